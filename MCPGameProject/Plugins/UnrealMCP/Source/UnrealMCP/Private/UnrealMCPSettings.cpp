@@ -44,6 +44,28 @@ UUnrealMCPSettings::UUnrealMCPSettings()
     ConnectTimeoutSec = FMath::Max(1.0f, ConnectTimeoutSec);
     ReadTimeoutSec = FMath::Max(1.0f, ReadTimeoutSec);
     HeartbeatIntervalSec = FMath::Clamp(HeartbeatIntervalSec, 0.1f, 60.0f);
+    MaxClientConnections = FMath::Clamp(MaxClientConnections, 1, 64);
+    MaxInFlightRequests = FMath::Clamp(MaxInFlightRequests, 1, 256);
+    CompressionThresholdBytes = FMath::Clamp(CompressionThresholdBytes, 0, 4 * 1024 * 1024);
+    SharedMemoryRingBytes = FMath::Clamp(SharedMemoryRingBytes, 0, 256 * 1024 * 1024);
+    OutboundQueueBytes = FMath::Clamp(OutboundQueueBytes, 64 * 1024, 1024 * 1024 * 1024);
+    SessionResumeWindowSec = FMath::Clamp(SessionResumeWindowSec, 0.0f, 3600.0f);
+    AssetIndexSaveIntervalMin = FMath::Clamp(AssetIndexSaveIntervalMin, 0.0f, 1440.0f);
+    GameThreadBudgetMs = FMath::Clamp(GameThreadBudgetMs, 0.5f, 100.0f);
+    ResponseCacheMaxEntries = FMath::Clamp(ResponseCacheMaxEntries, 0, 65536);
+    PrefetchFollowUps = FMath::Clamp(PrefetchFollowUps, 1, 32);
+    WorldChangeLogMaxActors = FMath::Clamp(WorldChangeLogMaxActors, 1024, 1048576);
+    RequestDedupWindowSec = FMath::Clamp(RequestDedupWindowSec, 0.0f, 86400.0f);
+    JobRetentionMin = FMath::Clamp(JobRetentionMin, 1.0f, 10080.0f);
+    BlueprintCompileDebounceMs = FMath::Clamp(BlueprintCompileDebounceMs, 0.0f, 60000.0f);
+    SourceControlRefreshIntervalSec = FMath::Clamp(SourceControlRefreshIntervalSec, 0.0f, 3600.0f);
+    SlowCommandThresholdMs = FMath::Clamp(SlowCommandThresholdMs, 0.0f, 60000.0f);
+    MetricsFlushIntervalSec = FMath::Clamp(MetricsFlushIntervalSec, 0.0f, 3600.0f);
+    MetricsRawSampleRate = FMath::Clamp(MetricsRawSampleRate, 0.0f, 1.0f);
+    MetricsHttpPort = FMath::Clamp(MetricsHttpPort, 0, 65535);
+    CommandMemorySampleMs = FMath::Clamp(CommandMemorySampleMs, 0.0f, 1000.0f);
+    BenchmarkConnections = FMath::Clamp(BenchmarkConnections, 1, 64);
+    BenchmarkDurationSec = FMath::Clamp(BenchmarkDurationSec, 1.0f, 600.0f);
     LogsDirectory.Path = ResolveLogsPath(LogsDirectory);
 }
 
@@ -51,3 +73,35 @@ FString UUnrealMCPSettings::GetEffectiveLogsDirectory() const
 {
     return ResolveLogsPath(LogsDirectory);
 }
+
+FUnrealMCPPerformanceValues UUnrealMCPSettings::GetPerformanceValues() const
+{
+    FUnrealMCPPerformanceValues Values;
+    switch (PerformanceProfile)
+    {
+    case EUnrealMCPPerformanceProfile::LocalFast:
+        // Compressing costs CPU on both ends and saves nothing over a local pipe or socket.
+        Values.Transport = EUnrealMCPTransport::LocalIpc;
+        Values.CompressionThresholdBytes = 0;
+        Values.GameThreadBudgetMs = 12.0f;
+        Values.bJsonLogs = false;
+        break;
+    case EUnrealMCPPerformanceProfile::Remote:
+        Values.CompressionThresholdBytes = 4096;
+        break;
+    case EUnrealMCPPerformanceProfile::Debug:
+        Values.bAllowBinaryEncoding = false;
+        Values.CompressionThresholdBytes = 0;
+        Values.bProtocolVerboseLogs = true;
+        break;
+    default:
+        Values.Transport = Transport;
+        Values.bAllowBinaryEncoding = bAllowBinaryEncoding;
+        Values.CompressionThresholdBytes = CompressionThresholdBytes;
+        Values.GameThreadBudgetMs = GameThreadBudgetMs;
+        Values.bProtocolVerboseLogs = bEnableProtocolVerboseLogs;
+        Values.bJsonLogs = bEnableJsonLogs;
+        break;
+    }
+    return Values;
+}
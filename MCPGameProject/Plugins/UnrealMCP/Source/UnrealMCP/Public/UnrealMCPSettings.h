@@ -17,6 +17,57 @@ enum class EUnrealMCPLogLevel : uint8
         Trace
 };
 
+UENUM()
+enum class EUnrealMCPTransport : uint8
+{
+        /** TCP socket on ServerHost:ServerPort. */
+        Tcp,
+        /** Same-host only: Unix domain socket, or a named pipe on Windows. */
+        LocalIpc UMETA(DisplayName="Local IPC")
+};
+
+UENUM()
+enum class EUnrealMCPSlowClientPolicy : uint8
+{
+        /** Discard the oldest queued event notifications; responses are always delivered. */
+        DropOldestEvents,
+        /** Close the connection once its outbound queue overflows. */
+        Disconnect
+};
+
+UENUM()
+enum class EUnrealMCPHeartbeatMode : uint8
+{
+        /** Ping after HeartbeatIntervalSec without traffic in either direction. */
+        Adaptive,
+        /** Ping only when the link has been silent for half of ReadTimeoutSec, just enough to keep it open. */
+        KeepaliveOnly UMETA(DisplayName="Keepalive Only")
+};
+
+UENUM()
+enum class EUnrealMCPPerformanceProfile : uint8
+{
+        /** Transport, encoding, compression, frame budget and logging apply as set below. */
+        Custom,
+        /** Same-host clients: local IPC, CBOR, no compression, a 12 ms frame budget, protocol and JSON logs off. */
+        LocalFast UMETA(DisplayName="Local (fast)"),
+        /** Clients on another machine: TCP, CBOR, frames from 4 KB compressed, an 8 ms frame budget, JSON logs on. */
+        Remote,
+        /** Readable traffic: TCP, JSON frames, no compression, an 8 ms frame budget, protocol and JSON logs on. */
+        Debug
+};
+
+/** The settings a performance profile selects together; see UUnrealMCPSettings::GetPerformanceValues. */
+struct FUnrealMCPPerformanceValues
+{
+        EUnrealMCPTransport Transport = EUnrealMCPTransport::Tcp;
+        bool bAllowBinaryEncoding = true;
+        int32 CompressionThresholdBytes = 16384;
+        float GameThreadBudgetMs = 8.0f;
+        bool bProtocolVerboseLogs = false;
+        bool bJsonLogs = true;
+};
+
 /**
  * Project-wide settings for the Unreal MCP plugin.
  */
@@ -28,7 +79,24 @@ class UNREALMCP_API UUnrealMCPSettings : public UDeveloperSettings
 public:
         UUnrealMCPSettings();
 
+        // === Performance ===
+        /**
+         * Sets transport, frame encoding, compression, GameThreadBudgetMs and the protocol and JSON
+         * logs together. Custom uses those fields as set; any other profile overrides them. Read
+         * when the server starts; the frame budget and logging also follow edits while it runs.
+         */
+        UPROPERTY(EditAnywhere, config, Category="Performance")
+        EUnrealMCPPerformanceProfile PerformanceProfile = EUnrealMCPPerformanceProfile::Custom;
+
         // === Network ===
+        /** Transport the MCP server listens on. Local IPC skips the TCP stack for clients on the same machine. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(EditCondition="PerformanceProfile==EUnrealMCPPerformanceProfile::Custom"))
+        EUnrealMCPTransport Transport = EUnrealMCPTransport::Tcp;
+
+        /** Local IPC endpoint name: \\.\pipe\<name> on Windows, <user temp dir>/<name>.sock elsewhere. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(EditCondition="Transport==EUnrealMCPTransport::LocalIpc || PerformanceProfile==EUnrealMCPPerformanceProfile::LocalFast"))
+        FString LocalEndpointName = TEXT("unreal-mcp");
+
         /** Host interface where the MCP socket server binds. */
         UPROPERTY(EditAnywhere, config, Category="Network")
         FString ServerHost = TEXT("127.0.0.1");
@@ -49,10 +117,119 @@ public:
         UPROPERTY(EditAnywhere, config, Category="Network")
         bool bAutoConnectOnEditorStartup = false;
 
-        /** Interval in seconds for heartbeat pings to remote clients. */
+        /** Seconds without traffic before a heartbeat ping is sent to a client. Responses and requests count as traffic. */
         UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="0.1", ClampMax="60.0"))
         float HeartbeatIntervalSec = 15.0f;
 
+        /** When heartbeats are sent. KeepaliveOnly suits editors left connected but idle for long stretches. */
+        UPROPERTY(EditAnywhere, config, Category="Network")
+        EUnrealMCPHeartbeatMode HeartbeatMode = EUnrealMCPHeartbeatMode::Adaptive;
+
+        /** Maximum number of MCP clients served concurrently. Extra clients are rejected at accept time. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="1", ClampMax="64"))
+        int32 MaxClientConnections = 8;
+
+        /** Requests a single client may keep in flight before the server stops reading (pipelining window). */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="1", ClampMax="256"))
+        int32 MaxInFlightRequests = 16;
+
+        /** Allow clients to negotiate CBOR frame payloads in the handshake. JSON remains the fallback. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(EditCondition="PerformanceProfile==EUnrealMCPPerformanceProfile::Custom"))
+        bool bAllowBinaryEncoding = true;
+
+        /** Frames at least this many bytes are zlib-compressed when the client negotiates it. 0 disables compression. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="0", ClampMax="4194304", ToolTip="Bytes", EditCondition="PerformanceProfile==EUnrealMCPPerformanceProfile::Custom"))
+        int32 CompressionThresholdBytes = 16384;
+
+        /** Shared-memory ring offered to same-host clients for bulk payloads (screenshots, exports). 0 disables it. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="0", ClampMax="268435456", ToolTip="Bytes"))
+        int32 SharedMemoryRingBytes = 33554432;
+
+        /** Bytes of encoded frames a connection may queue for a client that reads slowly. The server stops reading its requests while full. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="65536", ClampMax="1073741824", ToolTip="Bytes"))
+        int32 OutboundQueueBytes = 33554432;
+
+        /** What to do when a client's outbound queue is full. */
+        UPROPERTY(EditAnywhere, config, Category="Network")
+        EUnrealMCPSlowClientPolicy SlowClientPolicy = EUnrealMCPSlowClientPolicy::DropOldestEvents;
+
+        /** Seconds a disconnected session stays resumable with its token (enforcement, subscriptions, recent responses). 0 disables resumption. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="0.0", ClampMax="3600.0", ToolTip="Seconds"))
+        float SessionResumeWindowSec = 300.0f;
+
+        /** Answer asset registry reads (asset.find/exists/metadata) on a worker thread once the initial registry scan has finished, instead of queuing them behind the editor frame. */
+        UPROPERTY(EditAnywhere, config, Category="Network")
+        bool bRunRegistryQueriesOffGameThread = true;
+
+        /** Keep an asset index in Saved/UnrealMCP so asset.find and asset.graph can answer from it while the registry's startup scan runs. */
+        UPROPERTY(EditAnywhere, config, Category="Network")
+        bool bPersistAssetIndex = true;
+
+        /** Minutes between saves of the persisted asset index while the editor runs; it is also saved after the startup scan and on shutdown. 0 saves only then. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="0.0", ClampMax="1440.0", ToolTip="Minutes", EditCondition="bPersistAssetIndex"))
+        float AssetIndexSaveIntervalMin = 30.0f;
+
+        /** Milliseconds of each editor frame MCP commands may use. Queued commands beyond it wait for the next frame, and long read-only commands resume there. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="0.5", ClampMax="100.0", ToolTip="Milliseconds", EditCondition="PerformanceProfile==EUnrealMCPPerformanceProfile::Custom"))
+        float GameThreadBudgetMs = 8.0f;
+
+        /** Commands the game-thread queue may hold; past it new interactive and bulk requests are refused with OVERLOADED and a retryAfterMs. 0 disables the limit. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="0", ClampMax="65536"))
+        int32 MaxQueuedCommands = 512;
+
+        /** Estimated cost the game-thread queue may hold (1 per interactive command or batch entry, 8 per bulk command); past it new work is refused like MaxQueuedCommands. 0 disables the limit. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="0", ClampMax="1048576"))
+        int32 MaxQueuedCost = 1024;
+
+        /** Responses of repeatable read-only commands kept until an editor change invalidates them; hits skip the game thread. 0 disables the cache. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="0", ClampMax="65536"))
+        int32 ResponseCacheMaxEntries = 512;
+
+        /** After asset.find and sequence.create, runs the reads agents usually send next (asset.metadata of the top results, sequence.list_bindings) in idle game-thread time and caches their answers. Needs the response cache. */
+        UPROPERTY(EditAnywhere, config, Category="Network")
+        bool bSpeculativePrefetch = false;
+
+        /** Follow-up reads queued per triggering answer when bSpeculativePrefetch is on (e.g. how many asset.find results get asset.metadata). */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="1", ClampMax="32", EditCondition="bSpeculativePrefetch"))
+        int32 PrefetchFollowUps = 3;
+
+        /** Changed actors world.changes_since remembers; older changes are evicted and tokens from before them must resync. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="1024", ClampMax="1048576"))
+        int32 WorldChangeLogMaxActors = 65536;
+
+        /** Seconds the editor remembers a successful mutation by requestId, so a retry from a restarted or second MCP server is answered instead of applied again. 0 disables it. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="0.0", ClampMax="86400.0", ToolTip="Seconds"))
+        float RequestDedupWindowSec = 600.0f;
+
+        /** Minutes the result of a finished job.start job stays available to job.status and job.result. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="1.0", ClampMax="10080.0", ToolTip="Minutes"))
+        float JobRetentionMin = 60.0f;
+
+        /** Milliseconds without further edits before Blueprints changed by MCP commands are compiled; batches, shared transactions and compile_blueprint compile them at once. 0 compiles after every edit. */
+        UPROPERTY(EditAnywhere, config, Category="Network", meta=(ClampMin="0.0", ClampMax="60000.0", ToolTip="Milliseconds"))
+        float BlueprintCompileDebounceMs = 500.0f;
+
+        /** Leaves Blueprints changed by MCP commands uncompiled until a batch, shared transaction, compile_blueprint or a command that needs the generated class compiles them; edits keep the skeleton class current, so pins and types still resolve. The debounce is then unused. */
+        UPROPERTY(EditAnywhere, config, Category="Network")
+        bool bDeferBlueprintCompiles = false;
+
+        // === Memory ===
+        /** Used physical memory, in MB, the editor should stay under. From 90% of it garbage is collected between frames; past it bulk commands and batches are refused with OVERLOADED until memory drops. 0 disables the ceiling. */
+        UPROPERTY(EditAnywhere, config, Category="Memory", meta=(ClampMin="0", ClampMax="1048576", ToolTip="Megabytes"))
+        int32 MemoryCeilingMb = 0;
+
+        /** Seconds without queued or parked commands after which, if commands loaded assets since the last collection, garbage is collected incrementally. 0 disables idle collections. */
+        UPROPERTY(EditAnywhere, config, Category="Memory", meta=(ClampMin="0.0", ClampMax="3600.0", ToolTip="Seconds"))
+        float IdleGcSec = 30.0f;
+
+        /** Let idle and ceiling collections free assets MCP commands loaded, unless they are modified, open in an editor or still referenced. Otherwise loaded assets stay resident as they normally do in the editor. */
+        UPROPERTY(EditAnywhere, config, Category="Memory")
+        bool bReleaseAssetsLoadedByCommands = true;
+
+        /** Undo memory MCP mutations may hold in the editor's transaction buffer, in MB. Past it the oldest entries are dropped, back to and including MCP's own, so the newest MCP undo step is always kept. 0 leaves trimming to the editor's UndoBufferSize. */
+        UPROPERTY(EditAnywhere, config, Category="Memory", meta=(ClampMin="0", ClampMax="65536", ToolTip="Megabytes"))
+        int32 MaxUndoMemoryMb = 256;
+
         // === Security ===
         UPROPERTY(EditAnywhere, config, Category="Security")
         bool AllowWrite = false;
@@ -63,12 +240,31 @@ public:
         UPROPERTY(EditAnywhere, config, Category="Security")
         bool RequireCheckout = false;
 
+        /**
+         * Let requests with meta.noUndo run their mutations without undo transactions, for trusted
+         * bulk jobs whose changes source control can revert. Honored only with RequireCheckout;
+         * the editor's undo history is cleared after such a mutation, since older steps could no
+         * longer be undone safely.
+         */
+        UPROPERTY(EditAnywhere, config, Category="Security")
+        bool bAllowUndoFreeMutations = false;
+
+        /**
+         * Attach an audit (planned actions and outcome) to every mutation response and log it.
+         * Otherwise audits are only built for clients that ask for them in their capabilities
+         * message or a request's meta.audit.
+         */
+        UPROPERTY(EditAnywhere, config, Category="Security")
+        bool AlwaysEmitAudit = false;
+
         UPROPERTY(EditAnywhere, config, Category="Security")
         TArray<FDirectoryPath> AllowedContentRoots;
 
+        /** When non-empty, only these commands may run. Entries may use * and ? wildcards (e.g. "asset.*"). */
         UPROPERTY(EditAnywhere, config, Category="Security")
         TArray<FString> AllowedTools;
 
+        /** Commands that never run; checked before AllowedTools. Entries may use * and ? wildcards. */
         UPROPERTY(EditAnywhere, config, Category="Security")
         TArray<FString> DeniedTools;
 
@@ -82,8 +278,15 @@ public:
         UPROPERTY(EditAnywhere, config, Category="Source Control")
         FString PreferredProvider;
 
+        /**
+         * How often the status of files MCP checked out or added recently is refreshed in the
+         * background, so sc.status with "cached": true and the checkout cache stay current. 0 disables.
+         */
+        UPROPERTY(EditAnywhere, config, Category="Source Control", meta=(ClampMin="0.0", ClampMax="3600.0", ToolTip="Seconds"))
+        float SourceControlRefreshIntervalSec = 60.0f;
+
         // === Logging ===
-        UPROPERTY(EditAnywhere, config, Category="Logging")
+        UPROPERTY(EditAnywhere, config, Category="Logging", meta=(EditCondition="PerformanceProfile==EUnrealMCPPerformanceProfile::Custom"))
         bool bEnableProtocolVerboseLogs = false;
 
         /** Minimum verbosity for LogUnrealMCP category. */
@@ -91,15 +294,68 @@ public:
         EUnrealMCPLogLevel LogLevel = EUnrealMCPLogLevel::Display;
 
         /** Enable additional structured JSON logging (events + metrics). */
-        UPROPERTY(EditAnywhere, config, Category="Logging", meta=(DisplayName="Enable JSON Logs"))
+        UPROPERTY(EditAnywhere, config, Category="Logging", meta=(DisplayName="Enable JSON Logs", EditCondition="PerformanceProfile==EUnrealMCPPerformanceProfile::Custom"))
         bool bEnableJsonLogs = true;
 
         UPROPERTY(EditAnywhere, config, Category="Logging")
         FDirectoryPath LogsDirectory;
 
+        /**
+         * A command that holds the game thread longer than this is written to UnrealMCP_slow.jsonl
+         * with its params digest and a sampled callstack, and bookmarked in Insights. 0 disables.
+         */
+        UPROPERTY(EditAnywhere, config, Category="Logging", meta=(ClampMin="0.0", ClampMax="60000.0", ToolTip="Milliseconds"))
+        float SlowCommandThresholdMs = 100.0f;
+
+        /**
+         * Per-tool call counts and latency percentiles are kept in memory and written to the metrics
+         * file as one snapshot line per tool and outcome this often. 0 writes only at shutdown.
+         */
+        UPROPERTY(EditAnywhere, config, Category="Logging", meta=(ClampMin="0.0", ClampMax="3600.0", ToolTip="Seconds"))
+        float MetricsFlushIntervalSec = 60.0f;
+
+        /** Fraction of calls that still write a raw tool_duration_ms line next to the snapshots. */
+        UPROPERTY(EditAnywhere, config, Category="Logging", meta=(ClampMin="0.0", ClampMax="1.0"))
+        float MetricsRawSampleRate = 0.0f;
+
+        /**
+         * Serves the aggregated metrics in OpenMetrics format at http://<host>:<port>/metrics for
+         * Prometheus scrapes while the server runs. The bind address comes from the engine's
+         * [HTTPServer.Listeners] DefaultBindAddress. 0 disables the endpoint.
+         */
+        UPROPERTY(EditAnywhere, config, Category="Logging", meta=(ClampMin="0", ClampMax="65535", DisplayName="Metrics HTTP Port"))
+        int32 MetricsHttpPort = 0;
+
+        /** Milliseconds between used-memory samples while a command runs on the game thread, for meta.memory. The figure is process-wide, so other threads' allocations show up too. 0 disables it. */
+        UPROPERTY(EditAnywhere, config, Category="Logging", meta=(ClampMin="0.0", ClampMax="1000.0", ToolTip="Milliseconds"))
+        float CommandMemorySampleMs = 10.0f;
+
+        /**
+         * Captures every inbound frame and response time to UnrealMCP_traffic_<time>.mcptrace in the logs
+         * directory while the server runs, for replay with Python/replay_trace.py. Captures hold the
+         * full request params, so treat them like the session itself.
+         */
+        UPROPERTY(EditAnywhere, config, Category="Logging")
+        bool bCaptureTraffic = false;
+
+        /** Client connections the Run Benchmark action (and UnrealMCP.Benchmark) opens; each keeps one request outstanding. */
+        UPROPERTY(EditAnywhere, config, Category="Diagnostics", meta=(ClampMin="1", ClampMax="64"))
+        int32 BenchmarkConnections = 4;
+
+        /** Seconds the benchmark keeps sending requests, after a two-second idle frame-time baseline. */
+        UPROPERTY(EditAnywhere, config, Category="Diagnostics", meta=(ClampMin="1.0", ClampMax="600.0", ToolTip="Seconds"))
+        float BenchmarkDurationSec = 10.0f;
+
+        /** Weighted command mix, "command=weight" separated by commas. Supported: ping, asset.find, asset.exists, get_actors_in_level. */
+        UPROPERTY(EditAnywhere, config, Category="Diagnostics")
+        FString BenchmarkMix = TEXT("ping=4,asset.find=2,asset.exists=2,get_actors_in_level=2");
+
         virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
         virtual FText GetSectionText() const override { return NSLOCTEXT("UnrealMCP", "SettingsSection", "Unreal MCP"); }
 
         /** Resolves the log directory from settings or defaults. */
         FString GetEffectiveLogsDirectory() const;
+
+        /** Transport, encoding, compression, frame budget and logging as PerformanceProfile selects them. */
+        FUnrealMCPPerformanceValues GetPerformanceValues() const;
 };
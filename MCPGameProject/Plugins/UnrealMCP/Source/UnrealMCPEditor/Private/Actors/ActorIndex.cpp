@@ -0,0 +1,418 @@
+#include "Actors/ActorIndex.h"
+#include "CoreMinimal.h"
+
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+    AActor* ScanWorld(UWorld* World, TFunctionRef<bool(const AActor&)> Matches)
+    {
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            if (Matches(**It))
+            {
+                return *It;
+            }
+        }
+        return nullptr;
+    }
+}
+
+FActorIndex& FActorIndex::Get()
+{
+    static FActorIndex Instance;
+    return Instance;
+}
+
+void FActorIndex::Start()
+{
+    check(IsInGameThread());
+    if (bStarted)
+    {
+        return;
+    }
+    bStarted = true;
+
+    if (GEngine)
+    {
+        ActorAddedHandle = GEngine->OnLevelActorAdded().AddLambda([this](AActor* Actor)
+        {
+            ++Revision;
+            if (Actor)
+            {
+                if (FWorldIndex* Index = Worlds.Find(FObjectKey(Actor->GetWorld())))
+                {
+                    AddActor(*Index, Actor);
+                }
+            }
+        });
+        ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddLambda([this](AActor* Actor)
+        {
+            ++Revision;
+            if (Actor)
+            {
+                if (FWorldIndex* Index = Worlds.Find(FObjectKey(Actor->GetWorld())))
+                {
+                    RemoveActor(*Index, FObjectKey(Actor));
+                }
+            }
+        });
+        ActorOuterChangedHandle = GEngine->OnLevelActorOuterChanged().AddLambda([this](AActor* Actor, UObject*) { ReindexActor(Actor); });
+    }
+
+    ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddLambda([this](AActor* Actor) { ReindexActor(Actor); });
+    ObjectRenamedHandle = FCoreUObjectDelegates::OnObjectRenamed.AddLambda([this](UObject* Object, UObject*, FName)
+    {
+        if (AActor* Actor = Cast<AActor>(Object))
+        {
+            ReindexActor(Actor);
+        }
+    });
+
+    // Undo and redo bring actors back without an added event; streaming adds and removes whole levels.
+    PostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddLambda([this]()
+    {
+        ++Revision;
+        Worlds.Reset();
+    });
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddLambda([this](ULevel*, UWorld* World) { DropWorld(World); });
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddLambda([this](ULevel*, UWorld* World) { DropWorld(World); });
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddLambda([this](UWorld* World, bool, bool) { DropWorld(World); });
+}
+
+void FActorIndex::Stop()
+{
+    if (!bStarted)
+    {
+        return;
+    }
+    bStarted = false;
+
+    if (GEngine)
+    {
+        GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+        GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+        GEngine->OnLevelActorOuterChanged().Remove(ActorOuterChangedHandle);
+    }
+    FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+    FCoreUObjectDelegates::OnObjectRenamed.Remove(ObjectRenamedHandle);
+    FEditorDelegates::PostUndoRedo.Remove(PostUndoRedoHandle);
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+
+    Worlds.Empty();
+}
+
+AActor* FActorIndex::Resolve(UWorld* World, const FString& Identifier)
+{
+    if (AActor* Actor = FindByPath(World, Identifier))
+    {
+        return Actor;
+    }
+    if (AActor* Actor = FindByName(World, FName(*Identifier, FNAME_Find)))
+    {
+        return Actor;
+    }
+
+    FGuid Guid;
+    return FGuid::Parse(Identifier, Guid) ? FindByGuid(World, Guid) : nullptr;
+}
+
+AActor* FActorIndex::FindByName(UWorld* World, FName Name)
+{
+    if (!World || Name.IsNone())
+    {
+        return nullptr;
+    }
+
+    auto Matches = [Name](const AActor& Actor) { return Actor.GetFName() == Name; };
+    if (!UsesIndex(World))
+    {
+        return ScanWorld(World, Matches);
+    }
+
+    return LookUp(World, [this, World, Name, &Matches](const FWorldIndex& Index, AActor*& OutActor)
+    {
+        TArray<FObjectKey, TInlineAllocator<4>> Keys;
+        Index.ByName.MultiFind(Name, Keys);
+        for (const FObjectKey& Key : Keys)
+        {
+            if (!CheckHit(Index, World, Key, Matches, OutActor))
+            {
+                return false;
+            }
+            if (OutActor)
+            {
+                return true;
+            }
+        }
+        return true;
+    });
+}
+
+AActor* FActorIndex::FindByPath(UWorld* World, const FString& PathName)
+{
+    if (!World || PathName.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    auto Matches = [&PathName](const AActor& Actor) { return Actor.GetPathName() == PathName; };
+    if (!UsesIndex(World))
+    {
+        return ScanWorld(World, Matches);
+    }
+
+    return LookUp(World, [this, World, &PathName, &Matches](const FWorldIndex& Index, AActor*& OutActor)
+    {
+        const FObjectKey* Key = Index.ByPath.Find(PathName);
+        return !Key || CheckHit(Index, World, *Key, Matches, OutActor);
+    });
+}
+
+AActor* FActorIndex::FindByGuid(UWorld* World, const FGuid& Guid)
+{
+    if (!World || !Guid.IsValid())
+    {
+        return nullptr;
+    }
+
+    auto Matches = [&Guid](const AActor& Actor) { return Actor.GetActorGuid() == Guid; };
+    if (!UsesIndex(World))
+    {
+        return ScanWorld(World, Matches);
+    }
+
+    return LookUp(World, [this, World, &Guid, &Matches](const FWorldIndex& Index, AActor*& OutActor)
+    {
+        const FObjectKey* Key = Index.ByGuid.Find(Guid);
+        return !Key || CheckHit(Index, World, *Key, Matches, OutActor);
+    });
+}
+
+void FActorIndex::FindByLabel(UWorld* World, const FString& Label, TArray<AActor*>& OutActors)
+{
+    if (!World || Label.IsEmpty())
+    {
+        return;
+    }
+
+    auto Matches = [&Label](const AActor& Actor) { return Actor.GetActorLabel().Equals(Label, ESearchCase::IgnoreCase); };
+    if (!UsesIndex(World))
+    {
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            if (Matches(**It))
+            {
+                OutActors.Add(*It);
+            }
+        }
+        return;
+    }
+
+    const int32 FirstAdded = OutActors.Num();
+    LookUp(World, [this, World, &Label, &Matches, &OutActors, FirstAdded](const FWorldIndex& Index, AActor*&)
+    {
+        OutActors.SetNum(FirstAdded);
+        TArray<FObjectKey, TInlineAllocator<4>> Keys;
+        Index.ByLabel.MultiFind(Label, Keys);
+        for (const FObjectKey& Key : Keys)
+        {
+            AActor* Actor = nullptr;
+            if (!CheckHit(Index, World, Key, Matches, Actor))
+            {
+                return false;
+            }
+            if (Actor)
+            {
+                OutActors.Add(Actor);
+            }
+        }
+        return true;
+    });
+}
+
+void FActorIndex::GetActors(UWorld* World, TArray<AActor*>& OutActors)
+{
+    if (!World)
+    {
+        return;
+    }
+
+    FWorldIndex* Index = FindOrBuild(World);
+    if (!Index)
+    {
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            OutActors.Add(*It);
+        }
+        return;
+    }
+
+    OutActors.Reserve(OutActors.Num() + Index->Entries.Num());
+    for (const TPair<FObjectKey, FEntry>& Pair : Index->Entries)
+    {
+        AActor* Actor = Pair.Value.Actor.Get();
+        if (IsValid(Actor) && Actor->GetWorld() == World)
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+bool FActorIndex::UsesIndex(const UWorld* World) const
+{
+    // Without the delegates (e.g. in a commandlet) nothing would keep an index current.
+    return bStarted && World && !World->IsGameWorld();
+}
+
+FActorIndex::FWorldIndex* FActorIndex::FindOrBuild(UWorld* World)
+{
+    check(IsInGameThread());
+    if (!UsesIndex(World))
+    {
+        return nullptr;
+    }
+
+    const FObjectKey WorldKey(World);
+    if (FWorldIndex* Existing = Worlds.Find(WorldKey))
+    {
+        return Existing;
+    }
+
+    FWorldIndex& Index = Worlds.Add(WorldKey);
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        AddActor(Index, *It);
+    }
+    return &Index;
+}
+
+bool FActorIndex::CheckHit(const FWorldIndex& Index, UWorld* World, const FObjectKey& Key, TFunctionRef<bool(const AActor&)> Matches, AActor*& OutActor) const
+{
+    OutActor = nullptr;
+    const FEntry* Entry = Index.Entries.Find(Key);
+    AActor* Actor = Entry ? Entry->Actor.Get() : nullptr;
+    if (!IsValid(Actor) || Actor->GetWorld() != World || !Matches(*Actor))
+    {
+        return false;
+    }
+    OutActor = Actor;
+    return true;
+}
+
+AActor* FActorIndex::LookUp(UWorld* World, TFunctionRef<bool(const FWorldIndex&, AActor*&)> Lookup)
+{
+    AActor* Actor = nullptr;
+    for (int32 Attempt = 0; Attempt < 2; ++Attempt)
+    {
+        const FWorldIndex* Index = FindOrBuild(World);
+        if (!Index || Lookup(*Index, Actor))
+        {
+            return Actor;
+        }
+
+        // A delegate was missed somewhere; one rebuild brings the index back in line.
+        Actor = nullptr;
+        DropWorld(World);
+    }
+    return nullptr;
+}
+
+void FActorIndex::AddActor(FWorldIndex& Index, AActor* Actor)
+{
+    if (!IsValid(Actor))
+    {
+        return;
+    }
+
+    const FObjectKey Key(Actor);
+    RemoveActor(Index, Key);
+
+    FEntry& Entry = Index.Entries.Add(Key);
+    Entry.Actor = Actor;
+    Entry.Name = Actor->GetFName();
+    Entry.Path = Actor->GetPathName();
+    Entry.Label = Actor->GetActorLabel();
+    Entry.Guid = Actor->GetActorGuid();
+
+    Index.ByName.Add(Entry.Name, Key);
+    Index.ByPath.Add(Entry.Path, Key);
+    if (!Entry.Label.IsEmpty())
+    {
+        Index.ByLabel.Add(Entry.Label, Key);
+    }
+    if (Entry.Guid.IsValid())
+    {
+        Index.ByGuid.Add(Entry.Guid, Key);
+    }
+}
+
+void FActorIndex::RemoveActor(FWorldIndex& Index, const FObjectKey& Key)
+{
+    FEntry Entry;
+    if (!Index.Entries.RemoveAndCopyValue(Key, Entry))
+    {
+        return;
+    }
+
+    Index.ByName.RemoveSingle(Entry.Name, Key);
+    if (const FObjectKey* PathKey = Index.ByPath.Find(Entry.Path); PathKey && *PathKey == Key)
+    {
+        Index.ByPath.Remove(Entry.Path);
+    }
+    if (!Entry.Label.IsEmpty())
+    {
+        Index.ByLabel.RemoveSingle(Entry.Label, Key);
+    }
+    if (const FObjectKey* GuidKey = Index.ByGuid.Find(Entry.Guid); GuidKey && *GuidKey == Key)
+    {
+        Index.ByGuid.Remove(Entry.Guid);
+    }
+}
+
+void FActorIndex::ReindexActor(AActor* Actor)
+{
+    if (!Actor)
+    {
+        return;
+    }
+
+    ++Revision;
+    if (Worlds.Num() == 0)
+    {
+        return;
+    }
+
+    // A rename can move the actor to another world as well; drop it wherever it was filed.
+    const FObjectKey Key(Actor);
+    for (TPair<FObjectKey, FWorldIndex>& Pair : Worlds)
+    {
+        RemoveActor(Pair.Value, Key);
+    }
+    if (FWorldIndex* Index = Worlds.Find(FObjectKey(Actor->GetWorld())))
+    {
+        AddActor(*Index, Actor);
+    }
+}
+
+void FActorIndex::DropWorld(UWorld* World)
+{
+    ++Revision;
+    if (World)
+    {
+        Worlds.Remove(FObjectKey(World));
+    }
+    else
+    {
+        Worlds.Reset();
+    }
+}
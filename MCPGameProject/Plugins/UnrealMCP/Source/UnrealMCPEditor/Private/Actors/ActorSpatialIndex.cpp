@@ -0,0 +1,505 @@
+#include "Actors/ActorSpatialIndex.h"
+#include "CoreMinimal.h"
+
+#include "Algo/Sort.h"
+#include "Components/SceneComponent.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "SceneManagement.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+        /** A box query walks the occupied cells instead of its own range once it spans more cells than this many times over. */
+        constexpr int64 CellRangeWalkFactor = 4;
+
+        /** Longest ray walked cell by cell; longer rays are clamped. */
+        constexpr double MaxRayLength = 10000000.0;
+
+        /** Near plane of the frustum projection; the frustum is built without it, so only the shape matters. */
+        constexpr float FrustumNearPlane = 10.0f;
+
+        bool SphereIntersectsBox(const FVector& Center, double RadiusSquared, const FBox& Box)
+        {
+                return Box.ComputeSquaredDistanceToPoint(Center) <= RadiusSquared;
+        }
+
+        /** Where the ray enters Box, as a distance along Direction (unit length); false if it misses within Length. */
+        bool RayEntersBox(const FVector& Origin, const FVector& Direction, double Length, const FBox& Box, double& OutDistance)
+        {
+                double Enter = 0.0;
+                double Exit = Length;
+                for (int32 Axis = 0; Axis < 3; ++Axis)
+                {
+                        const double Start = Origin[Axis];
+                        const double Step = Direction[Axis];
+                        if (FMath::IsNearlyZero(Step))
+                        {
+                                if (Start < Box.Min[Axis] || Start > Box.Max[Axis])
+                                {
+                                        return false;
+                                }
+                                continue;
+                        }
+
+                        double Near = (Box.Min[Axis] - Start) / Step;
+                        double Far = (Box.Max[Axis] - Start) / Step;
+                        if (Near > Far)
+                        {
+                                Swap(Near, Far);
+                        }
+                        Enter = FMath::Max(Enter, Near);
+                        Exit = FMath::Min(Exit, Far);
+                        if (Enter > Exit)
+                        {
+                                return false;
+                        }
+                }
+                OutDistance = Enter;
+                return true;
+        }
+}
+
+FActorSpatialIndex& FActorSpatialIndex::Get()
+{
+        static FActorSpatialIndex Instance;
+        return Instance;
+}
+
+void FActorSpatialIndex::Start()
+{
+        check(IsInGameThread());
+        if (bStarted)
+        {
+                return;
+        }
+        bStarted = true;
+
+        if (GEngine)
+        {
+                ActorAddedHandle = GEngine->OnLevelActorAdded().AddLambda([this](AActor* Actor) { MarkDirty(Actor); });
+                ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddLambda([this](AActor* Actor)
+                {
+                        if (Actor)
+                        {
+                                if (FWorldGrid* Grid = Worlds.Find(FObjectKey(Actor->GetWorld())))
+                                {
+                                        RemoveActor(*Grid, FObjectKey(Actor));
+                                        Grid->Dirty.Remove(FObjectKey(Actor));
+                                }
+                        }
+                });
+        }
+        if (GEditor)
+        {
+                ActorMovedHandle = GEditor->OnActorMoved().AddLambda([this](AActor* Actor) { MarkDirty(Actor); });
+        }
+
+        // Modify() announces an edit before it happens, so the actor is re-filed lazily at the next query.
+        ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddLambda([this](UObject* Object)
+        {
+                if (Worlds.Num() == 0)
+                {
+                        return;
+                }
+                if (AActor* Actor = Cast<AActor>(Object))
+                {
+                        MarkDirty(Actor);
+                }
+                else if (const USceneComponent* Component = Cast<USceneComponent>(Object))
+                {
+                        MarkDirty(Component->GetOwner());
+                }
+        });
+
+        PostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddLambda([this]() { Worlds.Reset(); });
+        LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddLambda([this](ULevel*, UWorld* World) { DropWorld(World); });
+        LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddLambda([this](ULevel*, UWorld* World) { DropWorld(World); });
+        WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddLambda([this](UWorld* World, bool, bool) { DropWorld(World); });
+}
+
+void FActorSpatialIndex::Stop()
+{
+        if (!bStarted)
+        {
+                return;
+        }
+        bStarted = false;
+
+        if (GEngine)
+        {
+                GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+                GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+        }
+        if (GEditor)
+        {
+                GEditor->OnActorMoved().Remove(ActorMovedHandle);
+        }
+        FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+        FEditorDelegates::PostUndoRedo.Remove(PostUndoRedoHandle);
+        FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+        FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+        FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+
+        Worlds.Empty();
+}
+
+void FActorSpatialIndex::QueryBox(UWorld* World, const FBox& Box, TArray<AActor*>& OutActors)
+{
+        VisitCandidates(World, Box, [&Box, &OutActors](AActor& Actor, const FBox& Bounds)
+        {
+                if (Bounds.Intersect(Box))
+                {
+                        OutActors.Add(&Actor);
+                }
+        });
+}
+
+void FActorSpatialIndex::QuerySphere(UWorld* World, const FVector& Center, double Radius, TArray<AActor*>& OutActors)
+{
+        const double RadiusSquared = FMath::Square(Radius);
+        VisitCandidates(World, FBox(Center - FVector(Radius), Center + FVector(Radius)), [&Center, RadiusSquared, &OutActors](AActor& Actor, const FBox& Bounds)
+        {
+                if (SphereIntersectsBox(Center, RadiusSquared, Bounds))
+                {
+                        OutActors.Add(&Actor);
+                }
+        });
+}
+
+void FActorSpatialIndex::QueryRay(UWorld* World, const FVector& Origin, const FVector& Direction, double Length, TArray<FRayHit>& OutHits)
+{
+        const FVector Dir = Direction.GetSafeNormal();
+        if (!World || Dir.IsZero() || Length <= 0.0)
+        {
+                return;
+        }
+        Length = FMath::Min(Length, MaxRayLength);
+
+        auto Test = [&Origin, &Dir, Length, &OutHits](AActor& Actor, const FBox& Bounds)
+        {
+                double Distance = 0.0;
+                if (RayEntersBox(Origin, Dir, Length, Bounds, Distance))
+                {
+                        OutHits.Add({ &Actor, Distance });
+                }
+        };
+
+        FWorldGrid* Grid = FindOrBuild(World);
+        if (!Grid)
+        {
+                for (TActorIterator<AActor> It(World); It; ++It)
+                {
+                        Test(**It, GetActorBounds(**It));
+                }
+        }
+        else
+        {
+                // Walks the cells the ray crosses (Amanatides-Woo), so a long ray visits a line of cells, not a box of them.
+                TSet<FObjectKey> Seen;
+                auto VisitCell = [Grid, World, &Seen, &Test](const FIntVector& Cell)
+                {
+                        if (const TArray<FObjectKey>* Keys = Grid->Cells.Find(Cell))
+                        {
+                                for (const FObjectKey& Key : *Keys)
+                                {
+                                        bool bAlreadySeen = false;
+                                        Seen.Add(Key, &bAlreadySeen);
+                                        const FEntry* Entry = bAlreadySeen ? nullptr : Grid->Entries.Find(Key);
+                                        AActor* Actor = Entry ? Entry->Actor.Get() : nullptr;
+                                        if (IsValid(Actor) && Actor->GetWorld() == World)
+                                        {
+                                                Test(*Actor, Entry->Bounds);
+                                        }
+                                }
+                        }
+                };
+
+                FIntVector Cell = ToCell(Origin);
+                const FIntVector EndCell = ToCell(Origin + Dir * Length);
+                FIntVector Step;
+                FVector NextBoundary;
+                FVector Delta;
+                for (int32 Axis = 0; Axis < 3; ++Axis)
+                {
+                        Step[Axis] = Dir[Axis] > 0.0 ? 1 : (Dir[Axis] < 0.0 ? -1 : 0);
+                        const double Boundary = (Cell[Axis] + (Step[Axis] > 0 ? 1 : 0)) * CellSize;
+                        NextBoundary[Axis] = Step[Axis] != 0 ? (Boundary - Origin[Axis]) / Dir[Axis] : TNumericLimits<double>::Max();
+                        Delta[Axis] = Step[Axis] != 0 ? CellSize / FMath::Abs(Dir[Axis]) : TNumericLimits<double>::Max();
+                }
+
+                const int32 MaxSteps = 3 * (static_cast<int32>(Length / CellSize) + 2);
+                for (int32 Steps = 0; Steps < MaxSteps; ++Steps)
+                {
+                        VisitCell(Cell);
+                        if (Cell == EndCell)
+                        {
+                                break;
+                        }
+                        const int32 Axis = NextBoundary.X < NextBoundary.Y ? (NextBoundary.X < NextBoundary.Z ? 0 : 2) : (NextBoundary.Y < NextBoundary.Z ? 1 : 2);
+                        if (NextBoundary[Axis] > Length)
+                        {
+                                break;
+                        }
+                        Cell[Axis] += Step[Axis];
+                        NextBoundary[Axis] += Delta[Axis];
+                }
+
+                for (const FObjectKey& Key : Grid->Oversized)
+                {
+                        const FEntry* Entry = Grid->Entries.Find(Key);
+                        AActor* Actor = Entry ? Entry->Actor.Get() : nullptr;
+                        if (IsValid(Actor) && Actor->GetWorld() == World)
+                        {
+                                Test(*Actor, Entry->Bounds);
+                        }
+                }
+        }
+
+        Algo::SortBy(OutHits, &FRayHit::Distance);
+}
+
+void FActorSpatialIndex::QueryFrustum(UWorld* World, const FConvexVolume& Frustum, const FVector& Origin, double MaxDistance, TArray<AActor*>& OutActors)
+{
+        const double RadiusSquared = FMath::Square(MaxDistance);
+        VisitCandidates(World, FBox(Origin - FVector(MaxDistance), Origin + FVector(MaxDistance)), [&Frustum, &Origin, RadiusSquared, &OutActors](AActor& Actor, const FBox& Bounds)
+        {
+                if (SphereIntersectsBox(Origin, RadiusSquared, Bounds) && Frustum.IntersectBox(Bounds.GetCenter(), Bounds.GetExtent()))
+                {
+                        OutActors.Add(&Actor);
+                }
+        });
+}
+
+FConvexVolume FActorSpatialIndex::MakeViewFrustum(const FVector& Location, const FRotator& Rotation, float FovDegrees, float Aspect)
+{
+        // The same view and projection the level viewport builds, with UE's X-forward axes swapped into view space.
+        const FMatrix ViewRotation = FInverseRotationMatrix(Rotation) * FMatrix(FPlane(0, 0, 1, 0), FPlane(1, 0, 0, 0), FPlane(0, 1, 0, 0), FPlane(0, 0, 0, 1));
+        const FMatrix View = FTranslationMatrix(-Location) * ViewRotation;
+        const float HalfFov = FMath::DegreesToRadians(FMath::Clamp(FovDegrees, 1.0f, 170.0f)) * 0.5f;
+        const FMatrix Projection = FReversedZPerspectiveMatrix(HalfFov, HalfFov, 1.0f, FMath::Max(Aspect, 0.01f), FrustumNearPlane, FrustumNearPlane);
+
+        FConvexVolume Frustum;
+        GetViewFrustumBounds(Frustum, View * Projection, /*bUseNearPlane*/ false);
+        return Frustum;
+}
+
+FBox FActorSpatialIndex::GetActorBounds(const AActor& Actor)
+{
+        const FBox Bounds = Actor.GetComponentsBoundingBox(/*bNonColliding*/ true);
+        return Bounds.IsValid ? Bounds : FBox(Actor.GetActorLocation(), Actor.GetActorLocation());
+}
+
+bool FActorSpatialIndex::UsesGrid(const UWorld* World) const
+{
+        return bStarted && World && !World->IsGameWorld();
+}
+
+FActorSpatialIndex::FWorldGrid* FActorSpatialIndex::FindOrBuild(UWorld* World)
+{
+        check(IsInGameThread());
+        if (!UsesGrid(World))
+        {
+                return nullptr;
+        }
+
+        const FObjectKey WorldKey(World);
+        FWorldGrid* Grid = Worlds.Find(WorldKey);
+        if (!Grid)
+        {
+                Grid = &Worlds.Add(WorldKey);
+                for (TActorIterator<AActor> It(World); It; ++It)
+                {
+                        AddActor(*Grid, *It);
+                }
+                return Grid;
+        }
+
+        for (const TPair<FObjectKey, TWeakObjectPtr<AActor>>& Pair : Grid->Dirty)
+        {
+                RemoveActor(*Grid, Pair.Key);
+                AActor* Actor = Pair.Value.Get();
+                if (IsValid(Actor) && Actor->GetWorld() == World)
+                {
+                        AddActor(*Grid, Actor);
+                }
+        }
+        Grid->Dirty.Reset();
+        return Grid;
+}
+
+void FActorSpatialIndex::VisitCandidates(UWorld* World, const FBox& Box, TFunctionRef<void(AActor&, const FBox&)> Visit)
+{
+        if (!World || !Box.IsValid)
+        {
+                return;
+        }
+
+        FWorldGrid* Grid = FindOrBuild(World);
+        if (!Grid)
+        {
+                for (TActorIterator<AActor> It(World); It; ++It)
+                {
+                        Visit(**It, GetActorBounds(**It));
+                }
+                return;
+        }
+
+        TSet<FObjectKey> Seen;
+        auto VisitKey = [Grid, World, &Seen, &Visit](const FObjectKey& Key)
+        {
+                bool bAlreadySeen = false;
+                Seen.Add(Key, &bAlreadySeen);
+                const FEntry* Entry = bAlreadySeen ? nullptr : Grid->Entries.Find(Key);
+                AActor* Actor = Entry ? Entry->Actor.Get() : nullptr;
+                if (IsValid(Actor) && Actor->GetWorld() == World)
+                {
+                        Visit(*Actor, Entry->Bounds);
+                }
+        };
+
+        const FIntVector MinCell = ToCell(Box.Min);
+        const FIntVector MaxCell = ToCell(Box.Max);
+        const int64 RangeCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) * int64(MaxCell.Z - MinCell.Z + 1);
+        if (RangeCells > CellRangeWalkFactor * Grid->Cells.Num())
+        {
+                // A box larger than the populated world: walking what is filed beats walking empty cells.
+                for (const TPair<FIntVector, TArray<FObjectKey>>& Pair : Grid->Cells)
+                {
+                        const FIntVector& Cell = Pair.Key;
+                        if (Cell.X >= MinCell.X && Cell.X <= MaxCell.X && Cell.Y >= MinCell.Y && Cell.Y <= MaxCell.Y && Cell.Z >= MinCell.Z && Cell.Z <= MaxCell.Z)
+                        {
+                                for (const FObjectKey& Key : Pair.Value)
+                                {
+                                        VisitKey(Key);
+                                }
+                        }
+                }
+        }
+        else
+        {
+                for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+                {
+                        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+                        {
+                                for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+                                {
+                                        if (const TArray<FObjectKey>* Keys = Grid->Cells.Find(FIntVector(X, Y, Z)))
+                                        {
+                                                for (const FObjectKey& Key : *Keys)
+                                                {
+                                                        VisitKey(Key);
+                                                }
+                                        }
+                                }
+                        }
+                }
+        }
+
+        for (const FObjectKey& Key : Grid->Oversized)
+        {
+                VisitKey(Key);
+        }
+}
+
+void FActorSpatialIndex::AddActor(FWorldGrid& Grid, AActor* Actor)
+{
+        if (!IsValid(Actor))
+        {
+                return;
+        }
+
+        const FObjectKey Key(Actor);
+        RemoveActor(Grid, Key);
+
+        FEntry& Entry = Grid.Entries.Add(Key);
+        Entry.Actor = Actor;
+        Entry.Bounds = GetActorBounds(*Actor);
+        Entry.MinCell = ToCell(Entry.Bounds.Min);
+        Entry.MaxCell = ToCell(Entry.Bounds.Max);
+        const FIntVector Span = Entry.MaxCell - Entry.MinCell;
+        Entry.bOversized = Span.GetMax() >= MaxCellsPerAxis;
+        if (Entry.bOversized)
+        {
+                Grid.Oversized.Add(Key);
+                return;
+        }
+
+        for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+        {
+                for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+                {
+                        for (int32 Z = Entry.MinCell.Z; Z <= Entry.MaxCell.Z; ++Z)
+                        {
+                                Grid.Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(Key);
+                        }
+                }
+        }
+}
+
+void FActorSpatialIndex::RemoveActor(FWorldGrid& Grid, const FObjectKey& Key)
+{
+        FEntry Entry;
+        if (!Grid.Entries.RemoveAndCopyValue(Key, Entry))
+        {
+                return;
+        }
+
+        if (Entry.bOversized)
+        {
+                Grid.Oversized.Remove(Key);
+                return;
+        }
+
+        for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+        {
+                for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+                {
+                        for (int32 Z = Entry.MinCell.Z; Z <= Entry.MaxCell.Z; ++Z)
+                        {
+                                const FIntVector Cell(X, Y, Z);
+                                if (TArray<FObjectKey>* Keys = Grid.Cells.Find(Cell))
+                                {
+                                        Keys->RemoveSingleSwap(Key, EAllowShrinking::No);
+                                        if (Keys->Num() == 0)
+                                        {
+                                                Grid.Cells.Remove(Cell);
+                                        }
+                                }
+                        }
+                }
+        }
+}
+
+FIntVector FActorSpatialIndex::ToCell(const FVector& Location)
+{
+        auto Axis = [](double Value) { return static_cast<int32>(FMath::Clamp(FMath::FloorToDouble(Value / CellSize), -1000000.0, 1000000.0)); };
+        return FIntVector(Axis(Location.X), Axis(Location.Y), Axis(Location.Z));
+}
+
+void FActorSpatialIndex::MarkDirty(AActor* Actor)
+{
+        if (!Actor)
+        {
+                return;
+        }
+        if (FWorldGrid* Grid = Worlds.Find(FObjectKey(Actor->GetWorld())))
+        {
+                Grid->Dirty.Add(FObjectKey(Actor), Actor);
+        }
+}
+
+void FActorSpatialIndex::DropWorld(UWorld* World)
+{
+        if (World)
+        {
+                Worlds.Remove(FObjectKey(World));
+        }
+        else
+        {
+                Worlds.Reset();
+        }
+}
@@ -1,15 +1,31 @@
 #include "Actors/ActorTools.h"
 #include "CoreMinimal.h"
 
+#include "Actors/ActorIndex.h"
+#include "Actors/ActorSpatialIndex.h"
+#include "Actors/WorldChangeLog.h"
+#include "Algo/Sort.h"
+#include "Algo/StableSort.h"
+#include "Commands/MCPParamBinding.h"
+#include "Commands/PropertyPathCache.h"
+#include "Components/ActorComponent.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Editor.h"
+#include "EditorViewportClient.h"
 #include "Engine/Selection.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
 #include "GameFramework/Actor.h"
+#include "Levels/WorldPartitionActors.h"
+#include "Misc/Base64.h"
 #include "Misc/Char.h"
+#include "Permissions/WriteGate.h"
+#include "ScopedTransaction.h"
+#include "Transactions/BulkEdit.h"
+#include "Transactions/TransactionManager.h"
 #include "UObject/UObjectGlobals.h"
+#include "UObject/UnrealType.h"
 #include "Components/SceneComponent.h"
 
 namespace
@@ -21,6 +37,19 @@ namespace
         constexpr const TCHAR* ErrorCodeDestroyFailed = TEXT("DESTROY_FAILED");
         constexpr const TCHAR* ErrorCodeAttachFailed = TEXT("ATTACH_FAILED");
         constexpr const TCHAR* ErrorCodeTransformFailed = TEXT("TRANSFORM_FAILED");
+        constexpr const TCHAR* ErrorCodeViewportMissing = TEXT("VIEWPORT_MISSING");
+
+        constexpr int32 DefaultSpatialQueryLimit = 1000;
+        constexpr int32 MaxSpatialQueryLimit = 10000;
+        constexpr double DefaultFrustumMaxDistance = 100000.0;
+        constexpr int32 MaxSpawnBatchCount = 50000;
+        constexpr int32 MaxTransformBatchCount = 100000;
+        constexpr int32 DefaultChangesLimit = 5000;
+        constexpr int32 MaxChangesLimit = 50000;
+        constexpr int32 MaxReadPropertiesActors = 100000;
+        constexpr int32 MaxReadPropertiesColumns = 64;
+        /** Floats per packed transform: location xyz, quaternion xyzw, scale xyz. */
+        constexpr int32 PackedTransformStride = 10;
 
         TSharedPtr<FJsonObject> MakeErrorResponse(const FString& Code, const FString& Message)
         {
@@ -77,18 +106,7 @@ namespace
                         return FoundActor;
                 }
 
-                if (UWorld* World = GetEditorWorld())
-                {
-                        for (TActorIterator<AActor> It(World); It; ++It)
-                        {
-                                if (It->GetPathName() == Trimmed || It->GetName() == Trimmed)
-                                {
-                                        return *It;
-                                }
-                        }
-                }
-
-                return nullptr;
+                return FActorIndex::Get().Resolve(GetEditorWorld(), Trimmed);
         }
 
         bool ParseNumber(const TSharedPtr<FJsonValue>& Value, double& OutNumber)
@@ -145,6 +163,35 @@ namespace
                 return true;
         }
 
+        /** One of actor.transform's "set" and "add" objects; absent components are left alone. */
+        struct FTransformComponents
+        {
+                TOptional<FVector> Location;
+                TOptional<FRotator> Rotation;
+                TOptional<FVector> Scale;
+
+                static void Bind(TMCPParamBinding<FTransformComponents>& Binding)
+                {
+                        Binding.Optional(TEXT("location"), &FTransformComponents::Location)
+                                .Optional(TEXT("rotation"), &FTransformComponents::Rotation)
+                                .Optional(TEXT("scale"), &FTransformComponents::Scale);
+                }
+        };
+
+        struct FTransformParams
+        {
+                FString Actor;
+                FTransformComponents Set;
+                FTransformComponents Add;
+
+                static void Bind(TMCPParamBinding<FTransformParams>& Binding)
+                {
+                        Binding.Required(TEXT("actor"), &FTransformParams::Actor)
+                                .Optional(TEXT("set"), &FTransformParams::Set)
+                                .Optional(TEXT("add"), &FTransformParams::Add);
+                }
+        };
+
         bool ParseFNameArray(const TArray<TSharedPtr<FJsonValue>>& Values, TArray<FName>& OutNames)
         {
                 for (const TSharedPtr<FJsonValue>& Value : Values)
@@ -165,6 +212,93 @@ namespace
                 return true;
         }
 
+        /**
+         * Reads Field as Count vectors, given either flat ([x, y, z, x, y, z, ...]) or nested
+         * ([[x, y, z], ...]). One vector applies to every actor. Absent leaves OutVectors at Default.
+         */
+        bool ParseVectorColumn(const FJsonObject& Params, const TCHAR* Field, int32 Count, const FVector& Default, TArray<FVector>& OutVectors, FString& OutError)
+        {
+                OutVectors.Init(Default, Count);
+                if (!Params.HasField(Field))
+                {
+                        return true;
+                }
+
+                const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+                if (!Params.TryGetArrayField(Field, Values))
+                {
+                        OutError = FString::Printf(TEXT("%s must be an array"), Field);
+                        return false;
+                }
+
+                const bool bNested = Values->Num() > 0 && (*Values)[0].IsValid() && (*Values)[0]->Type == EJson::Array;
+                const int32 Provided = bNested ? Values->Num() : Values->Num() / 3;
+                if ((!bNested && Values->Num() % 3 != 0) || (Provided != Count && Provided != 1))
+                {
+                        OutError = FString::Printf(TEXT("%s must hold one vector or %d vectors"), Field, Count);
+                        return false;
+                }
+
+                TArray<TSharedPtr<FJsonValue>> Triple;
+                Triple.SetNum(3);
+                for (int32 Index = 0; Index < Provided; ++Index)
+                {
+                        if (!bNested)
+                        {
+                                for (int32 Axis = 0; Axis < 3; ++Axis)
+                                {
+                                        Triple[Axis] = (*Values)[Index * 3 + Axis];
+                                }
+                        }
+                        FVector Vector;
+                        const bool bParsed = ParseVector(bNested ? (*Values)[Index]->AsArray() : Triple, Vector);
+                        if (!bParsed)
+                        {
+                                OutError = FString::Printf(TEXT("%s[%d] is not three numbers"), Field, Index);
+                                return false;
+                        }
+                        OutVectors[Index] = Vector;
+                }
+                if (Provided == 1)
+                {
+                        OutVectors.Init(OutVectors[0], Count);
+                }
+                return true;
+        }
+
+        /** Reads Field as Count strings, or one string for every actor. Absent leaves OutStrings empty. */
+        bool ParseStringColumn(const FJsonObject& Params, const TCHAR* Field, int32 Count, TArray<FString>& OutStrings, FString& OutError)
+        {
+                if (!Params.HasField(Field))
+                {
+                        return true;
+                }
+
+                const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+                if (!Params.TryGetArrayField(Field, Values) || (Values->Num() != Count && Values->Num() != 1))
+                {
+                        OutError = FString::Printf(TEXT("%s must be an array of one or %d strings"), Field, Count);
+                        return false;
+                }
+
+                OutStrings.Reserve(Count);
+                for (const TSharedPtr<FJsonValue>& Value : *Values)
+                {
+                        FString String;
+                        if (!Value.IsValid() || !Value->TryGetString(String))
+                        {
+                                OutError = FString::Printf(TEXT("%s must hold only strings"), Field);
+                                return false;
+                        }
+                        OutStrings.Add(String.TrimStartAndEnd());
+                }
+                if (OutStrings.Num() == 1)
+                {
+                        OutStrings.Init(OutStrings[0], Count);
+                }
+                return true;
+        }
+
         UClass* ResolveActorClass(const FString& ClassPath)
         {
                 FString Trimmed = ClassPath;
@@ -244,6 +378,135 @@ namespace
                 }
         }
 
+        FEditorViewportClient* GetActiveLevelViewportClient()
+        {
+                if (!GEditor)
+                {
+                        return nullptr;
+                }
+
+                if (FViewport* ActiveViewport = GEditor->GetActiveViewport())
+                {
+                        if (FViewportClient* RawClient = ActiveViewport->GetClient())
+                        {
+                                return static_cast<FEditorViewportClient*>(RawClient);
+                        }
+                }
+
+                return nullptr;
+        }
+
+        /** Reads Field as a three-number array, or as the active viewport's location when it is "camera". */
+        bool ParsePointOrCamera(const FJsonObject& Params, const TCHAR* Field, FVector& OutPoint, bool& bOutCamera)
+        {
+                bOutCamera = false;
+                FString StringValue;
+                if (Params.TryGetStringField(Field, StringValue) && StringValue.Equals(TEXT("camera"), ESearchCase::IgnoreCase))
+                {
+                        const FEditorViewportClient* ViewportClient = GetActiveLevelViewportClient();
+                        if (!ViewportClient)
+                        {
+                                return false;
+                        }
+                        OutPoint = ViewportClient->GetViewLocation();
+                        bOutCamera = true;
+                        return true;
+                }
+
+                const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+                return Params.TryGetArrayField(Field, Values) && ParseVector(*Values, OutPoint);
+        }
+
+        bool MatchesClassHierarchy(const UClass* Class, const TArray<FString>& ClassNames)
+        {
+                for (; Class; Class = Class->GetSuperClass())
+                {
+                        const FString ClassName = Class->GetName();
+                        for (const FString& Candidate : ClassNames)
+                        {
+                                if (ClassName.Equals(Candidate, ESearchCase::IgnoreCase) || Class->GetPathName().Equals(Candidate, ESearchCase::IgnoreCase))
+                                {
+                                        return true;
+                                }
+                        }
+                }
+
+                return false;
+        }
+
+        bool MatchesClassNames(const AActor& Actor, const TArray<FString>& ClassNames)
+        {
+                return ClassNames.Num() == 0 || MatchesClassHierarchy(Actor.GetClass(), ClassNames);
+        }
+
+        /** The descriptor's own class by name or path, or its native class and parents (Blueprint parents are not loaded for this). */
+        bool MatchesClassNames(const FWorldPartitionActors::FDesc& Desc, const TArray<FString>& ClassNames)
+        {
+                if (ClassNames.Num() == 0 || MatchesClassHierarchy(Desc.NativeClass, ClassNames))
+                {
+                        return true;
+                }
+                return ClassNames.ContainsByPredicate([&Desc](const FString& Candidate)
+                {
+                        return Candidate.Equals(Desc.ClassName, ESearchCase::IgnoreCase) || Candidate.Equals(Desc.ClassPath, ESearchCase::IgnoreCase);
+                });
+        }
+
+        /**
+         * How one requested property path is read from actors of one class. A path that is not a
+         * property of the actor itself may start with an object property or a component name
+         * ("LightComponent.CastShadow"); the rest is then read from that object, compiled per its class.
+         */
+        struct FReadColumn
+        {
+                enum class EKind : uint8
+                {
+                        Unresolved,
+                        Actor,
+                        ObjectProperty,
+                        Component
+                };
+
+                EKind Kind = EKind::Unresolved;
+                /** Actor: the whole path. ObjectProperty: the object property the rest is read from. */
+                FPropertyPathCache::FCompiledPath Path;
+                FName ComponentName;
+                FString SubPath;
+        };
+
+        FReadColumn PlanReadColumn(const UClass* ActorClass, const FString& PropertyPath)
+        {
+                // Compiled paths are copied out: the cache may start over while a large read resolves more.
+                FPropertyPathCache& Cache = FPropertyPathCache::Get();
+                FReadColumn Column;
+                FString Error;
+                if (const FPropertyPathCache::FCompiledPath* Path = Cache.Resolve(ActorClass, PropertyPath, Error))
+                {
+                        Column.Kind = FReadColumn::EKind::Actor;
+                        Column.Path = *Path;
+                        return Column;
+                }
+
+                FString Head;
+                if (!PropertyPath.Split(TEXT("."), &Head, &Column.SubPath) || Head.IsEmpty() || Column.SubPath.IsEmpty())
+                {
+                        return Column;
+                }
+
+                const FPropertyPathCache::FCompiledPath* HeadPath = Cache.Resolve(ActorClass, Head, Error);
+                if (HeadPath && HeadPath->Leaf && HeadPath->Leaf->IsA<FObjectPropertyBase>())
+                {
+                        Column.Kind = FReadColumn::EKind::ObjectProperty;
+                        Column.Path = *HeadPath;
+                }
+                else
+                {
+                        Column.Kind = FReadColumn::EKind::Component;
+                        Column.ComponentName = FName(*Head);
+                }
+                return Column;
+        }
+
         TSharedPtr<FJsonObject> MakeTransformJson(const FVector& Location, const FRotator& Rotation, const FVector& Scale)
         {
                 TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
@@ -407,6 +670,156 @@ TSharedPtr<FJsonObject> FActorTools::Spawn(const TSharedPtr<FJsonObject>& Params
         return MakeSuccessResponse(Data);
 }
 
+TSharedPtr<FJsonObject> FActorTools::SpawnBatch(const TSharedPtr<FJsonObject>& Params)
+{
+        if (!Params.IsValid())
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* LocationValues = nullptr;
+        if (!Params->TryGetArrayField(TEXT("locations"), LocationValues) || LocationValues->Num() == 0)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing locations parameter"));
+        }
+        const bool bNestedLocations = (*LocationValues)[0].IsValid() && (*LocationValues)[0]->Type == EJson::Array;
+        const int32 Count = bNestedLocations ? LocationValues->Num() : LocationValues->Num() / 3;
+        if (Count > MaxSpawnBatchCount)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("At most %d actors per batch"), MaxSpawnBatchCount));
+        }
+
+        FString ColumnError;
+        TArray<FVector> Locations;
+        TArray<FVector> Rotations;
+        TArray<FVector> Scales;
+        TArray<FString> ClassPaths;
+        TArray<FString> Labels;
+        TArray<FString> Folders;
+        if (!ParseVectorColumn(*Params, TEXT("locations"), Count, FVector::ZeroVector, Locations, ColumnError)
+                || !ParseVectorColumn(*Params, TEXT("rotations"), Count, FVector::ZeroVector, Rotations, ColumnError)
+                || !ParseVectorColumn(*Params, TEXT("scales"), Count, FVector::OneVector, Scales, ColumnError)
+                || !ParseStringColumn(*Params, TEXT("classPaths"), Count, ClassPaths, ColumnError)
+                || !ParseStringColumn(*Params, TEXT("labels"), Count, Labels, ColumnError)
+                || !ParseStringColumn(*Params, TEXT("folders"), Count, Folders, ColumnError))
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, ColumnError);
+        }
+
+        FString SingleClassPath;
+        if (ClassPaths.Num() == 0)
+        {
+                if (!Params->TryGetStringField(TEXT("classPath"), SingleClassPath) || SingleClassPath.IsEmpty())
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing classPath or classPaths parameter"));
+                }
+                ClassPaths.Init(SingleClassPath, Count);
+        }
+
+        TArray<FName> SpawnTags;
+        if (Params->HasField(TEXT("tags")))
+        {
+                const TArray<TSharedPtr<FJsonValue>>* TagArray = nullptr;
+                if (!Params->TryGetArrayField(TEXT("tags"), TagArray) || !ParseFNameArray(*TagArray, SpawnTags))
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("tags must be an array of strings"));
+                }
+        }
+
+        // Each distinct class is loaded once, and a bad one fails the batch before anything spawns.
+        TMap<FString, UClass*> Classes;
+        for (const FString& ClassPath : ClassPaths)
+        {
+                if (Classes.Contains(ClassPath))
+                {
+                        continue;
+                }
+                UClass* ActorClass = ResolveActorClass(ClassPath);
+                if (!ActorClass || !ActorClass->IsChildOf(AActor::StaticClass()))
+                {
+                        return MakeErrorResponse(ErrorCodeClassNotFound, FString::Printf(TEXT("Unable to load an Actor class: %s"), *ClassPath));
+                }
+                Classes.Add(ClassPath, ActorClass);
+        }
+
+        UWorld* World = GetEditorWorld();
+        if (!World)
+        {
+                return MakeErrorResponse(ErrorCodeSpawnFailed, TEXT("Editor world is unavailable"));
+        }
+
+        TArray<AActor*> Spawned;
+        TArray<FTransform> Transforms;
+        Spawned.Reserve(Count);
+        Transforms.Reserve(Count);
+        TArray<TSharedPtr<FJsonValue>> Failures;
+        {
+                FScopedTransaction Transaction(FText::FromString(FWriteGate::GetTransactionName()), !FTransactionManager::IsUndoSuppressed());
+
+                // Every actor is created first with construction deferred, then finished in one pass, so
+                // no construction script runs while the level is half populated. AlwaysSpawn skips the
+                // per-actor overlap test; scattered placements are set by the caller on purpose.
+                for (int32 Index = 0; Index < Count; ++Index)
+                {
+                        const FTransform Transform(FRotator(Rotations[Index].X, Rotations[Index].Y, Rotations[Index].Z), Locations[Index], Scales[Index]);
+                        AActor* NewActor = World->SpawnActorDeferred<AActor>(Classes.FindChecked(ClassPaths[Index]), Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+                        if (!NewActor)
+                        {
+                                TSharedPtr<FJsonObject> Failure = MakeShared<FJsonObject>();
+                                Failure->SetNumberField(TEXT("index"), Index);
+                                Failure->SetStringField(TEXT("error"), TEXT("SpawnActorDeferred returned null"));
+                                Failures.Add(MakeShared<FJsonValueObject>(Failure));
+                                Spawned.Add(nullptr);
+                                Transforms.Add(Transform);
+                                continue;
+                        }
+
+                        if (SpawnTags.Num() > 0)
+                        {
+                                ApplyTags(*NewActor, SpawnTags);
+                        }
+                        Spawned.Add(NewActor);
+                        Transforms.Add(Transform);
+                }
+
+                for (int32 Index = 0; Index < Count; ++Index)
+                {
+                        AActor* NewActor = Spawned[Index];
+                        if (!NewActor)
+                        {
+                                continue;
+                        }
+
+                        NewActor->FinishSpawning(Transforms[Index]);
+                        if (Labels.IsValidIndex(Index) && !Labels[Index].IsEmpty())
+                        {
+                                NewActor->SetActorLabel(Labels[Index], /*bMarkDirty*/ false);
+                        }
+                        if (Folders.IsValidIndex(Index) && !Folders[Index].IsEmpty())
+                        {
+                                NewActor->SetFolderPath(FName(*Folders[Index]));
+                        }
+                }
+        }
+
+        FBulkEdit::NoteActorListChanged();
+        FBulkEdit::RedrawViewports(true);
+
+        TArray<TSharedPtr<FJsonValue>> ActorPaths;
+        ActorPaths.Reserve(Count);
+        for (AActor* NewActor : Spawned)
+        {
+                ActorPaths.Add(NewActor ? MakeShared<FJsonValueString>(NewActor->GetPathName()) : MakeShared<FJsonValueNull>());
+        }
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetNumberField(TEXT("requested"), Count);
+        Data->SetNumberField(TEXT("spawned"), Count - Failures.Num());
+        Data->SetArrayField(TEXT("actorPaths"), ActorPaths);
+        Data->SetArrayField(TEXT("failures"), Failures);
+        return MakeSuccessResponse(Data);
+}
+
 TSharedPtr<FJsonObject> FActorTools::Destroy(const TSharedPtr<FJsonObject>& Params)
 {
         if (!Params.IsValid())
@@ -547,97 +960,22 @@ TSharedPtr<FJsonObject> FActorTools::Transform(const TSharedPtr<FJsonObject>& Pa
                 return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
         }
 
-        FString ActorIdentifier;
-        if (!Params->TryGetStringField(TEXT("actor"), ActorIdentifier))
+        FTransformParams Request;
+        FString ParamError;
+        if (!TMCPParamBinding<FTransformParams>::Decode(Params, Request, ParamError))
         {
-                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing actor parameter"));
+                return MakeErrorResponse(ErrorCodeInvalidParams, ParamError);
         }
 
-        AActor* TargetActor = ResolveActor(ActorIdentifier);
+        AActor* TargetActor = ResolveActor(Request.Actor);
         if (!TargetActor)
         {
-                return MakeErrorResponse(ErrorCodeActorNotFound, FString::Printf(TEXT("Actor not found: %s"), *ActorIdentifier));
-        }
-
-        FVector Location = TargetActor->GetActorLocation();
-        FRotator Rotation = TargetActor->GetActorRotation();
-        FVector Scale = TargetActor->GetActorScale3D();
-
-        const TSharedPtr<FJsonObject>* SetObjectPtr = nullptr;
-        if (Params->TryGetObjectField(TEXT("set"), SetObjectPtr))
-        {
-                const TSharedPtr<FJsonObject>& SetObject = *SetObjectPtr;
-                if (SetObject.IsValid())
-                {
-                        if (SetObject->HasField(TEXT("location")))
-                        {
-                                const TArray<TSharedPtr<FJsonValue>>* LocationArray = nullptr;
-                                if (!SetObject->TryGetArrayField(TEXT("location"), LocationArray) || !ParseVector(*LocationArray, Location))
-                                {
-                                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("set.location must be an array of three numbers"));
-                                }
-                        }
-
-                        if (SetObject->HasField(TEXT("rotation")))
-                        {
-                                const TArray<TSharedPtr<FJsonValue>>* RotationArray = nullptr;
-                                if (!SetObject->TryGetArrayField(TEXT("rotation"), RotationArray) || !ParseRotator(*RotationArray, Rotation))
-                                {
-                                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("set.rotation must be an array of three numbers"));
-                                }
-                        }
-
-                        if (SetObject->HasField(TEXT("scale")))
-                        {
-                                const TArray<TSharedPtr<FJsonValue>>* ScaleArray = nullptr;
-                                if (!SetObject->TryGetArrayField(TEXT("scale"), ScaleArray) || !ParseVector(*ScaleArray, Scale))
-                                {
-                                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("set.scale must be an array of three numbers"));
-                                }
-                        }
-                }
+                return MakeErrorResponse(ErrorCodeActorNotFound, FString::Printf(TEXT("Actor not found: %s"), *Request.Actor));
         }
 
-        const TSharedPtr<FJsonObject>* AddObjectPtr = nullptr;
-        if (Params->TryGetObjectField(TEXT("add"), AddObjectPtr))
-        {
-                const TSharedPtr<FJsonObject>& AddObject = *AddObjectPtr;
-                if (AddObject.IsValid())
-                {
-                        if (AddObject->HasField(TEXT("location")))
-                        {
-                                const TArray<TSharedPtr<FJsonValue>>* LocationArray = nullptr;
-                                FVector LocationDelta = FVector::ZeroVector;
-                                if (!AddObject->TryGetArrayField(TEXT("location"), LocationArray) || !ParseVector(*LocationArray, LocationDelta))
-                                {
-                                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("add.location must be an array of three numbers"));
-                                }
-                                Location += LocationDelta;
-                        }
-
-                        if (AddObject->HasField(TEXT("rotation")))
-                        {
-                                const TArray<TSharedPtr<FJsonValue>>* RotationArray = nullptr;
-                                FRotator RotationDelta = FRotator::ZeroRotator;
-                                if (!AddObject->TryGetArrayField(TEXT("rotation"), RotationArray) || !ParseRotator(*RotationArray, RotationDelta))
-                                {
-                                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("add.rotation must be an array of three numbers"));
-                                }
-                                Rotation += RotationDelta;
-                        }
-
-                        if (AddObject->HasField(TEXT("scale")))
-                        {
-                                const TArray<TSharedPtr<FJsonValue>>* ScaleArray = nullptr;
-                                FVector ScaleDelta = FVector::ZeroVector;
-                                if (!AddObject->TryGetArrayField(TEXT("scale"), ScaleArray) || !ParseVector(*ScaleArray, ScaleDelta))
-                                {
-                                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("add.scale must be an array of three numbers"));
-                                }
-                                Scale += ScaleDelta;
-                        }
-                }
-        }
+        FVector Location = Request.Set.Location.Get(TargetActor->GetActorLocation()) + Request.Add.Location.Get(FVector::ZeroVector);
+        FRotator Rotation = Request.Set.Rotation.Get(TargetActor->GetActorRotation()) + Request.Add.Rotation.Get(FRotator::ZeroRotator);
+        FVector Scale = Request.Set.Scale.Get(TargetActor->GetActorScale3D()) + Request.Add.Scale.Get(FVector::ZeroVector);
 
         TargetActor->Modify();
         if (!TargetActor->SetActorTransform(FTransform(Rotation, Location, Scale), false, nullptr, ETeleportType::TeleportPhysics))
@@ -651,20 +989,191 @@ TSharedPtr<FJsonObject> FActorTools::Transform(const TSharedPtr<FJsonObject>& Pa
         return MakeSuccessResponse(Data);
 }
 
-TSharedPtr<FJsonObject> FActorTools::Tag(const TSharedPtr<FJsonObject>& Params)
+bool FActorTools::ParsePackedTransforms(const FJsonObject& Params, int32 Count, TArray<FTransform>& OutTransforms, FString& OutError)
 {
-        if (!Params.IsValid())
+        TArray<double> Floats;
+        const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+        FString Encoded;
+        if (Params.TryGetArrayField(TEXT("transforms"), Values))
         {
-                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+                Floats.Reserve(Values->Num());
+                for (const TSharedPtr<FJsonValue>& Value : *Values)
+                {
+                        double Number = 0.0;
+                        if (!ParseNumber(Value, Number))
+                        {
+                                OutError = TEXT("transforms must hold only numbers");
+                                return false;
+                        }
+                        Floats.Add(Number);
+                }
         }
-
-        FString ActorIdentifier;
-        if (!Params->TryGetStringField(TEXT("actor"), ActorIdentifier))
+        else if (Params.TryGetStringField(TEXT("transformsBase64"), Encoded))
         {
-                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing actor parameter"));
-        }
-
-        AActor* TargetActor = ResolveActor(ActorIdentifier);
+                TArray<uint8> Bytes;
+                if (!FBase64::Decode(Encoded, Bytes) || Bytes.Num() % sizeof(float) != 0)
+                {
+                        OutError = TEXT("transformsBase64 is not base64 of float32 values");
+                        return false;
+                }
+                // Every platform the editor runs on is little-endian, so the bytes copy straight in.
+                Floats.Reserve(Bytes.Num() / sizeof(float));
+                for (int32 Offset = 0; Offset < Bytes.Num(); Offset += sizeof(float))
+                {
+                        float Value = 0.0f;
+                        FMemory::Memcpy(&Value, Bytes.GetData() + Offset, sizeof(float));
+                        Floats.Add(Value);
+                }
+        }
+        else
+        {
+                OutError = TEXT("Missing transforms or transformsBase64 parameter");
+                return false;
+        }
+
+        if (Count < 0)
+        {
+                if (Floats.Num() == 0 || Floats.Num() % PackedTransformStride != 0)
+                {
+                        OutError = FString::Printf(TEXT("Expected a non-empty multiple of %d values (one transform each), got %d"), PackedTransformStride, Floats.Num());
+                        return false;
+                }
+                Count = Floats.Num() / PackedTransformStride;
+        }
+        else if (Floats.Num() != Count * PackedTransformStride)
+        {
+                OutError = FString::Printf(TEXT("Expected %d values (%d per actor), got %d"), Count * PackedTransformStride, PackedTransformStride, Floats.Num());
+                return false;
+        }
+
+        OutTransforms.Reserve(Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+                const double* F = Floats.GetData() + Index * PackedTransformStride;
+                FQuat Rotation(F[3], F[4], F[5], F[6]);
+                if (Rotation.SizeSquared() < UE_SMALL_NUMBER || !FMath::IsFinite(Rotation.SizeSquared()))
+                {
+                        OutError = FString::Printf(TEXT("Transform %d has a zero or non-finite quaternion"), Index);
+                        return false;
+                }
+                Rotation.Normalize();
+                OutTransforms.Add(FTransform(Rotation, FVector(F[0], F[1], F[2]), FVector(F[7], F[8], F[9])));
+        }
+        return true;
+}
+
+TSharedPtr<FJsonObject> FActorTools::TransformBatch(const TSharedPtr<FJsonObject>& Params)
+{
+        if (!Params.IsValid())
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* ActorsArray = nullptr;
+        if (!Params->TryGetArrayField(TEXT("actors"), ActorsArray) || ActorsArray->Num() == 0)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("actors must be a non-empty array"));
+        }
+        if (ActorsArray->Num() > MaxTransformBatchCount)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("At most %d actors per batch"), MaxTransformBatchCount));
+        }
+
+        const int32 Count = ActorsArray->Num();
+        TArray<FTransform> Transforms;
+        FString ParseError;
+        if (!ParsePackedTransforms(*Params, Count, Transforms, ParseError))
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, ParseError);
+        }
+
+        const bool bAllowMissing = Params->HasTypedField<EJson::Boolean>(TEXT("allowMissing")) && Params->GetBoolField(TEXT("allowMissing"));
+
+        // Everything is resolved before anything moves, so a bad identifier leaves the level untouched.
+        TArray<AActor*> Actors;
+        Actors.Reserve(Count);
+        TArray<TSharedPtr<FJsonValue>> Missing;
+        for (const TSharedPtr<FJsonValue>& Value : *ActorsArray)
+        {
+                FString ActorPath;
+                if (!Value.IsValid() || !Value->TryGetString(ActorPath))
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("actors must contain string identifiers"));
+                }
+
+                AActor* TargetActor = ResolveActor(ActorPath);
+                if (!TargetActor)
+                {
+                        if (!bAllowMissing)
+                        {
+                                return MakeErrorResponse(ErrorCodeActorNotFound, FString::Printf(TEXT("Actor not found: %s"), *ActorPath));
+                        }
+                        Missing.Add(MakeShared<FJsonValueString>(ActorPath));
+                }
+                Actors.Add(TargetActor);
+        }
+
+        TArray<TSharedPtr<FJsonValue>> Failed;
+        int32 MovedCount = 0;
+        {
+                FScopedTransaction Transaction(FText::FromString(FWriteGate::GetTransactionName()), !FTransactionManager::IsUndoSuppressed());
+
+                // Moves happen first and the editor's move notifications after, so construction scripts
+                // and listeners run once per actor against the final layout, and the viewport redraws once.
+                TArray<AActor*> Moved;
+                Moved.Reserve(Count);
+                for (int32 Index = 0; Index < Count; ++Index)
+                {
+                        AActor* TargetActor = Actors[Index];
+                        if (!TargetActor)
+                        {
+                                continue;
+                        }
+
+                        TargetActor->Modify();
+                        if (!TargetActor->SetActorTransform(Transforms[Index], false, nullptr, ETeleportType::TeleportPhysics))
+                        {
+                                Failed.Add(MakeShared<FJsonValueString>(TargetActor->GetPathName()));
+                                continue;
+                        }
+                        Moved.Add(TargetActor);
+                }
+
+                for (AActor* TargetActor : Moved)
+                {
+                        TargetActor->PostEditMove(true);
+                        if (GEngine)
+                        {
+                                GEngine->BroadcastOnActorMoved(TargetActor);
+                        }
+                }
+                MovedCount = Moved.Num();
+        }
+
+        FBulkEdit::RedrawViewports(true);
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetNumberField(TEXT("count"), MovedCount);
+        Data->SetArrayField(TEXT("missing"), Missing);
+        Data->SetArrayField(TEXT("failed"), Failed);
+
+        return MakeSuccessResponse(Data);
+}
+
+TSharedPtr<FJsonObject> FActorTools::Tag(const TSharedPtr<FJsonObject>& Params)
+{
+        if (!Params.IsValid())
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+        }
+
+        FString ActorIdentifier;
+        if (!Params->TryGetStringField(TEXT("actor"), ActorIdentifier))
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing actor parameter"));
+        }
+
+        AActor* TargetActor = ResolveActor(ActorIdentifier);
         if (!TargetActor)
         {
                 return MakeErrorResponse(ErrorCodeActorNotFound, FString::Printf(TEXT("Actor not found: %s"), *ActorIdentifier));
@@ -747,3 +1256,527 @@ TSharedPtr<FJsonObject> FActorTools::Tag(const TSharedPtr<FJsonObject>& Params)
 
         return MakeSuccessResponse(Data);
 }
+
+TSharedPtr<FJsonObject> FActorTools::QuerySpatial(const TSharedPtr<FJsonObject>& Params)
+{
+        if (!Params.IsValid())
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+        }
+
+        UWorld* World = GetEditorWorld();
+        if (!World)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("No editor world available"));
+        }
+
+        FString Shape;
+        if (!Params->TryGetStringField(TEXT("shape"), Shape))
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing shape parameter (box, sphere, ray or frustum)"));
+        }
+
+        int32 Limit = DefaultSpatialQueryLimit;
+        double LimitValue = 0.0;
+        if (Params->TryGetNumberField(TEXT("limit"), LimitValue))
+        {
+                Limit = FMath::Clamp(static_cast<int32>(LimitValue), 1, MaxSpatialQueryLimit);
+        }
+
+        TArray<FString> ClassNames;
+        const TArray<TSharedPtr<FJsonValue>>* ClassArray = nullptr;
+        if (Params->TryGetArrayField(TEXT("classNames"), ClassArray))
+        {
+                for (const TSharedPtr<FJsonValue>& Value : *ClassArray)
+                {
+                        FString ClassName;
+                        if (Value.IsValid() && Value->TryGetString(ClassName) && !ClassName.TrimStartAndEnd().IsEmpty())
+                        {
+                                ClassNames.Add(ClassName.TrimStartAndEnd());
+                        }
+                }
+        }
+
+        bool bIncludeUnloaded = false;
+        Params->TryGetBoolField(TEXT("includeUnloaded"), bIncludeUnloaded);
+
+        FActorSpatialIndex& Index = FActorSpatialIndex::Get();
+        TArray<FActorSpatialIndex::FRayHit> Hits;
+        // Tests an unloaded actor's descriptor bounds against the shape, setting the distance for ray and frustum.
+        TFunction<bool(const FBox&, double&)> DescTest;
+        bool bRay = false;
+        bool bCamera = false;
+        if (Shape.Equals(TEXT("box"), ESearchCase::IgnoreCase))
+        {
+                const TArray<TSharedPtr<FJsonValue>>* MinArray = nullptr;
+                const TArray<TSharedPtr<FJsonValue>>* MaxArray = nullptr;
+                FVector Min;
+                FVector Max;
+                if (!Params->TryGetArrayField(TEXT("min"), MinArray) || !ParseVector(*MinArray, Min)
+                        || !Params->TryGetArrayField(TEXT("max"), MaxArray) || !ParseVector(*MaxArray, Max))
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("box needs min and max arrays of three numbers"));
+                }
+
+                const FBox Box(Min.ComponentMin(Max), Min.ComponentMax(Max));
+                TArray<AActor*> Actors;
+                Index.QueryBox(World, Box, Actors);
+                for (AActor* Actor : Actors)
+                {
+                        Hits.Add({ Actor, 0.0 });
+                }
+                DescTest = [Box](const FBox& Bounds, double& OutDistance) { return Bounds.Intersect(Box); };
+        }
+        else if (Shape.Equals(TEXT("sphere"), ESearchCase::IgnoreCase))
+        {
+                FVector Center;
+                double Radius = 0.0;
+                if (!ParsePointOrCamera(*Params, TEXT("center"), Center, bCamera))
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("sphere needs a center array of three numbers, or \"camera\" with an active viewport"));
+                }
+                if (!Params->TryGetNumberField(TEXT("radius"), Radius) || Radius <= 0.0)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("sphere needs a positive radius"));
+                }
+
+                TArray<AActor*> Actors;
+                Index.QuerySphere(World, Center, Radius, Actors);
+                for (AActor* Actor : Actors)
+                {
+                        Hits.Add({ Actor, 0.0 });
+                }
+                DescTest = [Center, Radius](const FBox& Bounds, double& OutDistance) { return FMath::SphereAABBIntersection(Center, Radius * Radius, Bounds); };
+        }
+        else if (Shape.Equals(TEXT("ray"), ESearchCase::IgnoreCase))
+        {
+                FVector Origin;
+                if (!ParsePointOrCamera(*Params, TEXT("origin"), Origin, bCamera))
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("ray needs an origin array of three numbers, or \"camera\" with an active viewport"));
+                }
+
+                FVector Direction;
+                const TArray<TSharedPtr<FJsonValue>>* DirectionArray = nullptr;
+                if (Params->TryGetArrayField(TEXT("direction"), DirectionArray))
+                {
+                        if (!ParseVector(*DirectionArray, Direction) || Direction.IsNearlyZero())
+                        {
+                                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("direction must be a non-zero array of three numbers"));
+                        }
+                }
+                else if (bCamera)
+                {
+                        Direction = GetActiveLevelViewportClient()->GetViewRotation().Vector();
+                }
+                else
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("ray needs a direction unless its origin is \"camera\""));
+                }
+
+                double Length = 0.0;
+                if (!Params->TryGetNumberField(TEXT("length"), Length) || Length <= 0.0)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("ray needs a positive length"));
+                }
+
+                Index.QueryRay(World, Origin, Direction, Length, Hits);
+                bRay = true;
+
+                const FVector End = Origin + Direction.GetSafeNormal() * Length;
+                DescTest = [Origin, End, Length](const FBox& Bounds, double& OutDistance)
+                {
+                        FVector HitLocation;
+                        FVector HitNormal;
+                        float HitTime = 0.0f;
+                        if (!FMath::LineExtentBoxIntersection(Bounds, Origin, End, FVector::ZeroVector, HitLocation, HitNormal, HitTime))
+                        {
+                                return false;
+                        }
+                        OutDistance = HitTime * Length;
+                        return true;
+                };
+        }
+        else if (Shape.Equals(TEXT("frustum"), ESearchCase::IgnoreCase))
+        {
+                FEditorViewportClient* ViewportClient = GetActiveLevelViewportClient();
+                if (!ViewportClient || !ViewportClient->Viewport)
+                {
+                        return MakeErrorResponse(ErrorCodeViewportMissing, TEXT("frustum needs an active level viewport"));
+                }
+
+                double MaxDistance = DefaultFrustumMaxDistance;
+                if (Params->TryGetNumberField(TEXT("maxDistance"), MaxDistance) && MaxDistance <= 0.0)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("maxDistance must be positive"));
+                }
+
+                const FIntPoint Size = ViewportClient->Viewport->GetSizeXY();
+                const float Aspect = Size.Y > 0 ? static_cast<float>(Size.X) / static_cast<float>(Size.Y) : 1.0f;
+                const FVector Location = ViewportClient->GetViewLocation();
+                const FConvexVolume Frustum = FActorSpatialIndex::MakeViewFrustum(Location, ViewportClient->GetViewRotation(), ViewportClient->ViewFOV, Aspect);
+
+                TArray<AActor*> Actors;
+                Index.QueryFrustum(World, Frustum, Location, MaxDistance, Actors);
+                for (AActor* Actor : Actors)
+                {
+                        Hits.Add({ Actor, FVector::Dist(Location, Actor->GetActorLocation()) });
+                }
+                bRay = true;
+
+                DescTest = [Frustum, Location, MaxDistance](const FBox& Bounds, double& OutDistance)
+                {
+                        OutDistance = FVector::Dist(Location, Bounds.GetCenter());
+                        return OutDistance <= MaxDistance && Frustum.IntersectBox(Bounds.GetCenter(), Bounds.GetExtent());
+                };
+        }
+        else
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("Unknown shape '%s' (box, sphere, ray or frustum)"), *Shape));
+        }
+
+        // Loaded actors and, when asked, unloaded World Partition actors from their descriptors.
+        struct FSpatialMatch
+        {
+                AActor* Actor = nullptr;
+                int32 DescIndex = INDEX_NONE;
+                double Distance = 0.0;
+                FString Path;
+        };
+        TArray<FSpatialMatch> Matches;
+        Matches.Reserve(Hits.Num());
+        for (const FActorSpatialIndex::FRayHit& Hit : Hits)
+        {
+                if (MatchesClassNames(*Hit.Actor, ClassNames))
+                {
+                        Matches.Add({ Hit.Actor, INDEX_NONE, Hit.Distance, bRay ? FString() : Hit.Actor->GetPathName() });
+                }
+        }
+
+        TArray<FWorldPartitionActors::FDesc> UnloadedDescs;
+        if (bIncludeUnloaded && DescTest && FWorldPartitionActors::GetUnloaded(World, UnloadedDescs))
+        {
+                for (int32 DescIndex = 0; DescIndex < UnloadedDescs.Num(); ++DescIndex)
+                {
+                        const FWorldPartitionActors::FDesc& Desc = UnloadedDescs[DescIndex];
+                        double Distance = 0.0;
+                        if (Desc.Bounds.IsValid && MatchesClassNames(Desc, ClassNames) && DescTest(Desc.Bounds, Distance))
+                        {
+                                Matches.Add({ nullptr, DescIndex, Distance, Desc.Path });
+                        }
+                }
+        }
+
+        if (bRay)
+        {
+                Algo::StableSortBy(Matches, &FSpatialMatch::Distance);
+        }
+        else
+        {
+                // Box and sphere results come in cell order; path order keeps repeated queries comparable.
+                Algo::SortBy(Matches, &FSpatialMatch::Path);
+        }
+
+        TArray<TSharedPtr<FJsonValue>> ActorsJson;
+        const bool bTruncated = Matches.Num() > Limit;
+        for (int32 MatchIndex = 0; MatchIndex < FMath::Min(Matches.Num(), Limit); ++MatchIndex)
+        {
+                const FSpatialMatch& Hit = Matches[MatchIndex];
+                if (Hit.DescIndex != INDEX_NONE)
+                {
+                        const FWorldPartitionActors::FDesc& Desc = UnloadedDescs[Hit.DescIndex];
+                        TSharedRef<FJsonObject> DescJson = FWorldPartitionActors::ToJson(Desc);
+                        DescJson->SetStringField(TEXT("class"), Desc.ClassPath);
+                        if (bRay)
+                        {
+                                DescJson->SetNumberField(TEXT("distance"), Hit.Distance);
+                        }
+                        ActorsJson.Add(MakeShared<FJsonValueObject>(DescJson));
+                        continue;
+                }
+
+                TSharedPtr<FJsonObject> ActorJson = MakeShared<FJsonObject>();
+                ActorJson->SetStringField(TEXT("name"), Hit.Actor->GetName());
+                ActorJson->SetStringField(TEXT("label"), Hit.Actor->GetActorLabel());
+                ActorJson->SetStringField(TEXT("path"), Hit.Actor->GetPathName());
+                ActorJson->SetStringField(TEXT("class"), Hit.Actor->GetClass()->GetPathName());
+                const FVector Location = Hit.Actor->GetActorLocation();
+                TArray<TSharedPtr<FJsonValue>> LocationArray;
+                LocationArray.Add(MakeShared<FJsonValueNumber>(Location.X));
+                LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Y));
+                LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Z));
+                ActorJson->SetArrayField(TEXT("location"), LocationArray);
+                if (bRay)
+                {
+                        ActorJson->SetNumberField(TEXT("distance"), Hit.Distance);
+                }
+                ActorsJson.Add(MakeShared<FJsonValueObject>(ActorJson));
+        }
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetStringField(TEXT("shape"), Shape.ToLower());
+        Data->SetArrayField(TEXT("actors"), ActorsJson);
+        Data->SetNumberField(TEXT("count"), ActorsJson.Num());
+        Data->SetBoolField(TEXT("truncated"), bTruncated);
+        return MakeSuccessResponse(Data);
+}
+
+TSharedPtr<FJsonObject> FActorTools::ChangesSince(const TSharedPtr<FJsonObject>& Params)
+{
+        FString Token;
+        int32 Limit = DefaultChangesLimit;
+        if (Params.IsValid())
+        {
+                Params->TryGetStringField(TEXT("token"), Token);
+                double LimitValue = 0.0;
+                if (Params->TryGetNumberField(TEXT("limit"), LimitValue))
+                {
+                        Limit = FMath::Clamp(static_cast<int32>(LimitValue), 1, MaxChangesLimit);
+                }
+        }
+
+        FWorldChangeLog::FDelta Delta;
+        FWorldChangeLog::Get().ChangesSince(Token, Limit, Delta);
+
+        TArray<TSharedPtr<FJsonValue>> ChangesJson;
+        ChangesJson.Reserve(Delta.Entries.Num());
+        for (const FWorldChangeLog::FEntry& Entry : Delta.Entries)
+        {
+                ChangesJson.Add(MakeShared<FJsonValueObject>(FWorldChangeLog::EntryToJson(Entry)));
+        }
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetStringField(TEXT("token"), Delta.Token);
+        Data->SetBoolField(TEXT("resync"), Delta.bResync);
+        Data->SetBoolField(TEXT("more"), Delta.bMore);
+        Data->SetArrayField(TEXT("changes"), ChangesJson);
+        return MakeSuccessResponse(Data);
+}
+
+TSharedPtr<FJsonObject> FActorTools::ReadProperties(const TSharedPtr<FJsonObject>& Params)
+{
+        if (!Params.IsValid())
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* PropertiesArray = nullptr;
+        if (!Params->TryGetArrayField(TEXT("properties"), PropertiesArray) || PropertiesArray->Num() == 0)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("properties must be a non-empty array"));
+        }
+        if (PropertiesArray->Num() > MaxReadPropertiesColumns)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("At most %d properties per read"), MaxReadPropertiesColumns));
+        }
+
+        TArray<FString> Properties;
+        for (const TSharedPtr<FJsonValue>& Value : *PropertiesArray)
+        {
+                FString PropertyPath;
+                if (!Value.IsValid() || !Value->TryGetString(PropertyPath) || PropertyPath.TrimStartAndEnd().IsEmpty())
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("properties must contain non-empty strings"));
+                }
+                Properties.Add(PropertyPath.TrimStartAndEnd());
+        }
+
+        TArray<AActor*> Actors;
+        TArray<TSharedPtr<FJsonValue>> Missing;
+        bool bTruncated = false;
+        const TArray<TSharedPtr<FJsonValue>>* ActorsArray = nullptr;
+        const TArray<TSharedPtr<FJsonValue>>* ClassArray = nullptr;
+        if (Params->TryGetArrayField(TEXT("actors"), ActorsArray))
+        {
+                if (ActorsArray->Num() > MaxReadPropertiesActors)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("At most %d actors per read"), MaxReadPropertiesActors));
+                }
+
+                Actors.Reserve(ActorsArray->Num());
+                for (const TSharedPtr<FJsonValue>& Value : *ActorsArray)
+                {
+                        FString ActorPath;
+                        if (!Value.IsValid() || !Value->TryGetString(ActorPath))
+                        {
+                                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("actors must contain string identifiers"));
+                        }
+
+                        if (AActor* TargetActor = ResolveActor(ActorPath))
+                        {
+                                Actors.Add(TargetActor);
+                        }
+                        else
+                        {
+                                Missing.Add(MakeShared<FJsonValueString>(ActorPath));
+                        }
+                }
+        }
+        else if (Params->TryGetArrayField(TEXT("classNames"), ClassArray) && ClassArray->Num() > 0)
+        {
+                TArray<FString> ClassNames;
+                for (const TSharedPtr<FJsonValue>& Value : *ClassArray)
+                {
+                        FString ClassName;
+                        if (Value.IsValid() && Value->TryGetString(ClassName) && !ClassName.TrimStartAndEnd().IsEmpty())
+                        {
+                                ClassNames.Add(ClassName.TrimStartAndEnd());
+                        }
+                }
+                if (ClassNames.Num() == 0)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("classNames must contain class names"));
+                }
+
+                UWorld* World = GetEditorWorld();
+                if (!World)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("No editor world available"));
+                }
+
+                for (TActorIterator<AActor> It(World); It; ++It)
+                {
+                        if (MatchesClassNames(**It, ClassNames))
+                        {
+                                Actors.Add(*It);
+                        }
+                }
+                // Path order keeps repeated audits comparable and decides which actors a truncation keeps.
+                Algo::SortBy(Actors, [](const AActor* Actor) { return Actor->GetPathName(); });
+                if (Actors.Num() > MaxReadPropertiesActors)
+                {
+                        Actors.SetNum(MaxReadPropertiesActors);
+                        bTruncated = true;
+                }
+        }
+        else
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Provide actors or classNames"));
+        }
+
+        const int32 ColumnCount = Properties.Num();
+        FPropertyPathCache& Cache = FPropertyPathCache::Get();
+
+        // Paths are planned once per actor class and, past an object property or component, once per
+        // class of the object reached; each cell is then a typed read at a known offset.
+        TMap<const UClass*, TArray<FReadColumn>> Plans;
+        TMap<TPair<const UClass*, int32>, TOptional<FPropertyPathCache::FCompiledPath>> SubPaths;
+        TArray<TSet<FString>> Unresolved;
+        Unresolved.SetNum(ColumnCount);
+
+        TArray<TArray<TSharedPtr<FJsonValue>>> Columns;
+        Columns.SetNum(ColumnCount);
+        for (TArray<TSharedPtr<FJsonValue>>& Column : Columns)
+        {
+                Column.Reserve(Actors.Num());
+        }
+
+        TArray<TSharedPtr<FJsonValue>> ActorPaths;
+        ActorPaths.Reserve(Actors.Num());
+        TInlineComponentArray<UActorComponent*> Components;
+        for (AActor* Actor : Actors)
+        {
+                const UClass* ActorClass = Actor->GetClass();
+                TArray<FReadColumn>* Plan = Plans.Find(ActorClass);
+                if (!Plan)
+                {
+                        Plan = &Plans.Add(ActorClass);
+                        Plan->Reserve(ColumnCount);
+                        for (int32 ColumnIndex = 0; ColumnIndex < ColumnCount; ++ColumnIndex)
+                        {
+                                Plan->Add(PlanReadColumn(ActorClass, Properties[ColumnIndex]));
+                                if ((*Plan)[ColumnIndex].Kind == FReadColumn::EKind::Unresolved)
+                                {
+                                        Unresolved[ColumnIndex].Add(ActorClass->GetPathName());
+                                }
+                        }
+                }
+
+                ActorPaths.Add(MakeShared<FJsonValueString>(Actor->GetPathName()));
+                bool bComponentsGathered = false;
+                for (int32 ColumnIndex = 0; ColumnIndex < ColumnCount; ++ColumnIndex)
+                {
+                        const FReadColumn& Column = (*Plan)[ColumnIndex];
+                        const UObject* Source = nullptr;
+                        switch (Column.Kind)
+                        {
+                        case FReadColumn::EKind::Actor:
+                                Columns[ColumnIndex].Add(Column.Path.GetValue(Actor));
+                                continue;
+                        case FReadColumn::EKind::ObjectProperty:
+                                Source = CastFieldChecked<FObjectPropertyBase>(Column.Path.Leaf)->GetObjectPropertyValue(Column.Path.GetValuePtr(Actor));
+                                break;
+                        case FReadColumn::EKind::Component:
+                                if (!bComponentsGathered)
+                                {
+                                        Components.Reset();
+                                        Actor->GetComponents(Components);
+                                        bComponentsGathered = true;
+                                }
+                                for (const UActorComponent* Component : Components)
+                                {
+                                        if (Component && Component->GetFName() == Column.ComponentName)
+                                        {
+                                                Source = Component;
+                                                break;
+                                        }
+                                }
+                                break;
+                        default:
+                                break;
+                        }
+
+                        if (!Source)
+                        {
+                                Columns[ColumnIndex].Add(MakeShared<FJsonValueNull>());
+                                continue;
+                        }
+
+                        const UClass* SourceClass = Source->GetClass();
+                        TOptional<FPropertyPathCache::FCompiledPath>* SubPath = SubPaths.Find(TPair<const UClass*, int32>(SourceClass, ColumnIndex));
+                        if (!SubPath)
+                        {
+                                SubPath = &SubPaths.Add(TPair<const UClass*, int32>(SourceClass, ColumnIndex));
+                                FString Error;
+                                if (const FPropertyPathCache::FCompiledPath* Path = Cache.Resolve(SourceClass, Column.SubPath, Error))
+                                {
+                                        *SubPath = *Path;
+                                }
+                                else
+                                {
+                                        Unresolved[ColumnIndex].Add(SourceClass->GetPathName());
+                                }
+                        }
+
+                        Columns[ColumnIndex].Add(SubPath->IsSet() ? SubPath->GetValue().GetValue(Source) : MakeShared<FJsonValueNull>());
+                }
+        }
+
+        TArray<TSharedPtr<FJsonValue>> PropertiesJson;
+        TArray<TSharedPtr<FJsonValue>> ColumnsJson;
+        TArray<TSharedPtr<FJsonValue>> UnresolvedJson;
+        for (int32 ColumnIndex = 0; ColumnIndex < ColumnCount; ++ColumnIndex)
+        {
+                PropertiesJson.Add(MakeShared<FJsonValueString>(Properties[ColumnIndex]));
+                ColumnsJson.Add(MakeShared<FJsonValueArray>(MoveTemp(Columns[ColumnIndex])));
+
+                TArray<FString> ClassPaths = Unresolved[ColumnIndex].Array();
+                ClassPaths.Sort();
+                TArray<TSharedPtr<FJsonValue>> ClassesJson;
+                for (const FString& ClassPath : ClassPaths)
+                {
+                        ClassesJson.Add(MakeShared<FJsonValueString>(ClassPath));
+                }
+                UnresolvedJson.Add(MakeShared<FJsonValueArray>(ClassesJson));
+        }
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetArrayField(TEXT("properties"), PropertiesJson);
+        Data->SetArrayField(TEXT("actors"), ActorPaths);
+        Data->SetArrayField(TEXT("columns"), ColumnsJson);
+        Data->SetArrayField(TEXT("unresolved"), UnresolvedJson);
+        Data->SetArrayField(TEXT("missing"), Missing);
+        Data->SetNumberField(TEXT("count"), ActorPaths.Num());
+        Data->SetBoolField(TEXT("truncated"), bTruncated);
+        return MakeSuccessResponse(Data);
+}
@@ -0,0 +1,379 @@
+#include "Actors/InstanceTools.h"
+#include "CoreMinimal.h"
+
+#include "Actors/ActorIndex.h"
+#include "Actors/ActorTools.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "FoliageInstancedStaticMeshComponent.h"
+#include "FoliageType.h"
+#include "GameFramework/Actor.h"
+#include "InstancedFoliage.h"
+#include "InstancedFoliageActor.h"
+#include "Permissions/WriteGate.h"
+#include "ScopedTransaction.h"
+#include "Transactions/BulkEdit.h"
+#include "Transactions/TransactionManager.h"
+
+namespace
+{
+        constexpr const TCHAR* ErrorCodeInvalidParams = TEXT("INVALID_PARAMETERS");
+        constexpr const TCHAR* ErrorCodeAssetNotFound = TEXT("ASSET_NOT_FOUND");
+        constexpr const TCHAR* ErrorCodeActorNotFound = TEXT("ACTOR_NOT_FOUND");
+        constexpr const TCHAR* ErrorCodeSpawnFailed = TEXT("SPAWN_FAILED");
+
+        constexpr int32 MaxInstanceBatchCount = 500000;
+
+        TSharedPtr<FJsonObject> MakeErrorResponse(const FString& Code, const FString& Message)
+        {
+                TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+                Error->SetBoolField(TEXT("success"), false);
+                Error->SetStringField(TEXT("errorCode"), Code);
+                Error->SetStringField(TEXT("error"), Message);
+                return Error;
+        }
+
+        TSharedPtr<FJsonObject> MakeSuccessResponse(const TSharedPtr<FJsonObject>& Payload)
+        {
+                TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+                Result->SetBoolField(TEXT("success"), true);
+                if (Payload.IsValid())
+                {
+                        Result->SetObjectField(TEXT("data"), Payload);
+                }
+                return Result;
+        }
+
+        /** Instances are level content, so they always go to the editor world, never to PIE. */
+        UWorld* GetEditorWorld()
+        {
+                return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+        }
+
+        bool ReadTransforms(const FJsonObject& Params, TArray<FTransform>& OutTransforms, TSharedPtr<FJsonObject>& OutError)
+        {
+                FString ParseError;
+                if (!FActorTools::ParsePackedTransforms(Params, INDEX_NONE, OutTransforms, ParseError))
+                {
+                        OutError = MakeErrorResponse(ErrorCodeInvalidParams, ParseError);
+                        return false;
+                }
+                if (OutTransforms.Num() > MaxInstanceBatchCount)
+                {
+                        OutError = MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("At most %d instances per batch"), MaxInstanceBatchCount));
+                        return false;
+                }
+                return true;
+        }
+
+        template <typename TObjectType>
+        TObjectType* LoadAsset(const FJsonObject& Params, const TCHAR* Field, FString& OutPath)
+        {
+                if (!Params.TryGetStringField(Field, OutPath))
+                {
+                        return nullptr;
+                }
+                OutPath.TrimStartAndEndInline();
+                return OutPath.IsEmpty() ? nullptr : LoadObject<TObjectType>(nullptr, *OutPath);
+        }
+
+        bool GetBoolParam(const FJsonObject& Params, const TCHAR* Field, bool bDefault)
+        {
+                return Params.HasTypedField<EJson::Boolean>(Field) ? Params.GetBoolField(Field) : bDefault;
+        }
+
+        /** An instanced component of Actor showing Mesh, or the one called ComponentName. */
+        UInstancedStaticMeshComponent* FindInstancedComponent(AActor& Actor, const UStaticMesh* Mesh, const FString& ComponentName)
+        {
+                TInlineComponentArray<UInstancedStaticMeshComponent*> Components(&Actor);
+                for (UInstancedStaticMeshComponent* Component : Components)
+                {
+                        if (!Component || Component->IsEditorOnly() || Component->IsA<UFoliageInstancedStaticMeshComponent>())
+                        {
+                                continue;
+                        }
+                        if (ComponentName.IsEmpty() ? Component->GetStaticMesh() == Mesh : Component->GetName() == ComponentName)
+                        {
+                                return Component;
+                        }
+                }
+                return nullptr;
+        }
+
+        UInstancedStaticMeshComponent* CreateInstancedComponent(AActor& Actor, UStaticMesh* Mesh, const FString& ComponentName, bool bHierarchical)
+        {
+                UClass* ComponentClass = bHierarchical ? UHierarchicalInstancedStaticMeshComponent::StaticClass() : UInstancedStaticMeshComponent::StaticClass();
+                const FName Name = ComponentName.IsEmpty()
+                        ? MakeUniqueObjectName(&Actor, ComponentClass, Mesh->GetFName())
+                        : FName(*ComponentName);
+
+                Actor.Modify();
+                UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(&Actor, ComponentClass, Name, RF_Transactional);
+                Component->SetStaticMesh(Mesh);
+                if (USceneComponent* Root = Actor.GetRootComponent())
+                {
+                        Component->SetMobility(Root->Mobility);
+                        Component->SetupAttachment(Root);
+                }
+                else
+                {
+                        Component->SetMobility(EComponentMobility::Static);
+                        Actor.SetRootComponent(Component);
+                }
+                Actor.AddInstanceComponent(Component);
+                Component->OnComponentCreated();
+                Component->RegisterComponent();
+                return Component;
+        }
+}
+
+TSharedPtr<FJsonObject> FInstanceTools::FoliageAddInstances(const TSharedPtr<FJsonObject>& Params)
+{
+        if (!Params.IsValid())
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+        }
+
+        FString SourcePath;
+        UFoliageType* FoliageTypeAsset = nullptr;
+        UStaticMesh* Mesh = nullptr;
+        if (Params->HasField(TEXT("foliageType")))
+        {
+                FoliageTypeAsset = LoadAsset<UFoliageType>(*Params, TEXT("foliageType"), SourcePath);
+                if (!FoliageTypeAsset)
+                {
+                        return MakeErrorResponse(ErrorCodeAssetNotFound, FString::Printf(TEXT("Unable to load a foliage type: %s"), *SourcePath));
+                }
+        }
+        else
+        {
+                Mesh = LoadAsset<UStaticMesh>(*Params, TEXT("mesh"), SourcePath);
+                if (!Mesh)
+                {
+                        return SourcePath.IsEmpty()
+                                ? MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing mesh or foliageType parameter"))
+                                : MakeErrorResponse(ErrorCodeAssetNotFound, FString::Printf(TEXT("Unable to load a static mesh: %s"), *SourcePath));
+                }
+        }
+
+        TArray<FTransform> Transforms;
+        TSharedPtr<FJsonObject> Error;
+        if (!ReadTransforms(*Params, Transforms, Error))
+        {
+                return Error;
+        }
+
+        UWorld* World = GetEditorWorld();
+        if (!World || !World->GetCurrentLevel())
+        {
+                return MakeErrorResponse(ErrorCodeSpawnFailed, TEXT("Editor world is unavailable"));
+        }
+
+        TArray<TSharedPtr<FJsonValue>> Results;
+        {
+                FScopedTransaction Transaction(FText::FromString(FWriteGate::GetTransactionName()), !FTransactionManager::IsUndoSuppressed());
+
+                // A partitioned world keeps one foliage actor per grid cell, so each instance goes to the
+                // actor owning its location; an unpartitioned level has one actor for all of them.
+                TMap<AInstancedFoliageActor*, TArray<FFoliageInstance>> InstancesByActor;
+                ULevel* Level = World->GetCurrentLevel();
+                for (const FTransform& Transform : Transforms)
+                {
+                        AInstancedFoliageActor* FoliageActor = AInstancedFoliageActor::Get(World, true, Level, Transform.GetLocation());
+                        if (!FoliageActor)
+                        {
+                                return MakeErrorResponse(ErrorCodeSpawnFailed, TEXT("Unable to find or create an instanced foliage actor"));
+                        }
+
+                        FFoliageInstance Instance;
+                        Instance.Location = Transform.GetLocation();
+                        Instance.Rotation = Transform.Rotator();
+                        Instance.PreAlignRotation = Instance.Rotation;
+                        Instance.DrawScale3D = FVector3f(Transform.GetScale3D());
+                        InstancesByActor.FindOrAdd(FoliageActor).Add(Instance);
+                }
+
+                for (TPair<AInstancedFoliageActor*, TArray<FFoliageInstance>>& Pair : InstancesByActor)
+                {
+                        AInstancedFoliageActor* FoliageActor = Pair.Key;
+                        FoliageActor->Modify();
+
+                        FFoliageInfo* Info = nullptr;
+                        UFoliageType* FoliageType = nullptr;
+                        if (FoliageTypeAsset)
+                        {
+                                FoliageType = FoliageActor->AddFoliageType(FoliageTypeAsset, &Info);
+                        }
+                        else
+                        {
+                                FoliageType = FoliageActor->GetLocalFoliageTypeForSource(Mesh, &Info);
+                                if (!FoliageType)
+                                {
+                                        Info = FoliageActor->AddMesh(Mesh, &FoliageType);
+                                }
+                        }
+                        if (!FoliageType || !Info)
+                        {
+                                return MakeErrorResponse(ErrorCodeSpawnFailed, FString::Printf(TEXT("Unable to add %s to %s"), *SourcePath, *FoliageActor->GetPathName()));
+                        }
+
+                        // One call per foliage type and actor: the component is updated in a single pass.
+                        TArray<const FFoliageInstance*> NewInstances;
+                        NewInstances.Reserve(Pair.Value.Num());
+                        for (const FFoliageInstance& Instance : Pair.Value)
+                        {
+                                NewInstances.Add(&Instance);
+                        }
+                        Info->AddInstances(FoliageType, NewInstances);
+
+                        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+                        Entry->SetStringField(TEXT("foliageActor"), FoliageActor->GetPathName());
+                        Entry->SetStringField(TEXT("foliageType"), FoliageType->GetPathName());
+                        Entry->SetNumberField(TEXT("added"), NewInstances.Num());
+                        Entry->SetNumberField(TEXT("instanceCount"), Info->Instances.Num());
+                        Results.Add(MakeShared<FJsonValueObject>(Entry));
+                }
+        }
+
+        FBulkEdit::NoteActorListChanged();
+        FBulkEdit::RedrawViewports(true);
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetNumberField(TEXT("added"), Transforms.Num());
+        Data->SetStringField(TEXT("source"), SourcePath);
+        Data->SetArrayField(TEXT("foliageActors"), Results);
+        return MakeSuccessResponse(Data);
+}
+
+TSharedPtr<FJsonObject> FInstanceTools::IsmAddInstances(const TSharedPtr<FJsonObject>& Params)
+{
+        if (!Params.IsValid())
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+        }
+
+        FString MeshPath;
+        UStaticMesh* Mesh = LoadAsset<UStaticMesh>(*Params, TEXT("mesh"), MeshPath);
+        if (!Mesh)
+        {
+                return MeshPath.IsEmpty()
+                        ? MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing mesh parameter"))
+                        : MakeErrorResponse(ErrorCodeAssetNotFound, FString::Printf(TEXT("Unable to load a static mesh: %s"), *MeshPath));
+        }
+
+        TArray<FTransform> Transforms;
+        TSharedPtr<FJsonObject> Error;
+        if (!ReadTransforms(*Params, Transforms, Error))
+        {
+                return Error;
+        }
+
+        UWorld* World = GetEditorWorld();
+        if (!World)
+        {
+                return MakeErrorResponse(ErrorCodeSpawnFailed, TEXT("Editor world is unavailable"));
+        }
+
+        FString ActorIdentifier;
+        FString ComponentName;
+        FString Label;
+        FString Folder;
+        Params->TryGetStringField(TEXT("actor"), ActorIdentifier);
+        Params->TryGetStringField(TEXT("component"), ComponentName);
+        Params->TryGetStringField(TEXT("label"), Label);
+        Params->TryGetStringField(TEXT("folder"), Folder);
+        ActorIdentifier.TrimStartAndEndInline();
+        ComponentName.TrimStartAndEndInline();
+        const bool bHierarchical = GetBoolParam(*Params, TEXT("hierarchical"), true);
+        const bool bWorldSpace = GetBoolParam(*Params, TEXT("worldSpace"), true);
+
+        // The target is resolved before the transaction opens, so a bad identifier changes nothing.
+        AActor* TargetActor = nullptr;
+        if (!ActorIdentifier.IsEmpty())
+        {
+                TargetActor = FindObject<AActor>(nullptr, *ActorIdentifier);
+                if (!TargetActor)
+                {
+                        TargetActor = FActorIndex::Get().Resolve(World, ActorIdentifier);
+                }
+                if (!TargetActor)
+                {
+                        return MakeErrorResponse(ErrorCodeActorNotFound, FString::Printf(TEXT("Actor not found: %s"), *ActorIdentifier));
+                }
+                if (TargetActor->IsA<AInstancedFoliageActor>())
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Foliage actors keep their own instance lists; use foliage.add_instances"));
+                }
+        }
+
+        UInstancedStaticMeshComponent* Component = TargetActor ? FindInstancedComponent(*TargetActor, Mesh, ComponentName) : nullptr;
+        if (Component && !ComponentName.IsEmpty() && Component->GetStaticMesh() != Mesh)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("Component %s shows %s, not %s"),
+                        *ComponentName, *GetPathNameSafe(Component->GetStaticMesh()), *MeshPath));
+        }
+
+        bool bCreatedActor = false;
+        bool bCreatedComponent = false;
+        int32 FirstIndex = 0;
+        {
+                FScopedTransaction Transaction(FText::FromString(FWriteGate::GetTransactionName()), !FTransactionManager::IsUndoSuppressed());
+
+                if (!TargetActor)
+                {
+                        // A new actor sits at the first instance, so its pivot is somewhere meaningful.
+                        FActorSpawnParameters SpawnParameters;
+                        SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+                        SpawnParameters.ObjectFlags |= RF_Transactional;
+                        TargetActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Transforms[0].GetLocation()), SpawnParameters);
+                        if (!TargetActor)
+                        {
+                                return MakeErrorResponse(ErrorCodeSpawnFailed, TEXT("Failed to spawn an actor for the instances"));
+                        }
+                        bCreatedActor = true;
+                }
+
+                if (!Component)
+                {
+                        Component = CreateInstancedComponent(*TargetActor, Mesh, ComponentName, bHierarchical);
+                        bCreatedComponent = true;
+                        if (bCreatedActor)
+                        {
+                                Component->SetWorldLocation(Transforms[0].GetLocation());
+                                TargetActor->SetActorLabel(Label.IsEmpty() ? FString::Printf(TEXT("ISM_%s"), *Mesh->GetName()) : Label, /*bMarkDirty*/ false);
+                                if (!Folder.IsEmpty())
+                                {
+                                        TargetActor->SetFolderPath(FName(*Folder));
+                                }
+                        }
+                }
+
+                // AddInstances marks the render state dirty once for the whole batch, and a HISM
+                // rebuilds its tree once, instead of once per AddInstance.
+                Component->Modify();
+                FirstIndex = Component->GetInstanceCount();
+                Component->AddInstances(Transforms, /*bShouldReturnIndices*/ false, bWorldSpace);
+        }
+
+        if (bCreatedActor)
+        {
+                FBulkEdit::NoteActorListChanged();
+        }
+        FBulkEdit::RedrawViewports(true);
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetStringField(TEXT("actorPath"), TargetActor->GetPathName());
+        Data->SetStringField(TEXT("componentPath"), Component->GetPathName());
+        Data->SetBoolField(TEXT("createdActor"), bCreatedActor);
+        Data->SetBoolField(TEXT("createdComponent"), bCreatedComponent);
+        Data->SetBoolField(TEXT("hierarchical"), Component->IsA<UHierarchicalInstancedStaticMeshComponent>());
+        Data->SetNumberField(TEXT("added"), Transforms.Num());
+        Data->SetNumberField(TEXT("firstIndex"), FirstIndex);
+        Data->SetNumberField(TEXT("instanceCount"), Component->GetInstanceCount());
+        return MakeSuccessResponse(Data);
+}
@@ -0,0 +1,372 @@
+#include "Actors/WorldChangeLog.h"
+#include "CoreMinimal.h"
+
+#include "Algo/Sort.h"
+#include "Components/ActorComponent.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "Protocol/CommandContext.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UnrealMCPSettings.h"
+
+#include <algorithm>
+
+namespace
+{
+        TArray<TSharedPtr<FJsonValue>> VectorToJson(const FVector& Vector)
+        {
+                return { MakeShared<FJsonValueNumber>(Vector.X), MakeShared<FJsonValueNumber>(Vector.Y), MakeShared<FJsonValueNumber>(Vector.Z) };
+        }
+}
+
+FWorldChangeLog& FWorldChangeLog::Get()
+{
+        static FWorldChangeLog Instance;
+        return Instance;
+}
+
+void FWorldChangeLog::Start()
+{
+        check(IsInGameThread());
+        if (bStarted)
+        {
+                return;
+        }
+        bStarted = true;
+        MaxEntries = GetDefault<UUnrealMCPSettings>()->WorldChangeLogMaxActors;
+        ResetEpoch();
+
+        if (GEngine)
+        {
+                ActorAddedHandle = GEngine->OnLevelActorAdded().AddLambda([this](AActor* Actor) { Record(Actor, Added); });
+                ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddLambda([this](AActor* Actor) { Record(Actor, Deleted); });
+        }
+        if (GEditor)
+        {
+                ActorMovedHandle = GEditor->OnActorMoved().AddLambda([this](AActor* Actor) { Record(Actor, Moved); });
+        }
+        ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddLambda([this](AActor* Actor) { Record(Actor, Relabelled); });
+        PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([this](UObject* Object, FPropertyChangedEvent& Event)
+        {
+                const FName PropertyName = Event.GetMemberPropertyName();
+                if (AActor* Actor = Cast<AActor>(Object))
+                {
+                        Record(Actor, PropertiesEdited, PropertyName.IsNone() ? FString() : PropertyName.ToString());
+                }
+                else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+                {
+                        Record(Component->GetOwner(), PropertiesEdited, PropertyName.IsNone() ? Component->GetName() : Component->GetName() + TEXT(".") + PropertyName.ToString());
+                }
+        });
+
+        // Mutations Modify() what they change, components included, before any of the notifications above.
+        ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddLambda([this](UObject* Object)
+        {
+                if (AActor* Actor = Cast<AActor>(Object))
+                {
+                        NoteTouched(Actor);
+                }
+                else if (const UActorComponent* Component = Cast<UActorComponent>(Object))
+                {
+                        NoteTouched(Component->GetOwner());
+                }
+        });
+
+        PostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddLambda([this]() { ForceResync(); });
+        LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddLambda([this](ULevel*, UWorld* World)
+        {
+                if (World == TrackedWorld.Get())
+                {
+                        ForceResync();
+                }
+        });
+        LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddLambda([this](ULevel*, UWorld* World)
+        {
+                if (World == TrackedWorld.Get())
+                {
+                        ForceResync();
+                }
+        });
+        WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddLambda([this](UWorld* World, bool, bool)
+        {
+                if (World == TrackedWorld.Get())
+                {
+                        ResetEpoch();
+                }
+        });
+}
+
+void FWorldChangeLog::Stop()
+{
+        if (!bStarted)
+        {
+                return;
+        }
+        bStarted = false;
+
+        if (GEngine)
+        {
+                GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+                GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+        }
+        if (GEditor)
+        {
+                GEditor->OnActorMoved().Remove(ActorMovedHandle);
+        }
+        FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+        FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+        FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+        FEditorDelegates::PostUndoRedo.Remove(PostUndoRedoHandle);
+        FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+        FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+        FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+
+        Entries.Empty();
+        TouchedPackages.Empty();
+        TouchedKeys.Empty();
+        TrackedWorld.Reset();
+}
+
+void FWorldChangeLog::ChangesSince(const FString& Token, int32 Limit, FDelta& OutDelta)
+{
+        check(IsInGameThread());
+
+        // Nothing recorded yet may still belong to a world opened since the last change.
+        if (GEditor && GEditor->GetEditorWorldContext().World() != TrackedWorld.Get())
+        {
+                ResetEpoch();
+                TrackedWorld = GEditor->GetEditorWorldContext().World();
+        }
+
+        int64 Since = 0;
+        if (!ParseToken(Token, Since) || Since < FloorSeq || Since > Seq)
+        {
+                OutDelta.bResync = true;
+                OutDelta.Token = MakeToken(Seq);
+                return;
+        }
+
+        for (const TPair<FObjectKey, FEntry>& Pair : Entries)
+        {
+                if (Pair.Value.Seq > Since)
+                {
+                        OutDelta.Entries.Add(Pair.Value);
+                }
+        }
+        Algo::SortBy(OutDelta.Entries, &FEntry::Seq);
+
+        if (OutDelta.Entries.Num() > Limit)
+        {
+                OutDelta.Entries.SetNum(Limit);
+                OutDelta.bMore = true;
+                OutDelta.Token = MakeToken(OutDelta.Entries.Last().Seq);
+        }
+        else
+        {
+                OutDelta.Token = MakeToken(Seq);
+        }
+}
+
+TSharedRef<FJsonObject> FWorldChangeLog::EntryToJson(const FEntry& Entry)
+{
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+        AActor* Actor = Entry.Actor.Get();
+        const bool bGone = (Entry.Changes & Deleted) != 0 || !IsValid(Actor);
+        Json->SetStringField(TEXT("path"), bGone ? Entry.Path : Actor->GetPathName());
+        if (bGone)
+        {
+                Json->SetStringField(TEXT("change"), TEXT("deleted"));
+                return Json;
+        }
+
+        const bool bAdded = (Entry.Changes & Added) != 0;
+        Json->SetStringField(TEXT("change"), bAdded ? TEXT("added") : TEXT("updated"));
+        Json->SetStringField(TEXT("name"), Actor->GetName());
+        if (bAdded)
+        {
+                Json->SetStringField(TEXT("class"), Actor->GetClass()->GetPathName());
+        }
+        if (bAdded || (Entry.Changes & Relabelled))
+        {
+                Json->SetStringField(TEXT("label"), Actor->GetActorLabel());
+        }
+        if (bAdded || (Entry.Changes & Moved))
+        {
+                Json->SetArrayField(TEXT("location"), VectorToJson(Actor->GetActorLocation()));
+                const FRotator Rotation = Actor->GetActorRotation();
+                Json->SetArrayField(TEXT("rotation"), VectorToJson(FVector(Rotation.Pitch, Rotation.Yaw, Rotation.Roll)));
+                Json->SetArrayField(TEXT("scale"), VectorToJson(Actor->GetActorScale3D()));
+        }
+        if (!bAdded && (Entry.Changes & PropertiesEdited))
+        {
+                if (Entry.bManyProperties)
+                {
+                        Json->SetBoolField(TEXT("manyProperties"), true);
+                }
+                else
+                {
+                        TArray<FString> Names = Entry.Properties.Array();
+                        Names.Sort();
+                        TArray<TSharedPtr<FJsonValue>> NameValues;
+                        for (const FString& Name : Names)
+                        {
+                                NameValues.Add(MakeShared<FJsonValueString>(Name));
+                        }
+                        Json->SetArrayField(TEXT("properties"), NameValues);
+                }
+        }
+        return Json;
+}
+
+FString FWorldChangeLog::MakeToken(int64 InSeq) const
+{
+        return FString::Printf(TEXT("w1:%s:%lld"), *Epoch.ToString(EGuidFormats::Digits), InSeq);
+}
+
+bool FWorldChangeLog::ParseToken(const FString& Token, int64& OutSeq) const
+{
+        TArray<FString> Parts;
+        if (Token.ParseIntoArray(Parts, TEXT(":"), false) != 3 || Parts[0] != TEXT("w1"))
+        {
+                return false;
+        }
+
+        FGuid TokenEpoch;
+        return FGuid::Parse(Parts[1], TokenEpoch) && TokenEpoch == Epoch && LexTryParseString(OutSeq, *Parts[2]);
+}
+
+bool FWorldChangeLog::IsTracked(const AActor* Actor)
+{
+        if (!bStarted || !Actor || !GEditor)
+        {
+                return false;
+        }
+
+        UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
+        if (!EditorWorld || Actor->GetWorld() != EditorWorld)
+        {
+                return false;
+        }
+        if (TrackedWorld.Get() != EditorWorld)
+        {
+                ResetEpoch();
+                TrackedWorld = EditorWorld;
+        }
+        return true;
+}
+
+void FWorldChangeLog::Record(AActor* Actor, uint8 Change, const FString& Property)
+{
+        if (!IsTracked(Actor))
+        {
+                return;
+        }
+
+        NoteTouched(Actor);
+
+        FEntry& Entry = Entries.FindOrAdd(FObjectKey(Actor));
+        Entry.Actor = Actor;
+        Entry.Path = Actor->GetPathName();
+        Entry.Seq = ++Seq;
+        Entry.Changes |= Change;
+        if ((Change & PropertiesEdited) && !Entry.bManyProperties)
+        {
+                if (Property.IsEmpty() || Entry.Properties.Num() >= MaxPropertiesPerEntry)
+                {
+                        Entry.bManyProperties = true;
+                        Entry.Properties.Empty();
+                }
+                else
+                {
+                        Entry.Properties.Add(Property);
+                }
+        }
+
+        if (Entries.Num() > MaxEntries)
+        {
+                Evict();
+        }
+}
+
+void FWorldChangeLog::Evict()
+{
+        TArray<int64> Seqs;
+        Seqs.Reserve(Entries.Num());
+        for (const TPair<FObjectKey, FEntry>& Pair : Entries)
+        {
+                Seqs.Add(Pair.Value.Seq);
+        }
+
+        // Dropping a quarter at a time keeps eviction off the path of every later change.
+        const int32 Cut = FMath::Max(Seqs.Num() / 4, 1) - 1;
+        std::nth_element(Seqs.GetData(), Seqs.GetData() + Cut, Seqs.GetData() + Seqs.Num());
+        const int64 Cutoff = Seqs[Cut];
+        for (auto It = Entries.CreateIterator(); It; ++It)
+        {
+                if (It->Value.Seq <= Cutoff)
+                {
+                        It.RemoveCurrent();
+                }
+        }
+        FloorSeq = FMath::Max(FloorSeq, Cutoff);
+}
+
+void FWorldChangeLog::ForceResync()
+{
+        Entries.Reset();
+        FloorSeq = ++Seq;
+}
+
+void FWorldChangeLog::NoteTouched(AActor* Actor)
+{
+        if (!UnrealMCP::Protocol::FCommandContext::GetActive() || !IsTracked(Actor))
+        {
+                return;
+        }
+
+        const FObjectKey Key(Actor->GetPackage());
+        bool bAlreadyTouched = false;
+        TouchedKeys.Add(Key, &bAlreadyTouched);
+        if (!bAlreadyTouched)
+        {
+                TouchedPackages.Add(Key);
+        }
+}
+
+void FWorldChangeLog::GetTouchedPackages(TArray<UPackage*>& OutPackages)
+{
+        check(IsInGameThread());
+
+        TArray<FObjectKey> StillDirty;
+        StillDirty.Reserve(TouchedPackages.Num());
+        for (const FObjectKey& Key : TouchedPackages)
+        {
+                UPackage* Package = Cast<UPackage>(Key.ResolveObjectPtr());
+                if (Package && Package->IsDirty())
+                {
+                        OutPackages.Add(Package);
+                        StillDirty.Add(Key);
+                }
+                else
+                {
+                        TouchedKeys.Remove(Key);
+                }
+        }
+        TouchedPackages = MoveTemp(StillDirty);
+}
+
+void FWorldChangeLog::ResetEpoch()
+{
+        Entries.Reset();
+        TouchedPackages.Reset();
+        TouchedKeys.Reset();
+        Epoch = FGuid::NewGuid();
+        Seq = 0;
+        FloorSeq = 0;
+}
@@ -0,0 +1,259 @@
+#include "Assets/AssetClassResolver.h"
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeRWLock.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Object.h"
+#include "UObject/UObjectGlobals.h"
+#include "UnrealMCPLog.h"
+
+namespace
+{
+    /** Leftovers of Blueprint compilation and hot reload that no asset is an instance of. */
+    bool IsTransientClassName(const FString& Name)
+    {
+        return Name.StartsWith(TEXT("SKEL_")) || Name.StartsWith(TEXT("REINST_")) || Name.StartsWith(TEXT("HOTRELOADED_"));
+    }
+}
+
+FAssetClassResolver& FAssetClassResolver::Get()
+{
+    static FAssetClassResolver Resolver;
+    return Resolver;
+}
+
+void FAssetClassResolver::Start()
+{
+    check(IsInGameThread());
+    if (ModulesChangedHandle.IsValid())
+    {
+        return;
+    }
+
+    ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([this](FName, EModuleChangeReason Reason)
+    {
+        if (Reason == EModuleChangeReason::ModuleLoaded || Reason == EModuleChangeReason::ModuleUnloaded)
+        {
+            Invalidate();
+        }
+    });
+    ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+    {
+        Invalidate();
+    });
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FAssetClassResolver::HandleAssetChanged);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FAssetClassResolver::HandleAssetChanged);
+    AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FAssetClassResolver::HandleAssetUpdated);
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FAssetClassResolver::HandleAssetRenamed);
+}
+
+void FAssetClassResolver::Stop()
+{
+    if (ModulesChangedHandle.IsValid())
+    {
+        FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+        FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+    }
+    if (FAssetRegistryModule* Module = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+    {
+        IAssetRegistry& AssetRegistry = Module->Get();
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+        AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+    }
+    ModulesChangedHandle.Reset();
+    ReloadCompleteHandle.Reset();
+    AssetAddedHandle.Reset();
+    AssetRemovedHandle.Reset();
+    AssetUpdatedHandle.Reset();
+    AssetRenamedHandle.Reset();
+    Invalidate();
+}
+
+void FAssetClassResolver::HandleAssetChanged(const FAssetData& AssetData)
+{
+    // Only Blueprints add or remove classes; every other asset leaves the table as it is.
+    if ((bBuilt || bHasClosures) && AssetData.TagsAndValues.Contains(FBlueprintTags::GeneratedClassPath))
+    {
+        Invalidate();
+    }
+}
+
+void FAssetClassResolver::HandleAssetUpdated(const FAssetData& AssetData)
+{
+    // A saved Blueprint keeps its class but may have a new parent, which moves it in the tree.
+    if (bHasClosures && AssetData.TagsAndValues.Contains(FBlueprintTags::GeneratedClassPath))
+    {
+        InvalidateClosures();
+    }
+}
+
+void FAssetClassResolver::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    // A renamed Blueprint's class has a new path, so both the name and the closures are stale.
+    HandleAssetChanged(AssetData);
+}
+
+void FAssetClassResolver::Invalidate()
+{
+    FWriteScopeLock WriteLock(Lock);
+    bBuilt = false;
+    ClassesByName.Reset();
+    ++ClosureGeneration;
+    bHasClosures = false;
+    DerivedByBase.Reset();
+}
+
+void FAssetClassResolver::InvalidateClosures()
+{
+    FWriteScopeLock WriteLock(Lock);
+    ++ClosureGeneration;
+    bHasClosures = false;
+    DerivedByBase.Reset();
+}
+
+void FAssetClassResolver::ExpandDerivedClasses(TArray<FTopLevelAssetPath>& InOutPaths)
+{
+    if (InOutPaths.Num() == 0)
+    {
+        return;
+    }
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    // Blueprint classes keep arriving during the initial scan, so closures taken then are not kept.
+    const bool bCanCache = !AssetRegistry.IsLoadingAssets();
+
+    TSet<FTopLevelAssetPath> Seen(InOutPaths);
+    const int32 BaseCount = InOutPaths.Num();
+    for (int32 BaseIndex = 0; BaseIndex < BaseCount; ++BaseIndex)
+    {
+        const FTopLevelAssetPath Base = InOutPaths[BaseIndex];
+        TSharedPtr<const TArray<FTopLevelAssetPath>, ESPMode::ThreadSafe> Derived;
+        {
+            FReadScopeLock ReadLock(Lock);
+            if (const TSharedRef<const TArray<FTopLevelAssetPath>, ESPMode::ThreadSafe>* Found = DerivedByBase.Find(Base))
+            {
+                Derived = *Found;
+            }
+        }
+
+        if (!Derived.IsValid())
+        {
+            const uint32 Generation = ClosureGeneration;
+            TSet<FTopLevelAssetPath> DerivedSet;
+            AssetRegistry.GetDerivedClassNames({ Base }, TSet<FTopLevelAssetPath>(), DerivedSet);
+            DerivedSet.Remove(Base);
+            TSharedRef<const TArray<FTopLevelAssetPath>, ESPMode::ThreadSafe> Computed = MakeShared<const TArray<FTopLevelAssetPath>, ESPMode::ThreadSafe>(DerivedSet.Array());
+            Derived = Computed;
+
+            if (bCanCache)
+            {
+                FWriteScopeLock WriteLock(Lock);
+                if (Generation == ClosureGeneration)
+                {
+                    DerivedByBase.Add(Base, Computed);
+                    bHasClosures = true;
+                }
+            }
+        }
+
+        for (const FTopLevelAssetPath& ClassPath : *Derived)
+        {
+            bool bAlreadySeen = false;
+            Seen.Add(ClassPath, &bAlreadySeen);
+            if (!bAlreadySeen)
+            {
+                InOutPaths.Add(ClassPath);
+            }
+        }
+    }
+}
+
+void FAssetClassResolver::Prewarm()
+{
+    EnsureBuilt();
+}
+
+bool FAssetClassResolver::Resolve(const FString& ClassName, TArray<FTopLevelAssetPath>& OutPaths)
+{
+    FString Name = ClassName;
+    Name.TrimStartAndEndInline();
+    if (Name.IsEmpty())
+    {
+        return false;
+    }
+
+    if (Name.Contains(TEXT(".")) || Name.Contains(TEXT("/")))
+    {
+        const FTopLevelAssetPath ParsedPath(Name);
+        if (ParsedPath.IsNull())
+        {
+            return false;
+        }
+        OutPaths.AddUnique(ParsedPath);
+        return true;
+    }
+
+    EnsureBuilt();
+
+    FReadScopeLock ReadLock(Lock);
+    const TArray<FTopLevelAssetPath, TInlineAllocator<1>>* Found = ClassesByName.Find(Name.ToLower());
+    // C++ spellings: UStaticMesh, AActor.
+    if (!Found && Name.Len() > 1 && (Name[0] == TEXT('U') || Name[0] == TEXT('A')) && FChar::IsUpper(Name[1]))
+    {
+        Found = ClassesByName.Find(Name.RightChop(1).ToLower());
+    }
+    if (!Found)
+    {
+        return false;
+    }
+
+    for (const FTopLevelAssetPath& Path : *Found)
+    {
+        OutPaths.AddUnique(Path);
+    }
+    return true;
+}
+
+void FAssetClassResolver::EnsureBuilt()
+{
+    if (bBuilt)
+    {
+        return;
+    }
+
+    FWriteScopeLock WriteLock(Lock);
+    if (bBuilt)
+    {
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+    // Every class derives from UObject, so this is the registry's whole class table, Blueprints included.
+    TSet<FTopLevelAssetPath> ClassPaths;
+    AssetRegistry.GetDerivedClassNames({ UObject::StaticClass()->GetClassPathName() }, TSet<FTopLevelAssetPath>(), ClassPaths);
+
+    ClassesByName.Reset();
+    ClassesByName.Reserve(ClassPaths.Num());
+    for (const FTopLevelAssetPath& ClassPath : ClassPaths)
+    {
+        const FString Name = ClassPath.GetAssetName().ToString();
+        if (!IsTransientClassName(Name))
+        {
+            ClassesByName.FindOrAdd(Name.ToLower()).AddUnique(ClassPath);
+        }
+    }
+
+    bBuilt = true;
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("FAssetClassResolver: %d classes indexed in %.1f ms"), ClassPaths.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
@@ -1,18 +1,27 @@
 #include "Assets/AssetCrud.h"
 #include "CoreMinimal.h"
 
+#include "Assets/PackageSaver.h"
+#include "Assets/RedirectorFixup.h"
 #include "AssetRegistry/AssetData.h"
 #include "AssetRegistry/ARFilter.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetRegistry/IAssetRegistry.h"
 #include "AssetToolsModule.h"
+#include "AssetTools/AssetRenameData.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "EditorAssetLibrary.h"
+#include "EditorLoadingAndSavingUtils.h"
 #include "FileHelpers.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/PackageName.h"
 #include "Modules/ModuleManager.h"
+#include "ObjectTools.h"
 #include "Permissions/WriteGate.h"
+#include "Protocol/CommandContext.h"
+#include "Settings/UnrealMCPRuntimeConfig.h"
 #include "SourceControlService.h"
 #include "UObject/ObjectRedirector.h"
 #include "UObject/Package.h"
@@ -33,6 +42,20 @@ namespace
     constexpr const TCHAR* ErrorCodeHasReferencers = TEXT("HAS_REFERENCERS");
     constexpr const TCHAR* ErrorCodeSaveFailed = TEXT("SAVE_FAILED");
 
+    constexpr int32 MaxFixupBatchReferencers = 4096;
+
+    /** Where asset.fix_redirectors stopped when it suspended between batches. */
+    struct FFixRedirectorsResumeState : public UnrealMCP::Protocol::FCommandContext::FResumeState
+    {
+        TArray<FRedirectorFixup::FBatch> Batches;
+        int32 NextBatch = 0;
+        TArray<FString> FixedPaths;
+        int64 MemoryCeilingBytes = FRedirectorFixup::DefaultMemoryCeilingBytes;
+        int64 StartUsedBytes = 0;
+        int32 GarbageCollections = 0;
+        bool bCancelled = false;
+    };
+
     FString NormalizeContentPath(const FString& InPath)
     {
         FString Trimmed = InPath;
@@ -81,10 +104,11 @@ namespace
         return AssetRegistryModule.Get();
     }
 
-    bool EnsureCheckout(const FString& ContentPath, FString& OutErrorMessage)
+    /** Checks out every path in one source-control call. */
+    bool EnsureCheckout(const TArray<FString>& ContentPaths, FString& OutErrorMessage)
     {
         TSharedPtr<FJsonObject> CheckoutError;
-        if (!FWriteGate::EnsureCheckoutForContentPath(ContentPath, CheckoutError))
+        if (!FWriteGate::EnsureCheckoutForContentPaths(ContentPaths, CheckoutError))
         {
             OutErrorMessage = CheckoutError.IsValid() && CheckoutError->HasField(TEXT("message"))
                 ? CheckoutError->GetStringField(TEXT("message"))
@@ -137,61 +161,109 @@ namespace
         return true;
     }
 
-    bool DoesObjectPathNeedSaving(const FString& ObjectPath)
+    /** Every registry package under Paths (all content when empty), for saves that include clean packages. */
+    void CollectPackagesForSave(const TArray<FString>& Paths, TArray<FName>& OutPackageNames)
     {
-        const FString PackageName = FPackageName::ObjectPathToPackageName(ObjectPath);
-        if (PackageName.IsEmpty())
+        IAssetRegistry& AssetRegistry = GetAssetRegistry();
+        TArray<FAssetData> Assets;
+        if (Paths.Num() == 0)
+        {
+            AssetRegistry.GetAllAssets(Assets);
+        }
+        for (const FString& Path : Paths)
+        {
+            AssetRegistry.GetAssetsByPath(FName(*Path), Assets, true);
+        }
+
+        TSet<FName> Seen;
+        for (const FAssetData& AssetData : Assets)
         {
+            bool bAlreadySeen = false;
+            Seen.Add(AssetData.PackageName, &bAlreadySeen);
+            if (!bAlreadySeen)
+            {
+                OutPackageNames.Add(AssetData.PackageName);
+            }
+        }
+    }
+
+    /** One validated asset.rename move. */
+    struct FRenameMove
+    {
+        FSoftObjectPath FromSoftPath;
+        FString FromPackageName;
+        FString ToPackagePath;
+        FString ToObjectPath;
+    };
+
+    /** Checks one move the way a single rename always has; false with the error code and message. */
+    bool ValidateRenameMove(IAssetRegistry& AssetRegistry, const FString& RawFrom, const FString& RawTo, FRenameMove& OutMove, FString& OutCode, FString& OutMessage)
+    {
+        const FString FromObjectPath = NormalizeContentPath(RawFrom);
+        OutMove.ToPackagePath = NormalizeContentPath(RawTo);
+
+        FString TargetReason;
+        if (!IsPathAllowed(OutMove.ToPackagePath, TargetReason))
+        {
+            OutCode = ErrorCodePathNotAllowed;
+            OutMessage = TargetReason;
             return false;
         }
 
-        if (UPackage* Package = FindPackage(nullptr, *PackageName))
+        OutMove.FromSoftPath = FSoftObjectPath(FromObjectPath);
+        if (!OutMove.FromSoftPath.IsValid())
         {
-#if WITH_EDITOR
-            return Package && Package->IsDirty();
-#else
+            OutCode = ErrorCodeInvalidParams;
+            OutMessage = FString::Printf(TEXT("Invalid object path: %s"), *FromObjectPath);
             return false;
-#endif
         }
 
-        return false;
-    }
+        OutMove.FromPackageName = FPackageName::ObjectPathToPackageName(FromObjectPath);
+        if (!FPackageName::IsValidLongPackageName(OutMove.FromPackageName))
+        {
+            OutCode = ErrorCodeInvalidParams;
+            OutMessage = FString::Printf(TEXT("Invalid package path: %s"), *OutMove.FromPackageName);
+            return false;
+        }
 
-    bool CollectAssetsForSave(const TArray<FString>& Paths, bool bModifiedOnly, TArray<FString>& OutObjectPaths)
-    {
-        IAssetRegistry& AssetRegistry = GetAssetRegistry();
+        if (!FPackageName::IsValidLongPackageName(OutMove.ToPackagePath))
+        {
+            OutCode = ErrorCodeInvalidParams;
+            OutMessage = FString::Printf(TEXT("Invalid target package path: %s"), *OutMove.ToPackagePath);
+            return false;
+        }
 
-        if (Paths.Num() == 0)
+        const FAssetData ExistingAsset = AssetRegistry.GetAssetByObjectPath(OutMove.FromSoftPath);
+        if (!ExistingAsset.IsValid())
         {
-            TArray<FAssetData> AllAssets;
-            AssetRegistry.GetAllAssets(AllAssets);
-            for (const FAssetData& AssetData : AllAssets)
-            {
-                const FString ObjectPath = AssetData.ToSoftObjectPath().ToString();
-                if (!bModifiedOnly || DoesObjectPathNeedSaving(ObjectPath))
-                {
-                    OutObjectPaths.AddUnique(ObjectPath);
-                }
-            }
-            return true;
+            OutCode = ErrorCodeAssetNotFound;
+            OutMessage = FString::Printf(TEXT("Asset not found: %s"), *FromObjectPath);
+            return false;
         }
 
-        for (const FString& Path : Paths)
+        FString Reason;
+        if (!IsPathAllowed(OutMove.FromPackageName, Reason))
         {
-            const FName PathName(*Path);
-            TArray<FAssetData> PathAssets;
-            AssetRegistry.GetAssetsByPath(PathName, PathAssets, true);
+            OutCode = ErrorCodePathNotAllowed;
+            OutMessage = Reason;
+            return false;
+        }
 
-            for (const FAssetData& AssetData : PathAssets)
-            {
-                const FString ObjectPath = AssetData.ToSoftObjectPath().ToString();
-                if (!bModifiedOnly || DoesObjectPathNeedSaving(ObjectPath))
-                {
-                    OutObjectPaths.AddUnique(ObjectPath);
-                }
-            }
+        const FString NewAssetName = FPackageName::GetLongPackageAssetName(OutMove.ToPackagePath);
+        if (NewAssetName.IsEmpty())
+        {
+            OutCode = ErrorCodeInvalidParams;
+            OutMessage = FString::Printf(TEXT("Invalid target package path: %s"), *OutMove.ToPackagePath);
+            return false;
         }
 
+        OutMove.ToObjectPath = FString::Printf(TEXT("%s.%s"), *OutMove.ToPackagePath, *NewAssetName);
+        if (UEditorAssetLibrary::DoesAssetExist(OutMove.ToObjectPath))
+        {
+            OutCode = ErrorCodeAssetExists;
+            OutMessage = FString::Printf(TEXT("Target asset already exists: %s"), *OutMove.ToObjectPath);
+            return false;
+        }
         return true;
     }
 }
@@ -203,38 +275,92 @@ TSharedPtr<FJsonObject> FAssetCrud::CreateFolder(const TSharedPtr<FJsonObject>&
         return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
     }
 
-    FString RawPath;
-    if (!Params->TryGetStringField(TEXT("path"), RawPath))
+    // "paths" creates many folders in one request; folders that already exist are reported, not errors.
+    const TArray<TSharedPtr<FJsonValue>>* PathsJson = nullptr;
+    const bool bBulk = Params->TryGetArrayField(TEXT("paths"), PathsJson) && PathsJson;
+
+    TArray<FString> Paths;
+    if (bBulk)
     {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing path parameter"));
+        for (const TSharedPtr<FJsonValue>& Value : *PathsJson)
+        {
+            if (Value->Type == EJson::String)
+            {
+                Paths.AddUnique(NormalizeContentPath(Value->AsString()));
+            }
+        }
+        if (Paths.Num() == 0)
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("No paths supplied"));
+        }
     }
-
-    const FString Path = NormalizeContentPath(RawPath);
-    FString PathReason;
-    if (!IsPathAllowed(Path, PathReason))
+    else
     {
-        return MakeErrorResponse(ErrorCodePathNotAllowed, PathReason);
+        FString RawPath;
+        if (!Params->TryGetStringField(TEXT("path"), RawPath))
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing path parameter"));
+        }
+        Paths.Add(NormalizeContentPath(RawPath));
     }
 
-    if (!Path.StartsWith(TEXT("/Game/")))
+    for (const FString& Path : Paths)
     {
-        return MakeErrorResponse(ErrorCodePathNotAllowed, TEXT("Only /Game paths are supported"));
+        FString PathReason;
+        if (!IsPathAllowed(Path, PathReason))
+        {
+            return MakeErrorResponse(ErrorCodePathNotAllowed, PathReason);
+        }
+
+        if (!Path.StartsWith(TEXT("/Game/")))
+        {
+            return MakeErrorResponse(ErrorCodePathNotAllowed, TEXT("Only /Game paths are supported"));
+        }
     }
 
-    if (UEditorAssetLibrary::DoesDirectoryExist(Path))
+    if (!bBulk)
     {
-        return MakeErrorResponse(ErrorCodeDirectoryExists, FString::Printf(TEXT("Directory already exists: %s"), *Path));
+        const FString& Path = Paths[0];
+        if (UEditorAssetLibrary::DoesDirectoryExist(Path))
+        {
+            return MakeErrorResponse(ErrorCodeDirectoryExists, FString::Printf(TEXT("Directory already exists: %s"), *Path));
+        }
+
+        if (!UEditorAssetLibrary::MakeDirectory(Path))
+        {
+            return MakeErrorResponse(ErrorCodeCreateFolderFailed, FString::Printf(TEXT("Failed to create directory: %s"), *Path));
+        }
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetBoolField(TEXT("ok"), true);
+        Data->SetBoolField(TEXT("created"), true);
+        Data->SetStringField(TEXT("path"), Path);
+        return MakeSuccessResponse(Data);
     }
 
-    if (!UEditorAssetLibrary::MakeDirectory(Path))
+    TArray<TSharedPtr<FJsonValue>> Results;
+    bool bAllOk = true;
+    for (const FString& Path : Paths)
     {
-        return MakeErrorResponse(ErrorCodeCreateFolderFailed, FString::Printf(TEXT("Failed to create directory: %s"), *Path));
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("path"), Path);
+        if (UEditorAssetLibrary::DoesDirectoryExist(Path))
+        {
+            Entry->SetBoolField(TEXT("created"), false);
+            Entry->SetBoolField(TEXT("exists"), true);
+        }
+        else
+        {
+            const bool bCreated = UEditorAssetLibrary::MakeDirectory(Path);
+            Entry->SetBoolField(TEXT("created"), bCreated);
+            bAllOk &= bCreated;
+        }
+        Results.Add(MakeShared<FJsonValueObject>(Entry));
     }
 
     TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-    Data->SetBoolField(TEXT("ok"), true);
-    Data->SetBoolField(TEXT("created"), true);
-    Data->SetStringField(TEXT("path"), Path);
+    Data->SetBoolField(TEXT("ok"), bAllOk);
+    Data->SetArrayField(TEXT("results"), Results);
     return MakeSuccessResponse(Data);
 }
 
@@ -245,79 +371,114 @@ TSharedPtr<FJsonObject> FAssetCrud::Rename(const TSharedPtr<FJsonObject>& Params
         return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
     }
 
-    FString FromObjectPath;
-    FString ToPackagePath;
-    if (!Params->TryGetStringField(TEXT("fromObjectPath"), FromObjectPath) ||
-        !Params->TryGetStringField(TEXT("toPackagePath"), ToPackagePath))
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing fromObjectPath or toPackagePath"));
-    }
-
-    FromObjectPath = NormalizeContentPath(FromObjectPath);
-    ToPackagePath = NormalizeContentPath(ToPackagePath);
+    // "moves" renames many assets in one pass: everything is validated first, then checked out
+    // together, renamed with a single RenameAssets call and saved once.
+    const TArray<TSharedPtr<FJsonValue>>* MovesJson = nullptr;
+    const bool bBulk = Params->TryGetArrayField(TEXT("moves"), MovesJson) && MovesJson;
 
-    FString TargetReason;
-    if (!IsPathAllowed(ToPackagePath, TargetReason))
+    TArray<TPair<FString, FString>> RawMoves;
+    if (bBulk)
     {
-        return MakeErrorResponse(ErrorCodePathNotAllowed, TargetReason);
-    }
-
-    FSoftObjectPath FromSoftPath(FromObjectPath);
-    if (!FromSoftPath.IsValid())
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("Invalid object path: %s"), *FromObjectPath));
+        for (const TSharedPtr<FJsonValue>& Value : *MovesJson)
+        {
+            const TSharedPtr<FJsonObject>* MoveObject = nullptr;
+            FString From;
+            FString To;
+            if (!Value->TryGetObject(MoveObject) || !(*MoveObject)->TryGetStringField(TEXT("fromObjectPath"), From)
+                || !(*MoveObject)->TryGetStringField(TEXT("toPackagePath"), To))
+            {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Each move needs fromObjectPath and toPackagePath"));
+            }
+            RawMoves.Emplace(From, To);
+        }
+        if (RawMoves.Num() == 0)
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("No moves supplied"));
+        }
     }
-
-    FString FromPackageName = FPackageName::ObjectPathToPackageName(FromObjectPath);
-    if (!FPackageName::IsValidLongPackageName(FromPackageName))
+    else
     {
-        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("Invalid package path: %s"), *FromPackageName));
+        FString FromObjectPath;
+        FString ToPackagePath;
+        if (!Params->TryGetStringField(TEXT("fromObjectPath"), FromObjectPath) ||
+            !Params->TryGetStringField(TEXT("toPackagePath"), ToPackagePath))
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing fromObjectPath or toPackagePath"));
+        }
+        RawMoves.Emplace(FromObjectPath, ToPackagePath);
     }
 
-    if (!FPackageName::IsValidLongPackageName(ToPackagePath))
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("Invalid target package path: %s"), *ToPackagePath));
-    }
+    bool bSave = bBulk;
+    Params->TryGetBoolField(TEXT("save"), bSave);
 
     IAssetRegistry& AssetRegistry = GetAssetRegistry();
-    const FAssetData ExistingAsset = AssetRegistry.GetAssetByObjectPath(FromSoftPath);
-    if (!ExistingAsset.IsValid())
-    {
-        return MakeErrorResponse(ErrorCodeAssetNotFound, FString::Printf(TEXT("Asset not found: %s"), *FromObjectPath));
+    TArray<FRenameMove> Moves;
+    Moves.Reserve(RawMoves.Num());
+    TSet<FString> Targets;
+    for (const TPair<FString, FString>& RawMove : RawMoves)
+    {
+        FRenameMove& Move = Moves.AddDefaulted_GetRef();
+        FString Code;
+        FString Message;
+        if (!ValidateRenameMove(AssetRegistry, RawMove.Key, RawMove.Value, Move, Code, Message))
+        {
+            return MakeErrorResponse(Code, Message);
+        }
+
+        bool bDuplicate = false;
+        Targets.Add(Move.ToObjectPath, &bDuplicate);
+        if (bDuplicate)
+        {
+            return MakeErrorResponse(ErrorCodeAssetExists, FString::Printf(TEXT("Two moves target %s"), *Move.ToObjectPath));
+        }
     }
 
-    FString Reason;
-    if (!IsPathAllowed(FromPackageName, Reason))
+    // Referencers are gathered before the rename rewrites them, so the save below can find them.
+    TArray<FString> CheckoutPaths;
+    TSet<FName> Referencers;
+    for (const FRenameMove& Move : Moves)
     {
-        return MakeErrorResponse(ErrorCodePathNotAllowed, Reason);
+        CheckoutPaths.Add(Move.FromPackageName);
+        if (bSave)
+        {
+            TArray<FName> PackageReferencers;
+            AssetRegistry.GetReferencers(FName(*Move.FromPackageName), PackageReferencers, UE::AssetRegistry::EDependencyCategory::Package);
+            Referencers.Append(PackageReferencers);
+        }
     }
-
-    const FString NewAssetName = FPackageName::GetLongPackageAssetName(ToPackagePath);
-    if (NewAssetName.IsEmpty())
+    FString CheckoutError;
+    if (!EnsureCheckout(CheckoutPaths, CheckoutError))
     {
-        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("Invalid target package path: %s"), *ToPackagePath));
+        return MakeErrorResponse(ErrorCodeSourceControlRequired, CheckoutError);
     }
 
-    const FString ToObjectPath = FString::Printf(TEXT("%s.%s"), *ToPackagePath, *NewAssetName);
-    if (UEditorAssetLibrary::DoesAssetExist(ToObjectPath))
+    TArray<FAssetRenameData> RenameData;
+    RenameData.Reserve(Moves.Num());
+    for (const FRenameMove& Move : Moves)
     {
-        return MakeErrorResponse(ErrorCodeAssetExists, FString::Printf(TEXT("Target asset already exists: %s"), *ToObjectPath));
+        UObject* Asset = Move.FromSoftPath.TryLoad();
+        if (!Asset)
+        {
+            return MakeErrorResponse(ErrorCodeRenameFailed, FString::Printf(TEXT("Failed to load asset: %s"), *Move.FromSoftPath.ToString()));
+        }
+        RenameData.Emplace(Asset, FPackageName::GetLongPackagePath(Move.ToPackagePath), FPackageName::GetLongPackageAssetName(Move.ToPackagePath));
     }
 
-    FString CheckoutError;
-    if (!EnsureCheckout(FromObjectPath, CheckoutError))
+    FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+    if (!AssetToolsModule.Get().RenameAssets(RenameData))
     {
-        return MakeErrorResponse(ErrorCodeSourceControlRequired, CheckoutError);
+        return MakeErrorResponse(ErrorCodeRenameFailed, Moves.Num() == 1 ? FString(TEXT("Failed to rename asset")) : FString(TEXT("Failed to rename assets")));
     }
 
-    if (!UEditorAssetLibrary::RenameAsset(FromObjectPath, ToObjectPath))
+    TArray<FString> NewPackages;
+    for (const FRenameMove& Move : Moves)
     {
-        return MakeErrorResponse(ErrorCodeRenameFailed, TEXT("Failed to rename asset"));
+        NewPackages.Add(Move.ToPackagePath);
     }
 
     FString MarkForAddError;
     TArray<FString> NewFiles;
-    if (!ConvertPackagesToFiles({ToPackagePath}, NewFiles, MarkForAddError))
+    if (!ConvertPackagesToFiles(NewPackages, NewFiles, MarkForAddError))
     {
         return MakeErrorResponse(ErrorCodeSourceControlRequired, MarkForAddError);
     }
@@ -328,19 +489,73 @@ TSharedPtr<FJsonObject> FAssetCrud::Rename(const TSharedPtr<FJsonObject>& Params
         return MakeErrorResponse(ErrorCodeSourceControlRequired, MarkErrorDetail);
     }
 
-    bool bRedirectorCreated = false;
-    const FAssetData PostRenameData = AssetRegistry.GetAssetByObjectPath(FromSoftPath);
-    if (PostRenameData.IsValid())
+    TArray<TSharedPtr<FJsonValue>> Results;
+    TArray<UPackage*> PackagesToSave;
+    for (const FRenameMove& Move : Moves)
+    {
+        bool bRedirectorCreated = false;
+        const FAssetData PostRenameData = AssetRegistry.GetAssetByObjectPath(Move.FromSoftPath);
+        if (PostRenameData.IsValid())
+        {
+            bRedirectorCreated = PostRenameData.AssetClassPath == UObjectRedirector::StaticClass()->GetClassPathName();
+        }
+
+        if (bSave)
+        {
+            for (const FString& PackageName : { Move.ToPackagePath, Move.FromPackageName })
+            {
+                UPackage* Package = FindPackage(nullptr, *PackageName);
+                if (Package && Package->IsDirty())
+                {
+                    PackagesToSave.AddUnique(Package);
+                }
+            }
+        }
+
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("from"), Move.FromPackageName);
+        Entry->SetStringField(TEXT("to"), Move.ToPackagePath);
+        Entry->SetStringField(TEXT("objectPath"), Move.ToObjectPath);
+        Entry->SetBoolField(TEXT("redirectorCreated"), bRedirectorCreated);
+        Results.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+
+    // Renamed assets, their redirectors and the referencers the rename rewrote, in one save.
+    bool bSaved = true;
+    if (bSave)
     {
-        bRedirectorCreated = PostRenameData.AssetClassPath == UObjectRedirector::StaticClass()->GetClassPathName();
+        for (const FName& Referencer : Referencers)
+        {
+            UPackage* Package = FindPackage(nullptr, *Referencer.ToString());
+            FString Reason;
+            if (Package && Package->IsDirty() && IsPathAllowed(Package->GetName(), Reason))
+            {
+                PackagesToSave.AddUnique(Package);
+            }
+        }
+        bSaved = PackagesToSave.Num() == 0 || UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, /*bOnlyDirty*/ true);
+    }
+
+    if (!bBulk)
+    {
+        TSharedPtr<FJsonObject> Data = Results[0]->AsObject();
+        Data->SetBoolField(TEXT("ok"), true);
+        if (bSave)
+        {
+            Data->SetBoolField(TEXT("saved"), bSaved);
+        }
+        return MakeSuccessResponse(Data);
     }
 
     TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-    Data->SetBoolField(TEXT("ok"), true);
-    Data->SetStringField(TEXT("from"), FromPackageName);
-    Data->SetStringField(TEXT("to"), ToPackagePath);
-    Data->SetStringField(TEXT("objectPath"), ToObjectPath);
-    Data->SetBoolField(TEXT("redirectorCreated"), bRedirectorCreated);
+    Data->SetBoolField(TEXT("ok"), bSaved);
+    Data->SetArrayField(TEXT("results"), Results);
+    Data->SetNumberField(TEXT("renamedCount"), Moves.Num());
+    if (bSave)
+    {
+        Data->SetBoolField(TEXT("saved"), bSaved);
+        Data->SetNumberField(TEXT("savedPackages"), PackagesToSave.Num());
+    }
     return MakeSuccessResponse(Data);
 }
 
@@ -374,7 +589,7 @@ TSharedPtr<FJsonObject> FAssetCrud::Delete(const TSharedPtr<FJsonObject>& Params
         FString Normalized = NormalizeContentPath(Value->AsString());
         if (!Normalized.IsEmpty())
         {
-            ObjectPaths.Add(Normalized);
+            ObjectPaths.AddUnique(Normalized);
         }
     }
 
@@ -383,8 +598,10 @@ TSharedPtr<FJsonObject> FAssetCrud::Delete(const TSharedPtr<FJsonObject>& Params
         return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("No object paths supplied"));
     }
 
-    TArray<TSharedPtr<FJsonValue>> Results;
-
+    // Everything is validated before anything is deleted.
+    TArray<FAssetData> Assets;
+    TSet<FName> DeletedPackages;
+    Assets.Reserve(ObjectPaths.Num());
     for (const FString& ObjectPath : ObjectPaths)
     {
         FSoftObjectPath SoftPath(ObjectPath);
@@ -405,127 +622,188 @@ TSharedPtr<FJsonObject> FAssetCrud::Delete(const TSharedPtr<FJsonObject>& Params
         {
             return MakeErrorResponse(ErrorCodeAssetNotFound, FString::Printf(TEXT("Asset not found: %s"), *ObjectPath));
         }
+        Assets.Add(AssetData);
+        DeletedPackages.Add(AssetData.PackageName);
+    }
 
-        if (!bForce)
+    // One reference check for the whole set: referencers that are deleted too do not count.
+    if (!bForce)
+    {
+        using namespace UE::AssetRegistry;
+        for (const FAssetData& AssetData : Assets)
         {
-            using namespace UE::AssetRegistry;
             TArray<FName> Referencers;
             AssetRegistry.GetReferencers(AssetData.PackageName, Referencers, EDependencyCategory::Package, EDependencyQuery::Hard);
-
-            Referencers.RemoveAll([&](const FName& Ref)
+            for (const FName& Referencer : Referencers)
             {
-                return Ref == AssetData.PackageName;
-            });
-
-            if (Referencers.Num() > 0)
-            {
-                return MakeErrorResponse(ErrorCodeHasReferencers, FString::Printf(TEXT("Asset has referencers: %s"), *Referencers[0].ToString()));
+                if (!DeletedPackages.Contains(Referencer))
+                {
+                    return MakeErrorResponse(ErrorCodeHasReferencers, FString::Printf(TEXT("Asset has referencers: %s"), *Referencer.ToString()));
+                }
             }
         }
+    }
 
-        FString CheckoutError;
-        if (!EnsureCheckout(ObjectPath, CheckoutError))
-        {
-            return MakeErrorResponse(ErrorCodeSourceControlRequired, CheckoutError);
-        }
+    FString CheckoutError;
+    if (!EnsureCheckout(ObjectPaths, CheckoutError))
+    {
+        return MakeErrorResponse(ErrorCodeSourceControlRequired, CheckoutError);
+    }
 
-        if (!UEditorAssetLibrary::DeleteAsset(ObjectPath))
+    TArray<UObject*> Objects;
+    Objects.Reserve(Assets.Num());
+    for (const FAssetData& AssetData : Assets)
+    {
+        if (UObject* Asset = AssetData.GetAsset())
         {
-            return MakeErrorResponse(ErrorCodeDeleteFailed, FString::Printf(TEXT("Failed to delete asset: %s"), *ObjectPath));
+            Objects.Add(Asset);
         }
+    }
+
+    // Referencers were checked above (or force was asked for), so nothing is left to confirm.
+    const int32 DeletedCount = bForce ? ObjectTools::ForceDeleteObjects(Objects, /*ShowConfirmation*/ false) : ObjectTools::DeleteObjects(Objects, /*bShowConfirmation*/ false);
+    if (DeletedCount == 0)
+    {
+        return MakeErrorResponse(ErrorCodeDeleteFailed, FString::Printf(TEXT("Failed to delete asset: %s"), *ObjectPaths[0]));
+    }
+
+    TArray<TSharedPtr<FJsonValue>> Results;
+    bool bAllDeleted = true;
+    for (const FString& ObjectPath : ObjectPaths)
+    {
+        const bool bDeleted = !UEditorAssetLibrary::DoesAssetExist(ObjectPath);
+        bAllDeleted &= bDeleted;
 
         TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
         Entry->SetStringField(TEXT("objectPath"), ObjectPath);
-        Entry->SetBoolField(TEXT("deleted"), true);
+        Entry->SetBoolField(TEXT("deleted"), bDeleted);
         Results.Add(MakeShared<FJsonValueObject>(Entry));
     }
 
     TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-    Data->SetBoolField(TEXT("ok"), true);
+    Data->SetBoolField(TEXT("ok"), bAllDeleted);
+    Data->SetNumberField(TEXT("deletedCount"), DeletedCount);
     Data->SetArrayField(TEXT("results"), Results);
     return MakeSuccessResponse(Data);
 }
 
 TSharedPtr<FJsonObject> FAssetCrud::FixRedirectors(const TSharedPtr<FJsonObject>& Params)
 {
-    if (!Params.IsValid())
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
-    }
-
-    const TArray<TSharedPtr<FJsonValue>>* PathsJson = nullptr;
-    if (!Params->TryGetArrayField(TEXT("paths"), PathsJson) || !PathsJson)
+    // Batches are planned from the registry in the first slice; each later batch loads, fixes and
+    // saves only its own referencers, suspending to the next frame once the budget is spent.
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+    TSharedPtr<FFixRedirectorsResumeState> State = Context ? Context->TakeResumeState<FFixRedirectorsResumeState>() : nullptr;
+    if (!State.IsValid())
     {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing paths array"));
-    }
+        if (!Params.IsValid())
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+        }
 
-    bool bRecursive = true;
-    Params->TryGetBoolField(TEXT("recursive"), bRecursive);
+        const TArray<TSharedPtr<FJsonValue>>* PathsJson = nullptr;
+        if (!Params->TryGetArrayField(TEXT("paths"), PathsJson) || !PathsJson)
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing paths array"));
+        }
 
-    IAssetRegistry& AssetRegistry = GetAssetRegistry();
-    TArray<UObjectRedirector*> RedirectorsToFix;
-    TArray<FString> FixedPaths;
+        bool bRecursive = true;
+        Params->TryGetBoolField(TEXT("recursive"), bRecursive);
 
-    for (const TSharedPtr<FJsonValue>& Value : *PathsJson)
-    {
-        if (Value->Type != EJson::String)
+        State = MakeShared<FFixRedirectorsResumeState>();
+        int32 MaxReferencers = FRedirectorFixup::DefaultMaxReferencersPerBatch;
+        double Number = 0.0;
+        if (Params->TryGetNumberField(TEXT("batchSize"), Number))
         {
-            continue;
+            MaxReferencers = FMath::Clamp(static_cast<int32>(Number), 1, MaxFixupBatchReferencers);
         }
-
-        const FString Normalized = NormalizeContentPath(Value->AsString());
-        FString PathReason;
-        if (!IsPathAllowed(Normalized, PathReason))
+        if (Params->TryGetNumberField(TEXT("memoryCeilingMb"), Number))
         {
-            return MakeErrorResponse(ErrorCodePathNotAllowed, PathReason);
+            State->MemoryCeilingBytes = static_cast<int64>(FMath::Max(Number, 0.0) * 1024.0 * 1024.0);
         }
+        State->StartUsedBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
 
-        const FName PathName(*Normalized);
-        TArray<FAssetData> PathAssets;
-        AssetRegistry.GetAssetsByPath(PathName, PathAssets, bRecursive);
-
-        for (const FAssetData& AssetData : PathAssets)
+        IAssetRegistry& AssetRegistry = GetAssetRegistry();
+        TArray<FAssetData> Redirectors;
+        for (const TSharedPtr<FJsonValue>& Value : *PathsJson)
         {
-            if (AssetData.AssetClassPath == UObjectRedirector::StaticClass()->GetClassPathName())
+            if (Value->Type != EJson::String)
             {
-                if (UObjectRedirector* Redirector = Cast<UObjectRedirector>(AssetData.GetAsset()))
+                continue;
+            }
+
+            const FString Normalized = NormalizeContentPath(Value->AsString());
+            FString PathReason;
+            if (!IsPathAllowed(Normalized, PathReason))
+            {
+                return MakeErrorResponse(ErrorCodePathNotAllowed, PathReason);
+            }
+
+            const FName PathName(*Normalized);
+            TArray<FAssetData> PathAssets;
+            AssetRegistry.GetAssetsByPath(PathName, PathAssets, bRecursive);
+
+            for (const FAssetData& AssetData : PathAssets)
+            {
+                if (AssetData.AssetClassPath == UObjectRedirector::StaticClass()->GetClassPathName())
                 {
-                    RedirectorsToFix.Add(Redirector);
+                    Redirectors.Add(AssetData);
                 }
             }
         }
-    }
 
-    if (RedirectorsToFix.Num() == 0)
-    {
-        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-        Data->SetBoolField(TEXT("ok"), true);
-        Data->SetNumberField(TEXT("fixedCount"), 0);
-        Data->SetArrayField(TEXT("fixed"), {});
-        return MakeSuccessResponse(Data);
+        FRedirectorFixup::PlanBatches(AssetRegistry, Redirectors, MaxReferencers, State->Batches);
     }
 
-    FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
-    AssetToolsModule.Get().FixupReferencers(RedirectorsToFix);
+    const double SliceStart = FPlatformTime::Seconds();
+    const double SliceBudgetSeconds = FUnrealMCPRuntimeConfig::Get().GameThreadBudgetMs / 1000.0;
 
-    for (UObjectRedirector* Redirector : RedirectorsToFix)
+    while (State->NextBatch < State->Batches.Num())
     {
-        if (Redirector)
+        if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
         {
-            FixedPaths.Add(Redirector->GetPathName());
+            State->bCancelled = true;
+            break;
+        }
+        UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(State->NextBatch, State->Batches.Num(), TEXT("fix_redirectors"));
+
+        TSharedPtr<FJsonObject> CheckoutError;
+        if (!FRedirectorFixup::FixBatch(State->Batches[State->NextBatch], State->FixedPaths, CheckoutError))
+        {
+            return CheckoutError.IsValid() ? CheckoutError : MakeErrorResponse(ErrorCodeSourceControlRequired, TEXT("Source control checkout failed"));
+        }
+        ++State->NextBatch;
+
+        // The batch's referencers are saved now, so they can go before the next batch loads its own.
+        if (FRedirectorFixup::CollectGarbageOverCeiling(State->StartUsedBytes, State->MemoryCeilingBytes))
+        {
+            ++State->GarbageCollections;
+        }
+
+        if (State->NextBatch < State->Batches.Num() && Context && Context->CanSuspend()
+            && FPlatformTime::Seconds() - SliceStart >= SliceBudgetSeconds)
+        {
+            Context->Suspend(State.ToSharedRef());
+            return nullptr;
         }
     }
+    UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(State->NextBatch, State->Batches.Num(), TEXT("fix_redirectors"));
 
     TArray<TSharedPtr<FJsonValue>> FixedJson;
-    for (const FString& Path : FixedPaths)
+    for (const FString& Path : State->FixedPaths)
     {
         FixedJson.Add(MakeShared<FJsonValueString>(Path));
     }
 
     TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
     Data->SetBoolField(TEXT("ok"), true);
-    Data->SetNumberField(TEXT("fixedCount"), FixedPaths.Num());
+    Data->SetNumberField(TEXT("fixedCount"), State->FixedPaths.Num());
     Data->SetArrayField(TEXT("fixed"), FixedJson);
+    Data->SetNumberField(TEXT("batches"), State->NextBatch);
+    Data->SetNumberField(TEXT("garbageCollections"), State->GarbageCollections);
+    if (State->bCancelled)
+    {
+        Data->SetBoolField(TEXT("cancelled"), true);
+    }
     return MakeSuccessResponse(Data);
 }
 
@@ -564,29 +842,62 @@ TSharedPtr<FJsonObject> FAssetCrud::SaveAll(const TSharedPtr<FJsonObject>& Param
         }
     }
 
-    TArray<FString> ObjectPaths;
-    if (!CollectAssetsForSave(NormalizedPaths, bModifiedOnly, ObjectPaths))
+    // Dirty packages come from the editor's dirty list; only a full save walks the registry.
+    TArray<UPackage*> Packages;
+    if (bModifiedOnly)
+    {
+        FPackageSaver::CollectDirtyPackages(NormalizedPaths, Packages);
+    }
+    else
+    {
+        TArray<FName> PackageNames;
+        CollectPackagesForSave(NormalizedPaths, PackageNames);
+        for (const FName& PackageName : PackageNames)
+        {
+            FString Reason;
+            if (!IsPathAllowed(PackageName.ToString(), Reason))
+            {
+                continue;
+            }
+
+            UPackage* Package = FindPackage(nullptr, *PackageName.ToString());
+            if (!Package)
+            {
+                Package = LoadPackage(nullptr, *PackageName.ToString(), LOAD_None);
+            }
+            if (Package)
+            {
+                Packages.Add(Package);
+            }
+        }
+    }
+
+    TArray<FPackageSaver::FResult> Results;
+    TSharedPtr<FJsonObject> CheckoutError;
+    if (!FPackageSaver::SavePackages(Packages, Results, CheckoutError))
     {
-        return MakeErrorResponse(ErrorCodeSaveFailed, TEXT("Failed to collect packages"));
+        return CheckoutError.IsValid() ? CheckoutError : MakeErrorResponse(ErrorCodeSourceControlRequired, TEXT("Source control checkout required"));
     }
 
     TArray<TSharedPtr<FJsonValue>> SavedPackagesJson;
-    int32 SavedCount = 0;
-
-    for (const FString& ObjectPath : ObjectPaths)
+    int32 FailedCount = 0;
+    for (const FPackageSaver::FResult& Result : Results)
     {
-        const bool bSaved = UEditorAssetLibrary::SaveAsset(ObjectPath, bModifiedOnly);
-        if (bSaved)
+        if (Result.bSaved)
+        {
+            SavedPackagesJson.Add(MakeShared<FJsonValueString>(Result.PackageName));
+        }
+        else
         {
-            SavedCount++;
-            const FString PackagePath = FPackageName::ObjectPathToPackageName(ObjectPath);
-            SavedPackagesJson.Add(MakeShared<FJsonValueString>(PackagePath));
+            ++FailedCount;
         }
     }
 
     TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
     Data->SetBoolField(TEXT("ok"), true);
-    Data->SetNumberField(TEXT("savedCount"), SavedCount);
+    Data->SetNumberField(TEXT("savedCount"), SavedPackagesJson.Num());
+    Data->SetNumberField(TEXT("failedCount"), FailedCount);
     Data->SetArrayField(TEXT("savedPackages"), SavedPackagesJson);
+    Data->SetArrayField(TEXT("results"), FPackageSaver::ResultsToJson(Results));
     return MakeSuccessResponse(Data);
 }
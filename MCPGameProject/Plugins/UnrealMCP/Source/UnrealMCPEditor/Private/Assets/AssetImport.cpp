@@ -3,13 +3,16 @@
 
 #include "AssetToolsModule.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Assets/ImportSourceProbe.h"
 #include "AssetRegistry/IAssetRegistry.h"
 #include "AssetImportTask.h"
+#include "Async/ParallelFor.h"
 #include "EditorFramework/AssetImportData.h"
 #include "Factories/Factory.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "EditorAssetLibrary.h"
+#include "FileHelpers.h"
 #include "Factories/FbxFactory.h"
 #include "Factories/FbxImportUI.h"
 #include "Factories/FbxMeshImportData.h"
@@ -18,20 +21,41 @@
 #include "Factories/SoundFactory.h"
 #include "Factories/TextureFactory.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "InterchangeGenericAnimationPipeline.h"
+#include "InterchangeGenericAssetsPipeline.h"
+#include "InterchangeGenericAssetsPipelineSharedSettings.h"
+#include "InterchangeGenericMaterialPipeline.h"
+#include "InterchangeGenericMeshPipeline.h"
+#include "InterchangeGenericTexturePipeline.h"
+#include "InterchangeManager.h"
+#include "InterchangeSourceData.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
 #include "Misc/PackageName.h"
 #include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
 #include "Modules/ModuleManager.h"
+#include "Observability/MemoryPolicy.h"
 #include "Permissions/WriteGate.h"
+#include "Serialization/JsonSerializer.h"
+#include "Protocol/CommandContext.h"
 #include "ScopedTransaction.h"
+#include "Settings/UnrealMCPRuntimeConfig.h"
 #include "Sound/SoundBase.h"
 #include "Sound/SoundWave.h"
 #include "SourceControlService.h"
+#include "TextureCompiler.h"
+#include "Transactions/TransactionManager.h"
 #include "Engine/Texture.h"
 #include "Engine/TextureDefines.h"
 #include "Engine/Texture2D.h"
 #include "UObject/SoftObjectPath.h"
 #include "UObject/StrongObjectPtr.h"
+#include "UObject/Package.h"
 #include "UObject/UObjectGlobals.h"
+#include "UnrealMCPLog.h"
 #include "Animation/Skeleton.h"
 #include "UnrealEdGlobals.h"
 #include "Editor/UnrealEdEngine.h"
@@ -45,6 +69,7 @@ namespace
     constexpr const TCHAR* ErrorCodeUnsupportedExtension = TEXT("UNSUPPORTED_EXTENSION");
     constexpr const TCHAR* ErrorCodeImportFailed = TEXT("IMPORT_FAILED");
     constexpr const TCHAR* ErrorCodeSourceControlRequired = TEXT("SOURCE_CONTROL_REQUIRED");
+    constexpr const TCHAR* ErrorCodeJournalNotFound = TEXT("JOURNAL_NOT_FOUND");
 
     enum class EImportKind
     {
@@ -64,6 +89,8 @@ namespace
     struct FConflictOptions
     {
         EConflictPolicy Policy = EConflictPolicy::Overwrite;
+        /** Leave an existing asset alone when its recorded source hash matches the file. */
+        bool bSkipUnchanged = true;
     };
 
     struct FFbxOptions
@@ -85,6 +112,8 @@ namespace
         FString CompressionSettings = TEXT("Default");
         FString MipGenSettings = TEXT("FromTextureGroup");
         bool bFlipGreenChannel = false;
+        /** Wait for the imported textures to finish compiling instead of reporting them as pending. */
+        bool bWaitForCompilation = false;
     };
 
     struct FAudioOptions
@@ -92,6 +121,40 @@ namespace
         FString SoundGroup = TEXT("SFX");
     };
 
+    /** Per-entry progress recorded in the import journal. */
+    enum class EJournalStatus : uint8
+    {
+        Pending,
+        Imported,
+        PostProcessed,
+        Saved,
+        Failed,
+        Skipped
+    };
+
+    const TCHAR* JournalStatusToString(EJournalStatus Status)
+    {
+        switch (Status)
+        {
+        case EJournalStatus::Imported: return TEXT("imported");
+        case EJournalStatus::PostProcessed: return TEXT("postProcessed");
+        case EJournalStatus::Saved: return TEXT("saved");
+        case EJournalStatus::Failed: return TEXT("failed");
+        case EJournalStatus::Skipped: return TEXT("skipped");
+        default: return TEXT("pending");
+        }
+    }
+
+    EJournalStatus JournalStatusFromString(const FString& Status)
+    {
+        if (Status == TEXT("imported")) return EJournalStatus::Imported;
+        if (Status == TEXT("postProcessed")) return EJournalStatus::PostProcessed;
+        if (Status == TEXT("saved")) return EJournalStatus::Saved;
+        if (Status == TEXT("failed")) return EJournalStatus::Failed;
+        if (Status == TEXT("skipped")) return EJournalStatus::Skipped;
+        return EJournalStatus::Pending;
+    }
+
     struct FImportPlanEntry
     {
         FString SourceFile;
@@ -103,9 +166,14 @@ namespace
         bool bWillOverwrite = false;
         FString SkipReason;
         TArray<FString> PreExistingPackages;
+        /** MD5s the existing assets recorded for a source file of this name; set only for overwrites. */
+        TArray<FMD5Hash> RecordedSourceHashes;
         TArray<FString> ImportedObjectPaths;
         TArray<FString> Warnings;
         bool bImportFailed = false;
+        /** Imported through Interchange rather than a legacy factory. */
+        bool bInterchange = false;
+        EJournalStatus JournalStatus = EJournalStatus::Pending;
     };
 
     FString NormalizeContentPath(const FString& InPath)
@@ -190,6 +258,8 @@ namespace
             return Result;
         }
 
+        (*ConflictObject)->TryGetBoolField(TEXT("skipUnchanged"), Result.bSkipUnchanged);
+
         FString OnExisting;
         if ((*ConflictObject)->TryGetStringField(TEXT("onExisting"), OnExisting))
         {
@@ -335,6 +405,10 @@ namespace
         {
             OutOptions.bFlipGreenChannel = (*TextureObject)->GetBoolField(TEXT("flipGreenChannel"));
         }
+        if ((*TextureObject)->HasTypedField<EJson::Boolean>(TEXT("waitForCompilation")))
+        {
+            OutOptions.bWaitForCompilation = (*TextureObject)->GetBoolField(TEXT("waitForCompilation"));
+        }
     }
 
     void OverrideAudioOptions(const TSharedPtr<FJsonObject>& OptionsObject, FAudioOptions& OutOptions)
@@ -507,6 +581,9 @@ namespace
 
         if (bOutChanged)
         {
+            // Queues one more compile on the texture compiling manager; the factory already had every
+            // setting but sRGB, so this only happens for sRGB mismatches and Interchange imports.
+            Texture->PostEditChange();
             Texture->MarkPackageDirty();
         }
     }
@@ -533,6 +610,74 @@ namespace
         }
     }
 
+    /**
+     * The source hashes the package's assets recorded at their last import, read from the registry's
+     * AssetImportData tag so nothing is loaded. Only entries for a file named like SourceFile count.
+     */
+    void CollectRecordedSourceHashes(IAssetRegistry& AssetRegistry, const FString& PackagePath, const FString& SourceFile, TArray<FMD5Hash>& OutHashes)
+    {
+        TArray<FAssetData> Assets;
+        AssetRegistry.GetAssetsByPackageName(FName(*PackagePath), Assets, /*bIncludeOnlyOnDiskAssets*/ true);
+
+        const FString SourceName = FPaths::GetCleanFilename(SourceFile);
+        for (const FAssetData& AssetData : Assets)
+        {
+            FString ImportDataJson;
+            if (!AssetData.GetTagValue(UObject::SourceFileTagName(), ImportDataJson))
+            {
+                continue;
+            }
+
+            const TOptional<FAssetImportInfo> ImportInfo = FAssetImportInfo::FromJson(ImportDataJson);
+            if (!ImportInfo.IsSet())
+            {
+                continue;
+            }
+            for (const FAssetImportInfo::FSourceFile& Recorded : ImportInfo->SourceFiles)
+            {
+                if (Recorded.FileHash.IsValid() && FPaths::GetCleanFilename(Recorded.RelativeFilename).Equals(SourceName, ESearchCase::IgnoreCase))
+                {
+                    OutHashes.AddUnique(Recorded.FileHash);
+                }
+            }
+        }
+    }
+
+    /**
+     * Marks overwrites whose source file hashes to what the existing asset recorded as skipped
+     * (reason "unchanged"). Files are hashed on worker threads; returns how many were skipped.
+     */
+    int32 SkipUnchangedSources(TArray<FImportPlanEntry>& PlanEntries)
+    {
+        TArray<FImportPlanEntry*> Candidates;
+        for (FImportPlanEntry& Entry : PlanEntries)
+        {
+            if (Entry.bShouldImport && Entry.RecordedSourceHashes.Num() > 0)
+            {
+                Candidates.Add(&Entry);
+            }
+        }
+
+        TArray<FMD5Hash> SourceHashes;
+        SourceHashes.SetNum(Candidates.Num());
+        ParallelFor(Candidates.Num(), [&Candidates, &SourceHashes](int32 Index)
+        {
+            SourceHashes[Index] = FMD5Hash::HashFile(*Candidates[Index]->SourceFile);
+        });
+
+        int32 Skipped = 0;
+        for (int32 Index = 0; Index < Candidates.Num(); ++Index)
+        {
+            if (SourceHashes[Index].IsValid() && Candidates[Index]->RecordedSourceHashes.Contains(SourceHashes[Index]))
+            {
+                Candidates[Index]->bShouldImport = false;
+                Candidates[Index]->SkipReason = TEXT("unchanged");
+                ++Skipped;
+            }
+        }
+        return Skipped;
+    }
+
     void AppendArrayField(TSharedPtr<FJsonObject> Parent, const FString& FieldName, const TArray<TSharedPtr<FJsonValue>>& Values)
     {
         if (!Parent)
@@ -582,225 +727,478 @@ namespace
         Action->SetStringField(TEXT("dest"), DestPath);
         Actions.Add(MakeShared<FJsonValueObject>(Action));
     }
-}
 
-TSharedPtr<FJsonObject> FAssetImport::BatchImport(const TSharedPtr<FJsonObject>& Params)
-{
-    if (!Params.IsValid())
+    /**
+     * False when the first bytes of the file contradict its extension, which catches renamed,
+     * empty and truncated sources before an importer fails on them. Formats without a signature
+     * (TGA, HDR, ASCII FBX) only need to be non-empty.
+     */
+    bool HasPlausibleHeader(const FString& FilePath)
     {
-        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing parameters"));
-    }
+        TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+        if (!Reader.IsValid() || Reader->TotalSize() <= 0)
+        {
+            return false;
+        }
 
-    FString RawDestPath;
-    if (!Params->TryGetStringField(TEXT("destPath"), RawDestPath))
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing destPath"));
-    }
+        uint8 Header[12] = {};
+        const int64 HeaderSize = FMath::Min<int64>(Reader->TotalSize(), sizeof(Header));
+        Reader->Serialize(Header, HeaderSize);
+        if (Reader->IsError())
+        {
+            return false;
+        }
 
-    const FString DestPath = NormalizeContentPath(RawDestPath);
-    if (!DestPath.StartsWith(TEXT("/Game/")))
-    {
-        return MakeErrorResponse(ErrorCodeDestPathInvalid, TEXT("Destination must be under /Game"));
-    }
+        auto StartsWith = [&Header, HeaderSize](const char* Magic, int32 Offset = 0)
+        {
+            const int32 Length = FCStringAnsi::Strlen(Magic);
+            return Offset + Length <= HeaderSize && FMemory::Memcmp(Header + Offset, Magic, Length) == 0;
+        };
 
-    FString PathReason;
-    if (!FWriteGate::IsPathAllowed(DestPath, PathReason))
-    {
-        return MakeErrorResponse(ErrorCodePathNotAllowed, PathReason);
+        const FString Extension = FPaths::GetExtension(FilePath, true).ToLower();
+        if (Extension == TEXT(".png"))
+        {
+            return StartsWith("\x89PNG");
+        }
+        if (Extension == TEXT(".jpg") || Extension == TEXT(".jpeg"))
+        {
+            return StartsWith("\xFF\xD8");
+        }
+        if (Extension == TEXT(".bmp"))
+        {
+            return StartsWith("BM");
+        }
+        if (Extension == TEXT(".exr"))
+        {
+            return StartsWith("\x76\x2F\x31\x01");
+        }
+        if (Extension == TEXT(".wav"))
+        {
+            return StartsWith("RIFF") && StartsWith("WAVE", 8);
+        }
+        if (Extension == TEXT(".ogg"))
+        {
+            return StartsWith("OggS");
+        }
+        if (Extension == TEXT(".flac"))
+        {
+            return StartsWith("fLaC");
+        }
+        return true;
     }
 
-    const TArray<TSharedPtr<FJsonValue>>* FilesArray = nullptr;
-    if (!Params->TryGetArrayField(TEXT("files"), FilesArray) || !FilesArray || FilesArray->Num() == 0)
+    /**
+     * Rough single-thread costs of the real import, for ordering and budgeting a batch rather than
+     * as a promise: a base per file plus a rate per byte, pixel (mips included) or audio second.
+     */
+    constexpr double EstimatedFileBaseMs = 5.0;
+    constexpr double EstimatedFbxBytesPerMs = 20.0 * 1024.0;
+    constexpr double EstimatedSkeletalFbxFactor = 2.0;
+    constexpr double EstimatedLdrPixelsPerMs = 25000.0;
+    constexpr double EstimatedHdrPixelsPerMs = 5000.0;
+    constexpr double EstimatedAudioMsPerChannelSecond = 2.0;
+    constexpr int32 MaxTextureDimension = 16384;
+
+    /** One file of an asset.plan_import request. */
+    struct FPlannedImport
     {
-        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing files array"));
-    }
+        FString SourceFile;
+        EImportKind Kind = EImportKind::Unknown;
+        FImportSourceInfo Info;
+        /** Empty when the file can be imported; otherwise one of the batch_import skip reasons. */
+        FString InvalidReason;
+        FString InvalidMessage;
+        /** What the headers say the file holds. */
+        FString PredictedKind;
+        /** What the request's options would import it as. */
+        FString ImportAs;
+        double EstimatedMs = 0.0;
+        TArray<FString> Warnings;
+    };
 
-    const TSharedPtr<FJsonObject>* OptionsObjectPtr = nullptr;
-    if (!Params->TryGetObjectField(TEXT("options"), OptionsObjectPtr))
+    /** Fills File's prediction, cost and option mismatches from its probed headers (any thread). */
+    void PredictImport(FPlannedImport& File, const FFbxOptions& FbxOptions, const FTextureOptions& TextureOptions)
     {
-        OptionsObjectPtr = nullptr;
-    }
-
-    const TSharedPtr<FJsonObject> OptionsObject = OptionsObjectPtr ? *OptionsObjectPtr : nullptr;
-
-    FString Preset;
-    Params->TryGetStringField(TEXT("preset"), Preset);
-
-    FFbxOptions FbxOptions;
-    FTextureOptions TextureOptions;
-    FAudioOptions AudioOptions;
+        const FImportSourceInfo& Info = File.Info;
+        File.EstimatedMs = EstimatedFileBaseMs;
 
-    ApplyFbxPreset(Preset, FbxOptions);
-    ApplyTexturePreset(Preset, TextureOptions);
-    ApplyAudioPreset(Preset, AudioOptions);
+        if (File.Kind == EImportKind::Fbx)
+        {
+            const bool bSkinned = Info.SkinClusterCount > 0;
+            File.PredictedKind = bSkinned ? TEXT("skeletalMesh") : (Info.GeometryCount == 0 && Info.AnimStackCount > 0 ? TEXT("animation") : TEXT("staticMesh"));
+            File.ImportAs = FbxOptions.bImportAsSkeletal ? TEXT("skeletalMesh") : TEXT("staticMesh");
+            File.EstimatedMs += Info.FileSize / EstimatedFbxBytesPerMs * (bSkinned ? EstimatedSkeletalFbxFactor : 1.0);
 
-    OverrideFbxOptions(OptionsObject, FbxOptions);
-    OverrideTextureOptions(OptionsObject, TextureOptions);
-    OverrideAudioOptions(OptionsObject, AudioOptions);
+            if (bSkinned && !FbxOptions.bImportAsSkeletal)
+            {
+                File.Warnings.Add(TEXT("Contains skinned meshes but importAsSkeletal is off; they would import as static meshes"));
+            }
+            else if (!bSkinned && FbxOptions.bImportAsSkeletal)
+            {
+                File.Warnings.Add(TEXT("Has no skin clusters but importAsSkeletal is on; the skeletal import would fail"));
+            }
+            if (Info.AnimStackCount > 0 && FbxOptions.bImportAsSkeletal && !FbxOptions.bImportAnimations)
+            {
+                File.Warnings.Add(TEXT("Contains animation stacks but importAnimations is off"));
+            }
+            if (Info.GeometryCount == 0 && Info.AnimStackCount == 0)
+            {
+                File.Warnings.Add(TEXT("Contains no geometry or animation"));
+            }
+        }
+        else if (File.Kind == EImportKind::Texture)
+        {
+            File.PredictedKind = Info.bHdr ? TEXT("hdrTexture") : TEXT("texture");
+            File.ImportAs = ParseCompressionSettings(TextureOptions.CompressionSettings) == TC_HDR ? TEXT("hdrTexture") : TEXT("texture");
 
-    const FConflictOptions ConflictOptions = ParseConflictOptions(OptionsObject);
+            const double Pixels = static_cast<double>(Info.Width) * Info.Height * 4.0 / 3.0;
+            File.EstimatedMs += Pixels / (Info.bHdr ? EstimatedHdrPixelsPerMs : EstimatedLdrPixelsPerMs);
 
-    if (!EnsureDirectory(DestPath))
-    {
-        return MakeErrorResponse(ErrorCodeDestPathInvalid, TEXT("Failed to create destination folder"));
+            if (Info.bHdr && TextureOptions.bSRGB)
+            {
+                File.Warnings.Add(TEXT("HDR source with sRGB on"));
+            }
+            if (Info.bHdr != (File.ImportAs == TEXT("hdrTexture")))
+            {
+                File.Warnings.Add(FString::Printf(TEXT("%s source with %s compression"), Info.bHdr ? TEXT("HDR") : TEXT("LDR"), *TextureOptions.CompressionSettings));
+            }
+            if (!FMath::IsPowerOfTwo(Info.Width) || !FMath::IsPowerOfTwo(Info.Height))
+            {
+                File.Warnings.Add(FString::Printf(TEXT("%dx%d is not a power of two; the texture gets no mips and does not stream"), Info.Width, Info.Height));
+            }
+            if (Info.Width > MaxTextureDimension || Info.Height > MaxTextureDimension)
+            {
+                File.Warnings.Add(FString::Printf(TEXT("%dx%d exceeds the %d texture limit"), Info.Width, Info.Height, MaxTextureDimension));
+            }
+        }
+        else if (File.Kind == EImportKind::Audio)
+        {
+            File.PredictedKind = TEXT("sound");
+            File.ImportAs = TEXT("sound");
+            File.EstimatedMs += Info.DurationSeconds * FMath::Max(Info.Channels, 1) * EstimatedAudioMsPerChannelSecond;
+            if (Info.Channels > 2)
+            {
+                File.Warnings.Add(FString::Printf(TEXT("%d channels; imported as a multichannel sound"), Info.Channels));
+            }
+        }
     }
 
-    TArray<FImportPlanEntry> PlanEntries;
-    PlanEntries.Reserve(FilesArray->Num());
-
-    TArray<TSharedPtr<FJsonValue>> AuditActions;
-
-    for (const TSharedPtr<FJsonValue>& Value : *FilesArray)
+    /** Kinds routed through Interchange instead of the legacy factories (options.interchange). */
+    struct FInterchangeKinds
     {
-        if (!Value.IsValid() || Value->Type != EJson::String)
+        bool bFbx = false;
+        bool bTexture = false;
+        bool bAudio = false;
+
+        bool Uses(EImportKind Kind) const
         {
-            continue;
+            return (Kind == EImportKind::Fbx && bFbx) || (Kind == EImportKind::Texture && bTexture) || (Kind == EImportKind::Audio && bAudio);
         }
+    };
 
-        FImportPlanEntry Entry;
-        Entry.SourceFile = Value->AsString();
-        Entry.SourceFile.TrimStartAndEndInline();
-        Entry.NormalizedSourceFile = Entry.SourceFile;
-
-        if (Entry.SourceFile.IsEmpty())
+    /** Accepts true/false for every kind or { "fbx": bool, "texture": bool, "audio": bool }. */
+    FInterchangeKinds ParseInterchangeKinds(const TSharedPtr<FJsonObject>& OptionsObject)
+    {
+        FInterchangeKinds Result;
+        if (!OptionsObject.IsValid())
         {
-            Entry.bShouldImport = false;
-            Entry.SkipReason = TEXT("empty_path");
-            PlanEntries.Add(MoveTemp(Entry));
-            continue;
+            return Result;
         }
 
-        if (!FPaths::FileExists(Entry.SourceFile))
+        bool bAll = false;
+        if (OptionsObject->TryGetBoolField(TEXT("interchange"), bAll))
         {
-            Entry.bShouldImport = false;
-            Entry.SkipReason = TEXT("file_not_found");
-            PlanEntries.Add(MoveTemp(Entry));
-            continue;
+            Result.bFbx = Result.bTexture = Result.bAudio = bAll;
+            return Result;
         }
 
-        Entry.Kind = DetectKindByExtension(Entry.SourceFile);
-        if (Entry.Kind == EImportKind::Unknown)
+        const TSharedPtr<FJsonObject>* KindsObject = nullptr;
+        if (OptionsObject->TryGetObjectField(TEXT("interchange"), KindsObject) && KindsObject && KindsObject->IsValid())
         {
-            Entry.bShouldImport = false;
-            Entry.SkipReason = TEXT("unsupported_extension");
-            PlanEntries.Add(MoveTemp(Entry));
-            continue;
+            (*KindsObject)->TryGetBoolField(TEXT("fbx"), Result.bFbx);
+            (*KindsObject)->TryGetBoolField(TEXT("texture"), Result.bTexture);
+            (*KindsObject)->TryGetBoolField(TEXT("audio"), Result.bAudio);
         }
+        return Result;
+    }
 
-        Entry.DestPath = DestPath;
-        Entry.PackageBaseName = FPaths::GetBaseFilename(Entry.SourceFile);
+    /** The generic Interchange pipeline configured from the same options the legacy FBX factory gets. */
+    UInterchangeGenericAssetsPipeline* CreateInterchangePipeline(const FImportPlanEntry& Entry, const FFbxOptions& FbxOptions, const FTextureOptions& TextureOptions)
+    {
+        UInterchangeGenericAssetsPipeline* Pipeline = NewObject<UInterchangeGenericAssetsPipeline>(GetTransientPackage());
 
-        const FString PackagePath = FString::Printf(TEXT("%s/%s"), *DestPath, *Entry.PackageBaseName);
-        FString ExistingPackageFilename;
-        if (FPackageName::DoesPackageExist(PackagePath, &ExistingPackageFilename))
+        if (Entry.Kind == EImportKind::Fbx)
         {
-            Entry.bWillOverwrite = true;
-            Entry.PreExistingPackages.Add(PackagePath);
-        }
+            if (Pipeline->CommonMeshesProperties)
+            {
+                Pipeline->CommonMeshesProperties->ForceAllMeshAsType = FbxOptions.bImportAsSkeletal ? EInterchangeForceMeshType::IFMT_SkeletalMesh : EInterchangeForceMeshType::IFMT_StaticMesh;
 
-        if (Entry.bWillOverwrite && ConflictOptions.Policy == EConflictPolicy::Skip)
-        {
-            Entry.bShouldImport = false;
-            Entry.SkipReason = BuildSkipReason(ConflictOptions.Policy, PackagePath);
+                const FString NormalMethodLower = FbxOptions.NormalImportMethod.ToLower();
+                if (NormalMethodLower == TEXT("importnormalsandtangents"))
+                {
+                    Pipeline->CommonMeshesProperties->bRecomputeNormals = false;
+                    Pipeline->CommonMeshesProperties->bRecomputeTangents = false;
+                }
+                else if (NormalMethodLower == TEXT("computenormals"))
+                {
+                    Pipeline->CommonMeshesProperties->bRecomputeNormals = true;
+                }
+            }
+            if (Pipeline->MeshPipeline)
+            {
+                Pipeline->MeshPipeline->bImportStaticMeshes = !FbxOptions.bImportAsSkeletal;
+                Pipeline->MeshPipeline->bImportSkeletalMeshes = FbxOptions.bImportAsSkeletal;
+                Pipeline->MeshPipeline->bCombineStaticMeshes = FbxOptions.bCombineMeshes;
+                Pipeline->MeshPipeline->bCreatePhysicsAsset = FbxOptions.bImportAsSkeletal;
+                if (!FbxOptions.LodGroup.IsEmpty())
+                {
+                    Pipeline->MeshPipeline->LodGroup = FName(*FbxOptions.LodGroup);
+                }
+            }
+            if (Pipeline->CommonSkeletalMeshesAndAnimationsProperties && !FbxOptions.SkeletonPath.IsEmpty())
+            {
+                Pipeline->CommonSkeletalMeshesAndAnimationsProperties->Skeleton = TSoftObjectPtr<USkeleton>(FSoftObjectPath(FbxOptions.SkeletonPath));
+            }
+            if (Pipeline->AnimationPipeline)
+            {
+                Pipeline->AnimationPipeline->bImportAnimations = FbxOptions.bImportAnimations;
+            }
+            if (Pipeline->MaterialPipeline)
+            {
+                Pipeline->MaterialPipeline->bImportMaterials = FbxOptions.bImportMaterials;
+            }
+            if (Pipeline->TexturePipeline)
+            {
+                Pipeline->TexturePipeline->bImportTextures = FbxOptions.bImportTextures;
+            }
         }
-        else if (Entry.bWillOverwrite && ConflictOptions.Policy == EConflictPolicy::CreateUnique)
+        else if (Entry.Kind == EImportKind::Texture && Pipeline->TexturePipeline)
         {
-            Entry.bWillOverwrite = false;
-            Entry.PreExistingPackages.Reset();
+            Pipeline->TexturePipeline->bFlipNormalMapGreenChannel = TextureOptions.bFlipGreenChannel;
         }
-
-        PlanEntries.Add(MoveTemp(Entry));
+        // The other texture and audio settings are applied after the import, as for the legacy factories.
+        return Pipeline;
     }
 
-    if (PlanEntries.Num() == 0)
+    constexpr int32 DefaultImportChunkSize = 8;
+    constexpr int32 MaxImportChunkSize = 256;
+    constexpr int64 DefaultImportMemoryCeilingBytes = 2048LL * 1024 * 1024;
+
+    /** An Interchange import started in an earlier chunk that has not completed yet. */
+    struct FPendingInterchangeImport
     {
-        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("No importable files"));
-    }
+        int32 EntryIndex = INDEX_NONE;
+        UE::Interchange::FAssetImportResultPtr Result;
+        TStrongObjectPtr<UInterchangeGenericAssetsPipeline> Pipeline;
+    };
 
-    // Early exit if all entries are skipped or invalid
-    bool bHasImportable = false;
-    for (const FImportPlanEntry& Entry : PlanEntries)
+    /** Where asset.batch_import stopped when it suspended between chunks. */
+    struct FImportResumeState : public UnrealMCP::Protocol::FCommandContext::FResumeState
+    {
+        TArray<FImportPlanEntry> PlanEntries;
+        FFbxOptions FbxOptions;
+        FTextureOptions TextureOptions;
+        FAudioOptions AudioOptions;
+        FConflictOptions ConflictOptions;
+        FInterchangeKinds InterchangeKinds;
+        int32 UnchangedCount = 0;
+        /** At most ChunkSize at a time; their translation runs on Interchange's worker tasks. */
+        TArray<FPendingInterchangeImport> PendingInterchange;
+
+        bool bSave = false;
+        int32 ChunkSize = DefaultImportChunkSize;
+        /** Growth in used physical memory since the first slice that triggers a collection. */
+        int64 MemoryCeilingBytes = DefaultImportMemoryCeilingBytes;
+        int64 StartUsedBytes = 0;
+
+        int32 NextEntry = 0;
+        int32 TasksTotal = 0;
+        int32 TasksDone = 0;
+        int32 ChunkCount = 0;
+        int32 GarbageCollections = 0;
+        bool bCancelled = false;
+        /** Every texture imported so far; their compilation is waited on (or reported) once, at the end. */
+        TArray<TWeakObjectPtr<UTexture>> ImportedTextures;
+        /** Names the journal under Saved/UnrealMCP/ImportJournal; the params are kept there for resume. */
+        FString BatchId;
+        TSharedPtr<FJsonObject> Params;
+        TMap<FString, FJournaledEntry> Journaled;
+        int32 AlreadyImportedCount = 0;
+    };
+
+    /** An entry as an earlier run of the same batch left it in the journal. */
+    struct FJournaledEntry
+    {
+        EJournalStatus Status = EJournalStatus::Pending;
+        TArray<FString> ObjectPaths;
+    };
+
+    /** Batch ids name files under Saved/, so they are kept to [A-Za-z0-9_-]. */
+    bool IsValidBatchId(const FString& BatchId)
     {
-        if (Entry.bShouldImport)
+        if (BatchId.IsEmpty() || BatchId.Len() > 64)
         {
-            bHasImportable = true;
-            break;
+            return false;
+        }
+        for (const TCHAR Char : BatchId)
+        {
+            if (!FChar::IsAlnum(Char) && Char != TEXT('-') && Char != TEXT('_'))
+            {
+                return false;
+            }
         }
+        return true;
     }
 
-    if (!bHasImportable)
+    FString GetImportJournalPath(const FString& BatchId)
     {
-        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-        Data->SetBoolField(TEXT("ok"), true);
+        return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP"), TEXT("ImportJournal"), BatchId + TEXT(".json"));
+    }
 
-        TArray<TSharedPtr<FJsonValue>> SkippedArray;
-        for (const FImportPlanEntry& Entry : PlanEntries)
+    /** Reads BatchId's journal: the params the batch was started with and each file's last status. */
+    bool ReadImportJournal(const FString& BatchId, TSharedPtr<FJsonObject>& OutParams, TMap<FString, FJournaledEntry>& OutEntries)
+    {
+        FString Contents;
+        if (!FFileHelper::LoadFileToString(Contents, *GetImportJournalPath(BatchId)))
         {
-            if (!Entry.bShouldImport)
-            {
-                AddResultEntry(SkippedArray, Entry.SourceFile, {}, Entry.SkipReason);
-            }
+            return false;
         }
 
-        AppendArrayField(Data, TEXT("skipped"), SkippedArray);
-        Data->SetBoolField(TEXT("dryRun"), false);
+        TSharedPtr<FJsonObject> Journal;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Contents);
+        const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+        if (!FJsonSerializer::Deserialize(Reader, Journal) || !Journal.IsValid()
+            || !Journal->TryGetObjectField(TEXT("params"), ParamsObject))
+        {
+            return false;
+        }
+        OutParams = *ParamsObject;
 
-        TSharedPtr<FJsonObject> Audit = MakeShared<FJsonObject>();
-        Audit->SetBoolField(TEXT("dryRun"), false);
-        Audit->SetArrayField(TEXT("actions"), AuditActions);
-        Data->SetObjectField(TEXT("audit"), Audit);
+        const TArray<TSharedPtr<FJsonValue>>* EntriesArray = nullptr;
+        if (Journal->TryGetArrayField(TEXT("entries"), EntriesArray))
+        {
+            for (const TSharedPtr<FJsonValue>& Value : *EntriesArray)
+            {
+                const TSharedPtr<FJsonObject>* EntryObject = nullptr;
+                FString SourceFile;
+                FString Status;
+                if (!Value->TryGetObject(EntryObject) || !(*EntryObject)->TryGetStringField(TEXT("sourceFile"), SourceFile))
+                {
+                    continue;
+                }
 
-        return MakeSuccessResponse(Data);
+                FJournaledEntry& Entry = OutEntries.Add(SourceFile);
+                (*EntryObject)->TryGetStringField(TEXT("status"), Status);
+                Entry.Status = JournalStatusFromString(Status);
+                (*EntryObject)->TryGetStringArrayField(TEXT("objects"), Entry.ObjectPaths);
+            }
+        }
+        return true;
     }
 
-    // Ensure checkout for overwrite cases when required by settings
-    for (const FImportPlanEntry& Entry : PlanEntries)
+    /**
+     * Rewrites State's journal. Each write replaces the whole file through a temporary, so a crash
+     * leaves either the previous journal or the new one.
+     */
+    void WriteImportJournal(const FImportResumeState& State, bool bFinished)
     {
-        if (!Entry.bShouldImport || !Entry.bWillOverwrite)
+        if (State.BatchId.IsEmpty())
         {
-            continue;
+            return;
         }
 
-        TSharedPtr<FJsonObject> CheckoutError;
-        if (!EnsureCheckoutForPackages(Entry.PreExistingPackages, CheckoutError))
+        TArray<TSharedPtr<FJsonValue>> EntriesArray;
+        EntriesArray.Reserve(State.PlanEntries.Num());
+        for (const FImportPlanEntry& Entry : State.PlanEntries)
         {
-            FString FailureMessage = TEXT("Source control checkout failed");
-            if (CheckoutError.IsValid() && CheckoutError->HasField(TEXT("message")))
+            TSharedPtr<FJsonObject> EntryObject = MakeShared<FJsonObject>();
+            EntryObject->SetStringField(TEXT("sourceFile"), Entry.SourceFile);
+            EntryObject->SetStringField(TEXT("status"), JournalStatusToString(Entry.JournalStatus));
+            if (Entry.ImportedObjectPaths.Num() > 0)
             {
-                FailureMessage = CheckoutError->GetStringField(TEXT("message"));
+                TArray<TSharedPtr<FJsonValue>> Objects;
+                for (const FString& ObjectPath : Entry.ImportedObjectPaths)
+                {
+                    Objects.Add(MakeShared<FJsonValueString>(ObjectPath));
+                }
+                EntryObject->SetArrayField(TEXT("objects"), Objects);
             }
-            return MakeErrorResponse(ErrorCodeSourceControlRequired, FailureMessage);
+            EntriesArray.Add(MakeShared<FJsonValueObject>(EntryObject));
         }
-    }
 
-    FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+        TSharedPtr<FJsonObject> Journal = MakeShared<FJsonObject>();
+        Journal->SetStringField(TEXT("batchId"), State.BatchId);
+        Journal->SetStringField(TEXT("updated"), FDateTime::UtcNow().ToIso8601());
+        Journal->SetBoolField(TEXT("finished"), bFinished);
+        Journal->SetObjectField(TEXT("params"), State.Params);
+        Journal->SetArrayField(TEXT("entries"), EntriesArray);
 
-    TArray<UAssetImportTask*> ImportTasks;
-    ImportTasks.Reserve(PlanEntries.Num());
+        FString Serialized;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Serialized);
+        FJsonSerializer::Serialize(Journal.ToSharedRef(), Writer);
 
-    TArray<TStrongObjectPtr<UAssetImportTask>> OwnedTasks;
-    TArray<TStrongObjectPtr<UObject>> OwnedObjects;
+        const FString JournalPath = GetImportJournalPath(State.BatchId);
+        const FString TempPath = JournalPath + TEXT(".tmp");
+        if (!FFileHelper::SaveStringToFile(Serialized, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+            || !IFileManager::Get().Move(*JournalPath, *TempPath, /*bReplace*/ true))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCP: could not write import journal %s"), *JournalPath);
+        }
+    }
 
-    for (FImportPlanEntry& Entry : PlanEntries)
+    /**
+     * Entries a previous run of the batch already finished are skipped. A saved entry counts, and so
+     * does a post-processed one (a batch without save) whose assets are still loadable, which is the
+     * case after a dropped connection but not after a crash.
+     */
+    int32 ApplyImportJournal(TArray<FImportPlanEntry>& PlanEntries, const TMap<FString, FJournaledEntry>& Journaled)
     {
-        if (!Entry.bShouldImport)
+        int32 AlreadyImported = 0;
+        for (FImportPlanEntry& Entry : PlanEntries)
         {
-            continue;
+            const FJournaledEntry* Previous = Entry.bShouldImport ? Journaled.Find(Entry.SourceFile) : nullptr;
+            if (!Previous || Previous->ObjectPaths.Num() == 0)
+            {
+                continue;
+            }
+
+            bool bDone = Previous->Status == EJournalStatus::Saved;
+            if (!bDone && Previous->Status == EJournalStatus::PostProcessed)
+            {
+                bDone = true;
+                for (const FString& ObjectPath : Previous->ObjectPaths)
+                {
+                    bDone &= LoadObject<UObject>(nullptr, *ObjectPath) != nullptr;
+                }
+            }
+            if (bDone)
+            {
+                Entry.bShouldImport = false;
+                Entry.SkipReason = TEXT("alreadyImported");
+                Entry.JournalStatus = Previous->Status;
+                Entry.ImportedObjectPaths = Previous->ObjectPaths;
+                ++AlreadyImported;
+            }
         }
+        return AlreadyImported;
+    }
 
+    /** Builds the import task (with its factory and options) for one plan entry. */
+    TStrongObjectPtr<UAssetImportTask> CreateImportTask(FImportPlanEntry& Entry, const FImportResumeState& State, IAssetTools& AssetTools, TArray<TStrongObjectPtr<UObject>>& OwnedObjects)
+    {
         TStrongObjectPtr<UAssetImportTask> Task = TStrongObjectPtr<UAssetImportTask>(NewObject<UAssetImportTask>());
         Task->Filename = Entry.SourceFile;
         Task->DestinationPath = Entry.DestPath;
         Task->bAutomated = true;
         Task->bSave = false;
-        Task->bReplaceExisting = (ConflictOptions.Policy == EConflictPolicy::Overwrite);
+        Task->bReplaceExisting = (State.ConflictOptions.Policy == EConflictPolicy::Overwrite);
 
-        if (ConflictOptions.Policy == EConflictPolicy::CreateUnique)
+        if (State.ConflictOptions.Policy == EConflictPolicy::CreateUnique)
         {
             FString TargetPackage = FString::Printf(TEXT("%s/%s"), *Entry.DestPath, *Entry.PackageBaseName);
             FString UniquePackage;
             FString UniqueName;
-            AssetToolsModule.Get().CreateUniqueAssetName(TargetPackage, TEXT(""), UniquePackage, UniqueName);
+            AssetTools.CreateUniqueAssetName(TargetPackage, TEXT(""), UniquePackage, UniqueName);
             Task->DestinationName = UniqueName;
         }
 
@@ -811,6 +1209,7 @@ TSharedPtr<FJsonObject> FAssetImport::BatchImport(const TSharedPtr<FJsonObject>&
         {
         case EImportKind::Fbx:
         {
+            const FFbxOptions& FbxOptions = State.FbxOptions;
             UFbxImportUI* ImportUI = NewObject<UFbxImportUI>();
             ImportUI->bImportAsSkeletalMesh = FbxOptions.bImportAsSkeletal;
             ImportUI->bImportMesh = true;
@@ -858,7 +1257,11 @@ TSharedPtr<FJsonObject> FAssetImport::BatchImport(const TSharedPtr<FJsonObject>&
         {
             UTextureFactory* TextureFactory = NewObject<UTextureFactory>();
             TextureFactory->SuppressImportOverwriteDialog();
-            TextureFactory->bCreateMaterial = TextureOptions.bCreateMaterial;
+            TextureFactory->bCreateMaterial = State.TextureOptions.bCreateMaterial;
+            // Settings known before the import are compiled with the texture the first time.
+            TextureFactory->CompressionSettings = ParseCompressionSettings(State.TextureOptions.CompressionSettings);
+            TextureFactory->MipGenSettings = ParseMipGenSettings(State.TextureOptions.MipGenSettings);
+            TextureFactory->bFlipNormalMapGreenChannel = State.TextureOptions.bFlipGreenChannel;
             OverrideFactory = TextureFactory;
             break;
         }
@@ -888,88 +1291,566 @@ TSharedPtr<FJsonObject> FAssetImport::BatchImport(const TSharedPtr<FJsonObject>&
             OwnedObjects.Add(TStrongObjectPtr<UObject>(OptionsObject));
         }
 
-        ImportTasks.Add(Task.Get());
-        Task->AddToRoot();
-        OwnedTasks.Add(MoveTemp(Task));
+        return Task;
     }
 
-    if (ImportTasks.Num() == 0)
+    /** Response for a batch in which nothing is left to import. */
+    /** Records what Entry's import produced and applies the texture/audio options to it. */
+    void FinishImportedEntry(FImportPlanEntry& Entry, FImportResumeState& State, TSet<UPackage*>& OutPackages)
     {
-        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-        Data->SetBoolField(TEXT("ok"), true);
+        if (Entry.ImportedObjectPaths.Num() == 0)
+        {
+            Entry.bImportFailed = true;
+            Entry.JournalStatus = EJournalStatus::Failed;
+            return;
+        }
+        Entry.JournalStatus = EJournalStatus::Imported;
 
-        TArray<TSharedPtr<FJsonValue>> SkippedArray;
-        for (const FImportPlanEntry& Entry : PlanEntries)
+        for (const FString& ObjectPath : Entry.ImportedObjectPaths)
         {
-            if (!Entry.bShouldImport)
+            UObject* AssetObject = LoadObject<UObject>(nullptr, *ObjectPath);
+            if (!AssetObject)
             {
-                AddResultEntry(SkippedArray, Entry.SourceFile, {}, Entry.SkipReason);
+                continue;
+            }
+            if (Entry.Kind == EImportKind::Texture)
+            {
+                if (UTexture* Texture = Cast<UTexture>(AssetObject))
+                {
+                    bool bChanged = false;
+                    ApplyTexturePostImport(Texture, State.TextureOptions, bChanged);
+                    State.ImportedTextures.Add(Texture);
+                }
+            }
+            else if (Entry.Kind == EImportKind::Audio)
+            {
+                if (USoundWave* SoundWave = Cast<USoundWave>(AssetObject))
+                {
+                    bool bChanged = false;
+                    ApplyAudioPostImport(SoundWave, State.AudioOptions, bChanged);
+                }
+            }
+            OutPackages.Add(AssetObject->GetOutermost());
+        }
+        Entry.JournalStatus = EJournalStatus::PostProcessed;
+    }
+
+    /** Starts Entry's Interchange import; it translates on worker tasks and completes on a later tick. */
+    FPendingInterchangeImport StartInterchangeImport(int32 EntryIndex, const FImportResumeState& State, IAssetTools& AssetTools)
+    {
+        const FImportPlanEntry& Entry = State.PlanEntries[EntryIndex];
+
+        FPendingInterchangeImport Pending;
+        Pending.EntryIndex = EntryIndex;
+        Pending.Pipeline = TStrongObjectPtr<UInterchangeGenericAssetsPipeline>(CreateInterchangePipeline(Entry, State.FbxOptions, State.TextureOptions));
+
+        FImportAssetParameters ImportParameters;
+        ImportParameters.bIsAutomated = true;
+        ImportParameters.bReplaceExisting = (State.ConflictOptions.Policy == EConflictPolicy::Overwrite);
+        ImportParameters.OverridePipelines.Add(FSoftObjectPath(Pending.Pipeline.Get()));
+        if (State.ConflictOptions.Policy == EConflictPolicy::CreateUnique)
+        {
+            FString UniquePackage;
+            FString UniqueName;
+            AssetTools.CreateUniqueAssetName(FString::Printf(TEXT("%s/%s"), *Entry.DestPath, *Entry.PackageBaseName), TEXT(""), UniquePackage, UniqueName);
+            ImportParameters.DestinationName = UniqueName;
+        }
+
+        UInterchangeManager& InterchangeManager = UInterchangeManager::GetInterchangeManager();
+        Pending.Result = InterchangeManager.ImportAssetAsync(Entry.DestPath, UInterchangeManager::CreateSourceData(Entry.SourceFile), ImportParameters);
+        return Pending;
+    }
+
+    /** Finishes the Interchange imports that have completed (all of them, waiting, with bWait). Returns how many. */
+    int32 CollectInterchangeImports(FImportResumeState& State, bool bWait, TArray<int32>& OutFinishedEntries, TSet<UPackage*>& OutPackages)
+    {
+        int32 Finished = 0;
+        for (int32 PendingIndex = State.PendingInterchange.Num() - 1; PendingIndex >= 0; --PendingIndex)
+        {
+            FPendingInterchangeImport& Pending = State.PendingInterchange[PendingIndex];
+            if (Pending.Result.IsValid() && Pending.Result->GetStatus() != UE::Interchange::FImportResult::EStatus::Done)
+            {
+                if (!bWait)
+                {
+                    continue;
+                }
+                Pending.Result->WaitUntilDone();
+            }
+
+            FImportPlanEntry& Entry = State.PlanEntries[Pending.EntryIndex];
+            if (Pending.Result.IsValid())
+            {
+                for (const UObject* ImportedObject : Pending.Result->GetImportedObjects())
+                {
+                    if (ImportedObject)
+                    {
+                        Entry.ImportedObjectPaths.AddUnique(ImportedObject->GetPathName());
+                    }
+                }
+            }
+            FinishImportedEntry(Entry, State, OutPackages);
+            OutFinishedEntries.Add(Pending.EntryIndex);
+            ++State.TasksDone;
+            ++Finished;
+
+            State.PendingInterchange.RemoveAtSwap(PendingIndex);
+        }
+        return Finished;
+    }
+
+    TSharedPtr<FJsonObject> MakeNothingToImportResponse(const FImportResumeState& State)
+    {
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetBoolField(TEXT("ok"), true);
+
+        TArray<TSharedPtr<FJsonValue>> SkippedArray;
+        for (const FImportPlanEntry& Entry : State.PlanEntries)
+        {
+            if (!Entry.bShouldImport)
+            {
+                AddResultEntry(SkippedArray, Entry.SourceFile, {}, Entry.SkipReason);
             }
         }
 
         AppendArrayField(Data, TEXT("skipped"), SkippedArray);
-        Data->SetObjectField(TEXT("audit"), MakeShared<FJsonObject>());
+        Data->SetNumberField(TEXT("unchanged"), State.UnchangedCount);
+        Data->SetStringField(TEXT("batchId"), State.BatchId);
+        Data->SetNumberField(TEXT("alreadyImported"), State.AlreadyImportedCount);
+        Data->SetBoolField(TEXT("dryRun"), false);
+
+        TSharedPtr<FJsonObject> Audit = MakeShared<FJsonObject>();
+        Audit->SetBoolField(TEXT("dryRun"), false);
+        Audit->SetArrayField(TEXT("actions"), TArray<TSharedPtr<FJsonValue>>());
+        Data->SetObjectField(TEXT("audit"), Audit);
+
         return MakeSuccessResponse(Data);
     }
 
-    FScopedTransaction Transaction(FText::FromString(FWriteGate::GetTransactionName()));
+    /**
+     * Parses the request into State's plan: validates, sniffs and hashes the files on worker
+     * threads, applies the conflict policy and checks out overwrites. Returns the response when the
+     * batch ends here (bad params, nothing to import), or null to go on importing.
+     */
+    TSharedPtr<FJsonObject> PlanBatchImport(const TSharedPtr<FJsonObject>& Params, FImportResumeState& State)
+    {
+        if (!Params.IsValid())
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing parameters"));
+        }
+
+        FString RawDestPath;
+        if (!Params->TryGetStringField(TEXT("destPath"), RawDestPath))
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing destPath"));
+        }
 
-    AssetToolsModule.Get().ImportAssetTasks(ImportTasks);
+        const FString DestPath = NormalizeContentPath(RawDestPath);
+        if (!DestPath.StartsWith(TEXT("/Game/")))
+        {
+            return MakeErrorResponse(ErrorCodeDestPathInvalid, TEXT("Destination must be under /Game"));
+        }
 
-    for (UAssetImportTask* Task : ImportTasks)
-    {
-        if (!Task)
+        FString PathReason;
+        if (!FWriteGate::IsPathAllowed(DestPath, PathReason))
         {
-            continue;
+            return MakeErrorResponse(ErrorCodePathNotAllowed, PathReason);
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* FilesArray = nullptr;
+        if (!Params->TryGetArrayField(TEXT("files"), FilesArray) || !FilesArray || FilesArray->Num() == 0)
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing files array"));
+        }
+
+        State.Params = Params;
+        if (State.BatchId.IsEmpty() && !Params->TryGetStringField(TEXT("batchId"), State.BatchId))
+        {
+            State.BatchId = FString::Printf(TEXT("import-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits).ToLower());
+        }
+        if (!IsValidBatchId(State.BatchId))
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("batchId may only contain letters, digits, '-' and '_'"));
         }
 
-        FImportPlanEntry* MatchingEntry = PlanEntries.FindByPredicate([Task](const FImportPlanEntry& Entry)
+        const TSharedPtr<FJsonObject>* OptionsObjectPtr = nullptr;
+        if (!Params->TryGetObjectField(TEXT("options"), OptionsObjectPtr))
         {
-            return Entry.SourceFile == Task->Filename;
+            OptionsObjectPtr = nullptr;
+        }
+
+        const TSharedPtr<FJsonObject> OptionsObject = OptionsObjectPtr ? *OptionsObjectPtr : nullptr;
+
+        FString Preset;
+        Params->TryGetStringField(TEXT("preset"), Preset);
+
+        ApplyFbxPreset(Preset, State.FbxOptions);
+        ApplyTexturePreset(Preset, State.TextureOptions);
+        ApplyAudioPreset(Preset, State.AudioOptions);
+
+        OverrideFbxOptions(OptionsObject, State.FbxOptions);
+        OverrideTextureOptions(OptionsObject, State.TextureOptions);
+        OverrideAudioOptions(OptionsObject, State.AudioOptions);
+
+        State.ConflictOptions = ParseConflictOptions(OptionsObject);
+        State.InterchangeKinds = ParseInterchangeKinds(OptionsObject);
+
+        Params->TryGetBoolField(TEXT("save"), State.bSave);
+        double ChunkSize = 0.0;
+        if (Params->TryGetNumberField(TEXT("chunkSize"), ChunkSize))
+        {
+            State.ChunkSize = FMath::Clamp(static_cast<int32>(ChunkSize), 1, MaxImportChunkSize);
+        }
+        double MemoryCeilingMb = 0.0;
+        if (Params->TryGetNumberField(TEXT("memoryCeilingMb"), MemoryCeilingMb))
+        {
+            State.MemoryCeilingBytes = static_cast<int64>(FMath::Max(MemoryCeilingMb, 0.0) * 1024.0 * 1024.0);
+        }
+        State.StartUsedBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+
+        if (!EnsureDirectory(DestPath))
+        {
+            return MakeErrorResponse(ErrorCodeDestPathInvalid, TEXT("Failed to create destination folder"));
+        }
+
+        TArray<FImportPlanEntry>& PlanEntries = State.PlanEntries;
+        PlanEntries.Reserve(FilesArray->Num());
+        for (const TSharedPtr<FJsonValue>& Value : *FilesArray)
+        {
+            if (!Value.IsValid() || Value->Type != EJson::String)
+            {
+                continue;
+            }
+
+            FImportPlanEntry& Entry = PlanEntries.AddDefaulted_GetRef();
+            Entry.SourceFile = Value->AsString();
+            Entry.SourceFile.TrimStartAndEndInline();
+            Entry.NormalizedSourceFile = Entry.SourceFile;
+            Entry.DestPath = DestPath;
+        }
+
+        if (PlanEntries.Num() == 0)
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("No importable files"));
+        }
+
+        // File checks touch the disk, so ten thousand of them are spread over the worker threads.
+        ParallelFor(PlanEntries.Num(), [&PlanEntries](int32 Index)
+        {
+            FImportPlanEntry& Entry = PlanEntries[Index];
+            if (Entry.SourceFile.IsEmpty())
+            {
+                Entry.bShouldImport = false;
+                Entry.SkipReason = TEXT("empty_path");
+                return;
+            }
+
+            if (!FPaths::FileExists(Entry.SourceFile))
+            {
+                Entry.bShouldImport = false;
+                Entry.SkipReason = TEXT("file_not_found");
+                return;
+            }
+
+            Entry.Kind = DetectKindByExtension(Entry.SourceFile);
+            if (Entry.Kind == EImportKind::Unknown)
+            {
+                Entry.bShouldImport = false;
+                Entry.SkipReason = TEXT("unsupported_extension");
+                return;
+            }
+
+            if (!HasPlausibleHeader(Entry.SourceFile))
+            {
+                Entry.bShouldImport = false;
+                Entry.SkipReason = TEXT("invalid_header");
+                return;
+            }
+
+            Entry.PackageBaseName = FPaths::GetBaseFilename(Entry.SourceFile);
         });
 
-        if (!MatchingEntry)
+        // On resume, what the interrupted run finished is neither re-imported nor treated as a conflict.
+        State.AlreadyImportedCount = ApplyImportJournal(PlanEntries, State.Journaled);
+
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+        for (FImportPlanEntry& Entry : PlanEntries)
         {
-            continue;
+            if (!Entry.bShouldImport)
+            {
+                continue;
+            }
+
+            const FString PackagePath = FString::Printf(TEXT("%s/%s"), *DestPath, *Entry.PackageBaseName);
+            FString ExistingPackageFilename;
+            if (FPackageName::DoesPackageExist(PackagePath, &ExistingPackageFilename))
+            {
+                Entry.bWillOverwrite = true;
+                Entry.PreExistingPackages.Add(PackagePath);
+            }
+
+            if (Entry.bWillOverwrite && State.ConflictOptions.Policy == EConflictPolicy::Skip)
+            {
+                Entry.bShouldImport = false;
+                Entry.SkipReason = BuildSkipReason(State.ConflictOptions.Policy, PackagePath);
+            }
+            else if (Entry.bWillOverwrite && State.ConflictOptions.Policy == EConflictPolicy::CreateUnique)
+            {
+                Entry.bWillOverwrite = false;
+                Entry.PreExistingPackages.Reset();
+            }
+            else if (Entry.bWillOverwrite && State.ConflictOptions.bSkipUnchanged)
+            {
+                CollectRecordedSourceHashes(AssetRegistry, PackagePath, Entry.SourceFile, Entry.RecordedSourceHashes);
+            }
+        }
+
+        // A nightly re-import of a mostly unchanged source tree should only touch the files that changed.
+        State.UnchangedCount = SkipUnchangedSources(PlanEntries);
+
+        UInterchangeManager& InterchangeManager = UInterchangeManager::GetInterchangeManager();
+        for (FImportPlanEntry& Entry : PlanEntries)
+        {
+            if (!Entry.bShouldImport || !State.InterchangeKinds.Uses(Entry.Kind))
+            {
+                continue;
+            }
+
+            // Formats without an Interchange translator (most audio, in 5.6) keep the legacy factory.
+            const UInterchangeSourceData* SourceData = UInterchangeManager::CreateSourceData(Entry.SourceFile);
+            Entry.bInterchange = SourceData && InterchangeManager.CanTranslateSourceData(SourceData);
+            if (!Entry.bInterchange)
+            {
+                Entry.Warnings.Add(FString::Printf(TEXT("Interchange cannot translate %s; imported with the legacy factory"), *Entry.SourceFile));
+            }
         }
 
-        MatchingEntry->ImportedObjectPaths = Task->ImportedObjectPaths;
-        if (MatchingEntry->ImportedObjectPaths.Num() == 0)
+        for (const FImportPlanEntry& Entry : PlanEntries)
+        {
+            State.TasksTotal += Entry.bShouldImport ? 1 : 0;
+        }
+        if (State.TasksTotal == 0)
         {
-            MatchingEntry->bImportFailed = true;
+            return MakeNothingToImportResponse(State);
         }
 
-        if (MatchingEntry->Kind == EImportKind::Texture)
+        // Ensure checkout for overwrite cases when required by settings
+        for (const FImportPlanEntry& Entry : PlanEntries)
         {
-            for (const FString& ObjectPath : MatchingEntry->ImportedObjectPaths)
+            if (!Entry.bShouldImport || !Entry.bWillOverwrite)
             {
-                UObject* AssetObject = LoadObject<UObject>(nullptr, *ObjectPath);
-                if (UTexture* Texture = Cast<UTexture>(AssetObject))
+                continue;
+            }
+
+            TSharedPtr<FJsonObject> CheckoutError;
+            if (!EnsureCheckoutForPackages(Entry.PreExistingPackages, CheckoutError))
+            {
+                FString FailureMessage = TEXT("Source control checkout failed");
+                if (CheckoutError.IsValid() && CheckoutError->HasField(TEXT("message")))
                 {
-                    bool bChanged = false;
-                    ApplyTexturePostImport(Texture, TextureOptions, bChanged);
+                    FailureMessage = CheckoutError->GetStringField(TEXT("message"));
                 }
+                return MakeErrorResponse(ErrorCodeSourceControlRequired, FailureMessage);
             }
         }
-        else if (MatchingEntry->Kind == EImportKind::Audio)
+
+        return nullptr;
+    }
+}
+
+TSharedPtr<FJsonObject> FAssetImport::BatchImport(const TSharedPtr<FJsonObject>& Params)
+{
+    // The plan is built in the first slice; files are then imported in chunks, each post-processed
+    // (and saved, with "save") before the next, suspending to the next frame once the budget is spent.
+    // Interchange imports run asynchronously, at most a chunk's worth in flight, and are finished
+    // the same way as they complete.
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+    TSharedPtr<FImportResumeState> State = Context ? Context->TakeResumeState<FImportResumeState>() : nullptr;
+    if (!State.IsValid())
+    {
+        State = MakeShared<FImportResumeState>();
+
+        // resume continues an interrupted batch with the params its journal recorded.
+        TSharedPtr<FJsonObject> PlanParams = Params;
+        FString ResumeBatchId;
+        if (Params.IsValid() && Params->TryGetStringField(TEXT("resume"), ResumeBatchId))
         {
-            for (const FString& ObjectPath : MatchingEntry->ImportedObjectPaths)
+            if (!IsValidBatchId(ResumeBatchId) || !ReadImportJournal(ResumeBatchId, PlanParams, State->Journaled))
             {
-                UObject* AssetObject = LoadObject<UObject>(nullptr, *ObjectPath);
-                if (USoundWave* SoundWave = Cast<USoundWave>(AssetObject))
+                return MakeErrorResponse(ErrorCodeJournalNotFound, FString::Printf(TEXT("No import journal for batch %s"), *ResumeBatchId));
+            }
+            State->BatchId = ResumeBatchId;
+        }
+
+        if (TSharedPtr<FJsonObject> Finished = PlanBatchImport(PlanParams, *State))
+        {
+            return Finished;
+        }
+        for (FImportPlanEntry& Entry : State->PlanEntries)
+        {
+            if (!Entry.bShouldImport && Entry.JournalStatus == EJournalStatus::Pending)
+            {
+                Entry.JournalStatus = EJournalStatus::Skipped;
+            }
+        }
+        WriteImportJournal(*State, /*bFinished*/ false);
+    }
+
+    FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+    TArray<FImportPlanEntry>& PlanEntries = State->PlanEntries;
+    const double SliceStart = FPlatformTime::Seconds();
+    const double SliceBudgetSeconds = FUnrealMCPRuntimeConfig::Get().GameThreadBudgetMs / 1000.0;
+
+    while (State->NextEntry < PlanEntries.Num() || State->PendingInterchange.Num() > 0)
+    {
+        // Entries whose import completed in this pass; their packages are saved together.
+        TArray<int32> Finished;
+        TSet<UPackage*> ChunkPackages;
+        int32 Progressed = CollectInterchangeImports(*State, /*bWait*/ false, Finished, ChunkPackages);
+
+        TArray<int32> Chunk;
+        while (State->NextEntry < PlanEntries.Num() && Chunk.Num() + State->PendingInterchange.Num() < State->ChunkSize)
+        {
+            if (PlanEntries[State->NextEntry].bShouldImport)
+            {
+                Chunk.Add(State->NextEntry);
+            }
+            ++State->NextEntry;
+        }
+
+        // One file at a time so a cancel takes effect between files. Files already imported stay
+        // imported and are reported as usual; the rest are reported as skipped. Interchange imports
+        // already started are left to finish.
+        if (Chunk.Num() > 0)
+        {
+            FScopedTransaction Transaction(FText::FromString(FWriteGate::GetTransactionName()), !FTransactionManager::IsUndoSuppressed());
+            for (const int32 EntryIndex : Chunk)
+            {
+                FImportPlanEntry& Entry = PlanEntries[EntryIndex];
+                if (State->bCancelled || UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
                 {
-                    bool bChanged = false;
-                    ApplyAudioPostImport(SoundWave, AudioOptions, bChanged);
+                    State->bCancelled = true;
+                    Entry.bShouldImport = false;
+                    Entry.SkipReason = TEXT("cancelled");
+                    continue;
+                }
+
+                UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(State->TasksDone, State->TasksTotal, TEXT("import"));
+                ++Progressed;
+
+                if (Entry.bInterchange)
+                {
+                    State->PendingInterchange.Add(StartInterchangeImport(EntryIndex, *State, AssetToolsModule.Get()));
+                    continue;
+                }
+
+                // Tasks, factories and options live only as long as their chunk.
+                TArray<TStrongObjectPtr<UObject>> OwnedObjects;
+                TStrongObjectPtr<UAssetImportTask> Task = CreateImportTask(Entry, *State, AssetToolsModule.Get(), OwnedObjects);
+                AssetToolsModule.Get().ImportAssetTasks({ Task.Get() });
+                ++State->TasksDone;
+
+                Entry.ImportedObjectPaths = Task->ImportedObjectPaths;
+                FinishImportedEntry(Entry, *State, ChunkPackages);
+                Finished.Add(EntryIndex);
+            }
+            ++State->ChunkCount;
+        }
+
+        // Without a next frame to come back on (a batch entry), wait for Interchange here.
+        const bool bCanSuspend = Context && Context->CanSuspend();
+        if (Progressed == 0 && !bCanSuspend)
+        {
+            CollectInterchangeImports(*State, /*bWait*/ true, Finished, ChunkPackages);
+        }
+
+        if (State->bSave && ChunkPackages.Num() > 0)
+        {
+            TArray<UPackage*> Packages = ChunkPackages.Array();
+            if (!UEditorLoadingAndSavingUtils::SavePackages(Packages, /*bOnlyDirty*/ true))
+            {
+                for (const int32 EntryIndex : Finished)
+                {
+                    if (!PlanEntries[EntryIndex].bImportFailed && PlanEntries[EntryIndex].bShouldImport)
+                    {
+                        PlanEntries[EntryIndex].Warnings.Add(FString::Printf(TEXT("%s was imported but not saved"), *PlanEntries[EntryIndex].SourceFile));
+                    }
+                }
+            }
+            else
+            {
+                for (const int32 EntryIndex : Finished)
+                {
+                    if (PlanEntries[EntryIndex].JournalStatus == EJournalStatus::PostProcessed)
+                    {
+                        PlanEntries[EntryIndex].JournalStatus = EJournalStatus::Saved;
+                    }
+                }
+            }
+        }
+        ChunkPackages.Reset();
+        if (Finished.Num() > 0)
+        {
+            WriteImportJournal(*State, /*bFinished*/ false);
+        }
+
+        // Saved chunks can be released once memory grows past the ceiling. Unsaved imports exist
+        // only in memory, so without save they stay; neither can run under a pending Interchange import.
+        const int64 UsedBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+        if (State->bSave && State->PendingInterchange.Num() == 0 && State->MemoryCeilingBytes > 0
+            && UsedBytes - State->StartUsedBytes > State->MemoryCeilingBytes)
+        {
+            if (FMemoryPolicy::Collect(TEXT("chunk"), false, true))
+            {
+                ++State->GarbageCollections;
+            }
+        }
+
+        if (State->bCancelled && State->NextEntry < PlanEntries.Num())
+        {
+            // Nothing else is imported; the remaining files are reported as skipped.
+            for (int32 Index = State->NextEntry; Index < PlanEntries.Num(); ++Index)
+            {
+                if (PlanEntries[Index].bShouldImport)
+                {
+                    PlanEntries[Index].bShouldImport = false;
+                    PlanEntries[Index].SkipReason = TEXT("cancelled");
                 }
             }
+            State->NextEntry = PlanEntries.Num();
+        }
+
+        // Interchange completes its imports on later ticks, so waiting on them always suspends.
+        const bool bMoreWork = State->NextEntry < PlanEntries.Num() || State->PendingInterchange.Num() > 0;
+        if (bMoreWork && bCanSuspend
+            && (Progressed == 0 || FPlatformTime::Seconds() - SliceStart >= SliceBudgetSeconds))
+        {
+            Context->Suspend(State.ToSharedRef());
+            return nullptr;
         }
     }
 
-    for (TStrongObjectPtr<UAssetImportTask>& TaskPtr : OwnedTasks)
+    UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(State->TasksDone, State->TasksTotal, TEXT("import"));
+
+    // Textures compile asynchronously; a bulk import waits for all of them once rather than per file.
+    TArray<UTexture*> CompilingTextures;
+    for (const TWeakObjectPtr<UTexture>& Texture : State->ImportedTextures)
+    {
+        if (Texture.IsValid() && Texture->IsCompiling())
+        {
+            CompilingTextures.Add(Texture.Get());
+        }
+    }
+    TArray<TSharedPtr<FJsonValue>> PendingTexturesArray;
+    if (State->TextureOptions.bWaitForCompilation && CompilingTextures.Num() > 0)
     {
-        if (TaskPtr.IsValid())
+        UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(State->TasksDone, State->TasksTotal, TEXT("compileTextures"));
+        FTextureCompilingManager::Get().FinishCompilation(CompilingTextures);
+    }
+    else
+    {
+        for (const UTexture* Texture : CompilingTextures)
         {
-            TaskPtr->RemoveFromRoot();
+            PendingTexturesArray.Add(MakeShared<FJsonValueString>(Texture->GetPathName()));
         }
     }
 
@@ -1017,6 +1898,7 @@ TSharedPtr<FJsonObject> FAssetImport::BatchImport(const TSharedPtr<FJsonObject>&
     TArray<TSharedPtr<FJsonValue>> OverwrittenArray;
     TArray<TSharedPtr<FJsonValue>> SkippedArray;
     TArray<TSharedPtr<FJsonValue>> FailedArray;
+    TArray<TSharedPtr<FJsonValue>> AuditActions;
 
     TArray<TSharedPtr<FJsonValue>> WarningValues;
 
@@ -1043,7 +1925,7 @@ TSharedPtr<FJsonObject> FAssetImport::BatchImport(const TSharedPtr<FJsonObject>&
             continue;
         }
 
-        if (Entry.bWillOverwrite && ConflictOptions.Policy == EConflictPolicy::Overwrite)
+        if (Entry.bWillOverwrite && State->ConflictOptions.Policy == EConflictPolicy::Overwrite)
         {
             AddResultEntry(OverwrittenArray, Entry.SourceFile, Entry.ImportedObjectPaths);
         }
@@ -1063,8 +1945,15 @@ TSharedPtr<FJsonObject> FAssetImport::BatchImport(const TSharedPtr<FJsonObject>&
         AddAuditAction(AuditActions, Entry.SourceFile, Entry.DestPath);
     }
 
+    // A cancelled batch keeps its journal open; resume picks up the files it never reached.
+    WriteImportJournal(*State, /*bFinished*/ !State->bCancelled);
+
     TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
     Data->SetBoolField(TEXT("ok"), bAllOk);
+    if (State->bCancelled)
+    {
+        Data->SetBoolField(TEXT("cancelled"), true);
+    }
 
     if (CreatedArray.Num() > 0)
     {
@@ -1082,6 +1971,15 @@ TSharedPtr<FJsonObject> FAssetImport::BatchImport(const TSharedPtr<FJsonObject>&
     {
         AppendArrayField(Data, TEXT("failed"), FailedArray);
     }
+    Data->SetNumberField(TEXT("unchanged"), State->UnchangedCount);
+    Data->SetNumberField(TEXT("chunks"), State->ChunkCount);
+    Data->SetNumberField(TEXT("garbageCollections"), State->GarbageCollections);
+    Data->SetStringField(TEXT("batchId"), State->BatchId);
+    Data->SetNumberField(TEXT("alreadyImported"), State->AlreadyImportedCount);
+    if (PendingTexturesArray.Num() > 0)
+    {
+        Data->SetArrayField(TEXT("pendingTextures"), PendingTexturesArray);
+    }
     if (WarningValues.Num() > 0)
     {
         Data->SetArrayField(TEXT("warnings"), WarningValues);
@@ -1094,3 +1992,176 @@ TSharedPtr<FJsonObject> FAssetImport::BatchImport(const TSharedPtr<FJsonObject>&
 
     return MakeSuccessResponse(Data);
 }
+
+TSharedPtr<FJsonObject> FAssetImport::PlanImport(const TSharedPtr<FJsonObject>& Params)
+{
+    // Everything here is file reads and registry-free checks, so it runs off the game thread and
+    // spreads the header reads over the worker pool.
+    if (!Params.IsValid())
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing parameters"));
+    }
+
+    FString RawDestPath;
+    if (!Params->TryGetStringField(TEXT("destPath"), RawDestPath))
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing destPath"));
+    }
+
+    const FString DestPath = NormalizeContentPath(RawDestPath);
+    if (!DestPath.StartsWith(TEXT("/Game/")))
+    {
+        return MakeErrorResponse(ErrorCodeDestPathInvalid, TEXT("Destination must be under /Game"));
+    }
+
+    FString PathReason;
+    if (!FWriteGate::IsPathAllowed(DestPath, PathReason))
+    {
+        return MakeErrorResponse(ErrorCodePathNotAllowed, PathReason);
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* FilesArray = nullptr;
+    if (!Params->TryGetArrayField(TEXT("files"), FilesArray) || !FilesArray || FilesArray->Num() == 0)
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing files array"));
+    }
+
+    const TSharedPtr<FJsonObject>* OptionsObjectPtr = nullptr;
+    const TSharedPtr<FJsonObject> OptionsObject = Params->TryGetObjectField(TEXT("options"), OptionsObjectPtr) ? *OptionsObjectPtr : nullptr;
+
+    FString Preset;
+    Params->TryGetStringField(TEXT("preset"), Preset);
+
+    FFbxOptions FbxOptions;
+    FTextureOptions TextureOptions;
+    ApplyFbxPreset(Preset, FbxOptions);
+    ApplyTexturePreset(Preset, TextureOptions);
+    OverrideFbxOptions(OptionsObject, FbxOptions);
+    OverrideTextureOptions(OptionsObject, TextureOptions);
+    const FConflictOptions ConflictOptions = ParseConflictOptions(OptionsObject);
+
+    TArray<FPlannedImport> Planned;
+    Planned.Reserve(FilesArray->Num());
+    for (const TSharedPtr<FJsonValue>& Value : *FilesArray)
+    {
+        if (Value.IsValid() && Value->Type == EJson::String)
+        {
+            FPlannedImport& File = Planned.AddDefaulted_GetRef();
+            File.SourceFile = Value->AsString().TrimStartAndEnd();
+        }
+    }
+
+    ParallelFor(Planned.Num(), [&Planned, &FbxOptions, &TextureOptions](int32 Index)
+    {
+        FPlannedImport& File = Planned[Index];
+        if (File.SourceFile.IsEmpty() || !FPaths::FileExists(File.SourceFile))
+        {
+            File.InvalidReason = File.SourceFile.IsEmpty() ? TEXT("empty_path") : TEXT("file_not_found");
+            return;
+        }
+
+        File.Kind = DetectKindByExtension(File.SourceFile);
+        if (File.Kind == EImportKind::Unknown)
+        {
+            File.InvalidReason = TEXT("unsupported_extension");
+            return;
+        }
+
+        if (!FImportSourceProbe::Probe(File.SourceFile, File.Info, File.InvalidMessage))
+        {
+            File.InvalidReason = TEXT("invalid_header");
+            return;
+        }
+        PredictImport(File, FbxOptions, TextureOptions);
+    });
+
+    // Two files with the same base name land on the same package; the second overwrites (or,
+    // with createUnique, sits next to) the first.
+    TMap<FString, int32> PackageUses;
+    TArray<TSharedPtr<FJsonValue>> FilesJson;
+    TArray<TSharedPtr<FJsonValue>> InvalidJson;
+    int64 TotalBytes = 0;
+    double TotalMs = 0.0;
+    int32 ConflictCount = 0;
+    int32 WarningCount = 0;
+
+    for (const FPlannedImport& File : Planned)
+    {
+        if (!File.InvalidReason.IsEmpty())
+        {
+            TSharedPtr<FJsonObject> Invalid = MakeShared<FJsonObject>();
+            Invalid->SetStringField(TEXT("file"), File.SourceFile);
+            Invalid->SetStringField(TEXT("reason"), File.InvalidReason);
+            if (!File.InvalidMessage.IsEmpty())
+            {
+                Invalid->SetStringField(TEXT("message"), File.InvalidMessage);
+            }
+            InvalidJson.Add(MakeShared<FJsonValueObject>(Invalid));
+            continue;
+        }
+
+        const FString PackagePath = FString::Printf(TEXT("%s/%s"), *DestPath, *FPaths::GetBaseFilename(File.SourceFile));
+        const int32 PriorUses = PackageUses.FindOrAdd(PackagePath)++;
+
+        TSharedPtr<FJsonObject> FileJson = MakeShared<FJsonObject>();
+        FileJson->SetStringField(TEXT("file"), File.SourceFile);
+        FileJson->SetStringField(TEXT("predictedKind"), File.PredictedKind);
+        FileJson->SetStringField(TEXT("importAs"), File.ImportAs);
+        FileJson->SetObjectField(TEXT("source"), File.Info.ToJson());
+        FileJson->SetNumberField(TEXT("estimatedMs"), FMath::RoundToInt(File.EstimatedMs));
+        FileJson->SetStringField(TEXT("package"), PackagePath);
+
+        FString ConflictWith;
+        if (PriorUses > 0)
+        {
+            ConflictWith = TEXT("batch");
+        }
+        else if (FPackageName::DoesPackageExist(PackagePath))
+        {
+            ConflictWith = TEXT("existing");
+        }
+        if (!ConflictWith.IsEmpty())
+        {
+            TSharedPtr<FJsonObject> Conflict = MakeShared<FJsonObject>();
+            Conflict->SetStringField(TEXT("with"), ConflictWith);
+            Conflict->SetStringField(TEXT("action"),
+                ConflictOptions.Policy == EConflictPolicy::Skip ? TEXT("skip")
+                : ConflictOptions.Policy == EConflictPolicy::CreateUnique ? TEXT("createUnique")
+                : TEXT("overwrite"));
+            FileJson->SetObjectField(TEXT("conflict"), Conflict);
+            ++ConflictCount;
+        }
+
+        if (File.Warnings.Num() > 0)
+        {
+            TArray<TSharedPtr<FJsonValue>> Warnings;
+            for (const FString& Warning : File.Warnings)
+            {
+                Warnings.Add(MakeShared<FJsonValueString>(Warning));
+            }
+            FileJson->SetArrayField(TEXT("warnings"), Warnings);
+            WarningCount += File.Warnings.Num();
+        }
+
+        FilesJson.Add(MakeShared<FJsonValueObject>(FileJson));
+        TotalBytes += File.Info.FileSize;
+        TotalMs += File.EstimatedMs;
+    }
+
+    TSharedPtr<FJsonObject> Totals = MakeShared<FJsonObject>();
+    Totals->SetNumberField(TEXT("files"), Planned.Num());
+    Totals->SetNumberField(TEXT("importable"), FilesJson.Num());
+    Totals->SetNumberField(TEXT("invalid"), InvalidJson.Num());
+    Totals->SetNumberField(TEXT("conflicts"), ConflictCount);
+    Totals->SetNumberField(TEXT("warnings"), WarningCount);
+    Totals->SetNumberField(TEXT("bytes"), static_cast<double>(TotalBytes));
+    Totals->SetNumberField(TEXT("estimatedMs"), FMath::RoundToInt(TotalMs));
+
+    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+    Data->SetBoolField(TEXT("ok"), InvalidJson.Num() == 0 && WarningCount == 0);
+    Data->SetStringField(TEXT("destPath"), DestPath);
+    Data->SetArrayField(TEXT("files"), FilesJson);
+    Data->SetArrayField(TEXT("invalid"), InvalidJson);
+    Data->SetObjectField(TEXT("totals"), Totals);
+    return MakeSuccessResponse(Data);
+}
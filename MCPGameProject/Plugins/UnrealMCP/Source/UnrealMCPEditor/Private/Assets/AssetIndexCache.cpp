@@ -0,0 +1,397 @@
+#include "Assets/AssetIndexCache.h"
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/ARFilter.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/AssetRegistryState.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/PathViews.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/ArrayWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "UnrealMCPLog.h"
+#include "UnrealMCPSettings.h"
+
+namespace
+{
+    /** Bumped whenever the header layout changes; the registry state carries its own version. */
+    constexpr uint32 IndexMagic = 0x4D435849; // "MCXI"
+    constexpr uint32 IndexVersion = 1;
+
+    FString GetIndexPath()
+    {
+        return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP"), TEXT("AssetIndex.bin"));
+    }
+
+    IAssetRegistry& GetAssetRegistry()
+    {
+        return FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    }
+
+    FAssetRegistrySerializationOptions MakeSerializationOptions()
+    {
+        FAssetRegistrySerializationOptions Options(UE::AssetRegistry::ESerializationTarget::ForDevelopment);
+        Options.bSerializeAssetRegistry = true;
+        Options.bSerializeDependencies = true;
+        Options.bSerializeSearchableNameDependencies = false;
+        Options.bSerializeManageDependencies = false;
+        Options.bSerializePackageData = false;
+        return Options;
+    }
+
+    /**
+     * Packages in State whose file is gone or newer than SavedAt. One recursive stat pass per
+     * content root; much cheaper than a lookup per package.
+     */
+    void FindStalePackages(const FAssetRegistryState& State, const FDateTime& SavedAt, TSet<FName>& OutStale)
+    {
+        TMap<FString, FDateTime> FileTimes;
+        TArray<FString> RootPaths;
+        FPackageName::QueryRootContentPaths(RootPaths);
+        for (const FString& RootPath : RootPaths)
+        {
+            FString ContentDir;
+            if (!FPackageName::TryConvertLongPackageNameToFilename(RootPath, ContentDir))
+            {
+                continue;
+            }
+            ContentDir = FPaths::ConvertRelativePathToFull(ContentDir);
+            IFileManager::Get().IterateDirectoryStatRecursively(*ContentDir, [&FileTimes](const TCHAR* Filename, const FFileStatData& StatData)
+            {
+                if (!StatData.bIsDirectory)
+                {
+                    const FStringView Extension = FPathViews::GetExtension(Filename, true);
+                    if (Extension == FPackageName::GetAssetPackageExtension() || Extension == FPackageName::GetMapPackageExtension())
+                    {
+                        FileTimes.Add(FPaths::GetBaseFilename(Filename, false), StatData.ModificationTime);
+                    }
+                }
+                return true;
+            });
+        }
+
+        TSet<FName> Packages;
+        State.EnumerateAllAssets(TSet<FName>(), [&Packages](const FAssetData& AssetData)
+        {
+            Packages.Add(AssetData.PackageName);
+            return true;
+        });
+
+        for (const FName& PackageName : Packages)
+        {
+            FString Filename;
+            const FDateTime* FileTime = nullptr;
+            if (FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), Filename))
+            {
+                FileTime = FileTimes.Find(FPaths::ConvertRelativePathToFull(Filename));
+            }
+            if (!FileTime || *FileTime > SavedAt)
+            {
+                OutStale.Add(PackageName);
+            }
+        }
+    }
+}
+
+FAssetIndexCache& FAssetIndexCache::Get()
+{
+    static FAssetIndexCache Cache;
+    return Cache;
+}
+
+void FAssetIndexCache::Start()
+{
+    check(IsInGameThread());
+    const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+    if (bStarted || !Settings || !Settings->bPersistAssetIndex)
+    {
+        return;
+    }
+    bStarted = true;
+
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+    if (AssetRegistry.IsLoadingAssets())
+    {
+        bScanComplete = false;
+        FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FAssetIndexCache::HandleFilesLoaded);
+        LoadAsync();
+    }
+    else
+    {
+        bScanComplete = true;
+    }
+
+    if (Settings->AssetIndexSaveIntervalMin > 0.0f)
+    {
+        SaveTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FAssetIndexCache::TickSave), Settings->AssetIndexSaveIntervalMin * 60.0f);
+    }
+}
+
+void FAssetIndexCache::Stop()
+{
+    if (!bStarted)
+    {
+        return;
+    }
+    bStarted = false;
+
+    if (SaveTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SaveTickerHandle);
+        SaveTickerHandle.Reset();
+    }
+
+    if (FilesLoadedHandle.IsValid())
+    {
+        if (FAssetRegistryModule* Module = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+        {
+            Module->Get().OnFilesLoaded().Remove(FilesLoadedHandle);
+        }
+        FilesLoadedHandle.Reset();
+    }
+
+    // A partial scan would overwrite a complete index with less; keep the old file instead.
+    if (bScanComplete)
+    {
+        Save();
+    }
+
+    // Save's worker and a pending load hold their own references; wait for the write to land.
+    while (bSaving)
+    {
+        FPlatformProcess::Sleep(0.01f);
+    }
+
+    FScopeLock Lock(&Mutex);
+    Loaded.Reset();
+}
+
+bool FAssetIndexCache::IsServing() const
+{
+    return !bScanComplete && GetLoaded().IsValid();
+}
+
+TSharedPtr<const FAssetIndexCache::FLoadedIndex, ESPMode::ThreadSafe> FAssetIndexCache::GetLoaded() const
+{
+    FScopeLock Lock(&Mutex);
+    return Loaded;
+}
+
+void FAssetIndexCache::LoadAsync()
+{
+    const FString IndexPath = GetIndexPath();
+    if (!IFileManager::Get().FileExists(*IndexPath))
+    {
+        return;
+    }
+
+    Async(EAsyncExecution::ThreadPool, [this, IndexPath]()
+    {
+        const double StartTime = FPlatformTime::Seconds();
+
+        // Mapped so the multi-hundred-megabyte file is read by the state's deserializer straight
+        // from the page cache instead of being copied into a buffer first.
+        TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*IndexPath));
+        TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile.IsValid() ? MappedFile->MapRegion() : nullptr);
+        TArray<uint8> FileData;
+        TArrayView<const uint8> Bytes;
+        if (MappedRegion.IsValid())
+        {
+            Bytes = TArrayView<const uint8>(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+        }
+        else if (FFileHelper::LoadFileToArray(FileData, *IndexPath))
+        {
+            Bytes = FileData;
+        }
+
+        FMemoryReaderView Reader(Bytes);
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        int64 SavedTicks = 0;
+        Reader << Magic << Version << SavedTicks;
+        if (Reader.IsError() || Magic != IndexMagic || Version != IndexVersion)
+        {
+            UE_LOG(LogUnrealMCP, Display, TEXT("FAssetIndexCache: Ignoring %s (unknown format)"), *IndexPath);
+            return;
+        }
+
+        TSharedRef<FLoadedIndex> Index = MakeShared<FLoadedIndex>();
+        Index->State = MakeShared<FAssetRegistryState, ESPMode::ThreadSafe>();
+        Index->SavedAt = FDateTime(SavedTicks);
+        if (!Index->State->Load(Reader, FAssetRegistryLoadOptions()) || Reader.IsError())
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("FAssetIndexCache: Could not read %s"), *IndexPath);
+            return;
+        }
+        Index->AssetCount = Index->State->GetNumAssets();
+        const double LoadedTime = FPlatformTime::Seconds();
+
+        FindStalePackages(*Index->State, Index->SavedAt, Index->StalePackages);
+
+        if (bScanComplete)
+        {
+            // The live scan beat us to it; nothing left to serve.
+            return;
+        }
+
+        {
+            FScopeLock Lock(&Mutex);
+            Loaded = Index;
+        }
+        UE_LOG(LogUnrealMCP, Display, TEXT("FAssetIndexCache: Serving %d saved assets (%d stale packages) until the registry scan finishes; load %.2f s, validation %.2f s"),
+            Index->AssetCount, Index->StalePackages.Num(), LoadedTime - StartTime, FPlatformTime::Seconds() - LoadedTime);
+    });
+}
+
+void FAssetIndexCache::HandleFilesLoaded()
+{
+    bScanComplete = true;
+    {
+        FScopeLock Lock(&Mutex);
+        Loaded.Reset();
+    }
+    Save();
+}
+
+bool FAssetIndexCache::TickSave(float DeltaTime)
+{
+    if (bScanComplete)
+    {
+        Save();
+    }
+    return true;
+}
+
+void FAssetIndexCache::Save()
+{
+    check(IsInGameThread());
+    bool bExpected = false;
+    if (!bSaving.compare_exchange_strong(bExpected, true))
+    {
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const FAssetRegistrySerializationOptions Options = MakeSerializationOptions();
+    TSharedRef<FAssetRegistryState, ESPMode::ThreadSafe> State = MakeShared<FAssetRegistryState, ESPMode::ThreadSafe>();
+    GetAssetRegistry().InitializeTemporaryAssetRegistryState(*State, Options);
+    const FDateTime SavedAt = FDateTime::UtcNow();
+    const double CopySeconds = FPlatformTime::Seconds() - StartTime;
+
+    // Serializing and writing hundreds of megabytes must not hold the frame.
+    Async(EAsyncExecution::ThreadPool, [this, State, Options, SavedAt, CopySeconds]()
+    {
+        FArrayWriter Writer;
+        uint32 Magic = IndexMagic;
+        uint32 Version = IndexVersion;
+        int64 SavedTicks = SavedAt.GetTicks();
+        Writer << Magic << Version << SavedTicks;
+
+        const FString IndexPath = GetIndexPath();
+        const FString TempPath = IndexPath + TEXT(".tmp");
+        if (State->Save(Writer, Options) && FFileHelper::SaveArrayToFile(Writer, *TempPath) && IFileManager::Get().Move(*IndexPath, *TempPath, true, true))
+        {
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("FAssetIndexCache: Saved %d assets (%lld bytes) to %s; copy %.2f s"), State->GetNumAssets(), Writer.TotalSize(), *IndexPath, CopySeconds);
+        }
+        else
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("FAssetIndexCache: Could not write %s"), *IndexPath);
+            IFileManager::Get().Delete(*TempPath, false, false, true);
+        }
+        bSaving = false;
+    });
+}
+
+bool FAssetIndexCache::GetAssets(const FARFilter& Filter, TArray<FAssetData>& OutAssets) const
+{
+    if (bScanComplete)
+    {
+        return false;
+    }
+    const TSharedPtr<const FLoadedIndex, ESPMode::ThreadSafe> Index = GetLoaded();
+    if (!Index.IsValid())
+    {
+        return false;
+    }
+
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+    FARCompiledFilter CompiledFilter;
+    AssetRegistry.CompileFilter(Filter, CompiledFilter);
+
+    // What the live scan already has is current; the saved index fills in the rest.
+    TArray<FAssetData> LiveAssets;
+    AssetRegistry.GetAssets(Filter, LiveAssets);
+    TSet<FName> Skip = Index->StalePackages;
+    for (const FAssetData& AssetData : LiveAssets)
+    {
+        Skip.Add(AssetData.PackageName);
+    }
+
+    OutAssets = MoveTemp(LiveAssets);
+    Index->State->GetAssets(CompiledFilter, Skip, OutAssets);
+    return true;
+}
+
+bool FAssetIndexCache::GetDependencies(FName PackageName, UE::AssetRegistry::EDependencyQuery Query, TArray<FName>& OutPackages) const
+{
+    const TSharedPtr<const FLoadedIndex, ESPMode::ThreadSafe> Index = bScanComplete ? nullptr : GetLoaded();
+    if (!Index.IsValid() || Index->StalePackages.Contains(PackageName))
+    {
+        return false;
+    }
+
+    TArray<FAssetIdentifier> Dependencies;
+    Index->State->GetDependencies(FAssetIdentifier(PackageName), Dependencies, UE::AssetRegistry::EDependencyCategory::Package, Query);
+    for (const FAssetIdentifier& Dependency : Dependencies)
+    {
+        OutPackages.AddUnique(Dependency.PackageName);
+    }
+    return true;
+}
+
+bool FAssetIndexCache::GetReferencers(FName PackageName, UE::AssetRegistry::EDependencyQuery Query, TArray<FName>& OutPackages) const
+{
+    const TSharedPtr<const FLoadedIndex, ESPMode::ThreadSafe> Index = bScanComplete ? nullptr : GetLoaded();
+    if (!Index.IsValid())
+    {
+        return false;
+    }
+
+    TArray<FAssetIdentifier> Referencers;
+    Index->State->GetReferencers(FAssetIdentifier(PackageName), Referencers, UE::AssetRegistry::EDependencyCategory::Package, Query);
+    for (const FAssetIdentifier& Referencer : Referencers)
+    {
+        // A stale referencer may no longer reference this package.
+        if (!Index->StalePackages.Contains(Referencer.PackageName))
+        {
+            OutPackages.AddUnique(Referencer.PackageName);
+        }
+    }
+    return true;
+}
+
+void FAssetIndexCache::AddStatus(FJsonObject& RegistryJson) const
+{
+    const TSharedPtr<const FLoadedIndex, ESPMode::ThreadSafe> Index = bScanComplete ? nullptr : GetLoaded();
+    if (!Index.IsValid())
+    {
+        return;
+    }
+
+    TSharedPtr<FJsonObject> IndexJson = MakeShared<FJsonObject>();
+    IndexJson->SetNumberField(TEXT("assets"), Index->AssetCount);
+    IndexJson->SetNumberField(TEXT("stalePackages"), Index->StalePackages.Num());
+    IndexJson->SetStringField(TEXT("savedAt"), Index->SavedAt.ToIso8601());
+    RegistryJson.SetObjectField(TEXT("startupIndex"), IndexJson);
+}
@@ -0,0 +1,422 @@
+#include "Assets/AssetNameIndex.h"
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeRWLock.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/SoftObjectPath.h"
+#include "UnrealMCPLog.h"
+
+namespace
+{
+    constexpr int32 TrigramLength = 3;
+
+    /** Dead entries are compacted away once there are this many and they outnumber the live ones. */
+    constexpr int32 CompactionThreshold = 4096;
+
+    uint64 PackTrigram(const TCHAR* Chars)
+    {
+        return (static_cast<uint64>(Chars[0] & 0x1FFFFF) << 42) | (static_cast<uint64>(Chars[1] & 0x1FFFFF) << 21) | static_cast<uint64>(Chars[2] & 0x1FFFFF);
+    }
+
+    /** Distinct trigrams of an already lowered string. */
+    void CollectTrigrams(const FString& Lowered, TArray<uint64>& OutTrigrams)
+    {
+        OutTrigrams.Reset();
+        for (int32 Index = 0; Index + TrigramLength <= Lowered.Len(); ++Index)
+        {
+            OutTrigrams.AddUnique(PackTrigram(*Lowered + Index));
+        }
+    }
+
+    /** Trigrams a fuzzy match must share with the query: at least half of them. */
+    int32 FuzzyThreshold(int32 QueryTrigrams)
+    {
+        return FMath::Max(1, (QueryTrigrams + 1) / 2);
+    }
+
+    bool MatchesLowered(const FString& LowerText, const FString& LowerQuery, FAssetNameIndex::EMatch Match)
+    {
+        switch (Match)
+        {
+        case FAssetNameIndex::EMatch::Prefix:
+            return LowerText.StartsWith(LowerQuery, ESearchCase::CaseSensitive);
+        case FAssetNameIndex::EMatch::Fuzzy:
+        {
+            TArray<uint64> QueryTrigrams;
+            CollectTrigrams(LowerQuery, QueryTrigrams);
+            if (QueryTrigrams.Num() < 2)
+            {
+                return LowerText.Contains(LowerQuery, ESearchCase::CaseSensitive);
+            }
+
+            TArray<uint64> TextTrigrams;
+            CollectTrigrams(LowerText, TextTrigrams);
+            int32 Shared = 0;
+            for (uint64 Trigram : QueryTrigrams)
+            {
+                Shared += TextTrigrams.Contains(Trigram) ? 1 : 0;
+            }
+            return Shared >= FuzzyThreshold(QueryTrigrams.Num());
+        }
+        case FAssetNameIndex::EMatch::Contains:
+        default:
+            return LowerText.Contains(LowerQuery, ESearchCase::CaseSensitive);
+        }
+    }
+}
+
+void FAssetNameIndex::FTrigramTable::AddRef(FName Key)
+{
+    if (const int32* ExistingId = IdByKey.Find(Key))
+    {
+        if (RefCounts[*ExistingId]++ == 0)
+        {
+            --DeadCount;
+        }
+        return;
+    }
+
+    const int32 Id = Keys.Add(Key);
+    Lowered.Add(Key.ToString().ToLower());
+    RefCounts.Add(1);
+    IdByKey.Add(Key, Id);
+
+    TArray<uint64> Trigrams;
+    CollectTrigrams(Lowered[Id], Trigrams);
+    for (uint64 Trigram : Trigrams)
+    {
+        Postings.FindOrAdd(Trigram).Add(Id);
+    }
+}
+
+void FAssetNameIndex::FTrigramTable::Release(FName Key)
+{
+    const int32* Id = IdByKey.Find(Key);
+    if (!Id || RefCounts[*Id] == 0)
+    {
+        return;
+    }
+
+    // The entry stays in the postings, skipped while dead, so a rename back costs nothing.
+    if (--RefCounts[*Id] == 0)
+    {
+        ++DeadCount;
+        if (DeadCount > CompactionThreshold && DeadCount > Keys.Num() - DeadCount)
+        {
+            Compact();
+        }
+    }
+}
+
+void FAssetNameIndex::FTrigramTable::Compact()
+{
+    TArray<FName> LiveKeys;
+    TArray<int32> LiveCounts;
+    for (int32 Id = 0; Id < Keys.Num(); ++Id)
+    {
+        if (RefCounts[Id] > 0)
+        {
+            LiveKeys.Add(Keys[Id]);
+            LiveCounts.Add(RefCounts[Id]);
+        }
+    }
+
+    Reset();
+    for (int32 Index = 0; Index < LiveKeys.Num(); ++Index)
+    {
+        AddRef(LiveKeys[Index]);
+        RefCounts[Index] = LiveCounts[Index];
+    }
+}
+
+void FAssetNameIndex::FTrigramTable::Reset()
+{
+    Keys.Reset();
+    Lowered.Reset();
+    RefCounts.Reset();
+    IdByKey.Reset();
+    Postings.Reset();
+    DeadCount = 0;
+}
+
+void FAssetNameIndex::FTrigramTable::Find(const FString& LowerQuery, EMatch Match, TArray<int32>& OutIds) const
+{
+    TArray<uint64> QueryTrigrams;
+    CollectTrigrams(LowerQuery, QueryTrigrams);
+
+    // Too short to have a trigram: compare against every entry, which are lowered already.
+    if (QueryTrigrams.Num() == 0)
+    {
+        for (int32 Id = 0; Id < Keys.Num(); ++Id)
+        {
+            if (RefCounts[Id] > 0 && MatchesLowered(Lowered[Id], LowerQuery, Match))
+            {
+                OutIds.Add(Id);
+            }
+        }
+        return;
+    }
+
+    if (Match == EMatch::Fuzzy && QueryTrigrams.Num() >= 2)
+    {
+        const int32 Threshold = FuzzyThreshold(QueryTrigrams.Num());
+        TArray<uint8> SharedCounts;
+        SharedCounts.SetNumZeroed(Keys.Num());
+        for (uint64 Trigram : QueryTrigrams)
+        {
+            if (const TArray<int32>* Posting = Postings.Find(Trigram))
+            {
+                for (int32 Id : *Posting)
+                {
+                    if (SharedCounts[Id] < MAX_uint8)
+                    {
+                        ++SharedCounts[Id];
+                    }
+                }
+            }
+        }
+        for (int32 Id = 0; Id < Keys.Num(); ++Id)
+        {
+            if (SharedCounts[Id] >= Threshold && RefCounts[Id] > 0)
+            {
+                OutIds.Add(Id);
+            }
+        }
+        return;
+    }
+
+    // Exact substring or prefix: every query trigram must be present; verify the rarest one's entries.
+    const TArray<int32>* Rarest = nullptr;
+    for (uint64 Trigram : QueryTrigrams)
+    {
+        const TArray<int32>* Posting = Postings.Find(Trigram);
+        if (!Posting)
+        {
+            return;
+        }
+        if (!Rarest || Posting->Num() < Rarest->Num())
+        {
+            Rarest = Posting;
+        }
+    }
+
+    const EMatch VerifyMatch = Match == EMatch::Fuzzy ? EMatch::Contains : Match;
+    for (int32 Id : *Rarest)
+    {
+        if (RefCounts[Id] > 0 && MatchesLowered(Lowered[Id], LowerQuery, VerifyMatch))
+        {
+            OutIds.Add(Id);
+        }
+    }
+}
+
+FAssetNameIndex& FAssetNameIndex::Get()
+{
+    static FAssetNameIndex Instance;
+    return Instance;
+}
+
+void FAssetNameIndex::Start()
+{
+    check(IsInGameThread());
+    {
+        FWriteScopeLock WriteLock(Lock);
+        if (bStarted)
+        {
+            return;
+        }
+        bStarted = true;
+    }
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddLambda([this](const FAssetData& AssetData)
+    {
+        FWriteScopeLock WriteLock(Lock);
+        if (bBuilt)
+        {
+            AddAsset(AssetData);
+        }
+    });
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddLambda([this](const FAssetData& AssetData)
+    {
+        FWriteScopeLock WriteLock(Lock);
+        if (bBuilt)
+        {
+            RemoveAsset(AssetData);
+        }
+    });
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddLambda([this](const FAssetData& AssetData, const FString& OldObjectPath)
+    {
+        const FSoftObjectPath OldPath(OldObjectPath);
+        const FString OldPackageName = OldPath.GetLongPackageName();
+
+        FWriteScopeLock WriteLock(Lock);
+        if (bBuilt)
+        {
+            RemoveAsset(FName(*OldPath.GetAssetName()), FName(*OldPackageName), FName(*FPackageName::GetLongPackagePath(OldPackageName)));
+            AddAsset(AssetData);
+        }
+    });
+}
+
+void FAssetNameIndex::Stop()
+{
+    if (FAssetRegistryModule* Module = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+    {
+        IAssetRegistry& AssetRegistry = Module->Get();
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+    }
+    AssetAddedHandle.Reset();
+    AssetRemovedHandle.Reset();
+    AssetRenamedHandle.Reset();
+
+    FWriteScopeLock WriteLock(Lock);
+    bStarted = false;
+    bBuilt = false;
+    Names.Reset();
+    PackagesByName.Reset();
+    Paths.Reset();
+}
+
+bool FAssetNameIndex::Prewarm()
+{
+    return EnsureBuilt();
+}
+
+bool FAssetNameIndex::EnsureBuilt()
+{
+    if (bBuilt)
+    {
+        return true;
+    }
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    if (AssetRegistry.IsLoadingAssets())
+    {
+        return false;
+    }
+
+    // Held across the enumeration so a delegate firing meanwhile is applied after the build, not lost.
+    FWriteScopeLock WriteLock(Lock);
+    if (!bStarted)
+    {
+        return false;
+    }
+    if (bBuilt)
+    {
+        return true;
+    }
+
+    const double StartSeconds = FPlatformTime::Seconds();
+    TArray<FAssetData> Assets;
+    AssetRegistry.GetAllAssets(Assets);
+    for (const FAssetData& AssetData : Assets)
+    {
+        AddAsset(AssetData);
+    }
+    bBuilt = true;
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("FAssetNameIndex: Indexed %d assets (%d names, %d folders) in %.0f ms"),
+        Assets.Num(), Names.IdByKey.Num(), Paths.IdByKey.Num(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+    return true;
+}
+
+void FAssetNameIndex::AddAsset(const FAssetData& AssetData)
+{
+    Names.AddRef(AssetData.AssetName);
+    PackagesByName.FindOrAdd(AssetData.AssetName).FindOrAdd(AssetData.PackageName) += 1;
+    Paths.AddRef(AssetData.PackagePath);
+}
+
+void FAssetNameIndex::RemoveAsset(const FAssetData& AssetData)
+{
+    RemoveAsset(AssetData.AssetName, AssetData.PackageName, AssetData.PackagePath);
+}
+
+void FAssetNameIndex::RemoveAsset(FName AssetName, FName PackageName, FName PackagePath)
+{
+    if (TMap<FName, int32>* Packages = PackagesByName.Find(AssetName))
+    {
+        int32* Count = Packages->Find(PackageName);
+        if (!Count)
+        {
+            return;
+        }
+        if (--(*Count) <= 0)
+        {
+            Packages->Remove(PackageName);
+            if (Packages->Num() == 0)
+            {
+                PackagesByName.Remove(AssetName);
+            }
+        }
+        Names.Release(AssetName);
+        Paths.Release(PackagePath);
+    }
+}
+
+bool FAssetNameIndex::FindAssetNames(const FString& Query, EMatch Match, TSet<FName>& OutNames, TSet<FName>& OutPackages)
+{
+    if (!EnsureBuilt())
+    {
+        return false;
+    }
+
+    const FString LowerQuery = Query.ToLower();
+    FReadScopeLock ReadLock(Lock);
+    if (!bBuilt)
+    {
+        return false;
+    }
+
+    TArray<int32> Ids;
+    Names.Find(LowerQuery, Match, Ids);
+    for (int32 Id : Ids)
+    {
+        const FName Name = Names.Keys[Id];
+        OutNames.Add(Name);
+        if (const TMap<FName, int32>* Packages = PackagesByName.Find(Name))
+        {
+            for (const TPair<FName, int32>& Package : *Packages)
+            {
+                OutPackages.Add(Package.Key);
+            }
+        }
+    }
+    return true;
+}
+
+bool FAssetNameIndex::FindPackagePaths(const FString& Query, EMatch Match, TSet<FName>& OutPaths)
+{
+    if (!EnsureBuilt())
+    {
+        return false;
+    }
+
+    const FString LowerQuery = Query.ToLower();
+    FReadScopeLock ReadLock(Lock);
+    if (!bBuilt)
+    {
+        return false;
+    }
+
+    TArray<int32> Ids;
+    Paths.Find(LowerQuery, Match, Ids);
+    for (int32 Id : Ids)
+    {
+        OutPaths.Add(Paths.Keys[Id]);
+    }
+    return true;
+}
+
+bool FAssetNameIndex::Matches(const FString& Text, const FString& Query, EMatch Match)
+{
+    return MatchesLowered(Text.ToLower(), Query.ToLower(), Match);
+}
@@ -1,5 +1,9 @@
 #include "Assets/AssetQuery.h"
 #include "CoreMinimal.h"
+#include "Assets/AssetClassResolver.h"
+#include "Assets/AssetIndexCache.h"
+#include "Assets/AssetNameIndex.h"
+#include "Async/ParallelFor.h"
 #include "AssetRegistry/AssetData.h"
 #include "AssetRegistry/ARFilter.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -8,7 +12,10 @@
 #include "Dom/JsonValue.h"
 #include "HAL/FileManager.h"
 #include "HAL/PlatformTime.h"
+#include "Misc/Base64.h"
+#include "Misc/Guid.h"
 #include "Misc/PackageName.h"
+#include "Misc/ScopeLock.h"
 #include "Modules/ModuleManager.h"
 #include "UObject/SoftObjectPath.h"
 #include "UObject/UObjectGlobals.h"
@@ -18,9 +25,26 @@
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 
+#include <algorithm>
+#include <atomic>
+
 namespace
 {
     constexpr int32 MaxLimit = 1000;
+    constexpr int32 MaxBatchPaths = 1000;
+
+    /** Per-asset work is split into chunks of this many for ParallelFor; smaller sets stay on the calling thread. */
+    constexpr int32 ParallelChunkSize = 2048;
+
+    int32 GetParallelChunkCount(int32 Count, int32 ChunkSize = ParallelChunkSize)
+    {
+        return (Count + ChunkSize - 1) / ChunkSize;
+    }
+
+    EParallelForFlags GetParallelFlags(int32 Count, int32 ChunkSize = ParallelChunkSize)
+    {
+        return Count > ChunkSize ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+    }
 
     IAssetRegistry& GetAssetRegistry()
     {
@@ -28,58 +52,74 @@ namespace
         return AssetRegistryModule.Get();
     }
 
-    bool ResolveClassPath(const FString& ClassName, FTopLevelAssetPath& OutPath)
+    FAssetFindParams::ETagMatch GetTagMatch(const FAssetFindParams& Params, const FName& Tag)
     {
-        if (ClassName.IsEmpty())
-        {
-            return false;
-        }
-
-        if (ClassName.Contains(TEXT(".")) || ClassName.Contains(TEXT("/")))
-        {
-            FTopLevelAssetPath ParsedPath(ClassName);
-            if (ParsedPath.IsNull())
-            {
-                return false;
-            }
-
-            OutPath = ParsedPath;
-            return true;
-        }
-
-        if (UClass* FoundClass = FindObject<UClass>(ANY_PACKAGE, *ClassName))
-        {
-            OutPath = FoundClass->GetClassPathName();
-            return true;
-        }
-
-        OutPath = FTopLevelAssetPath(FName(TEXT("/Script/Engine")), FName(*ClassName));
-        return true;
+        const FAssetFindParams::ETagMatch* Match = Params.TagMatch.Find(Tag);
+        return Match ? *Match : FAssetFindParams::ETagMatch::Contains;
     }
 
-    bool MatchesTagQuery(const FAssetData& AssetData, const TMap<FName, TArray<FString>>& TagQuery)
+    /** SkipTag was already applied by the registry filter. */
+    bool MatchesTagQuery(const FAssetData& AssetData, const FAssetFindParams& Params, const FName& SkipTag)
     {
-        if (TagQuery.Num() == 0)
+        if (Params.TagQuery.Num() == 0)
         {
             return true;
         }
 
         const FAssetDataTagMapSharedView& Tags = AssetData.TagsAndValues;
-        for (const TPair<FName, TArray<FString>>& Pair : TagQuery)
+        for (const TPair<FName, TArray<FString>>& Pair : Params.TagQuery)
         {
+            if (Pair.Key == SkipTag)
+            {
+                continue;
+            }
+
             const FAssetDataTagMapSharedView::FFindTagResult TagValue = Tags.FindTag(Pair.Key);
             if (!TagValue.IsSet())
             {
                 return false;
             }
 
-            const FString TagString = TagValue.GetValue();
-            for (const FString& ExpectedValue : Pair.Value)
+            switch (GetTagMatch(Params, Pair.Key))
+            {
+            case FAssetFindParams::ETagMatch::Exact:
+            {
+                const bool bAnyEqual = Pair.Value.ContainsByPredicate([&TagValue](const FString& ExpectedValue)
+                {
+                    return TagValue.Equals(ExpectedValue);
+                });
+                if (!bAnyEqual)
+                {
+                    return false;
+                }
+                break;
+            }
+            case FAssetFindParams::ETagMatch::Prefix:
             {
-                if (!TagString.Contains(ExpectedValue, ESearchCase::IgnoreCase))
+                const FString TagString = TagValue.GetValue();
+                const bool bAnyPrefix = Pair.Value.ContainsByPredicate([&TagString](const FString& ExpectedValue)
+                {
+                    return TagString.StartsWith(ExpectedValue, ESearchCase::IgnoreCase);
+                });
+                if (!bAnyPrefix)
                 {
                     return false;
                 }
+                break;
+            }
+            case FAssetFindParams::ETagMatch::Contains:
+            default:
+            {
+                const FString TagString = TagValue.GetValue();
+                for (const FString& ExpectedValue : Pair.Value)
+                {
+                    if (!TagString.Contains(ExpectedValue, ESearchCase::IgnoreCase))
+                    {
+                        return false;
+                    }
+                }
+                break;
+            }
             }
         }
 
@@ -156,176 +196,855 @@ namespace
         }
     }
 
-    FString DependencyPackageToObjectPath(const FName& PackageName, IAssetRegistry& AssetRegistry)
+    void CopySelectedTags(const FAssetData& AssetData, const TArray<FName>& TagNames, TMap<FString, TArray<FString>>& OutTags)
     {
-        FString Result;
-        TArray<FAssetData> AssetsInPackage;
-        if (AssetRegistry.GetAssetsByPackageName(PackageName, AssetsInPackage))
+        OutTags.Reset();
+        for (const FName& TagName : TagNames)
         {
-            if (AssetsInPackage.Num() > 0)
+            const FAssetTagValueRef TagValue = AssetData.TagsAndValues.FindTag(TagName);
+            if (TagValue.IsSet())
             {
-                Result = AssetsInPackage[0].ToSoftObjectPath().ToString();
+                OutTags.Add(TagName.ToString(), ParseTagValues(TagValue.AsString()));
             }
         }
+    }
 
-        if (Result.IsEmpty())
+    FAssetLite MakeAssetLite(const FAssetData& AssetData, const FAssetFindParams::FFieldSelection& Fields)
+    {
+        FAssetLite Lite;
+        if (Fields.bObjectPath)
         {
-            Result = PackageName.ToString();
+            Lite.ObjectPath = AssetData.ToSoftObjectPath().ToString();
         }
-
-        return Result;
+        if (Fields.bPackagePath)
+        {
+            Lite.PackagePath = AssetData.PackagePath.ToString();
+        }
+        if (Fields.bAssetName)
+        {
+            Lite.AssetName = AssetData.AssetName.ToString();
+        }
+        if (Fields.bClassName)
+        {
+            Lite.ClassName = AssetData.AssetClassPath.GetAssetName().ToString();
+        }
+        if (Fields.bAllTags)
+        {
+            CopyTags(AssetData, Lite.Tags);
+        }
+        else if (Fields.TagNames.Num() > 0)
+        {
+            CopySelectedTags(AssetData, Fields.TagNames, Lite.Tags);
+        }
+        return Lite;
     }
 
-    void CollectDependencies(const FAssetData& AssetData, IAssetRegistry& AssetRegistry, bool bIncludeHard, bool bIncludeSoft, TArray<FString>& OutDependencies)
+    void CollectDependencyPackages(const FAssetData& AssetData, IAssetRegistry& AssetRegistry, bool bIncludeHard, bool bIncludeSoft, TArray<FName>& OutPackages)
     {
-        OutDependencies.Reset();
+        OutPackages.Reset();
 
-        TArray<FName> PackageDependencies;
         FAssetRegistryDependencyOptions Options;
         Options.bIncludeHardPackageReferences = bIncludeHard;
         Options.bIncludeSoftPackageReferences = bIncludeSoft;
         Options.bIncludeSearchableNames = false;
         Options.bIncludeHardManagementReferences = false;
         Options.bIncludeSoftManagementReferences = false;
-        AssetRegistry.GetDependencies(AssetData.PackageName, PackageDependencies, Options);
+        AssetRegistry.GetDependencies(AssetData.PackageName, OutPackages, Options);
+    }
+
+    /**
+     * Parses ObjectPaths and looks them all up in one registry query. OutSoftPaths lines up with
+     * ObjectPaths and holds a null path for entries that do not parse.
+     */
+    void LookupAssets(const TArray<FString>& ObjectPaths, IAssetRegistry& AssetRegistry, TArray<FSoftObjectPath>& OutSoftPaths, TMap<FSoftObjectPath, FAssetData>& OutAssets)
+    {
+        OutSoftPaths.Reset(ObjectPaths.Num());
+        OutAssets.Reset();
 
-        for (const FName& Dependency : PackageDependencies)
+        FARFilter Filter;
+        for (const FString& ObjectPath : ObjectPaths)
         {
-            OutDependencies.Add(DependencyPackageToObjectPath(Dependency, AssetRegistry));
+            FSoftObjectPath SoftPath(ObjectPath);
+            if (!ObjectPath.IsEmpty() && SoftPath.IsValid())
+            {
+                Filter.SoftObjectPaths.Add(SoftPath);
+                OutSoftPaths.Add(MoveTemp(SoftPath));
+            }
+            else
+            {
+                OutSoftPaths.Add(FSoftObjectPath());
+            }
+        }
+
+        if (Filter.SoftObjectPaths.Num() == 0)
+        {
+            return;
+        }
+
+        TArray<FAssetData> Assets;
+        AssetRegistry.GetAssets(Filter, Assets);
+        OutAssets.Reserve(Assets.Num());
+        for (FAssetData& AssetData : Assets)
+        {
+            OutAssets.Add(AssetData.ToSoftObjectPath(), MoveTemp(AssetData));
         }
     }
-}
 
-bool FAssetQuery::Find(const FAssetFindParams& Params, int32& OutTotal, TArray<FAssetLite>& OutItems, FString& OutError)
-{
-    const double StartTime = FPlatformTime::Seconds();
-    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+    /**
+     * A query's filtered matches, shared by the pages read through its cursor. The first SortedCount
+     * are in final order and no later entry sorts before them; the rest are in no particular order.
+     */
+    struct FFindSnapshot
+    {
+        FString QueryKey;
+        int64 Generation = 0;
+        TArray<FAssetData> Assets;
+        int32 SortedCount = 0;
+    };
 
-    OutError.Reset();
-    OutTotal = 0;
-    OutItems.Reset();
+    struct FSnapshotEntry
+    {
+        TSharedPtr<const FFindSnapshot, ESPMode::ThreadSafe> Snapshot;
+        double LastUsedSeconds = 0.0;
+    };
+
+    /** Idle time after which a snapshot is dropped, and how many are kept at once. */
+    constexpr double SnapshotIdleSeconds = 120.0;
+    constexpr int32 MaxSnapshots = 8;
+
+    FCriticalSection SnapshotMutex;
+    TMap<FGuid, FSnapshotEntry> Snapshots;
+    /** Bumped on every asset registry change; cursors from an older generation are refused. */
+    std::atomic<int64> SnapshotGeneration(0);
+
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+    FDelegateHandle AssetUpdatedHandle;
+    /** Set while the delegates above are bound, so worker threads know SnapshotGeneration is live. */
+    std::atomic<bool> bTrackingRegistry(false);
+
+    /** Last FFileLoadProgressUpdateData seen, for FAssetRegistryStatus. */
+    FDelegateHandle ScanProgressHandle;
+    std::atomic<int32> ScanTotalAssets(0);
+    std::atomic<int32> ScanProcessedAssets(0);
+    std::atomic<int32> ScanPendingDataLoad(0);
+    std::atomic<bool> bScanDiscoveringFiles(false);
+
+    void ExpireSnapshots()
+    {
+        ++SnapshotGeneration;
+        FScopeLock Lock(&SnapshotMutex);
+        Snapshots.Reset();
+    }
 
-    FARFilter Filter;
-    Filter.bRecursivePaths = Params.bRecursive;
-    Filter.bRecursiveClasses = true;
+    /** Package -> primary object path memo for dependency lists, valid for one SnapshotGeneration. */
+    constexpr int32 MaxMemoizedDependencyPaths = 65536;
+    FCriticalSection DependencyMemoMutex;
+    TMap<FName, FString> DependencyPathMemo;
+    int64 DependencyMemoGeneration = -1;
+
+    /**
+     * Maps each package to the object path of its first asset, or to the package name when it holds
+     * none (e.g. script packages). Packages not already memoized are resolved with one registry
+     * query. The memo only outlives the call while snapshot tracking sees registry changes.
+     */
+    void ResolveDependencyPaths(const TSet<FName>& PackageNames, IAssetRegistry& AssetRegistry, TMap<FName, FString>& OutPaths)
+    {
+        OutPaths.Reset();
+        if (PackageNames.Num() == 0)
+        {
+            return;
+        }
 
-    for (const FString& Path : Params.Paths)
+        const bool bUseMemo = bTrackingRegistry.load();
+        const int64 Generation = SnapshotGeneration.load();
+        TArray<FName> Missing;
+        if (bUseMemo)
+        {
+            FScopeLock Lock(&DependencyMemoMutex);
+            if (DependencyMemoGeneration != Generation)
+            {
+                DependencyPathMemo.Reset();
+                DependencyMemoGeneration = Generation;
+            }
+            for (const FName& PackageName : PackageNames)
+            {
+                if (const FString* Memoized = DependencyPathMemo.Find(PackageName))
+                {
+                    OutPaths.Add(PackageName, *Memoized);
+                }
+                else
+                {
+                    Missing.Add(PackageName);
+                }
+            }
+        }
+        else
+        {
+            Missing = PackageNames.Array();
+        }
+
+        if (Missing.Num() == 0)
+        {
+            return;
+        }
+
+        TMap<FName, FString> Resolved;
+        FARFilter Filter;
+        Filter.PackageNames = Missing;
+        TArray<FAssetData> Assets;
+        AssetRegistry.GetAssets(Filter, Assets);
+        for (const FAssetData& AssetData : Assets)
+        {
+            if (!Resolved.Contains(AssetData.PackageName))
+            {
+                Resolved.Add(AssetData.PackageName, AssetData.ToSoftObjectPath().ToString());
+            }
+        }
+
+        for (const FName& PackageName : Missing)
+        {
+            if (!Resolved.Contains(PackageName))
+            {
+                Resolved.Add(PackageName, PackageName.ToString());
+            }
+        }
+
+        if (bUseMemo)
+        {
+            FScopeLock Lock(&DependencyMemoMutex);
+            if (DependencyMemoGeneration == Generation)
+            {
+                if (DependencyPathMemo.Num() + Resolved.Num() > MaxMemoizedDependencyPaths)
+                {
+                    DependencyPathMemo.Reset();
+                }
+                DependencyPathMemo.Append(Resolved);
+            }
+        }
+        OutPaths.Append(MoveTemp(Resolved));
+    }
+
+    /** Caller holds SnapshotMutex. */
+    void PruneSnapshotsLocked(double Now)
     {
-        if (!Path.IsEmpty())
+        for (auto It = Snapshots.CreateIterator(); It; ++It)
         {
-            Filter.PackagePaths.Add(*Path);
+            if (Now - It.Value().LastUsedSeconds > SnapshotIdleSeconds)
+            {
+                It.RemoveCurrent();
+            }
         }
     }
 
-    for (const FString& ClassName : Params.ClassNames)
+    TSharedPtr<const FFindSnapshot, ESPMode::ThreadSafe> FindSnapshot(const FGuid& Id)
     {
-        FTopLevelAssetPath ClassPath;
-        if (ResolveClassPath(ClassName, ClassPath))
+        const double Now = FPlatformTime::Seconds();
+        FScopeLock Lock(&SnapshotMutex);
+        PruneSnapshotsLocked(Now);
+        FSnapshotEntry* Entry = Snapshots.Find(Id);
+        if (!Entry)
         {
-            Filter.ClassPaths.Add(ClassPath);
+            return nullptr;
         }
+        Entry->LastUsedSeconds = Now;
+        return Entry->Snapshot;
     }
 
-    TArray<FAssetData> AssetResults;
-    if (!AssetRegistry.GetAssets(Filter, AssetResults))
+    void StoreSnapshot(const FGuid& Id, const TSharedRef<const FFindSnapshot, ESPMode::ThreadSafe>& Snapshot)
     {
-        OutError = TEXT("Asset registry query failed");
-        return false;
+        // A snapshot computed across a registry change would be stale from the start.
+        if (Snapshot->Generation != SnapshotGeneration.load())
+        {
+            return;
+        }
+
+        const double Now = FPlatformTime::Seconds();
+        FScopeLock Lock(&SnapshotMutex);
+        PruneSnapshotsLocked(Now);
+        if (!Snapshots.Contains(Id) && Snapshots.Num() >= MaxSnapshots)
+        {
+            FGuid OldestId;
+            double OldestSeconds = TNumericLimits<double>::Max();
+            for (const TPair<FGuid, FSnapshotEntry>& Pair : Snapshots)
+            {
+                if (Pair.Value.LastUsedSeconds < OldestSeconds)
+                {
+                    OldestSeconds = Pair.Value.LastUsedSeconds;
+                    OldestId = Pair.Key;
+                }
+            }
+            Snapshots.Remove(OldestId);
+        }
+
+        FSnapshotEntry& Entry = Snapshots.FindOrAdd(Id);
+        Entry.Snapshot = Snapshot;
+        Entry.LastUsedSeconds = Now;
     }
 
-    TArray<FAssetData> Filtered;
-    Filtered.Reserve(AssetResults.Num());
+    /** Everything that decides which assets match and in what order; paging fields are left out. */
+    FString MakeQueryKey(const FAssetFindParams& Params)
+    {
+        TArray<FString> Paths = Params.Paths;
+        Paths.Sort();
+        TArray<FString> ClassNames = Params.ClassNames;
+        ClassNames.Sort();
+
+        FString Key = FString::Printf(TEXT("paths=%s;classes=%s;name=%s;prefix=%s;path=%s;fuzzy=%d;recursive=%d;sort=%d;asc=%d"),
+            *FString::Join(Paths, TEXT(",")),
+            *FString::Join(ClassNames, TEXT(",")),
+            Params.NameContains.IsSet() ? *Params.NameContains.GetValue() : TEXT(""),
+            Params.NameStartsWith.IsSet() ? *Params.NameStartsWith.GetValue() : TEXT(""),
+            Params.PathContains.IsSet() ? *Params.PathContains.GetValue() : TEXT(""),
+            Params.bFuzzy ? 1 : 0,
+            Params.bRecursive ? 1 : 0,
+            static_cast<int32>(Params.SortBy),
+            Params.bSortAscending ? 1 : 0);
+
+        TArray<FName> TagNames;
+        Params.TagQuery.GetKeys(TagNames);
+        TagNames.Sort(FNameLexicalLess());
+        for (const FName& TagName : TagNames)
+        {
+            Key += FString::Printf(TEXT(";tag:%s:%d=%s"), *TagName.ToString(), static_cast<int32>(GetTagMatch(Params, TagName)),
+                *FString::Join(Params.TagQuery.FindChecked(TagName), TEXT(",")));
+        }
+        return Key;
+    }
 
-    for (const FAssetData& AssetData : AssetResults)
+    FString EncodeCursor(const FGuid& SnapshotId, int64 Generation, int32 Offset, uint32 QueryHash)
     {
+        return FBase64::Encode(FString::Printf(TEXT("1:%s:%lld:%d:%08x"), *SnapshotId.ToString(EGuidFormats::Digits), Generation, Offset, QueryHash));
+    }
+
+    bool DecodeCursor(const FString& Cursor, FGuid& OutSnapshotId, int64& OutGeneration, int32& OutOffset, uint32& OutQueryHash)
+    {
+        FString Decoded;
+        if (!FBase64::Decode(Cursor, Decoded))
+        {
+            return false;
+        }
+
+        TArray<FString> Parts;
+        Decoded.ParseIntoArray(Parts, TEXT(":"), false);
+        if (Parts.Num() != 5 || Parts[0] != TEXT("1") || !FGuid::Parse(Parts[1], OutSnapshotId))
+        {
+            return false;
+        }
+
+        OutGeneration = FCString::Atoi64(*Parts[2]);
+        OutOffset = FCString::Atoi(*Parts[3]);
+        OutQueryHash = static_cast<uint32>(FCString::Strtoui64(*Parts[4], nullptr, 16));
+        return OutOffset >= 0;
+    }
+
+    /** Runs the registry query and filters its results; ordering is left to OrderAssets. */
+    bool CollectMatchingAssets(const FAssetFindParams& Params, TArray<FAssetData>& OutMatches, FString& OutError)
+    {
+        IAssetRegistry& AssetRegistry = GetAssetRegistry();
+
+        FARFilter Filter;
+        Filter.bRecursivePaths = Params.bRecursive;
+
+        for (const FString& Path : Params.Paths)
+        {
+            if (!Path.IsEmpty())
+            {
+                Filter.PackagePaths.Add(*Path);
+            }
+        }
+
+        // An unknown class must fail the query: dropping it would widen the filter to every class.
+        FAssetClassResolver& ClassResolver = FAssetClassResolver::Get();
+        for (const FString& ClassName : Params.ClassNames)
+        {
+            if (!ClassResolver.Resolve(ClassName, Filter.ClassPaths))
+            {
+                OutError = FString::Printf(TEXT("Unknown class '%s'"), *ClassName);
+                return false;
+            }
+        }
+        // Subclasses come from the resolver's cached closure rather than bRecursiveClasses, which
+        // would have the registry walk its class tree again for every query.
+        ClassResolver.ExpandDerivedClasses(Filter.ClassPaths);
+
+        OutMatches.Reset();
+
+        // Name and path searches go through the index when it is available: the matching names narrow
+        // the registry query to their packages, and results are then checked with set lookups.
+        struct FNameCriterion
+        {
+            FString Query;
+            FAssetNameIndex::EMatch Match;
+            bool bIndexed = false;
+            TSet<FName> Names;
+        };
+        TArray<FNameCriterion, TInlineAllocator<2>> NameCriteria;
         if (Params.NameContains.IsSet())
         {
-            const FString AssetNameString = AssetData.AssetName.ToString();
-            if (!AssetNameString.Contains(Params.NameContains.GetValue(), ESearchCase::IgnoreCase))
+            NameCriteria.Add({ Params.NameContains.GetValue(), Params.bFuzzy ? FAssetNameIndex::EMatch::Fuzzy : FAssetNameIndex::EMatch::Contains });
+        }
+        if (Params.NameStartsWith.IsSet())
+        {
+            NameCriteria.Add({ Params.NameStartsWith.GetValue(), FAssetNameIndex::EMatch::Prefix });
+        }
+
+        FAssetNameIndex& NameIndex = FAssetNameIndex::Get();
+        TSet<FName> NarrowPackages;
+        bool bNarrowByPackage = false;
+        for (FNameCriterion& Criterion : NameCriteria)
+        {
+            TSet<FName> CriterionPackages;
+            if (!NameIndex.FindAssetNames(Criterion.Query, Criterion.Match, Criterion.Names, CriterionPackages))
             {
                 continue;
             }
+            Criterion.bIndexed = true;
+            if (Criterion.Names.Num() == 0)
+            {
+                return true;
+            }
+            if (!bNarrowByPackage || CriterionPackages.Num() < NarrowPackages.Num())
+            {
+                NarrowPackages = MoveTemp(CriterionPackages);
+                bNarrowByPackage = true;
+            }
+        }
+        for (const FName& PackageName : NarrowPackages)
+        {
+            Filter.PackageNames.Add(PackageName);
         }
 
-        if (!MatchesTagQuery(AssetData, Params.TagQuery))
+        const FAssetNameIndex::EMatch PathMatch = Params.bFuzzy ? FAssetNameIndex::EMatch::Fuzzy : FAssetNameIndex::EMatch::Contains;
+        TSet<FName> MatchedPaths;
+        bool bPathsIndexed = false;
+        if (Params.PathContains.IsSet() && NameIndex.FindPackagePaths(Params.PathContains.GetValue(), PathMatch, MatchedPaths))
         {
-            continue;
+            bPathsIndexed = true;
+            if (MatchedPaths.Num() == 0)
+            {
+                return true;
+            }
+            // Without explicit paths, the matching folders are the query's paths.
+            if (Filter.PackagePaths.Num() == 0 && !bNarrowByPackage)
+            {
+                Filter.bRecursivePaths = false;
+                for (const FName& Path : MatchedPaths)
+                {
+                    Filter.PackagePaths.Add(Path);
+                }
+            }
+        }
+
+        // The registry ORs TagsAndValues entries, so one exact tag (its values already OR) goes into the
+        // filter and is answered by the tag index; every other tag is checked below.
+        FName IndexedTag;
+        for (const TPair<FName, TArray<FString>>& Pair : Params.TagQuery)
+        {
+            if (GetTagMatch(Params, Pair.Key) == FAssetFindParams::ETagMatch::Exact && Pair.Value.Num() > 0)
+            {
+                IndexedTag = Pair.Key;
+                for (const FString& Value : Pair.Value)
+                {
+                    Filter.TagsAndValues.Add(Pair.Key, Value);
+                }
+                break;
+            }
         }
 
-        Filtered.Add(AssetData);
+        // During the startup scan the saved index answers for what the registry has not reached yet.
+        TArray<FAssetData> AssetResults;
+        if (!FAssetIndexCache::Get().GetAssets(Filter, AssetResults) && !AssetRegistry.GetAssets(Filter, AssetResults))
+        {
+            OutError = TEXT("Asset registry query failed");
+            return false;
+        }
+
+        // The checks only read the assets and the sets built above, so chunks filter independently;
+        // each keeps its own matches and they are joined in chunk order.
+        const int32 ChunkCount = GetParallelChunkCount(AssetResults.Num());
+        TArray<TArray<FAssetData>> ChunkMatches;
+        ChunkMatches.SetNum(ChunkCount);
+        ParallelFor(ChunkCount, [&](int32 ChunkIndex)
+        {
+            TArray<FAssetData>& Matches = ChunkMatches[ChunkIndex];
+            const int32 Begin = ChunkIndex * ParallelChunkSize;
+            const int32 End = FMath::Min(Begin + ParallelChunkSize, AssetResults.Num());
+            for (int32 AssetIndex = Begin; AssetIndex < End; ++AssetIndex)
+            {
+                FAssetData& AssetData = AssetResults[AssetIndex];
+                bool bNameMatches = true;
+                for (const FNameCriterion& Criterion : NameCriteria)
+                {
+                    bNameMatches = Criterion.bIndexed
+                        ? Criterion.Names.Contains(AssetData.AssetName)
+                        : FAssetNameIndex::Matches(AssetData.AssetName.ToString(), Criterion.Query, Criterion.Match);
+                    if (!bNameMatches)
+                    {
+                        break;
+                    }
+                }
+                if (!bNameMatches)
+                {
+                    continue;
+                }
+
+                if (Params.PathContains.IsSet())
+                {
+                    const bool bPathMatches = bPathsIndexed
+                        ? MatchedPaths.Contains(AssetData.PackagePath)
+                        : FAssetNameIndex::Matches(AssetData.PackagePath.ToString(), Params.PathContains.GetValue(), PathMatch);
+                    if (!bPathMatches)
+                    {
+                        continue;
+                    }
+                }
+
+                if (!MatchesTagQuery(AssetData, Params, IndexedTag))
+                {
+                    continue;
+                }
+
+                Matches.Add(MoveTemp(AssetData));
+            }
+        }, GetParallelFlags(AssetResults.Num()));
+
+        int32 MatchCount = 0;
+        for (const TArray<FAssetData>& Matches : ChunkMatches)
+        {
+            MatchCount += Matches.Num();
+        }
+        OutMatches.Reserve(MatchCount);
+        for (TArray<FAssetData>& Matches : ChunkMatches)
+        {
+            OutMatches.Append(MoveTemp(Matches));
+        }
+
+        return true;
     }
 
-    Algo::Sort(Filtered, [&Params](const FAssetData& A, const FAssetData& B)
+    /** Sort keys resolved once per asset; comparing FNames lexically would resolve both strings on every compare. */
+    struct FAssetSortKey
+    {
+        /** Class or package path; empty when sorting by name. */
+        FString Primary;
+        FString Name;
+        int32 Index = 0;
+    };
+
+    int32 CompareSortKeys(const FAssetSortKey& A, const FAssetSortKey& B, const TArray<FAssetData>& Assets)
     {
-        auto CompareNames = [](const FName& Left, const FName& Right) -> int32
+        int32 Comparison = A.Primary.Compare(B.Primary, ESearchCase::IgnoreCase);
+        if (Comparison == 0)
         {
-            if (Left == Right)
+            Comparison = A.Name.Compare(B.Name, ESearchCase::IgnoreCase);
+        }
+
+        // Same-named assets in different packages: a total order keeps rebuilt snapshots page-stable.
+        if (Comparison == 0)
+        {
+            const FName PackageA = Assets[A.Index].PackageName;
+            const FName PackageB = Assets[B.Index].PackageName;
+            if (PackageA != PackageB)
             {
-                return 0;
+                Comparison = PackageA.LexicalLess(PackageB) ? -1 : 1;
             }
-            return Left.LexicalLess(Right) ? -1 : 1;
-        };
+        }
+        return Comparison;
+    }
 
-        int32 Comparison = 0;
-        switch (Params.SortBy)
+    /**
+     * Puts Assets[0, NeededCount) in final order, given that Assets[0, SortedCount) already is. When
+     * only a small page is needed the smallest entries are selected first, so a 20-item page out of
+     * 80k matches sorts 20 entries. Returns the new sorted count.
+     */
+    int32 OrderAssets(TArray<FAssetData>& Assets, int32 SortedCount, int32 NeededCount, const FAssetFindParams& Params)
+    {
+        const int32 RangeCount = Assets.Num() - SortedCount;
+        NeededCount = FMath::Min(NeededCount, Assets.Num());
+        if (NeededCount <= SortedCount || RangeCount <= 0)
         {
-        case FAssetFindParams::ESortBy::Class:
-            Comparison = CompareNames(A.AssetClassPath.GetAssetName(), B.AssetClassPath.GetAssetName());
-            break;
-        case FAssetFindParams::ESortBy::Path:
-            Comparison = CompareNames(A.PackagePath, B.PackagePath);
-            break;
-        case FAssetFindParams::ESortBy::Name:
-        default:
-            Comparison = CompareNames(A.AssetName, B.AssetName);
-            break;
+            return SortedCount;
         }
 
-        if (Comparison == 0)
+        // Resolving names to strings dominates key building, and each key only touches its own asset.
+        TArray<FAssetSortKey> Keys;
+        Keys.SetNum(RangeCount);
+        ParallelFor(GetParallelChunkCount(RangeCount), [&](int32 ChunkIndex)
+        {
+            const int32 Begin = ChunkIndex * ParallelChunkSize;
+            const int32 End = FMath::Min(Begin + ParallelChunkSize, RangeCount);
+            for (int32 KeyIndex = Begin; KeyIndex < End; ++KeyIndex)
+            {
+                const FAssetData& AssetData = Assets[SortedCount + KeyIndex];
+                FAssetSortKey& Key = Keys[KeyIndex];
+                Key.Index = SortedCount + KeyIndex;
+                Key.Name = AssetData.AssetName.ToString();
+                switch (Params.SortBy)
+                {
+                case FAssetFindParams::ESortBy::Class:
+                    Key.Primary = AssetData.AssetClassPath.GetAssetName().ToString();
+                    break;
+                case FAssetFindParams::ESortBy::Path:
+                    Key.Primary = AssetData.PackagePath.ToString();
+                    break;
+                default:
+                    break;
+                }
+            }
+        }, GetParallelFlags(RangeCount));
+
+        const bool bAscending = Params.bSortAscending;
+        auto Less = [&Assets, bAscending](const FAssetSortKey& A, const FAssetSortKey& B)
+        {
+            const int32 Comparison = CompareSortKeys(A, B, Assets);
+            return bAscending ? Comparison < 0 : Comparison > 0;
+        };
+
+        // Selecting first pays off while the page is a small share of what is left to order.
+        int32 SelectCount = NeededCount - SortedCount;
+        if (SelectCount * 4 < RangeCount)
         {
-            Comparison = CompareNames(A.AssetName, B.AssetName);
+            std::nth_element(Keys.GetData(), Keys.GetData() + SelectCount, Keys.GetData() + RangeCount, Less);
+            Algo::Sort(TArrayView<FAssetSortKey>(Keys.GetData(), SelectCount), Less);
+        }
+        else
+        {
+            Algo::Sort(Keys, Less);
+            SelectCount = RangeCount;
         }
 
-        if (Params.bSortAscending)
+        // Selected entries first, in order; the remainder keeps nth_element's partition.
+        TArray<FAssetData> Reordered;
+        Reordered.Reserve(RangeCount);
+        for (const FAssetSortKey& Key : Keys)
+        {
+            Reordered.Add(MoveTemp(Assets[Key.Index]));
+        }
+        for (int32 Offset = 0; Offset < RangeCount; ++Offset)
         {
-            return Comparison < 0;
+            Assets[SortedCount + Offset] = MoveTemp(Reordered[Offset]);
         }
 
-        return Comparison > 0;
-    });
+        return SortedCount + SelectCount;
+    }
+}
+
+bool FAssetQuery::Find(const FAssetFindParams& Params, int32& OutTotal, TArray<FAssetLite>& OutItems, FString& OutError)
+{
+    FAssetFindParams PageParams = Params;
+    PageParams.Cursor.Reset();
+
+    FAssetFindPage Page;
+    const bool bFound = FindPage(PageParams, Page, OutError);
+    OutTotal = Page.Total;
+    OutItems = MoveTemp(Page.Items);
+    return bFound;
+}
+
+bool FAssetQuery::FindPage(const FAssetFindParams& Params, FAssetFindPage& OutPage, FString& OutError)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    OutError.Reset();
+    OutPage = FAssetFindPage();
+
+    const FString QueryKey = MakeQueryKey(Params);
+    const uint32 QueryHash = GetTypeHash(QueryKey);
+    const int64 Generation = SnapshotGeneration.load();
+
+    FGuid SnapshotId;
+    int32 Offset = FMath::Max(Params.Offset, 0);
+    TSharedPtr<const FFindSnapshot, ESPMode::ThreadSafe> Snapshot;
+    if (!Params.Cursor.IsEmpty())
+    {
+        int64 CursorGeneration = 0;
+        uint32 CursorHash = 0;
+        if (!DecodeCursor(Params.Cursor, SnapshotId, CursorGeneration, Offset, CursorHash))
+        {
+            OutError = TEXT("Invalid cursor");
+            return false;
+        }
+        if (CursorHash != QueryHash)
+        {
+            OutError = TEXT("Cursor belongs to a different query; send the same filters and sort with it");
+            return false;
+        }
+        if (CursorGeneration != Generation)
+        {
+            OutPage.bCursorExpired = true;
+            OutError = TEXT("The asset registry changed since this cursor was issued; restart from the first page");
+            return false;
+        }
+        Snapshot = FindSnapshot(SnapshotId);
+    }
 
     const int32 ClampedLimit = FMath::Clamp(Params.Limit, 0, MaxLimit);
-    const int32 Offset = FMath::Max(Params.Offset, 0);
+    Offset = FMath::Min(Offset, MAX_int32 - MaxLimit);
+    if (!Snapshot.IsValid())
+    {
+        // A first page only needs its own entries ordered; the rest is sorted if a cursor comes back.
+        TSharedRef<FFindSnapshot, ESPMode::ThreadSafe> Collected = MakeShared<FFindSnapshot, ESPMode::ThreadSafe>();
+        Collected->QueryKey = QueryKey;
+        Collected->Generation = Generation;
+        if (!CollectMatchingAssets(Params, Collected->Assets, OutError))
+        {
+            return false;
+        }
+        Collected->SortedCount = OrderAssets(Collected->Assets, 0, Offset + ClampedLimit, Params);
+        Snapshot = Collected;
+    }
+    else if (Snapshot->SortedCount < FMath::Min(Offset + ClampedLimit, Snapshot->Assets.Num()))
+    {
+        // Following a cursor: order everything once, so every later page is a plain copy.
+        TSharedRef<FFindSnapshot, ESPMode::ThreadSafe> Ordered = MakeShared<FFindSnapshot, ESPMode::ThreadSafe>(*Snapshot);
+        Ordered->SortedCount = OrderAssets(Ordered->Assets, Ordered->SortedCount, Ordered->Assets.Num(), Params);
+        Snapshot = Ordered;
+    }
 
-    OutTotal = Filtered.Num();
+    const TArray<FAssetData>& Sorted = Snapshot->Assets;
+    OutPage.Total = Sorted.Num();
 
-    if (ClampedLimit == 0 || Offset >= Filtered.Num())
+    if (ClampedLimit == 0 || Offset >= Sorted.Num())
     {
-        UE_LOG(LogUnrealMCP, Verbose, TEXT("Asset.find returning 0 items (total %d)"), OutTotal);
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("Asset.find returning 0 items (total %d)"), OutPage.Total);
         return true;
     }
 
-    const int32 EndIndex = FMath::Min(Offset + ClampedLimit, Filtered.Num());
-    for (int32 Index = Offset; Index < EndIndex; ++Index)
+    const int32 EndIndex = FMath::Min(Offset + ClampedLimit, Sorted.Num());
+    // Tag parsing makes items far costlier than filtering, so pages are built in smaller chunks.
+    constexpr int32 ItemChunkSize = 64;
+    const int32 ItemCount = EndIndex - Offset;
+    OutPage.Items.SetNum(ItemCount);
+    ParallelFor(GetParallelChunkCount(ItemCount, ItemChunkSize), [&](int32 ChunkIndex)
     {
-        const FAssetData& AssetData = Filtered[Index];
-
-        FAssetLite Lite;
-        Lite.ObjectPath = AssetData.ToSoftObjectPath().ToString();
-        Lite.PackagePath = AssetData.PackagePath.ToString();
-        Lite.AssetName = AssetData.AssetName.ToString();
-        Lite.ClassName = AssetData.AssetClassPath.GetAssetName().ToString();
-        CopyTags(AssetData, Lite.Tags);
+        const int32 Begin = ChunkIndex * ItemChunkSize;
+        const int32 End = FMath::Min(Begin + ItemChunkSize, ItemCount);
+        for (int32 ItemIndex = Begin; ItemIndex < End; ++ItemIndex)
+        {
+            OutPage.Items[ItemIndex] = MakeAssetLite(Sorted[Offset + ItemIndex], Params.Fields);
+        }
+    }, GetParallelFlags(ItemCount, ItemChunkSize));
 
-        OutItems.Add(MoveTemp(Lite));
+    if (EndIndex < Sorted.Num())
+    {
+        if (!SnapshotId.IsValid())
+        {
+            SnapshotId = FGuid::NewGuid();
+        }
+        StoreSnapshot(SnapshotId, Snapshot.ToSharedRef());
+        OutPage.NextCursor = EncodeCursor(SnapshotId, Snapshot->Generation, EndIndex, QueryHash);
     }
 
     const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
-    UE_LOG(LogUnrealMCP, Verbose, TEXT("Asset.find returned %d/%d items in %.2f ms"), OutItems.Num(), OutTotal, ElapsedMs);
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Asset.find returned %d/%d items in %.2f ms"), OutPage.Items.Num(), OutPage.Total, ElapsedMs);
 
     return true;
 }
 
+double FAssetRegistryStatus::GetProgress() const
+{
+    if (bComplete)
+    {
+        return 1.0;
+    }
+    return TotalAssets > 0 ? FMath::Clamp(static_cast<double>(ProcessedAssets) / TotalAssets, 0.0, 1.0) : 0.0;
+}
+
+TSharedPtr<FJsonObject> FAssetRegistryStatus::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetBoolField(TEXT("complete"), bComplete);
+    Json->SetNumberField(TEXT("progress"), GetProgress());
+    if (!bComplete)
+    {
+        Json->SetBoolField(TEXT("discoveringFiles"), bDiscoveringFiles);
+        Json->SetNumberField(TEXT("totalAssets"), TotalAssets);
+        Json->SetNumberField(TEXT("processedAssets"), ProcessedAssets);
+        Json->SetNumberField(TEXT("pendingDataLoad"), PendingDataLoad);
+    }
+    return Json;
+}
+
+FAssetRegistryStatus FAssetQuery::GetRegistryStatus()
+{
+    FAssetRegistryStatus Status;
+    Status.bComplete = !GetAssetRegistry().IsLoadingAssets();
+    if (!Status.bComplete)
+    {
+        Status.bDiscoveringFiles = bScanDiscoveringFiles.load();
+        Status.TotalAssets = ScanTotalAssets.load();
+        Status.ProcessedAssets = ScanProcessedAssets.load();
+        Status.PendingDataLoad = ScanPendingDataLoad.load();
+    }
+    return Status;
+}
+
+void FAssetQuery::AddRegistryStatus(FJsonObject& Data)
+{
+    const FAssetRegistryStatus Status = GetRegistryStatus();
+    Data.SetBoolField(TEXT("complete"), Status.bComplete);
+    if (!Status.bComplete)
+    {
+        TSharedPtr<FJsonObject> RegistryJson = Status.ToJson();
+        FAssetIndexCache::Get().AddStatus(*RegistryJson);
+        Data.SetObjectField(TEXT("registry"), RegistryJson);
+    }
+}
+
+void FAssetQuery::StartSnapshotTracking()
+{
+    check(IsInGameThread());
+    if (AssetAddedHandle.IsValid())
+    {
+        return;
+    }
+
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddLambda([](const FAssetData&) { ExpireSnapshots(); });
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddLambda([](const FAssetData&) { ExpireSnapshots(); });
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddLambda([](const FAssetData&, const FString&) { ExpireSnapshots(); });
+    AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddLambda([](const FAssetData&) { ExpireSnapshots(); });
+    ScanProgressHandle = AssetRegistry.OnFileLoadProgressUpdated().AddLambda([](const IAssetRegistry::FFileLoadProgressUpdateData& Progress)
+    {
+        ScanTotalAssets = Progress.NumTotalAssets;
+        ScanProcessedAssets = Progress.NumAssetsProcessedByAssetRegistry;
+        ScanPendingDataLoad = Progress.NumAssetsPendingDataLoad;
+        bScanDiscoveringFiles = Progress.bIsDiscoveringAssetFiles;
+    });
+    bTrackingRegistry = true;
+}
+
+void FAssetQuery::StopSnapshotTracking()
+{
+    if (!AssetAddedHandle.IsValid())
+    {
+        return;
+    }
+
+    if (FAssetRegistryModule* Module = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+    {
+        IAssetRegistry& AssetRegistry = Module->Get();
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+        AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+        AssetRegistry.OnFileLoadProgressUpdated().Remove(ScanProgressHandle);
+    }
+    AssetAddedHandle.Reset();
+    AssetRemovedHandle.Reset();
+    AssetRenamedHandle.Reset();
+    AssetUpdatedHandle.Reset();
+    ScanProgressHandle.Reset();
+    bTrackingRegistry = false;
+    ExpireSnapshots();
+
+    FScopeLock Lock(&DependencyMemoMutex);
+    DependencyPathMemo.Empty();
+    DependencyMemoGeneration = -1;
+}
+
 bool FAssetQuery::Exists(const FString& ObjectPath, bool& bOutExists, FString& OutClassName, FString& OutError)
 {
     bOutExists = false;
@@ -338,25 +1057,65 @@ bool FAssetQuery::Exists(const FString& ObjectPath, bool& bOutExists, FString& O
         return false;
     }
 
-    IAssetRegistry& AssetRegistry = GetAssetRegistry();
-    FSoftObjectPath SoftPath(ObjectPath);
-    if (!SoftPath.IsValid())
+    TArray<FAssetExistsResult> Results;
+    if (!ExistsBatch({ ObjectPath }, Results, OutError))
     {
-        OutError = TEXT("Invalid object path");
         return false;
     }
 
-    const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(SoftPath);
-    bOutExists = AssetData.IsValid();
-    if (bOutExists)
+    if (!Results[0].Error.IsEmpty())
     {
-        OutClassName = AssetData.AssetClassPath.GetAssetName().ToString();
+        OutError = Results[0].Error;
+        return false;
     }
 
+    bOutExists = Results[0].bExists;
+    OutClassName = MoveTemp(Results[0].ClassName);
     return true;
 }
 
-bool FAssetQuery::Metadata(const FString& ObjectPath, TSharedPtr<FJsonObject>& OutJson, FString& OutError)
+bool FAssetQuery::ExistsBatch(const TArray<FString>& ObjectPaths, TArray<FAssetExistsResult>& OutResults, FString& OutError)
+{
+    OutResults.Reset();
+    OutError.Reset();
+
+    if (ObjectPaths.Num() == 0)
+    {
+        OutError = TEXT("Missing objectPaths parameter");
+        return false;
+    }
+
+    if (ObjectPaths.Num() > MaxBatchPaths)
+    {
+        OutError = FString::Printf(TEXT("At most %d object paths per request"), MaxBatchPaths);
+        return false;
+    }
+
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+    TArray<FSoftObjectPath> SoftPaths;
+    TMap<FSoftObjectPath, FAssetData> Assets;
+    LookupAssets(ObjectPaths, AssetRegistry, SoftPaths, Assets);
+
+    OutResults.Reserve(ObjectPaths.Num());
+    for (int32 Index = 0; Index < ObjectPaths.Num(); ++Index)
+    {
+        FAssetExistsResult& Result = OutResults.AddDefaulted_GetRef();
+        Result.ObjectPath = ObjectPaths[Index];
+        if (SoftPaths[Index].IsNull())
+        {
+            Result.Error = TEXT("Invalid object path");
+        }
+        else if (const FAssetData* AssetData = Assets.Find(SoftPaths[Index]))
+        {
+            Result.bExists = true;
+            Result.ClassName = AssetData->AssetClassPath.GetAssetName().ToString();
+        }
+    }
+
+    return true;
+}
+
+bool FAssetQuery::Metadata(const FString& ObjectPath, TSharedPtr<FJsonObject>& OutJson, FString& OutError, const FAssetMetadataOptions& Options)
 {
     OutJson.Reset();
     OutError.Reset();
@@ -367,91 +1126,399 @@ bool FAssetQuery::Metadata(const FString& ObjectPath, TSharedPtr<FJsonObject>& O
         return false;
     }
 
-    IAssetRegistry& AssetRegistry = GetAssetRegistry();
-    FSoftObjectPath SoftPath(ObjectPath);
-    if (!SoftPath.IsValid())
+    TArray<TSharedPtr<FJsonObject>> Items;
+    if (!MetadataBatch({ ObjectPath }, Items, OutError, Options))
     {
-        OutError = TEXT("Invalid object path");
         return false;
     }
 
-    const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(SoftPath);
-    if (!AssetData.IsValid())
+    bool bOk = false;
+    if (!Items[0]->TryGetBoolField(TEXT("ok"), bOk) || !bOk)
     {
-        OutError = TEXT("Asset not found");
+        Items[0]->TryGetStringField(TEXT("error"), OutError);
         return false;
     }
 
-    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-    Result->SetBoolField(TEXT("ok"), true);
-    Result->SetStringField(TEXT("objectPath"), AssetData.ToSoftObjectPath().ToString());
-    Result->SetStringField(TEXT("class"), AssetData.AssetClassPath.GetAssetName().ToString());
-    Result->SetStringField(TEXT("packageName"), AssetData.PackageName.ToString());
-    Result->SetStringField(TEXT("packagePath"), AssetData.PackagePath.ToString());
-    Result->SetStringField(TEXT("assetName"), AssetData.AssetName.ToString());
-    Result->SetBoolField(TEXT("isRedirector"), AssetData.IsRedirector());
-    Result->SetBoolField(TEXT("isUWorld"), AssetData.AssetClassPath == UWorld::StaticClass()->GetClassPathName());
+    OutJson = Items[0];
+    return true;
+}
+
+bool FAssetQuery::MetadataBatch(const TArray<FString>& ObjectPaths, TArray<TSharedPtr<FJsonObject>>& OutItems, FString& OutError, const FAssetMetadataOptions& Options)
+{
+    OutItems.Reset();
+    OutError.Reset();
 
-    FString PackageFilename;
-    if (FPackageName::DoesPackageExist(AssetData.PackageName.ToString(), nullptr, &PackageFilename))
+    if (ObjectPaths.Num() == 0)
     {
-        const int64 FileSize = IFileManager::Get().FileSize(*PackageFilename);
-        if (FileSize >= 0)
+        OutError = TEXT("Missing objectPaths parameter");
+        return false;
+    }
+
+    if (ObjectPaths.Num() > MaxBatchPaths)
+    {
+        OutError = FString::Printf(TEXT("At most %d object paths per request"), MaxBatchPaths);
+        return false;
+    }
+
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+    TArray<FSoftObjectPath> SoftPaths;
+    TMap<FSoftObjectPath, FAssetData> Assets;
+    LookupAssets(ObjectPaths, AssetRegistry, SoftPaths, Assets);
+
+    // Dependencies of the whole batch are resolved to object paths together; validation batches
+    // usually share most of them.
+    // Lists are capped before resolving, so a capped request never resolves what it does not return.
+    TArray<TArray<FName>> HardPackages;
+    TArray<TArray<FName>> SoftPackages;
+    TArray<int32> HardTotals;
+    TArray<int32> SoftTotals;
+    HardPackages.SetNum(ObjectPaths.Num());
+    SoftPackages.SetNum(ObjectPaths.Num());
+    HardTotals.SetNumZeroed(ObjectPaths.Num());
+    SoftTotals.SetNumZeroed(ObjectPaths.Num());
+    TSet<FName> DependencyPackages;
+    for (int32 Index = 0; Index < ObjectPaths.Num(); ++Index)
+    {
+        if (const FAssetData* AssetData = SoftPaths[Index].IsNull() ? nullptr : Assets.Find(SoftPaths[Index]))
         {
-            Result->SetNumberField(TEXT("sizeOnDisk"), static_cast<double>(FileSize));
+            CollectDependencyPackages(*AssetData, AssetRegistry, true, false, HardPackages[Index]);
+            CollectDependencyPackages(*AssetData, AssetRegistry, false, true, SoftPackages[Index]);
+            HardTotals[Index] = HardPackages[Index].Num();
+            SoftTotals[Index] = SoftPackages[Index].Num();
+            if (Options.MaxDependencies >= 0)
+            {
+                HardPackages[Index].SetNum(FMath::Min(HardPackages[Index].Num(), Options.MaxDependencies));
+                SoftPackages[Index].SetNum(FMath::Min(SoftPackages[Index].Num(), Options.MaxDependencies));
+            }
+            DependencyPackages.Append(HardPackages[Index]);
+            DependencyPackages.Append(SoftPackages[Index]);
         }
     }
 
-    const FString PackageNameString = AssetData.PackageName.ToString();
-    bool bIsDirtyKnown = false;
-    bool bIsDirty = false;
+    TMap<FName, FString> DependencyPaths;
+    if (Options.bResolveDependencies)
+    {
+        ResolveDependencyPaths(DependencyPackages, AssetRegistry, DependencyPaths);
+    }
+
+    auto MakeDependencyArray = [&DependencyPaths, &Options](const TArray<FName>& Packages)
+    {
+        TArray<TSharedPtr<FJsonValue>> JsonArray;
+        JsonArray.Reserve(Packages.Num());
+        for (const FName& PackageName : Packages)
+        {
+            JsonArray.Add(MakeShared<FJsonValueString>(Options.bResolveDependencies ? DependencyPaths.FindChecked(PackageName) : PackageName.ToString()));
+        }
+        return JsonArray;
+    };
 
-    if (!PackageNameString.IsEmpty())
+    OutItems.Reserve(ObjectPaths.Num());
+    for (int32 Index = 0; Index < ObjectPaths.Num(); ++Index)
     {
-        if (UPackage* Package = FindPackage(nullptr, *PackageNameString))
+        const FAssetData* AssetData = SoftPaths[Index].IsNull() ? nullptr : Assets.Find(SoftPaths[Index]);
+        if (!AssetData)
         {
-            bIsDirtyKnown = true;
-            bIsDirty = Package->IsDirty();
+            TSharedPtr<FJsonObject> Missing = MakeShared<FJsonObject>();
+            Missing->SetBoolField(TEXT("ok"), false);
+            Missing->SetStringField(TEXT("objectPath"), ObjectPaths[Index]);
+            Missing->SetStringField(TEXT("error"), SoftPaths[Index].IsNull() ? TEXT("Invalid object path") : TEXT("Asset not found"));
+            OutItems.Add(Missing);
+            continue;
+        }
+
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetBoolField(TEXT("ok"), true);
+        Result->SetStringField(TEXT("objectPath"), AssetData->ToSoftObjectPath().ToString());
+        Result->SetStringField(TEXT("class"), AssetData->AssetClassPath.GetAssetName().ToString());
+        Result->SetStringField(TEXT("packageName"), AssetData->PackageName.ToString());
+        Result->SetStringField(TEXT("packagePath"), AssetData->PackagePath.ToString());
+        Result->SetStringField(TEXT("assetName"), AssetData->AssetName.ToString());
+        Result->SetBoolField(TEXT("isRedirector"), AssetData->IsRedirector());
+        Result->SetBoolField(TEXT("isUWorld"), AssetData->AssetClassPath == UWorld::StaticClass()->GetClassPathName());
+
+        FString PackageFilename;
+        if (FPackageName::DoesPackageExist(AssetData->PackageName.ToString(), nullptr, &PackageFilename))
+        {
+            const int64 FileSize = IFileManager::Get().FileSize(*PackageFilename);
+            if (FileSize >= 0)
+            {
+                Result->SetNumberField(TEXT("sizeOnDisk"), static_cast<double>(FileSize));
+            }
         }
+
+        const FString PackageNameString = AssetData->PackageName.ToString();
+        bool bIsDirtyKnown = false;
+        bool bIsDirty = false;
+
+        if (!PackageNameString.IsEmpty())
+        {
+            if (UPackage* Package = FindPackage(nullptr, *PackageNameString))
+            {
+                bIsDirtyKnown = true;
+                bIsDirty = Package->IsDirty();
+            }
+        }
+
+        Result->SetBoolField(TEXT("isDirty"), bIsDirty);
+        Result->SetBoolField(TEXT("isDirtyKnown"), bIsDirtyKnown);
+
+        TSharedPtr<FJsonObject> TagsJson = MakeShared<FJsonObject>();
+        for (const TPair<FName, FAssetTagValueRef>& TagPair : AssetData->TagsAndValues)
+        {
+            TArray<FString> Parsed = ParseTagValues(TagPair.Value.AsString());
+            TArray<TSharedPtr<FJsonValue>> JsonArray;
+            for (const FString& Value : Parsed)
+            {
+                JsonArray.Add(MakeShared<FJsonValueString>(Value));
+            }
+            TagsJson->SetArrayField(TagPair.Key.ToString(), JsonArray);
+        }
+        Result->SetObjectField(TEXT("tags"), TagsJson);
+
+        TSharedPtr<FJsonObject> DependenciesJson = MakeShared<FJsonObject>();
+        DependenciesJson->SetArrayField(TEXT("hard"), MakeDependencyArray(HardPackages[Index]));
+        DependenciesJson->SetArrayField(TEXT("soft"), MakeDependencyArray(SoftPackages[Index]));
+        if (HardPackages[Index].Num() < HardTotals[Index] || SoftPackages[Index].Num() < SoftTotals[Index])
+        {
+            DependenciesJson->SetBoolField(TEXT("truncated"), true);
+            DependenciesJson->SetNumberField(TEXT("hardTotal"), HardTotals[Index]);
+            DependenciesJson->SetNumberField(TEXT("softTotal"), SoftTotals[Index]);
+        }
+        Result->SetObjectField(TEXT("dependencies"), DependenciesJson);
+
+        OutItems.Add(Result);
     }
 
-    Result->SetBoolField(TEXT("isDirty"), bIsDirty);
-    Result->SetBoolField(TEXT("isDirtyKnown"), bIsDirtyKnown);
+    return true;
+}
+
+bool FAssetQuery::Graph(const FAssetGraphParams& Params, TSharedPtr<FJsonObject>& OutJson, FString& OutError)
+{
+    using namespace UE::AssetRegistry;
+
+    OutJson.Reset();
+    OutError.Reset();
 
-    TSharedPtr<FJsonObject> TagsJson = MakeShared<FJsonObject>();
-    for (const TPair<FName, FAssetTagValueRef>& TagPair : AssetData.TagsAndValues)
+    if (Params.Roots.Num() == 0)
     {
-        TArray<FString> Parsed = ParseTagValues(TagPair.Value.AsString());
-        TArray<TSharedPtr<FJsonValue>> JsonArray;
-        for (const FString& Value : Parsed)
+        OutError = TEXT("Missing objectPaths parameter");
+        return false;
+    }
+
+    if (!Params.bHard && !Params.bSoft)
+    {
+        OutError = TEXT("At least one of hard and soft must be enabled");
+        return false;
+    }
+
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 MaxNodes = FMath::Max(1, Params.MaxNodes);
+    const bool bFollowDependencies = Params.Direction != FAssetGraphParams::EDirection::Referencers;
+    const bool bFollowReferencers = Params.Direction != FAssetGraphParams::EDirection::Dependencies;
+
+    TArray<FName> Nodes;
+    TArray<int32> Depths;
+    TArray<TArray<int32>> HardEdges;
+    TArray<TArray<int32>> SoftEdges;
+    TMap<FName, int32> NodeIndex;
+
+    auto IsFollowed = [&Params](FName PackageName)
+    {
+        if (Params.bIncludeScriptPackages)
+        {
+            return true;
+        }
+        TCHAR Buffer[FName::StringBufferSize];
+        PackageName.ToString(Buffer);
+        return FCString::Strnicmp(Buffer, TEXT("/Script/"), 8) != 0;
+    };
+
+    // Returns the node's index, adding it one level below Depth if there is room.
+    auto FindOrAddNode = [&](FName PackageName, int32 Depth) -> int32
+    {
+        if (const int32* Existing = NodeIndex.Find(PackageName))
+        {
+            return *Existing;
+        }
+        if (Nodes.Num() >= MaxNodes)
+        {
+            return INDEX_NONE;
+        }
+        const int32 Index = Nodes.Add(PackageName);
+        Depths.Add(Depth);
+        HardEdges.AddDefaulted();
+        SoftEdges.AddDefaulted();
+        NodeIndex.Add(PackageName, Index);
+        return Index;
+    };
+
+    TArray<FString> Invalid;
+    for (const FString& Root : Params.Roots)
+    {
+        FString PackageName = Root;
+        if (PackageName.Contains(TEXT(".")))
+        {
+            PackageName = FPackageName::ObjectPathToPackageName(PackageName);
+        }
+
+        FString Reason;
+        if (!FPackageName::IsValidLongPackageName(PackageName, false, &Reason))
         {
-            JsonArray.Add(MakeShared<FJsonValueString>(Value));
+            Invalid.Add(Root);
+            continue;
         }
-        TagsJson->SetArrayField(TagPair.Key.ToString(), JsonArray);
+        FindOrAddNode(FName(*PackageName), 0);
     }
-    Result->SetObjectField(TEXT("tags"), TagsJson);
 
-    TSharedPtr<FJsonObject> DependenciesJson = MakeShared<FJsonObject>();
+    if (Nodes.Num() == 0)
+    {
+        OutError = FString::Printf(TEXT("No valid package in objectPaths: %s"), *FString::Join(Invalid, TEXT(", ")));
+        return false;
+    }
 
-    TArray<FString> HardDependencies;
-    CollectDependencies(AssetData, AssetRegistry, true, false, HardDependencies);
-    TArray<TSharedPtr<FJsonValue>> HardArray;
-    for (const FString& Dependency : HardDependencies)
+    FString StopReason;
+    int32 Unexpanded = 0;
+    TArray<FName> Linked;
+    for (int32 Cursor = 0; Cursor < Nodes.Num(); ++Cursor)
     {
-        HardArray.Add(MakeShared<FJsonValueString>(Dependency));
+        if (Depths[Cursor] >= Params.MaxDepth)
+        {
+            // Breadth-first order: every later node is at least as deep.
+            break;
+        }
+
+        if (FPlatformTime::Seconds() - StartTime > Params.TimeLimitSeconds)
+        {
+            StopReason = TEXT("time");
+            Unexpanded = Nodes.Num() - Cursor;
+            break;
+        }
+
+        const FName PackageName = Nodes[Cursor];
+        const int32 ChildDepth = Depths[Cursor] + 1;
+        for (int32 Pass = 0; Pass < 2; ++Pass)
+        {
+            const bool bHardPass = Pass == 0;
+            if (bHardPass ? !Params.bHard : !Params.bSoft)
+            {
+                continue;
+            }
+            const EDependencyQuery Query = bHardPass ? EDependencyQuery::Hard : EDependencyQuery::Soft;
+
+            if (bFollowDependencies)
+            {
+                Linked.Reset();
+                if (!FAssetIndexCache::Get().GetDependencies(PackageName, Query, Linked))
+                {
+                    AssetRegistry.GetDependencies(PackageName, Linked, EDependencyCategory::Package, Query);
+                }
+                for (const FName& Dependency : Linked)
+                {
+                    if (Dependency == PackageName || !IsFollowed(Dependency))
+                    {
+                        continue;
+                    }
+                    const int32 Target = FindOrAddNode(Dependency, ChildDepth);
+                    if (Target == INDEX_NONE)
+                    {
+                        StopReason = TEXT("nodes");
+                        continue;
+                    }
+                    (bHardPass ? HardEdges : SoftEdges)[Cursor].AddUnique(Target);
+                }
+            }
+
+            if (bFollowReferencers)
+            {
+                Linked.Reset();
+                // Referencers can come from packages either side has scanned, so take both.
+                FAssetIndexCache::Get().GetReferencers(PackageName, Query, Linked);
+                AssetRegistry.GetReferencers(PackageName, Linked, EDependencyCategory::Package, Query);
+                for (const FName& Referencer : Linked)
+                {
+                    if (Referencer == PackageName || !IsFollowed(Referencer))
+                    {
+                        continue;
+                    }
+                    const int32 Source = FindOrAddNode(Referencer, ChildDepth);
+                    if (Source == INDEX_NONE)
+                    {
+                        StopReason = TEXT("nodes");
+                        continue;
+                    }
+                    (bHardPass ? HardEdges : SoftEdges)[Source].AddUnique(Cursor);
+                }
+            }
+        }
+    }
+
+    auto MakeAdjacency = [](const TArray<TArray<int32>>& Edges, int32& OutEdgeCount)
+    {
+        TArray<TSharedPtr<FJsonValue>> Rows;
+        Rows.Reserve(Edges.Num());
+        for (const TArray<int32>& Targets : Edges)
+        {
+            TArray<TSharedPtr<FJsonValue>> Row;
+            Row.Reserve(Targets.Num());
+            for (int32 Target : Targets)
+            {
+                Row.Add(MakeShared<FJsonValueNumber>(Target));
+            }
+            OutEdgeCount += Targets.Num();
+            Rows.Add(MakeShared<FJsonValueArray>(Row));
+        }
+        return Rows;
+    };
+
+    TArray<TSharedPtr<FJsonValue>> NodesJson;
+    TArray<TSharedPtr<FJsonValue>> DepthJson;
+    NodesJson.Reserve(Nodes.Num());
+    DepthJson.Reserve(Nodes.Num());
+    for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+    {
+        NodesJson.Add(MakeShared<FJsonValueString>(Nodes[Index].ToString()));
+        DepthJson.Add(MakeShared<FJsonValueNumber>(Depths[Index]));
     }
-    DependenciesJson->SetArrayField(TEXT("hard"), HardArray);
 
-    TArray<FString> SoftDependencies;
-    CollectDependencies(AssetData, AssetRegistry, false, true, SoftDependencies);
-    TArray<TSharedPtr<FJsonValue>> SoftArray;
-    for (const FString& Dependency : SoftDependencies)
+    int32 EdgeCount = 0;
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetArrayField(TEXT("nodes"), NodesJson);
+    Result->SetArrayField(TEXT("depth"), DepthJson);
+    if (Params.bHard)
+    {
+        Result->SetArrayField(TEXT("hard"), MakeAdjacency(HardEdges, EdgeCount));
+    }
+    if (Params.bSoft)
     {
-        SoftArray.Add(MakeShared<FJsonValueString>(Dependency));
+        Result->SetArrayField(TEXT("soft"), MakeAdjacency(SoftEdges, EdgeCount));
     }
-    DependenciesJson->SetArrayField(TEXT("soft"), SoftArray);
+    Result->SetNumberField(TEXT("edgeCount"), EdgeCount);
 
-    Result->SetObjectField(TEXT("dependencies"), DependenciesJson);
+    if (!StopReason.IsEmpty())
+    {
+        // "nodes": links to packages past MaxNodes were dropped; "time": the last Unexpanded nodes were never walked.
+        Result->SetBoolField(TEXT("truncated"), true);
+        Result->SetStringField(TEXT("stopReason"), StopReason);
+        if (Unexpanded > 0)
+        {
+            Result->SetNumberField(TEXT("unexpanded"), Unexpanded);
+        }
+    }
+
+    if (Invalid.Num() > 0)
+    {
+        TArray<TSharedPtr<FJsonValue>> InvalidJson;
+        for (const FString& Root : Invalid)
+        {
+            InvalidJson.Add(MakeShared<FJsonValueString>(Root));
+        }
+        Result->SetArrayField(TEXT("invalidRoots"), InvalidJson);
+    }
+
+    const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    Result->SetNumberField(TEXT("elapsedMs"), ElapsedMs);
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Asset.graph visited %d nodes, %d edges in %.2f ms"), Nodes.Num(), EdgeCount, ElapsedMs);
 
     OutJson = Result;
     return true;
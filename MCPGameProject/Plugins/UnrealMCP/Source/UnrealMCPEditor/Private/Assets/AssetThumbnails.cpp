@@ -0,0 +1,407 @@
+#include "Assets/AssetThumbnails.h"
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "EditorNav/ViewportCapture.h"
+#include "HAL/PlatformTime.h"
+#include "IImageWrapperModule.h"
+#include "Misc/Base64.h"
+#include "Misc/ObjectThumbnail.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+#include "ObjectTools.h"
+#include "Protocol/CommandContext.h"
+#include "Settings/UnrealMCPRuntimeConfig.h"
+#include "UObject/SoftObjectPath.h"
+
+#include <atomic>
+
+namespace
+{
+    constexpr const TCHAR* ErrorCodeInvalidParams = TEXT("INVALID_PARAMETERS");
+    constexpr const TCHAR* ErrorCodeCancelled = TEXT("CANCELLED");
+
+    constexpr int32 MaxPaths = 2000;
+    constexpr int32 DefaultSize = 128;
+    constexpr int32 MinSize = 8;
+    constexpr int32 MaxSize = 512;
+    constexpr int32 DefaultMaxRender = 32;
+
+    struct FThumbnailItem
+    {
+        FString Path;
+        FString ObjectPath;
+        /** "Class /Path/Package.Object", the key of a package's thumbnail table. */
+        FString FullName;
+        /** Copied from memory on the game thread; empty when the package file is read instead. */
+        FObjectThumbnail MemoryThumbnail;
+        bool bFromMemory = false;
+
+        const TCHAR* Source = nullptr;
+        /** Why there is no image: notFound, notSaved, noThumbnail, unreadable, loadFailed, renderFailed. */
+        const TCHAR* Missing = nullptr;
+        FViewportCapture::FResult Result;
+    };
+
+    /** One package file whose thumbnail table covers Items. */
+    struct FPackageRead
+    {
+        FString PackageName;
+        TArray<int32> Items;
+    };
+
+    /** What the workers fill in while the request is suspended; the game thread reads it once bDone. */
+    struct FThumbnailBatch
+    {
+        TArray<FThumbnailItem> Items;
+        TArray<FPackageRead> Packages;
+        /** Items whose thumbnail came from memory, encoded next to the package reads. */
+        TArray<int32> MemoryItems;
+        FViewportCapture::FOptions Options;
+        std::atomic<int32> PackagesRead{0};
+        std::atomic<bool> bDone{false};
+    };
+
+    struct FThumbnailsResumeState : public UnrealMCP::Protocol::FCommandContext::FResumeState
+    {
+        TSharedPtr<FThumbnailBatch, ESPMode::ThreadSafe> Batch;
+        bool bRender = false;
+        int32 MaxRender = DefaultMaxRender;
+        int32 NextRenderItem = 0;
+        int32 Rendered = 0;
+        double StartSeconds = 0.0;
+    };
+
+    TSharedPtr<FJsonObject> MakeErrorResponse(const FString& Code, const FString& Message)
+    {
+        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+        Error->SetBoolField(TEXT("success"), false);
+        Error->SetStringField(TEXT("errorCode"), Code);
+        Error->SetStringField(TEXT("error"), Message);
+        return Error;
+    }
+
+    TSharedPtr<FJsonObject> MakeSuccessResponse(const TSharedPtr<FJsonObject>& Payload)
+    {
+        TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+        Response->SetBoolField(TEXT("success"), true);
+        if (Payload.IsValid())
+        {
+            Response->SetObjectField(TEXT("data"), Payload);
+        }
+        return Response;
+    }
+
+    /** "/Game/Props/Chair" reads as "/Game/Props/Chair.Chair"; object paths pass through. */
+    FString ToObjectPath(const FString& InPath)
+    {
+        FString Path = InPath;
+        Path.TrimStartAndEndInline();
+        if (!Path.IsEmpty() && !Path.StartsWith(TEXT("/")))
+        {
+            Path = FString::Printf(TEXT("/Game/%s"), *Path);
+        }
+        if (!Path.IsEmpty() && !Path.Contains(TEXT(".")))
+        {
+            Path = FString::Printf(TEXT("%s.%s"), *Path, *FPackageName::GetShortName(Path));
+        }
+        return Path;
+    }
+
+    /** Decodes a stored thumbnail (BGRA8), then downscales and encodes it (any thread). */
+    void EncodeThumbnail(const FObjectThumbnail& Thumbnail, const FViewportCapture::FOptions& Options, FThumbnailItem& Item, const TCHAR* Source)
+    {
+        const int32 Width = Thumbnail.GetImageWidth();
+        const int32 Height = Thumbnail.GetImageHeight();
+        const TArray<uint8>& Raw = Thumbnail.GetUncompressedImageData();
+        if (Width <= 0 || Height <= 0 || Raw.Num() < Width * Height * static_cast<int32>(sizeof(FColor)))
+        {
+            Item.Missing = TEXT("unreadable");
+            return;
+        }
+
+        TArray<FColor> Pixels;
+        Pixels.SetNumUninitialized(Width * Height);
+        FMemory::Memcpy(Pixels.GetData(), Raw.GetData(), Width * Height * sizeof(FColor));
+        FViewportCapture::EncodeFrame(Pixels, Width, Height, Options, Item.Result);
+        if (!Item.Result.bOk)
+        {
+            Item.Missing = TEXT("unreadable");
+            return;
+        }
+        Item.Source = Source;
+        Item.Missing = nullptr;
+    }
+
+    /** Every package read and every decode/encode, spread over the task graph. */
+    void RunBatch(FThumbnailBatch& Batch)
+    {
+        const int32 JobCount = Batch.Packages.Num() + Batch.MemoryItems.Num();
+        ParallelFor(JobCount, [&Batch](int32 JobIndex)
+        {
+            if (JobIndex >= Batch.Packages.Num())
+            {
+                FThumbnailItem& Item = Batch.Items[Batch.MemoryItems[JobIndex - Batch.Packages.Num()]];
+                EncodeThumbnail(Item.MemoryThumbnail, Batch.Options, Item, TEXT("memory"));
+                return;
+            }
+
+            const FPackageRead& Read = Batch.Packages[JobIndex];
+            FString PackageFilename;
+            if (!FPackageName::DoesPackageExist(Read.PackageName, &PackageFilename))
+            {
+                for (int32 ItemIndex : Read.Items)
+                {
+                    Batch.Items[ItemIndex].Missing = TEXT("notSaved");
+                }
+                return;
+            }
+
+            // The summary and the thumbnail table only; nothing else in the package is read.
+            TSet<FName> FullNames;
+            for (int32 ItemIndex : Read.Items)
+            {
+                FullNames.Add(FName(*Batch.Items[ItemIndex].FullName));
+            }
+            FThumbnailMap Thumbnails;
+            const bool bRead = ThumbnailTools::LoadThumbnailsFromPackage(PackageFilename, FullNames, Thumbnails);
+            ++Batch.PackagesRead;
+            for (int32 ItemIndex : Read.Items)
+            {
+                FThumbnailItem& Item = Batch.Items[ItemIndex];
+                const FObjectThumbnail* Thumbnail = bRead ? Thumbnails.Find(FName(*Item.FullName)) : nullptr;
+                if (Thumbnail && !Thumbnail->IsEmpty())
+                {
+                    EncodeThumbnail(*Thumbnail, Batch.Options, Item, TEXT("package"));
+                }
+                else
+                {
+                    Item.Missing = TEXT("noThumbnail");
+                }
+            }
+        }, JobCount > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+    }
+
+    /** Loads and renders one asset that has no stored thumbnail (game thread). */
+    void RenderMissing(FThumbnailItem& Item, const FViewportCapture::FOptions& Options, int32 Size)
+    {
+        UObject* Asset = FSoftObjectPath(Item.ObjectPath).TryLoad();
+        if (!Asset)
+        {
+            Item.Missing = TEXT("loadFailed");
+            return;
+        }
+
+        FObjectThumbnail Rendered;
+        ThumbnailTools::RenderThumbnail(Asset, Size, Size, ThumbnailTools::EThumbnailTextureFlushMode::AlwaysFlush, nullptr, &Rendered);
+        if (Rendered.IsEmpty())
+        {
+            Item.Missing = TEXT("renderFailed");
+            return;
+        }
+        EncodeThumbnail(Rendered, Options, Item, TEXT("rendered"));
+    }
+
+    TSharedPtr<FThumbnailsResumeState> Prepare(const TSharedPtr<FJsonObject>& Params, FString& OutError)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* PathValues = nullptr;
+        if (!Params.IsValid() || !Params->TryGetArrayField(TEXT("paths"), PathValues) || PathValues->Num() == 0)
+        {
+            OutError = TEXT("Missing paths array");
+            return nullptr;
+        }
+        if (PathValues->Num() > MaxPaths)
+        {
+            OutError = FString::Printf(TEXT("At most %d paths per call"), MaxPaths);
+            return nullptr;
+        }
+
+        TSharedPtr<FThumbnailsResumeState> State = MakeShared<FThumbnailsResumeState>();
+        State->StartSeconds = FPlatformTime::Seconds();
+        State->Batch = MakeShared<FThumbnailBatch, ESPMode::ThreadSafe>();
+        FThumbnailBatch& Batch = *State->Batch;
+
+        double Number = 0.0;
+        int32 Size = DefaultSize;
+        if (Params->TryGetNumberField(TEXT("size"), Number))
+        {
+            Size = FMath::Clamp(static_cast<int32>(Number), MinSize, MaxSize);
+        }
+        FString FormatName;
+        Params->TryGetStringField(TEXT("format"), FormatName);
+        if (!FViewportCapture::ParseFormat(FormatName, Batch.Options.Format) || Batch.Options.Format == FViewportCapture::EFormat::Bmp)
+        {
+            OutError = FString::Printf(TEXT("Unsupported format '%s' (png or jpeg)"), *FormatName);
+            return nullptr;
+        }
+        if (Params->TryGetNumberField(TEXT("quality"), Number))
+        {
+            Batch.Options.Quality = FMath::Clamp(static_cast<int32>(Number), 1, 100);
+        }
+        Batch.Options.MaxWidth = Size;
+        Batch.Options.MaxHeight = Size;
+        Params->TryGetBoolField(TEXT("render"), State->bRender);
+        if (Params->TryGetNumberField(TEXT("maxRender"), Number))
+        {
+            State->MaxRender = FMath::Max(static_cast<int32>(Number), 0);
+        }
+
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+        TMap<FName, int32> PackageReadIndex;
+        Batch.Items.Reserve(PathValues->Num());
+        for (const TSharedPtr<FJsonValue>& Value : *PathValues)
+        {
+            FThumbnailItem& Item = Batch.Items.AddDefaulted_GetRef();
+            if (!Value.IsValid() || !Value->TryGetString(Item.Path))
+            {
+                OutError = TEXT("paths must be an array of strings");
+                return nullptr;
+            }
+            Item.ObjectPath = ToObjectPath(Item.Path);
+
+            const FAssetData AssetData = Item.ObjectPath.IsEmpty() ? FAssetData() : AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(Item.ObjectPath));
+            if (!AssetData.IsValid())
+            {
+                Item.Missing = TEXT("notFound");
+                continue;
+            }
+            Item.FullName = AssetData.GetFullName();
+
+            // Loaded packages keep their thumbnails in memory, including ones edited since the last save.
+            const FObjectThumbnail* Cached = ThumbnailTools::FindCachedThumbnail(Item.FullName);
+            if (Cached && !Cached->IsEmpty())
+            {
+                Item.MemoryThumbnail = *Cached;
+                Item.bFromMemory = true;
+                Batch.MemoryItems.Add(Batch.Items.Num() - 1);
+                continue;
+            }
+
+            int32& ReadIndex = PackageReadIndex.FindOrAdd(AssetData.PackageName, INDEX_NONE);
+            if (ReadIndex == INDEX_NONE)
+            {
+                ReadIndex = Batch.Packages.Num();
+                Batch.Packages.AddDefaulted_GetRef().PackageName = AssetData.PackageName.ToString();
+            }
+            Batch.Packages[ReadIndex].Items.Add(Batch.Items.Num() - 1);
+        }
+        return State;
+    }
+
+    TSharedPtr<FJsonObject> BuildResponse(const FThumbnailsResumeState& State, UnrealMCP::Protocol::FCommandContext* Context)
+    {
+        const FThumbnailBatch& Batch = *State.Batch;
+        TArray<TSharedPtr<FJsonValue>> Thumbnails;
+        TArray<TSharedPtr<FJsonValue>> Missing;
+        for (const FThumbnailItem& Item : Batch.Items)
+        {
+            if (Item.Missing || !Item.Source)
+            {
+                TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+                Entry->SetStringField(TEXT("path"), Item.Path);
+                Entry->SetStringField(TEXT("reason"), Item.Missing ? Item.Missing : TEXT("noThumbnail"));
+                Missing.Add(MakeShared<FJsonValueObject>(Entry));
+                continue;
+            }
+
+            TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+            Entry->SetStringField(TEXT("path"), Item.Path);
+            Entry->SetStringField(TEXT("source"), Item.Source);
+            Entry->SetNumberField(TEXT("width"), Item.Result.Width);
+            Entry->SetNumberField(TEXT("height"), Item.Result.Height);
+            Entry->SetStringField(TEXT("mimeType"), FViewportCapture::GetMimeType(Batch.Options.Format));
+            Entry->SetNumberField(TEXT("bytes"), Item.Result.Encoded.Num());
+            if (Context && Context->CanAttach())
+            {
+                Entry->SetObjectField(TEXT("data"), Context->Attach(TArray<uint8>(Item.Result.Encoded)));
+            }
+            else
+            {
+                Entry->SetStringField(TEXT("data"), FBase64::Encode(Item.Result.Encoded));
+            }
+            Thumbnails.Add(MakeShared<FJsonValueObject>(Entry));
+        }
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetArrayField(TEXT("thumbnails"), Thumbnails);
+        Data->SetArrayField(TEXT("missing"), Missing);
+        Data->SetNumberField(TEXT("packagesRead"), Batch.PackagesRead.load());
+        Data->SetNumberField(TEXT("fromMemory"), Batch.MemoryItems.Num());
+        Data->SetNumberField(TEXT("rendered"), State.Rendered);
+        Data->SetNumberField(TEXT("elapsedMs"), (FPlatformTime::Seconds() - State.StartSeconds) * 1000.0);
+        return MakeSuccessResponse(Data);
+    }
+}
+
+TSharedPtr<FJsonObject> FAssetThumbnails::Thumbnails(const TSharedPtr<FJsonObject>& Params)
+{
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+    TSharedPtr<FThumbnailsResumeState> State = Context ? Context->TakeResumeState<FThumbnailsResumeState>() : nullptr;
+    if (!State.IsValid())
+    {
+        FString Error;
+        State = Prepare(Params, Error);
+        if (!State.IsValid())
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, Error);
+        }
+
+        // Workers decode and encode through the image wrappers; only the game thread may load the module.
+        FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+        if (Context && Context->CanSuspend())
+        {
+            AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Batch = State->Batch]()
+            {
+                RunBatch(*Batch);
+                Batch->bDone = true;
+            });
+        }
+        else
+        {
+            // Batch entries answer in the same call; the reads still fan out across the workers.
+            RunBatch(*State->Batch);
+            State->Batch->bDone = true;
+        }
+    }
+
+    if (Context && Context->IsCancelled())
+    {
+        return MakeErrorResponse(ErrorCodeCancelled, TEXT("asset.thumbnails cancelled"));
+    }
+    if (!State->Batch->bDone)
+    {
+        Context->Suspend(State.ToSharedRef());
+        return nullptr;
+    }
+
+    // Rendering loads the asset, so it only happens when asked, a few per frame's budget.
+    if (State->bRender)
+    {
+        FThumbnailBatch& Batch = *State->Batch;
+        const double SliceStart = FPlatformTime::Seconds();
+        const double SliceBudgetSeconds = FUnrealMCPRuntimeConfig::Get().GameThreadBudgetMs / 1000.0;
+        for (; State->NextRenderItem < Batch.Items.Num() && State->Rendered < State->MaxRender; ++State->NextRenderItem)
+        {
+            FThumbnailItem& Item = Batch.Items[State->NextRenderItem];
+            if (!Item.Missing || FCString::Strcmp(Item.Missing, TEXT("noThumbnail")) != 0)
+            {
+                continue;
+            }
+            if (Context && Context->CanSuspend() && FPlatformTime::Seconds() - SliceStart >= SliceBudgetSeconds)
+            {
+                Context->Suspend(State.ToSharedRef());
+                return nullptr;
+            }
+            RenderMissing(Item, Batch.Options, Batch.Options.MaxWidth);
+            ++State->Rendered;
+        }
+    }
+
+    return BuildResponse(*State, Context);
+}
@@ -0,0 +1,653 @@
+#include "Assets/DataTableImport.h"
+#include "CoreMinimal.h"
+
+#include "Assets/PackageSaver.h"
+#include "DataTableEditorUtils.h"
+#include "DataTableUtils.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Engine/DataTable.h"
+#include "HAL/PlatformTime.h"
+#include "JsonObjectConverter.h"
+#include "Misc/Base64.h"
+#include "Permissions/WriteGate.h"
+#include "Protocol/Attachments.h"
+#include "Protocol/CommandContext.h"
+#include "ScopedTransaction.h"
+#include "Serialization/Csv/CsvParser.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Transactions/TransactionManager.h"
+#include "UObject/Package.h"
+
+namespace
+{
+    constexpr const TCHAR* ErrorCodeInvalidParams = TEXT("INVALID_PARAMETERS");
+    constexpr const TCHAR* ErrorCodeAssetNotFound = TEXT("ASSET_NOT_FOUND");
+    constexpr const TCHAR* ErrorCodeImportFailed = TEXT("IMPORT_FAILED");
+    constexpr const TCHAR* ErrorCodeSourceControlRequired = TEXT("SOURCE_CONTROL_REQUIRED");
+
+    constexpr int32 MaxRowsPerImport = 1000000;
+    constexpr int32 MaxReportedErrors = 100;
+    constexpr int32 MaxErrorsInMessage = 5;
+    /** A stream nobody has added to for this long is dropped with its staged rows. */
+    constexpr double StagedStreamTimeoutSeconds = 600.0;
+
+    using UnrealMCP::Protocol::FAttachments;
+    using UnrealMCP::Protocol::FCommandContext;
+
+    TSharedPtr<FJsonObject> MakeErrorResponse(const FString& Code, const FString& Message)
+    {
+        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+        Error->SetBoolField(TEXT("success"), false);
+        Error->SetStringField(TEXT("errorCode"), Code);
+        Error->SetStringField(TEXT("error"), Message);
+        return Error;
+    }
+
+    TSharedPtr<FJsonObject> MakeSuccessResponse(const TSharedPtr<FJsonObject>& Payload)
+    {
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetBoolField(TEXT("success"), true);
+        if (Payload.IsValid())
+        {
+            Result->SetObjectField(TEXT("data"), Payload);
+        }
+        return Result;
+    }
+
+    /** One value of one row: CSV cells keep their text, JSON rows their value. */
+    struct FImportCell
+    {
+        int32 Column = INDEX_NONE;
+        FString Text;
+        TSharedPtr<FJsonValue> Json;
+    };
+
+    struct FImportRow
+    {
+        FString Name;
+        TArray<FImportCell> Cells;
+    };
+
+    /** Rows parsed so far, for one request or for all the chunks of a stream. */
+    struct FStagedRows
+    {
+        FString TablePath;
+        /** Column names, shared by the cells of every chunk. */
+        TArray<FString> Columns;
+        TMap<FString, int32> ColumnIndex;
+        TArray<FImportRow> Rows;
+        int32 Chunks = 0;
+        double LastChunkSeconds = 0.0;
+
+        int32 FindOrAddColumn(const FString& Name)
+        {
+            if (const int32* Existing = ColumnIndex.Find(Name))
+            {
+                return *Existing;
+            }
+            const int32 Index = Columns.Add(Name);
+            ColumnIndex.Add(Name, Index);
+            return Index;
+        }
+    };
+
+    /** Game thread only. */
+    TMap<FString, FStagedRows> GStreams;
+
+    void DropExpiredStreams(double Now)
+    {
+        for (auto It = GStreams.CreateIterator(); It; ++It)
+        {
+            if (Now - It.Value().LastChunkSeconds > StagedStreamTimeoutSeconds)
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    /** A scratch row of the table's struct, destroyed with the object. */
+    struct FRowBuffer
+    {
+        explicit FRowBuffer(const UScriptStruct& InStruct)
+            : Struct(&InStruct)
+            , Data(static_cast<uint8*>(FMemory::Malloc(FMath::Max(InStruct.GetStructureSize(), 1), InStruct.GetMinAlignment())))
+        {
+            Struct->InitializeStruct(Data);
+        }
+
+        ~FRowBuffer()
+        {
+            Struct->DestroyStruct(Data);
+            FMemory::Free(Data);
+        }
+
+        FRowBuffer(const FRowBuffer&) = delete;
+        FRowBuffer& operator=(const FRowBuffer&) = delete;
+
+        void ResetToDefaults()
+        {
+            Struct->DestroyStruct(Data);
+            Struct->InitializeStruct(Data);
+        }
+
+        const UScriptStruct* Struct;
+        uint8* Data;
+    };
+
+    bool ReadText(const FJsonObject& Params, FString& OutText, FString& OutError)
+    {
+        const TSharedPtr<FJsonObject>* Reference = nullptr;
+        FString Encoded;
+        TArray<uint8> Decoded;
+        const TArray<uint8>* Bytes = nullptr;
+        if (Params.TryGetObjectField(TEXT("data"), Reference))
+        {
+            const int32 Index = FAttachments::GetReferenceIndex(**Reference);
+            const FCommandContext* Context = FCommandContext::GetActive();
+            Bytes = Index != INDEX_NONE && Context ? Context->GetRequestAttachment(Index) : nullptr;
+            if (!Bytes)
+            {
+                OutError = TEXT("data refers to an attachment the request does not carry");
+                return false;
+            }
+        }
+        else if (Params.TryGetStringField(TEXT("data"), Encoded))
+        {
+            if (!FBase64::Decode(Encoded, Decoded))
+            {
+                OutError = TEXT("data is neither an attachment reference nor base64");
+                return false;
+            }
+            Bytes = &Decoded;
+        }
+        else
+        {
+            return false;
+        }
+
+        // UTF-8 with or without a byte order mark, which spreadsheet exports like to add.
+        int32 Offset = 0;
+        if (Bytes->Num() >= 3 && (*Bytes)[0] == 0xEF && (*Bytes)[1] == 0xBB && (*Bytes)[2] == 0xBF)
+        {
+            Offset = 3;
+        }
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes->GetData() + Offset), Bytes->Num() - Offset);
+        OutText = FString(Converted.Length(), Converted.Get());
+        return true;
+    }
+
+    /**
+     * CSV in the layout the editor exports: a header row, then one row per line. The row name is
+     * in the NameColumn column, or in the first one when its header is "---" or empty.
+     */
+    bool ParseCsv(const FString& Text, const FString& NameColumn, FStagedRows& Staged, FString& OutError)
+    {
+        const FCsvParser Parser(Text);
+        const FCsvParser::FRows& Lines = Parser.GetRows();
+        if (Lines.Num() == 0)
+        {
+            OutError = TEXT("CSV has no header row");
+            return false;
+        }
+
+        const TArray<const TCHAR*>& Header = Lines[0];
+        int32 NameIndex = INDEX_NONE;
+        TArray<int32> Columns;
+        Columns.Init(INDEX_NONE, Header.Num());
+        for (int32 Index = 0; Index < Header.Num(); ++Index)
+        {
+            const FString Name = FString(Header[Index]).TrimStartAndEnd();
+            if (NameIndex == INDEX_NONE && (Name == NameColumn || (Index == 0 && (Name.IsEmpty() || Name == TEXT("---")))))
+            {
+                NameIndex = Index;
+                continue;
+            }
+            if (!Name.IsEmpty())
+            {
+                Columns[Index] = Staged.FindOrAddColumn(Name);
+            }
+        }
+        if (NameIndex == INDEX_NONE)
+        {
+            OutError = FString::Printf(TEXT("CSV header has no %s column"), *NameColumn);
+            return false;
+        }
+
+        Staged.Rows.Reserve(Staged.Rows.Num() + Lines.Num() - 1);
+        for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+        {
+            const TArray<const TCHAR*>& Line = Lines[LineIndex];
+            // Trailing blank lines come back as a single empty cell.
+            if (Line.Num() == 0 || (Line.Num() == 1 && FCString::Strlen(Line[0]) == 0))
+            {
+                continue;
+            }
+
+            FImportRow& Row = Staged.Rows.AddDefaulted_GetRef();
+            Row.Name = Line.IsValidIndex(NameIndex) ? FString(Line[NameIndex]).TrimStartAndEnd() : FString();
+            Row.Cells.Reserve(Line.Num());
+            for (int32 Index = 0; Index < Line.Num() && Index < Columns.Num(); ++Index)
+            {
+                if (Columns[Index] != INDEX_NONE)
+                {
+                    FImportCell& Cell = Row.Cells.AddDefaulted_GetRef();
+                    Cell.Column = Columns[Index];
+                    Cell.Text = Line[Index];
+                }
+            }
+        }
+        return true;
+    }
+
+    /** JSON rows in the layout the editor exports: objects whose NameColumn field names the row. */
+    bool ParseJsonRows(const TArray<TSharedPtr<FJsonValue>>& Values, const FString& NameColumn, FStagedRows& Staged, FString& OutError)
+    {
+        Staged.Rows.Reserve(Staged.Rows.Num() + Values.Num());
+        for (int32 Index = 0; Index < Values.Num(); ++Index)
+        {
+            const TSharedPtr<FJsonObject>* Object = nullptr;
+            if (!Values[Index].IsValid() || !Values[Index]->TryGetObject(Object))
+            {
+                OutError = FString::Printf(TEXT("Row %d is not an object"), Index);
+                return false;
+            }
+
+            FImportRow& Row = Staged.Rows.AddDefaulted_GetRef();
+            Row.Cells.Reserve((*Object)->Values.Num());
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : (*Object)->Values)
+            {
+                if (Field.Key == NameColumn)
+                {
+                    Field.Value->TryGetString(Row.Name);
+                    Row.Name.TrimStartAndEndInline();
+                    continue;
+                }
+                FImportCell& Cell = Row.Cells.AddDefaulted_GetRef();
+                Cell.Column = Staged.FindOrAddColumn(Field.Key);
+                Cell.Json = Field.Value;
+            }
+        }
+        return true;
+    }
+
+    /** Parses this request's chunk (rows, csv, or data with format) into Staged. */
+    bool ParseChunk(const FJsonObject& Params, FStagedRows& Staged, FString& OutError)
+    {
+        FString NameColumn = TEXT("Name");
+        Params.TryGetStringField(TEXT("nameColumn"), NameColumn);
+
+        const TArray<TSharedPtr<FJsonValue>>* Rows = nullptr;
+        FString Text;
+        if (Params.TryGetArrayField(TEXT("rows"), Rows))
+        {
+            return ParseJsonRows(*Rows, NameColumn, Staged, OutError);
+        }
+        if (Params.TryGetStringField(TEXT("csv"), Text))
+        {
+            return ParseCsv(Text, NameColumn, Staged, OutError);
+        }
+        if (!ReadText(Params, Text, OutError))
+        {
+            if (OutError.IsEmpty())
+            {
+                OutError = TEXT("Missing rows, csv or data parameter");
+            }
+            return false;
+        }
+
+        FString Format;
+        Params.TryGetStringField(TEXT("format"), Format);
+        if (Format.Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+        {
+            return ParseCsv(Text, NameColumn, Staged, OutError);
+        }
+        if (!Format.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+        {
+            OutError = TEXT("data needs format \"csv\" or \"json\"");
+            return false;
+        }
+
+        TArray<TSharedPtr<FJsonValue>> Values;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+        if (!FJsonSerializer::Deserialize(Reader, Values))
+        {
+            OutError = TEXT("data is not a JSON array of rows");
+            return false;
+        }
+        return ParseJsonRows(Values, NameColumn, Staged, OutError);
+    }
+
+    /** The row struct's properties by name, by export name and, for user structs, by display name. */
+    TMap<FString, FProperty*> MapProperties(const UScriptStruct& RowStruct)
+    {
+        TMap<FString, FProperty*> Properties;
+        for (TFieldIterator<FProperty> It(&RowStruct); It; ++It)
+        {
+            FProperty* Property = *It;
+            Properties.Add(Property->GetName(), Property);
+            Properties.Add(DataTableUtils::GetPropertyExportName(Property), Property);
+            Properties.Add(Property->GetAuthoredName(), Property);
+        }
+        return Properties;
+    }
+
+    struct FRowChange
+    {
+        FName Name;
+        bool bAdded = false;
+        TUniquePtr<FRowBuffer> Row;
+    };
+
+    void AddRowError(TArray<TSharedPtr<FJsonValue>>& Errors, int32& ErrorCount, int32 Index, const FString& RowName, const FString& Column, const FString& Message)
+    {
+        if (++ErrorCount > MaxReportedErrors)
+        {
+            return;
+        }
+        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+        Error->SetNumberField(TEXT("index"), Index);
+        Error->SetStringField(TEXT("row"), RowName);
+        if (!Column.IsEmpty())
+        {
+            Error->SetStringField(TEXT("column"), Column);
+        }
+        Error->SetStringField(TEXT("error"), Message);
+        Errors.Add(MakeShared<FJsonValueObject>(Error));
+    }
+}
+
+TSharedPtr<FJsonObject> FDataTableImport::ImportRows(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!Params.IsValid())
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+    }
+
+    const double StartSeconds = FPlatformTime::Seconds();
+    FString TablePath;
+    if (!Params->TryGetStringField(TEXT("dataTable"), TablePath) || TablePath.TrimStartAndEnd().IsEmpty())
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing dataTable parameter"));
+    }
+    TablePath.TrimStartAndEndInline();
+
+    FString Mode = TEXT("merge");
+    Params->TryGetStringField(TEXT("mode"), Mode);
+    const bool bReplace = Mode == TEXT("replace");
+    if (!bReplace && Mode != TEXT("merge"))
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("Unknown mode \"%s\"; expected merge or replace"), *Mode));
+    }
+
+    FString StreamId;
+    Params->TryGetStringField(TEXT("stream"), StreamId);
+    const bool bFinal = !Params->HasTypedField<EJson::Boolean>(TEXT("final")) || Params->GetBoolField(TEXT("final"));
+    if (!bFinal && StreamId.IsEmpty())
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("final: false needs a stream id"));
+    }
+
+    UDataTable* Table = LoadObject<UDataTable>(nullptr, *TablePath);
+    const UScriptStruct* RowStruct = Table ? Table->GetRowStruct() : nullptr;
+    if (!RowStruct)
+    {
+        return MakeErrorResponse(ErrorCodeAssetNotFound, FString::Printf(TEXT("Unable to load a DataTable with a row struct: %s"), *TablePath));
+    }
+
+    // Chunks of a stream accumulate until the final one; a lone request is a stream of one chunk.
+    const double Now = FPlatformTime::Seconds();
+    DropExpiredStreams(Now);
+    FStagedRows LocalRows;
+    FStagedRows* Staged = &LocalRows;
+    if (!StreamId.IsEmpty())
+    {
+        Staged = &GStreams.FindOrAdd(StreamId);
+        if (Staged->Chunks == 0)
+        {
+            Staged->TablePath = TablePath;
+        }
+        else if (Staged->TablePath != TablePath)
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("Stream %s imports into %s"), *StreamId, *Staged->TablePath));
+        }
+    }
+
+    FString ParseError;
+    const bool bParsed = ParseChunk(*Params, *Staged, ParseError);
+    if (bParsed && Staged->Rows.Num() > MaxRowsPerImport)
+    {
+        ParseError = FString::Printf(TEXT("At most %d rows per import"), MaxRowsPerImport);
+    }
+    if (!ParseError.IsEmpty())
+    {
+        GStreams.Remove(StreamId);
+        return MakeErrorResponse(ErrorCodeInvalidParams, ParseError);
+    }
+    ++Staged->Chunks;
+    Staged->LastChunkSeconds = Now;
+
+    if (!bFinal)
+    {
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetStringField(TEXT("dataTable"), TablePath);
+        Data->SetStringField(TEXT("stream"), StreamId);
+        Data->SetNumberField(TEXT("chunks"), Staged->Chunks);
+        Data->SetNumberField(TEXT("staged"), Staged->Rows.Num());
+        return MakeSuccessResponse(Data);
+    }
+
+    FStagedRows Import = MoveTemp(*Staged);
+    GStreams.Remove(StreamId);
+
+    const bool bIgnoreUnknown = Params->HasTypedField<EJson::Boolean>(TEXT("ignoreUnknownColumns")) && Params->GetBoolField(TEXT("ignoreUnknownColumns"));
+    const bool bAllowPartial = Params->HasTypedField<EJson::Boolean>(TEXT("allowPartial")) && Params->GetBoolField(TEXT("allowPartial"));
+    const bool bSave = Params->HasTypedField<EJson::Boolean>(TEXT("save")) && Params->GetBoolField(TEXT("save"));
+
+    const TMap<FString, FProperty*> PropertiesByName = MapProperties(*RowStruct);
+    TArray<FProperty*> ColumnProperties;
+    TArray<TSharedPtr<FJsonValue>> UnknownColumns;
+    ColumnProperties.Reserve(Import.Columns.Num());
+    for (const FString& Column : Import.Columns)
+    {
+        FProperty* const* Property = PropertiesByName.Find(Column);
+        ColumnProperties.Add(Property ? *Property : nullptr);
+        if (!Property)
+        {
+            UnknownColumns.Add(MakeShared<FJsonValueString>(Column));
+        }
+    }
+    if (UnknownColumns.Num() > 0 && !bIgnoreUnknown)
+    {
+        TArray<FString> Names;
+        for (const TSharedPtr<FJsonValue>& Value : UnknownColumns)
+        {
+            Names.Add(Value->AsString());
+        }
+        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("%s has no column %s (set ignoreUnknownColumns to skip them)"),
+            *RowStruct->GetName(), *FString::Join(Names, TEXT(", "))));
+    }
+
+    // Every row is built and compared before the table is touched, so a bad row leaves it as it was.
+    TArray<FRowChange> Changes;
+    TMap<FName, int32> ChangeIndex;
+    TSet<FName> Imported;
+    TArray<TSharedPtr<FJsonValue>> Errors;
+    TArray<FString> Problems;
+    int32 ErrorCount = 0;
+    int32 Unchanged = 0;
+    FRowBuffer Scratch(*RowStruct);
+    for (int32 RowIndex = 0; RowIndex < Import.Rows.Num(); ++RowIndex)
+    {
+        const FImportRow& Row = Import.Rows[RowIndex];
+        const FName RowName = DataTableUtils::MakeValidName(Row.Name);
+        if (Row.Name.IsEmpty() || RowName.IsNone())
+        {
+            AddRowError(Errors, ErrorCount, RowIndex, Row.Name, FString(), TEXT("Row has no name"));
+            continue;
+        }
+
+        // A row named twice builds on its earlier entry; merge mode starts from the stored row,
+        // replace mode from the struct's defaults.
+        const int32* Earlier = ChangeIndex.Find(RowName);
+        const uint8* Existing = Table->FindRowUnchecked(RowName);
+        if (Earlier)
+        {
+            RowStruct->CopyScriptStruct(Scratch.Data, Changes[*Earlier].Row->Data);
+        }
+        else if (Existing && (!bReplace || Imported.Contains(RowName)))
+        {
+            RowStruct->CopyScriptStruct(Scratch.Data, Existing);
+        }
+        else
+        {
+            Scratch.ResetToDefaults();
+        }
+
+        bool bRowFailed = false;
+        for (const FImportCell& Cell : Row.Cells)
+        {
+            FProperty* Property = ColumnProperties[Cell.Column];
+            if (!Property)
+            {
+                continue;
+            }
+            if (Cell.Json.IsValid())
+            {
+                FText Reason;
+                if (!FJsonObjectConverter::JsonValueToUProperty(Cell.Json, Property, Property->ContainerPtrToValuePtr<void>(Scratch.Data), 0, 0, false, &Reason))
+                {
+                    AddRowError(Errors, ErrorCount, RowIndex, Row.Name, Import.Columns[Cell.Column], Reason.IsEmpty() ? TEXT("Value does not fit the property") : Reason.ToString());
+                    bRowFailed = true;
+                }
+                continue;
+            }
+            const FString CellError = DataTableUtils::AssignStringToProperty(Cell.Text, Property, Scratch.Data);
+            if (!CellError.IsEmpty())
+            {
+                AddRowError(Errors, ErrorCount, RowIndex, Row.Name, Import.Columns[Cell.Column], CellError);
+                bRowFailed = true;
+            }
+        }
+        if (bRowFailed)
+        {
+            continue;
+        }
+
+        reinterpret_cast<FTableRowBase*>(Scratch.Data)->OnPostDataImport(Table, RowName, Problems);
+        Imported.Add(RowName);
+        if (Earlier)
+        {
+            RowStruct->CopyScriptStruct(Changes[*Earlier].Row->Data, Scratch.Data);
+            continue;
+        }
+        if (Existing && RowStruct->CompareScriptStruct(Existing, Scratch.Data, PPF_None))
+        {
+            ++Unchanged;
+            continue;
+        }
+
+        FRowChange& Change = Changes.AddDefaulted_GetRef();
+        Change.Name = RowName;
+        Change.bAdded = Existing == nullptr;
+        Change.Row = MakeUnique<FRowBuffer>(*RowStruct);
+        RowStruct->CopyScriptStruct(Change.Row->Data, Scratch.Data);
+        ChangeIndex.Add(RowName, Changes.Num() - 1);
+    }
+
+    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+    Data->SetStringField(TEXT("dataTable"), Table->GetPathName());
+    Data->SetStringField(TEXT("mode"), Mode);
+    Data->SetNumberField(TEXT("rows"), Import.Rows.Num());
+    Data->SetNumberField(TEXT("chunks"), Import.Chunks);
+    Data->SetNumberField(TEXT("failed"), ErrorCount);
+    Data->SetArrayField(TEXT("errors"), Errors);
+    Data->SetArrayField(TEXT("unknownColumns"), UnknownColumns);
+    if (ErrorCount > 0 && !bAllowPartial)
+    {
+        // Error responses carry a message only, so it names the first failures itself.
+        TArray<FString> FirstErrors;
+        for (int32 Index = 0; Index < Errors.Num() && Index < MaxErrorsInMessage; ++Index)
+        {
+            const TSharedPtr<FJsonObject>& Error = Errors[Index]->AsObject();
+            FString Column;
+            Error->TryGetStringField(TEXT("column"), Column);
+            FirstErrors.Add(FString::Printf(TEXT("row %d (%s)%s%s: %s"), static_cast<int32>(Error->GetNumberField(TEXT("index"))),
+                *Error->GetStringField(TEXT("row")), Column.IsEmpty() ? TEXT("") : TEXT(" column "), *Column, *Error->GetStringField(TEXT("error"))));
+        }
+        return MakeErrorResponse(ErrorCodeImportFailed, FString::Printf(TEXT("%d of %d rows failed, nothing was changed (set allowPartial to import the rest): %s"),
+            ErrorCount, Import.Rows.Num(), *FString::Join(FirstErrors, TEXT("; "))));
+    }
+
+    // In replace mode the imported rows are the whole table afterwards (minus failed rows, with allowPartial).
+    TArray<FName> Removed;
+    if (bReplace)
+    {
+        for (const TPair<FName, uint8*>& Pair : Table->GetRowMap())
+        {
+            if (!Imported.Contains(Pair.Key))
+            {
+                Removed.Add(Pair.Key);
+            }
+        }
+    }
+
+    int32 Added = 0;
+    if (Changes.Num() > 0 || Removed.Num() > 0)
+    {
+        FScopedTransaction Transaction(FText::FromString(FWriteGate::GetTransactionName()), !FTransactionManager::IsUndoSuppressed());
+        Table->Modify();
+
+        // One pre/post pair around the whole pass, so an open table editor rebuilds its list once.
+        FDataTableEditorUtils::BroadcastPreChange(Table, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+        for (const FName& RowName : Removed)
+        {
+            Table->RemoveRow(RowName);
+        }
+        for (const FRowChange& Change : Changes)
+        {
+            if (Change.bAdded)
+            {
+                // AddRow copies the row and notifies for it.
+                Table->AddRow(Change.Name, *reinterpret_cast<const FTableRowBase*>(Change.Row->Data));
+                ++Added;
+                continue;
+            }
+            RowStruct->CopyScriptStruct(Table->FindRowUnchecked(Change.Name), Change.Row->Data);
+            Table->HandleDataTableChanged(Change.Name);
+        }
+        FDataTableEditorUtils::BroadcastPostChange(Table, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+    }
+
+    Data->SetNumberField(TEXT("added"), Added);
+    Data->SetNumberField(TEXT("updated"), Changes.Num() - Added);
+    Data->SetNumberField(TEXT("unchanged"), Unchanged);
+    Data->SetNumberField(TEXT("removed"), Removed.Num());
+    if (Problems.Num() > 0)
+    {
+        TArray<TSharedPtr<FJsonValue>> Warnings;
+        for (const FString& Problem : Problems)
+        {
+            Warnings.Add(MakeShared<FJsonValueString>(Problem));
+        }
+        Data->SetArrayField(TEXT("warnings"), Warnings);
+    }
+
+    // One save for the whole import, and none when nothing changed.
+    bool bSaved = false;
+    if (bSave && Table->GetOutermost()->IsDirty())
+    {
+        TArray<FPackageSaver::FResult> Results;
+        TSharedPtr<FJsonObject> CheckoutError;
+        if (!FPackageSaver::SavePackages({ Table->GetOutermost() }, Results, CheckoutError))
+        {
+            return CheckoutError.IsValid() ? CheckoutError : MakeErrorResponse(ErrorCodeSourceControlRequired, TEXT("Source control checkout required"));
+        }
+        bSaved = Results.Num() == 1 && Results[0].bSaved;
+        Data->SetArrayField(TEXT("saveResults"), FPackageSaver::ResultsToJson(Results));
+    }
+    Data->SetBoolField(TEXT("saved"), bSaved);
+    Data->SetNumberField(TEXT("elapsedMs"), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+    return MakeSuccessResponse(Data);
+}
@@ -0,0 +1,505 @@
+#include "Assets/ImportSourceProbe.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Templates/UniquePtr.h"
+
+namespace
+{
+    /** Enough for every fixed header here and for the EXIF blocks that precede a JPEG frame header. */
+    constexpr int64 MaxHeaderBytes = 1024 * 1024;
+    /** Ogg's last page, which carries the stream length, lies within this much of the end. */
+    constexpr int64 OggTailBytes = 64 * 1024;
+    constexpr int64 FbxScanBlockBytes = 4 * 1024 * 1024;
+
+    bool ReadRange(FArchive& Reader, int64 Offset, int64 Size, TArray<uint8>& OutBytes)
+    {
+        Size = FMath::Clamp<int64>(Size, 0, Reader.TotalSize() - Offset);
+        OutBytes.SetNumUninitialized(static_cast<int32>(Size));
+        Reader.Seek(Offset);
+        Reader.Serialize(OutBytes.GetData(), Size);
+        return !Reader.IsError();
+    }
+
+    uint16 ReadU16LE(const uint8* Bytes) { return static_cast<uint16>(Bytes[0] | (Bytes[1] << 8)); }
+    uint16 ReadU16BE(const uint8* Bytes) { return static_cast<uint16>((Bytes[0] << 8) | Bytes[1]); }
+    uint32 ReadU32LE(const uint8* Bytes) { return static_cast<uint32>(Bytes[0]) | (static_cast<uint32>(Bytes[1]) << 8) | (static_cast<uint32>(Bytes[2]) << 16) | (static_cast<uint32>(Bytes[3]) << 24); }
+    uint32 ReadU32BE(const uint8* Bytes) { return (static_cast<uint32>(Bytes[0]) << 24) | (static_cast<uint32>(Bytes[1]) << 16) | (static_cast<uint32>(Bytes[2]) << 8) | static_cast<uint32>(Bytes[3]); }
+    uint64 ReadU64LE(const uint8* Bytes) { return static_cast<uint64>(ReadU32LE(Bytes)) | (static_cast<uint64>(ReadU32LE(Bytes + 4)) << 32); }
+
+    bool HasMagic(const TArray<uint8>& Bytes, int32 Offset, const char* Magic)
+    {
+        const int32 Length = FCStringAnsi::Strlen(Magic);
+        return Offset + Length <= Bytes.Num() && FMemory::Memcmp(Bytes.GetData() + Offset, Magic, Length) == 0;
+    }
+
+    bool ProbePng(const TArray<uint8>& Bytes, FImportSourceInfo& Info, FString& OutError)
+    {
+        if (Bytes.Num() < 26 || !HasMagic(Bytes, 0, "\x89PNG") || !HasMagic(Bytes, 12, "IHDR"))
+        {
+            OutError = TEXT("PNG without an IHDR chunk");
+            return false;
+        }
+
+        static const int32 ChannelsByColorType[] = { 1, 0, 3, 3, 2, 0, 4 };
+        Info.Width = static_cast<int32>(ReadU32BE(&Bytes[16]));
+        Info.Height = static_cast<int32>(ReadU32BE(&Bytes[20]));
+        Info.BitsPerChannel = Bytes[24];
+        Info.Channels = Bytes[25] < UE_ARRAY_COUNT(ChannelsByColorType) ? ChannelsByColorType[Bytes[25]] : 0;
+        return true;
+    }
+
+    bool ProbeJpeg(const TArray<uint8>& Bytes, FImportSourceInfo& Info, FString& OutError)
+    {
+        // Walks the marker segments up to the first start-of-frame, which holds the dimensions.
+        int32 Offset = 2;
+        while (Offset + 4 <= Bytes.Num() && Bytes[Offset] == 0xFF)
+        {
+            const uint8 Marker = Bytes[Offset + 1];
+            const int32 SegmentLength = ReadU16BE(&Bytes[Offset + 2]);
+            const bool bStartOfFrame = Marker >= 0xC0 && Marker <= 0xCF && Marker != 0xC4 && Marker != 0xC8 && Marker != 0xCC;
+            if (bStartOfFrame && Offset + 10 <= Bytes.Num())
+            {
+                Info.BitsPerChannel = Bytes[Offset + 4];
+                Info.Height = ReadU16BE(&Bytes[Offset + 5]);
+                Info.Width = ReadU16BE(&Bytes[Offset + 7]);
+                Info.Channels = Bytes[Offset + 9];
+                return true;
+            }
+            Offset += 2 + SegmentLength;
+        }
+        OutError = TEXT("JPEG without a frame header in its first megabyte");
+        return false;
+    }
+
+    bool ProbeBmp(const TArray<uint8>& Bytes, FImportSourceInfo& Info, FString& OutError)
+    {
+        if (Bytes.Num() < 30 || !HasMagic(Bytes, 0, "BM"))
+        {
+            OutError = TEXT("BMP header is truncated");
+            return false;
+        }
+
+        Info.Width = FMath::Abs(static_cast<int32>(ReadU32LE(&Bytes[18])));
+        Info.Height = FMath::Abs(static_cast<int32>(ReadU32LE(&Bytes[22])));
+        const int32 BitsPerPixel = ReadU16LE(&Bytes[28]);
+        Info.Channels = BitsPerPixel == 32 ? 4 : 3;
+        Info.BitsPerChannel = BitsPerPixel >= 24 ? 8 : BitsPerPixel;
+        return true;
+    }
+
+    bool ProbeTga(const TArray<uint8>& Bytes, FImportSourceInfo& Info, FString& OutError)
+    {
+        // TGA has no signature; the image type byte is the only sanity check.
+        const uint8 ImageType = Bytes.Num() >= 18 ? Bytes[2] : 0;
+        if (ImageType != 1 && ImageType != 2 && ImageType != 3 && ImageType != 9 && ImageType != 10 && ImageType != 11)
+        {
+            OutError = TEXT("TGA header has an unknown image type");
+            return false;
+        }
+
+        Info.Width = ReadU16LE(&Bytes[12]);
+        Info.Height = ReadU16LE(&Bytes[14]);
+        const int32 BitsPerPixel = Bytes[16];
+        Info.Channels = (ImageType == 3 || ImageType == 11) ? 1 : (BitsPerPixel == 32 ? 4 : 3);
+        Info.BitsPerChannel = 8;
+        return true;
+    }
+
+    bool ProbeExr(const TArray<uint8>& Bytes, FImportSourceInfo& Info, FString& OutError)
+    {
+        if (!HasMagic(Bytes, 0, "\x76\x2F\x31\x01"))
+        {
+            OutError = TEXT("EXR magic number is missing");
+            return false;
+        }
+
+        // Attributes follow the 8-byte version field as name\0 type\0 size value, up to an empty name.
+        Info.bHdr = true;
+        Info.BitsPerChannel = 16;
+        int32 Offset = 8;
+        while (Offset < Bytes.Num() && Bytes[Offset] != 0)
+        {
+            const int32 NameStart = Offset;
+            while (Offset < Bytes.Num() && Bytes[Offset] != 0) { ++Offset; }
+            const FString Name = FString::ConstructFromPtrSize(reinterpret_cast<const ANSICHAR*>(&Bytes[NameStart]), Offset - NameStart);
+            ++Offset;
+            while (Offset < Bytes.Num() && Bytes[Offset] != 0) { ++Offset; }
+            ++Offset;
+            if (Offset + 4 > Bytes.Num())
+            {
+                break;
+            }
+            const int32 Size = static_cast<int32>(ReadU32LE(&Bytes[Offset]));
+            Offset += 4;
+            if (Size < 0 || Offset + Size > Bytes.Num())
+            {
+                break;
+            }
+
+            if (Name == TEXT("dataWindow") && Size == 16)
+            {
+                Info.Width = static_cast<int32>(ReadU32LE(&Bytes[Offset + 8])) - static_cast<int32>(ReadU32LE(&Bytes[Offset])) + 1;
+                Info.Height = static_cast<int32>(ReadU32LE(&Bytes[Offset + 12])) - static_cast<int32>(ReadU32LE(&Bytes[Offset + 4])) + 1;
+            }
+            else if (Name == TEXT("channels"))
+            {
+                // Each channel is name\0 then 16 bytes of type and sampling; the list ends with \0.
+                int32 ChannelOffset = Offset;
+                const int32 End = Offset + Size;
+                while (ChannelOffset < End && Bytes[ChannelOffset] != 0)
+                {
+                    while (ChannelOffset < End && Bytes[ChannelOffset] != 0) { ++ChannelOffset; }
+                    if (ChannelOffset + 17 <= End && ReadU32LE(&Bytes[ChannelOffset + 1]) == 2)
+                    {
+                        Info.BitsPerChannel = 32;
+                    }
+                    ChannelOffset += 17;
+                    ++Info.Channels;
+                }
+            }
+            Offset += Size;
+        }
+
+        if (Info.Width <= 0 || Info.Height <= 0)
+        {
+            OutError = TEXT("EXR header has no dataWindow");
+            return false;
+        }
+        return true;
+    }
+
+    bool ProbeRadianceHdr(const TArray<uint8>& Bytes, FImportSourceInfo& Info, FString& OutError)
+    {
+        if (!HasMagic(Bytes, 0, "#?"))
+        {
+            OutError = TEXT("Radiance HDR signature is missing");
+            return false;
+        }
+
+        // Header lines end at a blank line; the next line is the resolution, e.g. "-Y 512 +X 1024".
+        const FString Text = FString::ConstructFromPtrSize(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), FMath::Min(Bytes.Num(), 4096));
+        const int32 BlankLine = Text.Find(TEXT("\n\n"));
+        if (BlankLine != INDEX_NONE)
+        {
+            FString Resolution = Text.Mid(BlankLine + 2);
+            Resolution.Split(TEXT("\n"), &Resolution, nullptr);
+
+            TArray<FString> Parts;
+            Resolution.ParseIntoArrayWS(Parts);
+            if (Parts.Num() == 4)
+            {
+                const bool bRowsFirst = Parts[0].EndsWith(TEXT("Y"));
+                Info.Height = FCString::Atoi(*Parts[bRowsFirst ? 1 : 3]);
+                Info.Width = FCString::Atoi(*Parts[bRowsFirst ? 3 : 1]);
+            }
+        }
+        if (Info.Width <= 0 || Info.Height <= 0)
+        {
+            OutError = TEXT("Radiance HDR resolution line is missing");
+            return false;
+        }
+
+        Info.bHdr = true;
+        Info.Channels = 3;
+        Info.BitsPerChannel = 32;
+        return true;
+    }
+
+    bool ProbeWav(const TArray<uint8>& Bytes, FImportSourceInfo& Info, FString& OutError)
+    {
+        if (!HasMagic(Bytes, 0, "RIFF") || !HasMagic(Bytes, 8, "WAVE"))
+        {
+            OutError = TEXT("WAV file without a RIFF/WAVE header");
+            return false;
+        }
+
+        uint32 ByteRate = 0;
+        int64 DataBytes = -1;
+        int32 Offset = 12;
+        while (Offset + 8 <= Bytes.Num())
+        {
+            const uint32 ChunkSize = ReadU32LE(&Bytes[Offset + 4]);
+            if (HasMagic(Bytes, Offset, "fmt ") && Offset + 24 <= Bytes.Num())
+            {
+                Info.Channels = ReadU16LE(&Bytes[Offset + 10]);
+                Info.SampleRate = static_cast<int32>(ReadU32LE(&Bytes[Offset + 12]));
+                ByteRate = ReadU32LE(&Bytes[Offset + 16]);
+                Info.BitsPerChannel = ReadU16LE(&Bytes[Offset + 22]);
+            }
+            else if (HasMagic(Bytes, Offset, "data"))
+            {
+                // The data chunk can be far larger than what was read; its size field is enough.
+                DataBytes = FMath::Min<int64>(ChunkSize, Info.FileSize - Offset - 8);
+                break;
+            }
+            Offset += 8 + ChunkSize + (ChunkSize & 1);
+        }
+
+        if (Info.SampleRate <= 0 || Info.Channels <= 0)
+        {
+            OutError = TEXT("WAV file without a fmt chunk");
+            return false;
+        }
+        if (DataBytes >= 0 && ByteRate > 0)
+        {
+            Info.DurationSeconds = static_cast<double>(DataBytes) / ByteRate;
+        }
+        return true;
+    }
+
+    bool ProbeOgg(FArchive& Reader, const TArray<uint8>& Bytes, FImportSourceInfo& Info, FString& OutError)
+    {
+        if (!HasMagic(Bytes, 0, "OggS") || Bytes.Num() < 27)
+        {
+            OutError = TEXT("Ogg file without a first page");
+            return false;
+        }
+
+        // The first packet starts right after the first page's segment table.
+        const int32 PacketOffset = 27 + Bytes[26];
+        int64 PreSkip = 0;
+        if (HasMagic(Bytes, PacketOffset, "\x01vorbis") && PacketOffset + 16 <= Bytes.Num())
+        {
+            Info.Channels = Bytes[PacketOffset + 11];
+            Info.SampleRate = static_cast<int32>(ReadU32LE(&Bytes[PacketOffset + 12]));
+        }
+        else if (HasMagic(Bytes, PacketOffset, "OpusHead") && PacketOffset + 16 <= Bytes.Num())
+        {
+            // Opus granule positions always count 48 kHz samples, whatever the input rate was.
+            Info.Channels = Bytes[PacketOffset + 9];
+            PreSkip = ReadU16LE(&Bytes[PacketOffset + 10]);
+            Info.SampleRate = 48000;
+        }
+        else
+        {
+            OutError = TEXT("Ogg stream is neither Vorbis nor Opus");
+            return false;
+        }
+
+        // The last page's granule position is the stream's length in samples.
+        TArray<uint8> Tail;
+        const int64 TailOffset = FMath::Max<int64>(0, Info.FileSize - OggTailBytes);
+        if (ReadRange(Reader, TailOffset, OggTailBytes, Tail))
+        {
+            for (int32 Offset = Tail.Num() - 14; Offset >= 0; --Offset)
+            {
+                if (HasMagic(Tail, Offset, "OggS"))
+                {
+                    const int64 Granule = static_cast<int64>(ReadU64LE(&Tail[Offset + 6]));
+                    Info.DurationSeconds = FMath::Max<int64>(Granule - PreSkip, 0) / static_cast<double>(Info.SampleRate);
+                    break;
+                }
+            }
+        }
+        Info.BitsPerChannel = 16;
+        return true;
+    }
+
+    bool ProbeFlac(const TArray<uint8>& Bytes, FImportSourceInfo& Info, FString& OutError)
+    {
+        // STREAMINFO is always the first metadata block: rate (20 bits), channels - 1 (3),
+        // bits per sample - 1 (5) and total samples (36) start 10 bytes into it.
+        if (!HasMagic(Bytes, 0, "fLaC") || Bytes.Num() < 26 || (Bytes[4] & 0x7F) != 0)
+        {
+            OutError = TEXT("FLAC file without a STREAMINFO block");
+            return false;
+        }
+
+        const uint8* Packed = &Bytes[18];
+        const uint64 Bits = (static_cast<uint64>(ReadU32BE(Packed)) << 32) | ReadU32BE(Packed + 4);
+        Info.SampleRate = static_cast<int32>(Bits >> 44);
+        Info.Channels = static_cast<int32>((Bits >> 41) & 0x7) + 1;
+        Info.BitsPerChannel = static_cast<int32>((Bits >> 36) & 0x1F) + 1;
+        const uint64 TotalSamples = Bits & 0xFFFFFFFFFull;
+        if (Info.SampleRate > 0)
+        {
+            Info.DurationSeconds = static_cast<double>(TotalSamples) / Info.SampleRate;
+        }
+        return true;
+    }
+
+    /**
+     * Counts geometry, skin cluster and animation stack objects by their name markers: binary FBX
+     * stores object names as "Name\x00\x01Class", ASCII FBX as "Class::Name". Node names are never
+     * compressed, so this holds without decoding the node tree.
+     */
+    bool ProbeFbx(FArchive& Reader, const TArray<uint8>& Bytes, FImportSourceInfo& Info, FString& OutError)
+    {
+        static const char BinaryMagic[] = "Kaydara FBX Binary  ";
+        Info.bFbxBinary = HasMagic(Bytes, 0, BinaryMagic);
+        if (Info.bFbxBinary)
+        {
+            Info.FbxVersion = Bytes.Num() >= 27 ? static_cast<int32>(ReadU32LE(&Bytes[23])) : 0;
+        }
+        else
+        {
+            const FString Text = FString::ConstructFromPtrSize(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), FMath::Min(Bytes.Num(), 256));
+            const int32 VersionAt = Text.Find(TEXT("FBX "));
+            if (VersionAt == INDEX_NONE)
+            {
+                OutError = TEXT("Neither a binary nor an ASCII FBX header");
+                return false;
+            }
+            // "; FBX 7.4.0 project file" becomes 7400, matching the binary header's number.
+            TArray<FString> VersionParts;
+            Text.Mid(VersionAt + 4, 16).ParseIntoArray(VersionParts, TEXT("."));
+            if (VersionParts.Num() >= 2)
+            {
+                Info.FbxVersion = FCString::Atoi(*VersionParts[0]) * 1000 + FCString::Atoi(*VersionParts[1]) * 100;
+            }
+        }
+
+        // The binary markers contain a NUL, so they carry explicit lengths.
+        const FAnsiStringView Markers[] = {
+            Info.bFbxBinary ? FAnsiStringView("\x00\x01Geometry", 10) : FAnsiStringView("\"Geometry::"),
+            Info.bFbxBinary ? FAnsiStringView("\x00\x01SubDeformer", 13) : FAnsiStringView("\"SubDeformer::"),
+            Info.bFbxBinary ? FAnsiStringView("\x00\x01" "AnimStack", 11) : FAnsiStringView("\"AnimStack::")
+        };
+        int32 Counts[UE_ARRAY_COUNT(Markers)] = {};
+
+        // Blocks overlap by the longest marker so none is missed at a block edge.
+        constexpr int32 Overlap = 16;
+        TArray<uint8> Block;
+        for (int64 Offset = 0; Offset < Info.FileSize; Offset += FbxScanBlockBytes - Overlap)
+        {
+            if (!ReadRange(Reader, Offset, FbxScanBlockBytes, Block))
+            {
+                OutError = TEXT("Read error while scanning the FBX file");
+                return false;
+            }
+            const int32 Scanned = Offset + Block.Num() >= Info.FileSize ? Block.Num() : Block.Num() - Overlap;
+            for (int32 MarkerIndex = 0; MarkerIndex < UE_ARRAY_COUNT(Markers); ++MarkerIndex)
+            {
+                const FAnsiStringView Marker = Markers[MarkerIndex];
+                for (int32 At = 0; At + Marker.Len() <= Block.Num() && At < Scanned; ++At)
+                {
+                    if (Block[At] == static_cast<uint8>(Marker[0]) && FMemory::Memcmp(&Block[At], Marker.GetData(), Marker.Len()) == 0)
+                    {
+                        ++Counts[MarkerIndex];
+                        At += Marker.Len() - 1;
+                    }
+                }
+            }
+            if (Offset + Block.Num() >= Info.FileSize)
+            {
+                break;
+            }
+        }
+
+        Info.GeometryCount = Counts[0];
+        Info.SkinClusterCount = Counts[1];
+        Info.AnimStackCount = Counts[2];
+        return true;
+    }
+}
+
+TSharedRef<FJsonObject> FImportSourceInfo::ToJson() const
+{
+    TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetStringField(TEXT("format"), Format);
+    Json->SetNumberField(TEXT("bytes"), static_cast<double>(FileSize));
+    if (Width > 0)
+    {
+        Json->SetNumberField(TEXT("width"), Width);
+        Json->SetNumberField(TEXT("height"), Height);
+        Json->SetBoolField(TEXT("hdr"), bHdr);
+    }
+    if (Format == TEXT("fbx"))
+    {
+        Json->SetNumberField(TEXT("version"), FbxVersion);
+        Json->SetBoolField(TEXT("binary"), bFbxBinary);
+        Json->SetNumberField(TEXT("geometries"), GeometryCount);
+        Json->SetNumberField(TEXT("skinClusters"), SkinClusterCount);
+        Json->SetNumberField(TEXT("animStacks"), AnimStackCount);
+    }
+    if (SampleRate > 0)
+    {
+        Json->SetNumberField(TEXT("sampleRate"), SampleRate);
+        Json->SetNumberField(TEXT("durationSeconds"), DurationSeconds);
+    }
+    if (Channels > 0)
+    {
+        Json->SetNumberField(TEXT("channels"), Channels);
+    }
+    if (BitsPerChannel > 0)
+    {
+        Json->SetNumberField(TEXT("bitsPerChannel"), BitsPerChannel);
+    }
+    return Json;
+}
+
+bool FImportSourceProbe::Probe(const FString& FilePath, FImportSourceInfo& OutInfo, FString& OutError)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+    if (!Reader.IsValid())
+    {
+        OutError = TEXT("File cannot be opened");
+        return false;
+    }
+
+    OutInfo.FileSize = Reader->TotalSize();
+    TArray<uint8> Bytes;
+    if (OutInfo.FileSize <= 0 || !ReadRange(*Reader, 0, MaxHeaderBytes, Bytes))
+    {
+        OutError = TEXT("File is empty or unreadable");
+        return false;
+    }
+
+    const FString Extension = FPaths::GetExtension(FilePath).ToLower();
+    if (Extension == TEXT("png"))
+    {
+        OutInfo.Format = TEXT("png");
+        return ProbePng(Bytes, OutInfo, OutError);
+    }
+    if (Extension == TEXT("jpg") || Extension == TEXT("jpeg"))
+    {
+        OutInfo.Format = TEXT("jpeg");
+        return ProbeJpeg(Bytes, OutInfo, OutError);
+    }
+    if (Extension == TEXT("bmp"))
+    {
+        OutInfo.Format = TEXT("bmp");
+        return ProbeBmp(Bytes, OutInfo, OutError);
+    }
+    if (Extension == TEXT("tga"))
+    {
+        OutInfo.Format = TEXT("tga");
+        return ProbeTga(Bytes, OutInfo, OutError);
+    }
+    if (Extension == TEXT("exr"))
+    {
+        OutInfo.Format = TEXT("exr");
+        return ProbeExr(Bytes, OutInfo, OutError);
+    }
+    if (Extension == TEXT("hdr"))
+    {
+        OutInfo.Format = TEXT("hdr");
+        return ProbeRadianceHdr(Bytes, OutInfo, OutError);
+    }
+    if (Extension == TEXT("wav"))
+    {
+        OutInfo.Format = TEXT("wav");
+        return ProbeWav(Bytes, OutInfo, OutError);
+    }
+    if (Extension == TEXT("ogg"))
+    {
+        OutInfo.Format = TEXT("ogg");
+        return ProbeOgg(*Reader, Bytes, OutInfo, OutError);
+    }
+    if (Extension == TEXT("flac"))
+    {
+        OutInfo.Format = TEXT("flac");
+        return ProbeFlac(Bytes, OutInfo, OutError);
+    }
+    if (Extension == TEXT("fbx"))
+    {
+        OutInfo.Format = TEXT("fbx");
+        return ProbeFbx(*Reader, Bytes, OutInfo, OutError);
+    }
+
+    OutError = TEXT("Unsupported extension");
+    return false;
+}
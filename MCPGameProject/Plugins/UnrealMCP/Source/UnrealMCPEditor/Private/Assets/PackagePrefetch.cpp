@@ -0,0 +1,196 @@
+#include "Assets/PackagePrefetch.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/PackageName.h"
+#include "Observability/MemoryPolicy.h"
+#include "Protocol/CommandContext.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+    constexpr const TCHAR* ErrorCodeCancelled = TEXT("CANCELLED");
+
+    const FName PrefetchStage(TEXT("prefetch"));
+
+    struct FPrefetchWait : public UnrealMCP::Protocol::FCommandContext::FResumeState
+    {
+        TSharedPtr<FPackagePrefetch> Prefetch;
+    };
+}
+
+FName FPackagePrefetch::ToPackageName(const FString& Path)
+{
+    // Export text ("StaticMesh'/Game/A.A'"), object and sub-object paths all name their package before the dot.
+    FString PackageName = FPackageName::ExportTextPathToObjectPath(Path.TrimStartAndEnd());
+    int32 DotIndex = INDEX_NONE;
+    if (PackageName.FindChar(TEXT('.'), DotIndex))
+    {
+        PackageName.LeftInline(DotIndex);
+    }
+    if (PackageName.StartsWith(TEXT("/Script/")) || !FPackageName::IsValidLongPackageName(PackageName))
+    {
+        return NAME_None;
+    }
+    return FName(*PackageName);
+}
+
+void FPackagePrefetch::Request(TConstArrayView<FString> Paths)
+{
+    for (const FString& Path : Paths)
+    {
+        const FName PackageName = ToPackageName(Path);
+        if (PackageName.IsNone() || PackageStates.Contains(PackageName))
+        {
+            continue;
+        }
+        if (FirstRequestSeconds == 0.0)
+        {
+            FirstRequestSeconds = FPlatformTime::Seconds();
+        }
+
+        const UPackage* Existing = FindObjectFast<UPackage>(nullptr, PackageName);
+        if (Existing && Existing->IsFullyLoaded())
+        {
+            PackageStates.Add(PackageName, EPackageState::Loaded);
+            ++NumAlreadyLoaded;
+            continue;
+        }
+        // A stat is far cheaper than a load the loader would fail, and keeps its warnings out of the log.
+        const FString PackageNameString = PackageName.ToString();
+        if (!FPackageName::DoesPackageExist(PackageNameString))
+        {
+            PackageStates.Add(PackageName, EPackageState::Failed);
+            ++NumFailed;
+            continue;
+        }
+
+        PackageStates.Add(PackageName, EPackageState::Pending);
+        ++NumPending;
+        TWeakPtr<FPackagePrefetch> WeakThis = AsShared();
+        const int32 RequestId = LoadPackageAsync(PackageNameString, FLoadPackageAsyncDelegate::CreateLambda(
+            [WeakThis, PackageName](const FName&, UPackage* Package, EAsyncLoadingResult::Type Result)
+            {
+                if (TSharedPtr<FPackagePrefetch> Prefetch = WeakThis.Pin())
+                {
+                    Prefetch->OnPackageLoaded(PackageName, Result == EAsyncLoadingResult::Succeeded ? Package : nullptr);
+                }
+            }));
+        // The loader may have finished (and called back) inside LoadPackageAsync.
+        if (RequestId != INDEX_NONE && PackageStates.FindChecked(PackageName) == EPackageState::Pending)
+        {
+            RequestIds.Add(PackageName, RequestId);
+        }
+    }
+}
+
+void FPackagePrefetch::OnPackageLoaded(FName PackageName, UPackage* Package)
+{
+    EPackageState* State = PackageStates.Find(PackageName);
+    if (!State || *State != EPackageState::Pending)
+    {
+        return;
+    }
+
+    const bool bSucceeded = Package != nullptr;
+    *State = bSucceeded ? EPackageState::Loaded : EPackageState::Failed;
+    ++(bSucceeded ? NumLoaded : NumFailed);
+    // Loaded between slices, so the memory policy would not see it otherwise.
+    FMemoryPolicy::NoteLoaded(Package);
+    --NumPending;
+    RequestIds.Remove(PackageName);
+    LastCompletionSeconds = FPlatformTime::Seconds();
+}
+
+bool FPackagePrefetch::IsReady(const FString& Path) const
+{
+    const EPackageState* State = PackageStates.Find(ToPackageName(Path));
+    return !State || *State != EPackageState::Pending;
+}
+
+void FPackagePrefetch::Flush()
+{
+    if (NumPending == 0)
+    {
+        return;
+    }
+
+    TArray<int32> PendingRequests;
+    RequestIds.GenerateValueArray(PendingRequests);
+    FlushAsyncLoading(PendingRequests);
+
+    // Anything the flush did not call back for is settled as failed; its handler loads it itself.
+    for (TPair<FName, EPackageState>& Pair : PackageStates)
+    {
+        if (Pair.Value == EPackageState::Pending)
+        {
+            Pair.Value = EPackageState::Failed;
+            ++NumFailed;
+        }
+    }
+    NumPending = 0;
+    RequestIds.Reset();
+    LastCompletionSeconds = FPlatformTime::Seconds();
+}
+
+TSharedPtr<FJsonObject> FPackagePrefetch::ToJson() const
+{
+    TSharedPtr<FJsonObject> Stats = MakeShared<FJsonObject>();
+    Stats->SetNumberField(TEXT("packages"), PackageStates.Num());
+    Stats->SetNumberField(TEXT("alreadyLoaded"), NumAlreadyLoaded);
+    Stats->SetNumberField(TEXT("loaded"), NumLoaded);
+    Stats->SetNumberField(TEXT("failed"), NumFailed);
+    const double ElapsedSeconds = LastCompletionSeconds > FirstRequestSeconds ? LastCompletionSeconds - FirstRequestSeconds : 0.0;
+    Stats->SetNumberField(TEXT("elapsedMs"), ElapsedSeconds * 1000.0);
+    return Stats;
+}
+
+bool FPackagePrefetch::Await(TConstArrayView<FString> Paths, TSharedPtr<FJsonObject>& OutResponse, TSharedPtr<FJsonObject>* OutStats)
+{
+    OutResponse.Reset();
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+    TSharedPtr<FPrefetchWait> Wait;
+    if (Context && Context->GetResumeStage() == PrefetchStage)
+    {
+        Wait = Context->TakeResumeState<FPrefetchWait>();
+    }
+    if (!Wait.IsValid())
+    {
+        Wait = MakeShared<FPrefetchWait>();
+        Wait->Stage = PrefetchStage;
+        Wait->Prefetch = MakeShared<FPackagePrefetch>();
+        Wait->Prefetch->Request(Paths);
+        if (!Context || !Context->CanSuspend())
+        {
+            // A batch entry has to finish inside its slice; the loads still overlap each other.
+            Wait->Prefetch->Flush();
+        }
+    }
+
+    FPackagePrefetch& Prefetch = *Wait->Prefetch;
+    if (Prefetch.GetNumPending() > 0)
+    {
+        // Nothing has been touched yet, so a cancelled request simply stops here.
+        if (Context->IsCancelled())
+        {
+            OutResponse = MakeShared<FJsonObject>();
+            OutResponse->SetBoolField(TEXT("success"), false);
+            OutResponse->SetStringField(TEXT("errorCode"), ErrorCodeCancelled);
+            OutResponse->SetStringField(TEXT("error"), TEXT("Cancelled while loading packages"));
+            return false;
+        }
+
+        const int32 Requested = Prefetch.GetNumRequested();
+        Context->ReportProgress(Requested - Prefetch.GetNumPending(), Requested, TEXT("loading"));
+        Context->Suspend(Wait.ToSharedRef());
+        return false;
+    }
+
+    if (OutStats)
+    {
+        *OutStats = Prefetch.ToJson();
+    }
+    return true;
+}
@@ -0,0 +1,205 @@
+#include "Assets/PackageSaver.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Permissions/WriteGate.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+namespace
+{
+    bool IsUnderRoot(const FString& PackageName, const FString& Root)
+    {
+        return PackageName.Equals(Root, ESearchCase::IgnoreCase)
+            || (PackageName.StartsWith(Root, ESearchCase::IgnoreCase) && PackageName.Len() > Root.Len() && PackageName[Root.Len()] == TCHAR('/'));
+    }
+}
+
+void FPackageSaver::CollectDirtyPackages(const TArray<FString>& Roots, TArray<UPackage*>& OutPackages)
+{
+    TArray<FString> NormalizedRoots;
+    for (const FString& Root : Roots)
+    {
+        FString Normalized = Root;
+        Normalized.TrimStartAndEndInline();
+        while (Normalized.Len() > 1 && Normalized.EndsWith(TEXT("/")))
+        {
+            Normalized.LeftChopInline(1);
+        }
+        if (!Normalized.IsEmpty())
+        {
+            NormalizedRoots.Add(MoveTemp(Normalized));
+        }
+    }
+
+    TArray<UPackage*> DirtyPackages;
+    FEditorFileUtils::GetDirtyContentPackages(DirtyPackages);
+    FEditorFileUtils::GetDirtyWorldPackages(DirtyPackages);
+
+    TSet<UPackage*> Seen;
+    for (UPackage* Package : DirtyPackages)
+    {
+        bool bAlreadySeen = false;
+        Seen.Add(Package, &bAlreadySeen);
+        if (!Package || bAlreadySeen || Package->HasAnyPackageFlags(PKG_CompiledIn | PKG_InMemoryOnly))
+        {
+            continue;
+        }
+
+        const FString PackageName = Package->GetName();
+        if (!FPackageName::IsValidLongPackageName(PackageName))
+        {
+            continue;
+        }
+
+        if (NormalizedRoots.Num() > 0 && !NormalizedRoots.ContainsByPredicate([&PackageName](const FString& Root) { return IsUnderRoot(PackageName, Root); }))
+        {
+            continue;
+        }
+
+        FString Reason;
+        if (FWriteGate::IsPathAllowed(PackageName, Reason))
+        {
+            OutPackages.Add(Package);
+        }
+    }
+}
+
+bool FPackageSaver::SavePackages(const TArray<UPackage*>& Packages, TArray<FResult>& OutResults, TSharedPtr<FJsonObject>& OutError, bool bConcurrent)
+{
+    TArray<FString> PackageNames;
+    PackageNames.Reserve(Packages.Num());
+    for (const UPackage* Package : Packages)
+    {
+        if (Package)
+        {
+            PackageNames.Add(Package->GetName());
+        }
+    }
+    if (!FWriteGate::EnsureCheckoutForContentPaths(PackageNames, OutError))
+    {
+        return false;
+    }
+
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Standalone;
+    SaveArgs.bSlowTask = false;
+
+    TArray<FPackageSaveInfo> ConcurrentSaves;
+    TArray<int32> ConcurrentResults;
+    TArray<UPackage*> EmptyPackages;
+    TArray<int32> EmptyResults;
+    OutResults.Reserve(OutResults.Num() + Packages.Num());
+    for (UPackage* Package : Packages)
+    {
+        if (!Package)
+        {
+            continue;
+        }
+
+        const int32 ResultIndex = OutResults.AddDefaulted();
+        FResult& Result = OutResults[ResultIndex];
+        Result.PackageName = Package->GetName();
+
+        const FString& Extension = Package->ContainsMap() ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension();
+        FString Filename;
+        if (!FPackageName::TryConvertLongPackageNameToFilename(Result.PackageName, Filename, Extension))
+        {
+            Result.Error = TEXT("No file for package");
+            continue;
+        }
+
+        if (IFileManager::Get().FileExists(*Filename) && IFileManager::Get().IsReadOnly(*Filename))
+        {
+            Result.Error = TEXT("File is read-only");
+            continue;
+        }
+
+        // A deleted actor leaves its external package empty; saving it means deleting its file.
+        if (UPackage::IsEmptyPackage(Package))
+        {
+            EmptyPackages.Add(Package);
+            EmptyResults.Add(ResultIndex);
+            continue;
+        }
+
+        UObject* Asset = Package->FindAssetInPackage();
+        if (bConcurrent && !Package->ContainsMap())
+        {
+            FPackageSaveInfo& SaveInfo = ConcurrentSaves.AddDefaulted_GetRef();
+            SaveInfo.Package = Package;
+            SaveInfo.Asset = Asset;
+            SaveInfo.Filename = Filename;
+            ConcurrentResults.Add(ResultIndex);
+            continue;
+        }
+
+        // Serialization stays on the game thread; SAVE_Async only hands the finished bytes to the
+        // async writer, which is drained once below.
+        SaveArgs.SaveFlags = SAVE_NoError | SAVE_Async;
+        const FSavePackageResultStruct SaveResult = UPackage::Save(Package, Asset, *Filename, SaveArgs);
+        Result.bSaved = SaveResult.IsSuccessful();
+        if (!Result.bSaved)
+        {
+            Result.Error = TEXT("Save failed");
+        }
+    }
+
+    if (ConcurrentSaves.Num() > 0)
+    {
+        // Harvesting runs here; serialization and writes are spread over the task graph.
+        SaveArgs.SaveFlags = SAVE_NoError;
+        TArray<FSavePackageResultStruct> SaveResults;
+        UPackage::SaveConcurrent(ConcurrentSaves, SaveArgs, SaveResults);
+        for (int32 Index = 0; Index < ConcurrentResults.Num(); ++Index)
+        {
+            FResult& Result = OutResults[ConcurrentResults[Index]];
+            Result.bSaved = SaveResults.IsValidIndex(Index) && SaveResults[Index].IsSuccessful();
+            if (!Result.bSaved)
+            {
+                Result.Error = TEXT("Save failed");
+            }
+        }
+    }
+
+    if (EmptyPackages.Num() > 0)
+    {
+        // The editor's save deletes the files and marks them for delete in source control.
+        TArray<UPackage*> FailedPackages;
+        FEditorFileUtils::PromptForCheckoutAndSave(EmptyPackages, /*bCheckDirty=*/false, /*bPromptToSave=*/false, &FailedPackages, /*bAlreadyCheckedOut=*/true);
+        for (int32 Index = 0; Index < EmptyResults.Num(); ++Index)
+        {
+            FResult& Result = OutResults[EmptyResults[Index]];
+            Result.bSaved = !FailedPackages.Contains(EmptyPackages[Index]);
+            if (!Result.bSaved)
+            {
+                Result.Error = TEXT("Delete failed");
+            }
+        }
+    }
+
+    UPackage::WaitForAsyncFileWrites();
+    return true;
+}
+
+TArray<TSharedPtr<FJsonValue>> FPackageSaver::ResultsToJson(const TArray<FResult>& Results)
+{
+    TArray<TSharedPtr<FJsonValue>> Json;
+    Json.Reserve(Results.Num());
+    for (const FResult& Result : Results)
+    {
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("package"), Result.PackageName);
+        Entry->SetBoolField(TEXT("saved"), Result.bSaved);
+        if (!Result.Error.IsEmpty())
+        {
+            Entry->SetStringField(TEXT("error"), Result.Error);
+        }
+        Json.Add(MakeShared<FJsonValueObject>(Entry));
+    }
+    return Json;
+}
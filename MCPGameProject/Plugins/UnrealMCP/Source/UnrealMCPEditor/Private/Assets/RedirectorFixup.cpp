@@ -0,0 +1,328 @@
+#include "Assets/RedirectorFixup.h"
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetToolsModule.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+#include "Observability/MemoryPolicy.h"
+#include "Permissions/WriteGate.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/UObjectGlobals.h"
+
+void FRedirectorFixup::PlanBatches(IAssetRegistry& AssetRegistry, const TArray<FAssetData>& Redirectors, int32 MaxReferencers, TArray<FBatch>& OutBatches)
+{
+    MaxReferencers = FMath::Max(MaxReferencers, 1);
+
+    // Referencer -> the redirectors it references, walked in name order so packages of one
+    // folder, which tend to reference the same things, end up in the same batch.
+    TArray<TArray<FName>> ReferencersByRedirector;
+    TMap<FName, TArray<int32>> RedirectorsByReferencer;
+    ReferencersByRedirector.SetNum(Redirectors.Num());
+    TArray<int32> Unreferenced;
+    for (int32 Index = 0; Index < Redirectors.Num(); ++Index)
+    {
+        AssetRegistry.GetReferencers(Redirectors[Index].PackageName, ReferencersByRedirector[Index], UE::AssetRegistry::EDependencyCategory::Package);
+        ReferencersByRedirector[Index].Remove(Redirectors[Index].PackageName);
+        if (ReferencersByRedirector[Index].Num() == 0)
+        {
+            Unreferenced.Add(Index);
+        }
+        for (const FName& Referencer : ReferencersByRedirector[Index])
+        {
+            RedirectorsByReferencer.FindOrAdd(Referencer).Add(Index);
+        }
+    }
+    RedirectorsByReferencer.KeySort([](const FName& A, const FName& B) { return A.LexicalLess(B); });
+
+    TBitArray<> Assigned(false, Redirectors.Num());
+    FBatch Current;
+    TSet<FName> CurrentReferencers;
+    auto Flush = [&OutBatches, &Current, &CurrentReferencers]()
+    {
+        if (Current.Redirectors.Num() > 0)
+        {
+            Current.Referencers = CurrentReferencers.Array();
+            OutBatches.Add(MoveTemp(Current));
+        }
+        Current = FBatch();
+        CurrentReferencers.Reset();
+    };
+
+    for (const TPair<FName, TArray<int32>>& Pair : RedirectorsByReferencer)
+    {
+        for (const int32 Index : Pair.Value)
+        {
+            if (Assigned[Index])
+            {
+                continue;
+            }
+
+            int32 Added = 0;
+            for (const FName& Referencer : ReferencersByRedirector[Index])
+            {
+                Added += CurrentReferencers.Contains(Referencer) ? 0 : 1;
+            }
+            if (Current.Redirectors.Num() > 0
+                && (CurrentReferencers.Num() + Added > MaxReferencers || Current.Redirectors.Num() >= MaxRedirectorsPerBatch))
+            {
+                Flush();
+            }
+
+            Assigned[Index] = true;
+            Current.Redirectors.Add(Redirectors[Index].GetSoftObjectPath());
+            CurrentReferencers.Append(ReferencersByRedirector[Index]);
+        }
+    }
+    Flush();
+
+    // Unreferenced redirectors load nothing else; they only need deleting.
+    for (const int32 Index : Unreferenced)
+    {
+        if (Current.Redirectors.Num() >= MaxRedirectorsPerBatch)
+        {
+            Flush();
+        }
+        Current.Redirectors.Add(Redirectors[Index].GetSoftObjectPath());
+    }
+    Flush();
+}
+
+void FRedirectorFixup::PlanGroupedBatches(IAssetRegistry& AssetRegistry, const TArray<FAssetData>& Redirectors, int32 MaxReferencers, TArray<FBatch>& OutBatches, int32& OutGroups)
+{
+    MaxReferencers = FMath::Max(MaxReferencers, 1);
+    const int32 Count = Redirectors.Num();
+    OutGroups = 0;
+
+    TArray<TArray<FName>> ReferencersByRedirector;
+    ReferencersByRedirector.SetNum(Count);
+    ParallelFor(Count, [&AssetRegistry, &Redirectors, &ReferencersByRedirector](int32 Index)
+    {
+        AssetRegistry.GetReferencers(Redirectors[Index].PackageName, ReferencersByRedirector[Index], UE::AssetRegistry::EDependencyCategory::Package);
+        ReferencersByRedirector[Index].Remove(Redirectors[Index].PackageName);
+    });
+
+    TMap<FName, int32> IndexByPackage;
+    IndexByPackage.Reserve(Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        IndexByPackage.Add(Redirectors[Index].PackageName, Index);
+    }
+
+    // Union-find: the group of a redirector is the lowest index reachable by shared referencers or chains.
+    TArray<int32> Parent;
+    Parent.SetNumUninitialized(Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        Parent[Index] = Index;
+    }
+    auto Find = [&Parent](int32 Index)
+    {
+        while (Parent[Index] != Index)
+        {
+            Parent[Index] = Parent[Parent[Index]];
+            Index = Parent[Index];
+        }
+        return Index;
+    };
+    auto Union = [&Parent, &Find](int32 A, int32 B)
+    {
+        A = Find(A);
+        B = Find(B);
+        if (A != B)
+        {
+            Parent[FMath::Max(A, B)] = FMath::Min(A, B);
+        }
+    };
+
+    // The next redirector along each chain, or INDEX_NONE where the chain reaches a real asset.
+    TArray<int32> Next;
+    Next.Init(INDEX_NONE, Count);
+    TMap<FName, int32> FirstByReferencer;
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        const FString Destination = GetDestination(Redirectors[Index]);
+        if (!Destination.IsEmpty())
+        {
+            const int32* Target = IndexByPackage.Find(FName(*FPackageName::ObjectPathToPackageName(Destination)));
+            if (Target && *Target != Index)
+            {
+                Next[Index] = *Target;
+                Union(Index, *Target);
+            }
+        }
+        for (const FName& Referencer : ReferencersByRedirector[Index])
+        {
+            if (const int32* Other = FirstByReferencer.Find(Referencer))
+            {
+                Union(Index, *Other);
+            }
+            else
+            {
+                FirstByReferencer.Add(Referencer, Index);
+            }
+        }
+    }
+
+    // Hops to the end of the chain; a cycle stops after Count hops.
+    TArray<int32> Depth;
+    Depth.SetNumZeroed(Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        for (int32 Hop = Next[Index]; Hop != INDEX_NONE && Depth[Index] < Count; Hop = Next[Hop])
+        {
+            ++Depth[Index];
+        }
+    }
+
+    TMap<int32, TArray<int32>> Groups;
+    TArray<int32> Unreferenced;
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        Groups.FindOrAdd(Find(Index)).Add(Index);
+    }
+    TArray<TArray<int32>> Ordered;
+    for (TPair<int32, TArray<int32>>& Pair : Groups)
+    {
+        // Alone in its group and referenced by nothing: there is nothing to load, only the redirector to delete.
+        if (Pair.Value.Num() == 1 && ReferencersByRedirector[Pair.Value[0]].Num() == 0)
+        {
+            Unreferenced.Add(Pair.Value[0]);
+            continue;
+        }
+        // A redirector is fixed after the one it redirects to, so its own fixup already sees the end of the chain.
+        Pair.Value.Sort([&Depth, &Redirectors](int32 A, int32 B)
+        {
+            return Depth[A] != Depth[B] ? Depth[A] < Depth[B] : Redirectors[A].PackageName.LexicalLess(Redirectors[B].PackageName);
+        });
+        Ordered.Add(MoveTemp(Pair.Value));
+    }
+    // Groups of one folder tend to reference the same things, so neighbours share a batch.
+    Ordered.Sort([&Redirectors](const TArray<int32>& A, const TArray<int32>& B)
+    {
+        return Redirectors[A[0]].PackageName.LexicalLess(Redirectors[B[0]].PackageName);
+    });
+    OutGroups = Ordered.Num();
+
+    FBatch Current;
+    TSet<FName> CurrentReferencers;
+    auto Flush = [&OutBatches, &Current, &CurrentReferencers]()
+    {
+        if (Current.Redirectors.Num() > 0)
+        {
+            Current.Referencers = CurrentReferencers.Array();
+            OutBatches.Add(MoveTemp(Current));
+        }
+        Current = FBatch();
+        CurrentReferencers.Reset();
+    };
+    auto CountAdded = [&CurrentReferencers, &ReferencersByRedirector](const TArray<int32>& Members)
+    {
+        TSet<FName> Added;
+        for (const int32 Index : Members)
+        {
+            for (const FName& Referencer : ReferencersByRedirector[Index])
+            {
+                if (!CurrentReferencers.Contains(Referencer))
+                {
+                    Added.Add(Referencer);
+                }
+            }
+        }
+        return Added.Num();
+    };
+
+    for (const TArray<int32>& Group : Ordered)
+    {
+        if (Current.Redirectors.Num() > 0
+            && (CurrentReferencers.Num() + CountAdded(Group) > MaxReferencers || Current.Redirectors.Num() + Group.Num() > MaxRedirectorsPerBatch))
+        {
+            Flush();
+        }
+        for (const int32 Index : Group)
+        {
+            if (Current.Redirectors.Num() > 0
+                && (CurrentReferencers.Num() + CountAdded({ Index }) > MaxReferencers || Current.Redirectors.Num() >= MaxRedirectorsPerBatch))
+            {
+                Flush();
+            }
+            Current.Redirectors.Add(Redirectors[Index].GetSoftObjectPath());
+            CurrentReferencers.Append(ReferencersByRedirector[Index]);
+        }
+    }
+    Flush();
+
+    for (const int32 Index : Unreferenced)
+    {
+        if (Current.Redirectors.Num() >= MaxRedirectorsPerBatch)
+        {
+            Flush();
+        }
+        Current.Redirectors.Add(Redirectors[Index].GetSoftObjectPath());
+    }
+    Flush();
+}
+
+bool FRedirectorFixup::FixBatch(const FBatch& Batch, TArray<FString>& OutFixed, TSharedPtr<FJsonObject>& OutError)
+{
+    TArray<FString> CheckoutPaths;
+    CheckoutPaths.Reserve(Batch.Referencers.Num() + Batch.Redirectors.Num());
+    for (const FName& Referencer : Batch.Referencers)
+    {
+        CheckoutPaths.Add(Referencer.ToString());
+    }
+    for (const FSoftObjectPath& Redirector : Batch.Redirectors)
+    {
+        CheckoutPaths.Add(Redirector.GetLongPackageName());
+    }
+    if (!FWriteGate::EnsureCheckoutForContentPaths(CheckoutPaths, OutError))
+    {
+        return false;
+    }
+
+    TArray<UObjectRedirector*> Loaded;
+    Loaded.Reserve(Batch.Redirectors.Num());
+    for (const FSoftObjectPath& Path : Batch.Redirectors)
+    {
+        if (UObjectRedirector* Redirector = Cast<UObjectRedirector>(Path.TryLoad()))
+        {
+            Loaded.Add(Redirector);
+            OutFixed.Add(Redirector->GetPathName());
+        }
+    }
+    if (Loaded.Num() == 0)
+    {
+        return true;
+    }
+
+    // Checked out above, so the provider need not prompt.
+    FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+    AssetToolsModule.Get().FixupReferencers(Loaded, /*bCheckoutDialogPrompt*/ false);
+    return true;
+}
+
+FString FRedirectorFixup::GetDestination(const FAssetData& Redirector)
+{
+    // The tag holds the destination's full name, "Class /Path/Package.Object".
+    FString FullName;
+    if (!Redirector.GetTagValue(TEXT("DestinationObject"), FullName))
+    {
+        return FString();
+    }
+    FString Class;
+    FString ObjectPath;
+    return FullName.Split(TEXT(" "), &Class, &ObjectPath) ? ObjectPath : FullName;
+}
+
+bool FRedirectorFixup::CollectGarbageOverCeiling(int64 StartUsedBytes, int64 CeilingBytes)
+{
+    const int64 UsedBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+    if (CeilingBytes <= 0 || UsedBytes - StartUsedBytes <= CeilingBytes)
+    {
+        return false;
+    }
+    return FMemoryPolicy::Collect(TEXT("chunk"), false, true);
+}
@@ -0,0 +1,443 @@
+#include "Commandlets/UnrealMCPAssetBenchmarkCommandlet.h"
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/AssetRegistryState.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Assets/AssetQuery.h"
+#include "Content/ContentTools.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UnrealMCPLog.h"
+#include "UnrealMCPSettings.h"
+
+namespace
+{
+    const TCHAR* const SyntheticRoot = TEXT("/Game/MCPBench");
+
+    /** Synthetic folder tree: Areas x Groups x Leaves folders, assets spread evenly over the leaves. */
+    constexpr int32 AreaCount = 10;
+    constexpr int32 GroupCount = 10;
+    constexpr int32 LeafCount = 10;
+
+    /** Share of soft references that point at a package that does not exist, as content.scan's brokenRefs. */
+    constexpr float BrokenReferenceRate = 0.01f;
+
+    struct FSyntheticClass
+    {
+        const TCHAR* ClassName;
+        const TCHAR* Prefix;
+        int32 Weight;
+    };
+
+    // Roughly the class mix of a large content project.
+    const FSyntheticClass SyntheticClasses[] = {
+        { TEXT("StaticMesh"), TEXT("SM_"), 40 },
+        { TEXT("Texture2D"), TEXT("T_"), 30 },
+        { TEXT("MaterialInstanceConstant"), TEXT("MI_"), 15 },
+        { TEXT("Blueprint"), TEXT("BP_"), 10 },
+        { TEXT("SoundWave"), TEXT("SW_"), 5 },
+    };
+
+    FString MakeFolder(int32 AssetIndex)
+    {
+        const int32 Leaf = AssetIndex % (AreaCount * GroupCount * LeafCount);
+        return FString::Printf(TEXT("%s/Area%d/Group%d/Leaf%d"), SyntheticRoot, Leaf / (GroupCount * LeafCount), (Leaf / LeafCount) % GroupCount, Leaf % LeafCount);
+    }
+
+    const FSyntheticClass& PickClass(int32 AssetIndex)
+    {
+        // Deterministic per index so soft references can name their target's class and path.
+        int32 TotalWeight = 0;
+        for (const FSyntheticClass& Class : SyntheticClasses)
+        {
+            TotalWeight += Class.Weight;
+        }
+
+        int32 Bucket = static_cast<int32>((static_cast<uint32>(AssetIndex) * 2654435761u) % static_cast<uint32>(TotalWeight));
+        for (const FSyntheticClass& Class : SyntheticClasses)
+        {
+            if (Bucket < Class.Weight)
+            {
+                return Class;
+            }
+            Bucket -= Class.Weight;
+        }
+        return SyntheticClasses[0];
+    }
+
+    FString MakeAssetName(int32 AssetIndex)
+    {
+        return FString::Printf(TEXT("%sAsset_%06d"), PickClass(AssetIndex).Prefix, AssetIndex);
+    }
+
+    FString MakeObjectPath(int32 AssetIndex)
+    {
+        const FString AssetName = MakeAssetName(AssetIndex);
+        return FString::Printf(TEXT("%s/%s.%s"), *MakeFolder(AssetIndex), *AssetName, *AssetName);
+    }
+
+    /** A soft reference to another synthetic asset, or now and then to one that was never created. */
+    FString MakeSoftReference(FRandomStream& Random, int32 AssetCount)
+    {
+        if (Random.FRand() < BrokenReferenceRate)
+        {
+            const int32 Missing = Random.RandRange(0, 999999);
+            return FString::Printf(TEXT("%s/Missing/M_Missing_%06d.M_Missing_%06d"), SyntheticRoot, Missing, Missing);
+        }
+        return MakeObjectPath(Random.RandRange(0, AssetCount - 1));
+    }
+
+    FAssetDataTagMap MakeTags(const FSyntheticClass& Class, FRandomStream& Random, int32 AssetCount)
+    {
+        FAssetDataTagMap Tags;
+        const FString ClassName = Class.ClassName;
+        if (ClassName == TEXT("StaticMesh"))
+        {
+            Tags.Add(TEXT("Triangles"), FString::FromInt(Random.RandRange(12, 250000)));
+            Tags.Add(TEXT("Vertices"), FString::FromInt(Random.RandRange(24, 180000)));
+            Tags.Add(TEXT("LODs"), FString::FromInt(Random.RandRange(1, 6)));
+            Tags.Add(TEXT("CollisionPrims"), FString::FromInt(Random.RandRange(0, 12)));
+            Tags.Add(TEXT("Materials"), FString::FromInt(Random.RandRange(1, 8)));
+            Tags.Add(TEXT("ApproxSize"), FString::Printf(TEXT("%dx%dx%d"), Random.RandRange(10, 5000), Random.RandRange(10, 5000), Random.RandRange(10, 2000)));
+            Tags.Add(TEXT("DefaultMaterial"), MakeSoftReference(Random, AssetCount));
+        }
+        else if (ClassName == TEXT("Texture2D"))
+        {
+            const int32 Size = 1 << Random.RandRange(6, 12);
+            Tags.Add(TEXT("Dimensions"), FString::Printf(TEXT("%dx%d"), Size, Size));
+            Tags.Add(TEXT("Format"), Random.RandRange(0, 2) == 0 ? TEXT("PF_BC5") : TEXT("PF_DXT5"));
+            Tags.Add(TEXT("LODGroup"), TEXT("TEXTUREGROUP_World"));
+            Tags.Add(TEXT("SRGB"), Random.RandRange(0, 1) ? TEXT("True") : TEXT("False"));
+            Tags.Add(TEXT("HasAlphaChannel"), Random.RandRange(0, 3) == 0 ? TEXT("True") : TEXT("False"));
+        }
+        else if (ClassName == TEXT("MaterialInstanceConstant"))
+        {
+            Tags.Add(TEXT("Parent"), MakeSoftReference(Random, AssetCount));
+            Tags.Add(TEXT("PhysMaterial"), MakeSoftReference(Random, AssetCount));
+            Tags.Add(TEXT("ScalarParameters"), FString::FromInt(Random.RandRange(0, 24)));
+            Tags.Add(TEXT("TextureParameters"), FString::FromInt(Random.RandRange(0, 12)));
+        }
+        else if (ClassName == TEXT("Blueprint"))
+        {
+            const int32 GeneratedIndex = Random.RandRange(0, 99999);
+            Tags.Add(TEXT("ParentClass"), TEXT("/Script/CoreUObject.Class'/Script/Engine.Actor'"));
+            Tags.Add(TEXT("NativeParentClass"), TEXT("/Script/CoreUObject.Class'/Script/Engine.Actor'"));
+            Tags.Add(TEXT("GeneratedClass"), FString::Printf(TEXT("/Script/Engine.BlueprintGeneratedClass'BP_Generated_%d_C'"), GeneratedIndex));
+            Tags.Add(TEXT("BlueprintType"), TEXT("BPTYPE_Normal"));
+            Tags.Add(TEXT("NumReplicatedProperties"), FString::FromInt(Random.RandRange(0, 20)));
+            Tags.Add(TEXT("SpawnMesh"), MakeSoftReference(Random, AssetCount));
+            Tags.Add(TEXT("SpawnSound"), MakeSoftReference(Random, AssetCount));
+        }
+        else
+        {
+            Tags.Add(TEXT("Duration"), FString::SanitizeFloat(Random.FRandRange(0.1f, 180.0f)));
+            Tags.Add(TEXT("SampleRate"), Random.RandRange(0, 1) ? TEXT("48000") : TEXT("44100"));
+            Tags.Add(TEXT("Channels"), FString::FromInt(Random.RandRange(1, 2)));
+        }
+        return Tags;
+    }
+
+    void AppendSyntheticAssets(IAssetRegistry& AssetRegistry, int32 AssetCount, int32 Seed)
+    {
+        FRandomStream Random(Seed);
+        FAssetRegistryState State;
+        for (int32 AssetIndex = 0; AssetIndex < AssetCount; ++AssetIndex)
+        {
+            const FSyntheticClass& Class = PickClass(AssetIndex);
+            const FString Folder = MakeFolder(AssetIndex);
+            const FString AssetName = MakeAssetName(AssetIndex);
+            // The state owns the asset data once added.
+            State.AddAssetData(new FAssetData(
+                FName(*(Folder / AssetName)),
+                FName(*Folder),
+                FName(*AssetName),
+                FTopLevelAssetPath(TEXT("/Script/Engine"), Class.ClassName),
+                MakeTags(Class, Random, AssetCount)));
+        }
+        AssetRegistry.AppendState(State);
+    }
+
+    /** Root, then the first sub folder at each level below it: the path sizes content.scan is timed over. */
+    TArray<FString> MakePathLadder(IAssetRegistry& AssetRegistry, const FString& Root)
+    {
+        TArray<FString> Ladder;
+        Ladder.Add(Root);
+        for (int32 Depth = 0; Depth < 3; ++Depth)
+        {
+            TArray<FString> SubPaths;
+            AssetRegistry.GetSubPaths(Ladder.Last(), SubPaths, false);
+            if (SubPaths.Num() == 0)
+            {
+                break;
+            }
+            SubPaths.Sort();
+            Ladder.Add(SubPaths[0]);
+        }
+        return Ladder;
+    }
+
+    struct FCaseTiming
+    {
+        FString Name;
+        TArray<double> SamplesMs;
+        int64 Total = 0;
+        int64 Returned = 0;
+        FString Error;
+    };
+
+    TSharedRef<FJsonObject> TimingToJson(FCaseTiming& Timing)
+    {
+        Timing.SamplesMs.Sort();
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+        Json->SetStringField(TEXT("name"), Timing.Name);
+        Json->SetNumberField(TEXT("iterations"), Timing.SamplesMs.Num());
+        Json->SetNumberField(TEXT("total"), static_cast<double>(Timing.Total));
+        Json->SetNumberField(TEXT("returned"), static_cast<double>(Timing.Returned));
+        if (Timing.SamplesMs.Num() > 0)
+        {
+            Json->SetNumberField(TEXT("minMs"), Timing.SamplesMs[0]);
+            Json->SetNumberField(TEXT("medianMs"), Timing.SamplesMs[Timing.SamplesMs.Num() / 2]);
+            Json->SetNumberField(TEXT("maxMs"), Timing.SamplesMs.Last());
+        }
+        if (!Timing.Error.IsEmpty())
+        {
+            Json->SetStringField(TEXT("error"), Timing.Error);
+        }
+        return Json;
+    }
+
+    FCaseTiming TimeFind(const FString& Name, const FAssetFindParams& Params, int32 Iterations)
+    {
+        FCaseTiming Timing;
+        Timing.Name = Name;
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            int32 Total = 0;
+            TArray<FAssetLite> Items;
+            const double Start = FPlatformTime::Seconds();
+            if (!FAssetQuery::Find(Params, Total, Items, Timing.Error))
+            {
+                break;
+            }
+            Timing.SamplesMs.Add((FPlatformTime::Seconds() - Start) * 1000.0);
+            Timing.Total = Total;
+            Timing.Returned = Items.Num();
+        }
+        return Timing;
+    }
+
+    FCaseTiming TimeContentCommand(FContentTools& ContentTools, const FString& Name, const FString& Command, const TSharedPtr<FJsonObject>& Params, const TCHAR* CountField, int32 Iterations)
+    {
+        FCaseTiming Timing;
+        Timing.Name = Name;
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            const double Start = FPlatformTime::Seconds();
+            const TSharedPtr<FJsonObject> Response = ContentTools.HandleCommand(Command, Params);
+            const double ElapsedMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+            const TSharedPtr<FJsonObject>* Data = nullptr;
+            if (!Response.IsValid() || !Response->TryGetObjectField(TEXT("data"), Data))
+            {
+                if (!Response.IsValid() || !Response->TryGetStringField(TEXT("error"), Timing.Error))
+                {
+                    Timing.Error = FString::Printf(TEXT("%s returned no data"), *Command);
+                }
+                break;
+            }
+            Timing.SamplesMs.Add(ElapsedMs);
+
+            const TSharedPtr<FJsonObject>* Counts = nullptr;
+            if ((*Data)->TryGetObjectField(CountField, Counts))
+            {
+                double Value = 0.0;
+                if ((*Counts)->TryGetNumberField(TEXT("assets"), Value) || (*Counts)->TryGetNumberField(TEXT("violations"), Value))
+                {
+                    Timing.Total = static_cast<int64>(Value);
+                }
+            }
+        }
+        return Timing;
+    }
+
+    TSharedPtr<FJsonObject> MakePathsParams(const FString& Path)
+    {
+        TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+        TArray<TSharedPtr<FJsonValue>> Paths;
+        Paths.Add(MakeShared<FJsonValueString>(Path));
+        Params->SetArrayField(TEXT("paths"), Paths);
+        return Params;
+    }
+}
+
+UUnrealMCPAssetBenchmarkCommandlet::UUnrealMCPAssetBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UUnrealMCPAssetBenchmarkCommandlet::Main(const FString& Params)
+{
+    int32 AssetCount = 200000;
+    int32 Seed = 1;
+    int32 Iterations = 3;
+    FString RegistryPath;
+    FString Root;
+    FString OutputPath;
+    FParse::Value(*Params, TEXT("Assets="), AssetCount);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    FParse::Value(*Params, TEXT("Registry="), RegistryPath);
+    FParse::Value(*Params, TEXT("Root="), Root);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    AssetCount = FMath::Clamp(AssetCount, 1, 2000000);
+    Iterations = FMath::Clamp(Iterations, 1, 100);
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetRegistry.SearchAllAssets(true);
+
+    const double BuildStart = FPlatformTime::Seconds();
+    const uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+    if (!RegistryPath.IsEmpty())
+    {
+        FAssetRegistryState State;
+        if (!FAssetRegistryState::LoadFromDisk(*RegistryPath, FAssetRegistryLoadOptions(), State))
+        {
+            UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPAssetBenchmark: cannot load asset registry %s"), *RegistryPath);
+            return 1;
+        }
+        AssetCount = State.GetNumAssets();
+        AssetRegistry.AppendState(State);
+        if (Root.IsEmpty())
+        {
+            Root = TEXT("/Game");
+        }
+    }
+    else
+    {
+        AppendSyntheticAssets(AssetRegistry, AssetCount, Seed);
+        if (Root.IsEmpty())
+        {
+            Root = SyntheticRoot;
+        }
+    }
+    const double BuildSeconds = FPlatformTime::Seconds() - BuildStart;
+    const int64 RegistryGrowthBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(UsedBefore);
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPAssetBenchmark: %d assets %s in %.1f s (+%.0f MiB), timing under %s"),
+        AssetCount, RegistryPath.IsEmpty() ? TEXT("synthesized") : TEXT("mounted"), BuildSeconds, RegistryGrowthBytes / (1024.0 * 1024.0), *Root);
+
+    const TArray<FString> Ladder = MakePathLadder(AssetRegistry, Root);
+    TArray<FCaseTiming> Timings;
+
+    // asset.find: filter, sort and paging combinations. Find only orders matches up to the end of the
+    // requested page, so a deep page costs more than the first one.
+    struct FFindCase
+    {
+        const TCHAR* Name;
+        TFunction<void(FAssetFindParams&)> Configure;
+    };
+    const FFindCase FindCases[] = {
+        { TEXT("root.name.page0"), [](FAssetFindParams&) {} },
+        { TEXT("root.name.desc"), [](FAssetFindParams& P) { P.bSortAscending = false; } },
+        { TEXT("root.class.page0"), [](FAssetFindParams& P) { P.SortBy = FAssetFindParams::ESortBy::Class; } },
+        { TEXT("root.path.page0"), [](FAssetFindParams& P) { P.SortBy = FAssetFindParams::ESortBy::Path; } },
+        { TEXT("root.name.deepPage"), [](FAssetFindParams& P) { P.Offset = 100000; } },
+        { TEXT("root.name.limit1000"), [](FAssetFindParams& P) { P.Limit = 1000; } },
+        { TEXT("class.StaticMesh"), [](FAssetFindParams& P) { P.ClassNames.Add(TEXT("StaticMesh")); } },
+        { TEXT("class.Texture2D.path"), [](FAssetFindParams& P) { P.ClassNames.Add(TEXT("Texture2D")); P.SortBy = FAssetFindParams::ESortBy::Path; } },
+        { TEXT("nameContains"), [](FAssetFindParams& P) { P.NameContains = FString(TEXT("_0012")); } },
+        { TEXT("tag.LODs"), [](FAssetFindParams& P) { P.TagQuery.Add(TEXT("LODs"), { FString(TEXT("4")) }); } },
+        { TEXT("class+tag+name"), [](FAssetFindParams& P) { P.ClassNames.Add(TEXT("StaticMesh")); P.TagQuery.Add(TEXT("LODs"), { FString(TEXT("2")) }); P.NameContains = FString(TEXT("9")); } },
+        { TEXT("nonRecursive"), [](FAssetFindParams& P) { P.bRecursive = false; } },
+        { TEXT("page1000.allFields"), [](FAssetFindParams& P) { P.Limit = 1000; } },
+        { TEXT("page1000.pathClass"), [](FAssetFindParams& P) { P.Limit = 1000; P.Fields.bPackagePath = false; P.Fields.bAssetName = false; P.Fields.bAllTags = false; } },
+    };
+    for (const FFindCase& Case : FindCases)
+    {
+        FAssetFindParams FindParams;
+        FindParams.Paths.Add(Root);
+        Case.Configure(FindParams);
+        Timings.Add(TimeFind(FString::Printf(TEXT("asset.find.%s"), Case.Name), FindParams, Iterations));
+    }
+    for (int32 Level = 1; Level < Ladder.Num(); ++Level)
+    {
+        FAssetFindParams FindParams;
+        FindParams.Paths.Add(Ladder[Level]);
+        Timings.Add(TimeFind(FString::Printf(TEXT("asset.find.subtree%d"), Level), FindParams, Iterations));
+    }
+
+    // content.scan and content.validate across path sizes, smallest first so a slow root shows up last.
+    FContentTools ContentTools;
+    TSharedPtr<FJsonObject> NamingRules = MakeShared<FJsonObject>();
+    NamingRules->SetStringField(TEXT("StaticMesh"), TEXT("^SM_"));
+    NamingRules->SetStringField(TEXT("Texture2D"), TEXT("^T_"));
+    TSharedPtr<FJsonObject> Rules = MakeShared<FJsonObject>();
+    Rules->SetObjectField(TEXT("naming"), NamingRules);
+    for (int32 Level = Ladder.Num() - 1; Level >= 0; --Level)
+    {
+        const FString Suffix = Level == 0 ? FString(TEXT("root")) : FString::Printf(TEXT("subtree%d"), Level);
+
+        TSharedPtr<FJsonObject> ScanParams = MakePathsParams(Ladder[Level]);
+        Timings.Add(TimeContentCommand(ContentTools, FString::Printf(TEXT("content.scan.%s"), *Suffix), TEXT("content.scan"), ScanParams, TEXT("stats"), Iterations));
+
+        TSharedPtr<FJsonObject> ValidateParams = MakePathsParams(Ladder[Level]);
+        ValidateParams->SetObjectField(TEXT("rules"), Rules);
+        Timings.Add(TimeContentCommand(ContentTools, FString::Printf(TEXT("content.validate.%s"), *Suffix), TEXT("content.validate"), ValidateParams, TEXT("summary"), Iterations));
+    }
+
+    TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+    Report->SetStringField(TEXT("source"), RegistryPath.IsEmpty() ? TEXT("synthetic") : RegistryPath);
+    Report->SetNumberField(TEXT("assets"), AssetCount);
+    Report->SetNumberField(TEXT("seed"), Seed);
+    Report->SetStringField(TEXT("root"), Root);
+    Report->SetNumberField(TEXT("buildSeconds"), BuildSeconds);
+    Report->SetNumberField(TEXT("registryGrowthBytes"), static_cast<double>(RegistryGrowthBytes));
+    TArray<TSharedPtr<FJsonValue>> Cases;
+    bool bAllPassed = true;
+    for (FCaseTiming& Timing : Timings)
+    {
+        const TSharedRef<FJsonObject> Json = TimingToJson(Timing);
+        Cases.Add(MakeShared<FJsonValueObject>(Json));
+        if (!Timing.Error.IsEmpty())
+        {
+            bAllPassed = false;
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPAssetBenchmark: %-32s failed: %s"), *Timing.Name, *Timing.Error);
+            continue;
+        }
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPAssetBenchmark: %-32s median %9.1f ms  max %9.1f ms  total %lld"),
+            *Timing.Name, Json->GetNumberField(TEXT("medianMs")), Json->GetNumberField(TEXT("maxMs")), Timing.Total);
+    }
+    Report->SetArrayField(TEXT("cases"), Cases);
+
+    if (OutputPath.IsEmpty())
+    {
+        OutputPath = FPaths::Combine(GetDefault<UUnrealMCPSettings>()->GetEffectiveLogsDirectory(),
+            FString::Printf(TEXT("UnrealMCP_asset_bench_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"))));
+    }
+    FString Serialized;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Serialized);
+    FJsonSerializer::Serialize(Report, Writer);
+    if (!FFileHelper::SaveStringToFile(Serialized, *OutputPath))
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPAssetBenchmark: cannot write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPAssetBenchmark: results written to %s"), *OutputPath);
+    return bAllPassed ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+#include "Commandlets/UnrealMCPServeCommandlet.h"
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Editor.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadManager.h"
+#include "Misc/Parse.h"
+#include "Modules/ModuleManager.h"
+#include "UnrealMCPBridge.h"
+#include "UnrealMCPLog.h"
+#include "UnrealMCPSettings.h"
+
+UUnrealMCPServeCommandlet::UUnrealMCPServeCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UUnrealMCPServeCommandlet::Main(const FString& Params)
+{
+    double IdleTimeoutSeconds = 300.0;
+    int32 TickRate = 60;
+    int32 ServerPort = 0;
+    FParse::Value(*Params, TEXT("IdleTimeout="), IdleTimeoutSeconds);
+    FParse::Value(*Params, TEXT("TickRate="), TickRate);
+    FParse::Value(*Params, TEXT("Port="), ServerPort);
+    TickRate = FMath::Clamp(TickRate, 1, 1000);
+
+    UUnrealMCPBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UUnrealMCPBridge>() : nullptr;
+    if (!Bridge)
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPServe: the UnrealMCPBridge subsystem is not available"));
+        return 1;
+    }
+
+    // Nothing listens before the registry is complete, so no request sees a partial scan.
+    const double ScanStart = FPlatformTime::Seconds();
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetRegistry.SearchAllAssets(true);
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPServe: asset registry scanned in %.1f s"), FPlatformTime::Seconds() - ScanStart);
+
+    if (ServerPort > 0)
+    {
+        GetMutableDefault<UUnrealMCPSettings>()->ServerPort = ServerPort;
+    }
+    Bridge->StartServer();
+    if (!Bridge->IsRunning())
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPServe: the server did not start"));
+        return 1;
+    }
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPServe: serving at %d frames/s, idle timeout %.0f s"), TickRate, IdleTimeoutSeconds);
+
+    // What the engine loop would do each frame for the bridge: game-thread tasks, the core ticker
+    // (scheduler, event hub, caches), thread-manager ticks for fake threads and garbage collection.
+    const double FrameSeconds = 1.0 / TickRate;
+    double LastFrame = FPlatformTime::Seconds();
+    double IdleSince = LastFrame;
+    while (!IsEngineExitRequested())
+    {
+        const double FrameStart = FPlatformTime::Seconds();
+        const float DeltaTime = static_cast<float>(FrameStart - LastFrame);
+        LastFrame = FrameStart;
+
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        FTSTicker::GetCoreTicker().Tick(DeltaTime);
+        FThreadManager::Get().Tick();
+        GEngine->ConditionalCollectGarbage();
+
+        const double Now = FPlatformTime::Seconds();
+        if (!Bridge->IsIdle())
+        {
+            IdleSince = Now;
+        }
+        else if (IdleTimeoutSeconds > 0.0 && Now - IdleSince >= IdleTimeoutSeconds)
+        {
+            UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPServe: idle for %.0f s, exiting"), Now - IdleSince);
+            break;
+        }
+
+        const double Remaining = FrameSeconds - (Now - FrameStart);
+        if (Remaining > 0.0)
+        {
+            FPlatformProcess::Sleep(static_cast<float>(Remaining));
+        }
+    }
+
+    Bridge->StopServer();
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include "Commands/BlueprintBatchCompile.h"
+#include "CoreMinimal.h"
+
+#include "Assets/AssetClassResolver.h"
+#include "AssetRegistry/ARFilter.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Commands/BlueprintCompileQueue.h"
+#include "Commands/BlueprintResolver.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "Dom/JsonValue.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "Protocol/CommandContext.h"
+
+namespace
+{
+    constexpr const TCHAR* ErrorCodeInvalidParams = TEXT("INVALID_PARAMETERS");
+    constexpr const TCHAR* ErrorCodeTooMany = TEXT("TOO_MANY_BLUEPRINTS");
+    constexpr const TCHAR* ErrorCodeCancelled = TEXT("CANCELLED");
+
+    /** Blueprints one compile_many takes; a project-wide recompile is a few thousand. */
+    constexpr int32 MaxBlueprints = 5000;
+
+    /** Blueprints loaded between progress frames. */
+    constexpr int32 ProgressInterval = 25;
+
+    TSharedPtr<FJsonObject> MakeErrorJson(const FString& Code, const FString& Message)
+    {
+        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+        Error->SetBoolField(TEXT("success"), false);
+        Error->SetStringField(TEXT("errorCode"), Code);
+        Error->SetStringField(TEXT("error"), Message);
+        Error->SetStringField(TEXT("message"), Message);
+        return Error;
+    }
+
+    TArray<FString> GetStringArray(const TSharedPtr<FJsonObject>& Params, const TCHAR* Field)
+    {
+        TArray<FString> Values;
+        const TArray<TSharedPtr<FJsonValue>>* ValuesJson = nullptr;
+        if (Params->TryGetArrayField(Field, ValuesJson))
+        {
+            for (const TSharedPtr<FJsonValue>& ValueJson : *ValuesJson)
+            {
+                FString Value;
+                if (ValueJson.IsValid() && ValueJson->TryGetString(Value) && !Value.TrimStartAndEnd().IsEmpty())
+                {
+                    Values.AddUnique(Value.TrimStartAndEnd());
+                }
+            }
+        }
+        return Values;
+    }
+
+    double MillisecondsSince(double StartSeconds)
+    {
+        return (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+    }
+}
+
+TSharedPtr<FJsonObject> FBlueprintBatchCompile::CompileMany(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!Params.IsValid())
+    {
+        return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+    }
+
+    const TArray<FString> Names = GetStringArray(Params, TEXT("blueprints"));
+    const TArray<FString> Paths = GetStringArray(Params, TEXT("paths"));
+    if (Names.Num() == 0 && Paths.Num() == 0)
+    {
+        return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Give 'blueprints' (names or paths) or 'paths' (content folders)"));
+    }
+
+    bool bSave = false;
+    Params->TryGetBoolField(TEXT("save"), bSave);
+    bool bSkipUpToDate = false;
+    Params->TryGetBoolField(TEXT("skipUpToDate"), bSkipUpToDate);
+
+    const double StartSeconds = FPlatformTime::Seconds();
+
+    // Folders are expanded from the registry without loading anything, so the cap is checked
+    // before the first blueprint loads.
+    TArray<FSoftObjectPath> FolderAssets;
+    if (Paths.Num() > 0)
+    {
+        FARFilter Filter;
+        Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+        FAssetClassResolver::Get().ExpandDerivedClasses(Filter.ClassPaths);
+        Filter.bRecursivePaths = true;
+        for (const FString& Path : Paths)
+        {
+            Filter.PackagePaths.Add(*Path);
+        }
+        TArray<FAssetData> Assets;
+        IAssetRegistry::GetChecked().GetAssets(Filter, Assets);
+        for (const FAssetData& Asset : Assets)
+        {
+            FolderAssets.Add(Asset.GetSoftObjectPath());
+        }
+    }
+
+    const int32 Total = Names.Num() + FolderAssets.Num();
+    if (Total > MaxBlueprints)
+    {
+        return MakeErrorJson(ErrorCodeTooMany, FString::Printf(TEXT("%d blueprints requested; the limit is %d per call"), Total, MaxBlueprints));
+    }
+
+    TArray<UBlueprint*> Blueprints;
+    TMap<UBlueprint*, double> LoadMs;
+    TArray<TSharedPtr<FJsonValue>> NotFoundJson;
+    int32 NumSkipped = 0;
+    int32 Done = 0;
+    auto Add = [&](UBlueprint* Blueprint, const FString& Requested, double LoadStartSeconds)
+    {
+        if (!Blueprint)
+        {
+            NotFoundJson.Add(MakeShared<FJsonValueString>(Requested));
+        }
+        else if (bSkipUpToDate && Blueprint->Status == BS_UpToDate && !FBlueprintCompileQueue::Get().IsPending(Blueprint))
+        {
+            ++NumSkipped;
+        }
+        else if (!Blueprints.Contains(Blueprint))
+        {
+            Blueprints.Add(Blueprint);
+            LoadMs.Add(Blueprint, MillisecondsSince(LoadStartSeconds));
+        }
+
+        if (++Done % ProgressInterval == 0)
+        {
+            UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(Done, Total, TEXT("loading"));
+        }
+    };
+
+    for (const FString& Name : Names)
+    {
+        const double LoadStartSeconds = FPlatformTime::Seconds();
+        Add(FBlueprintResolver::Get().Find(Name), Name, LoadStartSeconds);
+        if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
+        {
+            return MakeErrorJson(ErrorCodeCancelled, TEXT("Cancelled before compiling"));
+        }
+    }
+    for (const FSoftObjectPath& AssetPath : FolderAssets)
+    {
+        const double LoadStartSeconds = FPlatformTime::Seconds();
+        Add(Cast<UBlueprint>(AssetPath.TryLoad()), AssetPath.ToString(), LoadStartSeconds);
+        if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
+        {
+            return MakeErrorJson(ErrorCodeCancelled, TEXT("Cancelled before compiling"));
+        }
+    }
+    const double ResolveMs = MillisecondsSince(StartSeconds);
+
+    UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(Done, Total, TEXT("compiling"));
+    const double CompileStartSeconds = FPlatformTime::Seconds();
+    const TArray<FBlueprintCompileQueue::FReport> Reports = FBlueprintCompileQueue::Get().CompileMany(Blueprints, bSave);
+    double SaveSeconds = 0.0;
+    int32 NumWithErrors = 0;
+    TArray<TSharedPtr<FJsonValue>> ReportsJson;
+    for (int32 Index = 0; Index < Reports.Num(); ++Index)
+    {
+        const FBlueprintCompileQueue::FReport& Report = Reports[Index];
+        SaveSeconds += Report.SaveSeconds;
+        NumWithErrors += Report.NumErrors > 0 ? 1 : 0;
+
+        TSharedRef<FJsonObject> ReportJson = Report.ToJson();
+        ReportJson->SetNumberField(TEXT("loadMs"), LoadMs.FindRef(Blueprints[Index]));
+        ReportsJson.Add(MakeShared<FJsonValueObject>(ReportJson));
+    }
+    const double CompileMs = MillisecondsSince(CompileStartSeconds) - SaveSeconds * 1000.0;
+
+    TSharedPtr<FJsonObject> Timings = MakeShared<FJsonObject>();
+    Timings->SetNumberField(TEXT("resolveMs"), ResolveMs);
+    Timings->SetNumberField(TEXT("compileMs"), CompileMs);
+    Timings->SetNumberField(TEXT("saveMs"), SaveSeconds * 1000.0);
+    Timings->SetNumberField(TEXT("totalMs"), MillisecondsSince(StartSeconds));
+
+    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+    Data->SetNumberField(TEXT("count"), Reports.Num());
+    Data->SetNumberField(TEXT("withErrors"), NumWithErrors);
+    Data->SetNumberField(TEXT("skipped"), NumSkipped);
+    Data->SetArrayField(TEXT("notFound"), NotFoundJson);
+    Data->SetArrayField(TEXT("compiled"), ReportsJson);
+    Data->SetObjectField(TEXT("timings"), Timings);
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+}
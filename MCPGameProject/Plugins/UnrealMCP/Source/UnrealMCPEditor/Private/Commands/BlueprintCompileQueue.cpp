@@ -0,0 +1,332 @@
+#include "Commands/BlueprintCompileQueue.h"
+#include "CoreMinimal.h"
+
+#include "BlueprintCompilationManager.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "EditorAssetLibrary.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraphNode.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Logging/TokenizedMessage.h"
+#include "Settings/UnrealMCPRuntimeConfig.h"
+#include "Transactions/BulkEdit.h"
+#include "UnrealMCPLog.h"
+
+namespace
+{
+    /** Messages kept per report; a broken graph can log one per node. */
+    constexpr int32 MaxReportMessages = 50;
+
+    double GetDebounceSeconds()
+    {
+        return FUnrealMCPRuntimeConfig::Get().BlueprintCompileDebounceMs / 1000.0;
+    }
+
+    bool AreCompilesDeferred()
+    {
+        return FUnrealMCPRuntimeConfig::Get().bDeferBlueprintCompiles;
+    }
+
+    FString StatusOf(const UBlueprint* Blueprint, int32 NumWarnings)
+    {
+        return Blueprint->Status == BS_Error ? TEXT("error")
+            : (Blueprint->Status == BS_UpToDateWithWarnings || NumWarnings > 0) ? TEXT("warnings")
+            : TEXT("up_to_date");
+    }
+
+    /** Saves Blueprint's package for a report that asked, timing the save. */
+    void SaveForReport(UBlueprint* Blueprint, FBlueprintCompileQueue::FReport& Report)
+    {
+        const double StartSeconds = FPlatformTime::Seconds();
+        Report.bSaved = UEditorAssetLibrary::SaveLoadedAsset(Blueprint, /*bOnlyIfIsDirty=*/false);
+        Report.SaveSeconds = FPlatformTime::Seconds() - StartSeconds;
+    }
+}
+
+TSharedRef<FJsonObject> FBlueprintCompileQueue::FReport::ToJson() const
+{
+    TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+    Object->SetStringField(TEXT("blueprint"), Path);
+    Object->SetStringField(TEXT("status"), Status);
+    Object->SetNumberField(TEXT("errors"), NumErrors);
+    Object->SetNumberField(TEXT("warnings"), NumWarnings);
+    TArray<TSharedPtr<FJsonValue>> MessagesJson;
+    for (const FString& Message : Messages)
+    {
+        MessagesJson.Add(MakeShared<FJsonValueString>(Message));
+    }
+    Object->SetArrayField(TEXT("messages"), MessagesJson);
+    if (bSaved)
+    {
+        Object->SetBoolField(TEXT("saved"), true);
+        Object->SetNumberField(TEXT("saveMs"), SaveSeconds * 1000.0);
+    }
+    return Object;
+}
+
+FBlueprintCompileQueue& FBlueprintCompileQueue::Get()
+{
+    static FBlueprintCompileQueue Queue;
+    return Queue;
+}
+
+void FBlueprintCompileQueue::Stop()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+    Pending.Reset();
+}
+
+void FBlueprintCompileQueue::Request(UBlueprint* Blueprint, bool bSave)
+{
+    check(IsInGameThread());
+    if (!Blueprint)
+    {
+        return;
+    }
+
+    const bool bDeferred = AreCompilesDeferred();
+    if (!bDeferred && GetDebounceSeconds() <= 0.0)
+    {
+        CompileNow(Blueprint, bSave);
+        return;
+    }
+
+    FPending* Entry = Pending.FindByPredicate([Blueprint](const FPending& Candidate) { return Candidate.Blueprint.Get() == Blueprint; });
+    if (!Entry)
+    {
+        Entry = &Pending.AddDefaulted_GetRef();
+        Entry->Blueprint = Blueprint;
+    }
+    Entry->bSave |= bSave;
+    LastRequestSeconds = FPlatformTime::Seconds();
+
+    if (!bDeferred && !TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBlueprintCompileQueue::Tick), 0.1f);
+    }
+}
+
+FBlueprintCompileQueue::FReport FBlueprintCompileQueue::Compile(UBlueprint* Blueprint)
+{
+    check(IsInGameThread());
+
+    return CompileNow(Blueprint, TakePending(Blueprint));
+}
+
+TArray<FBlueprintCompileQueue::FReport> FBlueprintCompileQueue::CompileMany(const TArray<UBlueprint*>& Blueprints, bool bSave)
+{
+    check(IsInGameThread());
+
+    TArray<UBlueprint*> ToCompile;
+    TArray<bool> SaveRequested;
+    for (UBlueprint* Blueprint : Blueprints)
+    {
+        if (Blueprint && !ToCompile.Contains(Blueprint))
+        {
+            SaveRequested.Add(TakePending(Blueprint) || bSave);
+            ToCompile.Add(Blueprint);
+        }
+    }
+
+    // The manager sorts the queue itself; queueing the whole set before the flush is what lets it
+    // compile dependents once.
+    for (UBlueprint* Blueprint : ToCompile)
+    {
+        FBlueprintCompilationManager::QueueForCompilation(Blueprint);
+    }
+    FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+
+    TArray<FReport> Reports;
+    Reports.Reserve(ToCompile.Num());
+    for (int32 Index = 0; Index < ToCompile.Num(); ++Index)
+    {
+        UBlueprint* Blueprint = ToCompile[Index];
+        FReport& Report = Reports.AddDefaulted_GetRef();
+        Report.Path = Blueprint->GetPathName();
+
+        TArray<UEdGraphNode*> Nodes;
+        FBlueprintEditorUtils::GetAllNodesOfClass<UEdGraphNode>(Blueprint, Nodes);
+        TArray<FString> Warnings;
+        for (const UEdGraphNode* Node : Nodes)
+        {
+            if (!Node || !Node->bHasCompilerMessage)
+            {
+                continue;
+            }
+            const bool bError = Node->ErrorType <= EMessageSeverity::Error;
+            if (!bError && Node->ErrorType != EMessageSeverity::Warning)
+            {
+                continue;
+            }
+            int32& Count = bError ? Report.NumErrors : Report.NumWarnings;
+            ++Count;
+            const FString Line = FString::Printf(TEXT("%s: %s"), *Node->GetNodeTitle(ENodeTitleType::ListView).ToString(), *Node->ErrorMsg);
+            if (bError && Report.Messages.Num() < MaxReportMessages)
+            {
+                Report.Messages.Add(Line);
+            }
+            else if (!bError)
+            {
+                Warnings.Add(Line);
+            }
+        }
+        Report.Messages.Append(Warnings.GetData(), FMath::Min(Warnings.Num(), MaxReportMessages - Report.Messages.Num()));
+        // Errors outside any node (a bad parent class) only show in the status.
+        Report.NumErrors = Blueprint->Status == BS_Error ? FMath::Max(Report.NumErrors, 1) : Report.NumErrors;
+        Report.Status = StatusOf(Blueprint, Report.NumWarnings);
+
+        if (SaveRequested[Index])
+        {
+            SaveForReport(Blueprint, Report);
+        }
+        if (Report.NumErrors > 0)
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("FBlueprintCompileQueue: %s compiled with %d error(s)"), *Report.Path, Report.NumErrors);
+        }
+        CompiledDelegate.Broadcast(Report);
+    }
+    return Reports;
+}
+
+void FBlueprintCompileQueue::RegenerateSkeleton(UBlueprint* Blueprint)
+{
+    check(IsInGameThread());
+    if (Blueprint)
+    {
+        FKismetEditorUtilities::GenerateBlueprintSkeleton(Blueprint, /*bForceRegeneration=*/true);
+    }
+}
+
+void FBlueprintCompileQueue::Flush(UBlueprint* Blueprint)
+{
+    if (IsPending(Blueprint))
+    {
+        Compile(Blueprint);
+    }
+}
+
+void FBlueprintCompileQueue::FlushAll(TArray<FReport>* OutReports)
+{
+    check(IsInGameThread());
+
+    // Requests made while these compile (from OnCompiled listeners) wait for the next flush.
+    TArray<FPending> ToCompile = MoveTemp(Pending);
+    Pending.Reset();
+    ToCompile.RemoveAll([](const FPending& Entry) { return !Entry.Blueprint.IsValid(); });
+    for (int32 Index = 0; Index < ToCompile.Num(); ++Index)
+    {
+        const FPending& Entry = ToCompile[Index];
+        if (UBlueprint* Blueprint = Entry.Blueprint.Get())
+        {
+            // The classes the earlier compiles replaced are collected once, after the last.
+            FReport Report = CompileNow(Blueprint, Entry.bSave, /*bSkipGarbageCollection=*/Index + 1 < ToCompile.Num());
+            if (OutReports)
+            {
+                OutReports->Add(MoveTemp(Report));
+            }
+        }
+    }
+}
+
+bool FBlueprintCompileQueue::IsPending(const UBlueprint* Blueprint) const
+{
+    return Blueprint && Pending.ContainsByPredicate([Blueprint](const FPending& Candidate) { return Candidate.Blueprint.Get() == Blueprint; });
+}
+
+void FBlueprintCompileQueue::FlushInto(FJsonObject& Result)
+{
+    TArray<FReport> Reports;
+    FlushAll(&Reports);
+    if (Reports.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> ReportsJson;
+    for (const FReport& Report : Reports)
+    {
+        ReportsJson.Add(MakeShared<FJsonValueObject>(Report.ToJson()));
+    }
+    Result.SetArrayField(TEXT("compiled"), ReportsJson);
+}
+
+FBlueprintCompileQueue::FReport FBlueprintCompileQueue::CompileNow(UBlueprint* Blueprint, bool bSave, bool bSkipGarbageCollection)
+{
+    FReport Report;
+    Report.Path = Blueprint->GetPathName();
+
+    FCompilerResultsLog Results;
+    Results.SetSourcePath(Report.Path);
+    FKismetEditorUtilities::CompileBlueprint(Blueprint, bSkipGarbageCollection ? EBlueprintCompileOptions::SkipGarbageCollection : EBlueprintCompileOptions::None, &Results);
+
+    Report.NumErrors = Results.NumErrors;
+    Report.NumWarnings = Results.NumWarnings;
+    Report.Status = StatusOf(Blueprint, Results.NumWarnings);
+    for (const EMessageSeverity::Type Severity : { EMessageSeverity::Error, EMessageSeverity::Warning })
+    {
+        for (const TSharedRef<FTokenizedMessage>& Message : Results.Messages)
+        {
+            if (Message->GetSeverity() == Severity && Report.Messages.Num() < MaxReportMessages)
+            {
+                Report.Messages.Add(Message->ToText().ToString());
+            }
+        }
+    }
+
+    if (bSave)
+    {
+        SaveForReport(Blueprint, Report);
+    }
+    if (Report.NumErrors > 0)
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("FBlueprintCompileQueue: %s compiled with %d error(s)"), *Report.Path, Report.NumErrors);
+    }
+
+    CompiledDelegate.Broadcast(Report);
+    return Report;
+}
+
+bool FBlueprintCompileQueue::TakePending(const UBlueprint* Blueprint)
+{
+    const int32 Index = Pending.IndexOfByPredicate([Blueprint](const FPending& Candidate) { return Candidate.Blueprint.Get() == Blueprint; });
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+    const bool bSave = Pending[Index].bSave;
+    Pending.RemoveAt(Index);
+    return bSave;
+}
+
+bool FBlueprintCompileQueue::Tick(float DeltaTime)
+{
+    Pending.RemoveAll([](const FPending& Entry) { return !Entry.Blueprint.IsValid(); });
+    if (Pending.Num() == 0 || AreCompilesDeferred())
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+
+    // Inside a bulk edit the compile waits for the scope to close, which batches and shared
+    // transactions follow with a flush of their own.
+    if (FBulkEdit::IsActive() || FPlatformTime::Seconds() - LastRequestSeconds < GetDebounceSeconds())
+    {
+        return true;
+    }
+
+    FlushAll();
+    if (Pending.Num() > 0)
+    {
+        return true;
+    }
+    TickerHandle.Reset();
+    return false;
+}
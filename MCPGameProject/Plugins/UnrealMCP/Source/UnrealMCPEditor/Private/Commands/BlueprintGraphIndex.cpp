@@ -0,0 +1,207 @@
+#include "Commands/BlueprintGraphIndex.h"
+#include "CoreMinimal.h"
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "K2Node_Event.h"
+
+FBlueprintGraphIndex& FBlueprintGraphIndex::Get()
+{
+    static FBlueprintGraphIndex Index;
+    return Index;
+}
+
+void FBlueprintGraphIndex::Stop()
+{
+    for (TPair<TObjectKey<UEdGraph>, FGraphEntry>& Pair : Graphs)
+    {
+        if (UEdGraph* Graph = Pair.Value.Graph.Get())
+        {
+            Graph->RemoveOnGraphChangedHandler(Pair.Value.ChangedHandle);
+        }
+    }
+    Graphs.Reset();
+    Pins.Reset();
+}
+
+UEdGraphNode* FBlueprintGraphIndex::FindNode(UEdGraph* Graph, const FGuid& NodeGuid)
+{
+    FGraphEntry* Entry = GetEntry(Graph);
+    if (!Entry || !NodeGuid.IsValid())
+    {
+        return nullptr;
+    }
+
+    const TWeakObjectPtr<UEdGraphNode>* Found = Entry->NodesByGuid.Find(NodeGuid);
+    UEdGraphNode* Node = Found ? Found->Get() : nullptr;
+    if (Node && Node->GetGraph() == Graph && Node->NodeGuid == NodeGuid)
+    {
+        return Node;
+    }
+    if (Found)
+    {
+        // The node moved, was destroyed or got a new GUID without the graph telling us.
+        Build(Graph, *Entry);
+        Found = Entry->NodesByGuid.Find(NodeGuid);
+        return Found ? Found->Get() : nullptr;
+    }
+    return nullptr;
+}
+
+UEdGraphNode* FBlueprintGraphIndex::FindNode(UEdGraph* Graph, const FString& NodeId)
+{
+    FGuid NodeGuid;
+    return FGuid::Parse(NodeId, NodeGuid) ? FindNode(Graph, NodeGuid) : nullptr;
+}
+
+UK2Node_Event* FBlueprintGraphIndex::FindEventNode(UEdGraph* Graph, FName EventName)
+{
+    FGraphEntry* Entry = GetEntry(Graph);
+    if (!Entry || EventName.IsNone())
+    {
+        return nullptr;
+    }
+
+    if (const TArray<TWeakObjectPtr<UK2Node_Event>>* Events = Entry->EventsByName.Find(EventName))
+    {
+        for (const TWeakObjectPtr<UK2Node_Event>& Event : *Events)
+        {
+            UK2Node_Event* EventNode = Event.Get();
+            if (EventNode && EventNode->GetGraph() == Graph && EventNode->EventReference.GetMemberName() == EventName)
+            {
+                return EventNode;
+            }
+        }
+    }
+    return nullptr;
+}
+
+TArray<UK2Node_Event*> FBlueprintGraphIndex::FindEventNodes(UEdGraph* Graph, FName EventName)
+{
+    TArray<UK2Node_Event*> EventNodes;
+    FGraphEntry* Entry = GetEntry(Graph);
+    if (!Entry || EventName.IsNone())
+    {
+        return EventNodes;
+    }
+
+    if (const TArray<TWeakObjectPtr<UK2Node_Event>>* Events = Entry->EventsByName.Find(EventName))
+    {
+        for (const TWeakObjectPtr<UK2Node_Event>& Event : *Events)
+        {
+            UK2Node_Event* EventNode = Event.Get();
+            if (EventNode && EventNode->GetGraph() == Graph && EventNode->EventReference.GetMemberName() == EventName)
+            {
+                EventNodes.Add(EventNode);
+            }
+        }
+    }
+    return EventNodes;
+}
+
+UEdGraphPin* FBlueprintGraphIndex::FindPin(UEdGraphNode* Node, FName PinName, EEdGraphPinDirection Direction)
+{
+    if (!Node || PinName.IsNone())
+    {
+        return nullptr;
+    }
+
+    auto Matches = [PinName, Direction](const UEdGraphPin* Pin)
+    {
+        return Pin && !Pin->bWasTrashed && Pin->PinName == PinName && (Direction == EGPD_MAX || Pin->Direction == Direction);
+    };
+
+    const FPinKey Key{ Node, PinName, Direction };
+    if (UEdGraphPin** Cached = Pins.Find(Key))
+    {
+        // Reconstruction frees and reallocates pins, so a hit must still be one of the node's own.
+        if (Node->Pins.Contains(*Cached) && Matches(*Cached))
+        {
+            return *Cached;
+        }
+        Pins.Remove(Key);
+    }
+
+    // FName comparison ignores case, which covers both the exact and the case-insensitive match.
+    UEdGraphPin* const* Found = Node->Pins.FindByPredicate(Matches);
+    if (!Found)
+    {
+        return nullptr;
+    }
+    if (Pins.Num() >= MaxPins)
+    {
+        Pins.Reset();
+    }
+    Pins.Add(Key, *Found);
+    return *Found;
+}
+
+void FBlueprintGraphIndex::Invalidate(UEdGraph* Graph)
+{
+    if (FGraphEntry* Entry = Graph ? Graphs.Find(Graph) : nullptr)
+    {
+        Entry->bStale = true;
+    }
+}
+
+FBlueprintGraphIndex::FGraphEntry* FBlueprintGraphIndex::GetEntry(UEdGraph* Graph)
+{
+    check(IsInGameThread());
+    if (!Graph)
+    {
+        return nullptr;
+    }
+
+    FGraphEntry* Entry = Graphs.Find(Graph);
+    if (!Entry || !Entry->Graph.IsValid())
+    {
+        // Drop indexes of graphs that went away before making room for a new one.
+        for (auto It = Graphs.CreateIterator(); It; ++It)
+        {
+            if (!It.Value().Graph.IsValid())
+            {
+                It.RemoveCurrent();
+            }
+        }
+
+        Entry = &Graphs.Add(Graph);
+        Entry->Graph = Graph;
+        Entry->ChangedHandle = Graph->AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateLambda([this, GraphKey = TObjectKey<UEdGraph>(Graph)](const FEdGraphEditAction&)
+        {
+            if (FGraphEntry* Changed = Graphs.Find(GraphKey))
+            {
+                // New nodes get their GUIDs after AddNode notifies, so the rebuild waits for the next lookup.
+                Changed->bStale = true;
+            }
+        }));
+    }
+
+    if (Entry->bStale || Entry->NumIndexedNodes != Graph->Nodes.Num())
+    {
+        Build(Graph, *Entry);
+    }
+    return Entry;
+}
+
+void FBlueprintGraphIndex::Build(UEdGraph* Graph, FGraphEntry& Entry)
+{
+    Entry.NodesByGuid.Reset();
+    Entry.EventsByName.Reset();
+    for (UEdGraphNode* Node : Graph->Nodes)
+    {
+        if (!Node)
+        {
+            continue;
+        }
+        if (Node->NodeGuid.IsValid())
+        {
+            Entry.NodesByGuid.FindOrAdd(Node->NodeGuid, Node);
+        }
+        if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+        {
+            Entry.EventsByName.FindOrAdd(EventNode->EventReference.GetMemberName()).Add(EventNode);
+        }
+    }
+    Entry.NumIndexedNodes = Graph->Nodes.Num();
+    Entry.bStale = false;
+}
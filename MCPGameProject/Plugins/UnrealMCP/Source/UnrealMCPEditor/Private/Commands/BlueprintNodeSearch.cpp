@@ -0,0 +1,302 @@
+#include "Commands/BlueprintNodeSearch.h"
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "Dom/JsonValue.h"
+#include "FindInBlueprintManager.h"
+#include "FindInBlueprints.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Modules/ModuleManager.h"
+#include "Protocol/CommandContext.h"
+
+namespace
+{
+    constexpr const TCHAR* ErrorCodeInvalidParams = TEXT("INVALID_PARAMETERS");
+    constexpr const TCHAR* ErrorCodeSearchTimeout = TEXT("SEARCH_TIMEOUT");
+    constexpr const TCHAR* ErrorCodeCancelled = TEXT("CANCELLED");
+
+    constexpr int32 DefaultLimit = 500;
+    constexpr int32 MaxLimit = 5000;
+    constexpr double DefaultTimeoutSeconds = 30.0;
+    constexpr double MaxTimeoutSeconds = 600.0;
+
+    /** Node class names the searches by reference keep; matched as substrings, like the editor's search. */
+    const TCHAR* FunctionNodeClass = TEXT("K2Node_CallFunction");
+    const TCHAR* VariableNodeClass = TEXT("K2Node_Variable");
+    const TCHAR* EventNodeClass = TEXT("Event");
+
+    TSharedPtr<FJsonObject> MakeErrorJson(const FString& Code, const FString& Message)
+    {
+        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+        Error->SetBoolField(TEXT("success"), false);
+        Error->SetStringField(TEXT("errorCode"), Code);
+        Error->SetStringField(TEXT("error"), Message);
+        Error->SetStringField(TEXT("message"), Message);
+        return Error;
+    }
+
+    /** A search query value, quoted so names with spaces or operators stay one token. */
+    FString QuoteValue(const FString& Value)
+    {
+        return FString::Printf(TEXT("\"%s\""), *Value.Replace(TEXT("\""), TEXT("\\\"")));
+    }
+
+    /**
+     * The Find-in-Blueprints query for Params: a node filter on the node class and on the native
+     * name of the referenced function, variable or event, or the caller's own "query" as is.
+     */
+    bool BuildQuery(const TSharedPtr<FJsonObject>& Params, FString& OutQuery, FString& OutError)
+    {
+        FString RawQuery;
+        if (Params->TryGetStringField(TEXT("query"), RawQuery) && !RawQuery.TrimStartAndEnd().IsEmpty())
+        {
+            OutQuery = RawQuery.TrimStartAndEnd();
+            return true;
+        }
+
+        FString Function;
+        FString Variable;
+        FString Event;
+        FString NodeClass;
+        Params->TryGetStringField(TEXT("function"), Function);
+        Params->TryGetStringField(TEXT("variable"), Variable);
+        Params->TryGetStringField(TEXT("event"), Event);
+        Params->TryGetStringField(TEXT("nodeClass"), NodeClass);
+
+        const int32 NumReferences = !Function.IsEmpty() + !Variable.IsEmpty() + !Event.IsEmpty();
+        if (NumReferences > 1)
+        {
+            OutError = TEXT("Give at most one of 'function', 'variable' and 'event'");
+            return false;
+        }
+        if (NumReferences == 0 && NodeClass.IsEmpty())
+        {
+            OutError = TEXT("Give 'function', 'variable', 'event', 'nodeClass' or 'query'");
+            return false;
+        }
+
+        TArray<FString> Terms;
+        if (!NodeClass.IsEmpty())
+        {
+            Terms.Add(FString::Printf(TEXT("ClassName=%s"), *QuoteValue(NodeClass)));
+        }
+        const FString& Reference = !Function.IsEmpty() ? Function : (!Variable.IsEmpty() ? Variable : Event);
+        if (!Reference.IsEmpty())
+        {
+            if (NodeClass.IsEmpty())
+            {
+                const TCHAR* ReferenceClass = !Function.IsEmpty() ? FunctionNodeClass : (!Variable.IsEmpty() ? VariableNodeClass : EventNodeClass);
+                Terms.Add(FString::Printf(TEXT("ClassName=%s"), ReferenceClass));
+            }
+            Terms.Add(FString::Printf(TEXT("\"Native Name\"=%s"), *QuoteValue(Reference)));
+        }
+        OutQuery = FString::Printf(TEXT("Nodes(%s)"), *FString::Join(Terms, TEXT(" && ")));
+        return true;
+    }
+
+    /** A search on the Find-in-Blueprints thread, carried between the frames the handler waits in. */
+    struct FSearchWait : public UnrealMCP::Protocol::FCommandContext::FResumeState
+    {
+        TSharedPtr<FStreamSearch> Search;
+        FString Query;
+        TArray<FString> Paths;
+        int32 Limit = DefaultLimit;
+        double StartSeconds = 0.0;
+        double TimeoutSeconds = DefaultTimeoutSeconds;
+
+        virtual ~FSearchWait() override
+        {
+            if (Search.IsValid() && !Search->IsComplete())
+            {
+                Search->Stop();
+            }
+            if (Search.IsValid())
+            {
+                Search->EnsureCompletion();
+            }
+        }
+    };
+
+    /**
+     * Appends Item's matching nodes, the leaves of the result tree under a blueprint, each with the
+     * titles of the graphs (and collapsed graphs) above it.
+     */
+    void CollectMatches(const FSearchResult& Item, TArray<FString>& GraphPath, TArray<TSharedPtr<FJsonValue>>& OutMatches, int32 Limit, bool& bOutTruncated)
+    {
+        if (!Item.IsValid())
+        {
+            return;
+        }
+        if (Item->Children.Num() == 0)
+        {
+            if (OutMatches.Num() >= Limit)
+            {
+                bOutTruncated = true;
+                return;
+            }
+            TSharedPtr<FJsonObject> Match = MakeShared<FJsonObject>();
+            Match->SetStringField(TEXT("title"), Item->GetDisplayString().ToString());
+            Match->SetStringField(TEXT("category"), Item->GetCategory().ToString());
+            Match->SetStringField(TEXT("graph"), FString::Join(GraphPath, TEXT("/")));
+            OutMatches.Add(MakeShared<FJsonValueObject>(Match));
+            return;
+        }
+
+        GraphPath.Add(Item->GetDisplayString().ToString());
+        for (const FSearchResult& Child : Item->Children)
+        {
+            CollectMatches(Child, GraphPath, OutMatches, Limit, bOutTruncated);
+        }
+        GraphPath.Pop();
+    }
+
+    bool IsUnderPaths(const FString& BlueprintPath, const TArray<FString>& Paths)
+    {
+        if (Paths.Num() == 0)
+        {
+            return true;
+        }
+        for (const FString& Path : Paths)
+        {
+            if (BlueprintPath.StartsWith(Path, ESearchCase::IgnoreCase))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> BuildResponse(FSearchWait& Wait)
+    {
+        TArray<FSearchResult> Results;
+        Wait.Search->GetFilteredItems(Results);
+        Results.RemoveAll([](const FSearchResult& Result) { return !Result.IsValid(); });
+
+        // One entry per blueprint, in path order so repeated searches page the same way.
+        Results.Sort([](const FSearchResult& A, const FSearchResult& B)
+        {
+            return A->GetDisplayString().ToString() < B->GetDisplayString().ToString();
+        });
+
+        TArray<TSharedPtr<FJsonValue>> BlueprintsJson;
+        int32 NumMatches = 0;
+        bool bTruncated = false;
+        for (const FSearchResult& Result : Results)
+        {
+            if (bTruncated)
+            {
+                break;
+            }
+            const FString BlueprintPath = Result->GetDisplayString().ToString();
+            if (!IsUnderPaths(BlueprintPath, Wait.Paths))
+            {
+                continue;
+            }
+
+            TArray<FString> GraphPath;
+            TArray<TSharedPtr<FJsonValue>> Matches;
+            for (const FSearchResult& Child : Result->Children)
+            {
+                CollectMatches(Child, GraphPath, Matches, Wait.Limit - NumMatches, bTruncated);
+            }
+            if (Matches.Num() == 0)
+            {
+                continue;
+            }
+
+            NumMatches += Matches.Num();
+            TSharedPtr<FJsonObject> BlueprintJson = MakeShared<FJsonObject>();
+            BlueprintJson->SetStringField(TEXT("blueprint"), BlueprintPath);
+            BlueprintJson->SetArrayField(TEXT("matches"), Matches);
+            BlueprintsJson.Add(MakeShared<FJsonValueObject>(BlueprintJson));
+        }
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetStringField(TEXT("query"), Wait.Query);
+        Data->SetArrayField(TEXT("blueprints"), BlueprintsJson);
+        Data->SetNumberField(TEXT("count"), NumMatches);
+        Data->SetBoolField(TEXT("truncated"), bTruncated);
+        Data->SetNumberField(TEXT("unindexed"), FFindInBlueprintSearchManager::Get().GetNumberUncachedAssets());
+
+        // Blueprints the registry has not discovered yet are missing from the index as well.
+        const FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry"));
+        Data->SetBoolField(TEXT("registryLoading"), AssetRegistryModule && AssetRegistryModule->Get().IsLoadingAssets());
+        Data->SetNumberField(TEXT("elapsedMs"), (FPlatformTime::Seconds() - Wait.StartSeconds) * 1000.0);
+        return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+    }
+
+    /** The finished response, an error on timeout or cancel, or null after suspending until the next frame. */
+    TSharedPtr<FJsonObject> PollSearch(const TSharedRef<FSearchWait>& Wait, UnrealMCP::Protocol::FCommandContext* Context)
+    {
+        // Outside a suspendable request (a batch entry) the search is waited for here.
+        while (!Wait->Search->IsComplete())
+        {
+            if (Context)
+            {
+                Context->ReportProgress(FMath::FloorToInt(Wait->Search->GetPercentComplete() * 100.0f), 100, TEXT("searching"));
+                if (Context->IsCancelled())
+                {
+                    return MakeErrorJson(ErrorCodeCancelled, TEXT("Node search cancelled"));
+                }
+            }
+            if (FPlatformTime::Seconds() - Wait->StartSeconds > Wait->TimeoutSeconds)
+            {
+                return MakeErrorJson(ErrorCodeSearchTimeout, FString::Printf(TEXT("Node search still running after %.0f s"), Wait->TimeoutSeconds));
+            }
+            if (Context && Context->CanSuspend())
+            {
+                Context->Suspend(Wait);
+                return nullptr;
+            }
+            FPlatformProcess::Sleep(0.005f);
+        }
+        return BuildResponse(*Wait);
+    }
+}
+
+TSharedPtr<FJsonObject> FBlueprintNodeSearch::FindNodes(const TSharedPtr<FJsonObject>& Params)
+{
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+    if (TSharedPtr<FSearchWait> Wait = Context ? Context->TakeResumeState<FSearchWait>() : nullptr)
+    {
+        return PollSearch(Wait.ToSharedRef(), Context);
+    }
+
+    if (!Params.IsValid())
+    {
+        return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+    }
+
+    TSharedRef<FSearchWait> Wait = MakeShared<FSearchWait>();
+    FString Error;
+    if (!BuildQuery(Params, Wait->Query, Error))
+    {
+        return MakeErrorJson(ErrorCodeInvalidParams, Error);
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* PathsJson = nullptr;
+    if (Params->TryGetArrayField(TEXT("paths"), PathsJson))
+    {
+        for (const TSharedPtr<FJsonValue>& PathJson : *PathsJson)
+        {
+            FString Path;
+            if (PathJson.IsValid() && PathJson->TryGetString(Path) && !Path.IsEmpty())
+            {
+                Wait->Paths.Add(Path);
+            }
+        }
+    }
+
+    double Limit = DefaultLimit;
+    Params->TryGetNumberField(TEXT("limit"), Limit);
+    Wait->Limit = FMath::Clamp(static_cast<int32>(Limit), 1, MaxLimit);
+    Params->TryGetNumberField(TEXT("timeoutSec"), Wait->TimeoutSeconds);
+    Wait->TimeoutSeconds = FMath::Clamp(Wait->TimeoutSeconds, 1.0, MaxTimeoutSeconds);
+
+    Wait->StartSeconds = FPlatformTime::Seconds();
+    Wait->Search = MakeShared<FStreamSearch>(Wait->Query);
+    return PollSearch(Wait, Context);
+}
@@ -0,0 +1,227 @@
+#include "Commands/BlueprintResolver.h"
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+#include "UnrealMCPLog.h"
+
+namespace
+{
+    /** Where create_blueprint puts blueprints; it wins when several share a name. */
+    const TCHAR* DefaultBlueprintFolder = TEXT("/Game/Blueprints/");
+
+    bool IsBlueprintAsset(const FAssetData& AssetData)
+    {
+        return AssetData.IsInstanceOf(UBlueprint::StaticClass());
+    }
+
+    IAssetRegistry* GetAssetRegistry()
+    {
+        FAssetRegistryModule* Module = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry"));
+        return Module ? &Module->Get() : nullptr;
+    }
+}
+
+FBlueprintResolver& FBlueprintResolver::Get()
+{
+    static FBlueprintResolver Resolver;
+    return Resolver;
+}
+
+void FBlueprintResolver::Start()
+{
+    check(IsInGameThread());
+    if (AssetAddedHandle.IsValid())
+    {
+        return;
+    }
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddLambda([this](const FAssetData& AssetData)
+    {
+        if (bIndexBuilt && IsBlueprintAsset(AssetData))
+        {
+            IndexAsset(AssetData);
+        }
+    });
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddLambda([this](const FAssetData& AssetData)
+    {
+        if (IsBlueprintAsset(AssetData))
+        {
+            UnindexAsset(AssetData.AssetName, AssetData.GetSoftObjectPath());
+            Resolved.Reset();
+        }
+    });
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddLambda([this](const FAssetData& AssetData, const FString& OldObjectPath)
+    {
+        if (IsBlueprintAsset(AssetData))
+        {
+            const FSoftObjectPath OldPath(OldObjectPath);
+            UnindexAsset(FName(*OldPath.GetAssetName()), OldPath);
+            if (bIndexBuilt)
+            {
+                IndexAsset(AssetData);
+            }
+            Resolved.Reset();
+        }
+    });
+}
+
+void FBlueprintResolver::Stop()
+{
+    if (IAssetRegistry* AssetRegistry = GetAssetRegistry())
+    {
+        AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+    }
+    AssetAddedHandle.Reset();
+    AssetRemovedHandle.Reset();
+    AssetRenamedHandle.Reset();
+
+    PathsByName.Reset();
+    bIndexBuilt = false;
+    Invalidate();
+}
+
+UBlueprint* FBlueprintResolver::Find(const FString& NameOrPath)
+{
+    check(IsInGameThread());
+
+    const FString Key = NameOrPath.TrimStartAndEnd();
+    if (Key.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    if (const TWeakObjectPtr<UBlueprint>* Cached = Resolved.Find(Key))
+    {
+        if (UBlueprint* Blueprint = Cached->Get())
+        {
+            return Blueprint;
+        }
+        Resolved.Remove(Key);
+    }
+
+    const FSoftObjectPath ObjectPath = ResolvePath(Key);
+    if (ObjectPath.IsNull())
+    {
+        return nullptr;
+    }
+
+    UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *ObjectPath.ToString());
+    if (Blueprint)
+    {
+        Resolved.Add(Key, Blueprint);
+    }
+    return Blueprint;
+}
+
+void FBlueprintResolver::Invalidate()
+{
+    Resolved.Reset();
+}
+
+bool FBlueprintResolver::Prewarm()
+{
+    return EnsureIndex();
+}
+
+bool FBlueprintResolver::EnsureIndex()
+{
+    if (bIndexBuilt)
+    {
+        return true;
+    }
+
+    IAssetRegistry* AssetRegistry = GetAssetRegistry();
+    if (!AssetRegistry || AssetRegistry->IsLoadingAssets())
+    {
+        return false;
+    }
+
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+    Filter.bRecursiveClasses = true;
+    TArray<FAssetData> Assets;
+    AssetRegistry->GetAssets(Filter, Assets);
+
+    PathsByName.Reset();
+    for (const FAssetData& AssetData : Assets)
+    {
+        IndexAsset(AssetData);
+    }
+    bIndexBuilt = true;
+    return true;
+}
+
+void FBlueprintResolver::IndexAsset(const FAssetData& AssetData)
+{
+    PathsByName.FindOrAdd(AssetData.AssetName).AddUnique(AssetData.GetSoftObjectPath());
+}
+
+void FBlueprintResolver::UnindexAsset(FName AssetName, const FSoftObjectPath& ObjectPath)
+{
+    if (TArray<FSoftObjectPath>* Paths = PathsByName.Find(AssetName))
+    {
+        Paths->Remove(ObjectPath);
+        if (Paths->Num() == 0)
+        {
+            PathsByName.Remove(AssetName);
+        }
+    }
+}
+
+FSoftObjectPath FBlueprintResolver::ResolvePath(const FString& NameOrPath)
+{
+    if (NameOrPath.StartsWith(TEXT("/")))
+    {
+        // A package path names the asset of the same name inside it.
+        if (NameOrPath.Contains(TEXT(".")))
+        {
+            return FSoftObjectPath(NameOrPath);
+        }
+        return FSoftObjectPath(NameOrPath + TEXT(".") + FPackageName::GetShortName(NameOrPath));
+    }
+
+    const FString LegacyPath = DefaultBlueprintFolder + NameOrPath;
+    if (!EnsureIndex())
+    {
+        // Until the registry has scanned the project, only the default folder can be answered.
+        return FSoftObjectPath(LegacyPath + TEXT(".") + NameOrPath);
+    }
+
+    const TArray<FSoftObjectPath>* Paths = PathsByName.Find(FName(*NameOrPath));
+    if (!Paths || Paths->Num() == 0)
+    {
+        return FSoftObjectPath();
+    }
+    if (Paths->Num() == 1)
+    {
+        return (*Paths)[0];
+    }
+
+    // Several blueprints share the name: the default folder first, then the first path, so the
+    // choice does not depend on scan order.
+    const FSoftObjectPath* Chosen = Paths->FindByPredicate([&LegacyPath](const FSoftObjectPath& Path)
+    {
+        return Path.GetLongPackageName().Equals(LegacyPath, ESearchCase::IgnoreCase);
+    });
+    if (!Chosen)
+    {
+        Chosen = &(*Paths)[0];
+        for (const FSoftObjectPath& Path : *Paths)
+        {
+            if (Path.ToString() < Chosen->ToString())
+            {
+                Chosen = &Path;
+            }
+        }
+    }
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("FBlueprintResolver: %d blueprints are named '%s'; using %s"), Paths->Num(), *NameOrPath, *Chosen->ToString());
+    return *Chosen;
+}
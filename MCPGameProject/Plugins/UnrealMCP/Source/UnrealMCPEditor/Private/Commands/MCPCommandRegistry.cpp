@@ -0,0 +1,164 @@
+#include "Commands/MCPCommandRegistry.h"
+#include "CoreMinimal.h"
+#include "Commands/ParamSchema.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Modules/ModuleManager.h"
+#include "Observability/MetricsRegistry.h"
+#include "Permissions/WriteGate.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "UnrealMCPLog.h"
+
+bool FMCPCommandDescriptor::IsMutation(const TSharedPtr<FJsonObject>& Params) const
+{
+    switch (Mutation)
+    {
+    case EMCPCommandMutation::Mutating:
+        return true;
+    case EMCPCommandMutation::ByParams:
+        return FWriteGate::IsMutationCommand(Name, Params);
+    default:
+        return false;
+    }
+}
+
+FMCPCommandDescriptor& FMCPCommandRegistry::Register(const FString& Name, FMCPCommandDescriptor::FHandler Handler)
+{
+    FMCPCommandDescriptor& Descriptor = Commands.FindOrAdd(FName(*Name));
+    Descriptor.Name = Name;
+    Descriptor.Handler = MoveTemp(Handler);
+    Descriptor.Mutation = FWriteGate::IsMutationCommand(Name, nullptr) ? EMCPCommandMutation::Mutating : EMCPCommandMutation::ReadOnly;
+    Descriptor.PathRule = Descriptor.Mutation == EMCPCommandMutation::Mutating ? EMCPPathRule::FromParams : EMCPPathRule::None;
+    Descriptor.Affinity = EMCPThreadAffinity::GameThread;
+    Descriptor.Priority = UnrealMCP::Protocol::ECommandPriority::Interactive;
+    Descriptor.bRequiresCheckout = !Name.StartsWith(TEXT("sc."));
+    Descriptor.bCacheable = false;
+    Descriptor.MutationSchema = FWriteGate::FindMutationSchema(Name);
+    Descriptor.ModuleFamily = INDEX_NONE;
+    if (Descriptor.Mutation == EMCPCommandMutation::Mutating && !Descriptor.MutationSchema)
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("FMCPCommandRegistry: Mutating command %s has no write schema; the gate will treat it as editor-only"), *Name);
+    }
+    return Descriptor;
+}
+
+const FMCPCommandDescriptor* FMCPCommandRegistry::Find(const FString& Name) const
+{
+    // FNAME_Find keeps unknown command strings out of the name table.
+    const FName Key(*Name, FNAME_Find);
+    if (Key.IsNone())
+    {
+        return nullptr;
+    }
+
+    // FName compares case-insensitively; commands (and the write gate's lists) are case-sensitive.
+    const FMCPCommandDescriptor* Descriptor = Commands.Find(Key);
+    return Descriptor && Descriptor->Name.Equals(Name, ESearchCase::CaseSensitive) ? Descriptor : nullptr;
+}
+
+int32 FMCPCommandRegistry::LoadParamSchemas(const FString& Filename)
+{
+    FString Text;
+    if (!FFileHelper::LoadFileToString(Text, *Filename))
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("FMCPCommandRegistry: No parameter schemas at %s; params are checked by the handlers only"), *Filename);
+        return 0;
+    }
+
+    TSharedPtr<FJsonObject> Root;
+    const TSharedPtr<FJsonObject>* Tools = nullptr;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || !Root->TryGetObjectField(TEXT("tools"), Tools))
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("FMCPCommandRegistry: %s is not a parameter schema file"), *Filename);
+        return 0;
+    }
+
+    int32 Applied = 0;
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Tool : (*Tools)->Values)
+    {
+        const FName Key(*Tool.Key, FNAME_Find);
+        FMCPCommandDescriptor* Descriptor = Key.IsNone() ? nullptr : Commands.Find(Key);
+        if (!Descriptor || !Descriptor->Name.Equals(Tool.Key, ESearchCase::CaseSensitive))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("FMCPCommandRegistry: Parameter schema for unknown command %s"), *Tool.Key);
+            continue;
+        }
+
+        const TSharedPtr<FJsonObject>* Schema = nullptr;
+        FString Error = TEXT("schema must be an object");
+        TSharedPtr<const FParamSchema> Compiled;
+        if (Tool.Value.IsValid() && Tool.Value->TryGetObject(Schema))
+        {
+            Compiled = FParamSchema::Compile(**Schema, Error);
+        }
+        if (!Compiled.IsValid())
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("FMCPCommandRegistry: Ignoring parameter schema for %s: %s"), *Tool.Key, *Error);
+            continue;
+        }
+
+        Descriptor->ParamSchema = MoveTemp(Compiled);
+        ++Applied;
+    }
+    return Applied;
+}
+
+void FMCPCommandRegistry::RequireModules(const FString& Prefix, TArray<FName> ModuleNames)
+{
+    const int32 Family = ModuleFamilies.Num();
+    FModuleFamily& Entry = ModuleFamilies.AddDefaulted_GetRef();
+    Entry.Prefix = Prefix;
+    Entry.ModuleNames = MoveTemp(ModuleNames);
+
+    for (TPair<FName, FMCPCommandDescriptor>& Pair : Commands)
+    {
+        if (Pair.Value.Name.StartsWith(Prefix, ESearchCase::CaseSensitive))
+        {
+            Pair.Value.ModuleFamily = Family;
+        }
+    }
+}
+
+void FMCPCommandRegistry::LoadModulesFor(const FMCPCommandDescriptor& Command)
+{
+    check(IsInGameThread());
+    if (!ModuleFamilies.IsValidIndex(Command.ModuleFamily) || ModuleFamilies[Command.ModuleFamily].bLoaded)
+    {
+        return;
+    }
+
+    LoadFamily(ModuleFamilies[Command.ModuleFamily]);
+}
+
+void FMCPCommandRegistry::LoadModuleFamilies(TFunctionRef<bool(const FString& Prefix)> ShouldLoad, TArray<FString>& OutLoaded)
+{
+    check(IsInGameThread());
+    for (FModuleFamily& Family : ModuleFamilies)
+    {
+        if (!Family.bLoaded && ShouldLoad(Family.Prefix))
+        {
+            LoadFamily(Family);
+            OutLoaded.Add(Family.Prefix);
+        }
+    }
+}
+
+void FMCPCommandRegistry::LoadFamily(FModuleFamily& Family)
+{
+    Family.bLoaded = true;
+    const double Start = FPlatformTime::Seconds();
+    for (const FName& ModuleName : Family.ModuleNames)
+    {
+        // A missing module leaves the handler to fail the way it would have without this.
+        if (!FModuleManager::Get().LoadModule(ModuleName))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("FMCPCommandRegistry: Module %s, needed by %s* commands, could not be loaded"), *ModuleName.ToString(), *Family.Prefix);
+        }
+    }
+    FMetricsRegistry::MarkStartup(*(TEXT("modules:") + Family.Prefix), Start);
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("FMCPCommandRegistry: Loaded the modules of %s* in %.1f ms"), *Family.Prefix, (FPlatformTime::Seconds() - Start) * 1000.0);
+}
@@ -0,0 +1,383 @@
+#include "Commands/ParamSchema.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+namespace
+{
+    bool ParseTypeName(const FString& Name, uint8& OutMask)
+    {
+        static const TPair<const TCHAR*, uint8> Names[] = {
+            { TEXT("null"), 1 << 0 },
+            { TEXT("boolean"), 1 << 1 },
+            { TEXT("integer"), 1 << 2 },
+            // A number schema also accepts integers.
+            { TEXT("number"), (1 << 2) | (1 << 3) },
+            { TEXT("string"), 1 << 4 },
+            { TEXT("array"), 1 << 5 },
+            { TEXT("object"), 1 << 6 },
+        };
+        for (const TPair<const TCHAR*, uint8>& Entry : Names)
+        {
+            if (Name == Entry.Key)
+            {
+                OutMask |= Entry.Value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const TCHAR* DescribeType(EJson Type)
+    {
+        switch (Type)
+        {
+        case EJson::Null:
+            return TEXT("null");
+        case EJson::Boolean:
+            return TEXT("boolean");
+        case EJson::Number:
+            return TEXT("number");
+        case EJson::String:
+            return TEXT("string");
+        case EJson::Array:
+            return TEXT("array");
+        case EJson::Object:
+            return TEXT("object");
+        default:
+            return TEXT("nothing");
+        }
+    }
+
+    FString DescribeTypes(uint8 Mask)
+    {
+        static const TCHAR* const Names[] = { TEXT("null"), TEXT("boolean"), TEXT("integer"), TEXT("number"), TEXT("string"), TEXT("array"), TEXT("object") };
+        TArray<FString> Parts;
+        for (int32 Bit = 0; Bit < UE_ARRAY_COUNT(Names); ++Bit)
+        {
+            // "number" already covers "integer".
+            if ((Mask & (1 << Bit)) && !(Bit == 2 && (Mask & (1 << 3))))
+            {
+                Parts.Add(Names[Bit]);
+            }
+        }
+        return FString::Join(Parts, TEXT(" or "));
+    }
+
+    bool TryGetCount(const FJsonObject& Schema, const TCHAR* Keyword, int32& OutCount, const FString& Path, FString& OutError)
+    {
+        if (!Schema.HasField(Keyword))
+        {
+            return true;
+        }
+        double Number = 0.0;
+        if (!Schema.TryGetNumberField(Keyword, Number) || Number < 0.0)
+        {
+            OutError = FString::Printf(TEXT("%s: %s must be a non-negative number"), *Path, Keyword);
+            return false;
+        }
+        OutCount = static_cast<int32>(FMath::Min(Number, static_cast<double>(MAX_int32)));
+        return true;
+    }
+
+    bool TryGetBound(const FJsonObject& Schema, const TCHAR* Keyword, TOptional<double>& OutBound, const FString& Path, FString& OutError)
+    {
+        if (!Schema.HasField(Keyword))
+        {
+            return true;
+        }
+        double Number = 0.0;
+        if (!Schema.TryGetNumberField(Keyword, Number))
+        {
+            OutError = FString::Printf(TEXT("%s: %s must be a number"), *Path, Keyword);
+            return false;
+        }
+        OutBound = Number;
+        return true;
+    }
+
+    FString JoinPath(const FString& Path, const FString& Key)
+    {
+        return Path.IsEmpty() ? Key : Path + TEXT(".") + Key;
+    }
+}
+
+TSharedPtr<const FParamSchema> FParamSchema::Compile(const FJsonObject& Schema, FString& OutError)
+{
+    TSharedPtr<FParamSchema> Compiled = MakeShared<FParamSchema>();
+    if (Compiled->CompileNode(Schema, TEXT("$"), OutError) == INDEX_NONE)
+    {
+        return nullptr;
+    }
+    return Compiled;
+}
+
+int32 FParamSchema::CompileNode(const FJsonObject& Schema, const FString& Path, FString& OutError)
+{
+    // Children are compiled after their parent is added, so nodes are only ever addressed by index.
+    const int32 NodeIndex = Nodes.AddDefaulted();
+    FNode Node;
+
+    if (Schema.HasField(TEXT("type")))
+    {
+        Node.Types = 0;
+        FString TypeName;
+        const TArray<TSharedPtr<FJsonValue>>* TypeNames = nullptr;
+        if (Schema.TryGetStringField(TEXT("type"), TypeName))
+        {
+            if (!ParseTypeName(TypeName, Node.Types))
+            {
+                OutError = FString::Printf(TEXT("%s: unknown type '%s'"), *Path, *TypeName);
+                return INDEX_NONE;
+            }
+        }
+        else if (Schema.TryGetArrayField(TEXT("type"), TypeNames))
+        {
+            for (const TSharedPtr<FJsonValue>& Value : *TypeNames)
+            {
+                if (!Value.IsValid() || !Value->TryGetString(TypeName) || !ParseTypeName(TypeName, Node.Types))
+                {
+                    OutError = FString::Printf(TEXT("%s: type must list known type names"), *Path);
+                    return INDEX_NONE;
+                }
+            }
+        }
+        else
+        {
+            OutError = FString::Printf(TEXT("%s: type must be a string or an array"), *Path);
+            return INDEX_NONE;
+        }
+    }
+
+    const TSharedPtr<FJsonObject>* Properties = nullptr;
+    if (Schema.TryGetObjectField(TEXT("properties"), Properties))
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Property : (*Properties)->Values)
+        {
+            const TSharedPtr<FJsonObject>* PropertySchema = nullptr;
+            if (!Property.Value.IsValid() || !Property.Value->TryGetObject(PropertySchema))
+            {
+                OutError = FString::Printf(TEXT("%s.%s: property schemas must be objects"), *Path, *Property.Key);
+                return INDEX_NONE;
+            }
+            const int32 Child = CompileNode(**PropertySchema, Path + TEXT(".") + Property.Key, OutError);
+            if (Child == INDEX_NONE)
+            {
+                return INDEX_NONE;
+            }
+            Node.Properties.Emplace(Property.Key, Child);
+        }
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Required = nullptr;
+    if (Schema.TryGetArrayField(TEXT("required"), Required))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *Required)
+        {
+            FString Name;
+            if (!Value.IsValid() || !Value->TryGetString(Name))
+            {
+                OutError = FString::Printf(TEXT("%s: required must list property names"), *Path);
+                return INDEX_NONE;
+            }
+            Node.Required.Add(MoveTemp(Name));
+        }
+    }
+
+    // An additionalProperties schema is a keyword this subset ignores; only false is enforced.
+    bool bAdditionalProperties = true;
+    if (Schema.TryGetBoolField(TEXT("additionalProperties"), bAdditionalProperties))
+    {
+        Node.bAdditionalProperties = bAdditionalProperties;
+    }
+
+    const TSharedPtr<FJsonObject>* Items = nullptr;
+    if (Schema.TryGetObjectField(TEXT("items"), Items))
+    {
+        Node.Items = CompileNode(**Items, Path + TEXT("[]"), OutError);
+        if (Node.Items == INDEX_NONE)
+        {
+            return INDEX_NONE;
+        }
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Enum = nullptr;
+    if (Schema.TryGetArrayField(TEXT("enum"), Enum))
+    {
+        Node.Enum = *Enum;
+    }
+
+    if (!TryGetBound(Schema, TEXT("minimum"), Node.Minimum, Path, OutError)
+        || !TryGetBound(Schema, TEXT("maximum"), Node.Maximum, Path, OutError)
+        || !TryGetCount(Schema, TEXT("minLength"), Node.MinLength, Path, OutError)
+        || !TryGetCount(Schema, TEXT("maxLength"), Node.MaxLength, Path, OutError)
+        || !TryGetCount(Schema, TEXT("minItems"), Node.MinItems, Path, OutError)
+        || !TryGetCount(Schema, TEXT("maxItems"), Node.MaxItems, Path, OutError))
+    {
+        return INDEX_NONE;
+    }
+
+    Nodes[NodeIndex] = MoveTemp(Node);
+    return NodeIndex;
+}
+
+bool FParamSchema::Validate(const TSharedPtr<FJsonObject>& Params, FString& OutPath, FString& OutReason) const
+{
+    if (Nodes.Num() == 0)
+    {
+        return true;
+    }
+
+    const TSharedRef<FJsonObject> Object = Params.IsValid() ? Params.ToSharedRef() : MakeShared<FJsonObject>();
+    const FJsonValueObject Value(Object);
+    return ValidateNode(0, Value, FString(), OutPath, OutReason);
+}
+
+bool FParamSchema::ValidateNode(int32 NodeIndex, const FJsonValue& Value, const FString& Path, FString& OutPath, FString& OutReason) const
+{
+    const FNode& Node = Nodes[NodeIndex];
+
+    uint8 Type = 0;
+    switch (Value.Type)
+    {
+    case EJson::Null:
+        Type = Null;
+        break;
+    case EJson::Boolean:
+        Type = Boolean;
+        break;
+    case EJson::Number:
+        Type = FMath::IsFinite(Value.AsNumber()) && FMath::FloorToDouble(Value.AsNumber()) == Value.AsNumber() ? Integer : Number;
+        break;
+    case EJson::String:
+        Type = String;
+        break;
+    case EJson::Array:
+        Type = Array;
+        break;
+    case EJson::Object:
+        Type = Object;
+        break;
+    default:
+        break;
+    }
+
+    if (!(Node.Types & Type))
+    {
+        OutPath = Path;
+        OutReason = FString::Printf(TEXT("expected %s, got %s"), *DescribeTypes(Node.Types), DescribeType(Value.Type));
+        return false;
+    }
+
+    if (Node.Enum.Num() > 0 && !Node.Enum.ContainsByPredicate([&Value](const TSharedPtr<FJsonValue>& Allowed)
+        {
+            return Allowed.IsValid() && FJsonValue::CompareEqual(*Allowed, Value);
+        }))
+    {
+        OutPath = Path;
+        OutReason = TEXT("is not one of the allowed values");
+        return false;
+    }
+
+    switch (Value.Type)
+    {
+    case EJson::Number:
+    {
+        const double Number = Value.AsNumber();
+        if ((Node.Minimum.IsSet() && Number < Node.Minimum.GetValue()) || (Node.Maximum.IsSet() && Number > Node.Maximum.GetValue()))
+        {
+            OutPath = Path;
+            OutReason = Node.Minimum.IsSet() && Number < Node.Minimum.GetValue()
+                ? FString::Printf(TEXT("must be at least %g"), Node.Minimum.GetValue())
+                : FString::Printf(TEXT("must be at most %g"), Node.Maximum.GetValue());
+            return false;
+        }
+        return true;
+    }
+    case EJson::String:
+    {
+        const int32 Length = Value.AsString().Len();
+        if (Length < Node.MinLength || Length > Node.MaxLength)
+        {
+            OutPath = Path;
+            OutReason = Length < Node.MinLength
+                ? FString::Printf(TEXT("must be at least %d characters"), Node.MinLength)
+                : FString::Printf(TEXT("must be at most %d characters"), Node.MaxLength);
+            return false;
+        }
+        return true;
+    }
+    case EJson::Array:
+    {
+        const TArray<TSharedPtr<FJsonValue>>& Elements = Value.AsArray();
+        if (Elements.Num() < Node.MinItems || Elements.Num() > Node.MaxItems)
+        {
+            OutPath = Path;
+            OutReason = Elements.Num() < Node.MinItems
+                ? FString::Printf(TEXT("must have at least %d items"), Node.MinItems)
+                : FString::Printf(TEXT("must have at most %d items"), Node.MaxItems);
+            return false;
+        }
+        if (Node.Items != INDEX_NONE)
+        {
+            const FJsonValueNull Missing;
+            for (int32 Index = 0; Index < Elements.Num(); ++Index)
+            {
+                const FJsonValue& Element = Elements[Index].IsValid() ? *Elements[Index] : static_cast<const FJsonValue&>(Missing);
+                if (!ValidateNode(Node.Items, Element, FString::Printf(TEXT("%s[%d]"), *Path, Index), OutPath, OutReason))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    case EJson::Object:
+    {
+        const TSharedPtr<FJsonObject>& Object = Value.AsObject();
+        return !Object.IsValid() || ValidateObject(Node, *Object, Path, OutPath, OutReason);
+    }
+    default:
+        return true;
+    }
+}
+
+bool FParamSchema::ValidateObject(const FNode& Node, const FJsonObject& Object, const FString& Path, FString& OutPath, FString& OutReason) const
+{
+    for (const FString& Name : Node.Required)
+    {
+        if (!Object.Values.Contains(Name))
+        {
+            OutPath = JoinPath(Path, Name);
+            OutReason = TEXT("is required");
+            return false;
+        }
+    }
+
+    for (const TPair<FString, int32>& Property : Node.Properties)
+    {
+        if (const TSharedPtr<FJsonValue>* Field = Object.Values.Find(Property.Key))
+        {
+            if (Field->IsValid() && !ValidateNode(Property.Value, **Field, JoinPath(Path, Property.Key), OutPath, OutReason))
+            {
+                return false;
+            }
+        }
+    }
+
+    if (!Node.bAdditionalProperties)
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+        {
+            if (!Node.Properties.ContainsByPredicate([&Field](const TPair<FString, int32>& Property) { return Property.Key == Field.Key; }))
+            {
+                OutPath = JoinPath(Path, Field.Key);
+                OutReason = TEXT("is not an allowed parameter");
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,420 @@
+#include "Commands/PropertyPathCache.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "JsonObjectConverter.h"
+#include "UObject/Class.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+    typedef FPropertyPathCache::FCompiledPath FCompiledPath;
+
+    /** Number from a JSON number or numeric string. */
+    bool TryGetNumber(const TSharedPtr<FJsonValue>& Value, double& OutNumber)
+    {
+        return Value.IsValid() && Value->TryGetNumber(OutNumber);
+    }
+
+    /** Three numbers from [a, b, c]. */
+    bool TryGetTriple(const TSharedPtr<FJsonValue>& Value, double& OutA, double& OutB, double& OutC)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Array = nullptr;
+        return Value.IsValid() && Value->TryGetArray(Array) && Array->Num() == 3
+            && TryGetNumber((*Array)[0], OutA) && TryGetNumber((*Array)[1], OutB) && TryGetNumber((*Array)[2], OutC);
+    }
+
+    bool SetGeneric(const FCompiledPath& Path, void* ValuePtr, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+    {
+        if (Value.IsValid() && FJsonObjectConverter::JsonValueToUProperty(Value, const_cast<FProperty*>(Path.Leaf), ValuePtr, 0, 0))
+        {
+            return true;
+        }
+        OutError = FString::Printf(TEXT("Cannot convert value for %s property %s"), *Path.Leaf->GetCPPType(), *Path.Leaf->GetName());
+        return false;
+    }
+
+    TSharedPtr<FJsonValue> GetGeneric(const FCompiledPath& Path, const void* ValuePtr)
+    {
+        TSharedPtr<FJsonValue> Value = FJsonObjectConverter::UPropertyToJsonValue(const_cast<FProperty*>(Path.Leaf), ValuePtr, 0, 0);
+        return Value.IsValid() ? Value : MakeShared<FJsonValueNull>();
+    }
+
+    bool SetBool(const FCompiledPath& Path, void* ValuePtr, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+    {
+        bool bValue = false;
+        if (!Value.IsValid() || !Value->TryGetBool(bValue))
+        {
+            double Number = 0.0;
+            if (!TryGetNumber(Value, Number))
+            {
+                OutError = FString::Printf(TEXT("Property %s requires a boolean"), *Path.Leaf->GetName());
+                return false;
+            }
+            bValue = Number != 0.0;
+        }
+        static_cast<const FBoolProperty*>(Path.Leaf)->SetPropertyValue(ValuePtr, bValue);
+        return true;
+    }
+
+    TSharedPtr<FJsonValue> GetBool(const FCompiledPath& Path, const void* ValuePtr)
+    {
+        return MakeShared<FJsonValueBoolean>(static_cast<const FBoolProperty*>(Path.Leaf)->GetPropertyValue(ValuePtr));
+    }
+
+    bool SetInteger(const FCompiledPath& Path, void* ValuePtr, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+    {
+        double Number = 0.0;
+        if (!TryGetNumber(Value, Number))
+        {
+            OutError = FString::Printf(TEXT("Property %s requires a number"), *Path.Leaf->GetName());
+            return false;
+        }
+        static_cast<const FNumericProperty*>(Path.Leaf)->SetIntPropertyValue(ValuePtr, static_cast<int64>(Number));
+        return true;
+    }
+
+    TSharedPtr<FJsonValue> GetInteger(const FCompiledPath& Path, const void* ValuePtr)
+    {
+        return MakeShared<FJsonValueNumber>(static_cast<double>(static_cast<const FNumericProperty*>(Path.Leaf)->GetSignedIntPropertyValue(ValuePtr)));
+    }
+
+    bool SetFloat(const FCompiledPath& Path, void* ValuePtr, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+    {
+        double Number = 0.0;
+        if (!TryGetNumber(Value, Number))
+        {
+            OutError = FString::Printf(TEXT("Property %s requires a number"), *Path.Leaf->GetName());
+            return false;
+        }
+        static_cast<const FNumericProperty*>(Path.Leaf)->SetFloatingPointPropertyValue(ValuePtr, Number);
+        return true;
+    }
+
+    TSharedPtr<FJsonValue> GetFloat(const FCompiledPath& Path, const void* ValuePtr)
+    {
+        return MakeShared<FJsonValueNumber>(static_cast<const FNumericProperty*>(Path.Leaf)->GetFloatingPointPropertyValue(ValuePtr));
+    }
+
+    /** The enum and the integer property holding its value, for FEnumProperty and enum-backed FByteProperty leaves. */
+    void GetEnumParts(const FProperty* Leaf, const UEnum*& OutEnum, const FNumericProperty*& OutUnderlying)
+    {
+        if (const FEnumProperty* EnumProperty = CastField<const FEnumProperty>(Leaf))
+        {
+            OutEnum = EnumProperty->GetEnum();
+            OutUnderlying = EnumProperty->GetUnderlyingProperty();
+        }
+        else
+        {
+            OutUnderlying = CastField<const FByteProperty>(Leaf);
+            OutEnum = OutUnderlying ? static_cast<const FByteProperty*>(OutUnderlying)->GetIntPropertyEnum() : nullptr;
+        }
+    }
+
+    bool SetEnum(const FCompiledPath& Path, void* ValuePtr, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+    {
+        const UEnum* Enum = nullptr;
+        const FNumericProperty* Underlying = nullptr;
+        GetEnumParts(Path.Leaf, Enum, Underlying);
+
+        FString Name;
+        if (Value.IsValid() && Value->Type == EJson::String && Value->TryGetString(Name) && !Name.IsNumeric())
+        {
+            // Qualified names ("EAutoReceiveInput::Player0") are matched by their last part first.
+            FString ShortName = Name;
+            if (ShortName.Contains(TEXT("::")))
+            {
+                ShortName.Split(TEXT("::"), nullptr, &ShortName);
+            }
+            int64 EnumValue = Enum->GetValueByNameString(ShortName);
+            if (EnumValue == INDEX_NONE)
+            {
+                EnumValue = Enum->GetValueByNameString(Name);
+            }
+            if (EnumValue == INDEX_NONE)
+            {
+                OutError = FString::Printf(TEXT("Could not find enum value for '%s'"), *ShortName);
+                return false;
+            }
+            Underlying->SetIntPropertyValue(ValuePtr, EnumValue);
+            return true;
+        }
+
+        double Number = 0.0;
+        if (!TryGetNumber(Value, Number))
+        {
+            OutError = FString::Printf(TEXT("Enum property %s requires a name or a number"), *Path.Leaf->GetName());
+            return false;
+        }
+        Underlying->SetIntPropertyValue(ValuePtr, static_cast<int64>(Number));
+        return true;
+    }
+
+    TSharedPtr<FJsonValue> GetEnum(const FCompiledPath& Path, const void* ValuePtr)
+    {
+        const UEnum* Enum = nullptr;
+        const FNumericProperty* Underlying = nullptr;
+        GetEnumParts(Path.Leaf, Enum, Underlying);
+        return MakeShared<FJsonValueString>(Enum->GetNameStringByValue(Underlying->GetSignedIntPropertyValue(ValuePtr)));
+    }
+
+    bool SetString(const FCompiledPath& Path, void* ValuePtr, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+    {
+        FString String;
+        if (!Value.IsValid() || !Value->TryGetString(String))
+        {
+            OutError = FString::Printf(TEXT("Property %s requires a string"), *Path.Leaf->GetName());
+            return false;
+        }
+        if (Path.Leaf->IsA<FStrProperty>())
+        {
+            *static_cast<FString*>(ValuePtr) = MoveTemp(String);
+        }
+        else if (Path.Leaf->IsA<FNameProperty>())
+        {
+            *static_cast<FName*>(ValuePtr) = FName(*String);
+        }
+        else
+        {
+            *static_cast<FText*>(ValuePtr) = FText::FromString(String);
+        }
+        return true;
+    }
+
+    TSharedPtr<FJsonValue> GetString(const FCompiledPath& Path, const void* ValuePtr)
+    {
+        if (Path.Leaf->IsA<FStrProperty>())
+        {
+            return MakeShared<FJsonValueString>(*static_cast<const FString*>(ValuePtr));
+        }
+        if (Path.Leaf->IsA<FNameProperty>())
+        {
+            return MakeShared<FJsonValueString>(static_cast<const FName*>(ValuePtr)->ToString());
+        }
+        return MakeShared<FJsonValueString>(static_cast<const FText*>(ValuePtr)->ToString());
+    }
+
+    /** FVector from [x, y, z] (or any form the converter accepts), written in place. */
+    bool SetVector(const FCompiledPath& Path, void* ValuePtr, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+    {
+        double X, Y, Z;
+        if (TryGetTriple(Value, X, Y, Z))
+        {
+            *static_cast<FVector*>(ValuePtr) = FVector(X, Y, Z);
+            return true;
+        }
+        return SetGeneric(Path, ValuePtr, Value, OutError);
+    }
+
+    TSharedPtr<FJsonValue> GetVector(const FCompiledPath& Path, const void* ValuePtr)
+    {
+        const FVector& Vector = *static_cast<const FVector*>(ValuePtr);
+        TArray<TSharedPtr<FJsonValue>> Array;
+        Array.Add(MakeShared<FJsonValueNumber>(Vector.X));
+        Array.Add(MakeShared<FJsonValueNumber>(Vector.Y));
+        Array.Add(MakeShared<FJsonValueNumber>(Vector.Z));
+        return MakeShared<FJsonValueArray>(Array);
+    }
+
+    /** FRotator from [pitch, yaw, roll] (or any form the converter accepts), written in place. */
+    bool SetRotator(const FCompiledPath& Path, void* ValuePtr, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+    {
+        double Pitch, Yaw, Roll;
+        if (TryGetTriple(Value, Pitch, Yaw, Roll))
+        {
+            *static_cast<FRotator*>(ValuePtr) = FRotator(Pitch, Yaw, Roll);
+            return true;
+        }
+        return SetGeneric(Path, ValuePtr, Value, OutError);
+    }
+
+    TSharedPtr<FJsonValue> GetRotator(const FCompiledPath& Path, const void* ValuePtr)
+    {
+        const FRotator& Rotator = *static_cast<const FRotator*>(ValuePtr);
+        TArray<TSharedPtr<FJsonValue>> Array;
+        Array.Add(MakeShared<FJsonValueNumber>(Rotator.Pitch));
+        Array.Add(MakeShared<FJsonValueNumber>(Rotator.Yaw));
+        Array.Add(MakeShared<FJsonValueNumber>(Rotator.Roll));
+        return MakeShared<FJsonValueArray>(Array);
+    }
+
+    /** Picks the leaf's thunks once, so a set does not walk the type checks again. */
+    void BindAccessors(FCompiledPath& Path)
+    {
+        const FProperty* Leaf = Path.Leaf;
+        const FStructProperty* StructProperty = CastField<const FStructProperty>(Leaf);
+        const UEnum* Enum = nullptr;
+        const FNumericProperty* Underlying = nullptr;
+        GetEnumParts(Leaf, Enum, Underlying);
+
+        if (Leaf->IsA<FBoolProperty>())
+        {
+            Path.Setter = &SetBool;
+            Path.Getter = &GetBool;
+        }
+        else if (Enum && Underlying)
+        {
+            Path.Setter = &SetEnum;
+            Path.Getter = &GetEnum;
+        }
+        else if (const FNumericProperty* Numeric = CastField<const FNumericProperty>(Leaf))
+        {
+            Path.Setter = Numeric->IsFloatingPoint() ? &SetFloat : &SetInteger;
+            Path.Getter = Numeric->IsFloatingPoint() ? &GetFloat : &GetInteger;
+        }
+        else if (Leaf->IsA<FStrProperty>() || Leaf->IsA<FNameProperty>() || Leaf->IsA<FTextProperty>())
+        {
+            Path.Setter = &SetString;
+            Path.Getter = &GetString;
+        }
+        else if (StructProperty && StructProperty->Struct == TBaseStructure<FVector>::Get())
+        {
+            Path.Setter = &SetVector;
+            Path.Getter = &GetVector;
+        }
+        else if (StructProperty && StructProperty->Struct == TBaseStructure<FRotator>::Get())
+        {
+            Path.Setter = &SetRotator;
+            Path.Getter = &GetRotator;
+        }
+        else
+        {
+            Path.Setter = &SetGeneric;
+            Path.Getter = &GetGeneric;
+        }
+    }
+}
+
+FPropertyPathCache& FPropertyPathCache::Get()
+{
+    static FPropertyPathCache Cache;
+    return Cache;
+}
+
+void FPropertyPathCache::Start()
+{
+    check(IsInGameThread());
+    if (ReloadHandle.IsValid())
+    {
+        return;
+    }
+
+    ReloadHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+    {
+        Invalidate();
+    });
+    ReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([this](const FCoreUObjectDelegates::FReplacementObjectMap&)
+    {
+        Invalidate();
+    });
+    if (GEditor)
+    {
+        // A Blueprint compile rebuilds its class's properties in place, so the class stays valid.
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddLambda([this]()
+        {
+            Invalidate();
+        });
+    }
+}
+
+void FPropertyPathCache::Stop()
+{
+    if (ReloadHandle.IsValid())
+    {
+        FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadHandle);
+        FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ReinstancedHandle);
+    }
+    if (GEditor && BlueprintCompiledHandle.IsValid())
+    {
+        GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+    }
+    ReloadHandle.Reset();
+    ReinstancedHandle.Reset();
+    BlueprintCompiledHandle.Reset();
+    Invalidate();
+}
+
+void FPropertyPathCache::Invalidate()
+{
+    Entries.Reset();
+}
+
+const FPropertyPathCache::FCompiledPath* FPropertyPathCache::Resolve(const UClass* Class, const FString& Path, FString& OutError)
+{
+    if (!Class)
+    {
+        OutError = TEXT("Invalid object");
+        return nullptr;
+    }
+
+    FKey Key;
+    Key.Class = Class;
+    Key.Path = Path;
+    if (const TUniquePtr<FCompiledPath>* Found = Entries.Find(Key))
+    {
+        // A class released and another allocated at its address must not reuse the old layout.
+        if ((*Found)->Class.Get() == Class)
+        {
+            return Found->Get();
+        }
+        Entries.Remove(Key);
+    }
+
+    TUniquePtr<FCompiledPath> Compiled = MakeUnique<FCompiledPath>();
+    if (!Compile(Class, Path, *Compiled, OutError))
+    {
+        return nullptr;
+    }
+
+    if (Entries.Num() >= MaxEntries)
+    {
+        Entries.Reset();
+    }
+    return Entries.Add(MoveTemp(Key), MoveTemp(Compiled)).Get();
+}
+
+bool FPropertyPathCache::Compile(const UClass* Class, const FString& Path, FCompiledPath& OutPath, FString& OutError)
+{
+    TArray<FString> Segments;
+    Path.ParseIntoArray(Segments, TEXT("."));
+    if (Segments.Num() == 0)
+    {
+        OutError = FString::Printf(TEXT("Property not found: %s"), *Path);
+        return false;
+    }
+
+    const UStruct* Scope = Class;
+    for (int32 Index = 0; Index < Segments.Num(); ++Index)
+    {
+        const FProperty* Property = Scope->FindPropertyByName(FName(*Segments[Index]));
+        if (!Property)
+        {
+            OutError = FString::Printf(TEXT("Property not found: %s"), *Path);
+            return false;
+        }
+
+        OutPath.Chain.Add(Property);
+        OutPath.Offset += Property->GetOffset_ForInternal();
+        if (Index + 1 < Segments.Num())
+        {
+            // Only inline structs share the object's memory; pointers and containers would need
+            // a per-object walk, which is what the cache exists to avoid.
+            const FStructProperty* StructProperty = CastField<const FStructProperty>(Property);
+            if (!StructProperty)
+            {
+                OutError = FString::Printf(TEXT("%s is not a struct property, so %s cannot be resolved"), *Property->GetName(), *Path);
+                return false;
+            }
+            Scope = StructProperty->Struct;
+        }
+    }
+
+    OutPath.Class = Class;
+    OutPath.Leaf = OutPath.Chain.Last();
+    BindAccessors(OutPath);
+    return true;
+}
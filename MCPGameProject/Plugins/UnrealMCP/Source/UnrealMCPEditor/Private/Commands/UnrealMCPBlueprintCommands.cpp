@@ -1,6 +1,9 @@
 #include "Commands/UnrealMCPBlueprintCommands.h"
 #include "CoreMinimal.h"
+#include "Commands/BlueprintCompileQueue.h"
+#include "Commands/MCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/PropertyPathCache.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Factories/BlueprintFactory.h"
@@ -69,6 +72,18 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCommand(const FString
     return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint command: %s"), *CommandType));
 }
 
+void FUnrealMCPBlueprintCommands::RegisterCommands(FMCPCommandRegistry& Registry)
+{
+    Registry.Register(TEXT("create_blueprint"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleCreateBlueprint(Params); });
+    Registry.Register(TEXT("add_component_to_blueprint"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddComponentToBlueprint(Params); });
+    Registry.Register(TEXT("set_component_property"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetComponentProperty(Params); });
+    Registry.Register(TEXT("set_physics_properties"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetPhysicsProperties(Params); });
+    Registry.Register(TEXT("compile_blueprint"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleCompileBlueprint(Params); });
+    Registry.Register(TEXT("set_blueprint_property"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetBlueprintProperty(Params); });
+    Registry.Register(TEXT("set_static_mesh_properties"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetStaticMeshProperties(Params); });
+    Registry.Register(TEXT("set_pawn_properties"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetPawnProperties(Params); });
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCreateBlueprint(const TSharedPtr<FJsonObject>& Params)
 {
     // Get required parameters
@@ -268,8 +283,9 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleAddComponentToBluepri
         // Add to root if no parent specified
         Blueprint->SimpleConstructionScript->AddNode(NewNode);
 
-        // Compile the blueprint
-        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+        // Compiled once the edits to this blueprint settle, not after every component
+        FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+        FBlueprintCompileQueue::Get().Request(Blueprint);
 
         TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
         ResultObj->SetStringField(TEXT("component_name"), ComponentName);
@@ -533,9 +549,10 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
     {
         TSharedPtr<FJsonValue> JsonValue = Params->Values.FindRef(TEXT("property_value"));
         
-        // Get the property
-        FProperty* Property = FindFProperty<FProperty>(ComponentTemplate->GetClass(), *PropertyName);
-        if (!Property)
+        // Resolved and typed once per class and path; nested struct fields ("RelativeLocation.X") included.
+        FString ErrorMessage;
+        const FPropertyPathCache::FCompiledPath* Path = FPropertyPathCache::Get().Resolve(ComponentTemplate->GetClass(), PropertyName, ErrorMessage);
+        if (!Path)
         {
             UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Property %s not found on component %s"), 
                 *PropertyName, *ComponentName);
@@ -548,201 +565,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                 UE_LOG(LogTemp, Warning, TEXT("  - %s (%s)"), *Prop->GetName(), *Prop->GetCPPType());
             }
             
-            return FUnrealMCPCommonUtils::CreateErrorResponse(
-                FString::Printf(TEXT("Property %s not found on component %s"), *PropertyName, *ComponentName));
-        }
-        else
-        {
-            UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property found: %s (Type: %s)"), 
-                *PropertyName, *Property->GetCPPType());
+            return FUnrealMCPCommonUtils::CreateErrorResponse(PropertyName.Contains(TEXT("."))
+                ? ErrorMessage
+                : FString::Printf(TEXT("Property %s not found on component %s"), *PropertyName, *ComponentName));
         }
 
-        bool bSuccess = false;
-        FString ErrorMessage;
-
-        // Handle different property types
-        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Attempting to set property %s"), *PropertyName);
-        
-        // Add try-catch block to catch and log any crashes
-        try
-        {
-            if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
-            {
-                // Handle vector properties
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property is a struct: %s"), 
-                    StructProp->Struct ? *StructProp->Struct->GetName() : TEXT("NULL"));
-                    
-                if (StructProp->Struct == TBaseStructure<FVector>::Get())
-                {
-                    if (JsonValue->Type == EJson::Array)
-                    {
-                        // Handle array input [x, y, z]
-                        const TArray<TSharedPtr<FJsonValue>>& Arr = JsonValue->AsArray();
-                        if (Arr.Num() == 3)
-                        {
-                            FVector Vec(
-                                Arr[0]->AsNumber(),
-                                Arr[1]->AsNumber(),
-                                Arr[2]->AsNumber()
-                            );
-                            void* PropertyAddr = StructProp->ContainerPtrToValuePtr<void>(ComponentTemplate);
-                            UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting Vector(%f, %f, %f)"), 
-                                Vec.X, Vec.Y, Vec.Z);
-                            StructProp->CopySingleValue(PropertyAddr, &Vec);
-                            bSuccess = true;
-                        }
-                        else
-                        {
-                            ErrorMessage = FString::Printf(TEXT("Vector property requires 3 values, got %d"), Arr.Num());
-                            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
-                        }
-                    }
-                    else if (JsonValue->Type == EJson::Number)
-                    {
-                        // Handle scalar input (sets all components to same value)
-                        float Value = JsonValue->AsNumber();
-                        FVector Vec(Value, Value, Value);
-                        void* PropertyAddr = StructProp->ContainerPtrToValuePtr<void>(ComponentTemplate);
-                        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting Vector(%f, %f, %f) from scalar"), 
-                            Vec.X, Vec.Y, Vec.Z);
-                        StructProp->CopySingleValue(PropertyAddr, &Vec);
-                        bSuccess = true;
-                    }
-                    else
-                    {
-                        ErrorMessage = TEXT("Vector property requires either a single number or array of 3 numbers");
-                        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
-                    }
-                }
-                else
-                {
-                    // Handle other struct properties using default handler
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Using generic struct handler for %s"), 
-                        *PropertyName);
-                    bSuccess = FUnrealMCPCommonUtils::SetObjectProperty(ComponentTemplate, PropertyName, JsonValue, ErrorMessage);
-                    if (!bSuccess)
-                    {
-                        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Failed to set struct property: %s"), *ErrorMessage);
-                    }
-                }
-            }
-            else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
-            {
-                // Handle enum properties
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property is an enum"));
-                if (JsonValue->Type == EJson::String)
-                {
-                    FString EnumValueName = JsonValue->AsString();
-                    UEnum* Enum = EnumProp->GetEnum();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting enum from string: %s"), *EnumValueName);
-                    
-                    if (Enum)
-                    {
-                        int64 EnumValue = Enum->GetValueByNameString(EnumValueName);
-                        
-                        if (EnumValue != INDEX_NONE)
-                        {
-                            UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Found enum value: %lld"), EnumValue);
-                            EnumProp->GetUnderlyingProperty()->SetIntPropertyValue(
-                                ComponentTemplate, 
-                                EnumValue
-                            );
-                            bSuccess = true;
-                        }
-                        else
-                        {
-                            // List all possible enum values
-                            UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - Available enum values for %s:"), 
-                                *Enum->GetName());
-                            for (int32 i = 0; i < Enum->NumEnums(); i++)
-                            {
-                                UE_LOG(LogTemp, Warning, TEXT("  - %s (%lld)"), 
-                                    *Enum->GetNameStringByIndex(i),
-                                    Enum->GetValueByIndex(i));
-                            }
-                            
-                            ErrorMessage = FString::Printf(TEXT("Invalid enum value '%s' for property %s"), 
-                                *EnumValueName, *PropertyName);
-                            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
-                        }
-                    }
-                    else
-                    {
-                        ErrorMessage = TEXT("Enum object is NULL");
-                        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
-                    }
-                }
-                else if (JsonValue->Type == EJson::Number)
-                {
-                    // Allow setting enum by integer value
-                    int64 EnumValue = JsonValue->AsNumber();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting enum from number: %lld"), EnumValue);
-                    EnumProp->GetUnderlyingProperty()->SetIntPropertyValue(
-                        ComponentTemplate, 
-                        EnumValue
-                    );
-                    bSuccess = true;
-                }
-                else
-                {
-                    ErrorMessage = TEXT("Enum property requires either a string name or integer value");
-                    UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
-                }
-            }
-            else if (FNumericProperty* NumericProp = CastField<FNumericProperty>(Property))
-            {
-                // Handle numeric properties
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property is numeric: IsInteger=%d, IsFloat=%d"), 
-                    NumericProp->IsInteger(), NumericProp->IsFloatingPoint());
-                    
-                if (JsonValue->Type == EJson::Number)
-                {
-                    double Value = JsonValue->AsNumber();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting numeric value: %f"), Value);
-                    
-                    if (NumericProp->IsInteger())
-                    {
-                        NumericProp->SetIntPropertyValue(ComponentTemplate, (int64)Value);
-                        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Set integer value: %lld"), (int64)Value);
-                        bSuccess = true;
-                    }
-                    else if (NumericProp->IsFloatingPoint())
-                    {
-                        NumericProp->SetFloatingPointPropertyValue(ComponentTemplate, Value);
-                        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Set float value: %f"), Value);
-                        bSuccess = true;
-                    }
-                }
-                else
-                {
-                    ErrorMessage = TEXT("Numeric property requires a number value");
-                    UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
-                }
-            }
-            else
-            {
-                // Handle all other property types using default handler
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Using generic property handler for %s (Type: %s)"), 
-                    *PropertyName, *Property->GetCPPType());
-                bSuccess = FUnrealMCPCommonUtils::SetObjectProperty(ComponentTemplate, PropertyName, JsonValue, ErrorMessage);
-                if (!bSuccess)
-                {
-                    UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Failed to set property: %s"), *ErrorMessage);
-                }
-            }
-        }
-        catch (const std::exception& Ex)
-        {
-            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - EXCEPTION: %s"), ANSI_TO_TCHAR(Ex.what()));
-            return FUnrealMCPCommonUtils::CreateErrorResponse(
-                FString::Printf(TEXT("Exception while setting property %s: %s"), *PropertyName, ANSI_TO_TCHAR(Ex.what())));
-        }
-        catch (...)
-        {
-            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - UNKNOWN EXCEPTION occurred while setting property %s"), *PropertyName);
-            return FUnrealMCPCommonUtils::CreateErrorResponse(
-                FString::Printf(TEXT("Unknown exception while setting property %s"), *PropertyName));
-        }
+        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property found: %s (Type: %s)"), 
+            *PropertyName, *Path->Leaf->GetCPPType());
+        const bool bSuccess = Path->SetValue(ComponentTemplate, JsonValue, ErrorMessage);
 
         if (bSuccess)
         {
@@ -861,10 +691,29 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCompileBlueprint(cons
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
 
-    // Compile the blueprint
-    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    // "skeleton" only brings the skeleton class up to date, for graph building between full compiles
+    FString Mode = TEXT("full");
+    Params->TryGetStringField(TEXT("mode"), Mode);
+    if (Mode == TEXT("skeleton"))
+    {
+        FBlueprintCompileQueue::Get().RegenerateSkeleton(Blueprint);
 
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetStringField(TEXT("name"), BlueprintName);
+        ResultObj->SetBoolField(TEXT("compiled"), false);
+        ResultObj->SetStringField(TEXT("mode"), Mode);
+        ResultObj->SetBoolField(TEXT("pending"), FBlueprintCompileQueue::Get().IsPending(Blueprint));
+        return ResultObj;
+    }
+    if (Mode != TEXT("full"))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown compile mode '%s' (full or skeleton)"), *Mode));
+    }
+
+    // Compile the blueprint, along with any deferred edits to it
+    const FBlueprintCompileQueue::FReport Report = FBlueprintCompileQueue::Get().Compile(Blueprint);
+
+    TSharedPtr<FJsonObject> ResultObj = Report.ToJson();
     ResultObj->SetStringField(TEXT("name"), BlueprintName);
     ResultObj->SetBoolField(TEXT("compiled"), true);
     return ResultObj;
@@ -892,6 +741,9 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSpawnBlueprintActor(c
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
 
+    // Pending edits have to be compiled into the generated class first
+    FBlueprintCompileQueue::Get().Flush(Blueprint);
+
     // Get transform parameters
     FVector Location(0.0f, 0.0f, 0.0f);
     FRotator Rotation(0.0f, 0.0f, 0.0f);
@@ -948,6 +800,9 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetBlueprintProperty(
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
 
+    // Pending edits have to be compiled into the generated class first
+    FBlueprintCompileQueue::Get().Flush(Blueprint);
+
     // Get the default object
     UObject* DefaultObject = Blueprint->GeneratedClass->GetDefaultObject();
     if (!DefaultObject)
@@ -1069,6 +924,9 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetPawnProperties(con
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
 
+    // Pending edits have to be compiled into the generated class first
+    FBlueprintCompileQueue::Get().Flush(Blueprint);
+
     // Get the default object
     UObject* DefaultObject = Blueprint->GeneratedClass->GetDefaultObject();
     if (!DefaultObject)
@@ -1,5 +1,8 @@
 #include "Commands/UnrealMCPBlueprintNodeCommands.h"
 #include "CoreMinimal.h"
+#include "Commands/BlueprintCompileQueue.h"
+#include "Commands/BlueprintGraphIndex.h"
+#include "Commands/MCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
@@ -9,6 +12,7 @@
 #include "K2Node_Event.h"
 #include "K2Node_CallFunction.h"
 #include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
 #include "K2Node_InputAction.h"
 #include "K2Node_Self.h"
 #include "Kismet2/BlueprintEditorUtils.h"
@@ -19,6 +23,51 @@
 #include "EdGraphSchema_K2.h"
 #include "UnrealMCPLog.h"
 
+namespace
+{
+    /** Node and edge caps for one blueprint.graph_patch; a hand-built graph is a few hundred nodes. */
+    constexpr int32 MaxPatchNodes = 2000;
+    constexpr int32 MaxPatchEdges = 8000;
+
+    /** The field each graph_patch node type requires, or null for an unknown type. */
+    const TCHAR* GetPatchNodeKeyField(const FString& Type)
+    {
+        if (Type == TEXT("event"))
+        {
+            return TEXT("event_name");
+        }
+        if (Type == TEXT("function"))
+        {
+            return TEXT("function_name");
+        }
+        if (Type == TEXT("input_action"))
+        {
+            return TEXT("action_name");
+        }
+        if (Type == TEXT("component"))
+        {
+            return TEXT("component_name");
+        }
+        if (Type == TEXT("variable_get") || Type == TEXT("variable_set"))
+        {
+            return TEXT("variable_name");
+        }
+        if (Type == TEXT("self"))
+        {
+            return TEXT("");
+        }
+        return nullptr;
+    }
+
+    TSharedPtr<FJsonObject> MakePatchFailure(const TCHAR* Kind, const TSharedPtr<FJsonValue>& Key, const FString& Error)
+    {
+        TSharedPtr<FJsonObject> Failure = MakeShared<FJsonObject>();
+        Failure->SetField(Kind, Key);
+        Failure->SetStringField(TEXT("error"), Error);
+        return Failure;
+    }
+}
+
 FUnrealMCPBlueprintNodeCommands::FUnrealMCPBlueprintNodeCommands()
 {
 }
@@ -57,10 +106,27 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleCommand(const FSt
     {
         return HandleFindBlueprintNodes(Params);
     }
+    else if (CommandType == TEXT("blueprint.graph_patch"))
+    {
+        return HandleGraphPatch(Params);
+    }
     
     return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint node command: %s"), *CommandType));
 }
 
+void FUnrealMCPBlueprintNodeCommands::RegisterCommands(FMCPCommandRegistry& Registry)
+{
+    Registry.Register(TEXT("connect_blueprint_nodes"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleConnectBlueprintNodes(Params); });
+    Registry.Register(TEXT("add_blueprint_get_self_component_reference"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddBlueprintGetSelfComponentReference(Params); });
+    Registry.Register(TEXT("add_blueprint_self_reference"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddBlueprintSelfReference(Params); });
+    Registry.Register(TEXT("find_blueprint_nodes"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleFindBlueprintNodes(Params); }).bCacheable = true;
+    Registry.Register(TEXT("add_blueprint_event_node"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddBlueprintEvent(Params); });
+    Registry.Register(TEXT("add_blueprint_input_action_node"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddBlueprintInputActionNode(Params); });
+    Registry.Register(TEXT("add_blueprint_function_node"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddBlueprintFunctionCall(Params); });
+    Registry.Register(TEXT("add_blueprint_variable"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddBlueprintVariable(Params); });
+    Registry.Register(TEXT("blueprint.graph_patch"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleGraphPatch(Params); });
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleConnectBlueprintNodes(const TSharedPtr<FJsonObject>& Params)
 {
     // Get required parameters
@@ -109,19 +175,8 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleConnectBlueprintN
     }
 
     // Find the nodes
-    UEdGraphNode* SourceNode = nullptr;
-    UEdGraphNode* TargetNode = nullptr;
-    for (UEdGraphNode* Node : EventGraph->Nodes)
-    {
-        if (Node->NodeGuid.ToString() == SourceNodeId)
-        {
-            SourceNode = Node;
-        }
-        else if (Node->NodeGuid.ToString() == TargetNodeId)
-        {
-            TargetNode = Node;
-        }
-    }
+    UEdGraphNode* SourceNode = FBlueprintGraphIndex::Get().FindNode(EventGraph, SourceNodeId);
+    UEdGraphNode* TargetNode = FBlueprintGraphIndex::Get().FindNode(EventGraph, TargetNodeId);
 
     if (!SourceNode || !TargetNode)
     {
@@ -180,12 +235,27 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintGetSe
     }
     
     // We'll skip component verification since the GetAllNodes API may have changed in UE5.5
+    UK2Node_VariableGet* GetComponentNode = AddComponentReferenceNode(EventGraph, ComponentName, NodePosition);
+    if (!GetComponentNode)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to create get component node"));
+    }
     
+    // Mark the blueprint as modified
+    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetStringField(TEXT("node_id"), GetComponentNode->NodeGuid.ToString());
+    return ResultObj;
+}
+
+UK2Node_VariableGet* FUnrealMCPBlueprintNodeCommands::AddComponentReferenceNode(UEdGraph* EventGraph, const FString& ComponentName, const FVector2D& NodePosition)
+{
     // Create the variable get node directly
     UK2Node_VariableGet* GetComponentNode = NewObject<UK2Node_VariableGet>(EventGraph);
     if (!GetComponentNode)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to create get component node"));
+        return nullptr;
     }
     
     // Set up the variable reference properly for UE5.5
@@ -204,13 +274,8 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintGetSe
     
     // Explicitly reconstruct node for UE5.5
     GetComponentNode->ReconstructNode();
-    
-    // Mark the blueprint as modified
-    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetStringField(TEXT("node_id"), GetComponentNode->NodeGuid.ToString());
-    return ResultObj;
+    return GetComponentNode;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintEvent(const TSharedPtr<FJsonObject>& Params)
@@ -279,17 +344,6 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'function_name' parameter"));
     }
 
-    // Get position parameters (optional)
-    FVector2D NodePosition(0.0f, 0.0f);
-    if (Params->HasField(TEXT("node_position")))
-    {
-        NodePosition = FUnrealMCPCommonUtils::GetVector2DFromJson(Params, TEXT("node_position"));
-    }
-
-    // Check for target parameter (optional)
-    FString Target;
-    Params->TryGetStringField(TEXT("target"), Target);
-
     // Find the blueprint
     UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
     if (!Blueprint)
@@ -304,6 +358,41 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get event graph"));
     }
 
+    FString Error;
+    UK2Node_CallFunction* FunctionNode = AddFunctionCallNode(Blueprint, EventGraph, Params, Error);
+    if (!FunctionNode)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    // Mark the blueprint as modified
+    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetStringField(TEXT("node_id"), FunctionNode->NodeGuid.ToString());
+    return ResultObj;
+}
+
+UK2Node_CallFunction* FUnrealMCPBlueprintNodeCommands::AddFunctionCallNode(UBlueprint* Blueprint, UEdGraph* EventGraph, const TSharedPtr<FJsonObject>& Params, FString& OutError)
+{
+    FString FunctionName;
+    if (!Params->TryGetStringField(TEXT("function_name"), FunctionName))
+    {
+        OutError = TEXT("Missing 'function_name' parameter");
+        return nullptr;
+    }
+
+    // Get position parameters (optional)
+    FVector2D NodePosition(0.0f, 0.0f);
+    if (Params->HasField(TEXT("node_position")))
+    {
+        NodePosition = FUnrealMCPCommonUtils::GetVector2DFromJson(Params, TEXT("node_position"));
+    }
+
+    // Check for target parameter (optional)
+    FString Target;
+    Params->TryGetStringField(TEXT("target"), Target);
+
     // Find the function
     UFunction* Function = nullptr;
     UK2Node_CallFunction* FunctionNode = nullptr;
@@ -447,6 +536,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
     if (!Function && !FunctionNode)
     {
         UE_LOG(LogTemp, Display, TEXT("Trying to find function in blueprint class"));
+        FBlueprintCompileQueue::Get().Flush(Blueprint);
         Function = Blueprint->GeneratedClass->FindFunctionByName(*FunctionName);
     }
     
@@ -458,7 +548,8 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
     
     if (!FunctionNode)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Function not found: %s in target %s"), *FunctionName, Target.IsEmpty() ? TEXT("Blueprint") : *Target));
+        OutError = FString::Printf(TEXT("Function not found: %s in target %s"), *FunctionName, Target.IsEmpty() ? TEXT("Blueprint") : *Target);
+        return nullptr;
     }
 
     // Set parameters if provided
@@ -507,7 +598,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             if (!Class)
                             {
                                 Class = LoadObject<UClass>(nullptr, *ClassName);
-                                UE_LOG(LogUnrealMCP, Display, TEXT("FindObject<UClass> failed. Assuming soft path  path: %s"), *ClassName);
+                                UE_LOG(LogUnrealMCP, Verbose, TEXT("FindObject<UClass> failed. Assuming soft path  path: %s"), *ClassName);
                             }
                             
                             // If not found, try with Engine module path
@@ -515,27 +606,30 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             {
                                 FString EngineClassName = FString::Printf(TEXT("/Script/Engine.%s"), *ClassName);
                                 Class = LoadObject<UClass>(nullptr, *EngineClassName);
-                                UE_LOG(LogUnrealMCP, Display, TEXT("Trying Engine module path: %s"), *EngineClassName);
+                                UE_LOG(LogUnrealMCP, Verbose, TEXT("Trying Engine module path: %s"), *EngineClassName);
                             }
                             
                             if (!Class)
                             {
                                 UE_LOG(LogUnrealMCP, Error, TEXT("Failed to find class '%s'. Make sure to use the exact class name with proper prefix (A for actors, U for non-actors)"), *ClassName);
-                                return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to find class '%s'"), *ClassName));
+                                OutError = FString::Printf(TEXT("Failed to find class '%s'"), *ClassName);
+                                return nullptr;
                             }
 
                             const UEdGraphSchema_K2* K2Schema = Cast<const UEdGraphSchema_K2>(EventGraph->GetSchema());
                             if (!K2Schema)
                             {
                                 UE_LOG(LogUnrealMCP, Error, TEXT("Failed to get K2Schema"));
-                                return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get K2Schema"));
+                                OutError = TEXT("Failed to get K2Schema");
+                                return nullptr;
                             }
 
                             K2Schema->TrySetDefaultObject(*ParamPin, Class);
                             if (ParamPin->DefaultObject != Class)
                             {
                                 UE_LOG(LogUnrealMCP, Error, TEXT("Failed to set class reference for pin '%s' to '%s'"), *ParamPin->PinName.ToString(), *ClassName);
-                                return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to set class reference for pin '%s'"), *ParamPin->PinName.ToString()));
+                                OutError = FString::Printf(TEXT("Failed to set class reference for pin '%s'"), *ParamPin->PinName.ToString());
+                                return nullptr;
                             }
 
                             UE_LOG(LogUnrealMCP, Log, TEXT("Successfully set class reference for pin '%s' to '%s'"), *ParamPin->PinName.ToString(), *ClassName);
@@ -661,12 +755,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
         }
     }
 
-    // Mark the blueprint as modified
-    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
-
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetStringField(TEXT("node_id"), FunctionNode->NodeGuid.ToString());
-    return ResultObj;
+    return FunctionNode;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintVariable(const TSharedPtr<FJsonObject>& Params)
@@ -904,14 +993,9 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleFindBlueprintNode
         }
         
         // Look for nodes with exact event name (e.g., ReceiveBeginPlay)
-        for (UEdGraphNode* Node : EventGraph->Nodes)
+        for (UK2Node_Event* EventNode : FBlueprintGraphIndex::Get().FindEventNodes(EventGraph, FName(*EventName, FNAME_Find)))
         {
-            UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
-            if (EventNode && EventNode->EventReference.GetMemberName() == FName(*EventName))
-            {
-                UE_LOG(LogTemp, Display, TEXT("Found event node with name %s: %s"), *EventName, *EventNode->NodeGuid.ToString());
-                NodeGuidArray.Add(MakeShared<FJsonValueString>(EventNode->NodeGuid.ToString()));
-            }
+            NodeGuidArray.Add(MakeShared<FJsonValueString>(EventNode->NodeGuid.ToString()));
         }
     }
     // Add other node types as needed (InputAction, etc.)
@@ -921,3 +1005,235 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleFindBlueprintNode
     
     return ResultObj;
 } 
+
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleGraphPatch(const TSharedPtr<FJsonObject>& Params)
+{
+    FString BlueprintName;
+    if (!Params->TryGetStringField(TEXT("blueprint_name"), BlueprintName))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'blueprint_name' parameter"));
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* NodesJson = nullptr;
+    const TArray<TSharedPtr<FJsonValue>>* EdgesJson = nullptr;
+    Params->TryGetArrayField(TEXT("nodes"), NodesJson);
+    Params->TryGetArrayField(TEXT("edges"), EdgesJson);
+    const int32 NumNodes = NodesJson ? NodesJson->Num() : 0;
+    const int32 NumEdges = EdgesJson ? EdgesJson->Num() : 0;
+    if (NumNodes == 0 && NumEdges == 0)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("'nodes' and 'edges' are both empty"));
+    }
+    if (NumNodes > MaxPatchNodes || NumEdges > MaxPatchEdges)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("A graph patch holds at most %d nodes and %d edges"), MaxPatchNodes, MaxPatchEdges));
+    }
+
+    bool bCompile = true;
+    Params->TryGetBoolField(TEXT("compile"), bCompile);
+
+    // Check every spec before touching the graph, so a malformed patch changes nothing
+    TArray<TSharedPtr<FJsonObject>> NodeSpecs;
+    TArray<FString> NodeIds;
+    TArray<FString> NodeTypes;
+    for (int32 Index = 0; Index < NumNodes; ++Index)
+    {
+        const TSharedPtr<FJsonObject>* Spec = nullptr;
+        if (!(*NodesJson)[Index].IsValid() || !(*NodesJson)[Index]->TryGetObject(Spec))
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("nodes[%d] is not an object"), Index));
+        }
+
+        FString Id;
+        FString Type;
+        if (!(*Spec)->TryGetStringField(TEXT("id"), Id) || Id.IsEmpty())
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("nodes[%d] has no 'id'"), Index));
+        }
+        if (NodeIds.Contains(Id))
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("nodes[%d] repeats the id '%s'"), Index, *Id));
+        }
+        (*Spec)->TryGetStringField(TEXT("type"), Type);
+        const TCHAR* KeyField = GetPatchNodeKeyField(Type);
+        if (!KeyField)
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("nodes[%d] has unknown type '%s'"), Index, *Type));
+        }
+        FString KeyValue;
+        if (*KeyField && (!(*Spec)->TryGetStringField(KeyField, KeyValue) || KeyValue.IsEmpty()))
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("nodes[%d] is missing '%s'"), Index, KeyField));
+        }
+
+        NodeSpecs.Add(*Spec);
+        NodeIds.Add(Id);
+        NodeTypes.Add(Type);
+    }
+
+    struct FEdgeSpec
+    {
+        FString Source;
+        FString SourcePin;
+        FString Target;
+        FString TargetPin;
+    };
+    TArray<FEdgeSpec> EdgeSpecs;
+    EdgeSpecs.Reserve(NumEdges);
+    for (int32 Index = 0; Index < NumEdges; ++Index)
+    {
+        const TSharedPtr<FJsonObject>* Spec = nullptr;
+        if (!(*EdgesJson)[Index].IsValid() || !(*EdgesJson)[Index]->TryGetObject(Spec))
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("edges[%d] is not an object"), Index));
+        }
+
+        FEdgeSpec& Edge = EdgeSpecs.AddDefaulted_GetRef();
+        if (!(*Spec)->TryGetStringField(TEXT("source"), Edge.Source) || !(*Spec)->TryGetStringField(TEXT("source_pin"), Edge.SourcePin)
+            || !(*Spec)->TryGetStringField(TEXT("target"), Edge.Target) || !(*Spec)->TryGetStringField(TEXT("target_pin"), Edge.TargetPin))
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("edges[%d] needs 'source', 'source_pin', 'target' and 'target_pin'"), Index));
+        }
+    }
+
+    // One lookup of the blueprint and its graph for the whole patch
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    if (!Blueprint)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+    }
+
+    UEdGraph* EventGraph = FUnrealMCPCommonUtils::FindOrCreateEventGraph(Blueprint);
+    if (!EventGraph)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get event graph"));
+    }
+
+    // Events, functions and variables are looked up on the generated class
+    FBlueprintCompileQueue::Get().Flush(Blueprint);
+
+    TMap<FString, UEdGraphNode*> NodesById;
+    TArray<TSharedPtr<FJsonValue>> Failures;
+    TSet<FString> FailedIds;
+    TSharedPtr<FJsonObject> NodeGuidsObj = MakeShared<FJsonObject>();
+    int32 NumCreated = 0;
+    for (int32 Index = 0; Index < NodeSpecs.Num(); ++Index)
+    {
+        const TSharedPtr<FJsonObject>& Spec = NodeSpecs[Index];
+        const FString& Type = NodeTypes[Index];
+        FVector2D NodePosition(0.0f, 0.0f);
+        if (Spec->HasField(TEXT("node_position")))
+        {
+            NodePosition = FUnrealMCPCommonUtils::GetVector2DFromJson(Spec, TEXT("node_position"));
+        }
+        FString KeyValue;
+        Spec->TryGetStringField(GetPatchNodeKeyField(Type), KeyValue);
+
+        FString Error;
+        UEdGraphNode* Node = nullptr;
+        if (Type == TEXT("event"))
+        {
+            Node = FUnrealMCPCommonUtils::CreateEventNode(EventGraph, KeyValue, NodePosition);
+        }
+        else if (Type == TEXT("function"))
+        {
+            Node = AddFunctionCallNode(Blueprint, EventGraph, Spec, Error);
+        }
+        else if (Type == TEXT("input_action"))
+        {
+            Node = FUnrealMCPCommonUtils::CreateInputActionNode(EventGraph, KeyValue, NodePosition);
+        }
+        else if (Type == TEXT("component"))
+        {
+            Node = AddComponentReferenceNode(EventGraph, KeyValue, NodePosition);
+        }
+        else if (Type == TEXT("variable_get"))
+        {
+            Node = FUnrealMCPCommonUtils::CreateVariableGetNode(EventGraph, Blueprint, KeyValue, NodePosition);
+        }
+        else if (Type == TEXT("variable_set"))
+        {
+            Node = FUnrealMCPCommonUtils::CreateVariableSetNode(EventGraph, Blueprint, KeyValue, NodePosition);
+        }
+        else if (Type == TEXT("self"))
+        {
+            Node = FUnrealMCPCommonUtils::CreateSelfReferenceNode(EventGraph, NodePosition);
+        }
+
+        if (!Node)
+        {
+            FailedIds.Add(NodeIds[Index]);
+            Failures.Add(MakeShared<FJsonValueObject>(MakePatchFailure(TEXT("node"), MakeShared<FJsonValueString>(NodeIds[Index]),
+                Error.IsEmpty() ? FString::Printf(TEXT("Failed to create %s node"), *Type) : Error)));
+            continue;
+        }
+        if (!Node->NodeGuid.IsValid())
+        {
+            Node->CreateNewGuid();
+        }
+
+        NodesById.Add(NodeIds[Index], Node);
+        NodeGuidsObj->SetStringField(NodeIds[Index], Node->NodeGuid.ToString());
+        ++NumCreated;
+    }
+
+    // Patch ids shadow any GUID they happen to spell; other endpoints are nodes already in the graph
+    auto ResolveEndpoint = [&NodesById, &FailedIds, EventGraph](const FString& Id) -> UEdGraphNode*
+    {
+        if (FailedIds.Contains(Id))
+        {
+            return nullptr;
+        }
+        UEdGraphNode* const* Created = NodesById.Find(Id);
+        return Created ? *Created : FBlueprintGraphIndex::Get().FindNode(EventGraph, Id);
+    };
+
+    int32 NumConnected = 0;
+    for (int32 Index = 0; Index < EdgeSpecs.Num(); ++Index)
+    {
+        const FEdgeSpec& Edge = EdgeSpecs[Index];
+        FString Error;
+        UEdGraphNode* SourceNode = ResolveEndpoint(Edge.Source);
+        UEdGraphNode* TargetNode = ResolveEndpoint(Edge.Target);
+        if (!SourceNode || !TargetNode)
+        {
+            const FString& Missing = SourceNode ? Edge.Target : Edge.Source;
+            Error = FailedIds.Contains(Missing)
+                ? FString::Printf(TEXT("Node '%s' was not created"), *Missing)
+                : FString::Printf(TEXT("Node not found: %s"), *Missing);
+        }
+        else if (!FUnrealMCPCommonUtils::ConnectGraphNodes(EventGraph, SourceNode, Edge.SourcePin, TargetNode, Edge.TargetPin))
+        {
+            Error = FString::Printf(TEXT("Failed to connect %s.%s to %s.%s"), *Edge.Source, *Edge.SourcePin, *Edge.Target, *Edge.TargetPin);
+        }
+
+        if (!Error.IsEmpty())
+        {
+            Failures.Add(MakeShared<FJsonValueObject>(MakePatchFailure(TEXT("edge"), MakeShared<FJsonValueNumber>(Index), Error)));
+            continue;
+        }
+        ++NumConnected;
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetStringField(TEXT("blueprint_name"), BlueprintName);
+    ResultObj->SetObjectField(TEXT("nodes"), NodeGuidsObj);
+    ResultObj->SetNumberField(TEXT("created"), NumCreated);
+    ResultObj->SetNumberField(TEXT("connected"), NumConnected);
+    ResultObj->SetArrayField(TEXT("failures"), Failures);
+
+    // One structural notification and one compile for the whole patch, instead of one per node
+    if (NumCreated > 0 || NumConnected > 0)
+    {
+        FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+        if (bCompile)
+        {
+            ResultObj->SetObjectField(TEXT("compile"), FBlueprintCompileQueue::Get().Compile(Blueprint).ToJson());
+        }
+        else
+        {
+            FBlueprintCompileQueue::Get().Request(Blueprint);
+        }
+    }
+    return ResultObj;
+}
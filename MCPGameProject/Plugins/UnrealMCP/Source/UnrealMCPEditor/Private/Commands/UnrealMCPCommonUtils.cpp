@@ -1,5 +1,8 @@
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "CoreMinimal.h"
+#include "Commands/BlueprintGraphIndex.h"
+#include "Commands/BlueprintResolver.h"
+#include "Commands/PropertyPathCache.h"
 #include "GameFramework/Actor.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
@@ -154,8 +157,7 @@ UBlueprint* FUnrealMCPCommonUtils::FindBlueprint(const FString& BlueprintName)
 
 UBlueprint* FUnrealMCPCommonUtils::FindBlueprintByName(const FString& BlueprintName)
 {
-    FString AssetPath = TEXT("/Game/Blueprints/") + BlueprintName;
-    return LoadObject<UBlueprint>(nullptr, *AssetPath);
+    return FBlueprintResolver::Get().Find(BlueprintName);
 }
 
 UEdGraph* FUnrealMCPCommonUtils::FindOrCreateEventGraph(UBlueprint* Blueprint)
@@ -195,15 +197,9 @@ UK2Node_Event* FUnrealMCPCommonUtils::CreateEventNode(UEdGraph* Graph, const FSt
     }
     
     // Check for existing event node with this exact name
-    for (UEdGraphNode* Node : Graph->Nodes)
+    if (UK2Node_Event* ExistingNode = FindExistingEventNode(Graph, EventName))
     {
-        UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
-        if (EventNode && EventNode->EventReference.GetMemberName() == FName(*EventName))
-        {
-            UE_LOG(LogTemp, Display, TEXT("Using existing event node with name %s (ID: %s)"), 
-                *EventName, *EventNode->NodeGuid.ToString());
-            return EventNode;
-        }
+        return ExistingNode;
     }
 
     // No existing node found, create a new one
@@ -370,35 +366,10 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
         return nullptr;
     }
     
-    // Log all pins for debugging
-    UE_LOG(LogTemp, Display, TEXT("FindPin: Looking for pin '%s' (Direction: %d) in node '%s'"), 
-           *PinName, (int32)Direction, *Node->GetName());
-    
-    for (UEdGraphPin* Pin : Node->Pins)
-    {
-        UE_LOG(LogTemp, Display, TEXT("  - Available pin: '%s', Direction: %d, Category: %s"), 
-               *Pin->PinName.ToString(), (int32)Pin->Direction, *Pin->PinType.PinCategory.ToString());
-    }
-    
-    // First try exact match
-    for (UEdGraphPin* Pin : Node->Pins)
-    {
-        if (Pin->PinName.ToString() == PinName && (Direction == EGPD_MAX || Pin->Direction == Direction))
-        {
-            UE_LOG(LogTemp, Display, TEXT("  - Found exact matching pin: '%s'"), *Pin->PinName.ToString());
-            return Pin;
-        }
-    }
-    
-    // If no exact match and we're looking for a component reference, try case-insensitive match
-    for (UEdGraphPin* Pin : Node->Pins)
+    // Pin names are FNames, so the indexed lookup matches regardless of case
+    if (UEdGraphPin* Pin = FBlueprintGraphIndex::Get().FindPin(Node, FName(*PinName, FNAME_Find), Direction))
     {
-        if (Pin->PinName.ToString().Equals(PinName, ESearchCase::IgnoreCase) && 
-            (Direction == EGPD_MAX || Pin->Direction == Direction))
-        {
-            UE_LOG(LogTemp, Display, TEXT("  - Found case-insensitive matching pin: '%s'"), *Pin->PinName.ToString());
-            return Pin;
-        }
+        return Pin;
     }
     
     // If we're looking for a component output and didn't find it by name, try to find the first data output pin
@@ -408,13 +379,18 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
         {
             if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec)
             {
-                UE_LOG(LogTemp, Display, TEXT("  - Found fallback data output pin: '%s'"), *Pin->PinName.ToString());
                 return Pin;
             }
         }
     }
     
-    UE_LOG(LogTemp, Warning, TEXT("  - No matching pin found for '%s'"), *PinName);
+    // Only a failed lookup lists the pins; successful ones stay quiet on large graphs
+    UE_LOG(LogTemp, Warning, TEXT("FindPin: No pin '%s' (Direction: %d) on node '%s'"), *PinName, (int32)Direction, *Node->GetName());
+    for (const UEdGraphPin* Pin : Node->Pins)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("  - Available pin: '%s', Direction: %d, Category: %s"), 
+               *Pin->PinName.ToString(), (int32)Pin->Direction, *Pin->PinType.PinCategory.ToString());
+    }
     return nullptr;
 }
 
@@ -496,18 +472,7 @@ UK2Node_Event* FUnrealMCPCommonUtils::FindExistingEventNode(UEdGraph* Graph, con
         return nullptr;
     }
 
-    // Look for existing event nodes
-    for (UEdGraphNode* Node : Graph->Nodes)
-    {
-        UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
-        if (EventNode && EventNode->EventReference.GetMemberName() == FName(*EventName))
-        {
-            UE_LOG(LogTemp, Display, TEXT("Found existing event node with name: %s"), *EventName);
-            return EventNode;
-        }
-    }
-
-    return nullptr;
+    return FBlueprintGraphIndex::Get().FindEventNode(Graph, FName(*EventName, FNAME_Find));
 }
 
 bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& PropertyName, 
@@ -519,192 +484,25 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
         return false;
     }
 
-    FProperty* Property = Object->GetClass()->FindPropertyByName(*PropertyName);
-    if (!Property)
+    // Resolved once per class and path; nested struct fields ("RelativeLocation.X") included.
+    const FPropertyPathCache::FCompiledPath* Path = FPropertyPathCache::Get().Resolve(Object->GetClass(), PropertyName, OutErrorMessage);
+    return Path && Path->SetValue(Object, Value, OutErrorMessage);
+}
+
+bool FUnrealMCPCommonUtils::GetObjectProperty(const UObject* Object, const FString& PropertyName,
+                                     TSharedPtr<FJsonValue>& OutValue, FString& OutErrorMessage)
+{
+    if (!Object)
     {
-        OutErrorMessage = FString::Printf(TEXT("Property not found: %s"), *PropertyName);
+        OutErrorMessage = TEXT("Invalid object");
         return false;
     }
 
-    void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(Object);
-    
-    // Handle different property types
-    if (Property->IsA<FBoolProperty>())
-    {
-        ((FBoolProperty*)Property)->SetPropertyValue(PropertyAddr, Value->AsBool());
-        return true;
-    }
-    else if (Property->IsA<FIntProperty>())
+    const FPropertyPathCache::FCompiledPath* Path = FPropertyPathCache::Get().Resolve(Object->GetClass(), PropertyName, OutErrorMessage);
+    if (!Path)
     {
-        int32 IntValue = static_cast<int32>(Value->AsNumber());
-        FIntProperty* IntProperty = CastField<FIntProperty>(Property);
-        if (IntProperty)
-        {
-            IntProperty->SetPropertyValue_InContainer(Object, IntValue);
-            return true;
-        }
-    }
-    else if (Property->IsA<FFloatProperty>())
-    {
-        ((FFloatProperty*)Property)->SetPropertyValue(PropertyAddr, Value->AsNumber());
-        return true;
-    }
-    else if (Property->IsA<FStrProperty>())
-    {
-        ((FStrProperty*)Property)->SetPropertyValue(PropertyAddr, Value->AsString());
-        return true;
-    }
-    else if (Property->IsA<FByteProperty>())
-    {
-        FByteProperty* ByteProp = CastField<FByteProperty>(Property);
-        UEnum* EnumDef = ByteProp ? ByteProp->GetIntPropertyEnum() : nullptr;
-        
-        // If this is a TEnumAsByte property (has associated enum)
-        if (EnumDef)
-        {
-            // Handle numeric value
-            if (Value->Type == EJson::Number)
-            {
-                uint8 ByteValue = static_cast<uint8>(Value->AsNumber());
-                ByteProp->SetPropertyValue(PropertyAddr, ByteValue);
-                
-                UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric value: %d"), 
-                      *PropertyName, ByteValue);
-                return true;
-            }
-            // Handle string enum value
-            else if (Value->Type == EJson::String)
-            {
-                FString EnumValueName = Value->AsString();
-                
-                // Try to convert numeric string to number first
-                if (EnumValueName.IsNumeric())
-                {
-                    uint8 ByteValue = FCString::Atoi(*EnumValueName);
-                    ByteProp->SetPropertyValue(PropertyAddr, ByteValue);
-                    
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric string value: %s -> %d"), 
-                          *PropertyName, *EnumValueName, ByteValue);
-                    return true;
-                }
-                
-                // Handle qualified enum names (e.g., "Player0" or "EAutoReceiveInput::Player0")
-                if (EnumValueName.Contains(TEXT("::")))
-                {
-                    EnumValueName.Split(TEXT("::"), nullptr, &EnumValueName);
-                }
-                
-                int64 EnumValue = EnumDef->GetValueByNameString(EnumValueName);
-                if (EnumValue == INDEX_NONE)
-                {
-                    // Try with full name as fallback
-                    EnumValue = EnumDef->GetValueByNameString(Value->AsString());
-                }
-                
-                if (EnumValue != INDEX_NONE)
-                {
-                    ByteProp->SetPropertyValue(PropertyAddr, static_cast<uint8>(EnumValue));
-                    
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to name value: %s -> %lld"), 
-                          *PropertyName, *EnumValueName, EnumValue);
-                    return true;
-                }
-                else
-                {
-                    // Log all possible enum values for debugging
-                    UE_LOG(LogTemp, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
-                    for (int32 i = 0; i < EnumDef->NumEnums(); i++)
-                    {
-                        UE_LOG(LogTemp, Warning, TEXT("  - %s (value: %d)"), 
-                               *EnumDef->GetNameStringByIndex(i), EnumDef->GetValueByIndex(i));
-                    }
-                    
-                    OutErrorMessage = FString::Printf(TEXT("Could not find enum value for '%s'"), *EnumValueName);
-                    return false;
-                }
-            }
-        }
-        else
-        {
-            // Regular byte property
-            uint8 ByteValue = static_cast<uint8>(Value->AsNumber());
-            ByteProp->SetPropertyValue(PropertyAddr, ByteValue);
-            return true;
-        }
-    }
-    else if (Property->IsA<FEnumProperty>())
-    {
-        FEnumProperty* EnumProp = CastField<FEnumProperty>(Property);
-        UEnum* EnumDef = EnumProp ? EnumProp->GetEnum() : nullptr;
-        FNumericProperty* UnderlyingNumericProp = EnumProp ? EnumProp->GetUnderlyingProperty() : nullptr;
-        
-        if (EnumDef && UnderlyingNumericProp)
-        {
-            // Handle numeric value
-            if (Value->Type == EJson::Number)
-            {
-                int64 EnumValue = static_cast<int64>(Value->AsNumber());
-                UnderlyingNumericProp->SetIntPropertyValue(PropertyAddr, EnumValue);
-                
-                UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric value: %lld"), 
-                      *PropertyName, EnumValue);
-                return true;
-            }
-            // Handle string enum value
-            else if (Value->Type == EJson::String)
-            {
-                FString EnumValueName = Value->AsString();
-                
-                // Try to convert numeric string to number first
-                if (EnumValueName.IsNumeric())
-                {
-                    int64 EnumValue = FCString::Atoi64(*EnumValueName);
-                    UnderlyingNumericProp->SetIntPropertyValue(PropertyAddr, EnumValue);
-                    
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric string value: %s -> %lld"), 
-                          *PropertyName, *EnumValueName, EnumValue);
-                    return true;
-                }
-                
-                // Handle qualified enum names
-                if (EnumValueName.Contains(TEXT("::")))
-                {
-                    EnumValueName.Split(TEXT("::"), nullptr, &EnumValueName);
-                }
-                
-                int64 EnumValue = EnumDef->GetValueByNameString(EnumValueName);
-                if (EnumValue == INDEX_NONE)
-                {
-                    // Try with full name as fallback
-                    EnumValue = EnumDef->GetValueByNameString(Value->AsString());
-                }
-                
-                if (EnumValue != INDEX_NONE)
-                {
-                    UnderlyingNumericProp->SetIntPropertyValue(PropertyAddr, EnumValue);
-                    
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to name value: %s -> %lld"), 
-                          *PropertyName, *EnumValueName, EnumValue);
-                    return true;
-                }
-                else
-                {
-                    // Log all possible enum values for debugging
-                    UE_LOG(LogTemp, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
-                    for (int32 i = 0; i < EnumDef->NumEnums(); i++)
-                    {
-                        UE_LOG(LogTemp, Warning, TEXT("  - %s (value: %d)"), 
-                               *EnumDef->GetNameStringByIndex(i), EnumDef->GetValueByIndex(i));
-                    }
-                    
-                    OutErrorMessage = FString::Printf(TEXT("Could not find enum value for '%s'"), *EnumValueName);
-                    return false;
-                }
-            }
-        }
+        return false;
     }
-    
-    OutErrorMessage = FString::Printf(TEXT("Unsupported property type: %s for property %s"), 
-                                    *Property->GetClass()->GetName(), *PropertyName);
-    return false;
-} 
+    OutValue = Path->GetValue(Object);
+    return true;
+}
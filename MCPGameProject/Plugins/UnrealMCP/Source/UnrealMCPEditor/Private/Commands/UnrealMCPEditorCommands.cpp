@@ -1,16 +1,21 @@
 #include "Commands/UnrealMCPEditorCommands.h"
 #include "CoreMinimal.h"
+#include "Actors/ActorIndex.h"
+#include "Algo/Sort.h"
+#include "Misc/Base64.h"
+#include "Commands/BlueprintCompileQueue.h"
+#include "Commands/MCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "EditorNav/ViewportCapture.h"
+#include "Levels/WorldPartitionActors.h"
+#include "Protocol/CommandContext.h"
 #include "Editor.h"
 #include "EditorViewportClient.h"
 #include "LevelEditorViewport.h"
-#include "ImageUtils.h"
 #include "HighResScreenshot.h"
 #include "Engine/GameViewportClient.h"
-#include "Misc/FileHelper.h"
 #include "GameFramework/Actor.h"
 #include "Engine/Selection.h"
-#include "Kismet/GameplayStatics.h"
 #include "Engine/StaticMeshActor.h"
 #include "Engine/DirectionalLight.h"
 #include "Engine/PointLight.h"
@@ -22,6 +27,252 @@
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 
+#include <algorithm>
+
+namespace
+{
+    /** A take_screenshot waiting on its GPU readback and encode across frames. */
+    struct FScreenshotCapture : UnrealMCP::Protocol::FCommandContext::FResumeState
+    {
+        TSharedPtr<FViewportCapture, ESPMode::ThreadSafe> Capture;
+        FViewportCapture::EFormat Format = FViewportCapture::EFormat::Png;
+        FString FilePath;
+        bool bInline = false;
+    };
+
+    /** Most actors one get_actors_in_level page returns. */
+    constexpr int32 MaxActorsPageSize = 10000;
+
+    /** get_actors_in_level filters; an empty filter matches everything. */
+    struct FActorFilter
+    {
+        TArray<FString> ClassNames;
+        TArray<FName> Tags;
+        FString LabelContains;
+        FString Folder;
+        bool bRecursiveFolder = true;
+        /** Also match World Partition actors that are not loaded, from their descriptors. */
+        bool bIncludeUnloaded = false;
+
+        /** Class matches are decided once per class, not once per actor. */
+        mutable TMap<const UClass*, bool> ClassMatches;
+
+        bool IsEmpty() const
+        {
+            return ClassNames.Num() == 0 && Tags.Num() == 0 && LabelContains.IsEmpty() && Folder.IsEmpty();
+        }
+
+        bool MatchesClass(const UClass* Class) const
+        {
+            if (const bool* Cached = ClassMatches.Find(Class))
+            {
+                return *Cached;
+            }
+
+            // Short names, with or without the native A prefix, for the class or any of its parents.
+            bool bMatches = false;
+            for (const UClass* Candidate = Class; Candidate && !bMatches; Candidate = Candidate->GetSuperClass())
+            {
+                const FString Name = Candidate->GetName();
+                const FString PrefixedName = Candidate->GetPrefixCPP() + Name;
+                bMatches = ClassNames.ContainsByPredicate([&Name, &PrefixedName, Candidate](const FString& Wanted)
+                {
+                    return Wanted.Equals(Name, ESearchCase::IgnoreCase) || Wanted.Equals(PrefixedName, ESearchCase::IgnoreCase)
+                        || Wanted.Equals(Candidate->GetPathName(), ESearchCase::IgnoreCase);
+                });
+            }
+            ClassMatches.Add(Class, bMatches);
+            return bMatches;
+        }
+
+        bool Matches(const AActor& Actor) const
+        {
+            if (ClassNames.Num() > 0 && !MatchesClass(Actor.GetClass()))
+            {
+                return false;
+            }
+
+            for (const FName& Tag : Tags)
+            {
+                if (!Actor.ActorHasTag(Tag))
+                {
+                    return false;
+                }
+            }
+
+            if (!LabelContains.IsEmpty() && !Actor.GetActorLabel().Contains(LabelContains))
+            {
+                return false;
+            }
+
+            if (!Folder.IsEmpty())
+            {
+                const FString ActorFolder = Actor.GetFolderPath().ToString();
+                const bool bInFolder = ActorFolder.Equals(Folder, ESearchCase::IgnoreCase)
+                    || (bRecursiveFolder && ActorFolder.StartsWith(Folder + TEXT("/"), ESearchCase::IgnoreCase));
+                if (!bInFolder)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool Matches(const FWorldPartitionActors::FDesc& Desc) const
+        {
+            if (ClassNames.Num() > 0)
+            {
+                // The native class is resident even when the actor is not; Blueprint classes are
+                // matched by name or path only, so they are not loaded to walk their parents.
+                const FString BlueprintName = Desc.ClassName.EndsWith(TEXT("_C")) ? Desc.ClassName.LeftChop(2) : Desc.ClassName;
+                const bool bClassMatches = (Desc.NativeClass && MatchesClass(Desc.NativeClass))
+                    || ClassNames.ContainsByPredicate([&Desc, &BlueprintName](const FString& Wanted)
+                    {
+                        return Wanted.Equals(Desc.ClassName, ESearchCase::IgnoreCase) || Wanted.Equals(BlueprintName, ESearchCase::IgnoreCase)
+                            || Wanted.Equals(Desc.ClassPath, ESearchCase::IgnoreCase);
+                    });
+                if (!bClassMatches)
+                {
+                    return false;
+                }
+            }
+
+            for (const FName& Tag : Tags)
+            {
+                if (!Desc.Tags.Contains(Tag))
+                {
+                    return false;
+                }
+            }
+
+            const FString& Label = Desc.Label.IsEmpty() ? Desc.Name : Desc.Label;
+            if (!LabelContains.IsEmpty() && !Label.Contains(LabelContains))
+            {
+                return false;
+            }
+
+            if (!Folder.IsEmpty())
+            {
+                const bool bInFolder = Desc.Folder.Equals(Folder, ESearchCase::IgnoreCase)
+                    || (bRecursiveFolder && Desc.Folder.StartsWith(Folder + TEXT("/"), ESearchCase::IgnoreCase));
+                if (!bInFolder)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /** Identifies the filter in a cursor, so a cursor is not followed with different filters. */
+        uint32 Hash() const
+        {
+            uint32 Result = GetTypeHash(LabelContains.ToLower());
+            Result = HashCombine(Result, GetTypeHash(Folder.ToLower()));
+            Result = HashCombine(Result, GetTypeHash(bRecursiveFolder));
+            Result = HashCombine(Result, GetTypeHash(bIncludeUnloaded));
+            for (const FString& ClassName : ClassNames)
+            {
+                Result = HashCombine(Result, GetTypeHash(ClassName.ToLower()));
+            }
+            for (const FName& Tag : Tags)
+            {
+                Result = HashCombine(Result, GetTypeHash(Tag.ToString().ToLower()));
+            }
+            return Result;
+        }
+    };
+
+    void ReadStringList(const TSharedPtr<FJsonObject>& Params, const TCHAR* Field, TArray<FString>& OutValues)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+        if (Params->TryGetArrayField(Field, Values) && Values)
+        {
+            for (const TSharedPtr<FJsonValue>& Value : *Values)
+            {
+                FString String;
+                if (Value.IsValid() && Value->TryGetString(String) && !String.TrimStartAndEnd().IsEmpty())
+                {
+                    OutValues.Add(String.TrimStartAndEnd());
+                }
+            }
+        }
+    }
+
+    /** Cursors name the last actor path returned, so pages survive actors being added or removed in between. */
+    FString EncodeActorCursor(uint32 FilterHash, const FString& LastPath)
+    {
+        return FBase64::Encode(FString::Printf(TEXT("1:%08x:%s"), FilterHash, *LastPath));
+    }
+
+    bool DecodeActorCursor(const FString& Cursor, uint32& OutFilterHash, FString& OutLastPath)
+    {
+        FString Decoded;
+        if (!FBase64::Decode(Cursor, Decoded) || !Decoded.StartsWith(TEXT("1:")) || Decoded.Len() < 12 || Decoded[10] != TCHAR(':'))
+        {
+            return false;
+        }
+        OutFilterHash = FParse::HexNumber(*Decoded.Mid(2, 8));
+        OutLastPath = Decoded.Mid(11);
+        return !OutLastPath.IsEmpty();
+    }
+
+    TArray<TSharedPtr<FJsonValue>> VectorToJson(const FVector& Vector)
+    {
+        return { MakeShared<FJsonValueNumber>(Vector.X), MakeShared<FJsonValueNumber>(Vector.Y), MakeShared<FJsonValueNumber>(Vector.Z) };
+    }
+
+    /** The fields asked for, in the names ActorToJson uses for the ones it has. */
+    TSharedPtr<FJsonValue> ProjectActor(AActor& Actor, const FString& Path, const TSet<FString>& Fields)
+    {
+        TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+        if (Fields.Contains(TEXT("name")))
+        {
+            Object->SetStringField(TEXT("name"), Actor.GetName());
+        }
+        if (Fields.Contains(TEXT("label")))
+        {
+            Object->SetStringField(TEXT("label"), Actor.GetActorLabel());
+        }
+        if (Fields.Contains(TEXT("class")))
+        {
+            Object->SetStringField(TEXT("class"), Actor.GetClass()->GetName());
+        }
+        if (Fields.Contains(TEXT("path")))
+        {
+            Object->SetStringField(TEXT("path"), Path);
+        }
+        if (Fields.Contains(TEXT("folder")))
+        {
+            Object->SetStringField(TEXT("folder"), Actor.GetFolderPath().ToString());
+        }
+        if (Fields.Contains(TEXT("tags")))
+        {
+            TArray<TSharedPtr<FJsonValue>> Tags;
+            for (const FName& Tag : Actor.Tags)
+            {
+                Tags.Add(MakeShared<FJsonValueString>(Tag.ToString()));
+            }
+            Object->SetArrayField(TEXT("tags"), Tags);
+        }
+        if (Fields.Contains(TEXT("location")))
+        {
+            Object->SetArrayField(TEXT("location"), VectorToJson(Actor.GetActorLocation()));
+        }
+        if (Fields.Contains(TEXT("rotation")))
+        {
+            const FRotator Rotation = Actor.GetActorRotation();
+            Object->SetArrayField(TEXT("rotation"), VectorToJson(FVector(Rotation.Pitch, Rotation.Yaw, Rotation.Roll)));
+        }
+        if (Fields.Contains(TEXT("scale")))
+        {
+            Object->SetArrayField(TEXT("scale"), VectorToJson(Actor.GetActorScale3D()));
+        }
+        return MakeShared<FJsonValueObject>(Object);
+    }
+}
+
 FUnrealMCPEditorCommands::FUnrealMCPEditorCommands()
 {
 }
@@ -79,23 +330,167 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& C
     return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown editor command: %s"), *CommandType));
 }
 
+void FUnrealMCPEditorCommands::RegisterCommands(FMCPCommandRegistry& Registry)
+{
+    Registry.Register(TEXT("get_actors_in_level"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleGetActorsInLevel(Params); }).bCacheable = true;
+    Registry.Register(TEXT("find_actors_by_name"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleFindActorsByName(Params); }).bCacheable = true;
+    Registry.Register(TEXT("spawn_actor"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleSpawnActor(Params); });
+    Registry.Register(TEXT("create_actor"), [this](const TSharedPtr<FJsonObject>& Params)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("'create_actor' command is deprecated and will be removed in a future version. Please use 'spawn_actor' instead."));
+        return HandleSpawnActor(Params);
+    });
+    Registry.Register(TEXT("delete_actor"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleDeleteActor(Params); });
+    Registry.Register(TEXT("set_actor_transform"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetActorTransform(Params); });
+    Registry.Register(TEXT("get_actor_properties"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleGetActorProperties(Params); }).bCacheable = true;
+    Registry.Register(TEXT("set_actor_property"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetActorProperty(Params); });
+    Registry.Register(TEXT("spawn_blueprint_actor"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleSpawnBlueprintActor(Params); });
+    Registry.Register(TEXT("focus_viewport"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleFocusViewport(Params); });
+    Registry.Register(TEXT("take_screenshot"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleTakeScreenshot(Params); });
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params)
 {
+    FActorFilter Filter;
+    TSet<FString> Fields;
+    int32 Limit = 0;
+    FString Cursor;
+    if (Params.IsValid())
+    {
+        ReadStringList(Params, TEXT("classNames"), Filter.ClassNames);
+        TArray<FString> Tags;
+        ReadStringList(Params, TEXT("tags"), Tags);
+        for (const FString& Tag : Tags)
+        {
+            Filter.Tags.Add(FName(*Tag));
+        }
+        Params->TryGetStringField(TEXT("labelContains"), Filter.LabelContains);
+        if (Params->TryGetStringField(TEXT("folder"), Filter.Folder))
+        {
+            Filter.Folder.TrimStartAndEndInline();
+            while (Filter.Folder.RemoveFromEnd(TEXT("/")))
+            {
+            }
+        }
+        Params->TryGetBoolField(TEXT("recursive"), Filter.bRecursiveFolder);
+        Params->TryGetBoolField(TEXT("includeUnloaded"), Filter.bIncludeUnloaded);
+
+        TArray<FString> FieldList;
+        ReadStringList(Params, TEXT("fields"), FieldList);
+        for (const FString& Field : FieldList)
+        {
+            Fields.Add(Field.ToLower());
+        }
+
+        double LimitValue = 0.0;
+        if (Params->TryGetNumberField(TEXT("limit"), LimitValue))
+        {
+            Limit = FMath::Clamp(static_cast<int32>(LimitValue), 1, MaxActorsPageSize);
+        }
+        Params->TryGetStringField(TEXT("cursor"), Cursor);
+    }
+
     TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    TArray<TSharedPtr<FJsonValue>> ActorArray;
+    FActorIndex::Get().GetActors(GWorld, AllActors);
+
+    // Without filters, projection or paging the response keeps its original shape: every actor, unordered.
+    const bool bPaged = Limit > 0 || !Cursor.IsEmpty();
+    if (Filter.IsEmpty() && Fields.Num() == 0 && !bPaged && !Filter.bIncludeUnloaded)
+    {
+        TArray<TSharedPtr<FJsonValue>> ActorArray;
+        for (AActor* Actor : AllActors)
+        {
+            if (Actor)
+            {
+                ActorArray.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
+            }
+        }
+
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetArrayField(TEXT("actors"), ActorArray);
+        return ResultObj;
+    }
+
+    const uint32 FilterHash = Filter.Hash();
+    FString AfterPath;
+    if (!Cursor.IsEmpty())
+    {
+        uint32 CursorHash = 0;
+        if (!DecodeActorCursor(Cursor, CursorHash, AfterPath))
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Invalid cursor"));
+        }
+        if (CursorHash != FilterHash)
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Cursor belongs to different filters; send the same filters with it"));
+        }
+    }
+
+    // Filters read the actor only; paths are built for the matches, which pages are ordered by.
+    // Unloaded actors carry the path they will have once loaded, so they page in with the rest.
+    struct FActorMatch
+    {
+        FString Key;
+        AActor* Actor = nullptr;
+        int32 DescIndex = INDEX_NONE;
+    };
+    TArray<FActorMatch> Matches;
     for (AActor* Actor : AllActors)
     {
-        if (Actor)
+        if (Actor && Filter.Matches(*Actor))
         {
-            ActorArray.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
+            FString Path = Actor->GetPathName();
+            if (AfterPath.IsEmpty() || Path.Compare(AfterPath, ESearchCase::IgnoreCase) > 0)
+            {
+                Matches.Add({ MoveTemp(Path), Actor, INDEX_NONE });
+            }
         }
     }
-    
+
+    TArray<FWorldPartitionActors::FDesc> UnloadedDescs;
+    if (Filter.bIncludeUnloaded && FWorldPartitionActors::GetUnloaded(GWorld, UnloadedDescs))
+    {
+        for (int32 DescIndex = 0; DescIndex < UnloadedDescs.Num(); ++DescIndex)
+        {
+            const FWorldPartitionActors::FDesc& Desc = UnloadedDescs[DescIndex];
+            if (Filter.Matches(Desc) && (AfterPath.IsEmpty() || Desc.Path.Compare(AfterPath, ESearchCase::IgnoreCase) > 0))
+            {
+                Matches.Add({ Desc.Path, nullptr, DescIndex });
+            }
+        }
+    }
+
+    const int32 PageSize = Limit > 0 ? Limit : Matches.Num();
+    auto ByPath = [](const FActorMatch& A, const FActorMatch& B) { return A.Key.Compare(B.Key, ESearchCase::IgnoreCase) < 0; };
+    if (Matches.Num() > PageSize)
+    {
+        // Only the page's own entries, and the one after it, need ordering.
+        std::nth_element(Matches.GetData(), Matches.GetData() + PageSize, Matches.GetData() + Matches.Num(), ByPath);
+        Matches.SetNum(PageSize + 1);
+    }
+    Algo::Sort(Matches, ByPath);
+
+    const bool bHasMore = Matches.Num() > PageSize;
+    const int32 Count = FMath::Min(Matches.Num(), PageSize);
+    TArray<TSharedPtr<FJsonValue>> ActorArray;
+    ActorArray.Reserve(Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        const FActorMatch& Match = Matches[Index];
+        if (Match.DescIndex != INDEX_NONE)
+        {
+            ActorArray.Add(MakeShared<FJsonValueObject>(FWorldPartitionActors::ToJson(UnloadedDescs[Match.DescIndex], Fields.Num() > 0 ? &Fields : nullptr)));
+            continue;
+        }
+        ActorArray.Add(Fields.Num() > 0 ? ProjectActor(*Match.Actor, Match.Key, Fields) : FUnrealMCPCommonUtils::ActorToJson(Match.Actor));
+    }
+
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetArrayField(TEXT("actors"), ActorArray);
-    
+    if (bHasMore)
+    {
+        ResultObj->SetStringField(TEXT("nextCursor"), EncodeActorCursor(FilterHash, Matches[Count - 1].Key));
+    }
     return ResultObj;
 }
 
@@ -108,7 +503,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindActorsByName(const T
     }
     
     TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
+    FActorIndex::Get().GetActors(GWorld, AllActors);
     
     TArray<TSharedPtr<FJsonValue>> MatchingActors;
     for (AActor* Actor : AllActors)
@@ -169,14 +564,9 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TShared
     }
 
     // Check if an actor with this name already exists
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
-    for (AActor* Actor : AllActors)
+    if (FActorIndex::Get().FindByName(World, FName(*ActorName, FNAME_Find)))
     {
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
-        }
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
     }
 
     FActorSpawnParameters SpawnParams;
@@ -229,23 +619,17 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleDeleteActor(const TShare
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
     }
 
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
+    if (AActor* Actor = FActorIndex::Get().FindByName(GWorld, FName(*ActorName, FNAME_Find)))
     {
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            // Store actor info before deletion for the response
-            TSharedPtr<FJsonObject> ActorInfo = FUnrealMCPCommonUtils::ActorToJsonObject(Actor);
-            
-            // Delete the actor
-            Actor->Destroy();
-            
-            TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-            ResultObj->SetObjectField(TEXT("deleted_actor"), ActorInfo);
-            return ResultObj;
-        }
+        // Store actor info before deletion for the response
+        TSharedPtr<FJsonObject> ActorInfo = FUnrealMCPCommonUtils::ActorToJsonObject(Actor);
+        
+        // Delete the actor
+        Actor->Destroy();
+        
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetObjectField(TEXT("deleted_actor"), ActorInfo);
+        return ResultObj;
     }
     
     return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
@@ -261,18 +645,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(const
     }
 
     // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
-    {
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            TargetActor = Actor;
-            break;
-        }
-    }
+    AActor* TargetActor = FActorIndex::Get().FindByName(GWorld, FName(*ActorName, FNAME_Find));
 
     if (!TargetActor)
     {
@@ -312,18 +685,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorProperties(const
     }
 
     // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
-    {
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            TargetActor = Actor;
-            break;
-        }
-    }
+    AActor* TargetActor = FActorIndex::Get().FindByName(GWorld, FName(*ActorName, FNAME_Find));
 
     if (!TargetActor)
     {
@@ -331,7 +693,36 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorProperties(const
     }
 
     // Always return detailed properties for this command
-    return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
+    TSharedPtr<FJsonObject> Result = FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
+
+    // Specific properties by path, struct fields included ("bHidden", "PivotOffset.Z")
+    const TArray<TSharedPtr<FJsonValue>>* Paths = nullptr;
+    if (Result.IsValid() && Params->TryGetArrayField(TEXT("properties"), Paths))
+    {
+        TSharedPtr<FJsonObject> Values = MakeShared<FJsonObject>();
+        TArray<TSharedPtr<FJsonValue>> Missing;
+        for (const TSharedPtr<FJsonValue>& PathValue : *Paths)
+        {
+            FString PropertyPath;
+            TSharedPtr<FJsonValue> Value;
+            FString ErrorMessage;
+            if (!PathValue.IsValid() || !PathValue->TryGetString(PropertyPath))
+            {
+                continue;
+            }
+            if (FUnrealMCPCommonUtils::GetObjectProperty(TargetActor, PropertyPath, Value, ErrorMessage))
+            {
+                Values->SetField(PropertyPath, Value);
+            }
+            else
+            {
+                Missing.Add(MakeShared<FJsonValueString>(PropertyPath));
+            }
+        }
+        Result->SetObjectField(TEXT("values"), Values);
+        Result->SetArrayField(TEXT("missing"), Missing);
+    }
+    return Result;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(const TSharedPtr<FJsonObject>& Params)
@@ -344,18 +735,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(const T
     }
 
     // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
-    {
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            TargetActor = Actor;
-            break;
-        }
-    }
+    AActor* TargetActor = FActorIndex::Get().FindByName(GWorld, FName(*ActorName, FNAME_Find));
 
     if (!TargetActor)
     {
@@ -418,20 +798,15 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnBlueprintActor(cons
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Blueprint name is empty"));
     }
 
-    FString Root      = TEXT("/Game/Blueprints/");
-    FString AssetPath = Root + BlueprintName;
-
-    if (!FPackageName::DoesPackageExist(AssetPath))
-    {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint '%s' not found – it must reside under /Game/Blueprints"), *BlueprintName));
-    }
-
-    UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
     if (!Blueprint)
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
 
+    // Pending edits have to be compiled into the generated class first
+    FBlueprintCompileQueue::Get().Flush(Blueprint);
+
     // Get transform parameters
     FVector Location(0.0f, 0.0f, 0.0f);
     FRotator Rotation(0.0f, 0.0f, 0.0f);
@@ -516,18 +891,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(const TSha
     if (HasTargetActor)
     {
         // Find the actor
-        AActor* TargetActor = nullptr;
-        TArray<AActor*> AllActors;
-        UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-        
-        for (AActor* Actor : AllActors)
-        {
-            if (Actor && Actor->GetName() == TargetActorName)
-            {
-                TargetActor = Actor;
-                break;
-            }
-        }
+        AActor* TargetActor = FActorIndex::Get().FindByName(GWorld, FName(*TargetActorName, FNAME_Find));
 
         if (!TargetActor)
         {
@@ -563,39 +927,135 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(const TSha
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params)
 {
-    // Get file path parameter
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+    TSharedPtr<FScreenshotCapture> Pending = Context ? Context->TakeResumeState<FScreenshotCapture>() : nullptr;
+
+    FViewportCapture::FResult SyncResult;
+    FViewportCapture::EFormat Format = FViewportCapture::EFormat::Png;
     FString FilePath;
-    if (!Params->TryGetStringField(TEXT("filepath"), FilePath))
+    bool bInline = false;
+    if (Pending.IsValid())
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'filepath' parameter"));
+        Format = Pending->Format;
+        FilePath = Pending->FilePath;
+        bInline = Pending->bInline;
     }
-    
-    // Ensure the file path has a proper extension
-    if (!FilePath.EndsWith(TEXT(".png")))
+    else
     {
-        FilePath += TEXT(".png");
-    }
+        FString FormatName;
+        Params->TryGetStringField(TEXT("format"), FormatName);
+        if (!FViewportCapture::ParseFormat(FormatName, Format))
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unsupported format '%s' (png, jpeg or bmp)"), *FormatName));
+        }
 
-    // Get the active viewport
-    if (GEditor && GEditor->GetActiveViewport())
-    {
-        FViewport* Viewport = GEditor->GetActiveViewport();
-        TArray<FColor> Bitmap;
-        FIntRect ViewportRect(0, 0, Viewport->GetSizeXY().X, Viewport->GetSizeXY().Y);
-        
-        if (Viewport->ReadPixels(Bitmap, FReadSurfaceDataFlags(), ViewportRect))
+        // Without a file path the image comes back in the response.
+        Params->TryGetStringField(TEXT("filepath"), FilePath);
+        bInline = FilePath.IsEmpty();
+        Params->TryGetBoolField(TEXT("inline"), bInline);
+        if (!FilePath.IsEmpty() && !FilePath.EndsWith(FViewportCapture::GetExtension(Format), ESearchCase::IgnoreCase)
+            && !(Format == FViewportCapture::EFormat::Jpeg && FilePath.EndsWith(TEXT(".jpeg"), ESearchCase::IgnoreCase)))
+        {
+            FilePath += FViewportCapture::GetExtension(Format);
+        }
+
+        FViewportCapture::FOptions Options;
+        Options.Format = Format;
+        Options.FilePath = FilePath;
+        double Number = 0.0;
+        if (Params->TryGetNumberField(TEXT("quality"), Number))
+        {
+            Options.Quality = FMath::Clamp(static_cast<int32>(Number), 1, 100);
+        }
+        if (Params->TryGetNumberField(TEXT("maxWidth"), Number))
+        {
+            Options.MaxWidth = FMath::Max(static_cast<int32>(Number), 0);
+        }
+        if (Params->TryGetNumberField(TEXT("maxHeight"), Number))
+        {
+            Options.MaxHeight = FMath::Max(static_cast<int32>(Number), 0);
+        }
+        const TArray<TSharedPtr<FJsonValue>>* RoiArray = nullptr;
+        if (Params->TryGetArrayField(TEXT("roi"), RoiArray))
         {
-            TArray<uint8> CompressedBitmap;
-            FImageUtils::CompressImageArray(Viewport->GetSizeXY().X, Viewport->GetSizeXY().Y, Bitmap, CompressedBitmap);
-            
-            if (FFileHelper::SaveArrayToFile(CompressedBitmap, *FilePath))
+            double Roi[4] = { 0.0, 0.0, 0.0, 0.0 };
+            for (int32 Index = 0; RoiArray->Num() == 4 && Index < 4; ++Index)
+            {
+                (*RoiArray)[Index]->TryGetNumber(Roi[Index]);
+            }
+            const int32 X = static_cast<int32>(Roi[0]);
+            const int32 Y = static_cast<int32>(Roi[1]);
+            Options.Crop = FIntRect(X, Y, X + static_cast<int32>(Roi[2]), Y + static_cast<int32>(Roi[3]));
+            if (RoiArray->Num() != 4 || Options.Crop.IsEmpty())
             {
-                TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-                ResultObj->SetStringField(TEXT("filepath"), FilePath);
-                return ResultObj;
+                return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("'roi' must be [x, y, width, height] with a positive width and height"));
             }
         }
+
+        FViewport* Viewport = GEditor ? GEditor->GetActiveViewport() : nullptr;
+        if (!Viewport)
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to take screenshot: no active viewport"));
+        }
+
+        // Batch entries must answer in the same call, so only a command running on its own reads back asynchronously.
+        TSharedPtr<FViewportCapture, ESPMode::ThreadSafe> Capture = Context && Context->CanSuspend() ? FViewportCapture::Begin(*Viewport, Options) : nullptr;
+        if (Capture.IsValid())
+        {
+            Pending = MakeShared<FScreenshotCapture>();
+            Pending->Capture = Capture;
+            Pending->Format = Format;
+            Pending->FilePath = FilePath;
+            Pending->bInline = bInline;
+        }
+        else
+        {
+            FViewportCapture::CaptureNow(*Viewport, Options, SyncResult);
+        }
     }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to take screenshot"));
-} 
+
+    if (Pending.IsValid())
+    {
+        if (Context->IsCancelled())
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Screenshot cancelled"));
+        }
+
+        Pending->Capture->Poll();
+        if (!Pending->Capture->IsDone())
+        {
+            // The GPU copy and the encode run elsewhere; this frame only checked on them.
+            Context->Suspend(Pending.ToSharedRef());
+            return nullptr;
+        }
+    }
+
+    const FViewportCapture::FResult& Result = Pending.IsValid() ? Pending->Capture->GetResult() : SyncResult;
+    if (!Result.bOk)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to take screenshot: %s"), *Result.Error));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    if (!FilePath.IsEmpty())
+    {
+        ResultObj->SetStringField(TEXT("filepath"), FilePath);
+    }
+    ResultObj->SetNumberField(TEXT("width"), Result.Width);
+    ResultObj->SetNumberField(TEXT("height"), Result.Height);
+    ResultObj->SetNumberField(TEXT("sourceWidth"), Result.SourceWidth);
+    ResultObj->SetNumberField(TEXT("sourceHeight"), Result.SourceHeight);
+    ResultObj->SetStringField(TEXT("mimeType"), FViewportCapture::GetMimeType(Format));
+    ResultObj->SetNumberField(TEXT("bytes"), Result.Encoded.Num());
+    ResultObj->SetBoolField(TEXT("async"), Result.bAsync);
+    if (bInline && Context && Context->CanAttach())
+    {
+        // Raw bytes after the frame: no base64 growth or escaping on either side.
+        ResultObj->SetObjectField(TEXT("data"), Context->Attach(TArray<uint8>(Result.Encoded)));
+    }
+    else if (bInline)
+    {
+        ResultObj->SetStringField(TEXT("data"), FBase64::Encode(Result.Encoded));
+    }
+    return ResultObj;
+}
@@ -1,5 +1,6 @@
 #include "Commands/UnrealMCPProjectCommands.h"
 #include "CoreMinimal.h"
+#include "Commands/MCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "GameFramework/InputSettings.h"
 
@@ -17,6 +18,11 @@ TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleCommand(const FString&
     return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown project command: %s"), *CommandType));
 }
 
+void FUnrealMCPProjectCommands::RegisterCommands(FMCPCommandRegistry& Registry)
+{
+    Registry.Register(TEXT("create_input_mapping"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleCreateInputMapping(Params); });
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleCreateInputMapping(const TSharedPtr<FJsonObject>& Params)
 {
     // Get required parameters
@@ -1,7 +1,8 @@
 #include "Commands/UnrealMCPSourceControlCommands.h"
 #include "CoreMinimal.h"
+#include "Commands/MCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
-#include "SourceControlService.h"
+#include "Protocol/CommandContext.h"
 
 #include "Dom/JsonValue.h"
 
@@ -35,222 +36,167 @@ TSharedPtr<FJsonObject> FUnrealMCPSourceControlCommands::HandleCommand(const FSt
         return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), FString::Printf(TEXT("Unknown source control command: %s"), *CommandType));
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPSourceControlCommands::HandleStatus(const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPSourceControlCommands::RegisterCommands(FMCPCommandRegistry& Registry)
 {
-        if (!FSourceControlService::IsEnabled())
-        {
-                return MakeErrorResponse(TEXT("SC_NOT_AVAILABLE"), TEXT("Source control integration is disabled"));
-        }
-
-        TArray<FString> Files;
-        TArray<FString> Assets;
-        FString ExtractionError;
-        if (!ExtractTargets(Params, Files, Assets, ExtractionError))
-        {
-                return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), ExtractionError);
-        }
+        Registry.Register(TEXT("sc.status"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleStatus(Params); });
+        Registry.Register(TEXT("sc.checkout"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleCheckout(Params); });
+        Registry.Register(TEXT("sc.add"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleAdd(Params); });
+        Registry.Register(TEXT("sc.revert"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleRevert(Params); });
+        Registry.Register(TEXT("sc.submit"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleSubmit(Params); });
+}
 
-        FString AssetConversionError;
-        if (Assets.Num() > 0)
+TSharedPtr<FJsonObject> FUnrealMCPSourceControlCommands::HandleStatus(const TSharedPtr<FJsonObject>& Params)
+{
+        bool bCached = false;
+        if (Params.IsValid() && Params->TryGetBoolField(TEXT("cached"), bCached) && bCached)
         {
-                TArray<FString> AssetFiles;
-                if (!FSourceControlService::AssetPathsToFiles(Assets, AssetFiles, AssetConversionError))
+                if (!FSourceControlService::IsEnabled())
                 {
-                        return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), AssetConversionError);
+                        return MakeErrorResponse(TEXT("SC_NOT_AVAILABLE"), TEXT("Source control integration is disabled"));
                 }
 
-                Files.Append(AssetFiles);
-        }
+                TArray<FString> Files;
+                FString TargetError;
+                if (!CollectTargetFiles(Params, Files, TargetError))
+                {
+                        return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), TargetError);
+                }
 
-        TMap<FString, FString> PerFileStates;
-        FString OperationError;
-        const bool bSucceeded = FSourceControlService::UpdateStatus(Files, PerFileStates, OperationError);
+                // Whatever the provider last heard, kept fresh for recent checkouts by the background refresh.
+                TMap<FString, FString> PerFileStates;
+                FString CacheError;
+                if (!FSourceControlService::GetCachedStatus(Files, PerFileStates, CacheError))
+                {
+                        return MakeErrorResponse(TEXT("SC_NOT_AVAILABLE"), CacheError);
+                }
 
-        if (!bSucceeded && !OperationError.IsEmpty())
-        {
-                return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), OperationError);
+                TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+                Data->SetArrayField(TEXT("perFileResults"), BuildPerFileStatusArray(PerFileStates));
+                Data->SetBoolField(TEXT("cached"), true);
+                return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
         }
 
-        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-        TArray<TSharedPtr<FJsonValue>> Results = BuildPerFileStatusArray(PerFileStates);
-        Data->SetArrayField(TEXT("perFileResults"), Results);
-
-        return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+        return RunOperation(FSourceControlService::EOperation::UpdateStatus, Params, FString());
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPSourceControlCommands::HandleCheckout(const TSharedPtr<FJsonObject>& Params)
 {
-        if (!FSourceControlService::IsEnabled())
-        {
-                return MakeErrorResponse(TEXT("SC_NOT_AVAILABLE"), TEXT("Source control integration is disabled"));
-        }
-
-        TArray<FString> Files;
-        TArray<FString> Assets;
-        FString ExtractionError;
-        if (!ExtractTargets(Params, Files, Assets, ExtractionError))
-        {
-                return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), ExtractionError);
-        }
-
-        FString AssetConversionError;
-        if (Assets.Num() > 0)
-        {
-                TArray<FString> AssetFiles;
-                if (!FSourceControlService::AssetPathsToFiles(Assets, AssetFiles, AssetConversionError))
-                {
-                        return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), AssetConversionError);
-                }
+        return RunOperation(FSourceControlService::EOperation::Checkout, Params, FString());
+}
 
-                Files.Append(AssetFiles);
-        }
+TSharedPtr<FJsonObject> FUnrealMCPSourceControlCommands::HandleAdd(const TSharedPtr<FJsonObject>& Params)
+{
+        return RunOperation(FSourceControlService::EOperation::MarkForAdd, Params, FString());
+}
 
-        TMap<FString, bool> PerFileResults;
-        FString OperationError;
-        const bool bSucceeded = FSourceControlService::Checkout(Files, PerFileResults, OperationError);
+TSharedPtr<FJsonObject> FUnrealMCPSourceControlCommands::HandleRevert(const TSharedPtr<FJsonObject>& Params)
+{
+        return RunOperation(FSourceControlService::EOperation::Revert, Params, FString());
+}
 
-        if (!bSucceeded && !OperationError.IsEmpty())
+TSharedPtr<FJsonObject> FUnrealMCPSourceControlCommands::HandleSubmit(const TSharedPtr<FJsonObject>& Params)
+{
+        FString Description;
+        if (!Params.IsValid() || !Params->TryGetStringField(TEXT("description"), Description) || Description.IsEmpty())
         {
-                return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), OperationError);
+                return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), TEXT("Missing or empty 'description'"));
         }
 
-        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-        Data->SetArrayField(TEXT("perFileResults"), BuildPerFileResultArray(PerFileResults));
-        return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+        return RunOperation(FSourceControlService::EOperation::Submit, Params, Description);
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPSourceControlCommands::HandleAdd(const TSharedPtr<FJsonObject>& Params)
+TSharedPtr<FJsonObject> FUnrealMCPSourceControlCommands::RunOperation(FSourceControlService::EOperation Operation, const TSharedPtr<FJsonObject>& Params, const FString& Description)
 {
-        if (!FSourceControlService::IsEnabled())
-        {
-                return MakeErrorResponse(TEXT("SC_NOT_AVAILABLE"), TEXT("Source control integration is disabled"));
-        }
+        UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+        TSharedPtr<FPendingOperation> Pending = Context ? Context->TakeResumeState<FPendingOperation>() : nullptr;
 
-        TArray<FString> Files;
-        TArray<FString> Assets;
-        FString ExtractionError;
-        if (!ExtractTargets(Params, Files, Assets, ExtractionError))
+        if (!Pending.IsValid())
         {
-                return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), ExtractionError);
-        }
+                if (!FSourceControlService::IsEnabled())
+                {
+                        return MakeErrorResponse(TEXT("SC_NOT_AVAILABLE"), TEXT("Source control integration is disabled"));
+                }
 
-        FString AssetConversionError;
-        if (Assets.Num() > 0)
-        {
-                TArray<FString> AssetFiles;
-                if (!FSourceControlService::AssetPathsToFiles(Assets, AssetFiles, AssetConversionError))
+                TArray<FString> Files;
+                FString TargetError;
+                if (!CollectTargetFiles(Params, Files, TargetError))
                 {
-                        return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), AssetConversionError);
+                        return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), TargetError);
                 }
 
-                Files.Append(AssetFiles);
+                // Batch entries must answer in the same call, so only a command running on its own goes async.
+                const bool bAsync = Context && Context->CanSuspend();
+                Pending = MakeShared<FPendingOperation>(FSourceControlService::BeginOperation(Operation, Files, Description, bAsync));
         }
 
-        TMap<FString, bool> PerFileResults;
-        FString OperationError;
-        const bool bSucceeded = FSourceControlService::MarkForAdd(Files, PerFileResults, OperationError);
-
-        if (!bSucceeded && !OperationError.IsEmpty())
+        if (!Pending->Result->bDone)
         {
-                return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), OperationError);
-        }
-
-        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-        Data->SetArrayField(TEXT("perFileResults"), BuildPerFileResultArray(PerFileResults));
-        return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
-}
+                if (Context->IsCancelled() && !Pending->bCancelRequested)
+                {
+                        Pending->bCancelRequested = true;
+                        FSourceControlService::CancelOperation(Pending->Result);
+                }
 
-TSharedPtr<FJsonObject> FUnrealMCPSourceControlCommands::HandleRevert(const TSharedPtr<FJsonObject>& Params)
-{
-        if (!FSourceControlService::IsEnabled())
-        {
-                return MakeErrorResponse(TEXT("SC_NOT_AVAILABLE"), TEXT("Source control integration is disabled"));
+                // The provider works in the background; this frame only checked a flag.
+                Context->Suspend(Pending.ToSharedRef());
+                return nullptr;
         }
 
-        TArray<FString> Files;
-        TArray<FString> Assets;
-        FString ExtractionError;
-        if (!ExtractTargets(Params, Files, Assets, ExtractionError))
+        const FSourceControlService::FOperationResult& Result = *Pending->Result;
+        if (Result.bCancelled)
         {
-                return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), ExtractionError);
+                return MakeErrorResponse(TEXT("CANCELLED"), Result.Error);
         }
 
-        FString AssetConversionError;
-        if (Assets.Num() > 0)
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        switch (Operation)
         {
-                TArray<FString> AssetFiles;
-                if (!FSourceControlService::AssetPathsToFiles(Assets, AssetFiles, AssetConversionError))
+        case FSourceControlService::EOperation::UpdateStatus:
+                if (!Result.bSucceeded && !Result.Error.IsEmpty())
                 {
-                        return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), AssetConversionError);
+                        return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), Result.Error);
                 }
-
-                Files.Append(AssetFiles);
-        }
-
-        TMap<FString, bool> PerFileResults;
-        FString OperationError;
-        const bool bSucceeded = FSourceControlService::Revert(Files, PerFileResults, OperationError);
-
-        if (!bSucceeded && !OperationError.IsEmpty())
-        {
-                return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), OperationError);
+                Data->SetArrayField(TEXT("perFileResults"), BuildPerFileStatusArray(Result.PerFileState));
+                break;
+        case FSourceControlService::EOperation::Submit:
+                if (!Result.bSucceeded)
+                {
+                        return MakeErrorResponse(TEXT("SC_SUBMIT_FAILED"), Result.Error.IsEmpty() ? FString(TEXT("Submit failed")) : Result.Error);
+                }
+                Data->SetArrayField(TEXT("perFileResults"), BuildPerFileResultArray(Result.PerFileOk));
+                break;
+        default:
+                if (!Result.bSucceeded && !Result.Error.IsEmpty())
+                {
+                        return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), Result.Error);
+                }
+                Data->SetArrayField(TEXT("perFileResults"), BuildPerFileResultArray(Result.PerFileOk));
+                break;
         }
 
-        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-        Data->SetArrayField(TEXT("perFileResults"), BuildPerFileResultArray(PerFileResults));
         return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPSourceControlCommands::HandleSubmit(const TSharedPtr<FJsonObject>& Params)
+bool FUnrealMCPSourceControlCommands::CollectTargetFiles(const TSharedPtr<FJsonObject>& Params, TArray<FString>& OutFiles, FString& OutError) const
 {
-        if (!FSourceControlService::IsEnabled())
-        {
-                return MakeErrorResponse(TEXT("SC_NOT_AVAILABLE"), TEXT("Source control integration is disabled"));
-        }
-
-        FString Description;
-        if (!Params.IsValid() || !Params->TryGetStringField(TEXT("description"), Description) || Description.IsEmpty())
-        {
-                return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), TEXT("Missing or empty 'description'"));
-        }
-
-        TArray<FString> Files;
         TArray<FString> Assets;
-        FString ExtractionError;
-        if (!ExtractTargets(Params, Files, Assets, ExtractionError))
+        if (!ExtractTargets(Params, OutFiles, Assets, OutError))
         {
-                return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), ExtractionError);
+                return false;
         }
 
-        FString AssetConversionError;
         if (Assets.Num() > 0)
         {
                 TArray<FString> AssetFiles;
-                if (!FSourceControlService::AssetPathsToFiles(Assets, AssetFiles, AssetConversionError))
+                if (!FSourceControlService::AssetPathsToFiles(Assets, AssetFiles, OutError))
                 {
-                        return MakeErrorResponse(TEXT("SC_OPERATION_FAILED"), AssetConversionError);
+                        return false;
                 }
 
-                Files.Append(AssetFiles);
+                OutFiles.Append(AssetFiles);
         }
 
-        TMap<FString, bool> PerFileResults;
-        FString OperationError;
-        const bool bSucceeded = FSourceControlService::Submit(Files, Description, PerFileResults, OperationError);
-
-        if (!bSucceeded)
-        {
-                if (!OperationError.IsEmpty())
-                {
-                        return MakeErrorResponse(TEXT("SC_SUBMIT_FAILED"), OperationError);
-                }
-
-                return MakeErrorResponse(TEXT("SC_SUBMIT_FAILED"), TEXT("Submit failed"));
-        }
-
-        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-        Data->SetArrayField(TEXT("perFileResults"), BuildPerFileResultArray(PerFileResults));
-        return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+        return true;
 }
 
 bool FUnrealMCPSourceControlCommands::ExtractTargets(const TSharedPtr<FJsonObject>& Params, TArray<FString>& OutFiles, TArray<FString>& OutAssets, FString& OutError) const
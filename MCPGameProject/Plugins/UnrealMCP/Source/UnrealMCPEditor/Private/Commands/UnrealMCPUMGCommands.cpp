@@ -1,5 +1,8 @@
 #include "Commands/UnrealMCPUMGCommands.h"
 #include "CoreMinimal.h"
+#include "Commands/BlueprintCompileQueue.h"
+#include "Commands/BlueprintResolver.h"
+#include "Commands/MCPCommandRegistry.h"
 
 #include "WidgetBlueprint.h" // nécessite UMGEditor en PrivateDependency
 #include "Blueprint/UserWidget.h"
@@ -17,6 +20,10 @@
 #include "Blueprint/WidgetTree.h"
 #include "Components/CanvasPanel.h"
 #include "Components/CanvasPanelSlot.h"
+#include "Components/ContentWidget.h"
+#include "Components/PanelSlot.h"
+#include "Components/PanelWidget.h"
+#include "EdGraphSchema_K2_Actions.h"
 #include "JsonObjectConverter.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Components/Button.h"
@@ -26,8 +33,310 @@
 #include "K2Node_VariableSet.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet2/KismetEditorUtilities.h"
+#include "K2Node_ComponentBoundEvent.h"
 #include "K2Node_Event.h"
 #include "SourceControlService.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+	/** Widgets one umg.build_tree takes; a busy HUD screen is a few hundred. */
+	constexpr int32 MaxTreeWidgets = 2000;
+	constexpr int32 MaxTreeDepth = 64;
+
+	/**
+	 * The widget class Type names: a native class ("TextBlock", "UTextBlock"), a class path, or
+	 * another Widget Blueprint by name or path. Null unless it is a concrete widget class.
+	 */
+	UClass* FindWidgetClass(const FString& Type, const UWidgetBlueprint* Target)
+	{
+		UClass* Class = nullptr;
+		if (Type.StartsWith(TEXT("/")))
+		{
+			Class = LoadObject<UClass>(nullptr, *Type);
+		}
+		else
+		{
+			Class = FindFirstObject<UClass>(*Type, EFindFirstObjectOptions::NativeFirst);
+			if (!Class && Type.Len() > 1 && Type[0] == TEXT('U'))
+			{
+				Class = FindFirstObject<UClass>(*Type.RightChop(1), EFindFirstObjectOptions::NativeFirst);
+			}
+		}
+		if (!Class)
+		{
+			if (const UWidgetBlueprint* Nested = Cast<UWidgetBlueprint>(FBlueprintResolver::Get().Find(Type)))
+			{
+				Class = Nested->GeneratedClass;
+			}
+		}
+
+		if (!Class || !Class->IsChildOf(UWidget::StaticClass()) || Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated))
+		{
+			return nullptr;
+		}
+		// A widget blueprint cannot contain itself
+		return Target && Class->IsChildOf(Target->GeneratedClass) ? nullptr : Class;
+	}
+
+	TSharedPtr<FJsonObject> MakeTreeFailure(const FString& Widget, const FString& Error)
+	{
+		TSharedPtr<FJsonObject> Failure = MakeShared<FJsonObject>();
+		Failure->SetStringField(TEXT("widget"), Widget);
+		Failure->SetStringField(TEXT("error"), Error);
+		return Failure;
+	}
+
+	/**
+	 * Checks a widget spec and its children before anything is built: every type resolves, names
+	 * are unique in the request and, with bCheckTree, free in the tree, and only panels have children.
+	 */
+	bool ValidateWidgetSpec(const TSharedPtr<FJsonValue>& Value, const FString& Where, int32 Depth, const UWidgetBlueprint* WidgetBlueprint,
+		bool bCheckTree, TSet<FString>& Names, int32& NumWidgets, FString& OutError)
+	{
+		const TSharedPtr<FJsonObject>* Spec = nullptr;
+		if (!Value.IsValid() || !Value->TryGetObject(Spec))
+		{
+			OutError = FString::Printf(TEXT("%s is not an object"), *Where);
+			return false;
+		}
+		if (++NumWidgets > MaxTreeWidgets || Depth > MaxTreeDepth)
+		{
+			OutError = FString::Printf(TEXT("A widget tree holds at most %d widgets, %d deep"), MaxTreeWidgets, MaxTreeDepth);
+			return false;
+		}
+
+		FString Type;
+		if (!(*Spec)->TryGetStringField(TEXT("type"), Type) || Type.IsEmpty())
+		{
+			OutError = FString::Printf(TEXT("%s is missing 'type'"), *Where);
+			return false;
+		}
+		UClass* Class = FindWidgetClass(Type, WidgetBlueprint);
+		if (!Class)
+		{
+			OutError = FString::Printf(TEXT("%s: '%s' is not a widget class"), *Where, *Type);
+			return false;
+		}
+
+		FString Name;
+		if ((*Spec)->TryGetStringField(TEXT("name"), Name) && !Name.IsEmpty())
+		{
+			bool bAlreadyInSet = false;
+			Names.Add(Name, &bAlreadyInSet);
+			// Widgets of the tree are outered to it, so a removed one holding the name counts too
+			if (bAlreadyInSet || (bCheckTree && StaticFindObjectFast(nullptr, WidgetBlueprint->WidgetTree, FName(*Name))))
+			{
+				OutError = FString::Printf(TEXT("%s: a widget named '%s' already exists"), *Where, *Name);
+				return false;
+			}
+		}
+		else if ((*Spec)->HasField(TEXT("events")) || (*Spec)->HasField(TEXT("text_binding")))
+		{
+			OutError = FString::Printf(TEXT("%s: a widget with events or a text binding needs a 'name'"), *Where);
+			return false;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Children = nullptr;
+		if ((*Spec)->TryGetArrayField(TEXT("children"), Children) && Children->Num() > 0)
+		{
+			const UPanelWidget* Panel = Cast<UPanelWidget>(Class->GetDefaultObject());
+			if (!Panel)
+			{
+				OutError = FString::Printf(TEXT("%s: a %s cannot have children"), *Where, *Class->GetName());
+				return false;
+			}
+			if (!Panel->CanHaveMultipleChildren() && Children->Num() > 1)
+			{
+				OutError = FString::Printf(TEXT("%s: a %s holds one child"), *Where, *Class->GetName());
+				return false;
+			}
+			for (int32 Index = 0; Index < Children->Num(); ++Index)
+			{
+				if (!ValidateWidgetSpec((*Children)[Index], FString::Printf(TEXT("%s.children[%d]"), *Where, Index), Depth + 1, WidgetBlueprint, bCheckTree, Names, NumWidgets, OutError))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool TryGetVector2D(const TSharedPtr<FJsonValue>& Value, FVector2D& OutVector)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Numbers = nullptr;
+		if (!Value.IsValid() || !Value->TryGetArray(Numbers) || Numbers->Num() < 2)
+		{
+			return false;
+		}
+		OutVector = FVector2D((*Numbers)[0]->AsNumber(), (*Numbers)[1]->AsNumber());
+		return true;
+	}
+
+	/**
+	 * Applies a "slot" object: position, size, anchors ([minX, minY, maxX, maxY]), alignment,
+	 * auto_size and z_order on a canvas slot; any other key is a property of the slot itself
+	 * (Padding, HorizontalAlignment, Size...).
+	 */
+	void ApplySlot(UPanelSlot* Slot, const TSharedPtr<FJsonObject>& SlotSpec, const FString& WidgetName, TArray<TSharedPtr<FJsonValue>>& Failures)
+	{
+		UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(Slot);
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : SlotSpec->Values)
+		{
+			if (CanvasSlot)
+			{
+				FVector2D Vector;
+				const TArray<TSharedPtr<FJsonValue>>* Numbers = nullptr;
+				bool bFlag = false;
+				double Number = 0.0;
+				if (Pair.Key == TEXT("position") && TryGetVector2D(Pair.Value, Vector))
+				{
+					CanvasSlot->SetPosition(Vector);
+					continue;
+				}
+				if (Pair.Key == TEXT("size") && TryGetVector2D(Pair.Value, Vector))
+				{
+					CanvasSlot->SetSize(Vector);
+					continue;
+				}
+				if (Pair.Key == TEXT("alignment") && TryGetVector2D(Pair.Value, Vector))
+				{
+					CanvasSlot->SetAlignment(Vector);
+					continue;
+				}
+				if (Pair.Key == TEXT("anchors") && Pair.Value->TryGetArray(Numbers) && Numbers->Num() >= 4)
+				{
+					CanvasSlot->SetAnchors(FAnchors((*Numbers)[0]->AsNumber(), (*Numbers)[1]->AsNumber(), (*Numbers)[2]->AsNumber(), (*Numbers)[3]->AsNumber()));
+					continue;
+				}
+				if (Pair.Key == TEXT("auto_size") && Pair.Value->TryGetBool(bFlag))
+				{
+					CanvasSlot->SetAutoSize(bFlag);
+					continue;
+				}
+				if (Pair.Key == TEXT("z_order") && Pair.Value->TryGetNumber(Number))
+				{
+					CanvasSlot->SetZOrder(static_cast<int32>(Number));
+					continue;
+				}
+			}
+
+			FString Error;
+			if (!FUnrealMCPCommonUtils::SetObjectProperty(Slot, Pair.Key, Pair.Value, Error))
+			{
+				Failures.Add(MakeShared<FJsonValueObject>(MakeTreeFailure(WidgetName, FString::Printf(TEXT("slot.%s: %s"), *Pair.Key, *Error))));
+			}
+		}
+	}
+
+	/** What a built tree still needs once the skeleton class has the new widget variables. */
+	struct FPendingBindings
+	{
+		TArray<TPair<UWidget*, FString>> Events;
+		TArray<FString> TextBindings;
+	};
+
+	/** Builds Spec (already validated) and its children under Parent, or as the root when Parent is null. */
+	UWidget* BuildWidget(UWidgetBlueprint* WidgetBlueprint, const TSharedPtr<FJsonObject>& Spec, UPanelWidget* Parent,
+		TArray<TSharedPtr<FJsonValue>>& CreatedJson, TArray<TSharedPtr<FJsonValue>>& Failures, FPendingBindings& Bindings)
+	{
+		UClass* Class = FindWidgetClass(Spec->GetStringField(TEXT("type")), WidgetBlueprint);
+		FString Name;
+		Spec->TryGetStringField(TEXT("name"), Name);
+		UWidget* Widget = WidgetBlueprint->WidgetTree->ConstructWidget<UWidget>(Class, Name.IsEmpty() ? NAME_None : FName(*Name));
+		if (!Widget)
+		{
+			Failures.Add(MakeShared<FJsonValueObject>(MakeTreeFailure(Name, TEXT("Failed to create widget"))));
+			return nullptr;
+		}
+		Name = Widget->GetName();
+		CreatedJson.Add(MakeShared<FJsonValueString>(Name));
+
+		if (Parent)
+		{
+			UPanelSlot* Slot = Parent->AddChild(Widget);
+			const TSharedPtr<FJsonObject>* SlotSpec = nullptr;
+			if (Slot && Spec->TryGetObjectField(TEXT("slot"), SlotSpec))
+			{
+				ApplySlot(Slot, *SlotSpec, Name, Failures);
+			}
+		}
+		else
+		{
+			WidgetBlueprint->WidgetTree->RootWidget = Widget;
+		}
+
+		const TSharedPtr<FJsonObject>* Properties = nullptr;
+		if (Spec->TryGetObjectField(TEXT("properties"), Properties))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*Properties)->Values)
+			{
+				FString Error;
+				if (!FUnrealMCPCommonUtils::SetObjectProperty(Widget, Pair.Key, Pair.Value, Error))
+				{
+					Failures.Add(MakeShared<FJsonValueObject>(MakeTreeFailure(Name, FString::Printf(TEXT("%s: %s"), *Pair.Key, *Error))));
+				}
+			}
+		}
+
+		bool bIsVariable = false;
+		if (Spec->TryGetBoolField(TEXT("is_variable"), bIsVariable))
+		{
+			Widget->bIsVariable = bIsVariable;
+		}
+		const TArray<TSharedPtr<FJsonValue>>* Events = nullptr;
+		if (Spec->TryGetArrayField(TEXT("events"), Events))
+		{
+			for (const TSharedPtr<FJsonValue>& Event : *Events)
+			{
+				FString EventName;
+				if (Event.IsValid() && Event->TryGetString(EventName) && !EventName.IsEmpty())
+				{
+					// Set now, so the one skeleton regeneration after the build has the variable
+					Widget->bIsVariable = true;
+					Bindings.Events.Emplace(Widget, EventName);
+				}
+			}
+		}
+		FString TextBinding;
+		if (Spec->TryGetStringField(TEXT("text_binding"), TextBinding) && !TextBinding.IsEmpty())
+		{
+			Bindings.TextBindings.AddUnique(TextBinding);
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Children = nullptr;
+		const bool bHasChildren = Spec->TryGetArrayField(TEXT("children"), Children) && Children->Num() > 0;
+		FString Text;
+		const bool bHasText = Spec->TryGetStringField(TEXT("text"), Text);
+		if (UTextBlock* TextBlock = Cast<UTextBlock>(Widget))
+		{
+			if (bHasText)
+			{
+				TextBlock->SetText(FText::FromString(Text));
+			}
+		}
+		else if (bHasText && !bHasChildren && Widget->IsA<UContentWidget>())
+		{
+			// A labelled button, as add_button_to_widget makes it
+			UTextBlock* Label = WidgetBlueprint->WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(),
+				MakeUniqueObjectName(WidgetBlueprint->WidgetTree, UTextBlock::StaticClass(), FName(*(Name + TEXT("_Text")))));
+			Label->SetText(FText::FromString(Text));
+			CastChecked<UPanelWidget>(Widget)->AddChild(Label);
+			CreatedJson.Add(MakeShared<FJsonValueString>(Label->GetName()));
+		}
+
+		if (bHasChildren)
+		{
+			UPanelWidget* Panel = CastChecked<UPanelWidget>(Widget);
+			for (const TSharedPtr<FJsonValue>& Child : *Children)
+			{
+				BuildWidget(WidgetBlueprint, Child->AsObject(), Panel, CreatedJson, Failures, Bindings);
+			}
+		}
+		return Widget;
+	}
+}
 
 FUnrealMCPUMGCommands::FUnrealMCPUMGCommands()
 {
@@ -59,10 +368,25 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCommand(const FString& Comm
 	{
 		return HandleSetTextBlockBinding(Params);
 	}
+	else if (CommandName == TEXT("umg.build_tree"))
+	{
+		return HandleBuildWidgetTree(Params);
+	}
 
 	return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown UMG command: %s"), *CommandName));
 }
 
+void FUnrealMCPUMGCommands::RegisterCommands(FMCPCommandRegistry& Registry)
+{
+	Registry.Register(TEXT("create_umg_widget_blueprint"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleCreateUMGWidgetBlueprint(Params); });
+	Registry.Register(TEXT("add_text_block_to_widget"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddTextBlockToWidget(Params); });
+	Registry.Register(TEXT("add_button_to_widget"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddButtonToWidget(Params); });
+	Registry.Register(TEXT("bind_widget_event"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleBindWidgetEvent(Params); });
+	Registry.Register(TEXT("set_text_block_binding"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleSetTextBlockBinding(Params); });
+	Registry.Register(TEXT("add_widget_to_viewport"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleAddWidgetToViewport(Params); });
+	Registry.Register(TEXT("umg.build_tree"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleBuildWidgetTree(Params); });
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCreateUMGWidgetBlueprint(const TSharedPtr<FJsonObject>& Params)
 {
 	// Get required parameters
@@ -119,8 +443,9 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCreateUMGWidgetBlueprint(co
         Package->MarkPackageDirty();
         FAssetRegistryModule::AssetCreated(WidgetBlueprint);
 
-        // Compile the blueprint
-        FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+        // The root canvas is compiled in with whatever widgets follow; saved now so it can be marked for add
+        FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(WidgetBlueprint);
+        FBlueprintCompileQueue::Get().Request(WidgetBlueprint, /*bSave=*/true);
 
         const FString FullAssetPath = PackagePath + AssetName;
         UEditorAssetLibrary::SaveAsset(FullAssetPath, false);
@@ -205,9 +530,10 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddTextBlockToWidget(const
 	UCanvasPanelSlot* PanelSlot = RootCanvas->AddChildToCanvas(TextBlock);
 	PanelSlot->SetPosition(Position);
 
-	// Mark the package dirty and compile
+	// Mark the package dirty; the compile is coalesced with the edits that follow
 	WidgetBlueprint->MarkPackageDirty();
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(WidgetBlueprint);
+	FBlueprintCompileQueue::Get().Request(WidgetBlueprint);
 
 	// Create success response
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -237,7 +563,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddWidgetToViewport(const T
 	int32 ZOrder = 0;
 	Params->TryGetNumberField(TEXT("z_order"), ZOrder);
 
-	// Create widget instance
+	// Create widget instance, from a class that has the pending edits compiled in
+	FBlueprintCompileQueue::Get().Flush(WidgetBlueprint);
 	UClass* WidgetClass = WidgetBlueprint->GeneratedClass;
 	if (!WidgetClass)
 	{
@@ -293,6 +620,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddButtonToWidget(const TSh
 	}
 
 	// Create Button widget
+	FBlueprintCompileQueue::Get().Flush(WidgetBlueprint);
 	UButton* Button = NewObject<UButton>(WidgetBlueprint->GeneratedClass->GetDefaultObject(), UButton::StaticClass(), *WidgetName);
 	if (!Button)
 	{
@@ -331,9 +659,9 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddButtonToWidget(const TSh
 		}
 	}
 
-	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	// Compiled and saved once the edits to this widget settle
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(WidgetBlueprint);
+	FBlueprintCompileQueue::Get().Request(WidgetBlueprint, /*bSave=*/true);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("widget_name"), WidgetName);
@@ -375,14 +703,6 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleBindWidgetEvent(const TShar
 		return Response;
 	}
 
-	// Create the event graph if it doesn't exist
-	UEdGraph* EventGraph = FBlueprintEditorUtils::FindEventGraph(WidgetBlueprint);
-	if (!EventGraph)
-	{
-		Response->SetStringField(TEXT("error"), TEXT("Failed to find or create event graph"));
-		return Response;
-	}
-
 	// Find the widget in the blueprint
 	UWidget* Widget = WidgetBlueprint->WidgetTree->FindWidget(*WidgetName);
 	if (!Widget)
@@ -391,71 +711,17 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleBindWidgetEvent(const TShar
 		return Response;
 	}
 
-	// Create the event node (e.g., OnClicked for buttons)
-	UK2Node_Event* EventNode = nullptr;
-	
-	// Find existing nodes first
-	TArray<UK2Node_Event*> AllEventNodes;
-	FBlueprintEditorUtils::GetAllNodesOfClass<UK2Node_Event>(WidgetBlueprint, AllEventNodes);
-	
-	for (UK2Node_Event* Node : AllEventNodes)
-	{
-		if (Node->CustomFunctionName == FName(*EventName) && Node->EventReference.GetMemberParentClass() == Widget->GetClass())
-		{
-			EventNode = Node;
-			break;
-		}
-	}
-
-	// If no existing node, create a new one
-	if (!EventNode)
-	{
-		// Calculate position - place it below existing nodes
-		float MaxHeight = 0.0f;
-		for (UEdGraphNode* Node : EventGraph->Nodes)
-		{
-			MaxHeight = FMath::Max(MaxHeight, Node->NodePosY);
-		}
-		
-		const FVector2D NodePos(200, MaxHeight + 200);
-
-		// Call CreateNewBoundEventForClass, which returns void, so we can't capture the return value directly
-		// We'll need to find the node after creating it
-		FKismetEditorUtilities::CreateNewBoundEventForClass(
-			Widget->GetClass(),
-			FName(*EventName),
-			WidgetBlueprint,
-			nullptr  // We don't need a specific property binding
-		);
-
-		// Now find the newly created node
-		TArray<UK2Node_Event*> UpdatedEventNodes;
-		FBlueprintEditorUtils::GetAllNodesOfClass<UK2Node_Event>(WidgetBlueprint, UpdatedEventNodes);
-		
-		for (UK2Node_Event* Node : UpdatedEventNodes)
-		{
-			if (Node->CustomFunctionName == FName(*EventName) && Node->EventReference.GetMemberParentClass() == Widget->GetClass())
-			{
-				EventNode = Node;
-				
-				// Set position of the node
-				EventNode->NodePosX = NodePos.X;
-				EventNode->NodePosY = NodePos.Y;
-				
-				break;
-			}
-		}
-	}
-
+	// Find or create the event node (e.g., OnClicked for buttons)
+	UK2Node_Event* EventNode = FindOrAddBoundEvent(WidgetBlueprint, Widget, EventName);
 	if (!EventNode)
 	{
 		Response->SetStringField(TEXT("error"), TEXT("Failed to create event node"));
 		return Response;
 	}
 
-	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	// Compiled and saved once the edits to this widget settle
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(WidgetBlueprint);
+	FBlueprintCompileQueue::Get().Request(WidgetBlueprint, /*bSave=*/true);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("event_name"), EventName);
@@ -497,13 +763,6 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleSetTextBlockBinding(const T
 		return Response;
 	}
 
-	// Create a variable for binding if it doesn't exist
-	FBlueprintEditorUtils::AddMemberVariable(
-		WidgetBlueprint,
-		FName(*BindingName),
-		FEdGraphPinType(UEdGraphSchema_K2::PC_Text, NAME_None, nullptr, EPinContainerType::None, false, FEdGraphTerminalType())
-	);
-
 	// Find the TextBlock widget
 	UTextBlock* TextBlock = Cast<UTextBlock>(WidgetBlueprint->WidgetTree->FindWidget(FName(*WidgetName)));
 	if (!TextBlock)
@@ -512,11 +771,239 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleSetTextBlockBinding(const T
 		return Response;
 	}
 
-	// Create binding function
+	AddTextBinding(WidgetBlueprint, BindingName);
+
+	// Compiled and saved once the edits to this widget settle
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(WidgetBlueprint);
+	FBlueprintCompileQueue::Get().Request(WidgetBlueprint, /*bSave=*/true);
+
+	Response->SetBoolField(TEXT("success"), true);
+	Response->SetStringField(TEXT("binding_name"), BindingName);
+	return Response;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleBuildWidgetTree(const TSharedPtr<FJsonObject>& Params)
+{
+	FString BlueprintName;
+	if (!Params->TryGetStringField(TEXT("blueprint_name"), BlueprintName))
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'blueprint_name' parameter"));
+	}
+
+	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(FBlueprintResolver::Get().Find(BlueprintName));
+	if (!WidgetBlueprint || !WidgetBlueprint->WidgetTree)
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Widget Blueprint '%s' not found"), *BlueprintName));
+	}
+	UWidgetTree* WidgetTree = WidgetBlueprint->WidgetTree;
+
+	const TSharedPtr<FJsonValue> RootJson = Params->TryGetField(TEXT("root"));
+	const TArray<TSharedPtr<FJsonValue>>* WidgetsJson = nullptr;
+	Params->TryGetArrayField(TEXT("widgets"), WidgetsJson);
+	if (RootJson.IsValid() == (WidgetsJson != nullptr))
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Give either 'root' (the whole tree) or 'widgets' (added under 'parent')"));
+	}
+
+	bool bReplace = false;
+	Params->TryGetBoolField(TEXT("replace"), bReplace);
+	bool bCompile = true;
+	Params->TryGetBoolField(TEXT("compile"), bCompile);
+
+	if (RootJson.IsValid() && WidgetTree->RootWidget && !bReplace)
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("'%s' already has a root widget; pass 'replace' to rebuild the tree, or 'widgets' to add to it"), *BlueprintName));
+	}
+
+	UPanelWidget* Parent = nullptr;
+	if (WidgetsJson)
+	{
+		FString ParentName;
+		if (Params->TryGetStringField(TEXT("parent"), ParentName) && !ParentName.IsEmpty())
+		{
+			Parent = Cast<UPanelWidget>(WidgetTree->FindWidget(FName(*ParentName)));
+			if (!Parent)
+			{
+				return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("'%s' is not a panel widget in '%s'"), *ParentName, *BlueprintName));
+			}
+		}
+		else if (WidgetTree->RootWidget)
+		{
+			Parent = Cast<UPanelWidget>(WidgetTree->RootWidget);
+			if (!Parent)
+			{
+				return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("The root widget is not a panel; name a 'parent'"));
+			}
+		}
+		if (Parent && !Parent->CanHaveMultipleChildren() && Parent->GetChildrenCount() + WidgetsJson->Num() > 1)
+		{
+			return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("'%s' holds one child"), *Parent->GetName()));
+		}
+	}
+
+	// Check every spec before touching the tree, so a malformed request changes nothing
+	TSet<FString> Names;
+	int32 NumWidgets = 0;
+	FString Error;
+	// A replaced tree gives up its names
+	const bool bCheckTree = !(bReplace && RootJson.IsValid());
+	if (RootJson.IsValid())
+	{
+		if (!ValidateWidgetSpec(RootJson, TEXT("root"), 0, WidgetBlueprint, bCheckTree, Names, NumWidgets, Error))
+		{
+			return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+		}
+	}
+	else
+	{
+		for (int32 Index = 0; Index < WidgetsJson->Num(); ++Index)
+		{
+			if (!ValidateWidgetSpec((*WidgetsJson)[Index], FString::Printf(TEXT("widgets[%d]"), Index), 0, WidgetBlueprint, bCheckTree, Names, NumWidgets, Error))
+			{
+				return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+			}
+		}
+	}
+
+	if (bReplace && RootJson.IsValid())
+	{
+		// The old widgets move out of the tree's outer, which frees their names for the new tree
+		TArray<UObject*> OldObjects;
+		GetObjectsWithOuter(WidgetTree, OldObjects, /*bIncludeNestedObjects=*/false);
+		WidgetTree->RootWidget = nullptr;
+		for (UObject* Object : OldObjects)
+		{
+			if (UWidget* OldWidget = Cast<UWidget>(Object))
+			{
+				OldWidget->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_NonTransactional);
+			}
+		}
+	}
+	else if (WidgetsJson && !Parent)
+	{
+		// An empty tree gets the root canvas create_umg_widget_blueprint gives new widgets
+		Parent = WidgetTree->ConstructWidget<UCanvasPanel>(UCanvasPanel::StaticClass());
+		WidgetTree->RootWidget = Parent;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> CreatedJson;
+	TArray<TSharedPtr<FJsonValue>> Failures;
+	FPendingBindings Bindings;
+	if (RootJson.IsValid())
+	{
+		BuildWidget(WidgetBlueprint, RootJson->AsObject(), nullptr, CreatedJson, Failures, Bindings);
+	}
+	else
+	{
+		for (const TSharedPtr<FJsonValue>& WidgetJson : *WidgetsJson)
+		{
+			BuildWidget(WidgetBlueprint, WidgetJson->AsObject(), Parent, CreatedJson, Failures, Bindings);
+		}
+	}
+
+	// One skeleton regeneration for the whole tree, which gives the new widget variables the
+	// properties their bound events hang off
+	WidgetBlueprint->MarkPackageDirty();
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(WidgetBlueprint);
+	for (const TPair<UWidget*, FString>& Event : Bindings.Events)
+	{
+		if (!FindOrAddBoundEvent(WidgetBlueprint, Event.Key, Event.Value))
+		{
+			Failures.Add(MakeShared<FJsonValueObject>(MakeTreeFailure(Event.Key->GetName(), FString::Printf(TEXT("No event '%s' to bind"), *Event.Value))));
+		}
+	}
+	for (const FString& BindingName : Bindings.TextBindings)
+	{
+		AddTextBinding(WidgetBlueprint, BindingName);
+	}
+	if (Bindings.Events.Num() > 0 || Bindings.TextBindings.Num() > 0)
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(WidgetBlueprint);
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetStringField(TEXT("blueprint_name"), BlueprintName);
+	ResultObj->SetArrayField(TEXT("created"), CreatedJson);
+	ResultObj->SetNumberField(TEXT("count"), CreatedJson.Num());
+	ResultObj->SetArrayField(TEXT("failures"), Failures);
+
+	// One compile and one save for the whole tree, instead of one per widget
+	if (bCompile)
+	{
+		FBlueprintCompileQueue::FReport Report = FBlueprintCompileQueue::Get().Compile(WidgetBlueprint);
+		if (!Report.bSaved)
+		{
+			Report.bSaved = UEditorAssetLibrary::SaveLoadedAsset(WidgetBlueprint, /*bOnlyIfIsDirty=*/false);
+		}
+		ResultObj->SetObjectField(TEXT("compile"), Report.ToJson());
+	}
+	else
+	{
+		FBlueprintCompileQueue::Get().Request(WidgetBlueprint, /*bSave=*/true);
+	}
+	return ResultObj;
+}
+
+UK2Node_Event* FUnrealMCPUMGCommands::FindOrAddBoundEvent(UWidgetBlueprint* WidgetBlueprint, UWidget* Widget, const FString& EventName)
+{
+	UEdGraph* EventGraph = FBlueprintEditorUtils::FindEventGraph(WidgetBlueprint);
+	FMulticastDelegateProperty* DelegateProperty = FindFProperty<FMulticastDelegateProperty>(Widget->GetClass(), FName(*EventName));
+	if (!EventGraph || !DelegateProperty)
+	{
+		return nullptr;
+	}
+
+	// Bound events hang off the widget's member variable, which the skeleton class only has for variables
+	if (!Widget->bIsVariable)
+	{
+		Widget->bIsVariable = true;
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(WidgetBlueprint);
+	}
+	FObjectProperty* WidgetProperty = FindFProperty<FObjectProperty>(WidgetBlueprint->SkeletonGeneratedClass, Widget->GetFName());
+	if (!WidgetProperty)
+	{
+		return nullptr;
+	}
+
+	if (const UK2Node_ComponentBoundEvent* Existing = FKismetEditorUtilities::FindBoundEventForComponent(WidgetBlueprint, DelegateProperty->GetFName(), WidgetProperty->GetFName()))
+	{
+		return const_cast<UK2Node_ComponentBoundEvent*>(Existing);
+	}
+
+	// Place it below the existing nodes
+	int32 MaxPosY = 0;
+	for (const UEdGraphNode* Node : EventGraph->Nodes)
+	{
+		MaxPosY = FMath::Max(MaxPosY, Node ? Node->NodePosY : 0);
+	}
+
+	// Spawned here rather than by CreateNewBoundEventForClass, which also brings the blueprint editor up on the node
+	return FEdGraphSchemaAction_K2NewNode::SpawnNode<UK2Node_ComponentBoundEvent>(EventGraph, FVector2D(200, MaxPosY + 200), EK2NewNodeFlags::None,
+		[WidgetProperty, DelegateProperty](UK2Node_ComponentBoundEvent* NewNode)
+		{
+			NewNode->InitializeComponentBoundEventParams(WidgetProperty, DelegateProperty);
+		});
+}
+
+void FUnrealMCPUMGCommands::AddTextBinding(UWidgetBlueprint* WidgetBlueprint, const FString& BindingName)
+{
+	// Create a variable for binding if it doesn't exist
+	FBlueprintEditorUtils::AddMemberVariable(
+		WidgetBlueprint,
+		FName(*BindingName),
+		FEdGraphPinType(UEdGraphSchema_K2::PC_Text, NAME_None, nullptr, EPinContainerType::None, false, FEdGraphTerminalType())
+	);
+
+	// Create binding function, unless an earlier binding made it
 	const FString FunctionName = FString::Printf(TEXT("Get%s"), *BindingName);
+	const FName FunctionFName(*FunctionName);
+	if (WidgetBlueprint->FunctionGraphs.ContainsByPredicate([FunctionFName](const UEdGraph* Graph) { return Graph && Graph->GetFName() == FunctionFName; }))
+	{
+		return;
+	}
 	UEdGraph* FuncGraph = FBlueprintEditorUtils::CreateNewGraph(
 		WidgetBlueprint,
-		FName(*FunctionName),
+		FunctionFName,
 		UEdGraph::StaticClass(),
 		UEdGraphSchema_K2::StaticClass()
 	);
@@ -535,7 +1022,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleSetTextBlockBinding(const T
 		FuncGraph->AddNode(EntryNode, false, false);
 		EntryNode->NodePosX = 0;
 		EntryNode->NodePosY = 0;
-		EntryNode->FunctionReference.SetExternalMember(FName(*FunctionName), WidgetBlueprint->GeneratedClass);
+		EntryNode->FunctionReference.SetExternalMember(FunctionFName, WidgetBlueprint->GeneratedClass);
 		EntryNode->AllocateDefaultPins();
 
 		// Create get variable node
@@ -554,12 +1041,4 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleSetTextBlockBinding(const T
 			EntryThenPin->MakeLinkTo(GetVarOutPin);
 		}
 	}
-
-	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
-
-	Response->SetBoolField(TEXT("success"), true);
-	Response->SetStringField(TEXT("binding_name"), BindingName);
-	return Response;
-} 
+}
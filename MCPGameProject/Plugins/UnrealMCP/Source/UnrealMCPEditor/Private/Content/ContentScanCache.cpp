@@ -0,0 +1,514 @@
+#include "Content/ContentScanCache.h"
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/ARFilter.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Texture.h"
+#include "Misc/Guid.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "UObject/SoftObjectPath.h"
+
+namespace
+{
+        bool ShouldMarkAsOrphan(const FString& PackagePath, const TArray<FName>& Referencers)
+        {
+                if (PackagePath.StartsWith(TEXT("/Game/Temp")))
+                {
+                        return true;
+                }
+                return Referencers.Num() == 0;
+        }
+
+        bool IsPathUnder(const FString& PackagePath, const FString& Root, bool bRecursive)
+        {
+                if (PackagePath.Equals(Root, ESearchCase::IgnoreCase))
+                {
+                        return true;
+                }
+                return bRecursive && PackagePath.Len() > Root.Len() && PackagePath[Root.Len()] == TEXT('/') && PackagePath.StartsWith(Root, ESearchCase::IgnoreCase);
+        }
+
+        template <typename T, typename FEqual>
+        bool ArraysEqual(const TArray<T>& A, const TArray<T>& B, FEqual Equal)
+        {
+                if (A.Num() != B.Num())
+                {
+                        return false;
+                }
+                for (int32 Index = 0; Index < A.Num(); ++Index)
+                {
+                        if (!Equal(A[Index], B[Index]))
+                        {
+                                return false;
+                        }
+                }
+                return true;
+        }
+}
+
+bool FContentScanCache::FPackageScan::HasSameFindings(const FPackageScan& Other) const
+{
+        return PackagePath == Other.PackagePath
+                && Redirectors == Other.Redirectors
+                && UnusedTextures == Other.UnusedTextures
+                && Orphans == Other.Orphans
+                && ArraysEqual(Missing, Other.Missing, [](const FMissingDependency& A, const FMissingDependency& B)
+                {
+                        return A.Needed == B.Needed && A.Referencer == B.Referencer && A.Type == B.Type;
+                })
+                && ArraysEqual(Broken, Other.Broken, [](const FBrokenReference& A, const FBrokenReference& B)
+                {
+                        return A.Owner == B.Owner && A.Prop == B.Prop && A.SoftPath == B.SoftPath;
+                });
+}
+
+FContentScanCache& FContentScanCache::Get()
+{
+        static FContentScanCache Cache;
+        return Cache;
+}
+
+void FContentScanCache::Start()
+{
+        check(IsInGameThread());
+        if (bStarted)
+        {
+                return;
+        }
+        bStarted = true;
+        Reset();
+
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+        AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FContentScanCache::HandleAssetChanged);
+        AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FContentScanCache::HandleAssetChanged);
+        AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FContentScanCache::HandleAssetChanged);
+        AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FContentScanCache::HandleAssetRenamed);
+        bRegistryLoading = AssetRegistry.IsLoadingAssets();
+        if (bRegistryLoading)
+        {
+                FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FContentScanCache::HandleFilesLoaded);
+        }
+        PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FContentScanCache::HandlePackageSaved);
+}
+
+void FContentScanCache::Stop()
+{
+        if (!bStarted)
+        {
+                return;
+        }
+        bStarted = false;
+
+        if (FAssetRegistryModule* Module = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+        {
+                IAssetRegistry& AssetRegistry = Module->Get();
+                AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+                AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+                AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+                AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+                AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+        }
+        UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+        AssetAddedHandle.Reset();
+        AssetRemovedHandle.Reset();
+        AssetUpdatedHandle.Reset();
+        AssetRenamedHandle.Reset();
+        FilesLoadedHandle.Reset();
+        PackageSavedHandle.Reset();
+
+        Reset();
+}
+
+void FContentScanCache::Reset()
+{
+        Scans.Empty();
+        Removed.Empty();
+        Dependents.Empty();
+        Dirty.Empty();
+        Covered.Empty();
+        Epoch = FGuid::NewGuid();
+        Revision = 0;
+
+        FScopeLock Lock(&ChangedLock);
+        Changed.Empty();
+}
+
+FString FContentScanCache::MakeToken() const
+{
+        return FString::Printf(TEXT("%s.%llu"), *Epoch.ToString(EGuidFormats::Base36Encoded), Revision);
+}
+
+bool FContentScanCache::ParseToken(const FString& Token, uint64& OutRevision) const
+{
+        if (!bStarted)
+        {
+                return false;
+        }
+
+        FString EpochPart;
+        FString RevisionPart;
+        if (!Token.Split(TEXT("."), &EpochPart, &RevisionPart) || EpochPart != Epoch.ToString(EGuidFormats::Base36Encoded) || RevisionPart.IsEmpty() || !RevisionPart.IsNumeric())
+        {
+                return false;
+        }
+        OutRevision = FCString::Strtoui64(*RevisionPart, nullptr, 10);
+        return OutRevision <= Revision;
+}
+
+void FContentScanCache::QueueChanged(FName PackageName)
+{
+        if (PackageName.IsNone())
+        {
+                return;
+        }
+        FScopeLock Lock(&ChangedLock);
+        Changed.Add(PackageName);
+}
+
+void FContentScanCache::HandleAssetChanged(const FAssetData& AssetData)
+{
+        // The startup scan adds every asset; the cache is reset once it ends, so there is nothing to track.
+        if (!bRegistryLoading)
+        {
+                QueueChanged(AssetData.PackageName);
+        }
+}
+
+void FContentScanCache::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+        if (!bRegistryLoading)
+        {
+                QueueChanged(AssetData.PackageName);
+                QueueChanged(FName(*FSoftObjectPath(OldObjectPath).GetLongPackageName()));
+        }
+}
+
+void FContentScanCache::HandlePackageSaved(const FString& Filename, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+        if (Package && !bRegistryLoading)
+        {
+                QueueChanged(Package->GetFName());
+        }
+}
+
+void FContentScanCache::HandleFilesLoaded()
+{
+        // Anything computed during the startup scan saw a partial registry.
+        if (FAssetRegistryModule* Module = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+        {
+                Module->Get().OnFilesLoaded().Remove(FilesLoadedHandle);
+        }
+        FilesLoadedHandle.Reset();
+        Reset();
+        bRegistryLoading = false;
+}
+
+void FContentScanCache::ExpandChanged(IAssetRegistry& AssetRegistry)
+{
+        TSet<FName> ChangedNow;
+        {
+                FScopeLock Lock(&ChangedLock);
+                ChangedNow = MoveTemp(Changed);
+                Changed.Reset();
+        }
+
+        // A change can move another package's results: a dependency that appeared or vanished, or a
+        // reference that was added or dropped. The former are in Dependents; new references show up
+        // in the changed package's current dependencies.
+        TArray<FName> Dependencies;
+        for (const FName& PackageName : ChangedNow)
+        {
+                Dirty.Add(PackageName);
+                if (const TSet<FName>* Watchers = Dependents.Find(PackageName))
+                {
+                        Dirty.Append(*Watchers);
+                }
+
+                Dependencies.Reset();
+                AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+                for (const FName& Dependency : Dependencies)
+                {
+                        if (Scans.Contains(Dependency))
+                        {
+                                Dirty.Add(Dependency);
+                        }
+                }
+        }
+}
+
+bool FContentScanCache::IsUnder(FName PackagePath, const TArray<FString>& Paths, bool bRecursive)
+{
+        const FString PathString = PackagePath.ToString();
+        for (const FString& Root : Paths)
+        {
+                if (IsPathUnder(PathString, Root, bRecursive))
+                {
+                        return true;
+                }
+        }
+        return false;
+}
+
+bool FContentScanCache::IsCovered(const FString& Path, bool bRecursive) const
+{
+        for (const FCoveredRoot& Root : Covered)
+        {
+                if (Root.bRecursive ? IsPathUnder(Path, Root.Path, true) : (!bRecursive && Path.Equals(Root.Path, ESearchCase::IgnoreCase)))
+                {
+                        return true;
+                }
+        }
+        return false;
+}
+
+void FContentScanCache::MarkCovered(const TArray<FString>& Paths, bool bRecursive)
+{
+        for (const FString& Path : Paths)
+        {
+                if (!IsCovered(Path, bRecursive))
+                {
+                        Covered.Add({ Path, bRecursive });
+                }
+        }
+}
+
+void FContentScanCache::CollectPending(IAssetRegistry& AssetRegistry, const TArray<FString>& Paths, bool bRecursive, TArray<FName>& OutPending)
+{
+        check(IsInGameThread());
+        if (!bStarted)
+        {
+                // Nothing keeps the cache current (e.g. in a commandlet), so start from scratch.
+                Reset();
+        }
+        ExpandChanged(AssetRegistry);
+
+        TSet<FName> Pending;
+        TArray<FString> Uncovered;
+        for (const FString& Path : Paths)
+        {
+                if (!IsCovered(Path, bRecursive))
+                {
+                        Uncovered.Add(Path);
+                }
+        }
+
+        if (Uncovered.Num() > 0)
+        {
+                FARFilter Filter;
+                Filter.bRecursivePaths = bRecursive;
+                for (const FString& Path : Uncovered)
+                {
+                        Filter.PackagePaths.Add(*Path);
+                }
+                TArray<FAssetData> Assets;
+                AssetRegistry.GetAssets(Filter, Assets);
+                for (const FAssetData& AssetData : Assets)
+                {
+                        if (!Scans.Contains(AssetData.PackageName))
+                        {
+                                Pending.Add(AssetData.PackageName);
+                        }
+                }
+        }
+
+        for (auto It = Dirty.CreateIterator(); It; ++It)
+        {
+                const FPackageScan* Scan = Scans.Find(*It);
+                const FString PackagePath = Scan ? Scan->PackagePath.ToString() : FPackageName::GetLongPackagePath(It->ToString());
+                if (IsUnder(FName(*PackagePath), Paths, bRecursive))
+                {
+                        Pending.Add(*It);
+                }
+                else if (!Scan && !IsCovered(PackagePath, false))
+                {
+                        // A later scan of its folder enumerates it anyway.
+                        It.RemoveCurrent();
+                }
+        }
+
+        OutPending = Pending.Array();
+        OutPending.Sort(FNameLexicalLess());
+}
+
+void FContentScanCache::AddToIndex(FName PackageName, const FPackageScan& Scan)
+{
+        for (const FName& Watched : Scan.Watched)
+        {
+                Dependents.FindOrAdd(Watched).Add(PackageName);
+        }
+        for (const FName& Referencer : Scan.Referencers)
+        {
+                Dependents.FindOrAdd(Referencer).Add(PackageName);
+        }
+}
+
+void FContentScanCache::RemoveFromIndex(FName PackageName, const FPackageScan& Scan)
+{
+        auto Unlink = [this, PackageName](FName Key)
+        {
+                if (TSet<FName>* Watchers = Dependents.Find(Key))
+                {
+                        Watchers->Remove(PackageName);
+                        if (Watchers->Num() == 0)
+                        {
+                                Dependents.Remove(Key);
+                        }
+                }
+        };
+        for (const FName& Watched : Scan.Watched)
+        {
+                Unlink(Watched);
+        }
+        for (const FName& Referencer : Scan.Referencers)
+        {
+                Unlink(Referencer);
+        }
+}
+
+void FContentScanCache::Recompute(IAssetRegistry& AssetRegistry, FName PackageName)
+{
+        check(IsInGameThread());
+        Dirty.Remove(PackageName);
+
+        TArray<FAssetData> Assets;
+        AssetRegistry.GetAssetsByPackageName(PackageName, Assets);
+        FPackageScan* Existing = Scans.Find(PackageName);
+        if (Assets.Num() == 0)
+        {
+                if (Existing)
+                {
+                        Removed.Add(PackageName, { Existing->PackagePath, ++Revision });
+                        RemoveFromIndex(PackageName, *Existing);
+                        Scans.Remove(PackageName);
+                }
+                return;
+        }
+
+        FAssetRegistryDependencyOptions DependencyOptions;
+        DependencyOptions.bIncludePackages = true;
+        DependencyOptions.bIncludeHard = true;
+        DependencyOptions.bIncludeSoft = true;
+        DependencyOptions.bIncludeSearchableNames = false;
+        DependencyOptions.bIncludeManageDependencies = false;
+
+        const FTopLevelAssetPath RedirectorClassPath = UObjectRedirector::StaticClass()->GetClassPathName();
+        const FTopLevelAssetPath TextureClassPath = UTexture::StaticClass()->GetClassPathName();
+
+        FPackageScan Scan;
+        Scan.PackagePath = Assets[0].PackagePath;
+        Scan.AssetCount = Assets.Num();
+
+        // Dependencies and referencers belong to the package, so they are looked up once for all its assets.
+        TArray<FName> Dependencies;
+        AssetRegistry.GetDependencies(PackageName, Dependencies, DependencyOptions);
+        TArray<FName> MissingDependencies;
+        for (const FName& DependencyPackage : Dependencies)
+        {
+                TArray<FAssetData> DependencyAssets;
+                AssetRegistry.GetAssetsByPackageName(DependencyPackage, DependencyAssets);
+                if (DependencyAssets.Num() == 0)
+                {
+                        MissingDependencies.Add(DependencyPackage);
+                }
+        }
+        Scan.Watched = Dependencies;
+        AssetRegistry.GetReferencers(PackageName, Scan.Referencers, EAssetRegistryDependencyType::Packages);
+
+        const FString PackageNameString = PackageName.ToString();
+        const bool bOrphan = ShouldMarkAsOrphan(PackageNameString, Scan.Referencers);
+
+        Assets.Sort([](const FAssetData& A, const FAssetData& B) { return A.AssetName.LexicalLess(B.AssetName); });
+        for (const FAssetData& AssetData : Assets)
+        {
+                const FString ObjectPath = AssetData.ToSoftObjectPath().ToString();
+
+                if (AssetData.AssetClassPath == RedirectorClassPath)
+                {
+                        Scan.Redirectors.Add(ObjectPath);
+                        continue;
+                }
+
+                for (const FName& DependencyPackage : MissingDependencies)
+                {
+                        Scan.Missing.Add({ ObjectPath, DependencyPackage, AssetData.AssetClassPath.GetAssetName().ToString() });
+                }
+
+                // Broken soft references via tags
+                for (const TPair<FName, FAssetTagValueRef>& TagPair : AssetData.TagsAndValues())
+                {
+                        const FString TagValue = TagPair.Value.AsString();
+                        FSoftObjectPath SoftPath(TagValue);
+                        if (SoftPath.IsNull())
+                        {
+                                continue;
+                        }
+
+                        const FString LongPackageName = SoftPath.GetLongPackageName();
+                        if (!LongPackageName.StartsWith(TEXT("/Game/")))
+                        {
+                                continue;
+                        }
+
+                        Scan.Watched.AddUnique(FName(*LongPackageName));
+                        const FAssetData TargetAsset = AssetRegistry.GetAssetByObjectPath(SoftPath);
+                        if (!TargetAsset.IsValid())
+                        {
+                                Scan.Broken.Add({ ObjectPath, TagPair.Key.ToString(), SoftPath.ToString() });
+                        }
+                }
+
+                if (AssetData.IsInstanceOf(TextureClassPath) && Scan.Referencers.Num() == 0)
+                {
+                        Scan.UnusedTextures.Add(ObjectPath);
+                }
+
+                if (bOrphan)
+                {
+                        Scan.Orphans.Add(ObjectPath);
+                }
+        }
+
+        if (Existing)
+        {
+                Scan.Revision = Existing->HasSameFindings(Scan) ? Existing->Revision : ++Revision;
+                RemoveFromIndex(PackageName, *Existing);
+        }
+        else
+        {
+                Scan.Revision = ++Revision;
+                Removed.Remove(PackageName);
+        }
+        AddToIndex(PackageName, Scan);
+        Scans.Add(PackageName, MoveTemp(Scan));
+}
+
+void FContentScanCache::GetChanged(const TArray<FString>& Paths, bool bRecursive, uint64 SinceRevision, TArray<TPair<FName, const FPackageScan*>>& OutScans) const
+{
+        for (const TPair<FName, FPackageScan>& Pair : Scans)
+        {
+                if (Pair.Value.Revision > SinceRevision && IsUnder(Pair.Value.PackagePath, Paths, bRecursive))
+                {
+                        OutScans.Emplace(Pair.Key, &Pair.Value);
+                }
+        }
+        OutScans.Sort([](const TPair<FName, const FPackageScan*>& A, const TPair<FName, const FPackageScan*>& B) { return A.Key.LexicalLess(B.Key); });
+}
+
+void FContentScanCache::GetRemoved(const TArray<FString>& Paths, bool bRecursive, uint64 SinceRevision, TArray<FName>& OutPackages) const
+{
+        for (const TPair<FName, FRemovedPackage>& Pair : Removed)
+        {
+                if (Pair.Value.Revision > SinceRevision && IsUnder(Pair.Value.PackagePath, Paths, bRecursive))
+                {
+                        OutPackages.Add(Pair.Key);
+                }
+        }
+        OutPackages.Sort(FNameLexicalLess());
+}
@@ -1,21 +1,41 @@
 #include "Content/ContentTools.h"
 #include "CoreMinimal.h"
+#include "Commands/MCPCommandRegistry.h"
 
+#include "Assets/AssetClassResolver.h"
+#include "Assets/PackagePrefetch.h"
+#include "Assets/PackageSaver.h"
+#include "Assets/AssetQuery.h"
+#include "Assets/RedirectorFixup.h"
 #include "AssetRegistry/AssetData.h"
 #include "AssetRegistry/ARFilter.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetRegistry/IAssetRegistry.h"
 #include "AssetToolsModule.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Content/ContentScanCache.h"
 #include "EditorAssetLibrary.h"
 #include "FileHelpers.h"
+#include "HAL/PlatformMemory.h"
 #include "Engine/Texture.h"
 #include "Engine/StaticMesh.h"
 #include "Materials/MaterialInstance.h"
+#include "Misc/Crc.h"
+#include "Misc/ObjectThumbnail.h"
 #include "Misc/PackageName.h"
+#include "ObjectTools.h"
+#include "Observability/MemoryPolicy.h"
 #include "Permissions/WriteGate.h"
+#include "Protocol/CommandContext.h"
+#include "Protocol/ResponseStream.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "Internationalization/Regex.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Settings/UnrealMCPRuntimeConfig.h"
 #include "ThumbnailRendering/ThumbnailManager.h"
 #include "UObject/Package.h"
 #include "UObject/SoftObjectPath.h"
@@ -25,6 +45,51 @@
 #include "UObject/TopLevelAssetPath.h"
 #include "Containers/Map.h"
 #include "UObject/Script.h"
+#include "UObject/UObjectGlobals.h"
+#include <atomic>
+
+/** A content.validate rule set parsed once, from content.register_rules or from a call's own rules. */
+struct FCompiledValidationRules
+{
+        struct FNamingRule
+        {
+                explicit FNamingRule(const FString& InPattern)
+                        : PatternString(InPattern)
+                        , Pattern(InPattern)
+                {
+                }
+
+                bool Matches(const FString& AssetName) const
+                {
+                        if (!LiteralPrefix.IsEmpty())
+                        {
+                                return AssetName.StartsWith(LiteralPrefix, ESearchCase::CaseSensitive);
+                        }
+                        FRegexMatcher Matcher(Pattern, AssetName);
+                        return Matcher.FindNext();
+                }
+
+                FTopLevelAssetPath ClassPath;
+                FString RuleId;
+                FString PatternString;
+                /** Set for ^Prefix patterns, which are checked with a plain comparison. */
+                FString LiteralPrefix;
+                /** Compiled once and shared by the workers, each with its own matcher. */
+                FRegexPattern Pattern;
+        };
+
+        TArray<FNamingRule> Naming;
+        int32 TextureMaxSize = 0;
+        bool bTexturePowerOfTwo = false;
+        bool bHasTextureRules = false;
+        bool bRequiresCollision = false;
+        int32 StaticMeshMinLODs = 0;
+        bool bHasStaticMeshRules = false;
+        TArray<FName> RequiredMIParams;
+
+        static TSharedRef<FCompiledValidationRules> Compile(const TSharedPtr<FJsonObject>& RulesObject);
+        TSharedRef<FJsonObject> Describe() const;
+};
 
 namespace
 {
@@ -34,6 +99,417 @@ namespace
         constexpr const TCHAR* ErrorCodeThumbnailFailed = TEXT("THUMBNAIL_GEN_FAILED");
         constexpr const TCHAR* ErrorCodeSaveFailed = TEXT("SAVE_FAILED");
         constexpr const TCHAR* ErrorCodeWriteNotAllowed = TEXT("WRITE_NOT_ALLOWED");
+        constexpr const TCHAR* ErrorCodeCancelled = TEXT("CANCELLED");
+
+        TSharedPtr<FJsonObject> MakeCancelledResponse(const TCHAR* Operation, int32 Done, int32 Total)
+        {
+                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("%s cancelled after %d of %d assets"), Operation, Done, Total));
+                Error->SetStringField(TEXT("errorCode"), ErrorCodeCancelled);
+                return Error;
+        }
+
+        /** Where content.scan stopped when it yielded at the end of a frame's budget. */
+        struct FScanResumeState : public UnrealMCP::Protocol::FCommandContext::FResumeState
+        {
+                TArray<FString> Paths;
+                bool bRecursive = true;
+                bool bIncludeUnusedTextures = false;
+                bool bIncludeReferencers = true;
+
+                /** Set when the caller's sinceToken was usable; only later changes are returned. */
+                bool bIncremental = false;
+                uint64 SinceRevision = 0;
+
+                TArray<FName> Pending;
+                int32 NextIndex = 0;
+        };
+
+        constexpr int32 ValidateChunkSize = 2048;
+        /** Load checks ahead of the current one whose packages are kept loading. */
+        constexpr int32 ValidatePrefetchWindow = 64;
+        /** Violations per stream chunk when content.validate streams its results. */
+        constexpr int32 ValidateStreamBatch = 256;
+
+        enum class EValidateLoadKind : uint8
+        {
+                Texture,
+                StaticMesh,
+                MaterialInstance
+        };
+
+        /** An asset whose rules could not be settled from registry tags and need the object. */
+        struct FValidateLoadCheck
+        {
+                int32 AssetIndex = 0;
+                EValidateLoadKind Kind = EValidateLoadKind::Texture;
+        };
+
+        /** A violation found on a worker, added to the results in asset order. */
+        struct FValidateFinding
+        {
+                int32 AssetIndex = 0;
+                FString RuleId;
+                FString Message;
+        };
+
+        /** content.validate's rules, the loads still to do and what was found so far, kept across yields. */
+        struct FValidateResumeState : public UnrealMCP::Protocol::FCommandContext::FResumeState
+        {
+                TSharedPtr<const FCompiledValidationRules> Rules;
+
+                TArray<FAssetData> Assets;
+                TArray<FValidateLoadCheck> LoadChecks;
+                int32 NextLoadCheck = 0;
+                /** Loads the packages of the checks ahead while the current one runs. */
+                TSharedPtr<FPackagePrefetch> Prefetch = MakeShared<FPackagePrefetch>();
+                int32 PrefetchedThrough = 0;
+                int32 AssetsLoaded = 0;
+                int32 ParameterCacheHits = 0;
+
+                TArray<TSharedPtr<FJsonValue>> Violations;
+                TMap<FString, int32> ViolationsByRule;
+                int32 ViolationCount = 0;
+
+                /** Serialized violations not yet written to the response stream. */
+                TArray<FString> PendingLines;
+                bool bStreamWritten = false;
+
+                void AddViolation(const FString& AssetPath, const FString& RuleId, const FString& Message, UnrealMCP::Protocol::FResponseStream* Stream)
+                {
+                        TSharedPtr<FJsonObject> Violation = MakeShared<FJsonObject>();
+                        Violation->SetStringField(TEXT("asset"), AssetPath);
+                        Violation->SetStringField(TEXT("rule"), RuleId);
+                        Violation->SetStringField(TEXT("message"), Message);
+                        ViolationsByRule.FindOrAdd(RuleId) += 1;
+                        ++ViolationCount;
+
+                        if (!Stream)
+                        {
+                                Violations.Add(MakeShared<FJsonValueObject>(Violation));
+                                return;
+                        }
+
+                        FString Line;
+                        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+                        FJsonSerializer::Serialize(Violation.ToSharedRef(), Writer);
+                        PendingLines.Add(MoveTemp(Line));
+                        if (PendingLines.Num() >= ValidateStreamBatch)
+                        {
+                                FlushStream(Stream);
+                        }
+                }
+
+                /** Writes the pending violations as newline-separated JSON objects. */
+                void FlushStream(UnrealMCP::Protocol::FResponseStream* Stream)
+                {
+                        if (!Stream)
+                        {
+                                return;
+                        }
+
+                        Stream->Begin(TEXT("violations"), TEXT("application/x-ndjson"));
+                        if (PendingLines.Num() == 0)
+                        {
+                                return;
+                        }
+
+                        const FString Chunk = FString::Join(PendingLines, TEXT("\n"));
+                        Stream->WriteChunk(bStreamWritten ? FString(TEXT("\n")) + Chunk : Chunk);
+                        bStreamWritten = true;
+                        PendingLines.Reset();
+                }
+        };
+
+        /** The literal for patterns of the form ^Prefix or ^Prefix.*, which need no regex engine. */
+        bool TryGetLiteralPrefix(const FString& Pattern, FString& OutPrefix)
+        {
+                if (!Pattern.StartsWith(TEXT("^"), ESearchCase::CaseSensitive))
+                {
+                        return false;
+                }
+
+                FString Body = Pattern.Mid(1);
+                Body.RemoveFromEnd(TEXT(".*"), ESearchCase::CaseSensitive);
+                if (Body.IsEmpty())
+                {
+                        return false;
+                }
+                for (const TCHAR Char : Body)
+                {
+                        if (!FChar::IsAlnum(Char) && Char != TEXT('_') && Char != TEXT('-'))
+                        {
+                                return false;
+                        }
+                }
+
+                OutPrefix = MoveTemp(Body);
+                return true;
+        }
+
+        bool TryGetIntTag(const FAssetData& AssetData, FName Tag, int32& OutValue)
+        {
+                FString Value;
+                if (!AssetData.GetTagValue(Tag, Value) || !Value.IsNumeric())
+                {
+                        return false;
+                }
+                OutValue = FCString::Atoi(*Value);
+                return true;
+        }
+
+        /** A texture's size from its "Dimensions" registry tag ("2048x1024"). */
+        bool TryGetTextureDimensions(const FAssetData& AssetData, int32& OutWidth, int32& OutHeight)
+        {
+                FString Value;
+                FString Width;
+                FString Height;
+                if (!AssetData.GetTagValue(TEXT("Dimensions"), Value) || !Value.Split(TEXT("x"), &Width, &Height) || !Width.IsNumeric() || !Height.IsNumeric())
+                {
+                        return false;
+                }
+                OutWidth = FCString::Atoi(*Width);
+                OutHeight = FCString::Atoi(*Height);
+                return true;
+        }
+
+        void CheckTextureSize(const FCompiledValidationRules& Rules, int32 Width, int32 Height, TFunctionRef<void(const TCHAR*, const FString&)> AddFinding)
+        {
+                if (Rules.TextureMaxSize > 0 && (Width > Rules.TextureMaxSize || Height > Rules.TextureMaxSize))
+                {
+                        AddFinding(TEXT("texture.maxSize"), FString::Printf(TEXT("Texture dimensions %dx%d exceed max %d"), Width, Height, Rules.TextureMaxSize));
+                }
+
+                if (Rules.bTexturePowerOfTwo)
+                {
+                        if (!FMath::IsPowerOfTwo(Width) || !FMath::IsPowerOfTwo(Height))
+                        {
+                                AddFinding(TEXT("texture.powerOfTwo"), TEXT("Texture dimensions must be powers of two"));
+                        }
+                }
+        }
+
+        void CheckStaticMesh(const FCompiledValidationRules& Rules, int32 NumLODs, bool bHasCollision, TFunctionRef<void(const TCHAR*, const FString&)> AddFinding)
+        {
+                if (Rules.StaticMeshMinLODs > 0 && NumLODs < Rules.StaticMeshMinLODs)
+                {
+                        AddFinding(TEXT("staticMesh.minLODs"), FString::Printf(TEXT("Expected >=%d LODs, got %d"), Rules.StaticMeshMinLODs, NumLODs));
+                }
+
+                if (Rules.bRequiresCollision && !bHasCollision)
+                {
+                        AddFinding(TEXT("staticMesh.requiresCollision"), TEXT("Static mesh is missing collision"));
+                }
+        }
+
+        void CollectMaterialParameterNames(UMaterialInstance* MaterialInstance, TArray<FName>& OutNames)
+        {
+                TSet<FName> AvailableParams;
+                TArray<FMaterialParameterInfo> Infos;
+                TArray<FGuid> Ids;
+
+                Infos.Reset();
+                Ids.Reset();
+                MaterialInstance->GetAllScalarParameterInfo(Infos, Ids);
+                for (const FMaterialParameterInfo& Info : Infos)
+                {
+                        AvailableParams.Add(Info.Name);
+                }
+
+                Infos.Reset();
+                Ids.Reset();
+                MaterialInstance->GetAllVectorParameterInfo(Infos, Ids);
+                for (const FMaterialParameterInfo& Info : Infos)
+                {
+                        AvailableParams.Add(Info.Name);
+                }
+
+                Infos.Reset();
+                Ids.Reset();
+                MaterialInstance->GetAllTextureParameterInfo(Infos, Ids);
+                for (const FMaterialParameterInfo& Info : Infos)
+                {
+                        AvailableParams.Add(Info.Name);
+                }
+
+                Infos.Reset();
+                Ids.Reset();
+                MaterialInstance->GetAllStaticSwitchParameterInfo(Infos, Ids);
+                for (const FMaterialParameterInfo& Info : Infos)
+                {
+                        AvailableParams.Add(Info.Name);
+                }
+
+                OutNames = AvailableParams.Array();
+        }
+
+        constexpr int32 DefaultThumbnailChunkSize = 16;
+        constexpr int32 MaxThumbnailChunkSize = 512;
+        constexpr int64 DefaultThumbnailMemoryCeilingBytes = 2048LL * 1024 * 1024;
+
+        /** Where content.generate_thumbnails stopped when it suspended at the end of a frame's budget. */
+        struct FThumbnailResumeState : public UnrealMCP::Protocol::FCommandContext::FResumeState
+        {
+                TArray<FString> Assets;
+                int32 NextIndex = 0;
+                bool bHiRes = false;
+                bool bSave = true;
+                bool bForce = false;
+                int32 ChunkSize = DefaultThumbnailChunkSize;
+                /** Growth in used physical memory since the first slice that triggers a collection. */
+                int64 MemoryCeilingBytes = DefaultThumbnailMemoryCeilingBytes;
+                int64 StartUsedBytes = 0;
+                /** Loads the next chunk's packages while the current chunk renders. */
+                TSharedPtr<FPackagePrefetch> Prefetch = MakeShared<FPackagePrefetch>();
+                /** Assets whose saved thumbnail is current, settled when their chunk is prefetched. */
+                TBitArray<> UpToDate;
+                int32 PrefetchedThrough = 0;
+
+                int32 UpdatedCount = 0;
+                int32 ChunkCount = 0;
+                int32 GarbageCollections = 0;
+                bool bCancelled = false;
+                TArray<TSharedPtr<FJsonValue>> FailedArray;
+                TArray<TSharedPtr<FJsonValue>> SkippedArray;
+                TArray<TSharedPtr<FJsonValue>> AuditActions;
+        };
+
+        /** content.fix_missing's plan, built on a worker from registry data while the request is suspended. */
+        struct FFixMissingPlan
+        {
+                struct FBatch
+                {
+                        FRedirectorFixup::FBatch Fixup;
+                        /** Assets under the paths that reference the batch's redirectors; their soft references are remapped. */
+                        TArray<FSoftObjectPath> RemapAssets;
+                };
+
+                /** Every asset under the paths, read on the game thread before the plan starts. */
+                TArray<FAssetData> Assets;
+                TArray<FAssetData> Redirectors;
+                TMap<FString, FString> RedirectMap;
+                TArray<FBatch> Batches;
+                /** Referencer and redirector packages of every batch, checked out together before the first one. */
+                TArray<FString> PackagesToTouch;
+                int32 Groups = 0;
+                double PlanSeconds = 0.0;
+                std::atomic<bool> bDone{false};
+        };
+
+        /** Where content.fix_missing stopped when it suspended for its plan or at the end of a frame's budget. */
+        struct FFixMissingResumeState : public UnrealMCP::Protocol::FCommandContext::FResumeState
+        {
+                TArray<FString> Paths;
+                bool bRecursive = true;
+                bool bFixRedirectors = true;
+                bool bRemapReferences = true;
+                bool bDeleteRedirectors = true;
+                bool bSave = true;
+
+                TSharedPtr<FFixMissingPlan> Plan;
+                bool bCheckedOut = false;
+                int32 NextBatch = 0;
+                int32 NextDelete = 0;
+                int64 StartUsedBytes = 0;
+
+                TArray<FString> FixedPaths;
+                int32 RemappedCount = 0;
+                int32 DirtyCount = 0;
+                int32 DeletedCount = 0;
+                int32 GarbageCollections = 0;
+                bool bCancelled = false;
+        };
+
+        /** Groups the redirectors among Plan.Assets into batches and picks each batch's assets to remap. Any thread. */
+        void BuildFixMissingPlan(IAssetRegistry& AssetRegistry, FFixMissingPlan& Plan)
+        {
+                const double PlanStart = FPlatformTime::Seconds();
+                const FTopLevelAssetPath RedirectorClassPath = UObjectRedirector::StaticClass()->GetClassPathName();
+
+                // Remapping only visits assets the registry records as referencing a redirector, not every asset.
+                TMap<FName, TArray<FSoftObjectPath>> RemapCandidates;
+                for (const FAssetData& AssetData : Plan.Assets)
+                {
+                        if (AssetData.AssetClassPath != RedirectorClassPath)
+                        {
+                                RemapCandidates.FindOrAdd(AssetData.PackageName).Add(AssetData.GetSoftObjectPath());
+                                continue;
+                        }
+
+                        // Read from the registry tag: loading the redirector would load its destination too.
+                        Plan.Redirectors.Add(AssetData);
+                        const FString Destination = FRedirectorFixup::GetDestination(AssetData);
+                        if (!Destination.IsEmpty())
+                        {
+                                Plan.RedirectMap.Add(AssetData.GetObjectPathString(), Destination);
+                        }
+                }
+
+                TArray<FRedirectorFixup::FBatch> Fixups;
+                FRedirectorFixup::PlanGroupedBatches(AssetRegistry, Plan.Redirectors, FRedirectorFixup::DefaultMaxReferencersPerBatch, Fixups, Plan.Groups);
+
+                TSet<FName> Touched;
+                Plan.Batches.Reserve(Fixups.Num());
+                for (FRedirectorFixup::FBatch& Fixup : Fixups)
+                {
+                        FFixMissingPlan::FBatch& Batch = Plan.Batches.AddDefaulted_GetRef();
+                        for (const FName& Referencer : Fixup.Referencers)
+                        {
+                                Touched.Add(Referencer);
+                                if (const TArray<FSoftObjectPath>* Objects = RemapCandidates.Find(Referencer))
+                                {
+                                        Batch.RemapAssets.Append(*Objects);
+                                }
+                        }
+                        for (const FSoftObjectPath& Redirector : Fixup.Redirectors)
+                        {
+                                Touched.Add(Redirector.GetLongPackageFName());
+                        }
+                        Batch.Fixup = MoveTemp(Fixup);
+                }
+
+                Plan.PackagesToTouch.Reserve(Touched.Num());
+                for (const FName& PackageName : Touched)
+                {
+                        Plan.PackagesToTouch.Add(PackageName.ToString());
+                }
+                Plan.PlanSeconds = FPlatformTime::Seconds() - PlanStart;
+        }
+
+        /**
+         * True when the package on disk already carries a thumbnail for the asset and nothing in
+         * memory has changed it since, read from the package's thumbnail table without loading it.
+         */
+        bool HasSavedThumbnail(IAssetRegistry& AssetRegistry, const FSoftObjectPath& SoftPath)
+        {
+                const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(SoftPath);
+                if (!AssetData.IsValid())
+                {
+                        return false;
+                }
+
+                if (const UPackage* LoadedPackage = FindPackage(nullptr, *AssetData.PackageName.ToString()))
+                {
+                        if (LoadedPackage->IsDirty())
+                        {
+                                return false;
+                        }
+                }
+
+                FString PackageFilename;
+                if (!FPackageName::DoesPackageExist(AssetData.PackageName.ToString(), &PackageFilename))
+                {
+                        return false;
+                }
+
+                const FName FullName(*AssetData.GetFullName());
+                FThumbnailMap Thumbnails;
+                if (!ThumbnailTools::LoadThumbnailsFromPackage(PackageFilename, { FullName }, Thumbnails))
+                {
+                        return false;
+                }
+                const FObjectThumbnail* Thumbnail = Thumbnails.Find(FullName);
+                return Thumbnail && !Thumbnail->IsEmpty();
+        }
 
         FString SanitizePath(const FString& InPath)
         {
@@ -197,20 +673,11 @@ namespace
                 return bModified;
         }
 
-        bool ShouldMarkAsOrphan(const FString& PackagePath, const TArray<FName>& Referencers)
-        {
-                if (PackagePath.StartsWith(TEXT("/Game/Temp")))
-                {
-                        return true;
-                }
-                return Referencers.Num() == 0;
-        }
-
-        bool IsRegexMatch(const FString& Value, const FString& Pattern)
+        void CollectDerivedClasses(const FTopLevelAssetPath& ClassPath, TSet<FTopLevelAssetPath>& OutClasses)
         {
-                FRegexPattern RegexPattern(Pattern);
-                FRegexMatcher Matcher(RegexPattern, Value);
-                return Matcher.FindNext();
+                TArray<FTopLevelAssetPath> Classes = { ClassPath };
+                FAssetClassResolver::Get().ExpandDerivedClasses(Classes);
+                OutClasses.Append(Classes);
         }
 
         bool ResolveClassPathForRule(const FString& RuleKey, FTopLevelAssetPath& OutPath)
@@ -236,9 +703,11 @@ namespace
                         return true;
                 }
 
-                if (const UClass* FoundClass = FindObject<UClass>(nullptr, *RuleKey))
+                // Same resolver as asset.find; an ambiguous name takes the first class of that name.
+                TArray<FTopLevelAssetPath> Candidates;
+                if (FAssetClassResolver::Get().Resolve(RuleKey, Candidates))
                 {
-                        OutPath = FoundClass->GetClassPathName();
+                        OutPath = Candidates[0];
                         return true;
                 }
 
@@ -247,6 +716,103 @@ namespace
 
 }
 
+TSharedRef<FCompiledValidationRules> FCompiledValidationRules::Compile(const TSharedPtr<FJsonObject>& RulesObject)
+{
+        TSharedRef<FCompiledValidationRules> Rules = MakeShared<FCompiledValidationRules>();
+        if (!RulesObject.IsValid())
+        {
+                return Rules;
+        }
+
+        const TSharedPtr<FJsonObject>* NamingObject = nullptr;
+        if (RulesObject->TryGetObjectField(TEXT("naming"), NamingObject))
+        {
+                for (const auto& Pair : (*NamingObject)->Values)
+                {
+                        if (Pair.Value->Type != EJson::String)
+                        {
+                                continue;
+                        }
+
+                        FTopLevelAssetPath ClassPath;
+                        if (!ResolveClassPathForRule(Pair.Key, ClassPath))
+                        {
+                                continue;
+                        }
+
+                        FNamingRule& Rule = Rules->Naming.Emplace_GetRef(Pair.Value->AsString());
+                        Rule.ClassPath = ClassPath;
+                        Rule.RuleId = FString::Printf(TEXT("naming.%s"), *ClassPath.GetAssetName().ToString());
+                        TryGetLiteralPrefix(Rule.PatternString, Rule.LiteralPrefix);
+                }
+        }
+
+        const TSharedPtr<FJsonObject>* TextureRules = nullptr;
+        if (RulesObject->TryGetObjectField(TEXT("texture"), TextureRules))
+        {
+                if ((*TextureRules)->HasTypedField<EJson::Number>(TEXT("maxSize")))
+                {
+                        Rules->TextureMaxSize = static_cast<int32>((*TextureRules)->GetNumberField(TEXT("maxSize")));
+                        Rules->bHasTextureRules = true;
+                }
+                if ((*TextureRules)->HasTypedField<EJson::Boolean>(TEXT("powerOfTwo")))
+                {
+                        Rules->bTexturePowerOfTwo = (*TextureRules)->GetBoolField(TEXT("powerOfTwo"));
+                        Rules->bHasTextureRules = true;
+                }
+        }
+
+        const TSharedPtr<FJsonObject>* StaticMeshRules = nullptr;
+        if (RulesObject->TryGetObjectField(TEXT("staticMesh"), StaticMeshRules))
+        {
+                if ((*StaticMeshRules)->HasTypedField<EJson::Boolean>(TEXT("requiresCollision")))
+                {
+                        Rules->bRequiresCollision = (*StaticMeshRules)->GetBoolField(TEXT("requiresCollision"));
+                        Rules->bHasStaticMeshRules = true;
+                }
+                if ((*StaticMeshRules)->HasTypedField<EJson::Number>(TEXT("minLODs")))
+                {
+                        Rules->StaticMeshMinLODs = static_cast<int32>((*StaticMeshRules)->GetNumberField(TEXT("minLODs")));
+                        Rules->bHasStaticMeshRules = true;
+                }
+        }
+
+        const TSharedPtr<FJsonObject>* MIRules = nullptr;
+        if (RulesObject->TryGetObjectField(TEXT("mi"), MIRules))
+        {
+                const TArray<TSharedPtr<FJsonValue>>* RequireParams = nullptr;
+                if ((*MIRules)->TryGetArrayField(TEXT("requireParams"), RequireParams))
+                {
+                        for (const TSharedPtr<FJsonValue>& Value : *RequireParams)
+                        {
+                                if (Value->Type == EJson::String)
+                                {
+                                        Rules->RequiredMIParams.Add(*Value->AsString());
+                                }
+                        }
+                }
+        }
+
+        return Rules;
+}
+
+TSharedRef<FJsonObject> FCompiledValidationRules::Describe() const
+{
+        int32 PrefixRules = 0;
+        for (const FNamingRule& Rule : Naming)
+        {
+                PrefixRules += Rule.LiteralPrefix.IsEmpty() ? 0 : 1;
+        }
+
+        TSharedRef<FJsonObject> Description = MakeShared<FJsonObject>();
+        Description->SetNumberField(TEXT("namingRules"), Naming.Num());
+        Description->SetNumberField(TEXT("prefixRules"), PrefixRules);
+        Description->SetBoolField(TEXT("texture"), bHasTextureRules);
+        Description->SetBoolField(TEXT("staticMesh"), bHasStaticMeshRules);
+        Description->SetNumberField(TEXT("requiredParams"), RequiredMIParams.Num());
+        return Description;
+}
+
 FContentTools::FContentTools() = default;
 
 TSharedPtr<FJsonObject> FContentTools::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
@@ -259,6 +825,10 @@ TSharedPtr<FJsonObject> FContentTools::HandleCommand(const FString& CommandType,
         {
                 return HandleValidate(Params);
         }
+        if (CommandType == TEXT("content.register_rules"))
+        {
+                return HandleRegisterRules(Params);
+        }
         if (CommandType == TEXT("content.fix_missing"))
         {
                 return HandleFixMissing(Params);
@@ -273,441 +843,488 @@ TSharedPtr<FJsonObject> FContentTools::HandleCommand(const FString& CommandType,
         return Error;
 }
 
-TSharedPtr<FJsonObject> FContentTools::HandleScan(const TSharedPtr<FJsonObject>& Params)
+void FContentTools::RegisterCommands(FMCPCommandRegistry& Registry)
 {
-        TArray<FString> Paths;
-        FString ParseError;
-        if (!CollectContentPaths(Params, Paths, ParseError))
-        {
-                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(ParseError);
-                Error->SetStringField(TEXT("errorCode"), ErrorCodeScanFailed);
-                return Error;
-        }
+        Registry.Register(TEXT("content.scan"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleScan(Params); }).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+        Registry.Register(TEXT("content.validate"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleValidate(Params); }).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+        Registry.Register(TEXT("content.register_rules"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleRegisterRules(Params); });
+        Registry.Register(TEXT("content.fix_missing"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleFixMissing(Params); }).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+        Registry.Register(TEXT("content.generate_thumbnails"), [this](const TSharedPtr<FJsonObject>& Params) { return HandleGenerateThumbnails(Params); }).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+}
 
-        bool bRecursive = true;
-        bool bIncludeUnusedTextures = false;
-        bool bIncludeReferencers = true;
+TSharedPtr<FJsonObject> FContentTools::HandleScan(const TSharedPtr<FJsonObject>& Params)
+{
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+        FContentScanCache& ScanCache = FContentScanCache::Get();
 
-        if (Params.IsValid())
+        // A scan over a large tree yields at the end of each frame's budget and resumes here.
+        UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+        TSharedPtr<FScanResumeState> State = Context ? Context->TakeResumeState<FScanResumeState>() : nullptr;
+        if (!State.IsValid())
         {
-                Params->TryGetBoolField(TEXT("recursive"), bRecursive);
-                Params->TryGetBoolField(TEXT("includeUnusedTextures"), bIncludeUnusedTextures);
-                Params->TryGetBoolField(TEXT("includeReferencers"), bIncludeReferencers);
-        }
+                State = MakeShared<FScanResumeState>();
 
-        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+                FString ParseError;
+                if (!CollectContentPaths(Params, State->Paths, ParseError))
+                {
+                        TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(ParseError);
+                        Error->SetStringField(TEXT("errorCode"), ErrorCodeScanFailed);
+                        return Error;
+                }
 
-        FARFilter Filter;
-        Filter.bRecursivePaths = bRecursive;
-        Filter.bRecursiveClasses = true;
-        for (const FString& Path : Paths)
-        {
-                Filter.PackagePaths.Add(*Path);
+                FString SinceToken;
+                if (Params.IsValid())
+                {
+                        Params->TryGetBoolField(TEXT("recursive"), State->bRecursive);
+                        Params->TryGetBoolField(TEXT("includeUnusedTextures"), State->bIncludeUnusedTextures);
+                        Params->TryGetBoolField(TEXT("includeReferencers"), State->bIncludeReferencers);
+                        Params->TryGetStringField(TEXT("sinceToken"), SinceToken);
+                }
+                State->bIncremental = !SinceToken.IsEmpty() && ScanCache.ParseToken(SinceToken, State->SinceRevision);
+
+                // Only packages changed since they were last examined (or never examined) are walked.
+                ScanCache.CollectPending(AssetRegistry, State->Paths, State->bRecursive, State->Pending);
         }
 
-        TArray<FAssetData> Assets;
-        if (!AssetRegistry.GetAssets(Filter, Assets))
+        const TArray<FName>& Pending = State->Pending;
+        const int32 FirstIndex = State->NextIndex;
+        for (int32 PendingIndex = FirstIndex; PendingIndex < Pending.Num(); ++PendingIndex)
         {
-                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to query Asset Registry"));
-                Error->SetStringField(TEXT("errorCode"), ErrorCodeScanFailed);
-                return Error;
+                if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
+                {
+                        return MakeCancelledResponse(TEXT("Scan"), PendingIndex, Pending.Num());
+                }
+                if (PendingIndex > FirstIndex && Context && Context->ShouldYield())
+                {
+                        State->NextIndex = PendingIndex;
+                        Context->Yield(State.ToSharedRef());
+                        return nullptr;
+                }
+                UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(PendingIndex, Pending.Num(), TEXT("scan"));
+
+                ScanCache.Recompute(AssetRegistry, Pending[PendingIndex]);
         }
+        ScanCache.MarkCovered(State->Paths, State->bRecursive);
+
+        UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(Pending.Num(), Pending.Num(), TEXT("scan"));
+
+        const uint64 SinceRevision = State->bIncremental ? State->SinceRevision : 0;
+        TArray<TPair<FName, const FContentScanCache::FPackageScan*>> Scans;
+        ScanCache.GetChanged(State->Paths, State->bRecursive, SinceRevision, Scans);
 
         TArray<TSharedPtr<FJsonValue>> RedirectorsArray;
         TArray<TSharedPtr<FJsonValue>> MissingArray;
         TArray<TSharedPtr<FJsonValue>> BrokenArray;
         TArray<TSharedPtr<FJsonValue>> UnusedTexturesArray;
         TArray<TSharedPtr<FJsonValue>> OrphansArray;
+        TArray<TSharedPtr<FJsonValue>> ChangedPackagesArray;
+        // A package missing from a broken branch can have thousands of referencers, so each missing
+        // package's list is looked up once and the names go into one shared table.
+        TSharedPtr<FJsonObject> MissingReferencers = MakeShared<FJsonObject>();
+        TArray<TSharedPtr<FJsonValue>> ReferencerPackagesArray;
+        TMap<FName, int32> ReferencerIndices;
+        int32 AssetCount = 0;
+
+        for (const TPair<FName, const FContentScanCache::FPackageScan*>& Pair : Scans)
+        {
+                const FContentScanCache::FPackageScan& Scan = *Pair.Value;
+                AssetCount += Scan.AssetCount;
+                ChangedPackagesArray.Add(MakeShared<FJsonValueString>(Pair.Key.ToString()));
 
-        int32 RedirectorCount = 0;
-        int32 MissingCount = 0;
-        int32 BrokenCount = 0;
-        int32 UnusedCount = 0;
-        int32 OrphanCount = 0;
-
-        FAssetRegistryDependencyOptions DependencyOptions;
-        DependencyOptions.bIncludePackages = true;
-        DependencyOptions.bIncludeHard = true;
-        DependencyOptions.bIncludeSoft = true;
-        DependencyOptions.bIncludeSearchableNames = false;
-        DependencyOptions.bIncludeManageDependencies = false;
-
-        const FTopLevelAssetPath RedirectorClassPath = UObjectRedirector::StaticClass()->GetClassPathName();
-        const FTopLevelAssetPath TextureClassPath = UTexture::StaticClass()->GetClassPathName();
-
-        for (const FAssetData& AssetData : Assets)
-        {
-                const FString ObjectPath = AssetData.ToSoftObjectPath().ToString();
-
-                if (AssetData.AssetClassPath == RedirectorClassPath)
+                for (const FString& Redirector : Scan.Redirectors)
                 {
-                        RedirectorsArray.Add(MakeShared<FJsonValueString>(ObjectPath));
-                        ++RedirectorCount;
-                        continue;
+                        RedirectorsArray.Add(MakeShared<FJsonValueString>(Redirector));
                 }
 
-                // Missing hard/soft dependencies
-                TArray<FName> Dependencies;
-                AssetRegistry.GetDependencies(AssetData.PackageName, Dependencies, DependencyOptions);
-                for (const FName& DependencyPackage : Dependencies)
+                for (const FContentScanCache::FMissingDependency& Missing : Scan.Missing)
                 {
-                        TArray<FAssetData> DependencyAssets;
-                        AssetRegistry.GetAssetsByPackageName(DependencyPackage, DependencyAssets);
-                        if (DependencyAssets.Num() == 0)
+                        const FString NeededString = Missing.Needed.ToString();
+                        TSharedPtr<FJsonObject> MissingEntry = MakeShared<FJsonObject>();
+                        MissingEntry->SetStringField(TEXT("referencer"), Missing.Referencer);
+                        MissingEntry->SetStringField(TEXT("needed"), NeededString);
+                        MissingEntry->SetStringField(TEXT("type"), Missing.Type);
+
+                        if (State->bIncludeReferencers && !MissingReferencers->HasField(NeededString))
                         {
-                                TSharedPtr<FJsonObject> MissingEntry = MakeShared<FJsonObject>();
-                                MissingEntry->SetStringField(TEXT("referencer"), ObjectPath);
-                                MissingEntry->SetStringField(TEXT("needed"), DependencyPackage.ToString());
-                                MissingEntry->SetStringField(TEXT("type"), AssetData.AssetClassPath.GetAssetName().ToString());
+                                // Looked up now rather than cached: they change with packages outside the scan.
+                                TArray<FName> Referencers;
+                                AssetRegistry.GetReferencers(Missing.Needed, Referencers, EAssetRegistryDependencyType::All);
 
-                                if (bIncludeReferencers)
+                                TArray<TSharedPtr<FJsonValue>> IndexJson;
+                                IndexJson.Reserve(Referencers.Num());
+                                for (const FName& Referencer : Referencers)
                                 {
-                                        TArray<FName> Referencers;
-                                        AssetRegistry.GetReferencers(DependencyPackage, Referencers, EAssetRegistryDependencyType::All);
-
-                                        TArray<TSharedPtr<FJsonValue>> ReferencerJson;
-                                        for (const FName& Referencer : Referencers)
+                                        int32* Index = ReferencerIndices.Find(Referencer);
+                                        if (!Index)
                                         {
-                                                ReferencerJson.Add(MakeShared<FJsonValueString>(Referencer.ToString()));
+                                                Index = &ReferencerIndices.Add(Referencer, ReferencerPackagesArray.Num());
+                                                ReferencerPackagesArray.Add(MakeShared<FJsonValueString>(Referencer.ToString()));
                                         }
-                                        MissingEntry->SetArrayField(TEXT("referencers"), ReferencerJson);
+                                        IndexJson.Add(MakeShared<FJsonValueNumber>(*Index));
                                 }
 
-                                MissingArray.Add(MakeShared<FJsonValueObject>(MissingEntry));
-                                ++MissingCount;
+                                TSharedPtr<FJsonObject> MissingInfo = MakeShared<FJsonObject>();
+                                MissingInfo->SetArrayField(TEXT("referencers"), IndexJson);
+                                MissingReferencers->SetObjectField(NeededString, MissingInfo);
                         }
+
+                        MissingArray.Add(MakeShared<FJsonValueObject>(MissingEntry));
                 }
 
-                // Broken soft references via tags
-                for (const TPair<FName, FAssetTagValueRef>& TagPair : AssetData.TagsAndValues())
+                for (const FContentScanCache::FBrokenReference& Broken : Scan.Broken)
                 {
-                        const FString TagValue = TagPair.Value.AsString();
-                        FSoftObjectPath SoftPath(TagValue);
-                        if (SoftPath.IsNull())
-                        {
-                                continue;
-                        }
-
-                        const FString LongPackageName = SoftPath.GetLongPackageName();
-                        if (!LongPackageName.StartsWith(TEXT("/Game/")))
-                        {
-                                continue;
-                        }
-
-                        const FAssetData TargetAsset = AssetRegistry.GetAssetByObjectPath(SoftPath);
-                        if (!TargetAsset.IsValid())
-                        {
-                                TSharedPtr<FJsonObject> BrokenEntry = MakeShared<FJsonObject>();
-                                BrokenEntry->SetStringField(TEXT("owner"), ObjectPath);
-                                BrokenEntry->SetStringField(TEXT("prop"), TagPair.Key.ToString());
-                                BrokenEntry->SetStringField(TEXT("softPath"), SoftPath.ToString());
-                                BrokenArray.Add(MakeShared<FJsonValueObject>(BrokenEntry));
-                                ++BrokenCount;
-                        }
+                        TSharedPtr<FJsonObject> BrokenEntry = MakeShared<FJsonObject>();
+                        BrokenEntry->SetStringField(TEXT("owner"), Broken.Owner);
+                        BrokenEntry->SetStringField(TEXT("prop"), Broken.Prop);
+                        BrokenEntry->SetStringField(TEXT("softPath"), Broken.SoftPath);
+                        BrokenArray.Add(MakeShared<FJsonValueObject>(BrokenEntry));
                 }
 
-                // Referencers for orphan/unused detection
-                TArray<FName> Referencers;
-                AssetRegistry.GetReferencers(AssetData.PackageName, Referencers, EAssetRegistryDependencyType::Packages);
-
-                if (bIncludeUnusedTextures && AssetData.IsInstanceOf(TextureClassPath) && Referencers.Num() == 0)
+                if (State->bIncludeUnusedTextures)
                 {
-                        UnusedTexturesArray.Add(MakeShared<FJsonValueString>(ObjectPath));
-                        ++UnusedCount;
+                        for (const FString& Texture : Scan.UnusedTextures)
+                        {
+                                UnusedTexturesArray.Add(MakeShared<FJsonValueString>(Texture));
+                        }
                 }
 
-                const FString PackageName = AssetData.PackageName.ToString();
-                if (ShouldMarkAsOrphan(PackageName, Referencers))
+                for (const FString& Orphan : Scan.Orphans)
                 {
-                        OrphansArray.Add(MakeShared<FJsonValueString>(ObjectPath));
-                        ++OrphanCount;
+                        OrphansArray.Add(MakeShared<FJsonValueString>(Orphan));
                 }
         }
 
         TSharedPtr<FJsonObject> Stats = MakeShared<FJsonObject>();
-        Stats->SetNumberField(TEXT("assets"), Assets.Num());
-        Stats->SetNumberField(TEXT("redirectors"), RedirectorCount);
-        Stats->SetNumberField(TEXT("missing"), MissingCount);
-        Stats->SetNumberField(TEXT("brokenRefs"), BrokenCount);
-        Stats->SetNumberField(TEXT("unusedTextures"), UnusedCount);
-        Stats->SetNumberField(TEXT("orphans"), OrphanCount);
+        Stats->SetNumberField(TEXT("assets"), AssetCount);
+        Stats->SetNumberField(TEXT("redirectors"), RedirectorsArray.Num());
+        Stats->SetNumberField(TEXT("missing"), MissingArray.Num());
+        Stats->SetNumberField(TEXT("brokenRefs"), BrokenArray.Num());
+        Stats->SetNumberField(TEXT("unusedTextures"), UnusedTexturesArray.Num());
+        Stats->SetNumberField(TEXT("orphans"), OrphansArray.Num());
+        Stats->SetNumberField(TEXT("rescannedPackages"), Pending.Num());
 
         TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
         Data->SetBoolField(TEXT("ok"), true);
         Data->SetObjectField(TEXT("stats"), Stats);
         Data->SetArrayField(TEXT("redirectors"), RedirectorsArray);
         Data->SetArrayField(TEXT("missingAssets"), MissingArray);
+        if (State->bIncludeReferencers)
+        {
+                Data->SetObjectField(TEXT("missing"), MissingReferencers);
+                Data->SetArrayField(TEXT("referencerPackages"), ReferencerPackagesArray);
+        }
         Data->SetArrayField(TEXT("brokenRefs"), BrokenArray);
         Data->SetArrayField(TEXT("unusedTextures"), UnusedTexturesArray);
         Data->SetArrayField(TEXT("orphans"), OrphansArray);
+        Data->SetStringField(TEXT("token"), ScanCache.MakeToken());
+        Data->SetBoolField(TEXT("incremental"), State->bIncremental);
+        if (State->bIncremental)
+        {
+                TArray<FName> RemovedPackages;
+                ScanCache.GetRemoved(State->Paths, State->bRecursive, SinceRevision, RemovedPackages);
+                TArray<TSharedPtr<FJsonValue>> RemovedArray;
+                for (const FName& PackageName : RemovedPackages)
+                {
+                        RemovedArray.Add(MakeShared<FJsonValueString>(PackageName.ToString()));
+                }
+                Data->SetArrayField(TEXT("changedPackages"), ChangedPackagesArray);
+                Data->SetArrayField(TEXT("removedPackages"), RemovedArray);
+        }
+        FAssetQuery::AddRegistryStatus(*Data);
 
         return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
 }
 
 TSharedPtr<FJsonObject> FContentTools::HandleValidate(const TSharedPtr<FJsonObject>& Params)
 {
-        TArray<FString> Paths;
-        FString ParseError;
-        if (!CollectContentPaths(Params, Paths, ParseError))
-        {
-                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(ParseError);
-                Error->SetStringField(TEXT("errorCode"), ErrorCodeValidateFailed);
-                return Error;
-        }
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
 
-        TSharedPtr<FJsonObject> RulesObject;
-        if (Params.IsValid())
+        // Checks that load objects yield at the end of each frame's budget and resume here.
+        UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+        TSharedPtr<FValidateResumeState> State = Context ? Context->TakeResumeState<FValidateResumeState>() : nullptr;
+        UnrealMCP::Protocol::FResponseStream* Stream = UnrealMCP::Protocol::FResponseStream::GetActive();
+        if (!State.IsValid())
         {
-                const TSharedPtr<FJsonObject>* RulesPtr = nullptr;
-                if (Params->TryGetObjectField(TEXT("rules"), RulesPtr))
+                State = MakeShared<FValidateResumeState>();
+
+                TArray<FString> Paths;
+                FString ParseError;
+                if (!CollectContentPaths(Params, Paths, ParseError))
                 {
-                        RulesObject = *RulesPtr;
+                        TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(ParseError);
+                        Error->SetStringField(TEXT("errorCode"), ErrorCodeValidateFailed);
+                        return Error;
                 }
-        }
-
-        TMap<FTopLevelAssetPath, FString> NamingRules;
-        int32 TextureMaxSize = 0;
-        bool bTexturePowerOfTwo = false;
-        bool bHasTextureRules = false;
-        bool bRequiresCollision = false;
-        int32 StaticMeshMinLODs = 0;
-        bool bHasStaticMeshRules = false;
-        TArray<FName> RequiredMIParams;
-        bool bHasMIRules = false;
 
-        if (RulesObject.IsValid())
-        {
-                const TSharedPtr<FJsonObject>* NamingObject = nullptr;
-                if (RulesObject->TryGetObjectField(TEXT("naming"), NamingObject))
+                // A registered rule set is already compiled; inline rules are compiled for this call.
+                FString RulesId;
+                if (Params.IsValid() && Params->TryGetStringField(TEXT("rulesId"), RulesId))
                 {
-                        for (const auto& Pair : (*NamingObject)->Values)
+                        const TSharedPtr<const FCompiledValidationRules>* Registered = RegisteredRules.Find(RulesId);
+                        if (!Registered)
                         {
-                                if (Pair.Value->Type != EJson::String)
-                                {
-                                        continue;
-                                }
-
-                                FTopLevelAssetPath ClassPath;
-                                if (!ResolveClassPathForRule(Pair.Key, ClassPath))
-                                {
-                                        continue;
-                                }
-
-                                NamingRules.Add(ClassPath, Pair.Value->AsString());
+                                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("No rules registered as '%s'"), *RulesId));
+                                Error->SetStringField(TEXT("errorCode"), ErrorCodeValidateFailed);
+                                return Error;
                         }
+                        State->Rules = *Registered;
                 }
-
-                const TSharedPtr<FJsonObject>* TextureRules = nullptr;
-                if (RulesObject->TryGetObjectField(TEXT("texture"), TextureRules))
+                else
                 {
-                        if ((*TextureRules)->HasTypedField<EJson::Number>(TEXT("maxSize")))
-                        {
-                                TextureMaxSize = static_cast<int32>((*TextureRules)->GetNumberField(TEXT("maxSize")));
-                                bHasTextureRules = true;
-                        }
-                        if ((*TextureRules)->HasTypedField<EJson::Boolean>(TEXT("powerOfTwo")))
-                        {
-                                bTexturePowerOfTwo = (*TextureRules)->GetBoolField(TEXT("powerOfTwo"));
-                                bHasTextureRules = true;
-                        }
+                        const TSharedPtr<FJsonObject>* RulesPtr = nullptr;
+                        State->Rules = FCompiledValidationRules::Compile(Params.IsValid() && Params->TryGetObjectField(TEXT("rules"), RulesPtr) ? *RulesPtr : nullptr);
                 }
-
-                const TSharedPtr<FJsonObject>* StaticMeshRules = nullptr;
-                if (RulesObject->TryGetObjectField(TEXT("staticMesh"), StaticMeshRules))
+                const FCompiledValidationRules& Rules = *State->Rules;
+
+                // shard {index, count}: this call checks only the assets whose package name hashes to
+                // index, so several editors on the same project can split one validation between them.
+                int32 ShardIndex = 0;
+                int32 ShardCount = 1;
+                const TSharedPtr<FJsonObject>* ShardObject = nullptr;
+                if (Params.IsValid() && Params->TryGetObjectField(TEXT("shard"), ShardObject))
                 {
-                        if ((*StaticMeshRules)->HasTypedField<EJson::Boolean>(TEXT("requiresCollision")))
-                        {
-                                bRequiresCollision = (*StaticMeshRules)->GetBoolField(TEXT("requiresCollision"));
-                                bHasStaticMeshRules = true;
-                        }
-                        if ((*StaticMeshRules)->HasTypedField<EJson::Number>(TEXT("minLODs")))
+                        if (!(*ShardObject)->TryGetNumberField(TEXT("index"), ShardIndex) || !(*ShardObject)->TryGetNumberField(TEXT("count"), ShardCount)
+                                || ShardCount < 1 || ShardIndex < 0 || ShardIndex >= ShardCount)
                         {
-                                StaticMeshMinLODs = static_cast<int32>((*StaticMeshRules)->GetNumberField(TEXT("minLODs")));
-                                bHasStaticMeshRules = true;
+                                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("shard needs count >= 1 and 0 <= index < count"));
+                                Error->SetStringField(TEXT("errorCode"), ErrorCodeValidateFailed);
+                                return Error;
                         }
                 }
 
-                const TSharedPtr<FJsonObject>* MIRules = nullptr;
-                if (RulesObject->TryGetObjectField(TEXT("mi"), MIRules))
+                FARFilter Filter;
+                Filter.bRecursivePaths = true;
+                for (const FString& Path : Paths)
                 {
-                        const TArray<TSharedPtr<FJsonValue>>* RequireParams = nullptr;
-                        if ((*MIRules)->TryGetArrayField(TEXT("requireParams"), RequireParams))
-                        {
-                                for (const TSharedPtr<FJsonValue>& Value : *RequireParams)
-                                {
-                                        if (Value->Type == EJson::String)
-                                        {
-                                                RequiredMIParams.Add(*Value->AsString());
-                                        }
-                                }
-                                bHasMIRules = RequiredMIParams.Num() > 0;
-                        }
+                        Filter.PackagePaths.Add(*Path);
                 }
-        }
-
-        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
-
-        FARFilter Filter;
-        Filter.bRecursiveClasses = true;
-        Filter.bRecursivePaths = true;
-        for (const FString& Path : Paths)
-        {
-                Filter.PackagePaths.Add(*Path);
-        }
-
-        TArray<FAssetData> Assets;
-        if (!AssetRegistry.GetAssets(Filter, Assets))
-        {
-                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to query Asset Registry"));
-                Error->SetStringField(TEXT("errorCode"), ErrorCodeValidateFailed);
-                return Error;
-        }
 
-        const FTopLevelAssetPath TextureClassPath = UTexture::StaticClass()->GetClassPathName();
-        const FTopLevelAssetPath StaticMeshClassPath = UStaticMesh::StaticClass()->GetClassPathName();
-        const FTopLevelAssetPath MaterialInstanceClassPath = UMaterialInstance::StaticClass()->GetClassPathName();
-
-        TArray<TSharedPtr<FJsonValue>> Violations;
-        TMap<FString, int32> ViolationsByRule;
-
-        auto AddViolation = [&Violations, &ViolationsByRule](const FString& AssetPath, const FString& RuleId, const FString& Message)
-        {
-                TSharedPtr<FJsonObject> Violation = MakeShared<FJsonObject>();
-                Violation->SetStringField(TEXT("asset"), AssetPath);
-                Violation->SetStringField(TEXT("rule"), RuleId);
-                Violation->SetStringField(TEXT("message"), Message);
-                Violations.Add(MakeShared<FJsonValueObject>(Violation));
-                ViolationsByRule.FindOrAdd(RuleId) += 1;
-        };
-
-        for (const FAssetData& AssetData : Assets)
-        {
-                const FString ObjectPath = AssetData.ToSoftObjectPath().ToString();
-
-                // Naming
-                for (const TPair<FTopLevelAssetPath, FString>& Rule : NamingRules)
+                if (!AssetRegistry.GetAssets(Filter, State->Assets))
+                {
+                        TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to query Asset Registry"));
+                        Error->SetStringField(TEXT("errorCode"), ErrorCodeValidateFailed);
+                        return Error;
+                }
+                if (ShardCount > 1)
                 {
-                        if (!AssetData.IsInstanceOf(Rule.Key))
+                        // A CRC of the name rather than GetTypeHash, which depends on the process's name table.
+                        State->Assets.RemoveAllSwap([ShardIndex, ShardCount](const FAssetData& AssetData)
                         {
-                                continue;
-                        }
+                                return static_cast<int32>(FCrc::StrCrc32(*AssetData.PackageName.ToString()) % static_cast<uint32>(ShardCount)) != ShardIndex;
+                        });
+                }
 
-                        const FString AssetName = AssetData.AssetName.ToString();
-                        if (!IsRegexMatch(AssetName, Rule.Value))
+                // Class membership is settled up front from the registry's class tree (which blueprint
+                // classes can change, so not at compile time), so the workers only look up class paths.
+                TMap<FTopLevelAssetPath, TArray<int32>> NamingRulesByClass;
+                for (int32 RuleIndex = 0; RuleIndex < Rules.Naming.Num(); ++RuleIndex)
+                {
+                        TSet<FTopLevelAssetPath> Classes;
+                        CollectDerivedClasses(Rules.Naming[RuleIndex].ClassPath, Classes);
+                        for (const FTopLevelAssetPath& ClassPath : Classes)
                         {
-                                AddViolation(ObjectPath, FString::Printf(TEXT("naming.%s"), *Rule.Key.GetAssetName().ToString()),
-                                             FString::Printf(TEXT("Name should match %s"), *Rule.Value));
+                                NamingRulesByClass.FindOrAdd(ClassPath).Add(RuleIndex);
                         }
                 }
+                TSet<FTopLevelAssetPath> TextureClasses;
+                TSet<FTopLevelAssetPath> StaticMeshClasses;
+                TSet<FTopLevelAssetPath> MaterialInstanceClasses;
+                if (Rules.bHasTextureRules)
+                {
+                        CollectDerivedClasses(UTexture::StaticClass()->GetClassPathName(), TextureClasses);
+                }
+                if (Rules.bHasStaticMeshRules)
+                {
+                        CollectDerivedClasses(UStaticMesh::StaticClass()->GetClassPathName(), StaticMeshClasses);
+                }
+                if (Rules.RequiredMIParams.Num() > 0)
+                {
+                        CollectDerivedClasses(UMaterialInstance::StaticClass()->GetClassPathName(), MaterialInstanceClasses);
+                }
 
-                // Texture rules
-                if (bHasTextureRules && AssetData.IsInstanceOf(TextureClassPath))
+                // Naming rules, and texture and mesh rules whose answer is in the registry tags, only
+                // need registry data, so they run on workers. What is left needs the loaded object and
+                // stays on the game thread.
+                const TArray<FAssetData>& Assets = State->Assets;
+                const int32 ChunkCount = FMath::DivideAndRoundUp(Assets.Num(), ValidateChunkSize);
+                TArray<TArray<FValidateFinding>> ChunkFindings;
+                TArray<TArray<FValidateLoadCheck>> ChunkLoadChecks;
+                ChunkFindings.SetNum(ChunkCount);
+                ChunkLoadChecks.SetNum(ChunkCount);
+                ParallelFor(ChunkCount, [&](int32 ChunkIndex)
                 {
-                        if (UTexture* Texture = Cast<UTexture>(AssetData.GetAsset()))
+                        TArray<FValidateFinding>& Findings = ChunkFindings[ChunkIndex];
+                        TArray<FValidateLoadCheck>& LoadChecks = ChunkLoadChecks[ChunkIndex];
+                        const int32 Begin = ChunkIndex * ValidateChunkSize;
+                        const int32 End = FMath::Min(Begin + ValidateChunkSize, Assets.Num());
+                        for (int32 AssetIndex = Begin; AssetIndex < End; ++AssetIndex)
                         {
-                                const int32 Width = Texture->GetSurfaceWidth();
-                                const int32 Height = Texture->GetSurfaceHeight();
-                                if (TextureMaxSize > 0 && (Width > TextureMaxSize || Height > TextureMaxSize))
+                                const FAssetData& AssetData = Assets[AssetIndex];
+                                auto AddFinding = [&Findings, AssetIndex](const TCHAR* RuleId, const FString& Message)
                                 {
-                                        AddViolation(ObjectPath, TEXT("texture.maxSize"),
-                                                     FString::Printf(TEXT("Texture dimensions %dx%d exceed max %d"), Width, Height, TextureMaxSize));
-                                }
+                                        Findings.Add({ AssetIndex, RuleId, Message });
+                                };
 
-                                if (bTexturePowerOfTwo)
+                                if (const TArray<int32>* RuleIndices = NamingRulesByClass.Find(AssetData.AssetClassPath))
                                 {
-                                        if (!FMath::IsPowerOfTwo(Width) || !FMath::IsPowerOfTwo(Height))
+                                        const FString AssetName = AssetData.AssetName.ToString();
+                                        for (const int32 RuleIndex : *RuleIndices)
                                         {
-                                                AddViolation(ObjectPath, TEXT("texture.powerOfTwo"), TEXT("Texture dimensions must be powers of two"));
+                                                const FCompiledValidationRules::FNamingRule& Rule = Rules.Naming[RuleIndex];
+                                                if (!Rule.Matches(AssetName))
+                                                {
+                                                        AddFinding(*Rule.RuleId, FString::Printf(TEXT("Name should match %s"), *Rule.PatternString));
+                                                }
                                         }
                                 }
-                        }
-                }
 
-                // Static mesh rules
-                if (bHasStaticMeshRules && AssetData.IsInstanceOf(StaticMeshClassPath))
-                {
-                        if (UStaticMesh* StaticMesh = Cast<UStaticMesh>(AssetData.GetAsset()))
-                        {
-                                if (StaticMeshMinLODs > 0)
+                                if (TextureClasses.Contains(AssetData.AssetClassPath))
                                 {
-                                        const int32 NumLODs = StaticMesh->GetNumLODs();
-                                        if (NumLODs < StaticMeshMinLODs)
+                                        int32 Width = 0;
+                                        int32 Height = 0;
+                                        if (TryGetTextureDimensions(AssetData, Width, Height))
+                                        {
+                                                CheckTextureSize(Rules, Width, Height, AddFinding);
+                                        }
+                                        else
                                         {
-                                                AddViolation(ObjectPath, TEXT("staticMesh.minLODs"),
-                                                             FString::Printf(TEXT("Expected >=%d LODs, got %d"), StaticMeshMinLODs, NumLODs));
+                                                LoadChecks.Add({ AssetIndex, EValidateLoadKind::Texture });
                                         }
                                 }
-
-                                if (bRequiresCollision)
+                                else if (StaticMeshClasses.Contains(AssetData.AssetClassPath))
                                 {
-                                        const UBodySetup* BodySetup = StaticMesh->GetBodySetup();
-                                        const bool bHasCollision = BodySetup && (BodySetup->AggGeom.GetElementCount() > 0 || BodySetup->bHasCookedCollisionData);
-                                        if (!bHasCollision)
+                                        // CollisionPrims only counts simple shapes; a mesh without any may still
+                                        // have cooked collision, which takes the object to tell.
+                                        int32 NumLODs = 0;
+                                        int32 CollisionPrims = 0;
+                                        const bool bLODsKnown = Rules.StaticMeshMinLODs <= 0 || TryGetIntTag(AssetData, TEXT("LODs"), NumLODs);
+                                        const bool bCollisionKnown = !Rules.bRequiresCollision || (TryGetIntTag(AssetData, TEXT("CollisionPrims"), CollisionPrims) && CollisionPrims > 0);
+                                        if (bLODsKnown && bCollisionKnown)
+                                        {
+                                                CheckStaticMesh(Rules, NumLODs, true, AddFinding);
+                                        }
+                                        else
                                         {
-                                                AddViolation(ObjectPath, TEXT("staticMesh.requiresCollision"), TEXT("Static mesh is missing collision"));
+                                                LoadChecks.Add({ AssetIndex, EValidateLoadKind::StaticMesh });
                                         }
                                 }
+                                else if (MaterialInstanceClasses.Contains(AssetData.AssetClassPath))
+                                {
+                                        LoadChecks.Add({ AssetIndex, EValidateLoadKind::MaterialInstance });
+                                }
                         }
+                });
+
+                for (int32 ChunkIndex = 0; ChunkIndex < ChunkCount; ++ChunkIndex)
+                {
+                        for (const FValidateFinding& Finding : ChunkFindings[ChunkIndex])
+                        {
+                                State->AddViolation(Assets[Finding.AssetIndex].ToSoftObjectPath().ToString(), Finding.RuleId, Finding.Message, Stream);
+                        }
+                        State->LoadChecks.Append(MoveTemp(ChunkLoadChecks[ChunkIndex]));
+                }
+        }
+
+        const FCompiledValidationRules& Rules = *State->Rules;
+        const TArray<FAssetData>& Assets = State->Assets;
+        const TArray<FValidateLoadCheck>& LoadChecks = State->LoadChecks;
+        const int32 FirstIndex = State->NextLoadCheck;
+        for (int32 CheckIndex = FirstIndex; CheckIndex < LoadChecks.Num(); ++CheckIndex)
+        {
+                if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
+                {
+                        return MakeCancelledResponse(TEXT("Validate"), CheckIndex, LoadChecks.Num());
+                }
+                if (CheckIndex > FirstIndex && Context && Context->ShouldYield())
+                {
+                        State->NextLoadCheck = CheckIndex;
+                        State->FlushStream(Stream);
+                        Context->Yield(State.ToSharedRef());
+                        return nullptr;
                 }
+                UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(CheckIndex, LoadChecks.Num(), TEXT("validate"));
 
-                // Material instance rules
-                if (bHasMIRules && AssetData.IsInstanceOf(MaterialInstanceClassPath))
+                // Instances with cached parameters usually skip the load, so they are not prefetched.
+                TArray<FString> PrefetchPaths;
+                const int32 PrefetchEnd = FMath::Min(CheckIndex + ValidatePrefetchWindow, LoadChecks.Num());
+                for (; State->PrefetchedThrough < PrefetchEnd; ++State->PrefetchedThrough)
                 {
-                        if (UMaterialInstance* MaterialInstance = Cast<UMaterialInstance>(AssetData.GetAsset()))
+                        const FValidateLoadCheck& Ahead = LoadChecks[State->PrefetchedThrough];
+                        const FSoftObjectPath AheadPath = Assets[Ahead.AssetIndex].ToSoftObjectPath();
+                        if (Ahead.Kind != EValidateLoadKind::MaterialInstance || !MaterialParameterCache.Contains(AheadPath))
                         {
-                                TSet<FName> AvailableParams;
-                                TArray<FMaterialParameterInfo> Infos;
-                                TArray<FGuid> Ids;
-
-                                Infos.Reset();
-                                Ids.Reset();
-                                MaterialInstance->GetAllScalarParameterInfo(Infos, Ids);
-                                for (const FMaterialParameterInfo& Info : Infos)
-                                {
-                                        AvailableParams.Add(Info.Name);
-                                }
+                                PrefetchPaths.Add(AheadPath.ToString());
+                        }
+                }
+                State->Prefetch->Request(PrefetchPaths);
 
-                                Infos.Reset();
-                                Ids.Reset();
-                                MaterialInstance->GetAllVectorParameterInfo(Infos, Ids);
-                                for (const FMaterialParameterInfo& Info : Infos)
-                                {
-                                        AvailableParams.Add(Info.Name);
-                                }
+                const FAssetData& AssetData = Assets[LoadChecks[CheckIndex].AssetIndex];
+                const FString ObjectPath = AssetData.ToSoftObjectPath().ToString();
+                if (Context && Context->CanSuspend() && !State->Prefetch->IsReady(ObjectPath))
+                {
+                        State->NextLoadCheck = CheckIndex;
+                        State->FlushStream(Stream);
+                        Context->Suspend(State.ToSharedRef());
+                        return nullptr;
+                }
+                auto AddFinding = [&State, &ObjectPath, Stream](const TCHAR* RuleId, const FString& Message)
+                {
+                        State->AddViolation(ObjectPath, RuleId, Message, Stream);
+                };
 
-                                Infos.Reset();
-                                Ids.Reset();
-                                MaterialInstance->GetAllTextureParameterInfo(Infos, Ids);
-                                for (const FMaterialParameterInfo& Info : Infos)
-                                {
-                                        AvailableParams.Add(Info.Name);
-                                }
+                switch (LoadChecks[CheckIndex].Kind)
+                {
+                case EValidateLoadKind::Texture:
+                        if (UTexture* Texture = Cast<UTexture>(AssetData.GetAsset()))
+                        {
+                                ++State->AssetsLoaded;
+                                CheckTextureSize(Rules, Texture->GetSurfaceWidth(), Texture->GetSurfaceHeight(), AddFinding);
+                        }
+                        break;
 
-                                Infos.Reset();
-                                Ids.Reset();
-                                MaterialInstance->GetAllStaticSwitchParameterInfo(Infos, Ids);
-                                for (const FMaterialParameterInfo& Info : Infos)
-                                {
-                                        AvailableParams.Add(Info.Name);
-                                }
+                case EValidateLoadKind::StaticMesh:
+                        if (UStaticMesh* StaticMesh = Cast<UStaticMesh>(AssetData.GetAsset()))
+                        {
+                                ++State->AssetsLoaded;
+                                const UBodySetup* BodySetup = StaticMesh->GetBodySetup();
+                                const bool bHasCollision = BodySetup && (BodySetup->AggGeom.GetElementCount() > 0 || BodySetup->bHasCookedCollisionData);
+                                CheckStaticMesh(Rules, StaticMesh->GetNumLODs(), bHasCollision, AddFinding);
+                        }
+                        break;
 
-                                for (const FName& RequiredParam : RequiredMIParams)
+                case EValidateLoadKind::MaterialInstance:
+                {
+                        TArray<FName> AvailableParams;
+                        bool bLoaded = false;
+                        bool bCacheHit = false;
+                        if (ReadMaterialParameterNames(AssetRegistry, AssetData, AvailableParams, bLoaded, bCacheHit))
+                        {
+                                State->AssetsLoaded += bLoaded ? 1 : 0;
+                                State->ParameterCacheHits += bCacheHit ? 1 : 0;
+                                for (const FName& RequiredParam : Rules.RequiredMIParams)
                                 {
                                         if (!AvailableParams.Contains(RequiredParam))
                                         {
-                                                AddViolation(ObjectPath, TEXT("mi.requireParams"),
-                                                             FString::Printf(TEXT("Missing required parameter %s"), *RequiredParam.ToString()));
+                                                AddFinding(TEXT("mi.requireParams"), FString::Printf(TEXT("Missing required parameter %s"), *RequiredParam.ToString()));
                                         }
                                 }
                         }
+                        break;
+                }
                 }
         }
 
+        UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(LoadChecks.Num(), LoadChecks.Num(), TEXT("validate"));
+
         TSharedPtr<FJsonObject> Summary = MakeShared<FJsonObject>();
-        Summary->SetNumberField(TEXT("violations"), Violations.Num());
+        Summary->SetNumberField(TEXT("violations"), State->ViolationCount);
+        Summary->SetNumberField(TEXT("assets"), Assets.Num());
+        Summary->SetNumberField(TEXT("assetsLoaded"), State->AssetsLoaded);
+        Summary->SetNumberField(TEXT("parameterCacheHits"), State->ParameterCacheHits);
+        Summary->SetObjectField(TEXT("prefetch"), State->Prefetch->ToJson());
 
         TSharedPtr<FJsonObject> ByRule = MakeShared<FJsonObject>();
-        for (const TPair<FString, int32>& Pair : ViolationsByRule)
+        for (const TPair<FString, int32>& Pair : State->ViolationsByRule)
         {
                 ByRule->SetNumberField(Pair.Key, Pair.Value);
         }
@@ -715,168 +1332,295 @@ TSharedPtr<FJsonObject> FContentTools::HandleValidate(const TSharedPtr<FJsonObje
 
         TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
         Data->SetBoolField(TEXT("ok"), true);
-        Data->SetArrayField(TEXT("violations"), Violations);
+        if (Stream)
+        {
+                State->FlushStream(Stream);
+                Data->SetBoolField(TEXT("violationsStreamed"), true);
+        }
+        else
+        {
+                Data->SetArrayField(TEXT("violations"), State->Violations);
+        }
         Data->SetObjectField(TEXT("summary"), Summary);
+        FAssetQuery::AddRegistryStatus(*Data);
 
         return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
 }
 
-TSharedPtr<FJsonObject> FContentTools::HandleFixMissing(const TSharedPtr<FJsonObject>& Params)
+TSharedPtr<FJsonObject> FContentTools::HandleRegisterRules(const TSharedPtr<FJsonObject>& Params)
 {
-        if (!FWriteGate::IsWriteAllowed())
+        FString RulesId;
+        const TSharedPtr<FJsonObject>* RulesPtr = nullptr;
+        if (!Params.IsValid() || !Params->TryGetStringField(TEXT("id"), RulesId) || RulesId.IsEmpty())
         {
-                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Writes are currently disabled"));
-                Error->SetStringField(TEXT("errorCode"), ErrorCodeWriteNotAllowed);
+                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'id' parameter"));
+                Error->SetStringField(TEXT("errorCode"), ErrorCodeValidateFailed);
                 return Error;
         }
-
-        TArray<FString> Paths;
-        FString ParseError;
-        if (!CollectContentPaths(Params, Paths, ParseError))
+        if (!Params->TryGetObjectField(TEXT("rules"), RulesPtr))
         {
-                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(ParseError);
-                Error->SetStringField(TEXT("errorCode"), ErrorCodeFixRedirectorsFailed);
-                return Error;
+                // Without rules the id is dropped.
+                TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+                Data->SetStringField(TEXT("id"), RulesId);
+                Data->SetBoolField(TEXT("removed"), RegisteredRules.Remove(RulesId) > 0);
+                return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
         }
 
-        for (const FString& Path : Paths)
-        {
-                FString Reason;
-                if (!FWriteGate::IsPathAllowed(Path, Reason))
-                {
-                        TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(Reason);
-                        Error->SetStringField(TEXT("errorCode"), TEXT("PATH_NOT_ALLOWED"));
-                        return Error;
-                }
-        }
+        const TSharedRef<FCompiledValidationRules> Rules = FCompiledValidationRules::Compile(*RulesPtr);
+        RegisteredRules.Add(RulesId, Rules);
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetStringField(TEXT("id"), RulesId);
+        Data->SetObjectField(TEXT("compiled"), Rules->Describe());
+        return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+}
 
-        bool bRecursive = true;
-        bool bFixRedirectors = true;
-        bool bRemapReferences = true;
-        bool bDeleteRedirectors = true;
-        bool bSave = true;
+bool FContentTools::ReadMaterialParameterNames(IAssetRegistry& AssetRegistry, const FAssetData& AssetData, TArray<FName>& OutNames, bool& bOutLoaded, bool& bOutCacheHit)
+{
+        bOutLoaded = false;
+        bOutCacheHit = false;
 
-        if (Params.IsValid())
+        // Already in memory: read it as it is now, which may be ahead of what is on disk.
+        if (UMaterialInstance* Loaded = Cast<UMaterialInstance>(AssetData.FastGetAsset(false)))
         {
-                Params->TryGetBoolField(TEXT("recursive"), bRecursive);
-                Params->TryGetBoolField(TEXT("save"), bSave);
+                CollectMaterialParameterNames(Loaded, OutNames);
+                return true;
+        }
 
-                const TSharedPtr<FJsonObject>* FixObject = nullptr;
-                if (Params->TryGetObjectField(TEXT("fix"), FixObject) && FixObject->IsValid())
+        const FSoftObjectPath ObjectPath = AssetData.ToSoftObjectPath();
+        const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(AssetData.PackageName);
+        if (PackageData.IsSet())
+        {
+                const FCachedMaterialParameters* Cached = MaterialParameterCache.Find(ObjectPath);
+                if (Cached && Cached->PackageSavedHash == PackageData->GetPackageSavedHash())
                 {
-                        (*FixObject)->TryGetBoolField(TEXT("redirectors"), bFixRedirectors);
-                        (*FixObject)->TryGetBoolField(TEXT("remapReferences"), bRemapReferences);
-                        (*FixObject)->TryGetBoolField(TEXT("deleteStaleRedirectors"), bDeleteRedirectors);
+                        OutNames = Cached->Names;
+                        bOutCacheHit = true;
+                        return true;
                 }
         }
 
-        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
-
-        TArray<UObjectRedirector*> Redirectors;
-        TMap<FString, FString> RedirectMap;
-        FARFilter Filter;
-        Filter.bRecursivePaths = bRecursive;
-        Filter.bRecursiveClasses = true;
-        for (const FString& Path : Paths)
+        UMaterialInstance* MaterialInstance = Cast<UMaterialInstance>(AssetData.GetAsset());
+        if (!MaterialInstance)
         {
-                Filter.PackagePaths.Add(*Path);
+                return false;
         }
+        bOutLoaded = true;
+        CollectMaterialParameterNames(MaterialInstance, OutNames);
 
-        TArray<FAssetData> Assets;
-        AssetRegistry.GetAssets(Filter, Assets);
+        if (PackageData.IsSet())
+        {
+                FCachedMaterialParameters& Entry = MaterialParameterCache.FindOrAdd(ObjectPath);
+                Entry.PackageSavedHash = PackageData->GetPackageSavedHash();
+                Entry.Names = OutNames;
+        }
+        return true;
+}
 
-        const FTopLevelAssetPath RedirectorClassPath = UObjectRedirector::StaticClass()->GetClassPathName();
-        const FString CombinedPaths = FString::Join(Paths, TEXT(","));
-        for (const FAssetData& AssetData : Assets)
+TSharedPtr<FJsonObject> FContentTools::HandleFixMissing(const TSharedPtr<FJsonObject>& Params)
+{
+        // Planned on a worker from registry data while the request is suspended; the batches are then
+        // applied a few per frame, each loading, fixing, remapping and saving only its own packages.
+        UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+        TSharedPtr<FFixMissingResumeState> State = Context ? Context->TakeResumeState<FFixMissingResumeState>() : nullptr;
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+        if (!State.IsValid())
         {
-                if (AssetData.AssetClassPath != RedirectorClassPath)
+                if (!FWriteGate::IsWriteAllowed())
                 {
-                        continue;
+                        TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Writes are currently disabled"));
+                        Error->SetStringField(TEXT("errorCode"), ErrorCodeWriteNotAllowed);
+                        return Error;
+                }
+
+                State = MakeShared<FFixMissingResumeState>();
+                FString ParseError;
+                if (!CollectContentPaths(Params, State->Paths, ParseError))
+                {
+                        TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(ParseError);
+                        Error->SetStringField(TEXT("errorCode"), ErrorCodeFixRedirectorsFailed);
+                        return Error;
                 }
 
-                if (UObjectRedirector* Redirector = Cast<UObjectRedirector>(AssetData.GetAsset()))
+                for (const FString& Path : State->Paths)
                 {
-                        Redirectors.Add(Redirector);
-                        if (Redirector->DestinationObject)
+                        FString Reason;
+                        if (!FWriteGate::IsPathAllowed(Path, Reason))
                         {
-                                RedirectMap.Add(Redirector->GetPathName(), Redirector->DestinationObject->GetPathName());
+                                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(Reason);
+                                Error->SetStringField(TEXT("errorCode"), TEXT("PATH_NOT_ALLOWED"));
+                                return Error;
                         }
                 }
-        }
 
-        const int32 InitialRedirectorCount = Redirectors.Num();
+                if (Params.IsValid())
+                {
+                        Params->TryGetBoolField(TEXT("recursive"), State->bRecursive);
+                        Params->TryGetBoolField(TEXT("save"), State->bSave);
+
+                        const TSharedPtr<FJsonObject>* FixObject = nullptr;
+                        if (Params->TryGetObjectField(TEXT("fix"), FixObject) && FixObject->IsValid())
+                        {
+                                (*FixObject)->TryGetBoolField(TEXT("redirectors"), State->bFixRedirectors);
+                                (*FixObject)->TryGetBoolField(TEXT("remapReferences"), State->bRemapReferences);
+                                (*FixObject)->TryGetBoolField(TEXT("deleteStaleRedirectors"), State->bDeleteRedirectors);
+                        }
+                }
+                State->StartUsedBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
 
-        int32 FixedRedirectorCount = 0;
-        int32 RemappedCount = 0;
-        int32 DeletedCount = 0;
+                // Every asset under the paths: redirectors to fix, the rest to remap soft references in.
+                FARFilter Filter;
+                Filter.bRecursivePaths = State->bRecursive;
+                for (const FString& Path : State->Paths)
+                {
+                        Filter.PackagePaths.Add(*Path);
+                }
+                State->Plan = MakeShared<FFixMissingPlan>();
+                AssetRegistry.GetAssets(Filter, State->Plan->Assets);
 
-        TArray<TSharedPtr<FJsonValue>> AuditActions;
+                UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(0, 1, TEXT("plan"));
+                if (Context && Context->CanSuspend())
+                {
+                        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Plan = State->Plan, &AssetRegistry]()
+                        {
+                                BuildFixMissingPlan(AssetRegistry, *Plan);
+                                Plan->bDone = true;
+                        });
+                }
+                else
+                {
+                        BuildFixMissingPlan(AssetRegistry, *State->Plan);
+                        State->Plan->bDone = true;
+                }
+        }
 
-        if (bFixRedirectors && Redirectors.Num() > 0)
+        if (!State->Plan->bDone)
         {
-                FAssetToolsModule& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
-                AssetTools.Get().FixupReferencers(Redirectors);
+                if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
+                {
+                        // The worker finishes on its own; nothing has been changed yet.
+                        return MakeCancelledResponse(TEXT("content.fix_missing"), 0, State->Plan->Assets.Num());
+                }
+                Context->Suspend(State.ToSharedRef());
+                return nullptr;
+        }
+
+        const FFixMissingPlan& Plan = *State->Plan;
+        const bool bRemap = State->bRemapReferences && Plan.RedirectMap.Num() > 0;
+        const bool bApplyBatches = (State->bFixRedirectors && Plan.Redirectors.Num() > 0) || bRemap;
+        const double SliceStart = FPlatformTime::Seconds();
+        const double SliceBudgetSeconds = FUnrealMCPRuntimeConfig::Get().GameThreadBudgetMs / 1000.0;
 
-                FixedRedirectorCount = Redirectors.Num();
+        // One source-control call for every package the batches touch; each batch's own checkout is then answered from the cache.
+        if (!State->bCheckedOut)
+        {
+                State->bCheckedOut = true;
+                TSharedPtr<FJsonObject> CheckoutError;
+                if (State->bFixRedirectors && Plan.PackagesToTouch.Num() > 0 && !FWriteGate::EnsureCheckoutForContentPaths(Plan.PackagesToTouch, CheckoutError))
+                {
+                        return CheckoutError;
+                }
         }
 
-        TSet<UPackage*> DirtyPackages;
-        if (bRemapReferences && RedirectMap.Num() > 0)
+        while (bApplyBatches && State->NextBatch < Plan.Batches.Num())
         {
-                for (const FAssetData& AssetData : Assets)
+                if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
                 {
-                        if (AssetData.AssetClassPath == RedirectorClassPath)
+                        State->bCancelled = true;
+                        break;
+                }
+                UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(State->NextBatch, Plan.Batches.Num(), TEXT("fix_redirectors"));
+                const FFixMissingPlan::FBatch& Batch = Plan.Batches[State->NextBatch];
+
+                if (State->bFixRedirectors)
+                {
+                        TSharedPtr<FJsonObject> CheckoutError;
+                        if (!FRedirectorFixup::FixBatch(Batch.Fixup, State->FixedPaths, CheckoutError))
                         {
-                                continue;
+                                return CheckoutError;
                         }
+                }
 
-                        UObject* Asset = AssetData.GetAsset();
-                        if (!Asset)
+                TSet<UPackage*> DirtyPackages;
+                if (bRemap)
+                {
+                        for (const FSoftObjectPath& AssetPath : Batch.RemapAssets)
                         {
-                                continue;
+                                RemapSoftReferencesInObject(AssetPath.TryLoad(), Plan.RedirectMap, State->RemappedCount, DirtyPackages);
+                        }
+                }
+                State->DirtyCount += DirtyPackages.Num();
+
+                if (State->bSave && DirtyPackages.Num() > 0)
+                {
+                        TArray<FPackageSaver::FResult> SaveResults;
+                        TSharedPtr<FJsonObject> CheckoutError;
+                        if (!FPackageSaver::SavePackages(DirtyPackages.Array(), SaveResults, CheckoutError, /*bConcurrent=*/true))
+                        {
+                                return CheckoutError;
+                        }
+                        if (SaveResults.ContainsByPredicate([](const FPackageSaver::FResult& Result) { return !Result.bSaved; }))
+                        {
+                                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to save packages"));
+                                Error->SetStringField(TEXT("errorCode"), ErrorCodeSaveFailed);
+                                Error->SetArrayField(TEXT("results"), FPackageSaver::ResultsToJson(SaveResults));
+                                return Error;
                         }
+                }
+                ++State->NextBatch;
 
-                        RemapSoftReferencesInObject(Asset, RedirectMap, RemappedCount, DirtyPackages);
+                // Saved batches hold nothing we need; unsaved remaps live only in their dirty packages, so those stay.
+                if ((State->bSave || State->DirtyCount == 0)
+                    && FRedirectorFixup::CollectGarbageOverCeiling(State->StartUsedBytes, FRedirectorFixup::DefaultMemoryCeilingBytes))
+                {
+                        ++State->GarbageCollections;
                 }
 
+                if (State->NextBatch < Plan.Batches.Num() && Context && Context->CanSuspend()
+                    && FPlatformTime::Seconds() - SliceStart >= SliceBudgetSeconds)
+                {
+                        Context->Suspend(State.ToSharedRef());
+                        return nullptr;
+                }
         }
 
-        if (bDeleteRedirectors && Redirectors.Num() > 0)
+        // The fixups delete what they leave unreferenced; whatever the registry still shows unreferenced goes here.
+        while (State->bDeleteRedirectors && !State->bCancelled && State->NextDelete < Plan.Redirectors.Num())
         {
-                for (UObjectRedirector* Redirector : Redirectors)
+                if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
                 {
-                        if (!Redirector)
-                        {
-                                continue;
-                        }
-
-                        const FString ObjectPath = Redirector->GetPathName();
-                        const FString PackageName = Redirector->GetOutermost()->GetName();
+                        State->bCancelled = true;
+                        break;
+                }
+                UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(State->NextDelete, Plan.Redirectors.Num(), TEXT("delete_redirectors"));
+                const FAssetData& Redirector = Plan.Redirectors[State->NextDelete++];
+                const FString ObjectPath = Redirector.GetObjectPathString();
 
-                        TArray<FName> Referencers;
-                        AssetRegistry.GetReferencers(*PackageName, Referencers, EAssetRegistryDependencyType::All);
-                        if (Referencers.Num() > 0)
-                        {
-                                continue;
-                        }
+                TArray<FName> Referencers;
+                AssetRegistry.GetReferencers(Redirector.PackageName, Referencers, EAssetRegistryDependencyType::All);
+                if (Referencers.Num() == 0 && UEditorAssetLibrary::DoesAssetExist(ObjectPath) && UEditorAssetLibrary::DeleteAsset(ObjectPath))
+                {
+                        ++State->DeletedCount;
+                }
 
-                        if (UEditorAssetLibrary::DoesAssetExist(ObjectPath))
-                        {
-                                if (UEditorAssetLibrary::DeleteAsset(ObjectPath))
-                                {
-                                        ++DeletedCount;
-                                }
-                        }
+                if (State->NextDelete < Plan.Redirectors.Num() && Context && Context->CanSuspend()
+                    && FPlatformTime::Seconds() - SliceStart >= SliceBudgetSeconds)
+                {
+                        Context->Suspend(State.ToSharedRef());
+                        return nullptr;
                 }
         }
 
-        if (bFixRedirectors)
+        const FString CombinedPaths = FString::Join(State->Paths, TEXT(","));
+        TArray<TSharedPtr<FJsonValue>> AuditActions;
+
+        if (State->bFixRedirectors)
         {
                 TSharedPtr<FJsonObject> Action = MakeShared<FJsonObject>();
                 Action->SetStringField(TEXT("op"), TEXT("fix_redirectors"));
-                Action->SetNumberField(TEXT("count"), FixedRedirectorCount);
-                Action->SetBoolField(TEXT("recursive"), bRecursive);
-                Action->SetBoolField(TEXT("executed"), InitialRedirectorCount > 0);
+                Action->SetNumberField(TEXT("count"), State->FixedPaths.Num());
+                Action->SetBoolField(TEXT("recursive"), State->bRecursive);
+                Action->SetBoolField(TEXT("executed"), Plan.Redirectors.Num() > 0);
                 if (!CombinedPaths.IsEmpty())
                 {
                         Action->SetStringField(TEXT("paths"), CombinedPaths);
@@ -884,11 +1628,11 @@ TSharedPtr<FJsonObject> FContentTools::HandleFixMissing(const TSharedPtr<FJsonOb
                 AuditActions.Add(MakeShared<FJsonValueObject>(Action));
         }
 
-        if (bRemapReferences)
+        if (State->bRemapReferences)
         {
                 TSharedPtr<FJsonObject> Action = MakeShared<FJsonObject>();
                 Action->SetStringField(TEXT("op"), TEXT("remap_soft_refs"));
-                Action->SetNumberField(TEXT("count"), RemappedCount);
+                Action->SetNumberField(TEXT("count"), State->RemappedCount);
                 if (!CombinedPaths.IsEmpty())
                 {
                         Action->SetStringField(TEXT("paths"), CombinedPaths);
@@ -896,11 +1640,11 @@ TSharedPtr<FJsonObject> FContentTools::HandleFixMissing(const TSharedPtr<FJsonOb
                 AuditActions.Add(MakeShared<FJsonValueObject>(Action));
         }
 
-        if (bDeleteRedirectors)
+        if (State->bDeleteRedirectors)
         {
                 TSharedPtr<FJsonObject> Action = MakeShared<FJsonObject>();
                 Action->SetStringField(TEXT("op"), TEXT("delete_redirectors"));
-                Action->SetNumberField(TEXT("count"), DeletedCount);
+                Action->SetNumberField(TEXT("count"), State->DeletedCount);
                 if (!CombinedPaths.IsEmpty())
                 {
                         Action->SetStringField(TEXT("paths"), CombinedPaths);
@@ -908,30 +1652,25 @@ TSharedPtr<FJsonObject> FContentTools::HandleFixMissing(const TSharedPtr<FJsonOb
                 AuditActions.Add(MakeShared<FJsonValueObject>(Action));
         }
 
-        if (bSave && DirtyPackages.Num() > 0)
-        {
-                TArray<UPackage*> PackagesToSave = DirtyPackages.Array();
-                if (!UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, /*bOnlyDirty*/ false))
-                {
-                        TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to save packages"));
-                        Error->SetStringField(TEXT("errorCode"), ErrorCodeSaveFailed);
-                        return Error;
-                }
-        }
-
-        if (bSave)
+        if (State->bSave)
         {
                 TSharedPtr<FJsonObject> SaveAction = MakeShared<FJsonObject>();
                 SaveAction->SetStringField(TEXT("op"), TEXT("save_packages"));
-                SaveAction->SetNumberField(TEXT("count"), DirtyPackages.Num());
-                SaveAction->SetBoolField(TEXT("executed"), DirtyPackages.Num() > 0 && bSave);
+                SaveAction->SetNumberField(TEXT("count"), State->DirtyCount);
+                SaveAction->SetBoolField(TEXT("executed"), State->DirtyCount > 0);
                 AuditActions.Add(MakeShared<FJsonValueObject>(SaveAction));
         }
 
         TSharedPtr<FJsonObject> FixedObject = MakeShared<FJsonObject>();
-        FixedObject->SetNumberField(TEXT("redirectors"), FixedRedirectorCount);
-        FixedObject->SetNumberField(TEXT("remapped"), RemappedCount);
-        FixedObject->SetNumberField(TEXT("deletedRedirectors"), DeletedCount);
+        FixedObject->SetNumberField(TEXT("redirectors"), State->FixedPaths.Num());
+        FixedObject->SetNumberField(TEXT("remapped"), State->RemappedCount);
+        FixedObject->SetNumberField(TEXT("deletedRedirectors"), State->DeletedCount);
+
+        TSharedPtr<FJsonObject> PlanObject = MakeShared<FJsonObject>();
+        PlanObject->SetNumberField(TEXT("batches"), Plan.Batches.Num());
+        PlanObject->SetNumberField(TEXT("groups"), Plan.Groups);
+        PlanObject->SetNumberField(TEXT("packagesToTouch"), Plan.PackagesToTouch.Num());
+        PlanObject->SetNumberField(TEXT("planMs"), Plan.PlanSeconds * 1000.0);
 
         TSharedPtr<FJsonObject> Audit = MakeShared<FJsonObject>();
         Audit->SetBoolField(TEXT("dryRun"), FWriteGate::ShouldDryRun());
@@ -940,6 +1679,13 @@ TSharedPtr<FJsonObject> FContentTools::HandleFixMissing(const TSharedPtr<FJsonOb
         TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
         Data->SetBoolField(TEXT("ok"), true);
         Data->SetObjectField(TEXT("fixed"), FixedObject);
+        Data->SetObjectField(TEXT("plan"), PlanObject);
+        Data->SetNumberField(TEXT("batchesApplied"), State->NextBatch);
+        Data->SetNumberField(TEXT("garbageCollections"), State->GarbageCollections);
+        if (State->bCancelled)
+        {
+                Data->SetBoolField(TEXT("cancelled"), true);
+        }
         Data->SetObjectField(TEXT("audit"), Audit);
 
         return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
@@ -947,84 +1693,187 @@ TSharedPtr<FJsonObject> FContentTools::HandleFixMissing(const TSharedPtr<FJsonOb
 
 TSharedPtr<FJsonObject> FContentTools::HandleGenerateThumbnails(const TSharedPtr<FJsonObject>& Params)
 {
-        if (!FWriteGate::IsWriteAllowed())
+        // A long run is split into chunks: each chunk is saved and released before the next, and the
+        // handler suspends to the next frame once GameThreadBudgetMs is used up.
+        UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+        TSharedPtr<FThumbnailResumeState> State = Context ? Context->TakeResumeState<FThumbnailResumeState>() : nullptr;
+        if (!State.IsValid())
         {
-                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Writes are currently disabled"));
-                Error->SetStringField(TEXT("errorCode"), ErrorCodeWriteNotAllowed);
-                return Error;
-        }
+                if (!FWriteGate::IsWriteAllowed())
+                {
+                        TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Writes are currently disabled"));
+                        Error->SetStringField(TEXT("errorCode"), ErrorCodeWriteNotAllowed);
+                        return Error;
+                }
 
-        TArray<FString> Assets;
-        FString ParseError;
-        if (!CollectAssetPaths(Params, Assets, ParseError))
-        {
-                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(ParseError);
-                Error->SetStringField(TEXT("errorCode"), ErrorCodeThumbnailFailed);
-                return Error;
-        }
+                State = MakeShared<FThumbnailResumeState>();
+                FString ParseError;
+                if (!CollectAssetPaths(Params, State->Assets, ParseError))
+                {
+                        TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(ParseError);
+                        Error->SetStringField(TEXT("errorCode"), ErrorCodeThumbnailFailed);
+                        return Error;
+                }
 
-        bool bHiRes = false;
-        bool bSave = true;
-        if (Params.IsValid())
-        {
-                Params->TryGetBoolField(TEXT("hiRes"), bHiRes);
-                Params->TryGetBoolField(TEXT("save"), bSave);
+                if (Params.IsValid())
+                {
+                        Params->TryGetBoolField(TEXT("hiRes"), State->bHiRes);
+                        Params->TryGetBoolField(TEXT("save"), State->bSave);
+                        Params->TryGetBoolField(TEXT("force"), State->bForce);
+                        double ChunkSize = 0.0;
+                        if (Params->TryGetNumberField(TEXT("chunkSize"), ChunkSize))
+                        {
+                                State->ChunkSize = FMath::Clamp(static_cast<int32>(ChunkSize), 1, MaxThumbnailChunkSize);
+                        }
+                        double MemoryCeilingMb = 0.0;
+                        if (Params->TryGetNumberField(TEXT("memoryCeilingMb"), MemoryCeilingMb))
+                        {
+                                State->MemoryCeilingBytes = static_cast<int64>(FMath::Max(MemoryCeilingMb, 0.0) * 1024.0 * 1024.0);
+                        }
+                }
+                State->StartUsedBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+                State->UpToDate.Init(false, State->Assets.Num());
         }
 
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
         UThumbnailManager& ThumbnailManager = UThumbnailManager::Get();
+        const TArray<FString>& Assets = State->Assets;
+        const double SliceStart = FPlatformTime::Seconds();
+        const double SliceBudgetSeconds = FUnrealMCPRuntimeConfig::Get().GameThreadBudgetMs / 1000.0;
 
-        int32 UpdatedCount = 0;
-        TArray<TSharedPtr<FJsonValue>> FailedArray;
-        TArray<TSharedPtr<FJsonValue>> AuditActions;
-        TSet<UPackage*> PackagesToSave;
-
-        for (const FString& AssetPath : Assets)
+        while (State->NextIndex < Assets.Num() && !State->bCancelled)
         {
-                FSoftObjectPath SoftPath(AssetPath);
-                UObject* Asset = SoftPath.TryLoad();
-                if (!Asset)
+                // One chunk at a time; its packages are only held until it has been saved.
+                TSet<UPackage*> PackagesToSave;
+                const int32 ChunkEnd = FMath::Min(State->NextIndex + State->ChunkSize, Assets.Num());
+
+                // This chunk and the next are loading by now; the chunk starts once its own packages are in.
+                TArray<FString> PrefetchPaths;
+                const int32 PrefetchEnd = FMath::Min(ChunkEnd + State->ChunkSize, Assets.Num());
+                for (; State->PrefetchedThrough < PrefetchEnd; ++State->PrefetchedThrough)
                 {
-                        TSharedPtr<FJsonObject> Failure = MakeShared<FJsonObject>();
-                        Failure->SetStringField(TEXT("asset"), AssetPath);
-                        Failure->SetStringField(TEXT("reason"), TEXT("Asset could not be loaded"));
-                        FailedArray.Add(MakeShared<FJsonValueObject>(Failure));
-                        continue;
+                        const FString& AheadPath = Assets[State->PrefetchedThrough];
+                        const bool bUpToDate = !State->bForce && HasSavedThumbnail(AssetRegistry, FSoftObjectPath(AheadPath));
+                        State->UpToDate[State->PrefetchedThrough] = bUpToDate;
+                        if (!bUpToDate)
+                        {
+                                PrefetchPaths.Add(AheadPath);
+                        }
+                }
+                State->Prefetch->Request(PrefetchPaths);
+                if (Context && Context->CanSuspend() && !UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
+                {
+                        for (int32 AssetIndex = State->NextIndex; AssetIndex < ChunkEnd; ++AssetIndex)
+                        {
+                                if (!State->UpToDate[AssetIndex] && !State->Prefetch->IsReady(Assets[AssetIndex]))
+                                {
+                                        Context->Suspend(State.ToSharedRef());
+                                        return nullptr;
+                                }
+                        }
+                }
+
+                for (int32 AssetIndex = State->NextIndex; AssetIndex < ChunkEnd; ++AssetIndex)
+                {
+                        // Thumbnails already regenerated are kept (and saved below); the rest are left alone.
+                        if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
+                        {
+                                State->bCancelled = true;
+                                break;
+                        }
+                        UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(AssetIndex, Assets.Num(), TEXT("thumbnails"));
+                        State->NextIndex = AssetIndex + 1;
+
+                        const FString& AssetPath = Assets[AssetIndex];
+                        FSoftObjectPath SoftPath(AssetPath);
+                        if (State->UpToDate[AssetIndex])
+                        {
+                                TSharedPtr<FJsonObject> Skipped = MakeShared<FJsonObject>();
+                                Skipped->SetStringField(TEXT("asset"), AssetPath);
+                                Skipped->SetStringField(TEXT("reason"), TEXT("upToDate"));
+                                State->SkippedArray.Add(MakeShared<FJsonValueObject>(Skipped));
+                                continue;
+                        }
+
+                        UObject* Asset = SoftPath.TryLoad();
+                        if (!Asset)
+                        {
+                                TSharedPtr<FJsonObject> Failure = MakeShared<FJsonObject>();
+                                Failure->SetStringField(TEXT("asset"), AssetPath);
+                                Failure->SetStringField(TEXT("reason"), TEXT("Asset could not be loaded"));
+                                State->FailedArray.Add(MakeShared<FJsonValueObject>(Failure));
+                                continue;
+                        }
+
+                        ThumbnailManager.GenerateThumbnailForObject(Asset);
+                        if (UPackage* Package = Asset->GetOutermost())
+                        {
+                                PackagesToSave.Add(Package);
+                        }
+                        Asset->MarkPackageDirty();
+                        ++State->UpdatedCount;
+
+                        TSharedPtr<FJsonObject> Action = MakeShared<FJsonObject>();
+                        Action->SetStringField(TEXT("op"), TEXT("regen_thumbnail"));
+                        Action->SetStringField(TEXT("asset"), AssetPath);
+                        Action->SetBoolField(TEXT("hiRes"), State->bHiRes);
+                        State->AuditActions.Add(MakeShared<FJsonValueObject>(Action));
                 }
 
-                ThumbnailManager.GenerateThumbnailForObject(Asset);
-                if (UPackage* Package = Asset->GetOutermost())
+                if (State->bSave && PackagesToSave.Num() > 0)
                 {
-                        PackagesToSave.Add(Package);
+                        TArray<UPackage*> Packages = PackagesToSave.Array();
+                        if (!UEditorLoadingAndSavingUtils::SavePackages(Packages, /*bOnlyDirty*/ false))
+                        {
+                                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to save packages"));
+                                Error->SetStringField(TEXT("errorCode"), ErrorCodeSaveFailed);
+                                Error->SetNumberField(TEXT("updated"), State->UpdatedCount);
+                                return Error;
+                        }
                 }
-                Asset->MarkPackageDirty();
-                ++UpdatedCount;
+                PackagesToSave.Reset();
+                ++State->ChunkCount;
 
-                TSharedPtr<FJsonObject> Action = MakeShared<FJsonObject>();
-                Action->SetStringField(TEXT("op"), TEXT("regen_thumbnail"));
-                Action->SetStringField(TEXT("asset"), AssetPath);
-                Action->SetBoolField(TEXT("hiRes"), bHiRes);
-                AuditActions.Add(MakeShared<FJsonValueObject>(Action));
-        }
+                // Saved chunks hold nothing we need, so their objects can go once memory grows past the
+                // ceiling. Unsaved thumbnails live only in their dirty packages, so without save they stay.
+                const int64 UsedBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+                if (State->bSave && State->MemoryCeilingBytes > 0 && UsedBytes - State->StartUsedBytes > State->MemoryCeilingBytes)
+                {
+                        if (FMemoryPolicy::Collect(TEXT("chunk"), false, true))
+                        {
+                                ++State->GarbageCollections;
+                        }
+                }
 
-        if (bSave && PackagesToSave.Num() > 0)
-        {
-                TArray<UPackage*> Packages = PackagesToSave.Array();
-                if (!UEditorLoadingAndSavingUtils::SavePackages(Packages, /*bOnlyDirty*/ false))
+                if (State->NextIndex < Assets.Num() && !State->bCancelled && Context && Context->CanSuspend()
+                    && FPlatformTime::Seconds() - SliceStart >= SliceBudgetSeconds)
                 {
-                        TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to save packages"));
-                        Error->SetStringField(TEXT("errorCode"), ErrorCodeSaveFailed);
-                        return Error;
+                        Context->Suspend(State.ToSharedRef());
+                        return nullptr;
                 }
         }
 
+        if (!State->bCancelled)
+        {
+                UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(Assets.Num(), Assets.Num(), TEXT("thumbnails"));
+        }
+
         TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
         Data->SetBoolField(TEXT("ok"), true);
-        Data->SetNumberField(TEXT("updated"), UpdatedCount);
-        Data->SetArrayField(TEXT("failed"), FailedArray);
+        Data->SetNumberField(TEXT("updated"), State->UpdatedCount);
+        Data->SetArrayField(TEXT("failed"), State->FailedArray);
+        Data->SetArrayField(TEXT("skipped"), State->SkippedArray);
+        Data->SetNumberField(TEXT("chunks"), State->ChunkCount);
+        Data->SetNumberField(TEXT("garbageCollections"), State->GarbageCollections);
+        Data->SetObjectField(TEXT("prefetch"), State->Prefetch->ToJson());
+        if (State->bCancelled)
+        {
+                Data->SetBoolField(TEXT("cancelled"), true);
+        }
 
         TSharedPtr<FJsonObject> Audit = MakeShared<FJsonObject>();
         Audit->SetBoolField(TEXT("dryRun"), FWriteGate::ShouldDryRun());
-        Audit->SetArrayField(TEXT("actions"), AuditActions);
+        Audit->SetArrayField(TEXT("actions"), State->AuditActions);
         Data->SetObjectField(TEXT("audit"), Audit);
 
         return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
@@ -1,6 +1,8 @@
 #include "EditorNav/EditorNavTools.h"
 #include "CoreMinimal.h"
 
+#include "Actors/ActorIndex.h"
+#include "Actors/ActorSpatialIndex.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
@@ -135,18 +137,7 @@ namespace
                         return Existing;
                 }
 
-                if (UWorld* World = GetEditorWorld())
-                {
-                        for (TActorIterator<AActor> It(World); It; ++It)
-                        {
-                                if (It->GetPathName() == Trimmed || It->GetName() == Trimmed)
-                                {
-                                        return *It;
-                                }
-                        }
-                }
-
-                return nullptr;
+                return FActorIndex::Get().Resolve(GetEditorWorld(), Trimmed);
         }
 
         void CollectAttachedActors(AActor& Actor, TSet<AActor*>& OutActors)
@@ -324,6 +315,8 @@ TSharedPtr<FJsonObject> FEditorNavTools::LevelSelect(const TSharedPtr<FJsonObjec
         TOptional<FString> NameContains;
         TArray<FString> ClassNames;
         TArray<FName> Tags;
+        TOptional<FBox> BoundsFilter;
+        TOptional<FSphere> SphereFilter;
 
         if (FiltersObject && FiltersObject->IsValid())
         {
@@ -387,6 +380,39 @@ TSharedPtr<FJsonObject> FEditorNavTools::LevelSelect(const TSharedPtr<FJsonObjec
                                 }
                         }
                 }
+
+                const TSharedPtr<FJsonObject>* BoundsObject = nullptr;
+                if ((*FiltersObject)->TryGetObjectField(TEXT("bounds"), BoundsObject) && BoundsObject->IsValid())
+                {
+                        const TArray<TSharedPtr<FJsonValue>>* MinArray = nullptr;
+                        const TArray<TSharedPtr<FJsonValue>>* MaxArray = nullptr;
+                        FVector Min;
+                        FVector Max;
+                        if (!(*BoundsObject)->TryGetArrayField(TEXT("min"), MinArray) || !ParseVector(*MinArray, Min)
+                                || !(*BoundsObject)->TryGetArrayField(TEXT("max"), MaxArray) || !ParseVector(*MaxArray, Max))
+                        {
+                                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("filters.bounds needs min and max arrays of three numbers"));
+                                Error->SetStringField(TEXT("errorCode"), TEXT("LEVEL_SELECT_INVALID_PARAMS"));
+                                return Error;
+                        }
+                        BoundsFilter = FBox(Min.ComponentMin(Max), Min.ComponentMax(Max));
+                }
+
+                const TSharedPtr<FJsonObject>* SphereObject = nullptr;
+                if ((*FiltersObject)->TryGetObjectField(TEXT("sphere"), SphereObject) && SphereObject->IsValid())
+                {
+                        const TArray<TSharedPtr<FJsonValue>>* CenterArray = nullptr;
+                        FVector Center;
+                        double Radius = 0.0;
+                        if (!(*SphereObject)->TryGetArrayField(TEXT("center"), CenterArray) || !ParseVector(*CenterArray, Center)
+                                || !(*SphereObject)->TryGetNumberField(TEXT("radius"), Radius) || Radius <= 0.0)
+                        {
+                                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("filters.sphere needs a center array of three numbers and a positive radius"));
+                                Error->SetStringField(TEXT("errorCode"), TEXT("LEVEL_SELECT_INVALID_PARAMS"));
+                                return Error;
+                        }
+                        SphereFilter = FSphere(Center, Radius);
+                }
         }
 
         FString ModeString = TEXT("replace");
@@ -475,12 +501,43 @@ TSharedPtr<FJsonObject> FEditorNavTools::LevelSelect(const TSharedPtr<FJsonObjec
                 return true;
         };
 
+        // Spatial filters narrow the candidates through the grid instead of testing every actor.
+        TArray<AActor*> Candidates;
+        if (BoundsFilter.IsSet() || SphereFilter.IsSet())
+        {
+                if (BoundsFilter.IsSet())
+                {
+                        FActorSpatialIndex::Get().QueryBox(World, BoundsFilter.GetValue(), Candidates);
+                }
+                if (SphereFilter.IsSet())
+                {
+                        TArray<AActor*> InSphere;
+                        FActorSpatialIndex::Get().QuerySphere(World, SphereFilter->Center, SphereFilter->W, InSphere);
+                        if (BoundsFilter.IsSet())
+                        {
+                                const TSet<AActor*> SphereSet(InSphere);
+                                Candidates.RemoveAll([&SphereSet](AActor* Actor) { return !SphereSet.Contains(Actor); });
+                        }
+                        else
+                        {
+                                Candidates = MoveTemp(InSphere);
+                        }
+                }
+        }
+        else
+        {
+                for (TActorIterator<AActor> It(World); It; ++It)
+                {
+                        Candidates.Add(*It);
+                }
+        }
+
         TArray<AActor*> MatchedActors;
-        for (TActorIterator<AActor> It(World); It; ++It)
+        for (AActor* Actor : Candidates)
         {
-                if (MatchesFilters(*It))
+                if (MatchesFilters(Actor))
                 {
-                        MatchedActors.Add(*It);
+                        MatchedActors.Add(Actor);
                 }
         }
 
@@ -0,0 +1,333 @@
+#include "EditorNav/ViewportCapture.h"
+#include "CoreMinimal.h"
+
+#include "Async/Async.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Misc/FileHelper.h"
+#include "Modules/ModuleManager.h"
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+#include "RHIGPUReadback.h"
+#include "UnrealClient.h"
+
+namespace
+{
+        /** Target size fitting Width x Height into MaxWidth x MaxHeight with the aspect ratio kept; never upscales. */
+        FIntPoint FitSize(int32 Width, int32 Height, int32 MaxWidth, int32 MaxHeight)
+        {
+                double Scale = 1.0;
+                if (MaxWidth > 0 && Width > MaxWidth)
+                {
+                        Scale = FMath::Min(Scale, static_cast<double>(MaxWidth) / Width);
+                }
+                if (MaxHeight > 0 && Height > MaxHeight)
+                {
+                        Scale = FMath::Min(Scale, static_cast<double>(MaxHeight) / Height);
+                }
+                return FIntPoint(FMath::Max(1, FMath::RoundToInt(Width * Scale)), FMath::Max(1, FMath::RoundToInt(Height * Scale)));
+        }
+
+        /** Box-filter downscale; each target texel averages the source texels it covers. */
+        void Downscale(const TArray<FColor>& Source, int32 Width, int32 Height, int32 TargetWidth, int32 TargetHeight, TArray<FColor>& OutPixels)
+        {
+                OutPixels.SetNumUninitialized(TargetWidth * TargetHeight);
+                for (int32 Y = 0; Y < TargetHeight; ++Y)
+                {
+                        const int32 Y0 = static_cast<int32>(static_cast<int64>(Y) * Height / TargetHeight);
+                        const int32 Y1 = FMath::Max(Y0 + 1, static_cast<int32>(static_cast<int64>(Y + 1) * Height / TargetHeight));
+                        for (int32 X = 0; X < TargetWidth; ++X)
+                        {
+                                const int32 X0 = static_cast<int32>(static_cast<int64>(X) * Width / TargetWidth);
+                                const int32 X1 = FMath::Max(X0 + 1, static_cast<int32>(static_cast<int64>(X + 1) * Width / TargetWidth));
+                                uint32 Sum[4] = { 0, 0, 0, 0 };
+                                for (int32 SY = Y0; SY < Y1; ++SY)
+                                {
+                                        const FColor* Row = Source.GetData() + SY * Width;
+                                        for (int32 SX = X0; SX < X1; ++SX)
+                                        {
+                                                Sum[0] += Row[SX].B;
+                                                Sum[1] += Row[SX].G;
+                                                Sum[2] += Row[SX].R;
+                                                Sum[3] += Row[SX].A;
+                                        }
+                                }
+                                const uint32 Count = (Y1 - Y0) * (X1 - X0);
+                                FColor& Out = OutPixels[Y * TargetWidth + X];
+                                Out.B = static_cast<uint8>(Sum[0] / Count);
+                                Out.G = static_cast<uint8>(Sum[1] / Count);
+                                Out.R = static_cast<uint8>(Sum[2] / Count);
+                                Out.A = static_cast<uint8>(Sum[3] / Count);
+                        }
+                }
+        }
+
+        EImageFormat ToImageFormat(FViewportCapture::EFormat Format)
+        {
+                switch (Format)
+                {
+                case FViewportCapture::EFormat::Jpeg:
+                        return EImageFormat::JPEG;
+                case FViewportCapture::EFormat::Bmp:
+                        return EImageFormat::BMP;
+                default:
+                        return EImageFormat::PNG;
+                }
+        }
+}
+
+bool FViewportCapture::ParseFormat(const FString& Name, EFormat& OutFormat)
+{
+        if (Name.IsEmpty() || Name.Equals(TEXT("png"), ESearchCase::IgnoreCase))
+        {
+                OutFormat = EFormat::Png;
+                return true;
+        }
+        if (Name.Equals(TEXT("jpeg"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("jpg"), ESearchCase::IgnoreCase))
+        {
+                OutFormat = EFormat::Jpeg;
+                return true;
+        }
+        if (Name.Equals(TEXT("bmp"), ESearchCase::IgnoreCase))
+        {
+                OutFormat = EFormat::Bmp;
+                return true;
+        }
+        return false;
+}
+
+const TCHAR* FViewportCapture::GetMimeType(EFormat Format)
+{
+        switch (Format)
+        {
+        case EFormat::Jpeg:
+                return TEXT("image/jpeg");
+        case EFormat::Bmp:
+                return TEXT("image/bmp");
+        default:
+                return TEXT("image/png");
+        }
+}
+
+const TCHAR* FViewportCapture::GetExtension(EFormat Format)
+{
+        switch (Format)
+        {
+        case EFormat::Jpeg:
+                return TEXT(".jpg");
+        case EFormat::Bmp:
+                return TEXT(".bmp");
+        default:
+                return TEXT(".png");
+        }
+}
+
+TSharedPtr<FViewportCapture, ESPMode::ThreadSafe> FViewportCapture::Begin(FViewport& Viewport, const FOptions& Options)
+{
+        check(IsInGameThread());
+
+        const FTextureRHIRef Texture = Viewport.GetRenderTargetTexture();
+        if (!Texture.IsValid())
+        {
+                return nullptr;
+        }
+
+        const EPixelFormat Format = Texture->GetFormat();
+        if (Format != PF_B8G8R8A8 && Format != PF_R8G8B8A8 && Format != PF_A2B10G10R10 && Format != PF_FloatRGBA)
+        {
+                return nullptr;
+        }
+
+        const FIntPoint TextureSize = Texture->GetSizeXY();
+        const FIntPoint ViewportSize = Viewport.GetSizeXY();
+        FIntRect Region(0, 0, FMath::Min(TextureSize.X, ViewportSize.X), FMath::Min(TextureSize.Y, ViewportSize.Y));
+        if (!Options.Crop.IsEmpty())
+        {
+                Region.Clip(Options.Crop);
+        }
+        if (Region.IsEmpty())
+        {
+                return nullptr;
+        }
+
+        // The image wrapper module must be loaded here; workers only create wrappers from it.
+        FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+        TSharedPtr<FViewportCapture, ESPMode::ThreadSafe> Capture = MakeShared<FViewportCapture, ESPMode::ThreadSafe>();
+        Capture->Options = Options;
+        Capture->Result.bAsync = true;
+        Capture->SourceFormat = Format;
+        Capture->Region = Region;
+        Capture->Readback = MakeShared<FRHIGPUTextureReadback, ESPMode::ThreadSafe>(TEXT("MCPViewportCapture"));
+
+        ENQUEUE_RENDER_COMMAND(MCPViewportCaptureCopy)([Capture, Texture](FRHICommandListImmediate& RHICmdList)
+        {
+                const FIntRect& CopyRegion = Capture->Region;
+                Capture->Readback->EnqueueCopy(RHICmdList, Texture, FIntVector(CopyRegion.Min.X, CopyRegion.Min.Y, 0), 0, FIntVector(CopyRegion.Width(), CopyRegion.Height(), 1));
+                Capture->Stage = EStage::InFlight;
+        });
+        return Capture;
+}
+
+void FViewportCapture::CaptureNow(FViewport& Viewport, const FOptions& Options, FResult& OutResult)
+{
+        check(IsInGameThread());
+
+        const FIntPoint ViewportSize = Viewport.GetSizeXY();
+        FIntRect Region(0, 0, ViewportSize.X, ViewportSize.Y);
+        if (!Options.Crop.IsEmpty())
+        {
+                Region.Clip(Options.Crop);
+        }
+        if (Region.IsEmpty())
+        {
+                OutResult.Error = TEXT("Crop region lies outside the viewport");
+                return;
+        }
+
+        TArray<FColor> Pixels;
+        if (!Viewport.ReadPixels(Pixels, FReadSurfaceDataFlags(), Region))
+        {
+                OutResult.Error = TEXT("Failed to read viewport pixels");
+                return;
+        }
+
+        FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+        EncodeFrame(Pixels, Region.Width(), Region.Height(), Options, OutResult);
+}
+
+void FViewportCapture::Poll()
+{
+        check(IsInGameThread());
+        if (Stage.load() != EStage::InFlight || !Readback->IsReady())
+        {
+                return;
+        }
+
+        // Mapping happens on the render thread; the fence has passed, so the lock does not wait.
+        Stage = EStage::Mapping;
+        TSharedPtr<FViewportCapture, ESPMode::ThreadSafe> Self = AsShared();
+        ENQUEUE_RENDER_COMMAND(MCPViewportCaptureMap)([Self](FRHICommandListImmediate&)
+        {
+                const int32 Width = Self->Region.Width();
+                const int32 Height = Self->Region.Height();
+                const int32 BytesPerTexel = GPixelFormats[Self->SourceFormat].BlockBytes;
+
+                int32 RowPitchInTexels = 0;
+                const uint8* Mapped = static_cast<const uint8*>(Self->Readback->Lock(RowPitchInTexels));
+                if (!Mapped)
+                {
+                        Self->Fail(TEXT("GPU readback could not be mapped"));
+                        return;
+                }
+
+                TArray<uint8> Bytes;
+                Bytes.SetNumUninitialized(Width * Height * BytesPerTexel);
+                for (int32 Row = 0; Row < Height; ++Row)
+                {
+                        FMemory::Memcpy(Bytes.GetData() + Row * Width * BytesPerTexel, Mapped + static_cast<int64>(Row) * RowPitchInTexels * BytesPerTexel, Width * BytesPerTexel);
+                }
+                Self->Readback->Unlock();
+                Self->Readback.Reset();
+
+                Self->Stage = EStage::Encoding;
+                AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Self, Bytes = MoveTemp(Bytes), Width, Height]()
+                {
+                        TArray<FColor> Pixels;
+                        if (!ConvertToColors(Bytes, Self->SourceFormat, Width, Height, Pixels))
+                        {
+                                Self->Fail(TEXT("Unsupported viewport pixel format"));
+                                return;
+                        }
+                        EncodeFrame(Pixels, Width, Height, Self->Options, Self->Result);
+                        Self->Stage = EStage::Done;
+                });
+        });
+}
+
+bool FViewportCapture::ConvertToColors(const TArray<uint8>& Bytes, EPixelFormat SourceFormat, int32 Width, int32 Height, TArray<FColor>& OutPixels)
+{
+        const int32 Count = Width * Height;
+        OutPixels.SetNumUninitialized(Count);
+        switch (SourceFormat)
+        {
+        case PF_B8G8R8A8:
+                FMemory::Memcpy(OutPixels.GetData(), Bytes.GetData(), Count * sizeof(FColor));
+                return true;
+        case PF_R8G8B8A8:
+                for (int32 Index = 0; Index < Count; ++Index)
+                {
+                        const uint8* Texel = Bytes.GetData() + Index * 4;
+                        OutPixels[Index] = FColor(Texel[0], Texel[1], Texel[2], Texel[3]);
+                }
+                return true;
+        case PF_A2B10G10R10:
+                for (int32 Index = 0; Index < Count; ++Index)
+                {
+                        uint32 Texel = 0;
+                        FMemory::Memcpy(&Texel, Bytes.GetData() + Index * 4, 4);
+                        OutPixels[Index] = FColor(static_cast<uint8>((Texel >> 2) & 0xFF), static_cast<uint8>((Texel >> 12) & 0xFF), static_cast<uint8>((Texel >> 22) & 0xFF), static_cast<uint8>(((Texel >> 30) & 0x3) * 85));
+                }
+                return true;
+        case PF_FloatRGBA:
+                for (int32 Index = 0; Index < Count; ++Index)
+                {
+                        FFloat16Color Texel;
+                        FMemory::Memcpy(&Texel, Bytes.GetData() + Index * sizeof(FFloat16Color), sizeof(FFloat16Color));
+                        OutPixels[Index] = FLinearColor(Texel).ToFColor(/*bSRGB*/ false);
+                }
+                return true;
+        default:
+                return false;
+        }
+}
+
+void FViewportCapture::EncodeFrame(TArray<FColor>& Pixels, int32 Width, int32 Height, const FOptions& Options, FResult& OutResult)
+{
+        // Viewport alpha is scene coverage, not transparency; an opaque image is what agents look at.
+        for (FColor& Pixel : Pixels)
+        {
+                Pixel.A = 255;
+        }
+
+        OutResult.SourceWidth = Width;
+        OutResult.SourceHeight = Height;
+        const FIntPoint Target = FitSize(Width, Height, Options.MaxWidth, Options.MaxHeight);
+        if (Target.X != Width || Target.Y != Height)
+        {
+                TArray<FColor> Scaled;
+                Downscale(Pixels, Width, Height, Target.X, Target.Y, Scaled);
+                Pixels = MoveTemp(Scaled);
+                Width = Target.X;
+                Height = Target.Y;
+        }
+
+        IImageWrapperModule& ImageWrapperModule = FModuleManager::GetModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+        TSharedPtr<IImageWrapper> Wrapper = ImageWrapperModule.CreateImageWrapper(ToImageFormat(Options.Format));
+        if (!Wrapper.IsValid() || !Wrapper->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor), Width, Height, ERGBFormat::BGRA, 8))
+        {
+                OutResult.Error = TEXT("Failed to encode image");
+                return;
+        }
+
+        const int32 Quality = Options.Format == EFormat::Jpeg ? FMath::Clamp(Options.Quality, 1, 100) : 0;
+        const TArray64<uint8>& Compressed = Wrapper->GetCompressed(Quality);
+        OutResult.Encoded.Append(Compressed.GetData(), static_cast<int32>(Compressed.Num()));
+        OutResult.Width = Width;
+        OutResult.Height = Height;
+
+        if (!Options.FilePath.IsEmpty() && !FFileHelper::SaveArrayToFile(OutResult.Encoded, *Options.FilePath))
+        {
+                OutResult.Error = FString::Printf(TEXT("Failed to write %s"), *Options.FilePath);
+                return;
+        }
+        OutResult.bOk = true;
+}
+
+void FViewportCapture::Fail(const FString& Error)
+{
+        Result.Error = Error;
+        Result.bOk = false;
+        Readback.Reset();
+        Stage = EStage::Done;
+}
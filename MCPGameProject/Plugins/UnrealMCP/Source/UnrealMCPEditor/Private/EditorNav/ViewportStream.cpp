@@ -0,0 +1,398 @@
+#include "EditorNav/ViewportStream.h"
+#include "CoreMinimal.h"
+
+#include "Async/Async.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "EditorNav/ViewportCapture.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Base64.h"
+#include "Misc/Guid.h"
+#include "Misc/ScopeLock.h"
+#include "Observability/JsonLogger.h"
+#include "Protocol/Attachments.h"
+#include "Protocol/CommandContext.h"
+#include "UnrealClient.h"
+#include "UnrealMCPLog.h"
+
+#include <atomic>
+
+namespace
+{
+        using UnrealMCP::Protocol::FCommandContext;
+
+        constexpr int32 MaxStreams = 4;
+        /** One frame being read back while the previous one encodes; more only adds latency. */
+        constexpr int32 MaxFramesInFlight = 2;
+        constexpr int32 DefaultFps = 15;
+        constexpr int32 MaxFps = 60;
+        constexpr int32 DefaultMaxWidth = 1280;
+        constexpr int32 DefaultMaxHeight = 720;
+        constexpr int32 DefaultQuality = 75;
+
+        /** What the workers that send a stream's frames share with the game thread. */
+        struct FDelivery
+        {
+                FCriticalSection Mutex;
+                /** Frames finish encoding in any order; one older than the last sent is dropped. */
+                int64 LastSentSequence = -1;
+                std::atomic<int64> Stale{0};
+                std::atomic<bool> bSessionGone{false};
+        };
+
+        struct FInFlightFrame
+        {
+                TSharedPtr<FViewportCapture, ESPMode::ThreadSafe> Capture;
+                int64 Sequence = 0;
+                double StartedSeconds = 0.0;
+                double StartedUnixMs = 0.0;
+        };
+
+        struct FStream
+        {
+                FString StreamId;
+                FString SessionId;
+                FCommandContext::FFrameSink Sink;
+                bool bAttachments = false;
+                FString Codec;
+                FViewportCapture::FOptions Options;
+                int32 Fps = DefaultFps;
+                double IntervalSeconds = 0.0;
+                double NextDueSeconds = 0.0;
+                double StartedSeconds = 0.0;
+                int64 NextSequence = 0;
+                TArray<FInFlightFrame> InFlight;
+                TSharedRef<FDelivery, ESPMode::ThreadSafe> Delivery = MakeShared<FDelivery, ESPMode::ThreadSafe>();
+
+                int64 FramesSent = 0;
+                /** Came due while MaxFramesInFlight were busy, or while the viewport had nothing to copy. */
+                int64 FramesSkipped = 0;
+                int64 FramesFailed = 0;
+                double LatencySecondsSum = 0.0;
+                double GameThreadSeconds = 0.0;
+        };
+
+        /** Game thread only. */
+        TMap<FString, FStream> GStreams;
+        FTSTicker::FDelegateHandle GTickerHandle;
+
+        TSharedPtr<FJsonObject> MakeError(const TCHAR* Code, const FString& Message)
+        {
+                TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(Message);
+                Error->SetStringField(TEXT("errorCode"), Code);
+                return Error;
+        }
+
+        TSharedPtr<FViewportCapture, ESPMode::ThreadSafe> BeginFrame(FStream& Stream, double Now)
+        {
+                FViewport* Viewport = GEditor ? GEditor->GetActiveViewport() : nullptr;
+                TSharedPtr<FViewportCapture, ESPMode::ThreadSafe> Capture = Viewport ? FViewportCapture::Begin(*Viewport, Stream.Options) : nullptr;
+                if (Capture.IsValid())
+                {
+                        FInFlightFrame& Frame = Stream.InFlight.AddDefaulted_GetRef();
+                        Frame.Capture = Capture;
+                        Frame.Sequence = Stream.NextSequence++;
+                        Frame.StartedSeconds = Now;
+                        Frame.StartedUnixMs = FJsonLogger::NowUnixMs();
+                }
+                return Capture;
+        }
+
+        /** Builds the frame and hands it to the session on a worker; base64 and encoding stay off the game thread. */
+        void SendFrame(const FStream& Stream, const FInFlightFrame& Frame, double LatencySeconds)
+        {
+                AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Capture = Frame.Capture, Sink = Stream.Sink, Delivery = Stream.Delivery, StreamId = Stream.StreamId,
+                        Codec = Stream.Codec, Format = Stream.Options.Format, bAttachments = Stream.bAttachments, Sequence = Frame.Sequence, StartedUnixMs = Frame.StartedUnixMs, LatencySeconds]()
+                {
+                        const FViewportCapture::FResult& Result = Capture->GetResult();
+
+                        TSharedRef<FJsonObject> Message = MakeShared<FJsonObject>();
+                        Message->SetStringField(TEXT("type"), TEXT("viewport_frame"));
+                        Message->SetStringField(TEXT("streamId"), StreamId);
+                        Message->SetNumberField(TEXT("seq"), static_cast<double>(Sequence));
+                        Message->SetNumberField(TEXT("tsMs"), StartedUnixMs);
+                        Message->SetNumberField(TEXT("latencyMs"), LatencySeconds * 1000.0);
+                        Message->SetNumberField(TEXT("width"), Result.Width);
+                        Message->SetNumberField(TEXT("height"), Result.Height);
+                        Message->SetNumberField(TEXT("sourceWidth"), Result.SourceWidth);
+                        Message->SetNumberField(TEXT("sourceHeight"), Result.SourceHeight);
+                        Message->SetStringField(TEXT("codec"), Codec);
+                        Message->SetStringField(TEXT("mimeType"), FViewportCapture::GetMimeType(Format));
+                        Message->SetNumberField(TEXT("bytes"), Result.Encoded.Num());
+                        if (bAttachments)
+                        {
+                                TSharedRef<UnrealMCP::Protocol::FAttachmentList, ESPMode::ThreadSafe> Attachments = MakeShared<UnrealMCP::Protocol::FAttachmentList, ESPMode::ThreadSafe>();
+                                Attachments->Add(Result.Encoded);
+                                Message->SetObjectField(TEXT("data"), UnrealMCP::Protocol::FAttachments::MakeReference(0, Result.Encoded.Num()));
+                                UnrealMCP::Protocol::FAttachments::Bind(Message, Attachments);
+                        }
+                        else
+                        {
+                                Message->SetStringField(TEXT("data"), FBase64::Encode(Result.Encoded));
+                        }
+
+                        FScopeLock Lock(&Delivery->Mutex);
+                        if (Sequence < Delivery->LastSentSequence)
+                        {
+                                ++Delivery->Stale;
+                                return;
+                        }
+                        Delivery->LastSentSequence = Sequence;
+                        if (!Sink(Message))
+                        {
+                                Delivery->bSessionGone = true;
+                        }
+                });
+        }
+
+        /** Delivers finished frames in order and starts the next one when it is due (game thread). */
+        void TickStream(FStream& Stream, double Now)
+        {
+                for (FInFlightFrame& Frame : Stream.InFlight)
+                {
+                        Frame.Capture->Poll();
+                }
+                while (Stream.InFlight.Num() > 0 && Stream.InFlight[0].Capture->IsDone())
+                {
+                        const FInFlightFrame& Frame = Stream.InFlight[0];
+                        if (Frame.Capture->GetResult().bOk)
+                        {
+                                const double LatencySeconds = Now - Frame.StartedSeconds;
+                                Stream.LatencySecondsSum += LatencySeconds;
+                                ++Stream.FramesSent;
+                                SendFrame(Stream, Frame, LatencySeconds);
+                        }
+                        else
+                        {
+                                ++Stream.FramesFailed;
+                                UE_LOG(LogUnrealMCP, Verbose, TEXT("Viewport stream %s: frame %lld failed: %s"), *Stream.StreamId, Frame.Sequence, *Frame.Capture->GetResult().Error);
+                        }
+                        Stream.InFlight.RemoveAt(0);
+                }
+
+                if (Now < Stream.NextDueSeconds)
+                {
+                        return;
+                }
+                // A hitch is not made up with a burst of frames.
+                Stream.NextDueSeconds += Stream.IntervalSeconds;
+                if (Stream.NextDueSeconds < Now)
+                {
+                        Stream.NextDueSeconds = Now + Stream.IntervalSeconds;
+                }
+                if (Stream.InFlight.Num() >= MaxFramesInFlight || !BeginFrame(Stream, Now).IsValid())
+                {
+                        ++Stream.FramesSkipped;
+                }
+        }
+
+        bool Tick(float DeltaTime)
+        {
+                for (auto It = GStreams.CreateIterator(); It; ++It)
+                {
+                        FStream& Stream = It.Value();
+                        if (Stream.Delivery->bSessionGone)
+                        {
+                                UE_LOG(LogUnrealMCP, Display, TEXT("Viewport stream %s: session %s is gone, stopping"), *Stream.StreamId, *Stream.SessionId);
+                                It.RemoveCurrent();
+                                continue;
+                        }
+                        const double TickStart = FPlatformTime::Seconds();
+                        TickStream(Stream, TickStart);
+                        Stream.GameThreadSeconds += FPlatformTime::Seconds() - TickStart;
+                }
+
+                if (GStreams.Num() == 0)
+                {
+                        GTickerHandle.Reset();
+                        return false;
+                }
+                return true;
+        }
+
+        TSharedPtr<FJsonObject> MakeStats(const FStream& Stream)
+        {
+                const double Elapsed = FMath::Max(FPlatformTime::Seconds() - Stream.StartedSeconds, 0.0);
+                TSharedPtr<FJsonObject> Stats = MakeShared<FJsonObject>();
+                Stats->SetStringField(TEXT("streamId"), Stream.StreamId);
+                Stats->SetNumberField(TEXT("frames"), static_cast<double>(Stream.FramesSent - Stream.Delivery->Stale.load()));
+                Stats->SetNumberField(TEXT("skipped"), static_cast<double>(Stream.FramesSkipped));
+                Stats->SetNumberField(TEXT("failed"), static_cast<double>(Stream.FramesFailed));
+                Stats->SetNumberField(TEXT("stale"), static_cast<double>(Stream.Delivery->Stale.load()));
+                Stats->SetNumberField(TEXT("durationSec"), Elapsed);
+                Stats->SetNumberField(TEXT("fps"), Elapsed > 0.0 ? Stream.FramesSent / Elapsed : 0.0);
+                Stats->SetNumberField(TEXT("avgLatencyMs"), Stream.FramesSent > 0 ? Stream.LatencySecondsSum * 1000.0 / Stream.FramesSent : 0.0);
+                Stats->SetNumberField(TEXT("gameThreadMs"), Stream.GameThreadSeconds * 1000.0);
+                return Stats;
+        }
+
+        /** The session's stream id, or empty. */
+        FString FindSessionStream(const FString& SessionId)
+        {
+                for (const TPair<FString, FStream>& Pair : GStreams)
+                {
+                        if (Pair.Value.SessionId == SessionId)
+                        {
+                                return Pair.Key;
+                        }
+                }
+                return FString();
+        }
+}
+
+TSharedPtr<FJsonObject> FViewportStream::StreamStart(const TSharedPtr<FJsonObject>& Params)
+{
+        check(IsInGameThread());
+
+        FCommandContext* Context = FCommandContext::GetActive();
+        if (!Context || !Context->GetPushSink())
+        {
+                return MakeError(TEXT("VIEWPORT_STREAM_UNAVAILABLE"), TEXT("viewport.stream_start needs a client connection to push frames to"));
+        }
+
+        FStream Stream;
+        Stream.SessionId = Context->GetSessionId();
+        Stream.Sink = Context->GetPushSink();
+        Stream.bAttachments = Context->CanAttachToPush();
+        Stream.Options.MaxWidth = DefaultMaxWidth;
+        Stream.Options.MaxHeight = DefaultMaxHeight;
+        Stream.Options.Quality = DefaultQuality;
+
+        FString Codec;
+        if (Params.IsValid())
+        {
+                Params->TryGetStringField(TEXT("codec"), Codec);
+        }
+        if (Codec.IsEmpty() || Codec.Equals(TEXT("mjpeg"), ESearchCase::IgnoreCase) || Codec.Equals(TEXT("jpeg"), ESearchCase::IgnoreCase))
+        {
+                Stream.Codec = TEXT("mjpeg");
+                Stream.Options.Format = FViewportCapture::EFormat::Jpeg;
+        }
+        else if (Codec.Equals(TEXT("png"), ESearchCase::IgnoreCase))
+        {
+                Stream.Codec = TEXT("png");
+                Stream.Options.Format = FViewportCapture::EFormat::Png;
+        }
+        else if (Codec.Equals(TEXT("h264"), ESearchCase::IgnoreCase) || Codec.Equals(TEXT("hevc"), ESearchCase::IgnoreCase) || Codec.Equals(TEXT("h265"), ESearchCase::IgnoreCase))
+        {
+                // Hardware video encoders need AVCodecs and a per-client decoder; every frame here stands alone.
+                return MakeError(TEXT("VIEWPORT_STREAM_INVALID_PARAMS"), FString::Printf(TEXT("Codec '%s' is not available; use mjpeg or png"), *Codec));
+        }
+        else
+        {
+                return MakeError(TEXT("VIEWPORT_STREAM_INVALID_PARAMS"), FString::Printf(TEXT("Unsupported codec '%s' (mjpeg or png)"), *Codec));
+        }
+
+        double Number = 0.0;
+        if (Params.IsValid() && Params->TryGetNumberField(TEXT("fps"), Number))
+        {
+                Stream.Fps = FMath::Clamp(FMath::RoundToInt(Number), 1, MaxFps);
+        }
+        if (Params.IsValid() && Params->TryGetNumberField(TEXT("quality"), Number))
+        {
+                Stream.Options.Quality = FMath::Clamp(static_cast<int32>(Number), 1, 100);
+        }
+        const TArray<TSharedPtr<FJsonValue>>* Resolution = nullptr;
+        if (Params.IsValid() && Params->TryGetArrayField(TEXT("resolution"), Resolution))
+        {
+                double Size[2] = { 0.0, 0.0 };
+                if (Resolution->Num() != 2 || !(*Resolution)[0]->TryGetNumber(Size[0]) || !(*Resolution)[1]->TryGetNumber(Size[1]) || Size[0] < 0.0 || Size[1] < 0.0)
+                {
+                        return MakeError(TEXT("VIEWPORT_STREAM_INVALID_PARAMS"), TEXT("'resolution' must be [width, height]; 0 leaves that axis unbounded"));
+                }
+                Stream.Options.MaxWidth = static_cast<int32>(Size[0]);
+                Stream.Options.MaxHeight = static_cast<int32>(Size[1]);
+        }
+
+        // A session watches one viewport; starting again replaces its stream with the new settings.
+        const FString Replaced = FindSessionStream(Stream.SessionId);
+        if (Replaced.IsEmpty() && GStreams.Num() >= MaxStreams)
+        {
+                return MakeError(TEXT("VIEWPORT_STREAM_LIMIT"), FString::Printf(TEXT("At most %d viewport streams may run at once"), MaxStreams));
+        }
+
+        // The first frame shows whether this viewport can be read back at all; a synchronous read
+        // per frame would cost the game thread what streaming is meant to save.
+        const double Now = FPlatformTime::Seconds();
+        Stream.StreamId = FGuid::NewGuid().ToString(EGuidFormats::Digits).ToLower();
+        Stream.IntervalSeconds = 1.0 / Stream.Fps;
+        Stream.StartedSeconds = Now;
+        Stream.NextDueSeconds = Now + Stream.IntervalSeconds;
+        if (!BeginFrame(Stream, Now).IsValid())
+        {
+                return MakeError(TEXT("VIEWPORT_STREAM_UNAVAILABLE"), TEXT("The active viewport has no render target to read back; use take_screenshot"));
+        }
+
+        if (!Replaced.IsEmpty())
+        {
+                GStreams.Remove(Replaced);
+        }
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetStringField(TEXT("streamId"), Stream.StreamId);
+        Data->SetStringField(TEXT("frameType"), TEXT("viewport_frame"));
+        Data->SetNumberField(TEXT("fps"), Stream.Fps);
+        Data->SetStringField(TEXT("codec"), Stream.Codec);
+        Data->SetStringField(TEXT("mimeType"), FViewportCapture::GetMimeType(Stream.Options.Format));
+        Data->SetNumberField(TEXT("maxWidth"), Stream.Options.MaxWidth);
+        Data->SetNumberField(TEXT("maxHeight"), Stream.Options.MaxHeight);
+        Data->SetNumberField(TEXT("quality"), Stream.Options.Quality);
+        Data->SetBoolField(TEXT("attachments"), Stream.bAttachments);
+        if (!Replaced.IsEmpty())
+        {
+                Data->SetStringField(TEXT("replaced"), Replaced);
+        }
+
+        UE_LOG(LogUnrealMCP, Display, TEXT("Viewport stream %s: started for session %s at %d fps (%s)"), *Stream.StreamId, *Stream.SessionId, Stream.Fps, *Stream.Codec);
+        const FString StreamId = Stream.StreamId;
+        GStreams.Add(StreamId, MoveTemp(Stream));
+        if (!GTickerHandle.IsValid())
+        {
+                GTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick));
+        }
+        return Data;
+}
+
+TSharedPtr<FJsonObject> FViewportStream::StreamStop(const TSharedPtr<FJsonObject>& Params)
+{
+        check(IsInGameThread());
+
+        FCommandContext* Context = FCommandContext::GetActive();
+        const FString SessionId = Context ? Context->GetSessionId() : FString();
+        FString StreamId;
+        if (Params.IsValid())
+        {
+                Params->TryGetStringField(TEXT("streamId"), StreamId);
+        }
+        if (StreamId.IsEmpty())
+        {
+                StreamId = FindSessionStream(SessionId);
+        }
+
+        // Another session's stream is not this one's to stop.
+        const FStream* Stream = GStreams.Find(StreamId);
+        if (!Stream || Stream->SessionId != SessionId)
+        {
+                return MakeError(TEXT("VIEWPORT_STREAM_NOT_FOUND"), StreamId.IsEmpty() ? FString(TEXT("This session has no viewport stream")) : FString::Printf(TEXT("No viewport stream '%s'"), *StreamId));
+        }
+
+        TSharedPtr<FJsonObject> Data = MakeStats(*Stream);
+        UE_LOG(LogUnrealMCP, Display, TEXT("Viewport stream %s: stopped after %lld frames"), *StreamId, Stream->FramesSent);
+        // Frames still reading back are dropped with the stream; ones already encoding may still arrive.
+        GStreams.Remove(StreamId);
+        return Data;
+}
+
+void FViewportStream::StopAll()
+{
+        check(IsInGameThread());
+        GStreams.Reset();
+        if (GTickerHandle.IsValid())
+        {
+                FTSTicker::GetCoreTicker().RemoveTicker(GTickerHandle);
+                GTickerHandle.Reset();
+        }
+}
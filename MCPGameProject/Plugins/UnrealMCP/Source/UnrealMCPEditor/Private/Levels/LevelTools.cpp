@@ -1,17 +1,23 @@
 #include "Levels/LevelTools.h"
 #include "CoreMinimal.h"
 
+#include "Actors/WorldChangeLog.h"
+#include "Assets/PackageSaver.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "Editor.h"
 #include "Editor/EditorEngine.h"
 #include "FileHelpers.h"
+#include "Engine/Level.h"
 #include "Engine/LevelStreaming.h"
 #include "Engine/World.h"
 #include "HAL/PlatformProcess.h"
 #include "HAL/PlatformTime.h"
+#include "Levels/WorldPartitionActors.h"
 #include "Misc/PackageName.h"
 #include "Permissions/WriteGate.h"
+#include "Protocol/CommandContext.h"
 #include "ScopedTransaction.h"
+#include "Transactions/TransactionManager.h"
 #include "UObject/Package.h"
 #include "WorldPartition/DataLayer/DataLayerSubsystem.h"
 #include "WorldPartition/DataLayer/DataLayerManager.h"
@@ -29,6 +35,15 @@ namespace
     constexpr const TCHAR* ErrorCodeUnloadFailed = TEXT("UNLOAD_FAILED");
     constexpr const TCHAR* ErrorCodeStreamingFailed = TEXT("STREAMING_FAILED");
     constexpr const TCHAR* ErrorCodeSourceControlRequired = TEXT("SOURCE_CONTROL_REQUIRED");
+    constexpr const TCHAR* ErrorCodeStreamingTimeout = TEXT("STREAMING_TIMEOUT");
+    constexpr const TCHAR* ErrorCodeCancelled = TEXT("CANCELLED");
+    constexpr const TCHAR* ErrorCodeNotWorldPartition = TEXT("NOT_WORLD_PARTITION");
+    constexpr const TCHAR* ErrorCodeRegionNotFound = TEXT("REGION_NOT_FOUND");
+    constexpr const TCHAR* ErrorCodeRegionLoadFailed = TEXT("REGION_LOAD_FAILED");
+
+    constexpr float SyncStreamingTimeoutSeconds = 5.0f;
+    constexpr double DefaultAsyncStreamingTimeoutSeconds = 120.0;
+    constexpr double MaxAsyncStreamingTimeoutSeconds = 3600.0;
 
     UWorld* GetEditorWorld()
     {
@@ -95,6 +110,28 @@ namespace
         return Message.IsEmpty() ? FString(TEXT("Unknown error")) : Message;
     }
 
+    bool TryGetVectorField(const TSharedPtr<FJsonObject>& Params, const TCHAR* Field, FVector& OutVector)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+        if (!Params->TryGetArrayField(Field, Values) || !Values || Values->Num() != 3)
+        {
+            return false;
+        }
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            if (!(*Values)[Axis].IsValid() || !(*Values)[Axis]->TryGetNumber(OutVector[Axis]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> VectorToJson(const FVector& Vector)
+    {
+        return { MakeShared<FJsonValueNumber>(Vector.X), MakeShared<FJsonValueNumber>(Vector.Y), MakeShared<FJsonValueNumber>(Vector.Z) };
+    }
+
     TSharedPtr<FJsonObject> MakeErrorJson(const FString& Code, const FString& Message)
     {
         const FString FinalMessage = MakeErrorMessage(Message);
@@ -171,26 +208,21 @@ namespace
         AuditActions.Add(MakeShared<FJsonValueObject>(Action));
     }
 
-    bool EnsureCheckout(const FString& PackagePath, FString& OutError)
+    FString GetCheckoutErrorMessage(const TSharedPtr<FJsonObject>& CheckoutError)
     {
-        TSharedPtr<FJsonObject> CheckoutError;
-        if (!FWriteGate::EnsureCheckoutForContentPath(PackagePath, CheckoutError))
+        FString Message;
+        if (CheckoutError.IsValid())
         {
-            if (CheckoutError.IsValid())
+            if (CheckoutError->HasField(TEXT("message")))
             {
-                if (CheckoutError->HasField(TEXT("message")))
-                {
-                    OutError = CheckoutError->GetStringField(TEXT("message"));
-                }
-                if (OutError.IsEmpty() && CheckoutError->HasField(TEXT("code")))
-                {
-                    OutError = CheckoutError->GetStringField(TEXT("code"));
-                }
+                Message = CheckoutError->GetStringField(TEXT("message"));
+            }
+            if (Message.IsEmpty() && CheckoutError->HasField(TEXT("code")))
+            {
+                Message = CheckoutError->GetStringField(TEXT("code"));
             }
-            return false;
         }
-
-        return true;
+        return Message;
     }
 
     bool PackageMatchesIdentifier(const FString& PackageName, const FString& Identifier)
@@ -404,6 +436,238 @@ namespace
             }
         }
     }
+
+    /**
+     * Streaming levels and data layers on their way to a requested state. The synchronous path
+     * ticks the editor until they get there; with "async" the handler suspends and checks them
+     * once per frame instead, so the editor keeps running while the levels load.
+     */
+    struct FStreamingWait : public UnrealMCP::Protocol::FCommandContext::FResumeState
+    {
+        TWeakObjectPtr<UWorld> World;
+        TArray<TWeakObjectPtr<ULevelStreaming>> Levels;
+        TArray<FName> DataLayers;
+        EDataLayerRuntimeState DataLayerTarget = EDataLayerRuntimeState::Activated;
+        bool bLoad = true;
+        /** Loading waits for the levels to be visible as well, not only loaded. */
+        bool bWaitVisible = true;
+        double StartSeconds = 0.0;
+        double TimeoutSeconds = 0.0;
+        /** The success payload, sent once every target has settled. */
+        TSharedPtr<FJsonObject> Data;
+    };
+
+    FString GetStreamingLevelName(const ULevelStreaming& Streaming)
+    {
+        return FPackageName::GetLongPackageAssetName(Streaming.GetWorldAssetPackageName());
+    }
+
+    /**
+     * Targets that reached the requested state (or failed to load, which ends the wait too).
+     * OutPending and OutFailed name the others.
+     */
+    int32 CountSettledTargets(const FStreamingWait& Wait, TArray<FString>* OutPending, TArray<FString>* OutFailed)
+    {
+        int32 Settled = 0;
+        for (const TWeakObjectPtr<ULevelStreaming>& WeakStreaming : Wait.Levels)
+        {
+            // A streaming level removed from the world meanwhile has nothing left to wait for.
+            const ULevelStreaming* Streaming = WeakStreaming.Get();
+            if (!Streaming)
+            {
+                ++Settled;
+                continue;
+            }
+
+            if (Wait.bLoad && Streaming->GetLevelStreamingState() == ELevelStreamingState::FailedToLoad)
+            {
+                ++Settled;
+                if (OutFailed)
+                {
+                    OutFailed->Add(GetStreamingLevelName(*Streaming));
+                }
+                continue;
+            }
+
+            const bool bDone = Wait.bLoad
+                ? (Wait.bWaitVisible ? Streaming->IsLevelVisible() : Streaming->IsLevelLoaded())
+                : !Streaming->IsLevelLoaded();
+            if (bDone)
+            {
+                ++Settled;
+            }
+            else if (OutPending)
+            {
+                OutPending->Add(GetStreamingLevelName(*Streaming));
+            }
+        }
+
+        UDataLayerManager* DataLayerManager = GetDataLayerManager(Wait.World.Get());
+        for (const FName& LayerName : Wait.DataLayers)
+        {
+            if (!DataLayerManager || DataLayerManager->GetDataLayerRuntimeStateByName(LayerName) == Wait.DataLayerTarget)
+            {
+                ++Settled;
+            }
+            else if (OutPending)
+            {
+                OutPending->Add(LayerName.ToString());
+            }
+        }
+
+        return Settled;
+    }
+
+    int32 GetTargetCount(const FStreamingWait& Wait)
+    {
+        return Wait.Levels.Num() + Wait.DataLayers.Num();
+    }
+
+    /**
+     * One frame of an asynchronous wait: the finished response once every target has settled, an
+     * error on timeout or cancel, or null after suspending the handler until the next frame.
+     */
+    TSharedPtr<FJsonObject> PollStreamingWait(const TSharedRef<FStreamingWait>& Wait, UnrealMCP::Protocol::FCommandContext& Context)
+    {
+        TArray<FString> Pending;
+        TArray<FString> Failed;
+        const int32 Total = GetTargetCount(*Wait);
+        const int32 Settled = CountSettledTargets(*Wait, &Pending, &Failed);
+        Context.ReportProgress(Settled, Total, TEXT("streaming"));
+
+        const double ElapsedSeconds = FPlatformTime::Seconds() - Wait->StartSeconds;
+        if (Settled < Total)
+        {
+            // The streaming requests stay in place either way; only the wait for them ends.
+            if (Context.IsCancelled())
+            {
+                return MakeErrorJson(ErrorCodeCancelled, TEXT("Stopped waiting for streaming; the requested levels keep streaming"));
+            }
+            if (ElapsedSeconds > Wait->TimeoutSeconds)
+            {
+                return MakeErrorJson(ErrorCodeStreamingTimeout, FString::Printf(TEXT("Still streaming after %.0f s: %s"), Wait->TimeoutSeconds, *FString::Join(Pending, TEXT(", "))));
+            }
+
+            Context.Suspend(Wait);
+            return nullptr;
+        }
+
+        if (GEditor)
+        {
+            GEditor->RedrawAllViewports(false);
+        }
+
+        TArray<TSharedPtr<FJsonValue>> FailedJson;
+        for (const FString& Name : Failed)
+        {
+            FailedJson.Add(MakeShared<FJsonValueString>(Name));
+        }
+        Wait->Data->SetBoolField(TEXT("async"), true);
+        Wait->Data->SetNumberField(TEXT("elapsedMs"), ElapsedSeconds * 1000.0);
+        Wait->Data->SetArrayField(TEXT("failed"), FailedJson);
+        return FUnrealMCPCommonUtils::CreateSuccessResponse(Wait->Data);
+    }
+
+    /** Whether to wait asynchronously: asked for with "async", and the handler runs on its own (not in a batch). */
+    bool ShouldStreamAsync(const TSharedPtr<FJsonObject>& Params, double& OutTimeoutSeconds)
+    {
+        bool bAsync = false;
+        OutTimeoutSeconds = DefaultAsyncStreamingTimeoutSeconds;
+        if (Params.IsValid())
+        {
+            Params->TryGetBoolField(TEXT("async"), bAsync);
+            Params->TryGetNumberField(TEXT("timeoutSec"), OutTimeoutSeconds);
+        }
+        OutTimeoutSeconds = FMath::Clamp(OutTimeoutSeconds, 1.0, MaxAsyncStreamingTimeoutSeconds);
+
+        const UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+        return bAsync && Context && Context->CanSuspend();
+    }
+
+    /**
+     * level.save_open with "mode": "touched": only the still-dirty packages of actors MCP commands
+     * changed, which on a One-File-Per-Actor map are their external actor packages and nothing else.
+     * They are checked out in one call and saved concurrently.
+     */
+    TSharedPtr<FJsonObject> SaveTouchedPackages()
+    {
+        const double StartSeconds = FPlatformTime::Seconds();
+        const bool bDryRun = FWriteGate::ShouldDryRun();
+
+        TArray<UPackage*> Touched;
+        FWorldChangeLog::Get().GetTouchedPackages(Touched);
+
+        TArray<UPackage*> PackagesToSave;
+        TArray<TSharedPtr<FJsonValue>> SkippedJson;
+        int32 NumExternal = 0;
+        for (UPackage* Package : Touched)
+        {
+            FString PathReason;
+            if (!FWriteGate::IsPathAllowed(Package->GetName(), PathReason))
+            {
+                SkippedJson.Add(MakeShared<FJsonValueString>(Package->GetName()));
+                continue;
+            }
+            PackagesToSave.Add(Package);
+            NumExternal += Package->ContainsMap() ? 0 : 1;
+        }
+
+        TArray<FPackageSaver::FResult> SaveResults;
+        if (!bDryRun && PackagesToSave.Num() > 0)
+        {
+            TSharedPtr<FJsonObject> CheckoutError;
+            if (!FPackageSaver::SavePackages(PackagesToSave, SaveResults, CheckoutError, /*bConcurrent=*/true))
+            {
+                return MakeErrorJson(ErrorCodeSourceControlRequired, GetCheckoutErrorMessage(CheckoutError));
+            }
+        }
+
+        int32 NumFailed = 0;
+        for (const FPackageSaver::FResult& Result : SaveResults)
+        {
+            NumFailed += Result.bSaved ? 0 : 1;
+        }
+        if (SaveResults.Num() > 0 && NumFailed == SaveResults.Num())
+        {
+            return MakeErrorJson(ErrorCodeSaveFailed, TEXT("Failed to save the touched packages"));
+        }
+
+        TArray<TSharedPtr<FJsonValue>> PlannedJson;
+        if (bDryRun)
+        {
+            for (const UPackage* Package : PackagesToSave)
+            {
+                PlannedJson.Add(MakeShared<FJsonValueString>(Package->GetName()));
+            }
+        }
+
+        TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetBoolField(TEXT("ok"), NumFailed == 0);
+        Data->SetStringField(TEXT("mode"), TEXT("touched"));
+        Data->SetNumberField(TEXT("touched"), PackagesToSave.Num());
+        Data->SetNumberField(TEXT("externalActorPackages"), NumExternal);
+        Data->SetNumberField(TEXT("savedCount"), SaveResults.Num() - NumFailed);
+        Data->SetArrayField(TEXT("results"), FPackageSaver::ResultsToJson(SaveResults));
+        Data->SetArrayField(TEXT("skipped"), SkippedJson);
+        if (bDryRun)
+        {
+            Data->SetArrayField(TEXT("planned"), PlannedJson);
+        }
+        Data->SetNumberField(TEXT("elapsedMs"), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+
+        TArray<TSharedPtr<FJsonValue>> AuditActions;
+        AppendAuditAction(AuditActions, TEXT("save_touched"), [bDryRun, Count = PackagesToSave.Num()](TSharedPtr<FJsonObject>& Action)
+        {
+            Action->SetNumberField(TEXT("packages"), Count);
+            Action->SetBoolField(TEXT("executed"), !bDryRun);
+        });
+        TSharedPtr<FJsonObject> Audit = MakeShared<FJsonObject>();
+        Audit->SetBoolField(TEXT("dryRun"), bDryRun);
+        Audit->SetArrayField(TEXT("actions"), AuditActions);
+        Data->SetObjectField(TEXT("audit"), Audit);
+
+        return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+    }
 }
 
 TSharedPtr<FJsonObject> FLevelTools::SaveOpen(const TSharedPtr<FJsonObject>& Params)
@@ -422,12 +686,23 @@ TSharedPtr<FJsonObject> FLevelTools::SaveOpen(const TSharedPtr<FJsonObject>& Par
     bool bModifiedOnly = true;
     bool bShowDialog = false;
     bool bSaveExternalActors = true;
+    FString Mode = TEXT("maps");
 
     if (Params.IsValid())
     {
         Params->TryGetBoolField(TEXT("modifiedOnly"), bModifiedOnly);
         Params->TryGetBoolField(TEXT("showDialog"), bShowDialog);
         Params->TryGetBoolField(TEXT("saveExternalActors"), bSaveExternalActors);
+        Params->TryGetStringField(TEXT("mode"), Mode);
+    }
+
+    if (Mode == TEXT("touched"))
+    {
+        return SaveTouchedPackages();
+    }
+    if (Mode != TEXT("maps"))
+    {
+        return MakeErrorJson(ErrorCodeInvalidParams, FString::Printf(TEXT("Unknown mode '%s'; expected 'maps' or 'touched'"), *Mode));
     }
 
     (void)bShowDialog;
@@ -504,15 +779,6 @@ TSharedPtr<FJsonObject> FLevelTools::SaveOpen(const TSharedPtr<FJsonObject>& Par
             continue;
         }
 
-        if (!bDryRun)
-        {
-            FString CheckoutError;
-            if (!EnsureCheckout(PackagePath, CheckoutError))
-            {
-                return MakeErrorJson(ErrorCodeSourceControlRequired, CheckoutError);
-            }
-        }
-
         PackagesToSave.AddUnique(Package);
         SavedMaps.Add(MapObjectPath);
 
@@ -523,31 +789,69 @@ TSharedPtr<FJsonObject> FLevelTools::SaveOpen(const TSharedPtr<FJsonObject>& Par
         });
     }
 
-    bool bSaveOk = true;
+    // Dirty external actor packages of the saved maps go through the same checkout and save.
+    if (bSaveExternalActors)
+    {
+        const TArray<UPackage*> MapPackages = PackagesToSave;
+        for (ULevel* Level : World->GetLevels())
+        {
+            if (!Level || !MapPackages.Contains(Level->GetOutermost()))
+            {
+                continue;
+            }
+
+            for (UPackage* ExternalPackage : Level->GetLoadedExternalObjectPackages())
+            {
+                if (ExternalPackage && ExternalPackage->IsDirty())
+                {
+                    PackagesToSave.AddUnique(ExternalPackage);
+                }
+            }
+        }
+    }
 
+    TArray<FPackageSaver::FResult> SaveResults;
     if (!bDryRun && PackagesToSave.Num() > 0)
     {
-        bSaveOk = UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, /*bOnlyDirty*/ bModifiedOnly);
+        TSharedPtr<FJsonObject> CheckoutError;
+        if (!FPackageSaver::SavePackages(PackagesToSave, SaveResults, CheckoutError))
+        {
+            return MakeErrorJson(ErrorCodeSourceControlRequired, GetCheckoutErrorMessage(CheckoutError));
+        }
     }
 
-    if (!bSaveOk)
+    TSet<FString> FailedPackages;
+    for (const FPackageSaver::FResult& Result : SaveResults)
     {
-        return MakeErrorJson(ErrorCodeSaveFailed, TEXT("Failed to save map packages"));
+        if (!Result.bSaved)
+        {
+            FailedPackages.Add(Result.PackageName);
+        }
     }
 
-    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-    Data->SetBoolField(TEXT("ok"), true);
-    Data->SetNumberField(TEXT("savedCount"), bDryRun ? 0 : PackagesToSave.Num());
-
     TArray<TSharedPtr<FJsonValue>> SavedJson;
     if (!bDryRun)
     {
         for (const FString& Saved : SavedMaps)
         {
-            SavedJson.Add(MakeShared<FJsonValueString>(Saved));
+            if (!FailedPackages.Contains(ObjectPathToPackagePath(Saved)))
+            {
+                SavedJson.Add(MakeShared<FJsonValueString>(Saved));
+            }
+        }
+
+        // Every map failing is still an error; partial failures are reported per package.
+        if (SavedMaps.Num() > 0 && SavedJson.Num() == 0)
+        {
+            return MakeErrorJson(ErrorCodeSaveFailed, TEXT("Failed to save map packages"));
         }
     }
 
+    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+    Data->SetBoolField(TEXT("ok"), FailedPackages.Num() == 0);
+    Data->SetNumberField(TEXT("savedCount"), SaveResults.Num() - FailedPackages.Num());
+    Data->SetArrayField(TEXT("results"), FPackageSaver::ResultsToJson(SaveResults));
+
     TArray<TSharedPtr<FJsonValue>> SkippedJson;
     for (const FString& Skipped : SkippedMaps)
     {
@@ -575,6 +879,13 @@ TSharedPtr<FJsonObject> FLevelTools::SaveOpen(const TSharedPtr<FJsonObject>& Par
 
 TSharedPtr<FJsonObject> FLevelTools::Load(const TSharedPtr<FJsonObject>& Params)
 {
+    // With "async" the map opened on the first call; later calls only check its sublevels.
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+    if (TSharedPtr<FStreamingWait> Wait = Context ? Context->TakeResumeState<FStreamingWait>() : nullptr)
+    {
+        return PollStreamingWait(Wait.ToSharedRef(), *Context);
+    }
+
     if (!Params.IsValid())
     {
         return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Missing parameters"));
@@ -733,7 +1044,7 @@ TSharedPtr<FJsonObject> FLevelTools::Load(const TSharedPtr<FJsonObject>& Params)
     const bool bShouldTransact = !bDryRun && (StreamingTargets.Num() > 0 || DataLayersToLoad.Num() > 0);
     if (bShouldTransact)
     {
-        FScopedTransaction Transaction(FText::FromString(TEXT("MCP Levels v1")));
+        FScopedTransaction Transaction(FText::FromString(TEXT("MCP Levels v1")), !FTransactionManager::IsUndoSuppressed());
 
         for (ULevelStreaming* StreamingTarget : StreamingTargets)
         {
@@ -754,7 +1065,12 @@ TSharedPtr<FJsonObject> FLevelTools::Load(const TSharedPtr<FJsonObject>& Params)
         }
     }
 
-    if (!bDryRun && (StreamingTargets.Num() > 0 || DataLayersToLoad.Num() > 0))
+    // Opening the map itself stays synchronous; with "async" its sublevels then stream in while the
+    // editor keeps ticking, instead of in one flush.
+    const bool bHasStreamingTargets = !bDryRun && (StreamingTargets.Num() > 0 || DataLayersToLoad.Num() > 0);
+    double AsyncTimeoutSeconds = 0.0;
+    const bool bStreamAsync = bHasStreamingTargets && ShouldStreamAsync(Params, AsyncTimeoutSeconds);
+    if (bHasStreamingTargets && !bStreamAsync)
     {
         FlushStreaming(World);
     }
@@ -799,6 +1115,21 @@ TSharedPtr<FJsonObject> FLevelTools::Load(const TSharedPtr<FJsonObject>& Params)
     Audit->SetArrayField(TEXT("actions"), AuditActions);
     Data->SetObjectField(TEXT("audit"), Audit);
 
+    if (bStreamAsync)
+    {
+        TSharedRef<FStreamingWait> Wait = MakeShared<FStreamingWait>();
+        Wait->World = World;
+        for (ULevelStreaming* StreamingTarget : StreamingTargets)
+        {
+            Wait->Levels.Add(StreamingTarget);
+        }
+        Wait->DataLayers = DataLayersToLoad;
+        Wait->StartSeconds = FPlatformTime::Seconds();
+        Wait->TimeoutSeconds = AsyncTimeoutSeconds;
+        Wait->Data = Data;
+        return PollStreamingWait(Wait, *Context);
+    }
+
     return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
 }
 
@@ -901,7 +1232,7 @@ TSharedPtr<FJsonObject> FLevelTools::Unload(const TSharedPtr<FJsonObject>& Param
 
     if (!bDryRun && (StreamingTargets.Num() > 0 || PendingDataLayers.Num() > 0))
     {
-        FScopedTransaction Transaction(FText::FromString(TEXT("MCP Levels v1")));
+        FScopedTransaction Transaction(FText::FromString(TEXT("MCP Levels v1")), !FTransactionManager::IsUndoSuppressed());
 
         for (ULevelStreaming* StreamingTarget : StreamingTargets)
         {
@@ -951,6 +1282,12 @@ TSharedPtr<FJsonObject> FLevelTools::Unload(const TSharedPtr<FJsonObject>& Param
 
 TSharedPtr<FJsonObject> FLevelTools::StreamSublevel(const TSharedPtr<FJsonObject>& Params)
 {
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+    if (TSharedPtr<FStreamingWait> Wait = Context ? Context->TakeResumeState<FStreamingWait>() : nullptr)
+    {
+        return PollStreamingWait(Wait.ToSharedRef(), *Context);
+    }
+
     if (!Params.IsValid())
     {
         return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Missing parameters"));
@@ -967,16 +1304,37 @@ TSharedPtr<FJsonObject> FLevelTools::StreamSublevel(const TSharedPtr<FJsonObject
         return MakeErrorJson(ErrorCodeEditorUnavailable, TEXT("No active editor world"));
     }
 
+    // "name" targets one sublevel or data layer; "names" streams several in one request.
+    TArray<FString> TargetNames;
     FString TargetName;
-    if (!Params->TryGetStringField(TEXT("name"), TargetName))
+    if (Params->TryGetStringField(TEXT("name"), TargetName))
     {
-        return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Missing name parameter"));
+        TargetName.TrimStartAndEndInline();
+        if (TargetName.IsEmpty())
+        {
+            return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Empty sublevel name"));
+        }
+        TargetNames.Add(TargetName);
     }
-
-    TargetName.TrimStartAndEndInline();
-    if (TargetName.IsEmpty())
+    const TArray<TSharedPtr<FJsonValue>>* NamesArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("names"), NamesArray) && NamesArray)
     {
-        return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Empty sublevel name"));
+        for (const TSharedPtr<FJsonValue>& Value : *NamesArray)
+        {
+            if (Value.IsValid() && Value->Type == EJson::String)
+            {
+                FString Name = Value->AsString();
+                Name.TrimStartAndEndInline();
+                if (!Name.IsEmpty())
+                {
+                    TargetNames.AddUnique(Name);
+                }
+            }
+        }
+    }
+    if (TargetNames.Num() == 0)
+    {
+        return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Missing name parameter"));
     }
 
     bool bLoad = true;
@@ -986,97 +1344,109 @@ TSharedPtr<FJsonObject> FLevelTools::StreamSublevel(const TSharedPtr<FJsonObject
 
     const bool bDryRun = FWriteGate::ShouldDryRun();
 
-    ULevelStreaming* Streaming = FindStreamingLevel(World, TargetName);
-    bool bResolved = false;
+    TArray<ULevelStreaming*> StreamingTargets;
     TArray<FName> TargetDataLayers;
+    TArray<FString> NotFound;
     bool bActivateOnly = false;
 
-    if (!Streaming)
+    for (const FString& Name : TargetNames)
     {
-        if (World->GetWorldPartition())
+        if (ULevelStreaming* Streaming = FindStreamingLevel(World, Name))
         {
-            const TSharedPtr<FJsonObject>* WorldPartitionOptions = nullptr;
-            if (Params->TryGetObjectField(TEXT("worldPartition"), WorldPartitionOptions) && WorldPartitionOptions && WorldPartitionOptions->IsValid())
+            StreamingTargets.AddUnique(Streaming);
+        }
+        else
+        {
+            NotFound.Add(Name);
+        }
+    }
+
+    if (NotFound.Num() > 0 && World->GetWorldPartition())
+    {
+        const TSharedPtr<FJsonObject>* WorldPartitionOptions = nullptr;
+        if (Params->TryGetObjectField(TEXT("worldPartition"), WorldPartitionOptions) && WorldPartitionOptions && WorldPartitionOptions->IsValid())
+        {
+            const TSharedPtr<FJsonObject>& Options = *WorldPartitionOptions;
+            ResolveDataLayerNames(Options, TEXT("dataLayers"), TargetDataLayers);
+            Options->TryGetBoolField(TEXT("activateOnly"), bActivateOnly);
+            TargetDataLayers.RemoveAll([World](const FName& Name)
             {
-                const TSharedPtr<FJsonObject>& Options = *WorldPartitionOptions;
-                ResolveDataLayerNames(Options, TEXT("dataLayers"), TargetDataLayers);
-                Options->TryGetBoolField(TEXT("activateOnly"), bActivateOnly);
-                TargetDataLayers.RemoveAll([World](const FName& Name)
-                {
-                    return Name.IsNone() || !DataLayerExists(World, Name);
-                });
-            }
+                return Name.IsNone() || !DataLayerExists(World, Name);
+            });
+        }
 
-            if (TargetDataLayers.Num() == 0)
+        // Explicit data layers stand in for names that are not sublevels; otherwise a name may be a layer.
+        if (TargetDataLayers.Num() > 0)
+        {
+            NotFound.Reset();
+        }
+        else
+        {
+            NotFound.RemoveAll([World, &TargetDataLayers](const FString& Name)
             {
-                const FName LayerName(*TargetName);
+                const FName LayerName(*Name);
                 if (!LayerName.IsNone() && DataLayerExists(World, LayerName))
                 {
-                    TargetDataLayers.Add(LayerName);
+                    TargetDataLayers.AddUnique(LayerName);
+                    return true;
                 }
-            }
+                return false;
+            });
         }
     }
-    else
+
+    if (StreamingTargets.Num() == 0 && TargetDataLayers.Num() == 0)
     {
-        TargetDataLayers.Reset();
+        return MakeErrorJson(ErrorCodeSublevelNotFound, TEXT("Sublevel or data layer not found"));
     }
 
-    if (!Streaming && TargetDataLayers.Num() == 0)
+    TSharedRef<FStreamingWait> Wait = MakeShared<FStreamingWait>();
+    Wait->World = World;
+    for (ULevelStreaming* Streaming : StreamingTargets)
     {
-        return MakeErrorJson(ErrorCodeSublevelNotFound, TEXT("Sublevel or data layer not found"));
+        Wait->Levels.Add(Streaming);
     }
+    Wait->DataLayers = TargetDataLayers;
+    Wait->DataLayerTarget = (bLoad || bActivateOnly) ? EDataLayerRuntimeState::Activated : EDataLayerRuntimeState::Unloaded;
+    Wait->bLoad = bLoad;
+    Wait->bWaitVisible = bBlockUntilVisible;
 
+    double AsyncTimeoutSeconds = 0.0;
+    bool bStreamAsync = false;
     if (!bDryRun)
     {
-        FScopedTransaction Transaction(FText::FromString(TEXT("MCP Levels v1")));
+        FScopedTransaction Transaction(FText::FromString(TEXT("MCP Levels v1")), !FTransactionManager::IsUndoSuppressed());
         bool bChanged = false;
 
-        if (Streaming)
+        for (ULevelStreaming* Streaming : StreamingTargets)
         {
             Streaming->SetShouldBeLoaded(bLoad);
             Streaming->SetShouldBeVisible(bLoad);
             bChanged = true;
         }
-        else if (TargetDataLayers.Num() > 0)
+
+        if (TargetDataLayers.Num() > 0)
         {
             TArray<FName> Processed;
-            if (!SetDataLayersState(World, TargetDataLayers, bLoad, bActivateOnly, Processed))
+            if (!SetDataLayersState(World, TargetDataLayers, bLoad, bActivateOnly, Processed) && StreamingTargets.Num() == 0)
             {
                 return MakeErrorJson(ErrorCodeStreamingFailed, TEXT("Failed to update data layer state"));
             }
-            bChanged = Processed.Num() > 0;
+            bChanged = bChanged || Processed.Num() > 0;
         }
 
-        if (bChanged)
+        // Async requests leave the loading to the editor's own streaming updates and check on it
+        // every frame; the synchronous path flushes and ticks the editor until done.
+        bStreamAsync = bChanged && ShouldStreamAsync(Params, AsyncTimeoutSeconds);
+        if (bChanged && !bStreamAsync)
         {
             FlushStreaming(World);
             if (bBlockUntilVisible && bLoad)
             {
-                TickUntil([World, Streaming, &TargetDataLayers]()
+                TickUntil([&Wait]()
                 {
-                    if (Streaming)
-                    {
-                        return Streaming->IsLevelVisible();
-                    }
-
-                    if (TargetDataLayers.Num() > 0)
-                    {
-                        if (UDataLayerManager* DataLayerManager = GetDataLayerManager(World))
-                        {
-                            for (const FName& LayerName : TargetDataLayers)
-                            {
-                                if (DataLayerManager->GetDataLayerRuntimeStateByName(LayerName) != EDataLayerRuntimeState::Activated)
-                                {
-                                    return false;
-                                }
-                            }
-                            return true;
-                        }
-                    }
-
-                    return true;
-                }, 5.0f);
+                    return CountSettledTargets(*Wait, nullptr, nullptr) >= GetTargetCount(*Wait);
+                }, SyncStreamingTimeoutSeconds);
             }
         }
     }
@@ -1084,17 +1454,153 @@ TSharedPtr<FJsonObject> FLevelTools::StreamSublevel(const TSharedPtr<FJsonObject
     TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
     Data->SetBoolField(TEXT("ok"), true);
     Data->SetStringField(TEXT("action"), bLoad ? TEXT("loaded") : TEXT("unloaded"));
-    Data->SetStringField(TEXT("target"), TargetName);
+    Data->SetStringField(TEXT("target"), TargetNames[0]);
+    if (TargetNames.Num() > 1 || NamesArray)
+    {
+        TArray<TSharedPtr<FJsonValue>> TargetsJson;
+        for (const ULevelStreaming* Streaming : StreamingTargets)
+        {
+            TargetsJson.Add(MakeShared<FJsonValueString>(GetStreamingLevelName(*Streaming)));
+        }
+        AppendNamesToJsonArray(TargetDataLayers, TargetsJson);
+        Data->SetArrayField(TEXT("targets"), TargetsJson);
+
+        TArray<TSharedPtr<FJsonValue>> NotFoundJson;
+        for (const FString& Name : NotFound)
+        {
+            NotFoundJson.Add(MakeShared<FJsonValueString>(Name));
+        }
+        Data->SetArrayField(TEXT("notFound"), NotFoundJson);
+    }
 
     TSharedPtr<FJsonObject> Audit = MakeShared<FJsonObject>();
     Audit->SetBoolField(TEXT("dryRun"), bDryRun);
     TArray<TSharedPtr<FJsonValue>> AuditActions;
-    AppendAuditAction(AuditActions, TEXT("stream"), [&TargetName, bLoad, bDryRun](TSharedPtr<FJsonObject>& Action)
+    for (const FString& Name : TargetNames)
     {
-        Action->SetStringField(TEXT("target"), TargetName);
-        Action->SetBoolField(TEXT("load"), bLoad);
+        if (NotFound.Contains(Name))
+        {
+            continue;
+        }
+        AppendAuditAction(AuditActions, TEXT("stream"), [&Name, bLoad, bDryRun](TSharedPtr<FJsonObject>& Action)
+        {
+            Action->SetStringField(TEXT("target"), Name);
+            Action->SetBoolField(TEXT("load"), bLoad);
+            Action->SetBoolField(TEXT("executed"), !bDryRun);
+        });
+    }
+    Audit->SetArrayField(TEXT("actions"), AuditActions);
+    Data->SetObjectField(TEXT("audit"), Audit);
+
+    if (bStreamAsync)
+    {
+        Wait->StartSeconds = FPlatformTime::Seconds();
+        Wait->TimeoutSeconds = AsyncTimeoutSeconds;
+        Wait->Data = Data;
+        return PollStreamingWait(Wait, *Context);
+    }
+
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+}
+
+TSharedPtr<FJsonObject> FLevelTools::LoadRegion(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!Params.IsValid())
+    {
+        return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+    }
+
+    if (!GEditor)
+    {
+        return MakeErrorJson(ErrorCodeEditorUnavailable, TEXT("Editor instance unavailable"));
+    }
+
+    // Loader regions belong to the editor world; a PIE world streams on its own.
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    if (!World)
+    {
+        return MakeErrorJson(ErrorCodeEditorUnavailable, TEXT("No active editor world"));
+    }
+    if (!FWorldPartitionActors::GetWorldPartition(World))
+    {
+        return MakeErrorJson(ErrorCodeNotWorldPartition, TEXT("The open map does not use World Partition"));
+    }
+
+    FVector Min;
+    FVector Max;
+    if (!TryGetVectorField(Params, TEXT("min"), Min) || !TryGetVectorField(Params, TEXT("max"), Max))
+    {
+        return MakeErrorJson(ErrorCodeInvalidParams, TEXT("load_region needs min and max arrays of three numbers"));
+    }
+    const FBox Bounds(Min.ComponentMin(Max), Min.ComponentMax(Max));
+
+    const bool bDryRun = FWriteGate::ShouldDryRun();
+
+    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+    Data->SetBoolField(TEXT("ok"), true);
+    Data->SetArrayField(TEXT("min"), VectorToJson(Bounds.Min));
+    Data->SetArrayField(TEXT("max"), VectorToJson(Bounds.Max));
+
+    if (!bDryRun)
+    {
+        // Editor loader regions are not part of the undo history, so there is no transaction here.
+        FString RegionId;
+        int32 ActorCount = 0;
+        FString Error;
+        if (!FWorldPartitionActors::LoadRegion(World, Bounds, RegionId, ActorCount, Error))
+        {
+            return MakeErrorJson(ErrorCodeRegionLoadFailed, Error);
+        }
+        Data->SetStringField(TEXT("regionId"), RegionId);
+        Data->SetNumberField(TEXT("actorCount"), ActorCount);
+    }
+
+    TArray<TSharedPtr<FJsonValue>> AuditActions;
+    AppendAuditAction(AuditActions, TEXT("load_region"), [&Bounds, bDryRun](TSharedPtr<FJsonObject>& Action)
+    {
+        Action->SetArrayField(TEXT("min"), VectorToJson(Bounds.Min));
+        Action->SetArrayField(TEXT("max"), VectorToJson(Bounds.Max));
+        Action->SetBoolField(TEXT("executed"), !bDryRun);
+    });
+    TSharedPtr<FJsonObject> Audit = MakeShared<FJsonObject>();
+    Audit->SetBoolField(TEXT("dryRun"), bDryRun);
+    Audit->SetArrayField(TEXT("actions"), AuditActions);
+    Data->SetObjectField(TEXT("audit"), Audit);
+
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+}
+
+TSharedPtr<FJsonObject> FLevelTools::UnloadRegion(const TSharedPtr<FJsonObject>& Params)
+{
+    FString RegionId;
+    if (!Params.IsValid() || !Params->TryGetStringField(TEXT("regionId"), RegionId) || RegionId.TrimStartAndEnd().IsEmpty())
+    {
+        return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Missing regionId parameter"));
+    }
+    RegionId.TrimStartAndEndInline();
+
+    const bool bDryRun = FWriteGate::ShouldDryRun();
+    if (!bDryRun)
+    {
+        FString Error;
+        if (!FWorldPartitionActors::UnloadRegion(RegionId, Error))
+        {
+            return MakeErrorJson(ErrorCodeRegionNotFound, Error);
+        }
+    }
+
+    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+    Data->SetBoolField(TEXT("ok"), true);
+    Data->SetStringField(TEXT("regionId"), RegionId);
+
+    TArray<TSharedPtr<FJsonValue>> AuditActions;
+    AppendAuditAction(AuditActions, TEXT("unload_region"), [&RegionId, bDryRun](TSharedPtr<FJsonObject>& Action)
+    {
+        Action->SetStringField(TEXT("regionId"), RegionId);
         Action->SetBoolField(TEXT("executed"), !bDryRun);
     });
+    TSharedPtr<FJsonObject> Audit = MakeShared<FJsonObject>();
+    Audit->SetBoolField(TEXT("dryRun"), bDryRun);
     Audit->SetArrayField(TEXT("actions"), AuditActions);
     Data->SetObjectField(TEXT("audit"), Audit);
 
@@ -0,0 +1,214 @@
+#include "Levels/WorldPartitionActors.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Engine/World.h"
+#include "Misc/Guid.h"
+#include "UObject/WeakObjectPtr.h"
+#include "WorldPartition/LoaderAdapter/LoaderAdapterShape.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionActorDesc.h"
+#include "WorldPartition/WorldPartitionActorDescInstance.h"
+#include "WorldPartition/WorldPartitionEditorLoaderAdapter.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+
+namespace
+{
+    struct FRegion
+    {
+        TWeakObjectPtr<UWorld> World;
+        TWeakObjectPtr<UWorldPartitionEditorLoaderAdapter> Adapter;
+    };
+
+    TMap<FString, FRegion>& GetRegions()
+    {
+        static TMap<FString, FRegion> Regions;
+        return Regions;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> NamesToJson(const TArray<FName>& Names)
+    {
+        TArray<TSharedPtr<FJsonValue>> Values;
+        Values.Reserve(Names.Num());
+        for (const FName& Name : Names)
+        {
+            Values.Add(MakeShared<FJsonValueString>(Name.ToString()));
+        }
+        return Values;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> VectorToJson(const FVector& Vector)
+    {
+        return { MakeShared<FJsonValueNumber>(Vector.X), MakeShared<FJsonValueNumber>(Vector.Y), MakeShared<FJsonValueNumber>(Vector.Z) };
+    }
+}
+
+UWorldPartition* FWorldPartitionActors::GetWorldPartition(UWorld* World)
+{
+    return World ? World->GetWorldPartition() : nullptr;
+}
+
+bool FWorldPartitionActors::GetUnloaded(UWorld* World, TArray<FDesc>& OutDescs)
+{
+    UWorldPartition* WorldPartition = GetWorldPartition(World);
+    if (!WorldPartition)
+    {
+        return false;
+    }
+
+    FWorldPartitionHelpers::ForEachActorDescInstance(WorldPartition, AActor::StaticClass(), [&OutDescs](const FWorldPartitionActorDescInstance* Instance)
+    {
+        // Loaded actors are answered from the actors themselves, which may have changed since the
+        // descriptor was last saved.
+        if (!Instance || Instance->IsLoaded())
+        {
+            return true;
+        }
+
+        FDesc& Desc = OutDescs.AddDefaulted_GetRef();
+        Desc.Guid = Instance->GetGuid();
+        Desc.Path = Instance->GetActorSoftPath().ToString();
+        Desc.Name = Instance->GetActorName().ToString();
+        Desc.Label = Instance->GetActorLabel().ToString();
+        Desc.NativeClass = Instance->GetActorNativeClass();
+        const FTopLevelAssetPath BaseClass = Instance->GetBaseClass();
+        if (BaseClass.IsValid())
+        {
+            Desc.ClassPath = BaseClass.ToString();
+            Desc.ClassName = BaseClass.GetAssetName().ToString();
+        }
+        else if (Desc.NativeClass)
+        {
+            Desc.ClassPath = Desc.NativeClass->GetPathName();
+            Desc.ClassName = Desc.NativeClass->GetName();
+        }
+        Desc.Bounds = Instance->GetEditorBounds();
+        Desc.DataLayers = Instance->GetDataLayerInstanceNames().ToArray();
+        if (const FWorldPartitionActorDesc* ActorDesc = Instance->GetActorDesc())
+        {
+            Desc.Folder = ActorDesc->GetFolderPath().ToString();
+            for (const FName& Tag : ActorDesc->GetTags())
+            {
+                Desc.Tags.Add(Tag);
+            }
+        }
+        return true;
+    });
+    return true;
+}
+
+TSharedRef<FJsonObject> FWorldPartitionActors::ToJson(const FDesc& Desc, const TSet<FString>* Fields)
+{
+    auto Wants = [Fields](const TCHAR* Field) { return !Fields || Fields->Contains(Field); };
+
+    TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+    if (Wants(TEXT("name")))
+    {
+        Object->SetStringField(TEXT("name"), Desc.Name);
+    }
+    if (Wants(TEXT("label")))
+    {
+        Object->SetStringField(TEXT("label"), Desc.Label.IsEmpty() ? Desc.Name : Desc.Label);
+    }
+    if (Wants(TEXT("class")))
+    {
+        Object->SetStringField(TEXT("class"), Desc.ClassName);
+    }
+    if (Wants(TEXT("path")))
+    {
+        Object->SetStringField(TEXT("path"), Desc.Path);
+    }
+    if (Wants(TEXT("folder")))
+    {
+        Object->SetStringField(TEXT("folder"), Desc.Folder);
+    }
+    if (Wants(TEXT("tags")))
+    {
+        Object->SetArrayField(TEXT("tags"), NamesToJson(Desc.Tags));
+    }
+    if (Wants(TEXT("location")))
+    {
+        Object->SetArrayField(TEXT("location"), VectorToJson(Desc.Bounds.IsValid ? Desc.Bounds.GetCenter() : FVector::ZeroVector));
+    }
+    if (!Fields)
+    {
+        if (Desc.Bounds.IsValid)
+        {
+            TSharedPtr<FJsonObject> Bounds = MakeShared<FJsonObject>();
+            Bounds->SetArrayField(TEXT("min"), VectorToJson(Desc.Bounds.Min));
+            Bounds->SetArrayField(TEXT("max"), VectorToJson(Desc.Bounds.Max));
+            Object->SetObjectField(TEXT("bounds"), Bounds);
+        }
+        Object->SetArrayField(TEXT("dataLayers"), NamesToJson(Desc.DataLayers));
+    }
+    Object->SetBoolField(TEXT("loaded"), false);
+    return Object;
+}
+
+bool FWorldPartitionActors::LoadRegion(UWorld* World, const FBox& Bounds, FString& OutRegionId, int32& OutActorCount, FString& OutError)
+{
+    check(IsInGameThread());
+
+    UWorldPartition* WorldPartition = GetWorldPartition(World);
+    if (!WorldPartition)
+    {
+        OutError = TEXT("The open map does not use World Partition");
+        return false;
+    }
+
+    OutRegionId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphensLower);
+    UWorldPartitionEditorLoaderAdapter* Adapter = WorldPartition->CreateEditorLoaderAdapter<FLoaderAdapterShape>(World, Bounds, FString::Printf(TEXT("MCP Region %s"), *OutRegionId.Left(8)));
+    if (!Adapter || !Adapter->GetLoaderAdapter())
+    {
+        OutError = TEXT("Failed to create a loader for the region");
+        return false;
+    }
+
+    // User-created regions show in the World Partition editor, so they can be unloaded by hand too.
+    Adapter->GetLoaderAdapter()->SetUserCreated(true);
+    Adapter->GetLoaderAdapter()->Load();
+
+    OutActorCount = 0;
+    FWorldPartitionHelpers::ForEachActorDescInstance(WorldPartition, AActor::StaticClass(), [&OutActorCount, &Bounds](const FWorldPartitionActorDescInstance* Instance)
+    {
+        if (Instance && Instance->GetEditorBounds().Intersect(Bounds))
+        {
+            ++OutActorCount;
+        }
+        return true;
+    });
+
+    FRegion& Region = GetRegions().Add(OutRegionId);
+    Region.World = World;
+    Region.Adapter = Adapter;
+    return true;
+}
+
+bool FWorldPartitionActors::UnloadRegion(const FString& RegionId, FString& OutError)
+{
+    check(IsInGameThread());
+
+    FRegion Region;
+    if (!GetRegions().RemoveAndCopyValue(RegionId, Region))
+    {
+        OutError = FString::Printf(TEXT("No loaded region with id '%s'"), *RegionId);
+        return false;
+    }
+
+    UWorld* World = Region.World.Get();
+    UWorldPartition* WorldPartition = GetWorldPartition(World);
+    UWorldPartitionEditorLoaderAdapter* Adapter = Region.Adapter.Get();
+    if (!WorldPartition || !Adapter)
+    {
+        // The map was closed, or the region released in the editor; its cells went with it.
+        return true;
+    }
+
+    if (Adapter->GetLoaderAdapter())
+    {
+        Adapter->GetLoaderAdapter()->Unload();
+    }
+    WorldPartition->ReleaseEditorLoaderAdapter(Adapter);
+    return true;
+}
@@ -0,0 +1,951 @@
+#include "MCPClientConnection.h"
+#include "CoreMinimal.h"
+
+#include "MCPConnectionWriter.h"
+#include "MCPSession.h"
+#include "UnrealMCPBridge.h"
+#include "Protocol/Attachments.h"
+#include "Protocol/CommandContext.h"
+#include "Protocol/EventHub.h"
+#include "Protocol/Protocol.h"
+#include "Protocol/ResponseStream.h"
+#include "Permissions/WriteGate.h"
+#include "UnrealMCPLog.h"
+#include "Observability/JsonLogger.h"
+#include "Observability/MCPTrace.h"
+#include "Observability/MetricsRegistry.h"
+#include "Observability/TrafficRecorder.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/Guid.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Event.h"
+#include "Async/Async.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+        const TCHAR* ProtocolPluginVersion = TEXT("1.0.0");
+
+        FString GenerateSessionId()
+        {
+                return FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
+        }
+
+        /**
+         * meta.timings for a finished command, in milliseconds, with each phase also recorded in the
+         * metrics. Phases the request never reached are left out; null when it never started (cache
+         * hits, commands cancelled or expired while queued).
+         */
+        TSharedPtr<FJsonObject> MakeTimings(const FString& Tool, const UnrealMCP::Protocol::FCommandContext* Context, double ReceivedSeconds, double CompletedSeconds)
+        {
+                if (!Context || Context->GetTimings().StartedSeconds <= 0.0)
+                {
+                        return nullptr;
+                }
+
+                const UnrealMCP::Protocol::FCommandContext::FTimings& Timings = Context->GetTimings();
+                TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+                auto AddPhase = [&Tool, &Result](const TCHAR* Phase, double Seconds)
+                {
+                        const double Milliseconds = FMath::Max(Seconds, 0.0) * 1000.0;
+                        Result->SetNumberField(FString::Printf(TEXT("%sMs"), Phase), Milliseconds);
+                        FMetricsRegistry::RecordPhase(Tool, Phase, Milliseconds);
+                };
+
+                AddPhase(TEXT("queue"), Timings.StartedSeconds - ReceivedSeconds);
+                if (Timings.HandlerStartSeconds > 0.0)
+                {
+                        AddPhase(TEXT("gate"), Timings.HandlerStartSeconds - Timings.StartedSeconds);
+                        if (Timings.CheckoutSeconds > 0.0)
+                        {
+                                AddPhase(TEXT("checkout"), Timings.CheckoutSeconds);
+                        }
+                        AddPhase(TEXT("handler"), Timings.HandlerSeconds);
+                        const double ParkedSeconds = (Timings.HandlerEndSeconds - Timings.HandlerStartSeconds) - Timings.HandlerSeconds;
+                        if (ParkedSeconds > 0.0005)
+                        {
+                                AddPhase(TEXT("parked"), ParkedSeconds);
+                        }
+                        AddPhase(TEXT("complete"), CompletedSeconds - Timings.HandlerEndSeconds);
+                }
+                else
+                {
+                        // Refused by the gate (or failed checkout) before the handler ran.
+                        AddPhase(TEXT("gate"), CompletedSeconds - Timings.StartedSeconds);
+                }
+                return Result;
+        }
+
+        /** meta.memory for a command whose game-thread slices were sampled (also recorded in the metrics) or that recorded undo. */
+        TSharedPtr<FJsonObject> MakeMemory(const FString& Tool, const UnrealMCP::Protocol::FCommandContext* Context)
+        {
+                if (!Context || (!Context->GetMemoryUse().bMeasured && !Context->GetMemoryUse().bUndoRecorded))
+                {
+                        return nullptr;
+                }
+
+                const UnrealMCP::Protocol::FCommandContext::FMemoryUse& MemoryUse = Context->GetMemoryUse();
+                TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+                if (MemoryUse.bMeasured)
+                {
+                        Result->SetNumberField(TEXT("peakBytes"), static_cast<double>(MemoryUse.PeakDeltaBytes));
+                        Result->SetNumberField(TEXT("retainedBytes"), static_cast<double>(MemoryUse.RetainedBytes));
+                        FMetricsRegistry::RecordMemory(Tool, MemoryUse.PeakDeltaBytes);
+                }
+                if (MemoryUse.bUndoRecorded)
+                {
+                        Result->SetNumberField(TEXT("undoBytes"), static_cast<double>(MemoryUse.UndoBytes));
+                }
+                return Result;
+        }
+}
+
+FMCPClientConnection::FMCPClientConnection(UUnrealMCPBridge* InBridge, UnrealMCP::Protocol::FByteStreamPtr InStream, const FMCPServerConfig& InConfig, int32 InConnectionId,
+        TSharedPtr<FMCPSessionRegistry, ESPMode::ThreadSafe> InSessions, TSharedPtr<FTrafficRecorder, ESPMode::ThreadSafe> InRecorder)
+        : Bridge(InBridge)
+        , Stream(InStream)
+        , Config(InConfig)
+        , ConnectionId(InConnectionId)
+        , SessionId(GenerateSessionId())
+        , Thread(nullptr)
+        , bRunning(true)
+        , bFinished(false)
+        , SlotAvailableEvent(FPlatformProcess::GetSynchEventFromPool(false))
+        , Sessions(MoveTemp(InSessions))
+        , Recorder(MoveTemp(InRecorder))
+{
+}
+
+FMCPClientConnection::~FMCPClientConnection()
+{
+        Shutdown();
+        if (SlotAvailableEvent)
+        {
+                FPlatformProcess::ReturnSynchEventToPool(SlotAvailableEvent);
+                SlotAvailableEvent = nullptr;
+        }
+}
+
+bool FMCPClientConnection::Start()
+{
+        const FString ThreadName = FString::Printf(TEXT("UnrealMCPConnection_%d"), ConnectionId);
+        Thread = FRunnableThread::Create(this, *ThreadName, 0, TPri_Normal);
+        if (!Thread)
+        {
+                bFinished = true;
+                return false;
+        }
+        return true;
+}
+
+void FMCPClientConnection::Shutdown()
+{
+        Stop();
+        if (Thread)
+        {
+                Thread->WaitForCompletion();
+                delete Thread;
+                Thread = nullptr;
+        }
+}
+
+void FMCPClientConnection::Stop()
+{
+        bRunning = false;
+        if (SlotAvailableEvent)
+        {
+                SlotAvailableEvent->Trigger();
+        }
+        if (Stream.IsValid())
+        {
+                // Shutdown wakes a Wait/Recv blocked on the connection thread immediately (close alone
+                // does not on every platform). Run() closes the stream once the serve loop has exited.
+                Stream->Shutdown();
+        }
+}
+
+uint32 FMCPClientConnection::Run()
+{
+        UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientConnection[%d]: Serving session %s over %s"), ConnectionId, *SessionId, Stream.IsValid() ? Stream->GetTransportName() : TEXT("none"));
+        Serve();
+        // A resumable session keeps its subscriptions until the registry expires it; a session
+        // another connection already took over is not ours to touch.
+        if (Session.IsValid() && Session->Detach(this) && !(Sessions.IsValid() && Sessions->IsResumable()))
+        {
+                if (TSharedPtr<UnrealMCP::Protocol::FEventHub, ESPMode::ThreadSafe> EventHub = Bridge->GetEventHub())
+                {
+                        EventHub->Unsubscribe(SessionId, TArray<FString>());
+                }
+        }
+        if (Writer.IsValid())
+        {
+                // Let queued responses go out on a clean close; a stopped connection drops them.
+                if (bRunning && !Writer->Flush(1.0))
+                {
+                        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientConnection[%d]: Closing with %lld bytes unsent"), ConnectionId, Writer->GetQueuedBytes());
+                }
+                if (Stream.IsValid())
+                {
+                        Stream->Shutdown();
+                }
+                Writer->Shutdown();
+                if (Writer->GetDroppedEventCount() > 0)
+                {
+                        UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientConnection[%d]: %d event frames were dropped for a slow client"), ConnectionId, Writer->GetDroppedEventCount());
+                }
+        }
+        if (Stream.IsValid())
+        {
+                Stream->Close();
+        }
+        bFinished = true;
+        UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientConnection[%d]: Connection closed"), ConnectionId);
+        return 0;
+}
+
+void FMCPClientConnection::Serve()
+{
+        using namespace UnrealMCP::Protocol;
+
+        if (!Stream.IsValid())
+        {
+                return;
+        }
+
+        const FString EngineVersionString = FEngineVersion::Current().ToString();
+
+        ProtocolClient = MakeUnique<FProtocolClient>(Stream);
+        ProtocolClient->SetWindowMax(Config.MaxInFlightRequests);
+        ProtocolClient->SetAllowBinaryEncoding(Config.bAllowBinaryEncoding);
+        ProtocolClient->SetCompressionThreshold(Config.CompressionThresholdBytes);
+        ProtocolClient->SetSharedMemoryRingBytes(Config.SharedMemoryRingBytes);
+
+        ProtocolClient->SetSessionResolver([this](const FString& RequestedToken)
+        {
+                FHandshakeSession Result;
+                bool bResumed = false;
+                Session = Sessions.IsValid() ? Sessions->Open(RequestedToken, bResumed) : MakeShared<FMCPSession, ESPMode::ThreadSafe>(SessionId);
+                SessionId = Session->GetSessionId();
+                Result.SessionId = SessionId;
+                Result.ResumeToken = Session->GetResumeToken();
+                Result.bResumed = bResumed;
+                if (bResumed)
+                {
+                        UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientConnection[%d]: Resumed session %s"), ConnectionId, *SessionId);
+                }
+                return Result;
+        });
+
+        FString HandshakeError;
+        const double HandshakeTimeoutSeconds = FMath::Max(1.0, Config.HandshakeTimeoutSeconds);
+        const double IdleTimeoutSeconds = FMath::Max(1.0, Config.ReadTimeoutSeconds);
+        // Keepalive-only pings just often enough that neither side's idle timeout fires.
+        const double PingIntervalSeconds = Config.bKeepaliveOnlyHeartbeats
+                ? FMath::Max(0.1, IdleTimeoutSeconds * 0.5)
+                : FMath::Max(0.1, Config.HeartbeatIntervalSeconds);
+        const int32 WindowMax = ProtocolClient->GetWindowMax();
+
+        if (!ProtocolClient->PerformHandshake(EngineVersionString, ProtocolPluginVersion, SessionId, HandshakeError, HandshakeTimeoutSeconds))
+        {
+                UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Handshake failed: %s"), *HandshakeError);
+                return;
+        }
+
+        // Only the writer touches the stream from here on; SendMutex orders its sends against
+        // shared-memory activation on this thread.
+        Writer = MakeUnique<FMCPConnectionWriter>(ConnectionId, Config.MaxOutboundQueueBytes, Config.bDisconnectSlowClients,
+                [this](TArray<uint8>& Frame, FString& OutError)
+                {
+                        UNREALMCP_TRACE_SCOPE(MCP_SendFrame);
+                        FScopeLock SendLock(&SendMutex);
+                        const int64 PayloadBytes = Frame.Num() - static_cast<int64>(sizeof(uint32));
+                        if (!ProtocolClient->SendEncoded(Frame, OutError))
+                        {
+                                return false;
+                        }
+                        FMetricsRegistry::AddBytesSent(PayloadBytes);
+                        return true;
+                },
+                [this](const FString& Error)
+                {
+                        UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Outbound writer stopped: %s"), *Error);
+                        Stop();
+                },
+                [this]()
+                {
+                        SlotAvailableEvent->Trigger();
+                });
+        if (!Writer->Start())
+        {
+                UE_LOG(LogUnrealMCP, Error, TEXT("MCPClientConnection[%d]: Failed to create writer thread"), ConnectionId);
+                return;
+        }
+
+        // Take the session over. After a network drop the old connection may not have timed out
+        // yet; stop it so responses and events follow the client to this one.
+        TArray<TSharedRef<FJsonObject>> Undelivered;
+        FMCPClientConnectionPtr Previous = Session->Attach(AsShared(), Undelivered);
+        if (Previous.IsValid() && Previous.Get() != this)
+        {
+                UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientConnection[%d]: Session %s moved from connection %d"), ConnectionId, *SessionId, Previous->GetConnectionId());
+                Previous->Stop();
+        }
+        for (const TSharedRef<FJsonObject>& Response : Undelivered)
+        {
+                FString ReplayError;
+                if (!QueueMessage(Response, EMCPOutboundKind::Response, ReplayError))
+                {
+                        UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Failed to replay response: %s"), *ReplayError);
+                        return;
+                }
+        }
+
+        double LastPingTime = FPlatformTime::Seconds();
+        // Any frame in either direction proves the link is alive, so heartbeats only go out on a quiet one.
+        auto LastActivityTime = [this, &LastPingTime]()
+        {
+                return FMath::Max3(LastPingTime, ProtocolClient->GetLastReceivedTime(), ProtocolClient->GetLastSentTime());
+        };
+
+        while (bRunning && Stream->IsConnected())
+        {
+                // Stop reading while the window or the outbound queue is full; completions and the
+                // writer draining below its cap wake us.
+                if (InFlightCount.GetValue() >= WindowMax || Writer->IsOverCapacity())
+                {
+                        SlotAvailableEvent->Wait(FTimespan::FromMilliseconds(50));
+                        continue;
+                }
+
+                // Sleep until data arrives or the next heartbeat/idle deadline; Stop() wakes the wait early.
+                const double Now = FPlatformTime::Seconds();
+                const double UntilPing = PingIntervalSeconds - (Now - LastActivityTime());
+                const double UntilIdle = InFlightCount.GetValue() > 0
+                        ? UntilPing
+                        : IdleTimeoutSeconds - (Now - ProtocolClient->GetLastReceivedTime());
+                const double ReadTimeout = FMath::Max(0.0, FMath::Min(UntilIdle, UntilPing));
+
+                FProtocolReadResult ReadResult;
+                if (ProtocolClient->WaitForReadable(ReadTimeout))
+                {
+                        UNREALMCP_TRACE_SCOPE(MCP_ReadFrame);
+                        ReadResult = ProtocolClient->ReceiveMessage(IdleTimeoutSeconds, false);
+                }
+                else
+                {
+                        ReadResult.bTimeout = true;
+                }
+
+                if (ReadResult.bSuccess && ReadResult.Message.IsValid())
+                {
+                        FMetricsRegistry::AddBytesReceived(ReadResult.PayloadBytes);
+                        if (Recorder.IsValid())
+                        {
+                                Recorder->RecordInbound(ConnectionId, ReadResult.Message.ToSharedRef());
+                        }
+                        UNREALMCP_TRACE_SCOPE(MCP_HandleMessage);
+                        if (!HandleProtocolMessage(ReadResult.Message))
+                        {
+                                break;
+                        }
+                }
+                else if (ReadResult.bTimeout)
+                {
+                        if ((FPlatformTime::Seconds() - LastActivityTime()) >= PingIntervalSeconds)
+                        {
+                                FString PingError;
+                                if (!QueueMessage(MakePingMessage(), EMCPOutboundKind::Control, PingError))
+                                {
+                                        UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Failed to send ping: %s"), *PingError);
+                                        break;
+                                }
+
+                                LastPingTime = FPlatformTime::Seconds();
+                        }
+                }
+                else if (!ReadResult.Error.IsEmpty())
+                {
+                        UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Read error: %s"), *ReadResult.Error);
+                        break;
+                }
+
+                // Requests still in flight count as activity; a long command must not idle the client out.
+                if (InFlightCount.GetValue() == 0 && (FPlatformTime::Seconds() - ProtocolClient->GetLastReceivedTime()) > IdleTimeoutSeconds)
+                {
+                        UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Inactivity timeout, closing connection"));
+                        break;
+                }
+        }
+}
+
+bool FMCPClientConnection::HandleProtocolMessage(const TSharedPtr<FJsonObject>& Message)
+{
+        using namespace UnrealMCP::Protocol;
+
+        if (!Message.IsValid())
+        {
+                return false;
+        }
+
+        FString MessageType;
+        if (!Message->TryGetStringField(TEXT("type"), MessageType))
+        {
+                TSharedRef<FJsonObject> Details = MakeShared<FJsonObject>();
+                Details->SetStringField(TEXT("reason"), TEXT("Missing 'type' field"));
+                TSharedRef<FJsonObject> ErrorResponse = MakeErrorResponse(EProtocolErrorCode::MalformedFrame, TEXT("Message missing 'type' field."), Details);
+
+                FString WriteError;
+                QueueMessage(ErrorResponse, EMCPOutboundKind::Response, WriteError);
+                return true;
+        }
+
+        if (MessageType.Equals(TEXT("ping"), ESearchCase::IgnoreCase))
+        {
+                double TimestampValue = 0.0;
+                Message->TryGetNumberField(TEXT("ts"), TimestampValue);
+                FString PongError;
+                if (!QueueMessage(MakePongMessage(static_cast<int64>(TimestampValue)), EMCPOutboundKind::Control, PongError))
+                {
+                        UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Failed to send pong: %s"), *PongError);
+                        return false;
+                }
+                return true;
+        }
+
+        if (MessageType.Equals(TEXT("pong"), ESearchCase::IgnoreCase))
+        {
+                return true;
+        }
+
+        if (MessageType.Equals(TEXT("shm/ready"), ESearchCase::IgnoreCase))
+        {
+                // The client has mapped the ring offered in the handshake ack; switch bulk payloads over.
+                FScopeLock SendLock(&SendMutex);
+                ProtocolClient->ActivateSharedMemory();
+                return true;
+        }
+
+        if (MessageType.Equals(TEXT("handshake"), ESearchCase::IgnoreCase))
+        {
+                UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Unexpected handshake message after initialization"));
+                return true;
+        }
+
+        if (MessageType.Equals(TEXT("capabilities"), ESearchCase::IgnoreCase))
+        {
+                bool bOk = false;
+                Message->TryGetBoolField(TEXT("ok"), bOk);
+
+                // Audits cost a plan and a JSON tree per mutation, so they are built only on request.
+                bool bAuditRequested = false;
+                if (bOk && Message->TryGetBoolField(TEXT("audit"), bAuditRequested))
+                {
+                        Session->SetAuditRequested(bAuditRequested);
+                }
+
+                if (bOk && Message->HasTypedField<EJson::Object>(TEXT("enforcement")))
+                {
+                        const TSharedPtr<FJsonObject> Enforcement = Message->GetObjectField(TEXT("enforcement"));
+
+                        // Unlike the rest of the enforcement, the share belongs to this session only.
+                        double Share = 1.0;
+                        if (Enforcement->TryGetNumberField(TEXT("share"), Share))
+                        {
+                                Session->SetSchedulingShare(FMath::Clamp(static_cast<float>(Share), FCommandScheduler::MinShare, FCommandScheduler::MaxShare));
+                        }
+
+                        bool bAllowWrite = false;
+                        Enforcement->TryGetBoolField(TEXT("allowWrite"), bAllowWrite);
+
+                        bool bDryRun = true;
+                        Enforcement->TryGetBoolField(TEXT("dryRun"), bDryRun);
+
+                        TArray<FString> AllowedPaths;
+                        if (Enforcement->HasTypedField<EJson::Array>(TEXT("allowedPaths")))
+                        {
+                                const TArray<TSharedPtr<FJsonValue>>& PathValues = Enforcement->GetArrayField(TEXT("allowedPaths"));
+                                for (const TSharedPtr<FJsonValue>& Value : PathValues)
+                                {
+                                        if (Value.IsValid() && Value->Type == EJson::String)
+                                        {
+                                                AllowedPaths.Add(Value->AsString());
+                                        }
+                                }
+                        }
+
+                        TArray<FString> AllowedTools;
+                        if (Enforcement->HasTypedField<EJson::Array>(TEXT("allowedTools")))
+                        {
+                                const TArray<TSharedPtr<FJsonValue>>& ToolValues = Enforcement->GetArrayField(TEXT("allowedTools"));
+                                for (const TSharedPtr<FJsonValue>& Value : ToolValues)
+                                {
+                                        if (Value.IsValid() && Value->Type == EJson::String)
+                                        {
+                                                AllowedTools.Add(Value->AsString());
+                                        }
+                                }
+                        }
+
+                        TArray<FString> DeniedTools;
+                        if (Enforcement->HasTypedField<EJson::Array>(TEXT("deniedTools")))
+                        {
+                                const TArray<TSharedPtr<FJsonValue>>& ToolValues = Enforcement->GetArrayField(TEXT("deniedTools"));
+                                for (const TSharedPtr<FJsonValue>& Value : ToolValues)
+                                {
+                                        if (Value.IsValid() && Value->Type == EJson::String)
+                                        {
+                                                DeniedTools.Add(Value->AsString());
+                                        }
+                                }
+                        }
+
+                        FWriteGate::UpdateRemoteEnforcement(bAllowWrite, bDryRun, AllowedPaths, AllowedTools, DeniedTools);
+                        Session->MarkEnforcementReceived();
+
+                        UE_LOG(LogUnrealMCP, Display, TEXT("[Protocol] Remote enforcement updated (allowWrite=%s, dryRun=%s, paths=%d, allowedTools=%d, deniedTools=%d)"),
+                                bAllowWrite ? TEXT("true") : TEXT("false"),
+                                bDryRun ? TEXT("true") : TEXT("false"),
+                                AllowedPaths.Num(),
+                                AllowedTools.Num(),
+                                DeniedTools.Num());
+                }
+
+                return true;
+        }
+
+        FString RequestId;
+        if (!Message->TryGetStringField(TEXT("requestId"), RequestId))
+        {
+                if (Message->HasTypedField<EJson::Object>(TEXT("meta")))
+                {
+                        const TSharedPtr<FJsonObject> MetaObject = Message->GetObjectField(TEXT("meta"));
+                        if (MetaObject.IsValid())
+                        {
+                                MetaObject->TryGetStringField(TEXT("requestId"), RequestId);
+                        }
+                }
+        }
+
+        if (MessageType.Equals(TEXT("cancel"), ESearchCase::IgnoreCase))
+        {
+                // No reply of its own: the cancelled request answers CANCELLED, or completes normally if it was too late.
+                FString TargetId = RequestId;
+                const TSharedPtr<FJsonObject>* CancelParams = nullptr;
+                if (Message->TryGetObjectField(TEXT("params"), CancelParams))
+                {
+                        (*CancelParams)->TryGetStringField(TEXT("requestId"), TargetId);
+                }
+
+                const bool bInFlight = !TargetId.IsEmpty() && Session->CancelRequest(TargetId);
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPClientConnection[%d]: Cancel requested for %s (%s)"), ConnectionId, *TargetId, bInFlight ? TEXT("in flight") : TEXT("not running"));
+                return true;
+        }
+
+        if (RequestId.IsEmpty())
+        {
+                RequestId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
+        }
+
+        if (MessageType.Equals(TEXT("subscribe"), ESearchCase::IgnoreCase) || MessageType.Equals(TEXT("unsubscribe"), ESearchCase::IgnoreCase))
+        {
+                HandleSubscription(Message, MessageType.Equals(TEXT("subscribe"), ESearchCase::IgnoreCase), RequestId);
+                return true;
+        }
+
+        // A client retrying after a reconnect must not run a mutation twice.
+        TSharedRef<FCommandContext, ESPMode::ThreadSafe> Context = MakeShared<FCommandContext, ESPMode::ThreadSafe>(RequestId);
+        Context->SetAuditRequested(Session->IsAuditRequested());
+        Context->SetScheduling(Session->GetSessionId(), Session->GetSchedulingShare());
+        TSharedPtr<FJsonObject> RememberedResponse;
+        const FMCPSession::ERequestState RequestState = Session->BeginRequest(RequestId, Context, RememberedResponse);
+        if (RequestState == FMCPSession::ERequestState::Completed)
+        {
+                FString ReplayError;
+                if (!QueueMessage(RememberedResponse.ToSharedRef(), EMCPOutboundKind::Response, ReplayError))
+                {
+                        UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Failed to replay response: %s"), *ReplayError);
+                        return false;
+                }
+                return true;
+        }
+        if (RequestState == FMCPSession::ERequestState::InFlight)
+        {
+                // Still running from before the reconnect; its response goes to the attached connection.
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPClientConnection[%d]: Request %s already in flight"), ConnectionId, *RequestId);
+                return true;
+        }
+
+        const FDateTime StartUtc = FDateTime::UtcNow();
+        FPendingRequest Pending;
+        Pending.MessageType = MessageType;
+        Pending.RequestId = RequestId;
+        Pending.StartSeconds = FPlatformTime::Seconds();
+        Pending.StartTsMs = static_cast<double>(StartUtc.ToUnixTimestamp()) * 1000.0 + StartUtc.GetMillisecond();
+
+        TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+        if (Message->HasField(TEXT("params")) && Message->HasTypedField<EJson::Object>(TEXT("params")))
+        {
+                Params = Message->GetObjectField(TEXT("params"));
+        }
+
+        TWeakPtr<FMCPClientConnection, ESPMode::ThreadSafe> WeakThis = AsShared();
+
+        bool bStreamRequested = false;
+        Message->TryGetBoolField(TEXT("stream"), bStreamRequested);
+        if (bStreamRequested)
+        {
+                Pending.Stream = MakeShared<FResponseStream, ESPMode::ThreadSafe>(RequestId, [WeakThis](const TSharedRef<FJsonObject>& Frame)
+                {
+                        TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection = WeakThis.Pin();
+                        if (!Connection.IsValid())
+                        {
+                                return false;
+                        }
+
+                        FString SendError;
+                        if (!Connection->QueueMessage(Frame, EMCPOutboundKind::Response, SendError))
+                        {
+                                UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Failed to send stream frame: %s"), *SendError);
+                                Connection->Stop();
+                                return false;
+                        }
+                        return true;
+                });
+        }
+
+        const TSharedPtr<FJsonObject>* RequestMeta = nullptr;
+        if (Message->TryGetObjectField(TEXT("meta"), RequestMeta))
+        {
+                double DeadlineMs = 0.0;
+                if ((*RequestMeta)->TryGetNumberField(TEXT("deadlineMs"), DeadlineMs))
+                {
+                        Context->SetDeadline(DeadlineMs);
+                }
+
+                // Unknown values fall back to the command's own lane rather than failing the request.
+                FString PriorityName;
+                UnrealMCP::Protocol::ECommandPriority Priority;
+                if ((*RequestMeta)->TryGetStringField(TEXT("priority"), PriorityName) && UnrealMCP::Protocol::LexTryParseString(Priority, *PriorityName))
+                {
+                        Context->SetPriority(Priority);
+                }
+
+                bool bAuditRequested = false;
+                if ((*RequestMeta)->TryGetBoolField(TEXT("audit"), bAuditRequested))
+                {
+                        Context->SetAuditRequested(bAuditRequested);
+                }
+
+                bool bUndoFreeRequested = false;
+                if ((*RequestMeta)->TryGetBoolField(TEXT("noUndo"), bUndoFreeRequested))
+                {
+                        Context->SetUndoFreeRequested(bUndoFreeRequested);
+                }
+        }
+
+        // Streamed chunks are encoded on their own, before the envelope that would carry segments.
+        Context->SetAttachmentsAllowed(ProtocolClient->IsAttachmentsEnabled() && !bStreamRequested);
+        Context->SetRequestAttachments(FAttachments::Find(*Message));
+
+        bool bProgressRequested = false;
+        Message->TryGetBoolField(TEXT("progress"), bProgressRequested);
+        if (bProgressRequested)
+        {
+                // Progress is advisory: under the drop-oldest policy it is shed like an event.
+                Context->SetProgressSink([WeakThis](const TSharedRef<FJsonObject>& Frame)
+                {
+                        TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection = WeakThis.Pin();
+                        FString SendError;
+                        return Connection.IsValid() && Connection->QueueMessage(Frame, EMCPOutboundKind::Event, SendError);
+                });
+        }
+
+        // Frames pushed after the response (viewport streams) follow the session across a resume and
+        // are shed like events under backpressure; one sent while no connection is attached is lost.
+        TWeakPtr<FMCPSession, ESPMode::ThreadSafe> WeakPushSession = Session;
+        Context->SetPushSink([WeakPushSession](const TSharedRef<FJsonObject>& Frame)
+        {
+                TSharedPtr<FMCPSession, ESPMode::ThreadSafe> PinnedSession = WeakPushSession.Pin();
+                if (!PinnedSession.IsValid())
+                {
+                        return false;
+                }
+                if (FMCPClientConnectionPtr Connection = PinnedSession->GetConnection())
+                {
+                        FString QueueError;
+                        Connection->QueueMessage(Frame, EMCPOutboundKind::Event, QueueError);
+                }
+                return true;
+        }, ProtocolClient->IsAttachmentsEnabled());
+
+        InFlightCount.Increment();
+
+        Pending.Context = Context;
+        TSharedPtr<FResponseStream, ESPMode::ThreadSafe> Stream = Pending.Stream;
+        TSharedRef<FMCPSession, ESPMode::ThreadSafe> RequestSession = Session.ToSharedRef();
+        Bridge->ExecuteCommandAsync(MessageType, Params, RequestId, [WeakThis, RequestSession, Pending = MoveTemp(Pending)](TSharedRef<FJsonObject> Response) mutable
+        {
+                // The completion fires on the game thread; hand the response back to a worker so
+                // encoding never blocks the editor frame.
+                AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis, RequestSession, Pending = MoveTemp(Pending), Response]()
+                {
+                        if (TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection = WeakThis.Pin())
+                        {
+                                Connection->CompleteRequest(Pending, Response);
+                        }
+                        else
+                        {
+                                // The connection is gone; keep the response for the client's resumed session.
+                                DeliverResponse(RequestSession, Pending.RequestId, Response, true, Pending.MessageType);
+                        }
+                });
+        }, Stream, Context);
+
+        return true;
+}
+
+void FMCPClientConnection::HandleSubscription(const TSharedPtr<FJsonObject>& Message, bool bSubscribe, const FString& RequestId)
+{
+        using namespace UnrealMCP::Protocol;
+
+        TArray<FString> Topics;
+        const TSharedPtr<FJsonObject>* Params = nullptr;
+        const TArray<TSharedPtr<FJsonValue>>* TopicValues = nullptr;
+        if (Message->TryGetObjectField(TEXT("params"), Params) && (*Params)->TryGetArrayField(TEXT("topics"), TopicValues))
+        {
+                for (const TSharedPtr<FJsonValue>& Value : *TopicValues)
+                {
+                        if (Value.IsValid() && Value->Type == EJson::String)
+                        {
+                                if (Value->AsString() == TEXT("*"))
+                                {
+                                        Topics.Append(FEventHub::GetTopicNames());
+                                }
+                                else
+                                {
+                                        Topics.Add(Value->AsString());
+                                }
+                        }
+                }
+        }
+
+        TSharedPtr<FEventHub, ESPMode::ThreadSafe> EventHub = Bridge->GetEventHub();
+        TSharedPtr<FJsonObject> Response;
+        if (!EventHub.IsValid())
+        {
+                Response = MakeErrorResponse(EProtocolErrorCode::InternalError, TEXT("Event subscriptions are not available."));
+        }
+        else if (bSubscribe && Topics.Num() == 0)
+        {
+                TSharedRef<FJsonObject> Details = MakeShared<FJsonObject>();
+                TArray<TSharedPtr<FJsonValue>> Known;
+                for (const FString& Name : FEventHub::GetTopicNames())
+                {
+                        Known.Add(MakeShared<FJsonValueString>(Name));
+                }
+                Details->SetArrayField(TEXT("topics"), Known);
+                Response = MakeErrorResponse(EProtocolErrorCode::UnsupportedMessage, TEXT("subscribe needs params.topics."), Details);
+        }
+        else
+        {
+                TArray<FString> UnknownTopics;
+                if (bSubscribe)
+                {
+                        // Route through the session so a resumed connection keeps receiving events.
+                        TWeakPtr<FMCPSession, ESPMode::ThreadSafe> WeakSession = Session;
+                        EventHub->Subscribe(SessionId, Topics, [WeakSession](const TSharedRef<FJsonObject>& Frame)
+                        {
+                                TSharedPtr<FMCPSession, ESPMode::ThreadSafe> PinnedSession = WeakSession.Pin();
+                                FMCPClientConnectionPtr Connection = PinnedSession.IsValid() ? PinnedSession->GetConnection() : nullptr;
+                                FString QueueError;
+                                return Connection.IsValid() && Connection->QueueMessage(Frame, EMCPOutboundKind::Event, QueueError);
+                        }, UnknownTopics);
+                }
+                else
+                {
+                        EventHub->Unsubscribe(SessionId, Topics);
+                }
+
+                TArray<TSharedPtr<FJsonValue>> Subscribed;
+                for (const FString& Name : EventHub->GetSubscribedTopics(SessionId))
+                {
+                        Subscribed.Add(MakeShared<FJsonValueString>(Name));
+                }
+
+                TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+                Result->SetArrayField(TEXT("topics"), Subscribed);
+                if (UnknownTopics.Num() > 0)
+                {
+                        TArray<TSharedPtr<FJsonValue>> Ignored;
+                        for (const FString& Name : UnknownTopics)
+                        {
+                                Ignored.Add(MakeShared<FJsonValueString>(Name));
+                        }
+                        Result->SetArrayField(TEXT("ignoredTopics"), Ignored);
+                }
+
+                Response = MakeShared<FJsonObject>();
+                Response->SetBoolField(TEXT("ok"), true);
+                Response->SetStringField(TEXT("status"), TEXT("success"));
+                Response->SetObjectField(TEXT("result"), Result);
+        }
+
+        TSharedRef<FJsonObject> Meta = MakeShared<FJsonObject>();
+        Meta->SetStringField(TEXT("requestId"), RequestId);
+        Response->SetObjectField(TEXT("meta"), Meta);
+
+        FString SendError;
+        if (!QueueMessage(Response.ToSharedRef(), EMCPOutboundKind::Response, SendError))
+        {
+                UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Failed to send %s response: %s"), bSubscribe ? TEXT("subscribe") : TEXT("unsubscribe"), *SendError);
+        }
+}
+
+void FMCPClientConnection::CompleteRequest(const FPendingRequest& Pending, const TSharedRef<FJsonObject>& ResponseObject)
+{
+        using namespace UnrealMCP::Protocol;
+
+        ON_SCOPE_EXIT
+        {
+                InFlightCount.Decrement();
+                if (SlotAvailableEvent)
+                {
+                        SlotAvailableEvent->Trigger();
+                }
+        };
+
+        const FString& MessageType = Pending.MessageType;
+        const FString& RequestId = Pending.RequestId;
+        const double StartTsMs = Pending.StartTsMs;
+
+        const double CompletedSeconds = FPlatformTime::Seconds();
+        const double DurationMs = (CompletedSeconds - Pending.StartSeconds) * 1000.0;
+        // The envelope is spliced in place; it is encoded exactly once, by QueueMessage.
+        TSharedPtr<FJsonObject> Meta = ResponseObject->HasTypedField<EJson::Object>(TEXT("meta"))
+                ? ResponseObject->GetObjectField(TEXT("meta"))
+                : MakeShared<FJsonObject>();
+        if (Meta.IsValid())
+        {
+                Meta->SetStringField(TEXT("requestId"), RequestId);
+                Meta->SetNumberField(TEXT("ts"), StartTsMs);
+                Meta->SetNumberField(TEXT("durMs"), DurationMs);
+                if (TSharedPtr<FJsonObject> Timings = MakeTimings(MessageType, Pending.Context.Get(), Pending.StartSeconds, CompletedSeconds))
+                {
+                        Meta->SetObjectField(TEXT("timings"), Timings);
+                }
+                if (TSharedPtr<FJsonObject> Memory = MakeMemory(MessageType, Pending.Context.Get()))
+                {
+                        Meta->SetObjectField(TEXT("memory"), Memory);
+                }
+                ResponseObject->SetObjectField(TEXT("meta"), Meta);
+        }
+
+        const bool bOk = ResponseObject->HasField(TEXT("ok")) ? ResponseObject->GetBoolField(TEXT("ok")) : false;
+        FString ErrorCode;
+        if (ResponseObject->HasField(TEXT("error")))
+        {
+                const TSharedPtr<FJsonObject> Error = ResponseObject->GetObjectField(TEXT("error"));
+                if (Error.IsValid())
+                {
+                        Error->TryGetStringField(TEXT("code"), ErrorCode);
+                }
+        }
+
+        // Aggregated in memory; the metrics file gets periodic snapshots, not a line per call.
+        FMetricsRegistry::RecordToolCall(MessageType, bOk, ErrorCode, DurationMs);
+        if (Recorder.IsValid())
+        {
+                Recorder->RecordResponse(ConnectionId, RequestId, MessageType, DurationMs, bOk);
+        }
+        UNREALMCP_TRACE_BOOKMARK(TEXT("MCP done %s %s (%s, %.1f ms)"), *MessageType, *RequestId, bOk ? TEXT("ok") : *ErrorCode, DurationMs);
+
+        TSharedPtr<FJsonObject> EventFields = MakeShared<FJsonObject>();
+        EventFields->SetBoolField(TEXT("ok"), bOk);
+        EventFields->SetNumberField(TEXT("durMs"), DurationMs);
+        if (!ErrorCode.IsEmpty())
+        {
+                EventFields->SetStringField(TEXT("code"), ErrorCode);
+        }
+        FLogEvent Event;
+        Event.Level = bOk ? TEXT("info") : TEXT("error");
+        Event.Category = FString::Printf(TEXT("tool.%s"), *MessageType);
+        Event.RequestId = RequestId;
+        Event.SessionId = SessionId;
+        Event.Message = FString::Printf(TEXT("Command %s completed"), *MessageType);
+        Event.Fields = EventFields;
+        Event.TsUnixMs = StartTsMs;
+        FJsonLogger::Log(Event);
+
+        if (Pending.Stream.IsValid() && Pending.Stream->HasBegun())
+        {
+                // Chunks may still be queued; the final envelope must follow them in order. Streamed
+                // responses are not remembered, so a retry after a drop runs the command again.
+                Session->CompleteRequest(RequestId, ResponseObject, false);
+                Pending.Stream->Finish(ResponseObject);
+                return;
+        }
+
+        if (Pending.Context.IsValid())
+        {
+                if (FAttachmentListPtr Attachments = Pending.Context->TakeAttachments())
+                {
+                        FAttachments::Bind(ResponseObject, MoveTemp(Attachments));
+                }
+        }
+        DeliverResponse(Session.ToSharedRef(), RequestId, ResponseObject, true, MessageType);
+}
+
+void FMCPClientConnection::DeliverResponse(const TSharedRef<FMCPSession, ESPMode::ThreadSafe>& InSession, const FString& RequestId, const TSharedRef<FJsonObject>& ResponseObject, bool bRemember, const FString& Tool)
+{
+        FMCPClientConnectionPtr Target = InSession->CompleteRequest(RequestId, ResponseObject, bRemember);
+        if (!Target.IsValid())
+        {
+                return;
+        }
+
+        FString SendError;
+        if (!Target->QueueMessage(ResponseObject, EMCPOutboundKind::Response, SendError, Tool))
+        {
+                UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Failed to send response: %s"), *SendError);
+                Target->Stop();
+        }
+}
+
+bool FMCPClientConnection::QueueMessage(const TSharedRef<FJsonObject>& Message, EMCPOutboundKind Kind, FString& OutError, const FString& TimedTool)
+{
+        if (!ProtocolClient.IsValid() || !Writer.IsValid())
+        {
+                OutError = TEXT("Connection is not initialized");
+                return false;
+        }
+
+        const double EncodeStart = FPlatformTime::Seconds();
+        TArray<uint8> Frame;
+        {
+                UNREALMCP_TRACE_SCOPE(MCP_EncodeFrame);
+                LLM_SCOPE_BYTAG(UnrealMCP);
+                if (!ProtocolClient->EncodeOutbound(Message, Frame, OutError))
+                {
+                        return false;
+                }
+        }
+        if (TimedTool.IsEmpty())
+        {
+                return Writer->Enqueue(MoveTemp(Frame), Kind, OutError);
+        }
+
+        // Both phases come after the envelope is encoded, so they can only go to the metrics.
+        const double Enqueued = FPlatformTime::Seconds();
+        FMetricsRegistry::RecordPhase(TimedTool, TEXT("serialize"), (Enqueued - EncodeStart) * 1000.0);
+        return Writer->Enqueue(MoveTemp(Frame), Kind, OutError, [TimedTool, Enqueued]()
+        {
+                FMetricsRegistry::RecordPhase(TimedTool, TEXT("send"), (FPlatformTime::Seconds() - Enqueued) * 1000.0);
+        });
+}
@@ -0,0 +1,223 @@
+#include "MCPConnectionWriter.h"
+#include "CoreMinimal.h"
+
+#include "UnrealMCPLog.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+FMCPConnectionWriter::FMCPConnectionWriter(int32 InConnectionId, int64 InMaxQueuedBytes, bool bInDisconnectWhenFull, FSendFrame InSendFrame, TFunction<void(const FString&)> InOnFailed, TFunction<void()> InOnCapacityAvailable)
+        : ConnectionId(InConnectionId)
+        , MaxQueuedBytes(FMath::Max<int64>(1, InMaxQueuedBytes))
+        , bDisconnectWhenFull(bInDisconnectWhenFull)
+        , SendFrame(MoveTemp(InSendFrame))
+        , OnFailed(MoveTemp(InOnFailed))
+        , OnCapacityAvailable(MoveTemp(InOnCapacityAvailable))
+        , QueuedBytes(0)
+        , DroppedEvents(0)
+        , Thread(nullptr)
+        , WorkEvent(FPlatformProcess::GetSynchEventFromPool(false))
+        , DrainedEvent(FPlatformProcess::GetSynchEventFromPool(true))
+        , bRunning(true)
+        , bFailed(false)
+{
+        DrainedEvent->Trigger();
+}
+
+FMCPConnectionWriter::~FMCPConnectionWriter()
+{
+        Shutdown();
+        FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+        FPlatformProcess::ReturnSynchEventToPool(DrainedEvent);
+}
+
+bool FMCPConnectionWriter::Start()
+{
+        const FString ThreadName = FString::Printf(TEXT("UnrealMCPWriter_%d"), ConnectionId);
+        Thread = FRunnableThread::Create(this, *ThreadName, 0, TPri_Normal);
+        return Thread != nullptr;
+}
+
+void FMCPConnectionWriter::Shutdown()
+{
+        Stop();
+        if (Thread)
+        {
+                Thread->WaitForCompletion();
+                delete Thread;
+                Thread = nullptr;
+        }
+
+        FScopeLock Lock(&QueueMutex);
+        ControlFrames.Empty();
+        DataFrames.Empty();
+        QueuedBytes = 0;
+        DrainedEvent->Trigger();
+}
+
+void FMCPConnectionWriter::Stop()
+{
+        bRunning = false;
+        WorkEvent->Trigger();
+}
+
+bool FMCPConnectionWriter::Enqueue(TArray<uint8>&& Frame, EMCPOutboundKind Kind, FString& OutError, TFunction<void()> OnSent)
+{
+        const int64 FrameBytes = Frame.Num();
+        {
+                FScopeLock Lock(&QueueMutex);
+                if (bFailed || !bRunning)
+                {
+                        OutError = TEXT("Connection writer is closed");
+                        return false;
+                }
+
+                // An empty queue always takes the frame, so one response larger than the cap still goes out.
+                const bool bFits = QueuedBytes == 0 || QueuedBytes + FrameBytes <= MaxQueuedBytes;
+                if (!bFits)
+                {
+                        if (bDisconnectWhenFull)
+                        {
+                                OutError = FString::Printf(TEXT("Client is not reading; outbound queue exceeded %lld bytes"), MaxQueuedBytes);
+                        }
+                        else if (!DropOldestEvents(FrameBytes) && Kind == EMCPOutboundKind::Event)
+                        {
+                                ++DroppedEvents;
+                                UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPClientConnection[%d]: Dropped event frame (%lld bytes), outbound queue full"), ConnectionId, FrameBytes);
+                                return true;
+                        }
+                }
+
+                if (OutError.IsEmpty())
+                {
+                        FQueuedFrame& Queued = Kind == EMCPOutboundKind::Control ? ControlFrames.AddDefaulted_GetRef() : DataFrames.AddDefaulted_GetRef();
+                        Queued.Bytes = MoveTemp(Frame);
+                        Queued.Kind = Kind;
+                        Queued.OnSent = MoveTemp(OnSent);
+                        QueuedBytes += FrameBytes;
+                        DrainedEvent->Reset();
+                }
+        }
+
+        if (!OutError.IsEmpty())
+        {
+                Fail(OutError);
+                return false;
+        }
+
+        WorkEvent->Trigger();
+        return true;
+}
+
+bool FMCPConnectionWriter::DropOldestEvents(int64 BytesNeeded)
+{
+        // Caller holds QueueMutex. Responses are never reclaimed, so the event may still not fit.
+        int32 Index = 0;
+        while (QueuedBytes + BytesNeeded > MaxQueuedBytes && Index < DataFrames.Num())
+        {
+                if (DataFrames[Index].Kind == EMCPOutboundKind::Event)
+                {
+                        QueuedBytes -= DataFrames[Index].Bytes.Num();
+                        DataFrames.RemoveAt(Index, 1, EAllowShrinking::No);
+                        ++DroppedEvents;
+                }
+                else
+                {
+                        ++Index;
+                }
+        }
+
+        return QueuedBytes + BytesNeeded <= MaxQueuedBytes;
+}
+
+bool FMCPConnectionWriter::Flush(double TimeoutSeconds)
+{
+        return DrainedEvent->Wait(FTimespan::FromSeconds(FMath::Max(0.0, TimeoutSeconds)));
+}
+
+bool FMCPConnectionWriter::IsOverCapacity() const
+{
+        FScopeLock Lock(&QueueMutex);
+        return QueuedBytes >= MaxQueuedBytes;
+}
+
+int64 FMCPConnectionWriter::GetQueuedBytes() const
+{
+        FScopeLock Lock(&QueueMutex);
+        return QueuedBytes;
+}
+
+void FMCPConnectionWriter::Fail(const FString& Error)
+{
+        if (bFailed.AtomicSet(true))
+        {
+                return;
+        }
+
+        bRunning = false;
+        WorkEvent->Trigger();
+        if (OnFailed)
+        {
+                OnFailed(Error);
+        }
+}
+
+uint32 FMCPConnectionWriter::Run()
+{
+        while (bRunning)
+        {
+                FQueuedFrame Next;
+                bool bHaveFrame = false;
+                {
+                        FScopeLock Lock(&QueueMutex);
+                        TArray<FQueuedFrame>& Source = ControlFrames.Num() > 0 ? ControlFrames : DataFrames;
+                        if (Source.Num() > 0)
+                        {
+                                Next = MoveTemp(Source[0]);
+                                Source.RemoveAt(0, 1, EAllowShrinking::No);
+                                bHaveFrame = true;
+                        }
+                        else
+                        {
+                                DrainedEvent->Trigger();
+                        }
+                }
+
+                if (!bHaveFrame)
+                {
+                        WorkEvent->Wait();
+                        continue;
+                }
+
+                const int64 FrameBytes = Next.Bytes.Num();
+                FString SendError;
+                const bool bSent = SendFrame(Next.Bytes, SendError);
+
+                bool bWasOverCapacity = false;
+                {
+                        FScopeLock Lock(&QueueMutex);
+                        bWasOverCapacity = QueuedBytes >= MaxQueuedBytes;
+                        QueuedBytes -= FrameBytes;
+                }
+
+                if (!bSent)
+                {
+                        Fail(SendError);
+                        break;
+                }
+
+                if (Next.OnSent)
+                {
+                        Next.OnSent();
+                }
+
+                if (bWasOverCapacity && !IsOverCapacity() && OnCapacityAvailable)
+                {
+                        OnCapacityAvailable();
+                }
+        }
+
+        return 0;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Templates/Function.h"
+
+class FRunnableThread;
+class FEvent;
+
+/** What an outbound frame carries; decides its priority and whether it may be dropped. */
+enum class EMCPOutboundKind : uint8
+{
+        /** Command responses and stream chunks. Never dropped. */
+        Response,
+        /** Server-pushed notifications. Dropped oldest-first when a slow client fills the queue. */
+        Event,
+        /** Heartbeats. Jump ahead of queued responses and events. */
+        Control
+};
+
+/**
+ * Drains a connection's outbound frames on its own thread so a slow client never stalls
+ * the thread reading its next request or the heartbeat. Frames arrive already encoded;
+ * the queue is bounded by bytes, and a client that falls behind either loses its oldest
+ * queued events or is disconnected, depending on the slow-client policy.
+ */
+class FMCPConnectionWriter : public FRunnable
+{
+public:
+        /** Writes one encoded frame to the client. Called only on the writer thread. */
+        typedef TFunction<bool(TArray<uint8>& Frame, FString& OutError)> FSendFrame;
+
+        FMCPConnectionWriter(int32 InConnectionId, int64 InMaxQueuedBytes, bool bInDisconnectWhenFull, FSendFrame InSendFrame, TFunction<void(const FString&)> InOnFailed, TFunction<void()> InOnCapacityAvailable);
+        virtual ~FMCPConnectionWriter();
+
+        bool Start();
+
+        /** Stops the thread and discards anything still queued. */
+        void Shutdown();
+
+        /**
+         * Queues Frame for sending. Returns false if the writer has failed or the disconnect
+         * policy refused the frame; an event dropped under the drop-oldest policy still returns true.
+         * OnSent, if set, runs on the writer thread once the frame is written.
+         */
+        bool Enqueue(TArray<uint8>&& Frame, EMCPOutboundKind Kind, FString& OutError, TFunction<void()> OnSent = nullptr);
+
+        /** Waits up to TimeoutSeconds for the queue to empty. Returns false on timeout. */
+        bool Flush(double TimeoutSeconds);
+
+        /** True while the queue holds at least the byte cap; the reader pauses until it drains. */
+        bool IsOverCapacity() const;
+
+        int64 GetQueuedBytes() const;
+        int32 GetDroppedEventCount() const { return DroppedEvents; }
+
+        // FRunnable interface
+        virtual uint32 Run() override;
+        virtual void Stop() override;
+
+private:
+        struct FQueuedFrame
+        {
+                TArray<uint8> Bytes;
+                EMCPOutboundKind Kind = EMCPOutboundKind::Response;
+                TFunction<void()> OnSent;
+        };
+
+        bool DropOldestEvents(int64 BytesNeeded);
+        void Fail(const FString& Error);
+
+        int32 ConnectionId;
+        int64 MaxQueuedBytes;
+        bool bDisconnectWhenFull;
+        FSendFrame SendFrame;
+        TFunction<void(const FString&)> OnFailed;
+        TFunction<void()> OnCapacityAvailable;
+
+        mutable FCriticalSection QueueMutex;
+        TArray<FQueuedFrame> ControlFrames;
+        TArray<FQueuedFrame> DataFrames;
+        /** Queued bytes plus the frame currently being sent. */
+        int64 QueuedBytes;
+        int32 DroppedEvents;
+
+        FRunnableThread* Thread;
+        FEvent* WorkEvent;
+        FEvent* DrainedEvent;
+        FThreadSafeBool bRunning;
+        FThreadSafeBool bFailed;
+};
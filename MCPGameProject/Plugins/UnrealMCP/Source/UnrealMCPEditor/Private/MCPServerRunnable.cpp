@@ -1,46 +1,44 @@
 #include "MCPServerRunnable.h"
 #include "CoreMinimal.h"
 
+#include "MCPClientConnection.h"
+#include "MCPSession.h"
+#include "Observability/TrafficRecorder.h"
+#include "Protocol/EventHub.h"
 #include "UnrealMCPBridge.h"
-#include "Protocol/Protocol.h"
-#include "Permissions/WriteGate.h"
 #include "UnrealMCPLog.h"
-#include "Observability/JsonLogger.h"
 
-#include "Sockets.h"
-#include "SocketSubsystem.h"
-#include "Interfaces/IPv4/IPv4Address.h"
-#include "Dom/JsonObject.h"
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
-#include "Misc/Guid.h"
-#include "Misc/DateTime.h"
-#include "Misc/EngineVersion.h"
-#include "HAL/PlatformProcess.h"
-#include "HAL/PlatformTime.h"
 
 namespace
 {
-        constexpr double ReceivePollSeconds = 1.0;
-        const TCHAR* ProtocolPluginVersion = TEXT("1.0.0");
-
-        FString GenerateSessionId()
-        {
-                return FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
-        }
+        // Upper bound on a single accept wait; Stop() wakes the wait immediately, this only paces reaping.
+        constexpr double AcceptWaitSeconds = 1.0;
 }
 
-FMCPServerRunnable::FMCPServerRunnable(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InListenerSocket, const FMCPServerConfig& InConfig)
+FMCPServerRunnable::FMCPServerRunnable(UUnrealMCPBridge* InBridge, UnrealMCP::Protocol::FStreamListenerPtr InListener, const FMCPServerConfig& InConfig)
         : Bridge(InBridge)
-        , ListenerSocket(InListenerSocket)
+        , Listener(InListener)
         , bRunning(true)
         , Config(InConfig)
+        , NextConnectionId(1)
+        , Sessions(MakeShared<FMCPSessionRegistry, ESPMode::ThreadSafe>(InConfig.SessionResumeWindowSeconds))
 {
+        if (!Config.TrafficCapturePath.IsEmpty())
+        {
+                FString Error;
+                Recorder = FTrafficRecorder::Open(Config.TrafficCapturePath, Error);
+                if (!Recorder.IsValid())
+                {
+                        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPServerRunnable: %s; traffic capture is off"), *Error);
+                }
+        }
+
         UE_LOG(LogUnrealMCP, Display, TEXT("MCPServerRunnable: Created server runnable"));
 }
 
 FMCPServerRunnable::~FMCPServerRunnable()
 {
+        CloseAllConnections();
 }
 
 bool FMCPServerRunnable::Init()
@@ -50,31 +48,23 @@ bool FMCPServerRunnable::Init()
 
 uint32 FMCPServerRunnable::Run()
 {
-        UE_LOG(LogUnrealMCP, Display, TEXT("MCPServerRunnable: Server thread starting..."));
+        UE_LOG(LogUnrealMCP, Display, TEXT("MCPServerRunnable: Server thread starting on %s (max %d connections)..."), *Listener->Describe(), Config.MaxConnections);
 
         while (bRunning)
         {
-                bool bPending = false;
-                if (ListenerSocket->HasPendingConnection(bPending) && bPending)
+                // Block until a client connects; Stop() shuts the listener down, which wakes the wait at once.
+                UnrealMCP::Protocol::FByteStreamPtr ClientStream = Listener->Accept(AcceptWaitSeconds);
+                if (ClientStream.IsValid() && bRunning)
                 {
-                        ClientSocket = MakeShareable(ListenerSocket->Accept(TEXT("MCPClient")));
-                        if (ClientSocket.IsValid())
-                        {
-                                UE_LOG(LogUnrealMCP, Display, TEXT("MCPServerRunnable: Client connection accepted"));
-
-                                ClientSocket->SetNoDelay(true);
-                                ClientSocket->SetNonBlocking(false);
-                                int32 SocketBufferSize = 65536;
-                                ClientSocket->SetSendBufferSize(SocketBufferSize, SocketBufferSize);
-                                ClientSocket->SetReceiveBufferSize(SocketBufferSize, SocketBufferSize);
-
-                                RunConnection(ClientSocket);
-                        }
+                        AcceptConnection(ClientStream);
                 }
 
-                FPlatformProcess::Sleep(0.05f);
+                ReapFinishedConnections();
+                ReleaseSessions(Sessions->PruneExpired());
         }
 
+        CloseAllConnections();
+
         UE_LOG(LogUnrealMCP, Display, TEXT("MCPServerRunnable: Server thread stopping"));
         return 0;
 }
@@ -82,306 +72,130 @@ uint32 FMCPServerRunnable::Run()
 void FMCPServerRunnable::Stop()
 {
         bRunning = false;
+        if (Listener.IsValid())
+        {
+                // Unblocks Accept on the server thread.
+                Listener->Shutdown();
+        }
 }
 
 void FMCPServerRunnable::Exit()
 {
 }
 
-void FMCPServerRunnable::RunConnection(const TSharedPtr<FSocket>& InClientSocket)
+int32 FMCPServerRunnable::GetConnectionCount() const
 {
-        using namespace UnrealMCP::Protocol;
-
-        if (!InClientSocket.IsValid())
-        {
-                return;
-        }
-
-        const FString EngineVersionString = FEngineVersion::Current().ToString();
-        const FString SessionId = GenerateSessionId();
-
-        FProtocolClient ProtocolClient(InClientSocket);
-        FString HandshakeError;
-        const double HandshakeTimeoutSeconds = FMath::Max(1.0, Config.HandshakeTimeoutSeconds);
-        const double IdleTimeoutSeconds = FMath::Max(1.0, Config.ReadTimeoutSeconds);
-        const double PingIntervalSeconds = FMath::Max(0.1, Config.HeartbeatIntervalSeconds);
-
-        if (!ProtocolClient.PerformHandshake(EngineVersionString, ProtocolPluginVersion, SessionId, HandshakeError, HandshakeTimeoutSeconds))
+        FScopeLock Lock(&ConnectionsMutex);
+        int32 Count = 0;
+        for (const TSharedPtr<FMCPClientConnection>& Connection : Connections)
         {
-                UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Handshake failed: %s"), *HandshakeError);
-                InClientSocket->Close();
-                return;
-        }
-
-        double LastPingTime = FPlatformTime::Seconds();
-
-        while (bRunning && InClientSocket->GetConnectionState() == SCS_Connected)
-        {
-                const double Now = FPlatformTime::Seconds();
-                const double SinceLastReceive = Now - ProtocolClient.GetLastReceivedTime();
-                const double ReadTimeout = FMath::Min(ReceivePollSeconds, FMath::Max(0.0, IdleTimeoutSeconds - SinceLastReceive));
-
-                FProtocolReadResult ReadResult = ProtocolClient.ReceiveMessage(ReadTimeout, false);
-                if (ReadResult.bSuccess && ReadResult.Message.IsValid())
-                {
-                        if (!HandleProtocolMessage(ProtocolClient, ReadResult.Message))
-                        {
-                                break;
-                        }
-                }
-                else if (ReadResult.bTimeout)
+                if (Connection.IsValid() && !Connection->IsFinished())
                 {
-                        if ((Now - LastPingTime) >= PingIntervalSeconds)
-                        {
-                                FString PingError;
-                                if (!ProtocolClient.SendPing(PingError))
-                                {
-                                        UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Failed to send ping: %s"), *PingError);
-                                        break;
-                                }
-
-                                LastPingTime = FPlatformTime::Seconds();
-                        }
-                }
-                else if (!ReadResult.Error.IsEmpty())
-                {
-                        UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Read error: %s"), *ReadResult.Error);
-                        break;
-                }
-
-                if ((FPlatformTime::Seconds() - ProtocolClient.GetLastReceivedTime()) > IdleTimeoutSeconds)
-                {
-                        UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Inactivity timeout, closing connection"));
-                        break;
+                        ++Count;
                 }
         }
+        return Count;
+}
 
-        InClientSocket->Close();
-        if (ClientSocket == InClientSocket)
+int32 FMCPServerRunnable::GetInFlightCount() const
+{
+        FScopeLock Lock(&ConnectionsMutex);
+        int32 Count = 0;
+        for (const TSharedPtr<FMCPClientConnection>& Connection : Connections)
         {
-                ClientSocket.Reset();
+                if (Connection.IsValid() && !Connection->IsFinished())
+                {
+                        Count += Connection->GetInFlightCount();
+                }
         }
+        return Count;
 }
 
-bool FMCPServerRunnable::HandleProtocolMessage(UnrealMCP::Protocol::FProtocolClient& ProtocolClient, const TSharedPtr<FJsonObject>& Message)
+void FMCPServerRunnable::AcceptConnection(const UnrealMCP::Protocol::FByteStreamPtr& InClientStream)
 {
-        using namespace UnrealMCP::Protocol;
-
-        if (!Message.IsValid())
-        {
-                return false;
-        }
+        ReapFinishedConnections();
 
-        FString MessageType;
-        if (!Message->TryGetStringField(TEXT("type"), MessageType))
+        const int32 MaxConnections = FMath::Max(1, Config.MaxConnections);
+        if (GetConnectionCount() >= MaxConnections)
         {
-                TSharedRef<FJsonObject> Details = MakeShared<FJsonObject>();
-                Details->SetStringField(TEXT("reason"), TEXT("Missing 'type' field"));
-                TSharedRef<FJsonObject> ErrorResponse = MakeErrorResponse(EProtocolErrorCode::MalformedFrame, TEXT("Message missing 'type' field."), Details);
-
-                FString WriteError;
-                ProtocolClient.SendMessage(ErrorResponse, WriteError);
-                return true;
+                UE_LOG(LogUnrealMCP, Warning, TEXT("MCPServerRunnable: Rejecting client, connection limit (%d) reached"), MaxConnections);
+                InClientStream->Close();
+                return;
         }
 
-        if (MessageType.Equals(TEXT("ping"), ESearchCase::IgnoreCase))
+        TSharedPtr<FMCPClientConnection> Connection;
         {
-                double TimestampValue = 0.0;
-                Message->TryGetNumberField(TEXT("ts"), TimestampValue);
-                FString PongError;
-                if (!ProtocolClient.SendPong(static_cast<int64>(TimestampValue), PongError))
-                {
-                        UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Failed to send pong: %s"), *PongError);
-                        return false;
-                }
-                return true;
+                FScopeLock Lock(&ConnectionsMutex);
+                Connection = MakeShared<FMCPClientConnection>(Bridge, InClientStream, Config, NextConnectionId++, Sessions, Recorder);
+                Connections.Add(Connection);
         }
 
-        if (MessageType.Equals(TEXT("pong"), ESearchCase::IgnoreCase))
-        {
-                return true;
-        }
+        UE_LOG(LogUnrealMCP, Display, TEXT("MCPServerRunnable: Client connection %d accepted"), Connection->GetConnectionId());
 
-        if (MessageType.Equals(TEXT("handshake"), ESearchCase::IgnoreCase))
+        if (!Connection->Start())
         {
-                UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Unexpected handshake message after initialization"));
-                return true;
+                UE_LOG(LogUnrealMCP, Error, TEXT("MCPServerRunnable: Failed to create thread for connection %d"), Connection->GetConnectionId());
+                InClientStream->Close();
         }
+}
 
-        if (MessageType.Equals(TEXT("capabilities"), ESearchCase::IgnoreCase))
+void FMCPServerRunnable::ReapFinishedConnections()
+{
+        TArray<TSharedPtr<FMCPClientConnection>> Finished;
         {
-                bool bOk = false;
-                Message->TryGetBoolField(TEXT("ok"), bOk);
-                if (bOk && Message->HasTypedField<EJson::Object>(TEXT("enforcement")))
+                FScopeLock Lock(&ConnectionsMutex);
+                for (int32 Index = Connections.Num() - 1; Index >= 0; --Index)
                 {
-                        const TSharedPtr<FJsonObject> Enforcement = Message->GetObjectField(TEXT("enforcement"));
-
-                        bool bAllowWrite = false;
-                        Enforcement->TryGetBoolField(TEXT("allowWrite"), bAllowWrite);
-
-                        bool bDryRun = true;
-                        Enforcement->TryGetBoolField(TEXT("dryRun"), bDryRun);
-
-                        TArray<FString> AllowedPaths;
-                        if (Enforcement->HasTypedField<EJson::Array>(TEXT("allowedPaths")))
-                        {
-                                const TArray<TSharedPtr<FJsonValue>>& PathValues = Enforcement->GetArrayField(TEXT("allowedPaths"));
-                                for (const TSharedPtr<FJsonValue>& Value : PathValues)
-                                {
-                                        if (Value.IsValid() && Value->Type == EJson::String)
-                                        {
-                                                AllowedPaths.Add(Value->AsString());
-                                        }
-                                }
-                        }
-
-                        TArray<FString> AllowedTools;
-                        if (Enforcement->HasTypedField<EJson::Array>(TEXT("allowedTools")))
-                        {
-                                const TArray<TSharedPtr<FJsonValue>>& ToolValues = Enforcement->GetArrayField(TEXT("allowedTools"));
-                                for (const TSharedPtr<FJsonValue>& Value : ToolValues)
-                                {
-                                        if (Value.IsValid() && Value->Type == EJson::String)
-                                        {
-                                                AllowedTools.Add(Value->AsString());
-                                        }
-                                }
-                        }
-
-                        TArray<FString> DeniedTools;
-                        if (Enforcement->HasTypedField<EJson::Array>(TEXT("deniedTools")))
+                        if (!Connections[Index].IsValid() || Connections[Index]->IsFinished())
                         {
-                                const TArray<TSharedPtr<FJsonValue>>& ToolValues = Enforcement->GetArrayField(TEXT("deniedTools"));
-                                for (const TSharedPtr<FJsonValue>& Value : ToolValues)
-                                {
-                                        if (Value.IsValid() && Value->Type == EJson::String)
-                                        {
-                                                DeniedTools.Add(Value->AsString());
-                                        }
-                                }
+                                Finished.Add(Connections[Index]);
+                                Connections.RemoveAtSwap(Index);
                         }
-
-                        FWriteGate::UpdateRemoteEnforcement(bAllowWrite, bDryRun, AllowedPaths, AllowedTools, DeniedTools);
-
-                        UE_LOG(LogUnrealMCP, Display, TEXT("[Protocol] Remote enforcement updated (allowWrite=%s, dryRun=%s, paths=%d, allowedTools=%d, deniedTools=%d)"),
-                                bAllowWrite ? TEXT("true") : TEXT("false"),
-                                bDryRun ? TEXT("true") : TEXT("false"),
-                                AllowedPaths.Num(),
-                                AllowedTools.Num(),
-                                DeniedTools.Num());
                 }
-
-                return true;
         }
 
-        FString RequestId;
-        if (!Message->TryGetStringField(TEXT("requestId"), RequestId))
+        // Join outside the lock; finished threads return immediately.
+        for (const TSharedPtr<FMCPClientConnection>& Connection : Finished)
         {
-                if (Message->HasTypedField<EJson::Object>(TEXT("meta")))
+                if (Connection.IsValid())
                 {
-                        const TSharedPtr<FJsonObject> MetaObject = Message->GetObjectField(TEXT("meta"));
-                        if (MetaObject.IsValid())
-                        {
-                                MetaObject->TryGetStringField(TEXT("requestId"), RequestId);
-                        }
+                        Connection->Shutdown();
                 }
         }
+}
 
-        if (RequestId.IsEmpty())
-        {
-                RequestId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
-        }
-
-        const FDateTime StartUtc = FDateTime::UtcNow();
-        const double StartSeconds = FPlatformTime::Seconds();
-        const double StartTsMs = static_cast<double>(StartUtc.ToUnixTimestamp()) * 1000.0 + StartUtc.GetMillisecond();
-
-        TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
-        if (Message->HasField(TEXT("params")) && Message->HasTypedField<EJson::Object>(TEXT("params")))
+void FMCPServerRunnable::CloseAllConnections()
+{
+        TArray<TSharedPtr<FMCPClientConnection>> Active;
         {
-                Params = Message->GetObjectField(TEXT("params"));
+                FScopeLock Lock(&ConnectionsMutex);
+                Active = MoveTemp(Connections);
+                Connections.Reset();
         }
 
-        const FString ResponseString = Bridge->ExecuteCommand(MessageType, Params, RequestId);
-        TSharedPtr<FJsonObject> ResponseObject;
+        for (const TSharedPtr<FMCPClientConnection>& Connection : Active)
         {
-                TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseString);
-                if (!FJsonSerializer::Deserialize(Reader, ResponseObject) || !ResponseObject.IsValid())
+                if (Connection.IsValid())
                 {
-                        TSharedRef<FJsonObject> Details = MakeShared<FJsonObject>();
-                        Details->SetStringField(TEXT("raw"), ResponseString);
-                        TSharedRef<FJsonObject> ErrorResponse = MakeErrorResponse(EProtocolErrorCode::InternalError, TEXT("Failed to parse command response."), Details);
-
-                        FString WriteError;
-                        ProtocolClient.SendMessage(ErrorResponse, WriteError);
-                        return true;
+                        Connection->Shutdown();
                 }
         }
 
-        const double DurationMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
-        TSharedPtr<FJsonObject> Meta = ResponseObject->HasTypedField<EJson::Object>(TEXT("meta"))
-                ? ResponseObject->GetObjectField(TEXT("meta"))
-                : MakeShared<FJsonObject>();
-        if (Meta.IsValid())
+        ReleaseSessions(Sessions->RemoveAll());
+}
+
+void FMCPServerRunnable::ReleaseSessions(const TArray<FString>& SessionIds)
+{
+        if (SessionIds.Num() == 0 || !Bridge)
         {
-                Meta->SetStringField(TEXT("requestId"), RequestId);
-                Meta->SetNumberField(TEXT("ts"), StartTsMs);
-                Meta->SetNumberField(TEXT("durMs"), DurationMs);
-                ResponseObject->SetObjectField(TEXT("meta"), Meta);
+                return;
         }
 
-        const bool bOk = ResponseObject->HasField(TEXT("ok")) ? ResponseObject->GetBoolField(TEXT("ok")) : false;
-        FString ErrorCode;
-        if (ResponseObject->HasField(TEXT("error")))
+        if (TSharedPtr<UnrealMCP::Protocol::FEventHub, ESPMode::ThreadSafe> EventHub = Bridge->GetEventHub())
         {
-                const TSharedPtr<FJsonObject> Error = ResponseObject->GetObjectField(TEXT("error"));
-                if (Error.IsValid())
+                for (const FString& SessionId : SessionIds)
                 {
-                        Error->TryGetStringField(TEXT("code"), ErrorCode);
+                        EventHub->Unsubscribe(SessionId, TArray<FString>());
                 }
         }
-
-        TSharedPtr<FJsonObject> MetricFields = MakeShared<FJsonObject>();
-        MetricFields->SetStringField(TEXT("tool"), MessageType);
-        MetricFields->SetBoolField(TEXT("ok"), bOk);
-        MetricFields->SetNumberField(TEXT("durMs"), DurationMs);
-        if (!ErrorCode.IsEmpty())
-        {
-                MetricFields->SetStringField(TEXT("errorCode"), ErrorCode);
-        }
-        FJsonLogger::Metric(TEXT("tool_duration_ms"), MetricFields);
-
-        TSharedPtr<FJsonObject> CounterFields = MakeShared<FJsonObject>();
-        CounterFields->SetStringField(TEXT("tool"), MessageType);
-        CounterFields->SetBoolField(TEXT("ok"), bOk);
-        if (!ErrorCode.IsEmpty())
-        {
-                CounterFields->SetStringField(TEXT("errorCode"), ErrorCode);
-        }
-        FJsonLogger::Metric(TEXT("tool_calls_total"), CounterFields);
-
-        TSharedPtr<FJsonObject> EventFields = MakeShared<FJsonObject>();
-        EventFields->SetBoolField(TEXT("ok"), bOk);
-        EventFields->SetNumberField(TEXT("durMs"), DurationMs);
-        if (!ErrorCode.IsEmpty())
-        {
-                EventFields->SetStringField(TEXT("code"), ErrorCode);
-        }
-        FLogEvent Event;
-        Event.Level = bOk ? TEXT("info") : TEXT("error");
-        Event.Category = FString::Printf(TEXT("tool.%s"), *MessageType);
-        Event.RequestId = RequestId;
-        Event.Message = FString::Printf(TEXT("Command %s completed"), *MessageType);
-        Event.Fields = EventFields;
-        Event.TsUnixMs = StartTsMs;
-        FJsonLogger::Log(Event);
-
-        FString SendError;
-        if (!ProtocolClient.SendMessage(ResponseObject, SendError))
-        {
-                UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Failed to send response: %s"), *SendError);
-                return false;
-        }
-
-        return true;
 }
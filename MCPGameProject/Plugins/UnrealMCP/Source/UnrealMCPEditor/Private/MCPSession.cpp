@@ -0,0 +1,230 @@
+#include "MCPSession.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Guid.h"
+#include "Misc/ScopeLock.h"
+#include "Protocol/CommandContext.h"
+
+namespace
+{
+        // Completed responses remembered per session for retried requestIds.
+        constexpr int32 MaxRememberedResponses = 64;
+}
+
+FMCPSession::FMCPSession(const FString& InSessionId)
+        : SessionId(InSessionId)
+        , DetachedSince(FPlatformTime::Seconds())
+        , bEnforcementReceived(false)
+        , bAuditRequested(false)
+        , SchedulingShare(1.0f)
+{
+}
+
+FString FMCPSession::GetResumeToken() const
+{
+        FScopeLock Lock(&Mutex);
+        return ResumeToken;
+}
+
+void FMCPSession::SetResumeToken(const FString& InToken)
+{
+        FScopeLock Lock(&Mutex);
+        ResumeToken = InToken;
+}
+
+FMCPClientConnectionPtr FMCPSession::Attach(const FMCPClientConnectionPtr& InConnection, TArray<TSharedRef<FJsonObject>>& OutUndelivered)
+{
+        FScopeLock Lock(&Mutex);
+        FMCPClientConnectionPtr Previous = Connection.Pin();
+        Connection = InConnection;
+
+        for (TPair<FString, FRequestRecord>& Pair : Requests)
+        {
+                if (Pair.Value.Response.IsValid() && !Pair.Value.bDelivered)
+                {
+                        OutUndelivered.Add(Pair.Value.Response.ToSharedRef());
+                        Pair.Value.bDelivered = true;
+                }
+        }
+        return Previous;
+}
+
+bool FMCPSession::Detach(const FMCPClientConnection* InConnection)
+{
+        FScopeLock Lock(&Mutex);
+        if (Connection.IsValid() && Connection.Pin().Get() != InConnection)
+        {
+                return false;
+        }
+        Connection.Reset();
+        DetachedSince = FPlatformTime::Seconds();
+        return true;
+}
+
+FMCPClientConnectionPtr FMCPSession::GetConnection() const
+{
+        FScopeLock Lock(&Mutex);
+        return Connection.Pin();
+}
+
+bool FMCPSession::IsExpired(double WindowSeconds) const
+{
+        FScopeLock Lock(&Mutex);
+        return !Connection.IsValid() && (FPlatformTime::Seconds() - DetachedSince) > WindowSeconds;
+}
+
+bool FMCPSession::HasEnforcement() const
+{
+        FScopeLock Lock(&Mutex);
+        return bEnforcementReceived;
+}
+
+void FMCPSession::MarkEnforcementReceived()
+{
+        FScopeLock Lock(&Mutex);
+        bEnforcementReceived = true;
+}
+
+bool FMCPSession::IsAuditRequested() const
+{
+        FScopeLock Lock(&Mutex);
+        return bAuditRequested;
+}
+
+void FMCPSession::SetAuditRequested(bool bInAuditRequested)
+{
+        FScopeLock Lock(&Mutex);
+        bAuditRequested = bInAuditRequested;
+}
+
+float FMCPSession::GetSchedulingShare() const
+{
+        FScopeLock Lock(&Mutex);
+        return SchedulingShare;
+}
+
+void FMCPSession::SetSchedulingShare(float InShare)
+{
+        FScopeLock Lock(&Mutex);
+        SchedulingShare = InShare;
+}
+
+FMCPSession::ERequestState FMCPSession::BeginRequest(const FString& RequestId, const TSharedRef<UnrealMCP::Protocol::FCommandContext, ESPMode::ThreadSafe>& Context, TSharedPtr<FJsonObject>& OutResponse)
+{
+        FScopeLock Lock(&Mutex);
+        if (FRequestRecord* Existing = Requests.Find(RequestId))
+        {
+                if (!Existing->Response.IsValid())
+                {
+                        return ERequestState::InFlight;
+                }
+                OutResponse = Existing->Response;
+                Existing->bDelivered = true;
+                return ERequestState::Completed;
+        }
+
+        Requests.Add(RequestId).Context = Context;
+        return ERequestState::New;
+}
+
+bool FMCPSession::CancelRequest(const FString& RequestId)
+{
+        FScopeLock Lock(&Mutex);
+        const FRequestRecord* Record = Requests.Find(RequestId);
+        if (!Record || !Record->Context.IsValid())
+        {
+                return false;
+        }
+        Record->Context->Cancel();
+        return true;
+}
+
+FMCPClientConnectionPtr FMCPSession::CompleteRequest(const FString& RequestId, const TSharedRef<FJsonObject>& Response, bool bRemember)
+{
+        FScopeLock Lock(&Mutex);
+        FMCPClientConnectionPtr Target = Connection.Pin();
+
+        if (!bRemember)
+        {
+                Requests.Remove(RequestId);
+                return Target;
+        }
+
+        FRequestRecord& Record = Requests.FindOrAdd(RequestId);
+        Record.Response = Response;
+        Record.Context.Reset();
+        Record.bDelivered = Target.IsValid();
+
+        CompletedOrder.Add(RequestId);
+        if (CompletedOrder.Num() > MaxRememberedResponses)
+        {
+                Requests.Remove(CompletedOrder[0]);
+                CompletedOrder.RemoveAt(0, 1, EAllowShrinking::No);
+        }
+        return Target;
+}
+
+FMCPSessionRegistry::FMCPSessionRegistry(double InResumeWindowSeconds)
+        : ResumeWindowSeconds(FMath::Max(0.0, InResumeWindowSeconds))
+{
+}
+
+FMCPSessionPtr FMCPSessionRegistry::Open(const FString& Token, bool& bOutResumed)
+{
+        bOutResumed = false;
+        if (!IsResumable())
+        {
+                return MakeShared<FMCPSession, ESPMode::ThreadSafe>(FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens));
+        }
+
+        FScopeLock Lock(&Mutex);
+        FMCPSessionPtr Session;
+        if (!Token.IsEmpty() && SessionsByToken.RemoveAndCopyValue(Token, Session) && !Session->IsExpired(ResumeWindowSeconds))
+        {
+                bOutResumed = true;
+        }
+        else
+        {
+                Session = MakeShared<FMCPSession, ESPMode::ThreadSafe>(FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens));
+        }
+
+        const FString NewToken = GenerateToken();
+        Session->SetResumeToken(NewToken);
+        SessionsByToken.Add(NewToken, Session);
+        return Session;
+}
+
+TArray<FString> FMCPSessionRegistry::PruneExpired()
+{
+        TArray<FString> Expired;
+        FScopeLock Lock(&Mutex);
+        for (auto It = SessionsByToken.CreateIterator(); It; ++It)
+        {
+                if (It.Value()->IsExpired(ResumeWindowSeconds))
+                {
+                        Expired.Add(It.Value()->GetSessionId());
+                        It.RemoveCurrent();
+                }
+        }
+        return Expired;
+}
+
+TArray<FString> FMCPSessionRegistry::RemoveAll()
+{
+        TArray<FString> SessionIds;
+        FScopeLock Lock(&Mutex);
+        for (const TPair<FString, FMCPSessionPtr>& Pair : SessionsByToken)
+        {
+                SessionIds.Add(Pair.Value->GetSessionId());
+        }
+        SessionsByToken.Empty();
+        return SessionIds;
+}
+
+FString FMCPSessionRegistry::GenerateToken()
+{
+        // Two GUIDs back to back (64 hex digits) so a token is not guessable from a single GUID.
+        return FGuid::NewGuid().ToString(EGuidFormats::Digits) + FGuid::NewGuid().ToString(EGuidFormats::Digits);
+}
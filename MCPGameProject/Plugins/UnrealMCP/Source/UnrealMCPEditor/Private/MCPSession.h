@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+
+class FJsonObject;
+class FMCPClientConnection;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+        class FCommandContext;
+}
+}
+
+typedef TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> FMCPClientConnectionPtr;
+
+/**
+ * Client state that outlives a single connection. A client that reconnects with the session's
+ * resume token gets it back: remote enforcement already applied, event subscriptions (keyed by
+ * session id) and the responses it may not have received, so it can go straight to commands.
+ *
+ * Requests are remembered by requestId: a retry of a request that is still running is not
+ * dispatched again, and a retry of a completed one is answered from the remembered response.
+ */
+class FMCPSession
+{
+public:
+        enum class ERequestState : uint8
+        {
+                New,
+                InFlight,
+                Completed
+        };
+
+        explicit FMCPSession(const FString& InSessionId);
+
+        const FString& GetSessionId() const { return SessionId; }
+        FString GetResumeToken() const;
+        void SetResumeToken(const FString& InToken);
+
+        /**
+         * Makes Connection the session's live connection and returns the one it replaced, which
+         * may still be running if it has not noticed its client went away. OutUndelivered gets the
+         * responses that completed while no connection was attached.
+         */
+        FMCPClientConnectionPtr Attach(const FMCPClientConnectionPtr& Connection, TArray<TSharedRef<FJsonObject>>& OutUndelivered);
+
+        /** Detaches Connection if it is still the live one. Returns false if another connection took over. */
+        bool Detach(const FMCPClientConnection* Connection);
+
+        FMCPClientConnectionPtr GetConnection() const;
+
+        /** True once detached for longer than WindowSeconds (never-attached sessions count from creation). */
+        bool IsExpired(double WindowSeconds) const;
+
+        bool HasEnforcement() const;
+        void MarkEnforcementReceived();
+
+        /** Set from the client's capabilities message: whether its requests default to carrying audits. */
+        bool IsAuditRequested() const;
+        void SetAuditRequested(bool bInAuditRequested);
+
+        /** Set from the client's capabilities message (enforcement.share): its weight against other sessions on the game thread. */
+        float GetSchedulingShare() const;
+        void SetSchedulingShare(float InShare);
+
+        /**
+         * Registers RequestId as in flight with Context if it is new. OutResponse is set when it
+         * already completed.
+         */
+        ERequestState BeginRequest(const FString& RequestId, const TSharedRef<UnrealMCP::Protocol::FCommandContext, ESPMode::ThreadSafe>& Context, TSharedPtr<FJsonObject>& OutResponse);
+
+        /** Flags RequestId's context as cancelled. Returns false if it is not in flight. */
+        bool CancelRequest(const FString& RequestId);
+
+        /**
+         * Records the response for RequestId and returns the connection to send it on, or null if
+         * none is attached (it is replayed on the next Attach). Streamed responses are not kept.
+         */
+        FMCPClientConnectionPtr CompleteRequest(const FString& RequestId, const TSharedRef<FJsonObject>& Response, bool bRemember);
+
+private:
+        struct FRequestRecord
+        {
+                TSharedPtr<FJsonObject> Response;
+                /** Set while the request is in flight, so a cancel (even after a resume) reaches it. */
+                TSharedPtr<UnrealMCP::Protocol::FCommandContext, ESPMode::ThreadSafe> Context;
+                bool bDelivered = false;
+        };
+
+        FString SessionId;
+        FString ResumeToken;
+
+        mutable FCriticalSection Mutex;
+        TWeakPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection;
+        double DetachedSince;
+        bool bEnforcementReceived;
+        bool bAuditRequested;
+        float SchedulingShare;
+        TMap<FString, FRequestRecord> Requests;
+        /** Completed requestIds, oldest first, so the record stays bounded. */
+        TArray<FString> CompletedOrder;
+};
+
+typedef TSharedPtr<FMCPSession, ESPMode::ThreadSafe> FMCPSessionPtr;
+
+/**
+ * Sessions of one server, indexed by resume token. Tokens are rotated on every resume,
+ * so a token is good for exactly one reconnect.
+ */
+class FMCPSessionRegistry
+{
+public:
+        explicit FMCPSessionRegistry(double InResumeWindowSeconds);
+
+        /** 0 disables resumption: sessions are never looked up by token and expire as soon as they detach. */
+        bool IsResumable() const { return ResumeWindowSeconds > 0.0; }
+
+        /** Resumes the session that issued Token, or opens a fresh one. */
+        FMCPSessionPtr Open(const FString& Token, bool& bOutResumed);
+
+        /** Drops sessions detached for longer than the resume window and returns their ids. */
+        TArray<FString> PruneExpired();
+
+        /** Drops every session (server shutdown) and returns their ids. */
+        TArray<FString> RemoveAll();
+
+private:
+        static FString GenerateToken();
+
+        double ResumeWindowSeconds;
+        FCriticalSection Mutex;
+        TMap<FString, FMCPSessionPtr> SessionsByToken;
+};
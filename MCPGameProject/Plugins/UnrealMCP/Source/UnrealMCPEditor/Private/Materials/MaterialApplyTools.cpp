@@ -1,7 +1,9 @@
 #include "Materials/MaterialApplyTools.h"
 #include "CoreMinimal.h"
 
+#include "Actors/ActorIndex.h"
 #include "Algo/Transform.h"
+#include "Assets/PackagePrefetch.h"
 #include "Components/MeshComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/StaticMeshComponent.h"
@@ -16,8 +18,10 @@
 #include "Engine/World.h"
 #include "EngineUtils.h"
 #include "Materials/MaterialInterface.h"
+#include "Materials/ShaderCompileWait.h"
 #include "Misc/PackageName.h"
 #include "Permissions/WriteGate.h"
+#include "Protocol/CommandContext.h"
 #include "UObject/Package.h"
 #include "UObject/UObjectGlobals.h"
 
@@ -107,18 +111,7 @@ namespace
             return Existing;
         }
 
-        if (UWorld* World = GetEditorWorld())
-        {
-            for (TActorIterator<AActor> It(World); It; ++It)
-            {
-                if (It->GetPathName() == Trimmed || It->GetName() == Trimmed)
-                {
-                    return *It;
-                }
-            }
-        }
-
-        return nullptr;
+        return FActorIndex::Get().Resolve(GetEditorWorld(), Trimmed);
     }
 
     UMeshComponent* ResolveMeshComponent(AActor& Actor, const FString& ComponentName)
@@ -239,6 +232,257 @@ namespace
 
         AuditActions.Add(MakeShared<FJsonValueObject>(ActionObject));
     }
+
+    /** Meshes one mesh.remap_material_slots call may take. */
+    constexpr int32 MaxMeshesPerRequest = 1000;
+
+    /** One mesh's new slot layout, worked out before any mesh is touched. */
+    struct FRemapPlan
+    {
+        FString MeshObjectPath;
+        UStaticMesh* StaticMesh = nullptr;
+        /** Old slot index each new slot takes its material from. */
+        TArray<int32> SourceIndices;
+        TArray<FStaticMaterial> NewMaterials;
+        TArray<int32> OldToNew;
+        TArray<TPair<FName, FName>> AppliedRenames;
+        TArray<FString> ReorderedNames;
+        bool bHasReorder = false;
+    };
+
+    /**
+     * Validates Spec (meshObjectPath, rename, reorder, fillMissingWith) and works out the mesh's
+     * new slots into Out without modifying it. Null on success, else the error response.
+     */
+    TSharedPtr<FJsonObject> PlanRemap(const TSharedPtr<FJsonObject>& Spec, FRemapPlan& Out)
+    {
+        FString MeshObjectPath;
+        if (!Spec->TryGetStringField(TEXT("meshObjectPath"), MeshObjectPath) || MeshObjectPath.TrimStartAndEnd().IsEmpty())
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing meshObjectPath"));
+        }
+
+        MeshObjectPath.TrimStartAndEndInline();
+        Out.MeshObjectPath = MeshObjectPath;
+
+        const FString PackagePath = NormalizeContentPath(MeshObjectPath.Contains(TEXT(".")) ? FPackageName::ObjectPathToPackageName(MeshObjectPath) : MeshObjectPath);
+        if (PackagePath.IsEmpty())
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Invalid meshObjectPath"));
+        }
+
+        FString PathReason;
+        if (!FWriteGate::IsPathAllowed(PackagePath, PathReason))
+        {
+            return MakeErrorResponse(TEXT("PATH_NOT_ALLOWED"), PathReason);
+        }
+
+        UObject* MeshObject = LoadObject<UObject>(nullptr, *BuildObjectPath(PackagePath));
+        if (!MeshObject)
+        {
+            return MakeErrorResponse(ErrorCodeAssetNotFound, FString::Printf(TEXT("Mesh asset not found: %s"), *MeshObjectPath));
+        }
+
+        Out.StaticMesh = Cast<UStaticMesh>(MeshObject);
+        if (!Out.StaticMesh)
+        {
+            return MakeErrorResponse(ErrorCodeUnsupportedMesh, TEXT("Only static meshes are supported"));
+        }
+
+        const TArray<FStaticMaterial>& StaticMaterials = Out.StaticMesh->GetStaticMaterials();
+        TArray<FName> SlotNames;
+        SlotNames.Reserve(StaticMaterials.Num());
+        for (const FStaticMaterial& Material : StaticMaterials)
+        {
+            SlotNames.Add(Material.MaterialSlotName);
+        }
+
+        const TSharedPtr<FJsonObject>* RenameObject = nullptr;
+        if (Spec->TryGetObjectField(TEXT("rename"), RenameObject) && RenameObject && RenameObject->IsValid() && (*RenameObject)->Values.Num() > 0)
+        {
+            TSet<FName> PendingNames(SlotNames);
+
+            for (const auto& Pair : (*RenameObject)->Values)
+            {
+                const FString& OldNameString = Pair.Key;
+                if (!Pair.Value.IsValid() || Pair.Value->Type != EJson::String)
+                {
+                    return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Rename values must be strings"));
+                }
+
+                const FString NewNameString = Pair.Value->AsString();
+                const FName OldName(*OldNameString);
+                const FName NewName(*NewNameString);
+
+                const int32 Index = SlotNames.IndexOfByKey(OldName);
+                if (Index == INDEX_NONE)
+                {
+                    continue;
+                }
+
+                if (PendingNames.Contains(NewName) && NewName != OldName)
+                {
+                    return MakeErrorResponse(ErrorCodeSlotConflict, FString::Printf(TEXT("Slot name conflict: %s"), *NewNameString));
+                }
+
+                PendingNames.Remove(OldName);
+                PendingNames.Add(NewName);
+
+                SlotNames[Index] = NewName;
+                Out.AppliedRenames.Emplace(OldName, NewName);
+            }
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* ReorderArray = nullptr;
+        Out.bHasReorder = Spec->TryGetArrayField(TEXT("reorder"), ReorderArray) && ReorderArray && ReorderArray->Num() > 0;
+
+        FString FillMissingName;
+        Spec->TryGetStringField(TEXT("fillMissingWith"), FillMissingName);
+        FName FillMissingFName = FillMissingName.IsEmpty() ? NAME_None : FName(*FillMissingName);
+
+        TArray<FName> FinalNames = SlotNames;
+
+        if (Out.bHasReorder)
+        {
+            if (ReorderArray->Num() != SlotNames.Num())
+            {
+                return MakeErrorResponse(ErrorCodeReorderInvalid, TEXT("Reorder array must match slot count"));
+            }
+
+            TMap<FName, int32> NameToIndex;
+            for (int32 Index = 0; Index < SlotNames.Num(); ++Index)
+            {
+                NameToIndex.Add(SlotNames[Index], Index);
+            }
+
+            Out.SourceIndices.Reserve(ReorderArray->Num());
+            FinalNames.Reset(ReorderArray->Num());
+
+            for (const TSharedPtr<FJsonValue>& Value : *ReorderArray)
+            {
+                if (!Value.IsValid() || Value->Type != EJson::String)
+                {
+                    return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Reorder entries must be strings"));
+                }
+
+                const FString SlotNameString = Value->AsString();
+                const FName SlotName(*SlotNameString);
+
+                int32* FoundIndex = NameToIndex.Find(SlotName);
+                if (!FoundIndex && FillMissingFName != NAME_None)
+                {
+                    FoundIndex = NameToIndex.Find(FillMissingFName);
+                }
+
+                if (!FoundIndex)
+                {
+                    return MakeErrorResponse(ErrorCodeReorderInvalid, FString::Printf(TEXT("Reorder reference missing slot: %s"), *SlotNameString));
+                }
+
+                Out.SourceIndices.Add(*FoundIndex);
+                FinalNames.Add(SlotName);
+            }
+        }
+        else
+        {
+            Out.SourceIndices.Reserve(StaticMaterials.Num());
+            for (int32 Index = 0; Index < StaticMaterials.Num(); ++Index)
+            {
+                Out.SourceIndices.Add(Index);
+            }
+        }
+
+        Out.NewMaterials.SetNum(Out.SourceIndices.Num());
+        for (int32 NewIndex = 0; NewIndex < Out.SourceIndices.Num(); ++NewIndex)
+        {
+            const int32 SourceIndex = Out.SourceIndices[NewIndex];
+            if (!StaticMaterials.IsValidIndex(SourceIndex))
+            {
+                return MakeErrorResponse(ErrorCodeReorderInvalid, TEXT("Reorder index out of range"));
+            }
+
+            FStaticMaterial& Destination = Out.NewMaterials[NewIndex];
+            Destination = StaticMaterials[SourceIndex];
+            if (FinalNames.IsValidIndex(NewIndex))
+            {
+                Destination.MaterialSlotName = FinalNames[NewIndex];
+            }
+        }
+
+        Out.OldToNew.Init(INDEX_NONE, StaticMaterials.Num());
+        for (int32 NewIndex = 0; NewIndex < Out.SourceIndices.Num(); ++NewIndex)
+        {
+            const int32 OldIndex = Out.SourceIndices[NewIndex];
+            if (!Out.OldToNew.IsValidIndex(OldIndex) || Out.OldToNew[OldIndex] == INDEX_NONE)
+            {
+                Out.OldToNew[OldIndex] = NewIndex;
+            }
+        }
+
+        Algo::Transform(Out.NewMaterials, Out.ReorderedNames, [](const FStaticMaterial& Material)
+        {
+            return Material.MaterialSlotName.ToString();
+        });
+        return nullptr;
+    }
+
+    /** Writes Plan's slots and section material indices into its mesh. */
+    void ApplyRemap(const FRemapPlan& Plan)
+    {
+        UStaticMesh* StaticMesh = Plan.StaticMesh;
+        StaticMesh->Modify();
+        StaticMesh->GetStaticMaterials() = Plan.NewMaterials;
+
+        FMeshSectionInfoMap& SectionInfoMap = StaticMesh->GetSectionInfoMap();
+        for (auto It = SectionInfoMap.Map.CreateIterator(); It; ++It)
+        {
+            FMeshSectionInfo& Info = It.Value();
+            if (Plan.OldToNew.IsValidIndex(Info.MaterialIndex) && Plan.OldToNew[Info.MaterialIndex] != INDEX_NONE)
+            {
+                Info.MaterialIndex = Plan.OldToNew[Info.MaterialIndex];
+            }
+        }
+
+        StaticMesh->MarkPackageDirty();
+        StaticMesh->PostEditChange();
+    }
+
+    /** The slotChanges object and audit actions reporting Plan. */
+    TSharedPtr<FJsonObject> BuildSlotChanges(const FRemapPlan& Plan, TArray<TSharedPtr<FJsonValue>>& AuditActions)
+    {
+        TSharedPtr<FJsonObject> SlotChanges = MakeShared<FJsonObject>();
+
+        TArray<TSharedPtr<FJsonValue>> RenamedArray;
+        for (const TPair<FName, FName>& Rename : Plan.AppliedRenames)
+        {
+            TSharedPtr<FJsonObject> RenameObjectJson = MakeShared<FJsonObject>();
+            RenameObjectJson->SetStringField(TEXT("from"), Rename.Key.ToString());
+            RenameObjectJson->SetStringField(TEXT("to"), Rename.Value.ToString());
+            RenamedArray.Add(MakeShared<FJsonValueObject>(RenameObjectJson));
+        }
+        SlotChanges->SetArrayField(TEXT("renamed"), RenamedArray);
+        AppendStringArrayField(SlotChanges, TEXT("reordered"), Plan.ReorderedNames);
+
+        if (Plan.AppliedRenames.Num() > 0)
+        {
+            TSharedPtr<FJsonObject> RenameAction = MakeShared<FJsonObject>();
+            RenameAction->SetStringField(TEXT("op"), TEXT("rename_slots"));
+            RenameAction->SetStringField(TEXT("mesh"), Plan.MeshObjectPath);
+            RenameAction->SetArrayField(TEXT("pairs"), RenamedArray);
+            AuditActions.Add(MakeShared<FJsonValueObject>(RenameAction));
+        }
+
+        if (Plan.bHasReorder && Plan.SourceIndices.Num() > 0)
+        {
+            TSharedPtr<FJsonObject> ReorderAction = MakeShared<FJsonObject>();
+            ReorderAction->SetStringField(TEXT("op"), TEXT("reorder_slots"));
+            ReorderAction->SetStringField(TEXT("mesh"), Plan.MeshObjectPath);
+            AppendStringArrayField(ReorderAction, TEXT("order"), Plan.ReorderedNames);
+            AuditActions.Add(MakeShared<FJsonValueObject>(ReorderAction));
+        }
+
+        return SlotChanges;
+    }
 }
 
 TSharedPtr<FJsonObject> FMaterialApplyTools::BatchApply(const TSharedPtr<FJsonObject>& Params)
@@ -254,6 +498,33 @@ TSharedPtr<FJsonObject> FMaterialApplyTools::BatchApply(const TSharedPtr<FJsonOb
         return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing targets array"));
     }
 
+    // Every material the targets name is loaded side by side before any of them is resolved below.
+    TArray<FString> MaterialPaths;
+    for (const TSharedPtr<FJsonValue>& TargetValue : *TargetsArray)
+    {
+        const TSharedPtr<FJsonObject>* TargetObject = nullptr;
+        const TArray<TSharedPtr<FJsonValue>>* AssignArray = nullptr;
+        if (!TargetValue.IsValid() || !TargetValue->TryGetObject(TargetObject) || !(*TargetObject)->TryGetArrayField(TEXT("assign"), AssignArray))
+        {
+            continue;
+        }
+        for (const TSharedPtr<FJsonValue>& AssignValue : *AssignArray)
+        {
+            const TSharedPtr<FJsonObject>* AssignObject = nullptr;
+            FString MiPath;
+            if (AssignValue.IsValid() && AssignValue->TryGetObject(AssignObject) && (*AssignObject)->TryGetStringField(TEXT("mi"), MiPath))
+            {
+                MaterialPaths.Add(MoveTemp(MiPath));
+            }
+        }
+    }
+    TSharedPtr<FJsonObject> PrefetchResponse;
+    TSharedPtr<FJsonObject> PrefetchStats;
+    if (!FPackagePrefetch::Await(MaterialPaths, PrefetchResponse, &PrefetchStats))
+    {
+        return PrefetchResponse;
+    }
+
     const bool bStrict = !Params->HasField(TEXT("strict")) || Params->GetBoolField(TEXT("strict"));
     const bool bSaveActors = Params->HasField(TEXT("saveActors")) && Params->GetBoolField(TEXT("saveActors"));
 
@@ -263,11 +534,27 @@ TSharedPtr<FJsonObject> FMaterialApplyTools::BatchApply(const TSharedPtr<FJsonOb
         return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("No editor world available"));
     }
 
-    TArray<TSharedPtr<FJsonValue>> AppliedItems;
+    struct FAssignment
+    {
+        UMeshComponent* Component = nullptr;
+        AActor* Actor = nullptr;
+        int32 SlotIndex = INDEX_NONE;
+        UMaterialInterface* Material = nullptr;
+        FString ActorPath;
+        FString ComponentName;
+        FString MiPath;
+        /** The slot as the request named it, when by name. */
+        FString SlotName;
+    };
+
     TArray<TSharedPtr<FJsonValue>> SkippedItems;
-    TArray<TSharedPtr<FJsonValue>> AuditActions;
+    TArray<FAssignment> Assignments;
 
-    TSet<UPackage*> PackagesToSave;
+    // Every target is resolved before any component changes, so a bad entry fails the request without
+    // a partial apply. Re-skinning thousands of props names the same levels and materials over and
+    // over, so their checks and loads are done once per request.
+    TMap<UPackage*, TPair<bool, FString>> LevelPathChecks;
+    TMap<FString, UMaterialInterface*> Materials;
 
     for (const TSharedPtr<FJsonValue>& TargetValue : *TargetsArray)
     {
@@ -294,21 +581,20 @@ TSharedPtr<FJsonObject> FMaterialApplyTools::BatchApply(const TSharedPtr<FJsonOb
             return MakeErrorResponse(ErrorCodeActorNotFound, FString::Printf(TEXT("Actor not found: %s"), *ActorPath));
         }
 
-        FString LevelPath;
-        if (ULevel* Level = TargetActor->GetLevel())
+        ULevel* Level = TargetActor->GetLevel();
+        if (UPackage* Package = Level ? Level->GetOutermost() : nullptr)
         {
-            if (UPackage* Package = Level->GetOutermost())
+            TPair<bool, FString>* PathCheck = LevelPathChecks.Find(Package);
+            if (!PathCheck)
             {
-                LevelPath = NormalizeContentPath(Package->GetName());
+                FString PathReason;
+                const FString LevelPath = NormalizeContentPath(Package->GetName());
+                const bool bAllowed = LevelPath.IsEmpty() || FWriteGate::IsPathAllowed(LevelPath, PathReason);
+                PathCheck = &LevelPathChecks.Add(Package, TPair<bool, FString>(bAllowed, PathReason));
             }
-        }
-
-        if (!LevelPath.IsEmpty())
-        {
-            FString PathReason;
-            if (!FWriteGate::IsPathAllowed(LevelPath, PathReason))
+            if (!PathCheck->Key)
             {
-                return MakeErrorResponse(TEXT("PATH_NOT_ALLOWED"), PathReason);
+                return MakeErrorResponse(TEXT("PATH_NOT_ALLOWED"), PathCheck->Value);
             }
         }
 
@@ -326,9 +612,6 @@ TSharedPtr<FJsonObject> FMaterialApplyTools::BatchApply(const TSharedPtr<FJsonOb
             return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Target missing assign array"));
         }
 
-        bool bComponentModified = false;
-        MeshComponent->Modify();
-
         for (const TSharedPtr<FJsonValue>& AssignValue : *AssignArray)
         {
             if (!AssignValue.IsValid() || AssignValue->Type != EJson::Object)
@@ -384,67 +667,106 @@ TSharedPtr<FJsonObject> FMaterialApplyTools::BatchApply(const TSharedPtr<FJsonOb
                 continue;
             }
 
-            UMaterialInterface* Material = LoadMaterialInterface(MiPath);
-            if (!Material)
+            UMaterialInterface** CachedMaterial = Materials.Find(MiPath);
+            if (!CachedMaterial)
             {
-                return MakeErrorResponse(ErrorCodeMaterialNotFound, FString::Printf(TEXT("Material interface not found: %s"), *MiPath));
+                CachedMaterial = &Materials.Add(MiPath, LoadMaterialInterface(MiPath));
             }
-
-            UMaterialInterface* PreviousMaterial = MeshComponent->GetMaterial(SlotIndex);
-            MeshComponent->SetMaterial(SlotIndex, Material);
-            bComponentModified = true;
-
-            TSharedPtr<FJsonObject> Applied = MakeShared<FJsonObject>();
-            Applied->SetStringField(TEXT("actor"), ActorPath);
-            if (!ComponentName.IsEmpty())
+            if (!*CachedMaterial)
             {
-                Applied->SetStringField(TEXT("component"), ComponentName);
+                return MakeErrorResponse(ErrorCodeMaterialNotFound, FString::Printf(TEXT("Material interface not found: %s"), *MiPath));
             }
 
+            FAssignment& Assignment = Assignments.AddDefaulted_GetRef();
+            Assignment.Component = MeshComponent;
+            Assignment.Actor = TargetActor;
+            Assignment.SlotIndex = SlotIndex;
+            Assignment.Material = *CachedMaterial;
+            Assignment.ActorPath = ActorPath;
+            Assignment.ComponentName = ComponentName;
+            Assignment.MiPath = MiPath;
             if (bSlotWasName && SlotValue->Type == EJson::String)
             {
-                Applied->SetStringField(TEXT("slot"), SlotValue->AsString());
-            }
-            else
-            {
-                Applied->SetNumberField(TEXT("slot"), SlotIndex);
+                Assignment.SlotName = SlotValue->AsString();
             }
+        }
+    }
 
-            Applied->SetStringField(TEXT("mi"), MiPath);
-            Applied->SetStringField(TEXT("prev"), PreviousMaterial ? PreviousMaterial->GetPathName() : FString());
-            AppliedItems.Add(MakeShared<FJsonValueObject>(Applied));
+    // Grouped by component: each is modified, and its render state dirtied, once however many
+    // targets name it.
+    TMap<UMeshComponent*, TArray<int32>> AssignmentsByComponent;
+    TArray<UMeshComponent*> Components;
+    for (int32 Index = 0; Index < Assignments.Num(); ++Index)
+    {
+        TArray<int32>* ComponentAssignments = AssignmentsByComponent.Find(Assignments[Index].Component);
+        if (!ComponentAssignments)
+        {
+            Components.Add(Assignments[Index].Component);
+            ComponentAssignments = &AssignmentsByComponent.Add(Assignments[Index].Component);
+        }
+        ComponentAssignments->Add(Index);
+    }
 
-            TMap<FString, FString> AuditArgs;
-            AuditArgs.Add(TEXT("actor"), ActorPath);
-            if (!ComponentName.IsEmpty())
+    TArray<TSharedPtr<FJsonValue>> AppliedItems;
+    AppliedItems.SetNum(Assignments.Num());
+    TSet<UPackage*> PackagesToSave;
+
+    for (UMeshComponent* MeshComponent : Components)
+    {
+        MeshComponent->Modify();
+        for (const int32 Index : AssignmentsByComponent.FindChecked(MeshComponent))
+        {
+            const FAssignment& Assignment = Assignments[Index];
+            UMaterialInterface* PreviousMaterial = MeshComponent->GetMaterial(Assignment.SlotIndex);
+            MeshComponent->SetMaterial(Assignment.SlotIndex, Assignment.Material);
+
+            TSharedPtr<FJsonObject> Applied = MakeShared<FJsonObject>();
+            Applied->SetStringField(TEXT("actor"), Assignment.ActorPath);
+            if (!Assignment.ComponentName.IsEmpty())
             {
-                AuditArgs.Add(TEXT("component"), ComponentName);
+                Applied->SetStringField(TEXT("component"), Assignment.ComponentName);
             }
-            if (bSlotWasName && SlotValue->Type == EJson::String)
+
+            if (!Assignment.SlotName.IsEmpty())
             {
-                AuditArgs.Add(TEXT("slot"), SlotValue->AsString());
+                Applied->SetStringField(TEXT("slot"), Assignment.SlotName);
             }
             else
             {
-                AuditArgs.Add(TEXT("slot"), FString::FromInt(SlotIndex));
+                Applied->SetNumberField(TEXT("slot"), Assignment.SlotIndex);
             }
-            AuditArgs.Add(TEXT("mi"), MiPath);
-            AppendAuditAction(AuditActions, TEXT("apply_mi"), AuditArgs);
+
+            Applied->SetStringField(TEXT("mi"), Assignment.MiPath);
+            Applied->SetStringField(TEXT("prev"), PreviousMaterial ? PreviousMaterial->GetPathName() : FString());
+            AppliedItems[Index] = MakeShared<FJsonValueObject>(Applied);
         }
 
-        if (bComponentModified)
+        MeshComponent->MarkRenderStateDirty();
+        const FAssignment& First = Assignments[AssignmentsByComponent.FindChecked(MeshComponent)[0]];
+        if (ULevel* Level = First.Actor->GetLevel())
         {
-            MeshComponent->MarkRenderStateDirty();
-            if (ULevel* Level = TargetActor->GetLevel())
+            if (UPackage* Package = Level->GetOutermost())
             {
-                if (UPackage* Package = Level->GetOutermost())
-                {
-                    PackagesToSave.Add(Package);
-                }
+                PackagesToSave.Add(Package);
             }
         }
     }
 
+    // The audit follows the request's order, as the applied list does.
+    TArray<TSharedPtr<FJsonValue>> AuditActions;
+    for (const FAssignment& Assignment : Assignments)
+    {
+        TMap<FString, FString> AuditArgs;
+        AuditArgs.Add(TEXT("actor"), Assignment.ActorPath);
+        if (!Assignment.ComponentName.IsEmpty())
+        {
+            AuditArgs.Add(TEXT("component"), Assignment.ComponentName);
+        }
+        AuditArgs.Add(TEXT("slot"), Assignment.SlotName.IsEmpty() ? FString::FromInt(Assignment.SlotIndex) : Assignment.SlotName);
+        AuditArgs.Add(TEXT("mi"), Assignment.MiPath);
+        AppendAuditAction(AuditActions, TEXT("apply_mi"), AuditArgs);
+    }
+
     if (bSaveActors && PackagesToSave.Num() > 0)
     {
         TArray<UPackage*> PackagesArray = PackagesToSave.Array();
@@ -457,328 +779,213 @@ TSharedPtr<FJsonObject> FMaterialApplyTools::BatchApply(const TSharedPtr<FJsonOb
     TSharedPtr<FJsonObject> Result = MakeSuccessResponse();
     Result->SetArrayField(TEXT("applied"), AppliedItems);
     Result->SetArrayField(TEXT("skipped"), SkippedItems);
+    Result->SetObjectField(TEXT("prefetch"), PrefetchStats);
     Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, AuditActions));
     return Result;
 }
 
 TSharedPtr<FJsonObject> FMaterialApplyTools::RemapMaterialSlots(const TSharedPtr<FJsonObject>& Params)
 {
-    if (!Params.IsValid())
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
-    }
-
-    FString MeshObjectPath;
-    if (!Params->TryGetStringField(TEXT("meshObjectPath"), MeshObjectPath) || MeshObjectPath.TrimStartAndEnd().IsEmpty())
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing meshObjectPath"));
-    }
-
-    MeshObjectPath.TrimStartAndEndInline();
-
-    const FString PackagePath = NormalizeContentPath(MeshObjectPath.Contains(TEXT(".")) ? FPackageName::ObjectPathToPackageName(MeshObjectPath) : MeshObjectPath);
-    if (PackagePath.IsEmpty())
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Invalid meshObjectPath"));
-    }
-
-    FString PathReason;
-    if (!FWriteGate::IsPathAllowed(PackagePath, PathReason))
+    TSharedPtr<FJsonObject> ShaderWaitResponse;
+    if (FShaderCompileWait::Resume(ShaderWaitResponse))
     {
-        return MakeErrorResponse(TEXT("PATH_NOT_ALLOWED"), PathReason);
+        return ShaderWaitResponse;
     }
 
-    const FString ObjectPath = BuildObjectPath(PackagePath);
-
-    UObject* MeshObject = LoadObject<UObject>(nullptr, *ObjectPath);
-    if (!MeshObject)
-    {
-        return MakeErrorResponse(ErrorCodeAssetNotFound, FString::Printf(TEXT("Mesh asset not found: %s"), *MeshObjectPath));
-    }
-
-    UStaticMesh* StaticMesh = Cast<UStaticMesh>(MeshObject);
-    if (!StaticMesh)
-    {
-        return MakeErrorResponse(ErrorCodeUnsupportedMesh, TEXT("Only static meshes are supported"));
-    }
-
-    StaticMesh->Modify();
-
-    TArray<FStaticMaterial>& StaticMaterials = StaticMesh->GetStaticMaterials();
-    TArray<FName> OriginalNames;
-    OriginalNames.Reserve(StaticMaterials.Num());
-    for (const FStaticMaterial& Material : StaticMaterials)
-    {
-        OriginalNames.Add(Material.MaterialSlotName);
-    }
-
-    const TSharedPtr<FJsonObject>* RenameObject = nullptr;
-    bool bHasRename = Params->TryGetObjectField(TEXT("rename"), RenameObject) && RenameObject && RenameObject->IsValid() && (*RenameObject)->Values.Num() > 0;
-
-    TArray<TPair<FName, FName>> AppliedRenames;
-
-    if (bHasRename)
+    if (!Params.IsValid())
     {
-        TSet<FName> PendingNames(OriginalNames);
-
-        for (const auto& Pair : (*RenameObject)->Values)
-        {
-            const FString& OldNameString = Pair.Key;
-            if (!Pair.Value.IsValid() || Pair.Value->Type != EJson::String)
-            {
-                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Rename values must be strings"));
-            }
-
-            const FString NewNameString = Pair.Value->AsString();
-            const FName OldName(*OldNameString);
-            const FName NewName(*NewNameString);
-
-            const int32 Index = OriginalNames.IndexOfByKey(OldName);
-            if (Index == INDEX_NONE)
-            {
-                continue;
-            }
-
-            if (PendingNames.Contains(NewName) && NewName != OldName)
-            {
-                return MakeErrorResponse(ErrorCodeSlotConflict, FString::Printf(TEXT("Slot name conflict: %s"), *NewNameString));
-            }
-
-            PendingNames.Remove(OldName);
-            PendingNames.Add(NewName);
-
-            StaticMaterials[Index].MaterialSlotName = NewName;
-            OriginalNames[Index] = NewName;
-            AppliedRenames.Emplace(OldName, NewName);
-        }
+        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
     }
 
-    const TArray<TSharedPtr<FJsonValue>>* ReorderArray = nullptr;
-    const bool bHasReorder = Params->TryGetArrayField(TEXT("reorder"), ReorderArray) && ReorderArray && ReorderArray->Num() > 0;
-
-    FString FillMissingName;
-    Params->TryGetStringField(TEXT("fillMissingWith"), FillMissingName);
-    FName FillMissingFName = FillMissingName.IsEmpty() ? NAME_None : FName(*FillMissingName);
-
-    TArray<int32> SourceIndices;
-    TArray<FName> FinalNames = OriginalNames;
-
-    if (bHasReorder)
+    // "meshes" takes one { meshObjectPath, rename, reorder, fillMissingWith } per mesh; without it
+    // Params itself is the only mesh.
+    TArray<TSharedPtr<FJsonObject>> Specs;
+    const TArray<TSharedPtr<FJsonValue>>* MeshesArray = nullptr;
+    const bool bBatch = Params->TryGetArrayField(TEXT("meshes"), MeshesArray) && MeshesArray;
+    if (bBatch)
     {
-        if (ReorderArray->Num() != OriginalNames.Num())
+        if (MeshesArray->Num() == 0)
         {
-            return MakeErrorResponse(ErrorCodeReorderInvalid, TEXT("Reorder array must match slot count"));
+            return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("meshes must not be empty"));
         }
-
-        TMap<FName, int32> NameToIndex;
-        for (int32 Index = 0; Index < OriginalNames.Num(); ++Index)
+        if (MeshesArray->Num() > MaxMeshesPerRequest)
         {
-            NameToIndex.Add(OriginalNames[Index], Index);
+            return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("meshes has %d entries; the limit is %d"), MeshesArray->Num(), MaxMeshesPerRequest));
         }
-
-        SourceIndices.Reserve(ReorderArray->Num());
-        FinalNames.Reset(ReorderArray->Num());
-
-        for (const TSharedPtr<FJsonValue>& Value : *ReorderArray)
+        for (int32 Index = 0; Index < MeshesArray->Num(); ++Index)
         {
-            if (!Value.IsValid() || Value->Type != EJson::String)
-            {
-                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Reorder entries must be strings"));
-            }
-
-            const FString SlotNameString = Value->AsString();
-            const FName SlotName(*SlotNameString);
-
-            int32* FoundIndex = NameToIndex.Find(SlotName);
-            if (!FoundIndex && FillMissingFName != NAME_None)
-            {
-                FoundIndex = NameToIndex.Find(FillMissingFName);
-            }
-
-            if (!FoundIndex)
+            const TSharedPtr<FJsonValue>& Value = (*MeshesArray)[Index];
+            if (!Value.IsValid() || Value->Type != EJson::Object)
             {
-                return MakeErrorResponse(ErrorCodeReorderInvalid, FString::Printf(TEXT("Reorder reference missing slot: %s"), *SlotNameString));
+                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("meshes[%d] must be an object"), Index));
             }
-
-            SourceIndices.Add(*FoundIndex);
-            FinalNames.Add(SlotName);
+            Specs.Add(Value->AsObject());
         }
     }
     else
     {
-        SourceIndices.Reserve(StaticMaterials.Num());
-        for (int32 Index = 0; Index < StaticMaterials.Num(); ++Index)
-        {
-            SourceIndices.Add(Index);
-        }
+        Specs.Add(Params);
     }
 
-    TArray<FStaticMaterial> NewMaterials;
-    NewMaterials.SetNum(SourceIndices.Num());
-
-    for (int32 NewIndex = 0; NewIndex < SourceIndices.Num(); ++NewIndex)
+    // The meshes load side by side first; planning then finds each one in memory.
+    TArray<FString> MeshPaths;
+    for (const TSharedPtr<FJsonObject>& Spec : Specs)
     {
-        const int32 SourceIndex = SourceIndices[NewIndex];
-        if (!StaticMaterials.IsValidIndex(SourceIndex))
+        FString MeshObjectPath;
+        if (Spec.IsValid() && Spec->TryGetStringField(TEXT("meshObjectPath"), MeshObjectPath))
         {
-            return MakeErrorResponse(ErrorCodeReorderInvalid, TEXT("Reorder index out of range"));
-        }
-
-        FStaticMaterial& Destination = NewMaterials[NewIndex];
-        Destination = StaticMaterials[SourceIndex];
-        if (FinalNames.IsValidIndex(NewIndex))
-        {
-            Destination.MaterialSlotName = FinalNames[NewIndex];
+            MeshPaths.Add(NormalizeContentPath(MeshObjectPath));
         }
     }
-
-    TArray<int32> OldToNew;
-    OldToNew.Init(INDEX_NONE, StaticMaterials.Num());
-    for (int32 NewIndex = 0; NewIndex < SourceIndices.Num(); ++NewIndex)
+    TSharedPtr<FJsonObject> PrefetchResponse;
+    TSharedPtr<FJsonObject> PrefetchStats;
+    if (!FPackagePrefetch::Await(MeshPaths, PrefetchResponse, &PrefetchStats))
     {
-        const int32 OldIndex = SourceIndices[NewIndex];
-        if (!OldToNew.IsValidIndex(OldIndex) || OldToNew[OldIndex] == INDEX_NONE)
-        {
-            OldToNew[OldIndex] = NewIndex;
-        }
+        return PrefetchResponse;
     }
 
-    StaticMaterials = NewMaterials;
-
-    FMeshSectionInfoMap& SectionInfoMap = StaticMesh->GetSectionInfoMap();
-    for (auto It = SectionInfoMap.Map.CreateIterator(); It; ++It)
+    // Every mesh is validated before the first one changes, so a bad entry leaves the kit untouched.
+    TArray<FRemapPlan> Plans;
+    Plans.SetNum(Specs.Num());
+    TMap<UStaticMesh*, int32> PlanIndexByMesh;
+    for (int32 Index = 0; Index < Specs.Num(); ++Index)
     {
-        FMeshSectionInfo& Info = It.Value();
-        if (OldToNew.IsValidIndex(Info.MaterialIndex) && OldToNew[Info.MaterialIndex] != INDEX_NONE)
+        if (TSharedPtr<FJsonObject> PlanError = PlanRemap(Specs[Index], Plans[Index]))
+        {
+            if (bBatch)
+            {
+                PlanError->SetStringField(TEXT("error"), FString::Printf(TEXT("meshes[%d]: %s"), Index, *PlanError->GetStringField(TEXT("error"))));
+            }
+            return PlanError;
+        }
+        if (const int32* Earlier = PlanIndexByMesh.Find(Plans[Index].StaticMesh))
         {
-            Info.MaterialIndex = OldToNew[Info.MaterialIndex];
+            return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("meshes[%d]: mesh repeats meshes[%d]"), Index, *Earlier));
         }
+        PlanIndexByMesh.Add(Plans[Index].StaticMesh, Index);
     }
 
-    StaticMesh->MarkPackageDirty();
-    StaticMesh->PostEditChange();
+    TArray<UPackage*> Packages;
+    for (int32 Index = 0; Index < Plans.Num(); ++Index)
+    {
+        UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(Index, Plans.Num(), TEXT("remapping"));
+        ApplyRemap(Plans[Index]);
+        Packages.Add(Plans[Index].StaticMesh->GetOutermost());
+    }
 
     const bool bRebindActors = Params->HasField(TEXT("rebindActorsInWorld")) && Params->GetBoolField(TEXT("rebindActorsInWorld"));
     TSet<AActor*> ReboundActors;
+    TArray<TSet<AActor*>> ReboundActorsPerMesh;
+    ReboundActorsPerMesh.SetNum(Plans.Num());
 
-    if (bRebindActors)
+    UWorld* World = bRebindActors ? GetEditorWorld() : nullptr;
+    if (World)
     {
-        if (UWorld* World = GetEditorWorld())
+        // One pass over the world files every component under its mesh, so each remapped mesh
+        // finds its components without another walk of all actors.
+        TMap<UStaticMesh*, TArray<UStaticMeshComponent*>> ComponentsByMesh;
+        TArray<AActor*> Actors;
+        FActorIndex::Get().GetActors(World, Actors);
+        TArray<UStaticMeshComponent*> Components;
+        for (AActor* Actor : Actors)
         {
-            for (TActorIterator<AActor> It(World); It; ++It)
+            if (!Actor)
             {
-                AActor* Actor = *It;
-                if (!Actor)
+                continue;
+            }
+
+            Components.Reset();
+            Actor->GetComponents<UStaticMeshComponent>(Components);
+            for (UStaticMeshComponent* Component : Components)
+            {
+                UStaticMesh* ComponentMesh = Component ? Component->GetStaticMesh() : nullptr;
+                if (ComponentMesh && PlanIndexByMesh.Contains(ComponentMesh))
                 {
-                    continue;
+                    ComponentsByMesh.FindOrAdd(ComponentMesh).Add(Component);
                 }
+            }
+        }
 
-                TArray<UStaticMeshComponent*> Components;
-                Actor->GetComponents<UStaticMeshComponent>(Components);
-                for (UStaticMeshComponent* Component : Components)
-                {
-                    if (!Component || Component->GetStaticMesh() != StaticMesh)
-                    {
-                        continue;
-                    }
+        for (int32 PlanIndex = 0; PlanIndex < Plans.Num(); ++PlanIndex)
+        {
+            const FRemapPlan& Plan = Plans[PlanIndex];
+            const TArray<UStaticMeshComponent*>* MeshComponents = ComponentsByMesh.Find(Plan.StaticMesh);
+            if (!MeshComponents)
+            {
+                continue;
+            }
 
-                    Component->Modify();
+            for (UStaticMeshComponent* Component : *MeshComponents)
+            {
+                Component->Modify();
 
-                    TArray<UMaterialInterface*> CurrentMaterials;
-                    const int32 OldMaterialCount = Component->GetNumMaterials();
-                    CurrentMaterials.Reserve(OldMaterialCount);
-                    for (int32 Index = 0; Index < OldMaterialCount; ++Index)
-                    {
-                        CurrentMaterials.Add(Component->GetMaterial(Index));
-                    }
+                TArray<UMaterialInterface*> CurrentMaterials;
+                const int32 OldMaterialCount = Component->GetNumMaterials();
+                CurrentMaterials.Reserve(OldMaterialCount);
+                for (int32 Index = 0; Index < OldMaterialCount; ++Index)
+                {
+                    CurrentMaterials.Add(Component->GetMaterial(Index));
+                }
 
-                    for (int32 NewIndex = 0; NewIndex < SourceIndices.Num(); ++NewIndex)
-                    {
-                        const int32 SourceIndex = SourceIndices[NewIndex];
-                        UMaterialInterface* AppliedMaterial = CurrentMaterials.IsValidIndex(SourceIndex) ? CurrentMaterials[SourceIndex] : nullptr;
-                        Component->SetMaterial(NewIndex, AppliedMaterial);
-                    }
+                for (int32 NewIndex = 0; NewIndex < Plan.SourceIndices.Num(); ++NewIndex)
+                {
+                    const int32 SourceIndex = Plan.SourceIndices[NewIndex];
+                    UMaterialInterface* AppliedMaterial = CurrentMaterials.IsValidIndex(SourceIndex) ? CurrentMaterials[SourceIndex] : nullptr;
+                    Component->SetMaterial(NewIndex, AppliedMaterial);
+                }
+
+                Component->MarkRenderStateDirty();
+                Component->ReregisterComponent();
 
-                    Component->MarkRenderStateDirty();
-                    Component->ReregisterComponent();
-                    ReboundActors.Add(Actor);
+                if (AActor* Owner = Component->GetOwner())
+                {
+                    ReboundActors.Add(Owner);
+                    ReboundActorsPerMesh[PlanIndex].Add(Owner);
                 }
             }
         }
     }
 
     const bool bSave = !Params->HasField(TEXT("save")) || Params->GetBoolField(TEXT("save"));
-    if (bSave)
-    {
-        if (!UEditorAssetLibrary::SaveAsset(ObjectPath, false))
-        {
-            return MakeErrorResponse(ErrorCodeSaveFailed, TEXT("Failed to save mesh asset"));
-        }
-    }
-
-    TSharedPtr<FJsonObject> SlotChanges = MakeShared<FJsonObject>();
-
-    TArray<TSharedPtr<FJsonValue>> RenamedArray;
-    for (const TPair<FName, FName>& Rename : AppliedRenames)
+    if (bSave && !UEditorLoadingAndSavingUtils::SavePackages(Packages, false))
     {
-        TSharedPtr<FJsonObject> RenameObjectJson = MakeShared<FJsonObject>();
-        RenameObjectJson->SetStringField(TEXT("from"), Rename.Key.ToString());
-        RenameObjectJson->SetStringField(TEXT("to"), Rename.Value.ToString());
-        RenamedArray.Add(MakeShared<FJsonValueObject>(RenameObjectJson));
+        return MakeErrorResponse(ErrorCodeSaveFailed, bBatch ? TEXT("Failed to save mesh assets") : TEXT("Failed to save mesh asset"));
     }
-    SlotChanges->SetArrayField(TEXT("renamed"), RenamedArray);
-
-    TArray<FString> ReorderedNames;
-    if (bHasReorder)
-    {
-        Algo::Transform(FinalNames, ReorderedNames, [](const FName& Name)
-        {
-            return Name.ToString();
-        });
-    }
-    else
-    {
-        Algo::Transform(StaticMaterials, ReorderedNames, [](const FStaticMaterial& Material)
-        {
-            return Material.MaterialSlotName.ToString();
-        });
-    }
-
-    AppendStringArrayField(SlotChanges, TEXT("reordered"), ReorderedNames);
 
     TArray<TSharedPtr<FJsonValue>> AuditActions;
-    if (AppliedRenames.Num() > 0)
+    TArray<UMaterialInterface*> SlotMaterials;
+    for (const FRemapPlan& Plan : Plans)
     {
-        TArray<TSharedPtr<FJsonValue>> PairsArray;
-        for (const TPair<FName, FName>& Rename : AppliedRenames)
+        for (const FStaticMaterial& Material : Plan.StaticMesh->GetStaticMaterials())
         {
-            TSharedPtr<FJsonObject> PairObject = MakeShared<FJsonObject>();
-            PairObject->SetStringField(TEXT("from"), Rename.Key.ToString());
-            PairObject->SetStringField(TEXT("to"), Rename.Value.ToString());
-            PairsArray.Add(MakeShared<FJsonValueObject>(PairObject));
+            SlotMaterials.Add(Material.MaterialInterface);
         }
+    }
 
-        TSharedPtr<FJsonObject> RenameAction = MakeShared<FJsonObject>();
-        RenameAction->SetStringField(TEXT("op"), TEXT("rename_slots"));
-        RenameAction->SetStringField(TEXT("mesh"), MeshObjectPath);
-        RenameAction->SetArrayField(TEXT("pairs"), PairsArray);
-        AuditActions.Add(MakeShared<FJsonValueObject>(RenameAction));
+    TSharedPtr<FJsonObject> Result = MakeSuccessResponse();
+    if (!bBatch)
+    {
+        Result->SetStringField(TEXT("mesh"), Plans[0].MeshObjectPath);
+        Result->SetObjectField(TEXT("slotChanges"), BuildSlotChanges(Plans[0], AuditActions));
+        Result->SetNumberField(TEXT("reboundActors"), ReboundActors.Num());
+        Result->SetObjectField(TEXT("prefetch"), PrefetchStats);
+        Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, AuditActions));
+        return FShaderCompileWait::Begin(Params, Result, SlotMaterials);
     }
 
-    if (bHasReorder && SourceIndices.Num() > 0)
+    TArray<TSharedPtr<FJsonValue>> MeshResults;
+    for (int32 Index = 0; Index < Plans.Num(); ++Index)
     {
-        TSharedPtr<FJsonObject> ReorderAction = MakeShared<FJsonObject>();
-        ReorderAction->SetStringField(TEXT("op"), TEXT("reorder_slots"));
-        ReorderAction->SetStringField(TEXT("mesh"), MeshObjectPath);
-        AppendStringArrayField(ReorderAction, TEXT("order"), ReorderedNames);
-        AuditActions.Add(MakeShared<FJsonValueObject>(ReorderAction));
+        TSharedPtr<FJsonObject> MeshResult = MakeShared<FJsonObject>();
+        MeshResult->SetStringField(TEXT("mesh"), Plans[Index].MeshObjectPath);
+        MeshResult->SetObjectField(TEXT("slotChanges"), BuildSlotChanges(Plans[Index], AuditActions));
+        MeshResult->SetNumberField(TEXT("reboundActors"), ReboundActorsPerMesh[Index].Num());
+        MeshResults.Add(MakeShared<FJsonValueObject>(MeshResult));
     }
 
-    TSharedPtr<FJsonObject> Result = MakeSuccessResponse();
-    Result->SetStringField(TEXT("mesh"), MeshObjectPath);
-    Result->SetObjectField(TEXT("slotChanges"), SlotChanges);
+    Result->SetArrayField(TEXT("meshes"), MeshResults);
     Result->SetNumberField(TEXT("reboundActors"), ReboundActors.Num());
+    Result->SetObjectField(TEXT("prefetch"), PrefetchStats);
     Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, AuditActions));
-
-    return Result;
+    return FShaderCompileWait::Begin(Params, Result, SlotMaterials);
 }
@@ -2,16 +2,22 @@
 #include "CoreMinimal.h"
 
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Assets/PackageSaver.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "EditorAssetLibrary.h"
 #include "Engine/Texture.h"
+#include "FileHelpers.h"
+#include "MaterialShared.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialInstance.h"
 #include "Materials/MaterialInstanceConstant.h"
+#include "Materials/ShaderCompileWait.h"
 #include "Misc/PackageName.h"
 #include "Permissions/WriteGate.h"
+#include "Protocol/CommandContext.h"
 #include "SourceControlService.h"
+#include "StaticParameterSet.h"
 #include "UObject/Package.h"
 #include "UObject/UObjectGlobals.h"
 
@@ -96,23 +102,27 @@ namespace
         return Action;
     }
 
-    bool MarkForAdd(const FString& PackageName, FString& OutError)
+    /** Marks the packages' files for add in one source control call. */
+    bool MarkForAdd(const TArray<FString>& PackageNames, FString& OutError)
     {
-        if (!FSourceControlService::IsEnabled())
+        if (!FSourceControlService::IsEnabled() || PackageNames.Num() == 0)
         {
             return true;
         }
 
-        FString PackageFilename;
-        if (!FPackageName::TryConvertLongPackageNameToFilename(PackageName, PackageFilename))
+        TArray<FString> Files;
+        Files.Reserve(PackageNames.Num());
+        for (const FString& PackageName : PackageNames)
         {
-            OutError = FString::Printf(TEXT("Failed to convert package '%s' to filename"), *PackageName);
-            return false;
+            FString PackageFilename;
+            if (!FPackageName::TryConvertLongPackageNameToFilename(PackageName, PackageFilename))
+            {
+                OutError = FString::Printf(TEXT("Failed to convert package '%s' to filename"), *PackageName);
+                return false;
+            }
+            Files.Add(PackageFilename);
         }
 
-        TArray<FString> Files;
-        Files.Add(PackageFilename);
-
         TMap<FString, bool> PerFileResult;
         FString OperationError;
         if (!FSourceControlService::MarkForAdd(Files, PerFileResult, OperationError))
@@ -257,379 +267,812 @@ namespace
             SwitchNames.Add(Info.Name);
         }
     }
-}
 
-TSharedPtr<FJsonObject> FMaterialInstanceTools::Create(const TSharedPtr<FJsonObject>& Params)
-{
-    if (!Params.IsValid())
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
-    }
-
-    FString ParentPath;
-    FString RawMiPath;
-    const bool bHasParent = Params->TryGetStringField(TEXT("parent"), ParentPath);
-    const bool bHasPath = Params->TryGetStringField(TEXT("miPath"), RawMiPath);
+    /** Instances one mi.create or mi.set_params call may take. */
+    constexpr int32 MaxInstancesPerRequest = 5000;
 
-    if (bHasParent)
+    struct FTextureEdit
     {
-        ParentPath.TrimStartAndEndInline();
-    }
+        FString Name;
+        FString Path;
+        UTexture* Texture = nullptr;
+    };
 
-    if (bHasPath)
+    /** One instance's edits, parsed and resolved before any instance is touched. */
+    struct FInstanceEdit
     {
-        RawMiPath.TrimStartAndEndInline();
-    }
-
-    if (!bHasParent || ParentPath.IsEmpty())
+        UMaterialInstanceConstant* Instance = nullptr;
+        FString ObjectPath;
+        bool bClearUnset = false;
+        TArray<TPair<FString, float>> Scalars;
+        TArray<TPair<FString, FLinearColor>> Vectors;
+        TArray<FTextureEdit> Textures;
+        TArray<TPair<FString, bool>> Switches;
+    };
+
+    /** What applying an FInstanceEdit did, in the shape of the single-instance response. */
+    struct FInstanceOutcome
     {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parent parameter"));
-    }
-
-    if (!bHasPath || RawMiPath.IsEmpty())
+        bool bModified = false;
+        TArray<FString> ChangedScalars;
+        TArray<FString> ChangedVectors;
+        TArray<FString> ChangedTextures;
+        TArray<FString> ChangedSwitches;
+        TArray<FString> MissingScalars;
+        TArray<FString> MissingVectors;
+        TArray<FString> MissingTextures;
+        TArray<FString> MissingSwitches;
+        TArray<FString> Unchanged;
+    };
+
+    /**
+     * Parses Spec's scalars, vectors, textures and switches into Out. Textures are loaded once per
+     * path across a batch; a texture that does not load is kept as null and reported under
+     * notFound when applied.
+     */
+    bool ParseParameterEdits(const TSharedPtr<FJsonObject>& Spec, TMap<FString, UTexture*>& TextureCache, FInstanceEdit& Out, FString& OutErrorCode, FString& OutError)
     {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing miPath parameter"));
-    }
+        const TSharedPtr<FJsonObject>* ScalarsObject = nullptr;
+        if (Spec->TryGetObjectField(TEXT("scalars"), ScalarsObject) && ScalarsObject && ScalarsObject->IsValid())
+        {
+            for (const auto& Pair : (*ScalarsObject)->Values)
+            {
+                double NumberValue = 0.0;
+                if (!ParseNumericValue(Pair.Value, NumberValue))
+                {
+                    OutErrorCode = ErrorCodeInvalidParameterType;
+                    OutError = FString::Printf(TEXT("Scalar '%s' is not numeric"), *Pair.Key);
+                    return false;
+                }
+                Out.Scalars.Emplace(Pair.Key, static_cast<float>(NumberValue));
+            }
+        }
 
-    const bool bOverwriteIfExists = Params->HasTypedField<EJson::Boolean>(TEXT("overwriteIfExists")) && Params->GetBoolField(TEXT("overwriteIfExists"));
-    const bool bSave = !Params->HasField(TEXT("save")) || Params->GetBoolField(TEXT("save"));
+        const TSharedPtr<FJsonObject>* VectorsObject = nullptr;
+        if (Spec->TryGetObjectField(TEXT("vectors"), VectorsObject) && VectorsObject && VectorsObject->IsValid())
+        {
+            for (const auto& Pair : (*VectorsObject)->Values)
+            {
+                FLinearColor ColorValue;
+                if (!ParseLinearColor(Pair.Value, ColorValue))
+                {
+                    OutErrorCode = ErrorCodeInvalidParameterType;
+                    OutError = FString::Printf(TEXT("Vector '%s' must be an array of 3 or 4 numbers"), *Pair.Key);
+                    return false;
+                }
+                Out.Vectors.Emplace(Pair.Key, ColorValue);
+            }
+        }
 
-    FString NormalizedPath = NormalizeContentPath(RawMiPath);
-    if (!NormalizedPath.StartsWith(TEXT("/Game/")))
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("miPath must be within /Game"));
-    }
+        const TSharedPtr<FJsonObject>* TexturesObject = nullptr;
+        if (Spec->TryGetObjectField(TEXT("textures"), TexturesObject) && TexturesObject && TexturesObject->IsValid())
+        {
+            for (const auto& Pair : (*TexturesObject)->Values)
+            {
+                if (!Pair.Value.IsValid() || Pair.Value->Type != EJson::String)
+                {
+                    OutErrorCode = ErrorCodeInvalidParameterType;
+                    OutError = FString::Printf(TEXT("Texture '%s' must be a string object path"), *Pair.Key);
+                    return false;
+                }
+
+                FTextureEdit& TextureEdit = Out.Textures.AddDefaulted_GetRef();
+                TextureEdit.Name = Pair.Key;
+                TextureEdit.Path = Pair.Value->AsString();
+                if (UTexture** Cached = TextureCache.Find(TextureEdit.Path))
+                {
+                    TextureEdit.Texture = *Cached;
+                }
+                else
+                {
+                    TextureEdit.Texture = LoadObject<UTexture>(nullptr, *TextureEdit.Path);
+                    TextureCache.Add(TextureEdit.Path, TextureEdit.Texture);
+                }
+            }
+        }
 
-    if (!FPackageName::IsValidLongPackageName(NormalizedPath))
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("miPath is not a valid long package name"));
-    }
+        const TSharedPtr<FJsonObject>* SwitchesObject = nullptr;
+        if (Spec->TryGetObjectField(TEXT("switches"), SwitchesObject) && SwitchesObject && SwitchesObject->IsValid())
+        {
+            for (const auto& Pair : (*SwitchesObject)->Values)
+            {
+                if (!Pair.Value.IsValid() || Pair.Value->Type != EJson::Boolean)
+                {
+                    OutErrorCode = ErrorCodeInvalidParameterType;
+                    OutError = FString::Printf(TEXT("Switch '%s' must be a boolean"), *Pair.Key);
+                    return false;
+                }
+                Out.Switches.Emplace(Pair.Key, Pair.Value->AsBool());
+            }
+        }
 
-    FString PathReason;
-    if (!IsPathAllowed(NormalizedPath, PathReason))
-    {
-        return MakeErrorResponse(TEXT("PATH_NOT_ALLOWED"), PathReason);
+        return true;
     }
 
-    const FString AssetName = FPackageName::GetLongPackageAssetName(NormalizedPath);
-    if (AssetName.IsEmpty())
+    /**
+     * Validates Spec (miObjectPath, scalars, vectors, textures, switches, clearUnset) and loads its
+     * instance and textures into Out.
+     */
+    bool ParseInstanceEdit(const TSharedPtr<FJsonObject>& Spec, TMap<FString, UTexture*>& TextureCache, FInstanceEdit& Out, FString& OutErrorCode, FString& OutError)
     {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("miPath is missing asset name"));
-    }
+        FString MiObjectPath;
+        if (!Spec->TryGetStringField(TEXT("miObjectPath"), MiObjectPath) || MiObjectPath.TrimStartAndEnd().IsEmpty())
+        {
+            OutErrorCode = ErrorCodeInvalidParams;
+            OutError = TEXT("Missing miObjectPath parameter");
+            return false;
+        }
 
-    const FString MiObjectPath = BuildObjectPath(NormalizedPath);
+        MiObjectPath.TrimStartAndEndInline();
 
-    UMaterialInterface* ParentMaterial = LoadObject<UMaterialInterface>(nullptr, *ParentPath);
-    if (!ParentMaterial)
-    {
-        return MakeErrorResponse(ErrorCodeParentInvalid, TEXT("Parent material not found"));
-    }
+        const FString PackagePath = NormalizeContentPath(MiObjectPath);
+        if (!PackagePath.StartsWith(TEXT("/Game/")))
+        {
+            OutErrorCode = ErrorCodeInvalidParams;
+            OutError = TEXT("miObjectPath must be within /Game");
+            return false;
+        }
 
-    if (!ParentMaterial->IsA<UMaterial>() && !ParentMaterial->IsA<UMaterialInstance>())
-    {
-        return MakeErrorResponse(ErrorCodeParentInvalid, TEXT("Parent must be a Material or MaterialInstance"));
-    }
+        if (!FPackageName::IsValidLongPackageName(PackagePath))
+        {
+            OutErrorCode = ErrorCodeInvalidParams;
+            OutError = TEXT("miObjectPath is not a valid package");
+            return false;
+        }
 
-    const bool bExists = UEditorAssetLibrary::DoesAssetExist(MiObjectPath);
-    if (bExists && !bOverwriteIfExists)
-    {
-        return MakeErrorResponse(ErrorCodeAssetExists, TEXT("Material instance already exists"));
-    }
+        FString PathReason;
+        if (!IsPathAllowed(PackagePath, PathReason))
+        {
+            OutErrorCode = TEXT("PATH_NOT_ALLOWED");
+            OutError = PathReason;
+            return false;
+        }
 
-    if (bExists)
-    {
-        if (!UEditorAssetLibrary::DeleteAsset(MiObjectPath))
+        Out.ObjectPath = BuildObjectPath(PackagePath);
+        Out.Instance = LoadObject<UMaterialInstanceConstant>(nullptr, *Out.ObjectPath);
+        if (!Out.Instance)
         {
-            return MakeErrorResponse(ErrorCodeCreateFailed, TEXT("Failed to overwrite existing material instance"));
+            OutErrorCode = ErrorCodeAssetNotFound;
+            OutError = TEXT("Material instance not found");
+            return false;
         }
+
+        Out.bClearUnset = Spec->HasTypedField<EJson::Boolean>(TEXT("clearUnset")) && Spec->GetBoolField(TEXT("clearUnset"));
+        return ParseParameterEdits(Spec, TextureCache, Out, OutErrorCode, OutError);
     }
 
-    UPackage* Package = CreatePackage(*NormalizedPath);
-    if (!Package)
+    /**
+     * Applies Edit to its instance and adds the instance to UpdateContext, which refreshes it, its
+     * dependent instances and the components using them once when the context goes out of scope.
+     * Overrides that already hold the requested value are left alone and listed as unchanged. The
+     * switches are applied as one static parameter set, and the static permutation is only
+     * rebuilt when that set differs from the instance's (or overrides were cleared).
+     */
+    void ApplyInstanceEdit(const FInstanceEdit& Edit, FMaterialUpdateContext& UpdateContext, TArray<TSharedPtr<FJsonValue>>& AuditActions, FInstanceOutcome& Out)
     {
-        return MakeErrorResponse(ErrorCodeCreateFailed, TEXT("Failed to create package"));
-    }
+        UMaterialInstanceConstant* MaterialInstance = Edit.Instance;
 
-    Package->FullyLoad();
+        TSet<FName> ScalarNames;
+        TSet<FName> VectorNames;
+        TSet<FName> TextureNames;
+        TSet<FName> SwitchNames;
+        CollectParameterNames(*MaterialInstance, ScalarNames, VectorNames, TextureNames, SwitchNames);
 
-    UMaterialInstanceConstant* MaterialInstance = NewObject<UMaterialInstanceConstant>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
-    if (!MaterialInstance)
-    {
-        return MakeErrorResponse(ErrorCodeCreateFailed, TEXT("Failed to create material instance object"));
-    }
+        auto MarkModified = [&Out, MaterialInstance]()
+        {
+            if (!Out.bModified)
+            {
+                MaterialInstance->Modify();
+                Out.bModified = true;
+            }
+        };
 
-    MaterialInstance->SetParentEditorOnly(ParentMaterial);
-    MaterialInstance->PostEditChange();
+        auto AddAudit = [&AuditActions, &Edit](const TCHAR* Op, const FString& Name, const FString& Value)
+        {
+            TMap<FString, FString> Args;
+            Args.Add(TEXT("mi"), Edit.ObjectPath);
+            if (!Name.IsEmpty())
+            {
+                Args.Add(TEXT("name"), Name);
+                Args.Add(TEXT("value"), Value);
+            }
+            AuditActions.Add(MakeShared<FJsonValueObject>(MakeActionJson(Op, Args)));
+        };
 
-    FAssetRegistryModule::AssetCreated(MaterialInstance);
-    Package->MarkPackageDirty();
+        if (Edit.bClearUnset)
+        {
+            MarkModified();
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4)
+            MaterialInstance->ClearAllOverrideParameters();
+#else
+            MaterialInstance->ClearParameterOverrides();
+#endif
+            AddAudit(TEXT("clear_overrides"), FString(), FString());
+        }
 
-    if (!bExists)
-    {
-        FString ScError;
-        if (!MarkForAdd(NormalizedPath, ScError))
+        for (const TPair<FString, float>& Scalar : Edit.Scalars)
         {
-            return MakeErrorResponse(ErrorCodeSourceControlFailed, ScError);
+            const FName ParamName(*Scalar.Key);
+            if (!ScalarNames.Contains(ParamName))
+            {
+                Out.MissingScalars.Add(Scalar.Key);
+                continue;
+            }
+
+            float Current = 0.0f;
+            if (MaterialInstance->GetScalarParameterValue(FMaterialParameterInfo(ParamName), Current, /*bOveriddenOnly*/ true) && Current == Scalar.Value)
+            {
+                Out.Unchanged.Add(Scalar.Key);
+                continue;
+            }
+
+            MarkModified();
+            MaterialInstance->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(ParamName), Scalar.Value);
+            Out.ChangedScalars.Add(Scalar.Key);
+            AddAudit(TEXT("set_scalar"), Scalar.Key, LexToString(Scalar.Value));
         }
-    }
 
-    if (bSave)
-    {
-        if (!UEditorAssetLibrary::SaveAsset(MiObjectPath, false))
+        for (const TPair<FString, FLinearColor>& Vector : Edit.Vectors)
         {
-            return MakeErrorResponse(ErrorCodeSaveFailed, TEXT("Failed to save material instance"));
+            const FName ParamName(*Vector.Key);
+            if (!VectorNames.Contains(ParamName))
+            {
+                Out.MissingVectors.Add(Vector.Key);
+                continue;
+            }
+
+            FLinearColor Current;
+            if (MaterialInstance->GetVectorParameterValue(FMaterialParameterInfo(ParamName), Current, /*bOveriddenOnly*/ true) && Current == Vector.Value)
+            {
+                Out.Unchanged.Add(Vector.Key);
+                continue;
+            }
+
+            MarkModified();
+            MaterialInstance->SetVectorParameterValueEditorOnly(FMaterialParameterInfo(ParamName), Vector.Value);
+            Out.ChangedVectors.Add(Vector.Key);
+            const FLinearColor& Color = Vector.Value;
+            AddAudit(TEXT("set_vector"), Vector.Key, FString::Printf(TEXT("[%g,%g,%g,%g]"), Color.R, Color.G, Color.B, Color.A));
         }
-    }
 
-    TMap<FString, FString> ActionArgs;
-    ActionArgs.Add(TEXT("parent"), ParentPath);
-    ActionArgs.Add(TEXT("dst"), NormalizedPath);
-    TArray<TSharedPtr<FJsonValue>> Actions;
-    Actions.Add(MakeShared<FJsonValueObject>(MakeActionJson(TEXT("create_mi"), ActionArgs)));
+        for (const FTextureEdit& TextureEdit : Edit.Textures)
+        {
+            const FName ParamName(*TextureEdit.Name);
+            if (!TextureEdit.Texture || !TextureNames.Contains(ParamName))
+            {
+                Out.MissingTextures.Add(TextureEdit.Name);
+                continue;
+            }
 
-    TSharedPtr<FJsonObject> Result = MakeSuccessResponse();
-    Result->SetStringField(TEXT("miObjectPath"), MiObjectPath);
-    Result->SetStringField(TEXT("parentClass"), ParentMaterial->GetClass()->GetName());
-    Result->SetBoolField(TEXT("created"), true);
-    Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, Actions));
+            UTexture* Current = nullptr;
+            if (MaterialInstance->GetTextureParameterValue(FMaterialParameterInfo(ParamName), Current, /*bOveriddenOnly*/ true) && Current == TextureEdit.Texture)
+            {
+                Out.Unchanged.Add(TextureEdit.Name);
+                continue;
+            }
 
-    return Result;
-}
+            MarkModified();
+            MaterialInstance->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(ParamName), TextureEdit.Texture);
+            Out.ChangedTextures.Add(TextureEdit.Name);
+            AddAudit(TEXT("set_texture"), TextureEdit.Name, TextureEdit.Path);
+        }
 
-TSharedPtr<FJsonObject> FMaterialInstanceTools::SetParameters(const TSharedPtr<FJsonObject>& Params)
-{
-    if (!Params.IsValid())
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
-    }
+        // Setting switches one at a time rebuilds the permutation per switch; edit a copy of the
+        // static parameters instead and hand it over once.
+        FStaticParameterSet StaticParameters = MaterialInstance->GetStaticParameters();
+        bool bStaticParametersChanged = Edit.bClearUnset;
+        for (const TPair<FString, bool>& Switch : Edit.Switches)
+        {
+            const FName ParamName(*Switch.Key);
+            if (!SwitchNames.Contains(ParamName))
+            {
+                Out.MissingSwitches.Add(Switch.Key);
+                continue;
+            }
 
-    FString MiObjectPath;
-    if (!Params->TryGetStringField(TEXT("miObjectPath"), MiObjectPath) || MiObjectPath.TrimStartAndEnd().IsEmpty())
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing miObjectPath parameter"));
-    }
+            FStaticSwitchParameter* Existing = StaticParameters.StaticSwitchParameters.FindByPredicate([ParamName](const FStaticSwitchParameter& Parameter)
+            {
+                return Parameter.ParameterInfo.Name == ParamName;
+            });
+            if (Existing && Existing->bOverride && Existing->Value == Switch.Value)
+            {
+                Out.Unchanged.Add(Switch.Key);
+                continue;
+            }
 
-    MiObjectPath.TrimStartAndEndInline();
+            if (Existing)
+            {
+                Existing->Value = Switch.Value;
+                Existing->bOverride = true;
+            }
+            else
+            {
+                bool bDefaultValue = false;
+                FGuid ExpressionGuid;
+                MaterialInstance->GetStaticSwitchParameterDefaultValue(FMaterialParameterInfo(ParamName), bDefaultValue, ExpressionGuid);
+                StaticParameters.StaticSwitchParameters.Emplace(FMaterialParameterInfo(ParamName), Switch.Value, /*bOverride*/ true, ExpressionGuid);
+            }
 
-    const FString PackagePath = NormalizeContentPath(MiObjectPath);
-    if (!PackagePath.StartsWith(TEXT("/Game/")))
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("miObjectPath must be within /Game"));
+            MarkModified();
+            bStaticParametersChanged = true;
+            Out.ChangedSwitches.Add(Switch.Key);
+            AddAudit(TEXT("set_switch"), Switch.Key, Switch.Value ? TEXT("true") : TEXT("false"));
+        }
+
+        if (bStaticParametersChanged)
+        {
+            MaterialInstance->UpdateStaticPermutation(StaticParameters, &UpdateContext);
+        }
+
+        if (Out.bModified)
+        {
+            UpdateContext.AddMaterialInstance(MaterialInstance);
+            MaterialInstance->MarkPackageDirty();
+        }
     }
 
-    if (!FPackageName::IsValidLongPackageName(PackagePath))
+    /** Writes Outcome's fields (modified, changed, notFound, unchanged) onto Target. */
+    void WriteOutcomeFields(const FInstanceOutcome& Outcome, const TSharedPtr<FJsonObject>& Target)
     {
-        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("miObjectPath is not a valid package"));
+        Target->SetBoolField(TEXT("modified"), Outcome.bModified);
+        Target->SetObjectField(TEXT("changed"), BuildChangedJson(Outcome.ChangedScalars, Outcome.ChangedVectors, Outcome.ChangedTextures, Outcome.ChangedSwitches));
+        Target->SetObjectField(TEXT("notFound"), BuildNotFoundJson(Outcome.MissingScalars, Outcome.MissingVectors, Outcome.MissingTextures, Outcome.MissingSwitches));
+        AppendStringArrayField(Target, TEXT("unchanged"), Outcome.Unchanged);
     }
 
-    FString PathReason;
-    if (!IsPathAllowed(PackagePath, PathReason))
+    /**
+     * The per-instance specs of a call: the entries of its "instances" array, or Params itself
+     * for the single-instance form. Null on success, else the error response.
+     */
+    TSharedPtr<FJsonObject> GatherSpecs(const TSharedPtr<FJsonObject>& Params, TArray<TSharedPtr<FJsonObject>>& OutSpecs, bool& bOutBatch)
     {
-        return MakeErrorResponse(TEXT("PATH_NOT_ALLOWED"), PathReason);
-    }
+        const TArray<TSharedPtr<FJsonValue>>* InstancesArray = nullptr;
+        bOutBatch = Params->TryGetArrayField(TEXT("instances"), InstancesArray) && InstancesArray;
+        if (!bOutBatch)
+        {
+            OutSpecs.Add(Params);
+            return nullptr;
+        }
 
-    const FString NormalizedObjectPath = BuildObjectPath(PackagePath);
+        if (InstancesArray->Num() == 0)
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("instances must not be empty"));
+        }
+        if (InstancesArray->Num() > MaxInstancesPerRequest)
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("instances has %d entries; the limit is %d"), InstancesArray->Num(), MaxInstancesPerRequest));
+        }
+        OutSpecs.Reserve(InstancesArray->Num());
+        for (int32 Index = 0; Index < InstancesArray->Num(); ++Index)
+        {
+            const TSharedPtr<FJsonValue>& Value = (*InstancesArray)[Index];
+            if (!Value.IsValid() || Value->Type != EJson::Object)
+            {
+                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("instances[%d] must be an object"), Index));
+            }
+            OutSpecs.Add(Value->AsObject());
+        }
+        return nullptr;
+    }
 
-    UMaterialInstanceConstant* MaterialInstance = LoadObject<UMaterialInstanceConstant>(nullptr, *NormalizedObjectPath);
-    if (!MaterialInstance)
+    /** One instance mi.create is to make, validated before any is created. */
+    struct FCreateSpec
     {
-        return MakeErrorResponse(ErrorCodeAssetNotFound, TEXT("Material instance not found"));
-    }
+        FString PackagePath;
+        FString AssetName;
+        FString ParentPath;
+        UMaterialInterface* Parent = nullptr;
+        bool bExists = false;
+        /** Parameter overrides; Instance is filled in once the instance exists. */
+        FInstanceEdit Edit;
+    };
+
+    /**
+     * Validates Spec (miPath, parent, overwriteIfExists and the parameter overrides) into Out.
+     * Spec's parent and overwriteIfExists fall back to the call's; parents are loaded once per path.
+     */
+    bool ParseCreateSpec(const TSharedPtr<FJsonObject>& Spec, const FString& DefaultParent, bool bDefaultOverwrite, TMap<FString, UMaterialInterface*>& ParentCache,
+        TMap<FString, UTexture*>& TextureCache, FCreateSpec& Out, FString& OutErrorCode, FString& OutError)
+    {
+        FString ParentPath = DefaultParent;
+        Spec->TryGetStringField(TEXT("parent"), ParentPath);
+        ParentPath.TrimStartAndEndInline();
 
-    const bool bSave = !Params->HasField(TEXT("save")) || Params->GetBoolField(TEXT("save"));
-    const bool bClearUnset = Params->HasTypedField<EJson::Boolean>(TEXT("clearUnset")) && Params->GetBoolField(TEXT("clearUnset"));
+        FString RawMiPath;
+        Spec->TryGetStringField(TEXT("miPath"), RawMiPath);
+        RawMiPath.TrimStartAndEndInline();
 
-    MaterialInstance->Modify();
+        if (ParentPath.IsEmpty())
+        {
+            OutErrorCode = ErrorCodeInvalidParams;
+            OutError = TEXT("Missing parent parameter");
+            return false;
+        }
 
-    bool bModified = false;
-    bool bStaticSwitchChanged = false;
+        if (RawMiPath.IsEmpty())
+        {
+            OutErrorCode = ErrorCodeInvalidParams;
+            OutError = TEXT("Missing miPath parameter");
+            return false;
+        }
 
-    TSet<FName> ScalarNames;
-    TSet<FName> VectorNames;
-    TSet<FName> TextureNames;
-    TSet<FName> SwitchNames;
-    CollectParameterNames(*MaterialInstance, ScalarNames, VectorNames, TextureNames, SwitchNames);
+        Out.PackagePath = NormalizeContentPath(RawMiPath);
+        if (!Out.PackagePath.StartsWith(TEXT("/Game/")))
+        {
+            OutErrorCode = ErrorCodeInvalidParams;
+            OutError = TEXT("miPath must be within /Game");
+            return false;
+        }
 
-    TArray<FString> ChangedScalars;
-    TArray<FString> ChangedVectors;
-    TArray<FString> ChangedTextures;
-    TArray<FString> ChangedSwitches;
+        if (!FPackageName::IsValidLongPackageName(Out.PackagePath))
+        {
+            OutErrorCode = ErrorCodeInvalidParams;
+            OutError = TEXT("miPath is not a valid long package name");
+            return false;
+        }
 
-    TArray<FString> MissingScalars;
-    TArray<FString> MissingVectors;
-    TArray<FString> MissingTextures;
-    TArray<FString> MissingSwitches;
+        FString PathReason;
+        if (!IsPathAllowed(Out.PackagePath, PathReason))
+        {
+            OutErrorCode = TEXT("PATH_NOT_ALLOWED");
+            OutError = PathReason;
+            return false;
+        }
 
-    TArray<TSharedPtr<FJsonValue>> AuditActions;
+        Out.AssetName = FPackageName::GetLongPackageAssetName(Out.PackagePath);
+        if (Out.AssetName.IsEmpty())
+        {
+            OutErrorCode = ErrorCodeInvalidParams;
+            OutError = TEXT("miPath is missing asset name");
+            return false;
+        }
 
-    if (bClearUnset)
-    {
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4)
-        MaterialInstance->ClearAllOverrideParameters();
-#else
-        MaterialInstance->ClearParameterOverrides();
-#endif
-        bModified = true;
+        Out.Edit.ObjectPath = BuildObjectPath(Out.PackagePath);
+        Out.ParentPath = ParentPath;
 
-        TMap<FString, FString> Args;
-        AuditActions.Add(MakeShared<FJsonValueObject>(MakeActionJson(TEXT("clear_overrides"), Args)));
-    }
+        UMaterialInterface** CachedParent = ParentCache.Find(ParentPath);
+        Out.Parent = CachedParent ? *CachedParent : ParentCache.Add(ParentPath, LoadObject<UMaterialInterface>(nullptr, *ParentPath));
+        if (!Out.Parent)
+        {
+            OutErrorCode = ErrorCodeParentInvalid;
+            OutError = TEXT("Parent material not found");
+            return false;
+        }
 
-    const TSharedPtr<FJsonObject>* ScalarsObject = nullptr;
-    if (Params->TryGetObjectField(TEXT("scalars"), ScalarsObject) && ScalarsObject && ScalarsObject->IsValid())
-    {
-        for (const auto& Pair : (*ScalarsObject)->Values)
+        if (!Out.Parent->IsA<UMaterial>() && !Out.Parent->IsA<UMaterialInstance>())
         {
-            double NumberValue = 0.0;
-            if (!ParseNumericValue(Pair.Value, NumberValue))
-            {
-                return MakeErrorResponse(ErrorCodeInvalidParameterType, FString::Printf(TEXT("Scalar '%s' is not numeric"), *Pair.Key));
-            }
+            OutErrorCode = ErrorCodeParentInvalid;
+            OutError = TEXT("Parent must be a Material or MaterialInstance");
+            return false;
+        }
 
-            const FName ParamName(*Pair.Key);
-            if (!ScalarNames.Contains(ParamName))
-            {
-                MissingScalars.Add(Pair.Key);
-                continue;
-            }
+        const bool bOverwriteIfExists = Spec->HasTypedField<EJson::Boolean>(TEXT("overwriteIfExists")) ? Spec->GetBoolField(TEXT("overwriteIfExists")) : bDefaultOverwrite;
+        Out.bExists = UEditorAssetLibrary::DoesAssetExist(Out.Edit.ObjectPath);
+        if (Out.bExists && !bOverwriteIfExists)
+        {
+            OutErrorCode = ErrorCodeAssetExists;
+            OutError = TEXT("Material instance already exists");
+            return false;
+        }
 
-            const float FloatValue = static_cast<float>(NumberValue);
-            MaterialInstance->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(ParamName), FloatValue);
-            ChangedScalars.Add(Pair.Key);
-            bModified = true;
+        return ParseParameterEdits(Spec, TextureCache, Out.Edit, OutErrorCode, OutError);
+    }
+}
 
-            TMap<FString, FString> Args;
-            Args.Add(TEXT("name"), Pair.Key);
-            Args.Add(TEXT("value"), LexToString(FloatValue));
-            AuditActions.Add(MakeShared<FJsonValueObject>(MakeActionJson(TEXT("set_scalar"), Args)));
-        }
+TSharedPtr<FJsonObject> FMaterialInstanceTools::Create(const TSharedPtr<FJsonObject>& Params)
+{
+    TSharedPtr<FJsonObject> ShaderWaitResponse;
+    if (FShaderCompileWait::Resume(ShaderWaitResponse))
+    {
+        return ShaderWaitResponse;
     }
 
-    const TSharedPtr<FJsonObject>* VectorsObject = nullptr;
-    if (Params->TryGetObjectField(TEXT("vectors"), VectorsObject) && VectorsObject && VectorsObject->IsValid())
+    if (!Params.IsValid())
     {
-        for (const auto& Pair : (*VectorsObject)->Values)
-        {
-            FLinearColor ColorValue;
-            if (!ParseLinearColor(Pair.Value, ColorValue))
-            {
-                return MakeErrorResponse(ErrorCodeInvalidParameterType, FString::Printf(TEXT("Vector '%s' must be an array of 3 or 4 numbers"), *Pair.Key));
-            }
+        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+    }
 
-            const FName ParamName(*Pair.Key);
-            if (!VectorNames.Contains(ParamName))
-            {
-                MissingVectors.Add(Pair.Key);
-                continue;
-            }
+    TArray<TSharedPtr<FJsonObject>> Specs;
+    bool bBatch = false;
+    if (TSharedPtr<FJsonObject> SpecError = GatherSpecs(Params, Specs, bBatch))
+    {
+        return SpecError;
+    }
 
-            MaterialInstance->SetVectorParameterValueEditorOnly(FMaterialParameterInfo(ParamName), ColorValue);
-            ChangedVectors.Add(Pair.Key);
-            bModified = true;
+    // In the array form the top-level parent and overwriteIfExists apply to entries without their own.
+    FString DefaultParent;
+    bool bDefaultOverwrite = false;
+    if (bBatch)
+    {
+        Params->TryGetStringField(TEXT("parent"), DefaultParent);
+        bDefaultOverwrite = Params->HasTypedField<EJson::Boolean>(TEXT("overwriteIfExists")) && Params->GetBoolField(TEXT("overwriteIfExists"));
+    }
+    const bool bSave = !Params->HasField(TEXT("save")) || Params->GetBoolField(TEXT("save"));
 
-            TMap<FString, FString> Args;
-            Args.Add(TEXT("name"), Pair.Key);
-            Args.Add(TEXT("value"), FString::Printf(TEXT("[%g,%g,%g,%g]"), ColorValue.R, ColorValue.G, ColorValue.B, ColorValue.A));
-            AuditActions.Add(MakeShared<FJsonValueObject>(MakeActionJson(TEXT("set_vector"), Args)));
+    TArray<FCreateSpec> CreateSpecs;
+    CreateSpecs.Reserve(Specs.Num());
+    TMap<FString, UMaterialInterface*> ParentCache;
+    TMap<FString, UTexture*> TextureCache;
+    TMap<FString, int32> IndexByPackage;
+    for (int32 Index = 0; Index < Specs.Num(); ++Index)
+    {
+        FString ErrorCode;
+        FString Error;
+        FCreateSpec& CreateSpec = CreateSpecs.AddDefaulted_GetRef();
+        if (!ParseCreateSpec(Specs[Index], DefaultParent, bDefaultOverwrite, ParentCache, TextureCache, CreateSpec, ErrorCode, Error))
+        {
+            return MakeErrorResponse(ErrorCode, bBatch ? FString::Printf(TEXT("instances[%d]: %s"), Index, *Error) : Error);
+        }
+        if (const int32* Earlier = IndexByPackage.Find(CreateSpec.PackagePath))
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("instances[%d]: miPath repeats instances[%d]"), Index, *Earlier));
         }
+        IndexByPackage.Add(CreateSpec.PackagePath, Index);
     }
 
-    const TSharedPtr<FJsonObject>* TexturesObject = nullptr;
-    if (Params->TryGetObjectField(TEXT("textures"), TexturesObject) && TexturesObject && TexturesObject->IsValid())
+    TArray<FInstanceOutcome> Outcomes;
+    Outcomes.SetNum(CreateSpecs.Num());
+    // Why each instance could not be created; empty for the ones that were.
+    TArray<FString> Failures;
+    Failures.SetNum(CreateSpecs.Num());
+    TArray<TSharedPtr<FJsonValue>> AuditActions;
     {
-        for (const auto& Pair : (*TexturesObject)->Values)
+        FMaterialUpdateContext UpdateContext;
+        for (int32 Index = 0; Index < CreateSpecs.Num(); ++Index)
         {
-            if (!Pair.Value.IsValid() || Pair.Value->Type != EJson::String)
+            UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(Index, CreateSpecs.Num(), TEXT("creating"));
+            FCreateSpec& CreateSpec = CreateSpecs[Index];
+
+            if (CreateSpec.bExists && !UEditorAssetLibrary::DeleteAsset(CreateSpec.Edit.ObjectPath))
             {
-                return MakeErrorResponse(ErrorCodeInvalidParameterType, FString::Printf(TEXT("Texture '%s' must be a string object path"), *Pair.Key));
+                Failures[Index] = TEXT("Failed to overwrite existing material instance");
+                continue;
             }
 
-            const FString TexturePath = Pair.Value->AsString();
-            UTexture* Texture = LoadObject<UTexture>(nullptr, *TexturePath);
-            if (!Texture)
+            UPackage* Package = CreatePackage(*CreateSpec.PackagePath);
+            if (!Package)
             {
-                MissingTextures.Add(Pair.Key);
+                Failures[Index] = TEXT("Failed to create package");
                 continue;
             }
 
-            const FName ParamName(*Pair.Key);
-            if (!TextureNames.Contains(ParamName))
+            Package->FullyLoad();
+
+            UMaterialInstanceConstant* MaterialInstance = NewObject<UMaterialInstanceConstant>(Package, *CreateSpec.AssetName, RF_Public | RF_Standalone | RF_Transactional);
+            if (!MaterialInstance)
             {
-                MissingTextures.Add(Pair.Key);
+                Failures[Index] = TEXT("Failed to create material instance object");
                 continue;
             }
 
-            MaterialInstance->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(ParamName), Texture);
-            ChangedTextures.Add(Pair.Key);
-            bModified = true;
+            MaterialInstance->SetParentEditorOnly(CreateSpec.Parent);
 
-            TMap<FString, FString> Args;
-            Args.Add(TEXT("name"), Pair.Key);
-            Args.Add(TEXT("value"), TexturePath);
-            AuditActions.Add(MakeShared<FJsonValueObject>(MakeActionJson(TEXT("set_texture"), Args)));
+            TMap<FString, FString> ActionArgs;
+            ActionArgs.Add(TEXT("parent"), CreateSpec.ParentPath);
+            ActionArgs.Add(TEXT("dst"), CreateSpec.PackagePath);
+            AuditActions.Add(MakeShared<FJsonValueObject>(MakeActionJson(TEXT("create_mi"), ActionArgs)));
+
+            // The overrides go in before the instance's one PostEditChange, so it is set up with
+            // them instead of being refreshed again per parameter.
+            CreateSpec.Edit.Instance = MaterialInstance;
+            ApplyInstanceEdit(CreateSpec.Edit, UpdateContext, AuditActions, Outcomes[Index]);
+            MaterialInstance->PostEditChange();
+            Package->MarkPackageDirty();
         }
+        UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(CreateSpecs.Num(), CreateSpecs.Num(), TEXT("creating"));
     }
 
-    const TSharedPtr<FJsonObject>* SwitchesObject = nullptr;
-    if (Params->TryGetObjectField(TEXT("switches"), SwitchesObject) && SwitchesObject && SwitchesObject->IsValid())
+    // The registry (and the content browser behind it) hears about each instance once, after all
+    // of them are complete, and source control gets every new file in one call.
+    TArray<UPackage*> Packages;
+    TArray<FString> NewPackageNames;
+    TArray<UMaterialInterface*> CreatedInstances;
+    for (const FCreateSpec& CreateSpec : CreateSpecs)
     {
-        for (const auto& Pair : (*SwitchesObject)->Values)
+        if (UMaterialInstanceConstant* MaterialInstance = CreateSpec.Edit.Instance)
         {
-            if (!Pair.Value.IsValid() || Pair.Value->Type != EJson::Boolean)
+            FAssetRegistryModule::AssetCreated(MaterialInstance);
+            Packages.Add(MaterialInstance->GetOutermost());
+            CreatedInstances.Add(MaterialInstance);
+            if (!CreateSpec.bExists)
             {
-                return MakeErrorResponse(ErrorCodeInvalidParameterType, FString::Printf(TEXT("Switch '%s' must be a boolean"), *Pair.Key));
+                NewPackageNames.Add(CreateSpec.PackagePath);
             }
+        }
+    }
 
-            const FName ParamName(*Pair.Key);
-            if (!SwitchNames.Contains(ParamName))
+    if (!bBatch && !Failures[0].IsEmpty())
+    {
+        return MakeErrorResponse(ErrorCodeCreateFailed, Failures[0]);
+    }
+
+    FString ScError;
+    if (!MarkForAdd(NewPackageNames, ScError))
+    {
+        return MakeErrorResponse(ErrorCodeSourceControlFailed, ScError);
+    }
+
+    TMap<FString, FString> SaveErrors;
+    if (bSave && Packages.Num() > 0)
+    {
+        // One checkout call, and the file writes of one package overlap the next one's serialization.
+        TArray<FPackageSaver::FResult> SaveResults;
+        TSharedPtr<FJsonObject> CheckoutError;
+        if (!FPackageSaver::SavePackages(Packages, SaveResults, CheckoutError))
+        {
+            return CheckoutError.IsValid() ? CheckoutError : MakeErrorResponse(ErrorCodeSaveFailed, TEXT("Failed to save material instances"));
+        }
+        for (const FPackageSaver::FResult& SaveResult : SaveResults)
+        {
+            if (!SaveResult.bSaved)
             {
-                MissingSwitches.Add(Pair.Key);
-                continue;
+                SaveErrors.Add(SaveResult.PackageName, SaveResult.Error);
             }
+        }
+    }
+
+    if (!bBatch)
+    {
+        const FCreateSpec& CreateSpec = CreateSpecs[0];
+        if (SaveErrors.Contains(CreateSpec.PackagePath))
+        {
+            return MakeErrorResponse(ErrorCodeSaveFailed, TEXT("Failed to save material instance"));
+        }
 
-            const bool bValue = Pair.Value->AsBool();
-            bool bPreviousValue = false;
-            FGuid ExpressionGuid;
-            const bool bHadPreviousValue = MaterialInstance->GetStaticSwitchParameterValue(FMaterialParameterInfo(ParamName), bPreviousValue, ExpressionGuid);
-            MaterialInstance->SetStaticSwitchParameterValueEditorOnly(FMaterialParameterInfo(ParamName), bValue);
-            const bool bValueChanged = !bHadPreviousValue || bPreviousValue != bValue;
-            ChangedSwitches.Add(Pair.Key);
-            bModified = true;
-            bStaticSwitchChanged = bStaticSwitchChanged || bValueChanged;
+        const FInstanceOutcome& Outcome = Outcomes[0];
+        TSharedPtr<FJsonObject> Result = MakeSuccessResponse();
+        Result->SetStringField(TEXT("miObjectPath"), CreateSpec.Edit.ObjectPath);
+        Result->SetStringField(TEXT("parentClass"), CreateSpec.Parent->GetClass()->GetName());
+        Result->SetBoolField(TEXT("created"), true);
+        Result->SetObjectField(TEXT("changed"), BuildChangedJson(Outcome.ChangedScalars, Outcome.ChangedVectors, Outcome.ChangedTextures, Outcome.ChangedSwitches));
+        Result->SetObjectField(TEXT("notFound"), BuildNotFoundJson(Outcome.MissingScalars, Outcome.MissingVectors, Outcome.MissingTextures, Outcome.MissingSwitches));
+        Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, AuditActions));
+        return FShaderCompileWait::Begin(Params, Result, CreatedInstances);
+    }
 
-            TMap<FString, FString> Args;
-            Args.Add(TEXT("name"), Pair.Key);
-            Args.Add(TEXT("value"), bValue ? TEXT("true") : TEXT("false"));
-            AuditActions.Add(MakeShared<FJsonValueObject>(MakeActionJson(TEXT("set_switch"), Args)));
+    TArray<TSharedPtr<FJsonValue>> InstanceResults;
+    int32 NumFailed = 0;
+    int32 NumSaved = 0;
+    for (int32 Index = 0; Index < CreateSpecs.Num(); ++Index)
+    {
+        const FCreateSpec& CreateSpec = CreateSpecs[Index];
+        const FInstanceOutcome& Outcome = Outcomes[Index];
+        TSharedPtr<FJsonObject> InstanceResult = MakeShared<FJsonObject>();
+        InstanceResult->SetStringField(TEXT("miObjectPath"), CreateSpec.Edit.ObjectPath);
+        InstanceResult->SetStringField(TEXT("parentClass"), CreateSpec.Parent->GetClass()->GetName());
+        InstanceResult->SetBoolField(TEXT("created"), Failures[Index].IsEmpty());
+        if (!Failures[Index].IsEmpty())
+        {
+            ++NumFailed;
+            InstanceResult->SetStringField(TEXT("error"), Failures[Index]);
+            InstanceResults.Add(MakeShared<FJsonValueObject>(InstanceResult));
+            continue;
+        }
+
+        const FString* SaveError = SaveErrors.Find(CreateSpec.PackagePath);
+        const bool bSaved = bSave && !SaveError;
+        NumSaved += bSaved ? 1 : 0;
+        InstanceResult->SetBoolField(TEXT("saved"), bSaved);
+        if (SaveError)
+        {
+            InstanceResult->SetStringField(TEXT("saveError"), *SaveError);
+        }
+        InstanceResult->SetObjectField(TEXT("changed"), BuildChangedJson(Outcome.ChangedScalars, Outcome.ChangedVectors, Outcome.ChangedTextures, Outcome.ChangedSwitches));
+        InstanceResult->SetObjectField(TEXT("notFound"), BuildNotFoundJson(Outcome.MissingScalars, Outcome.MissingVectors, Outcome.MissingTextures, Outcome.MissingSwitches));
+        InstanceResults.Add(MakeShared<FJsonValueObject>(InstanceResult));
+    }
+
+    TSharedPtr<FJsonObject> Result = MakeSuccessResponse();
+    Result->SetArrayField(TEXT("instances"), InstanceResults);
+    Result->SetNumberField(TEXT("created"), CreatedInstances.Num());
+    Result->SetNumberField(TEXT("failed"), NumFailed);
+    Result->SetNumberField(TEXT("saved"), NumSaved);
+    Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, AuditActions));
+    return FShaderCompileWait::Begin(Params, Result, CreatedInstances);
+}
+
+TSharedPtr<FJsonObject> FMaterialInstanceTools::SetParameters(const TSharedPtr<FJsonObject>& Params)
+{
+    TSharedPtr<FJsonObject> ShaderWaitResponse;
+    if (FShaderCompileWait::Resume(ShaderWaitResponse))
+    {
+        return ShaderWaitResponse;
+    }
+
+    if (!Params.IsValid())
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+    }
+
+    TArray<TSharedPtr<FJsonObject>> Specs;
+    bool bBatch = false;
+    if (TSharedPtr<FJsonObject> SpecError = GatherSpecs(Params, Specs, bBatch))
+    {
+        return SpecError;
+    }
+
+    const bool bSave = !Params->HasField(TEXT("save")) || Params->GetBoolField(TEXT("save"));
+
+    // Everything is validated and loaded up front, so a bad entry fails the call before any
+    // instance is edited.
+    TArray<FInstanceEdit> Edits;
+    Edits.Reserve(Specs.Num());
+    TMap<FString, UTexture*> TextureCache;
+    for (int32 Index = 0; Index < Specs.Num(); ++Index)
+    {
+        FString ErrorCode;
+        FString Error;
+        if (!ParseInstanceEdit(Specs[Index], TextureCache, Edits.AddDefaulted_GetRef(), ErrorCode, Error))
+        {
+            return MakeErrorResponse(ErrorCode, bBatch ? FString::Printf(TEXT("instances[%d]: %s"), Index, *Error) : Error);
         }
     }
 
-    if (bStaticSwitchChanged)
+    TArray<FInstanceOutcome> Outcomes;
+    Outcomes.SetNum(Edits.Num());
+    TArray<TSharedPtr<FJsonValue>> AuditActions;
     {
-        MaterialInstance->InitStaticPermutation();
+        // One context for the whole call: shader maps, dependent instances and the components
+        // using the edited instances are refreshed once when it goes out of scope, not per edit.
+        FMaterialUpdateContext UpdateContext;
+        for (int32 Index = 0; Index < Edits.Num(); ++Index)
+        {
+            ApplyInstanceEdit(Edits[Index], UpdateContext, AuditActions, Outcomes[Index]);
+        }
     }
 
-    if (bModified)
+    TSet<UPackage*> PackagesToSave;
+    int32 NumModified = 0;
+    for (int32 Index = 0; Index < Edits.Num(); ++Index)
     {
-        MaterialInstance->PostEditChange();
-        MaterialInstance->MarkPackageDirty();
+        if (Outcomes[Index].bModified)
+        {
+            ++NumModified;
+            PackagesToSave.Add(Edits[Index].Instance->GetOutermost());
+        }
     }
 
-    if (bSave && bModified)
+    if (bSave && PackagesToSave.Num() > 0)
     {
-        if (!UEditorAssetLibrary::SaveAsset(NormalizedObjectPath, false))
+        TArray<UPackage*> PackagesArray = PackagesToSave.Array();
+        if (!UEditorLoadingAndSavingUtils::SavePackages(PackagesArray, /*bOnlyDirty*/false))
         {
-            return MakeErrorResponse(ErrorCodeSaveFailed, TEXT("Failed to save material instance"));
+            return MakeErrorResponse(ErrorCodeSaveFailed, bBatch ? TEXT("Failed to save material instances") : TEXT("Failed to save material instance"));
+        }
+    }
+
+    TArray<UMaterialInterface*> ModifiedInstances;
+    for (int32 Index = 0; Index < Edits.Num(); ++Index)
+    {
+        if (Outcomes[Index].bModified)
+        {
+            ModifiedInstances.Add(Edits[Index].Instance);
         }
     }
 
     TSharedPtr<FJsonObject> Result = MakeSuccessResponse();
-    Result->SetStringField(TEXT("miObjectPath"), NormalizedObjectPath);
-    Result->SetBoolField(TEXT("modified"), bModified);
-    Result->SetBoolField(TEXT("saved"), bSave && bModified);
-    Result->SetObjectField(TEXT("changed"), BuildChangedJson(ChangedScalars, ChangedVectors, ChangedTextures, ChangedSwitches));
-    Result->SetObjectField(TEXT("notFound"), BuildNotFoundJson(MissingScalars, MissingVectors, MissingTextures, MissingSwitches));
-    Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, AuditActions));
+    if (!bBatch)
+    {
+        Result->SetStringField(TEXT("miObjectPath"), Edits[0].ObjectPath);
+        WriteOutcomeFields(Outcomes[0], Result);
+        Result->SetBoolField(TEXT("saved"), bSave && Outcomes[0].bModified);
+        Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, AuditActions));
+        return FShaderCompileWait::Begin(Params, Result, ModifiedInstances);
+    }
 
-    return Result;
+    TArray<TSharedPtr<FJsonValue>> InstanceResults;
+    for (int32 Index = 0; Index < Edits.Num(); ++Index)
+    {
+        TSharedPtr<FJsonObject> InstanceResult = MakeShared<FJsonObject>();
+        InstanceResult->SetStringField(TEXT("miObjectPath"), Edits[Index].ObjectPath);
+        WriteOutcomeFields(Outcomes[Index], InstanceResult);
+        InstanceResult->SetBoolField(TEXT("saved"), bSave && Outcomes[Index].bModified);
+        InstanceResults.Add(MakeShared<FJsonValueObject>(InstanceResult));
+    }
+
+    Result->SetArrayField(TEXT("instances"), InstanceResults);
+    Result->SetNumberField(TEXT("modified"), NumModified);
+    Result->SetNumberField(TEXT("saved"), bSave ? PackagesToSave.Num() : 0);
+    Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, AuditActions));
+    return FShaderCompileWait::Begin(Params, Result, ModifiedInstances);
 }
@@ -0,0 +1,173 @@
+#include "Materials/ShaderCompileWait.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "MaterialShared.h"
+#include "Materials/MaterialInterface.h"
+#include "Protocol/CommandContext.h"
+#include "RHI.h"
+#include "ShaderCompiler.h"
+#include "UObject/WeakObjectPtr.h"
+
+namespace
+{
+    constexpr double DefaultTimeoutMs = 120000.0;
+    constexpr double MaxTimeoutMs = 600000.0;
+    const FName ShaderWaitStage(TEXT("shaders"));
+
+    struct FShaderWait : public UnrealMCP::Protocol::FCommandContext::FResumeState
+    {
+        TArray<TWeakObjectPtr<UMaterialInterface>> Materials;
+        /** The command's success payload, sent once the wait ends. */
+        TSharedPtr<FJsonObject> Response;
+        double StartSeconds = 0.0;
+        double TimeoutSeconds = 0.0;
+        /** Most jobs the compiling manager had left at any poll; the progress total. */
+        int32 PeakJobs = 0;
+    };
+
+    /** The resource the editor renders Material with; an instance without static overrides answers with its parent's. */
+    FMaterialResource* GetRenderedResource(UMaterialInterface* Material)
+    {
+        return Material ? Material->GetMaterialResource(GMaxRHIFeatureLevel) : nullptr;
+    }
+
+    int32 GetRemainingJobs()
+    {
+        return GShaderCompilingManager ? GShaderCompilingManager->GetNumRemainingJobs() : 0;
+    }
+
+    TArray<FString> CollectPending(const FShaderWait& Wait)
+    {
+        TArray<FString> Pending;
+        for (const TWeakObjectPtr<UMaterialInterface>& Material : Wait.Materials)
+        {
+            const FMaterialResource* Resource = GetRenderedResource(Material.Get());
+            if (Resource && !Resource->IsCompilationFinished())
+            {
+                Pending.Add(Material->GetPathName());
+            }
+        }
+        return Pending;
+    }
+
+    TSharedPtr<FJsonObject> Finish(const FShaderWait& Wait, const TArray<FString>& Pending, bool bTimedOut, bool bCancelled)
+    {
+        TArray<TSharedPtr<FJsonValue>> PendingJson;
+        for (const FString& Path : Pending)
+        {
+            PendingJson.Add(MakeShared<FJsonValueString>(Path));
+        }
+
+        TSharedPtr<FJsonObject> Shaders = MakeShared<FJsonObject>();
+        Shaders->SetBoolField(TEXT("complete"), Pending.Num() == 0);
+        Shaders->SetNumberField(TEXT("elapsedMs"), (FPlatformTime::Seconds() - Wait.StartSeconds) * 1000.0);
+        Shaders->SetNumberField(TEXT("remainingJobs"), GetRemainingJobs());
+        Shaders->SetArrayField(TEXT("pending"), PendingJson);
+        if (bTimedOut)
+        {
+            Shaders->SetBoolField(TEXT("timedOut"), true);
+        }
+        if (bCancelled)
+        {
+            Shaders->SetBoolField(TEXT("cancelled"), true);
+        }
+        Wait.Response->SetObjectField(TEXT("shaders"), Shaders);
+        return Wait.Response;
+    }
+
+    /** One frame of the wait: the finished response, or null after suspending until the next frame. */
+    TSharedPtr<FJsonObject> Poll(const TSharedRef<FShaderWait>& Wait, UnrealMCP::Protocol::FCommandContext& Context)
+    {
+        const TArray<FString> Pending = CollectPending(*Wait);
+        const int32 RemainingJobs = GetRemainingJobs();
+        Wait->PeakJobs = FMath::Max(Wait->PeakJobs, RemainingJobs);
+        // The manager's count covers every material compiling, so it only reads as done once ours are.
+        const int32 Total = FMath::Max(Wait->PeakJobs, 1);
+        const int32 Done = Pending.Num() == 0 ? Total : FMath::Clamp(Total - RemainingJobs, 0, Total - 1);
+        Context.ReportProgress(Done, Total, TEXT("shaders"));
+
+        if (Pending.Num() == 0)
+        {
+            return Finish(*Wait, Pending, false, false);
+        }
+        // The shaders keep compiling either way; only the wait for them ends.
+        if (Context.IsCancelled())
+        {
+            return Finish(*Wait, Pending, false, true);
+        }
+        if (FPlatformTime::Seconds() - Wait->StartSeconds > Wait->TimeoutSeconds)
+        {
+            return Finish(*Wait, Pending, true, false);
+        }
+
+        Context.Suspend(Wait);
+        return nullptr;
+    }
+}
+
+bool FShaderCompileWait::IsRequested(const TSharedPtr<FJsonObject>& Params)
+{
+    FString WaitFor;
+    return Params.IsValid() && Params->TryGetStringField(TEXT("waitFor"), WaitFor) && WaitFor.Equals(TEXT("shaders"), ESearchCase::IgnoreCase);
+}
+
+TSharedPtr<FJsonObject> FShaderCompileWait::Begin(const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonObject>& Response, const TArray<UMaterialInterface*>& Materials)
+{
+    if (!Response.IsValid() || !IsRequested(Params))
+    {
+        return Response;
+    }
+
+    double TimeoutMs = DefaultTimeoutMs;
+    Params->TryGetNumberField(TEXT("shaderTimeoutMs"), TimeoutMs);
+
+    TSharedRef<FShaderWait> Wait = MakeShared<FShaderWait>();
+    Wait->Stage = ShaderWaitStage;
+    Wait->Response = Response;
+    Wait->StartSeconds = FPlatformTime::Seconds();
+    Wait->TimeoutSeconds = FMath::Clamp(TimeoutMs, 0.0, MaxTimeoutMs) / 1000.0;
+    for (UMaterialInterface* Material : Materials)
+    {
+        if (Material)
+        {
+            Wait->Materials.AddUnique(Material);
+        }
+    }
+
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+    if (!Context || !Context->CanSuspend())
+    {
+        // A batch entry has to finish inside its slice, so it pays for the compile up front.
+        for (const TWeakObjectPtr<UMaterialInterface>& Material : Wait->Materials)
+        {
+            FMaterialResource* Resource = GetRenderedResource(Material.Get());
+            if (Resource && !Resource->IsCompilationFinished())
+            {
+                Resource->FinishCompilation();
+            }
+        }
+        return Finish(*Wait, CollectPending(*Wait), false, false);
+    }
+
+    return Poll(Wait, *Context);
+}
+
+bool FShaderCompileWait::Resume(TSharedPtr<FJsonObject>& OutResponse)
+{
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+    if (!Context || Context->GetResumeStage() != ShaderWaitStage)
+    {
+        return false;
+    }
+
+    TSharedPtr<FShaderWait> Wait = Context->TakeResumeState<FShaderWait>();
+    if (!Wait.IsValid())
+    {
+        return false;
+    }
+
+    OutResponse = Poll(Wait.ToSharedRef(), *Context);
+    return true;
+}
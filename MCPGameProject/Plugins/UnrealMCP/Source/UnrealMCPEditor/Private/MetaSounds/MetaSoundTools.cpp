@@ -1,11 +1,51 @@
 #include "MetaSounds/MetaSoundTools.h"
 #include "CoreMinimal.h"
 
+#include "Async/Async.h"
+#include "Algo/Transform.h"
+#include "Async/ParallelFor.h"
+#include "AudioParameter.h"
 #include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Engine/Engine.h"
+#include "HAL/PlatformTime.h"
+#include "MetasoundGenerator.h"
+#include "MetasoundSource.h"
+#include "Misc/Base64.h"
+#include "Protocol/CommandContext.h"
+#include "Protocol/ResponseStream.h"
+#include "Sound/SoundGenerator.h"
+#include "UObject/UObjectGlobals.h"
+
+#include <atomic>
 
 namespace
 {
         constexpr const TCHAR* ErrorCodeNotImplemented = TEXT("NOT_IMPLEMENTED");
+        constexpr const TCHAR* ErrorCodeInvalidParams = TEXT("INVALID_PARAMETERS");
+        constexpr const TCHAR* ErrorCodeAssetNotFound = TEXT("ASSET_NOT_FOUND");
+        constexpr const TCHAR* ErrorCodeRenderFailed = TEXT("RENDER_FAILED");
+        constexpr const TCHAR* ErrorCodeRenderTimeout = TEXT("RENDER_TIMEOUT");
+        constexpr const TCHAR* ErrorCodeCancelled = TEXT("CANCELLED");
+
+        constexpr double DefaultDurationSeconds = 5.0;
+        constexpr double MaxDurationSeconds = 120.0;
+        constexpr int32 DefaultSampleRate = 48000;
+        constexpr int32 MinSampleRate = 8000;
+        constexpr int32 MaxSampleRate = 192000;
+        constexpr int32 MaxVariantsPerRender = 64;
+        /** Grid combinations one metasound.sweep may render. */
+        constexpr int32 MaxSweepVariants = 1024;
+        /** Audio one sweep may render when it keeps no samples, summed over its variants. */
+        constexpr double MaxSweepAudioSeconds = 4.0 * 3600.0;
+        /** Samples (frames x channels) one call may hold across all of its variants: 256 MB of floats. */
+        constexpr int64 MaxTotalSamples = 64 * 1024 * 1024;
+        constexpr double DefaultRenderTimeoutSeconds = 120.0;
+        constexpr double MaxRenderTimeoutSeconds = 1800.0;
+        /** How long the generator may take to build its graph before the render gives up. */
+        constexpr double GraphBuildTimeoutSeconds = 30.0;
+        /** Bytes per streamed chunk; a multiple of 3, so each chunk is whole base64 groups. */
+        constexpr int32 StreamChunkBytes = 3 * 64 * 1024;
 
         TSharedPtr<FJsonObject> MakeNotImplementedResponse(const FString& Command)
         {
@@ -16,6 +56,1021 @@ namespace
                 Result->SetStringField(TEXT("error"), FString::Printf(TEXT("MetaSound command '%s' is not implemented yet."), *Command));
                 return Result;
         }
+
+        TSharedPtr<FJsonObject> MakeErrorResponse(const FString& Code, const FString& Message)
+        {
+                TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+                Error->SetBoolField(TEXT("success"), false);
+                Error->SetBoolField(TEXT("ok"), false);
+                Error->SetStringField(TEXT("errorCode"), Code);
+                Error->SetStringField(TEXT("error"), Message);
+                return Error;
+        }
+
+        TSharedPtr<FJsonObject> MakeSuccessResponse()
+        {
+                TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+                Result->SetBoolField(TEXT("success"), true);
+                Result->SetBoolField(TEXT("ok"), true);
+                return Result;
+        }
+
+        enum class ERenderFormat : uint8
+        {
+                /** 16-bit PCM in a RIFF/WAVE container. */
+                Wav,
+                /** Raw interleaved 32-bit float samples, little endian. */
+                PcmFloat
+        };
+
+        /** Analysis window of the spectral summary; a power of two. */
+        constexpr int32 SpectrumFftSize = 2048;
+        /** Share of the spectral energy below the rolloff frequency. */
+        constexpr double SpectralRolloffShare = 0.85;
+
+        /** In-place iterative radix-2 FFT; Re and Im hold Num (a power of two) values. */
+        void ComputeFft(double* Re, double* Im, int32 Num)
+        {
+                for (int32 Index = 1, Reversed = 0; Index < Num; ++Index)
+                {
+                        int32 Bit = Num >> 1;
+                        for (; Reversed & Bit; Bit >>= 1)
+                        {
+                                Reversed ^= Bit;
+                        }
+                        Reversed ^= Bit;
+                        if (Index < Reversed)
+                        {
+                                Swap(Re[Index], Re[Reversed]);
+                                Swap(Im[Index], Im[Reversed]);
+                        }
+                }
+
+                for (int32 Length = 2; Length <= Num; Length <<= 1)
+                {
+                        const double Angle = -2.0 * UE_DOUBLE_PI / Length;
+                        const double StepRe = FMath::Cos(Angle);
+                        const double StepIm = FMath::Sin(Angle);
+                        for (int32 Start = 0; Start < Num; Start += Length)
+                        {
+                                double TwiddleRe = 1.0;
+                                double TwiddleIm = 0.0;
+                                for (int32 Offset = 0; Offset < Length / 2; ++Offset)
+                                {
+                                        const int32 Even = Start + Offset;
+                                        const int32 Odd = Even + Length / 2;
+                                        const double OddRe = Re[Odd] * TwiddleRe - Im[Odd] * TwiddleIm;
+                                        const double OddIm = Re[Odd] * TwiddleIm + Im[Odd] * TwiddleRe;
+                                        Re[Odd] = Re[Even] - OddRe;
+                                        Im[Odd] = Im[Even] - OddIm;
+                                        Re[Even] += OddRe;
+                                        Im[Even] += OddIm;
+                                        const double NextRe = TwiddleRe * StepRe - TwiddleIm * StepIm;
+                                        TwiddleIm = TwiddleRe * StepIm + TwiddleIm * StepRe;
+                                        TwiddleRe = NextRe;
+                                }
+                        }
+                }
+        }
+
+        double ToDecibels(double Power, double Floor = -120.0)
+        {
+                return Power > 0.0 ? FMath::Max(Floor, 10.0 * FMath::LogX(10.0, Power)) : Floor;
+        }
+
+        /**
+         * Running summary of a render, fed block by block on the worker: peak and RMS level,
+         * integrated loudness (ITU-R BS.1770 K-weighting with its absolute and relative gates)
+         * and the shape of the average spectrum of the mono downmix.
+         */
+        class FAudioAnalyzer
+        {
+        public:
+                FAudioAnalyzer(int32 InNumChannels, int32 InSampleRate)
+                        : NumChannels(InNumChannels)
+                        , SampleRate(InSampleRate)
+                        , StepFrames(FMath::Max(1, InSampleRate / 10))
+                {
+                        for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+                        {
+                                Shelves.Add(FBiquad::MakeHighShelf(SampleRate));
+                                HighPasses.Add(FBiquad::MakeHighPass(SampleRate));
+                                // 5.1 layouts weight the surrounds up and leave the LFE out.
+                                ChannelWeights.Add(NumChannels >= 6 ? (Channel == 3 ? 0.0 : (Channel >= 4 ? 1.41 : 1.0)) : 1.0);
+                        }
+                        Window.SetNumUninitialized(SpectrumFftSize);
+                        for (int32 Index = 0; Index < SpectrumFftSize; ++Index)
+                        {
+                                Window[Index] = 0.5 - 0.5 * FMath::Cos(2.0 * UE_DOUBLE_PI * Index / (SpectrumFftSize - 1));
+                        }
+                        SpectrumPower.SetNumZeroed(SpectrumFftSize / 2 + 1);
+                        FrameBuffer.Reserve(SpectrumFftSize);
+                }
+
+                void Process(const float* Interleaved, int32 NumFrames)
+                {
+                        for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+                        {
+                                const float* Samples = Interleaved + static_cast<int64>(Frame) * NumChannels;
+                                double Mono = 0.0;
+                                for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+                                {
+                                        const double Sample = Samples[Channel];
+                                        Peak = FMath::Max(Peak, FMath::Abs(Sample));
+                                        SumSquares += Sample * Sample;
+                                        const double Weighted = HighPasses[Channel].Process(Shelves[Channel].Process(Sample));
+                                        StepPower += ChannelWeights[Channel] * Weighted * Weighted;
+                                        Mono += Sample;
+                                }
+
+                                if (++StepFill == StepFrames)
+                                {
+                                        StepPowers.Add(StepPower / StepFrames);
+                                        StepPower = 0.0;
+                                        StepFill = 0;
+                                }
+
+                                FrameBuffer.Add(Mono / NumChannels);
+                                if (FrameBuffer.Num() == SpectrumFftSize)
+                                {
+                                        AccumulateSpectrum();
+                                }
+                        }
+                        TotalFrames += NumFrames;
+                }
+
+                void Summarize(FJsonObject& Out)
+                {
+                        if (FrameBuffer.Num() > 0 && NumSpectra == 0)
+                        {
+                                // Shorter than one window: zero-padded so it still gets a spectrum.
+                                FrameBuffer.SetNumZeroed(SpectrumFftSize);
+                                AccumulateSpectrum();
+                        }
+
+                        const double SampleCount = static_cast<double>(FMath::Max<int64>(1, TotalFrames * NumChannels));
+                        Out.SetNumberField(TEXT("peakDb"), ToDecibels(Peak * Peak));
+                        Out.SetNumberField(TEXT("rmsDb"), ToDecibels(SumSquares / SampleCount));
+                        Out.SetNumberField(TEXT("loudnessLufs"), ComputeIntegratedLoudness());
+                        Out.SetBoolField(TEXT("silent"), Peak < 1.0e-5);
+
+                        double Total = 0.0;
+                        double Weighted = 0.0;
+                        double LogSum = 0.0;
+                        const double BinHz = static_cast<double>(SampleRate) / SpectrumFftSize;
+                        for (int32 Bin = 1; Bin < SpectrumPower.Num(); ++Bin)
+                        {
+                                Total += SpectrumPower[Bin];
+                                Weighted += SpectrumPower[Bin] * Bin * BinHz;
+                                LogSum += FMath::Loge(SpectrumPower[Bin] + 1.0e-20);
+                        }
+                        if (Total <= 0.0)
+                        {
+                                Out.SetNumberField(TEXT("spectralCentroidHz"), 0.0);
+                                Out.SetNumberField(TEXT("spectralRolloffHz"), 0.0);
+                                Out.SetNumberField(TEXT("spectralFlatness"), 0.0);
+                                return;
+                        }
+
+                        double Rolloff = 0.0;
+                        double Running = 0.0;
+                        for (int32 Bin = 1; Bin < SpectrumPower.Num(); ++Bin)
+                        {
+                                Running += SpectrumPower[Bin];
+                                if (Running >= SpectralRolloffShare * Total)
+                                {
+                                        Rolloff = Bin * BinHz;
+                                        break;
+                                }
+                        }
+                        const int32 NumBins = SpectrumPower.Num() - 1;
+                        Out.SetNumberField(TEXT("spectralCentroidHz"), Weighted / Total);
+                        Out.SetNumberField(TEXT("spectralRolloffHz"), Rolloff);
+                        // Geometric over arithmetic mean: near 1 for noise, near 0 for pure tones.
+                        Out.SetNumberField(TEXT("spectralFlatness"), FMath::Exp(LogSum / NumBins) / (Total / NumBins));
+                }
+
+        private:
+                struct FBiquad
+                {
+                        double B0 = 1.0, B1 = 0.0, B2 = 0.0, A1 = 0.0, A2 = 0.0;
+                        double Z1 = 0.0, Z2 = 0.0;
+
+                        double Process(double In)
+                        {
+                                const double Out = B0 * In + Z1;
+                                Z1 = B1 * In - A1 * Out + Z2;
+                                Z2 = B2 * In - A2 * Out;
+                                return Out;
+                        }
+
+                        /** First K-weighting stage (the head's acoustic effect), designed for any sample rate. */
+                        static FBiquad MakeHighShelf(int32 Rate)
+                        {
+                                const double A = FMath::Pow(10.0, 3.999843853973347 / 40.0);
+                                const double W0 = 2.0 * UE_DOUBLE_PI * 1681.974450955533 / Rate;
+                                const double Alpha = FMath::Sin(W0) / (2.0 * 0.7071752369554196);
+                                const double CosW0 = FMath::Cos(W0);
+                                const double SqrtA = FMath::Sqrt(A);
+                                const double A0 = (A + 1.0) - (A - 1.0) * CosW0 + 2.0 * SqrtA * Alpha;
+                                FBiquad Filter;
+                                Filter.B0 = A * ((A + 1.0) + (A - 1.0) * CosW0 + 2.0 * SqrtA * Alpha) / A0;
+                                Filter.B1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * CosW0) / A0;
+                                Filter.B2 = A * ((A + 1.0) + (A - 1.0) * CosW0 - 2.0 * SqrtA * Alpha) / A0;
+                                Filter.A1 = 2.0 * ((A - 1.0) - (A + 1.0) * CosW0) / A0;
+                                Filter.A2 = ((A + 1.0) - (A - 1.0) * CosW0 - 2.0 * SqrtA * Alpha) / A0;
+                                return Filter;
+                        }
+
+                        /** Second K-weighting stage (the RLB high-pass). */
+                        static FBiquad MakeHighPass(int32 Rate)
+                        {
+                                const double W0 = 2.0 * UE_DOUBLE_PI * 38.13547087613982 / Rate;
+                                const double Alpha = FMath::Sin(W0) / (2.0 * 0.5003270373253953);
+                                const double CosW0 = FMath::Cos(W0);
+                                const double A0 = 1.0 + Alpha;
+                                FBiquad Filter;
+                                Filter.B0 = (1.0 + CosW0) / 2.0 / A0;
+                                Filter.B1 = -(1.0 + CosW0) / A0;
+                                Filter.B2 = (1.0 + CosW0) / 2.0 / A0;
+                                Filter.A1 = -2.0 * CosW0 / A0;
+                                Filter.A2 = (1.0 - Alpha) / A0;
+                                return Filter;
+                        }
+                };
+
+                void AccumulateSpectrum()
+                {
+                        TArray<double> Re;
+                        TArray<double> Im;
+                        Re.SetNumUninitialized(SpectrumFftSize);
+                        Im.SetNumZeroed(SpectrumFftSize);
+                        for (int32 Index = 0; Index < SpectrumFftSize; ++Index)
+                        {
+                                Re[Index] = FrameBuffer[Index] * Window[Index];
+                        }
+                        ComputeFft(Re.GetData(), Im.GetData(), SpectrumFftSize);
+                        for (int32 Bin = 0; Bin < SpectrumPower.Num(); ++Bin)
+                        {
+                                SpectrumPower[Bin] += Re[Bin] * Re[Bin] + Im[Bin] * Im[Bin];
+                        }
+                        FrameBuffer.Reset();
+                        ++NumSpectra;
+                }
+
+                /** Gated mean of the 400 ms blocks (100 ms apart); the whole render when it is shorter. */
+                double ComputeIntegratedLoudness() const
+                {
+                        auto ToLufs = [](double Power) { return Power > 0.0 ? -0.691 + 10.0 * FMath::LogX(10.0, Power) : -120.0; };
+
+                        TArray<double> Blocks;
+                        for (int32 Step = 3; Step < StepPowers.Num(); ++Step)
+                        {
+                                Blocks.Add((StepPowers[Step - 3] + StepPowers[Step - 2] + StepPowers[Step - 1] + StepPowers[Step]) / 4.0);
+                        }
+                        if (Blocks.Num() == 0)
+                        {
+                                double Sum = StepPower;
+                                for (double Power : StepPowers)
+                                {
+                                        Sum += Power * StepFrames;
+                                }
+                                return ToLufs(Sum / FMath::Max<int64>(1, TotalFrames));
+                        }
+
+                        auto GatedMean = [&Blocks, &ToLufs](double GateLufs, double& OutMean)
+                        {
+                                double Sum = 0.0;
+                                int32 Count = 0;
+                                for (double Power : Blocks)
+                                {
+                                        if (ToLufs(Power) > GateLufs)
+                                        {
+                                                Sum += Power;
+                                                ++Count;
+                                        }
+                                }
+                                OutMean = Count > 0 ? Sum / Count : 0.0;
+                                return Count > 0;
+                        };
+
+                        double AbsoluteMean = 0.0;
+                        if (!GatedMean(-70.0, AbsoluteMean))
+                        {
+                                return -120.0;
+                        }
+                        double RelativeMean = 0.0;
+                        GatedMean(FMath::Max(-70.0, ToLufs(AbsoluteMean) - 10.0), RelativeMean);
+                        return ToLufs(RelativeMean);
+                }
+
+                int32 NumChannels;
+                int32 SampleRate;
+                int32 StepFrames;
+                TArray<FBiquad> Shelves;
+                TArray<FBiquad> HighPasses;
+                TArray<double> ChannelWeights;
+                TArray<double> Window;
+                TArray<double> SpectrumPower;
+                TArray<double> FrameBuffer;
+                TArray<double> StepPowers;
+                double Peak = 0.0;
+                double SumSquares = 0.0;
+                double StepPower = 0.0;
+                int32 StepFill = 0;
+                int32 NumSpectra = 0;
+                int64 TotalFrames = 0;
+        };
+
+        /**
+         * One variant being rendered. The generator is created on the game thread and, once its
+         * graph is built, handed to a background task that pulls blocks from it as fast as it
+         * produces them into Samples, publishing the frames it has written through FramesRendered.
+         */
+        struct FRenderJob
+        {
+                ISoundGeneratorPtr Generator;
+                int32 NumChannels = 0;
+                int32 TotalFrames = 0;
+                bool bStopWhenFinished = true;
+                /**
+                 * Interleaved, sized for TotalFrames up front so the game thread can read behind the
+                 * writer. A job that keeps no samples renders into one block here instead.
+                 */
+                TArray<float> Samples;
+                bool bKeepSamples = true;
+                /** Fed every block on the worker when the caller wants a summary rather than (or as well as) audio. */
+                TUniquePtr<FAudioAnalyzer> Analyzer;
+                TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+
+                /** Set from the generator's graph callback; game thread dispatches the job once it is. */
+                TSharedRef<std::atomic<bool>, ESPMode::ThreadSafe> bGraphReady = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+                FDelegateHandle GraphSetHandle;
+                bool bDispatched = false;
+
+                std::atomic<int32> FramesRendered{0};
+                std::atomic<bool> bCancel{false};
+                std::atomic<bool> bDone{false};
+                /** The source finished before TotalFrames; FramesRendered is where it ended. */
+                std::atomic<bool> bFinishedEarly{false};
+                /** Set by the worker before bDone; read only after it. */
+                FString Error;
+                double RenderSeconds = 0.0;
+
+                /** Streamed output: frames already converted and the bytes not yet sent. */
+                int32 FramesStreamed = 0;
+                TArray<uint8> PendingBytes;
+        };
+
+        /**
+         * Watches for the generator's graph. The generator builds it on a task of its own and
+         * renders silence until it is in, so a job is only handed to a worker once it is.
+         */
+        void WatchGraph(FRenderJob& Job)
+        {
+                TSharedRef<std::atomic<bool>, ESPMode::ThreadSafe> bGraphReady = Job.bGraphReady;
+                Metasound::FMetasoundGenerator& Generator = static_cast<Metasound::FMetasoundGenerator&>(*Job.Generator);
+                Job.GraphSetHandle = Generator.AddGraphSetCallback(Metasound::FOnSetGraph::FDelegate::CreateLambda([bGraphReady]()
+                {
+                        bGraphReady->store(true);
+                }));
+        }
+
+        void UnwatchGraph(FRenderJob& Job)
+        {
+                if (Job.GraphSetHandle.IsValid())
+                {
+                        static_cast<Metasound::FMetasoundGenerator&>(*Job.Generator).RemoveGraphSetCallback(Job.GraphSetHandle);
+                        Job.GraphSetHandle.Reset();
+                }
+        }
+
+        /** The worker's side of a job: renders every block, then marks it done. Any thread. */
+        void RenderJob(FRenderJob& Job)
+        {
+                const double StartSeconds = FPlatformTime::Seconds();
+                const int32 BlockFrames = FMath::Max(1, Job.Generator->GetDesiredNumSamplesToRenderPerCallback() / Job.NumChannels);
+                if (!Job.bKeepSamples)
+                {
+                        Job.Samples.SetNumZeroed(BlockFrames * Job.NumChannels);
+                }
+
+                int32 Frame = 0;
+                while (Frame < Job.TotalFrames && !Job.bCancel.load())
+                {
+                        const int32 Frames = FMath::Min(BlockFrames, Job.TotalFrames - Frame);
+                        float* Block = Job.Samples.GetData() + (Job.bKeepSamples ? static_cast<int64>(Frame) * Job.NumChannels : 0);
+                        Job.Generator->OnGenerateAudio(Block, Frames * Job.NumChannels);
+                        if (Job.Analyzer)
+                        {
+                                Job.Analyzer->Process(Block, Frames);
+                        }
+                        Frame += Frames;
+                        Job.FramesRendered.store(Frame, std::memory_order_release);
+
+                        if (Job.bStopWhenFinished && Job.Generator->IsFinished())
+                        {
+                                Job.bFinishedEarly.store(Frame < Job.TotalFrames);
+                                break;
+                        }
+                }
+
+                if (Job.Analyzer && !Job.bCancel.load())
+                {
+                        Job.Analyzer->Summarize(*Job.Summary);
+                }
+                Job.RenderSeconds = FPlatformTime::Seconds() - StartSeconds;
+                Job.bDone.store(true, std::memory_order_release);
+        }
+
+        /** Appends Frames of Samples, starting at FirstFrame, to Out in Format's sample layout. */
+        void AppendSamples(const FRenderJob& Job, int32 FirstFrame, int32 Frames, ERenderFormat Format, TArray<uint8>& Out)
+        {
+                const float* Source = Job.Samples.GetData() + static_cast<int64>(FirstFrame) * Job.NumChannels;
+                const int32 Count = Frames * Job.NumChannels;
+                if (Format == ERenderFormat::PcmFloat)
+                {
+                        const int32 Start = Out.AddUninitialized(Count * sizeof(float));
+                        FMemory::Memcpy(Out.GetData() + Start, Source, Count * sizeof(float));
+                        return;
+                }
+
+                const int32 Start = Out.AddUninitialized(Count * sizeof(int16));
+                int16* Dest = reinterpret_cast<int16*>(Out.GetData() + Start);
+                for (int32 Index = 0; Index < Count; ++Index)
+                {
+                        Dest[Index] = static_cast<int16>(FMath::Clamp(Source[Index], -1.0f, 1.0f) * 32767.0f);
+                }
+        }
+
+        /** The 44-byte RIFF/WAVE header of a 16-bit PCM file holding Frames frames. */
+        TArray<uint8> MakeWavHeader(int32 Frames, int32 NumChannels, int32 SampleRate)
+        {
+                const uint32 DataBytes = static_cast<uint32>(Frames) * NumChannels * sizeof(int16);
+                TArray<uint8> Header;
+                Header.Reserve(44);
+                auto Append = [&Header](const void* Data, int32 Bytes)
+                {
+                        Header.Append(static_cast<const uint8*>(Data), Bytes);
+                };
+                auto AppendU32 = [&Append](uint32 Value) { Append(&Value, sizeof(Value)); };
+                auto AppendU16 = [&Append](uint16 Value) { Append(&Value, sizeof(Value)); };
+
+                Append("RIFF", 4);
+                AppendU32(36 + DataBytes);
+                Append("WAVEfmt ", 8);
+                AppendU32(16);
+                AppendU16(1);
+                AppendU16(static_cast<uint16>(NumChannels));
+                AppendU32(static_cast<uint32>(SampleRate));
+                AppendU32(static_cast<uint32>(SampleRate) * NumChannels * sizeof(int16));
+                AppendU16(static_cast<uint16>(NumChannels * sizeof(int16)));
+                AppendU16(16);
+                Append("data", 4);
+                AppendU32(DataBytes);
+                return Header;
+        }
+
+        /** The whole output of a finished job. */
+        TArray<uint8> EncodeJob(const FRenderJob& Job, ERenderFormat Format, int32 SampleRate)
+        {
+                const int32 Frames = Job.FramesRendered.load(std::memory_order_acquire);
+                TArray<uint8> Bytes;
+                if (Format == ERenderFormat::Wav)
+                {
+                        Bytes = MakeWavHeader(Frames, Job.NumChannels, SampleRate);
+                }
+                AppendSamples(Job, 0, Frames, Format, Bytes);
+                return Bytes;
+        }
+
+        /** metasound.render between frames: the jobs on the workers and how to deliver them. */
+        struct FRenderWait : public UnrealMCP::Protocol::FCommandContext::FResumeState
+        {
+                FString SourcePath;
+                ERenderFormat Format = ERenderFormat::Wav;
+                int32 SampleRate = DefaultSampleRate;
+                bool bBatch = false;
+                /** metasound.sweep: each job's grid values, and whether its audio goes back too. */
+                bool bSweep = false;
+                bool bIncludeAudio = true;
+                TArray<FString> GridKeys;
+                TArray<TSharedPtr<FJsonObject>> GridValues;
+                /** Shared with the worker tasks, which may outlive a cancelled wait. */
+                TArray<TSharedPtr<FRenderJob, ESPMode::ThreadSafe>> Jobs;
+                double StartSeconds = 0.0;
+                double TimeoutSeconds = DefaultRenderTimeoutSeconds;
+                /** Streams the single job's output as it renders. */
+                bool bStreaming = false;
+        };
+
+        const TCHAR* GetContentType(ERenderFormat Format)
+        {
+                return Format == ERenderFormat::Wav ? TEXT("audio/wav") : TEXT("audio/L32f");
+        }
+
+        /** Sends the streamed job's newly rendered frames, keeping a remainder that is not whole base64 groups. */
+        void StreamRendered(FRenderWait& Wait, FRenderJob& Job, UnrealMCP::Protocol::FResponseStream& Stream, bool bFinal)
+        {
+                if (!Stream.HasBegun())
+                {
+                        Stream.Begin(TEXT("audio"), FString::Printf(TEXT("%s;base64"), GetContentType(Wait.Format)));
+                        if (Wait.Format == ERenderFormat::Wav)
+                        {
+                                // The stream cannot rewrite its header, so it announces the full
+                                // duration; a source that finishes early is padded with silence.
+                                Job.PendingBytes = MakeWavHeader(Job.TotalFrames, Job.NumChannels, Wait.SampleRate);
+                        }
+                }
+
+                const int32 Rendered = Job.FramesRendered.load(std::memory_order_acquire);
+                AppendSamples(Job, Job.FramesStreamed, Rendered - Job.FramesStreamed, Wait.Format, Job.PendingBytes);
+                Job.FramesStreamed = Rendered;
+
+                if (bFinal && Wait.Format == ERenderFormat::Wav && Rendered < Job.TotalFrames)
+                {
+                        Job.PendingBytes.AddZeroed((Job.TotalFrames - Rendered) * Job.NumChannels * sizeof(int16));
+                }
+
+                int32 Sent = 0;
+                while (Job.PendingBytes.Num() - Sent >= StreamChunkBytes || (bFinal && Sent < Job.PendingBytes.Num()))
+                {
+                        const int32 Bytes = FMath::Min(StreamChunkBytes, Job.PendingBytes.Num() - Sent);
+                        Stream.WriteChunk(FBase64::Encode(Job.PendingBytes.GetData() + Sent, Bytes));
+                        Sent += Bytes;
+                }
+                Job.PendingBytes.RemoveAt(0, Sent, EAllowShrinking::No);
+        }
+
+        void DescribeJob(const FRenderWait& Wait, const FRenderJob& Job, FJsonObject& Out)
+        {
+                const int32 Frames = Job.FramesRendered.load(std::memory_order_acquire);
+                Out.SetNumberField(TEXT("frames"), Frames);
+                Out.SetNumberField(TEXT("durationSec"), static_cast<double>(Frames) / Wait.SampleRate);
+                Out.SetBoolField(TEXT("finishedEarly"), Job.bFinishedEarly.load());
+                Out.SetNumberField(TEXT("renderMs"), Job.RenderSeconds * 1000.0);
+                if (Job.RenderSeconds > 0.0)
+                {
+                        Out.SetNumberField(TEXT("realtimeFactor"), (static_cast<double>(Frames) / Wait.SampleRate) / Job.RenderSeconds);
+                }
+        }
+
+        /** Puts a finished job's output into Out: an attachment when the connection takes them, else base64. */
+        void AttachOutput(const FRenderWait& Wait, const FRenderJob& Job, UnrealMCP::Protocol::FCommandContext* Context, FJsonObject& Out)
+        {
+                TArray<uint8> Bytes = EncodeJob(Job, Wait.Format, Wait.SampleRate);
+                Out.SetNumberField(TEXT("bytes"), Bytes.Num());
+                if (Context && Context->CanAttach())
+                {
+                        Out.SetObjectField(TEXT("audio"), Context->Attach(MoveTemp(Bytes)));
+                }
+                else
+                {
+                        Out.SetStringField(TEXT("audio"), FBase64::Encode(Bytes));
+                }
+        }
+
+        TSharedPtr<FJsonObject> FinishSweep(FRenderWait& Wait, UnrealMCP::Protocol::FCommandContext* Context)
+        {
+                TSharedPtr<FJsonObject> Result = MakeSuccessResponse();
+                Result->SetStringField(TEXT("source"), Wait.SourcePath);
+                Result->SetNumberField(TEXT("sampleRate"), Wait.SampleRate);
+                Result->SetNumberField(TEXT("numChannels"), Wait.Jobs[0]->NumChannels);
+                if (Wait.bIncludeAudio)
+                {
+                        Result->SetStringField(TEXT("format"), Wait.Format == ERenderFormat::Wav ? TEXT("wav") : TEXT("pcm"));
+                        Result->SetStringField(TEXT("contentType"), GetContentType(Wait.Format));
+                }
+
+                TArray<TSharedPtr<FJsonValue>> Keys;
+                for (const FString& Key : Wait.GridKeys)
+                {
+                        Keys.Add(MakeShared<FJsonValueString>(Key));
+                }
+                Result->SetArrayField(TEXT("gridKeys"), Keys);
+
+                TArray<TSharedPtr<FJsonValue>> Variants;
+                Variants.Reserve(Wait.Jobs.Num());
+                int64 TotalFrames = 0;
+                for (int32 Index = 0; Index < Wait.Jobs.Num(); ++Index)
+                {
+                        const FRenderJob& Job = *Wait.Jobs[Index];
+                        TSharedPtr<FJsonObject> Variant = MakeShared<FJsonObject>(*Job.Summary);
+                        Variant->SetNumberField(TEXT("index"), Index);
+                        Variant->SetObjectField(TEXT("params"), Wait.GridValues[Index]);
+                        DescribeJob(Wait, Job, *Variant);
+                        if (Wait.bIncludeAudio)
+                        {
+                                AttachOutput(Wait, Job, Context, *Variant);
+                        }
+                        TotalFrames += Job.FramesRendered.load();
+                        Variants.Add(MakeShared<FJsonValueObject>(Variant));
+                }
+                Result->SetArrayField(TEXT("variants"), Variants);
+
+                const double ElapsedSeconds = FPlatformTime::Seconds() - Wait.StartSeconds;
+                Result->SetNumberField(TEXT("elapsedMs"), ElapsedSeconds * 1000.0);
+                if (ElapsedSeconds > 0.0)
+                {
+                        // Audio rendered per second of wall time across every worker.
+                        Result->SetNumberField(TEXT("realtimeFactor"), (static_cast<double>(TotalFrames) / Wait.SampleRate) / ElapsedSeconds);
+                }
+                return Result;
+        }
+
+        TSharedPtr<FJsonObject> FinishRender(FRenderWait& Wait, UnrealMCP::Protocol::FCommandContext* Context)
+        {
+                for (const TSharedPtr<FRenderJob, ESPMode::ThreadSafe>& Job : Wait.Jobs)
+                {
+                        UnwatchGraph(*Job);
+                }
+                for (const TSharedPtr<FRenderJob, ESPMode::ThreadSafe>& Job : Wait.Jobs)
+                {
+                        if (!Job->Error.IsEmpty())
+                        {
+                                return MakeErrorResponse(ErrorCodeRenderFailed, Job->Error);
+                        }
+                }
+                if (Wait.bSweep)
+                {
+                        return FinishSweep(Wait, Context);
+                }
+
+                TSharedPtr<FJsonObject> Result = MakeSuccessResponse();
+                Result->SetStringField(TEXT("source"), Wait.SourcePath);
+                Result->SetStringField(TEXT("format"), Wait.Format == ERenderFormat::Wav ? TEXT("wav") : TEXT("pcm"));
+                Result->SetStringField(TEXT("contentType"), GetContentType(Wait.Format));
+                Result->SetNumberField(TEXT("sampleRate"), Wait.SampleRate);
+                Result->SetNumberField(TEXT("numChannels"), Wait.Jobs[0]->NumChannels);
+                Result->SetNumberField(TEXT("elapsedMs"), (FPlatformTime::Seconds() - Wait.StartSeconds) * 1000.0);
+
+                if (!Wait.bBatch)
+                {
+                        const FRenderJob& Job = *Wait.Jobs[0];
+                        DescribeJob(Wait, Job, *Result);
+                        if (Wait.bStreaming)
+                        {
+                                Result->SetBoolField(TEXT("audioStreamed"), true);
+                        }
+                        else
+                        {
+                                AttachOutput(Wait, Job, Context, *Result);
+                        }
+                        return Result;
+                }
+
+                TArray<TSharedPtr<FJsonValue>> Variants;
+                for (int32 Index = 0; Index < Wait.Jobs.Num(); ++Index)
+                {
+                        TSharedPtr<FJsonObject> Variant = MakeShared<FJsonObject>();
+                        Variant->SetNumberField(TEXT("index"), Index);
+                        DescribeJob(Wait, *Wait.Jobs[Index], *Variant);
+                        AttachOutput(Wait, *Wait.Jobs[Index], Context, *Variant);
+                        Variants.Add(MakeShared<FJsonValueObject>(Variant));
+                }
+                Result->SetArrayField(TEXT("variants"), Variants);
+                return Result;
+        }
+
+        void CancelJobs(FRenderWait& Wait)
+        {
+                for (const TSharedPtr<FRenderJob, ESPMode::ThreadSafe>& Job : Wait.Jobs)
+                {
+                        Job->bCancel.store(true);
+                        UnwatchGraph(*Job);
+                }
+        }
+
+        /**
+         * Hands every job whose graph is built to a worker. Returns false, with the job's index,
+         * once a graph has been building for longer than GraphBuildTimeoutSeconds.
+         */
+        bool DispatchReadyJobs(FRenderWait& Wait, int32& OutStalledIndex)
+        {
+                const bool bPastBuildDeadline = FPlatformTime::Seconds() - Wait.StartSeconds > GraphBuildTimeoutSeconds;
+                for (int32 Index = 0; Index < Wait.Jobs.Num(); ++Index)
+                {
+                        const TSharedPtr<FRenderJob, ESPMode::ThreadSafe>& Job = Wait.Jobs[Index];
+                        if (Job->bDispatched)
+                        {
+                                continue;
+                        }
+                        if (!Job->bGraphReady->load())
+                        {
+                                if (bPastBuildDeadline)
+                                {
+                                        OutStalledIndex = Index;
+                                        return false;
+                                }
+                                continue;
+                        }
+
+                        Job->bDispatched = true;
+                        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Job]()
+                        {
+                                RenderJob(*Job);
+                        });
+                }
+                return true;
+        }
+
+        TSharedPtr<FJsonObject> MakeGraphStalledResponse(const FRenderWait& Wait, int32 Index)
+        {
+                return MakeErrorResponse(ErrorCodeRenderFailed, Wait.Jobs.Num() > 1
+                        ? FString::Printf(TEXT("The MetaSound graph of variant %d was not built within %.0f s"), Index, GraphBuildTimeoutSeconds)
+                        : FString::Printf(TEXT("The MetaSound graph was not built within %.0f s"), GraphBuildTimeoutSeconds));
+        }
+
+        /** Renders every job before returning, for a caller that cannot suspend (a batch entry). */
+        TSharedPtr<FJsonObject> RenderInPlace(FRenderWait& Wait, UnrealMCP::Protocol::FCommandContext* Context)
+        {
+                for (int32 Index = 0; Index < Wait.Jobs.Num(); ++Index)
+                {
+                        while (!Wait.Jobs[Index]->bGraphReady->load())
+                        {
+                                if (FPlatformTime::Seconds() - Wait.StartSeconds > GraphBuildTimeoutSeconds)
+                                {
+                                        CancelJobs(Wait);
+                                        return MakeGraphStalledResponse(Wait, Index);
+                                }
+                                FPlatformProcess::Sleep(0.001f);
+                        }
+                }
+
+                ParallelFor(Wait.Jobs.Num(), [&Wait](int32 Index)
+                {
+                        RenderJob(*Wait.Jobs[Index]);
+                });
+                return FinishRender(Wait, Context);
+        }
+
+        /** One frame of a render: the response once every job is done, or null after suspending. */
+        TSharedPtr<FJsonObject> PollRender(const TSharedRef<FRenderWait>& Wait, UnrealMCP::Protocol::FCommandContext& Context)
+        {
+                int32 StalledIndex = INDEX_NONE;
+                if (!DispatchReadyJobs(*Wait, StalledIndex))
+                {
+                        CancelJobs(*Wait);
+                        return MakeGraphStalledResponse(*Wait, StalledIndex);
+                }
+
+                int64 Done = 0;
+                int64 Total = 0;
+                bool bAllDone = true;
+                for (const TSharedPtr<FRenderJob, ESPMode::ThreadSafe>& Job : Wait->Jobs)
+                {
+                        const bool bJobDone = Job->bDone.load(std::memory_order_acquire);
+                        bAllDone &= bJobDone;
+                        Done += bJobDone ? Job->TotalFrames : Job->FramesRendered.load();
+                        Total += Job->TotalFrames;
+                }
+                // Progress counts milliseconds of audio, which fits in int32 where frames may not.
+                const int32 SampleRate = Wait->SampleRate;
+                Context.ReportProgress(static_cast<int32>(Done * 1000 / SampleRate), static_cast<int32>(Total * 1000 / SampleRate), TEXT("rendering"));
+
+                UnrealMCP::Protocol::FResponseStream* Stream = Wait->bStreaming ? UnrealMCP::Protocol::FResponseStream::GetActive() : nullptr;
+                if (Stream && Wait->Jobs[0]->Error.IsEmpty())
+                {
+                        StreamRendered(*Wait, *Wait->Jobs[0], *Stream, bAllDone);
+                }
+
+                if (bAllDone)
+                {
+                        return FinishRender(*Wait, &Context);
+                }
+                if (Context.IsCancelled())
+                {
+                        CancelJobs(*Wait);
+                        return MakeErrorResponse(ErrorCodeCancelled, TEXT("Render cancelled"));
+                }
+                if (FPlatformTime::Seconds() - Wait->StartSeconds > Wait->TimeoutSeconds)
+                {
+                        CancelJobs(*Wait);
+                        return MakeErrorResponse(ErrorCodeRenderTimeout, FString::Printf(TEXT("Render still running after %.0f s"), Wait->TimeoutSeconds));
+                }
+
+                Context.Suspend(Wait);
+                return nullptr;
+        }
+
+        /**
+         * Adds the parameters of ParamObject to OutParameters. Keys are "Name" or "Type:Name"
+         * (Float, Int, Bool, String, Object); without a type a number is a float, and arrays of
+         * numbers, bools or strings become array parameters.
+         */
+        bool ParseAudioParameters(const TSharedPtr<FJsonObject>& ParamObject, TArray<FAudioParameter>& OutParameters, FString& OutError)
+        {
+                if (!ParamObject.IsValid())
+                {
+                        return true;
+                }
+
+                for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : ParamObject->Values)
+                {
+                        FString Type;
+                        FString Name = Pair.Key;
+                        if (Pair.Key.Split(TEXT(":"), &Type, &Name))
+                        {
+                                Type.TrimStartAndEndInline();
+                        }
+                        Name.TrimStartAndEndInline();
+                        const FString TypeUpper = Type.ToUpper();
+                        const TSharedPtr<FJsonValue>& Value = Pair.Value;
+                        if (Name.IsEmpty() || !Value.IsValid())
+                        {
+                                OutError = FString::Printf(TEXT("Parameter '%s' is missing a name or value"), *Pair.Key);
+                                return false;
+                        }
+                        const FName ParameterName(*Name);
+
+                        if ((TypeUpper.IsEmpty() || TypeUpper == TEXT("FLOAT")) && Value->Type == EJson::Number)
+                        {
+                                OutParameters.Emplace(ParameterName, static_cast<float>(Value->AsNumber()));
+                        }
+                        else if ((TypeUpper == TEXT("INT") || TypeUpper == TEXT("INT32")) && Value->Type == EJson::Number)
+                        {
+                                OutParameters.Emplace(ParameterName, static_cast<int32>(Value->AsNumber()));
+                        }
+                        else if ((TypeUpper.IsEmpty() || TypeUpper == TEXT("BOOL")) && Value->Type == EJson::Boolean)
+                        {
+                                OutParameters.Emplace(ParameterName, Value->AsBool());
+                        }
+                        else if ((TypeUpper.IsEmpty() || TypeUpper == TEXT("STRING")) && Value->Type == EJson::String)
+                        {
+                                OutParameters.Emplace(ParameterName, Value->AsString());
+                        }
+                        else if (TypeUpper == TEXT("OBJECT") && Value->Type == EJson::String)
+                        {
+                                UObject* Object = LoadObject<UObject>(nullptr, *Value->AsString());
+                                if (!Object)
+                                {
+                                        OutError = FString::Printf(TEXT("Parameter '%s': asset '%s' not found"), *Pair.Key, *Value->AsString());
+                                        return false;
+                                }
+                                OutParameters.Emplace(ParameterName, Object);
+                        }
+                        else if (Value->Type == EJson::Array)
+                        {
+                                const TArray<TSharedPtr<FJsonValue>>& Array = Value->AsArray();
+                                const EJson ElementType = Array.Num() > 0 && Array[0].IsValid() ? Array[0]->Type : EJson::Number;
+                                bool bUniform = true;
+                                for (const TSharedPtr<FJsonValue>& Element : Array)
+                                {
+                                        bUniform &= Element.IsValid() && Element->Type == ElementType;
+                                }
+                                if (!bUniform)
+                                {
+                                        OutError = FString::Printf(TEXT("Parameter '%s' must be an array of one type"), *Pair.Key);
+                                        return false;
+                                }
+
+                                if (ElementType == EJson::Number && (TypeUpper == TEXT("INT") || TypeUpper == TEXT("INT32")))
+                                {
+                                        TArray<int32> Values;
+                                        Algo::Transform(Array, Values, [](const TSharedPtr<FJsonValue>& Element) { return static_cast<int32>(Element->AsNumber()); });
+                                        OutParameters.Emplace(ParameterName, Values);
+                                }
+                                else if (ElementType == EJson::Number)
+                                {
+                                        TArray<float> Values;
+                                        Algo::Transform(Array, Values, [](const TSharedPtr<FJsonValue>& Element) { return static_cast<float>(Element->AsNumber()); });
+                                        OutParameters.Emplace(ParameterName, Values);
+                                }
+                                else if (ElementType == EJson::Boolean)
+                                {
+                                        TArray<bool> Values;
+                                        Algo::Transform(Array, Values, [](const TSharedPtr<FJsonValue>& Element) { return Element->AsBool(); });
+                                        OutParameters.Emplace(ParameterName, Values);
+                                }
+                                else if (ElementType == EJson::String)
+                                {
+                                        TArray<FString> Values;
+                                        Algo::Transform(Array, Values, [](const TSharedPtr<FJsonValue>& Element) { return Element->AsString(); });
+                                        OutParameters.Emplace(ParameterName, Values);
+                                }
+                                else
+                                {
+                                        OutError = FString::Printf(TEXT("Parameter '%s' has an unsupported array type"), *Pair.Key);
+                                        return false;
+                                }
+                        }
+                        else
+                        {
+                                OutError = FString::Printf(TEXT("Parameter '%s' does not match type '%s'"), *Pair.Key, Type.IsEmpty() ? TEXT("(inferred)") : *Type);
+                                return false;
+                        }
+                }
+
+                return true;
+        }
+
+        /**
+         * Reads what metasound.render and metasound.sweep share: the source, format, sample rate,
+         * timeout, default duration and stopWhenFinished. Returns an error response, or null.
+         */
+        TSharedPtr<FJsonObject> ParseRenderOptions(const TSharedPtr<FJsonObject>& Params, FRenderWait& Wait, UMetaSoundSource*& OutSource, double& OutDuration, bool& bOutStopWhenFinished)
+        {
+                FString SourcePath;
+                if (!Params->TryGetStringField(TEXT("sourcePath"), SourcePath) || SourcePath.TrimStartAndEnd().IsEmpty())
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing sourcePath parameter"));
+                }
+                SourcePath.TrimStartAndEndInline();
+
+                OutSource = LoadObject<UMetaSoundSource>(nullptr, *SourcePath);
+                if (!OutSource)
+                {
+                        return MakeErrorResponse(ErrorCodeAssetNotFound, FString::Printf(TEXT("MetaSound source '%s' not found"), *SourcePath));
+                }
+                Wait.SourcePath = OutSource->GetPathName();
+
+                FString Format = TEXT("wav");
+                Params->TryGetStringField(TEXT("format"), Format);
+                if (Format.Equals(TEXT("pcm"), ESearchCase::IgnoreCase))
+                {
+                        Wait.Format = ERenderFormat::PcmFloat;
+                }
+                else if (!Format.Equals(TEXT("wav"), ESearchCase::IgnoreCase))
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("format must be \"wav\" or \"pcm\""));
+                }
+
+                double SampleRate = DefaultSampleRate;
+                Params->TryGetNumberField(TEXT("sampleRate"), SampleRate);
+                Wait.SampleRate = FMath::Clamp(static_cast<int32>(SampleRate), MinSampleRate, MaxSampleRate);
+
+                double TimeoutSeconds = DefaultRenderTimeoutSeconds;
+                Params->TryGetNumberField(TEXT("timeoutSec"), TimeoutSeconds);
+                Wait.TimeoutSeconds = FMath::Clamp(TimeoutSeconds, 1.0, MaxRenderTimeoutSeconds);
+
+                OutDuration = DefaultDurationSeconds;
+                Params->TryGetNumberField(TEXT("durationSec"), OutDuration);
+                bOutStopWhenFinished = !Params->HasTypedField<EJson::Boolean>(TEXT("stopWhenFinished")) || Params->GetBoolField(TEXT("stopWhenFinished"));
+                return nullptr;
+        }
+
+        /**
+         * Creates one generator per entry of VariantParameters on the game thread and watches for
+         * its graph. From then on a generator only runs on its worker, which renders as fast as
+         * the graph allows. Returns an error response, or null.
+         */
+        TSharedPtr<FJsonObject> CreateJobs(UMetaSoundSource& Source, FRenderWait& Wait, TArray<TArray<FAudioParameter>>& VariantParameters, const TArray<int32>& VariantFrames,
+                bool bStopWhenFinished, bool bKeepSamples, bool bAnalyze)
+        {
+                Source.InitResources();
+                const int32 NumChannels = FMath::Max(1, Source.NumChannels);
+                const Audio::FDeviceId DeviceId = GEngine ? GEngine->GetMainAudioDeviceID() : static_cast<Audio::FDeviceId>(INDEX_NONE);
+                const uint64 FirstInstanceId = FPlatformTime::Cycles64();
+                Wait.Jobs.Reserve(VariantParameters.Num());
+                for (int32 Index = 0; Index < VariantParameters.Num(); ++Index)
+                {
+                        TSharedPtr<FRenderJob, ESPMode::ThreadSafe> Job = MakeShared<FRenderJob, ESPMode::ThreadSafe>();
+                        Job->NumChannels = NumChannels;
+                        Job->TotalFrames = VariantFrames[Index];
+                        Job->bStopWhenFinished = bStopWhenFinished;
+                        Job->bKeepSamples = bKeepSamples;
+                        if (bKeepSamples)
+                        {
+                                Job->Samples.SetNumZeroed(static_cast<int64>(Job->TotalFrames) * NumChannels);
+                        }
+                        if (bAnalyze)
+                        {
+                                Job->Analyzer = MakeUnique<FAudioAnalyzer>(NumChannels, Wait.SampleRate);
+                        }
+
+                        FSoundGeneratorInitParams InitParams;
+                        InitParams.AudioDeviceID = DeviceId;
+                        InitParams.SampleRate = static_cast<float>(Wait.SampleRate);
+                        InitParams.NumChannels = NumChannels;
+                        InitParams.NumFramesPerCallback = 1024;
+                        InitParams.AudioMixerNumOutputFrames = 1024;
+                        InitParams.InstanceID = FirstInstanceId + Index;
+                        InitParams.GraphName = Wait.SourcePath;
+
+                        Job->Generator = Source.CreateSoundGenerator(InitParams, MoveTemp(VariantParameters[Index]));
+                        if (!Job->Generator.IsValid())
+                        {
+                                CancelJobs(Wait);
+                                return MakeErrorResponse(ErrorCodeRenderFailed, FString::Printf(TEXT("Could not create a generator for '%s'"), *Wait.SourcePath));
+                        }
+                        WatchGraph(*Job);
+                        Wait.Jobs.Add(Job);
+                }
+                Wait.StartSeconds = FPlatformTime::Seconds();
+                return nullptr;
+        }
+
+        /** Renders the created jobs: in place inside a batch, otherwise on workers across frames. */
+        TSharedPtr<FJsonObject> StartRender(const TSharedRef<FRenderWait>& Wait, UnrealMCP::Protocol::FCommandContext* Context)
+        {
+                if (!Context || !Context->CanSuspend())
+                {
+                        return RenderInPlace(*Wait, Context);
+                }
+
+                Wait->bStreaming = !Wait->bBatch && !Wait->bSweep && UnrealMCP::Protocol::FResponseStream::GetActive() != nullptr;
+                return PollRender(Wait, *Context);
+        }
 }
 
 TSharedPtr<FJsonObject> FMetaSoundTools::SpawnComponent(const TSharedPtr<FJsonObject>& /*Params*/)
@@ -47,3 +1102,206 @@ TSharedPtr<FJsonObject> FMetaSoundTools::PatchPreset(const TSharedPtr<FJsonObjec
 {
         return MakeNotImplementedResponse(TEXT("metasound.patch_preset"));
 }
+
+TSharedPtr<FJsonObject> FMetaSoundTools::Render(const TSharedPtr<FJsonObject>& Params)
+{
+        UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+        if (TSharedPtr<FRenderWait> Wait = Context ? Context->TakeResumeState<FRenderWait>() : nullptr)
+        {
+                return PollRender(Wait.ToSharedRef(), *Context);
+        }
+
+        if (!Params.IsValid())
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+        }
+
+        TSharedRef<FRenderWait> Wait = MakeShared<FRenderWait>();
+        UMetaSoundSource* Source = nullptr;
+        double DefaultDuration = DefaultDurationSeconds;
+        bool bStopWhenFinished = true;
+        if (TSharedPtr<FJsonObject> Error = ParseRenderOptions(Params, *Wait, Source, DefaultDuration, bStopWhenFinished))
+        {
+                return Error;
+        }
+
+        // "variants" renders the source once per entry, each with its own params (on top of the
+        // shared ones) and optionally its own duration.
+        TArray<TSharedPtr<FJsonObject>> VariantSpecs;
+        const TArray<TSharedPtr<FJsonValue>>* VariantsArray = nullptr;
+        Wait->bBatch = Params->TryGetArrayField(TEXT("variants"), VariantsArray) && VariantsArray;
+        if (Wait->bBatch)
+        {
+                if (VariantsArray->Num() == 0 || VariantsArray->Num() > MaxVariantsPerRender)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("variants must have 1 to %d entries"), MaxVariantsPerRender));
+                }
+                for (int32 Index = 0; Index < VariantsArray->Num(); ++Index)
+                {
+                        const TSharedPtr<FJsonValue>& Value = (*VariantsArray)[Index];
+                        if (!Value.IsValid() || Value->Type != EJson::Object)
+                        {
+                                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("variants[%d] must be an object"), Index));
+                        }
+                        VariantSpecs.Add(Value->AsObject());
+                }
+        }
+        else
+        {
+                VariantSpecs.Add(nullptr);
+        }
+
+        TArray<FAudioParameter> SharedParameters;
+        FString ParamError;
+        if (Params->HasTypedField<EJson::Object>(TEXT("params")) && !ParseAudioParameters(Params->GetObjectField(TEXT("params")), SharedParameters, ParamError))
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, ParamError);
+        }
+
+        const int32 NumChannels = FMath::Max(1, Source->NumChannels);
+        int64 TotalSamples = 0;
+        TArray<TArray<FAudioParameter>> VariantParameters;
+        TArray<int32> VariantFrames;
+        for (int32 Index = 0; Index < VariantSpecs.Num(); ++Index)
+        {
+                TArray<FAudioParameter>& Parameters = VariantParameters.Add_GetRef(SharedParameters);
+                double Duration = DefaultDuration;
+                if (const TSharedPtr<FJsonObject>& Spec = VariantSpecs[Index])
+                {
+                        Spec->TryGetNumberField(TEXT("durationSec"), Duration);
+                        if (Spec->HasTypedField<EJson::Object>(TEXT("params")) && !ParseAudioParameters(Spec->GetObjectField(TEXT("params")), Parameters, ParamError))
+                        {
+                                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("variants[%d]: %s"), Index, *ParamError));
+                        }
+                }
+
+                if (Duration <= 0.0 || Duration > MaxDurationSeconds)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("durationSec must be greater than 0 and at most %.0f"), MaxDurationSeconds));
+                }
+                const int32 Frames = FMath::CeilToInt32(Duration * Wait->SampleRate);
+                VariantFrames.Add(Frames);
+                TotalSamples += static_cast<int64>(Frames) * NumChannels;
+        }
+
+        if (TotalSamples > MaxTotalSamples)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("The render would hold %lld samples; the limit is %lld"), TotalSamples, MaxTotalSamples));
+        }
+
+        if (TSharedPtr<FJsonObject> Error = CreateJobs(*Source, *Wait, VariantParameters, VariantFrames, bStopWhenFinished, /*bKeepSamples=*/true, /*bAnalyze=*/false))
+        {
+                return Error;
+        }
+        return StartRender(Wait, Context);
+}
+
+TSharedPtr<FJsonObject> FMetaSoundTools::Sweep(const TSharedPtr<FJsonObject>& Params)
+{
+        UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+        if (TSharedPtr<FRenderWait> Wait = Context ? Context->TakeResumeState<FRenderWait>() : nullptr)
+        {
+                return PollRender(Wait.ToSharedRef(), *Context);
+        }
+
+        if (!Params.IsValid())
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+        }
+
+        TSharedRef<FRenderWait> Wait = MakeShared<FRenderWait>();
+        Wait->bSweep = true;
+        Wait->bIncludeAudio = Params->HasTypedField<EJson::Boolean>(TEXT("includeAudio")) && Params->GetBoolField(TEXT("includeAudio"));
+        UMetaSoundSource* Source = nullptr;
+        double Duration = DefaultDurationSeconds;
+        bool bStopWhenFinished = true;
+        if (TSharedPtr<FJsonObject> Error = ParseRenderOptions(Params, *Wait, Source, Duration, bStopWhenFinished))
+        {
+                return Error;
+        }
+        if (Duration <= 0.0 || Duration > MaxDurationSeconds)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("durationSec must be greater than 0 and at most %.0f"), MaxDurationSeconds));
+        }
+
+        // The grid maps each parameter key to the values it takes; every combination is one
+        // variant, with the last key varying fastest.
+        const TSharedPtr<FJsonObject>* GridObject = nullptr;
+        if (!Params->TryGetObjectField(TEXT("grid"), GridObject) || !GridObject || !GridObject->IsValid() || (*GridObject)->Values.Num() == 0)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("grid must be an object mapping parameter keys to arrays of values"));
+        }
+
+        TArray<const TArray<TSharedPtr<FJsonValue>>*> Axes;
+        int64 NumVariants = 1;
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*GridObject)->Values)
+        {
+                const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+                if (!Pair.Value.IsValid() || !Pair.Value->TryGetArray(Values) || !Values || Values->Num() == 0)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("grid['%s'] must be a non-empty array of values"), *Pair.Key));
+                }
+                Wait->GridKeys.Add(Pair.Key);
+                Axes.Add(Values);
+                NumVariants *= Values->Num();
+                if (NumVariants > MaxSweepVariants)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("The grid has more than %d combinations"), MaxSweepVariants));
+                }
+        }
+
+        TArray<FAudioParameter> SharedParameters;
+        FString ParamError;
+        if (Params->HasTypedField<EJson::Object>(TEXT("params")) && !ParseAudioParameters(Params->GetObjectField(TEXT("params")), SharedParameters, ParamError))
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, ParamError);
+        }
+
+        const int32 Frames = FMath::CeilToInt32(Duration * Wait->SampleRate);
+        const int32 NumChannels = FMath::Max(1, Source->NumChannels);
+        if (Wait->bIncludeAudio && static_cast<int64>(Frames) * NumChannels * NumVariants > MaxTotalSamples)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("The sweep would hold %lld samples of audio; the limit is %lld (or leave includeAudio off)"),
+                        static_cast<int64>(Frames) * NumChannels * NumVariants, MaxTotalSamples));
+        }
+        if (Duration * NumVariants > MaxSweepAudioSeconds)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("The sweep would render %.0f s of audio; the limit is %.0f s"), Duration * NumVariants, MaxSweepAudioSeconds));
+        }
+
+        TArray<TArray<FAudioParameter>> VariantParameters;
+        VariantParameters.Reserve(NumVariants);
+        Wait->GridValues.Reserve(NumVariants);
+        for (int64 Variant = 0; Variant < NumVariants; ++Variant)
+        {
+                TArray<int32, TInlineAllocator<8>> Picks;
+                Picks.SetNumUninitialized(Axes.Num());
+                int64 Remainder = Variant;
+                for (int32 Axis = Axes.Num() - 1; Axis >= 0; --Axis)
+                {
+                        Picks[Axis] = static_cast<int32>(Remainder % Axes[Axis]->Num());
+                        Remainder /= Axes[Axis]->Num();
+                }
+
+                TSharedPtr<FJsonObject> Values = MakeShared<FJsonObject>();
+                for (int32 Axis = 0; Axis < Axes.Num(); ++Axis)
+                {
+                        Values->SetField(Wait->GridKeys[Axis], (*Axes[Axis])[Picks[Axis]]);
+                }
+
+                TArray<FAudioParameter>& Parameters = VariantParameters.Add_GetRef(SharedParameters);
+                if (!ParseAudioParameters(Values, Parameters, ParamError))
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("grid: %s"), *ParamError));
+                }
+                Wait->GridValues.Add(Values);
+        }
+
+        TArray<int32> VariantFrames;
+        VariantFrames.Init(Frames, NumVariants);
+        if (TSharedPtr<FJsonObject> Error = CreateJobs(*Source, *Wait, VariantParameters, VariantFrames, bStopWhenFinished, Wait->bIncludeAudio, /*bAnalyze=*/true))
+        {
+                return Error;
+        }
+        return StartRender(Wait, Context);
+}
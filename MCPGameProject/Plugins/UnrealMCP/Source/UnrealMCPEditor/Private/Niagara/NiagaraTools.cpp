@@ -1,6 +1,7 @@
 #include "Niagara/NiagaraTools.h"
 #include "CoreMinimal.h"
 
+#include "Actors/ActorIndex.h"
 #include "Components/SceneComponent.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
@@ -12,14 +13,18 @@
 #include "Engine/TextureRenderTarget.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Engine/World.h"
-#include "EngineUtils.h"
 #include "GameFramework/Actor.h"
 #include "Misc/Char.h"
 #include "NiagaraActor.h"
 #include "NiagaraComponent.h"
 #include "NiagaraSystem.h"
+#include "NiagaraTypes.h"
+#include "NiagaraUserRedirectionParameterStore.h"
+#include "NiagaraVariant.h"
+#include "Protocol/CommandContext.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "Transactions/BulkEdit.h"
 #include "UObject/UObjectGlobals.h"
 
 namespace
@@ -167,56 +172,81 @@ namespace
                         return Actor;
                 }
 
-                if (UWorld* World = GetEditorWorld())
+                return FActorIndex::Get().Resolve(GetEditorWorld(), Trimmed);
+        }
+
+        /** Resolves Niagara components by path or name, walking the world's actors at most once. */
+        class FNiagaraComponentLookup
+        {
+        public:
+                UNiagaraComponent* Resolve(const FString& ComponentPath)
                 {
-                        for (TActorIterator<AActor> It(World); It; ++It)
+                        FString Trimmed = ComponentPath;
+                        Trimmed.TrimStartAndEndInline();
+                        if (Trimmed.IsEmpty())
                         {
-                                if (It->GetPathName() == Trimmed || It->GetName() == Trimmed)
-                                {
-                                        return *It;
-                                }
+                                return nullptr;
                         }
-                }
 
-                return nullptr;
-        }
+                        if (UNiagaraComponent* Component = FindObject<UNiagaraComponent>(nullptr, *Trimmed))
+                        {
+                                return Component;
+                        }
 
-        UNiagaraComponent* ResolveNiagaraComponent(const FString& ComponentPath)
-        {
-                FString Trimmed = ComponentPath;
-                Trimmed.TrimStartAndEndInline();
-                if (Trimmed.IsEmpty())
-                {
-                        return nullptr;
-                }
+                        if (!bBuilt)
+                        {
+                                Build();
+                        }
 
-                if (UNiagaraComponent* Component = FindObject<UNiagaraComponent>(nullptr, *Trimmed))
-                {
-                        return Component;
+                        if (UNiagaraComponent* const* Found = ByPath.Find(Trimmed))
+                        {
+                                return *Found;
+                        }
+                        UNiagaraComponent* const* Found = ByName.Find(Trimmed);
+                        return Found ? *Found : nullptr;
                 }
 
-                if (UWorld* World = GetEditorWorld())
+        private:
+                void Build()
                 {
-                        for (TActorIterator<AActor> It(World); It; ++It)
+                        bBuilt = true;
+                        UWorld* World = GetEditorWorld();
+                        if (!World)
                         {
+                                return;
+                        }
+
+                        TArray<AActor*> Actors;
+                        FActorIndex::Get().GetActors(World, Actors);
+                        for (AActor* Actor : Actors)
+                        {
+                                if (!Actor)
+                                {
+                                        continue;
+                                }
+
                                 TInlineComponentArray<UNiagaraComponent*> NiagaraComponents;
-                                It->GetComponents(NiagaraComponents);
+                                Actor->GetComponents(NiagaraComponents);
                                 for (UNiagaraComponent* Component : NiagaraComponents)
                                 {
-                                        if (!Component)
+                                        if (Component)
                                         {
-                                                continue;
-                                        }
-
-                                        if (Component->GetPathName() == Trimmed || Component->GetName() == Trimmed)
-                                        {
-                                                return Component;
+                                                ByPath.Add(Component->GetPathName(), Component);
+                                                ByName.FindOrAdd(Component->GetName(), Component);
                                         }
                                 }
                         }
                 }
 
-                return nullptr;
+                TMap<FString, UNiagaraComponent*> ByPath;
+                /** First component found under each name; names need not be unique across actors. */
+                TMap<FString, UNiagaraComponent*> ByName;
+                bool bBuilt = false;
+        };
+
+        UNiagaraComponent* ResolveNiagaraComponent(const FString& ComponentPath)
+        {
+                return FNiagaraComponentLookup().Resolve(ComponentPath);
         }
 
         bool ParseNumber(const TSharedPtr<FJsonValue>& Value, double& OutNumber)
@@ -472,7 +502,85 @@ namespace
                 return LoadObject<TObjectType>(nullptr, *Trimmed);
         }
 
-        bool ApplyUserParameter(UNiagaraComponent& Component, const FString& RawKey, const TSharedPtr<FJsonValue>& Value, FString& OutErrorCode, FString& OutErrorMessage, TArray<FString>& OutApplied, TArray<TSharedPtr<FJsonValue>>& OutAuditActions)
+        /** Components one niagara.set_user_params call may take. */
+        constexpr int32 MaxComponentsPerRequest = 1000;
+
+        /** How an object parameter is handed to the component. */
+        enum class EUserParamObject : uint8
+        {
+                None,
+                Texture,
+                RenderTarget,
+                StaticMesh,
+                Object
+        };
+
+        /**
+         * A user parameter parsed once per call: the variable it names in a component's override
+         * store and the value converted to the store's layout, so applying it to each component is
+         * an offset lookup and a copy rather than another parse.
+         */
+        struct FUserParamEdit
+        {
+                FString RawKey;
+                TSharedPtr<FJsonValue> Value;
+                FNiagaraVariable Variable;
+                /** The value as stored; empty for object parameters. */
+                TArray<uint8> Data;
+                EUserParamObject ObjectKind = EUserParamObject::None;
+                FName ObjectName;
+                UObject* Object = nullptr;
+        };
+
+        /** What applying a parameter set did to one component. */
+        struct FUserParamOutcome
+        {
+                TArray<FString> Applied;
+                TArray<FString> Unchanged;
+                TArray<FString> NotFound;
+        };
+
+        template <typename TValue>
+        void SetEditData(FUserParamEdit& Out, const FNiagaraTypeDefinition& Type, const FName Name, const TValue& Value)
+        {
+                Out.Variable = FNiagaraVariable(Type, Name);
+                Out.Data.SetNumUninitialized(sizeof(TValue));
+                FMemory::Memcpy(Out.Data.GetData(), &Value, sizeof(TValue));
+        }
+
+        template <typename TObjectType>
+        TObjectType* LoadCachedAsset(const FString& Path, TMap<FString, UObject*>& AssetCache)
+        {
+                if (UObject** Cached = AssetCache.Find(Path))
+                {
+                        return Cast<TObjectType>(*Cached);
+                }
+                TObjectType* Asset = LoadAssetByPath<TObjectType>(Path);
+                AssetCache.Add(Path, Asset);
+                return Asset;
+        }
+
+        bool ParseObjectParameter(const FString& RawKey, const TSharedPtr<FJsonValue>& Value, const TCHAR* Expected, const TCHAR* AssetLabel, UObject*& OutObject, TFunctionRef<UObject*(const FString&)> Load, FString& OutErrorCode, FString& OutErrorMessage)
+        {
+                if (!Value.IsValid() || Value->Type != EJson::String)
+                {
+                        OutErrorCode = ErrorCodeParamFailed;
+                        OutErrorMessage = FString::Printf(TEXT("Parameter '%s' expected %s"), *RawKey, Expected);
+                        return false;
+                }
+
+                const FString AssetPath = Value->AsString();
+                OutObject = Load(AssetPath);
+                if (!OutObject)
+                {
+                        OutErrorCode = ErrorCodeAssetNotFound;
+                        OutErrorMessage = FString::Printf(TEXT("%s asset '%s' not found"), AssetLabel, *AssetPath);
+                        return false;
+                }
+                return true;
+        }
+
+        bool ParseUserParameter(const FString& RawKey, const TSharedPtr<FJsonValue>& Value, TMap<FString, UObject*>& AssetCache, FUserParamEdit& Out, FString& OutErrorCode, FString& OutErrorMessage)
         {
                 FString Type;
                 FString Name;
@@ -492,7 +600,14 @@ namespace
                         return false;
                 }
 
+                Out.RawKey = RawKey;
+                Out.Value = Value;
+
+                // The override store files user parameters under "User.". The typed setters add the
+                // prefix through the store's redirection; the offset lookups need it up front.
                 const FName ParameterName(*Name);
+                const FString StoreNameString = Name.StartsWith(TEXT("User.")) ? Name : TEXT("User.") + Name;
+                const FName StoreName(*StoreNameString);
                 const FString TypeUpper = Type.ToUpper();
 
                 if (TypeUpper == TEXT("FLOAT"))
@@ -505,7 +620,7 @@ namespace
                                 return false;
                         }
 
-                        Component.SetVariableFloat(ParameterName, static_cast<float>(Number));
+                        SetEditData(Out, FNiagaraTypeDefinition::GetFloatDef(), StoreName, static_cast<float>(Number));
                 }
                 else if (TypeUpper == TEXT("INT") || TypeUpper == TEXT("INTEGER"))
                 {
@@ -517,7 +632,7 @@ namespace
                                 return false;
                         }
 
-                        Component.SetVariableInt(ParameterName, static_cast<int32>(Number));
+                        SetEditData(Out, FNiagaraTypeDefinition::GetIntDef(), StoreName, static_cast<int32>(Number));
                 }
                 else if (TypeUpper == TEXT("BOOL") || TypeUpper == TEXT("BOOLEAN"))
                 {
@@ -529,7 +644,7 @@ namespace
                                 return false;
                         }
 
-                        Component.SetVariableBool(ParameterName, bBoolValue);
+                        SetEditData(Out, FNiagaraTypeDefinition::GetBoolDef(), StoreName, FNiagaraBool(bBoolValue));
                 }
                 else if (TypeUpper == TEXT("VECTOR2") || TypeUpper == TEXT("VEC2"))
                 {
@@ -541,7 +656,7 @@ namespace
                                 return false;
                         }
 
-                        Component.SetVariableVec2(ParameterName, VectorValue);
+                        SetEditData(Out, FNiagaraTypeDefinition::GetVec2Def(), StoreName, FVector2f(VectorValue));
                 }
                 else if (TypeUpper == TEXT("VECTOR") || TypeUpper == TEXT("VECTOR3") || TypeUpper == TEXT("VEC3"))
                 {
@@ -553,7 +668,7 @@ namespace
                                 return false;
                         }
 
-                        Component.SetVariableVec3(ParameterName, VectorValue);
+                        SetEditData(Out, FNiagaraTypeDefinition::GetVec3Def(), StoreName, FVector3f(VectorValue));
                 }
                 else if (TypeUpper == TEXT("VECTOR4") || TypeUpper == TEXT("VEC4"))
                 {
@@ -565,7 +680,7 @@ namespace
                                 return false;
                         }
 
-                        Component.SetVariableVec4(ParameterName, VectorValue);
+                        SetEditData(Out, FNiagaraTypeDefinition::GetVec4Def(), StoreName, FVector4f(VectorValue));
                 }
                 else if (TypeUpper == TEXT("COLOR") || TypeUpper == TEXT("LINEARCOLOR"))
                 {
@@ -577,7 +692,7 @@ namespace
                                 return false;
                         }
 
-                        Component.SetVariableLinearColor(ParameterName, ColorValue);
+                        SetEditData(Out, FNiagaraTypeDefinition::GetColorDef(), StoreName, ColorValue);
                 }
                 else if (TypeUpper == TEXT("QUAT") || TypeUpper == TEXT("QUATERNION"))
                 {
@@ -589,7 +704,7 @@ namespace
                                 return false;
                         }
 
-                        Component.SetVariableQuat(ParameterName, QuatValue);
+                        SetEditData(Out, FNiagaraTypeDefinition::GetQuatDef(), StoreName, FQuat4f(QuatValue));
                 }
                 else if (TypeUpper == TEXT("MATRIX"))
                 {
@@ -601,160 +716,331 @@ namespace
                                 return false;
                         }
 
-                        Component.SetVariableMatrix(ParameterName, MatrixValue);
+                        SetEditData(Out, FNiagaraTypeDefinition::GetMatrix4Def(), StoreName, FMatrix44f(MatrixValue));
                 }
-                else if (TypeUpper == TEXT("TEXTURE"))
+                else
                 {
-                        if (!Value.IsValid() || Value->Type != EJson::String)
+                        // Object parameters go through the component's typed setters, which also
+                        // rebind the data interfaces reading them.
+                        Out.ObjectName = ParameterName;
+                        bool bParsed = false;
+                        if (TypeUpper == TEXT("TEXTURE"))
                         {
-                                OutErrorCode = ErrorCodeParamFailed;
-                                OutErrorMessage = FString::Printf(TEXT("Parameter '%s' expected texture asset path"), *RawKey);
-                                return false;
+                                Out.ObjectKind = EUserParamObject::Texture;
+                                bParsed = ParseObjectParameter(RawKey, Value, TEXT("texture asset path"), TEXT("Texture"), Out.Object,
+                                        [&AssetCache](const FString& Path) -> UObject* { return LoadCachedAsset<UTexture>(Path, AssetCache); }, OutErrorCode, OutErrorMessage);
                         }
-
-                        FString AssetPath = Value->AsString();
-                        if (UTexture* Texture = LoadAssetByPath<UTexture>(AssetPath))
+                        else if (TypeUpper == TEXT("RENDERTARGET") || TypeUpper == TEXT("TEXTURERENDERTARGET"))
                         {
-                                Component.SetVariableTexture(ParameterName, Texture);
+                                Out.ObjectKind = EUserParamObject::RenderTarget;
+                                bParsed = ParseObjectParameter(RawKey, Value, TEXT("render target asset path"), TEXT("Render target"), Out.Object,
+                                        [&AssetCache](const FString& Path) -> UObject* { return LoadCachedAsset<UTextureRenderTarget>(Path, AssetCache); }, OutErrorCode, OutErrorMessage);
                         }
-                        else
+                        else if (TypeUpper == TEXT("TEXTURERENDERTARGET2D") || TypeUpper == TEXT("RENDERTARGET2D"))
                         {
-                                OutErrorCode = ErrorCodeAssetNotFound;
-                                OutErrorMessage = FString::Printf(TEXT("Texture asset '%s' not found"), *AssetPath);
-                                return false;
+                                Out.ObjectKind = EUserParamObject::RenderTarget;
+                                bParsed = ParseObjectParameter(RawKey, Value, TEXT("render target asset path"), TEXT("Render target"), Out.Object,
+                                        [&AssetCache](const FString& Path) -> UObject* { return LoadCachedAsset<UTextureRenderTarget2D>(Path, AssetCache); }, OutErrorCode, OutErrorMessage);
                         }
-                }
-                else if (TypeUpper == TEXT("RENDERTARGET") || TypeUpper == TEXT("TEXTURERENDERTARGET"))
-                {
-                        if (!Value.IsValid() || Value->Type != EJson::String)
+                        else if (TypeUpper == TEXT("STATICMESH"))
                         {
-                                OutErrorCode = ErrorCodeParamFailed;
-                                OutErrorMessage = FString::Printf(TEXT("Parameter '%s' expected render target asset path"), *RawKey);
-                                return false;
+                                Out.ObjectKind = EUserParamObject::StaticMesh;
+                                bParsed = ParseObjectParameter(RawKey, Value, TEXT("static mesh asset path"), TEXT("Static mesh"), Out.Object,
+                                        [&AssetCache](const FString& Path) -> UObject* { return LoadCachedAsset<UStaticMesh>(Path, AssetCache); }, OutErrorCode, OutErrorMessage);
                         }
-
-                        FString AssetPath = Value->AsString();
-                        if (UTextureRenderTarget* RenderTarget = LoadAssetByPath<UTextureRenderTarget>(AssetPath))
+                        else if (TypeUpper == TEXT("SKELETALMESH"))
                         {
-                                Component.SetVariableTextureRenderTarget(ParameterName, RenderTarget);
+                                Out.ObjectKind = EUserParamObject::Object;
+                                bParsed = ParseObjectParameter(RawKey, Value, TEXT("skeletal mesh asset path"), TEXT("Skeletal mesh"), Out.Object,
+                                        [&AssetCache](const FString& Path) -> UObject* { return LoadCachedAsset<USkeletalMesh>(Path, AssetCache); }, OutErrorCode, OutErrorMessage);
                         }
                         else
                         {
-                                OutErrorCode = ErrorCodeAssetNotFound;
-                                OutErrorMessage = FString::Printf(TEXT("Render target asset '%s' not found"), *AssetPath);
+                                OutErrorCode = ErrorCodeParamUnsupported;
+                                OutErrorMessage = FString::Printf(TEXT("Unsupported Niagara user parameter type '%s'"), *Type);
                                 return false;
                         }
+                        return bParsed;
                 }
-                else if (TypeUpper == TEXT("TEXTURERENDERTARGET2D") || TypeUpper == TEXT("RENDERTARGET2D"))
+
+                return true;
+        }
+
+        bool ParseUserParameterSet(const TSharedPtr<FJsonObject>& ParamObject, TMap<FString, UObject*>& AssetCache, TArray<FUserParamEdit>& OutEdits, FString& OutErrorCode, FString& OutErrorMessage)
+        {
+                if (!ParamObject.IsValid())
                 {
-                        if (!Value.IsValid() || Value->Type != EJson::String)
-                        {
-                                OutErrorCode = ErrorCodeParamFailed;
-                                OutErrorMessage = FString::Printf(TEXT("Parameter '%s' expected render target asset path"), *RawKey);
-                                return false;
-                        }
+                        return true;
+                }
 
-                        FString AssetPath = Value->AsString();
-                        if (UTextureRenderTarget2D* RenderTarget = LoadAssetByPath<UTextureRenderTarget2D>(AssetPath))
-                        {
-                                Component.SetVariableTextureRenderTarget(ParameterName, RenderTarget);
-                        }
-                        else
+                OutEdits.Reserve(OutEdits.Num() + ParamObject->Values.Num());
+                for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : ParamObject->Values)
+                {
+                        if (!ParseUserParameter(Pair.Key, Pair.Value, AssetCache, OutEdits.AddDefaulted_GetRef(), OutErrorCode, OutErrorMessage))
                         {
-                                OutErrorCode = ErrorCodeAssetNotFound;
-                                OutErrorMessage = FString::Printf(TEXT("Render target asset '%s' not found"), *AssetPath);
                                 return false;
                         }
                 }
-                else if (TypeUpper == TEXT("STATICMESH"))
+                return true;
+        }
+
+        /**
+         * Writes Edits into Component's override parameters. Plain values are copied straight to
+         * their store offset and skipped when the store already holds them; a parameter the
+         * component's system does not expose is added when bAddMissing, else reported in NotFound.
+         */
+        void ApplyUserParameterSet(UNiagaraComponent& Component, const TArray<FUserParamEdit>& Edits, bool bAddMissing, FUserParamOutcome& OutOutcome, TArray<TSharedPtr<FJsonValue>>& OutAuditActions)
+        {
+                FNiagaraUserRedirectionParameterStore& Store = Component.GetOverrideParameters();
+                const FString ComponentPath = Component.GetPathName();
+
+                for (const FUserParamEdit& Edit : Edits)
                 {
-                        if (!Value.IsValid() || Value->Type != EJson::String)
+                        switch (Edit.ObjectKind)
                         {
-                                OutErrorCode = ErrorCodeParamFailed;
-                                OutErrorMessage = FString::Printf(TEXT("Parameter '%s' expected static mesh asset path"), *RawKey);
-                                return false;
-                        }
-
-                        FString AssetPath = Value->AsString();
-                        if (UStaticMesh* StaticMesh = LoadAssetByPath<UStaticMesh>(AssetPath))
+                        case EUserParamObject::Texture:
+                                Component.SetVariableTexture(Edit.ObjectName, CastChecked<UTexture>(Edit.Object));
+                                break;
+                        case EUserParamObject::RenderTarget:
+                                Component.SetVariableTextureRenderTarget(Edit.ObjectName, CastChecked<UTextureRenderTarget>(Edit.Object));
+                                break;
+                        case EUserParamObject::StaticMesh:
+                                Component.SetVariableStaticMesh(Edit.ObjectName, CastChecked<UStaticMesh>(Edit.Object));
+                                break;
+                        case EUserParamObject::Object:
+                                Component.SetVariableObject(Edit.ObjectName, Edit.Object);
+                                break;
+                        case EUserParamObject::None:
                         {
-                                Component.SetVariableStaticMesh(ParameterName, StaticMesh);
+                                int32 Offset = Store.IndexOf(Edit.Variable);
+                                if (Offset == INDEX_NONE)
+                                {
+                                        if (!bAddMissing)
+                                        {
+                                                OutOutcome.NotFound.Add(Edit.RawKey);
+                                                continue;
+                                        }
+                                        Store.AddParameter(Edit.Variable, /*bInitialize=*/true, /*bTriggerRebind=*/true, &Offset);
+                                }
+                                else if (FMemory::Memcmp(Store.GetParameterData(Offset), Edit.Data.GetData(), Edit.Data.Num()) == 0)
+                                {
+                                        OutOutcome.Unchanged.Add(Edit.RawKey);
+                                        continue;
+                                }
+
+                                Store.SetParameterData(Edit.Data.GetData(), Offset, Edit.Data.Num());
+#if WITH_EDITOR
+                                // Keeps the edit with the component when the level is saved.
+                                Component.SetParameterOverride(Edit.Variable, FNiagaraVariant(Edit.Data.GetData(), Edit.Data.Num()));
+#endif
+                                break;
                         }
-                        else
-                        {
-                                OutErrorCode = ErrorCodeAssetNotFound;
-                                OutErrorMessage = FString::Printf(TEXT("Static mesh asset '%s' not found"), *AssetPath);
-                                return false;
                         }
+
+                        OutOutcome.Applied.Add(Edit.RawKey);
+
+                        TMap<FString, FString> Args;
+                        Args.Add(TEXT("component"), ComponentPath);
+                        Args.Add(TEXT("name"), Edit.RawKey);
+                        Args.Add(TEXT("value"), SerializeJsonValue(Edit.Value));
+                        OutAuditActions.Add(MakeShared<FJsonValueObject>(MakeAuditAction(TEXT("set_user_param"), Args)));
                 }
-                else if (TypeUpper == TEXT("SKELETALMESH"))
+        }
+
+        TArray<TSharedPtr<FJsonValue>> ToJsonStrings(const TArray<FString>& Values)
+        {
+                TArray<TSharedPtr<FJsonValue>> Array;
+                Array.Reserve(Values.Num());
+                for (const FString& Value : Values)
+                {
+                        Array.Add(MakeShared<FJsonValueString>(Value));
+                }
+                return Array;
+        }
+
+        void SelectActor(AActor* Actor)
+        {
+#if WITH_EDITOR
+                if (!GEditor || !Actor)
                 {
-                        if (!Value.IsValid() || Value->Type != EJson::String)
+                        return;
+                }
+
+                GEditor->SelectNone(false, true, false);
+                GEditor->SelectActor(Actor, true, true, true);
+                FBulkEdit::NoteSelectionChange();
+#endif
+        }
+
+        /** Systems one niagara.prepare call may take. */
+        constexpr int32 MaxSystemsPerPrepare = 500;
+        constexpr double DefaultPrepareTimeoutSeconds = 300.0;
+        constexpr double MaxPrepareTimeoutSeconds = 3600.0;
+        constexpr double DefaultWarmupSeconds = 1.0;
+        constexpr double MaxWarmupSeconds = 30.0;
+        constexpr float WarmupTickSeconds = 1.0f / 30.0f;
+        /** Frames a warm-up component stays alive, so the renderer dispatches its GPU sims. */
+        constexpr int32 WarmupFrames = 2;
+
+        /** niagara.prepare between frames: the systems it is compiling, then warming up. */
+        struct FPrepareWait : public UnrealMCP::Protocol::FCommandContext::FResumeState
+        {
+                TArray<TWeakObjectPtr<UNiagaraSystem>> Systems;
+                TArray<FString> SystemPaths;
+                bool bIncludeGpuShaders = true;
+                bool bWarmup = false;
+                double WarmupSeconds = DefaultWarmupSeconds;
+                double StartSeconds = 0.0;
+                double TimeoutSeconds = 0.0;
+                TArray<TWeakObjectPtr<UNiagaraComponent>> WarmupComponents;
+                /** Frames left before the warm-up components are removed; INDEX_NONE until they are spawned. */
+                int32 WarmupFramesLeft = INDEX_NONE;
+        };
+
+        bool IsSystemCompiling(UNiagaraSystem* System, bool bIncludeGpuShaders)
+        {
+#if WITH_EDITOR
+                return System && System->HasOutstandingCompilationRequests(bIncludeGpuShaders);
+#else
+                return false;
+#endif
+        }
+
+        /**
+         * Runs a transient component of each ready system for a moment, so the first real spawn
+         * finds its scripts bound and its GPU shaders and dispatches already set up.
+         */
+        void SpawnWarmupComponents(FPrepareWait& Wait)
+        {
+                UWorld* World = GetEditorWorld();
+                if (!World)
+                {
+                        return;
+                }
+
+                for (const TWeakObjectPtr<UNiagaraSystem>& WeakSystem : Wait.Systems)
+                {
+                        UNiagaraSystem* System = WeakSystem.Get();
+                        if (!System || !System->IsReadyToRun())
                         {
-                                OutErrorCode = ErrorCodeParamFailed;
-                                OutErrorMessage = FString::Printf(TEXT("Parameter '%s' expected skeletal mesh asset path"), *RawKey);
-                                return false;
+                                continue;
                         }
 
-                        FString AssetPath = Value->AsString();
-                        if (USkeletalMesh* SkeletalMesh = LoadAssetByPath<USkeletalMesh>(AssetPath))
+                        UNiagaraComponent* Component = NewObject<UNiagaraComponent>(World, NAME_None, RF_Transient);
+                        Component->SetAutoActivate(false);
+                        Component->SetAsset(System);
+                        Component->RegisterComponentWithWorld(World);
+                        Component->Activate(true);
+                        Component->AdvanceSimulationByTime(static_cast<float>(Wait.WarmupSeconds), WarmupTickSeconds);
+                        Wait.WarmupComponents.Add(Component);
+                }
+        }
+
+        void DestroyWarmupComponents(FPrepareWait& Wait)
+        {
+                for (const TWeakObjectPtr<UNiagaraComponent>& WeakComponent : Wait.WarmupComponents)
+                {
+                        if (UNiagaraComponent* Component = WeakComponent.Get())
                         {
-                                Component.SetVariableObject(ParameterName, SkeletalMesh);
+                                Component->DeactivateImmediate();
+                                Component->DestroyComponent();
                         }
-                        else
+                }
+                Wait.WarmupComponents.Reset();
+        }
+
+        TSharedPtr<FJsonObject> FinishPrepare(FPrepareWait& Wait, bool bTimedOut, bool bCancelled)
+        {
+                const bool bWarmedUp = Wait.WarmupFramesLeft != INDEX_NONE;
+                DestroyWarmupComponents(Wait);
+
+                TArray<TSharedPtr<FJsonValue>> SystemResults;
+                int32 NumReady = 0;
+                for (int32 Index = 0; Index < Wait.Systems.Num(); ++Index)
+                {
+                        UNiagaraSystem* System = Wait.Systems[Index].Get();
+                        const bool bCompiled = System && !IsSystemCompiling(System, Wait.bIncludeGpuShaders);
+                        const bool bReady = bCompiled && System->IsReadyToRun();
+                        NumReady += bReady ? 1 : 0;
+
+                        TSharedPtr<FJsonObject> SystemResult = MakeShared<FJsonObject>();
+                        SystemResult->SetStringField(TEXT("system"), Wait.SystemPaths[Index]);
+                        SystemResult->SetBoolField(TEXT("compiled"), bCompiled);
+                        SystemResult->SetBoolField(TEXT("readyToRun"), bReady);
+                        if (Wait.bWarmup)
                         {
-                                OutErrorCode = ErrorCodeAssetNotFound;
-                                OutErrorMessage = FString::Printf(TEXT("Skeletal mesh asset '%s' not found"), *AssetPath);
-                                return false;
+                                SystemResult->SetBoolField(TEXT("warmedUp"), bWarmedUp && bReady);
                         }
+                        SystemResults.Add(MakeShared<FJsonValueObject>(SystemResult));
                 }
-                else
+
+                TSharedPtr<FJsonObject> Result = MakeSuccessResponse();
+                Result->SetArrayField(TEXT("systems"), SystemResults);
+                Result->SetBoolField(TEXT("complete"), NumReady == Wait.Systems.Num());
+                Result->SetNumberField(TEXT("ready"), NumReady);
+                Result->SetNumberField(TEXT("elapsedMs"), (FPlatformTime::Seconds() - Wait.StartSeconds) * 1000.0);
+                if (bTimedOut)
                 {
-                        OutErrorCode = ErrorCodeParamUnsupported;
-                        OutErrorMessage = FString::Printf(TEXT("Unsupported Niagara user parameter type '%s'"), *Type);
-                        return false;
+                        Result->SetBoolField(TEXT("timedOut"), true);
                 }
-
-                OutApplied.Add(RawKey);
-
-                TMap<FString, FString> Args;
-                Args.Add(TEXT("component"), Component.GetPathName());
-                Args.Add(TEXT("name"), RawKey);
-                Args.Add(TEXT("value"), SerializeJsonValue(Value));
-                OutAuditActions.Add(MakeShared<FJsonValueObject>(MakeAuditAction(TEXT("set_user_param"), Args)));
-                return true;
+                if (bCancelled)
+                {
+                        Result->SetBoolField(TEXT("cancelled"), true);
+                }
+                return Result;
         }
 
-        bool ApplyUserParameterSet(UNiagaraComponent& Component, const TSharedPtr<FJsonObject>& ParamObject, FString& OutErrorCode, FString& OutErrorMessage, TArray<FString>& OutApplied, TArray<TSharedPtr<FJsonValue>>& OutAuditActions)
+        /** One frame of niagara.prepare: the finished response, or null after suspending until the next frame. */
+        TSharedPtr<FJsonObject> PollPrepare(const TSharedRef<FPrepareWait>& Wait, UnrealMCP::Protocol::FCommandContext& Context)
         {
-                if (!ParamObject.IsValid())
+                if (Wait->WarmupFramesLeft == INDEX_NONE)
                 {
-                        return true;
+                        int32 Compiled = 0;
+                        for (const TWeakObjectPtr<UNiagaraSystem>& WeakSystem : Wait->Systems)
+                        {
+                                UNiagaraSystem* System = WeakSystem.Get();
+#if WITH_EDITOR
+                                if (System)
+                                {
+                                        System->PollForCompilationComplete();
+                                }
+#endif
+                                Compiled += IsSystemCompiling(System, Wait->bIncludeGpuShaders) ? 0 : 1;
+                        }
+                        Context.ReportProgress(Compiled, Wait->Systems.Num(), TEXT("compiling"));
+
+                        if (Compiled == Wait->Systems.Num())
+                        {
+                                if (!Wait->bWarmup)
+                                {
+                                        return FinishPrepare(*Wait, false, false);
+                                }
+                                SpawnWarmupComponents(*Wait);
+                                Wait->WarmupFramesLeft = WarmupFrames;
+                        }
                 }
 
-                for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : ParamObject->Values)
+                if (Wait->WarmupFramesLeft != INDEX_NONE)
                 {
-                        if (!ApplyUserParameter(Component, Pair.Key, Pair.Value, OutErrorCode, OutErrorMessage, OutApplied, OutAuditActions))
+                        Context.ReportProgress(WarmupFrames - Wait->WarmupFramesLeft, WarmupFrames, TEXT("warmup"));
+                        if (Wait->WarmupFramesLeft-- == 0)
                         {
-                                return false;
+                                return FinishPrepare(*Wait, false, false);
                         }
                 }
 
-                return true;
-        }
-
-        void SelectActor(AActor* Actor)
-        {
-#if WITH_EDITOR
-                if (!GEditor || !Actor)
+                // Compiles already handed to the workers carry on either way; only the wait ends.
+                if (Context.IsCancelled())
                 {
-                        return;
+                        return FinishPrepare(*Wait, false, true);
+                }
+                if (FPlatformTime::Seconds() - Wait->StartSeconds > Wait->TimeoutSeconds)
+                {
+                        return FinishPrepare(*Wait, true, false);
                 }
 
-                GEditor->SelectNone(false, true, false);
-                GEditor->SelectActor(Actor, true, true, true);
-                GEditor->NoteSelectionChange();
-#endif
+                Context.Suspend(Wait);
+                return nullptr;
         }
 }
 
@@ -789,6 +1075,19 @@ TSharedPtr<FJsonObject> FNiagaraTools::SpawnComponent(const TSharedPtr<FJsonObje
                 return MakeErrorResponse(ErrorCodeSpawnFailed, TEXT("Unable to resolve editor world"));
         }
 
+        // Parsed before anything is spawned, so a bad parameter leaves nothing to clean up.
+        TArray<FUserParamEdit> InitialEdits;
+        if (Params->HasTypedField<EJson::Object>(TEXT("initialUserParams")))
+        {
+                TMap<FString, UObject*> AssetCache;
+                FString ErrorCode;
+                FString ErrorMessage;
+                if (!ParseUserParameterSet(Params->GetObjectField(TEXT("initialUserParams")), AssetCache, InitialEdits, ErrorCode, ErrorMessage))
+                {
+                        return MakeErrorResponse(ErrorCode, ErrorMessage);
+                }
+        }
+
         const bool bAutoActivate = !Params->HasField(TEXT("autoActivate")) || Params->GetBoolField(TEXT("autoActivate"));
         const bool bSelect = Params->HasTypedField<EJson::Boolean>(TEXT("select")) && Params->GetBoolField(TEXT("select"));
 
@@ -926,31 +1225,8 @@ TSharedPtr<FJsonObject> FNiagaraTools::SpawnComponent(const TSharedPtr<FJsonObje
 
         AuditActions.Add(MakeShared<FJsonValueObject>(MakeAuditAction(TEXT("spawn_niagara"), SpawnArgs)));
 
-        if (Params->HasTypedField<EJson::Object>(TEXT("initialUserParams")))
-        {
-                FString ErrorCode;
-                FString ErrorMessage;
-                TArray<FString> AppliedParams;
-                if (!ApplyUserParameterSet(*SpawnedComponent, Params->GetObjectField(TEXT("initialUserParams")), ErrorCode, ErrorMessage, AppliedParams, AuditActions))
-                {
-                        if (SpawnedComponent)
-                        {
-                                SpawnedComponent->DeactivateImmediate();
-                                SpawnedComponent->DestroyComponent();
-                                if (OwningActor)
-                                {
-                                        OwningActor->RemoveInstanceComponent(SpawnedComponent);
-                                }
-                        }
-
-                        if (!bAttached && OwningActor)
-                        {
-                                OwningActor->Destroy();
-                        }
-
-                        return MakeErrorResponse(ErrorCode, ErrorMessage);
-                }
-        }
+        FUserParamOutcome InitialOutcome;
+        ApplyUserParameterSet(*SpawnedComponent, InitialEdits, /*bAddMissing=*/true, InitialOutcome, AuditActions);
 
         SpawnedComponent->SetAutoActivate(bAutoActivate);
         if (bAutoActivate)
@@ -990,62 +1266,197 @@ TSharedPtr<FJsonObject> FNiagaraTools::SetUserParameters(const TSharedPtr<FJsonO
                 return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
         }
 
-        FString ComponentPath;
-        if (!Params->TryGetStringField(TEXT("componentPath"), ComponentPath))
-        {
-                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing componentPath parameter"));
-        }
+        const TArray<TSharedPtr<FJsonValue>>* ComponentsArray = nullptr;
+        const bool bBatch = Params->TryGetArrayField(TEXT("components"), ComponentsArray) && ComponentsArray;
+        const bool bAddMissing = !Params->HasTypedField<EJson::Boolean>(TEXT("addMissing")) || Params->GetBoolField(TEXT("addMissing"));
+        const bool bReinitialize = Params->HasTypedField<EJson::Boolean>(TEXT("reinitialize")) && Params->GetBoolField(TEXT("reinitialize"));
+        const bool bSaveActor = Params->HasTypedField<EJson::Boolean>(TEXT("saveActor")) && Params->GetBoolField(TEXT("saveActor"));
 
-        ComponentPath.TrimStartAndEndInline();
-        if (ComponentPath.IsEmpty())
+        // Top-level params are parsed once and shared by every component without its own.
+        TMap<FString, UObject*> AssetCache;
+        TArray<FUserParamEdit> SharedEdits;
+        const bool bHasSharedParams = Params->HasTypedField<EJson::Object>(TEXT("params"));
+        if (bHasSharedParams)
         {
-                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing componentPath parameter"));
+                FString ErrorCode;
+                FString ErrorMessage;
+                if (!ParseUserParameterSet(Params->GetObjectField(TEXT("params")), AssetCache, SharedEdits, ErrorCode, ErrorMessage))
+                {
+                        return MakeErrorResponse(ErrorCode, ErrorMessage);
+                }
         }
 
-        if (!Params->HasTypedField<EJson::Object>(TEXT("params")))
+        struct FTarget
         {
-                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("params must be an object"));
-        }
+                FString ComponentPath;
+                UNiagaraComponent* Component = nullptr;
+                /** Index into OwnEdits, or INDEX_NONE for the shared params. */
+                int32 EditsIndex = INDEX_NONE;
+        };
 
-        UNiagaraComponent* NiagaraComponent = ResolveNiagaraComponent(ComponentPath);
-        if (!NiagaraComponent)
+        TArray<FTarget> Targets;
+        TArray<TArray<FUserParamEdit>> OwnEdits;
+        FNiagaraComponentLookup Lookup;
+
+        if (!bBatch)
         {
-                return MakeErrorResponse(ErrorCodeComponentNotFound, FString::Printf(TEXT("Niagara component '%s' not found"), *ComponentPath));
-        }
+                FString ComponentPath;
+                if (!Params->TryGetStringField(TEXT("componentPath"), ComponentPath))
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing componentPath parameter"));
+                }
 
-        NiagaraComponent->Modify();
-        AActor* OwnerActor = NiagaraComponent->GetOwner();
-        if (OwnerActor)
+                ComponentPath.TrimStartAndEndInline();
+                if (ComponentPath.IsEmpty())
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing componentPath parameter"));
+                }
+
+                if (!bHasSharedParams)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("params must be an object"));
+                }
+
+                FTarget& Target = Targets.AddDefaulted_GetRef();
+                Target.ComponentPath = ComponentPath;
+                Target.Component = Lookup.Resolve(ComponentPath);
+                if (!Target.Component)
+                {
+                        return MakeErrorResponse(ErrorCodeComponentNotFound, FString::Printf(TEXT("Niagara component '%s' not found"), *ComponentPath));
+                }
+        }
+        else
         {
-                OwnerActor->Modify();
+                if (ComponentsArray->Num() == 0)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("components must not be empty"));
+                }
+                if (ComponentsArray->Num() > MaxComponentsPerRequest)
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("components has %d entries; the limit is %d"), ComponentsArray->Num(), MaxComponentsPerRequest));
+                }
+
+                // Every entry is resolved and parsed before the first component changes.
+                TMap<UNiagaraComponent*, int32> IndexByComponent;
+                for (int32 Index = 0; Index < ComponentsArray->Num(); ++Index)
+                {
+                        const TSharedPtr<FJsonValue>& Entry = (*ComponentsArray)[Index];
+                        FTarget& Target = Targets.AddDefaulted_GetRef();
+
+                        const TSharedPtr<FJsonObject>* EntryObject = nullptr;
+                        if (Entry.IsValid() && Entry->Type == EJson::String)
+                        {
+                                Target.ComponentPath = Entry->AsString();
+                        }
+                        else if (Entry.IsValid() && Entry->TryGetObject(EntryObject) && EntryObject && EntryObject->IsValid())
+                        {
+                                (*EntryObject)->TryGetStringField(TEXT("componentPath"), Target.ComponentPath);
+                                if ((*EntryObject)->HasTypedField<EJson::Object>(TEXT("params")))
+                                {
+                                        FString ErrorCode;
+                                        FString ErrorMessage;
+                                        Target.EditsIndex = OwnEdits.AddDefaulted();
+                                        if (!ParseUserParameterSet((*EntryObject)->GetObjectField(TEXT("params")), AssetCache, OwnEdits[Target.EditsIndex], ErrorCode, ErrorMessage))
+                                        {
+                                                return MakeErrorResponse(ErrorCode, FString::Printf(TEXT("components[%d]: %s"), Index, *ErrorMessage));
+                                        }
+                                }
+                        }
+                        else
+                        {
+                                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("components[%d] must be a component path or an object"), Index));
+                        }
+
+                        Target.ComponentPath.TrimStartAndEndInline();
+                        if (Target.ComponentPath.IsEmpty())
+                        {
+                                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("components[%d]: Missing componentPath parameter"), Index));
+                        }
+
+                        if (Target.EditsIndex == INDEX_NONE && !bHasSharedParams)
+                        {
+                                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("components[%d]: params must be an object"), Index));
+                        }
+
+                        Target.Component = Lookup.Resolve(Target.ComponentPath);
+                        if (!Target.Component)
+                        {
+                                return MakeErrorResponse(ErrorCodeComponentNotFound, FString::Printf(TEXT("components[%d]: Niagara component '%s' not found"), Index, *Target.ComponentPath));
+                        }
+
+                        if (const int32* Earlier = IndexByComponent.Find(Target.Component))
+                        {
+                                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("components[%d]: component repeats components[%d]"), Index, *Earlier));
+                        }
+                        IndexByComponent.Add(Target.Component, Index);
+                }
         }
 
         TArray<TSharedPtr<FJsonValue>> AuditActions;
-        TArray<FString> AppliedParams;
-        FString ErrorCode;
-        FString ErrorMessage;
-        if (!ApplyUserParameterSet(*NiagaraComponent, Params->GetObjectField(TEXT("params")), ErrorCode, ErrorMessage, AppliedParams, AuditActions))
+        TArray<FUserParamOutcome> Outcomes;
+        Outcomes.SetNum(Targets.Num());
+        TArray<bool> Reinitialized;
+        Reinitialized.Init(false, Targets.Num());
+        int32 NumApplied = 0;
+
+        for (int32 Index = 0; Index < Targets.Num(); ++Index)
         {
-                return MakeErrorResponse(ErrorCode, ErrorMessage);
+                UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(Index, Targets.Num(), TEXT("setting"));
+                UNiagaraComponent* NiagaraComponent = Targets[Index].Component;
+
+                NiagaraComponent->Modify();
+                AActor* OwnerActor = NiagaraComponent->GetOwner();
+                if (OwnerActor)
+                {
+                        OwnerActor->Modify();
+                }
+
+                const TArray<FUserParamEdit>& Edits = Targets[Index].EditsIndex == INDEX_NONE ? SharedEdits : OwnEdits[Targets[Index].EditsIndex];
+                ApplyUserParameterSet(*NiagaraComponent, Edits, bAddMissing, Outcomes[Index], AuditActions);
+                NumApplied += Outcomes[Index].Applied.Num();
+
+                // One restart per component once all of its parameters are in, and none for a
+                // component whose values were already current.
+                if (bReinitialize && Outcomes[Index].Applied.Num() > 0)
+                {
+                        NiagaraComponent->ReinitializeSystem();
+                        Reinitialized[Index] = true;
+                }
+
+                if (bSaveActor && OwnerActor)
+                {
+                        OwnerActor->MarkPackageDirty();
+                }
         }
+        UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(Targets.Num(), Targets.Num(), TEXT("setting"));
 
-        const bool bSaveActor = Params->HasTypedField<EJson::Boolean>(TEXT("saveActor")) && Params->GetBoolField(TEXT("saveActor"));
-        if (bSaveActor && OwnerActor)
+        TSharedPtr<FJsonObject> Result = MakeSuccessResponse();
+        if (!bBatch)
         {
-                OwnerActor->MarkPackageDirty();
+                Result->SetArrayField(TEXT("applied"), ToJsonStrings(Outcomes[0].Applied));
+                Result->SetArrayField(TEXT("notFound"), ToJsonStrings(Outcomes[0].NotFound));
+                Result->SetArrayField(TEXT("unchanged"), ToJsonStrings(Outcomes[0].Unchanged));
+                Result->SetBoolField(TEXT("reinitialized"), Reinitialized[0]);
+                Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, AuditActions));
+                return Result;
         }
 
-        TSharedPtr<FJsonObject> Result = MakeSuccessResponse();
-        TArray<TSharedPtr<FJsonValue>> AppliedArray;
-        for (const FString& Applied : AppliedParams)
+        TArray<TSharedPtr<FJsonValue>> ComponentResults;
+        ComponentResults.Reserve(Targets.Num());
+        for (int32 Index = 0; Index < Targets.Num(); ++Index)
         {
-                AppliedArray.Add(MakeShared<FJsonValueString>(Applied));
+                TSharedPtr<FJsonObject> ComponentResult = MakeShared<FJsonObject>();
+                ComponentResult->SetStringField(TEXT("componentPath"), Targets[Index].Component->GetPathName());
+                ComponentResult->SetArrayField(TEXT("applied"), ToJsonStrings(Outcomes[Index].Applied));
+                ComponentResult->SetArrayField(TEXT("notFound"), ToJsonStrings(Outcomes[Index].NotFound));
+                ComponentResult->SetArrayField(TEXT("unchanged"), ToJsonStrings(Outcomes[Index].Unchanged));
+                ComponentResult->SetBoolField(TEXT("reinitialized"), Reinitialized[Index]);
+                ComponentResults.Add(MakeShared<FJsonValueObject>(ComponentResult));
         }
-        Result->SetArrayField(TEXT("applied"), AppliedArray);
-        TArray<TSharedPtr<FJsonValue>> NotFoundArray;
-        Result->SetArrayField(TEXT("notFound"), NotFoundArray);
-        Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, AuditActions));
 
+        Result->SetArrayField(TEXT("components"), ComponentResults);
+        Result->SetNumberField(TEXT("applied"), NumApplied);
+        Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, AuditActions));
         return Result;
 }
 
@@ -1141,3 +1552,92 @@ TSharedPtr<FJsonObject> FNiagaraTools::Deactivate(const TSharedPtr<FJsonObject>&
         Result->SetObjectField(TEXT("audit"), MakeAuditObject(false, AuditActions));
         return Result;
 }
+
+TSharedPtr<FJsonObject> FNiagaraTools::Prepare(const TSharedPtr<FJsonObject>& Params)
+{
+        UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+        if (TSharedPtr<FPrepareWait> Wait = Context ? Context->TakeResumeState<FPrepareWait>() : nullptr)
+        {
+                return PollPrepare(Wait.ToSharedRef(), *Context);
+        }
+
+        if (!Params.IsValid())
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("Missing parameters"));
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* SystemsArray = nullptr;
+        if (!Params->TryGetArrayField(TEXT("systems"), SystemsArray) || !SystemsArray || SystemsArray->Num() == 0)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, TEXT("systems must be a non-empty array of system paths"));
+        }
+        if (SystemsArray->Num() > MaxSystemsPerPrepare)
+        {
+                return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("systems has %d entries; the limit is %d"), SystemsArray->Num(), MaxSystemsPerPrepare));
+        }
+
+        TSharedRef<FPrepareWait> Wait = MakeShared<FPrepareWait>();
+        for (int32 Index = 0; Index < SystemsArray->Num(); ++Index)
+        {
+                const TSharedPtr<FJsonValue>& Value = (*SystemsArray)[Index];
+                FString SystemPath = Value.IsValid() && Value->Type == EJson::String ? Value->AsString() : FString();
+                SystemPath.TrimStartAndEndInline();
+                if (SystemPath.IsEmpty())
+                {
+                        return MakeErrorResponse(ErrorCodeInvalidParams, FString::Printf(TEXT("systems[%d] must be a system path"), Index));
+                }
+
+                UNiagaraSystem* System = LoadObject<UNiagaraSystem>(nullptr, *SystemPath);
+                if (!System)
+                {
+                        return MakeErrorResponse(ErrorCodeSystemNotFound, FString::Printf(TEXT("systems[%d]: Niagara system '%s' not found"), Index, *SystemPath));
+                }
+
+                if (Wait->Systems.Contains(System))
+                {
+                        continue;
+                }
+                Wait->Systems.Add(System);
+                Wait->SystemPaths.Add(System->GetPathName());
+        }
+
+        const bool bForce = Params->HasTypedField<EJson::Boolean>(TEXT("force")) && Params->GetBoolField(TEXT("force"));
+        Wait->bIncludeGpuShaders = !Params->HasTypedField<EJson::Boolean>(TEXT("includeGpuShaders")) || Params->GetBoolField(TEXT("includeGpuShaders"));
+        Wait->bWarmup = Params->HasTypedField<EJson::Boolean>(TEXT("warmup")) && Params->GetBoolField(TEXT("warmup"));
+
+        double WarmupSeconds = DefaultWarmupSeconds;
+        Params->TryGetNumberField(TEXT("warmupSeconds"), WarmupSeconds);
+        Wait->WarmupSeconds = FMath::Clamp(WarmupSeconds, 0.0, MaxWarmupSeconds);
+
+        double TimeoutSeconds = DefaultPrepareTimeoutSeconds;
+        Params->TryGetNumberField(TEXT("timeoutSec"), TimeoutSeconds);
+        Wait->TimeoutSeconds = FMath::Clamp(TimeoutSeconds, 1.0, MaxPrepareTimeoutSeconds);
+        Wait->StartSeconds = FPlatformTime::Seconds();
+
+#if WITH_EDITOR
+        // Every request is queued before the first wait, so the systems compile side by side.
+        for (const TWeakObjectPtr<UNiagaraSystem>& WeakSystem : Wait->Systems)
+        {
+                WeakSystem->RequestCompile(bForce);
+        }
+#endif
+
+        if (!Context || !Context->CanSuspend())
+        {
+                // A batch entry has to finish inside its slice, so it compiles and warms up in place.
+#if WITH_EDITOR
+                for (const TWeakObjectPtr<UNiagaraSystem>& WeakSystem : Wait->Systems)
+                {
+                        WeakSystem->WaitForCompilationComplete(Wait->bIncludeGpuShaders, /*bShowProgress=*/false);
+                }
+#endif
+                if (Wait->bWarmup)
+                {
+                        SpawnWarmupComponents(*Wait);
+                        Wait->WarmupFramesLeft = 0;
+                }
+                return FinishPrepare(*Wait, false, false);
+        }
+
+        return PollPrepare(Wait, *Context);
+}
@@ -1,22 +1,33 @@
 #include "Observability/JsonLogger.h"
 #include "CoreMinimal.h"
 
+#include "Containers/Queue.h"
 #include "Dom/JsonObject.h"
+#include "HAL/Event.h"
 #include "HAL/FileManager.h"
-#include "Misc/FileHelper.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "Serialization/Archive.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 
 FCriticalSection FJsonLogger::CriticalSection;
 FString FJsonLogger::EventsPath;
 FString FJsonLogger::MetricsPath;
+FString FJsonLogger::SlowPath;
 bool FJsonLogger::bIsEnabled = false;
 
 namespace
 {
     constexpr int64 MaxFileBytes = 20 * 1024 * 1024; // 20 MiB
     constexpr int32 MaxFileGenerations = 3;
+    constexpr int32 BatchBytes = 64 * 1024;
+    constexpr uint32 FlushIntervalMs = 200;
 
     FString BuildMetricPath(const FString& Directory)
     {
@@ -28,6 +39,11 @@ namespace
         return FPaths::Combine(Directory, TEXT("UnrealMCP_events.jsonl"));
     }
 
+    FString BuildSlowPath(const FString& Directory)
+    {
+        return FPaths::Combine(Directory, TEXT("UnrealMCP_slow.jsonl"));
+    }
+
     void RotateFile(const FString& Path)
     {
         if (Path.IsEmpty())
@@ -54,29 +70,168 @@ namespace
             FileManager.Move(*Destination, *Source, true, true, true);
         }
     }
+
+    /**
+     * Appends queued lines to their files from a background thread. Producers (any thread) only
+     * enqueue; the writer wakes on its timer, or early once a batch's worth is waiting.
+     */
+    class FJsonLogWriter : public FRunnable
+    {
+    public:
+        FJsonLogWriter()
+            : WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+        {
+            Thread = FRunnableThread::Create(this, TEXT("UnrealMCPJsonLogWriter"), 0, TPri_BelowNormal);
+        }
+
+        virtual ~FJsonLogWriter() override
+        {
+            if (Thread)
+            {
+                bStopping = true;
+                WakeEvent->Trigger();
+                Thread->WaitForCompletion();
+                delete Thread;
+            }
+            FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        }
+
+        void Enqueue(const FString& Path, FString&& Line)
+        {
+            const int32 LineBytes = Line.Len();
+            Queue.Enqueue(TPair<FString, FString>(Path, MoveTemp(Line)));
+            if (PendingBytes.Add(LineBytes) + LineBytes >= BatchBytes)
+            {
+                WakeEvent->Trigger();
+            }
+        }
+
+        virtual uint32 Run() override
+        {
+            while (!bStopping)
+            {
+                WakeEvent->Wait(FlushIntervalMs);
+                Drain();
+            }
+
+            // Whatever was queued before shutdown still reaches the files.
+            Drain();
+            for (TPair<FString, FOpenFile>& Pair : Files)
+            {
+                Pair.Value.Writer.Reset();
+            }
+            return 0;
+        }
+
+    private:
+        struct FOpenFile
+        {
+            TUniquePtr<FArchive> Writer;
+            /** Size of the file, tracked as we append instead of asking the file system. */
+            int64 Bytes = 0;
+        };
+
+        void Drain()
+        {
+            TMap<FString, TArray<ANSICHAR>> Batches;
+            TPair<FString, FString> Entry;
+            while (Queue.Dequeue(Entry))
+            {
+                PendingBytes.Subtract(Entry.Value.Len());
+                const FTCHARToUTF8 Utf8(*Entry.Value);
+                Batches.FindOrAdd(Entry.Key).Append(Utf8.Get(), Utf8.Length());
+            }
+
+            for (TPair<FString, TArray<ANSICHAR>>& Batch : Batches)
+            {
+                Append(Batch.Key, Batch.Value);
+            }
+        }
+
+        void Append(const FString& Path, TArray<ANSICHAR>& Bytes)
+        {
+            FOpenFile& File = Files.FindOrAdd(Path);
+            if (File.Writer.IsValid() && File.Bytes >= MaxFileBytes)
+            {
+                File.Writer.Reset();
+                RotateFile(Path);
+                File.Bytes = 0;
+            }
+
+            if (!File.Writer.IsValid())
+            {
+                // One size check per open; from then on the count is ours.
+                const int64 ExistingBytes = IFileManager::Get().FileSize(*Path);
+                if (ExistingBytes >= MaxFileBytes)
+                {
+                    RotateFile(Path);
+                }
+                File.Bytes = ExistingBytes >= MaxFileBytes ? 0 : FMath::Max<int64>(ExistingBytes, 0);
+                File.Writer.Reset(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append | FILEWRITE_AllowRead));
+                if (!File.Writer.IsValid())
+                {
+                    return;
+                }
+            }
+
+            File.Writer->Serialize(Bytes.GetData(), Bytes.Num());
+            File.Writer->Flush();
+            File.Bytes += Bytes.Num();
+        }
+
+        TQueue<TPair<FString, FString>, EQueueMode::Mpsc> Queue;
+        FThreadSafeCounter PendingBytes;
+        TMap<FString, FOpenFile> Files;
+        FEvent* WakeEvent;
+        FRunnableThread* Thread = nullptr;
+        FThreadSafeBool bStopping;
+    };
+
+    /** Producers share the read lock, so logging threads never wait on each other. */
+    FRWLock GWriterLock;
+    TUniquePtr<FJsonLogWriter> GWriter;
 }
 
 void FJsonLogger::Init(const FString& Directory, bool bEnable)
 {
     FScopeLock Lock(&CriticalSection);
+
+    FString NormalizedDir = Directory;
+    if (bEnable)
+    {
+        if (NormalizedDir.IsEmpty())
+        {
+            NormalizedDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Logs"));
+        }
+        EnsureDirectory(NormalizedDir);
+    }
+
+    // Settings edits re-initialize the logger while other threads log, so the paths change under
+    // the writer lock that WriteLine holds while it reads them.
+    FWriteScopeLock WriterLock(GWriterLock);
+    GWriter.Reset();
     bIsEnabled = bEnable;
     if (!bIsEnabled)
     {
         EventsPath.Reset();
         MetricsPath.Reset();
+        SlowPath.Reset();
         return;
     }
 
-    FString NormalizedDir = Directory;
-    if (NormalizedDir.IsEmpty())
-    {
-        NormalizedDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Logs"));
-    }
-
-    EnsureDirectory(NormalizedDir);
-
     EventsPath = BuildEventsPath(NormalizedDir);
     MetricsPath = BuildMetricPath(NormalizedDir);
+    SlowPath = BuildSlowPath(NormalizedDir);
+    GWriter = MakeUnique<FJsonLogWriter>();
+}
+
+void FJsonLogger::Shutdown()
+{
+    FScopeLock Lock(&CriticalSection);
+    bIsEnabled = false;
+
+    FWriteScopeLock WriterLock(GWriterLock);
+    GWriter.Reset();
 }
 
 void FJsonLogger::Log(const FLogEvent& Event)
@@ -86,6 +241,21 @@ void FJsonLogger::Log(const FLogEvent& Event)
         return;
     }
 
+    WriteLine(EventsPath, BuildEventPayload(Event));
+}
+
+void FJsonLogger::Slow(const FLogEvent& Event)
+{
+    if (!bIsEnabled)
+    {
+        return;
+    }
+
+    WriteLine(SlowPath, BuildEventPayload(Event));
+}
+
+TSharedRef<FJsonObject> FJsonLogger::BuildEventPayload(const FLogEvent& Event)
+{
     TSharedRef<FJsonObject> Payload = MakeShared<FJsonObject>();
     Payload->SetStringField(TEXT("level"), Event.Level.IsEmpty() ? TEXT("info") : Event.Level.ToLower());
     if (!Event.Category.IsEmpty())
@@ -107,12 +277,13 @@ void FJsonLogger::Log(const FLogEvent& Event)
 
     Payload->SetNumberField(TEXT("ts"), Event.TsUnixMs > 0.0 ? Event.TsUnixMs : NowUnixMs());
 
+    // Referenced, not copied: WriteLine serializes the payload before returning and keeps nothing.
     if (Event.Fields.IsValid())
     {
-        Payload->SetObjectField(TEXT("fields"), CloneJson(Event.Fields));
+        Payload->SetObjectField(TEXT("fields"), Event.Fields);
     }
 
-    WriteLine(EventsPath, Payload);
+    return Payload;
 }
 
 void FJsonLogger::Metric(const FString& Name, const TSharedPtr<FJsonObject>& Fields)
@@ -127,7 +298,7 @@ void FJsonLogger::Metric(const FString& Name, const TSharedPtr<FJsonObject>& Fie
     Payload->SetNumberField(TEXT("ts"), NowUnixMs());
     if (Fields.IsValid())
     {
-        Payload->SetObjectField(TEXT("fields"), CloneJson(Fields));
+        Payload->SetObjectField(TEXT("fields"), Fields);
     }
 
     WriteLine(MetricsPath, Payload);
@@ -145,49 +316,18 @@ void FJsonLogger::EnsureDirectory(const FString& Directory)
 
 void FJsonLogger::WriteLine(const FString& Path, const TSharedRef<FJsonObject>& Payload)
 {
-    if (Path.IsEmpty())
-    {
-        return;
-    }
-
-    FScopeLock Lock(&CriticalSection);
-    RotateIfNeeded(Path);
-
+    // Serialized here, on the caller's thread, so the writer never touches the JSON objects.
     FString Serialized;
     TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Serialized);
     FJsonSerializer::Serialize(Payload, Writer, true);
     Serialized.AppendChar(TEXT('\n'));
 
-    FFileHelper::SaveStringToFile(Serialized, *Path, FFileHelper::EEncodingOptions::ForceUTF8, &IFileManager::Get(), FILEWRITE_Append);
-}
-
-void FJsonLogger::RotateIfNeeded(const FString& Path)
-{
-    if (Path.IsEmpty())
-    {
-        return;
-    }
-
-    const int64 CurrentSize = IFileManager::Get().FileSize(*Path);
-    if (CurrentSize >= MaxFileBytes)
-    {
-        RotateFile(Path);
-    }
-}
-
-TSharedPtr<FJsonObject> FJsonLogger::CloneJson(const TSharedPtr<FJsonObject>& Source)
-{
-    if (!Source.IsValid())
-    {
-        return nullptr;
-    }
-
-    TSharedPtr<FJsonObject> Copy = MakeShared<FJsonObject>();
-    for (const auto& Pair : Source->Values)
+    // Path is one of the static paths, which Init only changes under the write lock.
+    FReadScopeLock WriterLock(GWriterLock);
+    if (GWriter.IsValid() && !Path.IsEmpty())
     {
-        Copy->SetField(Pair.Key, Pair.Value);
+        GWriter->Enqueue(Path, MoveTemp(Serialized));
     }
-    return Copy;
 }
 
 double FJsonLogger::NowUnixMs()
@@ -0,0 +1,6 @@
+#include "Observability/MCPTrace.h"
+#include "CoreMinimal.h"
+
+UE_TRACE_CHANNEL_DEFINE(UnrealMCPChannel)
+
+LLM_DEFINE_TAG(UnrealMCP);
@@ -0,0 +1,281 @@
+#include "Observability/MemoryPolicy.h"
+#include "CoreMinimal.h"
+
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Observability/JsonLogger.h"
+#include "Settings/UnrealMCPRuntimeConfig.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/WeakObjectPtr.h"
+#include "UnrealMCPLog.h"
+
+#include <atomic>
+
+namespace
+{
+    constexpr float TickIntervalSeconds = 1.0f;
+    /** Share of MemoryCeilingMb from which the policy starts collecting. */
+    constexpr double CeilingCollectFraction = 0.9;
+    /** Ceiling collections that freed too little are not repeated every tick. */
+    constexpr double MinCeilingCollectIntervalSeconds = 30.0;
+    constexpr int64 BytesPerMb = 1024 * 1024;
+
+    TFunction<bool()> GHasCommandsInFlight;
+    FTSTicker::FDelegateHandle GTickerHandle;
+    FDelegateHandle GAssetLoadedHandle;
+
+    /** Game thread only. */
+    TSet<TWeakObjectPtr<UPackage>> GTracked;
+    int32 GSliceDepth = 0;
+    int32 GLoadedSinceCollect = 0;
+    double GLastActivitySeconds = 0.0;
+    double GLastCeilingCollectSeconds = 0.0;
+
+    /** Read by GetStats from other threads. */
+    FCriticalSection GStatsMutex;
+    FMemoryPolicy::FStats GStats;
+    std::atomic<bool> GOverCeiling{false};
+
+    int64 GetUsedBytes()
+    {
+        return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+    }
+
+    void OnAssetLoaded(UObject* Asset)
+    {
+        if (GSliceDepth > 0 && Asset)
+        {
+            FMemoryPolicy::NoteLoaded(Asset->GetOutermost());
+        }
+    }
+
+    /**
+     * Clears RF_Standalone on the assets of tracked packages that are unmodified, not the edited
+     * world and not open in an asset editor, so the next collection may free them, and stops
+     * tracking those packages. Returns the objects changed, to have the flag restored on survivors.
+     */
+    TArray<TWeakObjectPtr<UObject>> ReleaseTracked(int32& OutReleasedPackages)
+    {
+        TArray<TWeakObjectPtr<UObject>> Cleared;
+        OutReleasedPackages = 0;
+        UAssetEditorSubsystem* AssetEditors = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+        const UWorld* EditorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+        const UPackage* EditorWorldPackage = EditorWorld ? EditorWorld->GetOutermost() : nullptr;
+
+        TArray<UObject*> Assets;
+        for (auto It = GTracked.CreateIterator(); It; ++It)
+        {
+            UPackage* Package = It->Get();
+            if (!Package)
+            {
+                It.RemoveCurrent();
+                continue;
+            }
+            if (Package->IsDirty() || Package == EditorWorldPackage)
+            {
+                continue;
+            }
+
+            Assets.Reset();
+            bool bInUse = false;
+            ForEachObjectWithPackage(Package, [&Assets, &bInUse, AssetEditors](UObject* Object)
+            {
+                if (Object->IsA<UWorld>() || (AssetEditors && AssetEditors->FindEditorForAsset(Object, false)))
+                {
+                    bInUse = true;
+                    return false;
+                }
+                if (Object->HasAnyFlags(RF_Standalone))
+                {
+                    Assets.Add(Object);
+                }
+                return true;
+            }, false);
+            if (bInUse)
+            {
+                continue;
+            }
+
+            for (UObject* Asset : Assets)
+            {
+                Asset->ClearFlags(RF_Standalone);
+                Cleared.Add(Asset);
+            }
+            ++OutReleasedPackages;
+            It.RemoveCurrent();
+        }
+        return Cleared;
+    }
+}
+
+void FMemoryPolicy::Start(TFunction<bool()> InHasCommandsInFlight)
+{
+    Stop();
+    GHasCommandsInFlight = MoveTemp(InHasCommandsInFlight);
+    GLastActivitySeconds = FPlatformTime::Seconds();
+    GAssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddStatic(&OnAssetLoaded);
+    GTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FMemoryPolicy::Tick), TickIntervalSeconds);
+}
+
+void FMemoryPolicy::Stop()
+{
+    if (GTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(GTickerHandle);
+        GTickerHandle.Reset();
+    }
+    if (GAssetLoadedHandle.IsValid())
+    {
+        FCoreUObjectDelegates::OnAssetLoaded.Remove(GAssetLoadedHandle);
+        GAssetLoadedHandle.Reset();
+    }
+    GHasCommandsInFlight = nullptr;
+    GTracked.Reset();
+    GSliceDepth = 0;
+    GLoadedSinceCollect = 0;
+    GOverCeiling = false;
+}
+
+void FMemoryPolicy::BeginSlice()
+{
+    ++GSliceDepth;
+    GLastActivitySeconds = FPlatformTime::Seconds();
+}
+
+void FMemoryPolicy::EndSlice()
+{
+    GSliceDepth = FMath::Max(GSliceDepth - 1, 0);
+    GLastActivitySeconds = FPlatformTime::Seconds();
+}
+
+void FMemoryPolicy::NoteLoaded(UPackage* Package)
+{
+    if (!GTickerHandle.IsValid() || !Package)
+    {
+        return;
+    }
+
+    bool bAlreadyTracked = false;
+    GTracked.Add(Package, &bAlreadyTracked);
+    if (!bAlreadyTracked)
+    {
+        ++GLoadedSinceCollect;
+    }
+}
+
+bool FMemoryPolicy::Collect(const TCHAR* Reason, bool bRelease, bool bFullPurge)
+{
+    const double StartSeconds = FPlatformTime::Seconds();
+    const int64 UsedBefore = GetUsedBytes();
+
+    int32 ReleasedPackages = 0;
+    TArray<TWeakObjectPtr<UObject>> Cleared;
+    if (bRelease && FUnrealMCPRuntimeConfig::Get().bReleaseAssetsLoadedByCommands)
+    {
+        Cleared = ReleaseTracked(ReleasedPackages);
+    }
+
+    const bool bCollected = TryCollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, bFullPurge);
+
+    // Whatever is still referenced (or was not collected at all) keeps behaving like a loaded asset,
+    // and stays tracked for a later collection.
+    for (const TWeakObjectPtr<UObject>& Object : Cleared)
+    {
+        if (UObject* Survivor = Object.Get())
+        {
+            Survivor->SetFlags(RF_Standalone);
+            GTracked.Add(Survivor->GetOutermost());
+        }
+    }
+    if (!bCollected)
+    {
+        return false;
+    }
+
+    const double DurationSeconds = FPlatformTime::Seconds() - StartSeconds;
+    const int64 UsedAfter = GetUsedBytes();
+    GLoadedSinceCollect = 0;
+    {
+        FScopeLock Lock(&GStatsMutex);
+        GStats.Collections.FindOrAdd(Reason) += 1;
+        GStats.CollectSeconds += DurationSeconds;
+        GStats.LastCollectMs = DurationSeconds * 1000.0;
+        GStats.ReleasedPackages += ReleasedPackages;
+        GStats.TrackedPackages = GTracked.Num();
+        GStats.UsedBytes = UsedAfter;
+    }
+
+    TSharedPtr<FJsonObject> Fields = MakeShared<FJsonObject>();
+    Fields->SetStringField(TEXT("reason"), Reason);
+    Fields->SetNumberField(TEXT("durMs"), DurationSeconds * 1000.0);
+    Fields->SetBoolField(TEXT("fullPurge"), bFullPurge);
+    Fields->SetNumberField(TEXT("releasedPackages"), ReleasedPackages);
+    Fields->SetNumberField(TEXT("usedBeforeMb"), static_cast<double>(UsedBefore) / BytesPerMb);
+    Fields->SetNumberField(TEXT("usedAfterMb"), static_cast<double>(UsedAfter) / BytesPerMb);
+    FJsonLogger::Metric(TEXT("gc"), Fields);
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("MemoryPolicy: %s collection took %.1f ms, released %d packages, used %lld -> %lld MB"),
+        Reason, DurationSeconds * 1000.0, ReleasedPackages, UsedBefore / BytesPerMb, UsedAfter / BytesPerMb);
+    return true;
+}
+
+bool FMemoryPolicy::IsOverCeiling()
+{
+    return GOverCeiling.load(std::memory_order_relaxed);
+}
+
+FMemoryPolicy::FStats FMemoryPolicy::GetStats()
+{
+    FScopeLock Lock(&GStatsMutex);
+    return GStats;
+}
+
+bool FMemoryPolicy::Tick(float DeltaTime)
+{
+    const FUnrealMCPRuntimeConfig& Config = FUnrealMCPRuntimeConfig::Get();
+    const double Now = FPlatformTime::Seconds();
+    const bool bInFlight = GHasCommandsInFlight && GHasCommandsInFlight();
+    if (bInFlight)
+    {
+        GLastActivitySeconds = Now;
+    }
+
+    const int64 CeilingBytes = static_cast<int64>(Config.MemoryCeilingMb) * BytesPerMb;
+    int64 UsedBytes = GetUsedBytes();
+    if (CeilingBytes > 0 && UsedBytes >= static_cast<int64>(CeilingBytes * CeilingCollectFraction)
+        && Now - GLastCeilingCollectSeconds >= MinCeilingCollectIntervalSeconds)
+    {
+        // Near the ceiling the shorter pause of an incremental purge is worth it; at the ceiling it is not.
+        GLastCeilingCollectSeconds = Now;
+        Collect(TEXT("ceiling"), !bInFlight, UsedBytes >= CeilingBytes);
+        UsedBytes = GetUsedBytes();
+    }
+    else if (Config.IdleGcSec > 0.0f && !bInFlight && GLoadedSinceCollect > 0 && Now - GLastActivitySeconds >= Config.IdleGcSec)
+    {
+        Collect(TEXT("idle"), true, false);
+        UsedBytes = GetUsedBytes();
+    }
+
+    const bool bOverCeiling = CeilingBytes > 0 && UsedBytes >= CeilingBytes;
+    if (bOverCeiling != GOverCeiling.load(std::memory_order_relaxed))
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MemoryPolicy: used memory %lld MB is %s the %d MB ceiling; bulk commands are %s"),
+            UsedBytes / BytesPerMb, bOverCeiling ? TEXT("past") : TEXT("back under"), Config.MemoryCeilingMb, bOverCeiling ? TEXT("refused") : TEXT("accepted again"));
+    }
+    GOverCeiling = bOverCeiling;
+    {
+        FScopeLock Lock(&GStatsMutex);
+        GStats.TrackedPackages = GTracked.Num();
+        GStats.UsedBytes = UsedBytes;
+        GStats.CeilingBytes = CeilingBytes;
+        GStats.bOverCeiling = bOverCeiling;
+    }
+    return true;
+}
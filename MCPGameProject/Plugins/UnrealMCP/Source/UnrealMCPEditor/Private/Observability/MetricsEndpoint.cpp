@@ -0,0 +1,229 @@
+#include "Observability/MetricsEndpoint.h"
+#include "CoreMinimal.h"
+
+#include "HttpPath.h"
+#include "HttpRouteHandle.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Observability/MemoryPolicy.h"
+#include "Observability/MetricsRegistry.h"
+#include "Transactions/TransactionManager.h"
+#include "UnrealMCPLog.h"
+
+namespace
+{
+    const TCHAR* const ContentType = TEXT("application/openmetrics-text; version=1.0.0; charset=utf-8");
+
+    /** Exported bucket bounds in milliseconds; the in-memory histogram is much finer. */
+    const double BucketBoundsMs[] = { 1.0, 2.5, 5.0, 10.0, 25.0, 50.0, 100.0, 250.0, 500.0, 1000.0, 2500.0, 5000.0, 10000.0, 30000.0, 60000.0 };
+
+    FString EscapeLabel(const FString& Value)
+    {
+        return Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\"")).Replace(TEXT("\n"), TEXT("\\n"));
+    }
+
+    FString FormatNumber(double Value)
+    {
+        return FString::SanitizeFloat(Value, 0);
+    }
+
+    void AppendFamily(FString& Out, const TCHAR* Name, const TCHAR* Type, const TCHAR* Help, const TCHAR* Unit = nullptr)
+    {
+        Out += FString::Printf(TEXT("# TYPE %s %s\n"), Name, Type);
+        if (Unit)
+        {
+            Out += FString::Printf(TEXT("# UNIT %s %s\n"), Name, Unit);
+        }
+        Out += FString::Printf(TEXT("# HELP %s %s\n"), Name, Help);
+    }
+
+    void AppendHistogram(FString& Out, const TCHAR* Name, const FString& Labels, const FLatencyHistogram& Histogram)
+    {
+        for (const double BoundMs : BucketBoundsMs)
+        {
+            Out += FString::Printf(TEXT("%s_bucket{%s,le=\"%s\"} %llu\n"), Name, *Labels, *FormatNumber(BoundMs / 1000.0), Histogram.GetCountAtOrBelow(BoundMs));
+        }
+        Out += FString::Printf(TEXT("%s_bucket{%s,le=\"+Inf\"} %llu\n"), Name, *Labels, Histogram.GetCount());
+        Out += FString::Printf(TEXT("%s_count{%s} %llu\n"), Name, *Labels, Histogram.GetCount());
+        Out += FString::Printf(TEXT("%s_sum{%s} %s\n"), Name, *Labels, *FormatNumber(Histogram.GetSumMs() / 1000.0));
+    }
+}
+
+FMetricsEndpoint::~FMetricsEndpoint()
+{
+    Stop();
+}
+
+bool FMetricsEndpoint::Start(uint32 Port, FGaugeSource InGauges, FString& OutError)
+{
+    check(IsInGameThread());
+
+    Stop();
+
+    Router = FHttpServerModule::Get().GetHttpRouter(Port, /*bFailOnBindFailure=*/true);
+    if (!Router.IsValid())
+    {
+        OutError = FString::Printf(TEXT("Could not bind the metrics listener on port %u"), Port);
+        return false;
+    }
+
+    Gauges = MoveTemp(InGauges);
+    RouteHandle = Router->BindRoute(FHttpPath(TEXT("/metrics")), EHttpServerRequestVerbs::VERB_GET,
+        FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+        {
+            OnComplete(FHttpServerResponse::Create(Render(Gauges ? Gauges() : FMetricsGauges()), ContentType));
+            return true;
+        }));
+    if (!RouteHandle.IsValid())
+    {
+        OutError = FString::Printf(TEXT("GET /metrics is already bound on port %u"), Port);
+        Router.Reset();
+        return false;
+    }
+
+    FHttpServerModule::Get().StartAllListeners();
+    UE_LOG(LogUnrealMCP, Display, TEXT("FMetricsEndpoint: Serving OpenMetrics on port %u at /metrics"), Port);
+    return true;
+}
+
+void FMetricsEndpoint::Stop()
+{
+    if (Router.IsValid() && RouteHandle.IsValid())
+    {
+        Router->UnbindRoute(RouteHandle);
+    }
+    RouteHandle.Reset();
+    Router.Reset();
+    Gauges = nullptr;
+}
+
+FString FMetricsEndpoint::Render(const FMetricsGauges& Gauges)
+{
+    const TArray<FToolMetricsSnapshot> Series = FMetricsRegistry::GetSnapshot();
+    const TArray<FToolMetricsSnapshot> Phases = FMetricsRegistry::GetPhaseSnapshot();
+    const TArray<FToolMemorySnapshot> Memory = FMetricsRegistry::GetMemorySnapshot();
+    const TArray<FStartupMilestone> Startup = FMetricsRegistry::GetStartupTimeline();
+
+    FString Out;
+    Out.Reserve(4096 + (Series.Num() + Phases.Num()) * 1024);
+
+    AppendFamily(Out, TEXT("unrealmcp_tool_duration_seconds"), TEXT("histogram"), TEXT("Time from request receipt to response, per tool and outcome."), TEXT("seconds"));
+    for (const FToolMetricsSnapshot& Entry : Series)
+    {
+        const FString Labels = FString::Printf(TEXT("tool=\"%s\",outcome=\"%s\""), *EscapeLabel(Entry.Tool), *EscapeLabel(Entry.Outcome));
+        AppendHistogram(Out, TEXT("unrealmcp_tool_duration_seconds"), Labels, Entry.Total);
+    }
+
+    AppendFamily(Out, TEXT("unrealmcp_tool_phase_seconds"), TEXT("histogram"), TEXT("Time per request phase (queue, gate, checkout, handler, parked, complete, serialize, send), per tool."), TEXT("seconds"));
+    for (const FToolMetricsSnapshot& Entry : Phases)
+    {
+        const FString Labels = FString::Printf(TEXT("tool=\"%s\",phase=\"%s\""), *EscapeLabel(Entry.Tool), *EscapeLabel(Entry.Outcome));
+        AppendHistogram(Out, TEXT("unrealmcp_tool_phase_seconds"), Labels, Entry.Total);
+    }
+
+    AppendFamily(Out, TEXT("unrealmcp_tool_calls"), TEXT("counter"), TEXT("Completed commands, per tool and outcome."));
+    for (const FToolMetricsSnapshot& Entry : Series)
+    {
+        Out += FString::Printf(TEXT("unrealmcp_tool_calls_total{tool=\"%s\",outcome=\"%s\"} %llu\n"), *EscapeLabel(Entry.Tool), *EscapeLabel(Entry.Outcome), Entry.Total.GetCount());
+    }
+
+    AppendFamily(Out, TEXT("unrealmcp_tool_peak_memory_bytes"), TEXT("gauge"), TEXT("Largest used-memory rise seen during one call, per tool."), TEXT("bytes"));
+    for (const FToolMemorySnapshot& Entry : Memory)
+    {
+        Out += FString::Printf(TEXT("unrealmcp_tool_peak_memory_bytes{tool=\"%s\"} %lld\n"), *EscapeLabel(Entry.Tool), Entry.Total.MaxPeakBytes);
+    }
+
+    AppendFamily(Out, TEXT("unrealmcp_tool_peak_memory_sum_bytes"), TEXT("counter"), TEXT("Sum of per-call used-memory peaks; divide by the call count for the average."), TEXT("bytes"));
+    for (const FToolMemorySnapshot& Entry : Memory)
+    {
+        Out += FString::Printf(TEXT("unrealmcp_tool_peak_memory_sum_bytes_total{tool=\"%s\"} %s\n"), *EscapeLabel(Entry.Tool), *FormatNumber(Entry.Total.SumPeakBytes));
+    }
+
+    AppendFamily(Out, TEXT("unrealmcp_received_bytes"), TEXT("counter"), TEXT("Frame payload bytes read from clients, after decompression."), TEXT("bytes"));
+    Out += FString::Printf(TEXT("unrealmcp_received_bytes_total %lld\n"), FMetricsRegistry::GetBytesReceived());
+
+    AppendFamily(Out, TEXT("unrealmcp_sent_bytes"), TEXT("counter"), TEXT("Frame payload bytes sent to clients, before compression."), TEXT("bytes"));
+    Out += FString::Printf(TEXT("unrealmcp_sent_bytes_total %lld\n"), FMetricsRegistry::GetBytesSent());
+
+    AppendFamily(Out, TEXT("unrealmcp_game_thread_seconds"), TEXT("counter"), TEXT("Game-thread time spent running MCP commands."), TEXT("seconds"));
+    Out += FString::Printf(TEXT("unrealmcp_game_thread_seconds_total %s\n"), *FormatNumber(FMetricsRegistry::GetGameThreadSeconds()));
+
+    AppendFamily(Out, TEXT("unrealmcp_command_queue_depth"), TEXT("gauge"), TEXT("Commands waiting for the game thread."));
+    Out += FString::Printf(TEXT("unrealmcp_command_queue_depth %d\n"), Gauges.QueueDepth);
+
+    AppendFamily(Out, TEXT("unrealmcp_in_flight_requests"), TEXT("gauge"), TEXT("Requests accepted and not yet answered, across all connections."));
+    Out += FString::Printf(TEXT("unrealmcp_in_flight_requests %d\n"), Gauges.InFlight);
+
+    AppendFamily(Out, TEXT("unrealmcp_connections"), TEXT("gauge"), TEXT("Connected clients."));
+    Out += FString::Printf(TEXT("unrealmcp_connections %d\n"), Gauges.Connections);
+
+    AppendFamily(Out, TEXT("unrealmcp_frames_over_budget"), TEXT("gauge"), TEXT("Frames in the last minute whose MCP work exceeded GameThreadBudgetMs."));
+    Out += FString::Printf(TEXT("unrealmcp_frames_over_budget %d\n"), Gauges.FramesOverBudget);
+
+    AppendFamily(Out, TEXT("unrealmcp_prefetch_queued"), TEXT("counter"), TEXT("Speculative follow-up reads queued after asset.find and sequence.create."));
+    Out += FString::Printf(TEXT("unrealmcp_prefetch_queued_total %lld\n"), Gauges.PrefetchQueued);
+
+    AppendFamily(Out, TEXT("unrealmcp_prefetch_runs"), TEXT("counter"), TEXT("Follow-up reads run in idle game-thread time."));
+    Out += FString::Printf(TEXT("unrealmcp_prefetch_runs_total %lld\n"), Gauges.PrefetchRun);
+
+    AppendFamily(Out, TEXT("unrealmcp_prefetch_hits"), TEXT("counter"), TEXT("Requests answered from a response a prefetch cached."));
+    Out += FString::Printf(TEXT("unrealmcp_prefetch_hits_total %lld\n"), Gauges.PrefetchHits);
+
+    AppendFamily(Out, TEXT("unrealmcp_prefetch_dropped"), TEXT("counter"), TEXT("Follow-ups dropped unrun: already cached, too old, queue full or play session."));
+    Out += FString::Printf(TEXT("unrealmcp_prefetch_dropped_total %lld\n"), Gauges.PrefetchDropped);
+
+    AppendFamily(Out, TEXT("unrealmcp_prefetch_seconds"), TEXT("counter"), TEXT("Game-thread time spent running follow-ups."), TEXT("seconds"));
+    Out += FString::Printf(TEXT("unrealmcp_prefetch_seconds_total %s\n"), *FormatNumber(Gauges.PrefetchSeconds));
+
+    const FMemoryPolicy::FStats MemoryPolicy = FMemoryPolicy::GetStats();
+    AppendFamily(Out, TEXT("unrealmcp_gc_runs"), TEXT("counter"), TEXT("Garbage collections run by the memory policy, per reason (idle, ceiling, chunk)."));
+    for (const TPair<FString, int32>& Entry : MemoryPolicy.Collections)
+    {
+        Out += FString::Printf(TEXT("unrealmcp_gc_runs_total{reason=\"%s\"} %d\n"), *EscapeLabel(Entry.Key), Entry.Value);
+    }
+
+    AppendFamily(Out, TEXT("unrealmcp_gc_seconds"), TEXT("counter"), TEXT("Game-thread time spent in those collections."), TEXT("seconds"));
+    Out += FString::Printf(TEXT("unrealmcp_gc_seconds_total %s\n"), *FormatNumber(MemoryPolicy.CollectSeconds));
+
+    AppendFamily(Out, TEXT("unrealmcp_released_packages"), TEXT("counter"), TEXT("Packages loaded by commands whose assets were released for collection."));
+    Out += FString::Printf(TEXT("unrealmcp_released_packages_total %d\n"), MemoryPolicy.ReleasedPackages);
+
+    AppendFamily(Out, TEXT("unrealmcp_tracked_packages"), TEXT("gauge"), TEXT("Packages loaded by commands and not yet released."));
+    Out += FString::Printf(TEXT("unrealmcp_tracked_packages %d\n"), MemoryPolicy.TrackedPackages);
+
+    AppendFamily(Out, TEXT("unrealmcp_used_memory_bytes"), TEXT("gauge"), TEXT("Physical memory used by the editor at the last policy tick."), TEXT("bytes"));
+    Out += FString::Printf(TEXT("unrealmcp_used_memory_bytes %lld\n"), MemoryPolicy.UsedBytes);
+
+    AppendFamily(Out, TEXT("unrealmcp_memory_ceiling_bytes"), TEXT("gauge"), TEXT("MemoryCeilingMb in bytes; 0 when unbounded."), TEXT("bytes"));
+    Out += FString::Printf(TEXT("unrealmcp_memory_ceiling_bytes %lld\n"), MemoryPolicy.CeilingBytes);
+
+    const FTransactionManager::FUndoStats Undo = FTransactionManager::GetUndoStats();
+    AppendFamily(Out, TEXT("unrealmcp_undo_held_bytes"), TEXT("gauge"), TEXT("Undo buffer memory held by MCP transactions."), TEXT("bytes"));
+    Out += FString::Printf(TEXT("unrealmcp_undo_held_bytes %lld\n"), Undo.HeldBytes);
+
+    AppendFamily(Out, TEXT("unrealmcp_undo_held_transactions"), TEXT("gauge"), TEXT("MCP transactions in the undo buffer."));
+    Out += FString::Printf(TEXT("unrealmcp_undo_held_transactions %d\n"), Undo.HeldTransactions);
+
+    AppendFamily(Out, TEXT("unrealmcp_undo_trimmed_bytes"), TEXT("counter"), TEXT("MCP undo memory dropped to stay under MaxUndoMemoryMb."), TEXT("bytes"));
+    Out += FString::Printf(TEXT("unrealmcp_undo_trimmed_bytes_total %lld\n"), Undo.TrimmedBytes);
+
+    AppendFamily(Out, TEXT("unrealmcp_undo_trimmed_transactions"), TEXT("counter"), TEXT("MCP transactions dropped from the undo buffer."));
+    Out += FString::Printf(TEXT("unrealmcp_undo_trimmed_transactions_total %d\n"), Undo.TrimmedTransactions);
+
+    AppendFamily(Out, TEXT("unrealmcp_startup_milestone_seconds"), TEXT("gauge"), TEXT("When each startup step (module load, settings read, socket bind, first command) finished, since process start."), TEXT("seconds"));
+    for (const FStartupMilestone& Entry : Startup)
+    {
+        Out += FString::Printf(TEXT("unrealmcp_startup_milestone_seconds{milestone=\"%s\"} %s\n"), *EscapeLabel(Entry.Name), *FormatNumber(Entry.AtSeconds));
+    }
+
+    AppendFamily(Out, TEXT("unrealmcp_startup_step_seconds"), TEXT("gauge"), TEXT("How long each startup step took."), TEXT("seconds"));
+    for (const FStartupMilestone& Entry : Startup)
+    {
+        Out += FString::Printf(TEXT("unrealmcp_startup_step_seconds{milestone=\"%s\"} %s\n"), *EscapeLabel(Entry.Name), *FormatNumber(Entry.DurationMs / 1000.0));
+    }
+
+    Out += TEXT("# EOF\n");
+    return Out;
+}
@@ -0,0 +1,411 @@
+#include "Observability/MetricsRegistry.h"
+#include "CoreMinimal.h"
+
+#include "CoreGlobals.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Observability/JsonLogger.h"
+
+#include <atomic>
+
+namespace
+{
+    struct FToolSeries
+    {
+        FLatencyHistogram Total;
+        FLatencyHistogram Interval;
+    };
+
+    FCriticalSection GMetricsMutex;
+    /** Keyed by "tool|outcome". */
+    TMap<FString, FToolSeries> GSeries;
+    /** Keyed by "tool|phase". */
+    TMap<FString, FToolSeries> GPhaseSeries;
+    TMap<FString, FToolMemorySnapshot> GMemorySeries;
+    float GRawSampleRate = 0.0f;
+    FTSTicker::FDelegateHandle GFlushTickerHandle;
+
+    std::atomic<int64> GBytesReceived{0};
+    std::atomic<int64> GBytesSent{0};
+    /** In microseconds, so it can be a plain integer atomic. */
+    std::atomic<int64> GGameThreadMicros{0};
+
+    TArray<FStartupMilestone> GStartupTimeline;
+    /** Set by the first RecordToolCall, so later calls skip the timeline lock. */
+    std::atomic<bool> GFirstCommandServed{false};
+
+    FString MakeSeriesKey(const FString& Tool, const FString& Outcome)
+    {
+        return Tool + TEXT("|") + Outcome;
+    }
+
+    void SplitSeriesKey(const FString& Key, FString& OutTool, FString& OutOutcome)
+    {
+        if (!Key.Split(TEXT("|"), &OutTool, &OutOutcome, ESearchCase::CaseSensitive, ESearchDir::FromEnd))
+        {
+            OutTool = Key;
+            OutOutcome.Reset();
+        }
+    }
+
+    /** Caller holds GMetricsMutex. */
+    TArray<FToolMetricsSnapshot> CopySeries(const TMap<FString, FToolSeries>& Source)
+    {
+        TArray<FToolMetricsSnapshot> Snapshot;
+        Snapshot.Reserve(Source.Num());
+        for (const TPair<FString, FToolSeries>& Pair : Source)
+        {
+            FToolMetricsSnapshot& Entry = Snapshot.AddDefaulted_GetRef();
+            SplitSeriesKey(Pair.Key, Entry.Tool, Entry.Outcome);
+            Entry.Total = Pair.Value.Total;
+            Entry.Interval = Pair.Value.Interval;
+        }
+        return Snapshot;
+    }
+
+    /** Moves the active intervals out of Source and starts new ones. Caller holds GMetricsMutex. */
+    TArray<FToolMetricsSnapshot> TakeIntervals(TMap<FString, FToolSeries>& Source)
+    {
+        TArray<FToolMetricsSnapshot> Snapshot;
+        for (TPair<FString, FToolSeries>& Pair : Source)
+        {
+            if (Pair.Value.Interval.GetCount() == 0)
+            {
+                continue;
+            }
+
+            FToolMetricsSnapshot& Entry = Snapshot.AddDefaulted_GetRef();
+            SplitSeriesKey(Pair.Key, Entry.Tool, Entry.Outcome);
+            Entry.Total = Pair.Value.Total;
+            Entry.Interval = MoveTemp(Pair.Value.Interval);
+            Pair.Value.Interval.Reset();
+        }
+        return Snapshot;
+    }
+
+    void WriteIntervals(const TArray<FToolMetricsSnapshot>& Snapshot, const TCHAR* Name, const TCHAR* KeyField)
+    {
+        for (const FToolMetricsSnapshot& Entry : Snapshot)
+        {
+            TSharedPtr<FJsonObject> Fields = MakeShared<FJsonObject>();
+            Fields->SetStringField(TEXT("tool"), Entry.Tool);
+            Fields->SetStringField(KeyField, Entry.Outcome);
+            Fields->SetNumberField(TEXT("count"), static_cast<double>(Entry.Interval.GetCount()));
+            Fields->SetNumberField(TEXT("totalCount"), static_cast<double>(Entry.Total.GetCount()));
+            Fields->SetNumberField(TEXT("sumMs"), Entry.Interval.GetSumMs());
+            Fields->SetNumberField(TEXT("p50Ms"), Entry.Interval.GetPercentileMs(0.50));
+            Fields->SetNumberField(TEXT("p95Ms"), Entry.Interval.GetPercentileMs(0.95));
+            Fields->SetNumberField(TEXT("p99Ms"), Entry.Interval.GetPercentileMs(0.99));
+            Fields->SetNumberField(TEXT("maxMs"), Entry.Interval.GetMaxMs());
+            FJsonLogger::Metric(Name, Fields);
+        }
+    }
+}
+
+FLatencyHistogram::FLatencyHistogram()
+    : Count(0)
+    , SumMs(0.0)
+    , MaxMs(0.0)
+{
+}
+
+int32 FLatencyHistogram::BucketIndex(uint64 Microseconds)
+{
+    // Values below 2 * SubBucketCount are exact; above, the top SubBucketBits + 1 bits pick the bucket.
+    if (Microseconds < 2 * SubBucketCount)
+    {
+        return static_cast<int32>(Microseconds);
+    }
+
+    const int32 Exponent = FMath::Min(static_cast<int32>(FMath::FloorLog2_64(Microseconds)) - SubBucketBits, MaxExponent);
+    const uint64 SubBucket = FMath::Min<uint64>(Microseconds >> Exponent, 2 * SubBucketCount - 1) - SubBucketCount;
+    return (Exponent + 1) * SubBucketCount + static_cast<int32>(SubBucket);
+}
+
+uint64 FLatencyHistogram::BucketLowerBound(int32 Index)
+{
+    if (Index < 2 * SubBucketCount)
+    {
+        return static_cast<uint64>(Index);
+    }
+
+    const int32 Exponent = Index / SubBucketCount - 1;
+    const uint64 SubBucket = static_cast<uint64>(Index % SubBucketCount + SubBucketCount);
+    return SubBucket << Exponent;
+}
+
+uint64 FLatencyHistogram::BucketWidth(int32 Index)
+{
+    return Index < 2 * SubBucketCount ? 1 : uint64(1) << (Index / SubBucketCount - 1);
+}
+
+void FLatencyHistogram::Record(double Milliseconds)
+{
+    if (Buckets.Num() == 0)
+    {
+        Buckets.SetNumZeroed(NumBuckets);
+    }
+
+    const double Clamped = FMath::Max(Milliseconds, 0.0);
+    const uint64 Microseconds = static_cast<uint64>(Clamped * 1000.0);
+    ++Buckets[FMath::Clamp(BucketIndex(Microseconds), 0, NumBuckets - 1)];
+    ++Count;
+    SumMs += Clamped;
+    MaxMs = FMath::Max(MaxMs, Clamped);
+}
+
+void FLatencyHistogram::Reset()
+{
+    Buckets.Reset();
+    Count = 0;
+    SumMs = 0.0;
+    MaxMs = 0.0;
+}
+
+void FLatencyHistogram::Merge(const FLatencyHistogram& Other)
+{
+    if (Other.Count == 0)
+    {
+        return;
+    }
+    if (Buckets.Num() == 0)
+    {
+        Buckets.SetNumZeroed(NumBuckets);
+    }
+
+    for (int32 Index = 0; Index < Other.Buckets.Num(); ++Index)
+    {
+        Buckets[Index] += Other.Buckets[Index];
+    }
+    Count += Other.Count;
+    SumMs += Other.SumMs;
+    MaxMs = FMath::Max(MaxMs, Other.MaxMs);
+}
+
+double FLatencyHistogram::GetPercentileMs(double Quantile) const
+{
+    if (Count == 0)
+    {
+        return 0.0;
+    }
+
+    const uint64 Rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Quantile, 0.0, 1.0) * static_cast<double>(Count))));
+    uint64 Seen = 0;
+    for (int32 Index = 0; Index < Buckets.Num(); ++Index)
+    {
+        Seen += Buckets[Index];
+        if (Seen >= Rank)
+        {
+            const double MidpointUs = static_cast<double>(BucketLowerBound(Index)) + static_cast<double>(BucketWidth(Index)) * 0.5;
+            return FMath::Min(MidpointUs / 1000.0, MaxMs);
+        }
+    }
+    return MaxMs;
+}
+
+uint64 FLatencyHistogram::GetCountAtOrBelow(double Milliseconds) const
+{
+    const double BoundUs = Milliseconds * 1000.0;
+    uint64 Seen = 0;
+    for (int32 Index = 0; Index < Buckets.Num() && static_cast<double>(BucketLowerBound(Index)) <= BoundUs; ++Index)
+    {
+        Seen += Buckets[Index];
+    }
+    return Seen;
+}
+
+void FMetricsRegistry::Start(float FlushIntervalSeconds, float RawSampleRate)
+{
+    check(IsInGameThread());
+
+    {
+        FScopeLock Lock(&GMetricsMutex);
+        GRawSampleRate = FMath::Clamp(RawSampleRate, 0.0f, 1.0f);
+    }
+
+    if (!GFlushTickerHandle.IsValid() && FlushIntervalSeconds > 0.0f)
+    {
+        GFlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FMetricsRegistry::Tick), FlushIntervalSeconds);
+    }
+}
+
+void FMetricsRegistry::Stop()
+{
+    if (GFlushTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(GFlushTickerHandle);
+        GFlushTickerHandle.Reset();
+    }
+
+    Flush();
+}
+
+void FMetricsRegistry::RecordToolCall(const FString& Tool, bool bOk, const FString& ErrorCode, double DurationMs)
+{
+    const FString Outcome = bOk ? FString(TEXT("ok")) : (ErrorCode.IsEmpty() ? FString(TEXT("error")) : ErrorCode);
+
+    if (!GFirstCommandServed.exchange(true, std::memory_order_relaxed))
+    {
+        MarkStartup(TEXT("first_command"), FPlatformTime::Seconds() - DurationMs / 1000.0);
+    }
+
+    bool bWriteRaw = false;
+    {
+        FScopeLock Lock(&GMetricsMutex);
+        FToolSeries& Series = GSeries.FindOrAdd(MakeSeriesKey(Tool, Outcome));
+        Series.Total.Record(DurationMs);
+        Series.Interval.Record(DurationMs);
+        bWriteRaw = GRawSampleRate > 0.0f && FMath::FRand() < GRawSampleRate;
+    }
+
+    if (bWriteRaw)
+    {
+        TSharedPtr<FJsonObject> Fields = MakeShared<FJsonObject>();
+        Fields->SetStringField(TEXT("tool"), Tool);
+        Fields->SetBoolField(TEXT("ok"), bOk);
+        Fields->SetNumberField(TEXT("durMs"), DurationMs);
+        if (!ErrorCode.IsEmpty())
+        {
+            Fields->SetStringField(TEXT("errorCode"), ErrorCode);
+        }
+        FJsonLogger::Metric(TEXT("tool_duration_ms"), Fields);
+    }
+}
+
+void FMetricsRegistry::RecordMemory(const FString& Tool, int64 PeakDeltaBytes)
+{
+    const int64 PeakBytes = FMath::Max<int64>(PeakDeltaBytes, 0);
+
+    FScopeLock Lock(&GMetricsMutex);
+    FToolMemorySnapshot& Series = GMemorySeries.FindOrAdd(Tool);
+    Series.Tool = Tool;
+    Series.Total.Record(PeakBytes);
+    Series.Interval.Record(PeakBytes);
+}
+
+void FMetricsRegistry::RecordPhase(const FString& Tool, const TCHAR* Phase, double DurationMs)
+{
+    FScopeLock Lock(&GMetricsMutex);
+    FToolSeries& Series = GPhaseSeries.FindOrAdd(MakeSeriesKey(Tool, Phase));
+    Series.Total.Record(DurationMs);
+    Series.Interval.Record(DurationMs);
+}
+
+TArray<FToolMetricsSnapshot> FMetricsRegistry::GetSnapshot()
+{
+    FScopeLock Lock(&GMetricsMutex);
+    return CopySeries(GSeries);
+}
+
+TArray<FToolMetricsSnapshot> FMetricsRegistry::GetPhaseSnapshot()
+{
+    FScopeLock Lock(&GMetricsMutex);
+    return CopySeries(GPhaseSeries);
+}
+
+TArray<FToolMemorySnapshot> FMetricsRegistry::GetMemorySnapshot()
+{
+    TArray<FToolMemorySnapshot> Snapshot;
+    FScopeLock Lock(&GMetricsMutex);
+    GMemorySeries.GenerateValueArray(Snapshot);
+    return Snapshot;
+}
+
+void FMetricsRegistry::Flush()
+{
+    TArray<FToolMetricsSnapshot> Calls;
+    TArray<FToolMetricsSnapshot> Phases;
+    TArray<FToolMemorySnapshot> Memory;
+    {
+        FScopeLock Lock(&GMetricsMutex);
+        Calls = TakeIntervals(GSeries);
+        Phases = TakeIntervals(GPhaseSeries);
+        for (TPair<FString, FToolMemorySnapshot>& Pair : GMemorySeries)
+        {
+            if (Pair.Value.Interval.Count > 0)
+            {
+                Memory.Add(Pair.Value);
+                Pair.Value.Interval = FToolMemoryStats();
+            }
+        }
+    }
+
+    WriteIntervals(Calls, TEXT("tool_latency_snapshot"), TEXT("outcome"));
+    WriteIntervals(Phases, TEXT("tool_phase_snapshot"), TEXT("phase"));
+    for (const FToolMemorySnapshot& Entry : Memory)
+    {
+        TSharedPtr<FJsonObject> Fields = MakeShared<FJsonObject>();
+        Fields->SetStringField(TEXT("tool"), Entry.Tool);
+        Fields->SetNumberField(TEXT("count"), static_cast<double>(Entry.Interval.Count));
+        Fields->SetNumberField(TEXT("avgPeakBytes"), Entry.Interval.SumPeakBytes / static_cast<double>(Entry.Interval.Count));
+        Fields->SetNumberField(TEXT("maxPeakBytes"), static_cast<double>(Entry.Interval.MaxPeakBytes));
+        Fields->SetNumberField(TEXT("totalMaxPeakBytes"), static_cast<double>(Entry.Total.MaxPeakBytes));
+        FJsonLogger::Metric(TEXT("tool_memory_snapshot"), Fields);
+    }
+}
+
+bool FMetricsRegistry::Tick(float DeltaTime)
+{
+    Flush();
+    return true;
+}
+
+void FMetricsRegistry::AddBytesReceived(int64 Bytes)
+{
+    GBytesReceived.fetch_add(Bytes, std::memory_order_relaxed);
+}
+
+void FMetricsRegistry::AddBytesSent(int64 Bytes)
+{
+    GBytesSent.fetch_add(Bytes, std::memory_order_relaxed);
+}
+
+void FMetricsRegistry::AddGameThreadSeconds(double Seconds)
+{
+    GGameThreadMicros.fetch_add(static_cast<int64>(FMath::Max(Seconds, 0.0) * 1000000.0), std::memory_order_relaxed);
+}
+
+void FMetricsRegistry::MarkStartup(const TCHAR* Milestone, double StartedAt)
+{
+    const double Now = FPlatformTime::Seconds();
+    FStartupMilestone Entry;
+    Entry.Name = Milestone;
+    Entry.AtSeconds = Now - GStartTime;
+    Entry.DurationMs = FMath::Max(Now - StartedAt, 0.0) * 1000.0;
+    {
+        FScopeLock Lock(&GMetricsMutex);
+        if (GStartupTimeline.ContainsByPredicate([&Entry](const FStartupMilestone& Existing) { return Existing.Name == Entry.Name; }))
+        {
+            return;
+        }
+        GStartupTimeline.Add(Entry);
+    }
+
+    TSharedPtr<FJsonObject> Fields = MakeShared<FJsonObject>();
+    Fields->SetStringField(TEXT("milestone"), Entry.Name);
+    Fields->SetNumberField(TEXT("sinceProcessStartMs"), Entry.AtSeconds * 1000.0);
+    Fields->SetNumberField(TEXT("durMs"), Entry.DurationMs);
+    FJsonLogger::Metric(TEXT("startup_milestone"), Fields);
+}
+
+TArray<FStartupMilestone> FMetricsRegistry::GetStartupTimeline()
+{
+    FScopeLock Lock(&GMetricsMutex);
+    return GStartupTimeline;
+}
+
+int64 FMetricsRegistry::GetBytesReceived()
+{
+    return GBytesReceived.load(std::memory_order_relaxed);
+}
+
+int64 FMetricsRegistry::GetBytesSent()
+{
+    return GBytesSent.load(std::memory_order_relaxed);
+}
+
+double FMetricsRegistry::GetGameThreadSeconds()
+{
+    return static_cast<double>(GGameThreadMicros.load(std::memory_order_relaxed)) / 1000000.0;
+}
@@ -0,0 +1,305 @@
+#include "Observability/StallWatchdog.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformStackWalk.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Crc.h"
+#include "Misc/ScopeLock.h"
+#include "Observability/JsonLogger.h"
+#include "Observability/MetricsRegistry.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Protocol/ResponseCache.h"
+#include "UnrealMCPLog.h"
+
+namespace
+{
+    constexpr double OverBudgetWindowSeconds = 60.0;
+    constexpr SIZE_T CallstackBufferSize = 16 * 1024;
+    /** The sampler never sleeps longer than this, so a lowered threshold takes effect quickly. */
+    constexpr uint32 MaxSamplerWaitMs = 250;
+}
+
+FStallWatchdog::FStallWatchdog()
+    : ActiveStartSeconds(0.0)
+    , ActiveSliceId(0)
+    , bActiveSampled(false)
+    , ActiveStartUsedBytes(0)
+    , ActivePeakUsedBytes(0)
+    , AccumulatingFrame(0)
+    , AccumulatedFrameSeconds(0.0)
+    , SlowThresholdSeconds(0.0)
+    , FrameBudgetSeconds(0.0)
+    , MemorySampleSeconds(0.0)
+    , Thread(nullptr)
+    , WakeEvent(nullptr)
+{
+}
+
+FStallWatchdog::~FStallWatchdog()
+{
+    Shutdown();
+}
+
+void FStallWatchdog::Configure(double InSlowThresholdMs, double InFrameBudgetMs, double InMemorySampleMs)
+{
+    {
+        FScopeLock Lock(&Mutex);
+        SlowThresholdSeconds = FMath::Max(InSlowThresholdMs, 0.0) / 1000.0;
+        FrameBudgetSeconds = FMath::Max(InFrameBudgetMs, 0.0) / 1000.0;
+        MemorySampleSeconds = FMath::Max(InMemorySampleMs, 0.0) / 1000.0;
+    }
+
+    if ((SlowThresholdSeconds > 0.0 || MemorySampleSeconds > 0.0) && !Thread)
+    {
+        bStopping = false;
+        WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+        Thread = FRunnableThread::Create(this, TEXT("UnrealMCPStallWatchdog"), 0, TPri_BelowNormal);
+    }
+}
+
+void FStallWatchdog::Shutdown()
+{
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (WakeEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+}
+
+void FStallWatchdog::Stop()
+{
+    bStopping = true;
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+void FStallWatchdog::BeginSlice(const FString& CommandType, const FString& RequestId, const TSharedPtr<FJsonObject>& Params)
+{
+    check(IsInGameThread());
+
+    const double Now = FPlatformTime::Seconds();
+    RollFrame(GFrameCounter, Now);
+
+    ActiveParams = Params;
+    const int64 UsedBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+
+    bool bWakeSampler = false;
+    {
+        FScopeLock Lock(&Mutex);
+        ActiveCommand = CommandType;
+        ActiveRequestId = RequestId;
+        ActiveStartSeconds = Now;
+        ++ActiveSliceId;
+        bActiveSampled = false;
+        ActiveCallstack.Reset();
+        ActiveStartUsedBytes = UsedBytes;
+        ActivePeakUsedBytes = UsedBytes;
+        bWakeSampler = MemorySampleSeconds > 0.0;
+    }
+
+    // The idle sampler sleeps up to MaxSamplerWaitMs; memory samples should start with the slice.
+    if (bWakeSampler && WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+FStallWatchdog::FSliceStats FStallWatchdog::EndSlice()
+{
+    check(IsInGameThread());
+
+    const double Now = FPlatformTime::Seconds();
+    const int64 UsedBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+    FSliceStats Stats;
+    double ThresholdSeconds = 0.0;
+    FString Callstack;
+    {
+        FScopeLock Lock(&Mutex);
+        if (ActiveCommand.IsEmpty())
+        {
+            return Stats;
+        }
+        Stats.DurationSeconds = Now - ActiveStartSeconds;
+        Stats.StartUsedBytes = ActiveStartUsedBytes;
+        Stats.PeakUsedBytes = FMath::Max(ActivePeakUsedBytes, UsedBytes);
+        Stats.EndUsedBytes = UsedBytes;
+        ThresholdSeconds = SlowThresholdSeconds;
+        Callstack = MoveTemp(ActiveCallstack);
+    }
+
+    const double DurationSeconds = Stats.DurationSeconds;
+    AccumulatedFrameSeconds += DurationSeconds;
+    FMetricsRegistry::AddGameThreadSeconds(DurationSeconds);
+
+    if (ThresholdSeconds > 0.0 && DurationSeconds >= ThresholdSeconds)
+    {
+        WriteSlowEntry(DurationSeconds * 1000.0, Callstack);
+    }
+
+    ActiveParams.Reset();
+    FScopeLock Lock(&Mutex);
+    ActiveCommand.Reset();
+    ActiveRequestId.Reset();
+    return Stats;
+}
+
+int32 FStallWatchdog::GetFramesOverBudget() const
+{
+    const double Cutoff = FPlatformTime::Seconds() - OverBudgetWindowSeconds;
+    FScopeLock Lock(&Mutex);
+    int32 Expired = 0;
+    while (Expired < OverBudgetFrameTimes.Num() && OverBudgetFrameTimes[Expired] < Cutoff)
+    {
+        ++Expired;
+    }
+    return OverBudgetFrameTimes.Num() - Expired;
+}
+
+void FStallWatchdog::RollFrame(uint64 FrameNumber, double NowSeconds)
+{
+    if (FrameNumber == AccumulatingFrame)
+    {
+        return;
+    }
+
+    {
+        FScopeLock Lock(&Mutex);
+        if (FrameBudgetSeconds > 0.0 && AccumulatedFrameSeconds > FrameBudgetSeconds)
+        {
+            OverBudgetFrameTimes.Add(NowSeconds);
+        }
+
+        const double Cutoff = NowSeconds - OverBudgetWindowSeconds;
+        int32 Expired = 0;
+        while (Expired < OverBudgetFrameTimes.Num() && OverBudgetFrameTimes[Expired] < Cutoff)
+        {
+            ++Expired;
+        }
+        if (Expired > 0)
+        {
+            OverBudgetFrameTimes.RemoveAt(0, Expired);
+        }
+    }
+
+    AccumulatingFrame = FrameNumber;
+    AccumulatedFrameSeconds = 0.0;
+}
+
+void FStallWatchdog::WriteSlowEntry(double DurationMs, const FString& Callstack)
+{
+    FString CommandType;
+    FString RequestId;
+    double ThresholdMs = 0.0;
+    {
+        FScopeLock Lock(&Mutex);
+        CommandType = ActiveCommand;
+        RequestId = ActiveRequestId;
+        ThresholdMs = SlowThresholdSeconds * 1000.0;
+    }
+
+    // A digest rather than the params themselves: they can be large (file lists) or sensitive.
+    const FString ParamsKey = UnrealMCP::Protocol::FResponseCache::MakeKey(CommandType, ActiveParams);
+    const FString ParamsDigest = FString::Printf(TEXT("%08x"), FCrc::StrCrc32(*ParamsKey));
+    const int32 FramesOverBudget = GetFramesOverBudget();
+
+    UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: %s blocked the game thread for %.1f ms (requestId=%s, params=%s)"), *CommandType, DurationMs, *RequestId, *ParamsDigest);
+    TRACE_BOOKMARK(TEXT("MCP slow command: %s (%.0f ms)"), *CommandType, DurationMs);
+
+    TSharedPtr<FJsonObject> Fields = MakeShared<FJsonObject>();
+    Fields->SetStringField(TEXT("command"), CommandType);
+    Fields->SetNumberField(TEXT("durMs"), DurationMs);
+    Fields->SetNumberField(TEXT("thresholdMs"), ThresholdMs);
+    Fields->SetStringField(TEXT("paramsDigest"), ParamsDigest);
+    Fields->SetNumberField(TEXT("framesOverBudget"), FramesOverBudget);
+    if (!Callstack.IsEmpty())
+    {
+        Fields->SetStringField(TEXT("callstack"), Callstack);
+    }
+
+    FLogEvent Event;
+    Event.Level = TEXT("warn");
+    Event.Category = TEXT("slow_command");
+    Event.RequestId = RequestId;
+    Event.Message = FString::Printf(TEXT("%s took %.1f ms on the game thread"), *CommandType, DurationMs);
+    Event.Fields = Fields;
+    FJsonLogger::Slow(Event);
+}
+
+uint32 FStallWatchdog::Run()
+{
+    TArray<ANSICHAR> Buffer;
+
+    while (!bStopping)
+    {
+        double WaitSeconds = MaxSamplerWaitMs / 1000.0;
+        bool bSample = false;
+        uint64 SliceId = 0;
+        bool bSampleMemory = false;
+        uint64 MemorySliceId = 0;
+        {
+            FScopeLock Lock(&Mutex);
+            bSampleMemory = !ActiveCommand.IsEmpty() && MemorySampleSeconds > 0.0;
+            MemorySliceId = ActiveSliceId;
+        }
+        if (bSampleMemory)
+        {
+            // Read outside the lock; the game thread takes it at every slice boundary.
+            const int64 UsedBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+            FScopeLock Lock(&Mutex);
+            if (!ActiveCommand.IsEmpty() && ActiveSliceId == MemorySliceId)
+            {
+                ActivePeakUsedBytes = FMath::Max(ActivePeakUsedBytes, UsedBytes);
+            }
+            WaitSeconds = FMath::Min(WaitSeconds, MemorySampleSeconds);
+        }
+        {
+            FScopeLock Lock(&Mutex);
+            if (!ActiveCommand.IsEmpty() && !bActiveSampled && SlowThresholdSeconds > 0.0)
+            {
+                const double Elapsed = FPlatformTime::Seconds() - ActiveStartSeconds;
+                if (Elapsed >= SlowThresholdSeconds)
+                {
+                    bSample = true;
+                    bActiveSampled = true;
+                    SliceId = ActiveSliceId;
+                }
+                else
+                {
+                    WaitSeconds = FMath::Min(WaitSeconds, SlowThresholdSeconds - Elapsed);
+                }
+            }
+        }
+
+        if (bSample)
+        {
+            // One stack per slow slice, taken while the game thread is still inside it.
+            Buffer.SetNumZeroed(CallstackBufferSize);
+            FPlatformStackWalk::ThreadStackWalkAndDump(Buffer.GetData(), Buffer.Num(), 0, GGameThreadId);
+            const FString Callstack = ANSI_TO_TCHAR(Buffer.GetData());
+
+            FScopeLock Lock(&Mutex);
+            if (!ActiveCommand.IsEmpty() && ActiveSliceId == SliceId)
+            {
+                ActiveCallstack = Callstack;
+            }
+            continue;
+        }
+
+        WakeEvent->Wait(FMath::Max(1u, static_cast<uint32>(WaitSeconds * 1000.0)));
+    }
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "Observability/TrafficRecorder.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryWriter.h"
+#include "UnrealMCPLog.h"
+
+namespace
+{
+    const ANSICHAR TraceMagic[8] = { 'M', 'C', 'P', 'T', 'R', 'A', 'C', 'E' };
+
+    /** Buffered bytes that force a write even before the next second is up. */
+    constexpr int32 FlushThresholdBytes = 64 * 1024;
+    constexpr double FlushIntervalSeconds = 1.0;
+
+    FString ToCondensedJson(const TSharedRef<FJsonObject>& Object)
+    {
+        FString Json;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+        FJsonSerializer::Serialize(Object, JsonWriter);
+        return Json;
+    }
+}
+
+TSharedPtr<FTrafficRecorder, ESPMode::ThreadSafe> FTrafficRecorder::Open(const FString& Path, FString& OutError)
+{
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+    if (!Writer)
+    {
+        OutError = FString::Printf(TEXT("Cannot create traffic capture %s"), *Path);
+        return nullptr;
+    }
+
+    Writer->SetByteSwapping(!PLATFORM_LITTLE_ENDIAN);
+    Writer->Serialize(const_cast<ANSICHAR*>(TraceMagic), sizeof(TraceMagic));
+    uint16 Version = FormatVersion;
+    uint16 Reserved = 0;
+    const FDateTime Now = FDateTime::UtcNow();
+    int64 StartUnixMs = Now.ToUnixTimestamp() * 1000 + Now.GetMillisecond();
+    *Writer << Version << Reserved << StartUnixMs;
+    Writer->Flush();
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("FTrafficRecorder: Capturing protocol traffic to %s"), *Path);
+    return TSharedPtr<FTrafficRecorder, ESPMode::ThreadSafe>(new FTrafficRecorder(Path, MoveTemp(Writer)));
+}
+
+FTrafficRecorder::FTrafficRecorder(const FString& InPath, TUniquePtr<FArchive> InWriter)
+    : Path(InPath)
+    , StartSeconds(FPlatformTime::Seconds())
+    , LastFlushSeconds(StartSeconds)
+    , Writer(MoveTemp(InWriter))
+{
+}
+
+FTrafficRecorder::~FTrafficRecorder()
+{
+    FScopeLock Lock(&Mutex);
+    FlushLocked();
+    if (Writer)
+    {
+        Writer->Close();
+        Writer.Reset();
+    }
+}
+
+void FTrafficRecorder::RecordInbound(int32 ConnectionId, const TSharedRef<FJsonObject>& Message)
+{
+    FString Type;
+    Message->TryGetStringField(TEXT("type"), Type);
+    if (Type == TEXT("ping") || Type == TEXT("pong"))
+    {
+        return;
+    }
+
+    Append(ERecordKind::Inbound, ConnectionId, ToCondensedJson(Message));
+}
+
+void FTrafficRecorder::RecordResponse(int32 ConnectionId, const FString& RequestId, const FString& Tool, double DurationMs, bool bOk)
+{
+    TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+    Summary->SetStringField(TEXT("requestId"), RequestId);
+    Summary->SetStringField(TEXT("tool"), Tool);
+    Summary->SetNumberField(TEXT("durMs"), DurationMs);
+    Summary->SetBoolField(TEXT("ok"), bOk);
+    Append(ERecordKind::Response, ConnectionId, ToCondensedJson(Summary));
+}
+
+void FTrafficRecorder::Flush()
+{
+    FScopeLock Lock(&Mutex);
+    FlushLocked();
+}
+
+void FTrafficRecorder::Append(ERecordKind Kind, int32 ConnectionId, const FString& Json)
+{
+    const FTCHARToUTF8 Utf8(*Json);
+    const double Now = FPlatformTime::Seconds();
+
+    FScopeLock Lock(&Mutex);
+    FMemoryWriter Record(Pending, /*bIsPersistent=*/false, /*bSetOffset=*/true);
+    Record.SetByteSwapping(!PLATFORM_LITTLE_ENDIAN);
+    uint8 KindByte = static_cast<uint8>(Kind);
+    uint32 Connection = static_cast<uint32>(ConnectionId);
+    uint64 OffsetMicros = static_cast<uint64>(FMath::Max(Now - StartSeconds, 0.0) * 1000000.0);
+    uint32 Length = static_cast<uint32>(Utf8.Length());
+    Record << KindByte << Connection << OffsetMicros << Length;
+    Record.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Length);
+
+    if (Pending.Num() >= FlushThresholdBytes || Now - LastFlushSeconds >= FlushIntervalSeconds)
+    {
+        LastFlushSeconds = Now;
+        FlushLocked();
+    }
+}
+
+void FTrafficRecorder::FlushLocked()
+{
+    if (!Writer || Pending.Num() == 0)
+    {
+        return;
+    }
+
+    Writer->Serialize(Pending.GetData(), Pending.Num());
+    Writer->Flush();
+    Pending.Reset();
+}
@@ -6,19 +6,26 @@
 #include "Engine/World.h"
 #include "UObject/Package.h"
 
+#include "Misc/Base64.h"
 #include "Misc/PackageName.h"
 #include "Misc/Paths.h"
 #include "Misc/ScopeLock.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "Settings/UnrealMCPRuntimeConfig.h"
 #include "SourceControlService.h"
 
+#include <atomic>
+
 namespace
 {
         FString SerializeJsonValue(const TSharedPtr<FJsonValue>& Value);
         FString SerializeArrayField(const TSharedPtr<FJsonObject>& Object, const FString& FieldName);
+        FString SerializeArray(const TArray<TSharedPtr<FJsonValue>>& Array);
         FString SerializeObjectField(const TSharedPtr<FJsonObject>& Object, const FString& FieldName);
+        FString SerializeObject(const TSharedRef<FJsonObject>& Object);
 
+        /** Guards the remote inputs below and policy publication; gate checks never take it. */
         FCriticalSection GRemoteStateMutex;
         bool GRemoteAllowWrite = false;
         bool GRemoteDryRun = true;
@@ -51,27 +58,123 @@ namespace
                 }
         }
 
-        TArray<FString> ReadRemoteAllowedPaths()
+        /**
+         * One allow or deny list, compiled once per policy: plain names go into a hash set (FString
+         * hashes and compares case-insensitively), "prefix*" patterns into a prefix list and any
+         * other pattern with * or ? is matched with MatchesWildcard.
+         */
+        struct FToolMatcher
         {
-                FScopeLock Lock(&GRemoteStateMutex);
-                return GRemoteAllowedPaths;
-        }
+                TSet<FString> Exact;
+                TArray<FString> Prefixes;
+                TArray<FString> Wildcards;
 
-        TArray<FString> ReadRemoteAllowedTools()
-        {
-                FScopeLock Lock(&GRemoteStateMutex);
-                return GRemoteAllowedTools;
-        }
+                void Add(const FString& Pattern)
+                {
+                        const FString Normalized = Pattern.TrimStartAndEnd();
+                        if (Normalized.IsEmpty())
+                        {
+                                return;
+                        }
 
-        TArray<FString> ReadRemoteDeniedTools()
-        {
-                FScopeLock Lock(&GRemoteStateMutex);
-                return GRemoteDeniedTools;
-        }
+                        int32 StarIndex = INDEX_NONE;
+                        const bool bHasStar = Normalized.FindChar(TEXT('*'), StarIndex);
+                        const bool bHasQuestion = Normalized.Contains(TEXT("?"));
+                        if (!bHasStar && !bHasQuestion)
+                        {
+                                Exact.Add(Normalized);
+                        }
+                        else if (!bHasQuestion && StarIndex == Normalized.Len() - 1)
+                        {
+                                Prefixes.AddUnique(Normalized.LeftChop(1));
+                        }
+                        else
+                        {
+                                Wildcards.AddUnique(Normalized);
+                        }
+                }
+
+                bool IsEmpty() const
+                {
+                        return Exact.Num() == 0 && Prefixes.Num() == 0 && Wildcards.Num() == 0;
+                }
+
+                bool Matches(const FString& Command) const
+                {
+                        if (Exact.Contains(Command))
+                        {
+                                return true;
+                        }
+                        for (const FString& Prefix : Prefixes)
+                        {
+                                if (Command.StartsWith(Prefix, ESearchCase::IgnoreCase))
+                                {
+                                        return true;
+                                }
+                        }
+                        for (const FString& Wildcard : Wildcards)
+                        {
+                                if (Command.MatchesWildcard(Wildcard, ESearchCase::IgnoreCase))
+                                {
+                                        return true;
+                                }
+                        }
+                        return false;
+                }
+
+                bool operator==(const FToolMatcher& Other) const
+                {
+                        return Exact.Num() == Other.Exact.Num() && Exact.Includes(Other.Exact) && Prefixes == Other.Prefixes && Wildcards == Other.Wildcards;
+                }
+        };
+
+        /**
+         * Settings and remote enforcement folded into one immutable snapshot, so a gate check is a
+         * few lookups with no lock, copy or allocation.
+         */
+        struct FWriteGatePolicy
+        {
+                bool bWriteAllowed = false;
+                bool bDryRun = true;
+                FToolMatcher LocalDenied;
+                FToolMatcher LocalAllowed;
+                /** Set when AllowedTools has entries, even blank ones (which then allow nothing). */
+                bool bLocalAllowListActive = false;
+                FToolMatcher RemoteDenied;
+                FToolMatcher RemoteAllowed;
+                /** Intersection of the local and remote content roots; empty allows no content path. */
+                TArray<FString> AllowedRoots;
+
+                bool operator==(const FWriteGatePolicy& Other) const
+                {
+                        return bWriteAllowed == Other.bWriteAllowed
+                                && bDryRun == Other.bDryRun
+                                && LocalDenied == Other.LocalDenied
+                                && LocalAllowed == Other.LocalAllowed
+                                && bLocalAllowListActive == Other.bLocalAllowListActive
+                                && RemoteDenied == Other.RemoteDenied
+                                && RemoteAllowed == Other.RemoteAllowed
+                                && AllowedRoots == Other.AllowedRoots;
+                }
+        };
+
+        std::atomic<const FWriteGatePolicy*> GPolicy{nullptr};
+        /**
+         * Every policy ever published, freed at shutdown: readers use the raw pointer without
+         * reference counting. Identical republishes are skipped, so this only grows when the
+         * settings or the enforcement actually change.
+         */
+        TArray<TUniquePtr<FWriteGatePolicy>> GPublishedPolicies;
 
-        bool MatchesTool(const FString& Pattern, const FString& Command)
+        const FWriteGatePolicy& GetPolicy()
         {
-                return Pattern.Equals(Command, ESearchCase::IgnoreCase);
+                const FWriteGatePolicy* Policy = GPolicy.load(std::memory_order_acquire);
+                if (!Policy)
+                {
+                        FWriteGate::RefreshPolicy();
+                        Policy = GPolicy.load(std::memory_order_acquire);
+                }
+                return *Policy;
         }
 
         FString SerializeJsonValue(const TSharedPtr<FJsonValue>& Value)
@@ -129,10 +232,15 @@ namespace
                         return FString();
                 }
 
+                return SerializeArray(*Array);
+        }
+
+        FString SerializeArray(const TArray<TSharedPtr<FJsonValue>>& Array)
+        {
                 FString Serialized;
                 TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Serialized);
                 Writer->WriteArrayStart();
-                for (const TSharedPtr<FJsonValue>& Value : *Array)
+                for (const TSharedPtr<FJsonValue>& Value : Array)
                 {
                         if (!Value.IsValid())
                         {
@@ -174,11 +282,74 @@ namespace
                         return FString();
                 }
 
+                return SerializeObject(ChildObject->ToSharedRef());
+        }
+
+        FString SerializeObject(const TSharedRef<FJsonObject>& Object)
+        {
                 FString Serialized;
                 TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Serialized);
-                FJsonSerializer::Serialize(ChildObject->ToSharedRef(), Writer, /*bCloseWriter=*/true);
+                FJsonSerializer::Serialize(Object, Writer, /*bCloseWriter=*/true);
                 return Serialized;
         }
+
+        /** Package of the editor world's persistent or current level, or empty without an editor world. */
+        FString GetEditorLevelPackageName(EMutationLevelPath Level)
+        {
+#if WITH_EDITOR
+                if (GEditor)
+                {
+                        if (UWorld* World = GEditor->GetEditorWorldContext().World())
+                        {
+                                ULevel* Target = Level == EMutationLevelPath::Current ? World->GetCurrentLevel() : World->PersistentLevel.Get();
+                                if (Target)
+                                {
+                                        if (UPackage* Package = Target->GetOutermost())
+                                        {
+                                                return Package->GetName();
+                                        }
+                                }
+                        }
+                }
+#endif
+                return FString();
+        }
+
+        FMutationArgSpec MakeArg(const TCHAR* Name, const TCHAR* Key, EMutationArg Kind = EMutationArg::String, const TCHAR* Default = TEXT(""))
+        {
+                FMutationArgSpec Spec;
+                Spec.Name = Name;
+                Spec.Key = Key;
+                Spec.Kind = Kind;
+                Spec.Default = Default;
+                return Spec;
+        }
+
+        FMutationActionSpec MakeAction(const TCHAR* Op, TArray<FMutationArgSpec> Args = TArray<FMutationArgSpec>())
+        {
+                FMutationActionSpec Spec;
+                Spec.Op = Op;
+                Spec.Args = MoveTemp(Args);
+                return Spec;
+        }
+
+        /** One action per element of ArrayKey, recorded as ElementName. */
+        FMutationActionSpec MakeForEach(const TCHAR* Op, const TCHAR* ArrayKey, const TCHAR* ElementName, EMutationArg ElementKind, TArray<FMutationArgSpec> Args = TArray<FMutationArgSpec>())
+        {
+                FMutationActionSpec Spec = MakeAction(Op, MoveTemp(Args));
+                Spec.ForEach = ArrayKey;
+                Spec.Element = MakeArg(ElementName, TEXT(""), ElementKind);
+                return Spec;
+        }
+
+        FMutationPathKey MakePathKey(const TCHAR* Key, bool bPackage = false, const TCHAR* Field = TEXT(""))
+        {
+                FMutationPathKey PathKey;
+                PathKey.Key = Key;
+                PathKey.Field = Field;
+                PathKey.bPackage = bPackage;
+                return PathKey;
+        }
 }
 
 const UUnrealMCPSettings* FWriteGate::GetSettings()
@@ -194,9 +365,13 @@ bool FWriteGate::IsMutationCommand(const FString& CommandType, const TSharedPtr<
                 TEXT("delete_actor"),
                 TEXT("set_actor_transform"),
                 TEXT("actor.spawn"),
+                TEXT("actor.spawn_batch"),
                 TEXT("actor.destroy"),
                 TEXT("actor.attach"),
                 TEXT("actor.transform"),
+                TEXT("actor.transform_batch"),
+                TEXT("foliage.add_instances"),
+                TEXT("ism.add_instances"),
                 TEXT("actor.tag"),
                 TEXT("set_actor_property"),
                 TEXT("spawn_blueprint_actor"),
@@ -205,6 +380,7 @@ bool FWriteGate::IsMutationCommand(const FString& CommandType, const TSharedPtr<
                 TEXT("set_component_property"),
                 TEXT("set_physics_properties"),
                 TEXT("compile_blueprint"),
+                TEXT("blueprint.compile_many"),
                 TEXT("set_blueprint_property"),
                 TEXT("set_static_mesh_properties"),
                 TEXT("set_pawn_properties"),
@@ -216,12 +392,14 @@ bool FWriteGate::IsMutationCommand(const FString& CommandType, const TSharedPtr<
                 TEXT("add_blueprint_function_node"),
                 TEXT("add_blueprint_get_component_node"),
                 TEXT("add_blueprint_variable"),
+                TEXT("blueprint.graph_patch"),
                 TEXT("create_input_mapping"),
                 TEXT("create_umg_widget_blueprint"),
                 TEXT("add_text_block_to_widget"),
                 TEXT("add_button_to_widget"),
                 TEXT("bind_widget_event"),
                 TEXT("set_text_block_binding"),
+                TEXT("umg.build_tree"),
                 TEXT("add_widget_to_viewport"),
                 TEXT("sc.status"),
                 TEXT("sc.checkout"),
@@ -229,6 +407,7 @@ bool FWriteGate::IsMutationCommand(const FString& CommandType, const TSharedPtr<
                 TEXT("sc.revert"),
                 TEXT("sc.submit"),
                 TEXT("asset.batch_import"),
+                TEXT("datatable.import_rows"),
                 TEXT("mi.create"),
                 TEXT("mi.set_params"),
                 TEXT("mi.batch_apply"),
@@ -237,6 +416,7 @@ bool FWriteGate::IsMutationCommand(const FString& CommandType, const TSharedPtr<
                 TEXT("sequence.bind_actors"),
                 TEXT("sequence.unbind"),
                 TEXT("sequence.add_tracks"),
+                TEXT("sequence.evaluate_range"),
                 TEXT("niagara.spawn_component"),
                 TEXT("niagara.set_user_params"),
                 TEXT("niagara.activate"),
@@ -246,7 +426,9 @@ bool FWriteGate::IsMutationCommand(const FString& CommandType, const TSharedPtr<
                 TEXT("level.save_open"),
                 TEXT("level.load"),
                 TEXT("level.unload"),
-                TEXT("level.stream_sublevel")
+                TEXT("level.stream_sublevel"),
+                TEXT("level.load_region"),
+                TEXT("level.unload_region")
         };
 
         if (MutatingCommands.Contains(CommandType))
@@ -271,78 +453,17 @@ bool FWriteGate::IsMutationCommand(const FString& CommandType, const TSharedPtr<
 
 bool FWriteGate::IsWriteAllowed()
 {
-        const UUnrealMCPSettings* Settings = GetSettings();
-        if (!Settings)
-        {
-                return false;
-        }
-
-        bool bRemoteAllow = false;
-        {
-                FScopeLock Lock(&GRemoteStateMutex);
-                bRemoteAllow = GRemoteAllowWrite;
-        }
-
-        return Settings->AllowWrite && bRemoteAllow;
+        return GetPolicy().bWriteAllowed;
 }
 
 bool FWriteGate::ShouldDryRun()
 {
-        const UUnrealMCPSettings* Settings = GetSettings();
-        if (!Settings)
-        {
-                return true;
-        }
-
-        bool bRemoteDryRun = true;
-        {
-                FScopeLock Lock(&GRemoteStateMutex);
-                bRemoteDryRun = GRemoteDryRun;
-        }
-
-        return Settings->DryRun || bRemoteDryRun;
+        return GetPolicy().bDryRun;
 }
 
 TArray<FString> FWriteGate::GetEffectiveAllowedRoots()
 {
-        const UUnrealMCPSettings* Settings = GetSettings();
-        TArray<FString> LocalRoots;
-        if (Settings)
-        {
-                for (const FDirectoryPath& DirectoryPath : Settings->AllowedContentRoots)
-                {
-                        const FString Normalized = NormalizeContentPath(DirectoryPath.Path);
-                        if (!Normalized.IsEmpty())
-                        {
-                                LocalRoots.AddUnique(Normalized);
-                        }
-                }
-        }
-
-        const TArray<FString> RemoteRoots = ReadRemoteAllowedPaths();
-
-        if (LocalRoots.Num() == 0 || RemoteRoots.Num() == 0)
-        {
-                return {};
-        }
-
-        TArray<FString> Intersection;
-        for (const FString& LocalRoot : LocalRoots)
-        {
-                for (const FString& RemoteRoot : RemoteRoots)
-                {
-                        if (LocalRoot.StartsWith(RemoteRoot))
-                        {
-                                Intersection.AddUnique(LocalRoot);
-                        }
-                        else if (RemoteRoot.StartsWith(LocalRoot))
-                        {
-                                Intersection.AddUnique(RemoteRoot);
-                        }
-                }
-        }
-
-        return Intersection;
+        return GetPolicy().AllowedRoots;
 }
 
 bool FWriteGate::IsPathAllowed(const FString& ContentPath, FString& OutReason)
@@ -352,14 +473,17 @@ bool FWriteGate::IsPathAllowed(const FString& ContentPath, FString& OutReason)
                 return true;
         }
 
-        const FString Normalized = NormalizeContentPath(ContentPath);
+        // Resolved paths are normally already absolute and trimmed; only others pay for a copy.
+        const bool bNeedsNormalizing = !ContentPath.StartsWith(TEXT("/")) || FChar::IsWhitespace(ContentPath[ContentPath.Len() - 1]);
+        const FString NormalizedCopy = bNeedsNormalizing ? NormalizeContentPath(ContentPath) : FString();
+        const FString& Normalized = bNeedsNormalizing ? NormalizedCopy : ContentPath;
         if (Normalized.IsEmpty())
         {
                 OutReason = TEXT("Invalid content path");
                 return false;
         }
 
-        const TArray<FString> AllowedRoots = GetEffectiveAllowedRoots();
+        const TArray<FString>& AllowedRoots = GetPolicy().AllowedRoots;
         if (AllowedRoots.Num() == 0)
         {
                 OutReason = TEXT("No allowed content roots configured");
@@ -399,76 +523,49 @@ bool FWriteGate::CanMutate(const FString& CommandType, const FString& ContentPat
         return true;
 }
 
-bool FWriteGate::IsToolAllowed(const FString& CommandType, FString& OutReason)
+bool FWriteGate::CanSkipUndo(FString& OutReason)
 {
-        const UUnrealMCPSettings* Settings = GetSettings();
-        if (Settings)
+        const FUnrealMCPRuntimeConfig& Config = FUnrealMCPRuntimeConfig::Get();
+        if (!Config.bAllowUndoFreeMutations)
         {
-                for (const FString& DeniedTool : Settings->DeniedTools)
-                {
-                        FString Normalized = DeniedTool;
-                        Normalized.TrimStartAndEndInline();
-                        if (!Normalized.IsEmpty() && MatchesTool(Normalized, CommandType))
-                        {
-                                OutReason = TEXT("Tool denied by project settings");
-                                return false;
-                        }
-                }
+                OutReason = TEXT("Mutations without undo are disabled (bAllowUndoFreeMutations=false)");
+                return false;
+        }
+        if (!Config.bRequireCheckout)
+        {
+                OutReason = TEXT("Mutations without undo need RequireCheckout, so source control can revert them");
+                return false;
+        }
 
-                if (Settings->AllowedTools.Num() > 0)
-                {
-                        bool bAllowed = false;
-                        for (const FString& AllowedTool : Settings->AllowedTools)
-                        {
-                                FString Normalized = AllowedTool;
-                                Normalized.TrimStartAndEndInline();
-                                if (!Normalized.IsEmpty() && MatchesTool(Normalized, CommandType))
-                                {
-                                        bAllowed = true;
-                                        break;
-                                }
-                        }
+        OutReason.Reset();
+        return true;
+}
 
-                        if (!bAllowed)
-                        {
-                                OutReason = TEXT("Tool not present in AllowedTools");
-                                return false;
-                        }
-                }
+bool FWriteGate::IsToolAllowed(const FString& CommandType, FString& OutReason)
+{
+        const FWriteGatePolicy& Policy = GetPolicy();
+        if (Policy.LocalDenied.Matches(CommandType))
+        {
+                OutReason = TEXT("Tool denied by project settings");
+                return false;
         }
 
-        const TArray<FString> RemoteDenied = ReadRemoteDeniedTools();
-        for (const FString& DeniedTool : RemoteDenied)
+        if (Policy.bLocalAllowListActive && !Policy.LocalAllowed.Matches(CommandType))
         {
-                FString Normalized = DeniedTool;
-                Normalized.TrimStartAndEndInline();
-                if (!Normalized.IsEmpty() && MatchesTool(Normalized, CommandType))
-                {
-                        OutReason = TEXT("Tool denied by remote enforcement");
-                        return false;
-                }
+                OutReason = TEXT("Tool not present in AllowedTools");
+                return false;
         }
 
-        const TArray<FString> RemoteAllowed = ReadRemoteAllowedTools();
-        if (RemoteAllowed.Num() > 0)
+        if (Policy.RemoteDenied.Matches(CommandType))
         {
-                bool bAllowed = false;
-                for (const FString& AllowedTool : RemoteAllowed)
-                {
-                        FString Normalized = AllowedTool;
-                        Normalized.TrimStartAndEndInline();
-                        if (!Normalized.IsEmpty() && MatchesTool(Normalized, CommandType))
-                        {
-                                bAllowed = true;
-                                break;
-                        }
-                }
+                OutReason = TEXT("Tool denied by remote enforcement");
+                return false;
+        }
 
-                if (!bAllowed)
-                {
-                        OutReason = TEXT("Tool not permitted by remote enforcement");
-                        return false;
-                }
+        if (!Policy.RemoteAllowed.IsEmpty() && !Policy.RemoteAllowed.Matches(CommandType))
+        {
+                OutReason = TEXT("Tool not permitted by remote enforcement");
+                return false;
         }
 
         OutReason.Reset();
@@ -476,1684 +573,1500 @@ bool FWriteGate::IsToolAllowed(const FString& CommandType, FString& OutReason)
 }
 
 FMutationPlan FWriteGate::BuildPlan(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+        return BuildPlan(CommandType, Params, FindMutationSchema(CommandType));
+}
+
+FMutationPlan FWriteGate::BuildPlan(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FMutationSchema* Schema)
 {
         FMutationPlan Plan;
         Plan.bDryRun = ShouldDryRun();
 
-        bool bAddedSpecificActions = false;
-
-        if (CommandType == TEXT("camera.bookmark") && Params.IsValid())
-        {
-                FString Op;
-                if (Params->TryGetStringField(TEXT("op"), Op) && Op.Equals(TEXT("set"), ESearchCase::IgnoreCase))
-                {
-                        if (Params->HasTypedField<EJson::Boolean>(TEXT("persist")) && Params->GetBoolField(TEXT("persist")))
-                        {
-                                FMutationAction Action;
-                                Action.Op = TEXT("bookmark_persist");
-
-                                if (Params->HasTypedField<EJson::Number>(TEXT("index")))
-                                {
-                                        Action.Args.Add(TEXT("index"), FString::FromInt(static_cast<int32>(Params->GetNumberField(TEXT("index")))));
-                                }
-                                else if (Params->HasTypedField<EJson::String>(TEXT("index")))
-                                {
-                                        Action.Args.Add(TEXT("index"), Params->GetStringField(TEXT("index")));
-                                }
-                                else
-                                {
-                                        Action.Args.Add(TEXT("index"), TEXT("0"));
-                                }
-
-                                Plan.Actions.Add(Action);
-                                return Plan;
-                        }
-                }
-        }
-        else if (CommandType == TEXT("asset.create_folder") && Params.IsValid())
-        {
-                FMutationAction Action;
-                Action.Op = TEXT("mkdir");
-
-                FString Path;
-                if (Params->TryGetStringField(TEXT("path"), Path))
-                {
-                        Action.Args.Add(TEXT("path"), NormalizeContentPath(Path));
-                }
-
-                Plan.Actions.Add(Action);
-                return Plan;
-        }
-        else if (CommandType == TEXT("asset.rename") && Params.IsValid())
+        if (Schema && Params.IsValid())
         {
-                FMutationAction Action;
-                Action.Op = TEXT("rename");
-
-                FString FromObjectPath;
-                if (Params->TryGetStringField(TEXT("fromObjectPath"), FromObjectPath))
-                {
-                        const FString FromPackage = FPackageName::ObjectPathToPackageName(NormalizeContentPath(FromObjectPath));
-                        Action.Args.Add(TEXT("from"), FromPackage);
-                }
-
-                FString ToPackagePath;
-                if (Params->TryGetStringField(TEXT("toPackagePath"), ToPackagePath))
+                if (Schema->BuildActions)
                 {
-                        Action.Args.Add(TEXT("to"), NormalizeContentPath(ToPackagePath));
+                        Schema->BuildActions(Params, Plan.Actions);
                 }
 
-                Plan.Actions.Add(Action);
-                return Plan;
-        }
-        else if (CommandType == TEXT("asset.delete") && Params.IsValid())
-        {
-                const TArray<TSharedPtr<FJsonValue>>* ObjectPaths = nullptr;
-                if (Params->TryGetArrayField(TEXT("objectPaths"), ObjectPaths))
+                for (const FMutationActionSpec& Spec : Schema->Actions)
                 {
-                        for (const TSharedPtr<FJsonValue>& Value : *ObjectPaths)
+                        FMutationAction Template;
+                        Template.Op = Spec.Op.IsEmpty() ? CommandType : Spec.Op;
+                        for (const FMutationArgSpec& ArgSpec : Spec.Args)
                         {
-                                if (Value->Type == EJson::String)
+                                FString Value;
+                                if (ReadMutationArg(ArgSpec, Params->TryGetField(ArgSpec.Key), Value))
                                 {
-                                        FMutationAction Action;
-                                        Action.Op = TEXT("delete");
-                                        Action.Args.Add(TEXT("objectPath"), NormalizeContentPath(Value->AsString()));
-                                        Plan.Actions.Add(Action);
+                                        Template.Args.Add(ArgSpec.Name, MoveTemp(Value));
                                 }
                         }
 
-                        if (Plan.Actions.Num() > 0)
+                        if (Spec.ForEach.IsEmpty())
                         {
-                                return Plan;
+                                Plan.Actions.Add(MoveTemp(Template));
+                                continue;
                         }
-                }
-        }
-        else if (CommandType == TEXT("level.save_open") && Params.IsValid())
-        {
-                bool bModifiedOnly = true;
-                Params->TryGetBoolField(TEXT("modifiedOnly"), bModifiedOnly);
 
-                const TArray<TSharedPtr<FJsonValue>>* Maps = nullptr;
-                bool bAddedExplicit = false;
-                if (Params->TryGetArrayField(TEXT("maps"), Maps) && Maps)
-                {
-                        for (const TSharedPtr<FJsonValue>& Value : *Maps)
+                        const TArray<TSharedPtr<FJsonValue>>* Elements = nullptr;
+                        if (!Params->TryGetArrayField(Spec.ForEach, Elements) || !Elements)
                         {
-                                if (Value.IsValid() && Value->Type == EJson::String)
+                                continue;
+                        }
+                        for (const TSharedPtr<FJsonValue>& Element : *Elements)
+                        {
+                                FString Value;
+                                if (ReadMutationArg(Spec.Element, Element, Value))
                                 {
-                                        FString MapPath = NormalizeContentPath(Value->AsString());
-                                        if (MapPath.Contains(TEXT(".")))
-                                        {
-                                                MapPath = FPackageName::ObjectPathToPackageName(MapPath);
-                                        }
-
-                                        if (!MapPath.IsEmpty())
-                                        {
-                                                FMutationAction Action;
-                                                Action.Op = TEXT("save_map");
-                                                Action.Args.Add(TEXT("map"), MapPath);
-                                                Action.Args.Add(TEXT("modifiedOnly"), bModifiedOnly ? TEXT("true") : TEXT("false"));
-                                                Plan.Actions.Add(Action);
-                                                bAddedExplicit = true;
-                                        }
+                                        FMutationAction& Action = Plan.Actions.Add_GetRef(Template);
+                                        Action.Args.Add(Spec.Element.Name, MoveTemp(Value));
                                 }
                         }
                 }
-
-                if (!bAddedExplicit)
-                {
-                        FMutationAction Action;
-                        Action.Op = TEXT("save_map");
-                        Action.Args.Add(TEXT("scope"), TEXT("open"));
-                        Action.Args.Add(TEXT("modifiedOnly"), bModifiedOnly ? TEXT("true") : TEXT("false"));
-                        Plan.Actions.Add(Action);
-                }
-
-                bool bSaveExternal = true;
-                if (Params->TryGetBoolField(TEXT("saveExternalActors"), bSaveExternal) && bSaveExternal)
-                {
-                        FMutationAction ExtAction;
-                        ExtAction.Op = TEXT("save_external_actors");
-                        Plan.Actions.Add(ExtAction);
-                }
-
-                return Plan;
         }
-        else if (CommandType == TEXT("level.load") && Params.IsValid())
+
+        if (Plan.Actions.Num() == 0)
         {
-                FMutationAction OpenAction;
-                OpenAction.Op = TEXT("open_map");
+                FMutationAction Action;
+                Action.Op = CommandType;
 
-                FString MapPath;
-                if (Params->TryGetStringField(TEXT("mapPath"), MapPath))
+                if (Params.IsValid())
                 {
-                        FString Normalized = NormalizeContentPath(MapPath);
-                        if (Normalized.Contains(TEXT(".")))
+                        for (const auto& Pair : Params->Values)
                         {
-                                Normalized = FPackageName::ObjectPathToPackageName(Normalized);
+                                Action.Args.Add(Pair.Key, ValueToAuditString(Pair.Value));
                         }
-                        OpenAction.Args.Add(TEXT("path"), Normalized);
                 }
 
-                Plan.Actions.Add(OpenAction);
-
-                FString Mode(TEXT("none"));
-                if (Params->TryGetStringField(TEXT("loadSublevels"), Mode))
-                {
-                        Mode = Mode.ToLower();
-                }
+                Plan.Actions.Add(Action);
+        }
 
-                if (!Mode.IsEmpty() && Mode != TEXT("none"))
-                {
-                        FMutationAction SublevelsAction;
-                        SublevelsAction.Op = TEXT("load_sublevels");
-                        SublevelsAction.Args.Add(TEXT("mode"), Mode);
+        return Plan;
+}
 
-                        const TArray<TSharedPtr<FJsonValue>>* Sublevels = nullptr;
-                        if (Params->TryGetArrayField(TEXT("sublevels"), Sublevels) && Sublevels)
-                        {
-                                SublevelsAction.Args.Add(TEXT("count"), FString::FromInt(Sublevels->Num()));
-                        }
+TSharedPtr<FJsonObject> FWriteGate::BuildAuditJson(const FMutationPlan& Plan, bool bExecuted)
+{
+        TSharedPtr<FJsonObject> Audit = MakeShared<FJsonObject>();
+        Audit->SetBoolField(TEXT("mutation"), true);
+        Audit->SetBoolField(TEXT("dryRun"), Plan.bDryRun);
+        Audit->SetBoolField(TEXT("executed"), bExecuted);
+        Audit->SetStringField(TEXT("transaction"), GetTransactionName());
+        Audit->SetBoolField(TEXT("undoAvailable"), bExecuted);
 
-                        Plan.Actions.Add(SublevelsAction);
-                }
-
-                return Plan;
-        }
-        else if (CommandType == TEXT("level.unload") && Params.IsValid())
+        TArray<TSharedPtr<FJsonValue>> Actions;
+        for (const FMutationAction& Action : Plan.Actions)
         {
-                const TArray<TSharedPtr<FJsonValue>>* Sublevels = nullptr;
-                if (Params->TryGetArrayField(TEXT("sublevels"), Sublevels) && Sublevels)
-                {
-                        for (const TSharedPtr<FJsonValue>& Value : *Sublevels)
-                        {
-                                if (Value.IsValid() && Value->Type == EJson::String)
-                                {
-                                        FMutationAction Action;
-                                        Action.Op = TEXT("unload");
-                                        Action.Args.Add(TEXT("name"), Value->AsString());
-                                        Plan.Actions.Add(Action);
-                                }
-                        }
+                        TSharedPtr<FJsonObject> ActionObject = MakeShared<FJsonObject>();
+                        ActionObject->SetStringField(TEXT("op"), Action.Op);
 
-                        if (Plan.Actions.Num() > 0)
+                        TSharedPtr<FJsonObject> ArgsObject = MakeShared<FJsonObject>();
+                        for (const auto& ArgPair : Action.Args)
                         {
-                                return Plan;
+                                ArgsObject->SetStringField(ArgPair.Key, ArgPair.Value);
                         }
-                }
+                        ActionObject->SetObjectField(TEXT("args"), ArgsObject);
+                        Actions.Add(MakeShared<FJsonValueObject>(ActionObject));
         }
-        else if (CommandType == TEXT("level.stream_sublevel") && Params.IsValid())
-        {
-                FMutationAction Action;
-                Action.Op = TEXT("stream");
 
-                FString Target;
-                if (Params->TryGetStringField(TEXT("name"), Target))
-                {
-                        Action.Args.Add(TEXT("target"), Target);
-                }
+        Audit->SetArrayField(TEXT("actions"), Actions);
+        return Audit;
+}
 
-                bool bLoad = true;
-                Params->TryGetBoolField(TEXT("load"), bLoad);
-                Action.Args.Add(TEXT("load"), bLoad ? TEXT("true") : TEXT("false"));
+const FString& FWriteGate::GetTransactionName()
+{
+        static const FString TransactionName(TransactionLabel);
+        return TransactionName;
+}
 
-                Plan.Actions.Add(Action);
-                return Plan;
-        }
-        else if (CommandType == TEXT("actor.spawn") && Params.IsValid())
+bool FWriteGate::EnsureCheckoutForContentPath(const FString& ContentPath, TSharedPtr<FJsonObject>& OutError)
+{
+        return EnsureCheckoutForContentPaths({ContentPath}, OutError);
+}
+
+bool FWriteGate::EnsureCheckoutForContentPaths(const TArray<FString>& ContentPaths, TSharedPtr<FJsonObject>& OutError)
+{
+        if (!FUnrealMCPRuntimeConfig::Get().bRequireCheckout)
         {
-                FMutationAction Action;
-                Action.Op = TEXT("spawn");
+                return true;
+        }
 
-                FString ClassPath;
-                if (Params->TryGetStringField(TEXT("classPath"), ClassPath))
+        // File -> the content path it came from, to name the asset in errors.
+        TMap<FString, FString> FileToContentPath;
+        TArray<FString> Files;
+        for (const FString& ContentPath : ContentPaths)
+        {
+                if (ContentPath.IsEmpty())
                 {
-                        Action.Args.Add(TEXT("class"), ClassPath);
+                        continue;
                 }
 
-                const FString LocationString = SerializeArrayField(Params, TEXT("location"));
-                if (!LocationString.IsEmpty())
+                FString PackagePath = ContentPath;
+                if (PackagePath.Contains(TEXT(".")))
                 {
-                        Action.Args.Add(TEXT("location"), LocationString);
+                        PackagePath = FPackageName::ObjectPathToPackageName(PackagePath);
                 }
 
-                const FString RotationString = SerializeArrayField(Params, TEXT("rotation"));
-                if (!RotationString.IsEmpty())
+                if (!FPackageName::IsValidLongPackageName(PackagePath))
                 {
-                        Action.Args.Add(TEXT("rotation"), RotationString);
+                        continue;
                 }
 
-                const FString ScaleString = SerializeArrayField(Params, TEXT("scale"));
-                if (!ScaleString.IsEmpty())
+                TArray<FString> PathFiles;
+                FString ConversionError;
+                if (!FSourceControlService::AssetPathsToFiles({PackagePath}, PathFiles, ConversionError))
                 {
-                        Action.Args.Add(TEXT("scale"), ScaleString);
+                        OutError = MakeSourceControlRequiredError(ContentPath, ConversionError);
+                        return false;
                 }
 
-                const FString TagsString = SerializeArrayField(Params, TEXT("tags"));
-                if (!TagsString.IsEmpty())
+                for (const FString& File : PathFiles)
                 {
-                        Action.Args.Add(TEXT("tags"), TagsString);
+                        FileToContentPath.FindOrAdd(File, ContentPath);
+                        Files.AddUnique(File);
                 }
+        }
 
-                if (Params->HasTypedField<EJson::Boolean>(TEXT("select")))
-                {
-                        Action.Args.Add(TEXT("select"), Params->GetBoolField(TEXT("select")) ? TEXT("true") : TEXT("false"));
-                }
+        if (Files.Num() == 0)
+        {
+                return true;
+        }
+
+        TMap<FString, bool> PerFileResult;
+        FString CheckoutError;
+        const bool bSucceeded = FSourceControlService::EnsureCheckedOut(Files, PerFileResult, CheckoutError);
 
-                if (Params->HasTypedField<EJson::Boolean>(TEXT("deferred")))
+        for (const FString& File : Files)
+        {
+                const bool* bFileOk = PerFileResult.Find(File);
+                if (bFileOk && !*bFileOk)
                 {
-                        Action.Args.Add(TEXT("deferred"), Params->GetBoolField(TEXT("deferred")) ? TEXT("true") : TEXT("false"));
+                        OutError = MakeSourceControlRequiredError(FileToContentPath.FindRef(File), CheckoutError);
+                        return false;
                 }
-
-                Plan.Actions.Add(Action);
-                return Plan;
         }
-        else if (CommandType == TEXT("actor.destroy") && Params.IsValid())
+
+        if (!bSucceeded)
         {
-                const bool bHasAllowMissingFlag = Params->HasTypedField<EJson::Boolean>(TEXT("allowMissing"));
-                const bool bAllowMissing = bHasAllowMissingFlag && Params->GetBoolField(TEXT("allowMissing"));
+                OutError = MakeSourceControlRequiredError(FileToContentPath.FindRef(Files[0]), CheckoutError);
+                return false;
+        }
 
-                const TArray<TSharedPtr<FJsonValue>>* ActorsArray = nullptr;
-                if (Params->TryGetArrayField(TEXT("actors"), ActorsArray))
-                {
-                        for (const TSharedPtr<FJsonValue>& Value : *ActorsArray)
-                        {
-                                if (Value.IsValid() && Value->Type == EJson::String)
-                                {
-                                        FMutationAction Action;
-                                        Action.Op = TEXT("destroy");
-                                        Action.Args.Add(TEXT("actor"), Value->AsString());
-                                        if (bHasAllowMissingFlag)
-                                        {
-                                                Action.Args.Add(TEXT("allowMissing"), bAllowMissing ? TEXT("true") : TEXT("false"));
-                                        }
-                                        Plan.Actions.Add(Action);
-                                }
-                        }
+        return true;
+}
 
-                        if (Plan.Actions.Num() > 0)
-                        {
-                                return Plan;
-                        }
-                }
-        }
-        else if (CommandType == TEXT("actor.attach") && Params.IsValid())
+TSharedPtr<FJsonObject> FWriteGate::MakeSourceControlRequiredError(const FString& AssetPath, const FString& FailureMessage)
+{
+        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+        Error->SetStringField(TEXT("code"), TEXT("SOURCE_CONTROL_REQUIRED"));
+        Error->SetStringField(TEXT("message"), TEXT("Asset must be checked out before mutation"));
+
+        TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
+        Details->SetStringField(TEXT("asset"), NormalizeContentPath(AssetPath));
+        if (!FailureMessage.IsEmpty())
         {
-                FMutationAction Action;
-                Action.Op = TEXT("attach");
+                Details->SetStringField(TEXT("reason"), FailureMessage);
+        }
 
-                FString Child;
-                if (Params->TryGetStringField(TEXT("child"), Child))
-                {
-                        Action.Args.Add(TEXT("child"), Child);
-                }
+        Error->SetObjectField(TEXT("details"), Details);
+        return Error;
+}
 
-                FString Parent;
-                if (Params->TryGetStringField(TEXT("parent"), Parent))
-                {
-                        Action.Args.Add(TEXT("parent"), Parent);
-                }
+TSharedPtr<FJsonObject> FWriteGate::MakeWriteNotAllowedError(const FString& CommandType)
+{
+        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+        Error->SetStringField(TEXT("code"), TEXT("WRITE_NOT_ALLOWED"));
+        Error->SetStringField(TEXT("message"), TEXT("Write operations are disabled (allowWrite=false)"));
+        TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
+        Details->SetStringField(TEXT("tool"), CommandType);
+        Error->SetObjectField(TEXT("details"), Details);
+        return Error;
+}
+
+TSharedPtr<FJsonObject> FWriteGate::MakePathNotAllowedError(const FString& Path, const FString& Reason)
+{
+        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+        Error->SetStringField(TEXT("code"), TEXT("PATH_NOT_ALLOWED"));
+        Error->SetStringField(TEXT("message"), Reason);
+        TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
+        Details->SetStringField(TEXT("path"), NormalizeContentPath(Path));
+        Error->SetObjectField(TEXT("details"), Details);
+        return Error;
+}
+
+TSharedPtr<FJsonObject> FWriteGate::MakeUndoRequiredError(const FString& CommandType, const FString& Reason)
+{
+        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+        Error->SetStringField(TEXT("code"), TEXT("UNDO_REQUIRED"));
+        Error->SetStringField(TEXT("message"), Reason);
+
+        TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
+        Details->SetStringField(TEXT("tool"), CommandType);
+        Error->SetObjectField(TEXT("details"), Details);
+        return Error;
+}
+
+TSharedPtr<FJsonObject> FWriteGate::MakeToolNotAllowedError(const FString& CommandType, const FString& Reason)
+{
+        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+        Error->SetStringField(TEXT("code"), TEXT("TOOL_DENIED"));
+        Error->SetStringField(TEXT("message"), Reason);
+
+        TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
+        Details->SetStringField(TEXT("tool"), CommandType);
+        Error->SetObjectField(TEXT("details"), Details);
+        return Error;
+}
+
+void FWriteGate::UpdateRemoteEnforcement(bool bAllowWrite, bool bDryRun, const TArray<FString>& AllowedPaths, const TArray<FString>& AllowedTools, const TArray<FString>& DeniedTools)
+{
+        {
+                FScopeLock Lock(&GRemoteStateMutex);
+                GRemoteAllowWrite = bAllowWrite;
+                GRemoteDryRun = bDryRun;
 
-                if (Params->HasField(TEXT("socketName")))
+                GRemoteAllowedPaths.Reset();
+                for (const FString& Path : AllowedPaths)
                 {
-                        FString Socket;
-                        if (Params->TryGetStringField(TEXT("socketName"), Socket))
+                        const FString Normalized = NormalizeContentPath(Path);
+                        if (!Normalized.IsEmpty())
                         {
-                                Action.Args.Add(TEXT("socket"), Socket);
+                                GRemoteAllowedPaths.AddUnique(Normalized);
                         }
                 }
 
-                if (Params->HasTypedField<EJson::Boolean>(TEXT("keepWorldTransform")))
-                {
-                        Action.Args.Add(TEXT("keepWorldTransform"), Params->GetBoolField(TEXT("keepWorldTransform")) ? TEXT("true") : TEXT("false"));
-                }
+                GRemoteAllowedTools = AllowedTools;
+                GRemoteDeniedTools = DeniedTools;
+        }
 
-                if (Params->HasTypedField<EJson::Boolean>(TEXT("weldSimulatedBodies")))
-                {
-                        Action.Args.Add(TEXT("weldSimulatedBodies"), Params->GetBoolField(TEXT("weldSimulatedBodies")) ? TEXT("true") : TEXT("false"));
-                }
+        RefreshPolicy();
+}
 
-                Plan.Actions.Add(Action);
-                return Plan;
-        }
-        else if (CommandType == TEXT("actor.transform") && Params.IsValid())
-        {
-                FMutationAction Action;
-                Action.Op = TEXT("transform");
+void FWriteGate::RefreshPolicy()
+{
+        TUniquePtr<FWriteGatePolicy> Policy = MakeUnique<FWriteGatePolicy>();
+        const UUnrealMCPSettings* Settings = GetSettings();
 
-                FString ActorId;
-                if (Params->TryGetStringField(TEXT("actor"), ActorId))
+        TArray<FString> LocalRoots;
+        if (Settings)
+        {
+                for (const FString& Tool : Settings->DeniedTools)
                 {
-                        Action.Args.Add(TEXT("actor"), ActorId);
+                        Policy->LocalDenied.Add(Tool);
                 }
-
-                const FString SetString = SerializeObjectField(Params, TEXT("set"));
-                if (!SetString.IsEmpty())
+                for (const FString& Tool : Settings->AllowedTools)
                 {
-                        Action.Args.Add(TEXT("set"), SetString);
+                        Policy->LocalAllowed.Add(Tool);
                 }
+                Policy->bLocalAllowListActive = Settings->AllowedTools.Num() > 0;
 
-                const FString AddString = SerializeObjectField(Params, TEXT("add"));
-                if (!AddString.IsEmpty())
+                for (const FDirectoryPath& DirectoryPath : Settings->AllowedContentRoots)
                 {
-                        Action.Args.Add(TEXT("add"), AddString);
+                        const FString Normalized = NormalizeContentPath(DirectoryPath.Path);
+                        if (!Normalized.IsEmpty())
+                        {
+                                LocalRoots.AddUnique(Normalized);
+                        }
                 }
+        }
 
-                Plan.Actions.Add(Action);
-                return Plan;
+        FScopeLock Lock(&GRemoteStateMutex);
+        Policy->bWriteAllowed = Settings && Settings->AllowWrite && GRemoteAllowWrite;
+        Policy->bDryRun = !Settings || Settings->DryRun || GRemoteDryRun;
+        for (const FString& Tool : GRemoteDeniedTools)
+        {
+                Policy->RemoteDenied.Add(Tool);
         }
-        else if (CommandType == TEXT("actor.tag") && Params.IsValid())
+        for (const FString& Tool : GRemoteAllowedTools)
         {
-                FMutationAction Action;
-                Action.Op = TEXT("tag");
-
-                FString ActorId;
-                if (Params->TryGetStringField(TEXT("actor"), ActorId))
-                {
-                        Action.Args.Add(TEXT("actor"), ActorId);
-                }
+                Policy->RemoteAllowed.Add(Tool);
+        }
 
-                if (Params->HasField(TEXT("replace")))
+        for (const FString& LocalRoot : LocalRoots)
+        {
+                for (const FString& RemoteRoot : GRemoteAllowedPaths)
                 {
-                        const TSharedPtr<FJsonValue> ReplaceValue = Params->TryGetField(TEXT("replace"));
-                        if (!ReplaceValue.IsValid() || ReplaceValue->Type == EJson::Null)
+                        if (LocalRoot.StartsWith(RemoteRoot))
                         {
-                                Action.Args.Add(TEXT("replace"), TEXT("null"));
+                                Policy->AllowedRoots.AddUnique(LocalRoot);
                         }
-                        else
+                        else if (RemoteRoot.StartsWith(LocalRoot))
                         {
-                                Action.Args.Add(TEXT("replace"), SerializeJsonValue(ReplaceValue));
+                                Policy->AllowedRoots.AddUnique(RemoteRoot);
                         }
                 }
+        }
 
-                const FString AddTags = SerializeArrayField(Params, TEXT("add"));
-                if (!AddTags.IsEmpty())
-                {
-                        Action.Args.Add(TEXT("add"), AddTags);
-                }
+        const FWriteGatePolicy* Current = GPolicy.load(std::memory_order_relaxed);
+        if (Current && *Current == *Policy)
+        {
+                return;
+        }
+        GPolicy.store(Policy.Get(), std::memory_order_release);
+        GPublishedPolicies.Add(MoveTemp(Policy));
+}
 
-                const FString RemoveTags = SerializeArrayField(Params, TEXT("remove"));
-                if (!RemoveTags.IsEmpty())
-                {
-                        Action.Args.Add(TEXT("remove"), RemoveTags);
-                }
+FString FWriteGate::ResolvePathForCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+        return ResolvePath(FindMutationSchema(CommandType), Params);
+}
 
-                Plan.Actions.Add(Action);
-                return Plan;
+FString FWriteGate::ResolvePath(const FMutationSchema* Schema, const TSharedPtr<FJsonObject>& Params)
+{
+        if (!Schema)
+        {
+                return FString();
         }
-        else if (CommandType == TEXT("asset.fix_redirectors") && Params.IsValid())
+
+        if (Params.IsValid())
         {
-                const TArray<TSharedPtr<FJsonValue>>* Paths = nullptr;
-                if (Params->TryGetArrayField(TEXT("paths"), Paths))
+                for (const FMutationPathKey& PathKey : Schema->PathKeys)
                 {
-                        bool bAny = false;
-                        for (const TSharedPtr<FJsonValue>& Value : *Paths)
+                        const TSharedPtr<FJsonValue> Value = Params->TryGetField(PathKey.Key);
+                        if (!Value.IsValid())
                         {
-                                if (Value->Type == EJson::String)
+                                continue;
+                        }
+
+                        FString Candidate;
+                        if (Value->Type == EJson::Array)
+                        {
+                                for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
                                 {
-                                        FMutationAction Action;
-                                        Action.Op = TEXT("fix_redirectors");
-                                        Action.Args.Add(TEXT("path"), NormalizeContentPath(Value->AsString()));
-                                        if (Params->HasTypedField<EJson::Boolean>(TEXT("recursive")))
+                                        if (!Element.IsValid())
                                         {
-                                                Action.Args.Add(TEXT("recursive"), Params->GetBoolField(TEXT("recursive")) ? TEXT("true") : TEXT("false"));
+                                                continue;
+                                        }
+                                        if (PathKey.Field.IsEmpty() ? Element->TryGetString(Candidate) : Element->Type == EJson::Object && Element->AsObject()->TryGetStringField(PathKey.Field, Candidate))
+                                        {
+                                                Candidate = NormalizeContentPath(Candidate);
+                                                if (!Candidate.IsEmpty())
+                                                {
+                                                        break;
+                                                }
                                         }
-                                        Plan.Actions.Add(Action);
-                                        bAny = true;
                                 }
                         }
-
-                        if (bAny)
+                        else if (Value->Type == EJson::String)
                         {
-                                return Plan;
+                                Candidate = NormalizeContentPath(Value->AsString());
                         }
-                }
-        }
-        else if (CommandType == TEXT("asset.save_all") && Params.IsValid())
-        {
-                FMutationAction Action;
-                Action.Op = TEXT("save_all");
 
-                const TArray<TSharedPtr<FJsonValue>>* Paths = nullptr;
-                if (Params->TryGetArrayField(TEXT("paths"), Paths))
-                {
-                        TArray<FString> NormalizedPaths;
-                        for (const TSharedPtr<FJsonValue>& Value : *Paths)
+                        if (PathKey.bPackage && !Candidate.IsEmpty())
                         {
-                                if (Value->Type == EJson::String)
-                                {
-                                        NormalizedPaths.Add(NormalizeContentPath(Value->AsString()));
-                                }
+                                Candidate = FPackageName::ObjectPathToPackageName(Candidate);
                         }
-
-                        if (NormalizedPaths.Num() > 0)
+                        if (!Candidate.IsEmpty())
                         {
-                                Action.Args.Add(TEXT("paths"), FString::Join(NormalizedPaths, TEXT(",")));
+                                return Candidate;
                         }
                 }
-
-                if (Params->HasTypedField<EJson::Boolean>(TEXT("modifiedOnly")))
-                {
-                        Action.Args.Add(TEXT("modifiedOnly"), Params->GetBoolField(TEXT("modifiedOnly")) ? TEXT("true") : TEXT("false"));
-                }
-
-                Plan.Actions.Add(Action);
-                return Plan;
         }
-        else if (CommandType == TEXT("content.fix_missing") && Params.IsValid())
-        {
-                bool bRecursive = true;
-                Params->TryGetBoolField(TEXT("recursive"), bRecursive);
 
-                bool bFixRedirectors = true;
-                bool bRemapReferences = true;
-                bool bDeleteRedirectors = true;
+        if (Schema->LevelFallback != EMutationLevelPath::None)
+        {
+                return NormalizeContentPath(GetEditorLevelPackageName(Schema->LevelFallback));
+        }
 
-                const TSharedPtr<FJsonObject>* FixObject = nullptr;
-                if (Params->TryGetObjectField(TEXT("fix"), FixObject) && FixObject->IsValid())
-                {
-                        (*FixObject)->TryGetBoolField(TEXT("redirectors"), bFixRedirectors);
-                        (*FixObject)->TryGetBoolField(TEXT("remapReferences"), bRemapReferences);
-                        (*FixObject)->TryGetBoolField(TEXT("deleteStaleRedirectors"), bDeleteRedirectors);
-                }
+        return FString();
+}
 
-                const FString PathsSerialized = SerializeArrayField(Params, TEXT("paths"));
+const FMutationSchema* FWriteGate::FindMutationSchema(const FString& CommandType)
+{
+        static const TMap<FString, FMutationSchema> Schemas = []()
+        {
+                TMap<FString, FMutationSchema> Result;
+                RegisterMutationSchemas(Result);
+                return Result;
+        }();
+        return Schemas.Find(CommandType);
+}
 
-                if (bFixRedirectors)
+bool FWriteGate::ReadMutationArg(const FMutationArgSpec& Spec, const TSharedPtr<FJsonValue>& Value, FString& OutValue)
+{
+        if (Value.IsValid())
+        {
+                switch (Spec.Kind)
                 {
-                        FMutationAction FixAction;
-                        FixAction.Op = TEXT("fix_redirectors");
-                        if (!PathsSerialized.IsEmpty())
+                case EMutationArg::String:
+                        if (Value->TryGetString(OutValue))
                         {
-                                FixAction.Args.Add(TEXT("paths"), PathsSerialized);
+                                OutValue.TrimStartAndEndInline();
                         }
-                        FixAction.Args.Add(TEXT("recursive"), bRecursive ? TEXT("true") : TEXT("false"));
-                        Plan.Actions.Add(FixAction);
-                }
-
-                if (bRemapReferences)
-                {
-                        FMutationAction RemapAction;
-                        RemapAction.Op = TEXT("remap_soft_refs");
-                        if (!PathsSerialized.IsEmpty())
+                        break;
+                case EMutationArg::Path:
+                case EMutationArg::Package:
+                        if (Value->TryGetString(OutValue))
                         {
-                                RemapAction.Args.Add(TEXT("paths"), PathsSerialized);
+                                OutValue = NormalizeContentPath(OutValue);
+                                if (Spec.Kind == EMutationArg::Package && !OutValue.IsEmpty())
+                                {
+                                        OutValue = FPackageName::ObjectPathToPackageName(OutValue);
+                                }
                         }
-                        Plan.Actions.Add(RemapAction);
-                }
-
-                if (bDeleteRedirectors)
-                {
-                        FMutationAction DeleteAction;
-                        DeleteAction.Op = TEXT("delete_redirectors");
-                        if (!PathsSerialized.IsEmpty())
+                        break;
+                case EMutationArg::PathList:
+                        if (Value->Type == EJson::Array)
                         {
-                                DeleteAction.Args.Add(TEXT("paths"), PathsSerialized);
+                                TArray<FString> Paths;
+                                for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+                                {
+                                        if (Element.IsValid() && Element->Type == EJson::String)
+                                        {
+                                                Paths.Add(NormalizeContentPath(Element->AsString()));
+                                        }
+                                }
+                                OutValue = FString::Join(Paths, TEXT(","));
                         }
-                        Plan.Actions.Add(DeleteAction);
-                }
-
-                if (Params->HasField(TEXT("save")))
-                {
-                        FMutationAction SaveAction;
-                        SaveAction.Op = TEXT("save_packages");
-                        SaveAction.Args.Add(TEXT("save"), Params->GetBoolField(TEXT("save")) ? TEXT("true") : TEXT("false"));
-                        Plan.Actions.Add(SaveAction);
-                }
-
-                if (Plan.Actions.Num() == 0)
-                {
-                        FMutationAction DefaultAction;
-                        DefaultAction.Op = CommandType;
-                        Plan.Actions.Add(DefaultAction);
-                }
-
-                return Plan;
-        }
-        else if (CommandType == TEXT("content.generate_thumbnails") && Params.IsValid())
-        {
-                FMutationAction Action;
-                Action.Op = TEXT("generate_thumbnails");
-
-                const FString AssetsSerialized = SerializeArrayField(Params, TEXT("assets"));
-                if (!AssetsSerialized.IsEmpty())
-                {
-                        Action.Args.Add(TEXT("assets"), AssetsSerialized);
-                }
-
-                if (Params->HasField(TEXT("hiRes")))
-                {
-                        Action.Args.Add(TEXT("hiRes"), Params->GetBoolField(TEXT("hiRes")) ? TEXT("true") : TEXT("false"));
-                }
-
-                if (Params->HasField(TEXT("save")))
-                {
-                        Action.Args.Add(TEXT("save"), Params->GetBoolField(TEXT("save")) ? TEXT("true") : TEXT("false"));
-                }
-
-                Plan.Actions.Add(Action);
-                return Plan;
-        }
-        else if (CommandType == TEXT("niagara.spawn_component") && Params.IsValid())
-        {
-                FMutationAction Action;
-                Action.Op = TEXT("spawn_niagara");
-
-                FString SystemPath;
-                if (Params->TryGetStringField(TEXT("systemPath"), SystemPath))
-                {
-                        Action.Args.Add(TEXT("system"), SystemPath);
-                }
-
-                const TSharedPtr<FJsonObject>* AttachObject = nullptr;
-                if (Params->TryGetObjectField(TEXT("attach"), AttachObject) && AttachObject && AttachObject->IsValid())
-                {
-                        FString ActorPath;
-                        if ((*AttachObject)->TryGetStringField(TEXT("actorPath"), ActorPath))
-                        {
-                                Action.Args.Add(TEXT("attachTo"), ActorPath);
-                        }
-
-                        FString SocketName;
-                        if ((*AttachObject)->TryGetStringField(TEXT("socketName"), SocketName) && !SocketName.IsEmpty())
+                        break;
+                case EMutationArg::Bool:
+                        if (Value->Type == EJson::Boolean)
                         {
-                                Action.Args.Add(TEXT("socket"), SocketName);
+                                OutValue = Value->AsBool() ? TEXT("true") : TEXT("false");
                         }
-
-                        if ((*AttachObject)->HasTypedField<EJson::Boolean>(TEXT("keepWorldTransform")))
+                        break;
+                case EMutationArg::Int:
+                        if (Value->Type == EJson::Number)
                         {
-                                Action.Args.Add(TEXT("keepWorld"), (*AttachObject)->GetBoolField(TEXT("keepWorldTransform")) ? TEXT("true") : TEXT("false"));
+                                OutValue = FString::FromInt(static_cast<int32>(Value->AsNumber()));
                         }
-                }
-                else
-                {
-                        const FString TransformString = SerializeObjectField(Params, TEXT("transform"));
-                        if (!TransformString.IsEmpty())
+                        else if (Value->Type == EJson::String)
                         {
-                                Action.Args.Add(TEXT("transform"), TransformString);
+                                OutValue = Value->AsString();
                         }
-                }
-
-                if (Params->HasTypedField<EJson::Boolean>(TEXT("autoActivate")))
-                {
-                        Action.Args.Add(TEXT("autoActivate"), Params->GetBoolField(TEXT("autoActivate")) ? TEXT("true") : TEXT("false"));
-                }
-
-                if (Params->HasTypedField<EJson::Boolean>(TEXT("select")))
-                {
-                        Action.Args.Add(TEXT("select"), Params->GetBoolField(TEXT("select")) ? TEXT("true") : TEXT("false"));
-                }
-
-                const FString InitialParamsString = SerializeObjectField(Params, TEXT("initialUserParams"));
-                if (!InitialParamsString.IsEmpty())
-                {
-                        Action.Args.Add(TEXT("params"), InitialParamsString);
-                }
-
-                Plan.Actions.Add(Action);
-                return Plan;
-        }
-        else if (CommandType == TEXT("niagara.set_user_params") && Params.IsValid())
-        {
-                FString ComponentPath;
-                Params->TryGetStringField(TEXT("componentPath"), ComponentPath);
-
-                const TSharedPtr<FJsonObject>* ParamObject = nullptr;
-                if (Params->TryGetObjectField(TEXT("params"), ParamObject) && ParamObject && ParamObject->IsValid())
-                {
-                        for (const auto& Pair : (*ParamObject)->Values)
+                        break;
+                case EMutationArg::Array:
+                        if (Value->Type == EJson::Array)
                         {
-                                FMutationAction Action;
-                                Action.Op = TEXT("set_user_param");
-                                if (!ComponentPath.IsEmpty())
-                                {
-                                        Action.Args.Add(TEXT("component"), ComponentPath);
-                                }
-                                Action.Args.Add(TEXT("name"), Pair.Key);
-                                Action.Args.Add(TEXT("value"), SerializeJsonValue(Pair.Value));
-                                Plan.Actions.Add(Action);
+                                OutValue = SerializeArray(Value->AsArray());
                         }
-
-                        if (Plan.Actions.Num() > 0)
+                        break;
+                case EMutationArg::Object:
+                        if (Value->Type == EJson::Object && Value->AsObject().IsValid())
                         {
-                                return Plan;
+                                OutValue = SerializeObject(Value->AsObject().ToSharedRef());
                         }
+                        break;
+                case EMutationArg::Value:
+                        OutValue = Value->Type == EJson::Null ? FString(TEXT("null")) : SerializeJsonValue(Value);
+                        break;
                 }
         }
-        else if (CommandType == TEXT("niagara.activate") && Params.IsValid())
-        {
-                FMutationAction Action;
-                Action.Op = TEXT("activate_niagara");
 
-                FString ComponentPath;
-                if (Params->TryGetStringField(TEXT("componentPath"), ComponentPath))
-                {
-                        Action.Args.Add(TEXT("component"), ComponentPath);
-                }
-
-                if (Params->HasTypedField<EJson::Boolean>(TEXT("reset")))
-                {
-                        Action.Args.Add(TEXT("reset"), Params->GetBoolField(TEXT("reset")) ? TEXT("true") : TEXT("false"));
-                }
-
-                Plan.Actions.Add(Action);
-                return Plan;
+        if (OutValue.IsEmpty())
+        {
+                OutValue = Spec.Default;
         }
-        else if (CommandType == TEXT("niagara.deactivate") && Params.IsValid())
+        return !OutValue.IsEmpty();
+}
+
+void FWriteGate::RegisterMutationSchemas(TMap<FString, FMutationSchema>& Schemas)
+{
+        // Mutations that touch no content package; the gate treats them as editor-only.
+        static const TCHAR* const EditorOnlyCommands[] = {
+                TEXT("spawn_actor"),
+                TEXT("create_actor"),
+                TEXT("delete_actor"),
+                TEXT("set_actor_transform"),
+                TEXT("set_actor_property"),
+                TEXT("spawn_blueprint_actor"),
+                TEXT("add_component_to_blueprint"),
+                TEXT("set_component_property"),
+                TEXT("set_physics_properties"),
+                TEXT("compile_blueprint"),
+                TEXT("blueprint.compile_many"),
+                TEXT("set_blueprint_property"),
+                TEXT("set_static_mesh_properties"),
+                TEXT("set_pawn_properties"),
+                TEXT("connect_blueprint_nodes"),
+                TEXT("add_blueprint_get_self_component_reference"),
+                TEXT("add_blueprint_self_reference"),
+                TEXT("add_blueprint_event_node"),
+                TEXT("add_blueprint_input_action_node"),
+                TEXT("add_blueprint_function_node"),
+                TEXT("add_blueprint_get_component_node"),
+                TEXT("add_blueprint_variable"),
+                TEXT("blueprint.graph_patch"),
+                TEXT("create_input_mapping")
+        };
+        for (const TCHAR* Command : EditorOnlyCommands)
         {
-                FMutationAction Action;
-                Action.Op = TEXT("deactivate_niagara");
+                Schemas.Add(Command);
+        }
 
-                FString ComponentPath;
-                if (Params->TryGetStringField(TEXT("componentPath"), ComponentPath))
-                {
-                        Action.Args.Add(TEXT("component"), ComponentPath);
-                }
+        // Blueprint and widget assets created by name under /Game.
+        Schemas.Add(TEXT("create_blueprint")).PathKeys = { MakePathKey(TEXT("name")) };
+        Schemas.Add(TEXT("create_umg_widget_blueprint")).PathKeys = { MakePathKey(TEXT("name")) };
+        static const TCHAR* const WidgetCommands[] = {
+                TEXT("add_text_block_to_widget"),
+                TEXT("add_button_to_widget"),
+                TEXT("bind_widget_event"),
+                TEXT("set_text_block_binding"),
+                TEXT("umg.build_tree"),
+                TEXT("add_widget_to_viewport")
+        };
+        for (const TCHAR* Command : WidgetCommands)
+        {
+                Schemas.Add(Command).PathKeys = { MakePathKey(TEXT("widget_name")) };
+        }
 
-                if (Params->HasTypedField<EJson::Boolean>(TEXT("immediate")))
-                {
-                        Action.Args.Add(TEXT("immediate"), Params->GetBoolField(TEXT("immediate")) ? TEXT("true") : TEXT("false"));
-                }
+        static const TCHAR* const SourceControlCommands[] = {
+                TEXT("sc.status"),
+                TEXT("sc.checkout"),
+                TEXT("sc.add"),
+                TEXT("sc.revert"),
+                TEXT("sc.submit")
+        };
+        for (const TCHAR* Command : SourceControlCommands)
+        {
+                FMutationSchema& Schema = Schemas.Add(Command);
+                Schema.PathKeys = { MakePathKey(TEXT("assets")) };
+                Schema.Actions = {
+                        MakeForEach(TEXT(""), TEXT("assets"), TEXT("asset"), EMutationArg::Path),
+                        MakeForEach(TEXT(""), TEXT("files"), TEXT("file"), EMutationArg::String)
+                };
+        }
 
-                Plan.Actions.Add(Action);
-                return Plan;
+        {
+                FMutationSchema& Schema = Schemas.Add(TEXT("camera.bookmark"));
+                Schema.LevelFallback = EMutationLevelPath::Current;
+                Schema.Actions = { MakeAction(TEXT("bookmark_persist"), { MakeArg(TEXT("index"), TEXT("index"), EMutationArg::Int, TEXT("0")) }) };
         }
-        else if (CommandType == TEXT("asset.batch_import") && Params.IsValid())
+
         {
-                FString DestPath;
-                if (Params->TryGetStringField(TEXT("destPath"), DestPath))
+                // One mkdir per folder, for either the single "path" or the bulk "paths" form.
+                FMutationSchema& Schema = Schemas.Add(TEXT("asset.create_folder"));
+                Schema.PathKeys = { MakePathKey(TEXT("path")), MakePathKey(TEXT("paths")) };
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
                 {
-                        const FString NormalizedDest = NormalizeContentPath(DestPath);
-                        const TArray<TSharedPtr<FJsonValue>>* Files = nullptr;
-                        if (Params->TryGetArrayField(TEXT("files"), Files))
+                        TArray<FString> Paths;
+                        const TArray<TSharedPtr<FJsonValue>>* PathsJson = nullptr;
+                        if (Params->TryGetArrayField(TEXT("paths"), PathsJson) && PathsJson)
                         {
-                                for (const TSharedPtr<FJsonValue>& Value : *Files)
+                                for (const TSharedPtr<FJsonValue>& Value : *PathsJson)
                                 {
-                                        if (Value->Type == EJson::String)
+                                        if (Value.IsValid() && Value->Type == EJson::String)
                                         {
-                                                FMutationAction Action;
-                                                Action.Op = TEXT("import");
-                                                Action.Args.Add(TEXT("file"), Value->AsString());
-                                                Action.Args.Add(TEXT("dest"), NormalizedDest);
-                                                Plan.Actions.Add(Action);
+                                                Paths.Add(NormalizeContentPath(Value->AsString()));
                                         }
                                 }
-
-                                if (Plan.Actions.Num() > 0)
-                                {
-                                        return Plan;
-                                }
                         }
-                }
-        }
-        else if (CommandType == TEXT("mi.create") && Params.IsValid())
-        {
-                FMutationAction Action;
-                Action.Op = TEXT("create_mi");
-
-                FString Parent;
-                if (Params->TryGetStringField(TEXT("parent"), Parent))
-                {
-                        Action.Args.Add(TEXT("parent"), Parent);
-                }
-
-                FString MiPath;
-                if (Params->TryGetStringField(TEXT("miPath"), MiPath))
-                {
-                        Action.Args.Add(TEXT("dst"), NormalizeContentPath(MiPath));
-                }
-
-                Plan.Actions.Add(Action);
-                return Plan;
-        }
-        else if (CommandType == TEXT("mi.set_params") && Params.IsValid())
-        {
-                FString MiObjectPath;
-                if (Params->TryGetStringField(TEXT("miObjectPath"), MiObjectPath))
-                {
-                        FMutationAction TargetAction;
-                        TargetAction.Op = TEXT("mi_target");
-                        TargetAction.Args.Add(TEXT("mi"), NormalizeContentPath(MiObjectPath));
-                        Plan.Actions.Add(TargetAction);
-                }
-
-                if (Params->HasTypedField<EJson::Boolean>(TEXT("clearUnset")) && Params->GetBoolField(TEXT("clearUnset")))
-                {
-                        FMutationAction ClearAction;
-                        ClearAction.Op = TEXT("clear_overrides");
-                        Plan.Actions.Add(ClearAction);
-                }
-
-                const TSharedPtr<FJsonObject>* ScalarsObject = nullptr;
-                if (Params->TryGetObjectField(TEXT("scalars"), ScalarsObject) && ScalarsObject && ScalarsObject->IsValid())
-                {
-                        for (const auto& Pair : (*ScalarsObject)->Values)
-                        {
-                                FMutationAction Action;
-                                Action.Op = TEXT("set_scalar");
-                                Action.Args.Add(TEXT("name"), Pair.Key);
-                                Action.Args.Add(TEXT("value"), ValueToAuditString(Pair.Value));
-                                Plan.Actions.Add(Action);
-                        }
-                }
-
-                const TSharedPtr<FJsonObject>* VectorsObject = nullptr;
-                if (Params->TryGetObjectField(TEXT("vectors"), VectorsObject) && VectorsObject && VectorsObject->IsValid())
-                {
-                        for (const auto& Pair : (*VectorsObject)->Values)
-                        {
-                                FMutationAction Action;
-                                Action.Op = TEXT("set_vector");
-                                Action.Args.Add(TEXT("name"), Pair.Key);
-                                Action.Args.Add(TEXT("value"), ValueToAuditString(Pair.Value));
-                                Plan.Actions.Add(Action);
-                        }
-                }
-
-                const TSharedPtr<FJsonObject>* TexturesObject = nullptr;
-                if (Params->TryGetObjectField(TEXT("textures"), TexturesObject) && TexturesObject && TexturesObject->IsValid())
-                {
-                        for (const auto& Pair : (*TexturesObject)->Values)
+                        else
                         {
-                                FMutationAction Action;
-                                Action.Op = TEXT("set_texture");
-                                Action.Args.Add(TEXT("name"), Pair.Key);
-                                Action.Args.Add(TEXT("value"), ValueToAuditString(Pair.Value));
-                                Plan.Actions.Add(Action);
+                                FString Path;
+                                if (Params->TryGetStringField(TEXT("path"), Path))
+                                {
+                                        Paths.Add(NormalizeContentPath(Path));
+                                }
                         }
-                }
 
-                const TSharedPtr<FJsonObject>* SwitchesObject = nullptr;
-                if (Params->TryGetObjectField(TEXT("switches"), SwitchesObject) && SwitchesObject && SwitchesObject->IsValid())
-                {
-                        for (const auto& Pair : (*SwitchesObject)->Values)
+                        for (const FString& Path : Paths)
                         {
                                 FMutationAction Action;
-                                Action.Op = TEXT("set_switch");
-                                Action.Args.Add(TEXT("name"), Pair.Key);
-                                Action.Args.Add(TEXT("value"), ValueToAuditString(Pair.Value));
-                                Plan.Actions.Add(Action);
+                                Action.Op = TEXT("mkdir");
+                                Action.Args.Add(TEXT("path"), Path);
+                                Actions.Add(Action);
                         }
-                }
-
-                return Plan;
+                };
         }
-        else if (CommandType == TEXT("mi.batch_apply") && Params.IsValid())
+
         {
-                const TArray<TSharedPtr<FJsonValue>>* Targets = nullptr;
-                if (Params->TryGetArrayField(TEXT("targets"), Targets) && Targets)
+                // One rename per move, for either the single fromObjectPath/toPackagePath form or "moves".
+                FMutationSchema& Schema = Schemas.Add(TEXT("asset.rename"));
+                Schema.PathKeys = {
+                        MakePathKey(TEXT("fromObjectPath")),
+                        MakePathKey(TEXT("toPackagePath")),
+                        MakePathKey(TEXT("moves"), false, TEXT("fromObjectPath")),
+                        MakePathKey(TEXT("moves"), false, TEXT("toPackagePath"))
+                };
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
                 {
-                        for (const TSharedPtr<FJsonValue>& TargetValue : *Targets)
+                        auto AddRename = [&Actions](const TSharedPtr<FJsonObject>& Move)
                         {
-                                if (!TargetValue.IsValid() || TargetValue->Type != EJson::Object)
-                                {
-                                        continue;
-                                }
-
-                                const TSharedPtr<FJsonObject> TargetObject = TargetValue->AsObject();
-                                if (!TargetObject.IsValid())
-                                {
-                                        continue;
-                                }
-
-                                FString ActorPath;
-                                TargetObject->TryGetStringField(TEXT("actorPath"), ActorPath);
-
-                                FString ComponentName;
-                                TargetObject->TryGetStringField(TEXT("component"), ComponentName);
-
-                                const TArray<TSharedPtr<FJsonValue>>* AssignArray = nullptr;
-                                if (!TargetObject->TryGetArrayField(TEXT("assign"), AssignArray) || !AssignArray)
+                                FString From;
+                                FString To;
+                                if (Move->TryGetStringField(TEXT("fromObjectPath"), From) && Move->TryGetStringField(TEXT("toPackagePath"), To))
                                 {
-                                        continue;
+                                        FMutationAction Action;
+                                        Action.Op = TEXT("rename");
+                                        Action.Args.Add(TEXT("from"), FPackageName::ObjectPathToPackageName(NormalizeContentPath(From)));
+                                        Action.Args.Add(TEXT("to"), NormalizeContentPath(To));
+                                        Actions.Add(Action);
                                 }
+                        };
 
-                                for (const TSharedPtr<FJsonValue>& AssignValue : *AssignArray)
+                        const TArray<TSharedPtr<FJsonValue>>* Moves = nullptr;
+                        if (Params->TryGetArrayField(TEXT("moves"), Moves) && Moves)
+                        {
+                                for (const TSharedPtr<FJsonValue>& Value : *Moves)
                                 {
-                                        if (!AssignValue.IsValid() || AssignValue->Type != EJson::Object)
+                                        if (Value.IsValid() && Value->Type == EJson::Object && Value->AsObject().IsValid())
                                         {
-                                                continue;
+                                                AddRename(Value->AsObject());
                                         }
-
-                                        const TSharedPtr<FJsonObject> AssignObject = AssignValue->AsObject();
-                                        if (!AssignObject.IsValid())
-                                        {
-                                                continue;
-                                        }
-
-                                        FMutationAction Action;
-                                        Action.Op = TEXT("apply_mi");
-                                        if (!ActorPath.IsEmpty())
-                                        {
-                                                Action.Args.Add(TEXT("actor"), ActorPath);
-                                        }
-
-                                        if (!ComponentName.IsEmpty())
-                                        {
-                                                Action.Args.Add(TEXT("component"), ComponentName);
-                                        }
-
-                                        TSharedPtr<FJsonValue> SlotValue = AssignObject->TryGetField(TEXT("slot"));
-                                        if (SlotValue.IsValid())
-                                        {
-                                                Action.Args.Add(TEXT("slot"), SerializeJsonValue(SlotValue));
-                                        }
-
-                                        FString MiPath;
-                                        if (AssignObject->TryGetStringField(TEXT("mi"), MiPath))
-                                        {
-                                                Action.Args.Add(TEXT("mi"), MiPath);
-                                        }
-
-                                        Plan.Actions.Add(Action);
                                 }
                         }
-                }
-
-                if (Plan.Actions.Num() > 0)
-                {
-                        return Plan;
-                }
-        }
-        else if (CommandType == TEXT("mesh.remap_material_slots") && Params.IsValid())
-        {
-                FString MeshObjectPath;
-                Params->TryGetStringField(TEXT("meshObjectPath"), MeshObjectPath);
-
-                bool bHasAction = false;
-
-                const TSharedPtr<FJsonObject>* RenameObject = nullptr;
-                if (Params->TryGetObjectField(TEXT("rename"), RenameObject) && RenameObject && (*RenameObject)->Values.Num() > 0)
-                {
-                        FMutationAction Action;
-                        Action.Op = TEXT("rename_slots");
-                        if (!MeshObjectPath.IsEmpty())
-                        {
-                                Action.Args.Add(TEXT("mesh"), MeshObjectPath);
-                        }
-                        Action.Args.Add(TEXT("pairs"), SerializeObjectField(Params, TEXT("rename")));
-                        Plan.Actions.Add(Action);
-                        bHasAction = true;
-                }
-
-                const TArray<TSharedPtr<FJsonValue>>* ReorderArray = nullptr;
-                if (Params->TryGetArrayField(TEXT("reorder"), ReorderArray) && ReorderArray && ReorderArray->Num() > 0)
-                {
-                        FMutationAction Action;
-                        Action.Op = TEXT("reorder_slots");
-                        if (!MeshObjectPath.IsEmpty())
+                        else
                         {
-                                Action.Args.Add(TEXT("mesh"), MeshObjectPath);
+                                AddRename(Params);
                         }
-                        Action.Args.Add(TEXT("order"), SerializeArrayField(Params, TEXT("reorder")));
-                        Plan.Actions.Add(Action);
-                        bHasAction = true;
-                }
-
-                if (bHasAction)
-                {
-                        return Plan;
-                }
+                };
         }
-        else if (CommandType == TEXT("sequence.create") && Params.IsValid())
-        {
-                FString SequencePath;
-                const bool bHasPath = Params->TryGetStringField(TEXT("sequencePath"), SequencePath);
-                const FString NormalizedPath = bHasPath ? NormalizeContentPath(SequencePath) : FString();
-
-                const bool bOverwrite = Params->HasTypedField<EJson::Boolean>(TEXT("overwriteIfExists")) && Params->GetBoolField(TEXT("overwriteIfExists"));
-                if (bOverwrite)
-                {
-                        FMutationAction DeleteAction;
-                        DeleteAction.Op = TEXT("delete_sequence");
-                        if (!NormalizedPath.IsEmpty())
-                        {
-                                DeleteAction.Args.Add(TEXT("path"), NormalizedPath);
-                        }
-                        Plan.Actions.Add(DeleteAction);
-                }
-
-                FMutationAction CreateAction;
-                CreateAction.Op = TEXT("create_sequence");
-                if (!NormalizedPath.IsEmpty())
-                {
-                        CreateAction.Args.Add(TEXT("path"), NormalizedPath);
-                }
-                Plan.Actions.Add(CreateAction);
-
-                const bool bCreateCamera = Params->HasTypedField<EJson::Boolean>(TEXT("createCamera")) && Params->GetBoolField(TEXT("createCamera"));
-                const bool bAddCameraCut = Params->HasTypedField<EJson::Boolean>(TEXT("addCameraCut")) && Params->GetBoolField(TEXT("addCameraCut"));
 
-                if (bCreateCamera)
-                {
-                        FMutationAction CameraAction;
-                        CameraAction.Op = TEXT("spawn_camera");
-                        FString CameraName;
-                        if (Params->TryGetStringField(TEXT("cameraName"), CameraName) && !CameraName.IsEmpty())
-                        {
-                                CameraAction.Args.Add(TEXT("name"), CameraName);
-                        }
-                        Plan.Actions.Add(CameraAction);
+        {
+                FMutationSchema& Schema = Schemas.Add(TEXT("asset.delete"));
+                Schema.PathKeys = { MakePathKey(TEXT("objectPaths")) };
+                Schema.Actions = { MakeForEach(TEXT("delete"), TEXT("objectPaths"), TEXT("objectPath"), EMutationArg::Path) };
+        }
 
-                        if (bAddCameraCut)
-                        {
-                                FMutationAction CutAction;
-                                CutAction.Op = TEXT("add_camera_cut");
-                                Plan.Actions.Add(CutAction);
-                        }
-                }
+        {
+                FMutationSchema& Schema = Schemas.Add(TEXT("asset.fix_redirectors"));
+                Schema.PathKeys = { MakePathKey(TEXT("paths")) };
+                Schema.Actions = { MakeForEach(TEXT("fix_redirectors"), TEXT("paths"), TEXT("path"), EMutationArg::Path, { MakeArg(TEXT("recursive"), TEXT("recursive"), EMutationArg::Bool) }) };
+        }
 
-                const TArray<TSharedPtr<FJsonValue>>* ActorsArray = nullptr;
-                if (Params->TryGetArrayField(TEXT("bindActors"), ActorsArray) && ActorsArray)
-                {
-                        for (const TSharedPtr<FJsonValue>& Value : *ActorsArray)
-                        {
-                                if (Value.IsValid() && Value->Type == EJson::String)
-                                {
-                                        FMutationAction BindAction;
-                                        BindAction.Op = TEXT("bind_actor");
-                                        BindAction.Args.Add(TEXT("actor"), Value->AsString());
-                                        Plan.Actions.Add(BindAction);
-                                }
-                        }
-                }
+        {
+                FMutationSchema& Schema = Schemas.Add(TEXT("asset.save_all"));
+                Schema.PathKeys = { MakePathKey(TEXT("paths")) };
+                Schema.Actions = { MakeAction(TEXT("save_all"), {
+                        MakeArg(TEXT("paths"), TEXT("paths"), EMutationArg::PathList),
+                        MakeArg(TEXT("modifiedOnly"), TEXT("modifiedOnly"), EMutationArg::Bool)
+                }) };
+        }
 
-                return Plan;
+        {
+                FMutationSchema& Schema = Schemas.Add(TEXT("asset.batch_import"));
+                Schema.PathKeys = { MakePathKey(TEXT("destPath")) };
+                Schema.Actions = { MakeForEach(TEXT("import"), TEXT("files"), TEXT("file"), EMutationArg::String, { MakeArg(TEXT("dest"), TEXT("destPath"), EMutationArg::Path) }) };
         }
-        else if (CommandType == TEXT("sequence.bind_actors") && Params.IsValid())
         {
-                const TArray<TSharedPtr<FJsonValue>>* ActorsArray = nullptr;
-                if (Params->TryGetArrayField(TEXT("actorPaths"), ActorsArray) && ActorsArray)
-                {
-                        for (const TSharedPtr<FJsonValue>& Value : *ActorsArray)
-                        {
-                                if (Value.IsValid() && Value->Type == EJson::String)
-                                {
-                                        FString ActorPath = Value->AsString();
-                                        ActorPath.TrimStartAndEndInline();
-                                        if (!ActorPath.IsEmpty())
-                                        {
-                                                FMutationAction Action;
-                                                Action.Op = TEXT("bind");
-                                                Action.Args.Add(TEXT("actor"), ActorPath);
-                                                Plan.Actions.Add(Action);
-                                        }
-                                }
-                        }
-                }
-
-                return Plan;
+                FMutationSchema& Schema = Schemas.Add(TEXT("datatable.import_rows"));
+                Schema.PathKeys = { MakePathKey(TEXT("dataTable")) };
+                Schema.Actions = { MakeAction(TEXT("import_rows"), {
+                        MakeArg(TEXT("dataTable"), TEXT("dataTable"), EMutationArg::Path),
+                        MakeArg(TEXT("mode"), TEXT("mode"), EMutationArg::String, TEXT("merge")),
+                        MakeArg(TEXT("stream"), TEXT("stream")),
+                        MakeArg(TEXT("final"), TEXT("final"), EMutationArg::Bool, TEXT("true")),
+                        MakeArg(TEXT("save"), TEXT("save"), EMutationArg::Bool)
+                }) };
         }
-        else if (CommandType == TEXT("sequence.unbind") && Params.IsValid())
+
         {
-                const TArray<TSharedPtr<FJsonValue>>* BindingArray = nullptr;
-                if (Params->TryGetArrayField(TEXT("bindingIds"), BindingArray) && BindingArray)
+                FMutationSchema& Schema = Schemas.Add(TEXT("level.save_open"));
+                Schema.PathKeys = { MakePathKey(TEXT("maps"), /*bPackage=*/true) };
+                Schema.LevelFallback = EMutationLevelPath::Persistent;
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
                 {
-                        for (const TSharedPtr<FJsonValue>& Value : *BindingArray)
+                        FString Mode;
+                        if (Params->TryGetStringField(TEXT("mode"), Mode) && Mode == TEXT("touched"))
                         {
-                                if (Value.IsValid() && Value->Type == EJson::String)
-                                {
-                                        FString BindingId = Value->AsString();
-                                        BindingId.TrimStartAndEndInline();
-                                        if (!BindingId.IsEmpty())
-                                        {
-                                                FMutationAction Action;
-                                                Action.Op = TEXT("unbind");
-                                                Action.Args.Add(TEXT("bindingId"), BindingId);
-                                                Plan.Actions.Add(Action);
-                                        }
-                                }
+                                FMutationAction Action;
+                                Action.Op = TEXT("save_touched");
+                                Actions.Add(Action);
+                                return;
                         }
-                }
 
-                const TArray<TSharedPtr<FJsonValue>>* ActorsArray = nullptr;
-                if (Params->TryGetArrayField(TEXT("actorPaths"), ActorsArray) && ActorsArray)
-                {
-                        for (const TSharedPtr<FJsonValue>& Value : *ActorsArray)
-                        {
-                                if (Value.IsValid() && Value->Type == EJson::String)
-                                {
-                                        FString ActorPath = Value->AsString();
-                                        ActorPath.TrimStartAndEndInline();
-                                        if (!ActorPath.IsEmpty())
-                                        {
-                                                FMutationAction Action;
-                                                Action.Op = TEXT("unbind");
-                                                Action.Args.Add(TEXT("actor"), ActorPath);
-                                                Plan.Actions.Add(Action);
-                                        }
-                                }
-                        }
-                }
+                        bool bModifiedOnly = true;
+                        Params->TryGetBoolField(TEXT("modifiedOnly"), bModifiedOnly);
 
-                return Plan;
-        }
-        else if (CommandType == TEXT("sequence.add_tracks") && Params.IsValid())
-        {
-                const TArray<TSharedPtr<FJsonValue>>* BindingsArray = nullptr;
-                if (Params->TryGetArrayField(TEXT("bindings"), BindingsArray) && BindingsArray)
-                {
-                        for (const TSharedPtr<FJsonValue>& BindingValue : *BindingsArray)
+                        const TArray<TSharedPtr<FJsonValue>>* Maps = nullptr;
+                        bool bAddedExplicit = false;
+                        if (Params->TryGetArrayField(TEXT("maps"), Maps) && Maps)
                         {
-                                if (!BindingValue.IsValid() || BindingValue->Type != EJson::Object)
-                                {
-                                        continue;
-                                }
-
-                                TSharedPtr<FJsonObject> BindingObject = BindingValue->AsObject();
-                                FString ActorPath;
-                                BindingObject->TryGetStringField(TEXT("actorPath"), ActorPath);
-
-                                const TArray<TSharedPtr<FJsonValue>>* TracksArray = nullptr;
-                                if (BindingObject->TryGetArrayField(TEXT("tracks"), TracksArray) && TracksArray)
+                                for (const TSharedPtr<FJsonValue>& Value : *Maps)
                                 {
-                                        for (const TSharedPtr<FJsonValue>& TrackValue : *TracksArray)
+                                        if (Value.IsValid() && Value->Type == EJson::String)
                                         {
-                                                if (!TrackValue.IsValid() || TrackValue->Type != EJson::Object)
-                                                {
-                                                        continue;
-                                                }
-
-                                                TSharedPtr<FJsonObject> TrackObject = TrackValue->AsObject();
-                                                FString TrackType;
-                                                TrackObject->TryGetStringField(TEXT("type"), TrackType);
-
-                                                FMutationAction Action;
-                                                Action.Op = TEXT("add_track");
-                                                if (!TrackType.IsEmpty())
+                                                FString MapPath = NormalizeContentPath(Value->AsString());
+                                                if (MapPath.Contains(TEXT(".")))
                                                 {
-                                                        Action.Args.Add(TEXT("type"), TrackType);
-                                                }
-                                                if (!ActorPath.IsEmpty())
-                                                {
-                                                        Action.Args.Add(TEXT("actor"), ActorPath);
+                                                        MapPath = FPackageName::ObjectPathToPackageName(MapPath);
                                                 }
 
-                                                if (TrackObject->HasTypedField<EJson::String>(TEXT("propertyPath")))
+                                                if (!MapPath.IsEmpty())
                                                 {
-                                                        Action.Args.Add(TEXT("property"), TrackObject->GetStringField(TEXT("propertyPath")));
+                                                        FMutationAction Action;
+                                                        Action.Op = TEXT("save_map");
+                                                        Action.Args.Add(TEXT("map"), MapPath);
+                                                        Action.Args.Add(TEXT("modifiedOnly"), bModifiedOnly ? TEXT("true") : TEXT("false"));
+                                                        Actions.Add(Action);
+                                                        bAddedExplicit = true;
                                                 }
-
-                                                Plan.Actions.Add(Action);
                                         }
                                 }
                         }
-                }
 
-                const TArray<TSharedPtr<FJsonValue>>* CameraCutsArray = nullptr;
-                if (Params->TryGetArrayField(TEXT("cameraCuts"), CameraCutsArray) && CameraCutsArray)
-                {
-                        for (const TSharedPtr<FJsonValue>& CutValue : *CameraCutsArray)
+                        if (!bAddedExplicit)
                         {
-                                if (!CutValue.IsValid() || CutValue->Type != EJson::Object)
-                                {
-                                        continue;
-                                }
-
-                                TSharedPtr<FJsonObject> CutObject = CutValue->AsObject();
                                 FMutationAction Action;
-                                Action.Op = TEXT("add_camera_cut");
-
-                                if (CutObject->HasTypedField<EJson::Number>(TEXT("frameStart")))
-                                {
-                                        Action.Args.Add(TEXT("from"), FString::FromInt(static_cast<int32>(CutObject->GetNumberField(TEXT("frameStart")))));
-                                }
-                                else if (CutObject->HasTypedField<EJson::String>(TEXT("frameStart")))
-                                {
-                                        Action.Args.Add(TEXT("from"), CutObject->GetStringField(TEXT("frameStart")));
-                                }
-                                if (CutObject->HasTypedField<EJson::Number>(TEXT("frameEnd")))
-                                {
-                                        Action.Args.Add(TEXT("to"), FString::FromInt(static_cast<int32>(CutObject->GetNumberField(TEXT("frameEnd")))));
-                                }
-                                else if (CutObject->HasTypedField<EJson::String>(TEXT("frameEnd")))
-                                {
-                                        Action.Args.Add(TEXT("to"), CutObject->GetStringField(TEXT("frameEnd")));
-                                }
-                                if (CutObject->HasTypedField<EJson::String>(TEXT("cameraBindingId")))
-                                {
-                                        Action.Args.Add(TEXT("camera"), CutObject->GetStringField(TEXT("cameraBindingId")));
-                                }
-
-                                Plan.Actions.Add(Action);
+                                Action.Op = TEXT("save_map");
+                                Action.Args.Add(TEXT("scope"), TEXT("open"));
+                                Action.Args.Add(TEXT("modifiedOnly"), bModifiedOnly ? TEXT("true") : TEXT("false"));
+                                Actions.Add(Action);
                         }
-                }
 
-                return Plan;
-        }
-        else if (CommandType.StartsWith(TEXT("sc.")) && Params.IsValid())
-        {
-                const TArray<TSharedPtr<FJsonValue>>* AssetsArray = nullptr;
-                if (Params->TryGetArrayField(TEXT("assets"), AssetsArray))
-                {
-                        for (const TSharedPtr<FJsonValue>& Value : *AssetsArray)
+                        bool bSaveExternal = true;
+                        if (Params->TryGetBoolField(TEXT("saveExternalActors"), bSaveExternal) && bSaveExternal)
                         {
-                                if (Value->Type == EJson::String)
-                                {
-                                        FMutationAction AssetAction;
-                                        AssetAction.Op = CommandType;
-                                        AssetAction.Args.Add(TEXT("asset"), NormalizeContentPath(Value->AsString()));
-                                        Plan.Actions.Add(AssetAction);
-                                        bAddedSpecificActions = true;
-                                }
+                                FMutationAction ExtAction;
+                                ExtAction.Op = TEXT("save_external_actors");
+                                Actions.Add(ExtAction);
                         }
-                }
+                };
+        }
 
-                const TArray<TSharedPtr<FJsonValue>>* FilesArray = nullptr;
-                if (Params->TryGetArrayField(TEXT("files"), FilesArray))
+        {
+                FMutationSchema& Schema = Schemas.Add(TEXT("level.load"));
+                Schema.PathKeys = { MakePathKey(TEXT("mapPath"), /*bPackage=*/true) };
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
                 {
-                        for (const TSharedPtr<FJsonValue>& Value : *FilesArray)
+                        FMutationAction OpenAction;
+                        OpenAction.Op = TEXT("open_map");
+
+                        FString MapPath;
+                        if (Params->TryGetStringField(TEXT("mapPath"), MapPath))
                         {
-                                if (Value->Type == EJson::String)
+                                FString Normalized = NormalizeContentPath(MapPath);
+                                if (Normalized.Contains(TEXT(".")))
                                 {
-                                        FMutationAction FileAction;
-                                        FileAction.Op = CommandType;
-                                        FileAction.Args.Add(TEXT("file"), Value->AsString());
-                                        Plan.Actions.Add(FileAction);
-                                        bAddedSpecificActions = true;
+                                        Normalized = FPackageName::ObjectPathToPackageName(Normalized);
                                 }
+                                OpenAction.Args.Add(TEXT("path"), Normalized);
                         }
-                }
-        }
 
-        if (!bAddedSpecificActions)
-        {
-                FMutationAction Action;
-                Action.Op = CommandType;
+                        Actions.Add(OpenAction);
 
-                if (Params.IsValid())
-                {
-                        for (const auto& Pair : Params->Values)
+                        FString Mode(TEXT("none"));
+                        if (Params->TryGetStringField(TEXT("loadSublevels"), Mode))
                         {
-                                Action.Args.Add(Pair.Key, ValueToAuditString(Pair.Value));
+                                Mode = Mode.ToLower();
                         }
-                }
-
-                Plan.Actions.Add(Action);
-        }
-
-        return Plan;
-}
 
-TSharedPtr<FJsonObject> FWriteGate::BuildAuditJson(const FMutationPlan& Plan, bool bExecuted)
-{
-        TSharedPtr<FJsonObject> Audit = MakeShared<FJsonObject>();
-        Audit->SetBoolField(TEXT("mutation"), true);
-        Audit->SetBoolField(TEXT("dryRun"), Plan.bDryRun);
-        Audit->SetBoolField(TEXT("executed"), bExecuted);
-        Audit->SetStringField(TEXT("transaction"), GetTransactionName());
-        Audit->SetBoolField(TEXT("undoAvailable"), bExecuted);
+                        if (!Mode.IsEmpty() && Mode != TEXT("none"))
+                        {
+                                FMutationAction SublevelsAction;
+                                SublevelsAction.Op = TEXT("load_sublevels");
+                                SublevelsAction.Args.Add(TEXT("mode"), Mode);
 
-        TArray<TSharedPtr<FJsonValue>> Actions;
-        for (const FMutationAction& Action : Plan.Actions)
-        {
-                        TSharedPtr<FJsonObject> ActionObject = MakeShared<FJsonObject>();
-                        ActionObject->SetStringField(TEXT("op"), Action.Op);
+                                const TArray<TSharedPtr<FJsonValue>>* Sublevels = nullptr;
+                                if (Params->TryGetArrayField(TEXT("sublevels"), Sublevels) && Sublevels)
+                                {
+                                        SublevelsAction.Args.Add(TEXT("count"), FString::FromInt(Sublevels->Num()));
+                                }
 
-                        TSharedPtr<FJsonObject> ArgsObject = MakeShared<FJsonObject>();
-                        for (const auto& ArgPair : Action.Args)
-                        {
-                                ArgsObject->SetStringField(ArgPair.Key, ArgPair.Value);
+                                Actions.Add(SublevelsAction);
                         }
-                        ActionObject->SetObjectField(TEXT("args"), ArgsObject);
-                        Actions.Add(MakeShared<FJsonValueObject>(ActionObject));
+                };
         }
 
-        Audit->SetArrayField(TEXT("actions"), Actions);
-        return Audit;
-}
-
-const FString& FWriteGate::GetTransactionName()
-{
-        static const FString TransactionName(TransactionLabel);
-        return TransactionName;
-}
-
-bool FWriteGate::EnsureCheckoutForContentPath(const FString& ContentPath, TSharedPtr<FJsonObject>& OutError)
-{
-        const UUnrealMCPSettings* Settings = GetSettings();
-        if (!Settings || !Settings->RequireCheckout)
         {
-                return true;
+                FMutationSchema& Schema = Schemas.Add(TEXT("level.unload"));
+                Schema.LevelFallback = EMutationLevelPath::Persistent;
+                Schema.Actions = { MakeForEach(TEXT("unload"), TEXT("sublevels"), TEXT("name"), EMutationArg::String) };
         }
 
-        if (ContentPath.IsEmpty())
         {
-                return true;
+                FMutationSchema& Schema = Schemas.Add(TEXT("level.stream_sublevel"));
+                Schema.LevelFallback = EMutationLevelPath::Persistent;
+                Schema.Actions = { MakeAction(TEXT("stream"), {
+                        MakeArg(TEXT("target"), TEXT("name")),
+                        MakeArg(TEXT("load"), TEXT("load"), EMutationArg::Bool, TEXT("true"))
+                }) };
         }
 
-        FString PackagePath = ContentPath;
-        if (PackagePath.Contains(TEXT(".")))
         {
-                PackagePath = FPackageName::ObjectPathToPackageName(PackagePath);
+                FMutationSchema& Schema = Schemas.Add(TEXT("level.load_region"));
+                Schema.LevelFallback = EMutationLevelPath::Persistent;
+                Schema.Actions = { MakeAction(TEXT("load_region"), {
+                        MakeArg(TEXT("min"), TEXT("min"), EMutationArg::Array),
+                        MakeArg(TEXT("max"), TEXT("max"), EMutationArg::Array)
+                }) };
         }
 
-        if (!FPackageName::IsValidLongPackageName(PackagePath))
         {
-                return true;
+                FMutationSchema& Schema = Schemas.Add(TEXT("level.unload_region"));
+                Schema.LevelFallback = EMutationLevelPath::Persistent;
+                Schema.Actions = { MakeAction(TEXT("unload_region"), { MakeArg(TEXT("regionId"), TEXT("regionId")) }) };
         }
 
-        TArray<FString> AssetPaths;
-        AssetPaths.Add(PackagePath);
-
-        TArray<FString> Files;
-        FString ConversionError;
-        if (!FSourceControlService::AssetPathsToFiles(AssetPaths, Files, ConversionError))
+        Schemas.Add(TEXT("actor.spawn")).Actions = { MakeAction(TEXT("spawn"), {
+                MakeArg(TEXT("class"), TEXT("classPath")),
+                MakeArg(TEXT("location"), TEXT("location"), EMutationArg::Array),
+                MakeArg(TEXT("rotation"), TEXT("rotation"), EMutationArg::Array),
+                MakeArg(TEXT("scale"), TEXT("scale"), EMutationArg::Array),
+                MakeArg(TEXT("tags"), TEXT("tags"), EMutationArg::Array),
+                MakeArg(TEXT("select"), TEXT("select"), EMutationArg::Bool),
+                MakeArg(TEXT("deferred"), TEXT("deferred"), EMutationArg::Bool)
+        }) };
         {
-                OutError = MakeSourceControlRequiredError(ContentPath, ConversionError);
-                return false;
-        }
+                // One summary action; a per-actor plan for a 20k scatter would dwarf the command itself.
+                FMutationSchema& Schema = Schemas.Add(TEXT("actor.spawn_batch"));
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
+                {
+                        const TArray<TSharedPtr<FJsonValue>>* Locations = nullptr;
+                        int32 Count = 0;
+                        if (Params->TryGetArrayField(TEXT("locations"), Locations) && Locations->Num() > 0)
+                        {
+                                const bool bNested = (*Locations)[0].IsValid() && (*Locations)[0]->Type == EJson::Array;
+                                Count = bNested ? Locations->Num() : Locations->Num() / 3;
+                        }
 
-        if (Files.Num() == 0)
-        {
-                return true;
-        }
+                        TSet<FString> Classes;
+                        const TArray<TSharedPtr<FJsonValue>>* ClassPaths = nullptr;
+                        FString ClassPath;
+                        if (Params->TryGetArrayField(TEXT("classPaths"), ClassPaths))
+                        {
+                                for (const TSharedPtr<FJsonValue>& Value : *ClassPaths)
+                                {
+                                        if (Value.IsValid() && Value->TryGetString(ClassPath))
+                                        {
+                                                Classes.Add(ClassPath.TrimStartAndEnd());
+                                        }
+                                }
+                        }
+                        else if (Params->TryGetStringField(TEXT("classPath"), ClassPath))
+                        {
+                                Classes.Add(ClassPath.TrimStartAndEnd());
+                        }
 
-        TMap<FString, bool> PerFileResult;
-        FString CheckoutError;
-        if (!FSourceControlService::Checkout(Files, PerFileResult, CheckoutError))
-        {
-                OutError = MakeSourceControlRequiredError(ContentPath, CheckoutError);
-                return false;
+                        FMutationAction Action;
+                        Action.Op = TEXT("spawn_batch");
+                        Action.Args.Add(TEXT("count"), FString::FromInt(Count));
+                        Action.Args.Add(TEXT("classes"), FString::Join(Classes.Array(), TEXT(",")));
+                        Actions.Add(Action);
+                };
+        }
+        Schemas.Add(TEXT("actor.destroy")).Actions = { MakeForEach(TEXT("destroy"), TEXT("actors"), TEXT("actor"), EMutationArg::String, { MakeArg(TEXT("allowMissing"), TEXT("allowMissing"), EMutationArg::Bool) }) };
+        Schemas.Add(TEXT("actor.attach")).Actions = { MakeAction(TEXT("attach"), {
+                MakeArg(TEXT("child"), TEXT("child")),
+                MakeArg(TEXT("parent"), TEXT("parent")),
+                MakeArg(TEXT("socket"), TEXT("socketName")),
+                MakeArg(TEXT("keepWorldTransform"), TEXT("keepWorldTransform"), EMutationArg::Bool),
+                MakeArg(TEXT("weldSimulatedBodies"), TEXT("weldSimulatedBodies"), EMutationArg::Bool)
+        }) };
+        Schemas.Add(TEXT("actor.transform")).Actions = { MakeAction(TEXT("transform"), {
+                MakeArg(TEXT("actor"), TEXT("actor")),
+                MakeArg(TEXT("set"), TEXT("set"), EMutationArg::Object),
+                MakeArg(TEXT("add"), TEXT("add"), EMutationArg::Object)
+        }) };
+        Schemas.Add(TEXT("actor.transform_batch")).Actions = { MakeForEach(TEXT("transform"), TEXT("actors"), TEXT("actor"), EMutationArg::String) };
+        {
+                // Like spawn_batch, one summary action per call rather than one per instance.
+                const auto BuildInstanceActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
+                {
+                        constexpr int32 PackedTransformStride = 10;
+                        const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+                        FString Encoded;
+                        int32 Count = 0;
+                        if (Params->TryGetArrayField(TEXT("transforms"), Values))
+                        {
+                                Count = Values->Num() / PackedTransformStride;
+                        }
+                        else if (Params->TryGetStringField(TEXT("transformsBase64"), Encoded))
+                        {
+                                Count = static_cast<int32>(FBase64::GetDecodedDataSize(Encoded) / (sizeof(float) * PackedTransformStride));
+                        }
+
+                        FMutationAction Action;
+                        Action.Op = TEXT("add_instances");
+                        Action.Args.Add(TEXT("count"), FString::FromInt(Count));
+                        for (const TCHAR* Field : { TEXT("mesh"), TEXT("foliageType"), TEXT("actor"), TEXT("component") })
+                        {
+                                FString Value;
+                                if (Params->TryGetStringField(Field, Value) && !Value.TrimStartAndEnd().IsEmpty())
+                                {
+                                        Action.Args.Add(Field, Value.TrimStartAndEnd());
+                                }
+                        }
+                        Actions.Add(Action);
+                };
+                Schemas.Add(TEXT("foliage.add_instances")).BuildActions = BuildInstanceActions;
+                Schemas.Add(TEXT("ism.add_instances")).BuildActions = BuildInstanceActions;
         }
+        Schemas.Add(TEXT("actor.tag")).Actions = { MakeAction(TEXT("tag"), {
+                MakeArg(TEXT("actor"), TEXT("actor")),
+                MakeArg(TEXT("replace"), TEXT("replace"), EMutationArg::Value),
+                MakeArg(TEXT("add"), TEXT("add"), EMutationArg::Array),
+                MakeArg(TEXT("remove"), TEXT("remove"), EMutationArg::Array)
+        }) };
 
-        for (const TPair<FString, bool>& Pair : PerFileResult)
         {
-                if (!Pair.Value)
+                FMutationSchema& Schema = Schemas.Add(TEXT("content.fix_missing"));
+                Schema.PathKeys = { MakePathKey(TEXT("paths")) };
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
                 {
-                        OutError = MakeSourceControlRequiredError(ContentPath, CheckoutError);
-                        return false;
-                }
-        }
-
-        return true;
-}
+                        bool bRecursive = true;
+                        Params->TryGetBoolField(TEXT("recursive"), bRecursive);
 
-TSharedPtr<FJsonObject> FWriteGate::MakeSourceControlRequiredError(const FString& AssetPath, const FString& FailureMessage)
-{
-        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
-        Error->SetStringField(TEXT("code"), TEXT("SOURCE_CONTROL_REQUIRED"));
-        Error->SetStringField(TEXT("message"), TEXT("Asset must be checked out before mutation"));
-
-        TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
-        Details->SetStringField(TEXT("asset"), NormalizeContentPath(AssetPath));
-        if (!FailureMessage.IsEmpty())
-        {
-                Details->SetStringField(TEXT("reason"), FailureMessage);
-        }
+                        bool bFixRedirectors = true;
+                        bool bRemapReferences = true;
+                        bool bDeleteRedirectors = true;
 
-        Error->SetObjectField(TEXT("details"), Details);
-        return Error;
-}
+                        const TSharedPtr<FJsonObject>* FixObject = nullptr;
+                        if (Params->TryGetObjectField(TEXT("fix"), FixObject) && FixObject->IsValid())
+                        {
+                                (*FixObject)->TryGetBoolField(TEXT("redirectors"), bFixRedirectors);
+                                (*FixObject)->TryGetBoolField(TEXT("remapReferences"), bRemapReferences);
+                                (*FixObject)->TryGetBoolField(TEXT("deleteStaleRedirectors"), bDeleteRedirectors);
+                        }
 
-TSharedPtr<FJsonObject> FWriteGate::MakeWriteNotAllowedError(const FString& CommandType)
-{
-        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
-        Error->SetStringField(TEXT("code"), TEXT("WRITE_NOT_ALLOWED"));
-        Error->SetStringField(TEXT("message"), TEXT("Write operations are disabled (allowWrite=false)"));
-        TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
-        Details->SetStringField(TEXT("tool"), CommandType);
-        Error->SetObjectField(TEXT("details"), Details);
-        return Error;
-}
+                        const FString PathsSerialized = SerializeArrayField(Params, TEXT("paths"));
 
-TSharedPtr<FJsonObject> FWriteGate::MakePathNotAllowedError(const FString& Path, const FString& Reason)
-{
-        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
-        Error->SetStringField(TEXT("code"), TEXT("PATH_NOT_ALLOWED"));
-        Error->SetStringField(TEXT("message"), Reason);
-        TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
-        Details->SetStringField(TEXT("path"), NormalizeContentPath(Path));
-        Error->SetObjectField(TEXT("details"), Details);
-        return Error;
-}
+                        if (bFixRedirectors)
+                        {
+                                FMutationAction FixAction;
+                                FixAction.Op = TEXT("fix_redirectors");
+                                if (!PathsSerialized.IsEmpty())
+                                {
+                                        FixAction.Args.Add(TEXT("paths"), PathsSerialized);
+                                }
+                                FixAction.Args.Add(TEXT("recursive"), bRecursive ? TEXT("true") : TEXT("false"));
+                                Actions.Add(FixAction);
+                        }
 
-TSharedPtr<FJsonObject> FWriteGate::MakeToolNotAllowedError(const FString& CommandType, const FString& Reason)
-{
-        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
-        Error->SetStringField(TEXT("code"), TEXT("TOOL_DENIED"));
-        Error->SetStringField(TEXT("message"), Reason);
+                        if (bRemapReferences)
+                        {
+                                FMutationAction RemapAction;
+                                RemapAction.Op = TEXT("remap_soft_refs");
+                                if (!PathsSerialized.IsEmpty())
+                                {
+                                        RemapAction.Args.Add(TEXT("paths"), PathsSerialized);
+                                }
+                                Actions.Add(RemapAction);
+                        }
 
-        TSharedPtr<FJsonObject> Details = MakeShared<FJsonObject>();
-        Details->SetStringField(TEXT("tool"), CommandType);
-        Error->SetObjectField(TEXT("details"), Details);
-        return Error;
-}
+                        if (bDeleteRedirectors)
+                        {
+                                FMutationAction DeleteAction;
+                                DeleteAction.Op = TEXT("delete_redirectors");
+                                if (!PathsSerialized.IsEmpty())
+                                {
+                                        DeleteAction.Args.Add(TEXT("paths"), PathsSerialized);
+                                }
+                                Actions.Add(DeleteAction);
+                        }
 
-void FWriteGate::UpdateRemoteEnforcement(bool bAllowWrite, bool bDryRun, const TArray<FString>& AllowedPaths, const TArray<FString>& AllowedTools, const TArray<FString>& DeniedTools)
-{
-        FScopeLock Lock(&GRemoteStateMutex);
-        GRemoteAllowWrite = bAllowWrite;
-        GRemoteDryRun = bDryRun;
+                        if (Params->HasField(TEXT("save")))
+                        {
+                                FMutationAction SaveAction;
+                                SaveAction.Op = TEXT("save_packages");
+                                SaveAction.Args.Add(TEXT("save"), Params->GetBoolField(TEXT("save")) ? TEXT("true") : TEXT("false"));
+                                Actions.Add(SaveAction);
+                        }
 
-        GRemoteAllowedPaths.Reset();
-        for (const FString& Path : AllowedPaths)
-        {
-                const FString Normalized = NormalizeContentPath(Path);
-                if (!Normalized.IsEmpty())
-                {
-                        GRemoteAllowedPaths.AddUnique(Normalized);
-                }
+                };
         }
 
-        GRemoteAllowedTools.Reset();
-        for (const FString& Tool : AllowedTools)
         {
-                FString Normalized = Tool;
-                Normalized.TrimStartAndEndInline();
-                if (!Normalized.IsEmpty())
-                {
-                        GRemoteAllowedTools.AddUnique(Normalized);
-                }
+                FMutationSchema& Schema = Schemas.Add(TEXT("content.generate_thumbnails"));
+                Schema.PathKeys = { MakePathKey(TEXT("assets")) };
+                Schema.Actions = { MakeAction(TEXT("generate_thumbnails"), {
+                        MakeArg(TEXT("assets"), TEXT("assets"), EMutationArg::Array),
+                        MakeArg(TEXT("hiRes"), TEXT("hiRes"), EMutationArg::Bool),
+                        MakeArg(TEXT("save"), TEXT("save"), EMutationArg::Bool)
+                }) };
         }
 
-        GRemoteDeniedTools.Reset();
-        for (const FString& Tool : DeniedTools)
         {
-                FString Normalized = Tool;
-                Normalized.TrimStartAndEndInline();
-                if (!Normalized.IsEmpty())
+                FMutationSchema& Schema = Schemas.Add(TEXT("niagara.spawn_component"));
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
                 {
-                        GRemoteDeniedTools.AddUnique(Normalized);
-                }
-        }
-}
+                        FMutationAction Action;
+                        Action.Op = TEXT("spawn_niagara");
 
-FString FWriteGate::ResolvePathForCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
-{
-        if (!Params.IsValid())
-        {
-                return FString();
+                        FString SystemPath;
+                        if (Params->TryGetStringField(TEXT("systemPath"), SystemPath))
+                        {
+                                Action.Args.Add(TEXT("system"), SystemPath);
+                        }
+
+                        const TSharedPtr<FJsonObject>* AttachObject = nullptr;
+                        if (Params->TryGetObjectField(TEXT("attach"), AttachObject) && AttachObject && AttachObject->IsValid())
+                        {
+                                FString ActorPath;
+                                if ((*AttachObject)->TryGetStringField(TEXT("actorPath"), ActorPath))
+                                {
+                                        Action.Args.Add(TEXT("attachTo"), ActorPath);
+                                }
+
+                                FString SocketName;
+                                if ((*AttachObject)->TryGetStringField(TEXT("socketName"), SocketName) && !SocketName.IsEmpty())
+                                {
+                                        Action.Args.Add(TEXT("socket"), SocketName);
+                                }
+
+                                if ((*AttachObject)->HasTypedField<EJson::Boolean>(TEXT("keepWorldTransform")))
+                                {
+                                        Action.Args.Add(TEXT("keepWorld"), (*AttachObject)->GetBoolField(TEXT("keepWorldTransform")) ? TEXT("true") : TEXT("false"));
+                                }
+                        }
+                        else
+                        {
+                                const FString TransformString = SerializeObjectField(Params, TEXT("transform"));
+                                if (!TransformString.IsEmpty())
+                                {
+                                        Action.Args.Add(TEXT("transform"), TransformString);
+                                }
+                        }
+
+                        if (Params->HasTypedField<EJson::Boolean>(TEXT("autoActivate")))
+                        {
+                                Action.Args.Add(TEXT("autoActivate"), Params->GetBoolField(TEXT("autoActivate")) ? TEXT("true") : TEXT("false"));
+                        }
+
+                        if (Params->HasTypedField<EJson::Boolean>(TEXT("select")))
+                        {
+                                Action.Args.Add(TEXT("select"), Params->GetBoolField(TEXT("select")) ? TEXT("true") : TEXT("false"));
+                        }
+
+                        const FString InitialParamsString = SerializeObjectField(Params, TEXT("initialUserParams"));
+                        if (!InitialParamsString.IsEmpty())
+                        {
+                                Action.Args.Add(TEXT("params"), InitialParamsString);
+                        }
+
+                        Actions.Add(Action);
+                };
         }
 
-        if (CommandType == TEXT("level.save_open") && Params.IsValid())
         {
-                const TArray<TSharedPtr<FJsonValue>>* Maps = nullptr;
-                if (Params->TryGetArrayField(TEXT("maps"), Maps) && Maps)
+                FMutationSchema& Schema = Schemas.Add(TEXT("niagara.set_user_params"));
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
                 {
-                        for (const TSharedPtr<FJsonValue>& Value : *Maps)
+                        const TSharedPtr<FJsonObject>* SharedParams = nullptr;
+                        Params->TryGetObjectField(TEXT("params"), SharedParams);
+
+                        auto AddActions = [&Actions](const FString& ComponentPath, const TSharedPtr<FJsonObject>* ParamObject)
                         {
-                                if (Value.IsValid() && Value->Type == EJson::String)
+                                if (!ParamObject || !ParamObject->IsValid())
                                 {
-                                        FString MapPath = NormalizeContentPath(Value->AsString());
-                                        if (MapPath.Contains(TEXT(".")))
-                                        {
-                                                MapPath = FPackageName::ObjectPathToPackageName(MapPath);
-                                        }
+                                        return;
+                                }
 
-                                        if (!MapPath.IsEmpty())
+                                for (const auto& Pair : (*ParamObject)->Values)
+                                {
+                                        FMutationAction Action;
+                                        Action.Op = TEXT("set_user_param");
+                                        if (!ComponentPath.IsEmpty())
                                         {
-                                                return MapPath;
+                                                Action.Args.Add(TEXT("component"), ComponentPath);
                                         }
+                                        Action.Args.Add(TEXT("name"), Pair.Key);
+                                        Action.Args.Add(TEXT("value"), SerializeJsonValue(Pair.Value));
+                                        Actions.Add(Action);
                                 }
+                        };
+
+                        const TArray<TSharedPtr<FJsonValue>>* Components = nullptr;
+                        if (!Params->TryGetArrayField(TEXT("components"), Components) || !Components)
+                        {
+                                FString ComponentPath;
+                                Params->TryGetStringField(TEXT("componentPath"), ComponentPath);
+                                AddActions(ComponentPath, SharedParams);
+                                return;
                         }
-                }
 
-#if WITH_EDITOR
-                if (GEditor)
-                {
-                        if (UWorld* World = GEditor->GetEditorWorldContext().World())
+                        for (const TSharedPtr<FJsonValue>& Entry : *Components)
                         {
-                                if (ULevel* Level = World->PersistentLevel)
+                                const TSharedPtr<FJsonObject>* EntryObject = nullptr;
+                                if (Entry.IsValid() && Entry->Type == EJson::String)
                                 {
-                                        if (UPackage* Package = Level->GetOutermost())
-                                        {
-                                                return NormalizeContentPath(Package->GetName());
-                                        }
+                                        AddActions(Entry->AsString(), SharedParams);
+                                }
+                                else if (Entry.IsValid() && Entry->TryGetObject(EntryObject) && EntryObject && EntryObject->IsValid())
+                                {
+                                        FString ComponentPath;
+                                        (*EntryObject)->TryGetStringField(TEXT("componentPath"), ComponentPath);
+                                        const TSharedPtr<FJsonObject>* OwnParams = nullptr;
+                                        AddActions(ComponentPath, (*EntryObject)->TryGetObjectField(TEXT("params"), OwnParams) ? OwnParams : SharedParams);
                                 }
                         }
-                }
-#endif
+                };
+        }
+
+        Schemas.Add(TEXT("niagara.activate")).Actions = { MakeAction(TEXT("activate_niagara"), {
+                MakeArg(TEXT("component"), TEXT("componentPath")),
+                MakeArg(TEXT("reset"), TEXT("reset"), EMutationArg::Bool)
+        }) };
+        Schemas.Add(TEXT("niagara.deactivate")).Actions = { MakeAction(TEXT("deactivate_niagara"), {
+                MakeArg(TEXT("component"), TEXT("componentPath")),
+                MakeArg(TEXT("immediate"), TEXT("immediate"), EMutationArg::Bool)
+        }) };
+
+        {
+                FMutationSchema& Schema = Schemas.Add(TEXT("mi.create"));
+                Schema.PathKeys = { MakePathKey(TEXT("miPath")) };
+                Schema.Actions = { MakeAction(TEXT("create_mi"), {
+                        MakeArg(TEXT("parent"), TEXT("parent")),
+                        MakeArg(TEXT("dst"), TEXT("miPath"), EMutationArg::Path)
+                }) };
         }
 
-        if (CommandType == TEXT("level.load") && Params.IsValid())
         {
-                FString MapPath;
-                if (Params->TryGetStringField(TEXT("mapPath"), MapPath))
+                FMutationSchema& Schema = Schemas.Add(TEXT("mi.set_params"));
+                Schema.PathKeys = { MakePathKey(TEXT("miObjectPath")) };
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
                 {
-                        FString Normalized = NormalizeContentPath(MapPath);
-                        if (Normalized.Contains(TEXT(".")))
+                        FString MiObjectPath;
+                        if (Params->TryGetStringField(TEXT("miObjectPath"), MiObjectPath))
                         {
-                                Normalized = FPackageName::ObjectPathToPackageName(Normalized);
+                                FMutationAction TargetAction;
+                                TargetAction.Op = TEXT("mi_target");
+                                TargetAction.Args.Add(TEXT("mi"), NormalizeContentPath(MiObjectPath));
+                                Actions.Add(TargetAction);
                         }
 
-                        if (!Normalized.IsEmpty())
+                        if (Params->HasTypedField<EJson::Boolean>(TEXT("clearUnset")) && Params->GetBoolField(TEXT("clearUnset")))
                         {
-                                return Normalized;
+                                FMutationAction ClearAction;
+                                ClearAction.Op = TEXT("clear_overrides");
+                                Actions.Add(ClearAction);
                         }
-                }
-        }
 
-        if ((CommandType == TEXT("level.unload") || CommandType == TEXT("level.stream_sublevel")))
-        {
-#if WITH_EDITOR
-                if (GEditor)
-                {
-                        if (UWorld* World = GEditor->GetEditorWorldContext().World())
+                        const TSharedPtr<FJsonObject>* ScalarsObject = nullptr;
+                        if (Params->TryGetObjectField(TEXT("scalars"), ScalarsObject) && ScalarsObject && ScalarsObject->IsValid())
                         {
-                                if (ULevel* Level = World->PersistentLevel)
+                                for (const auto& Pair : (*ScalarsObject)->Values)
                                 {
-                                        if (UPackage* Package = Level->GetOutermost())
-                                        {
-                                                return NormalizeContentPath(Package->GetName());
-                                        }
+                                        FMutationAction Action;
+                                        Action.Op = TEXT("set_scalar");
+                                        Action.Args.Add(TEXT("name"), Pair.Key);
+                                        Action.Args.Add(TEXT("value"), ValueToAuditString(Pair.Value));
+                                        Actions.Add(Action);
                                 }
                         }
-                }
-#endif
-        }
 
-        if (CommandType == TEXT("camera.bookmark") && Params.IsValid())
-        {
-                FString Op;
-                if (Params->TryGetStringField(TEXT("op"), Op) && Op.Equals(TEXT("set"), ESearchCase::IgnoreCase))
-                {
-                        if (Params->HasTypedField<EJson::Boolean>(TEXT("persist")) && Params->GetBoolField(TEXT("persist")))
+                        const TSharedPtr<FJsonObject>* VectorsObject = nullptr;
+                        if (Params->TryGetObjectField(TEXT("vectors"), VectorsObject) && VectorsObject && VectorsObject->IsValid())
                         {
-#if WITH_EDITOR
-                                if (GEditor)
+                                for (const auto& Pair : (*VectorsObject)->Values)
                                 {
-                                        if (UWorld* World = GEditor->GetEditorWorldContext().World())
-                                        {
-                                                if (ULevel* Level = World->GetCurrentLevel())
-                                                {
-                                                        if (UPackage* Package = Level->GetOutermost())
-                                                        {
-                                                                return NormalizeContentPath(Package->GetName());
-                                                        }
-                                                }
-                                        }
+                                        FMutationAction Action;
+                                        Action.Op = TEXT("set_vector");
+                                        Action.Args.Add(TEXT("name"), Pair.Key);
+                                        Action.Args.Add(TEXT("value"), ValueToAuditString(Pair.Value));
+                                        Actions.Add(Action);
                                 }
-#endif
                         }
-                }
+
+                        const TSharedPtr<FJsonObject>* TexturesObject = nullptr;
+                        if (Params->TryGetObjectField(TEXT("textures"), TexturesObject) && TexturesObject && TexturesObject->IsValid())
+                        {
+                                for (const auto& Pair : (*TexturesObject)->Values)
+                                {
+                                        FMutationAction Action;
+                                        Action.Op = TEXT("set_texture");
+                                        Action.Args.Add(TEXT("name"), Pair.Key);
+                                        Action.Args.Add(TEXT("value"), ValueToAuditString(Pair.Value));
+                                        Actions.Add(Action);
+                                }
+                        }
+
+                        const TSharedPtr<FJsonObject>* SwitchesObject = nullptr;
+                        if (Params->TryGetObjectField(TEXT("switches"), SwitchesObject) && SwitchesObject && SwitchesObject->IsValid())
+                        {
+                                for (const auto& Pair : (*SwitchesObject)->Values)
+                                {
+                                        FMutationAction Action;
+                                        Action.Op = TEXT("set_switch");
+                                        Action.Args.Add(TEXT("name"), Pair.Key);
+                                        Action.Args.Add(TEXT("value"), ValueToAuditString(Pair.Value));
+                                        Actions.Add(Action);
+                                }
+                        }
+                };
         }
 
-        if (CommandType == TEXT("mi.batch_apply") && Params.IsValid())
         {
-                const TArray<TSharedPtr<FJsonValue>>* Targets = nullptr;
-                if (Params->TryGetArrayField(TEXT("targets"), Targets) && Targets)
+                FMutationSchema& Schema = Schemas.Add(TEXT("mi.batch_apply"));
+                Schema.PathKeys = { MakePathKey(TEXT("targets"), /*bPackage=*/true, TEXT("actorPath")) };
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
                 {
-                        for (const TSharedPtr<FJsonValue>& Value : *Targets)
+                        const TArray<TSharedPtr<FJsonValue>>* Targets = nullptr;
+                        if (Params->TryGetArrayField(TEXT("targets"), Targets) && Targets)
                         {
-                                if (Value.IsValid() && Value->Type == EJson::Object)
+                                for (const TSharedPtr<FJsonValue>& TargetValue : *Targets)
                                 {
-                                        const TSharedPtr<FJsonObject> TargetObject = Value->AsObject();
-                                        if (TargetObject.IsValid())
+                                        if (!TargetValue.IsValid() || TargetValue->Type != EJson::Object)
+                                        {
+                                                continue;
+                                        }
+
+                                        const TSharedPtr<FJsonObject> TargetObject = TargetValue->AsObject();
+                                        if (!TargetObject.IsValid())
+                                        {
+                                                continue;
+                                        }
+
+                                        FString ActorPath;
+                                        TargetObject->TryGetStringField(TEXT("actorPath"), ActorPath);
+
+                                        FString ComponentName;
+                                        TargetObject->TryGetStringField(TEXT("component"), ComponentName);
+
+                                        const TArray<TSharedPtr<FJsonValue>>* AssignArray = nullptr;
+                                        if (!TargetObject->TryGetArrayField(TEXT("assign"), AssignArray) || !AssignArray)
+                                        {
+                                                continue;
+                                        }
+
+                                        for (const TSharedPtr<FJsonValue>& AssignValue : *AssignArray)
                                         {
-                                                FString ActorPath;
-                                                if (TargetObject->TryGetStringField(TEXT("actorPath"), ActorPath))
+                                                if (!AssignValue.IsValid() || AssignValue->Type != EJson::Object)
                                                 {
-                                                        ActorPath.TrimStartAndEndInline();
-                                                        if (!ActorPath.IsEmpty())
-                                                        {
-                                                                const FString PackagePath = FPackageName::ObjectPathToPackageName(ActorPath);
-                                                                if (!PackagePath.IsEmpty())
-                                                                {
-                                                                        return NormalizeContentPath(PackagePath);
-                                                                }
-                                                        }
+                                                        continue;
+                                                }
+
+                                                const TSharedPtr<FJsonObject> AssignObject = AssignValue->AsObject();
+                                                if (!AssignObject.IsValid())
+                                                {
+                                                        continue;
                                                 }
+
+                                                FMutationAction Action;
+                                                Action.Op = TEXT("apply_mi");
+                                                if (!ActorPath.IsEmpty())
+                                                {
+                                                        Action.Args.Add(TEXT("actor"), ActorPath);
+                                                }
+
+                                                if (!ComponentName.IsEmpty())
+                                                {
+                                                        Action.Args.Add(TEXT("component"), ComponentName);
+                                                }
+
+                                                TSharedPtr<FJsonValue> SlotValue = AssignObject->TryGetField(TEXT("slot"));
+                                                if (SlotValue.IsValid())
+                                                {
+                                                        Action.Args.Add(TEXT("slot"), SerializeJsonValue(SlotValue));
+                                                }
+
+                                                FString MiPath;
+                                                if (AssignObject->TryGetStringField(TEXT("mi"), MiPath))
+                                                {
+                                                        Action.Args.Add(TEXT("mi"), MiPath);
+                                                }
+
+                                                Actions.Add(Action);
                                         }
                                 }
                         }
-                }
+                };
         }
 
-        if (CommandType == TEXT("mesh.remap_material_slots") && Params.IsValid())
         {
-                FString MeshObjectPath;
-                if (Params->TryGetStringField(TEXT("meshObjectPath"), MeshObjectPath))
+                FMutationSchema& Schema = Schemas.Add(TEXT("mesh.remap_material_slots"));
+                Schema.PathKeys = { MakePathKey(TEXT("meshObjectPath")), MakePathKey(TEXT("meshes"), false, TEXT("meshObjectPath")) };
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
                 {
-                        return NormalizeContentPath(MeshObjectPath);
-                }
-        }
+                        FString MeshObjectPath;
+                        Params->TryGetStringField(TEXT("meshObjectPath"), MeshObjectPath);
 
-        if (CommandType == TEXT("content.fix_missing") && Params.IsValid())
-        {
-                const TArray<TSharedPtr<FJsonValue>>* Paths = nullptr;
-                if (Params->TryGetArrayField(TEXT("paths"), Paths) && Paths)
-                {
-                        for (const TSharedPtr<FJsonValue>& Value : *Paths)
+                        const TSharedPtr<FJsonObject>* RenameObject = nullptr;
+                        if (Params->TryGetObjectField(TEXT("rename"), RenameObject) && RenameObject && (*RenameObject)->Values.Num() > 0)
                         {
-                                if (Value.IsValid() && Value->Type == EJson::String)
+                                FMutationAction Action;
+                                Action.Op = TEXT("rename_slots");
+                                if (!MeshObjectPath.IsEmpty())
                                 {
-                                        const FString Normalized = NormalizeContentPath(Value->AsString());
-                                        if (!Normalized.IsEmpty())
-                                        {
-                                                return Normalized;
-                                        }
+                                        Action.Args.Add(TEXT("mesh"), MeshObjectPath);
                                 }
+                                Action.Args.Add(TEXT("pairs"), SerializeObjectField(Params, TEXT("rename")));
+                                Actions.Add(Action);
                         }
-                }
-        }
 
-        if (CommandType == TEXT("content.generate_thumbnails") && Params.IsValid())
-        {
-                const TArray<TSharedPtr<FJsonValue>>* Assets = nullptr;
-                if (Params->TryGetArrayField(TEXT("assets"), Assets) && Assets)
-                {
-                        for (const TSharedPtr<FJsonValue>& Value : *Assets)
+                        const TArray<TSharedPtr<FJsonValue>>* ReorderArray = nullptr;
+                        if (Params->TryGetArrayField(TEXT("reorder"), ReorderArray) && ReorderArray && ReorderArray->Num() > 0)
                         {
-                                if (Value.IsValid() && Value->Type == EJson::String)
+                                FMutationAction Action;
+                                Action.Op = TEXT("reorder_slots");
+                                if (!MeshObjectPath.IsEmpty())
                                 {
-                                        const FString Normalized = NormalizeContentPath(Value->AsString());
-                                        if (!Normalized.IsEmpty())
-                                        {
-                                                return Normalized;
-                                        }
+                                        Action.Args.Add(TEXT("mesh"), MeshObjectPath);
                                 }
+                                Action.Args.Add(TEXT("order"), SerializeArrayField(Params, TEXT("reorder")));
+                                Actions.Add(Action);
                         }
-                }
+                };
         }
 
-        if (CommandType.StartsWith(TEXT("sc.")))
         {
-                const TArray<TSharedPtr<FJsonValue>>* AssetsArray = nullptr;
-                if (Params->TryGetArrayField(TEXT("assets"), AssetsArray))
+                FMutationSchema& Schema = Schemas.Add(TEXT("sequence.create"));
+                Schema.PathKeys = { MakePathKey(TEXT("sequencePath")) };
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
                 {
-                        for (const TSharedPtr<FJsonValue>& Value : *AssetsArray)
+                        FString SequencePath;
+                        const bool bHasPath = Params->TryGetStringField(TEXT("sequencePath"), SequencePath);
+                        const FString NormalizedPath = bHasPath ? NormalizeContentPath(SequencePath) : FString();
+
+                        const bool bOverwrite = Params->HasTypedField<EJson::Boolean>(TEXT("overwriteIfExists")) && Params->GetBoolField(TEXT("overwriteIfExists"));
+                        if (bOverwrite)
                         {
-                                if (Value->Type == EJson::String)
+                                FMutationAction DeleteAction;
+                                DeleteAction.Op = TEXT("delete_sequence");
+                                if (!NormalizedPath.IsEmpty())
                                 {
-                                        return NormalizeContentPath(Value->AsString());
+                                        DeleteAction.Args.Add(TEXT("path"), NormalizedPath);
                                 }
+                                Actions.Add(DeleteAction);
                         }
-                }
-        }
 
-        if (Params->HasTypedField<EJson::String>(TEXT("miPath")))
-        {
-                return NormalizeContentPath(Params->GetStringField(TEXT("miPath")));
-        }
+                        FMutationAction CreateAction;
+                        CreateAction.Op = TEXT("create_sequence");
+                        if (!NormalizedPath.IsEmpty())
+                        {
+                                CreateAction.Args.Add(TEXT("path"), NormalizedPath);
+                        }
+                        Actions.Add(CreateAction);
 
-        if (Params->HasTypedField<EJson::String>(TEXT("miObjectPath")))
-        {
-                return NormalizeContentPath(Params->GetStringField(TEXT("miObjectPath")));
-        }
+                        const bool bCreateCamera = Params->HasTypedField<EJson::Boolean>(TEXT("createCamera")) && Params->GetBoolField(TEXT("createCamera"));
+                        const bool bAddCameraCut = Params->HasTypedField<EJson::Boolean>(TEXT("addCameraCut")) && Params->GetBoolField(TEXT("addCameraCut"));
 
-        static const TArray<FString> CandidateKeys = {
-                TEXT("path"),
-                TEXT("asset_path"),
-                TEXT("asset"),
-                TEXT("objectPath"),
-                TEXT("fromObjectPath"),
-                TEXT("toPackagePath"),
-                TEXT("blueprint_path"),
-                TEXT("content_path"),
-                TEXT("target_path"),
-                TEXT("parent_path"),
-                TEXT("widget_path"),
-                TEXT("source_path"),
-                TEXT("package_path"),
-                TEXT("destPath"),
-                TEXT("sequencePath")
-        };
+                        if (bCreateCamera)
+                        {
+                                FMutationAction CameraAction;
+                                CameraAction.Op = TEXT("spawn_camera");
+                                FString CameraName;
+                                if (Params->TryGetStringField(TEXT("cameraName"), CameraName) && !CameraName.IsEmpty())
+                                {
+                                        CameraAction.Args.Add(TEXT("name"), CameraName);
+                                }
+                                Actions.Add(CameraAction);
 
-        for (const FString& Key : CandidateKeys)
-        {
-                if (Params->HasField(Key) && Params->HasTypedField<EJson::String>(Key))
-                {
-                        return NormalizeContentPath(Params->GetStringField(Key));
-                }
-        }
+                                if (bAddCameraCut)
+                                {
+                                        FMutationAction CutAction;
+                                        CutAction.Op = TEXT("add_camera_cut");
+                                        Actions.Add(CutAction);
+                                }
+                        }
 
-        // Some commands use "name" to represent a content path (e.g. blueprint creation)
-        if (CommandType.Contains(TEXT("blueprint")) && Params->HasTypedField<EJson::String>(TEXT("name")))
-        {
-                return NormalizeContentPath(Params->GetStringField(TEXT("name")));
+                        const TArray<TSharedPtr<FJsonValue>>* ActorsArray = nullptr;
+                        if (Params->TryGetArrayField(TEXT("bindActors"), ActorsArray) && ActorsArray)
+                        {
+                                for (const TSharedPtr<FJsonValue>& Value : *ActorsArray)
+                                {
+                                        if (Value.IsValid() && Value->Type == EJson::String)
+                                        {
+                                                FMutationAction BindAction;
+                                                BindAction.Op = TEXT("bind_actor");
+                                                BindAction.Args.Add(TEXT("actor"), Value->AsString());
+                                                Actions.Add(BindAction);
+                                        }
+                                }
+                        }
+                };
         }
 
-        if (Params->HasTypedField<EJson::String>(TEXT("widget_name")))
         {
-                return NormalizeContentPath(Params->GetStringField(TEXT("widget_name")));
+                FMutationSchema& Schema = Schemas.Add(TEXT("sequence.bind_actors"));
+                Schema.PathKeys = { MakePathKey(TEXT("sequencePath")) };
+                Schema.Actions = { MakeForEach(TEXT("bind"), TEXT("actorPaths"), TEXT("actor"), EMutationArg::String) };
         }
 
-        if (CommandType == TEXT("asset.delete") && Params.IsValid())
         {
-                const TArray<TSharedPtr<FJsonValue>>* ObjectPaths = nullptr;
-                if (Params->TryGetArrayField(TEXT("objectPaths"), ObjectPaths))
-                {
-                        for (const TSharedPtr<FJsonValue>& Value : *ObjectPaths)
-                        {
-                                if (Value->Type == EJson::String)
-                                {
-                                        return NormalizeContentPath(Value->AsString());
-                                }
-                        }
-                }
+                FMutationSchema& Schema = Schemas.Add(TEXT("sequence.unbind"));
+                Schema.PathKeys = { MakePathKey(TEXT("sequencePath")) };
+                Schema.Actions = {
+                        MakeForEach(TEXT("unbind"), TEXT("bindingIds"), TEXT("bindingId"), EMutationArg::String),
+                        MakeForEach(TEXT("unbind"), TEXT("actorPaths"), TEXT("actor"), EMutationArg::String)
+                };
         }
 
-        if (CommandType == TEXT("asset.fix_redirectors") && Params.IsValid())
         {
-                const TArray<TSharedPtr<FJsonValue>>* Paths = nullptr;
-                if (Params->TryGetArrayField(TEXT("paths"), Paths))
+                FMutationSchema& Schema = Schemas.Add(TEXT("sequence.add_tracks"));
+                Schema.PathKeys = { MakePathKey(TEXT("sequencePath")) };
+                Schema.BuildActions = [](const TSharedPtr<FJsonObject>& Params, TArray<FMutationAction>& Actions)
                 {
-                        for (const TSharedPtr<FJsonValue>& Value : *Paths)
+                        const TArray<TSharedPtr<FJsonValue>>* BindingsArray = nullptr;
+                        if (Params->TryGetArrayField(TEXT("bindings"), BindingsArray) && BindingsArray)
                         {
-                                if (Value->Type == EJson::String)
+                                for (const TSharedPtr<FJsonValue>& BindingValue : *BindingsArray)
                                 {
-                                        return NormalizeContentPath(Value->AsString());
+                                        if (!BindingValue.IsValid() || BindingValue->Type != EJson::Object)
+                                        {
+                                                continue;
+                                        }
+
+                                        TSharedPtr<FJsonObject> BindingObject = BindingValue->AsObject();
+                                        FString ActorPath;
+                                        BindingObject->TryGetStringField(TEXT("actorPath"), ActorPath);
+
+                                        const TArray<TSharedPtr<FJsonValue>>* TracksArray = nullptr;
+                                        if (BindingObject->TryGetArrayField(TEXT("tracks"), TracksArray) && TracksArray)
+                                        {
+                                                for (const TSharedPtr<FJsonValue>& TrackValue : *TracksArray)
+                                                {
+                                                        if (!TrackValue.IsValid() || TrackValue->Type != EJson::Object)
+                                                        {
+                                                                continue;
+                                                        }
+
+                                                        TSharedPtr<FJsonObject> TrackObject = TrackValue->AsObject();
+                                                        FString TrackType;
+                                                        TrackObject->TryGetStringField(TEXT("type"), TrackType);
+
+                                                        FMutationAction Action;
+                                                        Action.Op = TEXT("add_track");
+                                                        if (!TrackType.IsEmpty())
+                                                        {
+                                                                Action.Args.Add(TEXT("type"), TrackType);
+                                                        }
+                                                        if (!ActorPath.IsEmpty())
+                                                        {
+                                                                Action.Args.Add(TEXT("actor"), ActorPath);
+                                                        }
+
+                                                        if (TrackObject->HasTypedField<EJson::String>(TEXT("propertyPath")))
+                                                        {
+                                                                Action.Args.Add(TEXT("property"), TrackObject->GetStringField(TEXT("propertyPath")));
+                                                        }
+
+                                                        Actions.Add(Action);
+                                                }
+                                        }
                                 }
                         }
-                }
-        }
 
-        if (CommandType == TEXT("asset.save_all") && Params.IsValid())
-        {
-                const TArray<TSharedPtr<FJsonValue>>* Paths = nullptr;
-                if (Params->TryGetArrayField(TEXT("paths"), Paths))
-                {
-                        for (const TSharedPtr<FJsonValue>& Value : *Paths)
+                        const TArray<TSharedPtr<FJsonValue>>* CameraCutsArray = nullptr;
+                        if (Params->TryGetArrayField(TEXT("cameraCuts"), CameraCutsArray) && CameraCutsArray)
                         {
-                                if (Value->Type == EJson::String)
+                                for (const TSharedPtr<FJsonValue>& CutValue : *CameraCutsArray)
                                 {
-                                        return NormalizeContentPath(Value->AsString());
+                                        if (!CutValue.IsValid() || CutValue->Type != EJson::Object)
+                                        {
+                                                continue;
+                                        }
+
+                                        TSharedPtr<FJsonObject> CutObject = CutValue->AsObject();
+                                        FMutationAction Action;
+                                        Action.Op = TEXT("add_camera_cut");
+
+                                        if (CutObject->HasTypedField<EJson::Number>(TEXT("frameStart")))
+                                        {
+                                                Action.Args.Add(TEXT("from"), FString::FromInt(static_cast<int32>(CutObject->GetNumberField(TEXT("frameStart")))));
+                                        }
+                                        else if (CutObject->HasTypedField<EJson::String>(TEXT("frameStart")))
+                                        {
+                                                Action.Args.Add(TEXT("from"), CutObject->GetStringField(TEXT("frameStart")));
+                                        }
+                                        if (CutObject->HasTypedField<EJson::Number>(TEXT("frameEnd")))
+                                        {
+                                                Action.Args.Add(TEXT("to"), FString::FromInt(static_cast<int32>(CutObject->GetNumberField(TEXT("frameEnd")))));
+                                        }
+                                        else if (CutObject->HasTypedField<EJson::String>(TEXT("frameEnd")))
+                                        {
+                                                Action.Args.Add(TEXT("to"), CutObject->GetStringField(TEXT("frameEnd")));
+                                        }
+                                        if (CutObject->HasTypedField<EJson::String>(TEXT("cameraBindingId")))
+                                        {
+                                                Action.Args.Add(TEXT("camera"), CutObject->GetStringField(TEXT("cameraBindingId")));
+                                        }
+
+                                        Actions.Add(Action);
                                 }
                         }
-                }
+                };
         }
-
-        return FString();
 }
 
 FString FWriteGate::NormalizeContentPath(const FString& InPath)
@@ -0,0 +1,94 @@
+#include "Protocol/Attachments.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/ScopeLock.h"
+
+#include <atomic>
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+
+namespace
+{
+    const TCHAR* const ReferenceField = TEXT("$attachment");
+
+    struct FBinding
+    {
+        /** Guards against a new message reusing the address of a released one. */
+        TWeakPtr<FJsonObject> Message;
+        FAttachmentListPtr List;
+    };
+
+    FCriticalSection BindingsMutex;
+    TMap<const FJsonObject*, FBinding> Bindings;
+    /** Lets messages without attachments, nearly all of them, skip the lock. */
+    std::atomic<int32> BindingCount{0};
+
+    /** Drops bindings whose message has been released. Caller holds BindingsMutex. */
+    void PruneReleased()
+    {
+        for (auto It = Bindings.CreateIterator(); It; ++It)
+        {
+            if (!It.Value().Message.IsValid())
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+}
+
+TSharedRef<FJsonObject> FAttachments::MakeReference(int32 Index, int64 Bytes)
+{
+    TSharedRef<FJsonObject> Reference = MakeShared<FJsonObject>();
+    Reference->SetNumberField(ReferenceField, Index);
+    Reference->SetNumberField(TEXT("bytes"), static_cast<double>(Bytes));
+    return Reference;
+}
+
+int32 FAttachments::GetReferenceIndex(const FJsonObject& Object)
+{
+    int32 Index = INDEX_NONE;
+    return Object.TryGetNumberField(ReferenceField, Index) && Index >= 0 ? Index : INDEX_NONE;
+}
+
+void FAttachments::Bind(const TSharedRef<FJsonObject>& Message, FAttachmentListPtr List)
+{
+    FScopeLock Lock(&BindingsMutex);
+    // Released envelopes leave stale bindings behind; there are only ever a few (the sessions'
+    // remembered responses), so a sweep on every bind keeps the table at that size.
+    PruneReleased();
+    if (List.IsValid() && List->Num() > 0)
+    {
+        FBinding& Binding = Bindings.FindOrAdd(&Message.Get());
+        Binding.Message = Message;
+        Binding.List = MoveTemp(List);
+    }
+    else
+    {
+        Bindings.Remove(&Message.Get());
+    }
+    BindingCount.store(Bindings.Num(), std::memory_order_relaxed);
+}
+
+FAttachmentListPtr FAttachments::Find(const FJsonObject& Message)
+{
+    if (BindingCount.load(std::memory_order_relaxed) == 0)
+    {
+        return nullptr;
+    }
+
+    FScopeLock Lock(&BindingsMutex);
+    const FBinding* Binding = Bindings.Find(&Message);
+    if (!Binding)
+    {
+        return nullptr;
+    }
+    const TSharedPtr<FJsonObject> Bound = Binding->Message.Pin();
+    return Bound.Get() == &Message ? Binding->List : nullptr;
+}
+
+}
+}
@@ -0,0 +1,199 @@
+#include "Protocol/CommandContext.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+
+namespace
+{
+    // At most ten progress frames a second per request.
+    constexpr double MinProgressIntervalSeconds = 0.1;
+}
+
+FCommandContext* FCommandContext::ActiveContext = nullptr;
+
+FCommandContext::FCommandContext(const FString& InRequestId)
+    : RequestId(InRequestId)
+    , bCancelled(false)
+    , DeadlineUnixMs(0.0)
+    , Priority(ECommandPriority::Interactive)
+    , bHasPriority(false)
+    , Share(1.0f)
+    , bAuditRequested(false)
+    , bUndoFreeRequested(false)
+    , bPushAttachments(false)
+    , bAttachmentsAllowed(false)
+    , LastProgressSeconds(0.0)
+    , YieldDeadlineSeconds(0.0)
+    , bYielded(false)
+    , bSuspendable(false)
+{
+}
+
+TSharedRef<FJsonObject> FCommandContext::Attach(TArray<uint8>&& Bytes)
+{
+    check(bAttachmentsAllowed);
+    if (!Attachments.IsValid())
+    {
+        Attachments = MakeShared<FAttachmentList, ESPMode::ThreadSafe>();
+    }
+    const int64 Size = Bytes.Num();
+    const int32 Index = Attachments->Add(MoveTemp(Bytes));
+    return FAttachments::MakeReference(Index, Size);
+}
+
+FAttachmentListPtr FCommandContext::TakeAttachments()
+{
+    FAttachmentListPtr Taken = MoveTemp(Attachments);
+    Attachments.Reset();
+    return Taken;
+}
+
+const TArray<uint8>* FCommandContext::GetRequestAttachment(int32 Index) const
+{
+    return RequestAttachments.IsValid() && RequestAttachments->IsValidIndex(Index) ? &(*RequestAttachments)[Index] : nullptr;
+}
+
+void FCommandContext::MarkStarted()
+{
+    if (Timings.StartedSeconds <= 0.0)
+    {
+        Timings.StartedSeconds = FPlatformTime::Seconds();
+    }
+}
+
+void FCommandContext::AddHandlerSlice(double StartSeconds, double EndSeconds)
+{
+    if (Timings.HandlerStartSeconds <= 0.0)
+    {
+        Timings.HandlerStartSeconds = StartSeconds;
+    }
+    Timings.HandlerEndSeconds = EndSeconds;
+    Timings.HandlerSeconds += FMath::Max(EndSeconds - StartSeconds, 0.0);
+}
+
+void FCommandContext::AddMemorySlice(int64 StartUsedBytes, int64 PeakUsedBytes, int64 EndUsedBytes)
+{
+    if (StartUsedBytes <= 0)
+    {
+        return;
+    }
+
+    MemoryUse.PeakDeltaBytes = FMath::Max(MemoryUse.PeakDeltaBytes, MemoryUse.RetainedBytes + (PeakUsedBytes - StartUsedBytes));
+    MemoryUse.RetainedBytes += EndUsedBytes - StartUsedBytes;
+    MemoryUse.bMeasured = true;
+}
+
+bool FCommandContext::IsPastDeadline() const
+{
+    if (DeadlineUnixMs <= 0.0)
+    {
+        return false;
+    }
+
+    const FDateTime NowUtc = FDateTime::UtcNow();
+    const double NowUnixMs = static_cast<double>(NowUtc.ToUnixTimestamp()) * 1000.0 + NowUtc.GetMillisecond();
+    return NowUnixMs > DeadlineUnixMs;
+}
+
+void FCommandContext::ReportProgress(int32 Done, int32 Total, const FString& Phase)
+{
+    check(IsInGameThread());
+    if (!ProgressSink)
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    const bool bBoundary = Done <= 0 || Done >= Total || Phase != LastProgressPhase;
+    if (!bBoundary && Now - LastProgressSeconds < MinProgressIntervalSeconds)
+    {
+        return;
+    }
+    LastProgressSeconds = Now;
+    LastProgressPhase = Phase;
+
+    TSharedRef<FJsonObject> Frame = MakeShared<FJsonObject>();
+    Frame->SetStringField(TEXT("type"), TEXT("progress"));
+    Frame->SetStringField(TEXT("requestId"), RequestId);
+    Frame->SetNumberField(TEXT("done"), Done);
+    Frame->SetNumberField(TEXT("total"), Total);
+    Frame->SetStringField(TEXT("phase"), Phase);
+
+    TSharedPtr<FJsonObject> Meta = MakeShared<FJsonObject>();
+    Meta->SetStringField(TEXT("requestId"), RequestId);
+    Frame->SetObjectField(TEXT("meta"), Meta);
+
+    if (!ProgressSink(Frame))
+    {
+        // The client is gone; stop building frames nobody will read.
+        ProgressSink = nullptr;
+    }
+}
+
+bool FCommandContext::ShouldYield() const
+{
+    return YieldDeadlineSeconds > 0.0 && FPlatformTime::Seconds() >= YieldDeadlineSeconds;
+}
+
+void FCommandContext::Yield(TSharedRef<FResumeState> State)
+{
+    check(YieldDeadlineSeconds > 0.0);
+    ResumeState = MoveTemp(State);
+    bYielded = true;
+}
+
+void FCommandContext::Suspend(TSharedRef<FResumeState> State)
+{
+    check(bSuspendable);
+    ResumeState = MoveTemp(State);
+    bYielded = true;
+}
+
+bool FCommandContext::ConsumeYield()
+{
+    const bool bWasYielded = bYielded;
+    bYielded = false;
+    return bWasYielded;
+}
+
+FCommandContext* FCommandContext::GetActive()
+{
+    check(IsInGameThread());
+    return ActiveContext;
+}
+
+bool FCommandContext::IsActiveCancelled()
+{
+    const FCommandContext* Context = GetActive();
+    return Context && Context->IsCancelled();
+}
+
+void FCommandContext::ReportActiveProgress(int32 Done, int32 Total, const FString& Phase)
+{
+    if (FCommandContext* Context = GetActive())
+    {
+        Context->ReportProgress(Done, Total, Phase);
+    }
+}
+
+FCommandContext::FScopedActive::FScopedActive(FCommandContext* InContext)
+    : Previous(ActiveContext)
+{
+    check(IsInGameThread());
+    ActiveContext = InContext;
+}
+
+FCommandContext::FScopedActive::~FScopedActive()
+{
+    ActiveContext = Previous;
+}
+
+}
+}
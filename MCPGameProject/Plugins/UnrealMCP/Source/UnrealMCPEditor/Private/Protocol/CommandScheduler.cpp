@@ -0,0 +1,283 @@
+#include "Protocol/CommandScheduler.h"
+#include "CoreMinimal.h"
+
+#include "HAL/PlatformTime.h"
+#include "UnrealMCPLog.h"
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+
+namespace
+{
+    constexpr double DefaultBudgetSeconds = 0.008;
+
+    /** Until frames have measured it, assume one interactive command per 60 Hz frame. */
+    constexpr double InitialCostPerSecond = 60.0;
+
+    constexpr double MinCostPerSecond = 1.0;
+
+    /** Weight of the newest frame in CompletedCostPerSecond. */
+    constexpr double CostRateSmoothing = 0.1;
+}
+
+bool LexTryParseString(ECommandPriority& OutPriority, const TCHAR* Text)
+{
+    if (FCString::Stricmp(Text, TEXT("control")) == 0)
+    {
+        OutPriority = ECommandPriority::Control;
+        return true;
+    }
+    if (FCString::Stricmp(Text, TEXT("interactive")) == 0)
+    {
+        OutPriority = ECommandPriority::Interactive;
+        return true;
+    }
+    if (FCString::Stricmp(Text, TEXT("bulk")) == 0)
+    {
+        OutPriority = ECommandPriority::Bulk;
+        return true;
+    }
+    return false;
+}
+
+const TCHAR* LexToString(ECommandPriority Priority)
+{
+    switch (Priority)
+    {
+    case ECommandPriority::Control:
+        return TEXT("control");
+    case ECommandPriority::Bulk:
+        return TEXT("bulk");
+    default:
+        return TEXT("interactive");
+    }
+}
+
+FCommandScheduler::FCommandScheduler()
+    : CompletedCostPerSecond(InitialCostPerSecond)
+    , BudgetSeconds(DefaultBudgetSeconds)
+{
+}
+
+FCommandScheduler::~FCommandScheduler()
+{
+    Stop();
+}
+
+void FCommandScheduler::Start()
+{
+    check(IsInGameThread());
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCommandScheduler::Tick));
+    }
+}
+
+void FCommandScheduler::Stop()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    int32 Dropped = 0;
+    for (FLane& Lane : Lanes)
+    {
+        Dropped += Lane.QueuedCount.Set(0);
+        Lane.Inbox.Empty();
+        Lane.Flows.Reset();
+        Lane.NextFlow = 0;
+        Lane.SkippedFrames = 0;
+    }
+    QueuedCost.Set(0);
+    IdleStep = nullptr;
+    if (Dropped > 0)
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Dropped %d queued commands on shutdown"), Dropped);
+    }
+}
+
+void FCommandScheduler::SetBudgetMs(double InBudgetMs)
+{
+    BudgetSeconds = FMath::Max(InBudgetMs, 0.0) / 1000.0;
+}
+
+void FCommandScheduler::SetIdleStep(FIdleStep InIdleStep)
+{
+    check(IsInGameThread());
+    IdleStep = MoveTemp(InIdleStep);
+}
+
+void FCommandScheduler::Enqueue(ECommandPriority Priority, FStep Step, int32 Cost, const FString& SessionId, float Share)
+{
+    FLane& Lane = Lanes[FMath::Clamp(static_cast<int32>(Priority), 0, NumLanes - 1)];
+    Cost = FMath::Max(Cost, 0);
+    Lane.QueuedCount.Increment();
+    QueuedCost.Add(Cost);
+    Lane.Inbox.Enqueue(FQueuedStep{ MoveTemp(Step), Cost, SessionId, FMath::Clamp(Share, MinShare, MaxShare) });
+}
+
+int32 FCommandScheduler::GetQueuedCount() const
+{
+    int32 Total = 0;
+    for (const FLane& Lane : Lanes)
+    {
+        Total += Lane.QueuedCount.GetValue();
+    }
+    return Total;
+}
+
+int32 FCommandScheduler::GetQueuedCost() const
+{
+    return QueuedCost.GetValue();
+}
+
+double FCommandScheduler::EstimateDrainSeconds(int32 Cost) const
+{
+    // Frames spent inside one long yielding command complete nothing; the floor keeps the estimate finite.
+    const double Rate = FMath::Max(CompletedCostPerSecond.load(std::memory_order_relaxed), MinCostPerSecond);
+    return FMath::Max(Cost, 0) / Rate;
+}
+
+int32 FCommandScheduler::GetDefaultCost(ECommandPriority Priority)
+{
+    switch (Priority)
+    {
+    case ECommandPriority::Control:
+        return 0;
+    case ECommandPriority::Bulk:
+        return 8;
+    default:
+        return 1;
+    }
+}
+
+void FCommandScheduler::AdmitInbox(FLane& Lane)
+{
+    FQueuedStep Queued;
+    while (Lane.Inbox.Dequeue(Queued))
+    {
+        TUniquePtr<FFlow>* Found = Lane.Flows.FindByPredicate([&Queued](const TUniquePtr<FFlow>& Flow) { return Flow->SessionId == Queued.SessionId; });
+        FFlow* Flow = Found ? Found->Get() : Lane.Flows.Add_GetRef(MakeUnique<FFlow>()).Get();
+        Flow->SessionId = Queued.SessionId;
+        Flow->Share = Queued.Share;
+        Flow->Steps.Enqueue(MoveTemp(Queued));
+        Queued = FQueuedStep();
+    }
+}
+
+int32 FCommandScheduler::DrainLane(FLane& Lane, double SliceDeadline, int32 MaxSteps)
+{
+    AdmitInbox(Lane);
+
+    // Steps re-queued during this frame wait for the next one.
+    int32 Remaining = FMath::Min(Lane.QueuedCount.GetValue(), MaxSteps);
+    int32 Ran = 0;
+    while (Remaining > 0 && Lane.Flows.Num() > 0)
+    {
+        if (!Lane.Flows.IsValidIndex(Lane.NextFlow))
+        {
+            Lane.NextFlow = 0;
+        }
+        FFlow& Flow = *Lane.Flows[Lane.NextFlow];
+        if (!Flow.bCredited)
+        {
+            Flow.Deficit += Quantum * Flow.Share;
+            Flow.bCredited = true;
+        }
+
+        const FQueuedStep* Head = Flow.Steps.Peek();
+        if (Head->Cost > Flow.Deficit)
+        {
+            // Out of credit for this round; the rest waits for the session's next turn.
+            Flow.bCredited = false;
+            ++Lane.NextFlow;
+            continue;
+        }
+
+        FQueuedStep Queued;
+        Flow.Steps.Dequeue(Queued);
+        Flow.Deficit -= Queued.Cost;
+        --Remaining;
+        ++Ran;
+        if (Queued.Step(SliceDeadline))
+        {
+            Lane.QueuedCount.Decrement();
+            QueuedCost.Subtract(Queued.Cost);
+            CompletedCostThisTick += Queued.Cost;
+        }
+        else
+        {
+            // Behind whatever the session queued while it ran.
+            AdmitInbox(Lane);
+            Flow.Steps.Enqueue(MoveTemp(Queued));
+        }
+
+        if (Flow.Steps.IsEmpty())
+        {
+            // An idle session keeps no credit, so it cannot save up a burst.
+            Lane.Flows.RemoveAt(Lane.NextFlow);
+        }
+
+        if (FPlatformTime::Seconds() >= SliceDeadline)
+        {
+            break;
+        }
+    }
+    return Ran;
+}
+
+bool FCommandScheduler::Tick(float DeltaTime)
+{
+    const double SliceDeadline = FPlatformTime::Seconds() + BudgetSeconds;
+    bool bRanThisFrame[NumLanes] = {};
+    const bool bHadWork = QueuedCost.GetValue() > 0;
+    CompletedCostThisTick = 0;
+
+    // A lane that has waited too long gets one step before the higher lanes.
+    for (int32 Index = NumLanes - 1; Index > 0; --Index)
+    {
+        if (Lanes[Index].SkippedFrames >= MaxSkippedFrames)
+        {
+            bRanThisFrame[Index] = DrainLane(Lanes[Index], SliceDeadline, 1) > 0;
+            break;
+        }
+    }
+
+    for (int32 Index = 0; Index < NumLanes; ++Index)
+    {
+        // The first step of a frame always runs, even with no budget left.
+        const bool bAnyRan = bRanThisFrame[0] || bRanThisFrame[1] || bRanThisFrame[2];
+        if (bAnyRan && FPlatformTime::Seconds() >= SliceDeadline)
+        {
+            break;
+        }
+        bRanThisFrame[Index] |= DrainLane(Lanes[Index], SliceDeadline, MAX_int32) > 0;
+    }
+
+    for (int32 Index = 0; Index < NumLanes; ++Index)
+    {
+        FLane& Lane = Lanes[Index];
+        Lane.SkippedFrames = (bRanThisFrame[Index] || Lane.QueuedCount.GetValue() == 0) ? 0 : Lane.SkippedFrames + 1;
+    }
+
+    // Speculative work only gets what real commands left of the budget, and only when none wait.
+    if (IdleStep && GetQueuedCount() == 0 && FPlatformTime::Seconds() < SliceDeadline)
+    {
+        IdleStep(SliceDeadline);
+    }
+
+    // Idle frames say nothing about throughput; only frames that had costed work queued count.
+    if (bHadWork && DeltaTime > UE_KINDA_SMALL_NUMBER)
+    {
+        const double FrameRate = CompletedCostThisTick / static_cast<double>(DeltaTime);
+        const double Previous = CompletedCostPerSecond.load(std::memory_order_relaxed);
+        CompletedCostPerSecond.store(FMath::Lerp(Previous, FrameRate, CostRateSmoothing), std::memory_order_relaxed);
+    }
+    return true;
+}
+}
+}
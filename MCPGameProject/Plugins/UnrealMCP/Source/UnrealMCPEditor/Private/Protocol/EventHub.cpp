@@ -0,0 +1,476 @@
+#include "Protocol/EventHub.h"
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Commands/BlueprintCompileQueue.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Package.h"
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+namespace
+{
+    enum ETopic : int32
+    {
+        AssetAdded,
+        AssetRemoved,
+        AssetRenamed,
+        ActorAdded,
+        ActorDeleted,
+        ActorMoved,
+        PackageSaved,
+        BlueprintCompiled,
+        CacheInvalidated,
+        TopicCount
+    };
+
+    // Beyond this many distinct keys per topic in one frame the rest are only counted.
+    constexpr int32 MaxEventsPerTopicPerFrame = 1000;
+
+    int32 FindTopic(const FString& Name)
+    {
+        return FEventHub::GetTopicNames().IndexOfByPredicate([&Name](const FString& Candidate)
+        {
+            return Candidate.Equals(Name, ESearchCase::IgnoreCase);
+        });
+    }
+
+    TArray<TSharedPtr<FJsonValue>> MakeVectorArray(double X, double Y, double Z)
+    {
+        TArray<TSharedPtr<FJsonValue>> Values;
+        Values.Add(MakeShared<FJsonValueNumber>(X));
+        Values.Add(MakeShared<FJsonValueNumber>(Y));
+        Values.Add(MakeShared<FJsonValueNumber>(Z));
+        return Values;
+    }
+
+    TSharedRef<FJsonObject> MakeAssetEvent(const FAssetData& AssetData)
+    {
+        TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+        Event->SetStringField(TEXT("objectPath"), AssetData.GetObjectPathString());
+        Event->SetStringField(TEXT("packageName"), AssetData.PackageName.ToString());
+        Event->SetStringField(TEXT("class"), AssetData.AssetClassPath.GetAssetName().ToString());
+        return Event;
+    }
+
+    TSharedRef<FJsonObject> MakeActorEvent(const AActor* Actor, bool bIncludeTransform)
+    {
+        TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+        Event->SetStringField(TEXT("name"), Actor->GetName());
+        Event->SetStringField(TEXT("label"), Actor->GetActorLabel());
+        Event->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+        Event->SetStringField(TEXT("path"), Actor->GetPathName());
+        if (bIncludeTransform)
+        {
+            const FTransform Transform = Actor->GetActorTransform();
+            const FVector Location = Transform.GetLocation();
+            const FRotator Rotation = Transform.Rotator();
+            const FVector Scale = Transform.GetScale3D();
+            Event->SetArrayField(TEXT("location"), MakeVectorArray(Location.X, Location.Y, Location.Z));
+            Event->SetArrayField(TEXT("rotation"), MakeVectorArray(Rotation.Pitch, Rotation.Yaw, Rotation.Roll));
+            Event->SetArrayField(TEXT("scale"), MakeVectorArray(Scale.X, Scale.Y, Scale.Z));
+        }
+        return Event;
+    }
+
+    // PIE, preview and thumbnail worlds spawn and move actors constantly; only the edited level is interesting.
+    bool IsEditorActor(const AActor* Actor)
+    {
+        if (!IsValid(Actor))
+        {
+            return false;
+        }
+        const UWorld* World = Actor->GetWorld();
+        return World && World->WorldType == EWorldType::Editor;
+    }
+
+    bool IsAssetRegistryScanning()
+    {
+        const FAssetRegistryModule* Module = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry"));
+        return !Module || Module->Get().IsLoadingAssets();
+    }
+}
+
+const TArray<FString>& FEventHub::GetTopicNames()
+{
+    static const TArray<FString> Names = {
+        TEXT("asset.added"),
+        TEXT("asset.removed"),
+        TEXT("asset.renamed"),
+        TEXT("actor.added"),
+        TEXT("actor.deleted"),
+        TEXT("actor.moved"),
+        TEXT("package.saved"),
+        TEXT("blueprint.compiled"),
+        TEXT("cache.invalidated")
+    };
+    return Names;
+}
+
+FEventHub::FEventHub()
+    : bHasPending(false)
+    , NextSequence(1)
+    , LastCacheGeneration(INDEX_NONE)
+    , bStarted(false)
+{
+    PendingTopics.SetNum(TopicCount);
+}
+
+FEventHub::~FEventHub()
+{
+    Stop();
+}
+
+void FEventHub::Start()
+{
+    check(IsInGameThread());
+    if (bStarted)
+    {
+        return;
+    }
+    bStarted = true;
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddSP(this, &FEventHub::HandleAssetAdded);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddSP(this, &FEventHub::HandleAssetRemoved);
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddSP(this, &FEventHub::HandleAssetRenamed);
+
+    if (GEngine)
+    {
+        ActorAddedHandle = GEngine->OnLevelActorAdded().AddSP(this, &FEventHub::HandleActorAdded);
+        ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddSP(this, &FEventHub::HandleActorDeleted);
+    }
+    if (GEditor)
+    {
+        ActorMovedHandle = GEditor->OnActorMoved().AddSP(this, &FEventHub::HandleActorMoved);
+    }
+
+    PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddSP(this, &FEventHub::HandlePackageSaved);
+    BlueprintCompiledHandle = FBlueprintCompileQueue::Get().OnCompiled().AddSP(this, &FEventHub::HandleBlueprintCompiled);
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FEventHub::Flush));
+}
+
+void FEventHub::Stop()
+{
+    if (!bStarted)
+    {
+        return;
+    }
+    bStarted = false;
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+    if (FAssetRegistryModule* Module = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+    {
+        IAssetRegistry& AssetRegistry = Module->Get();
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+    }
+    if (GEngine)
+    {
+        GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+        GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+    }
+    if (GEditor)
+    {
+        GEditor->OnActorMoved().Remove(ActorMovedHandle);
+    }
+    UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+    FBlueprintCompileQueue::Get().OnCompiled().Remove(BlueprintCompiledHandle);
+
+    for (FPendingTopic& Pending : PendingTopics)
+    {
+        Pending = FPendingTopic();
+    }
+    bHasPending = false;
+}
+
+void FEventHub::Subscribe(const FString& SubscriberKey, const TArray<FString>& Topics, FEventSink Sink, TArray<FString>& OutUnknownTopics)
+{
+    uint32 AddedMask = 0;
+    for (const FString& Topic : Topics)
+    {
+        const int32 Index = FindTopic(Topic);
+        if (Index == INDEX_NONE)
+        {
+            OutUnknownTopics.Add(Topic);
+            continue;
+        }
+        AddedMask |= 1u << Index;
+    }
+
+    FScopeLock Lock(&SubscribersMutex);
+    FSubscriber& Subscriber = Subscribers.FindOrAdd(SubscriberKey);
+    Subscriber.TopicMask |= AddedMask;
+    Subscriber.Sink = MoveTemp(Sink);
+    RecomputeActiveMask();
+}
+
+void FEventHub::Unsubscribe(const FString& SubscriberKey, const TArray<FString>& Topics)
+{
+    FScopeLock Lock(&SubscribersMutex);
+    FSubscriber* Subscriber = Subscribers.Find(SubscriberKey);
+    if (!Subscriber)
+    {
+        return;
+    }
+
+    if (Topics.Num() == 0)
+    {
+        Subscribers.Remove(SubscriberKey);
+    }
+    else
+    {
+        for (const FString& Topic : Topics)
+        {
+            const int32 Index = FindTopic(Topic);
+            if (Index != INDEX_NONE)
+            {
+                Subscriber->TopicMask &= ~(1u << Index);
+            }
+        }
+        if (Subscriber->TopicMask == 0)
+        {
+            Subscribers.Remove(SubscriberKey);
+        }
+    }
+    RecomputeActiveMask();
+}
+
+TArray<FString> FEventHub::GetSubscribedTopics(const FString& SubscriberKey) const
+{
+    TArray<FString> Result;
+    FScopeLock Lock(&SubscribersMutex);
+    if (const FSubscriber* Subscriber = Subscribers.Find(SubscriberKey))
+    {
+        for (int32 Index = 0; Index < TopicCount; ++Index)
+        {
+            if (Subscriber->TopicMask & (1u << Index))
+            {
+                Result.Add(GetTopicNames()[Index]);
+            }
+        }
+    }
+    return Result;
+}
+
+void FEventHub::RecomputeActiveMask()
+{
+    // Caller holds SubscribersMutex.
+    uint32 Mask = 0;
+    for (const TPair<FString, FSubscriber>& Pair : Subscribers)
+    {
+        Mask |= Pair.Value.TopicMask;
+    }
+    ActiveTopicMask.Set(static_cast<int32>(Mask));
+}
+
+bool FEventHub::IsTopicActive(int32 Topic) const
+{
+    return (static_cast<uint32>(ActiveTopicMask.GetValue()) & (1u << Topic)) != 0;
+}
+
+void FEventHub::AddEvent(int32 Topic, const FString& Key, const TSharedRef<FJsonObject>& Event)
+{
+    FPendingTopic& Pending = PendingTopics[Topic];
+    if (const int32* Existing = Pending.IndexByKey.Find(Key))
+    {
+        Pending.Events[*Existing] = Event;
+        return;
+    }
+
+    if (Pending.Events.Num() >= MaxEventsPerTopicPerFrame)
+    {
+        ++Pending.Dropped;
+        return;
+    }
+
+    Pending.IndexByKey.Add(Key, Pending.Events.Add(Event));
+    bHasPending = true;
+}
+
+bool FEventHub::Flush(float DeltaTime)
+{
+    PollCacheGeneration();
+    if (!bHasPending)
+    {
+        return true;
+    }
+    bHasPending = false;
+
+    struct FTopicFrame
+    {
+        uint32 TopicBit;
+        TSharedRef<FJsonObject> Frame;
+    };
+    TArray<FTopicFrame> Frames;
+
+    for (int32 Topic = 0; Topic < TopicCount; ++Topic)
+    {
+        FPendingTopic& Pending = PendingTopics[Topic];
+        if (Pending.Events.Num() == 0)
+        {
+            continue;
+        }
+
+        TArray<TSharedPtr<FJsonValue>> EventValues;
+        EventValues.Reserve(Pending.Events.Num());
+        for (const TSharedPtr<FJsonObject>& Event : Pending.Events)
+        {
+            EventValues.Add(MakeShared<FJsonValueObject>(Event));
+        }
+
+        TSharedRef<FJsonObject> Frame = MakeShared<FJsonObject>();
+        Frame->SetStringField(TEXT("type"), TEXT("event"));
+        Frame->SetStringField(TEXT("topic"), GetTopicNames()[Topic]);
+        Frame->SetNumberField(TEXT("seq"), static_cast<double>(NextSequence++));
+        Frame->SetArrayField(TEXT("events"), EventValues);
+        if (Pending.Dropped > 0)
+        {
+            Frame->SetNumberField(TEXT("dropped"), Pending.Dropped);
+        }
+        Frames.Add({1u << Topic, Frame});
+
+        Pending = FPendingTopic();
+    }
+
+    TArray<TPair<uint32, FEventSink>> Sinks;
+    {
+        FScopeLock Lock(&SubscribersMutex);
+        for (const TPair<FString, FSubscriber>& Pair : Subscribers)
+        {
+            Sinks.Emplace(Pair.Value.TopicMask, Pair.Value.Sink);
+        }
+    }
+
+    if (Frames.Num() > 0 && Sinks.Num() > 0)
+    {
+        // Sinks encode and queue on the connection's writer; keep that off the editor frame.
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Frames = MoveTemp(Frames), Sinks = MoveTemp(Sinks)]()
+        {
+            for (const TPair<uint32, FEventSink>& Sink : Sinks)
+            {
+                for (const FTopicFrame& Frame : Frames)
+                {
+                    if ((Sink.Key & Frame.TopicBit) && !Sink.Value(Frame.Frame))
+                    {
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    return true;
+}
+
+void FEventHub::PollCacheGeneration()
+{
+    if (!CacheGenerationSource || !IsTopicActive(CacheInvalidated))
+    {
+        // Forgotten while nobody listens, so the next subscriber learns the current generation.
+        LastCacheGeneration = INDEX_NONE;
+        return;
+    }
+
+    // One event per frame however many edits bumped the generation; a play session reports -1.
+    const int64 Generation = CacheGenerationSource();
+    if (Generation != LastCacheGeneration)
+    {
+        LastCacheGeneration = Generation;
+        TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+        Event->SetNumberField(TEXT("generation"), static_cast<double>(Generation));
+        AddEvent(CacheInvalidated, TEXT("generation"), Event);
+    }
+}
+
+void FEventHub::HandleAssetAdded(const FAssetData& AssetData)
+{
+    // The startup scan reports every asset in the project; only changes after it are news.
+    if (IsTopicActive(AssetAdded) && !IsAssetRegistryScanning())
+    {
+        AddEvent(AssetAdded, AssetData.GetObjectPathString(), MakeAssetEvent(AssetData));
+    }
+}
+
+void FEventHub::HandleAssetRemoved(const FAssetData& AssetData)
+{
+    if (IsTopicActive(AssetRemoved))
+    {
+        AddEvent(AssetRemoved, AssetData.GetObjectPathString(), MakeAssetEvent(AssetData));
+    }
+}
+
+void FEventHub::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    if (IsTopicActive(AssetRenamed))
+    {
+        TSharedRef<FJsonObject> Event = MakeAssetEvent(AssetData);
+        Event->SetStringField(TEXT("oldObjectPath"), OldObjectPath);
+        AddEvent(AssetRenamed, AssetData.GetObjectPathString(), Event);
+    }
+}
+
+void FEventHub::HandleActorAdded(AActor* Actor)
+{
+    if (IsTopicActive(ActorAdded) && IsEditorActor(Actor))
+    {
+        AddEvent(ActorAdded, Actor->GetPathName(), MakeActorEvent(Actor, true));
+    }
+}
+
+void FEventHub::HandleActorDeleted(AActor* Actor)
+{
+    if (IsTopicActive(ActorDeleted) && IsEditorActor(Actor))
+    {
+        AddEvent(ActorDeleted, Actor->GetPathName(), MakeActorEvent(Actor, false));
+    }
+}
+
+void FEventHub::HandleActorMoved(AActor* Actor)
+{
+    if (IsTopicActive(ActorMoved) && IsEditorActor(Actor))
+    {
+        AddEvent(ActorMoved, Actor->GetPathName(), MakeActorEvent(Actor, true));
+    }
+}
+
+void FEventHub::HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+    // Cooking saves thousands of packages procedurally; agents only care about user saves.
+    if (!IsTopicActive(PackageSaved) || !Package || SaveContext.IsProceduralSave())
+    {
+        return;
+    }
+
+    TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+    Event->SetStringField(TEXT("packageName"), Package->GetName());
+    Event->SetStringField(TEXT("filename"), PackageFileName);
+    AddEvent(PackageSaved, Package->GetName(), Event);
+}
+
+void FEventHub::HandleBlueprintCompiled(const FBlueprintCompileQueue::FReport& Report)
+{
+    if (!IsTopicActive(BlueprintCompiled))
+    {
+        return;
+    }
+
+    AddEvent(BlueprintCompiled, Report.Path, Report.ToJson());
+}
+
+}
+}
@@ -0,0 +1,705 @@
+#include "Protocol/FrameCodec.h"
+#include "CoreMinimal.h"
+
+#include "CborReader.h"
+#include "CborWriter.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryReader.h"
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+namespace FrameCodec
+{
+namespace
+{
+    /** Deepest container nesting either decoder accepts; the handlers' params are far shallower. */
+    constexpr int32 MaxDecodeDepth = 64;
+
+    typedef TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>> FUtf8FrameWriter;
+    typedef TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>> FUtf8FrameWriterFactory;
+
+    void WriteCborNumber(FCborWriter& Writer, double Value)
+    {
+        // Integral values use CBOR's variable-length integers; other values use the narrowest
+        // float that round-trips, so keyframe data never goes through text formatting.
+        if (FMath::IsFinite(Value) && FMath::Abs(Value) < 9007199254740992.0 && FMath::FloorToDouble(Value) == Value)
+        {
+            Writer.WriteValue(static_cast<int64>(Value));
+        }
+        else if (static_cast<double>(static_cast<float>(Value)) == Value)
+        {
+            Writer.WriteValue(static_cast<float>(Value));
+        }
+        else
+        {
+            Writer.WriteValue(Value);
+        }
+    }
+
+    void WriteCborValue(FCborWriter& Writer, const TSharedPtr<FJsonValue>& Value);
+
+    void WriteCborObject(FCborWriter& Writer, const TSharedPtr<FJsonObject>& Object)
+    {
+        if (!Object.IsValid())
+        {
+            Writer.WriteNull();
+            return;
+        }
+
+        Writer.WriteContainerStart(ECborCode::Map, Object->Values.Num());
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object->Values)
+        {
+            Writer.WriteValue(Pair.Key);
+            WriteCborValue(Writer, Pair.Value);
+        }
+    }
+
+    void WriteCborValue(FCborWriter& Writer, const TSharedPtr<FJsonValue>& Value)
+    {
+        if (!Value.IsValid())
+        {
+            Writer.WriteNull();
+            return;
+        }
+
+        switch (Value->Type)
+        {
+        case EJson::String:
+            Writer.WriteValue(Value->AsString());
+            break;
+        case EJson::Number:
+            WriteCborNumber(Writer, Value->AsNumber());
+            break;
+        case EJson::Boolean:
+            Writer.WriteValue(Value->AsBool());
+            break;
+        case EJson::Array:
+        {
+            const TArray<TSharedPtr<FJsonValue>>& Items = Value->AsArray();
+            Writer.WriteContainerStart(ECborCode::Array, Items.Num());
+            for (const TSharedPtr<FJsonValue>& Item : Items)
+            {
+                WriteCborValue(Writer, Item);
+            }
+            break;
+        }
+        case EJson::Object:
+            WriteCborObject(Writer, Value->AsObject());
+            break;
+        case EJson::Null:
+        case EJson::None:
+        default:
+            Writer.WriteNull();
+            break;
+        }
+    }
+
+    TSharedPtr<FJsonValue> ReadCborValue(FCborReader& Reader, const FCborContext& Context, int32 Depth, FString& OutError);
+
+    bool ReadCborNext(FCborReader& Reader, FCborContext& Context, FString& OutError)
+    {
+        if (!Reader.ReadNext(Context) || Context.IsError())
+        {
+            OutError = TEXT("Truncated or invalid CBOR payload");
+            return false;
+        }
+        return true;
+    }
+
+    TSharedPtr<FJsonValue> ReadCborContainer(FCborReader& Reader, const FCborContext& Header, int32 Depth, FString& OutError)
+    {
+        if (Depth > MaxDecodeDepth)
+        {
+            OutError = TEXT("CBOR payload nested too deeply");
+            return nullptr;
+        }
+
+        const bool bIndefinite = Header.IsIndefiniteContainer();
+        const uint64 Length = bIndefinite ? 0 : Header.AsLength();
+        const bool bIsMap = Header.MajorType() == ECborCode::Map;
+
+        TArray<TSharedPtr<FJsonValue>> Items;
+        TSharedPtr<FJsonObject> Object = bIsMap ? MakeShared<FJsonObject>() : nullptr;
+
+        for (uint64 Index = 0; bIndefinite || Index < Length; ++Index)
+        {
+            FCborContext Context;
+            if (!ReadCborNext(Reader, Context, OutError))
+            {
+                return nullptr;
+            }
+            if (Context.IsBreak())
+            {
+                break;
+            }
+
+            if (bIsMap)
+            {
+                if (Context.MajorType() != ECborCode::TextString)
+                {
+                    OutError = TEXT("CBOR map keys must be text strings");
+                    return nullptr;
+                }
+                const FString Key = Context.AsString();
+
+                FCborContext ValueContext;
+                if (!ReadCborNext(Reader, ValueContext, OutError))
+                {
+                    return nullptr;
+                }
+                TSharedPtr<FJsonValue> Value = ReadCborValue(Reader, ValueContext, Depth + 1, OutError);
+                if (!Value.IsValid())
+                {
+                    return nullptr;
+                }
+                Object->SetField(Key, Value);
+            }
+            else
+            {
+                TSharedPtr<FJsonValue> Value = ReadCborValue(Reader, Context, Depth + 1, OutError);
+                if (!Value.IsValid())
+                {
+                    return nullptr;
+                }
+                Items.Add(Value);
+            }
+        }
+
+        if (bIsMap)
+        {
+            return MakeShared<FJsonValueObject>(Object);
+        }
+        return MakeShared<FJsonValueArray>(Items);
+    }
+
+    TSharedPtr<FJsonValue> ReadCborValue(FCborReader& Reader, const FCborContext& Context, int32 Depth, FString& OutError)
+    {
+        switch (Context.MajorType())
+        {
+        case ECborCode::Uint:
+            return MakeShared<FJsonValueNumber>(static_cast<double>(Context.AsUInt()));
+        case ECborCode::Int:
+            return MakeShared<FJsonValueNumber>(static_cast<double>(Context.AsInt()));
+        case ECborCode::TextString:
+            return MakeShared<FJsonValueString>(Context.AsString());
+        case ECborCode::Array:
+        case ECborCode::Map:
+            return ReadCborContainer(Reader, Context, Depth, OutError);
+        case ECborCode::Prim:
+            switch (Context.AdditionalValue())
+            {
+            case ECborCode::False:
+            case ECborCode::True:
+                return MakeShared<FJsonValueBoolean>(Context.AsBool());
+            case ECborCode::Null:
+            case ECborCode::Undefined:
+                return MakeShared<FJsonValueNull>();
+            case ECborCode::Value_4Bytes:
+                return MakeShared<FJsonValueNumber>(static_cast<double>(Context.AsFloat()));
+            case ECborCode::Value_8Bytes:
+                return MakeShared<FJsonValueNumber>(Context.AsDouble());
+            default:
+                break;
+            }
+            break;
+        default:
+            break;
+        }
+
+        OutError = TEXT("Unsupported CBOR item");
+        return nullptr;
+    }
+
+    /**
+     * Builds the DOM straight from the UTF-8 payload. FJsonSerializer over a TJsonReader would first
+     * widen the whole frame into an FString, then allocate a token string and a stack element per
+     * value; here each value costs its own node and, for strings, one FString built in place.
+     * Numbers become FJsonValueNumber, as in the CBOR decoder.
+     */
+    class FUtf8JsonParser
+    {
+    public:
+        FUtf8JsonParser(const uint8* Data, int32 Length)
+            : Begin(Data)
+            , Cursor(Data)
+            , End(Data + Length)
+        {
+        }
+
+        TSharedPtr<FJsonObject> ParseRoot(FString& OutError)
+        {
+            // A byte order mark is legal before the root.
+            if (End - Cursor >= 3 && Cursor[0] == 0xEF && Cursor[1] == 0xBB && Cursor[2] == 0xBF)
+            {
+                Cursor += 3;
+            }
+
+            SkipWhitespace();
+            TSharedPtr<FJsonObject> Root;
+            if (Cursor == End || *Cursor != '{')
+            {
+                Fail(TEXT("the payload is not an object"));
+            }
+            else
+            {
+                Root = ParseObject(0);
+                SkipWhitespace();
+                if (Root.IsValid() && Cursor != End)
+                {
+                    Fail(TEXT("unexpected data after the object"));
+                    Root.Reset();
+                }
+            }
+
+            if (!Root.IsValid())
+            {
+                OutError = Error;
+            }
+            return Root;
+        }
+
+    private:
+        const uint8* Begin;
+        const uint8* Cursor;
+        const uint8* End;
+        FString Error;
+
+        void Fail(const TCHAR* Reason)
+        {
+            if (Error.IsEmpty())
+            {
+                Error = FString::Printf(TEXT("Failed to parse JSON payload: %s at byte %d"), Reason, static_cast<int32>(Cursor - Begin));
+            }
+        }
+
+        void SkipWhitespace()
+        {
+            while (Cursor < End && (*Cursor == ' ' || *Cursor == '\n' || *Cursor == '\r' || *Cursor == '\t'))
+            {
+                ++Cursor;
+            }
+        }
+
+        bool Consume(uint8 Expected)
+        {
+            SkipWhitespace();
+            if (Cursor < End && *Cursor == Expected)
+            {
+                ++Cursor;
+                return true;
+            }
+            return false;
+        }
+
+        bool ConsumeLiteral(const ANSICHAR* Literal, int32 Length)
+        {
+            if (End - Cursor < Length || FMemory::Memcmp(Cursor, Literal, Length) != 0)
+            {
+                Fail(TEXT("invalid literal"));
+                return false;
+            }
+            Cursor += Length;
+            return true;
+        }
+
+        TSharedPtr<FJsonValue> ParseValue(int32 Depth)
+        {
+            SkipWhitespace();
+            if (Cursor == End)
+            {
+                Fail(TEXT("truncated value"));
+                return nullptr;
+            }
+
+            switch (*Cursor)
+            {
+            case '{':
+            {
+                TSharedPtr<FJsonObject> Object = ParseObject(Depth);
+                return Object.IsValid() ? MakeShared<FJsonValueObject>(Object) : nullptr;
+            }
+            case '[':
+                return ParseArray(Depth);
+            case '"':
+            {
+                FString Value;
+                return ParseString(Value) ? MakeShared<FJsonValueString>(MoveTemp(Value)) : nullptr;
+            }
+            case 't':
+                return ConsumeLiteral("true", 4) ? MakeShared<FJsonValueBoolean>(true) : nullptr;
+            case 'f':
+                return ConsumeLiteral("false", 5) ? MakeShared<FJsonValueBoolean>(false) : nullptr;
+            case 'n':
+                return ConsumeLiteral("null", 4) ? MakeShared<FJsonValueNull>() : nullptr;
+            default:
+                return ParseNumber();
+            }
+        }
+
+        TSharedPtr<FJsonObject> ParseObject(int32 Depth)
+        {
+            if (Depth > MaxDecodeDepth)
+            {
+                Fail(TEXT("nested too deeply"));
+                return nullptr;
+            }
+
+            ++Cursor;
+            TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+            if (Consume('}'))
+            {
+                return Object;
+            }
+
+            do
+            {
+                SkipWhitespace();
+                FString Key;
+                if (Cursor == End || *Cursor != '"')
+                {
+                    Fail(TEXT("expected a key"));
+                    return nullptr;
+                }
+                if (!ParseString(Key))
+                {
+                    return nullptr;
+                }
+                if (!Consume(':'))
+                {
+                    Fail(TEXT("expected ':'"));
+                    return nullptr;
+                }
+
+                TSharedPtr<FJsonValue> Value = ParseValue(Depth + 1);
+                if (!Value.IsValid())
+                {
+                    return nullptr;
+                }
+                // Like SetField, a repeated key keeps the last value.
+                Object->Values.Add(MoveTemp(Key), MoveTemp(Value));
+            }
+            while (Consume(','));
+
+            if (!Consume('}'))
+            {
+                Fail(TEXT("expected ',' or '}'"));
+                return nullptr;
+            }
+            return Object;
+        }
+
+        TSharedPtr<FJsonValue> ParseArray(int32 Depth)
+        {
+            if (Depth > MaxDecodeDepth)
+            {
+                Fail(TEXT("nested too deeply"));
+                return nullptr;
+            }
+
+            ++Cursor;
+            TArray<TSharedPtr<FJsonValue>> Items;
+            if (!Consume(']'))
+            {
+                do
+                {
+                    TSharedPtr<FJsonValue> Item = ParseValue(Depth + 1);
+                    if (!Item.IsValid())
+                    {
+                        return nullptr;
+                    }
+                    Items.Add(MoveTemp(Item));
+                }
+                while (Consume(','));
+
+                if (!Consume(']'))
+                {
+                    Fail(TEXT("expected ',' or ']'"));
+                    return nullptr;
+                }
+            }
+            return MakeShared<FJsonValueArray>(MoveTemp(Items));
+        }
+
+        bool ParseHex4(uint32& OutValue)
+        {
+            if (End - Cursor < 4)
+            {
+                return false;
+            }
+            OutValue = 0;
+            for (int32 Index = 0; Index < 4; ++Index)
+            {
+                const uint8 Char = *Cursor++;
+                uint32 Digit;
+                if (Char >= '0' && Char <= '9')
+                {
+                    Digit = Char - '0';
+                }
+                else if (Char >= 'a' && Char <= 'f')
+                {
+                    Digit = Char - 'a' + 10;
+                }
+                else if (Char >= 'A' && Char <= 'F')
+                {
+                    Digit = Char - 'A' + 10;
+                }
+                else
+                {
+                    return false;
+                }
+                OutValue = (OutValue << 4) | Digit;
+            }
+            return true;
+        }
+
+        /**
+         * Cursor is past the 'u' of an escape. A surrogate pair arrives as two escapes and is combined
+         * into one code point; a lone half, or an escaped U+0000 (which would end the FString early),
+         * is rejected.
+         */
+        bool ParseUnicodeEscape(FString& Out)
+        {
+            uint32 CodePoint = 0;
+            if (!ParseHex4(CodePoint))
+            {
+                Fail(TEXT("invalid \\u escape"));
+                return false;
+            }
+            if (CodePoint == 0)
+            {
+                Fail(TEXT("\\u0000 in string"));
+                return false;
+            }
+            if (CodePoint >= 0xDC00 && CodePoint <= 0xDFFF)
+            {
+                Fail(TEXT("unpaired low surrogate"));
+                return false;
+            }
+            if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF)
+            {
+                uint32 Low = 0;
+                if (End - Cursor < 2 || Cursor[0] != '\\' || Cursor[1] != 'u')
+                {
+                    Fail(TEXT("unpaired high surrogate"));
+                    return false;
+                }
+                Cursor += 2;
+                if (!ParseHex4(Low))
+                {
+                    Fail(TEXT("invalid \\u escape"));
+                    return false;
+                }
+                if (Low < 0xDC00 || Low > 0xDFFF)
+                {
+                    Fail(TEXT("unpaired high surrogate"));
+                    return false;
+                }
+                CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+            }
+
+            if (CodePoint < 0x80)
+            {
+                Out.AppendChar(static_cast<TCHAR>(CodePoint));
+                return true;
+            }
+
+            // Through UTF-8, so the code point lands correctly whether TCHAR is UTF-16 or UTF-32.
+            UTF8CHAR Encoded[4];
+            int32 EncodedLength;
+            if (CodePoint < 0x800)
+            {
+                Encoded[0] = static_cast<UTF8CHAR>(0xC0 | (CodePoint >> 6));
+                EncodedLength = 1;
+            }
+            else if (CodePoint < 0x10000)
+            {
+                Encoded[0] = static_cast<UTF8CHAR>(0xE0 | (CodePoint >> 12));
+                Encoded[1] = static_cast<UTF8CHAR>(0x80 | ((CodePoint >> 6) & 0x3F));
+                EncodedLength = 2;
+            }
+            else
+            {
+                Encoded[0] = static_cast<UTF8CHAR>(0xF0 | (CodePoint >> 18));
+                Encoded[1] = static_cast<UTF8CHAR>(0x80 | ((CodePoint >> 12) & 0x3F));
+                Encoded[2] = static_cast<UTF8CHAR>(0x80 | ((CodePoint >> 6) & 0x3F));
+                EncodedLength = 3;
+            }
+            Encoded[EncodedLength++] = static_cast<UTF8CHAR>(0x80 | (CodePoint & 0x3F));
+            Out.AppendChars(Encoded, EncodedLength);
+            return true;
+        }
+
+        /** Cursor is on the opening quote. Unescaped runs are converted from UTF-8 in one call each. */
+        bool ParseString(FString& Out)
+        {
+            ++Cursor;
+            const uint8* RunStart = Cursor;
+            while (Cursor < End)
+            {
+                const uint8 Char = *Cursor;
+                if (Char != '"' && Char != '\\' && Char >= 0x20)
+                {
+                    ++Cursor;
+                    continue;
+                }
+
+                if (Cursor > RunStart)
+                {
+                    Out.AppendChars(reinterpret_cast<const UTF8CHAR*>(RunStart), static_cast<int32>(Cursor - RunStart));
+                }
+                if (Char == '"')
+                {
+                    ++Cursor;
+                    return true;
+                }
+                if (Char < 0x20)
+                {
+                    Fail(TEXT("control character in string"));
+                    return false;
+                }
+
+                ++Cursor;
+                if (Cursor == End)
+                {
+                    break;
+                }
+                switch (*Cursor++)
+                {
+                case '"': Out.AppendChar(TEXT('"')); break;
+                case '\\': Out.AppendChar(TEXT('\\')); break;
+                case '/': Out.AppendChar(TEXT('/')); break;
+                case 'b': Out.AppendChar(TEXT('\b')); break;
+                case 'f': Out.AppendChar(TEXT('\f')); break;
+                case 'n': Out.AppendChar(TEXT('\n')); break;
+                case 'r': Out.AppendChar(TEXT('\r')); break;
+                case 't': Out.AppendChar(TEXT('\t')); break;
+                case 'u':
+                    if (!ParseUnicodeEscape(Out))
+                    {
+                        return false;
+                    }
+                    break;
+                default:
+                    Fail(TEXT("invalid escape"));
+                    return false;
+                }
+                RunStart = Cursor;
+            }
+
+            Fail(TEXT("unterminated string"));
+            return false;
+        }
+
+        TSharedPtr<FJsonValue> ParseNumber()
+        {
+            const uint8* Start = Cursor;
+            auto SkipDigits = [this]()
+            {
+                const uint8* DigitsStart = Cursor;
+                while (Cursor < End && *Cursor >= '0' && *Cursor <= '9')
+                {
+                    ++Cursor;
+                }
+                return Cursor > DigitsStart;
+            };
+
+            if (Cursor < End && *Cursor == '-')
+            {
+                ++Cursor;
+            }
+            // No leading zeros: "0" and "0.5" are numbers, "012" is not.
+            const uint8* IntegerStart = Cursor;
+            bool bValid = SkipDigits() && (*IntegerStart != '0' || Cursor - IntegerStart == 1);
+            if (bValid && Cursor < End && *Cursor == '.')
+            {
+                ++Cursor;
+                bValid = SkipDigits();
+            }
+            if (bValid && Cursor < End && (*Cursor == 'e' || *Cursor == 'E'))
+            {
+                ++Cursor;
+                if (Cursor < End && (*Cursor == '+' || *Cursor == '-'))
+                {
+                    ++Cursor;
+                }
+                bValid = SkipDigits();
+            }
+            if (!bValid)
+            {
+                Cursor = Start;
+                Fail(TEXT("invalid value"));
+                return nullptr;
+            }
+
+            // Atod needs a terminator; numbers are short enough for the inline buffer.
+            TArray<ANSICHAR, TInlineAllocator<64>> Text;
+            Text.Append(reinterpret_cast<const ANSICHAR*>(Start), static_cast<int32>(Cursor - Start));
+            Text.Add('\0');
+            return MakeShared<FJsonValueNumber>(FCStringAnsi::Atod(Text.GetData()));
+        }
+    };
+
+    TSharedPtr<FJsonObject> DecodeJson(const uint8* Data, int32 Length, FString& OutError)
+    {
+        FUtf8JsonParser Parser(Data, Length);
+        return Parser.ParseRoot(OutError);
+    }
+
+    TSharedPtr<FJsonObject> DecodeCbor(const uint8* Data, int32 Length, FString& OutError)
+    {
+        FMemoryReaderView Archive(TArrayView<const uint8>(Data, Length));
+        FCborReader Reader(&Archive, ECborEndianness::StandardCompliant);
+
+        FCborContext Context;
+        if (!ReadCborNext(Reader, Context, OutError))
+        {
+            return nullptr;
+        }
+        if (Context.MajorType() != ECborCode::Map)
+        {
+            OutError = TEXT("CBOR payload must be a map");
+            return nullptr;
+        }
+
+        TSharedPtr<FJsonValue> Root = ReadCborContainer(Reader, Context, 0, OutError);
+        return Root.IsValid() ? Root->AsObject() : nullptr;
+    }
+}
+
+bool Encode(const TSharedRef<FJsonObject>& Message, EFrameEncoding Encoding, FArchive& Archive, FString& OutError)
+{
+    if (Encoding == EFrameEncoding::Cbor)
+    {
+        FCborWriter Writer(&Archive, ECborEndianness::StandardCompliant);
+        WriteCborObject(Writer, Message);
+        return true;
+    }
+
+    TSharedRef<FUtf8FrameWriter> Writer = FUtf8FrameWriterFactory::Create(&Archive);
+    if (!FJsonSerializer::Serialize(Message, Writer, /*bCloseWriter=*/true))
+    {
+        OutError = TEXT("Failed to serialize JSON message");
+        return false;
+    }
+    return true;
+}
+
+TSharedPtr<FJsonObject> Decode(const uint8* Data, int32 Length, EFrameEncoding Encoding, FString& OutError)
+{
+    if (Encoding == EFrameEncoding::Cbor)
+    {
+        return DecodeCbor(Data, Length, OutError);
+    }
+    return DecodeJson(Data, Length, OutError);
+}
+
+}
+}
+}
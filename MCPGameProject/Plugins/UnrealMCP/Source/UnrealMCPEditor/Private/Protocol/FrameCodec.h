@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Protocol/Protocol.h"
+
+class FArchive;
+class FJsonObject;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+namespace FrameCodec
+{
+    /** Appends the encoded payload of Message to Archive using the given encoding. */
+    bool Encode(const TSharedRef<FJsonObject>& Message, EFrameEncoding Encoding, FArchive& Archive, FString& OutError);
+
+    /** Decodes a complete frame payload. Returns null and sets OutError on malformed input. */
+    TSharedPtr<FJsonObject> Decode(const uint8* Data, int32 Length, EFrameEncoding Encoding, FString& OutError);
+}
+}
+}
@@ -0,0 +1,256 @@
+#include "Protocol/JobRegistry.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Guid.h"
+#include "Misc/ScopeLock.h"
+#include "Protocol/CommandContext.h"
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+namespace
+{
+    constexpr double DefaultRetentionSeconds = 3600.0;
+
+    /** Copy of Source with each array field cut to [Offset, Offset + Limit); records the full lengths. */
+    TSharedRef<FJsonObject> PageArrays(const FJsonObject& Source, int32 Offset, int32 Limit, FJsonObject& OutLengths, int32& OutLongest)
+    {
+        TSharedRef<FJsonObject> Paged = MakeShared<FJsonObject>();
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Source.Values)
+        {
+            if (!Field.Value.IsValid() || Field.Value->Type != EJson::Array)
+            {
+                Paged->Values.Add(Field.Key, Field.Value);
+                continue;
+            }
+
+            const TArray<TSharedPtr<FJsonValue>>& Items = Field.Value->AsArray();
+            OutLengths.SetNumberField(Field.Key, Items.Num());
+            OutLongest = FMath::Max(OutLongest, Items.Num());
+
+            TArray<TSharedPtr<FJsonValue>> Page;
+            const int32 End = FMath::Min(Items.Num(), Offset + Limit);
+            for (int32 Index = Offset; Index < End; ++Index)
+            {
+                Page.Add(Items[Index]);
+            }
+            Paged->SetArrayField(Field.Key, Page);
+        }
+        return Paged;
+    }
+}
+
+FJobRegistry::FJobRegistry()
+    : RetentionSeconds(DefaultRetentionSeconds)
+{
+}
+
+void FJobRegistry::SetRetentionSeconds(double InRetentionSeconds)
+{
+    FScopeLock Lock(&Mutex);
+    RetentionSeconds = FMath::Max(InRetentionSeconds, 0.0);
+    PruneLocked(FPlatformTime::Seconds());
+}
+
+FString FJobRegistry::MakeJobId()
+{
+    return FString::Printf(TEXT("job-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits).ToLower());
+}
+
+void FJobRegistry::Add(const FString& JobId, const FString& CommandType, const TSharedRef<FCommandContext, ESPMode::ThreadSafe>& Context)
+{
+    FScopeLock Lock(&Mutex);
+    const double Now = FPlatformTime::Seconds();
+    PruneLocked(Now);
+
+    FJob& Job = Jobs.Add(JobId);
+    Job.CommandType = CommandType;
+    Job.Context = Context;
+    Job.CreatedSeconds = Now;
+}
+
+void FJobRegistry::SetProgress(const FString& JobId, int32 Done, int32 Total, const FString& Phase)
+{
+    FScopeLock Lock(&Mutex);
+    if (FJob* Job = Jobs.Find(JobId))
+    {
+        Job->Done = Done;
+        Job->Total = Total;
+        Job->Phase = Phase;
+    }
+}
+
+void FJobRegistry::Complete(const FString& JobId, const TSharedRef<FJsonObject>& Response)
+{
+    FScopeLock Lock(&Mutex);
+    FJob* Job = Jobs.Find(JobId);
+    if (!Job || Job->Response.IsValid())
+    {
+        return;
+    }
+
+    Job->Response = Response;
+    Job->FinishedSeconds = FPlatformTime::Seconds();
+    FinishedOrder.Emplace(JobId, Job->FinishedSeconds);
+    PruneLocked(Job->FinishedSeconds);
+}
+
+TSharedPtr<FJsonObject> FJobRegistry::Cancel(const FString& JobId)
+{
+    FScopeLock Lock(&Mutex);
+    const double Now = FPlatformTime::Seconds();
+    PruneLocked(Now);
+
+    const FJob* Job = Jobs.Find(JobId);
+    if (!Job)
+    {
+        return nullptr;
+    }
+
+    const bool bRunning = !Job->Response.IsValid();
+    if (bRunning)
+    {
+        Job->Context->Cancel();
+    }
+    TSharedRef<FJsonObject> Status = MakeStatusLocked(JobId, *Job, Now);
+    Status->SetBoolField(TEXT("cancelRequested"), bRunning);
+    return Status;
+}
+
+TSharedPtr<FJsonObject> FJobRegistry::GetStatus(const FString& JobId)
+{
+    FScopeLock Lock(&Mutex);
+    const double Now = FPlatformTime::Seconds();
+    PruneLocked(Now);
+
+    const FJob* Job = Jobs.Find(JobId);
+    return Job ? MakeStatusLocked(JobId, *Job, Now) : TSharedPtr<FJsonObject>();
+}
+
+TSharedPtr<FJsonObject> FJobRegistry::GetResultPage(const FString& JobId, int32 Offset, int32 Limit, FString& OutErrorCode)
+{
+    TSharedPtr<FJsonObject> Response;
+    TSharedPtr<FJsonObject> Status;
+    {
+        FScopeLock Lock(&Mutex);
+        const double Now = FPlatformTime::Seconds();
+        PruneLocked(Now);
+
+        const FJob* Job = Jobs.Find(JobId);
+        if (!Job)
+        {
+            OutErrorCode = TEXT("JOB_NOT_FOUND");
+            return nullptr;
+        }
+        if (!Job->Response.IsValid())
+        {
+            OutErrorCode = TEXT("JOB_NOT_FINISHED");
+            return nullptr;
+        }
+        Response = Job->Response;
+        Status = MakeStatusLocked(JobId, *Job, Now);
+    }
+
+    // Stored envelopes are never modified, so the page is cut outside the lock.
+    Offset = FMath::Max(Offset, 0);
+    Limit = FMath::Max(Limit, 1);
+    TSharedRef<FJsonObject> Lengths = MakeShared<FJsonObject>();
+    int32 Longest = 0;
+
+    TSharedRef<FJsonObject> Envelope = MakeShared<FJsonObject>();
+    Envelope->Values = Response->Values;
+    const TSharedPtr<FJsonObject>* Result = nullptr;
+    if (Response->TryGetObjectField(TEXT("result"), Result))
+    {
+        // Handlers nest their payload under data; page whichever level holds it.
+        const TSharedPtr<FJsonObject>* Data = nullptr;
+        if ((*Result)->TryGetObjectField(TEXT("data"), Data))
+        {
+            TSharedRef<FJsonObject> PagedResult = MakeShared<FJsonObject>();
+            PagedResult->Values = (*Result)->Values;
+            PagedResult->SetObjectField(TEXT("data"), PageArrays(**Data, Offset, Limit, *Lengths, Longest));
+            Envelope->SetObjectField(TEXT("result"), PagedResult);
+        }
+        else
+        {
+            Envelope->SetObjectField(TEXT("result"), PageArrays(**Result, Offset, Limit, *Lengths, Longest));
+        }
+    }
+
+    TSharedRef<FJsonObject> Page = MakeShared<FJsonObject>();
+    Page->SetNumberField(TEXT("offset"), Offset);
+    Page->SetNumberField(TEXT("limit"), Limit);
+    Page->SetNumberField(TEXT("total"), Longest);
+    Page->SetObjectField(TEXT("lengths"), Lengths);
+    if (Offset + Limit < Longest)
+    {
+        Page->SetNumberField(TEXT("nextOffset"), Offset + Limit);
+    }
+
+    Status->SetObjectField(TEXT("response"), Envelope);
+    Status->SetObjectField(TEXT("page"), Page);
+    return Status;
+}
+
+const TCHAR* FJobRegistry::GetState(const FJob& Job)
+{
+    if (!Job.Response.IsValid())
+    {
+        return Job.Context->GetTimings().StartedSeconds > 0.0 ? TEXT("running") : TEXT("queued");
+    }
+    if (Job.Context->IsCancelled())
+    {
+        return TEXT("cancelled");
+    }
+
+    bool bOk = false;
+    Job.Response->TryGetBoolField(TEXT("ok"), bOk);
+    return bOk ? TEXT("succeeded") : TEXT("failed");
+}
+
+TSharedRef<FJsonObject> FJobRegistry::MakeStatusLocked(const FString& JobId, const FJob& Job, double NowSeconds)
+{
+    TSharedRef<FJsonObject> Status = MakeShared<FJsonObject>();
+    Status->SetStringField(TEXT("jobId"), JobId);
+    Status->SetStringField(TEXT("type"), Job.CommandType);
+    Status->SetStringField(TEXT("state"), GetState(Job));
+
+    const double EndSeconds = Job.Response.IsValid() ? Job.FinishedSeconds : NowSeconds;
+    Status->SetNumberField(TEXT("elapsedMs"), FMath::RoundToInt64((EndSeconds - Job.CreatedSeconds) * 1000.0));
+
+    if (!Job.Phase.IsEmpty())
+    {
+        TSharedRef<FJsonObject> Progress = MakeShared<FJsonObject>();
+        Progress->SetNumberField(TEXT("done"), Job.Done);
+        Progress->SetNumberField(TEXT("total"), Job.Total);
+        Progress->SetStringField(TEXT("phase"), Job.Phase);
+        Status->SetObjectField(TEXT("progress"), Progress);
+    }
+
+    const TSharedPtr<FJsonObject>* Error = nullptr;
+    if (Job.Response.IsValid() && Job.Response->TryGetObjectField(TEXT("error"), Error))
+    {
+        Status->SetObjectField(TEXT("error"), *Error);
+    }
+    return Status;
+}
+
+void FJobRegistry::PruneLocked(double NowSeconds)
+{
+    int32 Expired = 0;
+    while (Expired < FinishedOrder.Num()
+        && (FinishedOrder.Num() - Expired > MaxFinished || NowSeconds - FinishedOrder[Expired].Value > RetentionSeconds))
+    {
+        Jobs.Remove(FinishedOrder[Expired].Key);
+        ++Expired;
+    }
+    if (Expired > 0)
+    {
+        FinishedOrder.RemoveAt(0, Expired);
+    }
+}
+}
+}
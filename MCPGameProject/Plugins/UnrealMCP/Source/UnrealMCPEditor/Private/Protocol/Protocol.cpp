@@ -1,16 +1,23 @@
 #include "Protocol/Protocol.h"
 #include "CoreMinimal.h"
 
+#include "Protocol/Attachments.h"
+#include "Protocol/FrameCodec.h"
+#include "Protocol/SharedMemoryRing.h"
+#include "Protocol/Transport.h"
+
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
+#include "HAL/PlatformProcess.h"
 #include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/Compression.h"
 #include "Misc/DateTime.h"
-#include "SocketSubsystem.h"
-#include "Sockets.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryWriter.h"
+#include "Settings/UnrealMCPRuntimeConfig.h"
 #include "UnrealMCPLog.h"
-#include "UnrealMCPSettings.h"
 
 namespace UnrealMCP
 {
@@ -20,32 +27,57 @@ namespace
 {
     constexpr uint32 MaxFrameSize = 4 * 1024 * 1024; // 4 MiB safety limit
     constexpr uint32 LegacyMaxSize = 512 * 1024;      // 512 KiB legacy payload guard
-
-    bool ShouldEmitVerbose()
+    constexpr int32 RetainedSendBufferBytes = 256 * 1024; // larger scratch buffers are released after use
+    constexpr uint32 CompressedFrameFlag = 0x80000000u;  // high bit of the length prefix
+    constexpr uint32 AttachmentFrameFlag = 0x40000000u;  // payload is [message][binary segments]
+    constexpr int32 CompressedSizeFieldBytes = sizeof(uint32); // uncompressed size precedes zlib data
+    constexpr int32 SharedMemoryThresholdBytes = 256 * 1024; // smaller payloads are cheaper inline
+    FThreadSafeCounter SharedMemoryRegionCounter;
+
+    /** Replaces the payload of an encoded frame with [uncompressed size][zlib data] if that is smaller. */
+    void TryCompressFrame(TArray<uint8>& InOutFrame, int32 PayloadSize, uint32 Flags)
     {
-        const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
-        return Settings && Settings->bEnableProtocolVerboseLogs;
+        int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, PayloadSize);
+        TArray<uint8> Compressed;
+        Compressed.SetNumUninitialized(sizeof(uint32) + CompressedSizeFieldBytes + CompressedSize);
+
+        if (!FCompression::CompressMemory(NAME_Zlib,
+                Compressed.GetData() + sizeof(uint32) + CompressedSizeFieldBytes, CompressedSize,
+                InOutFrame.GetData() + sizeof(uint32), PayloadSize))
+        {
+            return;
+        }
+
+        const int32 CompressedPayloadSize = CompressedSizeFieldBytes + CompressedSize;
+        if (CompressedPayloadSize >= PayloadSize)
+        {
+            return;
+        }
+
+        Compressed.SetNum(sizeof(uint32) + CompressedPayloadSize, EAllowShrinking::No);
+        const uint32 Length = static_cast<uint32>(CompressedPayloadSize) | CompressedFrameFlag | Flags;
+        const uint32 OriginalSize = static_cast<uint32>(PayloadSize);
+        FMemory::Memcpy(Compressed.GetData(), &Length, sizeof(uint32));
+        FMemory::Memcpy(Compressed.GetData() + sizeof(uint32), &OriginalSize, sizeof(uint32));
+        InOutFrame = MoveTemp(Compressed);
     }
 
-    FString GetSocketErrorMessage(const TCHAR* Operation)
+    bool ShouldEmitVerbose()
     {
-        ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-        const int32 ErrorCode = SocketSubsystem ? SocketSubsystem->GetLastErrorCode() : 0;
-        return FString::Printf(TEXT("%s failed (error %d)"), Operation, ErrorCode);
+        return FUnrealMCPRuntimeConfig::Get().bProtocolVerboseLogs;
     }
 
-    bool WaitForSocket(FSocket& Socket, ESocketWaitConditions::Type Condition, double TimeoutSeconds)
+    bool WaitForStream(IByteStream& Stream, EStreamWait Condition, double TimeoutSeconds)
     {
         if (TimeoutSeconds < 0.0)
         {
             TimeoutSeconds = 0.0;
         }
 
-        const FTimespan WaitTime = FTimespan::FromSeconds(TimeoutSeconds);
-        return Socket.Wait(Condition, WaitTime);
+        return Stream.Wait(Condition, TimeoutSeconds);
     }
 
-    bool ReadExact(FSocket& Socket, uint8* Buffer, int32 Length, double TimeoutSeconds, FString& OutError, bool& bOutTimeout, TArray<uint8>* OutAccumulated = nullptr)
+    bool ReadExact(IByteStream& Stream, uint8* Buffer, int32 Length, double TimeoutSeconds, FString& OutError, bool& bOutTimeout, TArray<uint8>* OutAccumulated = nullptr)
     {
         int32 TotalRead = 0;
         const double StartTime = FPlatformTime::Seconds();
@@ -54,7 +86,8 @@ namespace
         while (TotalRead < Length)
         {
             int32 BytesRead = 0;
-            if (Socket.Recv(Buffer + TotalRead, Length - TotalRead, BytesRead))
+            bool bWouldBlock = false;
+            if (Stream.Recv(Buffer + TotalRead, Length - TotalRead, BytesRead, bWouldBlock))
             {
                 if (BytesRead == 0)
                 {
@@ -71,8 +104,7 @@ namespace
                 continue;
             }
 
-            const int32 ErrorCode = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
-            if (ErrorCode == SE_EWOULDBLOCK)
+            if (bWouldBlock)
             {
                 const double Elapsed = FPlatformTime::Seconds() - StartTime;
                 const double Remaining = TimeoutSeconds - Elapsed;
@@ -83,7 +115,7 @@ namespace
                     return false;
                 }
 
-                if (!WaitForSocket(Socket, ESocketWaitConditions::WaitForRead, Remaining))
+                if (!WaitForStream(Stream, EStreamWait::Read, Remaining))
                 {
                     bOutTimeout = true;
                     OutError = TEXT("Read timed out");
@@ -93,14 +125,14 @@ namespace
                 continue;
             }
 
-            OutError = GetSocketErrorMessage(TEXT("Recv"));
+            OutError = Stream.DescribeLastError(TEXT("Recv"));
             return false;
         }
 
         return true;
     }
 
-    bool WriteAll(FSocket& Socket, const uint8* Data, int32 Length, double TimeoutSeconds, FString& OutError, bool& bOutTimeout)
+    bool WriteAll(IByteStream& Stream, const uint8* Data, int32 Length, double TimeoutSeconds, FString& OutError, bool& bOutTimeout)
     {
         int32 TotalWritten = 0;
         const double StartTime = FPlatformTime::Seconds();
@@ -109,7 +141,8 @@ namespace
         while (TotalWritten < Length)
         {
             int32 BytesSent = 0;
-            if (Socket.Send(Data + TotalWritten, Length - TotalWritten, BytesSent))
+            bool bWouldBlock = false;
+            if (Stream.Send(Data + TotalWritten, Length - TotalWritten, BytesSent, bWouldBlock))
             {
                 if (BytesSent == 0)
                 {
@@ -121,8 +154,7 @@ namespace
                 continue;
             }
 
-            const int32 ErrorCode = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
-            if (ErrorCode == SE_EWOULDBLOCK)
+            if (bWouldBlock)
             {
                 const double Elapsed = FPlatformTime::Seconds() - StartTime;
                 const double Remaining = TimeoutSeconds - Elapsed;
@@ -133,7 +165,7 @@ namespace
                     return false;
                 }
 
-                if (!WaitForSocket(Socket, ESocketWaitConditions::WaitForWrite, Remaining))
+                if (!WaitForStream(Stream, EStreamWait::Write, Remaining))
                 {
                     bOutTimeout = true;
                     OutError = TEXT("Write timed out");
@@ -143,13 +175,166 @@ namespace
                 continue;
             }
 
-            OutError = GetSocketErrorMessage(TEXT("Send"));
+            OutError = Stream.DescribeLastError(TEXT("Send"));
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Reserves the length prefix and encodes Message straight after it; the prefix is filled by
+     * FinalizeFrame. With attachments the payload becomes
+     *   [uint32 message size][message][uint32 count][count x uint32 size][segments]
+     * and the prefix slot already holds the attachment flag.
+     */
+    bool EncodeFramePayload(const TSharedRef<FJsonObject>& Message, TArray<uint8>& OutFrame, FString& OutError, const FFrameOptions& Options, const FAttachmentList* Attachments = nullptr)
+    {
+        const bool bAttachments = Attachments && Attachments->Num() > 0;
+        OutFrame.Reset();
+        OutFrame.AddZeroed(bAttachments ? 2 * sizeof(uint32) : sizeof(uint32));
+
+        FMemoryWriter Archive(OutFrame);
+        Archive.Seek(OutFrame.Num());
+        if (!FrameCodec::Encode(Message, Options.Encoding, Archive, OutError))
+        {
+            return false;
+        }
+        if (!bAttachments)
+        {
+            return true;
+        }
+
+        int64 FrameBytes = OutFrame.Num() + sizeof(uint32) * (1 + static_cast<int64>(Attachments->Num()));
+        for (const TArray<uint8>& Segment : *Attachments)
+        {
+            FrameBytes += Segment.Num();
+        }
+        if (FrameBytes - static_cast<int64>(sizeof(uint32)) > static_cast<int64>(MaxFrameSize))
+        {
+            OutError = TEXT("Payload exceeds maximum frame size");
+            return false;
+        }
+
+        const uint32 Flags = AttachmentFrameFlag;
+        const uint32 MessageSize = static_cast<uint32>(OutFrame.Num() - 2 * sizeof(uint32));
+        FMemory::Memcpy(OutFrame.GetData(), &Flags, sizeof(uint32));
+        FMemory::Memcpy(OutFrame.GetData() + sizeof(uint32), &MessageSize, sizeof(uint32));
+
+        OutFrame.Reserve(static_cast<int32>(FrameBytes));
+        const uint32 Count = static_cast<uint32>(Attachments->Num());
+        OutFrame.Append(reinterpret_cast<const uint8*>(&Count), sizeof(uint32));
+        for (const TArray<uint8>& Segment : *Attachments)
+        {
+            const uint32 SegmentSize = static_cast<uint32>(Segment.Num());
+            OutFrame.Append(reinterpret_cast<const uint8*>(&SegmentSize), sizeof(uint32));
+        }
+        for (const TArray<uint8>& Segment : *Attachments)
+        {
+            OutFrame.Append(Segment);
+        }
+        return true;
+    }
+
+    /** Splits a payload laid out by EncodeFramePayload into its message and segments. */
+    bool SplitAttachmentPayload(const uint8* Payload, uint32 PayloadLength, uint32& OutMessageSize, FAttachmentList& OutSegments, FString& OutError)
+    {
+        uint64 Offset = 0;
+        auto ReadUInt32 = [Payload, PayloadLength, &Offset](uint32& OutValue)
+        {
+            if (Offset + sizeof(uint32) > PayloadLength)
+            {
+                return false;
+            }
+            FMemory::Memcpy(&OutValue, Payload + Offset, sizeof(uint32));
+            Offset += sizeof(uint32);
+            return true;
+        };
+
+        uint32 Count = 0;
+        if (!ReadUInt32(OutMessageSize) || OutMessageSize == 0 || Offset + OutMessageSize > PayloadLength)
+        {
+            OutError = TEXT("Attachment frame has an invalid message size");
+            return false;
+        }
+        Offset += OutMessageSize;
+        if (!ReadUInt32(Count) || Offset + static_cast<uint64>(Count) * sizeof(uint32) > PayloadLength)
+        {
+            OutError = TEXT("Attachment frame has an invalid segment count");
+            return false;
+        }
+
+        TArray<uint32> Sizes;
+        Sizes.SetNumUninitialized(Count);
+        uint64 SegmentBytes = 0;
+        for (uint32& Size : Sizes)
+        {
+            ReadUInt32(Size);
+            SegmentBytes += Size;
+        }
+        if (Offset + SegmentBytes != PayloadLength)
+        {
+            OutError = TEXT("Attachment segment sizes do not match the frame");
+            return false;
+        }
+
+        OutSegments.Reset(Count);
+        for (const uint32 Size : Sizes)
+        {
+            OutSegments.Emplace(Payload + Offset, static_cast<int32>(Size));
+            Offset += Size;
+        }
+        return true;
+    }
+
+    /** Enforces the frame size limit, writes the length prefix and compresses if negotiated. */
+    bool FinalizeFrame(TArray<uint8>& InOutFrame, FString& OutError, const FFrameOptions& Options)
+    {
+        const int32 PayloadSize = InOutFrame.Num() - static_cast<int32>(sizeof(uint32));
+        if (PayloadSize > static_cast<int32>(MaxFrameSize))
+        {
+            OutError = TEXT("Payload exceeds maximum frame size");
             return false;
         }
 
+        // EncodeFramePayload leaves the attachment flag in the prefix slot; it survives compression.
+        uint32 Flags = 0;
+        FMemory::Memcpy(&Flags, InOutFrame.GetData(), sizeof(uint32));
+        Flags &= AttachmentFrameFlag;
+
+        const uint32 Length = static_cast<uint32>(PayloadSize) | Flags;
+        FMemory::Memcpy(InOutFrame.GetData(), &Length, sizeof(uint32));
+
+        if (Options.bCompression && PayloadSize >= Options.CompressionThreshold)
+        {
+            TryCompressFrame(InOutFrame, PayloadSize, Flags);
+        }
         return true;
     }
 
+    /** Sends an encoded frame and trims the scratch buffer afterwards. */
+    bool WriteEncodedFrame(IByteStream& Stream, TArray<uint8>& Frame, FString& OutError, double TimeoutSeconds)
+    {
+        // Header and payload go out in a single send so small responses stay one segment under TCP_NODELAY.
+        bool bTimedOut = false;
+        const bool bWritten = WriteAll(Stream, Frame.GetData(), Frame.Num(), TimeoutSeconds, OutError, bTimedOut);
+        if (!bWritten && bTimedOut)
+        {
+            OutError = TEXT("Timed out while writing frame");
+        }
+
+        if (Frame.Max() > RetainedSendBufferBytes)
+        {
+            Frame.Empty();
+        }
+        else
+        {
+            Frame.Reset();
+        }
+
+        return bWritten;
+    }
+
     bool TryParseJson(const FString& Text, TSharedPtr<FJsonObject>& OutObject)
     {
         TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
@@ -162,23 +347,101 @@ namespace
         return false;
     }
 
-    bool ReadLegacyPayload(FSocket& Socket, double TimeoutSeconds, TArray<uint8>& Buffer, FString& OutError, TSharedPtr<FJsonObject>& OutObject)
+    /**
+     * Tracks JSON nesting across arbitrary byte boundaries so a legacy (unframed) payload is parsed
+     * exactly once, when its top-level object closes. Only ASCII structural bytes matter, so UTF-8
+     * continuation bytes can be fed through unchanged.
+     */
+    struct FLegacyJsonScanner
+    {
+        int32 Depth = 0;
+        bool bInString = false;
+        bool bEscaped = false;
+        bool bStarted = false;
+
+        /** Feeds bytes; returns the index one past the closing brace of the top-level value, or INDEX_NONE. */
+        int32 Consume(const uint8* Data, int32 Length)
+        {
+            for (int32 Index = 0; Index < Length; ++Index)
+            {
+                const uint8 Byte = Data[Index];
+                if (bInString)
+                {
+                    if (bEscaped)
+                    {
+                        bEscaped = false;
+                    }
+                    else if (Byte == '\\')
+                    {
+                        bEscaped = true;
+                    }
+                    else if (Byte == '"')
+                    {
+                        bInString = false;
+                    }
+                    continue;
+                }
+
+                switch (Byte)
+                {
+                case '"':
+                    bInString = true;
+                    break;
+                case '{':
+                case '[':
+                    ++Depth;
+                    bStarted = true;
+                    break;
+                case '}':
+                case ']':
+                    if (--Depth == 0 && bStarted)
+                    {
+                        return Index + 1;
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+            return INDEX_NONE;
+        }
+
+        bool IsMalformed() const { return Depth < 0; }
+    };
+
+    bool ReadLegacyPayload(IByteStream& Stream, double TimeoutSeconds, TArray<uint8>& Buffer, FString& OutError, TSharedPtr<FJsonObject>& OutObject)
     {
         const double StartTime = FPlatformTime::Seconds();
-        while (Buffer.Num() < LegacyMaxSize)
+        FLegacyJsonScanner Scanner;
+        int32 Scanned = 0;
+
+        while (Buffer.Num() <= static_cast<int32>(LegacyMaxSize))
         {
-            // Attempt to parse with the bytes we have
-            Buffer.Add(0);
-            const FString Attempt = FString(UTF8_TO_TCHAR(reinterpret_cast<const char*>(Buffer.GetData())));
-            Buffer.Pop(false);
-            if (TryParseJson(Attempt, OutObject))
+            // Only scan the bytes that arrived since the last pass.
+            const int32 End = Scanner.Consume(Buffer.GetData() + Scanned, Buffer.Num() - Scanned);
+            if (Scanner.IsMalformed())
             {
-                return true;
+                OutError = TEXT("Malformed legacy payload");
+                return false;
             }
+            if (End != INDEX_NONE)
+            {
+                const int32 PayloadSize = Scanned + End;
+                const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Buffer.GetData()), PayloadSize);
+                if (TryParseJson(FString(Converter.Length(), Converter.Get()), OutObject))
+                {
+                    return true;
+                }
+
+                OutError = TEXT("Failed to parse legacy JSON payload");
+                return false;
+            }
+            Scanned = Buffer.Num();
 
             int32 BytesRead = 0;
-            uint8 Temp[256];
-            if (Socket.Recv(Temp, UE_ARRAY_COUNT(Temp), BytesRead))
+            bool bWouldBlock = false;
+            uint8 Temp[4096];
+            if (Stream.Recv(Temp, UE_ARRAY_COUNT(Temp), BytesRead, bWouldBlock))
             {
                 if (BytesRead == 0)
                 {
@@ -190,8 +453,7 @@ namespace
                 continue;
             }
 
-            const int32 ErrorCode = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
-            if (ErrorCode == SE_EWOULDBLOCK)
+            if (bWouldBlock)
             {
                 const double Elapsed = FPlatformTime::Seconds() - StartTime;
                 const double Remaining = TimeoutSeconds - Elapsed;
@@ -201,7 +463,7 @@ namespace
                     return false;
                 }
 
-                if (!WaitForSocket(Socket, ESocketWaitConditions::WaitForRead, Remaining))
+                if (!WaitForStream(Stream, EStreamWait::Read, Remaining))
                 {
                     OutError = TEXT("Legacy payload read timed out");
                     return false;
@@ -210,7 +472,7 @@ namespace
                 continue;
             }
 
-            OutError = GetSocketErrorMessage(TEXT("Recv"));
+            OutError = Stream.DescribeLastError(TEXT("Recv"));
             return false;
         }
 
@@ -247,11 +509,46 @@ FString LexToString(EProtocolErrorCode Code)
         return TEXT("UNSUPPORTED_MESSAGE");
     case EProtocolErrorCode::InternalError:
         return TEXT("INTERNAL_ERROR");
+    case EProtocolErrorCode::Cancelled:
+        return TEXT("CANCELLED");
+    case EProtocolErrorCode::DeadlineExceeded:
+        return TEXT("DEADLINE_EXCEEDED");
+    case EProtocolErrorCode::Overloaded:
+        return TEXT("OVERLOADED");
+    case EProtocolErrorCode::InvalidParams:
+        return TEXT("INVALID_PARAMS");
     default:
         return TEXT("INTERNAL_ERROR");
     }
 }
 
+FString LexToString(EFrameEncoding Encoding)
+{
+    switch (Encoding)
+    {
+    case EFrameEncoding::Cbor:
+        return TEXT("cbor");
+    case EFrameEncoding::Json:
+    default:
+        return TEXT("json");
+    }
+}
+
+bool LexTryParseString(EFrameEncoding& OutEncoding, const TCHAR* Buffer)
+{
+    if (FCString::Stricmp(Buffer, TEXT("cbor")) == 0)
+    {
+        OutEncoding = EFrameEncoding::Cbor;
+        return true;
+    }
+    if (FCString::Stricmp(Buffer, TEXT("json")) == 0)
+    {
+        OutEncoding = EFrameEncoding::Json;
+        return true;
+    }
+    return false;
+}
+
 TSharedRef<FJsonObject> MakeErrorResponse(EProtocolErrorCode Code, const FString& Message, const TSharedPtr<FJsonObject>& Details)
 {
     TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
@@ -270,53 +567,28 @@ TSharedRef<FJsonObject> MakeErrorResponse(EProtocolErrorCode Code, const FString
     return Root;
 }
 
-bool WriteFramedJson(FSocket& Socket, const TSharedRef<FJsonObject>& Message, FString& OutError, double TimeoutSeconds)
+bool EncodeFrame(const TSharedRef<FJsonObject>& Message, TArray<uint8>& OutFrame, FString& OutError, const FFrameOptions& Options)
 {
-    FString Serialized;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Serialized);
-    if (!FJsonSerializer::Serialize(Message, Writer, /*bCloseWriter=*/true))
-    {
-        OutError = TEXT("Failed to serialize JSON message");
-        return false;
-    }
-
-    FTCHARToUTF8 Converter(*Serialized);
-    const uint8* PayloadData = reinterpret_cast<const uint8*>(Converter.Get());
-    const int32 PayloadSize = Converter.Length();
-
-    if (PayloadSize > static_cast<int32>(MaxFrameSize))
-    {
-        OutError = TEXT("Payload exceeds maximum frame size");
-        return false;
-    }
-
-    uint8 Header[sizeof(uint32)];
-    const uint32 Length = static_cast<uint32>(PayloadSize);
-    FMemory::Memcpy(Header, &Length, sizeof(uint32));
+    return EncodeFramePayload(Message, OutFrame, OutError, Options) && FinalizeFrame(OutFrame, OutError, Options);
+}
 
-    bool bTimedOut = false;
-    if (!WriteAll(Socket, Header, sizeof(Header), TimeoutSeconds, OutError, bTimedOut))
+bool WriteFramedJson(IByteStream& Stream, const TSharedRef<FJsonObject>& Message, TArray<uint8>& ScratchBuffer, FString& OutError, double TimeoutSeconds, const FFrameOptions& Options)
+{
+    if (!EncodeFrame(Message, ScratchBuffer, OutError, Options))
     {
-        if (bTimedOut)
-        {
-            OutError = TEXT("Timed out while writing frame header");
-        }
         return false;
     }
 
-    if (!WriteAll(Socket, PayloadData, PayloadSize, TimeoutSeconds, OutError, bTimedOut))
-    {
-        if (bTimedOut)
-        {
-            OutError = TEXT("Timed out while writing frame payload");
-        }
-        return false;
-    }
+    return WriteEncodedFrame(Stream, ScratchBuffer, OutError, TimeoutSeconds);
+}
 
-    return true;
+bool WriteFramedJson(IByteStream& Stream, const TSharedRef<FJsonObject>& Message, FString& OutError, double TimeoutSeconds)
+{
+    TArray<uint8> ScratchBuffer;
+    return WriteFramedJson(Stream, Message, ScratchBuffer, OutError, TimeoutSeconds);
 }
 
-bool WriteLegacyJson(FSocket& Socket, const TSharedRef<FJsonObject>& Message, FString& OutError)
+bool WriteLegacyJson(IByteStream& Stream, const TSharedRef<FJsonObject>& Message, FString& OutError)
 {
     FString Serialized;
     TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Serialized);
@@ -327,17 +599,11 @@ bool WriteLegacyJson(FSocket& Socket, const TSharedRef<FJsonObject>& Message, FS
     }
 
     FTCHARToUTF8 Converter(*Serialized);
-    int32 BytesSent = 0;
-    if (!Socket.Send(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length(), BytesSent))
-    {
-        OutError = GetSocketErrorMessage(TEXT("Send"));
-        return false;
-    }
-
-    return true;
+    bool bTimedOut = false;
+    return WriteAll(Stream, reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length(), 5.0, OutError, bTimedOut);
 }
 
-FProtocolReadResult ReadFramedJson(FSocket& Socket, double TimeoutSeconds, bool bAllowLegacyFallback)
+FProtocolReadResult ReadFramedJson(IByteStream& Stream, double TimeoutSeconds, bool bAllowLegacyFallback, const FFrameOptions& Options)
 {
     FProtocolReadResult Result;
 
@@ -350,7 +616,7 @@ FProtocolReadResult ReadFramedJson(FSocket& Socket, double TimeoutSeconds, bool
         LegacyBuffer.Reserve(256);
     }
 
-    if (!ReadExact(Socket, Header, sizeof(Header), TimeoutSeconds, Error, bTimedOut, bAllowLegacyFallback ? &LegacyBuffer : nullptr))
+    if (!ReadExact(Stream, Header, sizeof(Header), TimeoutSeconds, Error, bTimedOut, bAllowLegacyFallback ? &LegacyBuffer : nullptr))
     {
         Result.Error = Error;
         Result.bTimeout = bTimedOut;
@@ -362,13 +628,26 @@ FProtocolReadResult ReadFramedJson(FSocket& Socket, double TimeoutSeconds, bool
     uint32 PayloadLength = 0;
     FMemory::Memcpy(&PayloadLength, Header, sizeof(uint32));
 
+    // The flag bit only has meaning once compression is negotiated; before that an oversized
+    // length still routes to legacy detection.
+    const bool bCompressed = Options.bCompression && (PayloadLength & CompressedFrameFlag) != 0;
+    if (bCompressed)
+    {
+        PayloadLength &= ~CompressedFrameFlag;
+    }
+    const bool bHasAttachments = Options.bAttachments && (PayloadLength & AttachmentFrameFlag) != 0;
+    if (bHasAttachments)
+    {
+        PayloadLength &= ~AttachmentFrameFlag;
+    }
+
     if (PayloadLength > MaxFrameSize)
     {
         if (bAllowLegacyFallback)
         {
             Result.bLegacyFallback = true;
             TSharedPtr<FJsonObject> LegacyObject;
-            if (ReadLegacyPayload(Socket, TimeoutSeconds, LegacyBuffer, Error, LegacyObject))
+            if (ReadLegacyPayload(Stream, TimeoutSeconds, LegacyBuffer, Error, LegacyObject))
             {
                 Result.Message = LegacyObject;
                 Result.bSuccess = true;
@@ -393,8 +672,8 @@ FProtocolReadResult ReadFramedJson(FSocket& Socket, double TimeoutSeconds, bool
     }
 
     TArray<uint8> Payload;
-    Payload.SetNumUninitialized(PayloadLength + 1);
-    if (!ReadExact(Socket, Payload.GetData(), PayloadLength, TimeoutSeconds, Error, bTimedOut))
+    Payload.SetNumUninitialized(PayloadLength);
+    if (!ReadExact(Stream, Payload.GetData(), PayloadLength, TimeoutSeconds, Error, bTimedOut))
     {
         Result.Error = Error;
         Result.bTimeout = bTimedOut;
@@ -403,36 +682,90 @@ FProtocolReadResult ReadFramedJson(FSocket& Socket, double TimeoutSeconds, bool
         return Result;
     }
 
-    Payload[PayloadLength] = 0; // null terminate for safe conversion
-    const FString PayloadString = FString(UTF8_TO_TCHAR(reinterpret_cast<const char*>(Payload.GetData())));
+    if (bCompressed)
+    {
+        uint32 OriginalSize = 0;
+        if (PayloadLength <= static_cast<uint32>(CompressedSizeFieldBytes))
+        {
+            Result.Error = TEXT("Compressed frame too short");
+            return Result;
+        }
+        FMemory::Memcpy(&OriginalSize, Payload.GetData(), sizeof(uint32));
+        if (OriginalSize == 0 || OriginalSize > MaxFrameSize)
+        {
+            Result.Error = TEXT("Compressed frame expands beyond maximum size");
+            return Result;
+        }
+
+        TArray<uint8> Uncompressed;
+        Uncompressed.SetNumUninitialized(OriginalSize);
+        if (!FCompression::UncompressMemory(NAME_Zlib, Uncompressed.GetData(), OriginalSize,
+                Payload.GetData() + CompressedSizeFieldBytes, PayloadLength - CompressedSizeFieldBytes))
+        {
+            Result.Error = TEXT("Failed to decompress frame payload");
+            return Result;
+        }
+
+        Payload = MoveTemp(Uncompressed);
+        PayloadLength = OriginalSize;
+    }
 
-    TSharedPtr<FJsonObject> JsonObject;
-    if (!TryParseJson(PayloadString, JsonObject))
+    // Segments are split off after decompression, which covers the whole payload.
+    const uint8* MessageData = Payload.GetData();
+    uint32 MessageSize = PayloadLength;
+    TSharedPtr<FAttachmentList, ESPMode::ThreadSafe> Attachments;
+    if (bHasAttachments)
     {
-        Result.Error = TEXT("Failed to parse JSON payload");
+        Attachments = MakeShared<FAttachmentList, ESPMode::ThreadSafe>();
+        if (!SplitAttachmentPayload(Payload.GetData(), PayloadLength, MessageSize, *Attachments, Error))
+        {
+            Result.Error = Error;
+            return Result;
+        }
+        MessageData += sizeof(uint32);
+    }
+
+    TSharedPtr<FJsonObject> JsonObject = FrameCodec::Decode(MessageData, MessageSize, Options.Encoding, Error);
+    if (!JsonObject.IsValid())
+    {
+        Result.Error = Error;
         Result.bSuccess = false;
         return Result;
     }
+    if (Attachments.IsValid())
+    {
+        FAttachments::Bind(JsonObject.ToSharedRef(), Attachments);
+    }
 
     Result.Message = JsonObject;
+    Result.PayloadBytes = PayloadLength;
     Result.bSuccess = true;
     return Result;
 }
 
-FProtocolClient::FProtocolClient(const TSharedPtr<FSocket>& InSocket)
-    : Socket(InSocket)
+FProtocolClient::FProtocolClient(const FByteStreamPtr& InStream)
+    : Stream(InStream)
     , LastReceivedTime(NowSeconds())
     , LastSentTime(NowSeconds())
     , bHandshakeCompleted(false)
     , bLegacyDetected(false)
+    , WindowMax(1)
+    , bAllowBinaryEncoding(true)
+    , CompressionThresholdBytes(16 * 1024)
+    , SharedMemoryRingBytes(0)
+    , bSharedMemoryActive(false)
+{
+}
+
+FProtocolClient::~FProtocolClient()
 {
 }
 
 bool FProtocolClient::PerformHandshake(const FString& EngineVersion, const FString& PluginVersion, const FString& SessionId, FString& OutError, double TimeoutSeconds)
 {
-    if (!Socket.IsValid())
+    if (!Stream.IsValid())
     {
-        OutError = TEXT("Invalid socket for handshake");
+        OutError = TEXT("Invalid stream for handshake");
         return false;
     }
 
@@ -447,7 +780,7 @@ bool FProtocolClient::PerformHandshake(const FString& EngineVersion, const FStri
             ErrorDetails->SetStringField(TEXT("sessionId"), SessionId);
             TSharedRef<FJsonObject> ErrorResponse = MakeErrorResponse(EProtocolErrorCode::ProtocolVersionMismatch, TEXT("Protocol version 1 required."), ErrorDetails);
             FString LegacyError;
-            WriteLegacyJson(*Socket, ErrorResponse, LegacyError);
+            WriteLegacyJson(*Stream, ErrorResponse, LegacyError);
         }
         OutError = ReadResult.Error.IsEmpty() ? TEXT("Failed to read handshake message") : ReadResult.Error;
         return false;
@@ -481,7 +814,7 @@ bool FProtocolClient::PerformHandshake(const FString& EngineVersion, const FStri
         Details->SetNumberField(TEXT("got"), ProtocolVersion);
         TSharedRef<FJsonObject> ErrorResponse = MakeErrorResponse(EProtocolErrorCode::ProtocolVersionMismatch, TEXT("Protocol version 1 required."), Details);
         FString WriteError;
-        WriteFramedJson(*Socket, ErrorResponse, WriteError);
+        WriteFramedJson(*Stream, ErrorResponse, WriteError);
         OutError = TEXT("Protocol version mismatch");
         return false;
     }
@@ -498,24 +831,139 @@ bool FProtocolClient::PerformHandshake(const FString& EngineVersion, const FStri
         UE_LOG(LogUnrealMCP, Verbose, TEXT("[Protocol] Handshake received - Engine: %s, Plugin: %s, Session: %s"), *RemoteEngineVersion, *RemotePluginVersion, *RemoteSessionId);
     }
 
+    FString RequestedResumeToken;
+    Handshake->TryGetStringField(TEXT("resumeToken"), RequestedResumeToken);
+    FHandshakeSession Session;
+    Session.SessionId = SessionId;
+    if (SessionResolver)
+    {
+        Session = SessionResolver(RequestedResumeToken);
+    }
+
     TSharedRef<FJsonObject> Ack = MakeShared<FJsonObject>();
     Ack->SetStringField(TEXT("type"), TEXT("handshake/ack"));
     Ack->SetBoolField(TEXT("ok"), true);
     Ack->SetStringField(TEXT("serverVersion"), PluginVersion);
+    Ack->SetStringField(TEXT("sessionId"), Session.SessionId);
+    Ack->SetBoolField(TEXT("resume"), Session.bResumed);
+    if (!Session.ResumeToken.IsEmpty())
+    {
+        Ack->SetStringField(TEXT("resumeToken"), Session.ResumeToken);
+    }
 
     TArray<TSharedPtr<FJsonValue>> Capabilities;
     Capabilities.Add(MakeShared<FJsonValueString>(TEXT("framed-json")));
     Capabilities.Add(MakeShared<FJsonValueString>(TEXT("heartbeat")));
     Capabilities.Add(MakeShared<FJsonValueString>(TEXT("error-schema")));
+    Capabilities.Add(MakeShared<FJsonValueString>(TEXT("response-stream")));
+    Capabilities.Add(MakeShared<FJsonValueString>(TEXT("events")));
+    Capabilities.Add(MakeShared<FJsonValueString>(TEXT("cancel")));
+    Capabilities.Add(MakeShared<FJsonValueString>(TEXT("progress")));
+    if (!Session.ResumeToken.IsEmpty())
+    {
+        Capabilities.Add(MakeShared<FJsonValueString>(TEXT("resume")));
+    }
+    if (WindowMax > 1)
+    {
+        Capabilities.Add(MakeShared<FJsonValueString>(TEXT("pipelining")));
+    }
+
+    // Pick the first encoding from the client's preference list that we support; JSON otherwise.
+    EFrameEncoding NegotiatedEncoding = EFrameEncoding::Json;
+    const TArray<TSharedPtr<FJsonValue>>* RequestedEncodings = nullptr;
+    if (Handshake->TryGetArrayField(TEXT("encodings"), RequestedEncodings))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *RequestedEncodings)
+        {
+            EFrameEncoding Candidate;
+            if (Value.IsValid() && Value->Type == EJson::String && LexTryParseString(Candidate, *Value->AsString())
+                && (Candidate == EFrameEncoding::Json || bAllowBinaryEncoding))
+            {
+                NegotiatedEncoding = Candidate;
+                break;
+            }
+        }
+    }
+    if (bAllowBinaryEncoding)
+    {
+        Capabilities.Add(MakeShared<FJsonValueString>(TEXT("cbor")));
+    }
+
+    bool bNegotiatedCompression = false;
+    const TArray<TSharedPtr<FJsonValue>>* RequestedCompression = nullptr;
+    if (CompressionThresholdBytes > 0 && Handshake->TryGetArrayField(TEXT("compression"), RequestedCompression))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *RequestedCompression)
+        {
+            if (Value.IsValid() && Value->Type == EJson::String && Value->AsString().Equals(TEXT("zlib"), ESearchCase::IgnoreCase))
+            {
+                bNegotiatedCompression = true;
+                break;
+            }
+        }
+    }
+    if (CompressionThresholdBytes > 0)
+    {
+        Capabilities.Add(MakeShared<FJsonValueString>(TEXT("compression")));
+    }
+
+    // Shared memory only works for a client on this machine, so a client has to ask for it.
+    bool bRequestedSharedMemory = false;
+    TSharedPtr<FJsonObject> SharedMemoryAck;
+    if (SharedMemoryRingBytes > 0 && Handshake->TryGetBoolField(TEXT("sharedMemory"), bRequestedSharedMemory) && bRequestedSharedMemory)
+    {
+        const FString RegionName = FString::Printf(TEXT("umcp_%u_%d"), FPlatformProcess::GetCurrentProcessId(), SharedMemoryRegionCounter.Increment());
+        SharedMemory = FSharedMemoryRing::Create(RegionName, SharedMemoryRingBytes);
+        if (SharedMemory.IsValid())
+        {
+            SharedMemoryAck = MakeShared<FJsonObject>();
+            SharedMemoryAck->SetStringField(TEXT("name"), SharedMemory->GetName());
+            SharedMemoryAck->SetNumberField(TEXT("size"), static_cast<double>(SharedMemory->GetRegionBytes()));
+            SharedMemoryAck->SetNumberField(TEXT("threshold"), SharedMemoryThresholdBytes);
+            SharedMemoryAck->SetNumberField(TEXT("maxEntry"), SharedMemory->GetMaxEntryBytes());
+        }
+    }
+    if (SharedMemoryRingBytes > 0)
+    {
+        Capabilities.Add(MakeShared<FJsonValueString>(TEXT("shared-memory")));
+    }
+
+    // Older clients would read an attachment frame's flag bit as part of its length, so
+    // segments are only sent to clients that ask for them.
+    bool bNegotiatedAttachments = false;
+    Handshake->TryGetBoolField(TEXT("attachments"), bNegotiatedAttachments);
+    Capabilities.Add(MakeShared<FJsonValueString>(TEXT("attachments")));
+
     Ack->SetArrayField(TEXT("capabilities"), Capabilities);
+    Ack->SetNumberField(TEXT("windowMax"), WindowMax);
+    Ack->SetStringField(TEXT("encoding"), LexToString(NegotiatedEncoding));
+    if (bNegotiatedCompression)
+    {
+        Ack->SetStringField(TEXT("compression"), TEXT("zlib"));
+        Ack->SetNumberField(TEXT("compressionThreshold"), CompressionThresholdBytes);
+    }
+    if (SharedMemoryAck.IsValid())
+    {
+        Ack->SetObjectField(TEXT("sharedMemory"), SharedMemoryAck);
+    }
+    if (bNegotiatedAttachments)
+    {
+        Ack->SetBoolField(TEXT("attachments"), true);
+    }
 
     FString WriteError;
-    if (!WriteFramedJson(*Socket, Ack, WriteError))
+    if (!WriteFramedJson(*Stream, Ack, SendBuffer, WriteError))
     {
         OutError = WriteError;
         return false;
     }
 
+    // Every frame after the ack, in both directions, uses the negotiated encoding and compression.
+    FrameOptions.Encoding = NegotiatedEncoding;
+    FrameOptions.bCompression = bNegotiatedCompression;
+    FrameOptions.CompressionThreshold = CompressionThresholdBytes;
+    FrameOptions.bAttachments = bNegotiatedAttachments;
+
     LastSentTime = NowSeconds();
     bHandshakeCompleted = true;
     return true;
@@ -523,9 +971,9 @@ bool FProtocolClient::PerformHandshake(const FString& EngineVersion, const FStri
 
 bool FProtocolClient::SendMessage(const TSharedPtr<FJsonObject>& Message, FString& OutError, double TimeoutSeconds)
 {
-    if (!Socket.IsValid())
+    if (!Stream.IsValid())
     {
-        OutError = TEXT("Invalid socket");
+        OutError = TEXT("Invalid stream");
         return false;
     }
 
@@ -535,25 +983,70 @@ bool FProtocolClient::SendMessage(const TSharedPtr<FJsonObject>& Message, FStrin
         return false;
     }
 
-    if (!WriteFramedJson(*Socket, Message.ToSharedRef(), OutError, TimeoutSeconds))
+    return EncodeOutbound(Message.ToSharedRef(), SendBuffer, OutError) && SendEncoded(SendBuffer, OutError, TimeoutSeconds);
+}
+
+bool FProtocolClient::EncodeOutbound(const TSharedRef<FJsonObject>& Message, TArray<uint8>& OutFrame, FString& OutError) const
+{
+    const FAttachmentListPtr Attachments = FrameOptions.bAttachments ? FAttachments::Find(*Message) : nullptr;
+    return EncodeFramePayload(Message, OutFrame, OutError, FrameOptions, Attachments.Get());
+}
+
+bool FProtocolClient::SendEncoded(TArray<uint8>& Frame, FString& OutError, double TimeoutSeconds)
+{
+    if (!Stream.IsValid())
     {
+        OutError = TEXT("Invalid stream");
         return false;
     }
 
-    LastSentTime = NowSeconds();
-    return true;
+    const int32 PayloadSize = Frame.Num() - static_cast<int32>(sizeof(uint32));
+    uint32 PrefixFlags = 0;
+    FMemory::Memcpy(&PrefixFlags, Frame.GetData(), sizeof(uint32));
+    uint64 Position = 0;
+    bool bWritten = false;
+    if (bSharedMemoryActive && PayloadSize >= SharedMemoryThresholdBytes
+        && SharedMemory->Write(Frame.GetData() + sizeof(uint32), PayloadSize, Position))
+    {
+        // The payload stays in the ring; the socket only carries where to find it.
+        TSharedRef<FJsonObject> Descriptor = MakeShared<FJsonObject>();
+        Descriptor->SetStringField(TEXT("type"), TEXT("shm/frame"));
+        Descriptor->SetNumberField(TEXT("position"), static_cast<double>(Position));
+        Descriptor->SetNumberField(TEXT("length"), PayloadSize);
+        if ((PrefixFlags & AttachmentFrameFlag) != 0)
+        {
+            Descriptor->SetBoolField(TEXT("attachments"), true);
+        }
+        Frame.Reset();
+        bWritten = WriteFramedJson(*Stream, Descriptor, Frame, OutError, TimeoutSeconds, FrameOptions);
+    }
+    else
+    {
+        bWritten = FinalizeFrame(Frame, OutError, FrameOptions) && WriteEncodedFrame(*Stream, Frame, OutError, TimeoutSeconds);
+    }
+
+    if (bWritten)
+    {
+        LastSentTime = NowSeconds();
+    }
+    return bWritten;
+}
+
+void FProtocolClient::ActivateSharedMemory()
+{
+    bSharedMemoryActive = SharedMemory.IsValid();
 }
 
 FProtocolReadResult FProtocolClient::ReceiveMessage(double TimeoutSeconds, bool bAllowLegacyFallback)
 {
     FProtocolReadResult Result;
-    if (!Socket.IsValid())
+    if (!Stream.IsValid())
     {
-        Result.Error = TEXT("Invalid socket");
+        Result.Error = TEXT("Invalid stream");
         return Result;
     }
 
-    Result = ReadFramedJson(*Socket, TimeoutSeconds, bAllowLegacyFallback && !bHandshakeCompleted);
+    Result = ReadFramedJson(*Stream, TimeoutSeconds, bAllowLegacyFallback && !bHandshakeCompleted, FrameOptions);
     if (Result.bSuccess)
     {
         LastReceivedTime = NowSeconds();
@@ -566,22 +1059,30 @@ FProtocolReadResult FProtocolClient::ReceiveMessage(double TimeoutSeconds, bool
     return Result;
 }
 
-bool FProtocolClient::SendHeartbeatMessage(const FString& Type, int64 Timestamp, FString& OutError)
+bool FProtocolClient::WaitForReadable(double TimeoutSeconds) const
 {
-    TSharedRef<FJsonObject> Message = MakeShared<FJsonObject>();
-    Message->SetStringField(TEXT("type"), Type);
-    Message->SetNumberField(TEXT("ts"), static_cast<double>(Timestamp));
-    return SendMessage(Message, OutError, 5.0);
+    if (!Stream.IsValid())
+    {
+        return false;
+    }
+
+    return WaitForStream(*Stream, EStreamWait::Read, TimeoutSeconds);
 }
 
-bool FProtocolClient::SendPing(FString& OutError)
+TSharedRef<FJsonObject> MakePingMessage()
 {
-    return SendHeartbeatMessage(TEXT("ping"), UnixTimestampMillis(), OutError);
+    TSharedRef<FJsonObject> Message = MakeShared<FJsonObject>();
+    Message->SetStringField(TEXT("type"), TEXT("ping"));
+    Message->SetNumberField(TEXT("ts"), static_cast<double>(UnixTimestampMillis()));
+    return Message;
 }
 
-bool FProtocolClient::SendPong(int64 Timestamp, FString& OutError)
+TSharedRef<FJsonObject> MakePongMessage(int64 Timestamp)
 {
-    return SendHeartbeatMessage(TEXT("pong"), Timestamp, OutError);
+    TSharedRef<FJsonObject> Message = MakeShared<FJsonObject>();
+    Message->SetStringField(TEXT("type"), TEXT("pong"));
+    Message->SetNumberField(TEXT("ts"), static_cast<double>(Timestamp));
+    return Message;
 }
 
 }
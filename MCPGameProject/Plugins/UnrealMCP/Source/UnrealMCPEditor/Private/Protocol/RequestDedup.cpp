@@ -0,0 +1,136 @@
+#include "Protocol/RequestDedup.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Protocol/ResponseCache.h"
+#include "UnrealMCPLog.h"
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+namespace
+{
+    FSHAHash HashRequest(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+    {
+        // Hashed so large params (batch_import file lists) cost 20 bytes per remembered request.
+        const FString Key = FResponseCache::MakeKey(CommandType, Params);
+        FSHAHash Hash;
+        FSHA1::HashBuffer(*Key, Key.Len() * sizeof(TCHAR), Hash.Hash);
+        return Hash;
+    }
+}
+
+FRequestDedup::FRequestDedup()
+    : WindowSeconds(0.0)
+{
+}
+
+void FRequestDedup::SetWindowSeconds(double InWindowSeconds)
+{
+    FScopeLock Lock(&Mutex);
+    WindowSeconds = FMath::Max(InWindowSeconds, 0.0);
+    PruneLocked(FPlatformTime::Seconds());
+}
+
+FRequestDedup::EClaim FRequestDedup::Claim(const FString& RequestId, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FCompletion& OnComplete)
+{
+    const FSHAHash Fingerprint = HashRequest(CommandType, Params);
+
+    TSharedPtr<FJsonObject> Stored;
+    {
+        FScopeLock Lock(&Mutex);
+        PruneLocked(FPlatformTime::Seconds());
+
+        FEntry* Entry = Entries.Find(RequestId);
+        if (!Entry)
+        {
+            Entries.Add(RequestId).Fingerprint = Fingerprint;
+            return EClaim::Owner;
+        }
+        if (Entry->Fingerprint != Fingerprint)
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: requestId %s reused for a different %s; running it without deduplication"), *RequestId, *CommandType);
+            return EClaim::Untracked;
+        }
+        if (!Entry->Response.IsValid())
+        {
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Duplicate %s (requestId=%s) joined the running original"), *CommandType, *RequestId);
+            Entry->Waiters.Add(MoveTemp(OnComplete));
+            return EClaim::Joined;
+        }
+        Stored = Entry->Response;
+    }
+
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Duplicate %s (requestId=%s) answered from the stored response"), *CommandType, *RequestId);
+    FCompletion Completion = MoveTemp(OnComplete);
+    Completion(MakeReplay(Stored.ToSharedRef()));
+    return EClaim::Joined;
+}
+
+void FRequestDedup::Complete(const FString& RequestId, const TSharedRef<FJsonObject>& Response)
+{
+    // Snapshot before the caller's completion splices its meta into Response.
+    TSharedRef<FJsonObject> Snapshot = MakeShared<FJsonObject>();
+    Snapshot->Values = Response->Values;
+    Snapshot->RemoveField(TEXT("meta"));
+
+    bool bOk = false;
+    Response->TryGetBoolField(TEXT("ok"), bOk);
+
+    TArray<FCompletion> Waiters;
+    {
+        FScopeLock Lock(&Mutex);
+        FEntry* Entry = Entries.Find(RequestId);
+        if (!Entry || Entry->Response.IsValid())
+        {
+            return;
+        }
+
+        Waiters = MoveTemp(Entry->Waiters);
+        if (bOk)
+        {
+            Entry->Response = Snapshot;
+            CompletedOrder.Emplace(RequestId, FPlatformTime::Seconds());
+        }
+        else
+        {
+            // Failures (including cancellation) are not remembered; a later retry runs again.
+            Entries.Remove(RequestId);
+        }
+    }
+
+    for (FCompletion& Waiter : Waiters)
+    {
+        Waiter(MakeReplay(Snapshot));
+    }
+}
+
+TSharedRef<FJsonObject> FRequestDedup::MakeReplay(const TSharedRef<FJsonObject>& Stored)
+{
+    TSharedRef<FJsonObject> Replay = MakeShared<FJsonObject>();
+    Replay->Values = Stored->Values;
+    TSharedRef<FJsonObject> Meta = MakeShared<FJsonObject>();
+    Meta->SetBoolField(TEXT("deduplicated"), true);
+    Replay->SetObjectField(TEXT("meta"), Meta);
+    return Replay;
+}
+
+void FRequestDedup::PruneLocked(double NowSeconds)
+{
+    int32 Expired = 0;
+    while (Expired < CompletedOrder.Num()
+        && (CompletedOrder.Num() - Expired > MaxCompleted || NowSeconds - CompletedOrder[Expired].Value > WindowSeconds))
+    {
+        Entries.Remove(CompletedOrder[Expired].Key);
+        ++Expired;
+    }
+    if (Expired > 0)
+    {
+        CompletedOrder.RemoveAt(0, Expired);
+    }
+}
+}
+}
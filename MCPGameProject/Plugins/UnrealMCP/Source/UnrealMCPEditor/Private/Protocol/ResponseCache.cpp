@@ -0,0 +1,272 @@
+#include "Protocol/ResponseCache.h"
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+namespace
+{
+    void AppendCanonicalJson(const TSharedPtr<FJsonValue>& Value, FString& Out)
+    {
+        if (!Value.IsValid())
+        {
+            Out += TEXT("null");
+            return;
+        }
+
+        switch (Value->Type)
+        {
+        case EJson::Boolean:
+            Out += Value->AsBool() ? TEXT("true") : TEXT("false");
+            break;
+        case EJson::Number:
+            Out += FString::Printf(TEXT("%.17g"), Value->AsNumber());
+            break;
+        case EJson::String:
+            Out += TEXT("\"");
+            Out += Value->AsString().ReplaceCharWithEscapedChar();
+            Out += TEXT("\"");
+            break;
+        case EJson::Array:
+        {
+            Out += TEXT("[");
+            bool bFirst = true;
+            for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+            {
+                if (!bFirst)
+                {
+                    Out += TEXT(",");
+                }
+                bFirst = false;
+                AppendCanonicalJson(Element, Out);
+            }
+            Out += TEXT("]");
+            break;
+        }
+        case EJson::Object:
+        {
+            const TSharedPtr<FJsonObject> Object = Value->AsObject();
+            TArray<FString> Keys;
+            if (Object.IsValid())
+            {
+                Object->Values.GetKeys(Keys);
+                Keys.Sort([](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::CaseSensitive) < 0; });
+            }
+
+            Out += TEXT("{");
+            bool bFirst = true;
+            for (const FString& Key : Keys)
+            {
+                if (!bFirst)
+                {
+                    Out += TEXT(",");
+                }
+                bFirst = false;
+                Out += TEXT("\"");
+                Out += Key.ReplaceCharWithEscapedChar();
+                Out += TEXT("\":");
+                AppendCanonicalJson(Object->Values.FindRef(Key), Out);
+            }
+            Out += TEXT("}");
+            break;
+        }
+        default:
+            Out += TEXT("null");
+            break;
+        }
+    }
+}
+
+FResponseCache::FResponseCache()
+    : EntriesGeneration(0)
+    , MaxEntries(0)
+    , bPlaySessionActive(false)
+    , bStarted(false)
+{
+}
+
+FResponseCache::~FResponseCache()
+{
+    Stop();
+}
+
+void FResponseCache::Start()
+{
+    check(IsInGameThread());
+    if (bStarted)
+    {
+        return;
+    }
+    bStarted = true;
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddSPLambda(this, [this](const FAssetData&) { Invalidate(); });
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddSPLambda(this, [this](const FAssetData&) { Invalidate(); });
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddSPLambda(this, [this](const FAssetData&, const FString&) { Invalidate(); });
+    AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddSPLambda(this, [this](const FAssetData&) { Invalidate(); });
+
+    // Modify() is how editor code announces an edit, so this covers property edits, moves and graph changes.
+    ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddSPLambda(this, [this](UObject*) { Invalidate(); });
+    ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddSPLambda(this, [this](UObject*, FPropertyChangedEvent&) { Invalidate(); });
+    // Undo and redo restore objects without calling Modify().
+    ObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddSPLambda(this, [this](UObject*, const FTransactionObjectEvent&) { Invalidate(); });
+
+    if (GEngine)
+    {
+        ActorAddedHandle = GEngine->OnLevelActorAdded().AddSPLambda(this, [this](AActor*) { Invalidate(); });
+        ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddSPLambda(this, [this](AActor*) { Invalidate(); });
+    }
+
+    PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddSPLambda(this, [this](const FString&, UPackage*, FObjectPostSaveContext) { Invalidate(); });
+    MapOpenedHandle = FEditorDelegates::OnMapOpened.AddSPLambda(this, [this](const FString&, bool) { Invalidate(); });
+    // A running game moves actors every tick without telling anyone, so nothing is cached during PIE.
+    BeginPIEHandle = FEditorDelegates::BeginPIE.AddSPLambda(this, [this](const bool) { bPlaySessionActive = true; Invalidate(); });
+    EndPIEHandle = FEditorDelegates::EndPIE.AddSPLambda(this, [this](const bool) { bPlaySessionActive = false; Invalidate(); });
+}
+
+void FResponseCache::Stop()
+{
+    if (!bStarted)
+    {
+        return;
+    }
+    bStarted = false;
+
+    if (FAssetRegistryModule* Module = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+    {
+        IAssetRegistry& AssetRegistry = Module->Get();
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+        AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+    }
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+    FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedHandle);
+    if (GEngine)
+    {
+        GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+        GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+    }
+    UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+    FEditorDelegates::OnMapOpened.Remove(MapOpenedHandle);
+    FEditorDelegates::BeginPIE.Remove(BeginPIEHandle);
+    FEditorDelegates::EndPIE.Remove(EndPIEHandle);
+
+    Invalidate();
+    FScopeLock Lock(&Mutex);
+    Entries.Empty();
+    InsertionOrder.Empty();
+}
+
+void FResponseCache::SetMaxEntries(int32 InMaxEntries)
+{
+    FScopeLock Lock(&Mutex);
+    MaxEntries = FMath::Max(InMaxEntries, 0);
+    if (InsertionOrder.Num() > MaxEntries)
+    {
+        const int32 Excess = InsertionOrder.Num() - MaxEntries;
+        for (int32 Index = 0; Index < Excess; ++Index)
+        {
+            Entries.Remove(InsertionOrder[Index]);
+        }
+        InsertionOrder.RemoveAt(0, Excess);
+    }
+}
+
+FString FResponseCache::MakeKey(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    TSharedPtr<FJsonValue> ParamsValue;
+    if (Params.IsValid())
+    {
+        ParamsValue = MakeShared<FJsonValueObject>(Params);
+    }
+
+    FString Key = CommandType;
+    Key += TEXT(":");
+    AppendCanonicalJson(ParamsValue, Key);
+    return Key;
+}
+
+TSharedPtr<FJsonObject> FResponseCache::Find(const FString& Key)
+{
+    TSharedPtr<FJsonObject> Cached;
+    {
+        FScopeLock Lock(&Mutex);
+        if (MaxEntries <= 0 || bPlaySessionActive || EntriesGeneration != Generation.GetValue())
+        {
+            return nullptr;
+        }
+        Cached = Entries.FindRef(Key);
+    }
+    if (!Cached.IsValid())
+    {
+        return nullptr;
+    }
+
+    // The connection splices its envelope into the response's own meta, so every hit gets a fresh one.
+    TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
+    Response->Values = Cached->Values;
+    TSharedRef<FJsonObject> Meta = MakeShared<FJsonObject>();
+    Meta->SetBoolField(TEXT("cached"), true);
+    Response->SetObjectField(TEXT("meta"), Meta);
+    return Response;
+}
+
+bool FResponseCache::Contains(const FString& Key)
+{
+    FScopeLock Lock(&Mutex);
+    return MaxEntries > 0 && !bPlaySessionActive && EntriesGeneration == Generation.GetValue() && Entries.Contains(Key);
+}
+
+void FResponseCache::Store(const FString& Key, int64 InGeneration, const TSharedRef<FJsonObject>& Response)
+{
+    bool bOk = false;
+    if (!Response->TryGetBoolField(TEXT("ok"), bOk) || !bOk)
+    {
+        return;
+    }
+
+    // Shallow copy taken before the connection decorates the response; nested values are never modified.
+    TSharedRef<FJsonObject> Snapshot = MakeShared<FJsonObject>();
+    Snapshot->Values = Response->Values;
+    Snapshot->RemoveField(TEXT("meta"));
+
+    FScopeLock Lock(&Mutex);
+    if (MaxEntries <= 0 || bPlaySessionActive || InGeneration != Generation.GetValue())
+    {
+        return;
+    }
+    if (EntriesGeneration != InGeneration)
+    {
+        Entries.Empty();
+        InsertionOrder.Empty();
+        EntriesGeneration = InGeneration;
+    }
+
+    if (!Entries.Contains(Key))
+    {
+        if (InsertionOrder.Num() >= MaxEntries)
+        {
+            Entries.Remove(InsertionOrder[0]);
+            InsertionOrder.RemoveAt(0);
+        }
+        InsertionOrder.Add(Key);
+    }
+    Entries.Add(Key, Snapshot);
+}
+}
+}
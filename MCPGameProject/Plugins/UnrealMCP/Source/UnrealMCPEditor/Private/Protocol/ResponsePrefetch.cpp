@@ -0,0 +1,214 @@
+#include "Protocol/ResponsePrefetch.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Observability/MetricsRegistry.h"
+#include "Protocol/ResponseCache.h"
+#include "UnrealMCPLog.h"
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+namespace
+{
+    /** Assumed for a command that has not run yet, so a first prefetch still fits a typical slice. */
+    constexpr double DefaultEstimateSeconds = 0.002;
+    constexpr double EstimateSmoothing = 0.25;
+
+    /** The handler's data object inside a protocol response ({ok, result: {success, data}}). */
+    const FJsonObject* GetData(const FJsonObject& Response)
+    {
+        bool bOk = false;
+        const TSharedPtr<FJsonObject>* Result = nullptr;
+        if (!Response.TryGetBoolField(TEXT("ok"), bOk) || !bOk || !Response.TryGetObjectField(TEXT("result"), Result))
+        {
+            return nullptr;
+        }
+        const TSharedPtr<FJsonObject>* Data = nullptr;
+        return (*Result)->TryGetObjectField(TEXT("data"), Data) ? Data->Get() : Result->Get();
+    }
+}
+
+FResponsePrefetcher::FResponsePrefetcher(const TSharedRef<FResponseCache, ESPMode::ThreadSafe>& InCache, FExecutor InExecutor)
+    : Cache(InCache)
+    , Executor(MoveTemp(InExecutor))
+    , MaxFollowUps(0)
+{
+}
+
+void FResponsePrefetcher::SetMaxFollowUps(int32 InMaxFollowUps)
+{
+    FScopeLock Lock(&Mutex);
+    MaxFollowUps.store(FMath::Max(InMaxFollowUps, 0), std::memory_order_relaxed);
+    if (InMaxFollowUps <= 0)
+    {
+        Stats.Dropped += Pending.Num();
+        Pending.Reset();
+    }
+}
+
+bool FResponsePrefetcher::IsTrigger(const FString& CommandType)
+{
+    return CommandType == TEXT("asset.find") || CommandType == TEXT("sequence.create");
+}
+
+void FResponsePrefetcher::OnResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FJsonObject& Response)
+{
+    const int32 Limit = MaxFollowUps.load(std::memory_order_relaxed);
+    const FJsonObject* Data = Limit > 0 ? GetData(Response) : nullptr;
+    if (!Data)
+    {
+        return;
+    }
+    const double Now = FPlatformTime::Seconds();
+
+    if (CommandType == TEXT("asset.find"))
+    {
+        // The top results are what an agent inspects next, one asset.metadata each.
+        const TArray<TSharedPtr<FJsonValue>>* Items = nullptr;
+        if (!Data->TryGetArrayField(TEXT("items"), Items))
+        {
+            return;
+        }
+        int32 Added = 0;
+        for (const TSharedPtr<FJsonValue>& Item : *Items)
+        {
+            const TSharedPtr<FJsonObject>* ItemObject = nullptr;
+            FString ObjectPath;
+            if (Added >= Limit)
+            {
+                break;
+            }
+            if (Item.IsValid() && Item->TryGetObject(ItemObject) && (*ItemObject)->TryGetStringField(TEXT("objectPath"), ObjectPath) && !ObjectPath.IsEmpty())
+            {
+                TSharedRef<FJsonObject> FollowUp = MakeShared<FJsonObject>();
+                FollowUp->SetStringField(TEXT("objectPath"), ObjectPath);
+                Enqueue(TEXT("asset.metadata"), FollowUp, Now);
+                ++Added;
+            }
+        }
+    }
+    else if (CommandType == TEXT("sequence.create"))
+    {
+        // Keyed by the path the agent created it with, which is the one it will list bindings by.
+        FString SequencePath;
+        // A dry run answers {planned} without creating anything to list.
+        if (Data->HasField(TEXT("sequence")) && Params.IsValid() && Params->TryGetStringField(TEXT("sequencePath"), SequencePath) && !SequencePath.IsEmpty())
+        {
+            TSharedRef<FJsonObject> FollowUp = MakeShared<FJsonObject>();
+            FollowUp->SetStringField(TEXT("sequencePath"), SequencePath);
+            Enqueue(TEXT("sequence.list_bindings"), FollowUp, Now);
+        }
+    }
+}
+
+void FResponsePrefetcher::Enqueue(const FString& CommandType, const TSharedRef<FJsonObject>& Params, double Now)
+{
+    FString Key = FResponseCache::MakeKey(CommandType, Params);
+
+    FScopeLock Lock(&Mutex);
+    if (Pending.ContainsByPredicate([&Key](const FPending& Entry) { return Entry.Key == Key; }))
+    {
+        return;
+    }
+    // A burst of finds keeps the newest follow-ups; the oldest are the least likely to be asked for.
+    if (Pending.Num() >= MaxPending)
+    {
+        Pending.RemoveAt(0);
+        ++Stats.Dropped;
+    }
+    FPending& Entry = Pending.AddDefaulted_GetRef();
+    Entry.CommandType = CommandType;
+    Entry.Params = Params;
+    Entry.Key = MoveTemp(Key);
+    Entry.QueuedAt = Now;
+    ++Stats.Queued;
+}
+
+void FResponsePrefetcher::NoteCacheHit(const FString& Key)
+{
+    FScopeLock Lock(&Mutex);
+    if (TrackedKeys.Remove(Key) > 0)
+    {
+        ++Stats.Hits;
+    }
+}
+
+void FResponsePrefetcher::RunIdle(double SliceDeadline)
+{
+    check(IsInGameThread());
+
+    while (true)
+    {
+        FPending Next;
+        {
+            FScopeLock Lock(&Mutex);
+            const double Now = FPlatformTime::Seconds();
+            // Nothing is stored during PIE, so running follow-ups then would only cost frame time.
+            if (!Cache->IsEnabled() || Cache->IsPlaySessionActive())
+            {
+                Stats.Dropped += Pending.Num();
+                Pending.Reset();
+                return;
+            }
+            while (Pending.Num() > 0 && Now - Pending[0].QueuedAt > MaxAgeSeconds)
+            {
+                Pending.RemoveAt(0);
+                ++Stats.Dropped;
+            }
+            if (Pending.Num() == 0)
+            {
+                return;
+            }
+            const double* Estimate = EstimatedSeconds.Find(Pending[0].CommandType);
+            if (Now + (Estimate ? *Estimate : DefaultEstimateSeconds) > SliceDeadline)
+            {
+                return;
+            }
+            Next = MoveTemp(Pending[0]);
+            Pending.RemoveAt(0);
+        }
+
+        if (Cache->Contains(Next.Key))
+        {
+            FScopeLock Lock(&Mutex);
+            ++Stats.Dropped;
+            continue;
+        }
+
+        // Taken before running, like the bridge does, so an edit made meanwhile keeps the answer out.
+        const int64 Generation = Cache->GetGeneration();
+        const double Start = FPlatformTime::Seconds();
+        const TSharedRef<FJsonObject> Response = Executor(Next.CommandType, Next.Params);
+        const double Elapsed = FPlatformTime::Seconds() - Start;
+        Cache->Store(Next.Key, Generation, Response);
+        FMetricsRegistry::RecordPhase(Next.CommandType, TEXT("prefetch"), Elapsed * 1000.0);
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Prefetched %s in %.2f ms"), *Next.Key, Elapsed * 1000.0);
+
+        FScopeLock Lock(&Mutex);
+        ++Stats.Run;
+        Stats.Seconds += Elapsed;
+        double& Estimate = EstimatedSeconds.FindOrAdd(Next.CommandType, Elapsed);
+        Estimate = FMath::Lerp(Estimate, Elapsed, EstimateSmoothing);
+        if (Cache->Contains(Next.Key) && !TrackedKeys.Contains(Next.Key))
+        {
+            if (TrackedKeys.Num() >= MaxTrackedKeys)
+            {
+                TrackedKeys.RemoveAt(0);
+            }
+            TrackedKeys.Add(MoveTemp(Next.Key));
+        }
+    }
+}
+
+FResponsePrefetcher::FStats FResponsePrefetcher::GetStats() const
+{
+    FScopeLock Lock(&Mutex);
+    return Stats;
+}
+}
+}
@@ -0,0 +1,135 @@
+#include "Protocol/ResponseStream.h"
+#include "CoreMinimal.h"
+
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+
+FResponseStream* FResponseStream::ActiveStream = nullptr;
+
+FResponseStream::FResponseStream(const FString& InRequestId, FFrameSink InSink)
+    : RequestId(InRequestId)
+    , Sink(MoveTemp(InSink))
+    , bBegun(false)
+    , bDraining(false)
+    , bFailed(false)
+    , ChunkCount(0)
+{
+}
+
+FResponseStream* FResponseStream::GetActive()
+{
+    check(IsInGameThread());
+    return ActiveStream;
+}
+
+FResponseStream::FScopedActive::FScopedActive(FResponseStream* InStream)
+    : Previous(ActiveStream)
+{
+    check(IsInGameThread());
+    ActiveStream = InStream;
+}
+
+FResponseStream::FScopedActive::~FScopedActive()
+{
+    ActiveStream = Previous;
+}
+
+void FResponseStream::Begin(const FString& Field, const FString& ContentType)
+{
+    if (bBegun)
+    {
+        return;
+    }
+
+    bBegun = true;
+    TSharedRef<FJsonObject> Frame = MakeFrame(TEXT("stream_begin"));
+    Frame->SetStringField(TEXT("field"), Field);
+    Frame->SetStringField(TEXT("contentType"), ContentType);
+    Enqueue(Frame);
+}
+
+void FResponseStream::WriteChunk(const FString& Data)
+{
+    check(bBegun);
+    if (Data.IsEmpty())
+    {
+        return;
+    }
+
+    TSharedRef<FJsonObject> Frame = MakeFrame(TEXT("stream_chunk"));
+    Frame->SetNumberField(TEXT("seq"), ChunkCount++);
+    Frame->SetStringField(TEXT("data"), Data);
+    Enqueue(Frame);
+}
+
+void FResponseStream::Finish(const TSharedRef<FJsonObject>& FinalResponse)
+{
+    FinalResponse->SetStringField(TEXT("type"), TEXT("stream_end"));
+    FinalResponse->SetStringField(TEXT("requestId"), RequestId);
+    FinalResponse->SetNumberField(TEXT("chunks"), ChunkCount);
+    Enqueue(FinalResponse);
+}
+
+TSharedRef<FJsonObject> FResponseStream::MakeFrame(const TCHAR* Type) const
+{
+    TSharedRef<FJsonObject> Frame = MakeShared<FJsonObject>();
+    Frame->SetStringField(TEXT("type"), Type);
+    Frame->SetStringField(TEXT("requestId"), RequestId);
+
+    TSharedPtr<FJsonObject> Meta = MakeShared<FJsonObject>();
+    Meta->SetStringField(TEXT("requestId"), RequestId);
+    Frame->SetObjectField(TEXT("meta"), Meta);
+    return Frame;
+}
+
+void FResponseStream::Enqueue(const TSharedRef<FJsonObject>& Frame)
+{
+    PendingFrames.Enqueue(Frame);
+    ScheduleDrain();
+}
+
+void FResponseStream::ScheduleDrain()
+{
+    if (bDraining.AtomicSet(true))
+    {
+        return;
+    }
+
+    TSharedRef<FResponseStream, ESPMode::ThreadSafe> Self = AsShared();
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Self]()
+    {
+        Self->Drain();
+    });
+}
+
+void FResponseStream::Drain()
+{
+    for (;;)
+    {
+        TSharedPtr<FJsonObject> Frame;
+        while (PendingFrames.Dequeue(Frame))
+        {
+            if (!bFailed && !Sink(Frame.ToSharedRef()))
+            {
+                // Keep draining so producers never stall; the frames are simply dropped.
+                bFailed = true;
+            }
+        }
+
+        bDraining = false;
+
+        // A producer may have enqueued after the last Dequeue but before the flag was cleared.
+        if (PendingFrames.IsEmpty() || bDraining.AtomicSet(true))
+        {
+            return;
+        }
+    }
+}
+
+}
+}
@@ -0,0 +1,103 @@
+#include "Protocol/SharedMemoryRing.h"
+#include "CoreMinimal.h"
+
+#include "HAL/PlatformAtomics.h"
+#include "UnrealMCPLog.h"
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+namespace
+{
+    constexpr int32 MagicOffset = 0;
+    constexpr int32 VersionOffset = 4;
+    constexpr int32 CapacityOffset = 8;
+    constexpr int32 HeadOffset = 16;
+    constexpr int32 TailOffset = 24;
+
+    volatile int64* HeaderField(FPlatformMemory::FSharedMemoryRegion* Region, int32 Offset)
+    {
+        return reinterpret_cast<volatile int64*>(static_cast<uint8*>(Region->GetAddress()) + Offset);
+    }
+}
+
+TUniquePtr<FSharedMemoryRing> FSharedMemoryRing::Create(const FString& Name, int32 CapacityBytes)
+{
+    if (CapacityBytes <= 0)
+    {
+        return nullptr;
+    }
+
+    // POSIX shm_open names need a leading slash; clients (Python's SharedMemory) add it themselves.
+#if PLATFORM_WINDOWS
+    const FString PlatformName = Name;
+#else
+    const FString PlatformName = TEXT("/") + Name;
+#endif
+
+    const uint32 Access = static_cast<uint32>(FPlatformMemory::ESharedMemoryAccess::Read) | static_cast<uint32>(FPlatformMemory::ESharedMemoryAccess::Write);
+    FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(PlatformName, true, Access, HeaderBytes + static_cast<SIZE_T>(CapacityBytes));
+    if (!Region)
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("[Protocol] Could not create shared memory region %s (%d bytes)"), *PlatformName, CapacityBytes);
+        return nullptr;
+    }
+
+    return TUniquePtr<FSharedMemoryRing>(new FSharedMemoryRing(Region, Name, CapacityBytes));
+}
+
+FSharedMemoryRing::FSharedMemoryRing(FPlatformMemory::FSharedMemoryRegion* InRegion, const FString& InName, int64 InCapacity)
+    : Region(InRegion)
+    , Name(InName)
+    , Capacity(InCapacity)
+    , Head(0)
+    , Tail(0)
+{
+    uint8* Base = static_cast<uint8*>(Region->GetAddress());
+    FMemory::Memzero(Base, HeaderBytes);
+    FMemory::Memcpy(Base + MagicOffset, &Magic, sizeof(Magic));
+    FMemory::Memcpy(Base + VersionOffset, &Version, sizeof(Version));
+    FMemory::Memcpy(Base + CapacityOffset, &Capacity, sizeof(Capacity));
+}
+
+FSharedMemoryRing::~FSharedMemoryRing()
+{
+    // The creating side unmaps and unlinks; a client still attached keeps its own mapping.
+    FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+}
+
+bool FSharedMemoryRing::Write(const uint8* Data, int32 Length, uint64& OutPosition)
+{
+    if (Length <= 0 || Length > GetMaxEntryBytes())
+    {
+        return false;
+    }
+
+    // Entries never straddle the end of the buffer: skip the remainder and start at offset 0.
+    uint64 Position = Head;
+    const uint64 Offset = Position % static_cast<uint64>(Capacity);
+    if (Offset + static_cast<uint64>(Length) > static_cast<uint64>(Capacity))
+    {
+        Position += static_cast<uint64>(Capacity) - Offset;
+    }
+
+    const uint64 End = Position + static_cast<uint64>(Length);
+    if (End > static_cast<uint64>(Capacity) && End - static_cast<uint64>(Capacity) > Tail)
+    {
+        // Publish the reclaimed range before overwriting it so readers can detect a torn copy.
+        Tail = End - static_cast<uint64>(Capacity);
+        FPlatformAtomics::AtomicStore(HeaderField(Region, TailOffset), static_cast<int64>(Tail));
+    }
+
+    FMemory::Memcpy(static_cast<uint8*>(Region->GetAddress()) + HeaderBytes + (Position % static_cast<uint64>(Capacity)), Data, Length);
+
+    Head = End;
+    FPlatformAtomics::AtomicStore(HeaderField(Region, HeadOffset), static_cast<int64>(Head));
+
+    OutPosition = Position;
+    return true;
+}
+
+}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformMemory.h"
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+    /**
+     * Single-producer byte ring in a named shared-memory region, used to hand bulk frame payloads
+     * to a same-host client without pushing them through the socket. The editor writes; the
+     * client only reads.
+     *
+     * Layout (little-endian): a 64-byte header {uint32 magic 'UMSR', uint32 version,
+     * uint64 capacity, uint64 head, uint64 tail} followed by capacity data bytes. Positions are
+     * monotonic byte counters; an entry at position P lives at P % capacity and never wraps.
+     * The writer advances tail past any bytes it is about to overwrite before touching them, so a
+     * reader that copies an entry and then finds tail <= P knows the copy is intact.
+     */
+    class FSharedMemoryRing
+    {
+    public:
+        static constexpr uint32 Magic = 0x52534D55; // "UMSR"
+        static constexpr uint32 Version = 1;
+        static constexpr int32 HeaderBytes = 64;
+
+        /** Creates and maps the region. Returns null if the platform has no named shared memory. */
+        static TUniquePtr<FSharedMemoryRing> Create(const FString& Name, int32 CapacityBytes);
+
+        ~FSharedMemoryRing();
+
+        /** Copies Data into the ring. Fails only if Length exceeds GetMaxEntryBytes(). */
+        bool Write(const uint8* Data, int32 Length, uint64& OutPosition);
+
+        /** Name a client passes to its shared-memory API (no platform prefix). */
+        const FString& GetName() const { return Name; }
+        int64 GetRegionBytes() const { return static_cast<int64>(HeaderBytes) + Capacity; }
+        int64 GetCapacity() const { return Capacity; }
+
+        /** Half the capacity, so the entry a reader is copying survives at least one more write. */
+        int32 GetMaxEntryBytes() const { return static_cast<int32>(FMath::Min<int64>(Capacity / 2, MAX_int32)); }
+
+    private:
+        FSharedMemoryRing(FPlatformMemory::FSharedMemoryRegion* InRegion, const FString& InName, int64 InCapacity);
+
+        FPlatformMemory::FSharedMemoryRegion* Region;
+        FString Name;
+        int64 Capacity;
+        uint64 Head;
+        uint64 Tail;
+    };
+}
+}
@@ -0,0 +1,949 @@
+#include "Protocol/Transport.h"
+#include "CoreMinimal.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+#include <atomic>
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include "Windows/WindowsHWrapper.h"
+#include "Windows/HideWindowsPlatformTypes.h"
+#elif PLATFORM_UNIX || PLATFORM_MAC
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+namespace
+{
+    constexpr int32 AcceptedSocketBufferBytes = 64 * 1024;
+    constexpr double ListenerErrorBackoffSeconds = 0.05; // keeps a broken listener from spinning
+    constexpr int32 LocalListenBacklog = 16;
+
+    /** Restricts endpoint names to a portable set so the Python client derives the same path. */
+    FString SanitizeEndpointName(const FString& Name)
+    {
+        FString Result = Name;
+        Result.TrimStartAndEndInline();
+        for (TCHAR& Char : Result)
+        {
+            if (!FChar::IsAlnum(Char) && Char != TEXT('-') && Char != TEXT('_') && Char != TEXT('.'))
+            {
+                Char = TEXT('_');
+            }
+        }
+        return Result.IsEmpty() ? FString(TEXT("unreal-mcp")) : Result;
+    }
+
+    int32 ToWaitMilliseconds(double TimeoutSeconds)
+    {
+        return static_cast<int32>(FMath::Clamp(TimeoutSeconds, 0.0, 86400.0) * 1000.0);
+    }
+
+    class FSocketByteStream final : public IByteStream
+    {
+    public:
+        explicit FSocketByteStream(const TSharedPtr<FSocket>& InSocket)
+            : Socket(InSocket)
+        {
+        }
+
+        virtual bool Recv(uint8* Data, int32 MaxBytes, int32& OutBytesRead, bool& bOutWouldBlock) override
+        {
+            bOutWouldBlock = false;
+            if (Socket->Recv(Data, MaxBytes, OutBytesRead))
+            {
+                return true;
+            }
+            bOutWouldBlock = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() == SE_EWOULDBLOCK;
+            return false;
+        }
+
+        virtual bool Send(const uint8* Data, int32 Length, int32& OutBytesSent, bool& bOutWouldBlock) override
+        {
+            bOutWouldBlock = false;
+            if (Socket->Send(Data, Length, OutBytesSent))
+            {
+                return true;
+            }
+            bOutWouldBlock = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() == SE_EWOULDBLOCK;
+            return false;
+        }
+
+        virtual bool Wait(EStreamWait Condition, double TimeoutSeconds) override
+        {
+            const ESocketWaitConditions::Type SocketCondition = Condition == EStreamWait::Read
+                ? ESocketWaitConditions::WaitForRead
+                : ESocketWaitConditions::WaitForWrite;
+            return Socket->Wait(SocketCondition, FTimespan::FromSeconds(FMath::Max(0.0, TimeoutSeconds)));
+        }
+
+        virtual bool IsConnected() const override
+        {
+            return Socket->GetConnectionState() == SCS_Connected;
+        }
+
+        virtual void Shutdown() override
+        {
+            // Unblocks a Recv/Wait on the connection thread.
+            Socket->Shutdown(ESocketShutdownMode::ReadWrite);
+        }
+
+        virtual void Close() override
+        {
+            Socket->Close();
+        }
+
+        virtual FString DescribeLastError(const TCHAR* Operation) const override
+        {
+            ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+            const int32 ErrorCode = SocketSubsystem ? SocketSubsystem->GetLastErrorCode() : 0;
+            return FString::Printf(TEXT("%s failed (error %d)"), Operation, ErrorCode);
+        }
+
+        virtual const TCHAR* GetTransportName() const override
+        {
+            return TEXT("tcp");
+        }
+
+    private:
+        TSharedPtr<FSocket> Socket;
+    };
+
+    class FSocketStreamListener final : public IStreamListener
+    {
+    public:
+        explicit FSocketStreamListener(const TSharedPtr<FSocket>& InListenerSocket)
+            : ListenerSocket(InListenerSocket)
+        {
+        }
+
+        virtual FByteStreamPtr Accept(double TimeoutSeconds) override
+        {
+            bool bPending = false;
+            if (!ListenerSocket->WaitForPendingConnection(bPending, FTimespan::FromSeconds(TimeoutSeconds)))
+            {
+                if (ListenerSocket->GetConnectionState() == SCS_ConnectionError)
+                {
+                    FPlatformProcess::Sleep(ListenerErrorBackoffSeconds);
+                }
+                return nullptr;
+            }
+            if (!bPending)
+            {
+                return nullptr;
+            }
+
+            TSharedPtr<FSocket> ClientSocket = MakeShareable(ListenerSocket->Accept(TEXT("MCPClient")));
+            if (!ClientSocket.IsValid())
+            {
+                return nullptr;
+            }
+
+            int32 ActualSize = 0;
+            ClientSocket->SetNoDelay(true);
+            ClientSocket->SetNonBlocking(false);
+            ClientSocket->SetSendBufferSize(AcceptedSocketBufferBytes, ActualSize);
+            ClientSocket->SetReceiveBufferSize(AcceptedSocketBufferBytes, ActualSize);
+            return MakeSocketStream(ClientSocket);
+        }
+
+        virtual void Shutdown() override
+        {
+            ListenerSocket->Shutdown(ESocketShutdownMode::ReadWrite);
+            ListenerSocket->Close();
+        }
+
+        virtual FString Describe() const override
+        {
+            ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+            if (!SocketSubsystem)
+            {
+                return TEXT("tcp");
+            }
+            TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+            ListenerSocket->GetAddress(*Address);
+            return Address->ToString(true);
+        }
+
+    private:
+        TSharedPtr<FSocket> ListenerSocket;
+    };
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+
+#if PLATFORM_MAC
+    constexpr int SendFlags = 0; // SIGPIPE is suppressed per socket with SO_NOSIGPIPE
+#else
+    constexpr int SendFlags = MSG_NOSIGNAL;
+#endif
+
+    void PrepareLocalSocket(int Fd)
+    {
+        fcntl(Fd, F_SETFD, FD_CLOEXEC);
+#if PLATFORM_MAC
+        int On = 1;
+        setsockopt(Fd, SOL_SOCKET, SO_NOSIGPIPE, &On, sizeof(On));
+#endif
+    }
+
+    bool MakeUnixAddress(const FString& Path, sockaddr_un& OutAddress, FString& OutError)
+    {
+        FMemory::Memzero(OutAddress);
+        OutAddress.sun_family = AF_UNIX;
+        const FTCHARToUTF8 PathUtf8(*Path);
+        if (PathUtf8.Length() >= static_cast<int32>(sizeof(OutAddress.sun_path)))
+        {
+            OutError = FString::Printf(TEXT("Local endpoint path is too long for a Unix domain socket: %s"), *Path);
+            return false;
+        }
+        FMemory::Memcpy(OutAddress.sun_path, PathUtf8.Get(), PathUtf8.Length());
+        return true;
+    }
+
+    FString DescribeErrno(const TCHAR* Operation, int ErrorCode)
+    {
+        return FString::Printf(TEXT("%s failed (errno %d: %s)"), Operation, ErrorCode, UTF8_TO_TCHAR(strerror(ErrorCode)));
+    }
+
+    class FUnixDomainStream final : public IByteStream
+    {
+    public:
+        explicit FUnixDomainStream(int InFd)
+            : Fd(InFd)
+            , bShutdown(false)
+        {
+        }
+
+        virtual ~FUnixDomainStream() override
+        {
+            Close();
+        }
+
+        virtual bool Recv(uint8* Data, int32 MaxBytes, int32& OutBytesRead, bool& bOutWouldBlock) override
+        {
+            bOutWouldBlock = false;
+            OutBytesRead = 0;
+            const ssize_t Result = recv(Fd, Data, MaxBytes, MSG_DONTWAIT);
+            if (Result >= 0)
+            {
+                OutBytesRead = static_cast<int32>(Result);
+                return true;
+            }
+            bOutWouldBlock = errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+            return false;
+        }
+
+        virtual bool Send(const uint8* Data, int32 Length, int32& OutBytesSent, bool& bOutWouldBlock) override
+        {
+            bOutWouldBlock = false;
+            OutBytesSent = 0;
+            const ssize_t Result = send(Fd, Data, Length, MSG_DONTWAIT | SendFlags);
+            if (Result >= 0)
+            {
+                OutBytesSent = static_cast<int32>(Result);
+                return true;
+            }
+            bOutWouldBlock = errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+            return false;
+        }
+
+        virtual bool Wait(EStreamWait Condition, double TimeoutSeconds) override
+        {
+            if (bShutdown)
+            {
+                return false;
+            }
+
+            pollfd Poll;
+            Poll.fd = Fd;
+            Poll.events = Condition == EStreamWait::Read ? POLLIN : POLLOUT;
+            Poll.revents = 0;
+            // Hang-up counts as readable so the following Recv observes the close.
+            return poll(&Poll, 1, ToWaitMilliseconds(TimeoutSeconds)) > 0 && !bShutdown;
+        }
+
+        virtual bool IsConnected() const override
+        {
+            if (bShutdown || Fd < 0)
+            {
+                return false;
+            }
+
+            pollfd Poll;
+            Poll.fd = Fd;
+            Poll.events = 0;
+            Poll.revents = 0;
+            return poll(&Poll, 1, 0) == 0 || (Poll.revents & (POLLERR | POLLNVAL)) == 0;
+        }
+
+        virtual void Shutdown() override
+        {
+            FScopeLock Lock(&FdLock);
+            bShutdown = true;
+            if (Fd >= 0)
+            {
+                // Wakes a poll() on the connection thread on both Linux and macOS.
+                shutdown(Fd, SHUT_RDWR);
+            }
+        }
+
+        virtual void Close() override
+        {
+            FScopeLock Lock(&FdLock);
+            bShutdown = true;
+            if (Fd >= 0)
+            {
+                close(Fd);
+                Fd = -1;
+            }
+        }
+
+        virtual FString DescribeLastError(const TCHAR* Operation) const override
+        {
+            return DescribeErrno(Operation, errno);
+        }
+
+        virtual const TCHAR* GetTransportName() const override
+        {
+            return TEXT("unix");
+        }
+
+    private:
+        int Fd;
+        std::atomic<bool> bShutdown;
+        FCriticalSection FdLock;
+    };
+
+    class FUnixDomainListener final : public IStreamListener
+    {
+    public:
+        FUnixDomainListener(int InListenFd, int InWakeReadFd, int InWakeWriteFd, const FString& InPath)
+            : ListenFd(InListenFd)
+            , WakeReadFd(InWakeReadFd)
+            , WakeWriteFd(InWakeWriteFd)
+            , Path(InPath)
+            , bShutdown(false)
+        {
+        }
+
+        virtual ~FUnixDomainListener() override
+        {
+            close(ListenFd);
+            close(WakeReadFd);
+            close(WakeWriteFd);
+            unlink(TCHAR_TO_UTF8(*Path));
+        }
+
+        virtual FByteStreamPtr Accept(double TimeoutSeconds) override
+        {
+            if (bShutdown)
+            {
+                return nullptr;
+            }
+
+            pollfd Polls[2];
+            Polls[0].fd = ListenFd;
+            Polls[0].events = POLLIN;
+            Polls[0].revents = 0;
+            Polls[1].fd = WakeReadFd;
+            Polls[1].events = POLLIN;
+            Polls[1].revents = 0;
+
+            if (poll(Polls, 2, ToWaitMilliseconds(TimeoutSeconds)) <= 0 || bShutdown || (Polls[0].revents & POLLIN) == 0)
+            {
+                return nullptr;
+            }
+
+            const int ClientFd = accept(ListenFd, nullptr, nullptr);
+            if (ClientFd < 0)
+            {
+                return nullptr;
+            }
+
+            PrepareLocalSocket(ClientFd);
+            return MakeShared<FUnixDomainStream, ESPMode::ThreadSafe>(ClientFd);
+        }
+
+        virtual void Shutdown() override
+        {
+            bShutdown = true;
+            const uint8 Wake = 1;
+            const ssize_t Ignored = write(WakeWriteFd, &Wake, 1);
+            (void)Ignored;
+        }
+
+        virtual FString Describe() const override
+        {
+            return Path;
+        }
+
+    private:
+        int ListenFd;
+        int WakeReadFd;
+        int WakeWriteFd;
+        FString Path;
+        std::atomic<bool> bShutdown;
+    };
+
+    FStreamListenerPtr CreatePlatformListener(const FString& Path, FString& OutError)
+    {
+        sockaddr_un Address;
+        if (!MakeUnixAddress(Path, Address, OutError))
+        {
+            return nullptr;
+        }
+
+        // A leftover socket file from a crashed editor is removed; a live one means another
+        // editor already owns this endpoint.
+        const int ProbeFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (ProbeFd >= 0)
+        {
+            const bool bInUse = connect(ProbeFd, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) == 0;
+            close(ProbeFd);
+            if (bInUse)
+            {
+                OutError = FString::Printf(TEXT("Local endpoint %s is already in use"), *Path);
+                return nullptr;
+            }
+        }
+        unlink(Address.sun_path);
+
+        const int ListenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (ListenFd < 0)
+        {
+            OutError = DescribeErrno(TEXT("socket"), errno);
+            return nullptr;
+        }
+        PrepareLocalSocket(ListenFd);
+
+        if (bind(ListenFd, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) != 0)
+        {
+            OutError = DescribeErrno(TEXT("bind"), errno);
+            close(ListenFd);
+            return nullptr;
+        }
+
+        // Only the editor's user may connect.
+        chmod(Address.sun_path, S_IRUSR | S_IWUSR);
+
+        if (listen(ListenFd, LocalListenBacklog) != 0)
+        {
+            OutError = DescribeErrno(TEXT("listen"), errno);
+            close(ListenFd);
+            unlink(Address.sun_path);
+            return nullptr;
+        }
+        fcntl(ListenFd, F_SETFL, fcntl(ListenFd, F_GETFL, 0) | O_NONBLOCK);
+
+        int WakeFds[2];
+        if (pipe(WakeFds) != 0)
+        {
+            OutError = DescribeErrno(TEXT("pipe"), errno);
+            close(ListenFd);
+            unlink(Address.sun_path);
+            return nullptr;
+        }
+        fcntl(WakeFds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(WakeFds[1], F_SETFD, FD_CLOEXEC);
+
+        return MakeShared<FUnixDomainListener, ESPMode::ThreadSafe>(ListenFd, WakeFds[0], WakeFds[1], Path);
+    }
+
+    FByteStreamPtr ConnectPlatformStream(const FString& Path, double /*TimeoutSeconds*/, FString& OutError)
+    {
+        sockaddr_un Address;
+        if (!MakeUnixAddress(Path, Address, OutError))
+        {
+            return nullptr;
+        }
+
+        const int Fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (Fd < 0)
+        {
+            OutError = DescribeErrno(TEXT("socket"), errno);
+            return nullptr;
+        }
+        PrepareLocalSocket(Fd);
+
+        // Connecting to a local socket completes (or is refused) immediately.
+        if (connect(Fd, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) != 0)
+        {
+            OutError = DescribeErrno(TEXT("connect"), errno);
+            close(Fd);
+            return nullptr;
+        }
+
+        return MakeShared<FUnixDomainStream, ESPMode::ThreadSafe>(Fd);
+    }
+
+#elif PLATFORM_WINDOWS
+
+    constexpr DWORD PipeBufferBytes = 64 * 1024;
+
+    FString DescribeWin32Error(const TCHAR* Operation, DWORD ErrorCode)
+    {
+        return FString::Printf(TEXT("%s failed (error %u)"), Operation, static_cast<uint32>(ErrorCode));
+    }
+
+    /**
+     * One end of an overlapped byte-mode named pipe. Reads go through a read-ahead buffer with a
+     * single outstanding ReadFile, so Wait(Read) is an event wait rather than a poll. Writes block
+     * until the pipe accepts the data, matching the blocking TCP sockets the server uses.
+     */
+    class FNamedPipeStream final : public IByteStream
+    {
+    public:
+        FNamedPipeStream(HANDLE InPipe, bool bInServerEnd)
+            : Pipe(InPipe)
+            , bServerEnd(bInServerEnd)
+            , ReadAheadSize(0)
+            , ReadAheadOffset(0)
+            , bReadPending(false)
+            , bShutdown(false)
+            , bPeerClosed(false)
+        {
+            FMemory::Memzero(ReadOverlapped);
+            FMemory::Memzero(WriteOverlapped);
+            ReadOverlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            WriteOverlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            ShutdownEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            ReadAhead.SetNumUninitialized(PipeBufferBytes);
+        }
+
+        virtual ~FNamedPipeStream() override
+        {
+            Close();
+            CloseHandle(ReadOverlapped.hEvent);
+            CloseHandle(WriteOverlapped.hEvent);
+            CloseHandle(ShutdownEvent);
+        }
+
+        virtual bool Recv(uint8* Data, int32 MaxBytes, int32& OutBytesRead, bool& bOutWouldBlock) override
+        {
+            bOutWouldBlock = false;
+            OutBytesRead = 0;
+            if (!PumpRead())
+            {
+                return bPeerClosed;
+            }
+
+            if (ReadAheadOffset >= ReadAheadSize)
+            {
+                if (bPeerClosed)
+                {
+                    return true;
+                }
+                bOutWouldBlock = true;
+                SetLastError(ERROR_IO_PENDING);
+                return false;
+            }
+
+            OutBytesRead = FMath::Min(MaxBytes, ReadAheadSize - ReadAheadOffset);
+            FMemory::Memcpy(Data, ReadAhead.GetData() + ReadAheadOffset, OutBytesRead);
+            ReadAheadOffset += OutBytesRead;
+            return true;
+        }
+
+        virtual bool Send(const uint8* Data, int32 Length, int32& OutBytesSent, bool& bOutWouldBlock) override
+        {
+            bOutWouldBlock = false;
+            OutBytesSent = 0;
+            if (bShutdown)
+            {
+                SetLastError(ERROR_OPERATION_ABORTED);
+                return false;
+            }
+
+            DWORD Written = 0;
+            if (!WriteFile(Pipe, Data, static_cast<DWORD>(Length), nullptr, &WriteOverlapped) && GetLastError() != ERROR_IO_PENDING)
+            {
+                return false;
+            }
+
+            // Block until the pipe takes the data; Shutdown cancels the write so the caller's buffer is released.
+            HANDLE Handles[2] = { WriteOverlapped.hEvent, ShutdownEvent };
+            if (WaitForMultipleObjects(2, Handles, FALSE, INFINITE) != WAIT_OBJECT_0)
+            {
+                CancelIoEx(Pipe, &WriteOverlapped);
+            }
+            if (!GetOverlappedResult(Pipe, &WriteOverlapped, &Written, TRUE))
+            {
+                return false;
+            }
+
+            OutBytesSent = static_cast<int32>(Written);
+            return true;
+        }
+
+        virtual bool Wait(EStreamWait Condition, double TimeoutSeconds) override
+        {
+            if (bShutdown)
+            {
+                return false;
+            }
+            if (Condition == EStreamWait::Write)
+            {
+                return true;
+            }
+
+            if (!PumpRead() || ReadAheadOffset < ReadAheadSize || bPeerClosed)
+            {
+                return true;
+            }
+
+            HANDLE Handles[2] = { ReadOverlapped.hEvent, ShutdownEvent };
+            return WaitForMultipleObjects(2, Handles, FALSE, static_cast<DWORD>(ToWaitMilliseconds(TimeoutSeconds))) == WAIT_OBJECT_0;
+        }
+
+        virtual bool IsConnected() const override
+        {
+            return !bShutdown && !bPeerClosed && Pipe != INVALID_HANDLE_VALUE;
+        }
+
+        virtual void Shutdown() override
+        {
+            bShutdown = true;
+            SetEvent(ShutdownEvent);
+        }
+
+        virtual void Close() override
+        {
+            FScopeLock Lock(&HandleLock);
+            bShutdown = true;
+            SetEvent(ShutdownEvent);
+            if (Pipe == INVALID_HANDLE_VALUE)
+            {
+                return;
+            }
+
+            // The read-ahead buffer must outlive any outstanding ReadFile.
+            if (bReadPending)
+            {
+                DWORD Ignored = 0;
+                CancelIoEx(Pipe, &ReadOverlapped);
+                GetOverlappedResult(Pipe, &ReadOverlapped, &Ignored, TRUE);
+                bReadPending = false;
+            }
+            if (bServerEnd)
+            {
+                FlushFileBuffers(Pipe);
+                DisconnectNamedPipe(Pipe);
+            }
+            CloseHandle(Pipe);
+            Pipe = INVALID_HANDLE_VALUE;
+        }
+
+        virtual FString DescribeLastError(const TCHAR* Operation) const override
+        {
+            return DescribeWin32Error(Operation, GetLastError());
+        }
+
+        virtual const TCHAR* GetTransportName() const override
+        {
+            return TEXT("pipe");
+        }
+
+    private:
+        /**
+         * Ensures either buffered data or an outstanding read. Returns false on a pipe error or
+         * once the peer has disconnected (bPeerClosed set).
+         */
+        bool PumpRead()
+        {
+            if (bShutdown || bPeerClosed)
+            {
+                return false;
+            }
+            if (ReadAheadOffset < ReadAheadSize)
+            {
+                return true;
+            }
+
+            if (!bReadPending)
+            {
+                ReadAheadSize = 0;
+                ReadAheadOffset = 0;
+                if (!ReadFile(Pipe, ReadAhead.GetData(), PipeBufferBytes, nullptr, &ReadOverlapped) && GetLastError() != ERROR_IO_PENDING)
+                {
+                    return HandleReadError(GetLastError());
+                }
+                bReadPending = true;
+            }
+
+            DWORD Transferred = 0;
+            if (!GetOverlappedResult(Pipe, &ReadOverlapped, &Transferred, FALSE))
+            {
+                const DWORD ErrorCode = GetLastError();
+                if (ErrorCode == ERROR_IO_INCOMPLETE)
+                {
+                    return true;
+                }
+                bReadPending = false;
+                return HandleReadError(ErrorCode);
+            }
+
+            bReadPending = false;
+            ReadAheadSize = static_cast<int32>(Transferred);
+            return true;
+        }
+
+        bool HandleReadError(DWORD ErrorCode)
+        {
+            if (ErrorCode == ERROR_BROKEN_PIPE || ErrorCode == ERROR_PIPE_NOT_CONNECTED)
+            {
+                bPeerClosed = true;
+            }
+            SetLastError(ErrorCode);
+            return false;
+        }
+
+        HANDLE Pipe;
+        bool bServerEnd;
+        OVERLAPPED ReadOverlapped;
+        OVERLAPPED WriteOverlapped;
+        HANDLE ShutdownEvent;
+        TArray<uint8> ReadAhead;
+        int32 ReadAheadSize;
+        int32 ReadAheadOffset;
+        bool bReadPending;
+        std::atomic<bool> bShutdown;
+        bool bPeerClosed;
+        FCriticalSection HandleLock;
+    };
+
+    HANDLE CreatePipeInstance(const FString& Path, bool bFirstInstance)
+    {
+        const DWORD OpenMode = PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED | (bFirstInstance ? FILE_FLAG_FIRST_PIPE_INSTANCE : 0);
+        return CreateNamedPipeW(*Path, OpenMode,
+            PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+            PIPE_UNLIMITED_INSTANCES, PipeBufferBytes, PipeBufferBytes, 0, nullptr);
+    }
+
+    /** Keeps one pipe instance waiting in ConnectNamedPipe; each accepted client gets a fresh one. */
+    class FNamedPipeListener final : public IStreamListener
+    {
+    public:
+        FNamedPipeListener(HANDLE InFirstInstance, const FString& InPath)
+            : PendingPipe(InFirstInstance)
+            , Path(InPath)
+            , bConnectPending(false)
+            , bShutdown(false)
+        {
+            FMemory::Memzero(ConnectOverlapped);
+            ConnectOverlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            WakeEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        }
+
+        virtual ~FNamedPipeListener() override
+        {
+            if (PendingPipe != INVALID_HANDLE_VALUE)
+            {
+                if (bConnectPending)
+                {
+                    DWORD Ignored = 0;
+                    CancelIoEx(PendingPipe, &ConnectOverlapped);
+                    GetOverlappedResult(PendingPipe, &ConnectOverlapped, &Ignored, TRUE);
+                }
+                CloseHandle(PendingPipe);
+            }
+            CloseHandle(ConnectOverlapped.hEvent);
+            CloseHandle(WakeEvent);
+        }
+
+        virtual FByteStreamPtr Accept(double TimeoutSeconds) override
+        {
+            if (bShutdown || PendingPipe == INVALID_HANDLE_VALUE)
+            {
+                return nullptr;
+            }
+
+            bool bConnected = false;
+            if (!bConnectPending)
+            {
+                if (ConnectNamedPipe(PendingPipe, &ConnectOverlapped))
+                {
+                    bConnected = true;
+                }
+                else
+                {
+                    const DWORD ErrorCode = GetLastError();
+                    if (ErrorCode == ERROR_PIPE_CONNECTED)
+                    {
+                        bConnected = true;
+                    }
+                    else if (ErrorCode == ERROR_IO_PENDING)
+                    {
+                        bConnectPending = true;
+                    }
+                    else
+                    {
+                        RecyclePendingPipe();
+                        return nullptr;
+                    }
+                }
+            }
+
+            if (!bConnected)
+            {
+                HANDLE Handles[2] = { ConnectOverlapped.hEvent, WakeEvent };
+                if (WaitForMultipleObjects(2, Handles, FALSE, static_cast<DWORD>(ToWaitMilliseconds(TimeoutSeconds))) != WAIT_OBJECT_0 || bShutdown)
+                {
+                    return nullptr;
+                }
+
+                DWORD Ignored = 0;
+                bConnectPending = false;
+                if (!GetOverlappedResult(PendingPipe, &ConnectOverlapped, &Ignored, FALSE))
+                {
+                    RecyclePendingPipe();
+                    return nullptr;
+                }
+            }
+
+            HANDLE ClientPipe = PendingPipe;
+            PendingPipe = CreatePipeInstance(Path, false);
+            return MakeShared<FNamedPipeStream, ESPMode::ThreadSafe>(ClientPipe, true);
+        }
+
+        virtual void Shutdown() override
+        {
+            bShutdown = true;
+            SetEvent(WakeEvent);
+        }
+
+        virtual FString Describe() const override
+        {
+            return Path;
+        }
+
+    private:
+        /** Replaces an instance whose connect failed (e.g. the client gave up) with a fresh one. */
+        void RecyclePendingPipe()
+        {
+            bConnectPending = false;
+            DisconnectNamedPipe(PendingPipe);
+            CloseHandle(PendingPipe);
+            PendingPipe = CreatePipeInstance(Path, false);
+            FPlatformProcess::Sleep(ListenerErrorBackoffSeconds);
+        }
+
+        HANDLE PendingPipe;
+        FString Path;
+        OVERLAPPED ConnectOverlapped;
+        HANDLE WakeEvent;
+        bool bConnectPending;
+        std::atomic<bool> bShutdown;
+    };
+
+    FStreamListenerPtr CreatePlatformListener(const FString& Path, FString& OutError)
+    {
+        // FILE_FLAG_FIRST_PIPE_INSTANCE fails if another process already serves this name.
+        HANDLE FirstInstance = CreatePipeInstance(Path, true);
+        if (FirstInstance == INVALID_HANDLE_VALUE)
+        {
+            const DWORD ErrorCode = GetLastError();
+            OutError = ErrorCode == ERROR_ACCESS_DENIED
+                ? FString::Printf(TEXT("Local endpoint %s is already in use"), *Path)
+                : DescribeWin32Error(TEXT("CreateNamedPipe"), ErrorCode);
+            return nullptr;
+        }
+
+        return MakeShared<FNamedPipeListener, ESPMode::ThreadSafe>(FirstInstance, Path);
+    }
+
+    FByteStreamPtr ConnectPlatformStream(const FString& Path, double TimeoutSeconds, FString& OutError)
+    {
+        const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+        for (;;)
+        {
+            HANDLE Pipe = CreateFileW(*Path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, nullptr);
+            if (Pipe != INVALID_HANDLE_VALUE)
+            {
+                return MakeShared<FNamedPipeStream, ESPMode::ThreadSafe>(Pipe, false);
+            }
+
+            const DWORD ErrorCode = GetLastError();
+            const double Remaining = Deadline - FPlatformTime::Seconds();
+            if (ErrorCode != ERROR_PIPE_BUSY || Remaining <= 0.0)
+            {
+                OutError = DescribeWin32Error(TEXT("CreateFile"), ErrorCode);
+                return nullptr;
+            }
+
+            // Every instance is mid-handshake with another client; wait for the next one.
+            WaitNamedPipeW(*Path, static_cast<DWORD>(ToWaitMilliseconds(Remaining)));
+        }
+    }
+
+#else
+
+    FStreamListenerPtr CreatePlatformListener(const FString& /*Path*/, FString& OutError)
+    {
+        OutError = TEXT("The local IPC transport is not supported on this platform");
+        return nullptr;
+    }
+
+    FByteStreamPtr ConnectPlatformStream(const FString& /*Path*/, double /*TimeoutSeconds*/, FString& OutError)
+    {
+        OutError = TEXT("The local IPC transport is not supported on this platform");
+        return nullptr;
+    }
+
+#endif
+}
+
+FByteStreamPtr MakeSocketStream(const TSharedPtr<FSocket>& Socket)
+{
+    if (!Socket.IsValid())
+    {
+        return nullptr;
+    }
+    return MakeShared<FSocketByteStream, ESPMode::ThreadSafe>(Socket);
+}
+
+FStreamListenerPtr MakeSocketListener(const TSharedPtr<FSocket>& ListenerSocket)
+{
+    if (!ListenerSocket.IsValid())
+    {
+        return nullptr;
+    }
+    return MakeShared<FSocketStreamListener, ESPMode::ThreadSafe>(ListenerSocket);
+}
+
+FString GetLocalEndpointPath(const FString& Name)
+{
+#if PLATFORM_WINDOWS
+    return FString::Printf(TEXT("\\\\.\\pipe\\%s"), *SanitizeEndpointName(Name));
+#else
+    return FPaths::Combine(FPlatformProcess::UserTempDir(), SanitizeEndpointName(Name) + TEXT(".sock"));
+#endif
+}
+
+FStreamListenerPtr CreateLocalListener(const FString& Name, FString& OutError)
+{
+    return CreatePlatformListener(GetLocalEndpointPath(Name), OutError);
+}
+
+FByteStreamPtr ConnectLocalStream(const FString& Name, double TimeoutSeconds, FString& OutError)
+{
+    return ConnectPlatformStream(GetLocalEndpointPath(Name), TimeoutSeconds, OutError);
+}
+
+}
+}
@@ -1,6 +1,7 @@
 #include "Sequencer/SequenceBindings.h"
 #include "CoreMinimal.h"
 
+#include "Actors/ActorIndex.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Editor.h"
@@ -14,6 +15,7 @@
 #include "MovieScenePossessable.h"
 #include "MovieSceneSequence.h"
 #include "ExtensionLibraries/MovieSceneSequenceExtensions.h"
+#include "UObject/ObjectKey.h"
 #include "UObject/Package.h"
 #include "UObject/UObjectGlobals.h"
 
@@ -82,18 +84,7 @@ namespace
             return DirectActor;
         }
 
-        if (UWorld* World = GetEditorWorld())
-        {
-            for (TActorIterator<AActor> It(World); It; ++It)
-            {
-                if (It->GetPathName() == Trimmed || It->GetName() == Trimmed)
-                {
-                    return *It;
-                }
-            }
-        }
-
-        return nullptr;
+        return FActorIndex::Get().Resolve(GetEditorWorld(), Trimmed);
     }
 
     FString MakeGuidString(const FGuid& Guid)
@@ -136,9 +127,161 @@ namespace
         return UE::MovieScene::FResolveParams(PlaybackContext, BindingContext);
     }
 
+    /** Sequences whose resolved bindings are kept; the cache starts over past this. */
+    constexpr int32 MaxCachedSequences = 32;
+
+    /**
+     * What a sequence's bindings resolve to in one world, from a single pass over the bindings. It
+     * stays valid while the binding list is unchanged and the actor index reports no actor change.
+     */
+    struct FResolvedBindings
+    {
+        uint64 ActorRevision = 0;
+        /** The sequence's binding GUIDs in order, to tell when the list changed. */
+        TArray<FGuid> BindingIds;
+        /** First actor each binding resolves to, parallel to BindingIds; null when it resolves to none. */
+        TArray<TWeakObjectPtr<AActor>> BoundActors;
+        TMultiMap<FObjectKey, FGuid> BindingsByActor;
+    };
+
+    TMap<TPair<FObjectKey, FObjectKey>, FResolvedBindings>& GetResolvedBindingsCache()
+    {
+        static TMap<TPair<FObjectKey, FObjectKey>, FResolvedBindings> Cache;
+        return Cache;
+    }
+
+    bool IsCurrent(const FResolvedBindings& Resolved, const TArray<FMovieSceneBinding>& Bindings, uint64 ActorRevision)
+    {
+        if (Resolved.ActorRevision != ActorRevision || Resolved.BindingIds.Num() != Bindings.Num())
+        {
+            return false;
+        }
+
+        for (int32 Index = 0; Index < Bindings.Num(); ++Index)
+        {
+            if (Resolved.BindingIds[Index] != Bindings[Index].GetObjectGuid() || Resolved.BoundActors[Index].IsStale())
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void ResolveBinding(ULevelSequence& Sequence, UWorld* World, const FGuid& Guid, FResolvedBindings& Resolved)
+    {
+        TWeakObjectPtr<AActor>& BoundActor = Resolved.BoundActors.AddDefaulted_GetRef();
+        Resolved.BindingIds.Add(Guid);
+
+        TArray<UObject*, TInlineAllocator<1>> LocatedObjects;
+        Sequence.LocateBoundObjects(Guid, MakeResolveParams(World, World), LocatedObjects);
+        for (UObject* Object : LocatedObjects)
+        {
+            if (AActor* Actor = Cast<AActor>(Object))
+            {
+                if (!BoundActor.IsValid())
+                {
+                    BoundActor = Actor;
+                }
+                Resolved.BindingsByActor.Add(FObjectKey(Actor), Guid);
+            }
+        }
+    }
+
+    /**
+     * The sequence's bindings resolved in World, from the cache when nothing changed since they were
+     * last resolved. Null for game worlds, whose actors the index does not track; callers resolve
+     * those directly.
+     */
+    const FResolvedBindings* FindResolvedBindings(ULevelSequence& Sequence, UWorld* World)
+    {
+        check(IsInGameThread());
+        FActorIndex& ActorIndex = FActorIndex::Get();
+        UMovieScene* MovieScene = Sequence.GetMovieScene();
+        if (!MovieScene || !ActorIndex.IsTracking(World))
+        {
+            return nullptr;
+        }
+
+        TMap<TPair<FObjectKey, FObjectKey>, FResolvedBindings>& Cache = GetResolvedBindingsCache();
+        const TPair<FObjectKey, FObjectKey> Key(FObjectKey(&Sequence), FObjectKey(World));
+        const TArray<FMovieSceneBinding>& Bindings = MovieScene->GetBindings();
+        if (FResolvedBindings* Existing = Cache.Find(Key))
+        {
+            if (IsCurrent(*Existing, Bindings, ActorIndex.GetRevision()))
+            {
+                return Existing;
+            }
+        }
+        else if (Cache.Num() >= MaxCachedSequences)
+        {
+            Cache.Reset();
+        }
+
+        FResolvedBindings& Resolved = Cache.FindOrAdd(Key);
+        Resolved = FResolvedBindings();
+        Resolved.ActorRevision = ActorIndex.GetRevision();
+        Resolved.BindingIds.Reserve(Bindings.Num());
+        Resolved.BoundActors.Reserve(Bindings.Num());
+        for (const FMovieSceneBinding& Binding : Bindings)
+        {
+            ResolveBinding(Sequence, World, Binding.GetObjectGuid(), Resolved);
+        }
+        return &Resolved;
+    }
+
+    /** Brings a cached entry up to date after BindActors added a binding, so the next actor need not re-resolve them all. */
+    void NoteBindingAdded(ULevelSequence& Sequence, UWorld* World, const FGuid& BindingId)
+    {
+        FResolvedBindings* Resolved = GetResolvedBindingsCache().Find(TPair<FObjectKey, FObjectKey>(FObjectKey(&Sequence), FObjectKey(World)));
+        const UMovieScene* MovieScene = Sequence.GetMovieScene();
+        if (!Resolved || !MovieScene)
+        {
+            return;
+        }
+
+        // Only an append keeps the cached order; anything else is left for IsCurrent to reject.
+        const TArray<FMovieSceneBinding>& Bindings = MovieScene->GetBindings();
+        if (Bindings.Num() == Resolved->BindingIds.Num() + 1 && Bindings.Last().GetObjectGuid() == BindingId)
+        {
+            ResolveBinding(Sequence, World, BindingId, *Resolved);
+        }
+    }
+
+    void NoteBindingRemoved(ULevelSequence& Sequence, UWorld* World, const FGuid& BindingId)
+    {
+        FResolvedBindings* Resolved = GetResolvedBindingsCache().Find(TPair<FObjectKey, FObjectKey>(FObjectKey(&Sequence), FObjectKey(World)));
+        if (!Resolved)
+        {
+            return;
+        }
+
+        const int32 Index = Resolved->BindingIds.IndexOfByKey(BindingId);
+        if (Index == INDEX_NONE)
+        {
+            return;
+        }
+
+        Resolved->BindingIds.RemoveAt(Index);
+        Resolved->BoundActors.RemoveAt(Index);
+        for (auto It = Resolved->BindingsByActor.CreateIterator(); It; ++It)
+        {
+            if (It.Value() == BindingId)
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+
     TArray<FGuid> FindBindingsForActor(ULevelSequence& Sequence, AActor& Actor)
     {
         TArray<FGuid> Result;
+        if (const FResolvedBindings* Resolved = FindResolvedBindings(Sequence, Actor.GetWorld()))
+        {
+            Resolved->BindingsByActor.MultiFind(FObjectKey(&Actor), Result, /*bMaintainOrder=*/true);
+            return Result;
+        }
+
         if (UMovieScene* MovieScene = Sequence.GetMovieScene())
         {
             for (const FMovieSceneBinding& Binding : MovieScene->GetBindings())
@@ -161,7 +304,7 @@ namespace
         return Result;
     }
 
-    bool RemoveBindingByGuid(ULevelSequence& Sequence, const FGuid& BindingId)
+    bool RemoveBindingByGuid(ULevelSequence& Sequence, const FGuid& BindingId, UWorld* World)
     {
         if (UMovieScene* MovieScene = Sequence.GetMovieScene())
         {
@@ -169,6 +312,7 @@ namespace
             if (BindingIndex != INDEX_NONE)
             {
                 MovieScene->RemoveBinding(BindingId);
+                NoteBindingRemoved(Sequence, World, BindingId);
                 return true;
             }
         }
@@ -374,6 +518,7 @@ TSharedPtr<FJsonObject> FSequenceBindings::BindActors(const TSharedPtr<FJsonObje
             UMovieSceneSequenceExtensions::SetBindingDisplayName(LevelSequence, BindingGuid, FText::FromString(FinalLabel));
         }
 
+        NoteBindingAdded(*LevelSequence, Actor->GetWorld(), BindingGuid);
         AppendAdded(AddedArray, Actor->GetPathName(), BindingGuid, FinalLabel);
         AppendAuditAction(AuditActions, TEXT("bind"), {{TEXT("actor"), Actor->GetPathName()}});
         bModified = true;
@@ -382,7 +527,7 @@ TSharedPtr<FJsonObject> FSequenceBindings::BindActors(const TSharedPtr<FJsonObje
         {
             for (const FGuid& BindingId : ExistingBindings)
             {
-                if (RemoveBindingByGuid(*LevelSequence, BindingId))
+                if (RemoveBindingByGuid(*LevelSequence, BindingId, Actor->GetWorld()))
                 {
                     AppendAuditAction(AuditActions, TEXT("unbind"), {{TEXT("bindingId"), MakeGuidString(BindingId)}});
                 }
@@ -547,9 +692,10 @@ TSharedPtr<FJsonObject> FSequenceBindings::Unbind(const TSharedPtr<FJsonObject>&
     MovieScene->Modify();
     LevelSequence->Modify();
 
+    UWorld* World = GetEditorWorld();
     for (const FGuid& BindingId : BindingIdsToRemove)
     {
-        if (RemoveBindingByGuid(*LevelSequence, BindingId))
+        if (RemoveBindingByGuid(*LevelSequence, BindingId, World))
         {
             AppendRemoved(RemovedArray, BindingId);
             AppendAuditAction(AuditActions, TEXT("unbind"), {{TEXT("bindingId"), MakeGuidString(BindingId)}});
@@ -616,11 +762,15 @@ TSharedPtr<FJsonObject> FSequenceBindings::List(const TSharedPtr<FJsonObject>& P
     }
 
     UWorld* World = GetEditorWorld();
+    // Resolved once per sequence and world and reused until a binding or actor changes.
+    const FResolvedBindings* Resolved = World ? FindResolvedBindings(*LevelSequence, World) : nullptr;
 
     TArray<TSharedPtr<FJsonValue>> BindingsArray;
 
-    for (const FMovieSceneBinding& Binding : MovieScene->GetBindings())
+    const TArray<FMovieSceneBinding>& Bindings = MovieScene->GetBindings();
+    for (int32 BindingIndex = 0; BindingIndex < Bindings.Num(); ++BindingIndex)
     {
+        const FMovieSceneBinding& Binding = Bindings[BindingIndex];
         TSharedPtr<FJsonObject> BindingJson = MakeShared<FJsonObject>();
         const FGuid& Guid = Binding.GetObjectGuid();
         BindingJson->SetStringField(TEXT("bindingId"), MakeGuidString(Guid));
@@ -633,7 +783,14 @@ TSharedPtr<FJsonObject> FSequenceBindings::List(const TSharedPtr<FJsonObject>& P
             BindingJson->SetStringField(TEXT("possessedObjectClass"), Possessable->GetPossessedObjectClassName());
         }
 
-        if (World)
+        if (Resolved)
+        {
+            if (const AActor* Actor = Resolved->BoundActors[BindingIndex].Get())
+            {
+                BindingJson->SetStringField(TEXT("boundActorPath"), Actor->GetPathName());
+            }
+        }
+        else if (World)
         {
             TArray<UObject*, TInlineAllocator<1>> LocatedObjects;
             LevelSequence->LocateBoundObjects(Guid, MakeResolveParams(World, World), LocatedObjects);
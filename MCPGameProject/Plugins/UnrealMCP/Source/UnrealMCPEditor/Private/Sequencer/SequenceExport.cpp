@@ -1,26 +1,43 @@
 #include "Sequencer/SequenceExport.h"
 #include "CoreMinimal.h"
 
+#include "Protocol/CommandContext.h"
+#include "Protocol/ResponseStream.h"
+#include "Sequencer/SequenceExportCache.h"
+
+#include "Algo/BinarySearch.h"
 #include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
 #include "Channels/MovieSceneBoolChannel.h"
 #include "Channels/MovieSceneByteChannel.h"
 #include "Channels/MovieSceneChannelProxy.h"
 #include "Channels/MovieSceneFloatChannel.h"
 #include "Channels/MovieSceneIntegerChannel.h"
+#include "Components/SceneComponent.h"
+#include "Containers/StringConv.h"
+#include "Curves/RichCurve.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Editor.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
 #include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
 #include "LevelSequence.h"
+#include "LevelSequencePlayer.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
 #include "Misc/PackageName.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/Paths.h"
 #include "MovieScene.h"
 #include "MovieSceneBinding.h"
 #include "MovieScenePossessable.h"
 #include "MovieSceneObjectBindingID.h"
 #include "MovieSceneSequence.h"
+#include "MovieSceneSequencePlaybackSettings.h"
 #include "MovieSceneSpawnable.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "Sections/MovieScene3DTransformSection.h"
 #include "Sections/MovieSceneBoolSection.h"
 #include "Sections/MovieSceneByteSection.h"
@@ -29,6 +46,10 @@
 #include "Sections/MovieSceneFloatSection.h"
 #include "Sections/MovieSceneIntegerSection.h"
 #include "MovieSceneSection.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryWriter.h"
 #include "Tracks/MovieScene3DTransformTrack.h"
 #include "Tracks/MovieSceneBoolTrack.h"
 #include "Tracks/MovieSceneByteTrack.h"
@@ -39,13 +60,18 @@
 #include "Tracks/MovieScenePropertyTrack.h"
 #include "Tracks/MovieSceneVisibilityTrack.h"
 #include "UObject/Object.h"
+#include "UObject/Package.h"
 #include "UObject/UObjectGlobals.h"
 
+#include <limits>
+
 namespace
 {
     constexpr const TCHAR* ErrorCodeInvalidParameters = TEXT("INVALID_PARAMETERS");
     constexpr const TCHAR* ErrorCodeSequenceNotFound = TEXT("SEQUENCE_NOT_FOUND");
     constexpr const TCHAR* ErrorCodeUnsupportedFormat = TEXT("UNSUPPORTED_FORMAT");
+    constexpr const TCHAR* ErrorCodeCancelled = TEXT("CANCELLED");
+    constexpr const TCHAR* ErrorCodeOutputFailed = TEXT("OUTPUT_FAILED");
 
     TSharedPtr<FJsonObject> MakeErrorResponse(const FString& Code, const FString& Message)
     {
@@ -204,31 +230,46 @@ namespace
         TOptional<FFrameNumber> TickStart;
         TOptional<FFrameNumber> TickEnd;
 
-        bool ContainsTick(const FFrameNumber& Tick) const
+        bool ContainsDisplay(int32 Frame) const
         {
-            if (TickStart.IsSet() && Tick < TickStart.GetValue())
+            if (DisplayStart.IsSet() && Frame < DisplayStart.GetValue())
             {
                 return false;
             }
-            if (TickEnd.IsSet() && Tick > TickEnd.GetValue())
+            if (DisplayEnd.IsSet() && Frame > DisplayEnd.GetValue())
             {
                 return false;
             }
             return true;
         }
 
-        bool ContainsDisplay(int32 Frame) const
+        /** False when no tick of SectionRange is inside the filter; an open side reaches forever. */
+        bool OverlapsSection(const TRange<FFrameNumber>& SectionRange) const
         {
-            if (DisplayStart.IsSet() && Frame < DisplayStart.GetValue())
+            const TRangeBound<FFrameNumber>& Lower = SectionRange.GetLowerBound();
+            const TRangeBound<FFrameNumber>& Upper = SectionRange.GetUpperBound();
+            if (TickEnd.IsSet() && Lower.IsClosed() && (Lower.IsExclusive() ? Lower.GetValue() + 1 : Lower.GetValue()) > TickEnd.GetValue())
             {
                 return false;
             }
-            if (DisplayEnd.IsSet() && Frame > DisplayEnd.GetValue())
+            if (TickStart.IsSet() && Upper.IsClosed() && (Upper.IsExclusive() ? Upper.GetValue() - 1 : Upper.GetValue()) < TickStart.GetValue())
             {
                 return false;
             }
             return true;
         }
+
+        /** The index of the first of the sorted key Times inside the tick range. */
+        int32 FirstKeyIndex(TArrayView<const FFrameNumber> Times) const
+        {
+            return TickStart.IsSet() ? Algo::LowerBound(Times, TickStart.GetValue()) : 0;
+        }
+
+        /** One past the index of the last of the sorted key Times inside the tick range. */
+        int32 EndKeyIndex(TArrayView<const FFrameNumber> Times) const
+        {
+            return TickEnd.IsSet() ? Algo::UpperBound(Times, TickEnd.GetValue()) : Times.Num();
+        }
     };
 
     bool ParseFrameRange(const UMovieScene& MovieScene, const TSharedPtr<FJsonObject>& Params, FFrameRangeFilter& OutFilter, FString& OutError)
@@ -285,20 +326,6 @@ namespace
         return true;
     }
 
-    FString CsvEscape(const FString& Value)
-    {
-        FString Result = Value;
-        Result.ReplaceInline(TEXT("\""), TEXT(""""));
-
-        const bool bNeedsQuotes = Result.Contains(TEXT(",")) || Result.Contains(TEXT("\n")) || Result.Contains(TEXT("\""));
-        if (bNeedsQuotes)
-        {
-            return FString::Printf(TEXT("\"%s\""), *Result);
-        }
-
-        return Result;
-    }
-
     FString OptionalIntToString(const TOptional<int32>& Value)
     {
         return Value.IsSet() ? FString::FromInt(Value.GetValue()) : FString();
@@ -307,7 +334,19 @@ namespace
     enum class EExportFormat
     {
         Json,
-        Csv
+        Csv,
+        Columnar
+    };
+
+    /**
+     * How curve channels (transforms, float and color properties) are keyed: evaluated at their key
+     * times, as the raw keys with interpolation and tangents, or baked at every display frame.
+     */
+    enum class EKeyMode
+    {
+        Evaluated,
+        Raw,
+        Baked
     };
 
     struct FIncludeSettings
@@ -379,337 +418,1288 @@ namespace
         }
     }
 
-    void AppendRangeArray(const UMovieScene& MovieScene, const TRange<FFrameNumber>& Range, const FFrameRangeFilter& Filter, TSharedPtr<FJsonObject>& SectionJson)
+    /** Bytes a streamed export buffers before it sends a chunk. */
+    constexpr int32 StreamChunkBytes = 64 * 1024;
+
+    /** Bindings exported in parallel before their output is appended; bounds what a wave holds. */
+    constexpr int32 BindingsPerWave = 256;
+
+    typedef TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>> FUtf8ExportWriter;
+    typedef TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>> FUtf8ExportWriterFactory;
+
+    /** Where the export text goes: the response itself, the response stream, or a file under Saved/. */
+    enum class EExportSink
     {
-        if (!SectionJson.IsValid())
-        {
-            return;
-        }
+        Response,
+        Stream,
+        File
+    };
 
-        if (!Range.HasLowerBound() && !Range.HasUpperBound())
+    /**
+     * Archive that hands UTF-8 text to the response stream a chunk at a time. A chunk never ends
+     * inside a multi-byte character, since each one is sent as text.
+     */
+    class FStreamChunkArchive : public FArchive
+    {
+    public:
+        explicit FStreamChunkArchive(UnrealMCP::Protocol::FResponseStream& InStream)
+            : Stream(InStream)
         {
-            return;
+            SetIsSaving(true);
         }
 
-        FFrameNumber StartTick = Range.HasLowerBound() ? Range.GetLowerBoundValue() : FFrameNumber(0);
-        FFrameNumber EndTick = Range.HasUpperBound() ? Range.GetUpperBoundValue() : StartTick;
-
-        if (Range.GetUpperBound().IsOpen())
+        virtual void Serialize(void* Data, int64 Num) override
         {
-            EndTick = StartTick;
+            Pending.Append(static_cast<const uint8*>(Data), Num);
+            BytesWritten += Num;
+            if (Pending.Num() >= StreamChunkBytes)
+            {
+                SendPending(false);
+            }
         }
-        else if (Range.GetUpperBound().IsExclusive())
+
+        virtual FString GetArchiveName() const override
         {
-            EndTick = EndTick - 1;
+            return TEXT("FStreamChunkArchive");
         }
 
-        if (Filter.TickStart.IsSet())
+        virtual int64 TotalSize() override
         {
-            StartTick = FMath::Max(StartTick, Filter.TickStart.GetValue());
+            return BytesWritten;
         }
-        if (Filter.TickEnd.IsSet())
+
+        /** Sends what is left; called once the document is complete. */
+        void Finish()
         {
-            EndTick = FMath::Min(EndTick, Filter.TickEnd.GetValue());
+            SendPending(true);
         }
 
-        if (EndTick < StartTick)
+    private:
+        void SendPending(bool bAll)
         {
-            return;
-        }
+            int32 Cut = Pending.Num();
+            if (!bAll && Cut > 0)
+            {
+                int32 Lead = Cut - 1;
+                while (Lead > 0 && (Pending[Lead] & 0xC0) == 0x80)
+                {
+                    --Lead;
+                }
+                const uint8 LeadByte = Pending[Lead];
+                const int32 Length = LeadByte < 0x80 ? 1 : (LeadByte >= 0xF0 ? 4 : (LeadByte >= 0xE0 ? 3 : 2));
+                if (Lead + Length > Cut)
+                {
+                    Cut = Lead;
+                }
+            }
+            if (Cut == 0)
+            {
+                return;
+            }
 
-        const int32 StartDisplay = ConvertTickFrameToDisplay(MovieScene, StartTick);
-        const int32 EndDisplay = ConvertTickFrameToDisplay(MovieScene, EndTick);
+            const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Pending.GetData()), Cut);
+            Stream.WriteChunk(FString(Converted.Length(), Converted.Get()));
+            Pending.RemoveAt(0, Cut, EAllowShrinking::No);
+        }
 
-        TArray<TSharedPtr<FJsonValue>> RangeArray;
-        RangeArray.Add(MakeShared<FJsonValueNumber>(StartDisplay));
-        RangeArray.Add(MakeShared<FJsonValueNumber>(EndDisplay));
-        SectionJson->SetArrayField(TEXT("range"), RangeArray);
-    }
+        UnrealMCP::Protocol::FResponseStream& Stream;
+        TArray<uint8> Pending;
+        int64 BytesWritten = 0;
+    };
 
-    void AppendVectorField(const FString& FieldName, const FVector& Value, TSharedPtr<FJsonObject>& JsonObject)
+    /** Passes everything written to it on to two archives: the export's sink and its cache entry. */
+    class FTeeArchive : public FArchive
     {
-        if (!JsonObject.IsValid())
+    public:
+        FTeeArchive(FArchive& InFirst, FArchive& InSecond)
+            : First(InFirst)
+            , Second(InSecond)
         {
-            return;
+            SetIsSaving(true);
         }
 
-        TArray<TSharedPtr<FJsonValue>> Components;
-        Components.Add(MakeShared<FJsonValueNumber>(Value.X));
-        Components.Add(MakeShared<FJsonValueNumber>(Value.Y));
-        Components.Add(MakeShared<FJsonValueNumber>(Value.Z));
-        JsonObject->SetArrayField(FieldName, Components);
-    }
-
-    void AppendColorField(const FString& FieldName, const FLinearColor& Color, TSharedPtr<FJsonObject>& JsonObject)
-    {
-        if (!JsonObject.IsValid())
+        virtual void Serialize(void* Data, int64 Num) override
         {
-            return;
+            First.Serialize(Data, Num);
+            Second.Serialize(Data, Num);
         }
 
-        TArray<TSharedPtr<FJsonValue>> Components;
-        Components.Add(MakeShared<FJsonValueNumber>(Color.R));
-        Components.Add(MakeShared<FJsonValueNumber>(Color.G));
-        Components.Add(MakeShared<FJsonValueNumber>(Color.B));
-        Components.Add(MakeShared<FJsonValueNumber>(Color.A));
-        JsonObject->SetArrayField(FieldName, Components);
-    }
-
-    void AddCsvRow(TArray<FString>& Lines,
-                   const FString& BindingId,
-                   const FString& Label,
-                   const FString& TrackType,
-                   const TOptional<int32>& SectionStart,
-                   const TOptional<int32>& SectionEnd,
-                   const TOptional<int32>& Frame,
-                   const FString& Key,
-                   const FString& Property,
-                   const FString& Value,
-                   const TOptional<FVector>& VectorValue,
-                   const TOptional<FLinearColor>& ColorValue)
-    {
-        TArray<FString> Columns;
-        Columns.Add(CsvEscape(BindingId));
-        Columns.Add(CsvEscape(Label));
-        Columns.Add(CsvEscape(TrackType));
-        Columns.Add(CsvEscape(OptionalIntToString(SectionStart)));
-        Columns.Add(CsvEscape(OptionalIntToString(SectionEnd)));
-        Columns.Add(CsvEscape(OptionalIntToString(Frame)));
-        Columns.Add(CsvEscape(Key));
-        Columns.Add(CsvEscape(Property));
-        Columns.Add(CsvEscape(Value));
-
-        if (VectorValue.IsSet())
+        virtual FString GetArchiveName() const override
         {
-            Columns.Add(CsvEscape(LexToString(VectorValue->X)));
-            Columns.Add(CsvEscape(LexToString(VectorValue->Y)));
-            Columns.Add(CsvEscape(LexToString(VectorValue->Z)));
+            return TEXT("FTeeArchive");
         }
-        else
+
+        virtual int64 TotalSize() override
         {
-            Columns.Add(TEXT(""));
-            Columns.Add(TEXT(""));
-            Columns.Add(TEXT(""));
+            return First.TotalSize();
         }
 
-        if (ColorValue.IsSet())
+    private:
+        FArchive& First;
+        FArchive& Second;
+    };
+
+    /**
+     * Writes the export document through one writer-style interface, either into a JSON tree (the
+     * inline response) or as UTF-8 text through an archive (a file or the response stream), so
+     * both come from the same walk. A default-constructed writer drops everything.
+     */
+    class FExportJson
+    {
+    public:
+        FExportJson() = default;
+
+        /** Tree mode: fields land in Root. */
+        explicit FExportJson(const TSharedRef<FJsonObject>& Root)
         {
-            Columns.Add(CsvEscape(LexToString(ColorValue->R)));
-            Columns.Add(CsvEscape(LexToString(ColorValue->G)));
-            Columns.Add(CsvEscape(LexToString(ColorValue->B)));
-            Columns.Add(CsvEscape(LexToString(ColorValue->A)));
+            Frames.Add({Root, {}, FString()});
         }
-        else
+
+        /** Text mode: the document is one object, opened here and closed by Close. */
+        explicit FExportJson(FArchive& Archive)
+            : Writer(FUtf8ExportWriterFactory::Create(&Archive))
         {
-            Columns.Add(TEXT(""));
-            Columns.Add(TEXT(""));
-            Columns.Add(TEXT(""));
-            Columns.Add(TEXT(""));
+            Writer->WriteObjectStart();
         }
 
-        Lines.Add(FString::Join(Columns, TEXT(",")));
-    }
-
-    FString GetBindingClassName(const UMovieScene& MovieScene, const FMovieSceneBinding& Binding)
-    {
-        const FGuid& Guid = Binding.GetObjectGuid();
-        if (const FMovieScenePossessable* Possessable = MovieScene.FindPossessable(Guid))
+        bool IsEnabled() const
         {
-            return Possessable->GetPossessedObjectClassName();
+            return Writer.IsValid() || Frames.Num() > 0;
         }
 
-        if (const FMovieSceneSpawnable* Spawnable = MovieScene.FindSpawnable(Guid))
+        void ObjectStart(const TCHAR* Id = nullptr)
         {
-            if (UObject* Template = Spawnable->GetObjectTemplate())
+            if (Writer)
             {
-                if (UClass* TemplateClass = Template->GetClass())
+                if (Id)
                 {
-                    return TemplateClass->GetName();
+                    Writer->WriteObjectStart(Id);
+                }
+                else
+                {
+                    Writer->WriteObjectStart();
                 }
             }
+            else if (Frames.Num() > 0)
+            {
+                Frames.Add({MakeShared<FJsonObject>(), {}, Id ? FString(Id) : FString()});
+            }
         }
 
-        return FString();
-    }
-
-    FString ToNormalizedBindingGuid(const FGuid& Guid)
-    {
-        return Guid.ToString(EGuidFormats::DigitsWithHyphens).ToUpper();
-    }
-}
-
-TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& Params)
-{
-    if (!Params.IsValid())
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing parameters"));
-    }
-
-    FString SequencePath;
-    if (!Params->TryGetStringField(TEXT("sequencePath"), SequencePath))
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing sequencePath"));
-    }
-
-    const FString SequenceObjectPath = ResolveSequenceObjectPath(SequencePath);
-    if (SequenceObjectPath.IsEmpty())
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Invalid sequencePath"));
-    }
-
-    FString FormatString = TEXT("json");
-    if (Params->HasField(TEXT("format")))
-    {
-        Params->TryGetStringField(TEXT("format"), FormatString);
-    }
-    FormatString.TrimStartAndEndInline();
-
-    EExportFormat ExportFormat = EExportFormat::Json;
-    if (FormatString.Equals(TEXT("json"), ESearchCase::IgnoreCase))
-    {
-        ExportFormat = EExportFormat::Json;
-    }
-    else if (FormatString.Equals(TEXT("csv"), ESearchCase::IgnoreCase))
-    {
-        ExportFormat = EExportFormat::Csv;
-    }
-    else
-    {
-        return MakeErrorResponse(ErrorCodeUnsupportedFormat, FString::Printf(TEXT("Unsupported format: %s"), *FormatString));
-    }
-
-    ULevelSequence* LevelSequence = LoadObject<ULevelSequence>(nullptr, *SequenceObjectPath);
-    if (!LevelSequence)
-    {
-        return MakeErrorResponse(ErrorCodeSequenceNotFound, FString::Printf(TEXT("Sequence not found: %s"), *SequenceObjectPath));
-    }
-
-    UMovieScene* MovieScene = LevelSequence->GetMovieScene();
-    if (!MovieScene)
-    {
-        return MakeErrorResponse(ErrorCodeSequenceNotFound, TEXT("Sequence is missing MovieScene"));
-    }
-
-    FIncludeSettings IncludeSettings;
-    const TSharedPtr<FJsonObject>* IncludeObject = nullptr;
-    if (Params->TryGetObjectField(TEXT("include"), IncludeObject))
-    {
-        ApplyTrackFilters(*IncludeObject, IncludeSettings);
-    }
-
-    const bool bResolveActorPaths = Params->HasTypedField<EJson::Boolean>(TEXT("worldActorPaths")) && Params->GetBoolField(TEXT("worldActorPaths"));
-    const bool bFlattenProperties = Params->HasTypedField<EJson::Boolean>(TEXT("flattenProperties")) && Params->GetBoolField(TEXT("flattenProperties"));
-
-    FFrameRangeFilter FrameFilter;
-    FString FrameRangeError;
-    if (!ParseFrameRange(*MovieScene, Params, FrameFilter, FrameRangeError))
-    {
-        return MakeErrorResponse(ErrorCodeInvalidParameters, FrameRangeError);
-    }
-
-    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-    Data->SetBoolField(TEXT("ok"), true);
-
-    TSharedPtr<FJsonObject> SequenceJson = MakeShared<FJsonObject>();
-    SequenceJson->SetStringField(TEXT("assetPath"), SequenceObjectPath);
-
-    const FFrameRate DisplayRate = MovieScene->GetDisplayRate();
-    const FFrameRate TickResolution = MovieScene->GetTickResolution();
-
-    {
-        TArray<TSharedPtr<FJsonValue>> DisplayRateArray;
-        DisplayRateArray.Add(MakeShared<FJsonValueNumber>(DisplayRate.Numerator));
-        DisplayRateArray.Add(MakeShared<FJsonValueNumber>(DisplayRate.Denominator));
-        SequenceJson->SetArrayField(TEXT("displayRate"), DisplayRateArray);
-    }
-
-    {
-        TArray<TSharedPtr<FJsonValue>> TickArray;
-        TickArray.Add(MakeShared<FJsonValueNumber>(TickResolution.Numerator));
-        TickArray.Add(MakeShared<FJsonValueNumber>(TickResolution.Denominator));
-        SequenceJson->SetArrayField(TEXT("tickResolution"), TickArray);
-    }
-
-    const TRange<FFrameNumber> PlaybackRange = MovieScene->GetPlaybackRange();
-    if (PlaybackRange.HasLowerBound() && PlaybackRange.HasUpperBound())
-    {
-        FFrameNumber RangeEnd = PlaybackRange.GetUpperBound().IsExclusive() ? PlaybackRange.GetUpperBoundValue() - 1 : PlaybackRange.GetUpperBoundValue();
-        const int32 DurationDisplay = ConvertTickFrameToDisplay(*MovieScene, RangeEnd) - ConvertTickFrameToDisplay(*MovieScene, PlaybackRange.GetLowerBoundValue()) + 1;
-        SequenceJson->SetNumberField(TEXT("durationFrames"), DurationDisplay);
-    }
-    else
-    {
-        SequenceJson->SetNumberField(TEXT("durationFrames"), 0);
-    }
-
-    Data->SetObjectField(TEXT("sequence"), SequenceJson);
-
-    UWorld* World = bResolveActorPaths ? GetEditorWorld() : nullptr;
-
-    TArray<TSharedPtr<FJsonValue>> BindingsArray;
-
-    TArray<FString> CsvLines;
-    if (ExportFormat == EExportFormat::Csv)
-    {
-        CsvLines.Add(TEXT("bindingId,label,trackType,sectionStart,sectionEnd,frame,key,property,value,x,y,z,r,g,b,a"));
-    }
-
-    for (const FMovieSceneBinding& Binding : MovieScene->GetBindings())
-    {
-        const FGuid& BindingGuid = Binding.GetObjectGuid();
-        const FString BindingId = ToNormalizedBindingGuid(BindingGuid);
-        const FString BindingLabel = MovieScene->GetObjectDisplayName(BindingGuid).ToString();
-        const FString ClassName = GetBindingClassName(*MovieScene, Binding);
-
-        FString ResolvedActorPath;
-        if (World)
+        void ObjectEnd()
         {
-            TArray<UObject*, TInlineAllocator<1>> LocatedObjects;
-            LevelSequence->LocateBoundObjects(BindingGuid, MakeResolveParams(World, World), LocatedObjects);
-            for (UObject* Located : LocatedObjects)
+            if (Writer)
             {
-                if (AActor* Actor = Cast<AActor>(Located))
-                {
-                    ResolvedActorPath = Actor->GetPathName();
-                    break;
-                }
+                Writer->WriteObjectEnd();
+            }
+            else if (Frames.Num() > 1)
+            {
+                FFrame Frame = Frames.Pop(EAllowShrinking::No);
+                Add(*Frame.Id, MakeShared<FJsonValueObject>(Frame.Object));
             }
         }
 
-        TSharedPtr<FJsonObject> BindingJson;
-        if (IncludeSettings.bBindings)
+        void ArrayStart(const TCHAR* Id = nullptr)
         {
-            BindingJson = MakeShared<FJsonObject>();
-            BindingJson->SetStringField(TEXT("bindingId"), BindingId);
-            BindingJson->SetStringField(TEXT("label"), BindingLabel);
-            if (!ClassName.IsEmpty())
+            if (Writer)
             {
-                BindingJson->SetStringField(TEXT("class"), ClassName);
-            }
-            if (!ResolvedActorPath.IsEmpty())
-            {
-                BindingJson->SetStringField(TEXT("resolvedActorPath"), ResolvedActorPath);
+                if (Id)
+                {
+                    Writer->WriteArrayStart(Id);
+                }
+                else
+                {
+                    Writer->WriteArrayStart();
+                }
             }
-            else if (bResolveActorPaths)
+            else if (Frames.Num() > 0)
             {
-                BindingJson->SetField(TEXT("resolvedActorPath"), MakeShared<FJsonValueNull>());
+                Frames.Add({nullptr, {}, Id ? FString(Id) : FString()});
             }
         }
 
-        TArray<TSharedPtr<FJsonValue>> TrackArray;
-
-        for (UMovieSceneTrack* Track : Binding.GetTracks())
+        void ArrayEnd()
         {
-            if (!Track)
+            if (Writer)
             {
-                continue;
+                Writer->WriteArrayEnd();
+            }
+            else if (Frames.Num() > 1)
+            {
+                FFrame Frame = Frames.Pop(EAllowShrinking::No);
+                Add(*Frame.Id, MakeShared<FJsonValueArray>(MoveTemp(Frame.Array)));
             }
+        }
 
-            if (IncludeSettings.bTransform)
+        void Value(const TCHAR* Id, const FString& InValue)
+        {
+            if (Writer)
             {
-                if (UMovieScene3DTransformTrack* TransformTrack = Cast<UMovieScene3DTransformTrack>(Track))
+                if (Id)
                 {
-                    TArray<TSharedPtr<FJsonValue>> TransformSections;
+                    Writer->WriteValue(Id, InValue);
+                }
+                else
+                {
+                    Writer->WriteValue(InValue);
+                }
+            }
+            else if (Frames.Num() > 0)
+            {
+                Add(Id, MakeShared<FJsonValueString>(InValue));
+            }
+        }
+
+        void Value(const TCHAR* Id, const TCHAR* InValue)
+        {
+            Value(Id, FString(InValue));
+        }
+
+        void Value(const TCHAR* Id, double InValue)
+        {
+            if (Writer)
+            {
+                if (Id)
+                {
+                    Writer->WriteValue(Id, InValue);
+                }
+                else
+                {
+                    Writer->WriteValue(InValue);
+                }
+            }
+            else if (Frames.Num() > 0)
+            {
+                Add(Id, MakeShared<FJsonValueNumber>(InValue));
+            }
+        }
+
+        void Value(const TCHAR* Id, int32 InValue)
+        {
+            if (Writer)
+            {
+                if (Id)
+                {
+                    Writer->WriteValue(Id, InValue);
+                }
+                else
+                {
+                    Writer->WriteValue(InValue);
+                }
+            }
+            else if (Frames.Num() > 0)
+            {
+                Add(Id, MakeShared<FJsonValueNumber>(InValue));
+            }
+        }
+
+        void Value(const TCHAR* Id, bool bInValue)
+        {
+            if (Writer)
+            {
+                if (Id)
+                {
+                    Writer->WriteValue(Id, bInValue);
+                }
+                else
+                {
+                    Writer->WriteValue(bInValue);
+                }
+            }
+            else if (Frames.Num() > 0)
+            {
+                Add(Id, MakeShared<FJsonValueBoolean>(bInValue));
+            }
+        }
+
+        void Null(const TCHAR* Id)
+        {
+            if (Writer)
+            {
+                Writer->WriteNull(Id);
+            }
+            else if (Frames.Num() > 0)
+            {
+                Add(Id, MakeShared<FJsonValueNull>());
+            }
+        }
+
+        /** Writes an object that already exists as a tree (small ones only, such as the sequence header). */
+        void Object(const TCHAR* Id, const TSharedRef<FJsonObject>& InObject)
+        {
+            if (Writer)
+            {
+                if (Id)
+                {
+                    const TSharedRef<FJsonValue> ObjectValue = MakeShared<FJsonValueObject>(InObject);
+                    FJsonSerializer::Serialize(ObjectValue, FString(Id), Writer.ToSharedRef(), /*bCloseWriter=*/false);
+                }
+                else
+                {
+                    FJsonSerializer::Serialize(InObject, Writer.ToSharedRef(), /*bCloseWriter=*/false);
+                }
+            }
+            else if (Frames.Num() > 0)
+            {
+                Add(Id, MakeShared<FJsonValueObject>(InObject));
+            }
+        }
+
+        /** Writes UTF-8 JSON that another text-mode writer produced, as the next array element. */
+        void RawValue(const TArray<uint8>& Utf8Json)
+        {
+            if (Writer && Utf8Json.Num() > 0)
+            {
+                const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Utf8Json.GetData()), Utf8Json.Num());
+                Writer->WriteRawJSONValue(FString(Converted.Length(), Converted.Get()));
+            }
+        }
+
+        void Close()
+        {
+            if (Writer)
+            {
+                Writer->WriteObjectEnd();
+                Writer->Close();
+                Writer.Reset();
+            }
+        }
+
+    private:
+        struct FFrame
+        {
+            /** Null for an array frame. */
+            TSharedPtr<FJsonObject> Object;
+            TArray<TSharedPtr<FJsonValue>> Array;
+            /** Field the frame is added under when it closes; empty inside an array. */
+            FString Id;
+        };
+
+        void Add(const TCHAR* Id, const TSharedRef<FJsonValue>& InValue)
+        {
+            FFrame& Top = Frames.Last();
+            if (Top.Object.IsValid())
+            {
+                Top.Object->SetField(Id, InValue);
+            }
+            else
+            {
+                Top.Array.Add(InValue);
+            }
+        }
+
+        TSharedPtr<FUtf8ExportWriter> Writer;
+        TArray<FFrame> Frames;
+    };
+
+    /** Writes CSV rows as UTF-8 text through an archive, building each row in one reused buffer. */
+    class FCsvExportWriter
+    {
+    public:
+        /** InNumColumns pads rows for a writer whose header is written elsewhere. */
+        explicit FCsvExportWriter(FArchive& InArchive, int32 InNumColumns = 0)
+            : Archive(InArchive)
+            , NumColumns(InNumColumns)
+        {
+            Row.Reserve(256);
+        }
+
+        /** Writes the header row; every later row is padded to its column count. */
+        void WriteHeader(const FString& Header)
+        {
+            int32 Commas = 0;
+            for (const TCHAR Char : Header)
+            {
+                Commas += Char == TEXT(',') ? 1 : 0;
+            }
+            NumColumns = Commas + 1;
+
+            BeginRow();
+            Row.Append(Header);
+            ColumnsInRow = NumColumns;
+            EndRow();
+        }
+
+        void BeginRow()
+        {
+            Row.Reset();
+            if (NumRows > 0)
+            {
+                Row.AppendChar(TEXT('\n'));
+            }
+        }
+
+        void Column(const FString& Value)
+        {
+            if (ColumnsInRow > 0)
+            {
+                Row.AppendChar(TEXT(','));
+            }
+            ++ColumnsInRow;
+
+            int32 QuoteIndex = INDEX_NONE;
+            const bool bNeedsQuotes = Value.FindChar(TEXT(','), QuoteIndex) || Value.FindChar(TEXT('\n'), QuoteIndex) || Value.FindChar(TEXT('"'), QuoteIndex);
+            if (!bNeedsQuotes)
+            {
+                Row.Append(Value);
+                return;
+            }
+
+            Row.AppendChar(TEXT('"'));
+            for (const TCHAR Char : Value)
+            {
+                if (Char == TEXT('"'))
+                {
+                    Row.AppendChar(TEXT('"'));
+                }
+                Row.AppendChar(Char);
+            }
+            Row.AppendChar(TEXT('"'));
+        }
+
+        void EndRow()
+        {
+            while (ColumnsInRow < NumColumns)
+            {
+                Column(FString());
+            }
+
+            const FTCHARToUTF8 Converted(*Row, Row.Len());
+            Archive.Serialize(const_cast<void*>(static_cast<const void*>(Converted.Get())), Converted.Length());
+            ColumnsInRow = 0;
+            ++NumRows;
+        }
+
+        /** Appends rows another writer built with the same columns, as if they were written here. */
+        void AppendRows(const TArray<uint8>& Utf8Rows, int64 InNumRows)
+        {
+            if (InNumRows == 0)
+            {
+                return;
+            }
+
+            if (NumRows > 0)
+            {
+                ANSICHAR Newline = '\n';
+                Archive.Serialize(&Newline, 1);
+            }
+            Archive.Serialize(const_cast<uint8*>(Utf8Rows.GetData()), Utf8Rows.Num());
+            NumRows += InNumRows;
+        }
+
+        int32 GetNumColumns() const
+        {
+            return NumColumns;
+        }
+
+        int64 GetNumRows() const
+        {
+            return NumRows;
+        }
+
+    private:
+        FArchive& Archive;
+        FString Row;
+        int32 NumColumns = 0;
+        int32 ColumnsInRow = 0;
+        int64 NumRows = 0;
+    };
+
+    void WriteRangeArray(const UMovieScene& MovieScene, const TRange<FFrameNumber>& Range, const FFrameRangeFilter& Filter, FExportJson& Json)
+    {
+        if (!Range.HasLowerBound() && !Range.HasUpperBound())
+        {
+            return;
+        }
+
+        FFrameNumber StartTick = Range.HasLowerBound() ? Range.GetLowerBoundValue() : FFrameNumber(0);
+        FFrameNumber EndTick = Range.HasUpperBound() ? Range.GetUpperBoundValue() : StartTick;
+
+        if (Range.GetUpperBound().IsOpen())
+        {
+            EndTick = StartTick;
+        }
+        else if (Range.GetUpperBound().IsExclusive())
+        {
+            EndTick = EndTick - 1;
+        }
+
+        if (Filter.TickStart.IsSet())
+        {
+            StartTick = FMath::Max(StartTick, Filter.TickStart.GetValue());
+        }
+        if (Filter.TickEnd.IsSet())
+        {
+            EndTick = FMath::Min(EndTick, Filter.TickEnd.GetValue());
+        }
+
+        if (EndTick < StartTick)
+        {
+            return;
+        }
+
+        Json.ArrayStart(TEXT("range"));
+        Json.Value(nullptr, ConvertTickFrameToDisplay(MovieScene, StartTick));
+        Json.Value(nullptr, ConvertTickFrameToDisplay(MovieScene, EndTick));
+        Json.ArrayEnd();
+    }
+
+    void WriteVectorField(const TCHAR* FieldName, const FVector& Value, FExportJson& Json)
+    {
+        Json.ArrayStart(FieldName);
+        Json.Value(nullptr, Value.X);
+        Json.Value(nullptr, Value.Y);
+        Json.Value(nullptr, Value.Z);
+        Json.ArrayEnd();
+    }
+
+    void WriteColorField(const TCHAR* FieldName, const FLinearColor& Color, FExportJson& Json)
+    {
+        Json.ArrayStart(FieldName);
+        Json.Value(nullptr, static_cast<double>(Color.R));
+        Json.Value(nullptr, static_cast<double>(Color.G));
+        Json.Value(nullptr, static_cast<double>(Color.B));
+        Json.Value(nullptr, static_cast<double>(Color.A));
+        Json.ArrayEnd();
+    }
+
+    /** One key of a curve channel as it is stored: its time, value, interpolation and tangents. */
+    struct FRawKey
+    {
+        FFrameNumber Tick;
+        int32 DisplayFrame = 0;
+        double Value = 0.0;
+        ERichCurveInterpMode InterpMode = RCIM_Cubic;
+        ERichCurveTangentMode TangentMode = RCTM_Auto;
+        float ArriveTangent = 0.0f;
+        float LeaveTangent = 0.0f;
+    };
+
+    const TCHAR* InterpModeToString(ERichCurveInterpMode Mode)
+    {
+        switch (Mode)
+        {
+        case RCIM_Linear:
+            return TEXT("linear");
+        case RCIM_Constant:
+            return TEXT("constant");
+        case RCIM_Cubic:
+            return TEXT("cubic");
+        default:
+            return TEXT("none");
+        }
+    }
+
+    const TCHAR* TangentModeToString(ERichCurveTangentMode Mode)
+    {
+        switch (Mode)
+        {
+        case RCTM_Auto:
+            return TEXT("auto");
+        case RCTM_SmartAuto:
+            return TEXT("smartAuto");
+        case RCTM_User:
+            return TEXT("user");
+        case RCTM_Break:
+            return TEXT("break");
+        default:
+            return TEXT("none");
+        }
+    }
+
+    /** The keys of a curve channel inside the frame filter, read straight from its channel data. */
+    template<typename ChannelType>
+    void CollectRawKeys(const UMovieScene& MovieScene, ChannelType& Channel, const FFrameRangeFilter& Filter, TArray<FRawKey>& OutKeys)
+    {
+        const auto ChannelData = Channel.GetData();
+        TArrayView<const FFrameNumber> Times = ChannelData.GetTimes();
+        const auto Values = ChannelData.GetValues();
+
+        const int32 FirstKey = Filter.FirstKeyIndex(Times);
+        const int32 EndKey = Filter.EndKeyIndex(Times);
+        OutKeys.Reset(FMath::Max(EndKey - FirstKey, 0));
+        for (int32 Index = FirstKey; Index < EndKey; ++Index)
+        {
+            const int32 DisplayFrame = ConvertTickFrameToDisplay(MovieScene, Times[Index]);
+            if (!Filter.ContainsDisplay(DisplayFrame))
+            {
+                continue;
+            }
+
+            FRawKey& Key = OutKeys.AddDefaulted_GetRef();
+            Key.Tick = Times[Index];
+            Key.DisplayFrame = DisplayFrame;
+            Key.Value = Values[Index].Value;
+            Key.InterpMode = Values[Index].InterpMode.GetValue();
+            Key.TangentMode = Values[Index].TangentMode.GetValue();
+            Key.ArriveTangent = Values[Index].Tangent.ArriveTangent;
+            Key.LeaveTangent = Values[Index].Tangent.LeaveTangent;
+        }
+    }
+
+    void WriteRawChannel(const TCHAR* ChannelName, TConstArrayView<FRawKey> Keys, FExportJson& Json)
+    {
+        Json.ObjectStart();
+        Json.Value(TEXT("channel"), ChannelName);
+        Json.ArrayStart(TEXT("keys"));
+        for (const FRawKey& Key : Keys)
+        {
+            Json.ObjectStart();
+            Json.Value(TEXT("frame"), Key.DisplayFrame);
+            Json.Value(TEXT("tick"), Key.Tick.Value);
+            Json.Value(TEXT("value"), Key.Value);
+            Json.Value(TEXT("interp"), InterpModeToString(Key.InterpMode));
+            if (Key.InterpMode == RCIM_Cubic)
+            {
+                Json.Value(TEXT("tangentMode"), TangentModeToString(Key.TangentMode));
+                Json.Value(TEXT("arriveTangent"), static_cast<double>(Key.ArriveTangent));
+                Json.Value(TEXT("leaveTangent"), static_cast<double>(Key.LeaveTangent));
+            }
+            Json.ObjectEnd();
+        }
+        Json.ArrayEnd();
+        Json.ObjectEnd();
+    }
+
+    /** The union of the key times of several channels inside the frame filter, in order. */
+    template<typename ChannelType>
+    void GatherKeyTimes(const UMovieScene& MovieScene, TArrayView<ChannelType*> Channels, const FFrameRangeFilter& Filter, TArray<FFrameTime>& OutTimes, TArray<int32>& OutDisplayFrames)
+    {
+        TArray<FFrameNumber> Ticks;
+        for (ChannelType* Channel : Channels)
+        {
+            TArrayView<const FFrameNumber> Times = Channel->GetData().GetTimes();
+            const int32 FirstKey = Filter.FirstKeyIndex(Times);
+            Ticks.Append(Times.Slice(FirstKey, FMath::Max(Filter.EndKeyIndex(Times) - FirstKey, 0)));
+        }
+        Ticks.Sort();
+
+        OutTimes.Reset(Ticks.Num());
+        OutDisplayFrames.Reset(Ticks.Num());
+        for (int32 Index = 0; Index < Ticks.Num(); ++Index)
+        {
+            if (Index > 0 && Ticks[Index] == Ticks[Index - 1])
+            {
+                continue;
+            }
+
+            const int32 DisplayFrame = ConvertTickFrameToDisplay(MovieScene, Ticks[Index]);
+            if (!Filter.ContainsDisplay(DisplayFrame))
+            {
+                continue;
+            }
+
+            OutTimes.Add(Ticks[Index]);
+            OutDisplayFrames.Add(DisplayFrame);
+        }
+    }
+
+    /**
+     * Every display frame a section covers, clipped to the frame filter, for baked sampling. A side
+     * of the section that is open ends where the playback range does.
+     */
+    void GatherBakeTimes(const UMovieScene& MovieScene, const TRange<FFrameNumber>& SectionRange, const FFrameRangeFilter& Filter, TArray<FFrameTime>& OutTimes, TArray<int32>& OutDisplayFrames)
+    {
+        OutTimes.Reset();
+        OutDisplayFrames.Reset();
+
+        const TRange<FFrameNumber> PlaybackRange = MovieScene.GetPlaybackRange();
+        const TRangeBound<FFrameNumber> Lower = SectionRange.HasLowerBound() ? SectionRange.GetLowerBound() : PlaybackRange.GetLowerBound();
+        const TRangeBound<FFrameNumber> Upper = SectionRange.HasUpperBound() ? SectionRange.GetUpperBound() : PlaybackRange.GetUpperBound();
+        if (!Lower.IsClosed() || !Upper.IsClosed())
+        {
+            return;
+        }
+
+        FFrameNumber StartTick = Lower.IsExclusive() ? Lower.GetValue() + 1 : Lower.GetValue();
+        FFrameNumber EndTick = Upper.IsExclusive() ? Upper.GetValue() - 1 : Upper.GetValue();
+        if (Filter.TickStart.IsSet())
+        {
+            StartTick = FMath::Max(StartTick, Filter.TickStart.GetValue());
+        }
+        if (Filter.TickEnd.IsSet())
+        {
+            EndTick = FMath::Min(EndTick, Filter.TickEnd.GetValue());
+        }
+        if (EndTick < StartTick)
+        {
+            return;
+        }
+
+        const int32 FirstFrame = ConvertTickFrameToDisplay(MovieScene, StartTick);
+        const int32 LastFrame = ConvertTickFrameToDisplay(MovieScene, EndTick);
+        OutTimes.Reserve(LastFrame - FirstFrame + 1);
+        OutDisplayFrames.Reserve(LastFrame - FirstFrame + 1);
+        for (int32 DisplayFrame = FirstFrame; DisplayFrame <= LastFrame; ++DisplayFrame)
+        {
+            const FFrameNumber Tick = ConvertDisplayFrameToTick(MovieScene, DisplayFrame);
+            if (Tick < StartTick || Tick > EndTick || !Filter.ContainsDisplay(DisplayFrame))
+            {
+                continue;
+            }
+
+            OutTimes.Add(Tick);
+            OutDisplayFrames.Add(DisplayFrame);
+        }
+    }
+
+    /**
+     * Evaluates every channel at every time in Times, one channel at a time over the shared times.
+     * OutValues is channel-major (channel C at time T is [C * Times.Num() + T]); a value the channel
+     * cannot produce is left at zero with its OutHasValue bit clear.
+     */
+    template<typename ChannelType>
+    void EvaluateChannelsAt(TArrayView<ChannelType*> Channels, TConstArrayView<FFrameTime> Times, TArray<double>& OutValues, TBitArray<>& OutHasValue)
+    {
+        const int32 NumTimes = Times.Num();
+        OutValues.SetNumZeroed(Channels.Num() * NumTimes, EAllowShrinking::No);
+        OutHasValue.Init(false, Channels.Num() * NumTimes);
+        if (NumTimes == 0)
+        {
+            return;
+        }
+
+        for (int32 ChannelIndex = 0; ChannelIndex < Channels.Num(); ++ChannelIndex)
+        {
+            const ChannelType& Channel = *Channels[ChannelIndex];
+            const int32 Offset = ChannelIndex * NumTimes;
+            double* Values = OutValues.GetData() + Offset;
+
+            // With fewer than two keys the curve is flat, so one evaluation fills the whole row.
+            if (Channel.GetNumKeys() < 2)
+            {
+                typename ChannelType::CurveValueType Value{};
+                if (Channel.Evaluate(Times[0], Value))
+                {
+                    for (int32 TimeIndex = 0; TimeIndex < NumTimes; ++TimeIndex)
+                    {
+                        Values[TimeIndex] = Value;
+                    }
+                    OutHasValue.SetRange(Offset, NumTimes, true);
+                }
+                continue;
+            }
+
+            for (int32 TimeIndex = 0; TimeIndex < NumTimes; ++TimeIndex)
+            {
+                typename ChannelType::CurveValueType Value{};
+                if (Channel.Evaluate(Times[TimeIndex], Value))
+                {
+                    Values[TimeIndex] = Value;
+                    OutHasValue[Offset + TimeIndex] = true;
+                }
+            }
+        }
+    }
+
+    void AddCsvRow(FCsvExportWriter& Csv,
+                   const FString& BindingId,
+                   const FString& Label,
+                   const FString& TrackType,
+                   const TOptional<int32>& SectionStart,
+                   const TOptional<int32>& SectionEnd,
+                   const TOptional<int32>& Frame,
+                   const FString& Key,
+                   const FString& Property,
+                   const FString& Value,
+                   const TOptional<FVector>& VectorValue,
+                   const TOptional<FLinearColor>& ColorValue,
+                   const FRawKey* RawKey = nullptr)
+    {
+        Csv.BeginRow();
+        Csv.Column(BindingId);
+        Csv.Column(Label);
+        Csv.Column(TrackType);
+        Csv.Column(OptionalIntToString(SectionStart));
+        Csv.Column(OptionalIntToString(SectionEnd));
+        Csv.Column(OptionalIntToString(Frame));
+        Csv.Column(Key);
+        Csv.Column(Property);
+        Csv.Column(Value);
+
+        if (VectorValue.IsSet())
+        {
+            Csv.Column(LexToString(VectorValue->X));
+            Csv.Column(LexToString(VectorValue->Y));
+            Csv.Column(LexToString(VectorValue->Z));
+        }
+        else
+        {
+            Csv.Column(FString());
+            Csv.Column(FString());
+            Csv.Column(FString());
+        }
+
+        if (ColorValue.IsSet())
+        {
+            Csv.Column(LexToString(ColorValue->R));
+            Csv.Column(LexToString(ColorValue->G));
+            Csv.Column(LexToString(ColorValue->B));
+            Csv.Column(LexToString(ColorValue->A));
+        }
+        else
+        {
+            Csv.Column(FString());
+            Csv.Column(FString());
+            Csv.Column(FString());
+            Csv.Column(FString());
+        }
+
+        if (RawKey)
+        {
+            Csv.Column(InterpModeToString(RawKey->InterpMode));
+            if (RawKey->InterpMode == RCIM_Cubic)
+            {
+                Csv.Column(TangentModeToString(RawKey->TangentMode));
+                Csv.Column(LexToString(RawKey->ArriveTangent));
+                Csv.Column(LexToString(RawKey->LeaveTangent));
+            }
+        }
+        Csv.EndRow();
+    }
+
+    /** Resolves outputPath to a full path under the project's Saved directory. */
+    bool ResolveOutputPath(const FString& OutputPath, FString& OutFullPath, FString& OutError)
+    {
+        if (OutputPath.IsEmpty() || !FPaths::IsRelative(OutputPath))
+        {
+            OutError = TEXT("outputPath must be a path relative to the project's Saved directory");
+            return false;
+        }
+
+        const FString SavedDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir());
+        OutFullPath = FPaths::ConvertRelativePathToFull(SavedDir, OutputPath);
+        if (!FPaths::IsUnderDirectory(OutFullPath, SavedDir) || OutFullPath == SavedDir)
+        {
+            OutError = FString::Printf(TEXT("outputPath '%s' leaves the Saved directory"), *OutputPath);
+            return false;
+        }
+        return true;
+    }
+
+    FString GetBindingClassName(const UMovieScene& MovieScene, const FMovieSceneBinding& Binding)
+    {
+        const FGuid& Guid = Binding.GetObjectGuid();
+        if (const FMovieScenePossessable* Possessable = MovieScene.FindPossessable(Guid))
+        {
+            return Possessable->GetPossessedObjectClassName();
+        }
+
+        if (const FMovieSceneSpawnable* Spawnable = MovieScene.FindSpawnable(Guid))
+        {
+            if (UObject* Template = Spawnable->GetObjectTemplate())
+            {
+                if (UClass* TemplateClass = Template->GetClass())
+                {
+                    return TemplateClass->GetName();
+                }
+            }
+        }
+
+        return FString();
+    }
+
+    FString ToNormalizedBindingGuid(const FGuid& Guid)
+    {
+        return Guid.ToString(EGuidFormats::DigitsWithHyphens).ToUpper();
+    }
+
+    enum class EColumnType : uint8
+    {
+        Float32,
+        Int32
+    };
+
+    /**
+     * Keys for format "columnar", kept as contiguous little-endian columns. A series is one frame
+     * column plus the value columns that share it: a section's sampled channels, one raw channel, or
+     * one stepped channel.
+     */
+    class FColumnarWriter
+    {
+    public:
+        struct FColumn
+        {
+            FString Name;
+            EColumnType Type = EColumnType::Float32;
+            TArray<uint8> Data;
+        };
+
+        struct FSeries
+        {
+            FString BindingId;
+            FString TrackType;
+            FString Property;
+            FString Channel;
+            TOptional<int32> SectionStart;
+            TOptional<int32> SectionEnd;
+            TArray<int32> Frames;
+            TArray<FColumn> Columns;
+        };
+
+        FSeries& BeginSeries(const UMovieScene& MovieScene, const TRange<FFrameNumber>& SectionRange, const FString& BindingId, const TCHAR* TrackType, const FString& Property, const FString& Channel)
+        {
+            FSeries& NewSeries = Series.AddDefaulted_GetRef();
+            NewSeries.BindingId = BindingId;
+            NewSeries.TrackType = TrackType;
+            NewSeries.Property = Property;
+            NewSeries.Channel = Channel;
+            if (SectionRange.HasLowerBound())
+            {
+                NewSeries.SectionStart = ConvertTickFrameToDisplay(MovieScene, SectionRange.GetLowerBoundValue());
+            }
+            if (SectionRange.HasUpperBound())
+            {
+                const FFrameNumber EndTick = SectionRange.GetUpperBound().IsExclusive() ? SectionRange.GetUpperBoundValue() - 1 : SectionRange.GetUpperBoundValue();
+                NewSeries.SectionEnd = ConvertTickFrameToDisplay(MovieScene, EndTick);
+            }
+            return NewSeries;
+        }
+
+        /** Begins a series with one int32 "value" column, for a stepped (bool, integer or byte) channel. */
+        FSeries& BeginStepSeries(const UMovieScene& MovieScene, const TRange<FFrameNumber>& SectionRange, const FString& BindingId, const TCHAR* TrackType, const FString& Property)
+        {
+            FSeries& NewSeries = BeginSeries(MovieScene, SectionRange, BindingId, TrackType, Property, FString());
+            AddColumn(NewSeries, TEXT("value"), EColumnType::Int32);
+            return NewSeries;
+        }
+
+        static void PushStep(FSeries& InSeries, int32 Frame, int32 Value)
+        {
+            InSeries.Frames.Add(Frame);
+            Push(InSeries.Columns[0], Value);
+        }
+
+        /** Closes the series begun last, dropping it when it got no frames. */
+        void EndSeries()
+        {
+            if (Series.Num() > 0 && Series.Last().Frames.Num() == 0)
+            {
+                Series.Pop(EAllowShrinking::No);
+            }
+            else if (Series.Num() > 0)
+            {
+                NumKeys += Series.Last().Frames.Num();
+            }
+        }
+
+        static FColumn& AddColumn(FSeries& InSeries, const TCHAR* Name, EColumnType Type)
+        {
+            FColumn& Column = InSeries.Columns.AddDefaulted_GetRef();
+            Column.Name = Name;
+            Column.Type = Type;
+            return Column;
+        }
+
+        static void Push(FColumn& Column, float Value)
+        {
+            Column.Data.Append(reinterpret_cast<const uint8*>(&Value), sizeof(Value));
+        }
+
+        static void Push(FColumn& Column, int32 Value)
+        {
+            Column.Data.Append(reinterpret_cast<const uint8*>(&Value), sizeof(Value));
+        }
+
+        /** Moves another writer's series to the end of this one. */
+        void Append(FColumnarWriter&& Other)
+        {
+            Series.Append(MoveTemp(Other.Series));
+            NumKeys += Other.NumKeys;
+            Other.Series.Reset();
+            Other.NumKeys = 0;
+        }
+
+        const TArray<FSeries>& GetSeries() const
+        {
+            return Series;
+        }
+
+        int64 GetNumKeys() const
+        {
+            return NumKeys;
+        }
+
+    private:
+        TArray<FSeries> Series;
+        int64 NumKeys = 0;
+    };
+
+    /** One series per raw channel: value, interp, tangentMode, arriveTangent and leaveTangent columns. */
+    void AddRawSeries(FColumnarWriter& Columnar, const UMovieScene& MovieScene, const TRange<FFrameNumber>& SectionRange, const FString& BindingId, const TCHAR* TrackType, const FString& Property, const FString& Channel, TConstArrayView<FRawKey> Keys)
+    {
+        FColumnarWriter::FSeries& Series = Columnar.BeginSeries(MovieScene, SectionRange, BindingId, TrackType, Property, Channel);
+        FColumnarWriter::FColumn& Values = FColumnarWriter::AddColumn(Series, TEXT("value"), EColumnType::Float32);
+        FColumnarWriter::FColumn& InterpModes = FColumnarWriter::AddColumn(Series, TEXT("interp"), EColumnType::Int32);
+        FColumnarWriter::FColumn& TangentModes = FColumnarWriter::AddColumn(Series, TEXT("tangentMode"), EColumnType::Int32);
+        FColumnarWriter::FColumn& ArriveTangents = FColumnarWriter::AddColumn(Series, TEXT("arriveTangent"), EColumnType::Float32);
+        FColumnarWriter::FColumn& LeaveTangents = FColumnarWriter::AddColumn(Series, TEXT("leaveTangent"), EColumnType::Float32);
+
+        Series.Frames.Reserve(Keys.Num());
+        for (const FRawKey& Key : Keys)
+        {
+            Series.Frames.Add(Key.DisplayFrame);
+            FColumnarWriter::Push(Values, static_cast<float>(Key.Value));
+            FColumnarWriter::Push(InterpModes, static_cast<int32>(Key.InterpMode));
+            FColumnarWriter::Push(TangentModes, static_cast<int32>(Key.TangentMode));
+            FColumnarWriter::Push(ArriveTangents, Key.ArriveTangent);
+            FColumnarWriter::Push(LeaveTangents, Key.LeaveTangent);
+        }
+        Columnar.EndSeries();
+    }
+
+    /**
+     * One series for a section's sampled channels, straight from EvaluateChannelsAt's channel-major
+     * output. A value a channel could not produce is written as NaN.
+     */
+    void AddSampledSeries(FColumnarWriter& Columnar, const UMovieScene& MovieScene, const TRange<FFrameNumber>& SectionRange, const FString& BindingId, const TCHAR* TrackType, const FString& Property, TConstArrayView<const TCHAR*> ColumnNames, TConstArrayView<int32> Frames, TConstArrayView<double> Values, const TBitArray<>& HasValue)
+    {
+        FColumnarWriter::FSeries& Series = Columnar.BeginSeries(MovieScene, SectionRange, BindingId, TrackType, Property, FString());
+        Series.Frames.Append(Frames.GetData(), Frames.Num());
+
+        const int32 NumFrames = Frames.Num();
+        for (int32 ColumnIndex = 0; ColumnIndex < ColumnNames.Num(); ++ColumnIndex)
+        {
+            FColumnarWriter::FColumn& Column = FColumnarWriter::AddColumn(Series, ColumnNames[ColumnIndex], EColumnType::Float32);
+            Column.Data.SetNumUninitialized(NumFrames * sizeof(float));
+            float* Out = reinterpret_cast<float*>(Column.Data.GetData());
+            const int32 Offset = ColumnIndex * NumFrames;
+            for (int32 Index = 0; Index < NumFrames; ++Index)
+            {
+                Out[Index] = HasValue[Offset + Index] ? static_cast<float>(Values[Offset + Index]) : std::numeric_limits<float>::quiet_NaN();
+            }
+        }
+        Columnar.EndSeries();
+    }
+
+    /** Leading bytes of a columnar export. */
+    constexpr ANSICHAR ColumnarMagic[8] = {'U', 'M', 'C', 'P', 'C', 'O', 'L', '1'};
+
+    /**
+     * Encodes a columnar export: the 8-byte magic, the header length as a little-endian uint32, the
+     * UTF-8 JSON header, zero padding to a multiple of 8 bytes, then every frame and value column
+     * back to back. Offsets in the header count from the start of that data, so a reader can map
+     * each column directly without parsing it.
+     */
+    TArray<uint8> EncodeColumnar(const FColumnarWriter& Columnar, const TSharedRef<FJsonObject>& Header)
+    {
+        int64 DataBytes = 0;
+        TArray<TSharedPtr<FJsonValue>> SeriesArray;
+        SeriesArray.Reserve(Columnar.GetSeries().Num());
+        for (const FColumnarWriter::FSeries& Series : Columnar.GetSeries())
+        {
+            TSharedPtr<FJsonObject> SeriesJson = MakeShared<FJsonObject>();
+            SeriesJson->SetStringField(TEXT("bindingId"), Series.BindingId);
+            SeriesJson->SetStringField(TEXT("trackType"), Series.TrackType);
+            if (!Series.Property.IsEmpty())
+            {
+                SeriesJson->SetStringField(TEXT("property"), Series.Property);
+            }
+            if (!Series.Channel.IsEmpty())
+            {
+                SeriesJson->SetStringField(TEXT("channel"), Series.Channel);
+            }
+            if (Series.SectionStart.IsSet())
+            {
+                SeriesJson->SetNumberField(TEXT("sectionStart"), Series.SectionStart.GetValue());
+            }
+            if (Series.SectionEnd.IsSet())
+            {
+                SeriesJson->SetNumberField(TEXT("sectionEnd"), Series.SectionEnd.GetValue());
+            }
+            SeriesJson->SetNumberField(TEXT("count"), Series.Frames.Num());
+            SeriesJson->SetNumberField(TEXT("frames"), static_cast<double>(DataBytes));
+            DataBytes += Series.Frames.Num() * sizeof(int32);
+
+            TArray<TSharedPtr<FJsonValue>> ColumnsArray;
+            for (const FColumnarWriter::FColumn& Column : Series.Columns)
+            {
+                TSharedPtr<FJsonObject> ColumnJson = MakeShared<FJsonObject>();
+                ColumnJson->SetStringField(TEXT("name"), Column.Name);
+                ColumnJson->SetStringField(TEXT("type"), Column.Type == EColumnType::Int32 ? TEXT("i32") : TEXT("f32"));
+                ColumnJson->SetNumberField(TEXT("offset"), static_cast<double>(DataBytes));
+                DataBytes += Column.Data.Num();
+                ColumnsArray.Add(MakeShared<FJsonValueObject>(ColumnJson));
+            }
+            SeriesJson->SetArrayField(TEXT("columns"), ColumnsArray);
+            SeriesArray.Add(MakeShared<FJsonValueObject>(SeriesJson));
+        }
+        Header->SetArrayField(TEXT("series"), SeriesArray);
+        Header->SetNumberField(TEXT("dataBytes"), static_cast<double>(DataBytes));
+
+        TArray<uint8> HeaderBytes;
+        {
+            FMemoryWriter HeaderArchive(HeaderBytes);
+            TSharedRef<FUtf8ExportWriter> Writer = FUtf8ExportWriterFactory::Create(&HeaderArchive);
+            FJsonSerializer::Serialize(Header, Writer);
+        }
+
+        const int64 Prefix = sizeof(ColumnarMagic) + sizeof(uint32) + HeaderBytes.Num();
+        const int64 Padding = Align(Prefix, 8) - Prefix;
+
+        TArray<uint8> Bytes;
+        Bytes.Reserve(Prefix + Padding + DataBytes);
+        Bytes.Append(reinterpret_cast<const uint8*>(ColumnarMagic), sizeof(ColumnarMagic));
+        const uint32 HeaderLength = static_cast<uint32>(HeaderBytes.Num());
+        Bytes.Append(reinterpret_cast<const uint8*>(&HeaderLength), sizeof(HeaderLength));
+        Bytes.Append(HeaderBytes);
+        Bytes.AddZeroed(Padding);
+        for (const FColumnarWriter::FSeries& Series : Columnar.GetSeries())
+        {
+            Bytes.Append(reinterpret_cast<const uint8*>(Series.Frames.GetData()), Series.Frames.Num() * sizeof(int32));
+            for (const FColumnarWriter::FColumn& Column : Series.Columns)
+            {
+                Bytes.Append(Column.Data);
+            }
+        }
+        return Bytes;
+    }
+
+    /** What every binding of one export shares; read-only once the workers start. */
+    struct FExportSettings
+    {
+        const UMovieScene* MovieScene = nullptr;
+        FIncludeSettings Include;
+        FFrameRangeFilter FrameFilter;
+        EKeyMode KeyMode = EKeyMode::Evaluated;
+        bool bFlattenProperties = false;
+        bool bResolveActorPaths = false;
+    };
+
+    /**
+     * A binding's fields that need the game thread (names, the world lookup) and its track list,
+     * read before the workers start. Channel data is read by the workers in place: the game thread
+     * waits inside the ParallelFor, so nothing can edit the sequence meanwhile.
+     */
+    struct FBindingSnapshot
+    {
+        FString BindingId;
+        FString Label;
+        FString ClassName;
+        FString ResolvedActorPath;
+        TArray<UMovieSceneTrack*> Tracks;
+    };
+
+    /** Buffers a worker reuses across the sections of one binding. */
+    struct FSampleScratch
+    {
+        TArray<FRawKey> RawKeys;
+        TArray<FFrameTime> SampleTimes;
+        TArray<int32> SampleFrames;
+        TArray<double> SampledValues;
+        TBitArray<> SampledMask;
+    };
+
+    /** One binding's export, written by a worker and appended in binding order. */
+    struct FBindingOutput
+    {
+        /** The binding object, for an inline response. */
+        TSharedPtr<FJsonObject> Tree;
+        /** The binding object as UTF-8 JSON, for a file or stream. */
+        TArray<uint8> JsonText;
+        TArray<uint8> CsvText;
+        int64 CsvRows = 0;
+        FColumnarWriter Columnar;
+    };
+
+    /** Whether Track is of a type the export includes; the others never reach ExportBinding. */
+    bool IsTrackIncluded(const FIncludeSettings& Include, const UMovieSceneTrack* Track)
+    {
+        // Transform and visibility tracks are property tracks too, and ExportBinding matches them as both.
+        return Track
+            && ((Include.bTransform && Track->IsA<UMovieScene3DTransformTrack>())
+                || (Include.bVisibility && Track->IsA<UMovieSceneVisibilityTrack>())
+                || (Include.bProperty && Track->IsA<UMovieScenePropertyTrack>()));
+    }
+
+    FBindingSnapshot SnapshotBinding(ULevelSequence& LevelSequence, const UMovieScene& MovieScene, const FMovieSceneBinding& Binding, const FIncludeSettings& Include, UWorld* World)
+    {
+        FBindingSnapshot Snapshot;
+        const FGuid& BindingGuid = Binding.GetObjectGuid();
+        Snapshot.BindingId = ToNormalizedBindingGuid(BindingGuid);
+        Snapshot.Label = MovieScene.GetObjectDisplayName(BindingGuid).ToString();
+        Snapshot.ClassName = GetBindingClassName(MovieScene, Binding);
+        for (UMovieSceneTrack* Track : Binding.GetTracks())
+        {
+            if (IsTrackIncluded(Include, Track))
+            {
+                Snapshot.Tracks.Add(Track);
+            }
+        }
+
+        if (World)
+        {
+            TArray<UObject*, TInlineAllocator<1>> LocatedObjects;
+            LevelSequence.LocateBoundObjects(BindingGuid, MakeResolveParams(World, World), LocatedObjects);
+            for (UObject* Located : LocatedObjects)
+            {
+                if (AActor* Actor = Cast<AActor>(Located))
+                {
+                    Snapshot.ResolvedActorPath = Actor->GetPathName();
+                    break;
+                }
+            }
+        }
+
+        return Snapshot;
+    }
+
+    /**
+     * Writes one binding as the root object of Json, its CSV rows to Csv and its key columns to
+     * Columnar. Safe to run on a worker thread: it only reads the sequence.
+     */
+    void ExportBinding(const FExportSettings& Settings, const FBindingSnapshot& Binding, FExportJson& Json, FCsvExportWriter* Csv, FColumnarWriter* Columnar, FSampleScratch& Scratch)
+    {
+        const UMovieScene* MovieScene = Settings.MovieScene;
+        const FIncludeSettings& IncludeSettings = Settings.Include;
+        const FFrameRangeFilter& FrameFilter = Settings.FrameFilter;
+        const EKeyMode KeyMode = Settings.KeyMode;
+        const bool bFlattenProperties = Settings.bFlattenProperties;
+        const FString& BindingId = Binding.BindingId;
+        const FString& BindingLabel = Binding.Label;
+        TArray<FRawKey>& RawKeys = Scratch.RawKeys;
+        TArray<FFrameTime>& SampleTimes = Scratch.SampleTimes;
+        TArray<int32>& SampleFrames = Scratch.SampleFrames;
+        TArray<double>& SampledValues = Scratch.SampledValues;
+        TBitArray<>& SampledMask = Scratch.SampledMask;
+
+        // Binding, track and section objects are only written while "bindings" is included; keys
+        // are still walked without it when CSV rows need them.
+        const bool bWriteJson = IncludeSettings.bBindings && Json.IsEnabled();
+        if (bWriteJson)
+        {
+            Json.Value(TEXT("bindingId"), BindingId);
+            Json.Value(TEXT("label"), BindingLabel);
+            if (!Binding.ClassName.IsEmpty())
+            {
+                Json.Value(TEXT("class"), Binding.ClassName);
+            }
+            if (!Binding.ResolvedActorPath.IsEmpty())
+            {
+                Json.Value(TEXT("resolvedActorPath"), Binding.ResolvedActorPath);
+            }
+            else if (Settings.bResolveActorPaths)
+            {
+                Json.Null(TEXT("resolvedActorPath"));
+            }
+            Json.ArrayStart(TEXT("tracks"));
+        }
+        FExportJson NoJson;
+        FExportJson& TrackJson = bWriteJson ? Json : NoJson;
+
+        for (UMovieSceneTrack* Track : Binding.Tracks)
+        {
+            if (!Track)
+            {
+                continue;
+            }
+
+            if (IncludeSettings.bTransform)
+            {
+                if (UMovieScene3DTransformTrack* TransformTrack = Cast<UMovieScene3DTransformTrack>(Track))
+                {
+                    // The track is opened by its first section, so one with none is left out.
+                    bool bTrackOpen = false;
 
                     for (UMovieSceneSection* Section : TransformTrack->GetAllSections())
                     {
@@ -745,149 +1735,121 @@ TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& P
                         const int32 SectionStartDisplay = ConvertTickFrameToDisplay(*MovieScene, SectionStartTick);
                         const int32 SectionEndDisplay = ConvertTickFrameToDisplay(*MovieScene, SectionEndTick);
 
-                        TSharedPtr<FJsonObject> SectionJson = MakeShared<FJsonObject>();
-                        AppendRangeArray(*MovieScene, SectionRange, FrameFilter, SectionJson);
+                        if (!bTrackOpen)
+                        {
+                            TrackJson.ObjectStart();
+                            TrackJson.Value(TEXT("type"), TEXT("Transform"));
+                            TrackJson.ArrayStart(TEXT("sections"));
+                            bTrackOpen = true;
+                        }
+
+                        TrackJson.ObjectStart();
+                        WriteRangeArray(*MovieScene, SectionRange, FrameFilter, TrackJson);
 
                         if (IncludeSettings.bIncludeKeys)
                         {
-                            TSet<int32> KeyFramesTick;
-
-                            auto AccumulateFrames = [&KeyFramesTick, &FrameFilter](FMovieSceneFloatChannel& Channel)
+                            FMovieSceneFloatChannel* TransformChannels[] = {
+                                &TransformSection->GetTranslationChannel(0), &TransformSection->GetTranslationChannel(1), &TransformSection->GetTranslationChannel(2),
+                                &TransformSection->GetRotationChannel(0), &TransformSection->GetRotationChannel(1), &TransformSection->GetRotationChannel(2),
+                                &TransformSection->GetScaleChannel(0), &TransformSection->GetScaleChannel(1), &TransformSection->GetScaleChannel(2)};
+                            static const TCHAR* const TransformChannelNames[] = {
+                                TEXT("location.x"), TEXT("location.y"), TEXT("location.z"),
+                                TEXT("rotation.x"), TEXT("rotation.y"), TEXT("rotation.z"),
+                                TEXT("scale.x"), TEXT("scale.y"), TEXT("scale.z")};
+                            static const TCHAR* const TransformVectorNames[] = {TEXT("location"), TEXT("rotation"), TEXT("scale")};
+
+                            if (KeyMode == EKeyMode::Raw)
                             {
-                                const FMovieSceneChannelData<float> ChannelData = Channel.GetData();
-                                TArrayView<const FFrameNumber> Times = ChannelData.GetTimes();
-                                for (const FFrameNumber& Time : Times)
+                                TrackJson.ArrayStart(TEXT("channels"));
+                                for (int32 ChannelIndex = 0; ChannelIndex < static_cast<int32>(UE_ARRAY_COUNT(TransformChannels)); ++ChannelIndex)
                                 {
-                                    const int32 TickValue = Time.Value;
-                                    if (FrameFilter.TickStart.IsSet() && TickValue < FrameFilter.TickStart.GetValue().Value)
+                                    CollectRawKeys(*MovieScene, *TransformChannels[ChannelIndex], FrameFilter, RawKeys);
+                                    WriteRawChannel(TransformChannelNames[ChannelIndex], RawKeys, TrackJson);
+                                    if (Columnar)
                                     {
-                                        continue;
+                                        AddRawSeries(*Columnar, *MovieScene, SectionRange, BindingId, TEXT("Transform"), FString(), TransformChannelNames[ChannelIndex], RawKeys);
                                     }
-                                    if (FrameFilter.TickEnd.IsSet() && TickValue > FrameFilter.TickEnd.GetValue().Value)
+
+                                    if (Csv)
                                     {
-                                        continue;
+                                        for (const FRawKey& Key : RawKeys)
+                                        {
+                                            AddCsvRow(*Csv, BindingId, BindingLabel, TEXT("Transform"), SectionStartDisplay, SectionEndDisplay, Key.DisplayFrame, TransformChannelNames[ChannelIndex], FString(), LexToString(Key.Value), TOptional<FVector>(), TOptional<FLinearColor>(), &Key);
+                                        }
                                     }
-                                    KeyFramesTick.Add(TickValue);
                                 }
-                            };
-
-                            AccumulateFrames(TransformSection->GetTranslationChannel(0));
-                            AccumulateFrames(TransformSection->GetTranslationChannel(1));
-                            AccumulateFrames(TransformSection->GetTranslationChannel(2));
-                            AccumulateFrames(TransformSection->GetRotationChannel(0));
-                            AccumulateFrames(TransformSection->GetRotationChannel(1));
-                            AccumulateFrames(TransformSection->GetRotationChannel(2));
-                            AccumulateFrames(TransformSection->GetScaleChannel(0));
-                            AccumulateFrames(TransformSection->GetScaleChannel(1));
-                            AccumulateFrames(TransformSection->GetScaleChannel(2));
-
-                            TArray<int32> SortedTicks = KeyFramesTick.Array();
-                            SortedTicks.Sort();
-
-                            TArray<TSharedPtr<FJsonValue>> KeysArray;
-
-                            for (int32 TickValue : SortedTicks)
+                                TrackJson.ArrayEnd();
+                            }
+                            else
                             {
-                                const FFrameNumber TickFrame(TickValue);
-                                if (!FrameFilter.ContainsTick(TickFrame))
-                                {
-                                    continue;
-                                }
-
-                                const int32 DisplayFrame = ConvertTickFrameToDisplay(*MovieScene, TickFrame);
-                                if (!FrameFilter.ContainsDisplay(DisplayFrame))
+                                if (KeyMode == EKeyMode::Baked)
                                 {
-                                    continue;
-                                }
-
-                                TSharedPtr<FJsonObject> KeyJson = MakeShared<FJsonObject>();
-                                KeyJson->SetNumberField(TEXT("frame"), DisplayFrame);
-
-                                FVector Location = FVector::ZeroVector;
-                                FVector Rotation = FVector::ZeroVector;
-                                FVector Scale = FVector(1.0f, 1.0f, 1.0f);
-                                bool bHasLocation = false;
-                                bool bHasRotation = false;
-                                bool bHasScale = false;
-
-                                auto EvaluateVector = [&TickFrame](FMovieSceneFloatChannel& X, FMovieSceneFloatChannel& Y, FMovieSceneFloatChannel& Z, FVector& OutVector, bool& bOutHasValue)
-                                {
-                                    double VX = 0.0;
-                                    double VY = 0.0;
-                                    double VZ = 0.0;
-                                    const bool bHasX = X.Evaluate(TickFrame, VX);
-                                    const bool bHasY = Y.Evaluate(TickFrame, VY);
-                                    const bool bHasZ = Z.Evaluate(TickFrame, VZ);
-                                    if (bHasX || bHasY || bHasZ)
-                                    {
-                                        OutVector = FVector(static_cast<float>(VX), static_cast<float>(VY), static_cast<float>(VZ));
-                                        bOutHasValue = true;
-                                    }
-                                };
-
-                                EvaluateVector(TransformSection->GetTranslationChannel(0), TransformSection->GetTranslationChannel(1), TransformSection->GetTranslationChannel(2), Location, bHasLocation);
-                                EvaluateVector(TransformSection->GetRotationChannel(0), TransformSection->GetRotationChannel(1), TransformSection->GetRotationChannel(2), Rotation, bHasRotation);
-                                EvaluateVector(TransformSection->GetScaleChannel(0), TransformSection->GetScaleChannel(1), TransformSection->GetScaleChannel(2), Scale, bHasScale);
-
-                                if (bHasLocation)
-                                {
-                                    AppendVectorField(TEXT("location"), Location, KeyJson);
+                                    GatherBakeTimes(*MovieScene, SectionRange, FrameFilter, SampleTimes, SampleFrames);
                                 }
-                                if (bHasRotation)
+                                else
                                 {
-                                    AppendVectorField(TEXT("rotation"), Rotation, KeyJson);
+                                    GatherKeyTimes(*MovieScene, MakeArrayView(TransformChannels), FrameFilter, SampleTimes, SampleFrames);
                                 }
-                                if (bHasScale)
+                                EvaluateChannelsAt(MakeArrayView(TransformChannels), SampleTimes, SampledValues, SampledMask);
+                                if (Columnar)
                                 {
-                                    AppendVectorField(TEXT("scale"), Scale, KeyJson);
+                                    AddSampledSeries(*Columnar, *MovieScene, SectionRange, BindingId, TEXT("Transform"), FString(), MakeArrayView(TransformChannelNames), SampleFrames, SampledValues, SampledMask);
                                 }
 
-                                KeysArray.Add(MakeShared<FJsonValueObject>(KeyJson));
+                                TrackJson.ArrayStart(TEXT("keys"));
 
-                                if (ExportFormat == EExportFormat::Csv)
+                                const int32 NumSamples = SampleTimes.Num();
+                                for (int32 Sample = 0; Sample < NumSamples; ++Sample)
                                 {
-                                    if (bHasLocation)
+                                    const int32 DisplayFrame = SampleFrames[Sample];
+
+                                    // A vector is present when any of its axes evaluates; the others read as zero.
+                                    FVector Vectors[3];
+                                    bool bHasVector[3] = {false, false, false};
+                                    for (int32 VectorIndex = 0; VectorIndex < 3; ++VectorIndex)
                                     {
-                                        AddCsvRow(CsvLines, BindingId, BindingLabel, TEXT("Transform"), SectionStartDisplay, SectionEndDisplay, DisplayFrame, TEXT("location"), FString(), FString(), Location, TOptional<FLinearColor>());
+                                        for (int32 Axis = 0; Axis < 3; ++Axis)
+                                        {
+                                            const int32 Slot = (VectorIndex * 3 + Axis) * NumSamples + Sample;
+                                            Vectors[VectorIndex][Axis] = static_cast<float>(SampledValues[Slot]);
+                                            bHasVector[VectorIndex] = bHasVector[VectorIndex] || SampledMask[Slot];
+                                        }
                                     }
-                                    if (bHasRotation)
+
+                                    TrackJson.ObjectStart();
+                                    TrackJson.Value(TEXT("frame"), DisplayFrame);
+                                    for (int32 VectorIndex = 0; VectorIndex < 3; ++VectorIndex)
                                     {
-                                        AddCsvRow(CsvLines, BindingId, BindingLabel, TEXT("Transform"), SectionStartDisplay, SectionEndDisplay, DisplayFrame, TEXT("rotation"), FString(), FString(), Rotation, TOptional<FLinearColor>());
+                                        if (bHasVector[VectorIndex])
+                                        {
+                                            WriteVectorField(TransformVectorNames[VectorIndex], Vectors[VectorIndex], TrackJson);
+                                        }
                                     }
-                                    if (bHasScale)
+                                    TrackJson.ObjectEnd();
+
+                                    if (Csv)
                                     {
-                                        AddCsvRow(CsvLines, BindingId, BindingLabel, TEXT("Transform"), SectionStartDisplay, SectionEndDisplay, DisplayFrame, TEXT("scale"), FString(), FString(), Scale, TOptional<FLinearColor>());
+                                        for (int32 VectorIndex = 0; VectorIndex < 3; ++VectorIndex)
+                                        {
+                                            if (bHasVector[VectorIndex])
+                                            {
+                                                AddCsvRow(*Csv, BindingId, BindingLabel, TEXT("Transform"), SectionStartDisplay, SectionEndDisplay, DisplayFrame, TransformVectorNames[VectorIndex], FString(), FString(), Vectors[VectorIndex], TOptional<FLinearColor>());
+                                            }
+                                        }
                                     }
                                 }
-                            }
 
-                            if (KeysArray.Num() > 0)
-                            {
-                                SectionJson->SetArrayField(TEXT("keys"), KeysArray);
-                            }
-                            else if (IncludeSettings.bIncludeKeys)
-                            {
-                                SectionJson->SetArrayField(TEXT("keys"), {});
+                                TrackJson.ArrayEnd();
                             }
                         }
 
-                        if (IncludeSettings.bBindings)
-                        {
-                            if (!SectionJson->HasField(TEXT("keys")) && IncludeSettings.bIncludeKeys)
-                            {
-                                SectionJson->SetArrayField(TEXT("keys"), {});
-                            }
-
-                            TransformSections.Add(MakeShared<FJsonValueObject>(SectionJson));
-                        }
+                        TrackJson.ObjectEnd();
                     }
 
-                    if (IncludeSettings.bBindings && TransformSections.Num() > 0)
+                    if (bTrackOpen)
                     {
-                        TSharedPtr<FJsonObject> TrackJson = MakeShared<FJsonObject>();
-                        TrackJson->SetStringField(TEXT("type"), TEXT("Transform"));
-                        TrackJson->SetArrayField(TEXT("sections"), TransformSections);
-                        TrackArray.Add(MakeShared<FJsonValueObject>(TrackJson));
+                        TrackJson.ArrayEnd();
+                        TrackJson.ObjectEnd();
                     }
                 }
             }
@@ -896,19 +1858,27 @@ TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& P
             {
                 if (UMovieSceneVisibilityTrack* VisibilityTrack = Cast<UMovieSceneVisibilityTrack>(Track))
                 {
-                    TArray<TSharedPtr<FJsonValue>> VisibilitySections;
+                    bool bTrackOpen = false;
 
                     for (UMovieSceneSection* Section : VisibilityTrack->GetAllSections())
                     {
                         UMovieSceneBoolSection* BoolSection = Cast<UMovieSceneBoolSection>(Section);
-                        if (!BoolSection)
+                        if (!BoolSection || !FrameFilter.OverlapsSection(BoolSection->GetRange()))
                         {
                             continue;
                         }
 
+                        if (!bTrackOpen)
+                        {
+                            TrackJson.ObjectStart();
+                            TrackJson.Value(TEXT("type"), TEXT("Visibility"));
+                            TrackJson.ArrayStart(TEXT("sections"));
+                            bTrackOpen = true;
+                        }
+
                         const TRange<FFrameNumber> SectionRange = BoolSection->GetRange();
-                        TSharedPtr<FJsonObject> SectionJson = MakeShared<FJsonObject>();
-                        AppendRangeArray(*MovieScene, SectionRange, FrameFilter, SectionJson);
+                        TrackJson.ObjectStart();
+                        WriteRangeArray(*MovieScene, SectionRange, FrameFilter, TrackJson);
 
                         FMovieSceneBoolChannel& Channel = BoolSection->GetChannel();
                         const FMovieSceneChannelData<bool> ChannelData = Channel.GetData();
@@ -917,14 +1887,11 @@ TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& P
 
                         if (IncludeSettings.bIncludeKeys)
                         {
-                            TArray<TSharedPtr<FJsonValue>> KeysArray;
-                            for (int32 Index = 0; Index < Times.Num(); ++Index)
+                            FColumnarWriter::FSeries* StepSeries = Columnar ? &Columnar->BeginStepSeries(*MovieScene, SectionRange, BindingId, TEXT("Visibility"), FString()) : nullptr;
+                            TrackJson.ArrayStart(TEXT("keys"));
+                            for (int32 Index = FrameFilter.FirstKeyIndex(Times), EndKey = FrameFilter.EndKeyIndex(Times); Index < EndKey; ++Index)
                             {
                                 const FFrameNumber TickFrame = Times[Index];
-                                if (!FrameFilter.ContainsTick(TickFrame))
-                                {
-                                    continue;
-                                }
 
                                 const int32 DisplayFrame = ConvertTickFrameToDisplay(*MovieScene, TickFrame);
                                 if (!FrameFilter.ContainsDisplay(DisplayFrame))
@@ -933,35 +1900,37 @@ TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& P
                                 }
 
                                 const bool bVisible = Values[Index];
-                                TSharedPtr<FJsonObject> KeyJson = MakeShared<FJsonObject>();
-                                KeyJson->SetNumberField(TEXT("frame"), DisplayFrame);
-                                KeyJson->SetBoolField(TEXT("visible"), bVisible);
-                                KeysArray.Add(MakeShared<FJsonValueObject>(KeyJson));
+                                TrackJson.ObjectStart();
+                                TrackJson.Value(TEXT("frame"), DisplayFrame);
+                                TrackJson.Value(TEXT("visible"), bVisible);
+                                TrackJson.ObjectEnd();
+                                if (StepSeries)
+                                {
+                                    FColumnarWriter::PushStep(*StepSeries, DisplayFrame, bVisible ? 1 : 0);
+                                }
 
-                                if (ExportFormat == EExportFormat::Csv)
+                                if (Csv)
                                 {
-                                    AddCsvRow(CsvLines, BindingId, BindingLabel, TEXT("Visibility"),
+                                    AddCsvRow(*Csv, BindingId, BindingLabel, TEXT("Visibility"),
                                               ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasLowerBound() ? SectionRange.GetLowerBoundValue() : TickFrame),
                                               ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasUpperBound() ? (SectionRange.GetUpperBound().IsExclusive() ? SectionRange.GetUpperBoundValue() - 1 : SectionRange.GetUpperBoundValue()) : TickFrame),
                                               DisplayFrame, TEXT("visible"), FString(), bVisible ? TEXT("true") : TEXT("false"), TOptional<FVector>(), TOptional<FLinearColor>());
                                 }
                             }
-
-                            SectionJson->SetArrayField(TEXT("keys"), KeysArray);
+                            TrackJson.ArrayEnd();
+                            if (Columnar)
+                            {
+                                Columnar->EndSeries();
+                            }
                         }
 
-                        if (IncludeSettings.bBindings)
-                        {
-                            VisibilitySections.Add(MakeShared<FJsonValueObject>(SectionJson));
-                        }
+                        TrackJson.ObjectEnd();
                     }
 
-                    if (IncludeSettings.bBindings && VisibilitySections.Num() > 0)
+                    if (bTrackOpen)
                     {
-                        TSharedPtr<FJsonObject> TrackJson = MakeShared<FJsonObject>();
-                        TrackJson->SetStringField(TEXT("type"), TEXT("Visibility"));
-                        TrackJson->SetArrayField(TEXT("sections"), VisibilitySections);
-                        TrackArray.Add(MakeShared<FJsonValueObject>(TrackJson));
+                        TrackJson.ArrayEnd();
+                        TrackJson.ObjectEnd();
                     }
                 }
             }
@@ -973,20 +1942,35 @@ TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& P
                     const FString PropertyPath = PropertyTrack->GetPropertyPath();
                     const FString PropertyName = PropertyTrack->GetPropertyName().ToString();
 
-                    TArray<TSharedPtr<FJsonValue>> PropertySections;
+                    bool bTrackOpen = false;
+                    // Keys are written only with includeKeys, though CSV rows come from them either way.
+                    FExportJson& KeyJson = IncludeSettings.bIncludeKeys ? TrackJson : NoJson;
 
                     for (UMovieSceneSection* Section : PropertyTrack->GetAllSections())
                     {
-                        if (!Section)
+                        if (!Section || !FrameFilter.OverlapsSection(Section->GetRange()))
                         {
                             continue;
                         }
 
-                        const TRange<FFrameNumber> SectionRange = Section->GetRange();
-                        TSharedPtr<FJsonObject> SectionJson = MakeShared<FJsonObject>();
-                        AppendRangeArray(*MovieScene, SectionRange, FrameFilter, SectionJson);
+                        if (!bTrackOpen)
+                        {
+                            TrackJson.ObjectStart();
+                            TrackJson.Value(TEXT("type"), TEXT("Property"));
+                            TrackJson.Value(TEXT("propertyPath"), PropertyPath);
+                            if (!PropertyName.IsEmpty())
+                            {
+                                TrackJson.Value(TEXT("propertyName"), PropertyName);
+                            }
+                            TrackJson.ArrayStart(TEXT("sections"));
+                            bTrackOpen = true;
+                        }
 
-                        TArray<TSharedPtr<FJsonValue>> KeysArray;
+                        const TRange<FFrameNumber> SectionRange = Section->GetRange();
+                        TrackJson.ObjectStart();
+                        WriteRangeArray(*MovieScene, SectionRange, FrameFilter, TrackJson);
+                        const bool bRawChannels = KeyMode == EKeyMode::Raw && (Section->IsA<UMovieSceneFloatSection>() || Section->IsA<UMovieSceneColorSection>());
+                        KeyJson.ArrayStart(bRawChannels ? TEXT("channels") : TEXT("keys"));
 
                         if (UMovieSceneBoolSection* BoolSection = Cast<UMovieSceneBoolSection>(Section))
                         {
@@ -995,13 +1979,10 @@ TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& P
                             TArrayView<const FFrameNumber> Times = ChannelData.GetTimes();
                             TArrayView<const bool> Values = ChannelData.GetValues();
 
-                            for (int32 Index = 0; Index < Times.Num(); ++Index)
+                            FColumnarWriter::FSeries* StepSeries = Columnar ? &Columnar->BeginStepSeries(*MovieScene, SectionRange, BindingId, TEXT("Property"), PropertyPath) : nullptr;
+                            for (int32 Index = FrameFilter.FirstKeyIndex(Times), EndKey = FrameFilter.EndKeyIndex(Times); Index < EndKey; ++Index)
                             {
                                 const FFrameNumber TickFrame = Times[Index];
-                                if (!FrameFilter.ContainsTick(TickFrame))
-                                {
-                                    continue;
-                                }
 
                                 const int32 DisplayFrame = ConvertTickFrameToDisplay(*MovieScene, TickFrame);
                                 if (!FrameFilter.ContainsDisplay(DisplayFrame))
@@ -1010,54 +1991,128 @@ TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& P
                                 }
 
                                 const bool bValue = Values[Index];
-                                TSharedPtr<FJsonObject> KeyJson = MakeShared<FJsonObject>();
-                                KeyJson->SetNumberField(TEXT("frame"), DisplayFrame);
-                                KeyJson->SetBoolField(TEXT("value"), bValue);
-                                KeysArray.Add(MakeShared<FJsonValueObject>(KeyJson));
+                                KeyJson.ObjectStart();
+                                KeyJson.Value(TEXT("frame"), DisplayFrame);
+                                KeyJson.Value(TEXT("value"), bValue);
+                                KeyJson.ObjectEnd();
+                                if (StepSeries)
+                                {
+                                    FColumnarWriter::PushStep(*StepSeries, DisplayFrame, bValue ? 1 : 0);
+                                }
 
-                                if (ExportFormat == EExportFormat::Csv)
+                                if (Csv)
                                 {
-                                    AddCsvRow(CsvLines, BindingId, BindingLabel, TEXT("Property"),
+                                    AddCsvRow(*Csv, BindingId, BindingLabel, TEXT("Property"),
                                               ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasLowerBound() ? SectionRange.GetLowerBoundValue() : TickFrame),
                                               ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasUpperBound() ? (SectionRange.GetUpperBound().IsExclusive() ? SectionRange.GetUpperBoundValue() - 1 : SectionRange.GetUpperBoundValue()) : TickFrame),
                                               DisplayFrame, PropertyName, PropertyPath, bValue ? TEXT("true") : TEXT("false"),
                                               TOptional<FVector>(), TOptional<FLinearColor>());
                                 }
                             }
+                            if (Columnar)
+                            {
+                                Columnar->EndSeries();
+                            }
                         }
                         else if (UMovieSceneFloatSection* FloatSection = Cast<UMovieSceneFloatSection>(Section))
                         {
                             FMovieSceneFloatChannel& Channel = FloatSection->GetChannel();
-                            const FMovieSceneChannelData<FMovieSceneFloatValue> ChannelData = Channel.GetData();
-                            TArrayView<const FFrameNumber> Times = ChannelData.GetTimes();
-                            TArrayView<const FMovieSceneFloatValue> Values = ChannelData.GetValues();
 
-                            for (int32 Index = 0; Index < Times.Num(); ++Index)
+                            if (KeyMode == EKeyMode::Raw)
                             {
-                                const FFrameNumber TickFrame = Times[Index];
-                                if (!FrameFilter.ContainsTick(TickFrame))
+                                CollectRawKeys(*MovieScene, Channel, FrameFilter, RawKeys);
+                                WriteRawChannel(TEXT("value"), RawKeys, KeyJson);
+                                if (Columnar)
                                 {
-                                    continue;
+                                    AddRawSeries(*Columnar, *MovieScene, SectionRange, BindingId, TEXT("Property"), PropertyPath, TEXT("value"), RawKeys);
                                 }
 
-                                const int32 DisplayFrame = ConvertTickFrameToDisplay(*MovieScene, TickFrame);
-                                if (!FrameFilter.ContainsDisplay(DisplayFrame))
+                                if (Csv)
                                 {
-                                    continue;
+                                    for (const FRawKey& Key : RawKeys)
+                                    {
+                                        AddCsvRow(*Csv, BindingId, BindingLabel, TEXT("Property"),
+                                                  ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasLowerBound() ? SectionRange.GetLowerBoundValue() : Key.Tick),
+                                                  ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasUpperBound() ? (SectionRange.GetUpperBound().IsExclusive() ? SectionRange.GetUpperBoundValue() - 1 : SectionRange.GetUpperBoundValue()) : Key.Tick),
+                                                  Key.DisplayFrame, PropertyName, PropertyPath, LexToString(Key.Value), TOptional<FVector>(), TOptional<FLinearColor>(), &Key);
+                                    }
+                                }
+                            }
+                            else if (KeyMode == EKeyMode::Baked)
+                            {
+                                FMovieSceneFloatChannel* Channels[] = {&Channel};
+                                GatherBakeTimes(*MovieScene, SectionRange, FrameFilter, SampleTimes, SampleFrames);
+                                EvaluateChannelsAt(MakeArrayView(Channels), SampleTimes, SampledValues, SampledMask);
+                                if (Columnar)
+                                {
+                                    static const TCHAR* const ValueColumnNames[] = {TEXT("value")};
+                                    AddSampledSeries(*Columnar, *MovieScene, SectionRange, BindingId, TEXT("Property"), PropertyPath, MakeArrayView(ValueColumnNames), SampleFrames, SampledValues, SampledMask);
+                                }
+
+                                for (int32 Sample = 0; Sample < SampleTimes.Num(); ++Sample)
+                                {
+                                    if (!SampledMask[Sample])
+                                    {
+                                        continue;
+                                    }
+
+                                    const FFrameNumber TickFrame = SampleTimes[Sample].FrameNumber;
+                                    const int32 DisplayFrame = SampleFrames[Sample];
+                                    const double Value = SampledValues[Sample];
+                                    KeyJson.ObjectStart();
+                                    KeyJson.Value(TEXT("frame"), DisplayFrame);
+                                    KeyJson.Value(TEXT("value"), Value);
+                                    KeyJson.ObjectEnd();
+
+                                    if (Csv)
+                                    {
+                                        AddCsvRow(*Csv, BindingId, BindingLabel, TEXT("Property"),
+                                                  ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasLowerBound() ? SectionRange.GetLowerBoundValue() : TickFrame),
+                                                  ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasUpperBound() ? (SectionRange.GetUpperBound().IsExclusive() ? SectionRange.GetUpperBoundValue() - 1 : SectionRange.GetUpperBoundValue()) : TickFrame),
+                                                  DisplayFrame, PropertyName, PropertyPath, LexToString(Value), TOptional<FVector>(), TOptional<FLinearColor>());
+                                    }
                                 }
+                            }
+                            else
+                            {
+                                const FMovieSceneChannelData<FMovieSceneFloatValue> ChannelData = Channel.GetData();
+                                TArrayView<const FFrameNumber> Times = ChannelData.GetTimes();
+                                TArrayView<const FMovieSceneFloatValue> Values = ChannelData.GetValues();
+
+                                FColumnarWriter::FSeries* ValueSeries = Columnar ? &Columnar->BeginSeries(*MovieScene, SectionRange, BindingId, TEXT("Property"), PropertyPath, FString()) : nullptr;
+                                FColumnarWriter::FColumn* ValueColumn = ValueSeries ? &FColumnarWriter::AddColumn(*ValueSeries, TEXT("value"), EColumnType::Float32) : nullptr;
+                                for (int32 Index = FrameFilter.FirstKeyIndex(Times), EndKey = FrameFilter.EndKeyIndex(Times); Index < EndKey; ++Index)
+                                {
+                                    const FFrameNumber TickFrame = Times[Index];
+
+                                    const int32 DisplayFrame = ConvertTickFrameToDisplay(*MovieScene, TickFrame);
+                                    if (!FrameFilter.ContainsDisplay(DisplayFrame))
+                                    {
+                                        continue;
+                                    }
 
-                                const double Value = Values[Index].Value;
-                                TSharedPtr<FJsonObject> KeyJson = MakeShared<FJsonObject>();
-                                KeyJson->SetNumberField(TEXT("frame"), DisplayFrame);
-                                KeyJson->SetNumberField(TEXT("value"), Value);
-                                KeysArray.Add(MakeShared<FJsonValueObject>(KeyJson));
+                                    const double Value = Values[Index].Value;
+                                    KeyJson.ObjectStart();
+                                    KeyJson.Value(TEXT("frame"), DisplayFrame);
+                                    KeyJson.Value(TEXT("value"), Value);
+                                    KeyJson.ObjectEnd();
+                                    if (ValueSeries)
+                                    {
+                                        ValueSeries->Frames.Add(DisplayFrame);
+                                        FColumnarWriter::Push(*ValueColumn, static_cast<float>(Value));
+                                    }
 
-                                if (ExportFormat == EExportFormat::Csv)
+                                    if (Csv)
+                                    {
+                                        AddCsvRow(*Csv, BindingId, BindingLabel, TEXT("Property"),
+                                                  ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasLowerBound() ? SectionRange.GetLowerBoundValue() : TickFrame),
+                                                  ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasUpperBound() ? (SectionRange.GetUpperBound().IsExclusive() ? SectionRange.GetUpperBoundValue() - 1 : SectionRange.GetUpperBoundValue()) : TickFrame),
+                                                  DisplayFrame, PropertyName, PropertyPath, LexToString(Value), TOptional<FVector>(), TOptional<FLinearColor>());
+                                    }
+                                }
+                                if (Columnar)
                                 {
-                                    AddCsvRow(CsvLines, BindingId, BindingLabel, TEXT("Property"),
-                                              ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasLowerBound() ? SectionRange.GetLowerBoundValue() : TickFrame),
-                                              ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasUpperBound() ? (SectionRange.GetUpperBound().IsExclusive() ? SectionRange.GetUpperBoundValue() - 1 : SectionRange.GetUpperBoundValue()) : TickFrame),
-                                              DisplayFrame, PropertyName, PropertyPath, LexToString(Value), TOptional<FVector>(), TOptional<FLinearColor>());
+                                    Columnar->EndSeries();
                                 }
                             }
                         }
@@ -1068,13 +2123,10 @@ TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& P
                             TArrayView<const FFrameNumber> Times = ChannelData.GetTimes();
                             TArrayView<const int32> Values = ChannelData.GetValues();
 
-                            for (int32 Index = 0; Index < Times.Num(); ++Index)
+                            FColumnarWriter::FSeries* StepSeries = Columnar ? &Columnar->BeginStepSeries(*MovieScene, SectionRange, BindingId, TEXT("Property"), PropertyPath) : nullptr;
+                            for (int32 Index = FrameFilter.FirstKeyIndex(Times), EndKey = FrameFilter.EndKeyIndex(Times); Index < EndKey; ++Index)
                             {
                                 const FFrameNumber TickFrame = Times[Index];
-                                if (!FrameFilter.ContainsTick(TickFrame))
-                                {
-                                    continue;
-                                }
 
                                 const int32 DisplayFrame = ConvertTickFrameToDisplay(*MovieScene, TickFrame);
                                 if (!FrameFilter.ContainsDisplay(DisplayFrame))
@@ -1083,19 +2135,27 @@ TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& P
                                 }
 
                                 const int32 Value = Values[Index];
-                                TSharedPtr<FJsonObject> KeyJson = MakeShared<FJsonObject>();
-                                KeyJson->SetNumberField(TEXT("frame"), DisplayFrame);
-                                KeyJson->SetNumberField(TEXT("value"), Value);
-                                KeysArray.Add(MakeShared<FJsonValueObject>(KeyJson));
+                                KeyJson.ObjectStart();
+                                KeyJson.Value(TEXT("frame"), DisplayFrame);
+                                KeyJson.Value(TEXT("value"), Value);
+                                KeyJson.ObjectEnd();
+                                if (StepSeries)
+                                {
+                                    FColumnarWriter::PushStep(*StepSeries, DisplayFrame, Value);
+                                }
 
-                                if (ExportFormat == EExportFormat::Csv)
+                                if (Csv)
                                 {
-                                    AddCsvRow(CsvLines, BindingId, BindingLabel, TEXT("Property"),
+                                    AddCsvRow(*Csv, BindingId, BindingLabel, TEXT("Property"),
                                               ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasLowerBound() ? SectionRange.GetLowerBoundValue() : TickFrame),
                                               ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasUpperBound() ? (SectionRange.GetUpperBound().IsExclusive() ? SectionRange.GetUpperBoundValue() - 1 : SectionRange.GetUpperBoundValue()) : TickFrame),
                                               DisplayFrame, PropertyName, PropertyPath, LexToString(Value), TOptional<FVector>(), TOptional<FLinearColor>());
                                 }
                             }
+                            if (Columnar)
+                            {
+                                Columnar->EndSeries();
+                            }
                         }
                         else if (UMovieSceneByteSection* ByteSection = Cast<UMovieSceneByteSection>(Section))
                         {
@@ -1104,13 +2164,10 @@ TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& P
                             TArrayView<const FFrameNumber> Times = ChannelData.GetTimes();
                             TArrayView<const uint8> Values = ChannelData.GetValues();
 
-                            for (int32 Index = 0; Index < Times.Num(); ++Index)
+                            FColumnarWriter::FSeries* StepSeries = Columnar ? &Columnar->BeginStepSeries(*MovieScene, SectionRange, BindingId, TEXT("Property"), PropertyPath) : nullptr;
+                            for (int32 Index = FrameFilter.FirstKeyIndex(Times), EndKey = FrameFilter.EndKeyIndex(Times); Index < EndKey; ++Index)
                             {
                                 const FFrameNumber TickFrame = Times[Index];
-                                if (!FrameFilter.ContainsTick(TickFrame))
-                                {
-                                    continue;
-                                }
 
                                 const int32 DisplayFrame = ConvertTickFrameToDisplay(*MovieScene, TickFrame);
                                 if (!FrameFilter.ContainsDisplay(DisplayFrame))
@@ -1119,148 +2176,643 @@ TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& P
                                 }
 
                                 const uint8 Value = Values[Index];
-                                TSharedPtr<FJsonObject> KeyJson = MakeShared<FJsonObject>();
-                                KeyJson->SetNumberField(TEXT("frame"), DisplayFrame);
-                                KeyJson->SetNumberField(TEXT("value"), Value);
-                                KeysArray.Add(MakeShared<FJsonValueObject>(KeyJson));
+                                KeyJson.ObjectStart();
+                                KeyJson.Value(TEXT("frame"), DisplayFrame);
+                                KeyJson.Value(TEXT("value"), static_cast<int32>(Value));
+                                KeyJson.ObjectEnd();
+                                if (StepSeries)
+                                {
+                                    FColumnarWriter::PushStep(*StepSeries, DisplayFrame, static_cast<int32>(Value));
+                                }
 
-                                if (ExportFormat == EExportFormat::Csv)
+                                if (Csv)
                                 {
-                                    AddCsvRow(CsvLines, BindingId, BindingLabel, TEXT("Property"),
+                                    AddCsvRow(*Csv, BindingId, BindingLabel, TEXT("Property"),
                                               ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasLowerBound() ? SectionRange.GetLowerBoundValue() : TickFrame),
                                               ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasUpperBound() ? (SectionRange.GetUpperBound().IsExclusive() ? SectionRange.GetUpperBoundValue() - 1 : SectionRange.GetUpperBoundValue()) : TickFrame),
                                               DisplayFrame, PropertyName, PropertyPath, LexToString(Value), TOptional<FVector>(), TOptional<FLinearColor>());
                                 }
                             }
+                            if (Columnar)
+                            {
+                                Columnar->EndSeries();
+                            }
                         }
                         else if (UMovieSceneColorSection* ColorSection = Cast<UMovieSceneColorSection>(Section))
                         {
-                            FMovieSceneFloatChannel& Red = ColorSection->GetRedChannel();
-                            FMovieSceneFloatChannel& Green = ColorSection->GetGreenChannel();
-                            FMovieSceneFloatChannel& Blue = ColorSection->GetBlueChannel();
-                            FMovieSceneFloatChannel& Alpha = ColorSection->GetAlphaChannel();
+                            FMovieSceneFloatChannel* ColorChannels[] = {&ColorSection->GetRedChannel(), &ColorSection->GetGreenChannel(), &ColorSection->GetBlueChannel(), &ColorSection->GetAlphaChannel()};
+                            static const TCHAR* const ColorChannelNames[] = {TEXT("r"), TEXT("g"), TEXT("b"), TEXT("a")};
 
-                            TSet<int32> KeyFrames;
-                            const auto GatherFrames = [&KeyFrames, &FrameFilter](FMovieSceneFloatChannel& Channel)
+                            if (KeyMode == EKeyMode::Raw)
                             {
-                                const FMovieSceneChannelData<FMovieSceneFloatValue> ChannelData = Channel.GetData();
-                                TArrayView<const FFrameNumber> Times = ChannelData.GetTimes();
-                                for (const FFrameNumber& Time : Times)
+                                for (int32 ChannelIndex = 0; ChannelIndex < static_cast<int32>(UE_ARRAY_COUNT(ColorChannels)); ++ChannelIndex)
                                 {
-                                    const int32 Tick = Time.Value;
-                                    if (FrameFilter.TickStart.IsSet() && Tick < FrameFilter.TickStart.GetValue().Value)
+                                    CollectRawKeys(*MovieScene, *ColorChannels[ChannelIndex], FrameFilter, RawKeys);
+                                    WriteRawChannel(ColorChannelNames[ChannelIndex], RawKeys, KeyJson);
+                                    if (Columnar)
                                     {
-                                        continue;
+                                        AddRawSeries(*Columnar, *MovieScene, SectionRange, BindingId, TEXT("Property"), PropertyPath, ColorChannelNames[ChannelIndex], RawKeys);
+                                    }
+
+                                    if (Csv)
+                                    {
+                                        for (const FRawKey& Key : RawKeys)
+                                        {
+                                            AddCsvRow(*Csv, BindingId, BindingLabel, TEXT("Property"),
+                                                      ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasLowerBound() ? SectionRange.GetLowerBoundValue() : Key.Tick),
+                                                      ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasUpperBound() ? (SectionRange.GetUpperBound().IsExclusive() ? SectionRange.GetUpperBoundValue() - 1 : SectionRange.GetUpperBoundValue()) : Key.Tick),
+                                                      Key.DisplayFrame, ColorChannelNames[ChannelIndex], PropertyPath, LexToString(Key.Value), TOptional<FVector>(), TOptional<FLinearColor>(), &Key);
+                                        }
                                     }
-                                    if (FrameFilter.TickEnd.IsSet() && Tick > FrameFilter.TickEnd.GetValue().Value)
+                                }
+                            }
+                            else
+                            {
+                                if (KeyMode == EKeyMode::Baked)
+                                {
+                                    GatherBakeTimes(*MovieScene, SectionRange, FrameFilter, SampleTimes, SampleFrames);
+                                }
+                                else
+                                {
+                                    GatherKeyTimes(*MovieScene, MakeArrayView(ColorChannels), FrameFilter, SampleTimes, SampleFrames);
+                                }
+                                EvaluateChannelsAt(MakeArrayView(ColorChannels), SampleTimes, SampledValues, SampledMask);
+                                if (Columnar)
+                                {
+                                    AddSampledSeries(*Columnar, *MovieScene, SectionRange, BindingId, TEXT("Property"), PropertyPath, MakeArrayView(ColorChannelNames), SampleFrames, SampledValues, SampledMask);
+                                }
+
+                                const int32 NumSamples = SampleTimes.Num();
+                                for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+                                {
+                                    if (!(SampledMask[Sample] || SampledMask[NumSamples + Sample] || SampledMask[2 * NumSamples + Sample] || SampledMask[3 * NumSamples + Sample]))
                                     {
                                         continue;
                                     }
-                                    KeyFrames.Add(Tick);
+
+                                    const FFrameNumber TickFrame = SampleTimes[Sample].FrameNumber;
+                                    const int32 DisplayFrame = SampleFrames[Sample];
+                                    FLinearColor Color(static_cast<float>(SampledValues[Sample]), static_cast<float>(SampledValues[NumSamples + Sample]),
+                                                       static_cast<float>(SampledValues[2 * NumSamples + Sample]), static_cast<float>(SampledValues[3 * NumSamples + Sample]));
+                                    KeyJson.ObjectStart();
+                                    KeyJson.Value(TEXT("frame"), DisplayFrame);
+                                    WriteColorField(TEXT("color"), Color, KeyJson);
+                                    KeyJson.ObjectEnd();
+
+                                    if (Csv)
+                                    {
+                                        FString ValueString;
+                                        if (!bFlattenProperties)
+                                        {
+                                            ValueString = FString::Printf(TEXT("%s,%s,%s,%s"), *LexToString(Color.R), *LexToString(Color.G), *LexToString(Color.B), *LexToString(Color.A));
+                                        }
+
+                                        AddCsvRow(*Csv, BindingId, BindingLabel, TEXT("Property"),
+                                                  ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasLowerBound() ? SectionRange.GetLowerBoundValue() : TickFrame),
+                                                  ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasUpperBound() ? (SectionRange.GetUpperBound().IsExclusive() ? SectionRange.GetUpperBoundValue() - 1 : SectionRange.GetUpperBoundValue()) : TickFrame),
+                                                  DisplayFrame, PropertyName, PropertyPath, ValueString, TOptional<FVector>(), bFlattenProperties ? Color : TOptional<FLinearColor>());
+                                    }
                                 }
-                            };
+                            }
+                        }
+
+                        KeyJson.ArrayEnd();
+                        TrackJson.ObjectEnd();
+                    }
+
+                    if (bTrackOpen)
+                    {
+                        TrackJson.ArrayEnd();
+                        TrackJson.ObjectEnd();
+                    }
+                }
+            }
+        }
+
+        if (bWriteJson)
+        {
+            Json.ArrayEnd();
+        }
+    }
+}
+
+namespace
+{
+    /** Everything besides the sequence's own state that decides what an export produces. */
+    FString MakeCacheOptions(EExportFormat Format, EKeyMode KeyMode, bool bFlattenProperties, const FIncludeSettings& Include, const FFrameRangeFilter& Filter)
+    {
+        return FString::Printf(TEXT("format=%d keyMode=%d flatten=%d include=%d%d%d%d%d%d frames=%s..%s ticks=%s..%s"),
+            static_cast<int32>(Format), static_cast<int32>(KeyMode), bFlattenProperties ? 1 : 0,
+            Include.bBindings ? 1 : 0, Include.bIncludeKeys ? 1 : 0, Include.bTransform ? 1 : 0, Include.bVisibility ? 1 : 0, Include.bProperty ? 1 : 0, Include.bCameraCut ? 1 : 0,
+            *OptionalIntToString(Filter.DisplayStart), *OptionalIntToString(Filter.DisplayEnd),
+            Filter.TickStart.IsSet() ? *FString::FromInt(Filter.TickStart->Value) : TEXT(""),
+            Filter.TickEnd.IsSet() ? *FString::FromInt(Filter.TickEnd->Value) : TEXT(""));
+    }
+
+    /** The result fields stored beside a cached body; the body itself carries the rest. */
+    TSharedRef<FJsonObject> MakeCachedFields(const FJsonObject& Data)
+    {
+        TSharedRef<FJsonObject> Fields = MakeShared<FJsonObject>();
+        for (const TCHAR* Name : {TEXT("sequence"), TEXT("rows"), TEXT("series"), TEXT("keys")})
+        {
+            if (TSharedPtr<FJsonValue> Value = Data.TryGetField(Name))
+            {
+                Fields->SetField(Name, Value);
+            }
+        }
+        return Fields;
+    }
+
+    /**
+     * Answers an export from a cache entry through the same sink a fresh export would use. Null when
+     * the entry cannot be read, before anything was sent, so the caller exports as usual.
+     */
+    TSharedPtr<FJsonObject> ServeCachedExport(EExportSink Sink, EExportFormat Format, const FString& BodyFile, const FJsonObject& Fields,
+                                              UnrealMCP::Protocol::FResponseStream* Stream, const FString& OutputFile, UnrealMCP::Protocol::FCommandContext* Context)
+    {
+        TSharedRef<FJsonObject> Data = MakeShared<FJsonObject>();
+        Data->SetBoolField(TEXT("ok"), true);
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Fields.Values)
+        {
+            Data->SetField(Field.Key, Field.Value);
+        }
+
+        if (Sink == EExportSink::File)
+        {
+            const FString TempFile = OutputFile + TEXT(".partial");
+            if (IFileManager::Get().Copy(*TempFile, *BodyFile) != COPY_OK)
+            {
+                IFileManager::Get().Delete(*TempFile, /*RequireExists=*/false, /*EvenReadOnly=*/true);
+                return nullptr;
+            }
+            if (!IFileManager::Get().Move(*OutputFile, *TempFile, /*Replace=*/true))
+            {
+                IFileManager::Get().Delete(*TempFile, /*RequireExists=*/false, /*EvenReadOnly=*/true);
+                return MakeErrorResponse(ErrorCodeOutputFailed, FString::Printf(TEXT("Could not write '%s'"), *OutputFile));
+            }
+            Data->SetStringField(TEXT("outputFile"), OutputFile);
+            Data->SetNumberField(TEXT("bytes"), static_cast<double>(IFileManager::Get().FileSize(*OutputFile)));
+        }
+        else if (Sink == EExportSink::Stream)
+        {
+            TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*BodyFile));
+            if (!Reader)
+            {
+                return nullptr;
+            }
+
+            if (Format == EExportFormat::Csv)
+            {
+                Stream->Begin(TEXT("csv"), TEXT("text/csv"));
+            }
+            else
+            {
+                Stream->Begin(TEXT("document"), TEXT("application/json"));
+            }
+            FStreamChunkArchive StreamArchive(*Stream);
+            TArray<uint8> Buffer;
+            Buffer.SetNumUninitialized(StreamChunkBytes);
+            for (int64 Remaining = Reader->TotalSize(); Remaining > 0;)
+            {
+                const int32 Count = static_cast<int32>(FMath::Min<int64>(Remaining, StreamChunkBytes));
+                Reader->Serialize(Buffer.GetData(), Count);
+                StreamArchive.Serialize(Buffer.GetData(), Count);
+                Remaining -= Count;
+            }
+            StreamArchive.Finish();
+            Data->SetNumberField(TEXT("bytes"), static_cast<double>(StreamArchive.TotalSize()));
+            Data->SetBoolField(Format == EExportFormat::Csv ? TEXT("csvStreamed") : TEXT("documentStreamed"), true);
+        }
+        else
+        {
+            TArray<uint8> Body;
+            if (!FFileHelper::LoadFileToArray(Body, *BodyFile))
+            {
+                return nullptr;
+            }
+
+            if (Format == EExportFormat::Columnar)
+            {
+                Data->SetNumberField(TEXT("bytes"), Body.Num());
+                if (Context && Context->CanAttach())
+                {
+                    Data->SetObjectField(TEXT("columnar"), Context->Attach(MoveTemp(Body)));
+                }
+                else
+                {
+                    Data->SetStringField(TEXT("columnar"), FBase64::Encode(Body));
+                }
+            }
+            else
+            {
+                const FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num());
+                FString BodyString(Text.Length(), Text.Get());
+                if (Format == EExportFormat::Csv)
+                {
+                    Data->SetStringField(TEXT("csv"), MoveTemp(BodyString));
+                }
+                else
+                {
+                    TSharedPtr<FJsonObject> Document;
+                    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BodyString);
+                    if (!FJsonSerializer::Deserialize(Reader, Document) || !Document.IsValid())
+                    {
+                        return nullptr;
+                    }
+                    for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Document->Values)
+                    {
+                        Data->SetField(Field.Key, Field.Value);
+                    }
+                }
+            }
+        }
+
+        Data->SetBoolField(TEXT("cached"), true);
+        return MakeSuccessResponse(Data);
+    }
+}
+
+TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!Params.IsValid())
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing parameters"));
+    }
+
+    FString SequencePath;
+    if (!Params->TryGetStringField(TEXT("sequencePath"), SequencePath))
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing sequencePath"));
+    }
+
+    const FString SequenceObjectPath = ResolveSequenceObjectPath(SequencePath);
+    if (SequenceObjectPath.IsEmpty())
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Invalid sequencePath"));
+    }
+
+    FString FormatString = TEXT("json");
+    if (Params->HasField(TEXT("format")))
+    {
+        Params->TryGetStringField(TEXT("format"), FormatString);
+    }
+    FormatString.TrimStartAndEndInline();
+
+    EExportFormat ExportFormat = EExportFormat::Json;
+    if (FormatString.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+    {
+        ExportFormat = EExportFormat::Json;
+    }
+    else if (FormatString.Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+    {
+        ExportFormat = EExportFormat::Csv;
+    }
+    else if (FormatString.Equals(TEXT("columnar"), ESearchCase::IgnoreCase))
+    {
+        ExportFormat = EExportFormat::Columnar;
+    }
+    else
+    {
+        return MakeErrorResponse(ErrorCodeUnsupportedFormat, FString::Printf(TEXT("Unsupported format: %s"), *FormatString));
+    }
+
+    ULevelSequence* LevelSequence = LoadObject<ULevelSequence>(nullptr, *SequenceObjectPath);
+    if (!LevelSequence)
+    {
+        return MakeErrorResponse(ErrorCodeSequenceNotFound, FString::Printf(TEXT("Sequence not found: %s"), *SequenceObjectPath));
+    }
+
+    UMovieScene* MovieScene = LevelSequence->GetMovieScene();
+    if (!MovieScene)
+    {
+        return MakeErrorResponse(ErrorCodeSequenceNotFound, TEXT("Sequence is missing MovieScene"));
+    }
+
+    FIncludeSettings IncludeSettings;
+    const TSharedPtr<FJsonObject>* IncludeObject = nullptr;
+    if (Params->TryGetObjectField(TEXT("include"), IncludeObject))
+    {
+        ApplyTrackFilters(*IncludeObject, IncludeSettings);
+    }
+
+    // The columnar container carries keys only; its header describes the sequence and camera cuts.
+    const bool bColumnar = ExportFormat == EExportFormat::Columnar;
+    if (bColumnar)
+    {
+        IncludeSettings.bBindings = false;
+        IncludeSettings.bIncludeKeys = true;
+    }
+
+    const bool bResolveActorPaths = Params->HasTypedField<EJson::Boolean>(TEXT("worldActorPaths")) && Params->GetBoolField(TEXT("worldActorPaths"));
+    const bool bFlattenProperties = Params->HasTypedField<EJson::Boolean>(TEXT("flattenProperties")) && Params->GetBoolField(TEXT("flattenProperties"));
+
+    EKeyMode KeyMode = EKeyMode::Evaluated;
+    FString KeyModeString;
+    if (Params->TryGetStringField(TEXT("keyMode"), KeyModeString))
+    {
+        KeyModeString.TrimStartAndEndInline();
+        if (KeyModeString.Equals(TEXT("raw"), ESearchCase::IgnoreCase))
+        {
+            KeyMode = EKeyMode::Raw;
+        }
+        else if (KeyModeString.Equals(TEXT("baked"), ESearchCase::IgnoreCase))
+        {
+            KeyMode = EKeyMode::Baked;
+        }
+        else if (!KeyModeString.IsEmpty() && !KeyModeString.Equals(TEXT("evaluated"), ESearchCase::IgnoreCase))
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParameters, FString::Printf(TEXT("Unsupported keyMode: %s (expected evaluated, raw or baked)"), *KeyModeString));
+        }
+    }
+
+    FFrameRangeFilter FrameFilter;
+    FString FrameRangeError;
+    if (!ParseFrameRange(*MovieScene, Params, FrameFilter, FrameRangeError))
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, FrameRangeError);
+    }
+
+    // Without a sink the document is built as a tree in the response, as it always was. With
+    // outputPath or a streamed response it is written as UTF-8 text while the sequence is walked,
+    // so nothing the size of the export is ever held; a CSV export to a sink skips the JSON. A
+    // columnar export is binary and goes to outputPath or an attachment, never the text stream.
+    FString OutputPath;
+    Params->TryGetStringField(TEXT("outputPath"), OutputPath);
+    OutputPath.TrimStartAndEndInline();
+
+    UnrealMCP::Protocol::FResponseStream* Stream = UnrealMCP::Protocol::FResponseStream::GetActive();
+    const EExportSink Sink = !OutputPath.IsEmpty() ? EExportSink::File : (Stream && !bColumnar ? EExportSink::Stream : EExportSink::Response);
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+
+    FString OutputFile;
+    if (Sink == EExportSink::File)
+    {
+        FString PathError;
+        if (!ResolveOutputPath(OutputPath, OutputFile, PathError))
+        {
+            return MakeErrorResponse(ErrorCodeInvalidParameters, PathError);
+        }
+    }
+
+    // An unchanged sequence exported with the same options is answered from the last result. Exports
+    // that resolve actors depend on the world as well, so they are never cached.
+    FString CacheKey;
+    const bool bUseCache = !(Params->HasTypedField<EJson::Boolean>(TEXT("cache")) && !Params->GetBoolField(TEXT("cache")))
+        && !bResolveActorPaths
+        && FSequenceExportCache::MakeKey(*LevelSequence, MakeCacheOptions(ExportFormat, KeyMode, bFlattenProperties, IncludeSettings, FrameFilter), CacheKey);
+    if (bUseCache)
+    {
+        FString CachedBody;
+        TSharedPtr<FJsonObject> CachedFields;
+        if (FSequenceExportCache::Find(CacheKey, CachedBody, CachedFields))
+        {
+            if (TSharedPtr<FJsonObject> Cached = ServeCachedExport(Sink, ExportFormat, CachedBody, *CachedFields, Stream, OutputFile, Context))
+            {
+                return Cached;
+            }
+        }
+    }
+    TUniquePtr<FArchive> CacheArchive = bUseCache ? FSequenceExportCache::BeginStore(CacheKey) : nullptr;
+
+    FString TempFile;
+    TUniquePtr<FArchive> FileArchive;
+    if (Sink == EExportSink::File)
+    {
+        // Written beside the target and moved over it at the end, so a cancelled export never
+        // leaves half a file under the real name.
+        TempFile = OutputFile + TEXT(".partial");
+        FileArchive.Reset(IFileManager::Get().CreateFileWriter(*TempFile));
+        if (!FileArchive)
+        {
+            FSequenceExportCache::AbandonStore(CacheKey, MoveTemp(CacheArchive));
+            return MakeErrorResponse(ErrorCodeOutputFailed, FString::Printf(TEXT("Could not open '%s' for writing"), *TempFile));
+        }
+    }
+
+    TArray<uint8> InlineCsvBytes;
+    FMemoryWriter InlineCsvArchive(InlineCsvBytes);
+    TUniquePtr<FStreamChunkArchive> StreamArchive;
+    if (Sink == EExportSink::Stream)
+    {
+        if (ExportFormat == EExportFormat::Csv)
+        {
+            Stream->Begin(TEXT("csv"), TEXT("text/csv"));
+        }
+        else
+        {
+            Stream->Begin(TEXT("document"), TEXT("application/json"));
+        }
+        StreamArchive = MakeUnique<FStreamChunkArchive>(*Stream);
+    }
+
+    FArchive* SinkArchive = Sink == EExportSink::File ? FileArchive.Get() : (Sink == EExportSink::Stream ? StreamArchive.Get() : nullptr);
+    // Text written to a file or the stream goes to the cache entry on the way.
+    TUniquePtr<FTeeArchive> TeeArchive;
+    if (SinkArchive && CacheArchive && !bColumnar)
+    {
+        TeeArchive = MakeUnique<FTeeArchive>(*SinkArchive, *CacheArchive);
+        SinkArchive = TeeArchive.Get();
+    }
+    auto AbortSink = [&FileArchive, &TempFile, &CacheArchive, &CacheKey]()
+    {
+        if (FileArchive)
+        {
+            FileArchive->Close();
+            FileArchive.Reset();
+            IFileManager::Get().Delete(*TempFile, /*RequireExists=*/false, /*EvenReadOnly=*/true);
+        }
+        if (CacheArchive)
+        {
+            FSequenceExportCache::AbandonStore(CacheKey, MoveTemp(CacheArchive));
+        }
+    };
+
+    TSharedRef<FJsonObject> Data = MakeShared<FJsonObject>();
+    Data->SetBoolField(TEXT("ok"), true);
+
+    FExportJson Json;
+    if (Sink == EExportSink::Response || bColumnar)
+    {
+        Json = FExportJson(Data);
+    }
+    else if (ExportFormat == EExportFormat::Json)
+    {
+        Json = FExportJson(*SinkArchive);
+    }
+
+    TUniquePtr<FCsvExportWriter> CsvWriter;
+    if (ExportFormat == EExportFormat::Csv)
+    {
+        CsvWriter = MakeUnique<FCsvExportWriter>(SinkArchive ? *SinkArchive : static_cast<FArchive&>(InlineCsvArchive));
+        // Raw keys carry their interpolation and tangents in four extra columns.
+        CsvWriter->WriteHeader(KeyMode == EKeyMode::Raw
+            ? TEXT("bindingId,label,trackType,sectionStart,sectionEnd,frame,key,property,value,x,y,z,r,g,b,a,interp,tangentMode,arriveTangent,leaveTangent")
+            : TEXT("bindingId,label,trackType,sectionStart,sectionEnd,frame,key,property,value,x,y,z,r,g,b,a"));
+    }
+    FCsvExportWriter* Csv = CsvWriter.Get();
 
-                            GatherFrames(Red);
-                            GatherFrames(Green);
-                            GatherFrames(Blue);
-                            GatherFrames(Alpha);
+    TSharedRef<FJsonObject> SequenceJson = MakeShared<FJsonObject>();
+    SequenceJson->SetStringField(TEXT("assetPath"), SequenceObjectPath);
+
+    const FFrameRate DisplayRate = MovieScene->GetDisplayRate();
+    const FFrameRate TickResolution = MovieScene->GetTickResolution();
+
+    {
+        TArray<TSharedPtr<FJsonValue>> DisplayRateArray;
+        DisplayRateArray.Add(MakeShared<FJsonValueNumber>(DisplayRate.Numerator));
+        DisplayRateArray.Add(MakeShared<FJsonValueNumber>(DisplayRate.Denominator));
+        SequenceJson->SetArrayField(TEXT("displayRate"), DisplayRateArray);
+    }
 
-                            TArray<int32> Sorted = KeyFrames.Array();
-                            Sorted.Sort();
+    {
+        TArray<TSharedPtr<FJsonValue>> TickArray;
+        TickArray.Add(MakeShared<FJsonValueNumber>(TickResolution.Numerator));
+        TickArray.Add(MakeShared<FJsonValueNumber>(TickResolution.Denominator));
+        SequenceJson->SetArrayField(TEXT("tickResolution"), TickArray);
+    }
 
-                            for (int32 Tick : Sorted)
-                            {
-                                const FFrameNumber TickFrame(Tick);
-                                if (!FrameFilter.ContainsTick(TickFrame))
-                                {
-                                    continue;
-                                }
+    const TRange<FFrameNumber> PlaybackRange = MovieScene->GetPlaybackRange();
+    if (PlaybackRange.HasLowerBound() && PlaybackRange.HasUpperBound())
+    {
+        FFrameNumber RangeEnd = PlaybackRange.GetUpperBound().IsExclusive() ? PlaybackRange.GetUpperBoundValue() - 1 : PlaybackRange.GetUpperBoundValue();
+        const int32 DurationDisplay = ConvertTickFrameToDisplay(*MovieScene, RangeEnd) - ConvertTickFrameToDisplay(*MovieScene, PlaybackRange.GetLowerBoundValue()) + 1;
+        SequenceJson->SetNumberField(TEXT("durationFrames"), DurationDisplay);
+    }
+    else
+    {
+        SequenceJson->SetNumberField(TEXT("durationFrames"), 0);
+    }
 
-                                const int32 DisplayFrame = ConvertTickFrameToDisplay(*MovieScene, TickFrame);
-                                if (!FrameFilter.ContainsDisplay(DisplayFrame))
-                                {
-                                    continue;
-                                }
+    Json.Object(TEXT("sequence"), SequenceJson);
+    if (Sink != EExportSink::Response)
+    {
+        Data->SetObjectField(TEXT("sequence"), SequenceJson);
+    }
 
-                                double R = 0.0;
-                                double G = 0.0;
-                                double B = 0.0;
-                                double A = 0.0;
-                                const bool bHasR = Red.Evaluate(TickFrame, R);
-                                const bool bHasG = Green.Evaluate(TickFrame, G);
-                                const bool bHasB = Blue.Evaluate(TickFrame, B);
-                                const bool bHasA = Alpha.Evaluate(TickFrame, A);
-                                if (!(bHasR || bHasG || bHasB || bHasA))
-                                {
-                                    continue;
-                                }
+    UWorld* World = bResolveActorPaths ? GetEditorWorld() : nullptr;
 
-                                FLinearColor Color(static_cast<float>(R), static_cast<float>(G), static_cast<float>(B), static_cast<float>(A));
-                                TSharedPtr<FJsonObject> KeyJson = MakeShared<FJsonObject>();
-                                KeyJson->SetNumberField(TEXT("frame"), DisplayFrame);
-                                AppendColorField(TEXT("color"), Color, KeyJson);
-                                KeysArray.Add(MakeShared<FJsonValueObject>(KeyJson));
+    if (IncludeSettings.bBindings)
+    {
+        Json.ArrayStart(TEXT("bindings"));
+    }
 
-                                if (ExportFormat == EExportFormat::Csv)
-                                {
-                                    FString ValueString;
-                                    if (!bFlattenProperties)
-                                    {
-                                        ValueString = FString::Printf(TEXT("%s,%s,%s,%s"), *LexToString(Color.R), *LexToString(Color.G), *LexToString(Color.B), *LexToString(Color.A));
-                                    }
+    // Bindings are exported in waves. The game thread reads each wave's bindings, the workers turn
+    // them into JSON and CSV, and the game thread appends the results in binding order before the
+    // next wave starts, so a streamed or file export only holds one wave at a time.
+    FExportSettings Settings;
+    Settings.MovieScene = MovieScene;
+    Settings.Include = IncludeSettings;
+    Settings.FrameFilter = FrameFilter;
+    Settings.KeyMode = KeyMode;
+    Settings.bFlattenProperties = bFlattenProperties;
+    Settings.bResolveActorPaths = bResolveActorPaths;
+
+    const bool bBindingJson = IncludeSettings.bBindings && Json.IsEnabled();
+    const bool bBindingJsonText = bBindingJson && Sink != EExportSink::Response;
+    const int32 CsvColumns = Csv ? Csv->GetNumColumns() : 0;
+    FColumnarWriter Columnar;
+
+    TArray<FBindingSnapshot> Snapshots;
+    TArray<FBindingOutput> Outputs;
+
+    const TArray<FMovieSceneBinding>& Bindings = MovieScene->GetBindings();
+    for (int32 WaveStart = 0; WaveStart < Bindings.Num(); WaveStart += BindingsPerWave)
+    {
+        if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
+        {
+            AbortSink();
+            return MakeErrorResponse(ErrorCodeCancelled, FString::Printf(TEXT("Export cancelled after %d of %d bindings"), WaveStart, Bindings.Num()));
+        }
+        UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(WaveStart, Bindings.Num(), TEXT("bindings"));
 
-                                    AddCsvRow(CsvLines, BindingId, BindingLabel, TEXT("Property"),
-                                              ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasLowerBound() ? SectionRange.GetLowerBoundValue() : TickFrame),
-                                              ConvertTickFrameToDisplay(*MovieScene, SectionRange.HasUpperBound() ? (SectionRange.GetUpperBound().IsExclusive() ? SectionRange.GetUpperBoundValue() - 1 : SectionRange.GetUpperBoundValue()) : TickFrame),
-                                              DisplayFrame, PropertyName, PropertyPath, ValueString, TOptional<FVector>(), bFlattenProperties ? Color : TOptional<FLinearColor>());
-                                }
-                            }
-                        }
+        const int32 WaveCount = FMath::Min(BindingsPerWave, Bindings.Num() - WaveStart);
+        Snapshots.Reset(WaveCount);
+        for (int32 BindingIndex = WaveStart; BindingIndex < WaveStart + WaveCount; ++BindingIndex)
+        {
+            Snapshots.Add(SnapshotBinding(*LevelSequence, *MovieScene, Bindings[BindingIndex], IncludeSettings, World));
+        }
 
-                        if (IncludeSettings.bIncludeKeys)
-                        {
-                            SectionJson->SetArrayField(TEXT("keys"), KeysArray);
-                        }
+        Outputs.Reset(WaveCount);
+        Outputs.SetNum(WaveCount);
+        ParallelFor(WaveCount, [&](int32 Index)
+        {
+            if (Context && Context->IsCancelled())
+            {
+                return;
+            }
 
-                        if (IncludeSettings.bBindings)
-                        {
-                            PropertySections.Add(MakeShared<FJsonValueObject>(SectionJson));
-                        }
-                    }
+            FBindingOutput& Output = Outputs[Index];
+            FMemoryWriter CsvArchive(Output.CsvText);
+            FCsvExportWriter BindingCsv(CsvArchive, CsvColumns);
+            FCsvExportWriter* BindingCsvPtr = Csv ? &BindingCsv : nullptr;
+            FColumnarWriter* BindingColumnar = bColumnar ? &Output.Columnar : nullptr;
+            FSampleScratch Scratch;
 
-                    if (IncludeSettings.bBindings && PropertySections.Num() > 0)
-                    {
-                        TSharedPtr<FJsonObject> TrackJson = MakeShared<FJsonObject>();
-                        TrackJson->SetStringField(TEXT("type"), TEXT("Property"));
-                        TrackJson->SetStringField(TEXT("propertyPath"), PropertyPath);
-                        if (!PropertyName.IsEmpty())
-                        {
-                            TrackJson->SetStringField(TEXT("propertyName"), PropertyName);
-                        }
-                        TrackJson->SetArrayField(TEXT("sections"), PropertySections);
-                        TrackArray.Add(MakeShared<FJsonValueObject>(TrackJson));
-                    }
-                }
+            if (bBindingJsonText)
+            {
+                FMemoryWriter JsonArchive(Output.JsonText);
+                FExportJson BindingJson(JsonArchive);
+                ExportBinding(Settings, Snapshots[Index], BindingJson, BindingCsvPtr, BindingColumnar, Scratch);
+                BindingJson.Close();
+            }
+            else if (bBindingJson)
+            {
+                Output.Tree = MakeShared<FJsonObject>();
+                FExportJson BindingJson(Output.Tree.ToSharedRef());
+                ExportBinding(Settings, Snapshots[Index], BindingJson, BindingCsvPtr, BindingColumnar, Scratch);
             }
+            else
+            {
+                FExportJson NoJson;
+                ExportBinding(Settings, Snapshots[Index], NoJson, BindingCsvPtr, BindingColumnar, Scratch);
+            }
+            Output.CsvRows = BindingCsv.GetNumRows();
+        }, WaveCount > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+        if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
+        {
+            AbortSink();
+            return MakeErrorResponse(ErrorCodeCancelled, FString::Printf(TEXT("Export cancelled after %d of %d bindings"), WaveStart, Bindings.Num()));
         }
 
-        if (IncludeSettings.bBindings && BindingJson.IsValid())
+        for (FBindingOutput& Output : Outputs)
         {
-            BindingJson->SetArrayField(TEXT("tracks"), TrackArray);
-            BindingsArray.Add(MakeShared<FJsonValueObject>(BindingJson));
+            if (Output.Tree.IsValid())
+            {
+                Json.Object(nullptr, Output.Tree.ToSharedRef());
+            }
+            else if (bBindingJsonText)
+            {
+                Json.RawValue(Output.JsonText);
+            }
+
+            if (Csv)
+            {
+                Csv->AppendRows(Output.CsvText, Output.CsvRows);
+            }
+            Columnar.Append(MoveTemp(Output.Columnar));
         }
     }
 
+    UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(Bindings.Num(), Bindings.Num(), TEXT("bindings"));
+
     if (IncludeSettings.bBindings)
     {
-        Data->SetArrayField(TEXT("bindings"), BindingsArray);
+        Json.ArrayEnd();
     }
 
     if (IncludeSettings.bCameraCut)
     {
         if (UMovieSceneCameraCutTrack* CameraCutTrack = MovieScene->FindMasterTrack<UMovieSceneCameraCutTrack>())
         {
-            TArray<TSharedPtr<FJsonValue>> CameraCutsArray;
+            // Listed when there are cuts, or as an empty array alongside the bindings.
+            bool bCutsOpen = false;
+            if (IncludeSettings.bBindings)
+            {
+                Json.ArrayStart(TEXT("cameraCuts"));
+                bCutsOpen = true;
+            }
+
             for (UMovieSceneSection* Section : CameraCutTrack->GetAllSections())
             {
                 UMovieSceneCameraCutSection* CameraSection = Cast<UMovieSceneCameraCutSection>(Section);
@@ -1306,36 +2858,388 @@ TSharedPtr<FJsonObject> FSequenceExport::Export(const TSharedPtr<FJsonObject>& P
                     }
                 }
 
-                TSharedPtr<FJsonObject> CutJson = MakeShared<FJsonObject>();
-                CutJson->SetNumberField(TEXT("start"), StartDisplay);
-                CutJson->SetNumberField(TEXT("end"), EndDisplay);
+                if (!bCutsOpen)
+                {
+                    Json.ArrayStart(TEXT("cameraCuts"));
+                    bCutsOpen = true;
+                }
 
                 const FMovieSceneObjectBindingID BindingId = CameraSection->GetCameraBindingID();
-                CutJson->SetStringField(TEXT("cameraBindingId"), ToNormalizedBindingGuid(BindingId.GetGuid()));
-                CameraCutsArray.Add(MakeShared<FJsonValueObject>(CutJson));
+                Json.ObjectStart();
+                Json.Value(TEXT("start"), StartDisplay);
+                Json.Value(TEXT("end"), EndDisplay);
+                Json.Value(TEXT("cameraBindingId"), ToNormalizedBindingGuid(BindingId.GetGuid()));
+                Json.ObjectEnd();
 
-                if (ExportFormat == EExportFormat::Csv)
+                if (Csv)
                 {
-                    AddCsvRow(CsvLines, FString(), TEXT(""), TEXT("CameraCut"), StartDisplay, EndDisplay, StartDisplay, TEXT("camera"), TEXT("cameraBindingId"), ToNormalizedBindingGuid(BindingId.GetGuid()), TOptional<FVector>(), TOptional<FLinearColor>());
+                    AddCsvRow(*Csv, FString(), TEXT(""), TEXT("CameraCut"), StartDisplay, EndDisplay, StartDisplay, TEXT("camera"), TEXT("cameraBindingId"), ToNormalizedBindingGuid(BindingId.GetGuid()), TOptional<FVector>(), TOptional<FLinearColor>());
                 }
             }
 
-            if (CameraCutsArray.Num() > 0)
+            if (bCutsOpen)
             {
-                Data->SetArrayField(TEXT("cameraCuts"), CameraCutsArray);
+                Json.ArrayEnd();
             }
-            else if (IncludeSettings.bBindings)
+        }
+    }
+
+    Json.Close();
+    if (Csv)
+    {
+        Data->SetNumberField(TEXT("rows"), Csv->GetNumRows() - 1);
+    }
+
+    if (bColumnar)
+    {
+        TSharedRef<FJsonObject> Header = MakeShared<FJsonObject>();
+        Header->SetStringField(TEXT("format"), TEXT("columnar"));
+        Header->SetNumberField(TEXT("version"), 1);
+        Header->SetStringField(TEXT("keyMode"), KeyMode == EKeyMode::Raw ? TEXT("raw") : (KeyMode == EKeyMode::Baked ? TEXT("baked") : TEXT("evaluated")));
+        Header->SetObjectField(TEXT("sequence"), SequenceJson);
+        const TArray<TSharedPtr<FJsonValue>>* CameraCuts = nullptr;
+        if (Data->TryGetArrayField(TEXT("cameraCuts"), CameraCuts))
+        {
+            Header->SetArrayField(TEXT("cameraCuts"), *CameraCuts);
+        }
+
+        TArray<uint8> ColumnarBytes = EncodeColumnar(Columnar, Header);
+        Data->SetNumberField(TEXT("series"), Columnar.GetSeries().Num());
+        Data->SetNumberField(TEXT("keys"), static_cast<double>(Columnar.GetNumKeys()));
+        Data->SetNumberField(TEXT("bytes"), ColumnarBytes.Num());
+        if (CacheArchive)
+        {
+            CacheArchive->Serialize(ColumnarBytes.GetData(), ColumnarBytes.Num());
+        }
+        if (Sink == EExportSink::File)
+        {
+            FileArchive->Serialize(ColumnarBytes.GetData(), ColumnarBytes.Num());
+        }
+        else if (Context && Context->CanAttach())
+        {
+            Data->SetObjectField(TEXT("columnar"), Context->Attach(MoveTemp(ColumnarBytes)));
+        }
+        else
+        {
+            Data->SetStringField(TEXT("columnar"), FBase64::Encode(ColumnarBytes));
+        }
+    }
+
+    if (Sink == EExportSink::File)
+    {
+        const int64 Bytes = FileArchive->TotalSize();
+        const bool bWritten = FileArchive->Close() && !FileArchive->IsError();
+        FileArchive.Reset();
+        if (!bWritten || !IFileManager::Get().Move(*OutputFile, *TempFile, /*Replace=*/true))
+        {
+            IFileManager::Get().Delete(*TempFile, /*RequireExists=*/false, /*EvenReadOnly=*/true);
+            AbortSink();
+            return MakeErrorResponse(ErrorCodeOutputFailed, FString::Printf(TEXT("Could not write '%s'"), *OutputFile));
+        }
+        Data->SetStringField(TEXT("outputFile"), OutputFile);
+        Data->SetNumberField(TEXT("bytes"), static_cast<double>(Bytes));
+    }
+    else if (Sink == EExportSink::Stream)
+    {
+        StreamArchive->Finish();
+        Data->SetNumberField(TEXT("bytes"), static_cast<double>(StreamArchive->TotalSize()));
+        Data->SetBoolField(ExportFormat == EExportFormat::Csv ? TEXT("csvStreamed") : TEXT("documentStreamed"), true);
+    }
+    else if (Csv)
+    {
+        const FUTF8ToTCHAR CsvText(reinterpret_cast<const ANSICHAR*>(InlineCsvBytes.GetData()), InlineCsvBytes.Num());
+        Data->SetStringField(TEXT("csv"), FString(CsvText.Length(), CsvText.Get()));
+    }
+
+    if (CacheArchive)
+    {
+        if (Sink == EExportSink::Response && ExportFormat == EExportFormat::Csv)
+        {
+            CacheArchive->Serialize(InlineCsvBytes.GetData(), InlineCsvBytes.Num());
+        }
+        else if (Sink == EExportSink::Response && ExportFormat == EExportFormat::Json)
+        {
+            // The inline tree is the document plus "ok"; the entry keeps the document a file would hold.
+            TSharedRef<FJsonObject> Document = MakeShared<FJsonObject>();
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Data->Values)
             {
-                Data->SetArrayField(TEXT("cameraCuts"), {});
+                if (Field.Key != TEXT("ok"))
+                {
+                    Document->SetField(Field.Key, Field.Value);
+                }
             }
+            TSharedRef<FUtf8ExportWriter> Writer = FUtf8ExportWriterFactory::Create(CacheArchive.Get());
+            FJsonSerializer::Serialize(Document, Writer);
         }
+        FSequenceExportCache::CommitStore(CacheKey, MoveTemp(CacheArchive), MakeCachedFields(*Data));
     }
 
-    if (ExportFormat == EExportFormat::Csv)
+    return MakeSuccessResponse(Data);
+}
+
+namespace
+{
+    /** Evaluated frames one sequence.evaluate_range call may ask for. */
+    constexpr int32 MaxEvaluatedFrames = 100000;
+
+    /** Frames times bindings one call may ask for, which bounds the response at about 150 MB. */
+    constexpr int32 MaxEvaluatedSamples = 4 * 1000 * 1000;
+
+    /** Frames evaluated between cancellation checks and progress reports. */
+    constexpr int32 EvaluateFramesPerReport = 256;
+
+    /** The world transform of a bound actor or scene component, or false for anything else. */
+    bool GetBoundWorldTransform(const TArray<UObject*>& BoundObjects, FTransform& OutTransform)
+    {
+        for (UObject* Bound : BoundObjects)
+        {
+            if (const AActor* Actor = Cast<AActor>(Bound))
+            {
+                if (Actor->GetRootComponent())
+                {
+                    OutTransform = Actor->GetActorTransform();
+                    return true;
+                }
+            }
+            else if (const USceneComponent* Component = Cast<USceneComponent>(Bound))
+            {
+                OutTransform = Component->GetComponentTransform();
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+TSharedPtr<FJsonObject> FSequenceExport::EvaluateRange(const TSharedPtr<FJsonObject>& Params)
+{
+    check(IsInGameThread());
+
+    if (!Params.IsValid())
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing parameters"));
+    }
+
+    FString SequencePath;
+    if (!Params->TryGetStringField(TEXT("sequencePath"), SequencePath))
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Missing sequencePath"));
+    }
+
+    const FString SequenceObjectPath = ResolveSequenceObjectPath(SequencePath);
+    if (SequenceObjectPath.IsEmpty())
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("Invalid sequencePath"));
+    }
+
+    ULevelSequence* LevelSequence = LoadObject<ULevelSequence>(nullptr, *SequenceObjectPath);
+    if (!LevelSequence)
+    {
+        return MakeErrorResponse(ErrorCodeSequenceNotFound, FString::Printf(TEXT("Sequence not found: %s"), *SequenceObjectPath));
+    }
+
+    UMovieScene* MovieScene = LevelSequence->GetMovieScene();
+    if (!MovieScene)
+    {
+        return MakeErrorResponse(ErrorCodeSequenceNotFound, TEXT("Sequence is missing MovieScene"));
+    }
+
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+    UWorld* World = GetEditorWorld();
+    if (!World || !World->PersistentLevel)
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("No editor world to evaluate in"));
+    }
+
+    // The range defaults to the playback range, as display frames.
+    FFrameRangeFilter FrameFilter;
+    FString FrameRangeError;
+    if (!ParseFrameRange(*MovieScene, Params, FrameFilter, FrameRangeError))
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, FrameRangeError);
+    }
+
+    const TRange<FFrameNumber> PlaybackRange = MovieScene->GetPlaybackRange();
+    int32 StartFrame = 0;
+    int32 EndFrame = 0;
+    if (FrameFilter.DisplayStart.IsSet())
+    {
+        StartFrame = FrameFilter.DisplayStart.GetValue();
+    }
+    else if (PlaybackRange.HasLowerBound())
+    {
+        StartFrame = ConvertTickFrameToDisplay(*MovieScene, PlaybackRange.GetLowerBoundValue());
+    }
+    if (FrameFilter.DisplayEnd.IsSet())
+    {
+        EndFrame = FrameFilter.DisplayEnd.GetValue();
+    }
+    else if (PlaybackRange.HasUpperBound())
     {
-        const FString CsvString = FString::Join(CsvLines, TEXT("\n"));
-        Data->SetStringField(TEXT("csv"), CsvString);
+        EndFrame = ConvertTickFrameToDisplay(*MovieScene, PlaybackRange.GetUpperBound().IsExclusive() ? PlaybackRange.GetUpperBoundValue() - 1 : PlaybackRange.GetUpperBoundValue());
     }
+    else
+    {
+        EndFrame = StartFrame;
+    }
+    if (EndFrame < StartFrame)
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("frameRange is empty"));
+    }
+
+    int32 Step = 1;
+    if (Params->HasField(TEXT("step")) && (!ParseIntField(Params, TEXT("step"), Step) || Step < 1))
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("step must be a positive integer"));
+    }
+
+    const int64 RequestedFrames = (static_cast<int64>(EndFrame) - StartFrame) / Step + 1;
+    if (RequestedFrames > MaxEvaluatedFrames)
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, FString::Printf(TEXT("%lld frames requested; at most %d can be evaluated at once (raise step or narrow frameRange)"), RequestedFrames, MaxEvaluatedFrames));
+    }
+    const int32 NumFrames = static_cast<int32>(RequestedFrames);
+
+    // Every root binding by default, or the ones named by bindingIds.
+    TSet<FString> RequestedIds;
+    const TArray<TSharedPtr<FJsonValue>>* BindingIdValues = nullptr;
+    if (Params->TryGetArrayField(TEXT("bindingIds"), BindingIdValues))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *BindingIdValues)
+        {
+            FGuid Guid;
+            FString IdString;
+            if (!Value.IsValid() || !Value->TryGetString(IdString) || !FGuid::Parse(IdString.TrimStartAndEnd(), Guid))
+            {
+                return MakeErrorResponse(ErrorCodeInvalidParameters, TEXT("bindingIds must be binding GUID strings"));
+            }
+            RequestedIds.Add(ToNormalizedBindingGuid(Guid));
+        }
+    }
+
+    TArray<FGuid> BindingGuids;
+    for (const FMovieSceneBinding& Binding : MovieScene->GetBindings())
+    {
+        if (RequestedIds.Num() == 0 || RequestedIds.Contains(ToNormalizedBindingGuid(Binding.GetObjectGuid())))
+        {
+            BindingGuids.Add(Binding.GetObjectGuid());
+        }
+    }
+    if (static_cast<int64>(NumFrames) * BindingGuids.Num() > MaxEvaluatedSamples)
+    {
+        return MakeErrorResponse(ErrorCodeInvalidParameters, FString::Printf(TEXT("%d frames of %d bindings requested; at most %d binding frames can be evaluated at once (raise step, narrow frameRange or pass bindingIds)"), NumFrames, BindingGuids.Num(), MaxEvaluatedSamples));
+    }
+
+    // Nine float columns per binding, binding-major; a frame the binding has nothing bound at is NaN.
+    constexpr int32 NumTransformColumns = 9;
+    TArray<int32> Frames;
+    Frames.Reserve(NumFrames);
+    TArray<TArray<float>> Values;
+    Values.SetNum(BindingGuids.Num() * NumTransformColumns);
+    for (TArray<float>& Column : Values)
+    {
+        Column.Reserve(NumFrames);
+    }
+
+    // A transient player evaluates the sequence against the editor world the way it would play at
+    // runtime, so attachment and spawnables are resolved, but with camera cuts off so no viewport is
+    // taken over. Stopping it restores everything the evaluation animated.
+    ULevelSequencePlayer* Player = NewObject<ULevelSequencePlayer>(GetTransientPackage());
+    FMovieSceneSequencePlaybackSettings PlaybackSettings;
+    PlaybackSettings.bDisableCameraCuts = true;
+    PlaybackSettings.bPauseAtEnd = true;
+    PlaybackSettings.FinishCompletionStateOverride = EMovieSceneCompletionModeOverride::ForceRestoreState;
+    Player->SetPlaybackSettings(PlaybackSettings);
+    Player->Initialize(LevelSequence, World->PersistentLevel, FLevelSequenceCameraSettings());
+    ON_SCOPE_EXIT
+    {
+        Player->Stop();
+        Player->TearDown();
+    };
 
+    for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+    {
+        if (FrameIndex % EvaluateFramesPerReport == 0)
+        {
+            if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
+            {
+                return MakeErrorResponse(ErrorCodeCancelled, FString::Printf(TEXT("Evaluation cancelled after %d of %d frames"), FrameIndex, NumFrames));
+            }
+            UnrealMCP::Protocol::FCommandContext::ReportActiveProgress(FrameIndex, NumFrames, TEXT("frames"));
+        }
+
+        const int32 DisplayFrame = StartFrame + FrameIndex * Step;
+        Player->SetPlaybackPosition(FMovieSceneSequencePlaybackParams(FFrameTime(DisplayFrame), EUpdatePositionMethod::Jump));
+        Frames.Add(DisplayFrame);
+
+        for (int32 BindingIndex = 0; BindingIndex < BindingGuids.Num(); ++BindingIndex)
+        {
+            FTransform Transform;
+            const bool bBound = GetBoundWorldTransform(Player->GetBoundObjects(UE::MovieScene::FRelativeObjectBindingID(BindingGuids[BindingIndex])), Transform);
+            const FVector Location = Transform.GetLocation();
+            const FRotator Rotation = Transform.Rotator();
+            const FVector Scale = Transform.GetScale3D();
+            // Rotation in the order of a transform track's channels: roll, pitch, yaw.
+            const double FrameValues[NumTransformColumns] = {
+                Location.X, Location.Y, Location.Z,
+                Rotation.Roll, Rotation.Pitch, Rotation.Yaw,
+                Scale.X, Scale.Y, Scale.Z};
+            for (int32 Column = 0; Column < NumTransformColumns; ++Column)
+            {
+                Values[BindingIndex * NumTransformColumns + Column].Add(bBound ? static_cast<float>(FrameValues[Column]) : std::numeric_limits<float>::quiet_NaN());
+            }
+        }
+    }
+
+    static const TCHAR* const TransformColumnNames[NumTransformColumns] = {
+        TEXT("location.x"), TEXT("location.y"), TEXT("location.z"),
+        TEXT("rotation.x"), TEXT("rotation.y"), TEXT("rotation.z"),
+        TEXT("scale.x"), TEXT("scale.y"), TEXT("scale.z")};
+
+    FColumnarWriter Columnar;
+    for (int32 BindingIndex = 0; BindingIndex < BindingGuids.Num(); ++BindingIndex)
+    {
+        FColumnarWriter::FSeries& Series = Columnar.BeginSeries(*MovieScene, TRange<FFrameNumber>::All(), ToNormalizedBindingGuid(BindingGuids[BindingIndex]), TEXT("WorldTransform"), FString(), FString());
+        Series.Frames = Frames;
+        for (int32 Column = 0; Column < NumTransformColumns; ++Column)
+        {
+            const TArray<float>& ColumnValues = Values[BindingIndex * NumTransformColumns + Column];
+            FColumnarWriter::AddColumn(Series, TransformColumnNames[Column], EColumnType::Float32).Data.Append(reinterpret_cast<const uint8*>(ColumnValues.GetData()), ColumnValues.Num() * sizeof(float));
+        }
+        Columnar.EndSeries();
+    }
+
+    TSharedRef<FJsonObject> Header = MakeShared<FJsonObject>();
+    Header->SetStringField(TEXT("format"), TEXT("columnar"));
+    Header->SetNumberField(TEXT("version"), 1);
+    Header->SetStringField(TEXT("keyMode"), TEXT("evaluatedWorld"));
+    {
+        TSharedRef<FJsonObject> SequenceJson = MakeShared<FJsonObject>();
+        SequenceJson->SetStringField(TEXT("assetPath"), SequenceObjectPath);
+        const FFrameRate DisplayRate = MovieScene->GetDisplayRate();
+        TArray<TSharedPtr<FJsonValue>> DisplayRateArray;
+        DisplayRateArray.Add(MakeShared<FJsonValueNumber>(DisplayRate.Numerator));
+        DisplayRateArray.Add(MakeShared<FJsonValueNumber>(DisplayRate.Denominator));
+        SequenceJson->SetArrayField(TEXT("displayRate"), DisplayRateArray);
+        SequenceJson->SetNumberField(TEXT("start"), StartFrame);
+        SequenceJson->SetNumberField(TEXT("end"), EndFrame);
+        SequenceJson->SetNumberField(TEXT("step"), Step);
+        Header->SetObjectField(TEXT("sequence"), SequenceJson);
+    }
+
+    TArray<uint8> ColumnarBytes = EncodeColumnar(Columnar, Header);
+    TSharedRef<FJsonObject> Data = MakeShared<FJsonObject>();
+    Data->SetBoolField(TEXT("ok"), true);
+    Data->SetNumberField(TEXT("bindings"), BindingGuids.Num());
+    Data->SetNumberField(TEXT("frames"), NumFrames);
+    Data->SetNumberField(TEXT("bytes"), ColumnarBytes.Num());
+    if (Context && Context->CanAttach())
+    {
+        Data->SetObjectField(TEXT("columnar"), Context->Attach(MoveTemp(ColumnarBytes)));
+    }
+    else
+    {
+        Data->SetStringField(TEXT("columnar"), FBase64::Encode(ColumnarBytes));
+    }
     return MakeSuccessResponse(Data);
 }
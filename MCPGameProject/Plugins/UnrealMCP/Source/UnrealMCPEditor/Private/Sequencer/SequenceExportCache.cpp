@@ -0,0 +1,224 @@
+#include "Sequencer/SequenceExportCache.h"
+#include "CoreMinimal.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "IO/IoHash.h"
+#include "LevelSequence.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "MovieScene.h"
+#include "MovieSceneSequence.h"
+#include "Sections/MovieSceneSubSection.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Tracks/MovieSceneSubTrack.h"
+#include "UObject/Package.h"
+#include "UnrealMCPLog.h"
+
+namespace
+{
+    /** Bumped whenever what an export writes changes, so entries from an older plugin are never served. */
+    constexpr int32 CacheFormatVersion = 1;
+
+    FString GetCacheDir()
+    {
+        return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP"), TEXT("SequenceExportCache"));
+    }
+
+    FString GetBodyPath(const FString& Key)
+    {
+        return FPaths::Combine(GetCacheDir(), Key + TEXT(".bin"));
+    }
+
+    FString GetFieldsPath(const FString& Key)
+    {
+        return FPaths::Combine(GetCacheDir(), Key + TEXT(".json"));
+    }
+
+    /** Sequence and every sequence its sub and shot tracks reach, each once. */
+    void GatherSequences(UMovieSceneSequence* Sequence, TArray<UMovieSceneSequence*>& OutSequences)
+    {
+        if (!Sequence || OutSequences.Contains(Sequence))
+        {
+            return;
+        }
+        OutSequences.Add(Sequence);
+
+        UMovieScene* MovieScene = Sequence->GetMovieScene();
+        if (!MovieScene)
+        {
+            return;
+        }
+
+        for (UMovieSceneTrack* Track : MovieScene->GetTracks())
+        {
+            if (UMovieSceneSubTrack* SubTrack = Cast<UMovieSceneSubTrack>(Track))
+            {
+                for (UMovieSceneSection* Section : SubTrack->GetAllSections())
+                {
+                    if (UMovieSceneSubSection* SubSection = Cast<UMovieSceneSubSection>(Section))
+                    {
+                        GatherSequences(SubSection->GetSequence(), OutSequences);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * What identifies the saved contents of Package: the hash recorded when it was saved or loaded,
+     * else the file's timestamp and size. False for a package with unsaved changes or no file.
+     */
+    bool GetSavedState(const UPackage& Package, FString& OutState)
+    {
+        if (Package.IsDirty())
+        {
+            return false;
+        }
+
+#if WITH_EDITORONLY_DATA
+        const FIoHash& SavedHash = Package.GetSavedHash();
+        if (!SavedHash.IsZero())
+        {
+            OutState = LexToString(SavedHash);
+            return true;
+        }
+#endif
+
+        FString Filename;
+        if (!FPackageName::DoesPackageExist(Package.GetName(), &Filename))
+        {
+            return false;
+        }
+
+        const FFileStatData StatData = IFileManager::Get().GetStatData(*Filename);
+        if (!StatData.bIsValid)
+        {
+            return false;
+        }
+        OutState = FString::Printf(TEXT("%lld:%lld"), StatData.ModificationTime.GetTicks(), StatData.FileSize);
+        return true;
+    }
+
+    /** Deletes the least recently written entries until at most MaxEntries remain. */
+    void PruneEntries(int32 MaxEntries)
+    {
+        TArray<TPair<FDateTime, FString>> Entries;
+        IFileManager::Get().IterateDirectoryStat(*GetCacheDir(), [&Entries](const TCHAR* Filename, const FFileStatData& StatData)
+        {
+            if (!StatData.bIsDirectory && FPaths::GetExtension(Filename) == TEXT("json"))
+            {
+                Entries.Emplace(StatData.ModificationTime, FPaths::GetBaseFilename(Filename));
+            }
+            return true;
+        });
+
+        if (Entries.Num() <= MaxEntries)
+        {
+            return;
+        }
+
+        Entries.Sort([](const TPair<FDateTime, FString>& A, const TPair<FDateTime, FString>& B) { return A.Key < B.Key; });
+        for (int32 Index = 0; Index < Entries.Num() - MaxEntries; ++Index)
+        {
+            IFileManager::Get().Delete(*GetFieldsPath(Entries[Index].Value), /*RequireExists=*/false, /*EvenReadOnly=*/true, /*Quiet=*/true);
+            IFileManager::Get().Delete(*GetBodyPath(Entries[Index].Value), /*RequireExists=*/false, /*EvenReadOnly=*/true, /*Quiet=*/true);
+        }
+    }
+}
+
+bool FSequenceExportCache::MakeKey(ULevelSequence& Sequence, const FString& Options, FString& OutKey)
+{
+    check(IsInGameThread());
+
+    TArray<UMovieSceneSequence*> Sequences;
+    GatherSequences(&Sequence, Sequences);
+
+    TArray<FString> PackageStates;
+    for (UMovieSceneSequence* Reached : Sequences)
+    {
+        const UPackage* Package = Reached->GetPackage();
+        FString State;
+        if (!Package || !GetSavedState(*Package, State))
+        {
+            return false;
+        }
+        PackageStates.AddUnique(Package->GetName() + TEXT("=") + State);
+    }
+    PackageStates.Sort();
+
+    const FString Source = FString::Printf(TEXT("v%d\n%s\n%s\n%s"), CacheFormatVersion, *Sequence.GetPathName(), *Options, *FString::Join(PackageStates, TEXT("\n")));
+    const FTCHARToUTF8 Utf8Source(*Source);
+    FSHAHash Hash;
+    FSHA1::HashBuffer(Utf8Source.Get(), Utf8Source.Length(), Hash.Hash);
+    OutKey = Hash.ToString();
+    return true;
+}
+
+bool FSequenceExportCache::Find(const FString& Key, FString& OutBodyFile, TSharedPtr<FJsonObject>& OutFields)
+{
+    FString FieldsText;
+    if (!FFileHelper::LoadFileToString(FieldsText, *GetFieldsPath(Key)))
+    {
+        return false;
+    }
+
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FieldsText);
+    TSharedPtr<FJsonObject> Fields;
+    if (!FJsonSerializer::Deserialize(Reader, Fields) || !Fields.IsValid())
+    {
+        return false;
+    }
+
+    const FString BodyFile = GetBodyPath(Key);
+    if (!IFileManager::Get().FileExists(*BodyFile))
+    {
+        return false;
+    }
+
+    OutBodyFile = BodyFile;
+    OutFields = Fields;
+    return true;
+}
+
+TUniquePtr<FArchive> FSequenceExportCache::BeginStore(const FString& Key)
+{
+    // Written beside the entry and moved into place by CommitStore, so a reader never sees half a body.
+    return TUniquePtr<FArchive>(IFileManager::Get().CreateFileWriter(*(GetBodyPath(Key) + TEXT(".partial"))));
+}
+
+bool FSequenceExportCache::CommitStore(const FString& Key, TUniquePtr<FArchive> Writer, const TSharedRef<FJsonObject>& Fields)
+{
+    const FString BodyFile = GetBodyPath(Key);
+    const FString PartialFile = BodyFile + TEXT(".partial");
+    const bool bWritten = Writer && Writer->Close() && !Writer->IsError();
+    Writer.Reset();
+
+    FString FieldsText;
+    TSharedRef<TJsonWriter<>> FieldsWriter = TJsonWriterFactory<>::Create(&FieldsText);
+    if (!bWritten || !FJsonSerializer::Serialize(Fields, FieldsWriter)
+        || !IFileManager::Get().Move(*BodyFile, *PartialFile, /*Replace=*/true)
+        || !FFileHelper::SaveStringToFile(FieldsText, *GetFieldsPath(Key), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("FSequenceExportCache: Could not store entry %s"), *Key);
+        IFileManager::Get().Delete(*PartialFile, /*RequireExists=*/false, /*EvenReadOnly=*/true, /*Quiet=*/true);
+        IFileManager::Get().Delete(*BodyFile, /*RequireExists=*/false, /*EvenReadOnly=*/true, /*Quiet=*/true);
+        return false;
+    }
+
+    PruneEntries(MaxEntries);
+    return true;
+}
+
+void FSequenceExportCache::AbandonStore(const FString& Key, TUniquePtr<FArchive> Writer)
+{
+    if (Writer)
+    {
+        Writer->Close();
+        Writer.Reset();
+    }
+    IFileManager::Get().Delete(*(GetBodyPath(Key) + TEXT(".partial")), /*RequireExists=*/false, /*EvenReadOnly=*/true, /*Quiet=*/true);
+}
@@ -1,6 +1,7 @@
 #include "Sequencer/SequenceTools.h"
 #include "CoreMinimal.h"
 
+#include "Actors/ActorIndex.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetRegistry/IAssetRegistry.h"
 #include "AssetToolsModule.h"
@@ -218,18 +219,7 @@ namespace
             return DirectActor;
         }
 
-        if (UWorld* World = GetEditorWorld())
-        {
-            for (TActorIterator<AActor> It(World); It; ++It)
-            {
-                if (It->GetPathName() == Trimmed || It->GetName() == Trimmed)
-                {
-                    return *It;
-                }
-            }
-        }
-
-        return nullptr;
+        return FActorIndex::Get().Resolve(GetEditorWorld(), Trimmed);
     }
 
     enum class EMarkForAddResult
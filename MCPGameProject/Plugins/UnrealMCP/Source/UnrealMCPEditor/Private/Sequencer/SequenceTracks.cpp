@@ -1,10 +1,12 @@
 #include "Sequencer/SequenceTracks.h"
 #include "CoreMinimal.h"
 
+#include "Algo/StableSort.h"
 #include "Channels/MovieSceneBoolChannel.h"
 #include "Channels/MovieSceneByteChannel.h"
 #include "Channels/MovieSceneFloatChannel.h"
 #include "Channels/MovieSceneIntegerChannel.h"
+#include "Commands/PropertyPathCache.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "EditorAssetLibrary.h"
@@ -358,6 +360,42 @@ namespace
         return nullptr;
     }
 
+    /**
+     * Fills an empty curve channel with cubic auto-tangent keys in one Set and computes the tangents
+     * once afterwards, instead of a sorted insert per key. Times must already be sorted.
+     */
+    void SetCubicKeys(FMovieSceneFloatChannel& Channel, TConstArrayView<FFrameNumber> Times, TConstArrayView<float> Values)
+    {
+        if (Times.Num() == 0)
+        {
+            return;
+        }
+
+        TArray<FMovieSceneFloatValue> KeyValues;
+        KeyValues.Reserve(Values.Num());
+        for (const float Value : Values)
+        {
+            FMovieSceneFloatValue& KeyValue = KeyValues.Emplace_GetRef(Value);
+            KeyValue.InterpMode = RCIM_Cubic;
+            KeyValue.TangentMode = RCTM_Auto;
+        }
+
+        Channel.Set(TArray<FFrameNumber>(Times), MoveTemp(KeyValues));
+        Channel.AutoSetTangents();
+    }
+
+    /** Fills an empty bool, integer or byte channel. Times must already be sorted, so every key appends. */
+    template <typename ChannelType, typename ValueType>
+    void SetDiscreteKeys(ChannelType& Channel, const TArray<FFrameNumber>& Times, const TArray<ValueType>& Values)
+    {
+        auto ChannelData = Channel.GetData();
+        ChannelData.Reset();
+        for (int32 Index = 0; Index < Times.Num(); ++Index)
+        {
+            ChannelData.AddKey(Times[Index], Values[Index]);
+        }
+    }
+
     struct FTransformKey
     {
         FFrameNumber Frame;
@@ -488,8 +526,11 @@ namespace
 
         TransformSection->SetMask(EMovieSceneTransformChannel::All);
 
-        FFrameNumber MinFrame = Keys[0].Frame;
-        FFrameNumber MaxFrame = Keys[0].Frame;
+        // Keys are sorted once and each channel is filled in bulk, so a capture with tens of
+        // thousands of keys costs a sort and a copy rather than a sorted insert per key.
+        Algo::StableSortBy(Keys, &FTransformKey::Frame);
+        const FFrameNumber MinFrame = Keys[0].Frame;
+        const FFrameNumber MaxFrame = Keys.Last().Frame;
 
         FMovieSceneFloatChannel& TranslationX = TransformSection->GetTranslationChannel(EAxis::X);
         FMovieSceneFloatChannel& TranslationY = TransformSection->GetTranslationChannel(EAxis::Y);
@@ -501,33 +542,49 @@ namespace
         FMovieSceneFloatChannel& ScaleY = TransformSection->GetScaleChannel(EAxis::Y);
         FMovieSceneFloatChannel& ScaleZ = TransformSection->GetScaleChannel(EAxis::Z);
 
+        TArray<FFrameNumber> LocationTimes;
+        TArray<FFrameNumber> RotationTimes;
+        TArray<FFrameNumber> ScaleTimes;
+        TArray<float> LocationValues[3];
+        TArray<float> RotationValues[3];
+        TArray<float> ScaleValues[3];
         for (const FTransformKey& Key : Keys)
         {
-            MinFrame = FMath::Min(MinFrame, Key.Frame);
-            MaxFrame = FMath::Max(MaxFrame, Key.Frame);
-
             if (Key.bHasLocation)
             {
-                TranslationX.AddCubicKey(Key.Frame, Key.Location.X);
-                TranslationY.AddCubicKey(Key.Frame, Key.Location.Y);
-                TranslationZ.AddCubicKey(Key.Frame, Key.Location.Z);
+                LocationTimes.Add(Key.Frame);
+                LocationValues[0].Add(Key.Location.X);
+                LocationValues[1].Add(Key.Location.Y);
+                LocationValues[2].Add(Key.Location.Z);
             }
 
             if (Key.bHasRotation)
             {
-                RotationX.AddCubicKey(Key.Frame, Key.Rotation.Roll);
-                RotationY.AddCubicKey(Key.Frame, Key.Rotation.Pitch);
-                RotationZ.AddCubicKey(Key.Frame, Key.Rotation.Yaw);
+                RotationTimes.Add(Key.Frame);
+                RotationValues[0].Add(Key.Rotation.Roll);
+                RotationValues[1].Add(Key.Rotation.Pitch);
+                RotationValues[2].Add(Key.Rotation.Yaw);
             }
 
             if (Key.bHasScale)
             {
-                ScaleX.AddCubicKey(Key.Frame, Key.Scale.X);
-                ScaleY.AddCubicKey(Key.Frame, Key.Scale.Y);
-                ScaleZ.AddCubicKey(Key.Frame, Key.Scale.Z);
+                ScaleTimes.Add(Key.Frame);
+                ScaleValues[0].Add(Key.Scale.X);
+                ScaleValues[1].Add(Key.Scale.Y);
+                ScaleValues[2].Add(Key.Scale.Z);
             }
         }
 
+        SetCubicKeys(TranslationX, LocationTimes, LocationValues[0]);
+        SetCubicKeys(TranslationY, LocationTimes, LocationValues[1]);
+        SetCubicKeys(TranslationZ, LocationTimes, LocationValues[2]);
+        SetCubicKeys(RotationX, RotationTimes, RotationValues[0]);
+        SetCubicKeys(RotationY, RotationTimes, RotationValues[1]);
+        SetCubicKeys(RotationZ, RotationTimes, RotationValues[2]);
+        SetCubicKeys(ScaleX, ScaleTimes, ScaleValues[0]);
+        SetCubicKeys(ScaleY, ScaleTimes, ScaleValues[1]);
+        SetCubicKeys(ScaleZ, ScaleTimes, ScaleValues[2]);
+
         const TRange<FFrameNumber> Range = TRange<FFrameNumber>::Inclusive(MinFrame, MaxFrame);
         TransformSection->SetRange(Range);
         Track->AddSection(*TransformSection);
@@ -589,9 +646,8 @@ namespace
 
         FMovieSceneBoolChannel& Channel = BoolSection->GetChannel();
 
-        FFrameNumber MinFrame = TNumericLimits<int32>::Max();
-        FFrameNumber MaxFrame = TNumericLimits<int32>::Lowest();
-
+        TArray<TPair<FFrameNumber, bool>> VisibilityKeys;
+        VisibilityKeys.Reserve(KeysArray.Num());
         for (const TSharedPtr<FJsonValue>& Value : KeysArray)
         {
             if (!Value.IsValid() || Value->Type != EJson::Object)
@@ -618,13 +674,22 @@ namespace
                 return false;
             }
 
-            const FFrameNumber KeyFrame = ConvertDisplayFrameToTick(MovieScene, Frame);
-            MinFrame = FMath::Min(MinFrame, KeyFrame);
-            MaxFrame = FMath::Max(MaxFrame, KeyFrame);
-            Channel.AddKey(KeyFrame, bVisible);
+            VisibilityKeys.Emplace(ConvertDisplayFrameToTick(MovieScene, Frame), bVisible);
         }
 
-        const TRange<FFrameNumber> Range = TRange<FFrameNumber>::Inclusive(MinFrame, MaxFrame);
+        Algo::StableSortBy(VisibilityKeys, [](const TPair<FFrameNumber, bool>& Key) { return Key.Key; });
+        TArray<FFrameNumber> Times;
+        TArray<bool> Values;
+        Times.Reserve(VisibilityKeys.Num());
+        Values.Reserve(VisibilityKeys.Num());
+        for (const TPair<FFrameNumber, bool>& Key : VisibilityKeys)
+        {
+            Times.Add(Key.Key);
+            Values.Add(Key.Value);
+        }
+        SetDiscreteKeys(Channel, Times, Values);
+
+        const TRange<FFrameNumber> Range = TRange<FFrameNumber>::Inclusive(Times[0], Times.Last());
         BoolSection->SetRange(Range);
         Track->AddSection(*BoolSection);
 
@@ -871,8 +936,20 @@ namespace
             return false;
         }
 
-        FTrackInstancePropertyBindings PropertyBindings(*PropertyNameString, PropertyPath);
-        if (FProperty* ResolvedProperty = PropertyBindings.ResolveProperty(SampleObject))
+        // Plain and struct-field paths come from the shared cache; paths through object
+        // references or array elements still take the full binding walk.
+        FString CacheError;
+        FProperty* ResolvedProperty = nullptr;
+        if (const FPropertyPathCache::FCompiledPath* Cached = FPropertyPathCache::Get().Resolve(SampleObject->GetClass(), PropertyPath, CacheError))
+        {
+            ResolvedProperty = const_cast<FProperty*>(Cached->Leaf);
+        }
+        else
+        {
+            FTrackInstancePropertyBindings PropertyBindings(*PropertyNameString, PropertyPath);
+            ResolvedProperty = PropertyBindings.ResolveProperty(SampleObject);
+        }
+        if (ResolvedProperty)
         {
             OutProperty.PropertyPath = PropertyPath;
             OutProperty.PropertyName = FName(*PropertyNameString);
@@ -1007,8 +1084,16 @@ namespace
             return false;
         }
 
-        FFrameNumber MinFrame = Keys[0].Frame;
-        FFrameNumber MaxFrame = Keys[0].Frame;
+        // Sorted once so each channel below is filled in bulk, as for transform tracks.
+        Algo::StableSortBy(Keys, &FPropertyKey::Frame);
+        const FFrameNumber MinFrame = Keys[0].Frame;
+        const FFrameNumber MaxFrame = Keys.Last().Frame;
+        TArray<FFrameNumber> Times;
+        Times.Reserve(Keys.Num());
+        for (const FPropertyKey& Key : Keys)
+        {
+            Times.Add(Key.Frame);
+        }
 
         if (ResolvedProperty.Kind == EPropertyTrackKind::Bool)
         {
@@ -1020,13 +1105,13 @@ namespace
                 return false;
             }
 
-            FMovieSceneBoolChannel& Channel = BoolSection->GetChannel();
+            TArray<bool> Values;
+            Values.Reserve(Keys.Num());
             for (const FPropertyKey& Key : Keys)
             {
-                MinFrame = FMath::Min(MinFrame, Key.Frame);
-                MaxFrame = FMath::Max(MaxFrame, Key.Frame);
-                Channel.AddKey(Key.Frame, Key.bBoolValue);
+                Values.Add(Key.bBoolValue);
             }
+            SetDiscreteKeys(BoolSection->GetChannel(), Times, Values);
 
             BoolSection->SetRange(TRange<FFrameNumber>::Inclusive(MinFrame, MaxFrame));
             PropertyTrack->AddSection(*BoolSection);
@@ -1041,13 +1126,13 @@ namespace
                 return false;
             }
 
-            FMovieSceneFloatChannel& Channel = FloatSection->GetChannel();
+            TArray<float> Values;
+            Values.Reserve(Keys.Num());
             for (const FPropertyKey& Key : Keys)
             {
-                MinFrame = FMath::Min(MinFrame, Key.Frame);
-                MaxFrame = FMath::Max(MaxFrame, Key.Frame);
-                Channel.AddCubicKey(Key.Frame, static_cast<float>(Key.NumericValue));
+                Values.Add(static_cast<float>(Key.NumericValue));
             }
+            SetCubicKeys(FloatSection->GetChannel(), Times, Values);
 
             FloatSection->SetRange(TRange<FFrameNumber>::Inclusive(MinFrame, MaxFrame));
             PropertyTrack->AddSection(*FloatSection);
@@ -1062,7 +1147,8 @@ namespace
                 return false;
             }
 
-            FMovieSceneIntegerChannel& Channel = IntegerSection->GetChannel();
+            TArray<int32> Values;
+            Values.Reserve(Keys.Num());
             for (const FPropertyKey& Key : Keys)
             {
                 if (!Key.IntegerValue.IsSet())
@@ -1072,10 +1158,9 @@ namespace
                     return false;
                 }
 
-                MinFrame = FMath::Min(MinFrame, Key.Frame);
-                MaxFrame = FMath::Max(MaxFrame, Key.Frame);
-                Channel.AddKey(Key.Frame, Key.IntegerValue.GetValue());
+                Values.Add(Key.IntegerValue.GetValue());
             }
+            SetDiscreteKeys(IntegerSection->GetChannel(), Times, Values);
 
             IntegerSection->SetRange(TRange<FFrameNumber>::Inclusive(MinFrame, MaxFrame));
             PropertyTrack->AddSection(*IntegerSection);
@@ -1090,7 +1175,8 @@ namespace
                 return false;
             }
 
-            FMovieSceneByteChannel& Channel = ByteSection->GetChannel();
+            TArray<uint8> Values;
+            Values.Reserve(Keys.Num());
             for (const FPropertyKey& Key : Keys)
             {
                 if (!Key.ByteValue.IsSet())
@@ -1100,10 +1186,9 @@ namespace
                     return false;
                 }
 
-                MinFrame = FMath::Min(MinFrame, Key.Frame);
-                MaxFrame = FMath::Max(MaxFrame, Key.Frame);
-                Channel.AddKey(Key.Frame, Key.ByteValue.GetValue());
+                Values.Add(Key.ByteValue.GetValue());
             }
+            SetDiscreteKeys(ByteSection->GetChannel(), Times, Values);
 
             ByteSection->SetRange(TRange<FFrameNumber>::Inclusive(MinFrame, MaxFrame));
             PropertyTrack->AddSection(*ByteSection);
@@ -1118,11 +1203,7 @@ namespace
                 return false;
             }
 
-            FMovieSceneFloatChannel& R = ColorSection->GetRedChannel();
-            FMovieSceneFloatChannel& G = ColorSection->GetGreenChannel();
-            FMovieSceneFloatChannel& B = ColorSection->GetBlueChannel();
-            FMovieSceneFloatChannel& A = ColorSection->GetAlphaChannel();
-
+            TArray<float> Values[4];
             for (const FPropertyKey& Key : Keys)
             {
                 if (!Key.ColorValue.IsSet())
@@ -1133,14 +1214,17 @@ namespace
                 }
 
                 const FLinearColor Color = Key.ColorValue.GetValue();
-                MinFrame = FMath::Min(MinFrame, Key.Frame);
-                MaxFrame = FMath::Max(MaxFrame, Key.Frame);
-                R.AddCubicKey(Key.Frame, Color.R);
-                G.AddCubicKey(Key.Frame, Color.G);
-                B.AddCubicKey(Key.Frame, Color.B);
-                A.AddCubicKey(Key.Frame, Color.A);
+                Values[0].Add(Color.R);
+                Values[1].Add(Color.G);
+                Values[2].Add(Color.B);
+                Values[3].Add(Color.A);
             }
 
+            SetCubicKeys(ColorSection->GetRedChannel(), Times, Values[0]);
+            SetCubicKeys(ColorSection->GetGreenChannel(), Times, Values[1]);
+            SetCubicKeys(ColorSection->GetBlueChannel(), Times, Values[2]);
+            SetCubicKeys(ColorSection->GetAlphaChannel(), Times, Values[3]);
+
             ColorSection->SetRange(TRange<FFrameNumber>::Inclusive(MinFrame, MaxFrame));
             PropertyTrack->AddSection(*ColorSection);
         }
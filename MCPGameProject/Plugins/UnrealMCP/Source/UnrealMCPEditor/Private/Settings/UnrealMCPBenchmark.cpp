@@ -0,0 +1,542 @@
+#include "Settings/UnrealMCPDiagnostics.h"
+#include "CoreMinimal.h"
+
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+#include "Observability/JsonLogger.h"
+#include "Observability/MetricsRegistry.h"
+#include "RHI.h"
+#include "RenderCore.h"
+#include "UnrealMCPLog.h"
+#include "UnrealMCPSettings.h"
+
+#include <atomic>
+
+namespace
+{
+        /** The engine's hitch threshold when t.HitchFrameTimeThreshold is not registered. */
+        constexpr double DefaultHitchFrameMs = 60.0;
+
+        const TCHAR* const SupportedCommands[] = { TEXT("ping"), TEXT("asset.find"), TEXT("asset.exists"), TEXT("get_actors_in_level") };
+
+        bool IsSupportedCommand(const FString& Command)
+        {
+                for (const TCHAR* Supported : SupportedCommands)
+                {
+                        if (Command.Equals(Supported, ESearchCase::CaseSensitive))
+                        {
+                                return true;
+                        }
+                }
+                return false;
+        }
+
+        /** Fixed params per command, so runs on different machines ask for the same work. */
+        TSharedPtr<FJsonObject> MakeParams(const FString& Command)
+        {
+                if (Command == TEXT("asset.find"))
+                {
+                        TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+                        Params->SetArrayField(TEXT("paths"), { MakeShared<FJsonValueString>(TEXT("/Game")) });
+                        Params->SetNumberField(TEXT("limit"), 50);
+                        return Params;
+                }
+                if (Command == TEXT("asset.exists"))
+                {
+                        TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+                        Params->SetStringField(TEXT("objectPath"), TEXT("/Engine/BasicShapes/Cube.Cube"));
+                        return Params;
+                }
+                if (Command == TEXT("get_actors_in_level"))
+                {
+                        return MakeShared<FJsonObject>();
+                }
+                return nullptr;
+        }
+
+        FString FormatLatency(const FLatencyHistogram& Histogram)
+        {
+                return FString::Printf(TEXT("p50 %.2f ms, p99 %.2f ms, max %.2f ms"),
+                        Histogram.GetPercentileMs(0.50), Histogram.GetPercentileMs(0.99), Histogram.GetMaxMs());
+        }
+
+        FString FormatFrames(const FLatencyHistogram& Histogram)
+        {
+                const double AverageMs = Histogram.GetCount() > 0 ? Histogram.GetSumMs() / static_cast<double>(Histogram.GetCount()) : 0.0;
+                return FString::Printf(TEXT("avg %.2f ms, p99 %.2f ms, max %.2f ms"), AverageMs, Histogram.GetPercentileMs(0.99), Histogram.GetMaxMs());
+        }
+
+        TSharedPtr<FJsonObject> HistogramToJson(const FLatencyHistogram& Histogram)
+        {
+                TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+                Result->SetNumberField(TEXT("count"), static_cast<double>(Histogram.GetCount()));
+                Result->SetNumberField(TEXT("avgMs"), Histogram.GetCount() > 0 ? Histogram.GetSumMs() / static_cast<double>(Histogram.GetCount()) : 0.0);
+                Result->SetNumberField(TEXT("p50Ms"), Histogram.GetPercentileMs(0.50));
+                Result->SetNumberField(TEXT("p90Ms"), Histogram.GetPercentileMs(0.90));
+                Result->SetNumberField(TEXT("p99Ms"), Histogram.GetPercentileMs(0.99));
+                Result->SetNumberField(TEXT("maxMs"), Histogram.GetMaxMs());
+                return Result;
+        }
+
+        double GetHitchFrameMs()
+        {
+                const IConsoleVariable* Threshold = IConsoleManager::Get().FindConsoleVariable(TEXT("t.HitchFrameTimeThreshold"));
+                const double Ms = Threshold ? Threshold->GetFloat() : 0.0;
+                return Ms > 0.0 ? Ms : DefaultHitchFrameMs;
+        }
+
+        /**
+         * Frame times of one phase, as stat unit sees them: the whole frame, the game and render
+         * threads' work and the GPU's, all from the previous frame's counters. McpGameThreadShare is
+         * the part of the phase's wall time the game thread spent inside MCP command slices.
+         */
+        struct FFrameSamples
+        {
+                FLatencyHistogram Frame;
+                FLatencyHistogram GameThread;
+                FLatencyHistogram RenderThread;
+                FLatencyHistogram Gpu;
+                int32 Hitches = 0;
+                double StartSeconds = 0.0;
+                double EndSeconds = 0.0;
+                double McpStartSeconds = 0.0;
+                double McpEndSeconds = 0.0;
+
+                void Begin(double Now)
+                {
+                        StartSeconds = Now;
+                        McpStartSeconds = FMetricsRegistry::GetGameThreadSeconds();
+                }
+
+                void End(double Now)
+                {
+                        EndSeconds = Now;
+                        McpEndSeconds = FMetricsRegistry::GetGameThreadSeconds();
+                }
+
+                void Record(double HitchFrameMs)
+                {
+                        const double FrameMs = FApp::GetDeltaTime() * 1000.0;
+                        Frame.Record(FrameMs);
+                        GameThread.Record(FPlatformTime::ToMilliseconds(GGameThreadTime));
+                        RenderThread.Record(FPlatformTime::ToMilliseconds(GRenderThreadTime));
+                        // Zero when the RHI has no GPU timing; those frames are left out rather than counted as free.
+                        const uint32 GpuCycles = RHIGetGPUFrameCycles();
+                        if (GpuCycles > 0)
+                        {
+                                Gpu.Record(FPlatformTime::ToMilliseconds(GpuCycles));
+                        }
+                        if (FrameMs >= HitchFrameMs)
+                        {
+                                ++Hitches;
+                        }
+                }
+
+                double GetSeconds() const
+                {
+                        return FMath::Max(EndSeconds - StartSeconds, 0.001);
+                }
+
+                double GetMcpGameThreadShare() const
+                {
+                        return FMath::Clamp((McpEndSeconds - McpStartSeconds) / GetSeconds(), 0.0, 1.0);
+                }
+
+                TSharedPtr<FJsonObject> ToJson() const
+                {
+                        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+                        Result->SetNumberField(TEXT("seconds"), GetSeconds());
+                        Result->SetObjectField(TEXT("frame"), HistogramToJson(Frame));
+                        Result->SetObjectField(TEXT("gameThread"), HistogramToJson(GameThread));
+                        Result->SetObjectField(TEXT("renderThread"), HistogramToJson(RenderThread));
+                        Result->SetObjectField(TEXT("gpu"), HistogramToJson(Gpu));
+                        Result->SetNumberField(TEXT("hitches"), Hitches);
+                        Result->SetNumberField(TEXT("hitchesPerMinute"), Hitches * 60.0 / GetSeconds());
+                        Result->SetNumberField(TEXT("mcpGameThreadShare"), GetMcpGameThreadShare());
+                        return Result;
+                }
+
+                FString Format(const TCHAR* Label) const
+                {
+                        FString Line = FString::Printf(TEXT("%s: frame %s; game thread p50 %.2f / p99 %.2f ms; render thread p50 %.2f / p99 %.2f ms"),
+                                Label, *FormatFrames(Frame), GameThread.GetPercentileMs(0.50), GameThread.GetPercentileMs(0.99),
+                                RenderThread.GetPercentileMs(0.50), RenderThread.GetPercentileMs(0.99));
+                        if (Gpu.GetCount() > 0)
+                        {
+                                Line += FString::Printf(TEXT("; GPU p50 %.2f / p99 %.2f ms"), Gpu.GetPercentileMs(0.50), Gpu.GetPercentileMs(0.99));
+                        }
+                        Line += FString::Printf(TEXT("; %d hitch(es); MCP %.1f%% of the game thread"), Hitches, GetMcpGameThreadShare() * 100.0);
+                        return Line;
+                }
+        };
+
+        /** The last finished run's JSON report. Game thread only. */
+        TSharedPtr<FJsonObject> GLastReport;
+}
+
+/**
+ * One benchmark run. Each client connection runs on its own thread and keeps one request
+ * outstanding (a closed loop), so throughput is what the editor sustains, not what was offered.
+ * The game thread samples frame times through a core ticker and drives the phases: idle
+ * baseline, load, then draining until every connection has stopped.
+ */
+class FUnrealMCPDiagnostics::FBenchmarkRun : public TSharedFromThis<FBenchmarkRun, ESPMode::ThreadSafe>
+{
+public:
+        FBenchmarkRun(const FUnrealMCPBenchmarkOptions& InOptions, FBenchmarkComplete InOnComplete)
+                : Options(InOptions)
+                , OnComplete(MoveTemp(InOnComplete))
+                , Phase(EPhase::Baseline)
+                , PhaseStartSeconds(0.0)
+                , LoadStartSeconds(0.0)
+                , LoadEndSeconds(0.0)
+                , bStop(false)
+                , WorkersLeft(0)
+        {
+                for (const TPair<FString, int32>& Entry : Options.Mix)
+                {
+                        TotalWeight += Entry.Value;
+                }
+        }
+
+        void Start()
+        {
+                check(IsInGameThread());
+                PhaseStartSeconds = FPlatformTime::Seconds();
+                HitchFrameMs = GetHitchFrameMs();
+                Idle.Begin(PhaseStartSeconds);
+                FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FBenchmarkRun::Tick));
+        }
+
+        static TSharedPtr<FBenchmarkRun, ESPMode::ThreadSafe> Active;
+
+private:
+        enum class EPhase : uint8
+        {
+                Baseline,
+                Load,
+                Draining,
+        };
+
+        /** Written only by its own connection thread until WorkersLeft reaches zero. */
+        struct FWorkerResult
+        {
+                FLatencyHistogram All;
+                TMap<FString, FLatencyHistogram> PerCommand;
+                TMap<FString, int32> ErrorCodes;
+                int64 Errors = 0;
+                FString FatalError;
+        };
+
+        bool Tick(float DeltaTime)
+        {
+                const double Now = FPlatformTime::Seconds();
+
+                switch (Phase)
+                {
+                case EPhase::Baseline:
+                        Idle.Record(HitchFrameMs);
+                        if (Now - PhaseStartSeconds >= Options.BaselineSeconds)
+                        {
+                                Idle.End(Now);
+                                StartWorkers();
+                                Phase = EPhase::Load;
+                                PhaseStartSeconds = Now;
+                                LoadStartSeconds = Now;
+                                Load.Begin(Now);
+                        }
+                        break;
+
+                case EPhase::Load:
+                        Load.Record(HitchFrameMs);
+                        if (Now - PhaseStartSeconds >= Options.DurationSeconds || WorkersLeft.load() == 0)
+                        {
+                                bStop = true;
+                                LoadEndSeconds = Now;
+                                Load.End(Now);
+                                Phase = EPhase::Draining;
+                        }
+                        break;
+
+                case EPhase::Draining:
+                        if (WorkersLeft.load() == 0)
+                        {
+                                Finish();
+                                return false;
+                        }
+                        break;
+                }
+                return true;
+        }
+
+        void StartWorkers()
+        {
+                const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+                Results.SetNum(Options.Connections);
+                WorkersLeft = Options.Connections;
+                for (int32 Index = 0; Index < Options.Connections; ++Index)
+                {
+                        Async(EAsyncExecution::Thread, [Self = AsShared(), Settings, Index]()
+                        {
+                                Self->RunWorker(*Settings, Index);
+                                --Self->WorkersLeft;
+                        });
+                }
+        }
+
+        void RunWorker(const UUnrealMCPSettings& Settings, int32 Index)
+        {
+                FWorkerResult& Result = Results[Index];
+
+                UnrealMCP::Protocol::FByteStreamPtr Stream;
+                FString Error;
+                if (!ConnectToServer(Settings, Stream, Error) || !PerformHandshake(*Stream, Settings, Error))
+                {
+                        Result.FatalError = Error;
+                        return;
+                }
+
+                FRandomStream Random(Index * 7919 + 1);
+                while (!bStop)
+                {
+                        const FString& Command = PickCommand(Random);
+                        const double StartSeconds = FPlatformTime::Seconds();
+                        TSharedPtr<FJsonObject> Response;
+                        if (!SendCommand(*Stream, Command, MakeParams(Command), Settings, Response, Error, Settings.ReadTimeoutSec))
+                        {
+                                Result.FatalError = Error;
+                                return;
+                        }
+
+                        const double LatencyMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+                        Result.All.Record(LatencyMs);
+                        Result.PerCommand.FindOrAdd(Command).Record(LatencyMs);
+
+                        bool bOk = false;
+                        if (!Response->TryGetBoolField(TEXT("ok"), bOk) || !bOk)
+                        {
+                                FString Code = TEXT("ERROR");
+                                const TSharedPtr<FJsonObject>* ErrorObject = nullptr;
+                                if (Response->TryGetObjectField(TEXT("error"), ErrorObject))
+                                {
+                                        (*ErrorObject)->TryGetStringField(TEXT("code"), Code);
+                                }
+                                ++Result.Errors;
+                                ++Result.ErrorCodes.FindOrAdd(Code);
+                        }
+                }
+        }
+
+        const FString& PickCommand(FRandomStream& Random) const
+        {
+                int32 Roll = Random.RandHelper(TotalWeight);
+                for (const TPair<FString, int32>& Entry : Options.Mix)
+                {
+                        if (Roll < Entry.Value)
+                        {
+                                return Entry.Key;
+                        }
+                        Roll -= Entry.Value;
+                }
+                return Options.Mix.Last().Key;
+        }
+
+        void Finish()
+        {
+                FLatencyHistogram All;
+                TMap<FString, FLatencyHistogram> PerCommand;
+                TMap<FString, int32> ErrorCodes;
+                int64 Errors = 0;
+                int32 FailedConnections = 0;
+                FString FirstFatalError;
+                for (const FWorkerResult& Result : Results)
+                {
+                        All.Merge(Result.All);
+                        for (const TPair<FString, FLatencyHistogram>& Pair : Result.PerCommand)
+                        {
+                                PerCommand.FindOrAdd(Pair.Key).Merge(Pair.Value);
+                        }
+                        for (const TPair<FString, int32>& Pair : Result.ErrorCodes)
+                        {
+                                ErrorCodes.FindOrAdd(Pair.Key) += Pair.Value;
+                        }
+                        Errors += Result.Errors;
+                        if (!Result.FatalError.IsEmpty())
+                        {
+                                ++FailedConnections;
+                                if (FirstFatalError.IsEmpty())
+                                {
+                                        FirstFatalError = Result.FatalError;
+                                }
+                        }
+                }
+
+                const double LoadSeconds = FMath::Max(LoadEndSeconds - LoadStartSeconds, 0.001);
+                const double Throughput = static_cast<double>(All.GetCount()) / LoadSeconds;
+
+                FString Report = FString::Printf(TEXT("Benchmark: %d connection(s) for %.1f s, %llu requests (%.1f/s), %lld error(s).\n"),
+                        Options.Connections, LoadSeconds, All.GetCount(), Throughput, Errors);
+                Report += FString::Printf(TEXT("Latency: %s\n"), *FormatLatency(All));
+                for (const TPair<FString, int32>& Entry : Options.Mix)
+                {
+                        if (const FLatencyHistogram* Histogram = PerCommand.Find(Entry.Key))
+                        {
+                                Report += FString::Printf(TEXT("  %s: %llu, %s\n"), *Entry.Key, Histogram->GetCount(), *FormatLatency(*Histogram));
+                        }
+                }
+                for (const TPair<FString, int32>& Pair : ErrorCodes)
+                {
+                        Report += FString::Printf(TEXT("  error %s: %d\n"), *Pair.Key, Pair.Value);
+                }
+                Report += Idle.Format(TEXT("Idle")) + TEXT("\n");
+                Report += Load.Format(TEXT("Under load")) + TEXT("\n");
+                Report += FString::Printf(TEXT("Frame p99 %+.2f ms and %+d hitch(es) (over %.0f ms) against idle"),
+                        Load.Frame.GetPercentileMs(0.99) - Idle.Frame.GetPercentileMs(0.99), Load.Hitches - Idle.Hitches, HitchFrameMs);
+                if (FailedConnections > 0)
+                {
+                        Report += FString::Printf(TEXT("\n%d connection(s) failed: %s"), FailedConnections, *FirstFatalError);
+                }
+
+                TSharedPtr<FJsonObject> Fields = MakeShared<FJsonObject>();
+                Fields->SetNumberField(TEXT("connections"), Options.Connections);
+                Fields->SetNumberField(TEXT("durationSec"), LoadSeconds);
+                Fields->SetNumberField(TEXT("requests"), static_cast<double>(All.GetCount()));
+                Fields->SetNumberField(TEXT("requestsPerSec"), Throughput);
+                Fields->SetNumberField(TEXT("errors"), static_cast<double>(Errors));
+                Fields->SetNumberField(TEXT("failedConnections"), FailedConnections);
+                Fields->SetObjectField(TEXT("latency"), HistogramToJson(All));
+                TSharedPtr<FJsonObject> Commands = MakeShared<FJsonObject>();
+                for (const TPair<FString, FLatencyHistogram>& Pair : PerCommand)
+                {
+                        Commands->SetObjectField(Pair.Key, HistogramToJson(Pair.Value));
+                }
+                Fields->SetObjectField(TEXT("commands"), Commands);
+                Fields->SetObjectField(TEXT("frameIdle"), HistogramToJson(Idle.Frame));
+                Fields->SetObjectField(TEXT("frameLoad"), HistogramToJson(Load.Frame));
+                Fields->SetNumberField(TEXT("hitchThresholdMs"), HitchFrameMs);
+                Fields->SetObjectField(TEXT("idle"), Idle.ToJson());
+                Fields->SetObjectField(TEXT("load"), Load.ToJson());
+                Fields->SetBoolField(TEXT("success"), All.GetCount() > 0 && FailedConnections == 0);
+                FJsonLogger::Metric(TEXT("benchmark_report"), Fields);
+                GLastReport = Fields;
+
+                const bool bSuccess = All.GetCount() > 0 && FailedConnections == 0;
+                UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPDiagnostics: %s"), *Report);
+
+                // Keep this run alive through the callback, which may start the next one.
+                const TSharedPtr<FBenchmarkRun, ESPMode::ThreadSafe> Self = Active;
+                Active.Reset();
+                if (OnComplete)
+                {
+                        OnComplete(FText::FromString(Report), bSuccess);
+                }
+        }
+
+        FUnrealMCPBenchmarkOptions Options;
+        FBenchmarkComplete OnComplete;
+        int32 TotalWeight = 0;
+
+        EPhase Phase;
+        double PhaseStartSeconds;
+        double LoadStartSeconds;
+        double LoadEndSeconds;
+        double HitchFrameMs = DefaultHitchFrameMs;
+        FFrameSamples Idle;
+        FFrameSamples Load;
+
+        TArray<FWorkerResult> Results;
+        std::atomic<bool> bStop;
+        std::atomic<int32> WorkersLeft;
+};
+
+TSharedPtr<FUnrealMCPDiagnostics::FBenchmarkRun, ESPMode::ThreadSafe> FUnrealMCPDiagnostics::FBenchmarkRun::Active;
+
+bool FUnrealMCPDiagnostics::StartBenchmark(const FUnrealMCPBenchmarkOptions& Options, FBenchmarkComplete OnComplete, FText& OutMessage)
+{
+        check(IsInGameThread());
+
+        if (FBenchmarkRun::Active.IsValid())
+        {
+                OutMessage = FText::FromString(TEXT("A benchmark is already running."));
+                return false;
+        }
+
+        if (Options.Connections < 1 || Options.DurationSeconds <= 0.0 || Options.BaselineSeconds <= 0.0 || Options.Mix.Num() == 0)
+        {
+                OutMessage = FText::FromString(TEXT("The benchmark needs at least one connection, a baseline, a duration and a command mix."));
+                return false;
+        }
+
+        FBenchmarkRun::Active = MakeShared<FBenchmarkRun, ESPMode::ThreadSafe>(Options, MoveTemp(OnComplete));
+        FBenchmarkRun::Active->Start();
+
+        OutMessage = FText::FromString(FString::Printf(TEXT("Benchmark started: %d connection(s) for %.1f s after a %.0f s idle baseline."),
+                Options.Connections, Options.DurationSeconds, Options.BaselineSeconds));
+        return true;
+}
+
+bool FUnrealMCPDiagnostics::MakeBenchmarkOptions(const UUnrealMCPSettings& Settings, FUnrealMCPBenchmarkOptions& OutOptions, FString& OutError)
+{
+        OutOptions.Connections = FMath::Clamp(Settings.BenchmarkConnections, 1, 64);
+        OutOptions.DurationSeconds = FMath::Clamp(static_cast<double>(Settings.BenchmarkDurationSec), 1.0, 600.0);
+        return ParseBenchmarkMix(Settings.BenchmarkMix, OutOptions.Mix, OutError);
+}
+
+bool FUnrealMCPDiagnostics::ParseBenchmarkMix(const FString& Mix, TArray<TPair<FString, int32>>& OutMix, FString& OutError)
+{
+        OutMix.Reset();
+
+        TArray<FString> Entries;
+        Mix.ParseIntoArray(Entries, TEXT(","), true);
+        for (FString& Entry : Entries)
+        {
+                Entry.TrimStartAndEndInline();
+                FString Command = Entry;
+                int32 Weight = 1;
+                FString WeightText;
+                if (Entry.Split(TEXT("="), &Command, &WeightText))
+                {
+                        Command.TrimStartAndEndInline();
+                        WeightText.TrimStartAndEndInline();
+                        if (!WeightText.IsNumeric())
+                        {
+                                OutError = FString::Printf(TEXT("Invalid weight '%s' for %s"), *WeightText, *Command);
+                                return false;
+                        }
+                        Weight = FCString::Atoi(*WeightText);
+                }
+
+                if (!IsSupportedCommand(Command))
+                {
+                        OutError = FString::Printf(TEXT("Unsupported benchmark command '%s' (use ping, asset.find, asset.exists or get_actors_in_level)"), *Command);
+                        return false;
+                }
+                if (Weight > 0)
+                {
+                        OutMix.Emplace(Command, Weight);
+                }
+        }
+
+        if (OutMix.Num() == 0)
+        {
+                OutError = TEXT("The benchmark mix has no commands");
+                return false;
+        }
+        return true;
+}
+
+bool FUnrealMCPDiagnostics::IsBenchmarkRunning()
+{
+        return FBenchmarkRun::Active.IsValid();
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPDiagnostics::GetLastBenchmarkReport()
+{
+        check(IsInGameThread());
+        return GLastReport;
+}
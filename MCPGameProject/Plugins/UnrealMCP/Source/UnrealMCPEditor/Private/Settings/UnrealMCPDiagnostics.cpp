@@ -21,6 +21,11 @@ namespace
 
         FString FormatEndpointMessage(const UUnrealMCPSettings& Settings)
         {
+                if (Settings.GetPerformanceValues().Transport == EUnrealMCPTransport::LocalIpc)
+                {
+                        return UnrealMCP::Protocol::GetLocalEndpointPath(Settings.LocalEndpointName);
+                }
+
                 FString Host = Settings.ServerHost;
                 Host.TrimStartAndEndInline();
                 return FString::Printf(TEXT("%s:%d"), *Host, Settings.ServerPort);
@@ -59,15 +64,15 @@ bool FUnrealMCPDiagnostics::TestConnection(FText& OutMessage)
                 return false;
         }
 
-        TSharedPtr<FSocket> Socket;
+        UnrealMCP::Protocol::FByteStreamPtr Stream;
         FString Error;
-        if (!ConnectToServer(*Settings, Socket, Error))
+        if (!ConnectToServer(*Settings, Stream, Error))
         {
                 OutMessage = FText::FromString(FString::Printf(TEXT("Failed to connect to %s: %s"), *FormatEndpointMessage(*Settings), *Error));
                 return false;
         }
 
-        if (!PerformHandshake(*Socket, *Settings, Error))
+        if (!PerformHandshake(*Stream, *Settings, Error))
         {
                 OutMessage = FText::FromString(FString::Printf(TEXT("Handshake failed: %s"), *Error));
                 return false;
@@ -86,15 +91,15 @@ bool FUnrealMCPDiagnostics::SendPing(FText& OutMessage)
                 return false;
         }
 
-        TSharedPtr<FSocket> Socket;
+        UnrealMCP::Protocol::FByteStreamPtr Stream;
         FString Error;
-        if (!ConnectToServer(*Settings, Socket, Error))
+        if (!ConnectToServer(*Settings, Stream, Error))
         {
                 OutMessage = FText::FromString(FString::Printf(TEXT("Failed to connect to %s: %s"), *FormatEndpointMessage(*Settings), *Error));
                 return false;
         }
 
-        if (!PerformHandshake(*Socket, *Settings, Error))
+        if (!PerformHandshake(*Stream, *Settings, Error))
         {
                 OutMessage = FText::FromString(FString::Printf(TEXT("Handshake failed: %s"), *Error));
                 return false;
@@ -102,7 +107,7 @@ bool FUnrealMCPDiagnostics::SendPing(FText& OutMessage)
 
         const double StartTime = FPlatformTime::Seconds();
         TSharedPtr<FJsonObject> Response;
-        if (!SendCommand(*Socket, TEXT("ping"), nullptr, *Settings, Response, Error, Settings->ReadTimeoutSec))
+        if (!SendCommand(*Stream, TEXT("ping"), nullptr, *Settings, Response, Error, Settings->ReadTimeoutSec))
         {
                 OutMessage = FText::FromString(FString::Printf(TEXT("Ping failed: %s"), *Error));
                 return false;
@@ -254,7 +259,19 @@ bool FUnrealMCPDiagnostics::TailLogs(FText& OutMessage)
         return true;
 }
 
-bool FUnrealMCPDiagnostics::ConnectToServer(const UUnrealMCPSettings& Settings, TSharedPtr<FSocket>& OutSocket, FString& OutError)
+bool FUnrealMCPDiagnostics::ConnectToServer(const UUnrealMCPSettings& Settings, UnrealMCP::Protocol::FByteStreamPtr& OutStream, FString& OutError)
+{
+        if (Settings.GetPerformanceValues().Transport != EUnrealMCPTransport::LocalIpc)
+        {
+                return ConnectTcp(Settings, OutStream, OutError);
+        }
+
+        const double Timeout = FMath::Max(0.1, static_cast<double>(Settings.ConnectTimeoutSec));
+        OutStream = UnrealMCP::Protocol::ConnectLocalStream(Settings.LocalEndpointName, Timeout, OutError);
+        return OutStream.IsValid();
+}
+
+bool FUnrealMCPDiagnostics::ConnectTcp(const UUnrealMCPSettings& Settings, UnrealMCP::Protocol::FByteStreamPtr& OutStream, FString& OutError)
 {
         ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
         if (!SocketSubsystem)
@@ -328,7 +345,7 @@ bool FUnrealMCPDiagnostics::ConnectToServer(const UUnrealMCPSettings& Settings,
         }
 
         Socket->SetNonBlocking(false);
-        OutSocket = Socket;
+        OutStream = UnrealMCP::Protocol::MakeSocketStream(Socket);
         return true;
 }
 
@@ -352,7 +369,7 @@ FString FUnrealMCPDiagnostics::GetMetricsLogPath(const UUnrealMCPSettings& Setti
         return FPaths::Combine(Directory, MetricsLogName);
 }
 
-bool FUnrealMCPDiagnostics::PerformHandshake(FSocket& Socket, const UUnrealMCPSettings& Settings, FString& OutError)
+bool FUnrealMCPDiagnostics::PerformHandshake(UnrealMCP::Protocol::IByteStream& Stream, const UUnrealMCPSettings& Settings, FString& OutError)
 {
         using namespace UnrealMCP::Protocol;
 
@@ -364,13 +381,13 @@ bool FUnrealMCPDiagnostics::PerformHandshake(FSocket& Socket, const UUnrealMCPSe
         Handshake->SetStringField(TEXT("sessionId"), FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens));
 
         FString WriteError;
-        if (!WriteFramedJson(Socket, Handshake, WriteError, Settings.ConnectTimeoutSec))
+        if (!WriteFramedJson(Stream, Handshake, WriteError, Settings.ConnectTimeoutSec))
         {
                 OutError = WriteError;
                 return false;
         }
 
-        const FProtocolReadResult Result = ReadFramedJson(Socket, Settings.ConnectTimeoutSec, false);
+        const FProtocolReadResult Result = ReadFramedJson(Stream, Settings.ConnectTimeoutSec, false);
         if (!Result.bSuccess || !Result.Message.IsValid())
         {
                 OutError = Result.Error.IsEmpty() ? TEXT("No handshake acknowledgment received") : Result.Error;
@@ -395,7 +412,7 @@ bool FUnrealMCPDiagnostics::PerformHandshake(FSocket& Socket, const UUnrealMCPSe
         return true;
 }
 
-bool FUnrealMCPDiagnostics::SendCommand(FSocket& Socket, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const UUnrealMCPSettings& Settings, TSharedPtr<FJsonObject>& OutResponse, FString& OutError, double TimeoutSeconds)
+bool FUnrealMCPDiagnostics::SendCommand(UnrealMCP::Protocol::IByteStream& Stream, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const UUnrealMCPSettings& Settings, TSharedPtr<FJsonObject>& OutResponse, FString& OutError, double TimeoutSeconds)
 {
         using namespace UnrealMCP::Protocol;
 
@@ -407,13 +424,13 @@ bool FUnrealMCPDiagnostics::SendCommand(FSocket& Socket, const FString& CommandT
         }
 
         FString SendError;
-        if (!WriteFramedJson(Socket, Message, SendError, Settings.ConnectTimeoutSec))
+        if (!WriteFramedJson(Stream, Message, SendError, Settings.ConnectTimeoutSec))
         {
                 OutError = SendError;
                 return false;
         }
 
-        const FProtocolReadResult Result = ReadFramedJson(Socket, TimeoutSeconds, false);
+        const FProtocolReadResult Result = ReadFramedJson(Stream, TimeoutSeconds, false);
         if (!Result.bSuccess || !Result.Message.IsValid())
         {
                 OutError = Result.Error.IsEmpty() ? TEXT("No response from server") : Result.Error;
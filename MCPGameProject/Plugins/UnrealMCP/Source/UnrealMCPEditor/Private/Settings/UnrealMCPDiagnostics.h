@@ -1,14 +1,27 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Protocol/Transport.h"
 
-class FSocket;
 class UUnrealMCPSettings;
 
+/** What the benchmark sends, and for how long. */
+struct FUnrealMCPBenchmarkOptions
+{
+        int32 Connections = 4;
+        double DurationSeconds = 10.0;
+        /** Idle frame times are sampled this long before the load starts. */
+        double BaselineSeconds = 2.0;
+        /** Commands and their relative weights. */
+        TArray<TPair<FString, int32>> Mix;
+};
+
 /** Utility helpers for diagnostics actions triggered from the settings panel. */
 class FUnrealMCPDiagnostics
 {
 public:
+        typedef TFunction<void(const FText& Report, bool bSuccess)> FBenchmarkComplete;
+
         /** Attempts to connect and perform a handshake using the current settings. */
         static bool TestConnection(FText& OutMessage);
 
@@ -27,10 +40,47 @@ public:
         /** Launches a tail command for the events log if supported by the platform. */
         static bool TailLogs(FText& OutMessage);
 
+        /**
+         * Starts a load run against the running server: Options.Connections client connections send
+         * the weighted mix back to back for Options.DurationSeconds. Returns false (with OutMessage)
+         * if the options are unusable or a run is already going. OnComplete is called on the game
+         * thread with the report: throughput, latency percentiles per command, and for the idle
+         * baseline against the load, frame, game-thread, render-thread and GPU time percentiles,
+         * hitch counts and the share of the game thread spent in MCP commands.
+         */
+        static bool StartBenchmark(const FUnrealMCPBenchmarkOptions& Options, FBenchmarkComplete OnComplete, FText& OutMessage);
+
+        /** Options from the Benchmark* settings. */
+        static bool MakeBenchmarkOptions(const UUnrealMCPSettings& Settings, FUnrealMCPBenchmarkOptions& OutOptions, FString& OutError);
+
+        /** Parses "command=weight,command=weight"; a command without a weight gets 1. */
+        static bool ParseBenchmarkMix(const FString& Mix, TArray<TPair<FString, int32>>& OutMix, FString& OutError);
+
+        static bool IsBenchmarkRunning();
+
+        /**
+         * The last finished run's report as the JSON written to the metrics log (benchmark_report),
+         * or null before the first one. Lets automation tests start a run, wait for
+         * IsBenchmarkRunning to turn false and compare the numbers. Game thread.
+         */
+        static TSharedPtr<FJsonObject> GetLastBenchmarkReport();
+
+        /**
+         * Times protocol framing over a local socket pair (1 KiB to 4 MiB frames, plus the legacy
+         * fallback) and JSON/CBOR encode and decode of representative responses, without a server.
+         * Blocks for a few seconds; call it off the game thread. Writes the per-case timings as JSON
+         * to OutResultsPath in the logs directory and a table to OutReport. False if any case failed.
+         */
+        static bool RunProtocolBenchmark(FString& OutReport, FString& OutResultsPath);
+
 private:
-        static bool ConnectToServer(const UUnrealMCPSettings& Settings, TSharedPtr<FSocket>& OutSocket, FString& OutError);
-        static bool PerformHandshake(FSocket& Socket, const UUnrealMCPSettings& Settings, FString& OutError);
-        static bool SendCommand(FSocket& Socket, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const UUnrealMCPSettings& Settings, TSharedPtr<FJsonObject>& OutResponse, FString& OutError, double TimeoutSeconds);
+        class FBenchmarkRun;
+
+        /** Connects over the configured transport (TCP or local IPC). */
+        static bool ConnectToServer(const UUnrealMCPSettings& Settings, UnrealMCP::Protocol::FByteStreamPtr& OutStream, FString& OutError);
+        static bool ConnectTcp(const UUnrealMCPSettings& Settings, UnrealMCP::Protocol::FByteStreamPtr& OutStream, FString& OutError);
+        static bool PerformHandshake(UnrealMCP::Protocol::IByteStream& Stream, const UUnrealMCPSettings& Settings, FString& OutError);
+        static bool SendCommand(UnrealMCP::Protocol::IByteStream& Stream, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const UUnrealMCPSettings& Settings, TSharedPtr<FJsonObject>& OutResponse, FString& OutError, double TimeoutSeconds);
         static FString ResolveHostForConnection(const FString& Host);
         static FString GetEventsLogPath(const UUnrealMCPSettings& Settings);
         static FString GetMetricsLogPath(const UUnrealMCPSettings& Settings);
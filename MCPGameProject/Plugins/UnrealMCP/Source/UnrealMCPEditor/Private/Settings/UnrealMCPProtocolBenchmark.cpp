@@ -0,0 +1,376 @@
+#include "Settings/UnrealMCPDiagnostics.h"
+#include "CoreMinimal.h"
+
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Observability/JsonLogger.h"
+#include "Observability/MetricsRegistry.h"
+#include "Protocol/Protocol.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UnrealMCPSettings.h"
+
+#include <atomic>
+
+namespace
+{
+        using namespace UnrealMCP::Protocol;
+
+        /** Each case runs at least this long and this many times, after a short warm-up. */
+        constexpr double MinCaseSeconds = 0.5;
+        constexpr int32 MinIterations = 10;
+        constexpr int32 MaxIterations = 20000;
+        constexpr int32 WarmupIterations = 3;
+
+        /** Room left for the envelope so the largest case still fits the 4 MiB frame limit. */
+        constexpr int32 EnvelopeReserveBytes = 256;
+
+        /** An in-memory stream: Send appends, Recv consumes. Isolates the codec from socket cost. */
+        class FMemoryByteStream : public IByteStream
+        {
+        public:
+                void Reset(const TArray<uint8>& Bytes)
+                {
+                        Buffer = Bytes;
+                        ReadOffset = 0;
+                }
+
+                virtual bool Recv(uint8* Data, int32 MaxBytes, int32& OutBytesRead, bool& bOutWouldBlock) override
+                {
+                        OutBytesRead = FMath::Min(MaxBytes, Buffer.Num() - ReadOffset);
+                        FMemory::Memcpy(Data, Buffer.GetData() + ReadOffset, OutBytesRead);
+                        ReadOffset += OutBytesRead;
+                        bOutWouldBlock = false;
+                        return true;
+                }
+
+                virtual bool Send(const uint8* Data, int32 Length, int32& OutBytesSent, bool& bOutWouldBlock) override
+                {
+                        Buffer.Append(Data, Length);
+                        OutBytesSent = Length;
+                        bOutWouldBlock = false;
+                        return true;
+                }
+
+                virtual bool Wait(EStreamWait Condition, double TimeoutSeconds) override { return true; }
+                virtual bool IsConnected() const override { return true; }
+                virtual void Shutdown() override {}
+                virtual void Close() override {}
+                virtual FString DescribeLastError(const TCHAR* Operation) const override { return FString(); }
+                virtual const TCHAR* GetTransportName() const override { return TEXT("memory"); }
+
+        private:
+                TArray<uint8> Buffer;
+                int32 ReadOffset = 0;
+        };
+
+        struct FCaseResult
+        {
+                FString Name;
+                int64 PayloadBytes = 0;
+                FLatencyHistogram Histogram;
+                FString Error;
+        };
+
+        /** Times Iteration until MinCaseSeconds and MinIterations are both met; stops at the first failure. */
+        FCaseResult RunCase(const FString& Name, int64 PayloadBytes, TFunctionRef<bool(FString& OutError)> Iteration)
+        {
+                FCaseResult Result;
+                Result.Name = Name;
+                Result.PayloadBytes = PayloadBytes;
+
+                for (int32 Index = 0; Index < WarmupIterations; ++Index)
+                {
+                        if (!Iteration(Result.Error))
+                        {
+                                return Result;
+                        }
+                }
+
+                const double CaseStart = FPlatformTime::Seconds();
+                while (Result.Histogram.GetCount() < MaxIterations
+                        && (Result.Histogram.GetCount() < MinIterations || FPlatformTime::Seconds() - CaseStart < MinCaseSeconds))
+                {
+                        const double Start = FPlatformTime::Seconds();
+                        if (!Iteration(Result.Error))
+                        {
+                                return Result;
+                        }
+                        Result.Histogram.Record((FPlatformTime::Seconds() - Start) * 1000.0);
+                }
+                return Result;
+        }
+
+        TSharedRef<FJsonObject> MakeBlobMessage(int32 PayloadBytes)
+        {
+                TSharedRef<FJsonObject> Message = MakeShared<FJsonObject>();
+                Message->SetBoolField(TEXT("ok"), true);
+                TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+                Result->SetStringField(TEXT("data"), FString::ChrN(FMath::Max(PayloadBytes - EnvelopeReserveBytes, 1), TEXT('x')));
+                Message->SetObjectField(TEXT("result"), Result);
+                return Message;
+        }
+
+        /** Shaped like an asset.find page: Count items of path, class and tags. */
+        TSharedRef<FJsonObject> MakeAssetFindResponse(int32 Count)
+        {
+                TArray<TSharedPtr<FJsonValue>> Items;
+                for (int32 Index = 0; Index < Count; ++Index)
+                {
+                        TSharedPtr<FJsonObject> Item = MakeShared<FJsonObject>();
+                        Item->SetStringField(TEXT("objectPath"), FString::Printf(TEXT("/Game/Environment/Props/SM_Prop_%04d.SM_Prop_%04d"), Index, Index));
+                        Item->SetStringField(TEXT("packageName"), FString::Printf(TEXT("/Game/Environment/Props/SM_Prop_%04d"), Index));
+                        Item->SetStringField(TEXT("class"), TEXT("/Script/Engine.StaticMesh"));
+                        TSharedPtr<FJsonObject> Tags = MakeShared<FJsonObject>();
+                        Tags->SetStringField(TEXT("Triangles"), FString::FromInt(1200 + Index));
+                        Tags->SetStringField(TEXT("LODs"), TEXT("4"));
+                        Item->SetObjectField(TEXT("tags"), Tags);
+                        Items.Add(MakeShared<FJsonValueObject>(Item));
+                }
+
+                TSharedRef<FJsonObject> Message = MakeShared<FJsonObject>();
+                Message->SetBoolField(TEXT("ok"), true);
+                TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+                Result->SetNumberField(TEXT("total"), Count);
+                Result->SetArrayField(TEXT("items"), Items);
+                Message->SetObjectField(TEXT("result"), Result);
+                return Message;
+        }
+
+        /** Shaped like get_actors_in_level: Count actors with numeric transforms. */
+        TSharedRef<FJsonObject> MakeActorListResponse(int32 Count)
+        {
+                TArray<TSharedPtr<FJsonValue>> Actors;
+                for (int32 Index = 0; Index < Count; ++Index)
+                {
+                        TSharedPtr<FJsonObject> Actor = MakeShared<FJsonObject>();
+                        Actor->SetStringField(TEXT("name"), FString::Printf(TEXT("StaticMeshActor_%d"), Index));
+                        Actor->SetStringField(TEXT("class"), TEXT("StaticMeshActor"));
+                        auto MakeVector = [Index](double Scale)
+                        {
+                                return TArray<TSharedPtr<FJsonValue>>{
+                                        MakeShared<FJsonValueNumber>(Index * Scale),
+                                        MakeShared<FJsonValueNumber>(Index * Scale * 0.5),
+                                        MakeShared<FJsonValueNumber>(Scale) };
+                        };
+                        Actor->SetArrayField(TEXT("location"), MakeVector(100.0));
+                        Actor->SetArrayField(TEXT("rotation"), MakeVector(1.5));
+                        Actor->SetArrayField(TEXT("scale"), MakeVector(1.0));
+                        Actors.Add(MakeShared<FJsonValueObject>(Actor));
+                }
+
+                TSharedRef<FJsonObject> Message = MakeShared<FJsonObject>();
+                Message->SetBoolField(TEXT("ok"), true);
+                TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+                Result->SetArrayField(TEXT("actors"), Actors);
+                Message->SetObjectField(TEXT("result"), Result);
+                return Message;
+        }
+
+        int64 EncodedPayloadBytes(const TSharedRef<FJsonObject>& Message, const FFrameOptions& Options)
+        {
+                TArray<uint8> Frame;
+                FString Error;
+                return EncodeFrame(Message, Frame, Error, Options) ? Frame.Num() - static_cast<int64>(sizeof(uint32)) : 0;
+        }
+
+        /**
+         * Frames written on a helper thread and read on this one over a same-host socket pair, one at
+         * a time so each sample is one frame's write-to-decoded latency.
+         */
+        void RunSocketCases(TArray<FCaseResult>& OutResults)
+        {
+                const FString EndpointName = FString::Printf(TEXT("unreal-mcp-bench-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+                FString Error;
+                FStreamListenerPtr Listener = CreateLocalListener(EndpointName, Error);
+                FByteStreamPtr Client = Listener.IsValid() ? ConnectLocalStream(EndpointName, 2.0, Error) : nullptr;
+                FByteStreamPtr Server = Client.IsValid() ? Listener->Accept(2.0) : nullptr;
+                if (!Server.IsValid())
+                {
+                        FCaseResult& Failed = OutResults.AddDefaulted_GetRef();
+                        Failed.Name = TEXT("socket");
+                        Failed.Error = Error.IsEmpty() ? TEXT("Could not open a local socket pair") : Error;
+                        return;
+                }
+
+                FEvent* WriteEvent = FPlatformProcess::GetSynchEventFromPool(false);
+                TSharedRef<FJsonObject> PendingMessage = MakeShared<FJsonObject>();
+                std::atomic<bool> bStopWriter(false);
+                std::atomic<bool> bLegacy(false);
+                TFuture<void> WriterDone = Async(EAsyncExecution::Thread, [&]()
+                {
+                        TArray<uint8> Scratch;
+                        FString WriteError;
+                        while (true)
+                        {
+                                WriteEvent->Wait();
+                                if (bStopWriter)
+                                {
+                                        return;
+                                }
+                                if (bLegacy)
+                                {
+                                        WriteLegacyJson(*Client, PendingMessage, WriteError);
+                                }
+                                else
+                                {
+                                        WriteFramedJson(*Client, PendingMessage, Scratch, WriteError, 10.0);
+                                }
+                        }
+                });
+
+                auto RunFrames = [&](const FString& Name, const TSharedRef<FJsonObject>& Message, bool bLegacyFrame)
+                {
+                        PendingMessage = Message;
+                        bLegacy = bLegacyFrame;
+                        OutResults.Add(RunCase(Name, EncodedPayloadBytes(Message, FFrameOptions()), [&](FString& OutError)
+                        {
+                                WriteEvent->Trigger();
+                                const FProtocolReadResult Read = ReadFramedJson(*Server, 10.0, bLegacyFrame);
+                                if (!Read.bSuccess)
+                                {
+                                        OutError = Read.Error.IsEmpty() ? TEXT("Frame not received") : Read.Error;
+                                        return false;
+                                }
+                                return true;
+                        }));
+                };
+
+                const TPair<const TCHAR*, int32> Sizes[] = {
+                        { TEXT("1KiB"), 1024 },
+                        { TEXT("16KiB"), 16 * 1024 },
+                        { TEXT("256KiB"), 256 * 1024 },
+                        { TEXT("1MiB"), 1024 * 1024 },
+                        { TEXT("4MiB"), 4 * 1024 * 1024 },
+                };
+                for (const TPair<const TCHAR*, int32>& Size : Sizes)
+                {
+                        RunFrames(FString::Printf(TEXT("socket.framed.%s"), Size.Key), MakeBlobMessage(Size.Value), false);
+                }
+                // Legacy clients send bare JSON, capped at 512 KiB; the reader falls back after the header check.
+                RunFrames(TEXT("socket.legacy.1KiB"), MakeBlobMessage(1024), true);
+                RunFrames(TEXT("socket.legacy.256KiB"), MakeBlobMessage(256 * 1024), true);
+
+                bStopWriter = true;
+                WriteEvent->Trigger();
+                WriterDone.Wait();
+                FPlatformProcess::ReturnSynchEventToPool(WriteEvent);
+                Client->Close();
+                Server->Close();
+                Listener->Shutdown();
+        }
+
+        /** Encode and decode of representative responses without any transport, in both encodings. */
+        void RunCodecCases(TArray<FCaseResult>& OutResults)
+        {
+                const TPair<const TCHAR*, TSharedRef<FJsonObject>> Messages[] = {
+                        { TEXT("asset_find_50"), MakeAssetFindResponse(50) },
+                        { TEXT("asset_find_1000"), MakeAssetFindResponse(1000) },
+                        { TEXT("actors_500"), MakeActorListResponse(500) },
+                };
+                const TPair<const TCHAR*, EFrameEncoding> Encodings[] = {
+                        { TEXT("json"), EFrameEncoding::Json },
+                        { TEXT("cbor"), EFrameEncoding::Cbor },
+                };
+
+                for (const TPair<const TCHAR*, TSharedRef<FJsonObject>>& Message : Messages)
+                {
+                        for (const TPair<const TCHAR*, EFrameEncoding>& Encoding : Encodings)
+                        {
+                                FFrameOptions Options;
+                                Options.Encoding = Encoding.Value;
+                                const int64 PayloadBytes = EncodedPayloadBytes(Message.Value, Options);
+
+                                TArray<uint8> Frame;
+                                OutResults.Add(RunCase(FString::Printf(TEXT("codec.encode.%s.%s"), Encoding.Key, Message.Key), PayloadBytes, [&](FString& OutError)
+                                {
+                                        return EncodeFrame(Message.Value, Frame, OutError, Options);
+                                }));
+
+                                FMemoryByteStream Stream;
+                                OutResults.Add(RunCase(FString::Printf(TEXT("codec.decode.%s.%s"), Encoding.Key, Message.Key), PayloadBytes, [&](FString& OutError)
+                                {
+                                        Stream.Reset(Frame);
+                                        const FProtocolReadResult Read = ReadFramedJson(Stream, 1.0, false, Options);
+                                        OutError = Read.Error;
+                                        return Read.bSuccess;
+                                }));
+                        }
+                }
+        }
+
+        TSharedRef<FJsonObject> CaseToJson(const FCaseResult& Result)
+        {
+                const FLatencyHistogram& Histogram = Result.Histogram;
+                const double MeanMs = Histogram.GetCount() > 0 ? Histogram.GetSumMs() / static_cast<double>(Histogram.GetCount()) : 0.0;
+
+                TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+                Json->SetStringField(TEXT("name"), Result.Name);
+                Json->SetNumberField(TEXT("payloadBytes"), static_cast<double>(Result.PayloadBytes));
+                Json->SetNumberField(TEXT("iterations"), static_cast<double>(Histogram.GetCount()));
+                Json->SetNumberField(TEXT("meanUs"), MeanMs * 1000.0);
+                Json->SetNumberField(TEXT("p50Us"), Histogram.GetPercentileMs(0.50) * 1000.0);
+                Json->SetNumberField(TEXT("p99Us"), Histogram.GetPercentileMs(0.99) * 1000.0);
+                Json->SetNumberField(TEXT("maxUs"), Histogram.GetMaxMs() * 1000.0);
+                Json->SetNumberField(TEXT("mibPerSec"), MeanMs > 0.0 ? (static_cast<double>(Result.PayloadBytes) / (1024.0 * 1024.0)) / (MeanMs / 1000.0) : 0.0);
+                if (!Result.Error.IsEmpty())
+                {
+                        Json->SetStringField(TEXT("error"), Result.Error);
+                }
+                return Json;
+        }
+}
+
+bool FUnrealMCPDiagnostics::RunProtocolBenchmark(FString& OutReport, FString& OutResultsPath)
+{
+        TArray<FCaseResult> Results;
+        RunSocketCases(Results);
+        RunCodecCases(Results);
+
+        TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+        Root->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+        Root->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+        Root->SetStringField(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+        TArray<TSharedPtr<FJsonValue>> Cases;
+
+        bool bAllPassed = true;
+        OutReport = FString::Printf(TEXT("%-36s %12s %8s %10s %10s %10s\n"), TEXT("case"), TEXT("bytes"), TEXT("iters"), TEXT("p50 us"), TEXT("p99 us"), TEXT("MiB/s"));
+        for (const FCaseResult& Result : Results)
+        {
+                const TSharedRef<FJsonObject> Json = CaseToJson(Result);
+                Cases.Add(MakeShared<FJsonValueObject>(Json));
+                if (!Result.Error.IsEmpty())
+                {
+                        bAllPassed = false;
+                        OutReport += FString::Printf(TEXT("%-36s failed: %s\n"), *Result.Name, *Result.Error);
+                        continue;
+                }
+                OutReport += FString::Printf(TEXT("%-36s %12lld %8llu %10.1f %10.1f %10.1f\n"), *Result.Name, Result.PayloadBytes, Result.Histogram.GetCount(),
+                        Json->GetNumberField(TEXT("p50Us")), Json->GetNumberField(TEXT("p99Us")), Json->GetNumberField(TEXT("mibPerSec")));
+        }
+        Root->SetArrayField(TEXT("cases"), Cases);
+
+        FString Serialized;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Serialized);
+        FJsonSerializer::Serialize(Root, Writer);
+
+        const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+        OutResultsPath = FPaths::Combine(Settings->GetEffectiveLogsDirectory(),
+                FString::Printf(TEXT("UnrealMCP_protocol_bench_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"))));
+        if (!FFileHelper::SaveStringToFile(Serialized, *OutResultsPath))
+        {
+                OutReport += FString::Printf(TEXT("Could not write %s\n"), *OutResultsPath);
+                OutResultsPath.Reset();
+                return false;
+        }
+
+        FJsonLogger::Metric(TEXT("protocol_benchmark"), Root);
+        return bAllPassed;
+}
@@ -0,0 +1,140 @@
+#include "Settings/UnrealMCPRuntimeConfig.h"
+#include "CoreMinimal.h"
+
+#include "Misc/ScopeLock.h"
+#include "UnrealMCPSettings.h"
+
+#include <atomic>
+
+namespace
+{
+    std::atomic<const FUnrealMCPRuntimeConfig*> GConfig{nullptr};
+    /**
+     * Every snapshot ever published, freed at shutdown: readers keep the raw pointer without
+     * reference counting. Identical rebuilds are not published, so this grows only with real edits.
+     */
+    TArray<TUniquePtr<FUnrealMCPRuntimeConfig>> GPublishedConfigs;
+    FCriticalSection GPublishMutex;
+    FSimpleMulticastDelegate GOnChanged;
+    FDelegateHandle GSettingsChangedHandle;
+
+    TUniquePtr<FUnrealMCPRuntimeConfig> BuildConfig()
+    {
+        TUniquePtr<FUnrealMCPRuntimeConfig> Config = MakeUnique<FUnrealMCPRuntimeConfig>();
+        const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+        if (!Settings)
+        {
+            return Config;
+        }
+
+        // The budget and logging follow the performance profile; Custom leaves them as set.
+        const FUnrealMCPPerformanceValues Performance = Settings->GetPerformanceValues();
+        Config->bProtocolVerboseLogs = Performance.bProtocolVerboseLogs;
+        Config->bJsonLogs = Performance.bJsonLogs;
+        Config->LogsDirectory = Settings->GetEffectiveLogsDirectory();
+        Config->bRequireCheckout = Settings->RequireCheckout;
+        Config->bAllowUndoFreeMutations = Settings->bAllowUndoFreeMutations;
+        Config->bAlwaysEmitAudit = Settings->AlwaysEmitAudit;
+        Config->bEnableSourceControl = Settings->EnableSourceControl;
+        Config->GameThreadBudgetMs = Performance.GameThreadBudgetMs;
+        Config->ResponseCacheMaxEntries = Settings->ResponseCacheMaxEntries;
+        Config->bSpeculativePrefetch = Settings->bSpeculativePrefetch;
+        Config->PrefetchFollowUps = Settings->PrefetchFollowUps;
+        Config->RequestDedupWindowSec = Settings->RequestDedupWindowSec;
+        Config->JobRetentionMin = Settings->JobRetentionMin;
+        Config->BlueprintCompileDebounceMs = Settings->BlueprintCompileDebounceMs;
+        Config->bDeferBlueprintCompiles = Settings->bDeferBlueprintCompiles;
+        Config->MemoryCeilingMb = Settings->MemoryCeilingMb;
+        Config->IdleGcSec = Settings->IdleGcSec;
+        Config->bReleaseAssetsLoadedByCommands = Settings->bReleaseAssetsLoadedByCommands;
+        Config->MaxUndoMemoryMb = Settings->MaxUndoMemoryMb;
+        return Config;
+    }
+
+    /** Returns true when Config was new and is now the published snapshot. */
+    bool Publish(TUniquePtr<FUnrealMCPRuntimeConfig> Config)
+    {
+        FScopeLock Lock(&GPublishMutex);
+        const FUnrealMCPRuntimeConfig* Current = GConfig.load(std::memory_order_relaxed);
+        if (Current && *Current == *Config)
+        {
+            return false;
+        }
+        GConfig.store(Config.Get(), std::memory_order_release);
+        GPublishedConfigs.Add(MoveTemp(Config));
+        return Current != nullptr;
+    }
+}
+
+bool FUnrealMCPRuntimeConfig::operator==(const FUnrealMCPRuntimeConfig& Other) const
+{
+    return bProtocolVerboseLogs == Other.bProtocolVerboseLogs
+        && bJsonLogs == Other.bJsonLogs
+        && LogsDirectory == Other.LogsDirectory
+        && bRequireCheckout == Other.bRequireCheckout
+        && bAllowUndoFreeMutations == Other.bAllowUndoFreeMutations
+        && bAlwaysEmitAudit == Other.bAlwaysEmitAudit
+        && bEnableSourceControl == Other.bEnableSourceControl
+        && GameThreadBudgetMs == Other.GameThreadBudgetMs
+        && ResponseCacheMaxEntries == Other.ResponseCacheMaxEntries
+        && bSpeculativePrefetch == Other.bSpeculativePrefetch
+        && PrefetchFollowUps == Other.PrefetchFollowUps
+        && RequestDedupWindowSec == Other.RequestDedupWindowSec
+        && JobRetentionMin == Other.JobRetentionMin
+        && BlueprintCompileDebounceMs == Other.BlueprintCompileDebounceMs
+        && bDeferBlueprintCompiles == Other.bDeferBlueprintCompiles
+        && MemoryCeilingMb == Other.MemoryCeilingMb
+        && IdleGcSec == Other.IdleGcSec
+        && bReleaseAssetsLoadedByCommands == Other.bReleaseAssetsLoadedByCommands
+        && MaxUndoMemoryMb == Other.MaxUndoMemoryMb;
+}
+
+const FUnrealMCPRuntimeConfig& FUnrealMCPRuntimeConfig::Get()
+{
+    const FUnrealMCPRuntimeConfig* Config = GConfig.load(std::memory_order_acquire);
+    if (!Config)
+    {
+        // Only before Start; the settings object is already loaded by then, so reading it here is safe.
+        Publish(BuildConfig());
+        Config = GConfig.load(std::memory_order_acquire);
+    }
+    return *Config;
+}
+
+void FUnrealMCPRuntimeConfig::Refresh()
+{
+    check(IsInGameThread());
+    if (Publish(BuildConfig()))
+    {
+        GOnChanged.Broadcast();
+    }
+}
+
+FSimpleMulticastDelegate& FUnrealMCPRuntimeConfig::OnChanged()
+{
+    return GOnChanged;
+}
+
+void FUnrealMCPRuntimeConfig::Start()
+{
+    Refresh();
+    if (!GSettingsChangedHandle.IsValid())
+    {
+        GSettingsChangedHandle = GetMutableDefault<UUnrealMCPSettings>()->OnSettingChanged().AddLambda([](UObject*, FPropertyChangedEvent&)
+        {
+            FUnrealMCPRuntimeConfig::Refresh();
+        });
+    }
+}
+
+void FUnrealMCPRuntimeConfig::Stop()
+{
+    if (GSettingsChangedHandle.IsValid())
+    {
+        if (UObjectInitialized())
+        {
+            GetMutableDefault<UUnrealMCPSettings>()->OnSettingChanged().Remove(GSettingsChangedHandle);
+        }
+        GSettingsChangedHandle.Reset();
+    }
+}
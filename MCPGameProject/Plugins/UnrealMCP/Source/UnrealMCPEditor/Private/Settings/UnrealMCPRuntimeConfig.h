@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Delegates/Delegate.h"
+
+/**
+ * The UUnrealMCPSettings values read on request paths, copied into an immutable snapshot when the
+ * module starts and again whenever the settings are edited. Readers get plain fields through one
+ * atomic load instead of a GetDefault and a UObject read per check, from any thread.
+ *
+ * Settings read once per server start (ports, timeouts, queue limits) are still read from the
+ * settings object; subscribers to OnChanged apply what can change while the server runs.
+ */
+struct FUnrealMCPRuntimeConfig
+{
+    bool bProtocolVerboseLogs = false;
+    bool bJsonLogs = true;
+    FString LogsDirectory;
+
+    bool bRequireCheckout = false;
+    bool bAllowUndoFreeMutations = false;
+    bool bAlwaysEmitAudit = false;
+    bool bEnableSourceControl = true;
+
+    float GameThreadBudgetMs = 8.0f;
+    int32 ResponseCacheMaxEntries = 512;
+    bool bSpeculativePrefetch = false;
+    int32 PrefetchFollowUps = 3;
+    float RequestDedupWindowSec = 600.0f;
+    float JobRetentionMin = 60.0f;
+
+    float BlueprintCompileDebounceMs = 500.0f;
+    bool bDeferBlueprintCompiles = false;
+
+    int32 MemoryCeilingMb = 0;
+    float IdleGcSec = 30.0f;
+    bool bReleaseAssetsLoadedByCommands = true;
+    int32 MaxUndoMemoryMb = 256;
+
+    bool operator==(const FUnrealMCPRuntimeConfig& Other) const;
+
+    /** The current snapshot; built from the settings on first use. Lock-free, safe from any thread. */
+    static const FUnrealMCPRuntimeConfig& Get();
+
+    /**
+     * Rebuilds the snapshot from UUnrealMCPSettings and, if anything differs, publishes it and
+     * broadcasts OnChanged. Game thread.
+     */
+    static void Refresh();
+
+    /** Broadcast on the game thread after a new snapshot is published; Get already returns it. */
+    static FSimpleMulticastDelegate& OnChanged();
+
+    /** Builds the first snapshot and follows settings edits; the editor module calls these. */
+    static void Start();
+    static void Stop();
+};
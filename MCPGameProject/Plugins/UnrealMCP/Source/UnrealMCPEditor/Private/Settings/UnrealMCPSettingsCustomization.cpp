@@ -6,6 +6,7 @@
 #include "DetailWidgetRow.h"
 #include "IDetailGroup.h"
 #include "Settings/UnrealMCPDiagnostics.h"
+#include "UnrealMCPSettings.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/SBoxPanel.h"
 #include "Widgets/Text/STextBlock.h"
@@ -70,6 +71,15 @@ void FUnrealMCPSettingsCustomization::CustomizeDetails(IDetailLayoutBuilder& Det
                         .Text(LOCTEXT("TailLogsButton", "Tail Logs"))
                         .OnClicked(this, &FUnrealMCPSettingsCustomization::OnTailLogs)
                 ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                        SNew(SButton)
+                        .Text(LOCTEXT("RunBenchmarkButton", "Run Benchmark"))
+                        .ToolTipText(LOCTEXT("RunBenchmarkTooltip", "Load the running server with the Benchmark* settings and report throughput, latency and frame time."))
+                        .IsEnabled_Lambda([]() { return !FUnrealMCPDiagnostics::IsBenchmarkRunning(); })
+                        .OnClicked(this, &FUnrealMCPSettingsCustomization::OnRunBenchmark)
+                ]
         ];
 }
 
@@ -121,6 +131,30 @@ FReply FUnrealMCPSettingsCustomization::OnTailLogs()
         return FReply::Handled();
 }
 
+FReply FUnrealMCPSettingsCustomization::OnRunBenchmark()
+{
+        FText Message;
+        FUnrealMCPBenchmarkOptions Options;
+        FString Error;
+        if (!FUnrealMCPDiagnostics::MakeBenchmarkOptions(*GetDefault<UUnrealMCPSettings>(), Options, Error))
+        {
+                ShowResultDialog(FText::FromString(Error), false);
+                return FReply::Handled();
+        }
+
+        // The panel may be closed before the run ends, so the report does not go through this.
+        const bool bStarted = FUnrealMCPDiagnostics::StartBenchmark(Options, [](const FText& Report, bool bSuccess)
+        {
+                const FText Title = bSuccess ? LOCTEXT("BenchmarkTitle", "Benchmark") : LOCTEXT("BenchmarkFailureTitle", "Benchmark Error");
+                FMessageDialog::Open(EAppMsgType::Ok, Report, &Title);
+        }, Message);
+        if (!bStarted)
+        {
+                ShowResultDialog(Message, false);
+        }
+        return FReply::Handled();
+}
+
 void FUnrealMCPSettingsCustomization::ShowResultDialog(const FText& Message, bool bSuccess) const
 {
         const FText Title = bSuccess ? LOCTEXT("DiagnosticsSuccessTitle", "Diagnostics") : LOCTEXT("DiagnosticsFailureTitle", "Diagnostics Error");
@@ -17,6 +17,7 @@ private:
         FReply OnOpenEventsLog();
         FReply OnOpenMetricsLog();
         FReply OnTailLogs();
+        FReply OnRunBenchmark();
 
         void ShowResultDialog(const FText& Message, bool bSuccess) const;
 };
@@ -2,14 +2,18 @@
 #include "CoreMinimal.h"
 #include "UnrealMCPSettings.h"
 
+#include "Containers/Ticker.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
 #include "ISourceControlModule.h"
 #include "ISourceControlOperation.h"
 #include "ISourceControlProvider.h"
 #include "ISourceControlState.h"
 #include "Misc/PackageName.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Settings/UnrealMCPRuntimeConfig.h"
 #include "SourceControlOperations.h"
 #if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4)
 #include "SourceControlOperationBase.h"
@@ -23,20 +27,33 @@ namespace
                 FPaths::NormalizeFilename(Normalized);
                 return Normalized;
         }
+
+        /**
+         * Files this editor session knows to be checked out or added, for the provider named
+         * GCheckedOutProvider. Switching providers starts over.
+         */
+        FCriticalSection GCheckedOutMutex;
+        TSet<FString> GCheckedOutFiles;
+        FName GCheckedOutProvider;
+
+        /** Files checked out or added by MCP, with when; the background refresh re-queries these. */
+        TMap<FString, double> GRecentlyTouched;
+        constexpr double RecentlyTouchedSeconds = 1800.0;
+
+        FTSTicker::FDelegateHandle GRefreshTickerHandle;
+        TSharedPtr<FSourceControlService::FOperationResult, ESPMode::ThreadSafe> GRefreshPending;
 }
 
 bool FSourceControlService::IsEnabled()
 {
-        const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
-        return Settings && Settings->EnableSourceControl;
+        return FUnrealMCPRuntimeConfig::Get().bEnableSourceControl;
 }
 
 bool FSourceControlService::EnsureProviderReady(FString& OutError)
 {
         OutError.Reset();
 
-        const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
-        if (!Settings || !Settings->EnableSourceControl)
+        if (!FUnrealMCPRuntimeConfig::Get().bEnableSourceControl)
         {
                 OutError = TEXT("Source control integration is disabled");
                 return false;
@@ -73,12 +90,37 @@ bool FSourceControlService::EnsureProviderReady(FString& OutError)
                 return false;
         }
 
+        {
+                FScopeLock Lock(&GCheckedOutMutex);
+                if (GCheckedOutProvider != Provider.GetName())
+                {
+                        GCheckedOutProvider = Provider.GetName();
+                        GCheckedOutFiles.Reset();
+                }
+        }
+
         return true;
 }
 
 bool FSourceControlService::UpdateStatus(const TArray<FString>& Files, TMap<FString, FString>& OutPerFileState, FString& OutError)
 {
-        OutPerFileState.Reset();
+        const FOperationResultRef Result = BeginOperation(EOperation::UpdateStatus, Files, FString(), false);
+        OutPerFileState = MoveTemp(Result->PerFileState);
+        OutError = Result->Error;
+        return Result->bSucceeded;
+}
+
+bool FSourceControlService::Checkout(const TArray<FString>& Files, TMap<FString, bool>& OutPerFileOk, FString& OutError)
+{
+        const FOperationResultRef Result = BeginOperation(EOperation::Checkout, Files, FString(), false);
+        OutPerFileOk = MoveTemp(Result->PerFileOk);
+        OutError = Result->Error;
+        return Result->bSucceeded;
+}
+
+bool FSourceControlService::EnsureCheckedOut(const TArray<FString>& Files, TMap<FString, bool>& OutPerFileOk, FString& OutError)
+{
+        OutPerFileOk.Reset();
         OutError.Reset();
 
         FString ReadyError;
@@ -88,172 +130,356 @@ bool FSourceControlService::UpdateStatus(const TArray<FString>& Files, TMap<FStr
                 return false;
         }
 
-        if (Files.Num() == 0)
-        {
-                return true;
-        }
-
         TArray<FString> ExistingFiles;
         CollectExistingFiles(Files, ExistingFiles);
 
-        if (ExistingFiles.Num() == 0)
-        {
-                return true;
-        }
-
         ISourceControlProvider& Provider = ISourceControlModule::Get().GetProvider();
 
-        TSharedRef<FUpdateStatus, ESPMode::ThreadSafe> Operation = ISourceControlOperation::Create<FUpdateStatus>();
-        Operation->SetUpdateHistory(true);
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4)
-        const ECommandResult::Type Result = Provider.Execute(Operation, ExistingFiles, EConcurrency::Synchronous, FSourceControlOperationComplete());
-#else
-        const ECommandResult::Type Result = Provider.Execute(Operation, ExistingFiles, EConcurrency::Synchronous);
-#endif
-        if (Result != ECommandResult::Succeeded)
-        {
-                OutError = TEXT("Failed to update source control status");
-                return false;
-        }
-
+        // Only files still read-only go to the server; the provider's cached state costs nothing.
+        TArray<FString> Pending;
         for (const FString& File : ExistingFiles)
         {
-                const FSourceControlStatePtr State = Provider.GetState(File, EStateCacheUsage::Use);
-                if (State.IsValid())
+                bool bWritable = IsKnownCheckedOut(File);
+                if (!bWritable)
                 {
-                        OutPerFileState.Add(File, DescribeState(*State));
+                        const FSourceControlStatePtr State = Provider.GetState(File, EStateCacheUsage::Use);
+                        bWritable = State.IsValid() && (State->IsCheckedOut() || State->IsAdded());
+                }
+
+                if (bWritable)
+                {
+                        OutPerFileOk.Add(File, true);
                 }
                 else
                 {
-                        OutPerFileState.Add(File, TEXT("Unknown"));
+                        Pending.Add(File);
                 }
         }
 
-        return true;
+        if (Pending.Num() == 0)
+        {
+                RememberCheckedOut(OutPerFileOk);
+                return true;
+        }
+
+        TMap<FString, bool> PendingResult;
+        const bool bSucceeded = Checkout(Pending, PendingResult, OutError);
+        OutPerFileOk.Append(PendingResult);
+        RememberCheckedOut(OutPerFileOk);
+        return bSucceeded;
 }
 
-bool FSourceControlService::Checkout(const TArray<FString>& Files, TMap<FString, bool>& OutPerFileOk, FString& OutError)
+bool FSourceControlService::MarkForAdd(const TArray<FString>& Files, TMap<FString, bool>& OutPerFileOk, FString& OutError)
 {
-        OutPerFileOk.Reset();
-        OutError.Reset();
+        const FOperationResultRef Result = BeginOperation(EOperation::MarkForAdd, Files, FString(), false);
+        OutPerFileOk = MoveTemp(Result->PerFileOk);
+        OutError = Result->Error;
+        return Result->bSucceeded;
+}
+
+bool FSourceControlService::Revert(const TArray<FString>& Files, TMap<FString, bool>& OutPerFileOk, FString& OutError)
+{
+        const FOperationResultRef Result = BeginOperation(EOperation::Revert, Files, FString(), false);
+        OutPerFileOk = MoveTemp(Result->PerFileOk);
+        OutError = Result->Error;
+        return Result->bSucceeded;
+}
+
+bool FSourceControlService::Submit(const TArray<FString>& Files, const FString& Description, TMap<FString, bool>& OutPerFileOk, FString& OutError)
+{
+        const FOperationResultRef Result = BeginOperation(EOperation::Submit, Files, Description, false);
+        OutPerFileOk = MoveTemp(Result->PerFileOk);
+        OutError = Result->Error;
+        return Result->bSucceeded;
+}
+
+FSourceControlService::FOperationResultRef FSourceControlService::BeginOperation(EOperation Operation, const TArray<FString>& Files, const FString& Description, bool bAsync)
+{
+        check(IsInGameThread());
+
+        const FOperationResultRef Result = MakeShared<FOperationResult, ESPMode::ThreadSafe>();
+        auto Complete = [&Result](bool bSucceeded, const FString& Error = FString())
+        {
+                Result->bSucceeded = bSucceeded;
+                Result->Error = Error;
+                Result->bDone = true;
+                return Result;
+        };
 
         FString ReadyError;
         if (!EnsureProviderReady(ReadyError))
         {
-                OutError = ReadyError;
-                return false;
+                return Complete(false, ReadyError);
+        }
+
+        if (Operation == EOperation::Submit && Description.IsEmpty())
+        {
+                return Complete(false, TEXT("Description is required for submit"));
         }
 
         ISourceControlProvider& Provider = ISourceControlModule::Get().GetProvider();
 
-        if (Provider.GetName() == TEXT("Git"))
+        if (Operation == EOperation::Checkout && Provider.GetName() == TEXT("Git"))
         {
                 for (const FString& File : Files)
                 {
-                        OutPerFileOk.Add(File, true);
+                        Result->PerFileOk.Add(File, true);
                 }
-                return true;
+                return Complete(true);
         }
 
-        return ExecuteSimpleOperation(Files, []()
+        TArray<FString> ExistingFiles;
+        CollectExistingFiles(Files, ExistingFiles);
+
+        if (ExistingFiles.Num() == 0 && Operation != EOperation::Submit)
         {
-                return ISourceControlOperation::Create<FCheckOut>();
-        }, OutPerFileOk, OutError);
+                return Complete(true);
+        }
+
+        TSharedRef<ISourceControlOperation, ESPMode::ThreadSafe> ProviderOperation = [Operation, &Description]() -> TSharedRef<ISourceControlOperation, ESPMode::ThreadSafe>
+        {
+                switch (Operation)
+                {
+                case EOperation::UpdateStatus:
+                {
+                        TSharedRef<FUpdateStatus, ESPMode::ThreadSafe> StatusOperation = ISourceControlOperation::Create<FUpdateStatus>();
+                        StatusOperation->SetUpdateHistory(true);
+                        return StatusOperation;
+                }
+                case EOperation::Checkout:
+                        return ISourceControlOperation::Create<FCheckOut>();
+                case EOperation::MarkForAdd:
+                        return ISourceControlOperation::Create<FMarkForAdd>();
+                case EOperation::Revert:
+                        return ISourceControlOperation::Create<FRevert>();
+                case EOperation::Submit:
+                default:
+                {
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4)
+                        TSharedRef<FCheckIn, ESPMode::ThreadSafe> CheckInOperation = ISourceControlOperation::Create<FCheckIn>();
+                        CheckInOperation->SetDescription(FText::FromString(Description));
+                        return CheckInOperation;
+#else
+                        TSharedRef<FSubmit, ESPMode::ThreadSafe> SubmitOperation = ISourceControlOperation::Create<FSubmit>();
+                        SubmitOperation->SetDescription(Description);
+                        return SubmitOperation;
+#endif
+                }
+                }
+        }();
+        Result->ProviderOperation = ProviderOperation;
+
+        if (Operation == EOperation::Revert)
+        {
+                // Forgotten even on failure: a partial revert leaves the state unknown until the next status.
+                ForgetCheckedOut(ExistingFiles);
+        }
+
+        // The provider calls back on the game thread: at once for synchronous runs, from its tick otherwise.
+        const FSourceControlOperationComplete OnComplete = FSourceControlOperationComplete::CreateLambda([Operation, Result, ExistingFiles](const FSourceControlOperationRef&, ECommandResult::Type CommandResult)
+        {
+                FinishOperation(Operation, Result, ExistingFiles, CommandResult == ECommandResult::Succeeded, CommandResult == ECommandResult::Cancelled);
+        });
+
+        const ECommandResult::Type CommandResult = Provider.Execute(ProviderOperation, ExistingFiles, bAsync ? EConcurrency::Asynchronous : EConcurrency::Synchronous, OnComplete);
+
+        // Some providers report a synchronous (or rejected) run only through the return value.
+        if (!bAsync || CommandResult != ECommandResult::Succeeded)
+        {
+                FinishOperation(Operation, Result, ExistingFiles, CommandResult == ECommandResult::Succeeded, CommandResult == ECommandResult::Cancelled);
+        }
+
+        return Result;
 }
 
-bool FSourceControlService::MarkForAdd(const TArray<FString>& Files, TMap<FString, bool>& OutPerFileOk, FString& OutError)
+void FSourceControlService::CancelOperation(const FOperationResultRef& Result)
 {
-        OutPerFileOk.Reset();
-        OutError.Reset();
+        check(IsInGameThread());
 
-        FString ReadyError;
-        if (!EnsureProviderReady(ReadyError))
+        if (Result->bDone || !Result->ProviderOperation.IsValid())
         {
-                OutError = ReadyError;
-                return false;
+                return;
         }
 
-        return ExecuteSimpleOperation(Files, []()
+        ISourceControlProvider& Provider = ISourceControlModule::Get().GetProvider();
+        const FSourceControlOperationRef Operation = Result->ProviderOperation.ToSharedRef();
+        if (Provider.CanCancelOperation(Operation))
         {
-                return ISourceControlOperation::Create<FMarkForAdd>();
-        }, OutPerFileOk, OutError);
+                Provider.CancelOperation(Operation);
+        }
 }
 
-bool FSourceControlService::Revert(const TArray<FString>& Files, TMap<FString, bool>& OutPerFileOk, FString& OutError)
+void FSourceControlService::FinishOperation(EOperation Operation, const FOperationResultRef& Result, const TArray<FString>& Files, bool bSucceeded, bool bCancelled)
 {
-        OutPerFileOk.Reset();
-        OutError.Reset();
+        if (Result->bDone)
+        {
+                return;
+        }
 
-        FString ReadyError;
-        if (!EnsureProviderReady(ReadyError))
+        Result->bSucceeded = bSucceeded;
+        Result->bCancelled = bCancelled;
+        if (!bSucceeded)
         {
-                OutError = ReadyError;
-                return false;
+                if (bCancelled)
+                {
+                        Result->Error = TEXT("Source control operation was cancelled");
+                }
+                else if (Operation == EOperation::UpdateStatus)
+                {
+                        Result->Error = TEXT("Failed to update source control status");
+                }
+                else if (Operation == EOperation::Submit)
+                {
+                        Result->Error = TEXT("Failed to submit to source control");
+                }
+                else
+                {
+                        Result->Error = TEXT("Source control operation failed");
+                }
         }
 
-        return ExecuteSimpleOperation(Files, []()
+        switch (Operation)
         {
-                return ISourceControlOperation::Create<FRevert>();
-        }, OutPerFileOk, OutError);
+        case EOperation::UpdateStatus:
+                if (bSucceeded)
+                {
+                        FString CacheError;
+                        GetCachedStatus(Files, Result->PerFileState, CacheError);
+                }
+                break;
+        case EOperation::Submit:
+                if (bSucceeded)
+                {
+                        for (const FString& File : Files)
+                        {
+                                Result->PerFileOk.Add(File, true);
+                        }
+                        ForgetCheckedOut(Files);
+                }
+                break;
+        default:
+                for (const FString& File : Files)
+                {
+                        Result->PerFileOk.Add(File, bSucceeded);
+                }
+                if (Operation == EOperation::Checkout || Operation == EOperation::MarkForAdd)
+                {
+                        RememberCheckedOut(Result->PerFileOk);
+                        if (bSucceeded)
+                        {
+                                FScopeLock Lock(&GCheckedOutMutex);
+                                const double Now = FPlatformTime::Seconds();
+                                for (const FString& File : Files)
+                                {
+                                        GRecentlyTouched.Add(File, Now);
+                                }
+                        }
+                }
+                break;
+        }
+
+        Result->ProviderOperation.Reset();
+        Result->bDone = true;
 }
 
-bool FSourceControlService::Submit(const TArray<FString>& Files, const FString& Description, TMap<FString, bool>& OutPerFileOk, FString& OutError)
+bool FSourceControlService::GetCachedStatus(const TArray<FString>& Files, TMap<FString, FString>& OutPerFileState, FString& OutError)
 {
-        OutPerFileOk.Reset();
+        OutPerFileState.Reset();
         OutError.Reset();
 
-        FString ReadyError;
-        if (!EnsureProviderReady(ReadyError))
+        if (!ISourceControlModule::Get().IsEnabled())
         {
-                OutError = ReadyError;
+                OutError = TEXT("Source control module is disabled");
                 return false;
         }
 
-        if (Description.IsEmpty())
-        {
-                OutError = TEXT("Description is required for submit");
-                return false;
-        }
+        TArray<FString> ExistingFiles;
+        CollectExistingFiles(Files, ExistingFiles);
 
         ISourceControlProvider& Provider = ISourceControlModule::Get().GetProvider();
-
-        TSharedRef<ISourceControlOperation, ESPMode::ThreadSafe> Operation =
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4)
-                [&Description]()
+        TMap<FString, bool> Writable;
+        for (const FString& File : ExistingFiles)
+        {
+                const FSourceControlStatePtr State = Provider.GetState(File, EStateCacheUsage::Use);
+                if (State.IsValid())
                 {
-                        TSharedRef<FCheckIn, ESPMode::ThreadSafe> CheckInOperation = ISourceControlOperation::Create<FCheckIn>();
-                        CheckInOperation->SetDescription(FText::FromString(Description));
-                        return StaticCastSharedRef<ISourceControlOperation>(CheckInOperation);
-                }();
-#else
-                [&Description]()
+                        OutPerFileState.Add(File, DescribeState(*State));
+                        Writable.Add(File, State->IsCheckedOut() || State->IsAdded());
+                }
+                else
                 {
-                        TSharedRef<FSubmit, ESPMode::ThreadSafe> SubmitOperation = ISourceControlOperation::Create<FSubmit>();
-                        SubmitOperation->SetDescription(Description);
-                        return StaticCastSharedRef<ISourceControlOperation>(SubmitOperation);
-                }();
-#endif
+                        OutPerFileState.Add(File, TEXT("Unknown"));
+                }
+        }
+        RememberCheckedOut(Writable);
 
-        TArray<FString> ExistingFiles;
-        CollectExistingFiles(Files, ExistingFiles);
+        return true;
+}
 
-        const ECommandResult::Type Result =
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4)
-                Provider.Execute(Operation, ExistingFiles, EConcurrency::Synchronous, FSourceControlOperationComplete());
-#else
-                Provider.Execute(Operation, ExistingFiles, EConcurrency::Synchronous);
-#endif
-        if (Result != ECommandResult::Succeeded)
+void FSourceControlService::StartStatusRefresh()
+{
+        check(IsInGameThread());
+
+        const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+        const float IntervalSeconds = Settings ? Settings->SourceControlRefreshIntervalSec : 0.0f;
+        if (GRefreshTickerHandle.IsValid() || IntervalSeconds <= 0.0f)
         {
-                OutError = TEXT("Failed to submit to source control");
-                return false;
+                return;
         }
 
-        for (const FString& File : ExistingFiles)
+        GRefreshTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FSourceControlService::TickStatusRefresh), IntervalSeconds);
+}
+
+void FSourceControlService::StopStatusRefresh()
+{
+        if (GRefreshTickerHandle.IsValid())
+        {
+                FTSTicker::GetCoreTicker().RemoveTicker(GRefreshTickerHandle);
+                GRefreshTickerHandle.Reset();
+        }
+
+        if (GRefreshPending.IsValid())
+        {
+                CancelOperation(GRefreshPending.ToSharedRef());
+                GRefreshPending.Reset();
+        }
+}
+
+bool FSourceControlService::TickStatusRefresh(float DeltaTime)
+{
+        // One refresh at a time; a slow server just skips ticks.
+        if (GRefreshPending.IsValid() && !GRefreshPending->bDone)
         {
-                OutPerFileOk.Add(File, true);
+                return true;
         }
+        GRefreshPending.Reset();
 
+        if (!IsEnabled() || !ISourceControlModule::Get().IsEnabled() || !ISourceControlModule::Get().GetProvider().IsAvailable())
+        {
+                return true;
+        }
+
+        TArray<FString> Files;
+        {
+                FScopeLock Lock(&GCheckedOutMutex);
+                const double Cutoff = FPlatformTime::Seconds() - RecentlyTouchedSeconds;
+                for (auto It = GRecentlyTouched.CreateIterator(); It; ++It)
+                {
+                        if (It.Value() < Cutoff)
+                        {
+                                It.RemoveCurrent();
+                        }
+                        else
+                        {
+                                Files.Add(It.Key());
+                        }
+                }
+        }
+
+        if (Files.Num() > 0)
+        {
+                GRefreshPending = BeginOperation(EOperation::UpdateStatus, Files, FString(), true);
+        }
         return true;
 }
 
@@ -320,57 +546,6 @@ void FSourceControlService::AppendStatusArray(const TMap<FString, FString>& PerF
         }
 }
 
-bool FSourceControlService::ExecuteSimpleOperation(const TArray<FString>& Files, const TFunctionRef<TSharedRef<ISourceControlOperation>(void)>& OperationFactory, TMap<FString, bool>& OutPerFileOk, FString& OutError)
-{
-        TArray<FString> ExistingFiles;
-        CollectExistingFiles(Files, ExistingFiles);
-
-        if (ExistingFiles.Num() == 0)
-        {
-                return true;
-        }
-
-        ISourceControlProvider& Provider = ISourceControlModule::Get().GetProvider();
-
-        bool bAllSucceeded = true;
-#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4)
-        const TSharedRef<ISourceControlOperation, ESPMode::ThreadSafe> Operation = OperationFactory();
-        const ECommandResult::Type Result = Provider.Execute(Operation, ExistingFiles, EConcurrency::Synchronous, FSourceControlOperationComplete());
-        const bool bSucceeded = Result == ECommandResult::Succeeded;
-        for (const FString& File : ExistingFiles)
-        {
-                OutPerFileOk.Add(File, bSucceeded);
-        }
-        if (!bSucceeded)
-        {
-                bAllSucceeded = false;
-                if (OutError.IsEmpty())
-                {
-                        OutError = TEXT("Source control operation failed");
-                }
-        }
-#else
-        for (const FString& File : ExistingFiles)
-        {
-                const TSharedRef<ISourceControlOperation, ESPMode::ThreadSafe> Operation = OperationFactory();
-                const ECommandResult::Type Result = Provider.Execute(Operation, File);
-                const bool bSucceeded = Result == ECommandResult::Succeeded;
-                OutPerFileOk.Add(File, bSucceeded);
-
-                if (!bSucceeded)
-                {
-                        bAllSucceeded = false;
-                        if (OutError.IsEmpty())
-                        {
-                                OutError = TEXT("Source control operation failed");
-                        }
-                }
-        }
-#endif
-
-        return bAllSucceeded;
-}
-
 FString FSourceControlService::DescribeState(const ISourceControlState& State)
 {
         if (State.IsDeleted())
@@ -430,3 +605,34 @@ bool FSourceControlService::CollectExistingFiles(const TArray<FString>& Files, T
 
         return OutExistingFiles.Num() > 0;
 }
+
+bool FSourceControlService::IsKnownCheckedOut(const FString& File)
+{
+        FScopeLock Lock(&GCheckedOutMutex);
+        return GCheckedOutFiles.Contains(File);
+}
+
+void FSourceControlService::RememberCheckedOut(const TMap<FString, bool>& PerFileOk)
+{
+        FScopeLock Lock(&GCheckedOutMutex);
+        for (const TPair<FString, bool>& Pair : PerFileOk)
+        {
+                if (Pair.Value)
+                {
+                        GCheckedOutFiles.Add(Pair.Key);
+                }
+                else
+                {
+                        GCheckedOutFiles.Remove(Pair.Key);
+                }
+        }
+}
+
+void FSourceControlService::ForgetCheckedOut(const TArray<FString>& Files)
+{
+        FScopeLock Lock(&GCheckedOutMutex);
+        for (const FString& File : Files)
+        {
+                GCheckedOutFiles.Remove(NormalizeFilePath(File));
+        }
+}
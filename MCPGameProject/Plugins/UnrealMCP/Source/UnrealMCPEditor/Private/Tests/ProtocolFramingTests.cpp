@@ -0,0 +1,221 @@
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/AutomationTest.h"
+#include "Protocol/FrameCodec.h"
+#include "Protocol/Protocol.h"
+#include "Protocol/Transport.h"
+
+namespace
+{
+    using namespace UnrealMCP::Protocol;
+
+    /** Frame limit enforced by Protocol.cpp; kept in step with MaxFrameSize there. */
+    constexpr int32 MaxFrameBytes = 4 * 1024 * 1024;
+
+    /** An in-memory stream: Send appends, Recv consumes, and an empty buffer reads as closed. */
+    class FMemoryByteStream : public IByteStream
+    {
+    public:
+        void Reset(const TArray<uint8>& Bytes)
+        {
+            Buffer = Bytes;
+            ReadOffset = 0;
+        }
+
+        virtual bool Recv(uint8* Data, int32 MaxBytes, int32& OutBytesRead, bool& bOutWouldBlock) override
+        {
+            OutBytesRead = FMath::Min(MaxBytes, Buffer.Num() - ReadOffset);
+            FMemory::Memcpy(Data, Buffer.GetData() + ReadOffset, OutBytesRead);
+            ReadOffset += OutBytesRead;
+            bOutWouldBlock = false;
+            return true;
+        }
+
+        virtual bool Send(const uint8* Data, int32 Length, int32& OutBytesSent, bool& bOutWouldBlock) override
+        {
+            Buffer.Append(Data, Length);
+            OutBytesSent = Length;
+            bOutWouldBlock = false;
+            return true;
+        }
+
+        virtual bool Wait(EStreamWait Condition, double TimeoutSeconds) override { return true; }
+        virtual bool IsConnected() const override { return true; }
+        virtual void Shutdown() override {}
+        virtual void Close() override {}
+        virtual FString DescribeLastError(const TCHAR* Operation) const override { return FString(); }
+        virtual const TCHAR* GetTransportName() const override { return TEXT("memory"); }
+
+    private:
+        TArray<uint8> Buffer;
+        int32 ReadOffset = 0;
+    };
+
+    TSharedRef<FJsonObject> MakeSampleMessage()
+    {
+        TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+        Params->SetStringField(TEXT("path"), TEXT("/Game/Maps/Caf\u00E9"));
+        Params->SetNumberField(TEXT("limit"), 25);
+        Params->SetBoolField(TEXT("recursive"), true);
+        TArray<TSharedPtr<FJsonValue>> Classes;
+        Classes.Add(MakeShared<FJsonValueString>(TEXT("StaticMesh")));
+        Classes.Add(MakeShared<FJsonValueString>(TEXT("Material")));
+        Params->SetArrayField(TEXT("classes"), Classes);
+
+        TSharedRef<FJsonObject> Message = MakeShared<FJsonObject>();
+        Message->SetStringField(TEXT("type"), TEXT("asset.find"));
+        Message->SetStringField(TEXT("requestId"), TEXT("r1"));
+        Message->SetObjectField(TEXT("params"), Params);
+        return Message;
+    }
+
+    TSharedPtr<FJsonObject> DecodeJsonText(const ANSICHAR* Text, FString& OutError)
+    {
+        return UnrealMCP::Protocol::FrameCodec::Decode(reinterpret_cast<const uint8*>(Text), FCStringAnsi::Strlen(Text), EFrameEncoding::Json, OutError);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMCPFramingRoundTripTest, "UnrealMCP.Protocol.Framing.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealMCPFramingRoundTripTest::RunTest(const FString& Parameters)
+{
+    struct FVariant
+    {
+        const TCHAR* Name;
+        EFrameEncoding Encoding;
+        bool bCompression;
+    };
+    const FVariant Variants[] = {
+        { TEXT("json"), EFrameEncoding::Json, false },
+        { TEXT("cbor"), EFrameEncoding::Cbor, false },
+        { TEXT("json+zlib"), EFrameEncoding::Json, true },
+    };
+
+    FMemoryByteStream Stream;
+    for (const FVariant& Variant : Variants)
+    {
+        FFrameOptions Options;
+        Options.Encoding = Variant.Encoding;
+        Options.bCompression = Variant.bCompression;
+        Options.CompressionThreshold = 0;
+
+        const TSharedRef<FJsonObject> Sent = MakeSampleMessage();
+        TArray<uint8> Frame;
+        FString Error;
+        if (!TestTrue(FString::Printf(TEXT("%s: encodes"), Variant.Name), EncodeFrame(Sent, Frame, Error, Options)))
+        {
+            AddError(Error);
+            continue;
+        }
+
+        Stream.Reset(Frame);
+        const FProtocolReadResult Read = ReadFramedJson(Stream, 1.0, false, Options);
+        if (!TestTrue(FString::Printf(TEXT("%s: decodes"), Variant.Name), Read.bSuccess && Read.Message.IsValid()))
+        {
+            AddError(Read.Error);
+            continue;
+        }
+
+        const TSharedPtr<FJsonObject>* Params = nullptr;
+        TestEqual(FString::Printf(TEXT("%s: type"), Variant.Name), Read.Message->GetStringField(TEXT("type")), FString(TEXT("asset.find")));
+        TestEqual(FString::Printf(TEXT("%s: requestId"), Variant.Name), Read.Message->GetStringField(TEXT("requestId")), FString(TEXT("r1")));
+        if (TestTrue(FString::Printf(TEXT("%s: params"), Variant.Name), Read.Message->TryGetObjectField(TEXT("params"), Params)))
+        {
+            TestEqual(FString::Printf(TEXT("%s: path"), Variant.Name), (*Params)->GetStringField(TEXT("path")), FString(TEXT("/Game/Maps/Caf\u00E9")));
+            TestEqual(FString::Printf(TEXT("%s: limit"), Variant.Name), (*Params)->GetIntegerField(TEXT("limit")), 25);
+            TestTrue(FString::Printf(TEXT("%s: recursive"), Variant.Name), (*Params)->GetBoolField(TEXT("recursive")));
+            TestEqual(FString::Printf(TEXT("%s: classes"), Variant.Name), (*Params)->GetArrayField(TEXT("classes")).Num(), 2);
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMCPFramingOversizeTest, "UnrealMCP.Protocol.Framing.RejectsOversizeFrames",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealMCPFramingOversizeTest::RunTest(const FString& Parameters)
+{
+    // Writing: a message whose payload is over the limit is refused before anything is sent.
+    TSharedRef<FJsonObject> Large = MakeShared<FJsonObject>();
+    Large->SetStringField(TEXT("data"), FString::ChrN(MaxFrameBytes + 1, TEXT('x')));
+    TArray<uint8> Frame;
+    FString Error;
+    TestFalse(TEXT("Oversize message is not encoded"), EncodeFrame(Large, Frame, Error));
+    TestFalse(TEXT("Oversize encode reports an error"), Error.IsEmpty());
+
+    // Reading: a length prefix over the limit fails without reading (or allocating) the payload.
+    FMemoryByteStream Stream;
+    const uint32 DeclaredLength = static_cast<uint32>(MaxFrameBytes) + 1;
+    TArray<uint8> Header;
+    Header.Append(reinterpret_cast<const uint8*>(&DeclaredLength), sizeof(DeclaredLength));
+    Header.Append(reinterpret_cast<const uint8*>("{}"), 2);
+    Stream.Reset(Header);
+    const FProtocolReadResult Read = ReadFramedJson(Stream, 1.0, false);
+    TestFalse(TEXT("Oversize length prefix is rejected"), Read.bSuccess);
+    TestFalse(TEXT("Oversize length prefix is not a timeout"), Read.bTimeout);
+    TestFalse(TEXT("Oversize length prefix is not mistaken for legacy input"), Read.bLegacyFallback);
+
+    // A payload of exactly the limit still goes through.
+    FMemoryByteStream Boundary;
+    const uint32 BoundaryLength = static_cast<uint32>(MaxFrameBytes);
+    TArray<uint8> BoundaryFrame;
+    BoundaryFrame.Append(reinterpret_cast<const uint8*>(&BoundaryLength), sizeof(BoundaryLength));
+    const FString Padding = FString::ChrN(MaxFrameBytes - 11, TEXT('x'));
+    const FString Body = FString::Printf(TEXT("{\"data\":\"%s\"}"), *Padding);
+    const FTCHARToUTF8 Utf8(*Body);
+    BoundaryFrame.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    TestEqual(TEXT("Boundary frame has the limit's payload"), BoundaryFrame.Num(), MaxFrameBytes + static_cast<int32>(sizeof(uint32)));
+    Boundary.Reset(BoundaryFrame);
+    TestTrue(TEXT("Frame at the limit is accepted"), ReadFramedJson(Boundary, 1.0, false).bSuccess);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMCPJsonParserTest, "UnrealMCP.Protocol.Framing.JsonParser",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnrealMCPJsonParserTest::RunTest(const FString& Parameters)
+{
+    FString Error;
+
+    // Escapes: a surrogate pair becomes one code point, the same one a raw UTF-8 run produces.
+    TSharedPtr<FJsonObject> Escaped = DecodeJsonText("{\"s\":\"a\\u00e9\\u20ac\\ud83d\\ude00\\n\"}", Error);
+    TSharedPtr<FJsonObject> Raw = DecodeJsonText("{\"s\":\"a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\\n\"}", Error);
+    if (TestTrue(TEXT("Escaped string decodes"), Escaped.IsValid()) && TestTrue(TEXT("Raw string decodes"), Raw.IsValid()))
+    {
+        TestEqual(TEXT("Escapes match the raw UTF-8"), Escaped->GetStringField(TEXT("s")), Raw->GetStringField(TEXT("s")));
+    }
+
+    const ANSICHAR* Rejected[] = {
+        "{\"s\":\"a\\u0000b\"}",        // would truncate the FString
+        "{\"s\":\"\\ud83d\"}",          // high surrogate at the end of the string
+        "{\"s\":\"\\ud83dx\"}",         // high surrogate followed by a plain character
+        "{\"s\":\"\\ud83d\\u0041\"}",   // high surrogate followed by a non-surrogate escape
+        "{\"s\":\"\\ude00\"}",          // lone low surrogate
+        "{\"n\":012}",
+        "{\"n\":-01}",
+        "{\"n\":00.5}",
+    };
+    for (const ANSICHAR* Text : Rejected)
+    {
+        Error.Reset();
+        TestFalse(FString::Printf(TEXT("Rejects %hs"), Text), DecodeJsonText(Text, Error).IsValid());
+        TestFalse(FString::Printf(TEXT("Reports an error for %hs"), Text), Error.IsEmpty());
+    }
+
+    TSharedPtr<FJsonObject> Numbers = DecodeJsonText("{\"a\":0,\"b\":-0.5,\"c\":10,\"d\":0e2,\"e\":-0}", Error);
+    if (TestTrue(TEXT("Numbers without leading zeros decode"), Numbers.IsValid()))
+    {
+        TestEqual(TEXT("0"), Numbers->GetNumberField(TEXT("a")), 0.0);
+        TestEqual(TEXT("-0.5"), Numbers->GetNumberField(TEXT("b")), -0.5);
+        TestEqual(TEXT("10"), Numbers->GetNumberField(TEXT("c")), 10.0);
+        TestEqual(TEXT("0e2"), Numbers->GetNumberField(TEXT("d")), 0.0);
+    }
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,269 @@
+#include "Transactions/BulkEdit.h"
+#include "CoreMinimal.h"
+
+#include "Containers/Ticker.h"
+#include "Editor.h"
+#include "Engine/Selection.h"
+#include "HAL/PlatformTime.h"
+#include "LevelEditorViewport.h"
+#include "Misc/Guid.h"
+#include "UnrealMCPLog.h"
+
+#define LOCTEXT_NAMESPACE "UnrealMCPBulkEdit"
+
+namespace
+{
+        struct FBulkState
+        {
+                int32 Depth = 0;
+                /** Viewports this scope paused; only these get the override removed. */
+                TArray<FLevelEditorViewportClient*> PausedViewports;
+                bool bRedrawPending = false;
+                bool bInvalidateHitProxies = false;
+                bool bActorListChanged = false;
+                bool bSelectionChanged = false;
+
+                /** The client-held scope from editor.bulk_begin, which holds one level of Depth. */
+                FString ExplicitId;
+                double ExplicitOpenedSeconds = 0.0;
+                double ExplicitIdleTimeoutSeconds = 0.0;
+                double ExplicitLastActivitySeconds = 0.0;
+                FTSTicker::FDelegateHandle TickerHandle;
+        };
+
+        FBulkState& GetState()
+        {
+                static FBulkState State;
+                return State;
+        }
+
+        FText GetRealtimeOverrideName()
+        {
+                return LOCTEXT("RealtimeOverride", "MCP bulk edit");
+        }
+}
+
+void FBulkEdit::Enter()
+{
+        check(IsInGameThread());
+
+        if (GetState().Depth++ == 0)
+        {
+                Suspend();
+        }
+}
+
+void FBulkEdit::Leave()
+{
+        check(IsInGameThread());
+
+        FBulkState& State = GetState();
+        if (!ensure(State.Depth > 0))
+        {
+                return;
+        }
+        if (--State.Depth == 0)
+        {
+                Resume();
+        }
+}
+
+bool FBulkEdit::IsActive()
+{
+        return GetState().Depth > 0;
+}
+
+void FBulkEdit::RedrawViewports(bool bInvalidateHitProxies)
+{
+        FBulkState& State = GetState();
+        if (State.Depth > 0)
+        {
+                State.bRedrawPending = true;
+                State.bInvalidateHitProxies |= bInvalidateHitProxies;
+                return;
+        }
+        if (GEditor)
+        {
+                GEditor->RedrawLevelEditingViewports(bInvalidateHitProxies);
+        }
+}
+
+void FBulkEdit::NoteActorListChanged()
+{
+        FBulkState& State = GetState();
+        if (State.Depth > 0)
+        {
+                State.bActorListChanged = true;
+                return;
+        }
+        if (GEditor)
+        {
+                GEditor->BroadcastLevelActorListChanged();
+        }
+}
+
+void FBulkEdit::NoteSelectionChange()
+{
+        FBulkState& State = GetState();
+        if (State.Depth > 0)
+        {
+                State.bSelectionChanged = true;
+                return;
+        }
+        if (GEditor)
+        {
+                GEditor->NoteSelectionChange();
+        }
+}
+
+bool FBulkEdit::OpenExplicit(double IdleTimeoutSeconds, FString& OutBulkId, FString& OutError)
+{
+        check(IsInGameThread());
+
+        FBulkState& State = GetState();
+        if (!State.ExplicitId.IsEmpty())
+        {
+                OutError = FString::Printf(TEXT("Bulk edit '%s' is already open"), *State.ExplicitId);
+                return false;
+        }
+
+        State.ExplicitId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphensLower);
+        State.ExplicitOpenedSeconds = FPlatformTime::Seconds();
+        State.ExplicitLastActivitySeconds = State.ExplicitOpenedSeconds;
+        State.ExplicitIdleTimeoutSeconds = FMath::Max(IdleTimeoutSeconds, 0.0);
+        if (State.ExplicitIdleTimeoutSeconds > 0.0)
+        {
+                State.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FBulkEdit::TickExplicit), 1.0f);
+        }
+        Enter();
+
+        OutBulkId = State.ExplicitId;
+        return true;
+}
+
+bool FBulkEdit::CloseExplicit(const FString& BulkId, double& OutDurationSeconds, FString& OutError)
+{
+        check(IsInGameThread());
+
+        FBulkState& State = GetState();
+        if (State.ExplicitId.IsEmpty() || State.ExplicitId != BulkId)
+        {
+                OutError = FString::Printf(TEXT("No open bulk edit with id '%s'"), *BulkId);
+                return false;
+        }
+
+        if (State.TickerHandle.IsValid())
+        {
+                FTSTicker::GetCoreTicker().RemoveTicker(State.TickerHandle);
+                State.TickerHandle.Reset();
+        }
+        OutDurationSeconds = FPlatformTime::Seconds() - State.ExplicitOpenedSeconds;
+        State.ExplicitId.Reset();
+        Leave();
+        return true;
+}
+
+void FBulkEdit::TouchExplicit()
+{
+        check(IsInGameThread());
+        FBulkState& State = GetState();
+        if (!State.ExplicitId.IsEmpty())
+        {
+                State.ExplicitLastActivitySeconds = FPlatformTime::Seconds();
+        }
+}
+
+void FBulkEdit::Suspend()
+{
+        FBulkState& State = GetState();
+        if (!GEditor)
+        {
+                return;
+        }
+
+        // Only viewports that are realtime right now are paused; the override is restored by name,
+        // so a user toggling realtime meanwhile is not overwritten.
+        for (FLevelEditorViewportClient* ViewportClient : GEditor->GetLevelViewportClients())
+        {
+                if (ViewportClient && ViewportClient->IsRealtime())
+                {
+                        ViewportClient->AddRealtimeOverride(false, GetRealtimeOverrideName());
+                        State.PausedViewports.Add(ViewportClient);
+                }
+        }
+
+        // Selection listeners (details panels, outliner highlighting, mode tools) hear of the whole
+        // scope's changes once, when the batch ends.
+        GEditor->GetSelectedActors()->BeginBatchSelectOperation();
+        GEditor->GetSelectedComponents()->BeginBatchSelectOperation();
+}
+
+void FBulkEdit::Resume()
+{
+        FBulkState& State = GetState();
+        const bool bRedraw = State.bRedrawPending || State.PausedViewports.Num() > 0;
+        const bool bInvalidateHitProxies = State.bInvalidateHitProxies;
+        const bool bActorListChanged = State.bActorListChanged;
+        const bool bSelectionChanged = State.bSelectionChanged;
+        TArray<FLevelEditorViewportClient*> PausedViewports = MoveTemp(State.PausedViewports);
+        State.PausedViewports.Reset();
+        State.bRedrawPending = false;
+        State.bInvalidateHitProxies = false;
+        State.bActorListChanged = false;
+        State.bSelectionChanged = false;
+
+        if (!GEditor)
+        {
+                return;
+        }
+
+        GEditor->GetSelectedComponents()->EndBatchSelectOperation(/*bNotify=*/true);
+        GEditor->GetSelectedActors()->EndBatchSelectOperation(/*bNotify=*/true);
+
+        // Viewports closed while paused are no longer in the list and are skipped.
+        for (FLevelEditorViewportClient* ViewportClient : GEditor->GetLevelViewportClients())
+        {
+                if (ViewportClient && PausedViewports.Contains(ViewportClient))
+                {
+                        ViewportClient->RemoveRealtimeOverride(GetRealtimeOverrideName(), /*bCheckMissingOverride=*/false);
+                }
+        }
+
+        if (bActorListChanged)
+        {
+                GEditor->BroadcastLevelActorListChanged();
+        }
+        if (bSelectionChanged)
+        {
+                GEditor->NoteSelectionChange();
+        }
+        if (bRedraw)
+        {
+                GEditor->RedrawLevelEditingViewports(bInvalidateHitProxies);
+        }
+}
+
+bool FBulkEdit::TickExplicit(float DeltaTime)
+{
+        FBulkState& State = GetState();
+        if (State.ExplicitId.IsEmpty())
+        {
+                return false;
+        }
+        if (FPlatformTime::Seconds() - State.ExplicitLastActivitySeconds < State.ExplicitIdleTimeoutSeconds)
+        {
+                return true;
+        }
+
+        UE_LOG(LogUnrealMCP, Warning, TEXT("FBulkEdit: Closing idle bulk edit '%s' after %.0f s"), *State.ExplicitId, State.ExplicitIdleTimeoutSeconds);
+
+        // The ticker goes away by returning false.
+        State.TickerHandle.Reset();
+        const FString BulkId = State.ExplicitId;
+        double Duration = 0.0;
+        FString Error;
+        CloseExplicit(BulkId, Duration, Error);
+        return false;
+}
+
+#undef LOCTEXT_NAMESPACE
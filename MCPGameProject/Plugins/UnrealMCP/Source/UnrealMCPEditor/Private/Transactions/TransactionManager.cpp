@@ -1,21 +1,388 @@
 #include "Transactions/TransactionManager.h"
 #include "CoreMinimal.h"
 
+#include "Containers/Ticker.h"
+#include "Transactions/BulkEdit.h"
 #include "Editor.h"
+#include "Editor/TransBuffer.h"
+#include "Editor/Transactor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Guid.h"
+#include "Protocol/CommandContext.h"
+#include "Settings/UnrealMCPRuntimeConfig.h"
+#include "UnrealMCPLog.h"
+
+#include <atomic>
+
+namespace
+{
+        struct FSharedTransaction
+        {
+                bool bOpen = false;
+                FString Id;
+                FString Name;
+                /** The undo buffer entry BeginTransaction pushed, so abort only ever undoes our own. */
+                const FTransaction* Transaction = nullptr;
+                double IdleTimeoutSeconds = 0.0;
+                double LastActivitySeconds = 0.0;
+                int32 Mutations = 0;
+                /** Begin calls currently joined to the shared transaction. */
+                int32 JoinedDepth = 0;
+                /** The transaction's size when the joined mutation began, to report what it added. */
+                int64 JoinStartBytes = 0;
+                FTSTicker::FDelegateHandle TickerHandle;
+        };
+
+        /** The transaction of a mutation running on its own, open from the outermost Begin to its End. */
+        struct FOwnTransaction
+        {
+                int32 Depth = 0;
+                /** Null when Begin joined an editor transaction that was already running. */
+                const FTransaction* Transaction = nullptr;
+        };
+
+        constexpr int64 BytesPerMb = 1024 * 1024;
+
+        FOwnTransaction GOwn;
+        int32 GUndoFreeDepth = 0;
+        /** Begin calls skipped while undo is suppressed, so their End is skipped too. */
+        int32 GSkippedDepth = 0;
+        /** Finished MCP transactions still in the undo buffer, as far as the last trim saw. */
+        TSet<const FTransaction*> GMcpTransactions;
+
+        std::atomic<int64> GHeldBytes{0};
+        std::atomic<int32> GHeldTransactions{0};
+        std::atomic<int64> GTrimmedBytes{0};
+        std::atomic<int32> GTrimmedTransactions{0};
+
+        int64 GetDataSize(const FTransaction* Transaction)
+        {
+                return Transaction ? static_cast<int64>(Transaction->DataSize()) : 0;
+        }
+
+        void ReportUndoBytes(int64 Bytes)
+        {
+                if (UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive())
+                {
+                        Context->AddUndoBytes(Bytes);
+                }
+        }
+
+        FSharedTransaction& GetShared()
+        {
+                static FSharedTransaction Shared;
+                return Shared;
+        }
+
+        const FTransaction* GetNewestTransaction()
+        {
+                if (!GEditor || !GEditor->Trans || GEditor->Trans->GetQueueLength() <= 0)
+                {
+                        return nullptr;
+                }
+                return GEditor->Trans->GetTransaction(GEditor->Trans->GetQueueLength() - 1);
+        }
+}
 
 void FTransactionManager::Begin(const FString& TransactionName)
 {
+        FSharedTransaction& Shared = GetShared();
+        if (Shared.bOpen)
+        {
+                if (Shared.JoinedDepth++ == 0)
+                {
+                        ++Shared.Mutations;
+                        Shared.JoinStartBytes = GetDataSize(Shared.Transaction);
+                }
+                Shared.LastActivitySeconds = FPlatformTime::Seconds();
+                return;
+        }
+        if (GUndoFreeDepth > 0)
+        {
+                ++GSkippedDepth;
+                return;
+        }
+
         if (GEditor)
         {
+                const bool bJoinsEditorTransaction = GEditor->IsTransactionActive();
                 const FText TransactionText = FText::FromString(TransactionName);
                 GEditor->BeginTransaction(TransactionText);
+                if (GOwn.Depth++ == 0)
+                {
+                        GOwn.Transaction = bJoinsEditorTransaction ? nullptr : GetNewestTransaction();
+                }
         }
 }
 
 void FTransactionManager::End()
 {
+        FSharedTransaction& Shared = GetShared();
+        if (Shared.JoinedDepth > 0)
+        {
+                if (--Shared.JoinedDepth == 0)
+                {
+                        ReportUndoBytes(GetDataSize(Shared.Transaction) - Shared.JoinStartBytes);
+                }
+                Shared.LastActivitySeconds = FPlatformTime::Seconds();
+                return;
+        }
+        if (GSkippedDepth > 0)
+        {
+                --GSkippedDepth;
+                return;
+        }
+
+        if (GEditor)
+        {
+                const bool bOutermost = GOwn.Depth > 0 && --GOwn.Depth == 0;
+                const FTransaction* Transaction = bOutermost ? GOwn.Transaction : nullptr;
+                // Measured while still open: an empty transaction is dropped on End.
+                const int64 Bytes = GetDataSize(Transaction);
+                GEditor->EndTransaction();
+                if (bOutermost)
+                {
+                        GOwn.Transaction = nullptr;
+                        ReportUndoBytes(Bytes);
+                        if (Transaction && GetNewestTransaction() == Transaction)
+                        {
+                                NoteFinished(Transaction);
+                        }
+                }
+        }
+}
+
+bool FTransactionManager::IsSharedOpen()
+{
+        return GetShared().bOpen;
+}
+
+bool FTransactionManager::BeginUndoFree(FString& OutError)
+{
+        check(IsInGameThread());
+
+        if (GetShared().bOpen)
+        {
+                OutError = FString::Printf(TEXT("Cannot skip undo inside the open transaction '%s'"), *GetShared().Name);
+                return false;
+        }
+        ++GUndoFreeDepth;
+        return true;
+}
+
+void FTransactionManager::EndUndoFree()
+{
+        if (GUndoFreeDepth == 0 || --GUndoFreeDepth > 0)
+        {
+                return;
+        }
+
+        if (GEditor && GEditor->Trans && GEditor->Trans->GetQueueLength() > 0)
+        {
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("FTransactionManager: Clearing %d undo steps after an undo-free mutation"), GEditor->Trans->GetQueueLength());
+                GEditor->ResetTransaction(FText::FromString(TEXT("MCP mutation without undo")));
+        }
+        GMcpTransactions.Reset();
+        GHeldBytes = 0;
+        GHeldTransactions = 0;
+}
+
+bool FTransactionManager::IsUndoSuppressed()
+{
+        return GUndoFreeDepth > 0;
+}
+
+FTransactionManager::FUndoStats FTransactionManager::GetUndoStats()
+{
+        FUndoStats Stats;
+        Stats.HeldBytes = GHeldBytes.load(std::memory_order_relaxed);
+        Stats.HeldTransactions = GHeldTransactions.load(std::memory_order_relaxed);
+        Stats.TrimmedBytes = GTrimmedBytes.load(std::memory_order_relaxed);
+        Stats.TrimmedTransactions = GTrimmedTransactions.load(std::memory_order_relaxed);
+        return Stats;
+}
+
+bool FTransactionManager::OpenShared(const FString& TransactionName, double IdleTimeoutSeconds, FString& OutTransactionId, FString& OutError)
+{
+        check(IsInGameThread());
+
+        FSharedTransaction& Shared = GetShared();
+        if (!GEditor)
+        {
+                OutError = TEXT("Editor instance unavailable");
+                return false;
+        }
+        if (Shared.bOpen)
+        {
+                OutError = FString::Printf(TEXT("Transaction '%s' is already open"), *Shared.Name);
+                return false;
+        }
+        if (GUndoFreeDepth > 0)
+        {
+                OutError = TEXT("Cannot open a transaction for a request that runs without undo");
+                return false;
+        }
+
+        GEditor->BeginTransaction(FText::FromString(TransactionName));
+        FBulkEdit::Enter();
+
+        Shared.bOpen = true;
+        Shared.Id = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphensLower);
+        Shared.Name = TransactionName;
+        Shared.Transaction = GetNewestTransaction();
+        Shared.IdleTimeoutSeconds = FMath::Max(IdleTimeoutSeconds, 0.0);
+        Shared.LastActivitySeconds = FPlatformTime::Seconds();
+        Shared.Mutations = 0;
+        Shared.JoinedDepth = 0;
+        if (Shared.IdleTimeoutSeconds > 0.0)
+        {
+                Shared.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FTransactionManager::TickShared), 1.0f);
+        }
+
+        OutTransactionId = Shared.Id;
+        return true;
+}
+
+bool FTransactionManager::CommitShared(const FString& TransactionId, int32& OutMutations, FString& OutError)
+{
+        return CloseShared(TransactionId, false, OutMutations, OutError);
+}
+
+bool FTransactionManager::AbortShared(const FString& TransactionId, int32& OutMutations, FString& OutError)
+{
+        return CloseShared(TransactionId, true, OutMutations, OutError);
+}
+
+bool FTransactionManager::CloseShared(const FString& TransactionId, bool bUndo, int32& OutMutations, FString& OutError)
+{
+        check(IsInGameThread());
+
+        FSharedTransaction& Shared = GetShared();
+        if (!Shared.bOpen || Shared.Id != TransactionId)
+        {
+                OutError = FString::Printf(TEXT("No open transaction with id '%s'"), *TransactionId);
+                return false;
+        }
+        if (Shared.JoinedDepth > 0)
+        {
+                OutError = TEXT("A mutation is still running inside the transaction");
+                return false;
+        }
+
+        if (Shared.TickerHandle.IsValid())
+        {
+                FTSTicker::GetCoreTicker().RemoveTicker(Shared.TickerHandle);
+        }
+
         if (GEditor)
         {
                 GEditor->EndTransaction();
+
+                // An empty transaction is dropped on End, in which case there is nothing to undo.
+                const FTransaction* Newest = GetNewestTransaction();
+                if (Newest && Newest == Shared.Transaction)
+                {
+                        if (bUndo)
+                        {
+                                GEditor->UndoTransaction(/*bCanRedo=*/false);
+                        }
+                        else
+                        {
+                                NoteFinished(Newest);
+                        }
+                }
+        }
+        FBulkEdit::Leave();
+
+        OutMutations = Shared.Mutations;
+        Shared = FSharedTransaction();
+        return true;
+}
+
+bool FTransactionManager::TickShared(float DeltaTime)
+{
+        FSharedTransaction& Shared = GetShared();
+        if (!Shared.bOpen)
+        {
+                return false;
+        }
+        if (Shared.JoinedDepth > 0 || FPlatformTime::Seconds() - Shared.LastActivitySeconds < Shared.IdleTimeoutSeconds)
+        {
+                return true;
+        }
+
+        UE_LOG(LogUnrealMCP, Warning, TEXT("FTransactionManager: Committing idle transaction '%s' after %.0f s (%d mutations)"), *Shared.Name, Shared.IdleTimeoutSeconds, Shared.Mutations);
+
+        // The ticker goes away by returning false.
+        Shared.TickerHandle.Reset();
+        int32 Mutations = 0;
+        FString Error;
+        CloseShared(Shared.Id, false, Mutations, Error);
+        return false;
+}
+
+void FTransactionManager::NoteFinished(const FTransaction* Transaction)
+{
+        GMcpTransactions.Add(Transaction);
+        TrimUndoBuffer();
+}
+
+void FTransactionManager::TrimUndoBuffer()
+{
+        UTransBuffer* Buffer = GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+        if (!Buffer || Buffer->IsActive())
+        {
+                return;
+        }
+
+        // Entries the editor dropped itself (its UndoBufferSize, a reset) are forgotten here.
+        TSet<const FTransaction*> Live;
+        TArray<int32> McpIndices;
+        TArray<int64> McpBytes;
+        int64 HeldBytes = 0;
+        const int32 UndoableCount = Buffer->UndoBuffer.Num() - Buffer->UndoCount;
+        int32 NewestUndoable = INDEX_NONE;
+        for (int32 Index = 0; Index < Buffer->UndoBuffer.Num(); ++Index)
+        {
+                const FTransaction* Transaction = &Buffer->UndoBuffer[Index].Get();
+                if (!GMcpTransactions.Contains(Transaction))
+                {
+                        continue;
+                }
+                Live.Add(Transaction);
+                McpIndices.Add(Index);
+                McpBytes.Add(GetDataSize(Transaction));
+                HeldBytes += McpBytes.Last();
+                if (Index < UndoableCount)
+                {
+                        NewestUndoable = McpIndices.Num() - 1;
+                }
+        }
+        GMcpTransactions = MoveTemp(Live);
+
+        // The newest MCP step stays, so the last command can always be undone.
+        const int64 CapBytes = static_cast<int64>(FUnrealMCPRuntimeConfig::Get().MaxUndoMemoryMb) * BytesPerMb;
+        int32 NumToRemove = 0;
+        int32 TrimmedTransactions = 0;
+        int64 TrimmedBytes = 0;
+        for (int32 McpIndex = 0; CapBytes > 0 && HeldBytes > CapBytes && McpIndex < NewestUndoable; ++McpIndex)
+        {
+                NumToRemove = McpIndices[McpIndex] + 1;
+                HeldBytes -= McpBytes[McpIndex];
+                TrimmedBytes += McpBytes[McpIndex];
+                ++TrimmedTransactions;
+                GMcpTransactions.Remove(&Buffer->UndoBuffer[McpIndices[McpIndex]].Get());
+        }
+
+        if (NumToRemove > 0)
+        {
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("FTransactionManager: Dropped the %d oldest undo steps (%d from MCP, %lld KB) to stay under MaxUndoMemoryMb=%d"),
+                        NumToRemove, TrimmedTransactions, TrimmedBytes / 1024, FUnrealMCPRuntimeConfig::Get().MaxUndoMemoryMb);
+                Buffer->UndoBuffer.RemoveAt(0, NumToRemove);
+                Buffer->OnUndoBufferChanged().Broadcast();
+                GTrimmedBytes.fetch_add(TrimmedBytes, std::memory_order_relaxed);
+                GTrimmedTransactions.fetch_add(TrimmedTransactions, std::memory_order_relaxed);
         }
+        GHeldBytes = HeldBytes;
+        GHeldTransactions = GMcpTransactions.Num();
 }
@@ -0,0 +1,152 @@
+#include "Transactions/TransactionTools.h"
+#include "CoreMinimal.h"
+
+#include "Commands/BlueprintCompileQueue.h"
+#include "Editor.h"
+#include "Permissions/WriteGate.h"
+#include "Transactions/BulkEdit.h"
+#include "Transactions/TransactionManager.h"
+
+namespace
+{
+    constexpr const TCHAR* ErrorCodeInvalidParams = TEXT("INVALID_PARAMETERS");
+    constexpr const TCHAR* ErrorCodeEditorUnavailable = TEXT("EDITOR_UNAVAILABLE");
+    constexpr const TCHAR* ErrorCodeTransactionActive = TEXT("TRANSACTION_ACTIVE");
+    constexpr const TCHAR* ErrorCodeTransactionNotFound = TEXT("TRANSACTION_NOT_FOUND");
+    constexpr const TCHAR* ErrorCodeBulkActive = TEXT("BULK_EDIT_ACTIVE");
+    constexpr const TCHAR* ErrorCodeBulkNotFound = TEXT("BULK_EDIT_NOT_FOUND");
+
+    constexpr double DefaultIdleTimeoutSeconds = 60.0;
+    constexpr double MaxIdleTimeoutSeconds = 3600.0;
+
+    TSharedPtr<FJsonObject> MakeErrorJson(const FString& Code, const FString& Message)
+    {
+        TSharedPtr<FJsonObject> Error = MakeShared<FJsonObject>();
+        Error->SetBoolField(TEXT("success"), false);
+        Error->SetStringField(TEXT("errorCode"), Code);
+        Error->SetStringField(TEXT("error"), Message);
+        Error->SetStringField(TEXT("message"), Message);
+        return Error;
+    }
+
+    TSharedPtr<FJsonObject> Close(const TSharedPtr<FJsonObject>& Params, bool bAbort)
+    {
+        FString TransactionId;
+        if (!Params.IsValid() || !Params->TryGetStringField(TEXT("transactionId"), TransactionId) || TransactionId.IsEmpty())
+        {
+            return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Missing 'transactionId' parameter"));
+        }
+
+        int32 Mutations = 0;
+        FString Error;
+        const bool bClosed = bAbort
+            ? FTransactionManager::AbortShared(TransactionId, Mutations, Error)
+            : FTransactionManager::CommitShared(TransactionId, Mutations, Error);
+        if (!bClosed)
+        {
+            return MakeErrorJson(ErrorCodeTransactionNotFound, Error);
+        }
+
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("transactionId"), TransactionId);
+        Result->SetBoolField(bAbort ? TEXT("aborted") : TEXT("committed"), true);
+        Result->SetNumberField(TEXT("mutations"), Mutations);
+        // Blueprints edited in the transaction compile once, outside it.
+        FBlueprintCompileQueue::Get().FlushInto(*Result);
+        return Result;
+    }
+}
+
+TSharedPtr<FJsonObject> FTransactionTools::Begin(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!GEditor)
+    {
+        return MakeErrorJson(ErrorCodeEditorUnavailable, TEXT("Editor instance unavailable"));
+    }
+
+    FString Name = FWriteGate::GetTransactionName();
+    double IdleTimeoutSeconds = DefaultIdleTimeoutSeconds;
+    if (Params.IsValid())
+    {
+        Params->TryGetStringField(TEXT("name"), Name);
+        Params->TryGetNumberField(TEXT("idleTimeoutSec"), IdleTimeoutSeconds);
+    }
+    if (Name.TrimStartAndEnd().IsEmpty())
+    {
+        return MakeErrorJson(ErrorCodeInvalidParams, TEXT("'name' must not be empty"));
+    }
+    IdleTimeoutSeconds = FMath::Clamp(IdleTimeoutSeconds, 1.0, MaxIdleTimeoutSeconds);
+
+    FString TransactionId;
+    FString Error;
+    if (!FTransactionManager::OpenShared(Name, IdleTimeoutSeconds, TransactionId, Error))
+    {
+        return MakeErrorJson(ErrorCodeTransactionActive, Error);
+    }
+
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("transactionId"), TransactionId);
+    Result->SetStringField(TEXT("name"), Name);
+    Result->SetNumberField(TEXT("idleTimeoutSec"), IdleTimeoutSeconds);
+    return Result;
+}
+
+TSharedPtr<FJsonObject> FTransactionTools::Commit(const TSharedPtr<FJsonObject>& Params)
+{
+    return Close(Params, /*bAbort=*/false);
+}
+
+TSharedPtr<FJsonObject> FTransactionTools::Abort(const TSharedPtr<FJsonObject>& Params)
+{
+    return Close(Params, /*bAbort=*/true);
+}
+
+TSharedPtr<FJsonObject> FTransactionTools::BulkBegin(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!GEditor)
+    {
+        return MakeErrorJson(ErrorCodeEditorUnavailable, TEXT("Editor instance unavailable"));
+    }
+
+    double IdleTimeoutSeconds = DefaultIdleTimeoutSeconds;
+    if (Params.IsValid())
+    {
+        Params->TryGetNumberField(TEXT("idleTimeoutSec"), IdleTimeoutSeconds);
+    }
+    IdleTimeoutSeconds = FMath::Clamp(IdleTimeoutSeconds, 1.0, MaxIdleTimeoutSeconds);
+
+    FString BulkId;
+    FString Error;
+    if (!FBulkEdit::OpenExplicit(IdleTimeoutSeconds, BulkId, Error))
+    {
+        return MakeErrorJson(ErrorCodeBulkActive, Error);
+    }
+
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("bulkId"), BulkId);
+    Result->SetNumberField(TEXT("idleTimeoutSec"), IdleTimeoutSeconds);
+    return Result;
+}
+
+TSharedPtr<FJsonObject> FTransactionTools::BulkEnd(const TSharedPtr<FJsonObject>& Params)
+{
+    FString BulkId;
+    if (!Params.IsValid() || !Params->TryGetStringField(TEXT("bulkId"), BulkId) || BulkId.IsEmpty())
+    {
+        return MakeErrorJson(ErrorCodeInvalidParams, TEXT("Missing 'bulkId' parameter"));
+    }
+
+    double DurationSeconds = 0.0;
+    FString Error;
+    if (!FBulkEdit::CloseExplicit(BulkId, DurationSeconds, Error))
+    {
+        return MakeErrorJson(ErrorCodeBulkNotFound, Error);
+    }
+
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("bulkId"), BulkId);
+    Result->SetBoolField(TEXT("ended"), true);
+    Result->SetNumberField(TEXT("durationMs"), DurationSeconds * 1000.0);
+    FBlueprintCompileQueue::Get().FlushInto(*Result);
+    return Result;
+}
@@ -1,8 +1,20 @@
 #include "UnrealMCPBridge.h"
 #include "CoreMinimal.h"
 #include "MCPServerRunnable.h"
+#include "Protocol/CommandContext.h"
+#include "Protocol/CommandScheduler.h"
+#include "Protocol/EventHub.h"
+#include "Protocol/JobRegistry.h"
+#include "Protocol/Protocol.h"
+#include "Protocol/RequestDedup.h"
+#include "Protocol/ResponseCache.h"
+#include "Protocol/ResponsePrefetch.h"
+#include "Protocol/ResponseStream.h"
+#include "Protocol/Transport.h"
+#include "Settings/UnrealMCPRuntimeConfig.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
+#include "HAL/PlatformTime.h"
 #include "HAL/RunnableThread.h"
 #include "Interfaces/IPv4/IPv4Address.h"
 #include "Interfaces/IPv4/IPv4Endpoint.h"
@@ -53,21 +65,40 @@
 #include "EditorSubsystem.h"
 #include "Subsystems/EditorActorSubsystem.h"
 // Include our new command handler classes
+#include "Commands/MCPCommandRegistry.h"
 #include "Commands/UnrealMCPEditorCommands.h"
 #include "Commands/UnrealMCPBlueprintCommands.h"
 #include "Commands/UnrealMCPBlueprintNodeCommands.h"
 #include "Commands/UnrealMCPProjectCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/BlueprintBatchCompile.h"
+#include "Commands/BlueprintCompileQueue.h"
+#include "Commands/BlueprintGraphIndex.h"
+#include "Commands/BlueprintNodeSearch.h"
+#include "Commands/BlueprintResolver.h"
+#include "Commands/ParamSchema.h"
+#include "Commands/PropertyPathCache.h"
 #include "Commands/UnrealMCPUMGCommands.h"
 #include "Commands/UnrealMCPSourceControlCommands.h"
+#include "Content/ContentScanCache.h"
 #include "Content/ContentTools.h"
 #include "Assets/AssetCrud.h"
 #include "Assets/AssetImport.h"
+#include "Assets/AssetThumbnails.h"
+#include "Assets/DataTableImport.h"
+#include "Assets/AssetClassResolver.h"
+#include "Assets/AssetIndexCache.h"
+#include "Assets/AssetNameIndex.h"
 #include "Assets/AssetQuery.h"
 #include "Niagara/NiagaraTools.h"
 #include "MetaSounds/MetaSoundTools.h"
+#include "Actors/ActorIndex.h"
+#include "Actors/ActorSpatialIndex.h"
+#include "Actors/WorldChangeLog.h"
 #include "Actors/ActorTools.h"
+#include "Actors/InstanceTools.h"
 #include "EditorNav/EditorNavTools.h"
+#include "EditorNav/ViewportStream.h"
 #include "Levels/LevelTools.h"
 #include "Sequencer/SequenceBindings.h"
 #include "Sequencer/SequenceExport.h"
@@ -75,923 +106,2437 @@
 #include "Sequencer/SequenceTracks.h"
 #include "Materials/MaterialApplyTools.h"
 #include "Materials/MaterialInstanceTools.h"
+#include "Observability/MCPTrace.h"
+#include "Observability/MetricsEndpoint.h"
+#include "Observability/MemoryPolicy.h"
+#include "Observability/MetricsRegistry.h"
+#include "Observability/StallWatchdog.h"
 #include "Permissions/WriteGate.h"
+#include "SourceControlService.h"
+#include "Transactions/BulkEdit.h"
 #include "Transactions/TransactionManager.h"
+#include "Transactions/TransactionTools.h"
 #include "UnrealMCPLog.h"
 #include "UnrealMCPSettings.h"
 
+#include "Interfaces/IPluginManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
 #include "Misc/ScopeExit.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/GarbageCollection.h"
+
+namespace
+{
+    /** Where a batch stopped when it yielded at the end of a frame's budget. */
+    struct FBatchResumeState : public UnrealMCP::Protocol::FCommandContext::FResumeState
+    {
+        TArray<TSharedPtr<FJsonValue>> Results;
+        int32 NextIndex = 0;
+        int32 Failed = 0;
+    };
+
+    /**
+     * Sets meta.cacheGen, the response cache generation a client may key its own cache on, and
+     * meta.cacheable on answers the client may keep (mutations only report the generation).
+     */
+    void SetCacheGeneration(FJsonObject& Response, int64 Generation, bool bCacheable)
+    {
+        TSharedPtr<FJsonObject> Meta = Response.HasTypedField<EJson::Object>(TEXT("meta")) ? Response.GetObjectField(TEXT("meta")) : MakeShared<FJsonObject>();
+        Meta->SetNumberField(TEXT("cacheGen"), static_cast<double>(Generation));
+        if (bCacheable)
+        {
+            Meta->SetBoolField(TEXT("cacheable"), true);
+        }
+        Response.SetObjectField(TEXT("meta"), Meta);
+    }
+
+    constexpr int32 DefaultJobPageLimit = 500;
+    constexpr int32 MaxJobPageLimit = 10000;
+
+    TSharedPtr<FJsonObject> MakeJobError(const TCHAR* ErrorCode, const FString& Message)
+    {
+        TSharedPtr<FJsonObject> Error = FUnrealMCPCommonUtils::CreateErrorResponse(Message);
+        Error->SetStringField(TEXT("errorCode"), ErrorCode);
+        return Error;
+    }
+
+    bool ParseTagMatch(const FString& Value, FAssetFindParams::ETagMatch& OutMatch)
+    {
+        if (Value.Equals(TEXT("exact"), ESearchCase::IgnoreCase))
+        {
+            OutMatch = FAssetFindParams::ETagMatch::Exact;
+        }
+        else if (Value.Equals(TEXT("prefix"), ESearchCase::IgnoreCase))
+        {
+            OutMatch = FAssetFindParams::ETagMatch::Prefix;
+        }
+        else if (Value.Equals(TEXT("contains"), ESearchCase::IgnoreCase))
+        {
+            OutMatch = FAssetFindParams::ETagMatch::Contains;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /** Tag values as the registry stores them: whole numbers without a fractional part. */
+    bool TagValueToString(const TSharedPtr<FJsonValue>& Value, FString& OutString)
+    {
+        if (!Value.IsValid())
+        {
+            return false;
+        }
+
+        switch (Value->Type)
+        {
+        case EJson::String:
+            OutString = Value->AsString();
+            return true;
+        case EJson::Number:
+        {
+            const double Number = Value->AsNumber();
+            OutString = FMath::IsNearlyEqual(Number, FMath::RoundToDouble(Number)) && FMath::Abs(Number) < 1e15
+                ? FString::Printf(TEXT("%lld"), static_cast<int64>(FMath::RoundToDouble(Number)))
+                : FString::SanitizeFloat(Number);
+            return true;
+        }
+        case EJson::Boolean:
+            OutString = Value->AsBool() ? TEXT("true") : TEXT("false");
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    TSharedPtr<FJsonObject> HandleAssetFind(const TSharedPtr<FJsonObject>& Params)
+    {
+        TSharedPtr<FJsonObject> ResultJson;
+        FAssetFindParams QueryParams;
+        if (Params.IsValid())
+        {
+            const TArray<TSharedPtr<FJsonValue>>* PathsArray = nullptr;
+            if (Params->TryGetArrayField(TEXT("paths"), PathsArray))
+            {
+                for (const TSharedPtr<FJsonValue>& Value : *PathsArray)
+                {
+                    if (Value.IsValid() && Value->Type == EJson::String)
+                    {
+                        FString PathValue = Value->AsString();
+                        PathValue.TrimStartAndEndInline();
+                        if (!PathValue.IsEmpty())
+                        {
+                            QueryParams.Paths.Add(MoveTemp(PathValue));
+                        }
+                    }
+                }
+            }
+
+            const TArray<TSharedPtr<FJsonValue>>* ClassArray = nullptr;
+            if (Params->TryGetArrayField(TEXT("classNames"), ClassArray))
+            {
+                for (const TSharedPtr<FJsonValue>& Value : *ClassArray)
+                {
+                    if (Value.IsValid() && Value->Type == EJson::String)
+                    {
+                        FString ClassName = Value->AsString();
+                        ClassName.TrimStartAndEndInline();
+                        if (!ClassName.IsEmpty())
+                        {
+                            QueryParams.ClassNames.Add(MoveTemp(ClassName));
+                        }
+                    }
+                }
+            }
+
+            FString NameContains;
+            if (Params->TryGetStringField(TEXT("nameContains"), NameContains))
+            {
+                NameContains.TrimStartAndEndInline();
+                if (!NameContains.IsEmpty())
+                {
+                    QueryParams.NameContains = NameContains;
+                }
+            }
+
+            FString NameStartsWith;
+            if (Params->TryGetStringField(TEXT("nameStartsWith"), NameStartsWith))
+            {
+                NameStartsWith.TrimStartAndEndInline();
+                if (!NameStartsWith.IsEmpty())
+                {
+                    QueryParams.NameStartsWith = NameStartsWith;
+                }
+            }
+
+            FString PathContains;
+            if (Params->TryGetStringField(TEXT("pathContains"), PathContains))
+            {
+                PathContains.TrimStartAndEndInline();
+                if (!PathContains.IsEmpty())
+                {
+                    QueryParams.PathContains = PathContains;
+                }
+            }
+
+            Params->TryGetBoolField(TEXT("fuzzy"), QueryParams.bFuzzy);
+
+            FAssetFindParams::ETagMatch DefaultTagMatch = FAssetFindParams::ETagMatch::Contains;
+            FString TagMatchString;
+            if (Params->TryGetStringField(TEXT("tagMatch"), TagMatchString))
+            {
+                ParseTagMatch(TagMatchString, DefaultTagMatch);
+            }
+
+            // Each tag maps to a value, a list of values, or {"values": ..., "match": "exact"|"prefix"|"contains"}.
+            const TSharedPtr<FJsonObject>* TagQueryObject = nullptr;
+            if (Params->TryGetObjectField(TEXT("tagQuery"), TagQueryObject))
+            {
+                for (const auto& TagPair : (*TagQueryObject)->Values)
+                {
+                    TSharedPtr<FJsonValue> ValuesJson = TagPair.Value;
+                    FAssetFindParams::ETagMatch TagMatch = DefaultTagMatch;
+                    if (ValuesJson.IsValid() && ValuesJson->Type == EJson::Object)
+                    {
+                        const TSharedPtr<FJsonObject> Condition = ValuesJson->AsObject();
+                        FString ConditionMatch;
+                        if (Condition->TryGetStringField(TEXT("match"), ConditionMatch))
+                        {
+                            ParseTagMatch(ConditionMatch, TagMatch);
+                        }
+                        ValuesJson = Condition->TryGetField(TEXT("values"));
+                    }
+
+                    TArray<FString> TagValues;
+                    FString TagValueString;
+                    if (ValuesJson.IsValid() && ValuesJson->Type == EJson::Array)
+                    {
+                        for (const TSharedPtr<FJsonValue>& TagValue : ValuesJson->AsArray())
+                        {
+                            if (TagValueToString(TagValue, TagValueString))
+                            {
+                                TagValues.Add(TagValueString);
+                            }
+                        }
+                    }
+                    else if (TagValueToString(ValuesJson, TagValueString))
+                    {
+                        TagValues.Add(TagValueString);
+                    }
+
+                    if (TagValues.Num() > 0)
+                    {
+                        const FName TagName(*TagPair.Key);
+                        QueryParams.TagQuery.Add(TagName, MoveTemp(TagValues));
+                        if (TagMatch != FAssetFindParams::ETagMatch::Contains)
+                        {
+                            QueryParams.TagMatch.Add(TagName, TagMatch);
+                        }
+                    }
+                }
+            }
+
+            if (Params->HasTypedField<EJson::Boolean>(TEXT("recursive")))
+            {
+                QueryParams.bRecursive = Params->GetBoolField(TEXT("recursive"));
+            }
+
+            if (Params->HasTypedField<EJson::Number>(TEXT("limit")))
+            {
+                QueryParams.Limit = static_cast<int32>(Params->GetNumberField(TEXT("limit")));
+            }
+
+            if (Params->HasTypedField<EJson::Number>(TEXT("offset")))
+            {
+                QueryParams.Offset = static_cast<int32>(Params->GetNumberField(TEXT("offset")));
+            }
+
+            Params->TryGetStringField(TEXT("cursor"), QueryParams.Cursor);
+
+            // "path", "packagePath", "name", "class", "tags" or "tags.<TagName>"; unknown entries are ignored.
+            const TArray<TSharedPtr<FJsonValue>>* FieldsArray = nullptr;
+            if (Params->TryGetArrayField(TEXT("fields"), FieldsArray))
+            {
+                FAssetFindParams::FFieldSelection& Fields = QueryParams.Fields;
+                Fields.bObjectPath = false;
+                Fields.bPackagePath = false;
+                Fields.bAssetName = false;
+                Fields.bClassName = false;
+                Fields.bAllTags = false;
+                for (const TSharedPtr<FJsonValue>& Value : *FieldsArray)
+                {
+                    if (!Value.IsValid() || Value->Type != EJson::String)
+                    {
+                        continue;
+                    }
+
+                    FString Field = Value->AsString();
+                    Field.TrimStartAndEndInline();
+                    if (Field.Equals(TEXT("path"), ESearchCase::IgnoreCase) || Field.Equals(TEXT("objectPath"), ESearchCase::IgnoreCase))
+                    {
+                        Fields.bObjectPath = true;
+                    }
+                    else if (Field.Equals(TEXT("packagePath"), ESearchCase::IgnoreCase))
+                    {
+                        Fields.bPackagePath = true;
+                    }
+                    else if (Field.Equals(TEXT("name"), ESearchCase::IgnoreCase) || Field.Equals(TEXT("assetName"), ESearchCase::IgnoreCase))
+                    {
+                        Fields.bAssetName = true;
+                    }
+                    else if (Field.Equals(TEXT("class"), ESearchCase::IgnoreCase))
+                    {
+                        Fields.bClassName = true;
+                    }
+                    else if (Field.Equals(TEXT("tags"), ESearchCase::IgnoreCase))
+                    {
+                        Fields.bAllTags = true;
+                    }
+                    else if (Field.StartsWith(TEXT("tags."), ESearchCase::IgnoreCase) && Field.Len() > 5)
+                    {
+                        Fields.TagNames.AddUnique(FName(*Field.RightChop(5)));
+                    }
+                }
+            }
+
+            const TSharedPtr<FJsonObject>* SortObject = nullptr;
+            if (Params->TryGetObjectField(TEXT("sort"), SortObject) && SortObject->IsValid())
+            {
+                FString SortBy;
+                if ((*SortObject)->TryGetStringField(TEXT("by"), SortBy))
+                {
+                    if (SortBy.Equals(TEXT("class"), ESearchCase::IgnoreCase))
+                    {
+                        QueryParams.SortBy = FAssetFindParams::ESortBy::Class;
+                    }
+                    else if (SortBy.Equals(TEXT("path"), ESearchCase::IgnoreCase))
+                    {
+                        QueryParams.SortBy = FAssetFindParams::ESortBy::Path;
+                    }
+                    else
+                    {
+                        QueryParams.SortBy = FAssetFindParams::ESortBy::Name;
+                    }
+                }
+
+                FString SortOrder;
+                if ((*SortObject)->TryGetStringField(TEXT("order"), SortOrder))
+                {
+                    QueryParams.bSortAscending = !SortOrder.Equals(TEXT("desc"), ESearchCase::IgnoreCase);
+                }
+            }
+        }
+
+        if (QueryParams.Paths.Num() == 0 &&
+            QueryParams.ClassNames.Num() == 0 &&
+            !QueryParams.NameContains.IsSet() &&
+            !QueryParams.NameStartsWith.IsSet() &&
+            !QueryParams.PathContains.IsSet() &&
+            QueryParams.TagQuery.Num() == 0)
+        {
+            ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Provide at least one filter (paths, classNames, nameContains, nameStartsWith, pathContains, or tagQuery)"));
+            ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_FIND_INVALID_FILTER"));
+        }
+        else
+        {
+            FAssetFindPage Page;
+            FString QueryError;
+            if (!FAssetQuery::FindPage(QueryParams, Page, QueryError))
+            {
+                ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(QueryError);
+                ResultJson->SetStringField(TEXT("errorCode"), Page.bCursorExpired ? TEXT("ASSET_FIND_CURSOR_EXPIRED")
+                    : QueryParams.Cursor.IsEmpty() ? TEXT("ASSET_FIND_FAILED") : TEXT("ASSET_FIND_INVALID_CURSOR"));
+            }
+            else
+            {
+                TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+                Data->SetNumberField(TEXT("total"), Page.Total);
+                if (!Page.NextCursor.IsEmpty())
+                {
+                    Data->SetStringField(TEXT("nextCursor"), Page.NextCursor);
+                }
+
+                const FAssetFindParams::FFieldSelection& Fields = QueryParams.Fields;
+                const bool bAnyTags = Fields.bAllTags || Fields.TagNames.Num() > 0;
+
+                TArray<TSharedPtr<FJsonValue>> ItemsArray;
+                ItemsArray.Reserve(Page.Items.Num());
+                for (const FAssetLite& Item : Page.Items)
+                {
+                    TSharedPtr<FJsonObject> ItemObject = MakeShared<FJsonObject>();
+                    if (Fields.bObjectPath)
+                    {
+                        ItemObject->SetStringField(TEXT("objectPath"), Item.ObjectPath);
+                    }
+                    if (Fields.bPackagePath)
+                    {
+                        ItemObject->SetStringField(TEXT("packagePath"), Item.PackagePath);
+                    }
+                    if (Fields.bAssetName)
+                    {
+                        ItemObject->SetStringField(TEXT("assetName"), Item.AssetName);
+                    }
+                    if (Fields.bClassName)
+                    {
+                        ItemObject->SetStringField(TEXT("class"), Item.ClassName);
+                    }
+
+                    if (bAnyTags)
+                    {
+                        TSharedPtr<FJsonObject> TagsJson = MakeShared<FJsonObject>();
+                        for (const TPair<FString, TArray<FString>>& TagPair : Item.Tags)
+                        {
+                            TArray<TSharedPtr<FJsonValue>> TagValues;
+                            for (const FString& TagValue : TagPair.Value)
+                            {
+                                TagValues.Add(MakeShared<FJsonValueString>(TagValue));
+                            }
+                            TagsJson->SetArrayField(TagPair.Key, TagValues);
+                        }
+                        ItemObject->SetObjectField(TEXT("tags"), TagsJson);
+                    }
+
+                    ItemsArray.Add(MakeShared<FJsonValueObject>(ItemObject));
+                }
+
+                Data->SetArrayField(TEXT("items"), ItemsArray);
+                FAssetQuery::AddRegistryStatus(*Data);
+                ResultJson = FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+            }
+        }
+        return ResultJson;
+    }
+
+    /** Reads the batched "objectPaths" form; false when the request uses the single objectPath instead. */
+    bool ReadObjectPaths(const TSharedPtr<FJsonObject>& Params, TArray<FString>& OutPaths)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* PathsArray = nullptr;
+        if (!Params.IsValid() || !Params->TryGetArrayField(TEXT("objectPaths"), PathsArray))
+        {
+            return false;
+        }
+
+        OutPaths.Reserve(PathsArray->Num());
+        for (const TSharedPtr<FJsonValue>& Value : *PathsArray)
+        {
+            FString ObjectPath;
+            if (Value.IsValid() && Value->Type == EJson::String)
+            {
+                ObjectPath = Value->AsString();
+                ObjectPath.TrimStartAndEndInline();
+            }
+            OutPaths.Add(MoveTemp(ObjectPath));
+        }
+        return true;
+    }
+
+    TSharedPtr<FJsonObject> HandleAssetExists(const TSharedPtr<FJsonObject>& Params)
+    {
+        TSharedPtr<FJsonObject> ResultJson;
+        FString ObjectPath;
+        TArray<FString> ObjectPaths;
+        if (ReadObjectPaths(Params, ObjectPaths))
+        {
+            TArray<FAssetExistsResult> Results;
+            FString ExistsError;
+            if (!FAssetQuery::ExistsBatch(ObjectPaths, Results, ExistsError))
+            {
+                ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(ExistsError);
+                ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_EXISTS_FAILED"));
+            }
+            else
+            {
+                int32 FoundCount = 0;
+                TArray<TSharedPtr<FJsonValue>> ItemsArray;
+                ItemsArray.Reserve(Results.Num());
+                for (const FAssetExistsResult& Result : Results)
+                {
+                    TSharedPtr<FJsonObject> ItemObject = MakeShared<FJsonObject>();
+                    ItemObject->SetStringField(TEXT("objectPath"), Result.ObjectPath);
+                    ItemObject->SetBoolField(TEXT("exists"), Result.bExists);
+                    if (!Result.ClassName.IsEmpty())
+                    {
+                        ItemObject->SetStringField(TEXT("class"), Result.ClassName);
+                    }
+                    if (!Result.Error.IsEmpty())
+                    {
+                        ItemObject->SetStringField(TEXT("error"), Result.Error);
+                    }
+                    FoundCount += Result.bExists ? 1 : 0;
+                    ItemsArray.Add(MakeShared<FJsonValueObject>(ItemObject));
+                }
+
+                TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+                Data->SetNumberField(TEXT("found"), FoundCount);
+                Data->SetArrayField(TEXT("items"), ItemsArray);
+                FAssetQuery::AddRegistryStatus(*Data);
+                ResultJson = FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+            }
+        }
+        else if (Params.IsValid() && Params->TryGetStringField(TEXT("objectPath"), ObjectPath))
+        {
+            ObjectPath.TrimStartAndEndInline();
+            bool bExists = false;
+            FString ClassName;
+            FString ExistsError;
+            if (!FAssetQuery::Exists(ObjectPath, bExists, ClassName, ExistsError))
+            {
+                ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(ExistsError);
+                ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_EXISTS_FAILED"));
+            }
+            else
+            {
+                TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+                Data->SetBoolField(TEXT("exists"), bExists);
+                if (!ClassName.IsEmpty())
+                {
+                    Data->SetStringField(TEXT("class"), ClassName);
+                }
+                FAssetQuery::AddRegistryStatus(*Data);
+                ResultJson = FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+            }
+        }
+        else
+        {
+            ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing objectPath or objectPaths parameter"));
+            ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_EXISTS_FAILED"));
+        }
+        return ResultJson;
+    }
+
+    TSharedPtr<FJsonObject> HandleAssetMetadata(const TSharedPtr<FJsonObject>& Params)
+    {
+        TSharedPtr<FJsonObject> ResultJson;
+        FAssetMetadataOptions Options;
+        if (Params.IsValid())
+        {
+            if (Params->HasTypedField<EJson::Number>(TEXT("maxDependencies")))
+            {
+                Options.MaxDependencies = FMath::Max(0, static_cast<int32>(Params->GetNumberField(TEXT("maxDependencies"))));
+            }
+            Params->TryGetBoolField(TEXT("resolveDependencies"), Options.bResolveDependencies);
+        }
+
+        FString ObjectPath;
+        TArray<FString> ObjectPaths;
+        if (ReadObjectPaths(Params, ObjectPaths))
+        {
+            TArray<TSharedPtr<FJsonObject>> Items;
+            FString MetadataError;
+            if (!FAssetQuery::MetadataBatch(ObjectPaths, Items, MetadataError, Options))
+            {
+                ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(MetadataError);
+                ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_METADATA_FAILED"));
+            }
+            else
+            {
+                TArray<TSharedPtr<FJsonValue>> ItemsArray;
+                ItemsArray.Reserve(Items.Num());
+                for (const TSharedPtr<FJsonObject>& Item : Items)
+                {
+                    ItemsArray.Add(MakeShared<FJsonValueObject>(Item));
+                }
+
+                TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+                Data->SetArrayField(TEXT("items"), ItemsArray);
+                FAssetQuery::AddRegistryStatus(*Data);
+                ResultJson = FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+            }
+        }
+        else if (Params.IsValid() && Params->TryGetStringField(TEXT("objectPath"), ObjectPath))
+        {
+            ObjectPath.TrimStartAndEndInline();
+            TSharedPtr<FJsonObject> MetadataJson;
+            FString MetadataError;
+            if (!FAssetQuery::Metadata(ObjectPath, MetadataJson, MetadataError, Options))
+            {
+                ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(MetadataError);
+                ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_METADATA_FAILED"));
+            }
+            else
+            {
+                FAssetQuery::AddRegistryStatus(*MetadataJson);
+                ResultJson = FUnrealMCPCommonUtils::CreateSuccessResponse(MetadataJson);
+            }
+        }
+        else
+        {
+            ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing objectPath or objectPaths parameter"));
+            ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_METADATA_FAILED"));
+        }
+        return ResultJson;
+    }
+
+    TSharedPtr<FJsonObject> HandleAssetGraph(const TSharedPtr<FJsonObject>& Params)
+    {
+        TSharedPtr<FJsonObject> ResultJson;
+        FAssetGraphParams GraphParams;
+        if (Params.IsValid())
+        {
+            FString ObjectPath;
+            if (!ReadObjectPaths(Params, GraphParams.Roots) && Params->TryGetStringField(TEXT("objectPath"), ObjectPath))
+            {
+                ObjectPath.TrimStartAndEndInline();
+                GraphParams.Roots.Add(ObjectPath);
+            }
+            GraphParams.Roots.RemoveAll([](const FString& Root) { return Root.IsEmpty(); });
+
+            FString Direction;
+            if (Params->TryGetStringField(TEXT("direction"), Direction))
+            {
+                if (Direction.Equals(TEXT("referencers"), ESearchCase::IgnoreCase))
+                {
+                    GraphParams.Direction = FAssetGraphParams::EDirection::Referencers;
+                }
+                else if (Direction.Equals(TEXT("both"), ESearchCase::IgnoreCase))
+                {
+                    GraphParams.Direction = FAssetGraphParams::EDirection::Both;
+                }
+            }
+
+            Params->TryGetBoolField(TEXT("hard"), GraphParams.bHard);
+            Params->TryGetBoolField(TEXT("soft"), GraphParams.bSoft);
+            Params->TryGetBoolField(TEXT("includeScript"), GraphParams.bIncludeScriptPackages);
+
+            if (Params->HasTypedField<EJson::Number>(TEXT("depth")))
+            {
+                GraphParams.MaxDepth = FMath::Clamp(static_cast<int32>(Params->GetNumberField(TEXT("depth"))), 0, 64);
+            }
+            if (Params->HasTypedField<EJson::Number>(TEXT("maxNodes")))
+            {
+                GraphParams.MaxNodes = FMath::Clamp(static_cast<int32>(Params->GetNumberField(TEXT("maxNodes"))), 1, 50000);
+            }
+            if (Params->HasTypedField<EJson::Number>(TEXT("timeLimitMs")))
+            {
+                GraphParams.TimeLimitSeconds = FMath::Clamp(Params->GetNumberField(TEXT("timeLimitMs")), 1.0, 30000.0) / 1000.0;
+            }
+        }
+
+        TSharedPtr<FJsonObject> GraphJson;
+        FString GraphError;
+        if (!FAssetQuery::Graph(GraphParams, GraphJson, GraphError))
+        {
+            ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(GraphError);
+            ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_GRAPH_FAILED"));
+        }
+        else
+        {
+            FAssetQuery::AddRegistryStatus(*GraphJson);
+            ResultJson = FUnrealMCPCommonUtils::CreateSuccessResponse(GraphJson);
+        }
+        return ResultJson;
+    }
+}
 
 UUnrealMCPBridge::UUnrealMCPBridge()
 {
-    EditorCommands = MakeShared<FUnrealMCPEditorCommands>();
-    BlueprintCommands = MakeShared<FUnrealMCPBlueprintCommands>();
-    BlueprintNodeCommands = MakeShared<FUnrealMCPBlueprintNodeCommands>();
-    ProjectCommands = MakeShared<FUnrealMCPProjectCommands>();
-    UMGCommands = MakeShared<FUnrealMCPUMGCommands>();
-    SourceControlCommands = MakeShared<FUnrealMCPSourceControlCommands>();
-    ContentTools = MakeShared<FContentTools>();
+    FWriteGate::UpdateRemoteEnforcement(false, true, TArray<FString>(), TArray<FString>(), TArray<FString>());
+}
+
+void UUnrealMCPBridge::EnsureCommandsRegistered()
+{
+    check(IsInGameThread());
+    if (CommandRegistry.IsValid())
+    {
+        return;
+    }
+
+    const double Start = FPlatformTime::Seconds();
+    EditorCommands = MakeShared<FUnrealMCPEditorCommands>();
+    BlueprintCommands = MakeShared<FUnrealMCPBlueprintCommands>();
+    BlueprintNodeCommands = MakeShared<FUnrealMCPBlueprintNodeCommands>();
+    ProjectCommands = MakeShared<FUnrealMCPProjectCommands>();
+    UMGCommands = MakeShared<FUnrealMCPUMGCommands>();
+    SourceControlCommands = MakeShared<FUnrealMCPSourceControlCommands>();
+    ContentTools = MakeShared<FContentTools>();
+
+    CommandRegistry = MakeShared<FMCPCommandRegistry>();
+    RegisterCommands();
+    FMetricsRegistry::MarkStartup(TEXT("commands_registered"), Start);
+}
+
+UUnrealMCPBridge::~UUnrealMCPBridge()
+{
+    // Registered handlers point into the command objects below.
+    CommandRegistry.Reset();
+    EditorCommands.Reset();
+    BlueprintCommands.Reset();
+    BlueprintNodeCommands.Reset();
+    ProjectCommands.Reset();
+    UMGCommands.Reset();
+    SourceControlCommands.Reset();
+    ContentTools.Reset();
+}
+
+void UUnrealMCPBridge::RegisterCommands()
+{
+    FMCPCommandRegistry& Registry = *CommandRegistry;
+
+    Registry.Register(TEXT("ping"), [](const TSharedPtr<FJsonObject>&)
+    {
+        TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("message"), TEXT("pong"));
+        return Result;
+    }).Priority = UnrealMCP::Protocol::ECommandPriority::Control;
+
+    EditorCommands->RegisterCommands(Registry);
+    BlueprintCommands->RegisterCommands(Registry);
+    BlueprintNodeCommands->RegisterCommands(Registry);
+    ProjectCommands->RegisterCommands(Registry);
+    UMGCommands->RegisterCommands(Registry);
+    SourceControlCommands->RegisterCommands(Registry);
+    ContentTools->RegisterCommands(Registry);
+
+    // FAssetQuery only reads the asset registry, which is safe to query from any thread.
+    {
+        FMCPCommandDescriptor& AssetRead = Registry.Register(TEXT("asset.find"), &HandleAssetFind);
+        AssetRead.Affinity = EMCPThreadAffinity::AnyThread;
+        AssetRead.bCacheable = true;
+    }
+    {
+        FMCPCommandDescriptor& AssetRead = Registry.Register(TEXT("asset.exists"), &HandleAssetExists);
+        AssetRead.Affinity = EMCPThreadAffinity::AnyThread;
+        AssetRead.bCacheable = true;
+    }
+    {
+        FMCPCommandDescriptor& AssetRead = Registry.Register(TEXT("asset.metadata"), &HandleAssetMetadata);
+        AssetRead.Affinity = EMCPThreadAffinity::AnyThread;
+        AssetRead.bCacheable = true;
+    }
+    {
+        FMCPCommandDescriptor& AssetRead = Registry.Register(TEXT("asset.graph"), &HandleAssetGraph);
+        AssetRead.Affinity = EMCPThreadAffinity::AnyThread;
+        AssetRead.bCacheable = true;
+    }
+    {
+        // Polled while the editor starts, so it jumps the queue like ping.
+        FMCPCommandDescriptor& RegistryStatus = Registry.Register(TEXT("asset.registry_status"), [](const TSharedPtr<FJsonObject>&)
+        {
+            TSharedPtr<FJsonObject> Status = FAssetQuery::GetRegistryStatus().ToJson();
+            FAssetIndexCache::Get().AddStatus(*Status);
+            return Status;
+        });
+        RegistryStatus.Affinity = EMCPThreadAffinity::AnyThread;
+        RegistryStatus.Priority = UnrealMCP::Protocol::ECommandPriority::Control;
+    }
+    Registry.Register(TEXT("asset.create_folder"), &FAssetCrud::CreateFolder);
+    Registry.Register(TEXT("asset.rename"), &FAssetCrud::Rename);
+    Registry.Register(TEXT("asset.delete"), &FAssetCrud::Delete);
+    Registry.Register(TEXT("asset.fix_redirectors"), &FAssetCrud::FixRedirectors).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+    Registry.Register(TEXT("asset.save_all"), &FAssetCrud::SaveAll).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+    Registry.Register(TEXT("asset.batch_import"), &FAssetImport::BatchImport).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+    Registry.Register(TEXT("asset.plan_import"), &FAssetImport::PlanImport).Affinity = EMCPThreadAffinity::AnyThread;
+    Registry.Register(TEXT("asset.thumbnails"), &FAssetThumbnails::Thumbnails).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+    Registry.Register(TEXT("datatable.import_rows"), &FDataTableImport::ImportRows).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+
+    Registry.Register(TEXT("actor.spawn"), &FActorTools::Spawn);
+    Registry.Register(TEXT("actor.spawn_batch"), &FActorTools::SpawnBatch).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+    Registry.Register(TEXT("actor.destroy"), &FActorTools::Destroy);
+    Registry.Register(TEXT("actor.attach"), &FActorTools::Attach);
+    Registry.Register(TEXT("actor.transform"), &FActorTools::Transform);
+    Registry.Register(TEXT("actor.transform_batch"), &FActorTools::TransformBatch);
+    Registry.Register(TEXT("actor.tag"), &FActorTools::Tag);
+    Registry.Register(TEXT("actor.query_spatial"), &FActorTools::QuerySpatial);
+    Registry.Register(TEXT("actor.read_properties"), &FActorTools::ReadProperties).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+    Registry.Register(TEXT("world.changes_since"), &FActorTools::ChangesSince);
+    Registry.Register(TEXT("foliage.add_instances"), &FInstanceTools::FoliageAddInstances).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+    Registry.Register(TEXT("ism.add_instances"), &FInstanceTools::IsmAddInstances).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+
+    Registry.Register(TEXT("blueprint.find_nodes"), &FBlueprintNodeSearch::FindNodes).bCacheable = true;
+    Registry.Register(TEXT("blueprint.compile_many"), &FBlueprintBatchCompile::CompileMany).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+
+    Registry.Register(TEXT("level.save_open"), &FLevelTools::SaveOpen);
+    Registry.Register(TEXT("level.load"), &FLevelTools::Load);
+    Registry.Register(TEXT("level.unload"), &FLevelTools::Unload);
+    Registry.Register(TEXT("level.stream_sublevel"), &FLevelTools::StreamSublevel);
+    Registry.Register(TEXT("level.load_region"), &FLevelTools::LoadRegion);
+    Registry.Register(TEXT("level.unload_region"), &FLevelTools::UnloadRegion);
+
+    Registry.Register(TEXT("transaction.begin"), &FTransactionTools::Begin);
+    Registry.Register(TEXT("transaction.commit"), &FTransactionTools::Commit);
+    Registry.Register(TEXT("transaction.abort"), &FTransactionTools::Abort);
+    Registry.Register(TEXT("editor.bulk_begin"), &FTransactionTools::BulkBegin);
+    Registry.Register(TEXT("editor.bulk_end"), &FTransactionTools::BulkEnd);
+
+    Registry.Register(TEXT("level.select"), &FEditorNavTools::LevelSelect);
+    Registry.Register(TEXT("viewport.focus"), &FEditorNavTools::ViewportFocus);
+    Registry.Register(TEXT("viewport.stream_start"), &FViewportStream::StreamStart);
+    Registry.Register(TEXT("viewport.stream_stop"), &FViewportStream::StreamStop);
+    FMCPCommandDescriptor& CameraBookmark = Registry.Register(TEXT("camera.bookmark"), &FEditorNavTools::CameraBookmark);
+    CameraBookmark.Mutation = EMCPCommandMutation::ByParams;
+    CameraBookmark.PathRule = EMCPPathRule::FromParams;
+
+    Registry.Register(TEXT("niagara.spawn_component"), &FNiagaraTools::SpawnComponent);
+    Registry.Register(TEXT("niagara.set_user_params"), &FNiagaraTools::SetUserParameters);
+    Registry.Register(TEXT("niagara.activate"), &FNiagaraTools::Activate);
+    Registry.Register(TEXT("niagara.deactivate"), &FNiagaraTools::Deactivate);
+    Registry.Register(TEXT("niagara.prepare"), &FNiagaraTools::Prepare);
+
+    Registry.Register(TEXT("metasound.spawn_component"), &FMetaSoundTools::SpawnComponent);
+    Registry.Register(TEXT("metasound.set_params"), &FMetaSoundTools::SetParameters);
+    Registry.Register(TEXT("metasound.play"), &FMetaSoundTools::Play);
+    Registry.Register(TEXT("metasound.stop"), &FMetaSoundTools::Stop);
+    Registry.Register(TEXT("metasound.export_info"), &FMetaSoundTools::ExportInfo);
+    Registry.Register(TEXT("metasound.patch_preset"), &FMetaSoundTools::PatchPreset);
+    Registry.Register(TEXT("metasound.render"), &FMetaSoundTools::Render);
+    Registry.Register(TEXT("metasound.sweep"), &FMetaSoundTools::Sweep);
+
+    Registry.Register(TEXT("mi.create"), &FMaterialInstanceTools::Create);
+    Registry.Register(TEXT("mi.set_params"), &FMaterialInstanceTools::SetParameters);
+    Registry.Register(TEXT("mi.batch_apply"), &FMaterialApplyTools::BatchApply);
+    Registry.Register(TEXT("mesh.remap_material_slots"), &FMaterialApplyTools::RemapMaterialSlots);
+
+    Registry.Register(TEXT("sequence.create"), &FSequenceTools::Create);
+    Registry.Register(TEXT("sequence.bind_actors"), &FSequenceBindings::BindActors);
+    Registry.Register(TEXT("sequence.unbind"), &FSequenceBindings::Unbind);
+    Registry.Register(TEXT("sequence.list_bindings"), &FSequenceBindings::List).bCacheable = true;
+    Registry.Register(TEXT("sequence.add_tracks"), &FSequenceTracks::AddTracks);
+    Registry.Register(TEXT("sequence.export"), &FSequenceExport::Export).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+    // Mutating (see FWriteGate::IsMutationCommand): it plays the sequence on the level's bound actors, and
+    // ForceRestoreState only undoes state the tracks saved as pre-animated.
+    Registry.Register(TEXT("sequence.evaluate_range"), &FSequenceExport::EvaluateRange).Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+
+    // Jobs only touch FJobRegistry, so starting and polling one need not wait for the frame.
+    Registry.Register(TEXT("job.start"), [this](const TSharedPtr<FJsonObject>& Params)
+    {
+        return HandleJobStart(Params);
+    }).Affinity = EMCPThreadAffinity::AnyThread;
+    {
+        FMCPCommandDescriptor& JobStatus = Registry.Register(TEXT("job.status"), [this](const TSharedPtr<FJsonObject>& Params)
+        {
+            FString JobId;
+            TSharedPtr<FJsonObject> Status;
+            if (Params.IsValid() && Params->TryGetStringField(TEXT("jobId"), JobId) && JobRegistry.IsValid())
+            {
+                Status = JobRegistry->GetStatus(JobId);
+            }
+            return Status.IsValid() ? FUnrealMCPCommonUtils::CreateSuccessResponse(Status)
+                : MakeJobError(TEXT("JOB_NOT_FOUND"), FString::Printf(TEXT("No job '%s'"), *JobId));
+        });
+        JobStatus.Affinity = EMCPThreadAffinity::AnyThread;
+        JobStatus.Priority = UnrealMCP::Protocol::ECommandPriority::Control;
+    }
+    Registry.Register(TEXT("job.result"), [this](const TSharedPtr<FJsonObject>& Params)
+    {
+        FString JobId;
+        double Offset = 0.0;
+        double Limit = DefaultJobPageLimit;
+        if (Params.IsValid())
+        {
+            Params->TryGetStringField(TEXT("jobId"), JobId);
+            Params->TryGetNumberField(TEXT("offset"), Offset);
+            Params->TryGetNumberField(TEXT("limit"), Limit);
+        }
+
+        FString ErrorCode = TEXT("JOB_NOT_FOUND");
+        TSharedPtr<FJsonObject> Page = JobRegistry.IsValid()
+            ? JobRegistry->GetResultPage(JobId, static_cast<int32>(FMath::Max(Offset, 0.0)), FMath::Clamp(static_cast<int32>(Limit), 1, MaxJobPageLimit), ErrorCode)
+            : nullptr;
+        if (!Page.IsValid())
+        {
+            return MakeJobError(*ErrorCode, ErrorCode == TEXT("JOB_NOT_FINISHED")
+                ? FString::Printf(TEXT("Job '%s' is still running"), *JobId)
+                : FString::Printf(TEXT("No job '%s'"), *JobId));
+        }
+        return FUnrealMCPCommonUtils::CreateSuccessResponse(Page);
+    }).Affinity = EMCPThreadAffinity::AnyThread;
+    {
+        FMCPCommandDescriptor& JobCancel = Registry.Register(TEXT("job.cancel"), [this](const TSharedPtr<FJsonObject>& Params)
+        {
+            FString JobId;
+            TSharedPtr<FJsonObject> Status;
+            if (Params.IsValid() && Params->TryGetStringField(TEXT("jobId"), JobId) && JobRegistry.IsValid())
+            {
+                Status = JobRegistry->Cancel(JobId);
+            }
+            return Status.IsValid() ? FUnrealMCPCommonUtils::CreateSuccessResponse(Status)
+                : MakeJobError(TEXT("JOB_NOT_FOUND"), FString::Printf(TEXT("No job '%s'"), *JobId));
+        });
+        JobCancel.Affinity = EMCPThreadAffinity::AnyThread;
+        JobCancel.Priority = UnrealMCP::Protocol::ECommandPriority::Control;
+    }
+
+    // Sent by the MCP server once it has connected, ahead of the agent's first command.
+    Registry.Register(TEXT("editor.warmup"), [this](const TSharedPtr<FJsonObject>& Params)
+    {
+        return HandleWarmup(Params);
+    });
+
+    // The same file the MCP server's schema_registry reads, so both sides reject the same params.
+    int32 ParamSchemas = 0;
+    if (const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UnrealMCP")))
+    {
+        ParamSchemas = Registry.LoadParamSchemas(FPaths::Combine(Plugin->GetBaseDir(), TEXT("Resources"), TEXT("ParamSchemas.json")));
+    }
+
+    // Plugin modules only some families use; the editor starts without waiting for them.
+    Registry.RequireModules(TEXT("niagara."), { TEXT("Niagara") });
+    Registry.RequireModules(TEXT("metasound."), { TEXT("MetasoundEngine"), TEXT("MetasoundFrontend") });
+    Registry.RequireModules(TEXT("sequence."), { TEXT("LevelSequenceEditor"), TEXT("Sequencer") });
+    Registry.RequireModules(TEXT("asset.batch_import"), { TEXT("InterchangeEngine") });
+
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Registered %d commands, %d with parameter schemas"), Registry.Num(), ParamSchemas);
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleWarmup(const TSharedPtr<FJsonObject>& Params)
+{
+    const double Start = FPlatformTime::Seconds();
+
+    TSet<FString> Families;
+    const TArray<TSharedPtr<FJsonValue>>* FamiliesArray = nullptr;
+    if (Params.IsValid() && Params->TryGetArrayField(TEXT("families"), FamiliesArray))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *FamiliesArray)
+        {
+            FString Prefix;
+            if (Value.IsValid() && Value->TryGetString(Prefix) && !Prefix.IsEmpty())
+            {
+                Families.Add(MoveTemp(Prefix));
+            }
+        }
+    }
+    TArray<FString> LoadedFamilies;
+    if (Families.Num() > 0)
+    {
+        const bool bAllFamilies = Families.Contains(TEXT("*"));
+        CommandRegistry->LoadModuleFamilies([&Families, bAllFamilies](const FString& Prefix)
+        {
+            return bAllFamilies || Families.Contains(Prefix);
+        }, LoadedFamilies);
+    }
+
+    TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+    TArray<TSharedPtr<FJsonValue>> LoadedValues;
+    for (const FString& Prefix : LoadedFamilies)
+    {
+        LoadedValues.Add(MakeShared<FJsonValueString>(Prefix));
+    }
+    Data->SetArrayField(TEXT("loadedFamilies"), LoadedValues);
+
+    // The name and blueprint indexes wait for the initial scan; until then they report false and
+    // are built by the first query after it, as without a warm-up.
+    TSharedPtr<FJsonObject> Indexes = MakeShared<FJsonObject>();
+    FAssetClassResolver::Get().Prewarm();
+    Indexes->SetBoolField(TEXT("classes"), true);
+    Indexes->SetBoolField(TEXT("names"), FAssetNameIndex::Get().Prewarm());
+    Indexes->SetBoolField(TEXT("blueprints"), FBlueprintResolver::Get().Prewarm());
+    Data->SetObjectField(TEXT("indexes"), Indexes);
+    FAssetQuery::AddRegistryStatus(*Data);
+
+    Data->SetNumberField(TEXT("elapsedMs"), (FPlatformTime::Seconds() - Start) * 1000.0);
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleJobStart(const TSharedPtr<FJsonObject>& Params)
+{
+    FString CommandType;
+    if (!Params.IsValid() || !Params->TryGetStringField(TEXT("type"), CommandType) || CommandType.IsEmpty())
+    {
+        return MakeJobError(TEXT("INVALID_PARAMS"), TEXT("job.start requires 'type'"));
+    }
+    if (CommandType.StartsWith(TEXT("job.")))
+    {
+        return MakeJobError(TEXT("INVALID_PARAMS"), TEXT("Jobs cannot start other jobs"));
+    }
+    if (CommandType != TEXT("batch") && !CommandRegistry->Find(CommandType))
+    {
+        return MakeJobError(TEXT("UNKNOWN_COMMAND"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
+    }
+    if (!JobRegistry.IsValid())
+    {
+        return MakeJobError(TEXT("JOB_START_FAILED"), TEXT("The bridge is shutting down"));
+    }
+
+    TSharedPtr<FJsonObject> CommandParams = MakeShared<FJsonObject>();
+    const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+    if (Params->TryGetObjectField(TEXT("params"), ParamsObject))
+    {
+        CommandParams = *ParamsObject;
+    }
+
+    const FString JobId = UnrealMCP::Protocol::FJobRegistry::MakeJobId();
+    TSharedRef<UnrealMCP::Protocol::FCommandContext, ESPMode::ThreadSafe> Context = MakeShared<UnrealMCP::Protocol::FCommandContext, ESPMode::ThreadSafe>(JobId);
+    FString PriorityName;
+    UnrealMCP::Protocol::ECommandPriority Priority;
+    if (Params->TryGetStringField(TEXT("priority"), PriorityName) && UnrealMCP::Protocol::LexTryParseString(Priority, *PriorityName))
+    {
+        Context->SetPriority(Priority);
+    }
+    // The active context belongs to the game thread; job.start itself may run on a worker.
+    if (const UnrealMCP::Protocol::FCommandContext* Caller = IsInGameThread() ? UnrealMCP::Protocol::FCommandContext::GetActive() : nullptr)
+    {
+        Context->SetAuditRequested(Caller->IsAuditRequested());
+        Context->SetUndoFreeRequested(Caller->IsUndoFreeRequested());
+        // The job queues under the session that started it, so it counts against that session's share.
+        Context->SetScheduling(Caller->GetSessionId(), Caller->GetShare());
+    }
+
+    // Progress lands in the job record instead of on a connection, so job.status can report it.
+    TWeakPtr<UnrealMCP::Protocol::FJobRegistry, ESPMode::ThreadSafe> WeakJobs = JobRegistry;
+    Context->SetProgressSink([WeakJobs, JobId](const TSharedRef<FJsonObject>& Frame)
+    {
+        TSharedPtr<UnrealMCP::Protocol::FJobRegistry, ESPMode::ThreadSafe> Jobs = WeakJobs.Pin();
+        if (!Jobs.IsValid())
+        {
+            return false;
+        }
+        Jobs->SetProgress(JobId, static_cast<int32>(Frame->GetNumberField(TEXT("done"))), static_cast<int32>(Frame->GetNumberField(TEXT("total"))), Frame->GetStringField(TEXT("phase")));
+        return true;
+    });
+
+    JobRegistry->Add(JobId, CommandType, Context);
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Started job %s (%s)"), *JobId, *CommandType);
+    ExecuteCommandAsync(CommandType, CommandParams, JobId, [WeakJobs, JobId](TSharedRef<FJsonObject> Response)
+    {
+        if (TSharedPtr<UnrealMCP::Protocol::FJobRegistry, ESPMode::ThreadSafe> Jobs = WeakJobs.Pin())
+        {
+            Jobs->Complete(JobId, Response);
+        }
+    }, nullptr, Context);
+
+    TSharedPtr<FJsonObject> Status = JobRegistry->GetStatus(JobId);
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(Status);
+}
+
+// Initialize subsystem
+void UUnrealMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
+{
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Initializing"));
+    const double InitializeStart = FPlatformTime::Seconds();
+
+    bIsRunning = false;
+    ListenerSocket = nullptr;
+    ConnectionSocket = nullptr;
+    ServerThread = nullptr;
+    ServerRunnable = nullptr;
+
+    EventHub = MakeShared<UnrealMCP::Protocol::FEventHub, ESPMode::ThreadSafe>();
+    EventHub->Start();
+
+    CommandScheduler = MakeShared<UnrealMCP::Protocol::FCommandScheduler, ESPMode::ThreadSafe>();
+    CommandScheduler->Start();
+
+    ResponseCache = MakeShared<UnrealMCP::Protocol::FResponseCache, ESPMode::ThreadSafe>();
+    ResponseCache->Start();
+    EventHub->SetCacheGenerationSource([WeakCache = TWeakPtr<UnrealMCP::Protocol::FResponseCache, ESPMode::ThreadSafe>(ResponseCache)]()
+    {
+        const TSharedPtr<UnrealMCP::Protocol::FResponseCache, ESPMode::ThreadSafe> Cache = WeakCache.Pin();
+        return Cache.IsValid() && !Cache->IsPlaySessionActive() ? Cache->GetGeneration() : INDEX_NONE;
+    });
+
+    FAssetQuery::StartSnapshotTracking();
+    FAssetNameIndex::Get().Start();
+    FAssetClassResolver::Get().Start();
+    FAssetIndexCache::Get().Start();
+    FContentScanCache::Get().Start();
+    FActorIndex::Get().Start();
+    FActorSpatialIndex::Get().Start();
+    FWorldChangeLog::Get().Start();
+    FPropertyPathCache::Get().Start();
+    FBlueprintResolver::Get().Start();
+
+    RequestDedup = MakeShared<UnrealMCP::Protocol::FRequestDedup, ESPMode::ThreadSafe>();
+    JobRegistry = MakeShared<UnrealMCP::Protocol::FJobRegistry, ESPMode::ThreadSafe>();
+
+    StallWatchdog = MakeShared<FStallWatchdog, ESPMode::ThreadSafe>();
+
+    // Follow-ups run as watched slices, so they count toward MCP game-thread time like any command.
+    ResponsePrefetcher = MakeShared<UnrealMCP::Protocol::FResponsePrefetcher, ESPMode::ThreadSafe>(ResponseCache.ToSharedRef(),
+        [this](const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+        {
+            UNREALMCP_TRACE_SCOPE(MCP_Prefetch);
+            LLM_SCOPE_BYTAG(UnrealMCP);
+            StallWatchdog->BeginSlice(CommandType, TEXT("prefetch"), Params);
+            TSharedRef<FJsonObject> Response = BuildCommandResponse(CommandType, Params);
+            StallWatchdog->EndSlice();
+            return Response;
+        });
+    CommandScheduler->SetIdleStep([WeakPrefetcher = TWeakPtr<UnrealMCP::Protocol::FResponsePrefetcher, ESPMode::ThreadSafe>(ResponsePrefetcher)](double SliceDeadline)
+    {
+        if (const TSharedPtr<UnrealMCP::Protocol::FResponsePrefetcher, ESPMode::ThreadSafe> Prefetcher = WeakPrefetcher.Pin())
+        {
+            Prefetcher->RunIdle(SliceDeadline);
+        }
+    });
+
+    // The write gate checks a compiled snapshot of the settings; recompile it when they are edited.
+    FWriteGate::RefreshPolicy();
+    SettingsChangedHandle = FUnrealMCPRuntimeConfig::OnChanged().AddUObject(this, &UUnrealMCPBridge::HandleRuntimeConfigChanged);
+
+    // Registry reads may leave the game thread only once the initial scan is done; until then
+    // they would block on (or race) the gatherer.
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    if (AssetRegistry.IsLoadingAssets())
+    {
+        AssetRegistryFilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddUObject(this, &UUnrealMCPBridge::HandleAssetRegistryFilesLoaded);
+    }
+    else
+    {
+        bAssetRegistryReady = true;
+    }
+
+    const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+    if (Settings)
+    {
+        FString Host = Settings->ServerHost;
+        Host.TrimStartAndEndInline();
+
+        FIPv4Address ParsedAddress;
+        if (!FIPv4Address::Parse(Host, ParsedAddress))
+        {
+            if (Host.Equals(TEXT("localhost"), ESearchCase::IgnoreCase))
+            {
+                ParsedAddress = FIPv4Address::InternalLoopback;
+            }
+            else
+            {
+                ParsedAddress = FIPv4Address::Any;
+                UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Invalid ServerHost '%s', defaulting to %s"), *Host, *ParsedAddress.ToString());
+            }
+        }
+
+        ServerAddress = ParsedAddress;
+        Port = static_cast<uint16>(FMath::Clamp(Settings->ServerPort, 1, 65535));
+        FMetricsRegistry::MarkStartup(TEXT("bridge_initialized"), InitializeStart);
+
+        // Other commandlets (cooks, benchmarks) never listen; UnrealMCPServe starts the server itself.
+        if (Settings->bAutoConnectOnEditorStartup && !IsRunningCommandlet())
+        {
+            StartServer();
+        }
+    }
+    else
+    {
+        ServerAddress = FIPv4Address::InternalLoopback;
+        Port = 12029;
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Failed to load settings, using defaults"));
+        StartServer();
+    }
+}
+
+// Clean up resources when subsystem is destroyed
+void UUnrealMCPBridge::Deinitialize()
+{
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Shutting down"));
+    StopServer();
+
+    // Parked requests still need an answer; they run as they are before the scheduler goes away.
+    ReleaseScanWaiters(false);
+
+    if (EventHub.IsValid())
+    {
+        EventHub->Stop();
+        EventHub.Reset();
+    }
+
+    if (CommandScheduler.IsValid())
+    {
+        CommandScheduler->Stop();
+        CommandScheduler.Reset();
+    }
+
+    ResponsePrefetcher.Reset();
+
+    if (ResponseCache.IsValid())
+    {
+        ResponseCache->Stop();
+        ResponseCache.Reset();
+    }
+    FAssetQuery::StopSnapshotTracking();
+    FAssetNameIndex::Get().Stop();
+    FAssetClassResolver::Get().Stop();
+    FAssetIndexCache::Get().Stop();
+    FContentScanCache::Get().Stop();
+    FActorIndex::Get().Stop();
+    FActorSpatialIndex::Get().Stop();
+    FWorldChangeLog::Get().Stop();
+    FPropertyPathCache::Get().Stop();
+    FBlueprintResolver::Get().Stop();
+    FBlueprintCompileQueue::Get().Stop();
+    FBlueprintGraphIndex::Get().Stop();
+    RequestDedup.Reset();
+    JobRegistry.Reset();
+
+    FMemoryPolicy::Stop();
+    if (StallWatchdog.IsValid())
+    {
+        StallWatchdog->Shutdown();
+        StallWatchdog.Reset();
+    }
+
+    FSourceControlService::StopStatusRefresh();
+
+    if (SettingsChangedHandle.IsValid())
+    {
+        FUnrealMCPRuntimeConfig::OnChanged().Remove(SettingsChangedHandle);
+        SettingsChangedHandle.Reset();
+    }
+
+    if (AssetRegistryFilesLoadedHandle.IsValid())
+    {
+        if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+        {
+            AssetRegistryModule->Get().OnFilesLoaded().Remove(AssetRegistryFilesLoadedHandle);
+        }
+        AssetRegistryFilesLoadedHandle.Reset();
+    }
+}
+
+void UUnrealMCPBridge::HandleRuntimeConfigChanged()
+{
+    FWriteGate::RefreshPolicy();
+
+    // The rest is applied by StartServer; while the server runs, take edits without a restart.
+    if (!bIsRunning)
+    {
+        return;
+    }
+    const FUnrealMCPRuntimeConfig& Config = FUnrealMCPRuntimeConfig::Get();
+    CommandScheduler->SetBudgetMs(Config.GameThreadBudgetMs);
+    ResponseCache->SetMaxEntries(Config.ResponseCacheMaxEntries);
+    ResponsePrefetcher->SetMaxFollowUps(Config.bSpeculativePrefetch ? Config.PrefetchFollowUps : 0);
+    RequestDedup->SetWindowSeconds(Config.RequestDedupWindowSec);
+    JobRegistry->SetRetentionSeconds(Config.JobRetentionMin * 60.0);
+}
+
+void UUnrealMCPBridge::HandleAssetRegistryFilesLoaded()
+{
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Asset registry scan finished; registry queries may run off the game thread"));
+    {
+        FScopeLock Lock(&ScanWaitersLock);
+        bAssetRegistryReady = true;
+    }
+
+    // Answers cached during the scan carry "complete": false.
+    if (ResponseCache.IsValid())
+    {
+        ResponseCache->Invalidate();
+    }
+    ReleaseScanWaiters(false);
+}
+
+bool UUnrealMCPBridge::ParkUntilScanFinished(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& RequestId, TFunction<void(TSharedRef<FJsonObject>)>& OnComplete,
+    TSharedPtr<UnrealMCP::Protocol::FResponseStream, ESPMode::ThreadSafe>& Stream,
+    TSharedPtr<UnrealMCP::Protocol::FCommandContext, ESPMode::ThreadSafe>& Context)
+{
+    bool bWaitForScan = false;
+    if (bAssetRegistryReady || !Params.IsValid() || !Params->TryGetBoolField(TEXT("waitForScan"), bWaitForScan) || !bWaitForScan)
+    {
+        return false;
+    }
+
+    double TimeoutMs = 30000.0;
+    Params->TryGetNumberField(TEXT("scanTimeoutMs"), TimeoutMs);
+    TimeoutMs = FMath::Clamp(TimeoutMs, 0.0, 600000.0);
+
+    // Dispatched again without the flag, so the second pass runs it whatever the scan state.
+    TSharedPtr<FJsonObject> Unparked = MakeShared<FJsonObject>(*Params);
+    Unparked->RemoveField(TEXT("waitForScan"));
+    Unparked->RemoveField(TEXT("scanTimeoutMs"));
+
+    FScopeLock Lock(&ScanWaitersLock);
+    if (bAssetRegistryReady)
+    {
+        return false;
+    }
+
+    FScanWaiter& Waiter = ScanWaiters.AddDefaulted_GetRef();
+    Waiter.CommandType = CommandType;
+    Waiter.Params = Unparked;
+    Waiter.RequestId = RequestId;
+    Waiter.OnComplete = MoveTemp(OnComplete);
+    Waiter.Stream = MoveTemp(Stream);
+    Waiter.Context = MoveTemp(Context);
+    Waiter.DeadlineSeconds = FPlatformTime::Seconds() + TimeoutMs / 1000.0;
+
+    if (!ScanWaitTickerHandle.IsValid())
+    {
+        ScanWaitTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float)
+        {
+            ReleaseScanWaiters(true);
+            return true;
+        }), 0.1f);
+    }
+
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: %s (requestId=%s) waits up to %.0f ms for the asset registry scan"), *CommandType, *RequestId, TimeoutMs);
+    return true;
+}
+
+void UUnrealMCPBridge::ReleaseScanWaiters(bool bOnlyExpired)
+{
+    TArray<FScanWaiter> Released;
+    {
+        FScopeLock Lock(&ScanWaitersLock);
+        const double Now = FPlatformTime::Seconds();
+        for (int32 Index = ScanWaiters.Num() - 1; Index >= 0; --Index)
+        {
+            if (!bOnlyExpired || ScanWaiters[Index].DeadlineSeconds <= Now)
+            {
+                Released.Add(MoveTemp(ScanWaiters[Index]));
+                ScanWaiters.RemoveAt(Index, 1, EAllowShrinking::No);
+            }
+        }
+
+        if (ScanWaiters.Num() == 0 && ScanWaitTickerHandle.IsValid())
+        {
+            FTSTicker::GetCoreTicker().RemoveTicker(ScanWaitTickerHandle);
+            ScanWaitTickerHandle.Reset();
+        }
+    }
+
+    // Oldest first, outside the lock: a released request may complete synchronously from the cache.
+    for (int32 Index = Released.Num() - 1; Index >= 0; --Index)
+    {
+        FScanWaiter& Waiter = Released[Index];
+        ExecuteCommandAsync(Waiter.CommandType, Waiter.Params, Waiter.RequestId, MoveTemp(Waiter.OnComplete), MoveTemp(Waiter.Stream), MoveTemp(Waiter.Context));
+    }
+}
+
+// Start the MCP server
+bool UUnrealMCPBridge::IsIdle()
+{
+    if (ServerRunnable && ServerRunnable->GetConnectionCount() > 0)
+    {
+        return false;
+    }
+    if (CommandScheduler.IsValid() && CommandScheduler->GetQueuedCount() > 0)
+    {
+        return false;
+    }
+    FScopeLock Lock(&ScanWaitersLock);
+    return ScanWaiters.Num() == 0;
+}
+
+void UUnrealMCPBridge::StartServer()
+{
+    if (bIsRunning)
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Server is already running"));
+        return;
+    }
+
+    const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+    if (!Settings)
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Cannot start server without settings"));
+        return;
+    }
+
+    // Handlers, schemas and the checkout refresh serve requests only, so an editor (or a cook) that
+    // never listens never builds them.
+    EnsureCommandsRegistered();
+    FSourceControlService::StartStatusRefresh();
+
+    const FUnrealMCPPerformanceValues Performance = Settings->GetPerformanceValues();
+    const double BindStart = FPlatformTime::Seconds();
+    TSharedPtr<UnrealMCP::Protocol::IStreamListener, ESPMode::ThreadSafe> Listener;
+    if (Performance.Transport == EUnrealMCPTransport::LocalIpc)
+    {
+        FString ListenError;
+        Listener = UnrealMCP::Protocol::CreateLocalListener(Settings->LocalEndpointName, ListenError);
+        if (!Listener.IsValid())
+        {
+            UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to start local IPC listener: %s"), *ListenError);
+            return;
+        }
+
+        bIsRunning = true;
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Server started on %s"), *Listener->Describe());
+    }
+    else if (!StartTcpListener(*Settings, Listener))
+    {
+        return;
+    }
+    FMetricsRegistry::MarkStartup(TEXT("listener_bound"), BindStart);
+
+    // Start server thread
+    FMCPServerConfig ServerConfig;
+    ServerConfig.HandshakeTimeoutSeconds = Settings->ConnectTimeoutSec;
+    ServerConfig.ReadTimeoutSeconds = Settings->ReadTimeoutSec;
+    ServerConfig.HeartbeatIntervalSeconds = Settings->HeartbeatIntervalSec;
+    ServerConfig.bKeepaliveOnlyHeartbeats = Settings->HeartbeatMode == EUnrealMCPHeartbeatMode::KeepaliveOnly;
+    ServerConfig.MaxConnections = Settings->MaxClientConnections;
+    ServerConfig.MaxInFlightRequests = Settings->MaxInFlightRequests;
+    ServerConfig.bAllowBinaryEncoding = Performance.bAllowBinaryEncoding;
+    ServerConfig.CompressionThresholdBytes = Performance.CompressionThresholdBytes;
+    ServerConfig.SharedMemoryRingBytes = Settings->SharedMemoryRingBytes;
+    ServerConfig.MaxOutboundQueueBytes = Settings->OutboundQueueBytes;
+    ServerConfig.bDisconnectSlowClients = Settings->SlowClientPolicy == EUnrealMCPSlowClientPolicy::Disconnect;
+    ServerConfig.SessionResumeWindowSeconds = Settings->SessionResumeWindowSec;
+    if (Settings->bCaptureTraffic)
+    {
+        ServerConfig.TrafficCapturePath = FPaths::Combine(Settings->GetEffectiveLogsDirectory(),
+            FString::Printf(TEXT("UnrealMCP_traffic_%s.mcptrace"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"))));
+    }
+
+    bRegistryQueriesOffGameThread = Settings->bRunRegistryQueriesOffGameThread;
+    CommandScheduler->SetBudgetMs(Performance.GameThreadBudgetMs);
+    MaxQueuedCommands = Settings->MaxQueuedCommands;
+    MaxQueuedCost = Settings->MaxQueuedCost;
+    ResponseCache->SetMaxEntries(Settings->ResponseCacheMaxEntries);
+    ResponsePrefetcher->SetMaxFollowUps(Settings->bSpeculativePrefetch ? Settings->PrefetchFollowUps : 0);
+    RequestDedup->SetWindowSeconds(Settings->RequestDedupWindowSec);
+    JobRegistry->SetRetentionSeconds(Settings->JobRetentionMin * 60.0);
+    StallWatchdog->Configure(Settings->SlowCommandThresholdMs, Performance.GameThreadBudgetMs, Settings->CommandMemorySampleMs);
+    // Queued counts parked commands too, whose handlers may still hold raw pointers to assets.
+    FMemoryPolicy::Start([this]() { return CommandScheduler.IsValid() && CommandScheduler->GetQueuedCount() > 0; });
+
+    ServerRunnable = new FMCPServerRunnable(this, Listener, ServerConfig);
+    ServerThread = FRunnableThread::Create(
+        ServerRunnable,
+        TEXT("UnrealMCPServerThread"),
+        0, TPri_Normal
+    );
+
+    if (!ServerThread)
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to create server thread"));
+        StopServer();
+        return;
+    }
+
+    if (Settings->MetricsHttpPort > 0)
+    {
+        MetricsEndpoint = MakeShared<FMetricsEndpoint>();
+        FString EndpointError;
+        const bool bEndpointStarted = MetricsEndpoint->Start(static_cast<uint32>(Settings->MetricsHttpPort), [this]()
+        {
+            FMetricsGauges Gauges;
+            Gauges.QueueDepth = CommandScheduler.IsValid() ? CommandScheduler->GetQueuedCount() : 0;
+            Gauges.InFlight = ServerRunnable ? ServerRunnable->GetInFlightCount() : 0;
+            Gauges.Connections = ServerRunnable ? ServerRunnable->GetConnectionCount() : 0;
+            Gauges.FramesOverBudget = StallWatchdog.IsValid() ? StallWatchdog->GetFramesOverBudget() : 0;
+            if (ResponsePrefetcher.IsValid())
+            {
+                const UnrealMCP::Protocol::FResponsePrefetcher::FStats Prefetch = ResponsePrefetcher->GetStats();
+                Gauges.PrefetchQueued = Prefetch.Queued;
+                Gauges.PrefetchRun = Prefetch.Run;
+                Gauges.PrefetchHits = Prefetch.Hits;
+                Gauges.PrefetchDropped = Prefetch.Dropped;
+                Gauges.PrefetchSeconds = Prefetch.Seconds;
+            }
+            return Gauges;
+        }, EndpointError);
+        if (!bEndpointStarted)
+        {
+            // Metrics are optional; the MCP server keeps running without them.
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Metrics endpoint disabled: %s"), *EndpointError);
+            MetricsEndpoint.Reset();
+        }
+    }
+}
+
+bool UUnrealMCPBridge::StartTcpListener(const UUnrealMCPSettings& Settings, TSharedPtr<UnrealMCP::Protocol::IStreamListener, ESPMode::ThreadSafe>& OutListener)
+{
+    FString Host = Settings.ServerHost;
+    Host.TrimStartAndEndInline();
+
+    FIPv4Address BindAddress;
+    if (!FIPv4Address::Parse(Host, BindAddress))
+    {
+        if (Host.Equals(TEXT("localhost"), ESearchCase::IgnoreCase))
+        {
+            BindAddress = FIPv4Address::InternalLoopback;
+        }
+        else if (Host.Equals(TEXT("0.0.0.0"), ESearchCase::IgnoreCase))
+        {
+            BindAddress = FIPv4Address::Any;
+        }
+        else
+        {
+            BindAddress = ServerAddress;
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Unable to parse ServerHost '%s', using %s"), *Host, *BindAddress.ToString());
+        }
+    }
+    ServerAddress = BindAddress;
+
+    Port = static_cast<uint16>(FMath::Clamp(Settings.ServerPort, 1, 65535));
+
+    // Create socket subsystem
+    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    if (!SocketSubsystem)
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to get socket subsystem"));
+        return false;
+    }
+
+    // Create listener socket
+    TSharedPtr<FSocket> NewListenerSocket = MakeShareable(SocketSubsystem->CreateSocket(NAME_Stream, TEXT("UnrealMCPListener"), false));
+    if (!NewListenerSocket.IsValid())
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to create listener socket"));
+        return false;
+    }
+
+    // Allow address reuse for quick restarts
+    NewListenerSocket->SetReuseAddr(true);
+    NewListenerSocket->SetNonBlocking(true);
+
+    // Bind to address
+    FIPv4Endpoint Endpoint(BindAddress, Port);
+    if (!NewListenerSocket->Bind(*Endpoint.ToInternetAddr()))
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to bind listener socket to %s:%d"), *BindAddress.ToString(), Port);
+        return false;
+    }
+
+    // Start listening
+    if (!NewListenerSocket->Listen(FMath::Max(5, Settings.MaxClientConnections)))
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to start listening"));
+        return false;
+    }
+
+    ListenerSocket = NewListenerSocket;
+    OutListener = UnrealMCP::Protocol::MakeSocketListener(ListenerSocket);
+    bIsRunning = true;
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Server started on %s:%d"), *BindAddress.ToString(), Port);
+    return true;
+}
+
+// Stop the MCP server
+void UUnrealMCPBridge::StopServer()
+{
+    if (!bIsRunning)
+    {
+        return;
+    }
+
+    bIsRunning = false;
+
+    // Nobody is left to receive frames.
+    FViewportStream::StopAll();
+
+    // The scrape handler reads ServerRunnable, so the route goes first.
+    MetricsEndpoint.Reset();
+
+    // Clean up thread
+    if (ServerThread)
+    {
+        ServerThread->Kill(true);
+        delete ServerThread;
+        ServerThread = nullptr;
+    }
+
+    // The runnable owns the listener; releasing it closes the socket, pipe or socket file.
+    delete ServerRunnable;
+    ServerRunnable = nullptr;
+
+    // Close sockets
+    if (ConnectionSocket.IsValid())
+    {
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ConnectionSocket.Get());
+        ConnectionSocket.Reset();
+    }
+
+    if (ListenerSocket.IsValid())
+    {
+        // Created with MakeShareable, so the last reference deletes it; DestroySocket here would free it twice.
+        ListenerSocket->Close();
+        ListenerSocket.Reset();
+    }
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Server stopped"));
+}
+
+// Execute a command received from a client
+FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& RequestId)
+{
+    // Create a promise to wait for the result
+    TSharedRef<TPromise<FString>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<FString>, ESPMode::ThreadSafe>();
+    TFuture<FString> Future = Promise->GetFuture();
+
+    ExecuteCommandAsync(CommandType, Params, RequestId, [Promise](TSharedRef<FJsonObject> Response)
+    {
+        FString ResultString;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
+        FJsonSerializer::Serialize(Response, Writer, /*bCloseWriter=*/true);
+        Promise->SetValue(MoveTemp(ResultString));
+    });
+
+    return Future.Get();
+}
+
+void UUnrealMCPBridge::ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& RequestId, TFunction<void(TSharedRef<FJsonObject>)> OnComplete,
+    TSharedPtr<UnrealMCP::Protocol::FResponseStream, ESPMode::ThreadSafe> Stream,
+    TSharedPtr<UnrealMCP::Protocol::FCommandContext, ESPMode::ThreadSafe> Context)
+{
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Executing command: %s (requestId=%s)"), *CommandType, *RequestId);
+    UNREALMCP_TRACE_SCOPE(MCP_Dispatch);
+
+    if (ParkUntilScanFinished(CommandType, Params, RequestId, OnComplete, Stream, Context))
+    {
+        return;
+    }
+
+    const FMCPCommandDescriptor* Command = CommandRegistry->Find(CommandType);
+
+    // Malformed requests are answered here, before they claim a dedup slot or wait for a frame.
+    if (Command)
+    {
+        if (TSharedPtr<FJsonObject> Invalid = MakeInvalidParamsResponse(*Command, Params, RequestId))
+        {
+            OnComplete(Invalid.ToSharedRef());
+            return;
+        }
+    }
+
+    // Session records only catch retries within one session; this catches them across MCP server
+    // restarts and instances, and folds a duplicate that races the original into its response.
+    const bool bMayMutate = CommandType == TEXT("batch") || (Command && Command->IsMutation(Params));
+    if (bMayMutate && !RequestId.IsEmpty() && !Stream.IsValid() && RequestDedup.IsValid() && RequestDedup->IsEnabled())
+    {
+        switch (RequestDedup->Claim(RequestId, CommandType, Params, OnComplete))
+        {
+        case UnrealMCP::Protocol::FRequestDedup::EClaim::Joined:
+            return;
+        case UnrealMCP::Protocol::FRequestDedup::EClaim::Owner:
+            OnComplete = [Dedup = RequestDedup, RequestId, Inner = MoveTemp(OnComplete)](TSharedRef<FJsonObject> Response)
+            {
+                Dedup->Complete(RequestId, Response);
+                Inner(Response);
+            };
+            break;
+        default:
+            break;
+        }
+    }
+
+    // The likely next reads are queued before the answer goes out; the idle step runs them into the cache.
+    if (ResponsePrefetcher.IsValid() && ResponsePrefetcher->IsEnabled() && UnrealMCP::Protocol::FResponsePrefetcher::IsTrigger(CommandType) && !Stream.IsValid() && bAssetRegistryReady)
+    {
+        OnComplete = [Prefetcher = ResponsePrefetcher, CommandType, Params, Inner = MoveTemp(OnComplete)](TSharedRef<FJsonObject> Response)
+        {
+            Prefetcher->OnResponse(CommandType, Params, *Response);
+            Inner(Response);
+        };
+    }
+
+    // Cacheable answers carry the generation they were computed in (meta.cacheGen), so a client can
+    // keep them until the editor reports a newer one. Nothing is tagged while a play session runs.
+    if (Command && Command->bCacheable && !Stream.IsValid() && ResponseCache.IsValid() && !ResponseCache->IsPlaySessionActive())
+    {
+        // The generation is taken before the lookup, so an edit made while this runs keeps the result out.
+        const int64 CacheGeneration = ResponseCache->GetGeneration();
+        if (ResponseCache->IsEnabled())
+        {
+            const FString CacheKey = UnrealMCP::Protocol::FResponseCache::MakeKey(CommandType, Params);
+            if (TSharedPtr<FJsonObject> Cached = ResponseCache->Find(CacheKey))
+            {
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Answered %s from the response cache (requestId=%s)"), *CommandType, *RequestId);
+                if (ResponsePrefetcher.IsValid())
+                {
+                    ResponsePrefetcher->NoteCacheHit(CacheKey);
+                }
+                SetCacheGeneration(*Cached, CacheGeneration, true);
+                OnComplete(Cached.ToSharedRef());
+                return;
+            }
 
-    FWriteGate::UpdateRemoteEnforcement(false, true, TArray<FString>(), TArray<FString>(), TArray<FString>());
-}
+            OnComplete = [Cache = ResponseCache, CacheKey, CacheGeneration, Inner = MoveTemp(OnComplete)](TSharedRef<FJsonObject> Response)
+            {
+                Cache->Store(CacheKey, CacheGeneration, Response);
+                SetCacheGeneration(*Response, CacheGeneration, true);
+                Inner(Response);
+            };
+        }
+        else
+        {
+            OnComplete = [CacheGeneration, Inner = MoveTemp(OnComplete)](TSharedRef<FJsonObject> Response)
+            {
+                SetCacheGeneration(*Response, CacheGeneration, true);
+                Inner(Response);
+            };
+        }
+    }
 
-UUnrealMCPBridge::~UUnrealMCPBridge()
-{
-    EditorCommands.Reset();
-    BlueprintCommands.Reset();
-    BlueprintNodeCommands.Reset();
-    ProjectCommands.Reset();
-    UMGCommands.Reset();
-    SourceControlCommands.Reset();
-    ContentTools.Reset();
-}
+    if (Command && Command->Affinity == EMCPThreadAffinity::AnyThread && !Stream.IsValid() && bRegistryQueriesOffGameThread && bAssetRegistryReady)
+    {
+        // Registry-only reads; nothing here touches editor state, so they need not wait for the frame.
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, CommandType, RequestId, Params, OnComplete = MoveTemp(OnComplete), Context = MoveTemp(Context)]()
+        {
+            if (TSharedPtr<FJsonObject> NotStarted = MakeNotStartedResponse(CommandType, RequestId, Context.Get()))
+            {
+                OnComplete(NotStarted.ToSharedRef());
+                return;
+            }
 
-// Initialize subsystem
-void UUnrealMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
-{
-    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Initializing"));
+            // Class lookups (FindObject) must not overlap a garbage collection.
+            FGCScopeGuard GCGuard;
+            UNREALMCP_TRACE_SCOPE(MCP_WorkerCommand);
+            LLM_SCOPE_BYTAG(UnrealMCP);
+            UNREALMCP_TRACE_BOOKMARK(TEXT("MCP start %s %s"), *CommandType, *RequestId);
+            if (Context.IsValid())
+            {
+                Context->MarkStarted();
+            }
+            const double HandlerStart = FPlatformTime::Seconds();
+            TSharedRef<FJsonObject> Response = BuildCommandResponse(CommandType, Params);
+            if (Context.IsValid())
+            {
+                Context->AddHandlerSlice(HandlerStart, FPlatformTime::Seconds());
+            }
+            OnComplete(Response);
+        });
+        return;
+    }
 
-    bIsRunning = false;
-    ListenerSocket = nullptr;
-    ConnectionSocket = nullptr;
-    ServerThread = nullptr;
+    // Read-only handlers (and batches, between entries) may yield when the frame budget runs out;
+    // mutations, and batches sharing one transaction, always run to completion inside it.
+    bool bTransactionalBatch = false;
+    if (CommandType == TEXT("batch") && Params.IsValid())
+    {
+        Params->TryGetBoolField(TEXT("transaction"), bTransactionalBatch);
+    }
+    const bool bYieldable = (CommandType == TEXT("batch") && !bTransactionalBatch) || (Command && Command->Mutation == EMCPCommandMutation::ReadOnly);
+    // Editor delegates catch most edits; this also covers ones they miss (source control state, settings).
+    const bool bInvalidatesCache = CommandType == TEXT("batch") || (Command && Command->Mutation != EMCPCommandMutation::ReadOnly);
 
-    const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
-    if (Settings)
+    // Batches run many commands, so they queue behind interactive work unless the client says otherwise.
+    UnrealMCP::Protocol::ECommandPriority Priority = UnrealMCP::Protocol::ECommandPriority::Interactive;
+    if (Command)
     {
-        FString Host = Settings->ServerHost;
-        Host.TrimStartAndEndInline();
+        Priority = Command->Priority;
+    }
+    else if (CommandType == TEXT("batch"))
+    {
+        Priority = UnrealMCP::Protocol::ECommandPriority::Bulk;
+    }
+    if (Context.IsValid())
+    {
+        Priority = Context->GetPriorityOr(Priority);
+    }
 
-        FIPv4Address ParsedAddress;
-        if (!FIPv4Address::Parse(Host, ParsedAddress))
+    // A batch costs one unit per entry, and at least what its lane costs.
+    int32 Cost = UnrealMCP::Protocol::FCommandScheduler::GetDefaultCost(Priority);
+    const TArray<TSharedPtr<FJsonValue>>* BatchCommands = nullptr;
+    if (CommandType == TEXT("batch") && Params.IsValid() && Params->TryGetArrayField(TEXT("commands"), BatchCommands))
+    {
+        Cost = FMath::Max(Cost, BatchCommands->Num());
+    }
+
+    // Refusing now, with a retry hint, beats letting the request time out at the back of a backlog.
+    if (TSharedPtr<FJsonObject> Overloaded = MakeOverloadedResponse(CommandType, RequestId, Priority, Cost))
+    {
+        OnComplete(Overloaded.ToSharedRef());
+        return;
+    }
+
+    // Each session gets its own queue in the lane, so one client's backlog does not hold up another's commands.
+    const FString SessionId = Context.IsValid() ? Context->GetSessionId() : FString();
+    const float Share = Context.IsValid() ? Context->GetShare() : 1.0f;
+
+    // Queue execution on the game thread; the completion runs there too, so callers must not block in it.
+    CommandScheduler->Enqueue(Priority, [this, CommandType, RequestId, Params, OnComplete = MoveTemp(OnComplete), Stream = MoveTemp(Stream), Context = MoveTemp(Context), bYieldable, bInvalidatesCache, bStarted = false](double SliceDeadline) mutable
+    {
+        if (!bStarted)
         {
-            if (Host.Equals(TEXT("localhost"), ESearchCase::IgnoreCase))
+            if (TSharedPtr<FJsonObject> NotStarted = MakeNotStartedResponse(CommandType, RequestId, Context.Get()))
             {
-                ParsedAddress = FIPv4Address::InternalLoopback;
+                OnComplete(NotStarted.ToSharedRef());
+                return true;
             }
-            else
+            bStarted = true;
+            UNREALMCP_TRACE_BOOKMARK(TEXT("MCP start %s %s"), *CommandType, *RequestId);
+        }
+
+        UNREALMCP_TRACE_SCOPE(MCP_CommandSlice);
+
+        if (Context.IsValid())
+        {
+            Context->MarkStarted();
+            Context->SetYieldDeadline(bYieldable ? SliceDeadline : 0.0);
+            Context->SetSuspendable(true);
+        }
+
+        TSharedPtr<FJsonObject> Response;
+        {
+            UnrealMCP::Protocol::FResponseStream::FScopedActive ActiveStream(Stream.Get());
+            UnrealMCP::Protocol::FCommandContext::FScopedActive ActiveContext(Context.Get());
+            LLM_SCOPE_BYTAG(UnrealMCP);
+            StallWatchdog->BeginSlice(CommandType, RequestId, Params);
+            FMemoryPolicy::BeginSlice();
+            Response = ExecuteCommandOnGameThread(CommandType, Params);
+            FMemoryPolicy::EndSlice();
+            const FStallWatchdog::FSliceStats SliceStats = StallWatchdog->EndSlice();
+            if (Context.IsValid())
             {
-                ParsedAddress = FIPv4Address::Any;
-                UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Invalid ServerHost '%s', defaulting to %s"), *Host, *ParsedAddress.ToString());
+                Context->AddMemorySlice(SliceStats.StartUsedBytes, SliceStats.PeakUsedBytes, SliceStats.EndUsedBytes);
             }
         }
 
-        ServerAddress = ParsedAddress;
-        Port = static_cast<uint16>(FMath::Clamp(Settings->ServerPort, 1, 65535));
+        if (Context.IsValid() && Context->ConsumeYield())
+        {
+            return false;
+        }
 
-        if (Settings->bAutoConnectOnEditorStartup)
+        if (bInvalidatesCache && ResponseCache.IsValid())
         {
-            StartServer();
+            ResponseCache->Invalidate();
+            // Tells a client caching reads to drop what it holds before it sees the change event.
+            SetCacheGeneration(*Response, ResponseCache->GetGeneration(), false);
         }
+
+        OnComplete(Response.ToSharedRef());
+        return true;
+    }, Cost, SessionId, Share);
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::MakeOverloadedResponse(const FString& CommandType, const FString& RequestId, UnrealMCP::Protocol::ECommandPriority Priority, int32 Cost) const
+{
+    if (Priority == UnrealMCP::Protocol::ECommandPriority::Control || !CommandScheduler.IsValid())
+    {
+        return nullptr;
     }
-    else
+
+    // Past the memory ceiling only cheap commands get in, until the policy's collections bring it back down.
+    if (Cost > 1 && FMemoryPolicy::IsOverCeiling())
     {
-        ServerAddress = FIPv4Address::InternalLoopback;
-        Port = 12029;
-        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Failed to load settings, using defaults"));
-        StartServer();
+        const FMemoryPolicy::FStats Memory = FMemoryPolicy::GetStats();
+        const int64 RetryAfterMs = 2000;
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Refused %s, editor uses %lld MB of its %lld MB ceiling; retry in %lld ms (requestId=%s)"),
+            *CommandType, Memory.UsedBytes / (1024 * 1024), Memory.CeilingBytes / (1024 * 1024), RetryAfterMs, *RequestId);
+
+        TSharedRef<FJsonObject> Details = MakeShared<FJsonObject>();
+        Details->SetBoolField(TEXT("retryable"), true);
+        Details->SetNumberField(TEXT("retryAfterMs"), static_cast<double>(RetryAfterMs));
+        Details->SetStringField(TEXT("reason"), TEXT("memory"));
+        Details->SetNumberField(TEXT("usedBytes"), static_cast<double>(Memory.UsedBytes));
+        Details->SetNumberField(TEXT("ceilingBytes"), static_cast<double>(Memory.CeilingBytes));
+        Details->SetNumberField(TEXT("cost"), Cost);
+        TSharedRef<FJsonObject> Overloaded = UnrealMCP::Protocol::MakeErrorResponse(UnrealMCP::Protocol::EProtocolErrorCode::Overloaded, TEXT("The editor is past its memory ceiling; retry later."), Details);
+        Overloaded->SetStringField(TEXT("status"), TEXT("error"));
+        return Overloaded;
     }
+
+    const int32 QueuedCount = CommandScheduler->GetQueuedCount();
+    const int32 QueuedCost = CommandScheduler->GetQueuedCost();
+    const bool bCountExceeded = MaxQueuedCommands > 0 && QueuedCount >= MaxQueuedCommands;
+    // An empty queue always admits, so one command costlier than the whole limit can still run.
+    const bool bCostExceeded = MaxQueuedCost > 0 && QueuedCost > 0 && QueuedCost + Cost > MaxQueuedCost;
+    if (!bCountExceeded && !bCostExceeded)
+    {
+        return nullptr;
+    }
+
+    // Long enough for the queue to work off what stands between this command and the limit.
+    int32 ExcessCost = QueuedCost + Cost - MaxQueuedCost;
+    if (bCountExceeded && QueuedCount > 0)
+    {
+        const int32 ExcessCommands = QueuedCount + 1 - MaxQueuedCommands;
+        ExcessCost = FMath::Max(ExcessCost, FMath::DivideAndRoundUp(QueuedCost * ExcessCommands, QueuedCount));
+    }
+    const int64 RetryAfterMs = FMath::Clamp<int64>(FMath::CeilToInt64(CommandScheduler->EstimateDrainSeconds(FMath::Max(ExcessCost, 1)) * 1000.0), 50, 30000);
+
+    UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Refused %s, game-thread queue holds %d commands (cost %d); retry in %lld ms (requestId=%s)"),
+        *CommandType, QueuedCount, QueuedCost, RetryAfterMs, *RequestId);
+
+    TSharedRef<FJsonObject> Details = MakeShared<FJsonObject>();
+    Details->SetBoolField(TEXT("retryable"), true);
+    Details->SetNumberField(TEXT("retryAfterMs"), static_cast<double>(RetryAfterMs));
+    Details->SetNumberField(TEXT("queueDepth"), QueuedCount);
+    Details->SetNumberField(TEXT("queuedCost"), QueuedCost);
+    Details->SetNumberField(TEXT("cost"), Cost);
+    TSharedRef<FJsonObject> Overloaded = UnrealMCP::Protocol::MakeErrorResponse(UnrealMCP::Protocol::EProtocolErrorCode::Overloaded, TEXT("The editor's command queue is full; retry later."), Details);
+    Overloaded->SetStringField(TEXT("status"), TEXT("error"));
+    return Overloaded;
 }
 
-// Clean up resources when subsystem is destroyed
-void UUnrealMCPBridge::Deinitialize()
+TSharedPtr<FJsonObject> UUnrealMCPBridge::MakeInvalidParamsResponse(const FMCPCommandDescriptor& Command, const TSharedPtr<FJsonObject>& Params, const FString& RequestId)
 {
-    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Shutting down"));
-    StopServer();
+    FString Path;
+    FString Reason;
+    if (!Command.ParamSchema.IsValid() || Command.ParamSchema->Validate(Params, Path, Reason))
+    {
+        return nullptr;
+    }
+
+    const FString Message = Path.IsEmpty() ? FString::Printf(TEXT("%s params %s"), *Command.Name, *Reason)
+        : FString::Printf(TEXT("%s: '%s' %s"), *Command.Name, *Path, *Reason);
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Rejected %s (requestId=%s)"), *Message, *RequestId);
+
+    TSharedRef<FJsonObject> Details = MakeShared<FJsonObject>();
+    Details->SetStringField(TEXT("tool"), Command.Name);
+    Details->SetStringField(TEXT("path"), Path);
+    Details->SetStringField(TEXT("reason"), Reason);
+    TSharedRef<FJsonObject> Invalid = UnrealMCP::Protocol::MakeErrorResponse(UnrealMCP::Protocol::EProtocolErrorCode::InvalidParams, Message, Details);
+    Invalid->SetStringField(TEXT("status"), TEXT("error"));
+    return Invalid;
 }
 
-// Start the MCP server
-void UUnrealMCPBridge::StartServer()
+TSharedPtr<FJsonObject> UUnrealMCPBridge::MakeNotStartedResponse(const FString& CommandType, const FString& RequestId, const UnrealMCP::Protocol::FCommandContext* Context)
 {
-    if (bIsRunning)
+    if (Context && Context->IsCancelled())
     {
-        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Server is already running"));
-        return;
+        // Cancelled while still queued: answer without touching the editor.
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Command %s cancelled before it started (requestId=%s)"), *CommandType, *RequestId);
+        TSharedRef<FJsonObject> Cancelled = UnrealMCP::Protocol::MakeErrorResponse(UnrealMCP::Protocol::EProtocolErrorCode::Cancelled, TEXT("Command was cancelled before it started."));
+        Cancelled->SetStringField(TEXT("status"), TEXT("error"));
+        return Cancelled;
+    }
+    if (Context && Context->IsPastDeadline())
+    {
+        // The caller gave up while this sat in the queue (e.g. behind an editor hitch); running it
+        // now would only apply a mutation nobody is waiting for.
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Command %s dropped, deadline passed while queued (requestId=%s)"), *CommandType, *RequestId);
+        TSharedRef<FJsonObject> Expired = UnrealMCP::Protocol::MakeErrorResponse(UnrealMCP::Protocol::EProtocolErrorCode::DeadlineExceeded, TEXT("Deadline passed before the command started."));
+        Expired->SetStringField(TEXT("status"), TEXT("error"));
+        return Expired;
     }
+    return nullptr;
+}
 
-    const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
-    if (!Settings)
+TSharedRef<FJsonObject> UUnrealMCPBridge::ExecuteCommandOnGameThread(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    check(IsInGameThread());
+
+    // Any request counts as activity for a client-held bulk edit, so it only times out once the client
+    // goes quiet. Touched here rather than per handler, since handlers also run on workers.
+    FBulkEdit::TouchExplicit();
+
+    if (CommandType == TEXT("batch"))
     {
-        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Cannot start server without settings"));
-        return;
+        return ExecuteBatch(Params);
     }
 
-    FString Host = Settings->ServerHost;
-    Host.TrimStartAndEndInline();
+    return BuildCommandResponse(CommandType, Params);
+}
 
-    FIPv4Address BindAddress;
-    if (!FIPv4Address::Parse(Host, BindAddress))
+TSharedRef<FJsonObject> UUnrealMCPBridge::ExecuteBatch(const TSharedPtr<FJsonObject>& Params)
+{
+    TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+
+    const TArray<TSharedPtr<FJsonValue>>* Commands = nullptr;
+    if (!Params.IsValid() || !Params->TryGetArrayField(TEXT("commands"), Commands))
     {
-        if (Host.Equals(TEXT("localhost"), ESearchCase::IgnoreCase))
+        ResponseJson->SetBoolField(TEXT("ok"), false);
+        ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+        TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+        ErrorObject->SetStringField(TEXT("code"), TEXT("INVALID_PARAMS"));
+        ErrorObject->SetStringField(TEXT("message"), TEXT("batch requires a 'commands' array"));
+        ResponseJson->SetObjectField(TEXT("error"), ErrorObject);
+        return ResponseJson;
+    }
+
+    bool bStopOnError = false;
+    Params->TryGetBoolField(TEXT("stopOnError"), bStopOnError);
+    bool bTransaction = false;
+    Params->TryGetBoolField(TEXT("transaction"), bTransaction);
+
+    // Batch entries answer inside the batch envelope, never as a separate stream.
+    UnrealMCP::Protocol::FResponseStream::FScopedActive NoStream(nullptr);
+
+    // The editor UI catches up once per batch slice rather than after every entry.
+    FBulkEdit::FScope BulkEdit;
+
+    // Unless the batch shares a transaction, every entry runs in its own, so a long batch may pause
+    // between entries at the end of a frame's budget and pick up where it stopped on the next one.
+    UnrealMCP::Protocol::FCommandContext* Context = UnrealMCP::Protocol::FCommandContext::GetActive();
+    TSharedPtr<FBatchResumeState> State = Context ? Context->TakeResumeState<FBatchResumeState>() : nullptr;
+    if (!State.IsValid())
+    {
+        State = MakeShared<FBatchResumeState>();
+        State->Results.Reserve(Commands->Num());
+    }
+    const double SliceDeadline = Context ? Context->GetYieldDeadline() : 0.0;
+
+    // With "transaction": true every entry joins one undo transaction (the client's open one, if
+    // any), so objects are snapshotted once and the batch undoes as a single step. Such a batch
+    // never yields: the transaction must not stay open across frames.
+    FString BatchTransactionId;
+    if (bTransaction && !FTransactionManager::IsSharedOpen())
+    {
+        FString TransactionError;
+        if (!FTransactionManager::OpenShared(FWriteGate::GetTransactionName(), 0.0, BatchTransactionId, TransactionError))
         {
-            BindAddress = FIPv4Address::InternalLoopback;
+            ResponseJson->SetBoolField(TEXT("ok"), false);
+            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+            TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+            ErrorObject->SetStringField(TEXT("code"), TEXT("TRANSACTION_FAILED"));
+            ErrorObject->SetStringField(TEXT("message"), TransactionError);
+            ResponseJson->SetObjectField(TEXT("error"), ErrorObject);
+            return ResponseJson;
         }
-        else if (Host.Equals(TEXT("0.0.0.0"), ESearchCase::IgnoreCase))
+    }
+
+    TArray<TSharedPtr<FJsonValue>>& Results = State->Results;
+    int32& Failed = State->Failed;
+    bool bStopped = false;
+    bool bCancelled = false;
+
+    const int32 FirstIndex = State->NextIndex;
+    if (FirstIndex == 0)
+    {
+        PrefetchBatchCheckouts(*Commands);
+    }
+    for (int32 Index = FirstIndex; Index < Commands->Num(); ++Index)
+    {
+        if (UnrealMCP::Protocol::FCommandContext::IsActiveCancelled())
         {
-            BindAddress = FIPv4Address::Any;
+            bCancelled = true;
+            bStopped = true;
+            break;
+        }
+        if (!bTransaction && Index > FirstIndex && Context && Context->ShouldYield())
+        {
+            State->NextIndex = Index;
+            Context->Yield(State.ToSharedRef());
+            return ResponseJson;
+        }
+
+        const TSharedPtr<FJsonValue>& Entry = (*Commands)[Index];
+        const TSharedPtr<FJsonObject> EntryObject = Entry.IsValid() ? Entry->AsObject() : nullptr;
+
+        FString SubType;
+        TSharedRef<FJsonObject> SubResponse = MakeShared<FJsonObject>();
+        if (!EntryObject.IsValid() || !EntryObject->TryGetStringField(TEXT("type"), SubType) || SubType.IsEmpty())
+        {
+            SubResponse->SetBoolField(TEXT("ok"), false);
+            SubResponse->SetStringField(TEXT("status"), TEXT("error"));
+            TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+            ErrorObject->SetStringField(TEXT("code"), TEXT("INVALID_PARAMS"));
+            ErrorObject->SetStringField(TEXT("message"), TEXT("Batch entry missing 'type'"));
+            SubResponse->SetObjectField(TEXT("error"), ErrorObject);
+        }
+        else if (SubType == TEXT("batch"))
+        {
+            SubResponse->SetBoolField(TEXT("ok"), false);
+            SubResponse->SetStringField(TEXT("status"), TEXT("error"));
+            TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+            ErrorObject->SetStringField(TEXT("code"), TEXT("INVALID_PARAMS"));
+            ErrorObject->SetStringField(TEXT("message"), TEXT("Nested batches are not supported"));
+            SubResponse->SetObjectField(TEXT("error"), ErrorObject);
         }
         else
         {
-            BindAddress = ServerAddress;
-            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Unable to parse ServerHost '%s', using %s"), *Host, *BindAddress.ToString());
+            TSharedPtr<FJsonObject> SubParams = MakeShared<FJsonObject>();
+            if (EntryObject->HasTypedField<EJson::Object>(TEXT("params")))
+            {
+                SubParams = EntryObject->GetObjectField(TEXT("params"));
+            }
+
+            // Checked per entry rather than up front, so one bad entry fails alone.
+            const FMCPCommandDescriptor* SubCommand = CommandRegistry->Find(SubType);
+            TSharedPtr<FJsonObject> Invalid = SubCommand ? MakeInvalidParamsResponse(*SubCommand, SubParams, FString()) : nullptr;
+            if (Invalid.IsValid())
+            {
+                SubResponse = Invalid.ToSharedRef();
+            }
+            else
+            {
+                // Entries themselves run to completion; only the batch yields.
+                const bool bSuspendable = Context && Context->CanSuspend();
+                if (Context)
+                {
+                    Context->SetYieldDeadline(0.0);
+                    Context->SetSuspendable(false);
+                }
+                SubResponse = BuildCommandResponse(SubType, SubParams);
+                if (Context)
+                {
+                    Context->SetYieldDeadline(SliceDeadline);
+                    Context->SetSuspendable(bSuspendable);
+                }
+            }
         }
-    }
-    ServerAddress = BindAddress;
 
-    Port = static_cast<uint16>(FMath::Clamp(Settings->ServerPort, 1, 65535));
+        SubResponse->SetNumberField(TEXT("index"), Index);
+        SubResponse->SetStringField(TEXT("type"), SubType);
+        FString SubRequestId;
+        if (EntryObject.IsValid() && EntryObject->TryGetStringField(TEXT("requestId"), SubRequestId))
+        {
+            SubResponse->SetStringField(TEXT("requestId"), SubRequestId);
+        }
 
-    // Create socket subsystem
-    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-    if (!SocketSubsystem)
-    {
-        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to get socket subsystem"));
-        return;
+        bool bSubOk = false;
+        SubResponse->TryGetBoolField(TEXT("ok"), bSubOk);
+        Results.Add(MakeShared<FJsonValueObject>(SubResponse));
+
+        if (!bSubOk)
+        {
+            ++Failed;
+            if (bStopOnError)
+            {
+                bStopped = Index + 1 < Commands->Num();
+                break;
+            }
+        }
     }
 
-    // Create listener socket
-    TSharedPtr<FSocket> NewListenerSocket = MakeShareable(SocketSubsystem->CreateSocket(NAME_Stream, TEXT("UnrealMCPListener"), false));
-    if (!NewListenerSocket.IsValid())
+    // A transactional batch that stopped on an error (or was cancelled) leaves nothing behind.
+    bool bRolledBack = false;
+    if (!BatchTransactionId.IsEmpty())
     {
-        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to create listener socket"));
-        return;
+        bRolledBack = bCancelled || (bStopOnError && Failed > 0);
+        int32 Mutations = 0;
+        FString TransactionError;
+        const bool bClosed = bRolledBack
+            ? FTransactionManager::AbortShared(BatchTransactionId, Mutations, TransactionError)
+            : FTransactionManager::CommitShared(BatchTransactionId, Mutations, TransactionError);
+        if (!bClosed)
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Failed to close batch transaction: %s"), *TransactionError);
+            bRolledBack = false;
+        }
     }
 
-    // Allow address reuse for quick restarts
-    NewListenerSocket->SetReuseAddr(true);
-    NewListenerSocket->SetNonBlocking(true);
-
-    // Bind to address
-    FIPv4Endpoint Endpoint(BindAddress, Port);
-    if (!NewListenerSocket->Bind(*Endpoint.ToInternetAddr()))
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetArrayField(TEXT("results"), Results);
+    Result->SetNumberField(TEXT("total"), Commands->Num());
+    // Blueprints the entries edited compile once, after the transaction is closed.
+    FBlueprintCompileQueue::Get().FlushInto(*Result);
+    Result->SetNumberField(TEXT("executed"), Results.Num());
+    Result->SetNumberField(TEXT("failed"), Failed);
+    Result->SetBoolField(TEXT("stopped"), bStopped);
+    Result->SetBoolField(TEXT("cancelled"), bCancelled);
+    if (bTransaction)
     {
-        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to bind listener socket to %s:%d"), *BindAddress.ToString(), Port);
-        return;
+        Result->SetBoolField(TEXT("rolledBack"), bRolledBack);
     }
 
-    // Start listening
-    if (!NewListenerSocket->Listen(5))
+    const bool bOk = Failed == 0 && !bCancelled;
+    ResponseJson->SetBoolField(TEXT("ok"), bOk);
+    ResponseJson->SetStringField(TEXT("status"), bOk ? TEXT("success") : TEXT("error"));
+    ResponseJson->SetObjectField(TEXT("result"), Result);
+    if (bCancelled)
     {
-        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to start listening"));
-        return;
+        TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+        ErrorObject->SetStringField(TEXT("code"), UnrealMCP::Protocol::LexToString(UnrealMCP::Protocol::EProtocolErrorCode::Cancelled));
+        ErrorObject->SetStringField(TEXT("message"), FString::Printf(TEXT("Batch cancelled after %d of %d commands"), Results.Num(), Commands->Num()));
+        ResponseJson->SetObjectField(TEXT("error"), ErrorObject);
     }
-
-    ListenerSocket = NewListenerSocket;
-    bIsRunning = true;
-    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Server started on %s:%d"), *BindAddress.ToString(), Port);
-
-    // Start server thread
-    FMCPServerConfig ServerConfig;
-    ServerConfig.HandshakeTimeoutSeconds = Settings->ConnectTimeoutSec;
-    ServerConfig.ReadTimeoutSeconds = Settings->ReadTimeoutSec;
-    ServerConfig.HeartbeatIntervalSeconds = Settings->HeartbeatIntervalSec;
-
-    ServerThread = FRunnableThread::Create(
-        new FMCPServerRunnable(this, ListenerSocket, ServerConfig),
-        TEXT("UnrealMCPServerThread"),
-        0, TPri_Normal
-    );
-
-    if (!ServerThread)
+    else if (Failed > 0)
     {
-        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to create server thread"));
-        StopServer();
-        return;
+        TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+        ErrorObject->SetStringField(TEXT("code"), TEXT("BATCH_PARTIAL_FAILURE"));
+        ErrorObject->SetStringField(TEXT("message"), FString::Printf(TEXT("%d of %d batch commands failed"), Failed, Results.Num()));
+        ResponseJson->SetObjectField(TEXT("error"), ErrorObject);
     }
+    return ResponseJson;
 }
 
-// Stop the MCP server
-void UUnrealMCPBridge::StopServer()
+void UUnrealMCPBridge::PrefetchBatchCheckouts(const TArray<TSharedPtr<FJsonValue>>& Commands)
 {
-    if (!bIsRunning)
+    if (!FUnrealMCPRuntimeConfig::Get().bRequireCheckout || FWriteGate::ShouldDryRun())
     {
         return;
     }
 
-    bIsRunning = false;
-
-    // Clean up thread
-    if (ServerThread)
+    TArray<FString> Paths;
+    for (const TSharedPtr<FJsonValue>& Entry : Commands)
     {
-        ServerThread->Kill(true);
-        delete ServerThread;
-        ServerThread = nullptr;
-    }
+        const TSharedPtr<FJsonObject> EntryObject = Entry.IsValid() ? Entry->AsObject() : nullptr;
+        FString SubType;
+        if (!EntryObject.IsValid() || !EntryObject->TryGetStringField(TEXT("type"), SubType))
+        {
+            continue;
+        }
 
-    // Close sockets
-    if (ConnectionSocket.IsValid())
-    {
-        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ConnectionSocket.Get());
-        ConnectionSocket.Reset();
+        const FMCPCommandDescriptor* Command = CommandRegistry->Find(SubType);
+        const TSharedPtr<FJsonObject>* SubParams = nullptr;
+        EntryObject->TryGetObjectField(TEXT("params"), SubParams);
+        const TSharedPtr<FJsonObject> EntryParams = SubParams ? *SubParams : MakeShared<FJsonObject>();
+        if (!Command || !Command->bRequiresCheckout || Command->PathRule != EMCPPathRule::FromParams || !Command->IsMutation(EntryParams))
+        {
+            continue;
+        }
+
+        // Only what BuildCommandResponse would go on to check out, so a denied entry never locks files.
+        const FString TargetPath = FWriteGate::ResolvePath(Command->MutationSchema, EntryParams);
+        FString Reason;
+        if (!TargetPath.IsEmpty() && FWriteGate::IsToolAllowed(SubType, Reason) && FWriteGate::CanMutate(SubType, TargetPath, Reason))
+        {
+            Paths.AddUnique(TargetPath);
+        }
     }
 
-    if (ListenerSocket.IsValid())
+    // Failures are left to the entries themselves, which report them one by one.
+    if (Paths.Num() > 1)
     {
-        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenerSocket.Get());
-        ListenerSocket.Reset();
+        TSharedPtr<FJsonObject> CheckoutError;
+        FWriteGate::EnsureCheckoutForContentPaths(Paths, CheckoutError);
     }
-
-    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Server stopped"));
 }
 
-// Execute a command received from a client
-FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& RequestId)
+TSharedRef<FJsonObject> UUnrealMCPBridge::BuildCommandResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Executing command: %s (requestId=%s)"), *CommandType, *RequestId);
+    TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+
+    try
+    {
+        TSharedPtr<FJsonObject> ResultJson;
+        const FMCPCommandDescriptor* Command = CommandRegistry->Find(CommandType);
+        const bool bIsMutation = Command && Command->IsMutation(Params);
+        // The target path only feeds the mutation gate and checkout, so reads skip resolving it.
+        const FString TargetPath = bIsMutation && Command->PathRule == EMCPPathRule::FromParams ? FWriteGate::ResolvePath(Command->MutationSchema, Params) : FString();
+        // Audits are built only when someone consumes them: the project setting, or a client that
+        // asked in its capabilities or the request meta. Commands answered on a worker have no active context.
+        const UnrealMCP::Protocol::FCommandContext* Context = IsInGameThread() ? UnrealMCP::Protocol::FCommandContext::GetActive() : nullptr;
+        const bool bWantsAudit = bIsMutation && (FUnrealMCPRuntimeConfig::Get().bAlwaysEmitAudit || (Context && Context->IsAuditRequested()));
+        const bool bUndoFree = bIsMutation && Context && Context->IsUndoFreeRequested();
+        FMutationPlan MutationPlan;
+        bool bSkipExecution = false;
+        TSharedPtr<FJsonObject> AuditJson;
+
+        FString ToolReason;
+        bool bToolAllowed = false;
+        {
+            UNREALMCP_TRACE_SCOPE(MCP_WriteGate);
+            bToolAllowed = FWriteGate::IsToolAllowed(CommandType, ToolReason);
+        }
+        if (!bToolAllowed)
+        {
+            ResponseJson->SetBoolField(TEXT("ok"), false);
+            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+            ResponseJson->SetObjectField(TEXT("error"), FWriteGate::MakeToolNotAllowedError(CommandType, ToolReason));
 
-    // Create a promise to wait for the result
-    TPromise<FString> Promise;
-    TFuture<FString> Future = Promise.GetFuture();
+            if (bWantsAudit)
+            {
+                MutationPlan = FWriteGate::BuildPlan(CommandType, Params, Command->MutationSchema);
+                MutationPlan.bDryRun = true;
+                AuditJson = FWriteGate::BuildAuditJson(MutationPlan, false);
+                ResponseJson->SetObjectField(TEXT("audit"), AuditJson);
+            }
 
-    // Queue execution on Game Thread
-    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Params, Promise = MoveTemp(Promise)]() mutable
-    {
-        TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+            return ResponseJson;
+        }
 
-        try
+        if (bIsMutation)
         {
-            TSharedPtr<FJsonObject> ResultJson;
-            const bool bIsMutation = FWriteGate::IsMutationCommand(CommandType, Params);
-            const FString TargetPath = FWriteGate::ResolvePathForCommand(CommandType, Params);
-            FMutationPlan MutationPlan;
-            bool bSkipExecution = false;
-            TSharedPtr<FJsonObject> AuditJson;
+            if (bWantsAudit)
+            {
+                MutationPlan = FWriteGate::BuildPlan(CommandType, Params, Command->MutationSchema);
+            }
 
-            FString ToolReason;
-            if (!FWriteGate::IsToolAllowed(CommandType, ToolReason))
+            FString GateReason;
+            FString UndoReason;
+            bool bCanMutate = false;
+            {
+                UNREALMCP_TRACE_SCOPE(MCP_WriteGate);
+                bCanMutate = FWriteGate::CanMutate(CommandType, TargetPath, GateReason);
+            }
+            if (!bCanMutate)
             {
+                TSharedPtr<FJsonObject> ErrorObject;
+                if (!FWriteGate::IsWriteAllowed())
+                {
+                    ErrorObject = FWriteGate::MakeWriteNotAllowedError(CommandType);
+                }
+                else
+                {
+                    ErrorObject = FWriteGate::MakePathNotAllowedError(TargetPath, GateReason);
+                }
+
                 ResponseJson->SetBoolField(TEXT("ok"), false);
                 ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetObjectField(TEXT("error"), FWriteGate::MakeToolNotAllowedError(CommandType, ToolReason));
+                ResponseJson->SetObjectField(TEXT("error"), ErrorObject);
 
-                if (bIsMutation)
+                if (bWantsAudit)
                 {
-                    MutationPlan = FWriteGate::BuildPlan(CommandType, Params);
                     MutationPlan.bDryRun = true;
                     AuditJson = FWriteGate::BuildAuditJson(MutationPlan, false);
-                    ResponseJson->SetObjectField(TEXT("audit"), AuditJson);
                 }
-
-                FString ResultString;
-                TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-                FJsonSerializer::Serialize(ResponseJson, Writer, /*bCloseWriter=*/true);
-                Promise.SetValue(ResultString);
-                return;
+                bSkipExecution = true;
             }
-
-            if (bIsMutation)
+            else if (bUndoFree && !FWriteGate::CanSkipUndo(UndoReason))
             {
-                MutationPlan = FWriteGate::BuildPlan(CommandType, Params);
+                // Asking for no undo is explicit, so it is refused rather than quietly ignored.
+                ResponseJson->SetBoolField(TEXT("ok"), false);
+                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+                ResponseJson->SetObjectField(TEXT("error"), FWriteGate::MakeUndoRequiredError(CommandType, UndoReason));
 
-                FString GateReason;
-                if (!FWriteGate::CanMutate(CommandType, TargetPath, GateReason))
+                if (bWantsAudit)
                 {
-                    TSharedPtr<FJsonObject> ErrorObject;
-                    if (!FWriteGate::IsWriteAllowed())
-                    {
-                        ErrorObject = FWriteGate::MakeWriteNotAllowedError(CommandType);
-                    }
-                    else
-                    {
-                        ErrorObject = FWriteGate::MakePathNotAllowedError(TargetPath, GateReason);
-                    }
-
-                    ResponseJson->SetBoolField(TEXT("ok"), false);
-                    ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                    ResponseJson->SetObjectField(TEXT("error"), ErrorObject);
-
                     MutationPlan.bDryRun = true;
                     AuditJson = FWriteGate::BuildAuditJson(MutationPlan, false);
-                    bSkipExecution = true;
                 }
-                else if (FWriteGate::ShouldDryRun())
-                {
-                    MutationPlan.bDryRun = true;
-                    TSharedPtr<FJsonObject> ResultPayload = MakeShared<FJsonObject>();
-                    ResultPayload->SetBoolField(TEXT("planned"), true);
+                bSkipExecution = true;
+            }
+            else if (FWriteGate::ShouldDryRun())
+            {
+                MutationPlan.bDryRun = true;
+                TSharedPtr<FJsonObject> ResultPayload = MakeShared<FJsonObject>();
+                ResultPayload->SetBoolField(TEXT("planned"), true);
 
-                    ResponseJson->SetBoolField(TEXT("ok"), true);
-                    ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
-                    ResponseJson->SetObjectField(TEXT("result"), ResultPayload);
+                ResponseJson->SetBoolField(TEXT("ok"), true);
+                ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
+                ResponseJson->SetObjectField(TEXT("result"), ResultPayload);
 
+                if (bWantsAudit)
+                {
                     AuditJson = FWriteGate::BuildAuditJson(MutationPlan, false);
-                    bSkipExecution = true;
                 }
+                bSkipExecution = true;
             }
+        }
 
-            if (!bSkipExecution)
+        if (!bSkipExecution)
+        {
+            if (bIsMutation && Command->bRequiresCheckout)
             {
-                if (bIsMutation && !CommandType.StartsWith(TEXT("sc.")))
+                TSharedPtr<FJsonObject> CheckoutError;
+                const double CheckoutStart = FPlatformTime::Seconds();
+                bool bCheckedOut = false;
                 {
-                    TSharedPtr<FJsonObject> CheckoutError;
-                    if (!FWriteGate::EnsureCheckoutForContentPath(TargetPath, CheckoutError))
-                    {
-                        ResponseJson->SetBoolField(TEXT("ok"), false);
-                        ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                        ResponseJson->SetObjectField(TEXT("error"), CheckoutError);
-
-                        MutationPlan.bDryRun = false;
-                        AuditJson = FWriteGate::BuildAuditJson(MutationPlan, false);
-
-                        FString ResultString;
-                        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-                        FJsonSerializer::Serialize(ResponseJson, Writer, /*bCloseWriter=*/true);
-                        Promise.SetValue(ResultString);
-                        return;
-                    }
+                    UNREALMCP_TRACE_SCOPE(MCP_Checkout);
+                    bCheckedOut = FWriteGate::EnsureCheckoutForContentPath(TargetPath, CheckoutError);
                 }
-
-                bool bTransactionActive = false;
-                if (bIsMutation)
+                if (UnrealMCP::Protocol::FCommandContext* TimedContext = IsInGameThread() ? UnrealMCP::Protocol::FCommandContext::GetActive() : nullptr)
                 {
-                    FTransactionManager::Begin(FWriteGate::GetTransactionName());
-                    bTransactionActive = true;
+                    TimedContext->AddCheckoutTime(FPlatformTime::Seconds() - CheckoutStart);
                 }
-
-                ON_SCOPE_EXIT
+                if (!bCheckedOut)
                 {
-                    if (bTransactionActive)
-                    {
-                        FTransactionManager::End();
-                    }
-                };
-
-                if (CommandType == TEXT("ping"))
-                {
-                    ResultJson = MakeShared<FJsonObject>();
-                    ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
-                }
-                // Editor Commands (including actor manipulation)
-                else if (CommandType == TEXT("get_actors_in_level") ||
-                         CommandType == TEXT("find_actors_by_name") ||
-                         CommandType == TEXT("spawn_actor") ||
-                         CommandType == TEXT("create_actor") ||
-                         CommandType == TEXT("delete_actor") ||
-                         CommandType == TEXT("set_actor_transform") ||
-                         CommandType == TEXT("get_actor_properties") ||
-                         CommandType == TEXT("set_actor_property") ||
-                         CommandType == TEXT("spawn_blueprint_actor") ||
-                         CommandType == TEXT("focus_viewport") ||
-                         CommandType == TEXT("take_screenshot"))
-                {
-                    ResultJson = EditorCommands->HandleCommand(CommandType, Params);
-                }
-                // Blueprint Commands
-                else if (CommandType == TEXT("create_blueprint") ||
-                         CommandType == TEXT("add_component_to_blueprint") ||
-                         CommandType == TEXT("set_component_property") ||
-                         CommandType == TEXT("set_physics_properties") ||
-                         CommandType == TEXT("compile_blueprint") ||
-                         CommandType == TEXT("set_blueprint_property") ||
-                         CommandType == TEXT("set_static_mesh_properties") ||
-                         CommandType == TEXT("set_pawn_properties"))
-                {
-                    ResultJson = BlueprintCommands->HandleCommand(CommandType, Params);
-                }
-                // Blueprint Node Commands
-                else if (CommandType == TEXT("connect_blueprint_nodes") ||
-                         CommandType == TEXT("add_blueprint_get_self_component_reference") ||
-                         CommandType == TEXT("add_blueprint_self_reference") ||
-                         CommandType == TEXT("find_blueprint_nodes") ||
-                         CommandType == TEXT("add_blueprint_event_node") ||
-                         CommandType == TEXT("add_blueprint_input_action_node") ||
-                         CommandType == TEXT("add_blueprint_function_node") ||
-                         CommandType == TEXT("add_blueprint_get_component_node") ||
-                         CommandType == TEXT("add_blueprint_variable"))
-                {
-                    ResultJson = BlueprintNodeCommands->HandleCommand(CommandType, Params);
-                }
-                // Project Commands
-                else if (CommandType == TEXT("create_input_mapping"))
-                {
-                    ResultJson = ProjectCommands->HandleCommand(CommandType, Params);
-                }
-                // UMG Commands
-                else if (CommandType == TEXT("create_umg_widget_blueprint") ||
-                         CommandType == TEXT("add_text_block_to_widget") ||
-                         CommandType == TEXT("add_button_to_widget") ||
-                         CommandType == TEXT("bind_widget_event") ||
-                         CommandType == TEXT("set_text_block_binding") ||
-                         CommandType == TEXT("add_widget_to_viewport"))
-                {
-                    ResultJson = UMGCommands->HandleCommand(CommandType, Params);
-                }
-                else if (CommandType == TEXT("asset.find") ||
-                         CommandType == TEXT("asset.exists") ||
-                         CommandType == TEXT("asset.metadata"))
-                {
-                    if (CommandType == TEXT("asset.find"))
-                    {
-                        FAssetFindParams QueryParams;
-                        if (Params.IsValid())
-                        {
-                            const TArray<TSharedPtr<FJsonValue>>* PathsArray = nullptr;
-                            if (Params->TryGetArrayField(TEXT("paths"), PathsArray))
-                            {
-                                for (const TSharedPtr<FJsonValue>& Value : *PathsArray)
-                                {
-                                    if (Value.IsValid() && Value->Type == EJson::String)
-                                    {
-                                        FString PathValue = Value->AsString();
-                                        PathValue.TrimStartAndEndInline();
-                                        if (!PathValue.IsEmpty())
-                                        {
-                                            QueryParams.Paths.Add(MoveTemp(PathValue));
-                                        }
-                                    }
-                                }
-                            }
-
-                            const TArray<TSharedPtr<FJsonValue>>* ClassArray = nullptr;
-                            if (Params->TryGetArrayField(TEXT("classNames"), ClassArray))
-                            {
-                                for (const TSharedPtr<FJsonValue>& Value : *ClassArray)
-                                {
-                                    if (Value.IsValid() && Value->Type == EJson::String)
-                                    {
-                                        FString ClassName = Value->AsString();
-                                        ClassName.TrimStartAndEndInline();
-                                        if (!ClassName.IsEmpty())
-                                        {
-                                            QueryParams.ClassNames.Add(MoveTemp(ClassName));
-                                        }
-                                    }
-                                }
-                            }
-
-                            FString NameContains;
-                            if (Params->TryGetStringField(TEXT("nameContains"), NameContains))
-                            {
-                                NameContains.TrimStartAndEndInline();
-                                if (!NameContains.IsEmpty())
-                                {
-                                    QueryParams.NameContains = NameContains;
-                                }
-                            }
-
-                            const TSharedPtr<FJsonObject>* TagQueryObject = nullptr;
-                            if (Params->TryGetObjectField(TEXT("tagQuery"), TagQueryObject))
-                            {
-                                for (const auto& TagPair : (*TagQueryObject)->Values)
-                                {
-                                    TArray<FString> TagValues;
-                                    if (TagPair.Value->Type == EJson::Array)
-                                    {
-                                        for (const TSharedPtr<FJsonValue>& TagValue : TagPair.Value->AsArray())
-                                        {
-                                            if (TagValue->Type == EJson::String)
-                                            {
-                                                TagValues.Add(TagValue->AsString());
-                                            }
-                                            else if (TagValue->Type == EJson::Number)
-                                            {
-                                                TagValues.Add(FString::SanitizeFloat(TagValue->AsNumber()));
-                                            }
-                                            else if (TagValue->Type == EJson::Boolean)
-                                            {
-                                                TagValues.Add(TagValue->AsBool() ? TEXT("true") : TEXT("false"));
-                                            }
-                                        }
-                                    }
-                                    else if (TagPair.Value->Type == EJson::String)
-                                    {
-                                        TagValues.Add(TagPair.Value->AsString());
-                                    }
-                                    else if (TagPair.Value->Type == EJson::Number)
-                                    {
-                                        TagValues.Add(FString::SanitizeFloat(TagPair.Value->AsNumber()));
-                                    }
-                                    else if (TagPair.Value->Type == EJson::Boolean)
-                                    {
-                                        TagValues.Add(TagPair.Value->AsBool() ? TEXT("true") : TEXT("false"));
-                                    }
-
-                                    if (TagValues.Num() > 0)
-                                    {
-                                        QueryParams.TagQuery.Add(FName(*TagPair.Key), MoveTemp(TagValues));
-                                    }
-                                }
-                            }
-
-                            if (Params->HasTypedField<EJson::Boolean>(TEXT("recursive")))
-                            {
-                                QueryParams.bRecursive = Params->GetBoolField(TEXT("recursive"));
-                            }
-
-                            if (Params->HasTypedField<EJson::Number>(TEXT("limit")))
-                            {
-                                QueryParams.Limit = static_cast<int32>(Params->GetNumberField(TEXT("limit")));
-                            }
-
-                            if (Params->HasTypedField<EJson::Number>(TEXT("offset")))
-                            {
-                                QueryParams.Offset = static_cast<int32>(Params->GetNumberField(TEXT("offset")));
-                            }
-
-                            const TSharedPtr<FJsonObject>* SortObject = nullptr;
-                            if (Params->TryGetObjectField(TEXT("sort"), SortObject) && SortObject->IsValid())
-                            {
-                                FString SortBy;
-                                if ((*SortObject)->TryGetStringField(TEXT("by"), SortBy))
-                                {
-                                    if (SortBy.Equals(TEXT("class"), ESearchCase::IgnoreCase))
-                                    {
-                                        QueryParams.SortBy = FAssetFindParams::ESortBy::Class;
-                                    }
-                                    else if (SortBy.Equals(TEXT("path"), ESearchCase::IgnoreCase))
-                                    {
-                                        QueryParams.SortBy = FAssetFindParams::ESortBy::Path;
-                                    }
-                                    else
-                                    {
-                                        QueryParams.SortBy = FAssetFindParams::ESortBy::Name;
-                                    }
-                                }
-
-                                FString SortOrder;
-                                if ((*SortObject)->TryGetStringField(TEXT("order"), SortOrder))
-                                {
-                                    QueryParams.bSortAscending = !SortOrder.Equals(TEXT("desc"), ESearchCase::IgnoreCase);
-                                }
-                            }
-                        }
+                    ResponseJson->SetBoolField(TEXT("ok"), false);
+                    ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+                    ResponseJson->SetObjectField(TEXT("error"), CheckoutError);
 
-                        if (QueryParams.Paths.Num() == 0 &&
-                            QueryParams.ClassNames.Num() == 0 &&
-                            !QueryParams.NameContains.IsSet() &&
-                            QueryParams.TagQuery.Num() == 0)
-                        {
-                            ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Provide at least one filter (paths, classNames, nameContains, or tagQuery)"));
-                            ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_FIND_INVALID_FILTER"));
-                        }
-                        else
-                        {
-                            int32 Total = 0;
-                            TArray<FAssetLite> Items;
-                            FString QueryError;
-                            if (!FAssetQuery::Find(QueryParams, Total, Items, QueryError))
-                            {
-                                ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(QueryError);
-                                ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_FIND_FAILED"));
-                            }
-                            else
-                            {
-                                TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-                                Data->SetNumberField(TEXT("total"), Total);
-
-                                TArray<TSharedPtr<FJsonValue>> ItemsArray;
-                                for (const FAssetLite& Item : Items)
-                                {
-                                    TSharedPtr<FJsonObject> ItemObject = MakeShared<FJsonObject>();
-                                    ItemObject->SetStringField(TEXT("objectPath"), Item.ObjectPath);
-                                    ItemObject->SetStringField(TEXT("packagePath"), Item.PackagePath);
-                                    ItemObject->SetStringField(TEXT("assetName"), Item.AssetName);
-                                    ItemObject->SetStringField(TEXT("class"), Item.ClassName);
-
-                                    TSharedPtr<FJsonObject> TagsJson = MakeShared<FJsonObject>();
-                                    for (const TPair<FString, TArray<FString>>& TagPair : Item.Tags)
-                                    {
-                                        TArray<TSharedPtr<FJsonValue>> TagValues;
-                                        for (const FString& TagValue : TagPair.Value)
-                                        {
-                                            TagValues.Add(MakeShared<FJsonValueString>(TagValue));
-                                        }
-                                        TagsJson->SetArrayField(TagPair.Key, TagValues);
-                                    }
-
-                                    ItemObject->SetObjectField(TEXT("tags"), TagsJson);
-                                    ItemsArray.Add(MakeShared<FJsonValueObject>(ItemObject));
-                                }
-
-                                Data->SetArrayField(TEXT("items"), ItemsArray);
-                                ResultJson = FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
-                            }
-                        }
-                    }
-                    else if (CommandType == TEXT("asset.exists"))
-                    {
-                        FString ObjectPath;
-                        if (Params.IsValid() && Params->TryGetStringField(TEXT("objectPath"), ObjectPath))
-                        {
-                            ObjectPath.TrimStartAndEndInline();
-                            bool bExists = false;
-                            FString ClassName;
-                            FString ExistsError;
-                            if (!FAssetQuery::Exists(ObjectPath, bExists, ClassName, ExistsError))
-                            {
-                                ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(ExistsError);
-                                ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_EXISTS_FAILED"));
-                            }
-                            else
-                            {
-                                TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-                                Data->SetBoolField(TEXT("exists"), bExists);
-                                if (!ClassName.IsEmpty())
-                                {
-                                    Data->SetStringField(TEXT("class"), ClassName);
-                                }
-                                ResultJson = FUnrealMCPCommonUtils::CreateSuccessResponse(Data);
-                            }
-                        }
-                        else
-                        {
-                            ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing objectPath parameter"));
-                            ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_EXISTS_FAILED"));
-                        }
-                    }
-                    else if (CommandType == TEXT("asset.metadata"))
-                    {
-                        FString ObjectPath;
-                        if (Params.IsValid() && Params->TryGetStringField(TEXT("objectPath"), ObjectPath))
-                        {
-                            ObjectPath.TrimStartAndEndInline();
-                            TSharedPtr<FJsonObject> MetadataJson;
-                            FString MetadataError;
-                            if (!FAssetQuery::Metadata(ObjectPath, MetadataJson, MetadataError))
-                            {
-                                ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(MetadataError);
-                                ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_METADATA_FAILED"));
-                            }
-                            else
-                            {
-                                ResultJson = FUnrealMCPCommonUtils::CreateSuccessResponse(MetadataJson);
-                            }
-                        }
-                        else
-                        {
-                            ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing objectPath parameter"));
-                            ResultJson->SetStringField(TEXT("errorCode"), TEXT("ASSET_METADATA_FAILED"));
-                        }
-                    }
-                }
-                else if (CommandType == TEXT("actor.spawn"))
-                {
-                    ResultJson = FActorTools::Spawn(Params);
-                }
-                else if (CommandType == TEXT("actor.destroy"))
-                {
-                    ResultJson = FActorTools::Destroy(Params);
-                }
-                else if (CommandType == TEXT("actor.attach"))
-                {
-                    ResultJson = FActorTools::Attach(Params);
-                }
-                else if (CommandType == TEXT("actor.transform"))
-                {
-                    ResultJson = FActorTools::Transform(Params);
-                }
-                else if (CommandType == TEXT("actor.tag"))
-                {
-                    ResultJson = FActorTools::Tag(Params);
-                }
-                else if (CommandType == TEXT("level.save_open"))
-                {
-                    ResultJson = FLevelTools::SaveOpen(Params);
-                }
-                else if (CommandType == TEXT("level.load"))
-                {
-                    ResultJson = FLevelTools::Load(Params);
-                }
-                else if (CommandType == TEXT("level.unload"))
-                {
-                    ResultJson = FLevelTools::Unload(Params);
-                }
-                else if (CommandType == TEXT("level.stream_sublevel"))
-                {
-                    ResultJson = FLevelTools::StreamSublevel(Params);
-                }
-                else if (CommandType == TEXT("level.select"))
-                {
-                    ResultJson = FEditorNavTools::LevelSelect(Params);
-                }
-                else if (CommandType == TEXT("viewport.focus"))
-                {
-                    ResultJson = FEditorNavTools::ViewportFocus(Params);
-                }
-                else if (CommandType == TEXT("camera.bookmark"))
-                {
-                    ResultJson = FEditorNavTools::CameraBookmark(Params);
+                    return ResponseJson;
                 }
-                else if (CommandType == TEXT("asset.create_folder"))
-                {
-                    ResultJson = FAssetCrud::CreateFolder(Params);
-                }
-                else if (CommandType == TEXT("asset.rename"))
-                {
-                    ResultJson = FAssetCrud::Rename(Params);
-                }
-                else if (CommandType == TEXT("asset.delete"))
-                {
-                    ResultJson = FAssetCrud::Delete(Params);
-                }
-                else if (CommandType == TEXT("niagara.spawn_component"))
-                {
-                    ResultJson = FNiagaraTools::SpawnComponent(Params);
-                }
-                else if (CommandType == TEXT("niagara.set_user_params"))
-                {
-                    ResultJson = FNiagaraTools::SetUserParameters(Params);
-                }
-                else if (CommandType == TEXT("niagara.activate"))
-                {
-                    ResultJson = FNiagaraTools::Activate(Params);
-                }
-                else if (CommandType == TEXT("niagara.deactivate"))
-                {
-                    ResultJson = FNiagaraTools::Deactivate(Params);
-                }
-                else if (CommandType == TEXT("metasound.spawn_component"))
-                {
-                    ResultJson = FMetaSoundTools::SpawnComponent(Params);
-                }
-                else if (CommandType == TEXT("metasound.set_params"))
-                {
-                    ResultJson = FMetaSoundTools::SetParameters(Params);
-                }
-                else if (CommandType == TEXT("metasound.play"))
-                {
-                    ResultJson = FMetaSoundTools::Play(Params);
-                }
-                else if (CommandType == TEXT("metasound.stop"))
-                {
-                    ResultJson = FMetaSoundTools::Stop(Params);
-                }
-                else if (CommandType == TEXT("metasound.export_info"))
-                {
-                    ResultJson = FMetaSoundTools::ExportInfo(Params);
-                }
-                else if (CommandType == TEXT("metasound.patch_preset"))
-                {
-                    ResultJson = FMetaSoundTools::PatchPreset(Params);
-                }
-                else if (CommandType == TEXT("asset.fix_redirectors"))
-                {
-                    ResultJson = FAssetCrud::FixRedirectors(Params);
-                }
-                else if (CommandType == TEXT("asset.save_all"))
-                {
-                    ResultJson = FAssetCrud::SaveAll(Params);
-                }
-                else if (CommandType == TEXT("asset.batch_import"))
-                {
-                    ResultJson = FAssetImport::BatchImport(Params);
-                }
-                else if (CommandType == TEXT("content.scan") ||
-                         CommandType == TEXT("content.validate") ||
-                         CommandType == TEXT("content.fix_missing") ||
-                         CommandType == TEXT("content.generate_thumbnails"))
-                {
-                    ResultJson = ContentTools->HandleCommand(CommandType, Params);
-                }
-                else if (CommandType == TEXT("mi.create"))
-                {
-                    ResultJson = FMaterialInstanceTools::Create(Params);
-                }
-                else if (CommandType == TEXT("mi.set_params"))
-                {
-                    ResultJson = FMaterialInstanceTools::SetParameters(Params);
-                }
-                else if (CommandType == TEXT("mi.batch_apply"))
-                {
-                    ResultJson = FMaterialApplyTools::BatchApply(Params);
-                }
-                else if (CommandType == TEXT("mesh.remap_material_slots"))
-                {
-                    ResultJson = FMaterialApplyTools::RemapMaterialSlots(Params);
-                }
-                else if (CommandType == TEXT("sequence.create"))
-                {
-                    ResultJson = FSequenceTools::Create(Params);
-                }
-                else if (CommandType == TEXT("sequence.bind_actors"))
-                {
-                    ResultJson = FSequenceBindings::BindActors(Params);
-                }
-                else if (CommandType == TEXT("sequence.unbind"))
-                {
-                    ResultJson = FSequenceBindings::Unbind(Params);
-                }
-                else if (CommandType == TEXT("sequence.list_bindings"))
-                {
-                    ResultJson = FSequenceBindings::List(Params);
-                }
-                else if (CommandType == TEXT("sequence.add_tracks"))
+            }
+
+            bool bUndoFreeActive = false;
+            if (bUndoFree)
+            {
+                FString UndoError;
+                if (!FTransactionManager::BeginUndoFree(UndoError))
                 {
-                    ResultJson = FSequenceTracks::AddTracks(Params);
+                    ResponseJson->SetBoolField(TEXT("ok"), false);
+                    ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+                    ResponseJson->SetObjectField(TEXT("error"), FWriteGate::MakeUndoRequiredError(CommandType, UndoError));
+                    return ResponseJson;
                 }
-                else if (CommandType == TEXT("sequence.export"))
+                bUndoFreeActive = true;
+            }
+
+            bool bTransactionActive = false;
+            if (bIsMutation)
+            {
+                FTransactionManager::Begin(FWriteGate::GetTransactionName());
+                bTransactionActive = true;
+            }
+
+            ON_SCOPE_EXIT
+            {
+                if (bTransactionActive)
                 {
-                    ResultJson = FSequenceExport::Export(Params);
+                    FTransactionManager::End();
                 }
-                else if (CommandType.StartsWith(TEXT("sc.")))
+                if (bUndoFreeActive)
                 {
-                    ResultJson = SourceControlCommands->HandleCommand(CommandType, Params);
+                    FTransactionManager::EndUndoFree();
                 }
-                else
-                {
-                    ResponseJson->SetBoolField(TEXT("ok"), false);
-                    ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                    TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
-                    ErrorObject->SetStringField(TEXT("code"), TEXT("UNKNOWN_COMMAND"));
-                    ErrorObject->SetStringField(TEXT("message"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
-                    ResponseJson->SetObjectField(TEXT("error"), ErrorObject);
+            };
 
-                    if (bIsMutation)
-                    {
-                        MutationPlan.bDryRun = true;
-                        AuditJson = FWriteGate::BuildAuditJson(MutationPlan, false);
-                    }
+            if (!Command)
+            {
+                ResponseJson->SetBoolField(TEXT("ok"), false);
+                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+                TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+                ErrorObject->SetStringField(TEXT("code"), TEXT("UNKNOWN_COMMAND"));
+                ErrorObject->SetStringField(TEXT("message"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
+                ResponseJson->SetObjectField(TEXT("error"), ErrorObject);
+                return ResponseJson;
+            }
 
-                    FString ResultString;
-                    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-                    FJsonSerializer::Serialize(ResponseJson, Writer, /*bCloseWriter=*/true);
-                    Promise.SetValue(ResultString);
-                    return;
-                }
+            // Families with their own modules (niagara.*, metasound.*, ...) load them on first use.
+            if (IsInGameThread())
+            {
+                CommandRegistry->LoadModulesFor(*Command);
+            }
 
-                // Check if the result contains an error
-                bool bSuccess = true;
-                FString ErrorMessage;
+            const double HandlerStart = FPlatformTime::Seconds();
+            {
+                UNREALMCP_TRACE_SCOPE_TEXT(*CommandType);
+                ResultJson = Command->Handler(Params);
+            }
+            // Off-thread reads time themselves; the active context belongs to the game thread.
+            UnrealMCP::Protocol::FCommandContext* TimedContext = IsInGameThread() ? UnrealMCP::Protocol::FCommandContext::GetActive() : nullptr;
+            if (TimedContext)
+            {
+                TimedContext->AddHandlerSlice(HandlerStart, FPlatformTime::Seconds());
+            }
 
-                FString ErrorCode = TEXT("COMMAND_FAILED");
-                if (ResultJson.IsValid() && ResultJson->HasField(TEXT("success")))
-                {
-                    bSuccess = ResultJson->GetBoolField(TEXT("success"));
-                    if (!bSuccess)
-                    {
-                        if (ResultJson->HasField(TEXT("error")))
-                        {
-                            ErrorMessage = ResultJson->GetStringField(TEXT("error"));
-                        }
-                        if (ResultJson->HasField(TEXT("errorCode")))
-                        {
-                            ErrorCode = ResultJson->GetStringField(TEXT("errorCode"));
-                        }
-                    }
-                }
+            // Check if the result contains an error
+            bool bSuccess = true;
+            FString ErrorMessage;
 
-                if (bSuccess)
+            FString ErrorCode = TEXT("COMMAND_FAILED");
+            if (ResultJson.IsValid() && ResultJson->HasField(TEXT("success")))
+            {
+                bSuccess = ResultJson->GetBoolField(TEXT("success"));
+                if (!bSuccess)
                 {
-                    ResponseJson->SetBoolField(TEXT("ok"), true);
-                    ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
-                    if (ResultJson.IsValid())
+                    if (ResultJson->HasField(TEXT("error")))
                     {
-                        ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+                        ErrorMessage = ResultJson->GetStringField(TEXT("error"));
                     }
-
-                    if (bIsMutation)
+                    if (ResultJson->HasField(TEXT("errorCode")))
                     {
-                        MutationPlan.bDryRun = false;
-                        AuditJson = FWriteGate::BuildAuditJson(MutationPlan, true);
+                        ErrorCode = ResultJson->GetStringField(TEXT("errorCode"));
                     }
                 }
-                else
-                {
-                    ResponseJson->SetBoolField(TEXT("ok"), false);
-                    ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-
-                    TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
-                    if (ErrorMessage.IsEmpty())
-                    {
-                        ErrorMessage = TEXT("Command failed");
-                    }
+            }
 
-                    ErrorObject->SetStringField(TEXT("code"), ErrorCode);
-                    ErrorObject->SetStringField(TEXT("message"), ErrorMessage);
-                    ResponseJson->SetObjectField(TEXT("error"), ErrorObject);
+            if (bSuccess)
+            {
+                ResponseJson->SetBoolField(TEXT("ok"), true);
+                ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
+                if (ResultJson.IsValid())
+                {
+                    ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+                }
 
-                    if (bIsMutation)
-                    {
-                        MutationPlan.bDryRun = false;
-                        AuditJson = FWriteGate::BuildAuditJson(MutationPlan, false);
-                    }
+                if (bWantsAudit)
+                {
+                    MutationPlan.bDryRun = false;
+                    AuditJson = FWriteGate::BuildAuditJson(MutationPlan, true);
                 }
             }
-
-            if (AuditJson.IsValid())
+            else
             {
-                ResponseJson->SetObjectField(TEXT("audit"), AuditJson);
+                ResponseJson->SetBoolField(TEXT("ok"), false);
+                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+
+                TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+                if (ErrorMessage.IsEmpty())
+                {
+                    ErrorMessage = TEXT("Command failed");
+                }
+
+                ErrorObject->SetStringField(TEXT("code"), ErrorCode);
+                ErrorObject->SetStringField(TEXT("message"), ErrorMessage);
+                ResponseJson->SetObjectField(TEXT("error"), ErrorObject);
 
-                FString AuditString;
-                TSharedRef<TJsonWriter<>> AuditWriter = TJsonWriterFactory<>::Create(&AuditString);
-                FJsonSerializer::Serialize(AuditJson.ToSharedRef(), AuditWriter, /*bCloseWriter=*/true);
-                UE_LOG(LogUnrealMCP, Display, TEXT("[AUDIT] %s"), *AuditString);
+                if (bWantsAudit)
+                {
+                    MutationPlan.bDryRun = false;
+                    AuditJson = FWriteGate::BuildAuditJson(MutationPlan, false);
+                }
             }
         }
-        catch (const std::exception& e)
+
+        if (AuditJson.IsValid())
         {
-            ResponseJson->SetBoolField(TEXT("ok"), false);
-            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-            TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
-            ErrorObject->SetStringField(TEXT("code"), TEXT("EXCEPTION"));
-            ErrorObject->SetStringField(TEXT("message"), UTF8_TO_TCHAR(e.what()));
-            ResponseJson->SetObjectField(TEXT("error"), ErrorObject);
+            ResponseJson->SetObjectField(TEXT("audit"), AuditJson);
+
+            FString AuditString;
+            TSharedRef<TJsonWriter<>> AuditWriter = TJsonWriterFactory<>::Create(&AuditString);
+            FJsonSerializer::Serialize(AuditJson.ToSharedRef(), AuditWriter, /*bCloseWriter=*/true);
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("[AUDIT] %s"), *AuditString);
         }
+    }
+    catch (const std::exception& e)
+    {
+        ResponseJson->SetBoolField(TEXT("ok"), false);
+        ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+        TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+        ErrorObject->SetStringField(TEXT("code"), TEXT("EXCEPTION"));
+        ErrorObject->SetStringField(TEXT("message"), UTF8_TO_TCHAR(e.what()));
+        ResponseJson->SetObjectField(TEXT("error"), ErrorObject);
+    }
 
-        FString ResultString;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-        FJsonSerializer::Serialize(ResponseJson, Writer, /*bCloseWriter=*/true);
-        Promise.SetValue(ResultString);
-    });
-    
-    return Future.Get();
+    return ResponseJson;
 }
@@ -1,22 +1,112 @@
 #include "UnrealMCPEditorModule.h"
 #include "CoreMinimal.h"
 
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 #include "ISettingsModule.h"
 #include "Modules/ModuleManager.h"
 #include "Observability/JsonLogger.h"
+#include "Observability/MetricsRegistry.h"
 #include "PropertyEditorModule.h"
+#include "Settings/UnrealMCPDiagnostics.h"
+#include "Settings/UnrealMCPRuntimeConfig.h"
 #include "Settings/UnrealMCPSettingsCustomization.h"
 #include "UnrealMCPLog.h"
 #include "UnrealMCPSettings.h"
 
+#include <atomic>
+
 #define LOCTEXT_NAMESPACE "FUnrealMCPEditorModule"
 
+namespace
+{
+    /** UnrealMCP.Benchmark [Connections] [Seconds] [Mix]; anything left out comes from the Benchmark* settings. */
+    void RunBenchmarkCommand(const TArray<FString>& Args)
+    {
+        FUnrealMCPBenchmarkOptions Options;
+        FString Error;
+        if (!FUnrealMCPDiagnostics::MakeBenchmarkOptions(*GetDefault<UUnrealMCPSettings>(), Options, Error))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCP.Benchmark: %s"), *Error);
+            return;
+        }
+
+        if (Args.Num() > 0)
+        {
+            Options.Connections = FMath::Clamp(FCString::Atoi(*Args[0]), 1, 64);
+        }
+        if (Args.Num() > 1)
+        {
+            Options.DurationSeconds = FMath::Clamp(FCString::Atod(*Args[1]), 1.0, 600.0);
+        }
+        if (Args.Num() > 2 && !FUnrealMCPDiagnostics::ParseBenchmarkMix(Args[2], Options.Mix, Error))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCP.Benchmark: %s"), *Error);
+            return;
+        }
+
+        // The report is logged by the run itself.
+        FText Message;
+        if (!FUnrealMCPDiagnostics::StartBenchmark(Options, nullptr, Message))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCP.Benchmark: %s"), *Message.ToString());
+            return;
+        }
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCP.Benchmark: %s"), *Message.ToString());
+    }
+
+    std::atomic<bool> bProtocolBenchmarkRunning(false);
+
+    /** UnrealMCP.BenchProtocol; runs on a worker thread so the editor keeps ticking. */
+    void RunProtocolBenchmarkCommand()
+    {
+        if (bProtocolBenchmarkRunning.exchange(true))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCP.BenchProtocol: a run is already in progress"));
+            return;
+        }
+
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCP.BenchProtocol: started"));
+        Async(EAsyncExecution::Thread, []()
+        {
+            FString Report;
+            FString ResultsPath;
+            const bool bPassed = FUnrealMCPDiagnostics::RunProtocolBenchmark(Report, ResultsPath);
+            UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCP.BenchProtocol results (%s):\n%s"), ResultsPath.IsEmpty() ? TEXT("not saved") : *ResultsPath, *Report);
+            if (!bPassed)
+            {
+                UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCP.BenchProtocol: one or more cases failed"));
+            }
+            bProtocolBenchmarkRunning = false;
+        });
+    }
+}
+
 void FUnrealMCPEditorModule::StartupModule()
 {
+    // The first two startup milestones; the logger they are written to exists only once settings are read.
+    const double StartupStart = FPlatformTime::Seconds();
+    FUnrealMCPRuntimeConfig::Start();
+    const FUnrealMCPRuntimeConfig& Config = FUnrealMCPRuntimeConfig::Get();
+    FJsonLogger::Init(Config.LogsDirectory, Config.bJsonLogs);
     if (const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>())
     {
-        FJsonLogger::Init(Settings->GetEffectiveLogsDirectory(), Settings->bEnableJsonLogs);
+        FMetricsRegistry::Start(Settings->MetricsFlushIntervalSec, Settings->MetricsRawSampleRate);
     }
+    FMetricsRegistry::MarkStartup(TEXT("settings_read"), StartupStart);
+
+    // Turning JSON logs on or off, or moving them, takes effect without a restart.
+    ConfigChangedHandle = FUnrealMCPRuntimeConfig::OnChanged().AddLambda([Directory = Config.LogsDirectory, bEnabled = Config.bJsonLogs]() mutable
+    {
+        const FUnrealMCPRuntimeConfig& Changed = FUnrealMCPRuntimeConfig::Get();
+        if (Changed.bJsonLogs != bEnabled || Changed.LogsDirectory != Directory)
+        {
+            Directory = Changed.LogsDirectory;
+            bEnabled = Changed.bJsonLogs;
+            FJsonLogger::Init(Directory, bEnabled);
+        }
+    });
 
     if (ISettingsModule* SettingsModule = FModuleManager::LoadModulePtr<ISettingsModule>("Settings"))
     {
@@ -39,11 +129,36 @@ void FUnrealMCPEditorModule::StartupModule()
         bCustomizationRegistered = true;
     }
 
+    BenchmarkCommand = IConsoleManager::Get().RegisterConsoleCommand(
+        TEXT("UnrealMCP.Benchmark"),
+        TEXT("Loads the running MCP server and logs throughput, latency and frame time. Args: [Connections] [Seconds] [command=weight,...]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunBenchmarkCommand),
+        ECVF_Default);
+
+    ProtocolBenchmarkCommand = IConsoleManager::Get().RegisterConsoleCommand(
+        TEXT("UnrealMCP.BenchProtocol"),
+        TEXT("Times protocol framing and JSON/CBOR codec cases and writes the results as JSON to the logs directory."),
+        FConsoleCommandDelegate::CreateStatic(&RunProtocolBenchmarkCommand),
+        ECVF_Default);
+
+    FMetricsRegistry::MarkStartup(TEXT("module_loaded"), StartupStart);
     UE_LOG(LogUnrealMCP, Display, TEXT("Unreal MCP editor module started"));
 }
 
 void FUnrealMCPEditorModule::ShutdownModule()
 {
+    if (BenchmarkCommand)
+    {
+        IConsoleManager::Get().UnregisterConsoleObject(BenchmarkCommand);
+        BenchmarkCommand = nullptr;
+    }
+
+    if (ProtocolBenchmarkCommand)
+    {
+        IConsoleManager::Get().UnregisterConsoleObject(ProtocolBenchmarkCommand);
+        ProtocolBenchmarkCommand = nullptr;
+    }
+
     if (bCustomizationRegistered)
     {
         if (FPropertyEditorModule* PropertyEditorModule = FModuleManager::GetModulePtr<FPropertyEditorModule>("PropertyEditor"))
@@ -63,6 +178,14 @@ void FUnrealMCPEditorModule::ShutdownModule()
         bSettingsRegistered = false;
     }
 
+    FUnrealMCPRuntimeConfig::OnChanged().Remove(ConfigChangedHandle);
+    ConfigChangedHandle.Reset();
+    FUnrealMCPRuntimeConfig::Stop();
+
+    // The last snapshot goes through the log writer, so it has to be written before that stops.
+    FMetricsRegistry::Stop();
+    FJsonLogger::Shutdown();
+
     UE_LOG(LogUnrealMCP, Display, TEXT("Unreal MCP editor module shut down"));
 }
 
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class UWorld;
+
+/**
+ * Per-world actor lookup by name, path, label and GUID, shared by every actor-resolving tool so a
+ * lookup by name no longer walks the whole world. A world's index is built by one actor iteration
+ * on its first lookup and kept current from the engine's actor added, deleted, renamed, relabelled
+ * and outer-changed delegates; undo, redo and level streaming drop it to be rebuilt on the next
+ * lookup. Every hit is checked against the actor before it is returned, and a stale entry rebuilds
+ * the index once. Game (PIE) worlds spawn actors without telling the editor, so they are scanned
+ * instead of indexed. Game thread only.
+ */
+class FActorIndex
+{
+public:
+    static FActorIndex& Get();
+
+    /** Binds the engine delegates (game thread). */
+    void Start();
+
+    /** Unbinds them and frees every index. */
+    void Stop();
+
+    /**
+     * The actor in World whose path name, name or actor GUID is Identifier, tried in that order;
+     * the same matching the tools' resolvers always did by scanning.
+     */
+    AActor* Resolve(UWorld* World, const FString& Identifier);
+
+    AActor* FindByName(UWorld* World, FName Name);
+    AActor* FindByPath(UWorld* World, const FString& PathName);
+    AActor* FindByGuid(UWorld* World, const FGuid& Guid);
+
+    /** Actors whose label is Label (case-insensitive); labels need not be unique. */
+    void FindByLabel(UWorld* World, const FString& Label, TArray<AActor*>& OutActors);
+
+    /** Every live actor in World, in no particular order. */
+    void GetActors(UWorld* World, TArray<AActor*>& OutActors);
+
+    /** Whether World's actor changes reach the index (editor worlds once started; never game worlds). */
+    bool IsTracking(const UWorld* World) const { return UsesIndex(World); }
+
+    /**
+     * Bumped by every actor add, delete, rename, relabel or move, undo/redo and level streaming in
+     * any tracked world, so callers can cache what they derive from actors and compare revisions.
+     */
+    uint64 GetRevision() const { return Revision; }
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<AActor> Actor;
+        FName Name;
+        FString Path;
+        FString Label;
+        FGuid Guid;
+    };
+
+    struct FWorldIndex
+    {
+        TMap<FObjectKey, FEntry> Entries;
+        TMultiMap<FName, FObjectKey> ByName;
+        TMap<FString, FObjectKey> ByPath;
+        TMultiMap<FString, FObjectKey> ByLabel;
+        TMap<FGuid, FObjectKey> ByGuid;
+    };
+
+    /** False for game worlds and before Start, which are scanned instead. */
+    bool UsesIndex(const UWorld* World) const;
+
+    /** World's index, built if it has none; null when UsesIndex is false. */
+    FWorldIndex* FindOrBuild(UWorld* World);
+
+    /** The indexed actor for Key if it is still alive, in World and passes Matches; false asks for a rebuild. */
+    bool CheckHit(const FWorldIndex& Index, UWorld* World, const FObjectKey& Key, TFunctionRef<bool(const AActor&)> Matches, AActor*& OutActor) const;
+
+    /** Runs Lookup on World's index; a stale hit rebuilds the index and runs it once more. */
+    AActor* LookUp(UWorld* World, TFunctionRef<bool(const FWorldIndex&, AActor*&)> Lookup);
+
+    static void AddActor(FWorldIndex& Index, AActor* Actor);
+    static void RemoveActor(FWorldIndex& Index, const FObjectKey& Key);
+
+    /** Re-files a built world's entry for Actor after a rename, relabel or move. */
+    void ReindexActor(AActor* Actor);
+    void DropWorld(UWorld* World);
+
+    TMap<FObjectKey, FWorldIndex> Worlds;
+    uint64 Revision = 0;
+    bool bStarted = false;
+
+    FDelegateHandle ActorAddedHandle;
+    FDelegateHandle ActorDeletedHandle;
+    FDelegateHandle ActorOuterChangedHandle;
+    FDelegateHandle ActorLabelChangedHandle;
+    FDelegateHandle ObjectRenamedHandle;
+    FDelegateHandle PostUndoRedoHandle;
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+    FDelegateHandle WorldCleanupHandle;
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ConvexVolume.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class UWorld;
+
+/**
+ * Per-world loose grid over actor bounds, for box, sphere, ray and frustum queries that touch only
+ * the cells they overlap instead of every actor. Each actor is filed under every cell its bounds
+ * overlap; actors spanning more than MaxCellsPerAxis cells on an axis (landscapes, sky spheres,
+ * volumes) go on an oversized list that every query tests. A world's grid is built on its first
+ * query. The engine's actor added, deleted and moved events keep it current. Modify() on an actor
+ * or one of its scene components marks the actor to be re-filed before the next query, since
+ * Modify() comes before the change. Undo, redo and level streaming drop the grid. Game (PIE) worlds
+ * are scanned instead, as in FActorIndex. Game thread only.
+ */
+class FActorSpatialIndex
+{
+public:
+        /** Grid cell edge, 50 m. */
+        static constexpr double CellSize = 5000.0;
+        static constexpr int32 MaxCellsPerAxis = 16;
+
+        struct FRayHit
+        {
+                AActor* Actor = nullptr;
+                /** Distance from the ray origin to where it enters the actor's bounds (0 when it starts inside). */
+                double Distance = 0.0;
+        };
+
+        static FActorSpatialIndex& Get();
+
+        /** Binds the engine delegates (game thread). */
+        void Start();
+
+        /** Unbinds them and frees every grid. */
+        void Stop();
+
+        /** Actors whose bounds intersect Box. */
+        void QueryBox(UWorld* World, const FBox& Box, TArray<AActor*>& OutActors);
+
+        /** Actors whose bounds come within Radius of Center. */
+        void QuerySphere(UWorld* World, const FVector& Center, double Radius, TArray<AActor*>& OutActors);
+
+        /** Actors whose bounds the segment from Origin along Direction for Length crosses, nearest first. */
+        void QueryRay(UWorld* World, const FVector& Origin, const FVector& Direction, double Length, TArray<FRayHit>& OutHits);
+
+        /** Actors whose bounds intersect Frustum and lie within MaxDistance of Origin. */
+        void QueryFrustum(UWorld* World, const FConvexVolume& Frustum, const FVector& Origin, double MaxDistance, TArray<AActor*>& OutActors);
+
+        /** A camera's view frustum without a far plane; FovDegrees is horizontal, Aspect is width / height. */
+        static FConvexVolume MakeViewFrustum(const FVector& Location, const FRotator& Rotation, float FovDegrees, float Aspect);
+
+        /** The bounds an actor is filed under: its components' bounds, or its location when it has none. */
+        static FBox GetActorBounds(const AActor& Actor);
+
+private:
+        struct FEntry
+        {
+                TWeakObjectPtr<AActor> Actor;
+                FBox Bounds = FBox(ForceInit);
+                FIntVector MinCell = FIntVector::ZeroValue;
+                FIntVector MaxCell = FIntVector::ZeroValue;
+                bool bOversized = false;
+        };
+
+        struct FWorldGrid
+        {
+                TMap<FObjectKey, FEntry> Entries;
+                TMap<FIntVector, TArray<FObjectKey>> Cells;
+                TSet<FObjectKey> Oversized;
+                /** Actors to re-file before the next query. */
+                TMap<FObjectKey, TWeakObjectPtr<AActor>> Dirty;
+        };
+
+        /** False for game worlds and before Start, which are scanned instead. */
+        bool UsesGrid(const UWorld* World) const;
+
+        /** World's grid, built if it has none and with dirty actors re-filed; null when UsesGrid is false. */
+        FWorldGrid* FindOrBuild(UWorld* World);
+
+        /** Calls Visit once for each live actor filed in a cell overlapping Box, and each oversized one. */
+        void VisitCandidates(UWorld* World, const FBox& Box, TFunctionRef<void(AActor&, const FBox&)> Visit);
+
+        static void AddActor(FWorldGrid& Grid, AActor* Actor);
+        static void RemoveActor(FWorldGrid& Grid, const FObjectKey& Key);
+        static FIntVector ToCell(const FVector& Location);
+
+        void MarkDirty(AActor* Actor);
+        void DropWorld(UWorld* World);
+
+        TMap<FObjectKey, FWorldGrid> Worlds;
+        bool bStarted = false;
+
+        FDelegateHandle ActorAddedHandle;
+        FDelegateHandle ActorDeletedHandle;
+        FDelegateHandle ActorMovedHandle;
+        FDelegateHandle ObjectModifiedHandle;
+        FDelegateHandle PostUndoRedoHandle;
+        FDelegateHandle LevelAddedHandle;
+        FDelegateHandle LevelRemovedHandle;
+        FDelegateHandle WorldCleanupHandle;
+};
@@ -11,6 +11,9 @@ public:
         /** Spawns an actor instance in the current editor world. */
         static TSharedPtr<FJsonObject> Spawn(const TSharedPtr<FJsonObject>& Params);
 
+        /** Spawns many actors from parallel arrays in one transaction, with construction deferred to the end. */
+        static TSharedPtr<FJsonObject> SpawnBatch(const TSharedPtr<FJsonObject>& Params);
+
         /** Destroys actors by path/name. */
         static TSharedPtr<FJsonObject> Destroy(const TSharedPtr<FJsonObject>& Params);
 
@@ -20,6 +23,25 @@ public:
         /** Applies absolute and/or additive transforms to an actor. */
         static TSharedPtr<FJsonObject> Transform(const TSharedPtr<FJsonObject>& Params);
 
+        /** Applies packed location/quaternion/scale transforms to many actors in one transaction. */
+        static TSharedPtr<FJsonObject> TransformBatch(const TSharedPtr<FJsonObject>& Params);
+
         /** Mutates the Actor Tags array for an actor. */
         static TSharedPtr<FJsonObject> Tag(const TSharedPtr<FJsonObject>& Params);
+
+        /** Reports which actors of the edited level changed since a token, and a new token. */
+        static TSharedPtr<FJsonObject> ChangesSince(const TSharedPtr<FJsonObject>& Params);
+
+        /** Lists actors whose bounds meet a box, sphere, ray or the active viewport's frustum. */
+        static TSharedPtr<FJsonObject> QuerySpatial(const TSharedPtr<FJsonObject>& Params);
+
+        /** Reads the same property paths from many actors into one column per path. */
+        static TSharedPtr<FJsonObject> ReadProperties(const TSharedPtr<FJsonObject>& Params);
+
+        /**
+         * Reads Count packed transforms from "transforms" (a flat number array, 10 per transform:
+         * location xyz, quaternion xyzw, scale xyz) or "transformsBase64" (the same layout as
+         * little-endian float32). A negative Count takes as many transforms as are given.
+         */
+        static bool ParsePackedTransforms(const FJsonObject& Params, int32 Count, TArray<FTransform>& OutTransforms, FString& OutError);
 };
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * Bulk placement into instanced static mesh components. Scatters of thousands of copies of one
+ * mesh land as instances of a handful of components instead of one actor each, in one batch per
+ * component, so the render state (and the HISM tree) is rebuilt once rather than per instance.
+ */
+class UNREALMCPEDITOR_API FInstanceTools
+{
+public:
+        /** Adds packed transforms as foliage instances of a mesh or foliage type in the edited world. */
+        static TSharedPtr<FJsonObject> FoliageAddInstances(const TSharedPtr<FJsonObject>& Params);
+
+        /** Adds packed transforms as instances of an (H)ISM component on an existing or new actor. */
+        static TSharedPtr<FJsonObject> IsmAddInstances(const TSharedPtr<FJsonObject>& Params);
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class FJsonObject;
+class UPackage;
+class UWorld;
+
+/**
+ * Bounded log of what changed among the edited level's actors, for world.changes_since. One entry
+ * per changed actor holds the kinds of change since it entered the log (added, deleted, moved,
+ * relabelled, properties edited) and the sequence number of its latest change, so an actor dragged
+ * for a minute is one entry. A token is the sequence number a client has seen, so a delta is the
+ * entries changed after it. When the log is full the oldest quarter is evicted. Tokens older than
+ * the eviction, and every token after undo, redo or level streaming (which change actors without
+ * saying which), get a resync answer. A new map starts a new epoch, and earlier tokens are then
+ * rejected. Game thread only.
+ *
+ * Separately it keeps the packages of the actors MCP commands changed (an actor's external package
+ * on a One-File-Per-Actor map, its level's otherwise), so level.save_open can save just those.
+ */
+class FWorldChangeLog
+{
+public:
+        enum EChange : uint8
+        {
+                Added = 1 << 0,
+                Deleted = 1 << 1,
+                Moved = 1 << 2,
+                Relabelled = 1 << 3,
+                PropertiesEdited = 1 << 4
+        };
+
+        struct FEntry
+        {
+                TWeakObjectPtr<AActor> Actor;
+                /** Path at the latest change, kept for deleted actors. */
+                FString Path;
+                int64 Seq = 0;
+                uint8 Changes = 0;
+                /** Edited property names, as "Property" or "Component.Property"; empty once bManyProperties is set. */
+                TSet<FString> Properties;
+                bool bManyProperties = false;
+        };
+
+        struct FDelta
+        {
+                /** The token cannot be served: the client must take a full snapshot and start from Token. */
+                bool bResync = false;
+                /** Entries changed after the token, oldest first. */
+                TArray<FEntry> Entries;
+                /** Token to send next time. */
+                FString Token;
+                /** More entries remain past Token. */
+                bool bMore = false;
+        };
+
+        static constexpr int32 MaxPropertiesPerEntry = 32;
+
+        static FWorldChangeLog& Get();
+
+        /** Binds the engine delegates (game thread). */
+        void Start();
+
+        /** Unbinds them and drops the log. */
+        void Stop();
+
+        /** Entries changed after Token, at most Limit of them. An empty Token asks for the current token and a resync. */
+        void ChangesSince(const FString& Token, int32 Limit, FDelta& OutDelta);
+
+        /**
+         * Packages of the edited level's actors that MCP commands added, deleted or modified and that
+         * are still dirty, in the order they were first touched. Saved or reverted ones drop out.
+         */
+        void GetTouchedPackages(TArray<UPackage*>& OutPackages);
+
+        /** An entry in the shape world.changes_since reports it. */
+        static TSharedRef<FJsonObject> EntryToJson(const FEntry& Entry);
+
+private:
+        FString MakeToken(int64 InSeq) const;
+        bool ParseToken(const FString& Token, int64& OutSeq) const;
+
+        /** The edited world when Actor belongs to it, starting a new epoch if that world changed. */
+        bool IsTracked(const AActor* Actor);
+        void Record(AActor* Actor, uint8 Change, const FString& Property = FString());
+        /** Keeps Actor's package when the change comes from an MCP command. */
+        void NoteTouched(AActor* Actor);
+        void Evict();
+
+        /** Invalidates every token issued so far without changing the epoch. */
+        void ForceResync();
+        void ResetEpoch();
+
+        TMap<FObjectKey, FEntry> Entries;
+        TWeakObjectPtr<UWorld> TrackedWorld;
+        FGuid Epoch;
+        int64 Seq = 0;
+        /** Tokens below this missed evicted or unrecorded changes. */
+        int64 FloorSeq = 0;
+        int32 MaxEntries = 65536;
+        bool bStarted = false;
+        /** In the order first touched, and as a set for the check on every Modify. */
+        TArray<FObjectKey> TouchedPackages;
+        TSet<FObjectKey> TouchedKeys;
+
+        FDelegateHandle ActorAddedHandle;
+        FDelegateHandle ActorDeletedHandle;
+        FDelegateHandle ActorMovedHandle;
+        FDelegateHandle ActorLabelChangedHandle;
+        FDelegateHandle PropertyChangedHandle;
+        FDelegateHandle ObjectModifiedHandle;
+        FDelegateHandle PostUndoRedoHandle;
+        FDelegateHandle LevelAddedHandle;
+        FDelegateHandle LevelRemovedHandle;
+        FDelegateHandle WorldCleanupHandle;
+};
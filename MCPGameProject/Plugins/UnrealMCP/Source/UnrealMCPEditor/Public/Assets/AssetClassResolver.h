@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/TopLevelAssetPath.h"
+
+#include <atomic>
+
+struct FAssetData;
+
+/**
+ * Resolves the class names clients write ("StaticMesh", "UStaticMesh", "BP_Door_C" or a full
+ * "/Script/Engine.StaticMesh") to class paths, from a table of every class the asset registry knows,
+ * native and Blueprint-generated. The table is built on first use and dropped when modules load,
+ * after a hot reload or live coding patch, and when a Blueprint asset is added or removed.
+ *
+ * Short names are matched case-insensitively. A name defined by more than one package resolves to
+ * all of them, so a filter built from it matches every candidate instead of guessing one.
+ *
+ * It also keeps each queried class's subclass closure, so filters can list their classes outright
+ * instead of asking the registry to walk the class tree (bRecursiveClasses) on every query. Closures
+ * are dropped with the table, and also when a Blueprint is saved, since that may reparent it.
+ */
+class FAssetClassResolver
+{
+public:
+    static FAssetClassResolver& Get();
+
+    /** Binds the module, reload and registry delegates that drop the table (game thread). */
+    void Start();
+    void Stop();
+
+    /** Builds the table now rather than on the first Resolve (editor.warmup). Thread-safe. */
+    void Prewarm();
+
+    /** Appends the classes ClassName names to OutPaths; false if it names none. Thread-safe. */
+    bool Resolve(const FString& ClassName, TArray<FTopLevelAssetPath>& OutPaths);
+
+    /**
+     * Appends every class deriving from one of InOutPaths, native or Blueprint-generated, that is not
+     * already in it. A filter with the result as ClassPaths matches what bRecursiveClasses would, so
+     * it can leave the flag off. Thread-safe.
+     */
+    void ExpandDerivedClasses(TArray<FTopLevelAssetPath>& InOutPaths);
+
+    /** Drops the table and the cached closures; the next Resolve rebuilds it. */
+    void Invalidate();
+
+private:
+    void EnsureBuilt();
+    void InvalidateClosures();
+    void HandleAssetChanged(const FAssetData& AssetData);
+    void HandleAssetUpdated(const FAssetData& AssetData);
+    void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+    FRWLock Lock;
+    std::atomic<bool> bBuilt{ false };
+
+    /** Lowered class name -> every class of that name. */
+    TMap<FString, TArray<FTopLevelAssetPath, TInlineAllocator<1>>> ClassesByName;
+
+    /** Base class -> its subclasses, the base excluded. Shared so readers can use one outside the lock. */
+    TMap<FTopLevelAssetPath, TSharedRef<const TArray<FTopLevelAssetPath>, ESPMode::ThreadSafe>> DerivedByBase;
+    std::atomic<bool> bHasClosures{ false };
+    /** Bumped by every invalidation, so a closure computed across one is not stored. */
+    std::atomic<uint32> ClosureGeneration{ 0 };
+
+    FDelegateHandle ModulesChangedHandle;
+    FDelegateHandle ReloadCompleteHandle;
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetUpdatedHandle;
+    FDelegateHandle AssetRenamedHandle;
+};
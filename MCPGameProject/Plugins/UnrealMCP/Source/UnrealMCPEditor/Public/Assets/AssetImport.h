@@ -4,10 +4,13 @@
 
 class FJsonObject;
 
-/** Implements the asset.batch_import mutation. */
+/** Implements the asset.batch_import mutation and its read-only planner, asset.plan_import. */
 class FAssetImport
 {
 public:
     static TSharedPtr<FJsonObject> BatchImport(const TSharedPtr<FJsonObject>& Params);
+
+    /** Predicts kind, cost, conflicts and option mismatches of a batch_import from file headers alone. Any thread. */
+    static TSharedPtr<FJsonObject> PlanImport(const TSharedPtr<FJsonObject>& Params);
 };
 
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetRegistryInterface.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+
+#include <atomic>
+
+struct FARFilter;
+struct FAssetData;
+class FAssetRegistryState;
+class FJsonObject;
+
+/**
+ * A copy of the asset registry (assets, tags and package dependencies) kept in
+ * Saved/UnrealMCP/AssetIndex.bin, so registry reads have something to answer from during the
+ * minutes a cold editor spends on its startup scan.
+ *
+ * It is saved after the scan finishes, every AssetIndexSaveIntervalMin and on shutdown. At startup,
+ * while the registry is still loading, the file is memory-mapped and deserialized on a worker
+ * thread, then checked in one pass over the content folders' file timestamps: packages changed or
+ * deleted since the save are left out, and the live registry answers for them once it gets there.
+ * The copy is dropped as soon as the live scan completes.
+ */
+class FAssetIndexCache
+{
+public:
+    static FAssetIndexCache& Get();
+
+    /** Starts loading the saved index if the registry is still scanning, and schedules saves (game thread). */
+    void Start();
+
+    /** Saves the index if the scan had finished, then frees everything (game thread). */
+    void Stop();
+
+    /** True while the live registry is still scanning and a validated saved index is loaded. Thread-safe. */
+    bool IsServing() const;
+
+    /**
+     * Assets matching Filter: the saved index's answer for packages it knows and that have not
+     * changed since, merged with whatever the live registry has scanned so far (which wins).
+     * False when not serving; callers then query the registry directly.
+     */
+    bool GetAssets(const FARFilter& Filter, TArray<FAssetData>& OutAssets) const;
+
+    /** Package dependencies or referencers from the saved index; false when not serving. */
+    bool GetDependencies(FName PackageName, UE::AssetRegistry::EDependencyQuery Query, TArray<FName>& OutPackages) const;
+    bool GetReferencers(FName PackageName, UE::AssetRegistry::EDependencyQuery Query, TArray<FName>& OutPackages) const;
+
+    /** Adds "startupIndex" to a registry status object while serving. */
+    void AddStatus(FJsonObject& RegistryJson) const;
+
+    /** Writes the index now (game thread); the file is written on a worker thread. */
+    void Save();
+
+private:
+    struct FLoadedIndex
+    {
+        TSharedPtr<FAssetRegistryState, ESPMode::ThreadSafe> State;
+        /** Packages changed or deleted on disk since SavedAt. */
+        TSet<FName> StalePackages;
+        FDateTime SavedAt;
+        int32 AssetCount = 0;
+    };
+
+    void LoadAsync();
+    void HandleFilesLoaded();
+    bool TickSave(float DeltaTime);
+    TSharedPtr<const FLoadedIndex, ESPMode::ThreadSafe> GetLoaded() const;
+
+    mutable FCriticalSection Mutex;
+    TSharedPtr<const FLoadedIndex, ESPMode::ThreadSafe> Loaded;
+
+    std::atomic<bool> bScanComplete{ false };
+    std::atomic<bool> bSaving{ false };
+    bool bStarted = false;
+
+    FDelegateHandle FilesLoadedHandle;
+    FTSTicker::FDelegateHandle SaveTickerHandle;
+};
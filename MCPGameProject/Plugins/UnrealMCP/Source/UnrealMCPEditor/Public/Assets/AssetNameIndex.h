@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+#include <atomic>
+
+struct FAssetData;
+
+/**
+ * In-memory trigram index over asset names and package folders, so asset.find can answer name and
+ * path searches without lowering and scanning every asset string. It is built on the first query
+ * after the initial registry scan and kept current from the registry's add, remove and rename
+ * delegates; until then (or outside the editor subsystem, e.g. commandlets) lookups report that the
+ * index is unavailable and callers fall back to scanning.
+ *
+ * Matching is case-insensitive. Fuzzy matching accepts strings sharing at least half of the query's
+ * trigrams, which tolerates a typo or two in queries of four or more characters.
+ */
+class FAssetNameIndex
+{
+public:
+    enum class EMatch : uint8
+    {
+        Contains,
+        Prefix,
+        Fuzzy
+    };
+
+    static FAssetNameIndex& Get();
+
+    /** Binds the registry delegates (game thread). */
+    void Start();
+
+    /** Unbinds them and frees the index. */
+    void Stop();
+
+    /**
+     * Asset names matching Query, with the packages holding an asset of that name. False if the
+     * index cannot be used yet; the out sets are then untouched.
+     */
+    bool FindAssetNames(const FString& Query, EMatch Match, TSet<FName>& OutNames, TSet<FName>& OutPackages);
+
+    /** Package folders (e.g. /Game/Props/Rocks) matching Query. False if the index cannot be used yet. */
+    bool FindPackagePaths(const FString& Query, EMatch Match, TSet<FName>& OutPaths);
+
+    /** Builds the index now rather than on the first query (editor.warmup); false until the registry scan is done. */
+    bool Prewarm();
+
+    /** The same test without the index, for callers falling back to a scan. */
+    static bool Matches(const FString& Text, const FString& Query, EMatch Match);
+
+private:
+    /** Lowered strings keyed by FName with trigram postings; entries are counted so shared names and folders stay until their last asset goes. */
+    struct FTrigramTable
+    {
+        TArray<FName> Keys;
+        TArray<FString> Lowered;
+        TArray<int32> RefCounts;
+        TMap<FName, int32> IdByKey;
+        TMap<uint64, TArray<int32>> Postings;
+        int32 DeadCount = 0;
+
+        void AddRef(FName Key);
+        void Release(FName Key);
+        void Find(const FString& LowerQuery, EMatch Match, TArray<int32>& OutIds) const;
+        void Reset();
+
+    private:
+        void Compact();
+    };
+
+    bool EnsureBuilt();
+    void AddAsset(const FAssetData& AssetData);
+    void RemoveAsset(const FAssetData& AssetData);
+    void RemoveAsset(FName AssetName, FName PackageName, FName PackagePath);
+
+    FRWLock Lock;
+    std::atomic<bool> bBuilt{ false };
+    bool bStarted = false;
+
+    FTrigramTable Names;
+    /** For each indexed asset name, the packages that hold an asset of that name, with counts. */
+    TMap<FName, TMap<FName, int32>> PackagesByName;
+    FTrigramTable Paths;
+
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+};
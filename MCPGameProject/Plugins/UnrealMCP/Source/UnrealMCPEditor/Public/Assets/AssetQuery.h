@@ -12,11 +12,33 @@ struct FAssetFindParams
     TArray<FString> Paths;
     TArray<FString> ClassNames;
     TOptional<FString> NameContains;
+    TOptional<FString> NameStartsWith;
+    /** Substring of the package folder, e.g. "Props/Rocks". */
+    TOptional<FString> PathContains;
+    /** NameContains and PathContains also accept near matches (see FAssetNameIndex). */
+    bool bFuzzy = false;
     TMap<FName, TArray<FString>> TagQuery;
+
+    enum class ETagMatch : uint8
+    {
+        /** The tag value contains every listed value (case-insensitive). */
+        Contains,
+        /** The tag value is one of the listed values, as stored; answered by the registry's tag index. */
+        Exact,
+        /** The tag value starts with one of the listed values (case-insensitive). */
+        Prefix
+    };
+
+    /** Per-tag mode for TagQuery; tags not listed use Contains. */
+    TMap<FName, ETagMatch> TagMatch;
+
     bool bRecursive = true;
     int32 Limit = 200;
     int32 Offset = 0;
 
+    /** NextCursor of a previous page of the same query; when set, Offset is ignored. */
+    FString Cursor;
+
     enum class ESortBy
     {
         Name,
@@ -26,6 +48,20 @@ struct FAssetFindParams
 
     ESortBy SortBy = ESortBy::Name;
     bool bSortAscending = true;
+
+    /** Which FAssetLite fields to fill; the rest are left empty and never read from the registry. */
+    struct FFieldSelection
+    {
+        bool bObjectPath = true;
+        bool bPackagePath = true;
+        bool bAssetName = true;
+        bool bClassName = true;
+        /** Every tag, parsed; when false only TagNames are copied. */
+        bool bAllTags = true;
+        TArray<FName> TagNames;
+    };
+
+    FFieldSelection Fields;
 };
 
 struct FAssetLite
@@ -37,10 +73,121 @@ struct FAssetLite
     TMap<FString, TArray<FString>> Tags;
 };
 
+struct FAssetFindPage
+{
+    int32 Total = 0;
+    TArray<FAssetLite> Items;
+
+    /** Opaque cursor for the next page; empty on the last one. */
+    FString NextCursor;
+
+    /** The cursor was issued before an asset registry change; the query must restart from the first page. */
+    bool bCursorExpired = false;
+};
+
+struct FAssetExistsResult
+{
+    FString ObjectPath;
+    bool bExists = false;
+    FString ClassName;
+
+    /** Set when ObjectPath does not parse; bExists is then false. */
+    FString Error;
+};
+
+struct FAssetMetadataOptions
+{
+    /** Cap on each of the hard and soft dependency lists; negative for no cap. */
+    int32 MaxDependencies = -1;
+
+    /** Report dependencies as asset object paths; false returns the package names as the registry gives them. */
+    bool bResolveDependencies = true;
+};
+
+struct FAssetGraphParams
+{
+    /** Object paths or package names to start from. */
+    TArray<FString> Roots;
+
+    enum class EDirection : uint8
+    {
+        /** What the roots use. */
+        Dependencies,
+        /** What uses the roots, i.e. what breaks if they change. */
+        Referencers,
+        Both
+    };
+
+    EDirection Direction = EDirection::Dependencies;
+    bool bHard = true;
+    bool bSoft = true;
+    /** Follow /Script packages; they are leaves of nearly every graph, so they are left out by default. */
+    bool bIncludeScriptPackages = false;
+
+    int32 MaxDepth = 3;
+    int32 MaxNodes = 2000;
+    double TimeLimitSeconds = 5.0;
+};
+
+/** Where the asset registry's initial scan is; answers given before it completes may miss assets. */
+struct FAssetRegistryStatus
+{
+    bool bComplete = true;
+    /** Still discovering files on disk, so TotalAssets is a lower bound. */
+    bool bDiscoveringFiles = false;
+    int32 TotalAssets = 0;
+    int32 ProcessedAssets = 0;
+    int32 PendingDataLoad = 0;
+
+    /** 0..1, from the last progress update the registry sent. */
+    double GetProgress() const;
+    TSharedPtr<FJsonObject> ToJson() const;
+};
+
 class FAssetQuery
 {
 public:
     static bool Find(const FAssetFindParams& Params, int32& OutTotal, TArray<FAssetLite>& OutItems, FString& OutError);
+
+    /**
+     * Like Find, but a query with more matches than Limit keeps its sorted result as a snapshot and
+     * returns a cursor to it, so later pages are copied straight out of the snapshot. Snapshots are
+     * dropped after a couple of idle minutes or on any asset registry change; a cursor whose snapshot
+     * timed out is rebuilt transparently as long as the registry has not changed since.
+     */
+    static bool FindPage(const FAssetFindParams& Params, FAssetFindPage& OutPage, FString& OutError);
+
+    /** Thread-safe; progress counts are only tracked between StartSnapshotTracking and StopSnapshotTracking. */
+    static FAssetRegistryStatus GetRegistryStatus();
+
+    /** Sets "complete" on a read result, plus "registry" (see FAssetRegistryStatus::ToJson) while the scan runs. */
+    static void AddRegistryStatus(FJsonObject& Data);
+
+    /** Binds the registry delegates that expire snapshots and track scan progress (game thread). */
+    static void StartSnapshotTracking();
+    static void StopSnapshotTracking();
+
     static bool Exists(const FString& ObjectPath, bool& bOutExists, FString& OutClassName, FString& OutError);
-    static bool Metadata(const FString& ObjectPath, TSharedPtr<FJsonObject>& OutJson, FString& OutError);
+    static bool Metadata(const FString& ObjectPath, TSharedPtr<FJsonObject>& OutJson, FString& OutError, const FAssetMetadataOptions& Options = FAssetMetadataOptions());
+
+    /**
+     * Batched forms: all paths are looked up in one registry query and results come back in request
+     * order (up to 1000 paths). Entries that fail on their own are reported per item; false is only
+     * returned for a bad request as a whole.
+     */
+    static bool ExistsBatch(const TArray<FString>& ObjectPaths, TArray<FAssetExistsResult>& OutResults, FString& OutError);
+
+    /**
+     * Items are the single-path metadata objects, or {"ok": false, "objectPath", "error"}. Dependency
+     * packages are resolved once for the batch, through a memo that lasts until the next registry change.
+     */
+    /**
+     * Breadth-first walk of the package dependency graph from Roots, stopping at MaxDepth, MaxNodes or
+     * TimeLimitSeconds, whichever comes first. OutJson holds parallel arrays: "nodes" (package names,
+     * roots first), "depth", and "hard"/"soft" adjacency lists of node indices, where an entry in
+     * hard[i] means node i depends on that node. Edges are only listed between returned nodes.
+     */
+    static bool Graph(const FAssetGraphParams& Params, TSharedPtr<FJsonObject>& OutJson, FString& OutError);
+
+    static bool MetadataBatch(const TArray<FString>& ObjectPaths, TArray<TSharedPtr<FJsonObject>>& OutItems, FString& OutError, const FAssetMetadataOptions& Options = FAssetMetadataOptions());
 };
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * asset.thumbnails: previews for many assets without loading them. Thumbnails are read from the
+ * thumbnail table each saved package already carries (one read per package, however many of its
+ * assets are asked for), or from memory for packages edited since, then decoded, downscaled to
+ * size and encoded on worker threads while the request is suspended. Assets with no thumbnail are
+ * reported as missing; only render: true loads and renders them, on the game thread.
+ */
+class FAssetThumbnails
+{
+public:
+    static TSharedPtr<FJsonObject> Thumbnails(const TSharedPtr<FJsonObject>& Params);
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * datatable.import_rows: appends or replaces many rows of a UDataTable in one pass. Rows arrive as
+ * JSON objects, CSV text or a CSV/JSON attachment, optionally spread over several requests of one
+ * stream that are staged in memory until the final chunk. Each row is built in a scratch copy and
+ * compared with the row it would overwrite, so only rows that actually change are written and
+ * notified (HandleDataTableChanged), the table editor refreshes once, and the package is saved
+ * once at the end when asked.
+ */
+class FDataTableImport
+{
+public:
+    static TSharedPtr<FJsonObject> ImportRows(const TSharedPtr<FJsonObject>& Params);
+};
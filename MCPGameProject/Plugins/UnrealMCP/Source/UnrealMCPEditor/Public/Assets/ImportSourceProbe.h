@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * What an import source's own headers say about it, read without an importer: image dimensions
+ * and pixel format, an FBX file's version and whether it holds skins and animation, an audio
+ * file's channels, rate and length. Reads at most a bounded prefix (and, for Ogg, suffix) of the
+ * file, except for FBX, whose object markers are scanned through the whole file.
+ */
+struct FImportSourceInfo
+{
+    /** "png", "jpeg", "bmp", "tga", "exr", "hdr", "fbx", "wav", "ogg" or "flac". */
+    FString Format;
+    int64 FileSize = 0;
+
+    int32 Width = 0;
+    int32 Height = 0;
+    int32 BitsPerChannel = 0;
+    int32 Channels = 0;
+    bool bHdr = false;
+
+    int32 FbxVersion = 0;
+    bool bFbxBinary = false;
+    int32 GeometryCount = 0;
+    int32 SkinClusterCount = 0;
+    int32 AnimStackCount = 0;
+
+    int32 SampleRate = 0;
+    double DurationSeconds = 0.0;
+
+    /** Fields set above, in the shape asset.plan_import reports them. */
+    TSharedRef<FJsonObject> ToJson() const;
+};
+
+class FImportSourceProbe
+{
+public:
+    /** Reads FilePath's headers by its extension. False with OutError when they cannot be parsed. Any thread. */
+    static bool Probe(const FString& FilePath, FImportSourceInfo& OutInfo, FString& OutError);
+};
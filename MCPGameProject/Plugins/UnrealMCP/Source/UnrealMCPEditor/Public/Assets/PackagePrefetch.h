@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+
+class FJsonObject;
+class UPackage;
+
+/**
+ * Loads the packages a multi-asset command is about to resolve with LoadPackageAsync, all at once,
+ * so disk reads and decompression run side by side on the loader instead of one synchronous
+ * LoadObject after another on the game thread. Handlers then take each object as its package
+ * lands; LoadObject/TryLoad on a finished package is a lookup.
+ *
+ * Handlers with a resume state of their own keep an FPackagePrefetch in it, Request the next few
+ * items' packages each slice and suspend while the one they need is still loading, so processing
+ * overlaps the loads behind it. Handlers without one call Await before resolving anything.
+ * Everything runs on the game thread; completions arrive while the engine ticks between slices.
+ */
+class FPackagePrefetch : public TSharedFromThis<FPackagePrefetch>
+{
+public:
+    /**
+     * Starts loading the packages behind Paths (object paths or long package names) that are
+     * neither in memory nor already requested. Script packages and malformed paths are ignored.
+     */
+    void Request(TConstArrayView<FString> Paths);
+
+    /** Whether Path's package has finished loading (or failed), or was never requested. */
+    bool IsReady(const FString& Path) const;
+
+    int32 GetNumPending() const { return NumPending; }
+    int32 GetNumRequested() const { return PackageStates.Num(); }
+
+    /** Waits in this call for every outstanding load, for handlers that cannot suspend. */
+    void Flush();
+
+    /** { packages, alreadyLoaded, loaded, failed, elapsedMs } for a command's response. */
+    TSharedPtr<FJsonObject> ToJson() const;
+
+    /**
+     * Prefetches Paths, then suspends the running handler until all of them are in memory.
+     * True when the handler should carry on (also when it cannot suspend: the loads are then
+     * finished here, still side by side). False when it must return OutResponse right away:
+     * null after suspending (it is called again with the same params and must call Await again
+     * before resolving anything), or the CANCELLED error when the request was cancelled while
+     * waiting. OutStats, when given, receives ToJson once the wait is over.
+     */
+    static bool Await(TConstArrayView<FString> Paths, TSharedPtr<FJsonObject>& OutResponse, TSharedPtr<FJsonObject>* OutStats = nullptr);
+
+private:
+    enum class EPackageState : uint8
+    {
+        Pending,
+        Loaded,
+        Failed
+    };
+
+    static FName ToPackageName(const FString& Path);
+
+    /** Package is null when the load failed. */
+    void OnPackageLoaded(FName PackageName, UPackage* Package);
+
+    TMap<FName, EPackageState> PackageStates;
+    TMap<FName, int32> RequestIds;
+    int32 NumPending = 0;
+    int32 NumAlreadyLoaded = 0;
+    int32 NumLoaded = 0;
+    int32 NumFailed = 0;
+    double FirstRequestSeconds = 0.0;
+    double LastCompletionSeconds = 0.0;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class FJsonValue;
+class UPackage;
+
+/**
+ * Selective package saving for asset.save_all and level.save_open. Only dirty packages are
+ * collected, from the editor's dirty list rather than by walking the registry. They are checked out
+ * in one source-control call and serialized one after another, with their files written
+ * asynchronously and waited for once at the end, so disk writes overlap the next package's
+ * serialization. Packages without a map (external actor packages, most assets) can instead be
+ * serialized side by side on worker threads with UPackage::SaveConcurrent.
+ */
+class FPackageSaver
+{
+public:
+    struct FResult
+    {
+        FString PackageName;
+        bool bSaved = false;
+        /** Why the package was not saved; empty when it was. */
+        FString Error;
+    };
+
+    /**
+     * Dirty content and map packages under Roots (package paths such as "/Game/Props"; all content
+     * when empty) that the write gate allows. Game thread.
+     */
+    static void CollectDirtyPackages(const TArray<FString>& Roots, TArray<UPackage*>& OutPackages);
+
+    /**
+     * Checks out Packages in one call, then saves each one (game thread). False with OutError, the
+     * write gate's checkout error, when the checkout fails; nothing is saved then. Otherwise one
+     * result per package, in order. bConcurrent saves the packages without a map concurrently.
+     * Packages left empty by a deleted actor go through the editor's save, which deletes their files.
+     */
+    static bool SavePackages(const TArray<UPackage*>& Packages, TArray<FResult>& OutResults, TSharedPtr<FJsonObject>& OutError, bool bConcurrent = false);
+
+    /** Per-package results in the shape the save commands report them. */
+    static TArray<TSharedPtr<FJsonValue>> ResultsToJson(const TArray<FResult>& Results);
+};
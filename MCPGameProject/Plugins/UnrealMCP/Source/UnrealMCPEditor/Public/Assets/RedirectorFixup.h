@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class FJsonObject;
+class IAssetRegistry;
+
+/**
+ * Redirector fixup in batches of reference locality, for asset.fix_redirectors and
+ * content.fix_missing. Fixing every redirector at once loads every package that references any of
+ * them; here redirectors are grouped by the packages that reference them (from registry data, with
+ * nothing loaded), and each group is checked out, fixed up and saved before the next one loads.
+ * Saved referencers can then be released by a garbage collection.
+ */
+class FRedirectorFixup
+{
+public:
+    struct FBatch
+    {
+        TArray<FSoftObjectPath> Redirectors;
+        /** Packages referencing the batch's redirectors; these are what the fixup loads and saves. */
+        TArray<FName> Referencers;
+    };
+
+    static constexpr int32 DefaultMaxReferencersPerBatch = 64;
+    static constexpr int32 MaxRedirectorsPerBatch = 256;
+    static constexpr int64 DefaultMemoryCeilingBytes = 2048LL * 1024 * 1024;
+
+    /**
+     * Splits Redirectors into batches of at most MaxReferencers referencing packages (a redirector
+     * with more referencers gets a batch to itself). Redirectors sharing referencers land in the
+     * same batch when they fit.
+     */
+    static void PlanBatches(IAssetRegistry& AssetRegistry, const TArray<FAssetData>& Redirectors, int32 MaxReferencers, TArray<FBatch>& OutBatches);
+
+    /**
+     * PlanBatches for large sets, safe on a worker thread (it only reads the registry). Referencers
+     * are read in parallel. Redirectors that share a referencer or redirect to one another form one
+     * group; each group is ordered so a redirector comes after the one it redirects to, and groups
+     * are packed whole into batches, so batches touch disjoint packages. A group over the limits is
+     * split in that order. OutGroups is the number of referenced groups.
+     */
+    static void PlanGroupedBatches(IAssetRegistry& AssetRegistry, const TArray<FAssetData>& Redirectors, int32 MaxReferencers, TArray<FBatch>& OutBatches, int32& OutGroups);
+
+    /**
+     * Checks out the batch's referencers and redirectors in one source-control call, then loads the
+     * redirectors and fixes up (and saves) their referencers, deleting the redirectors left
+     * unreferenced (game thread). False with OutError, the write gate's checkout error, when the
+     * checkout fails; nothing is changed then.
+     */
+    static bool FixBatch(const FBatch& Batch, TArray<FString>& OutFixed, TSharedPtr<FJsonObject>& OutError);
+
+    /** The object a redirector points to, from its registry tag, or empty if the tag is missing. */
+    static FString GetDestination(const FAssetData& Redirector);
+
+    /** Collects garbage if used memory grew by more than CeilingBytes since StartUsedBytes. True if it ran. */
+    static bool CollectGarbageOverCeiling(int64 StartUsedBytes, int64 CeilingBytes);
+};
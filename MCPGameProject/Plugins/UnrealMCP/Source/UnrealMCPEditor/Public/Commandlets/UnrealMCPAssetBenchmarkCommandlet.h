@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UnrealMCPAssetBenchmarkCommandlet.generated.h"
+
+/**
+ * Times asset.find and content.scan/validate against a project-sized asset registry, so behaviour
+ * that only shows up at hundreds of thousands of assets can be reproduced from this project:
+ *
+ *   UnrealEditor-Cmd MCPGameProject.uproject -run=UnrealMCPAssetBenchmark [-Assets=380000] [-Seed=1]
+ *       [-Registry=<AssetRegistry.bin>] [-Root=/Game/...] [-Iterations=3] [-Output=<file.json>]
+ *
+ * By default a registry of -Assets synthetic entries is appended under /Game/MCPBench, with per-class
+ * tag sets and soft references fanning out to other synthetic assets. -Registry mounts a registry saved
+ * from another project instead (e.g. the production project's cooked AssetRegistry.bin), which brings its
+ * real dependency graph. Nothing is written to disk apart from the results file.
+ */
+UCLASS()
+class UUnrealMCPAssetBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UUnrealMCPAssetBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
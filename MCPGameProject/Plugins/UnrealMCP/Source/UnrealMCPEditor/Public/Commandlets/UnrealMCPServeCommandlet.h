@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UnrealMCPServeCommandlet.generated.h"
+
+/**
+ * Hosts the MCP server without the editor UI, for CI and farm nodes:
+ *
+ *   UnrealEditor-Cmd MCPGameProject.uproject -run=UnrealMCPServe -nullrhi -unattended -nosplash
+ *       [-Port=55557] [-IdleTimeout=300] [-TickRate=60]
+ *
+ * The bridge subsystem, its command registry and its settings are the ones the editor uses. The asset
+ * registry is scanned before the server starts listening, then the commandlet pumps the core ticker
+ * (and with it the game-thread scheduler and the event hub) at -TickRate frames per second. It exits
+ * once -IdleTimeout seconds pass with no client connected and nothing queued; 0 keeps it running
+ * until the process is asked to exit. Commands that need a viewport fail as they would in an editor
+ * whose viewport is closed.
+ */
+UCLASS()
+class UUnrealMCPServeCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UUnrealMCPServeCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * blueprint.compile_many: compiles a set of blueprints, named or every one under some content
+ * folders, in one pass of the engine's compilation manager (see FBlueprintCompileQueue::CompileMany),
+ * so recompiling hundreds of blueprints after a native change costs what the editor's own
+ * recompile does rather than one full compile, reinstance and dependent recompile per blueprint.
+ */
+class UNREALMCPEDITOR_API FBlueprintBatchCompile
+{
+public:
+    static TSharedPtr<FJsonObject> CompileMany(const TSharedPtr<FJsonObject>& Params);
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/WeakObjectPtr.h"
+
+class FJsonObject;
+class UBlueprint;
+
+/**
+ * Blueprint compiles requested by MCP edits, coalesced. An edit (a component, a widget, a binding)
+ * marks its blueprint pending instead of compiling it; pending blueprints compile once, after
+ * BlueprintCompileDebounceMs without further requests and outside any bulk-edit scope, or at once
+ * when a batch or shared transaction ends, when compile_blueprint asks, or when a command needs the
+ * generated class (spawning, class defaults). Forty widgets added in a row compile once. With
+ * bDeferBlueprintCompiles there is no debounced compile; pending blueprints wait for one of the
+ * others, their edits having kept the skeleton class current.
+ *
+ * Every compile the queue runs is reported through OnCompiled (the blueprint.compiled event).
+ * Game thread only.
+ */
+class UNREALMCPEDITOR_API FBlueprintCompileQueue
+{
+public:
+    struct FReport
+    {
+        FString Path;
+        /** "up_to_date", "warnings" or "error". */
+        FString Status;
+        int32 NumErrors = 0;
+        int32 NumWarnings = 0;
+        /** Error and warning lines, errors first. */
+        TArray<FString> Messages;
+        bool bSaved = false;
+        /** Time the save took, when there was one. */
+        double SaveSeconds = 0.0;
+
+        TSharedRef<FJsonObject> ToJson() const;
+    };
+
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnCompiled, const FReport&);
+
+    static FBlueprintCompileQueue& Get();
+
+    /**
+     * Drops pending compiles. Their blueprints stay marked modified, so the editor still compiles
+     * them before they are saved or played.
+     */
+    void Stop();
+
+    /**
+     * Compiles Blueprint later, or now when the debounce is 0 and compiles are not deferred. bSave
+     * saves its package after the compile, so a deferred compile does not leave an uncompiled
+     * blueprint on disk.
+     */
+    void Request(UBlueprint* Blueprint, bool bSave = false);
+
+    /** Compiles Blueprint now, pending or not, and saves it if a pending request asked to. */
+    FReport Compile(UBlueprint* Blueprint);
+
+    /**
+     * Compiles Blueprints together through the engine's compilation manager, the way the editor
+     * recompiles after a hot reload: skeletons first, then each class in hierarchy order, and a
+     * dependent blueprint once for the whole set rather than once per blueprint it depends on.
+     * Pending requests for them are taken over, their save included; bSave saves all of them.
+     *
+     * The manager compiles in phases across the set, so there is no per-blueprint compile time,
+     * and each report's errors, warnings and messages are the ones left on its graph nodes.
+     */
+    TArray<FReport> CompileMany(const TArray<UBlueprint*>& Blueprints, bool bSave = false);
+
+    /**
+     * Regenerates only Blueprint's skeleton class, so pins and types of its new members resolve,
+     * without bytecode or reinstancing. Leaves a pending compile pending.
+     */
+    void RegenerateSkeleton(UBlueprint* Blueprint);
+
+    /** Compiles Blueprint now if it is pending; for commands that read its generated class. */
+    void Flush(UBlueprint* Blueprint);
+
+    /** Compiles every pending blueprint now, appending their reports to OutReports. */
+    void FlushAll(TArray<FReport>* OutReports = nullptr);
+
+    bool IsPending(const UBlueprint* Blueprint) const;
+
+    /**
+     * Flushes everything pending and sets Result's "compiled" to the reports, if there were any.
+     * For the commands that end a batch of edits (batch, transaction.commit, editor.bulk_end).
+     */
+    void FlushInto(FJsonObject& Result);
+
+    FOnCompiled& OnCompiled() { return CompiledDelegate; }
+
+private:
+    struct FPending
+    {
+        TWeakObjectPtr<UBlueprint> Blueprint;
+        bool bSave = false;
+    };
+
+    FReport CompileNow(UBlueprint* Blueprint, bool bSave, bool bSkipGarbageCollection = false);
+    /** Takes Blueprint's pending request off the queue, returning whether it asked for a save. */
+    bool TakePending(const UBlueprint* Blueprint);
+    bool Tick(float DeltaTime);
+
+    TArray<FPending> Pending;
+    double LastRequestSeconds = 0.0;
+    FTSTicker::FDelegateHandle TickerHandle;
+    FOnCompiled CompiledDelegate;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UEdGraph;
+class UEdGraphNode;
+class UK2Node_Event;
+
+/**
+ * Lookups into blueprint graphs for the node commands: nodes by GUID, event nodes by event name and
+ * pins by (node, name, direction). Each graph is indexed on its first lookup and marked stale by its
+ * graph-changed notification (nodes added or removed, undo), then rebuilt on the next lookup, so a
+ * run of connect_blueprint_nodes on a large graph is a hash lookup per endpoint instead of a walk
+ * over every node and pin.
+ *
+ * Pins are cached as they are asked for and checked against their node on every hit, since node
+ * reconstruction reallocates them without notifying the graph. Graphs are held weakly. Game thread
+ * only.
+ */
+class FBlueprintGraphIndex
+{
+public:
+    static FBlueprintGraphIndex& Get();
+
+    /** Unbinds the graph delegates and drops every index (game thread). */
+    void Stop();
+
+    UEdGraphNode* FindNode(UEdGraph* Graph, const FGuid& NodeGuid);
+
+    /** Node with the GUID NodeId spells ("A1B2..." or hyphenated); null if none or not a GUID. */
+    UEdGraphNode* FindNode(UEdGraph* Graph, const FString& NodeId);
+
+    /** First event node for EventName, in graph order. */
+    UK2Node_Event* FindEventNode(UEdGraph* Graph, FName EventName);
+
+    /** Every event node for EventName, in graph order. */
+    TArray<UK2Node_Event*> FindEventNodes(UEdGraph* Graph, FName EventName);
+
+    /** Pin of Node named PinName (case-insensitive); EGPD_MAX matches either direction. */
+    UEdGraphPin* FindPin(UEdGraphNode* Node, FName PinName, EEdGraphPinDirection Direction);
+
+    /** Marks Graph's index stale; for edits that bypass the graph's notifications. */
+    void Invalidate(UEdGraph* Graph);
+
+private:
+    struct FGraphEntry
+    {
+        TWeakObjectPtr<UEdGraph> Graph;
+        FDelegateHandle ChangedHandle;
+        bool bStale = true;
+        /** Graph->Nodes.Num() at the last build; catches nodes added without a notification. */
+        int32 NumIndexedNodes = 0;
+        TMap<FGuid, TWeakObjectPtr<UEdGraphNode>> NodesByGuid;
+        TMap<FName, TArray<TWeakObjectPtr<UK2Node_Event>>> EventsByName;
+    };
+
+    struct FPinKey
+    {
+        TObjectKey<UEdGraphNode> Node;
+        FName PinName;
+        EEdGraphPinDirection Direction = EGPD_MAX;
+
+        bool operator==(const FPinKey& Other) const { return Node == Other.Node && PinName == Other.PinName && Direction == Other.Direction; }
+        friend uint32 GetTypeHash(const FPinKey& Key) { return HashCombine(HashCombine(GetTypeHash(Key.Node), GetTypeHash(Key.PinName)), GetTypeHash(static_cast<uint8>(Key.Direction))); }
+    };
+
+    /** Pins kept before the pin cache starts over. */
+    static constexpr int32 MaxPins = 16384;
+
+    /** Graph's entry, built or rebuilt if stale; null for a null graph. */
+    FGraphEntry* GetEntry(UEdGraph* Graph);
+    void Build(UEdGraph* Graph, FGraphEntry& Entry);
+
+    TMap<TObjectKey<UEdGraph>, FGraphEntry> Graphs;
+    TMap<FPinKey, UEdGraphPin*> Pins;
+};
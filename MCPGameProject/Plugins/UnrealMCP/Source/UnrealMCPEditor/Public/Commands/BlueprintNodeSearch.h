@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Project-wide blueprint node search (blueprint.find_nodes): the call sites of a function, the
+ * uses of a variable, the handlers of an event or the nodes of a class, across every blueprint.
+ *
+ * Answers come from the editor's Find-in-Blueprints index, which is read from the searchable data
+ * each blueprint stores in its asset registry tags when saved and kept current as blueprints are
+ * added, edited, renamed or removed, so no blueprint is loaded to answer. Blueprints saved by an
+ * engine too old to store that data are not covered until they are resaved; the response counts
+ * them in "unindexed".
+ */
+class UNREALMCPEDITOR_API FBlueprintNodeSearch
+{
+public:
+    static TSharedPtr<FJsonObject> FindNodes(const TSharedPtr<FJsonObject>& Params);
+};
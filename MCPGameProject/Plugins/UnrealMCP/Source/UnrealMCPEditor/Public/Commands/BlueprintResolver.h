@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/WeakObjectPtr.h"
+
+struct FAssetData;
+class UBlueprint;
+
+/**
+ * Resolves the blueprint names that blueprint and node commands take. A name may be a short asset
+ * name ("BP_Door"), looked up in an index of every Blueprint asset in the asset registry so the
+ * blueprint can live in any folder, or a package or object path ("/Game/Doors/BP_Door").
+ *
+ * Resolved blueprints are kept weakly by the name they were asked for, so a graph-building session
+ * sending hundreds of commands to one blueprint resolves it once. The index follows the registry's
+ * add, remove and rename delegates; renames and removals also drop the resolved blueprints, since a
+ * name may then mean another asset. Game thread only.
+ */
+class FBlueprintResolver
+{
+public:
+    static FBlueprintResolver& Get();
+
+    /** Binds the registry delegates (game thread). */
+    void Start();
+
+    /** Unbinds them and drops the index and the resolved blueprints. */
+    void Stop();
+
+    /** The blueprint NameOrPath names, loading it if needed; null if there is none. */
+    UBlueprint* Find(const FString& NameOrPath);
+
+    /** Builds the name index now rather than on the first Find (editor.warmup); false until the registry scan is done. */
+    bool Prewarm();
+
+    void Invalidate();
+
+private:
+    /** Builds the name index once the registry's initial scan is done. False until then. */
+    bool EnsureIndex();
+    void IndexAsset(const FAssetData& AssetData);
+    void UnindexAsset(FName AssetName, const FSoftObjectPath& ObjectPath);
+
+    /** Object path NameOrPath resolves to, or an empty path. */
+    FSoftObjectPath ResolvePath(const FString& NameOrPath);
+
+    /** Object paths of the Blueprint assets (of any Blueprint class) with each asset name. */
+    TMap<FName, TArray<FSoftObjectPath>> PathsByName;
+    bool bIndexBuilt = false;
+
+    /** Keyed by the name as asked for; FString keys compare without case. */
+    TMap<FString, TWeakObjectPtr<UBlueprint>> Resolved;
+
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+};
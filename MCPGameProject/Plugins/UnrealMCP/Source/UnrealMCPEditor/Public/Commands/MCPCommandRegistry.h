@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Protocol/CommandScheduler.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+
+class FJsonObject;
+class FParamSchema;
+struct FMutationSchema;
+
+/** Whether a command changes editor or content state, and so goes through the write gate. */
+enum class EMCPCommandMutation : uint8
+{
+    ReadOnly,
+    Mutating,
+    /** Decided per call by FWriteGate::IsMutationCommand (e.g. camera.bookmark only writes for op=set with persist). */
+    ByParams
+};
+
+/** Where the write gate looks for the content path a mutation touches. */
+enum class EMCPPathRule : uint8
+{
+    /** No content path; the gate treats the command as an editor-only mutation. */
+    None,
+    /** The path keys (and level fallback) of the command's FMutationSchema. */
+    FromParams
+};
+
+/** Thread a command's handler must run on. */
+enum class EMCPThreadAffinity : uint8
+{
+    GameThread,
+    AnyThread
+};
+
+/** Everything the bridge needs to gate and run one command, looked up once per request. */
+struct UNREALMCPEDITOR_API FMCPCommandDescriptor
+{
+    typedef TFunction<TSharedPtr<FJsonObject>(const TSharedPtr<FJsonObject>&)> FHandler;
+
+    FString Name;
+    FHandler Handler;
+    EMCPCommandMutation Mutation = EMCPCommandMutation::ReadOnly;
+    EMCPPathRule PathRule = EMCPPathRule::None;
+    EMCPThreadAffinity Affinity = EMCPThreadAffinity::GameThread;
+    /** Scheduler lane for game-thread commands; a request's meta.priority overrides it. */
+    UnrealMCP::Protocol::ECommandPriority Priority = UnrealMCP::Protocol::ECommandPriority::Interactive;
+    /** Mutations check out their target package first; sc.* commands drive source control themselves. */
+    bool bRequiresCheckout = true;
+    /** Read-only and answerable from FResponseCache: the result depends only on params and editor state. */
+    bool bCacheable = false;
+    /** Where the write gate finds the target path and how it plans the audit; null if none is declared. */
+    const FMutationSchema* MutationSchema = nullptr;
+    /** Checked on the connection thread before the command is queued; null accepts any params. */
+    TSharedPtr<const FParamSchema> ParamSchema;
+    /** Index of the module family declared with FMCPCommandRegistry::RequireModules; INDEX_NONE if none. */
+    int32 ModuleFamily = INDEX_NONE;
+
+    bool IsMutation(const TSharedPtr<FJsonObject>& Params) const;
+};
+
+/**
+ * Command name -> descriptor table the bridge dispatches through. Handler classes add their
+ * commands once at startup, so dispatch is a single hash lookup however many tools exist.
+ */
+class UNREALMCPEDITOR_API FMCPCommandRegistry
+{
+public:
+    /**
+     * Adds (or replaces) Name. Mutation and path rule default from FWriteGate's mutating-command
+     * list and the schema from FWriteGate::FindMutationSchema; the returned descriptor may be
+     * adjusted before the next Register call.
+     */
+    FMCPCommandDescriptor& Register(const FString& Name, FMCPCommandDescriptor::FHandler Handler);
+
+    /** Exact (case-sensitive) lookup; null for unknown commands. */
+    const FMCPCommandDescriptor* Find(const FString& Name) const;
+
+    /**
+     * Compiles the "tools" map of a parameter schema file (Resources/ParamSchemas.json) onto the
+     * commands registered so far. Call after every Register; returns the number of schemas applied.
+     * Schemas for unknown commands, or that fail to compile, are logged and skipped.
+     */
+    int32 LoadParamSchemas(const FString& Filename);
+
+    /**
+     * Declares the engine or plugin modules that the commands registered so far under Prefix need
+     * (Niagara for "niagara.", ...). They are loaded before the first of those commands runs instead
+     * of at editor startup; a command registered with the prefix later is not covered.
+     */
+    void RequireModules(const FString& Prefix, TArray<FName> ModuleNames);
+
+    /** Loads the modules of Command's family on its first use; later calls return at once. Game thread only. */
+    void LoadModulesFor(const FMCPCommandDescriptor& Command);
+
+    /**
+     * Loads now the modules of every family ShouldLoad accepts the prefix of, for a warm-up that
+     * spares the first command of each family the wait. Appends the prefixes this call loaded.
+     * Game thread only.
+     */
+    void LoadModuleFamilies(TFunctionRef<bool(const FString& Prefix)> ShouldLoad, TArray<FString>& OutLoaded);
+
+    int32 Num() const { return Commands.Num(); }
+
+private:
+    struct FModuleFamily
+    {
+        FString Prefix;
+        TArray<FName> ModuleNames;
+        bool bLoaded = false;
+    };
+
+    void LoadFamily(FModuleFamily& Family);
+
+    TMap<FName, FMCPCommandDescriptor> Commands;
+    TArray<FModuleFamily> ModuleFamilies;
+};
@@ -0,0 +1,369 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/Optional.h"
+#include "Templates/Function.h"
+
+template <typename TParams> class TMCPParamBinding;
+
+/**
+ * How one member type is read from a JSON value. Leaf types set OutError to "<path> must be <what>";
+ * numbers also accept numeric strings, as the handlers' own parsers do. Any other type is taken to
+ * be a struct with a static Bind and is read as a nested object.
+ */
+template <typename T>
+struct TMCPParamType
+{
+    static bool Read(const FJsonValue& Value, T& Out, const FString& Path, FString& OutError)
+    {
+        return TMCPParamBinding<T>::DecodeValue(Value, Out, Path, OutError);
+    }
+};
+
+namespace UnrealMCP
+{
+namespace Params
+{
+    inline bool Fail(const FString& Path, const TCHAR* Expected, FString& OutError)
+    {
+        OutError = FString::Printf(TEXT("%s must be %s"), *Path, Expected);
+        return false;
+    }
+
+    inline bool ReadNumber(const FJsonValue& Value, double& Out)
+    {
+        if (Value.Type == EJson::Number)
+        {
+            Out = Value.AsNumber();
+            return true;
+        }
+        return Value.Type == EJson::String && LexTryParseString(Out, *Value.AsString());
+    }
+
+    inline bool ReadTriple(const FJsonValue& Value, double (&Out)[3])
+    {
+        if (Value.Type != EJson::Array)
+        {
+            return false;
+        }
+        const TArray<TSharedPtr<FJsonValue>>& Items = Value.AsArray();
+        if (Items.Num() != 3)
+        {
+            return false;
+        }
+        for (int32 Index = 0; Index < 3; ++Index)
+        {
+            if (!Items[Index].IsValid() || !ReadNumber(*Items[Index], Out[Index]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename TInt>
+    bool ReadInteger(const FJsonValue& Value, TInt& Out, const FString& Path, FString& OutError)
+    {
+        double Number = 0.0;
+        if (!ReadNumber(Value, Number) || !FMath::IsFinite(Number)
+            || Number < static_cast<double>(TNumericLimits<TInt>::Min()) || Number > static_cast<double>(TNumericLimits<TInt>::Max()))
+        {
+            return Fail(Path, TEXT("an integer"), OutError);
+        }
+        Out = static_cast<TInt>(FMath::RoundHalfFromZero(Number));
+        return true;
+    }
+}
+}
+
+template <>
+struct TMCPParamType<FString>
+{
+    static bool Read(const FJsonValue& Value, FString& Out, const FString& Path, FString& OutError)
+    {
+        return Value.TryGetString(Out) || UnrealMCP::Params::Fail(Path, TEXT("a string"), OutError);
+    }
+};
+
+template <>
+struct TMCPParamType<FName>
+{
+    static bool Read(const FJsonValue& Value, FName& Out, const FString& Path, FString& OutError)
+    {
+        if (Value.Type != EJson::String)
+        {
+            return UnrealMCP::Params::Fail(Path, TEXT("a string"), OutError);
+        }
+        Out = FName(*Value.AsString());
+        return true;
+    }
+};
+
+template <>
+struct TMCPParamType<bool>
+{
+    static bool Read(const FJsonValue& Value, bool& Out, const FString& Path, FString& OutError)
+    {
+        return Value.TryGetBool(Out) || UnrealMCP::Params::Fail(Path, TEXT("a boolean"), OutError);
+    }
+};
+
+template <>
+struct TMCPParamType<double>
+{
+    static bool Read(const FJsonValue& Value, double& Out, const FString& Path, FString& OutError)
+    {
+        return UnrealMCP::Params::ReadNumber(Value, Out) || UnrealMCP::Params::Fail(Path, TEXT("a number"), OutError);
+    }
+};
+
+template <>
+struct TMCPParamType<float>
+{
+    static bool Read(const FJsonValue& Value, float& Out, const FString& Path, FString& OutError)
+    {
+        double Number = 0.0;
+        if (!UnrealMCP::Params::ReadNumber(Value, Number))
+        {
+            return UnrealMCP::Params::Fail(Path, TEXT("a number"), OutError);
+        }
+        Out = static_cast<float>(Number);
+        return true;
+    }
+};
+
+template <>
+struct TMCPParamType<int32>
+{
+    static bool Read(const FJsonValue& Value, int32& Out, const FString& Path, FString& OutError)
+    {
+        return UnrealMCP::Params::ReadInteger(Value, Out, Path, OutError);
+    }
+};
+
+template <>
+struct TMCPParamType<int64>
+{
+    static bool Read(const FJsonValue& Value, int64& Out, const FString& Path, FString& OutError)
+    {
+        return UnrealMCP::Params::ReadInteger(Value, Out, Path, OutError);
+    }
+};
+
+/** [x, y, z]. */
+template <>
+struct TMCPParamType<FVector>
+{
+    static bool Read(const FJsonValue& Value, FVector& Out, const FString& Path, FString& OutError)
+    {
+        double Components[3];
+        if (!UnrealMCP::Params::ReadTriple(Value, Components))
+        {
+            return UnrealMCP::Params::Fail(Path, TEXT("an array of three numbers"), OutError);
+        }
+        Out = FVector(Components[0], Components[1], Components[2]);
+        return true;
+    }
+};
+
+/** [pitch, yaw, roll]. */
+template <>
+struct TMCPParamType<FRotator>
+{
+    static bool Read(const FJsonValue& Value, FRotator& Out, const FString& Path, FString& OutError)
+    {
+        double Components[3];
+        if (!UnrealMCP::Params::ReadTriple(Value, Components))
+        {
+            return UnrealMCP::Params::Fail(Path, TEXT("an array of three numbers"), OutError);
+        }
+        Out = FRotator(Components[0], Components[1], Components[2]);
+        return true;
+    }
+};
+
+template <>
+struct TMCPParamType<TArray<FString>>
+{
+    static bool Read(const FJsonValue& Value, TArray<FString>& Out, const FString& Path, FString& OutError)
+    {
+        if (Value.Type != EJson::Array)
+        {
+            return UnrealMCP::Params::Fail(Path, TEXT("an array of strings"), OutError);
+        }
+        const TArray<TSharedPtr<FJsonValue>>& Items = Value.AsArray();
+        Out.Reset(Items.Num());
+        for (const TSharedPtr<FJsonValue>& Item : Items)
+        {
+            if (!Item.IsValid() || Item->Type != EJson::String)
+            {
+                return UnrealMCP::Params::Fail(Path, TEXT("an array of strings"), OutError);
+            }
+            Out.Add(Item->AsString());
+        }
+        return true;
+    }
+};
+
+/** Left as JSON, for the parts of a command that are free-form. */
+template <>
+struct TMCPParamType<TSharedPtr<FJsonObject>>
+{
+    static bool Read(const FJsonValue& Value, TSharedPtr<FJsonObject>& Out, const FString& Path, FString& OutError)
+    {
+        if (Value.Type != EJson::Object)
+        {
+            return UnrealMCP::Params::Fail(Path, TEXT("an object"), OutError);
+        }
+        Out = Value.AsObject();
+        return true;
+    }
+};
+
+/** Unset while the key is absent, so a handler can tell "not given" from a default. */
+template <typename T>
+struct TMCPParamType<TOptional<T>>
+{
+    static bool Read(const FJsonValue& Value, TOptional<T>& Out, const FString& Path, FString& OutError)
+    {
+        T Decoded{};
+        if (!TMCPParamType<T>::Read(Value, Decoded, Path, OutError))
+        {
+            return false;
+        }
+        Out = MoveTemp(Decoded);
+        return true;
+    }
+};
+
+/**
+ * Typed parameters for a command. The handler declares a struct and, in its static
+ * Bind(TMCPParamBinding<T>&), which key fills which member:
+ *
+ *     struct FMoveParams
+ *     {
+ *         FString Actor;
+ *         TOptional<FVector> Location;
+ *
+ *         static void Bind(TMCPParamBinding<FMoveParams>& Binding)
+ *         {
+ *             Binding.Required(TEXT("actor"), &FMoveParams::Actor);
+ *             Binding.Optional(TEXT("location"), &FMoveParams::Location);
+ *         }
+ *     };
+ *
+ * Decode then walks the params object once, converting each bound key into its member, instead of a
+ * string-keyed lookup and a conversion per access; the first wrong type or missing required key comes
+ * back as one message ("set.location must be an array of three numbers", "Missing actor parameter").
+ * Keys match case-insensitively, like FJsonObject lookups. Unbound keys are ignored and null counts
+ * as absent. Ranges, enums and sizes stay in ParamSchemas.json, which runs before the handler.
+ */
+template <typename TParams>
+class TMCPParamBinding
+{
+public:
+    template <typename T>
+    TMCPParamBinding& Required(const TCHAR* Key, T TParams::* Member)
+    {
+        return Add(Key, Member, true);
+    }
+
+    /** The member keeps its initializer when the key is absent. */
+    template <typename T>
+    TMCPParamBinding& Optional(const TCHAR* Key, T TParams::* Member)
+    {
+        return Add(Key, Member, false);
+    }
+
+    /** Decodes Params (null reads as an empty object) into Out; false with OutError on the first bad key. */
+    static bool Decode(const TSharedPtr<FJsonObject>& Params, TParams& Out, FString& OutError)
+    {
+        static const FJsonObject Empty;
+        return Get().DecodeObject(Params.IsValid() ? *Params : Empty, FString(), Out, OutError);
+    }
+
+    /** Nested form: Value must be an object; errors are reported under Path. */
+    static bool DecodeValue(const FJsonValue& Value, TParams& Out, const FString& Path, FString& OutError)
+    {
+        if (Value.Type != EJson::Object || !Value.AsObject().IsValid())
+        {
+            return UnrealMCP::Params::Fail(Path, TEXT("an object"), OutError);
+        }
+        return Get().DecodeObject(*Value.AsObject(), Path + TEXT("."), Out, OutError);
+    }
+
+private:
+    typedef TFunction<bool(TParams&, const FJsonValue&, const FString&, FString&)> FReader;
+
+    struct FField
+    {
+        FString Key;
+        bool bRequired = false;
+        FReader Read;
+    };
+
+    TArray<FField> Fields;
+
+    /** Built on first use; Bind only describes the struct, so the table never changes afterwards. */
+    static const TMCPParamBinding& Get()
+    {
+        static const TMCPParamBinding Binding = []()
+        {
+            TMCPParamBinding Built;
+            TParams::Bind(Built);
+            check(Built.Fields.Num() <= 64);
+            return Built;
+        }();
+        return Binding;
+    }
+
+    template <typename T>
+    TMCPParamBinding& Add(const TCHAR* Key, T TParams::* Member, bool bRequired)
+    {
+        FField& Field = Fields.AddDefaulted_GetRef();
+        Field.Key = Key;
+        Field.bRequired = bRequired;
+        Field.Read = [Member](TParams& Out, const FJsonValue& Value, const FString& Path, FString& OutError)
+        {
+            return TMCPParamType<T>::Read(Value, Out.*Member, Path, OutError);
+        };
+        return *this;
+    }
+
+    bool DecodeObject(const FJsonObject& Object, const FString& Prefix, TParams& Out, FString& OutError) const
+    {
+        uint64 Seen = 0;
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object.Values)
+        {
+            if (!Pair.Value.IsValid() || Pair.Value->IsNull())
+            {
+                continue;
+            }
+            for (int32 Index = 0; Index < Fields.Num(); ++Index)
+            {
+                const FField& Field = Fields[Index];
+                if (Field.Key.Equals(Pair.Key, ESearchCase::IgnoreCase))
+                {
+                    if (!Field.Read(Out, *Pair.Value, Prefix + Field.Key, OutError))
+                    {
+                        return false;
+                    }
+                    Seen |= uint64(1) << Index;
+                    break;
+                }
+            }
+        }
+
+        for (int32 Index = 0; Index < Fields.Num(); ++Index)
+        {
+            if (Fields[Index].bRequired && (Seen & (uint64(1) << Index)) == 0)
+            {
+                OutError = FString::Printf(TEXT("Missing %s%s parameter"), *Prefix, *Fields[Index].Key);
+                return false;
+            }
+        }
+        return true;
+    }
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+
+class FJsonObject;
+class FJsonValue;
+
+/**
+ * A command's parameter schema, compiled once from the JSON Schema subset in
+ * Resources/ParamSchemas.json (shared with the MCP server's security/schema_registry.py): type
+ * (one name or a list), properties, required, additionalProperties (a boolean), items, enum,
+ * minimum/maximum, minLength/maxLength and minItems/maxItems. Other keywords are ignored, so
+ * nothing a full validator accepts is rejected here.
+ *
+ * Compiled schemas are immutable, so requests are checked on the connection thread that read them
+ * and a malformed request is answered without ever queueing for the game thread.
+ */
+class UNREALMCPEDITOR_API FParamSchema
+{
+public:
+    /** Null with OutError when Schema uses a keyword wrongly (e.g. an unknown type name). */
+    static TSharedPtr<const FParamSchema> Compile(const FJsonObject& Schema, FString& OutError);
+
+    /**
+     * True when Params conforms; missing params count as an empty object. Otherwise OutPath names
+     * the first offending value ("files[3]", "" for the params themselves) and OutReason says why.
+     */
+    bool Validate(const TSharedPtr<FJsonObject>& Params, FString& OutPath, FString& OutReason) const;
+
+private:
+    enum EType : uint8
+    {
+        Null = 1 << 0,
+        Boolean = 1 << 1,
+        Integer = 1 << 2,
+        Number = 1 << 3,
+        String = 1 << 4,
+        Array = 1 << 5,
+        Object = 1 << 6,
+        Any = 0x7f
+    };
+
+    /** One (sub)schema; children are indices into Nodes. */
+    struct FNode
+    {
+        uint8 Types = Any;
+        TArray<TPair<FString, int32>> Properties;
+        TArray<FString> Required;
+        bool bAdditionalProperties = true;
+        int32 Items = INDEX_NONE;
+        TArray<TSharedPtr<FJsonValue>> Enum;
+        TOptional<double> Minimum;
+        TOptional<double> Maximum;
+        int32 MinLength = 0;
+        int32 MaxLength = MAX_int32;
+        int32 MinItems = 0;
+        int32 MaxItems = MAX_int32;
+    };
+
+    int32 CompileNode(const FJsonObject& Schema, const FString& Path, FString& OutError);
+    bool ValidateNode(int32 NodeIndex, const FJsonValue& Value, const FString& Path, FString& OutPath, FString& OutReason) const;
+    bool ValidateObject(const FNode& Node, const FJsonObject& Object, const FString& Path, FString& OutPath, FString& OutReason) const;
+
+    /** Nodes[0] is the root. */
+    TArray<FNode> Nodes;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class FJsonValue;
+
+/**
+ * Property paths compiled once per (class, path) for the property get/set commands. A path names a
+ * property of the class, optionally followed by fields of nested structs ("RelativeLocation.X",
+ * "BodyInstance.MassScale"); the compiled form keeps the property chain, the leaf's offset from
+ * the object and a setter/getter picked for the leaf's type, so a repeated edit is a hash lookup
+ * and a typed write instead of a name search and a chain of type checks.
+ *
+ * Entries hold their class weakly and are dropped when it goes away; everything is dropped when
+ * classes can change layout under the same object (hot reload, Blueprint compiles, reinstancing).
+ * Game thread only.
+ */
+class FPropertyPathCache
+{
+public:
+    struct FCompiledPath;
+
+    typedef bool (*FSetter)(const FCompiledPath& Path, void* ValuePtr, const TSharedPtr<FJsonValue>& Value, FString& OutError);
+    typedef TSharedPtr<FJsonValue> (*FGetter)(const FCompiledPath& Path, const void* ValuePtr);
+
+    struct FCompiledPath
+    {
+        TWeakObjectPtr<const UClass> Class;
+        /** From the class's property to the leaf; every link before the leaf is a struct property. */
+        TArray<const FProperty*, TInlineAllocator<4>> Chain;
+        const FProperty* Leaf = nullptr;
+        /** Offset of the leaf value from the start of the object. */
+        int32 Offset = 0;
+        FSetter Setter = nullptr;
+        FGetter Getter = nullptr;
+
+        void* GetValuePtr(UObject* Object) const { return reinterpret_cast<uint8*>(Object) + Offset; }
+        const void* GetValuePtr(const UObject* Object) const { return reinterpret_cast<const uint8*>(Object) + Offset; }
+
+        /** Writes Value into Object's leaf. False with OutError when the value does not fit the type. */
+        bool SetValue(UObject* Object, const TSharedPtr<FJsonValue>& Value, FString& OutError) const
+        {
+            return Setter(*this, GetValuePtr(Object), Value, OutError);
+        }
+
+        TSharedPtr<FJsonValue> GetValue(const UObject* Object) const
+        {
+            return Getter(*this, GetValuePtr(Object));
+        }
+    };
+
+    /** Compiled paths kept before the cache starts over. */
+    static constexpr int32 MaxEntries = 4096;
+
+    static FPropertyPathCache& Get();
+
+    /** Binds the reload and reinstancing delegates (game thread). */
+    void Start();
+
+    /** Unbinds them and drops every entry (game thread). */
+    void Stop();
+
+    /** Compiled Path on Class, or null with OutError ("Property not found: ..."). */
+    const FCompiledPath* Resolve(const UClass* Class, const FString& Path, FString& OutError);
+
+    void Invalidate();
+
+private:
+    struct FKey
+    {
+        const UClass* Class = nullptr;
+        FString Path;
+
+        bool operator==(const FKey& Other) const { return Class == Other.Class && Path.Equals(Other.Path, ESearchCase::IgnoreCase); }
+        friend uint32 GetTypeHash(const FKey& Key) { return HashCombine(PointerHash(Key.Class), GetTypeHash(Key.Path)); }
+    };
+
+    static bool Compile(const UClass* Class, const FString& Path, FCompiledPath& OutPath, FString& OutError);
+
+    TMap<FKey, TUniquePtr<FCompiledPath>> Entries;
+    FDelegateHandle ReloadHandle;
+    FDelegateHandle ReinstancedHandle;
+    FDelegateHandle BlueprintCompiledHandle;
+};
@@ -4,6 +4,8 @@
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 
+class FMCPCommandRegistry;
+
 /**
  * Handler class for Blueprint-related MCP commands
  */
@@ -15,6 +17,9 @@ public:
     // Handle blueprint commands
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Adds this handler's commands to Registry; the registered handlers call back into this instance. */
+    void RegisterCommands(FMCPCommandRegistry& Registry);
+
 private:
     // Specific blueprint command handlers
     TSharedPtr<FJsonObject> HandleCreateBlueprint(const TSharedPtr<FJsonObject>& Params);
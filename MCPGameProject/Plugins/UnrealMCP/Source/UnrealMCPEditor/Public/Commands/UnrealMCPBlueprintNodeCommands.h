@@ -4,6 +4,12 @@
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 
+class FMCPCommandRegistry;
+class UBlueprint;
+class UEdGraph;
+class UK2Node_CallFunction;
+class UK2Node_VariableGet;
+
 /**
  * Handler class for Blueprint Node-related MCP commands
  */
@@ -15,6 +21,9 @@ public:
     // Handle blueprint node commands
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Adds this handler's commands to Registry; the registered handlers call back into this instance. */
+    void RegisterCommands(FMCPCommandRegistry& Registry);
+
 private:
     // Specific blueprint node command handlers
     TSharedPtr<FJsonObject> HandleConnectBlueprintNodes(const TSharedPtr<FJsonObject>& Params);
@@ -25,4 +34,9 @@ private:
     TSharedPtr<FJsonObject> HandleAddBlueprintInputActionNode(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleAddBlueprintSelfReference(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleFindBlueprintNodes(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleGraphPatch(const TSharedPtr<FJsonObject>& Params);
+
+    // Node builders shared by the single-node commands and blueprint.graph_patch
+    static UK2Node_CallFunction* AddFunctionCallNode(UBlueprint* Blueprint, UEdGraph* EventGraph, const TSharedPtr<FJsonObject>& Params, FString& OutError);
+    static UK2Node_VariableGet* AddComponentReferenceNode(UEdGraph* EventGraph, const FString& ComponentName, const FVector2D& NodePosition);
 }; 
\ No newline at end of file
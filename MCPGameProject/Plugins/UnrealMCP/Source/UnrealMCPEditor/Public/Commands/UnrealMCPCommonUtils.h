@@ -54,7 +54,9 @@ public:
     static UEdGraphPin* FindPin(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction = EGPD_MAX);
     static UK2Node_Event* FindExistingEventNode(UEdGraph* Graph, const FString& EventName);
 
-    // Property utilities
+    // Property utilities; PropertyName may name a nested struct field ("RelativeLocation.X")
     static bool SetObjectProperty(UObject* Object, const FString& PropertyName, 
                                  const TSharedPtr<FJsonValue>& Value, FString& OutErrorMessage);
+    static bool GetObjectProperty(const UObject* Object, const FString& PropertyName,
+                                 TSharedPtr<FJsonValue>& OutValue, FString& OutErrorMessage);
 }; 
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 
+class FMCPCommandRegistry;
+
 /**
  * Handler class for Editor-related MCP commands
  * Handles viewport control, actor manipulation, and level management
@@ -16,6 +18,9 @@ public:
     // Handle editor commands
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Adds this handler's commands to Registry; the registered handlers call back into this instance. */
+    void RegisterCommands(FMCPCommandRegistry& Registry);
+
 private:
     // Actor manipulation commands
     TSharedPtr<FJsonObject> HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params);
@@ -4,6 +4,8 @@
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 
+class FMCPCommandRegistry;
+
 /**
  * Handler class for Project-wide MCP commands
  */
@@ -15,6 +17,9 @@ public:
     // Handle project commands
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Adds this handler's commands to Registry; the registered handlers call back into this instance. */
+    void RegisterCommands(FMCPCommandRegistry& Registry);
+
 private:
     // Specific project command handlers
     TSharedPtr<FJsonObject> HandleCreateInputMapping(const TSharedPtr<FJsonObject>& Params);
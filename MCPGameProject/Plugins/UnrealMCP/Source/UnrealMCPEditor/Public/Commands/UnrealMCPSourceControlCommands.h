@@ -3,6 +3,10 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
+#include "Protocol/CommandContext.h"
+#include "SourceControlService.h"
+
+class FMCPCommandRegistry;
 
 class UNREALMCPEDITOR_API FUnrealMCPSourceControlCommands
 {
@@ -11,6 +15,9 @@ public:
 
         TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+        /** Adds this handler's commands to Registry; the registered handlers call back into this instance. */
+        void RegisterCommands(FMCPCommandRegistry& Registry);
+
 private:
         TSharedPtr<FJsonObject> HandleStatus(const TSharedPtr<FJsonObject>& Params);
         TSharedPtr<FJsonObject> HandleCheckout(const TSharedPtr<FJsonObject>& Params);
@@ -18,6 +25,24 @@ private:
         TSharedPtr<FJsonObject> HandleRevert(const TSharedPtr<FJsonObject>& Params);
         TSharedPtr<FJsonObject> HandleSubmit(const TSharedPtr<FJsonObject>& Params);
 
+        /** A provider operation started on an earlier frame, waited on across frames. */
+        struct FPendingOperation : public UnrealMCP::Protocol::FCommandContext::FResumeState
+        {
+                explicit FPendingOperation(const FSourceControlService::FOperationResultRef& InResult) : Result(InResult) {}
+
+                FSourceControlService::FOperationResultRef Result;
+                bool bCancelRequested = false;
+        };
+
+        /**
+         * Starts Operation on the targets in Params, or picks up the one an earlier frame started,
+         * suspending the command until the provider is done. Runs synchronously inside a batch.
+         */
+        TSharedPtr<FJsonObject> RunOperation(FSourceControlService::EOperation Operation, const TSharedPtr<FJsonObject>& Params, const FString& Description);
+
+        /** 'files' plus the files of 'assets'. */
+        bool CollectTargetFiles(const TSharedPtr<FJsonObject>& Params, TArray<FString>& OutFiles, FString& OutError) const;
+
         bool ExtractTargets(const TSharedPtr<FJsonObject>& Params, TArray<FString>& OutFiles, TArray<FString>& OutAssets, FString& OutError) const;
         TArray<TSharedPtr<FJsonValue>> BuildPerFileResultArray(const TMap<FString, bool>& PerFileResult) const;
         TArray<TSharedPtr<FJsonValue>> BuildPerFileStatusArray(const TMap<FString, FString>& PerFileStatus) const;
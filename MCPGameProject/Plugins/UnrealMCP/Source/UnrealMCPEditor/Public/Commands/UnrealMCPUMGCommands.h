@@ -4,6 +4,11 @@
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 
+class FMCPCommandRegistry;
+class UK2Node_Event;
+class UWidget;
+class UWidgetBlueprint;
+
 /**
  * Handles UMG (Widget Blueprint) related MCP commands
  * Responsible for creating and modifying UMG Widget Blueprints,
@@ -22,6 +27,9 @@ public:
      */
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    /** Adds this handler's commands to Registry; the registered handlers call back into this instance. */
+    void RegisterCommands(FMCPCommandRegistry& Registry);
+
 private:
     /**
      * Create a new UMG Widget Blueprint
@@ -80,4 +88,22 @@ private:
      * @return JSON response with the binding details
      */
     TSharedPtr<FJsonObject> HandleSetTextBlockBinding(const TSharedPtr<FJsonObject>& Params);
+
+    /**
+     * Build a widget hierarchy in a Widget Blueprint in one pass (umg.build_tree)
+     * @param Params - Must include:
+     *                "blueprint_name" - Name or path of the target Widget Blueprint
+     *                "root" - Widget spec that becomes the root (with "replace" if the tree has one), or
+     *                "widgets" - Widget specs added under "parent" (default the root widget)
+     *                A spec has "type", "name", and optionally "text", "properties", "slot",
+     *                "is_variable", "events", "text_binding" and "children"
+     * @return JSON response with the created widgets, per-widget failures and the compile report
+     */
+    TSharedPtr<FJsonObject> HandleBuildWidgetTree(const TSharedPtr<FJsonObject>& Params);
+
+    /** The bound event node for Widget's EventName delegate, created if missing; makes Widget a variable. */
+    static UK2Node_Event* FindOrAddBoundEvent(UWidgetBlueprint* WidgetBlueprint, UWidget* Widget, const FString& EventName);
+
+    /** Adds the Text variable BindingName and its Get<BindingName> function, unless they exist. */
+    static void AddTextBinding(UWidgetBlueprint* WidgetBlueprint, const FString& BindingName);
 }; 
\ No newline at end of file
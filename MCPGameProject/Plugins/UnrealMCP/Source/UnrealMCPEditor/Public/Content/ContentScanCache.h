@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+#include <atomic>
+
+class IAssetRegistry;
+class UPackage;
+class FObjectPostSaveContext;
+struct FAssetData;
+
+/**
+ * content.scan's findings kept per package, so a repeated scan only re-examines packages that
+ * changed since the last one. Changes are picked up from the registry's add, remove, rename and
+ * update delegates and from package saves; a changed package also dirties the cached packages that
+ * depend on it or that it references, since their missing-dependency and orphan results hang on it.
+ *
+ * Every stored result carries the revision at which it last changed, which is what lets a scan
+ * answer with only the packages that changed since a token. Tokens name the cache epoch, so a token
+ * from before a reset (editor restart, end of the startup scan) is recognised as unusable.
+ *
+ * Game thread only, apart from the delegates, which may fire on any thread and only queue names.
+ */
+class FContentScanCache
+{
+public:
+        struct FMissingDependency
+        {
+                FString Referencer;
+                FName Needed;
+                FString Type;
+        };
+
+        struct FBrokenReference
+        {
+                FString Owner;
+                FString Prop;
+                FString SoftPath;
+        };
+
+        /** The findings for one package's assets, plus what decides when they go stale. */
+        struct FPackageScan
+        {
+                FName PackagePath;
+                int32 AssetCount = 0;
+                TArray<FString> Redirectors;
+                TArray<FMissingDependency> Missing;
+                TArray<FBrokenReference> Broken;
+                /** Unreferenced textures; only reported when the scan asks for them. */
+                TArray<FString> UnusedTextures;
+                TArray<FString> Orphans;
+
+                /** Hard and soft dependencies plus the packages named by soft-path tags. */
+                TArray<FName> Watched;
+                TArray<FName> Referencers;
+                uint64 Revision = 0;
+
+                bool HasSameFindings(const FPackageScan& Other) const;
+        };
+
+        static FContentScanCache& Get();
+
+        /** Binds the registry and package-save delegates (game thread). */
+        void Start();
+
+        /** Unbinds them and frees the cache. */
+        void Stop();
+
+        /** The token for the cache as it stands now. */
+        FString MakeToken() const;
+
+        /** The revision Token was issued at; false if it is malformed, from an earlier epoch or the cache is not started. */
+        bool ParseToken(const FString& Token, uint64& OutRevision) const;
+
+        /**
+         * Packages under Paths that have to be (re)computed before the cache can answer for them:
+         * those dirtied since their last scan and, the first time a folder is scanned, all of them.
+         * Without Start nothing keeps the cache current, so each call then starts from an empty one.
+         */
+        void CollectPending(IAssetRegistry& AssetRegistry, const TArray<FString>& Paths, bool bRecursive, TArray<FName>& OutPending);
+
+        /** Re-examines one package and stores the result, bumping its revision if the findings changed. */
+        void Recompute(IAssetRegistry& AssetRegistry, FName PackageName);
+
+        /** Records that everything under Paths is now in the cache, once its pending packages are done. */
+        void MarkCovered(const TArray<FString>& Paths, bool bRecursive);
+
+        /** Stored results under Paths changed after SinceRevision, in package name order. */
+        void GetChanged(const TArray<FString>& Paths, bool bRecursive, uint64 SinceRevision, TArray<TPair<FName, const FPackageScan*>>& OutScans) const;
+
+        /** Packages under Paths that disappeared after SinceRevision. */
+        void GetRemoved(const TArray<FString>& Paths, bool bRecursive, uint64 SinceRevision, TArray<FName>& OutPackages) const;
+
+private:
+        struct FCoveredRoot
+        {
+                FString Path;
+                bool bRecursive = true;
+        };
+
+        struct FRemovedPackage
+        {
+                FName PackagePath;
+                uint64 Revision = 0;
+        };
+
+        void Reset();
+        void QueueChanged(FName PackageName);
+        void ExpandChanged(IAssetRegistry& AssetRegistry);
+        void AddToIndex(FName PackageName, const FPackageScan& Scan);
+        void RemoveFromIndex(FName PackageName, const FPackageScan& Scan);
+        bool IsCovered(const FString& Path, bool bRecursive) const;
+        static bool IsUnder(FName PackagePath, const TArray<FString>& Paths, bool bRecursive);
+
+        void HandleAssetChanged(const FAssetData& AssetData);
+        void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+        void HandlePackageSaved(const FString& Filename, UPackage* Package, FObjectPostSaveContext SaveContext);
+        void HandleFilesLoaded();
+
+        TMap<FName, FPackageScan> Scans;
+        TMap<FName, FRemovedPackage> Removed;
+        /** For each package, the cached packages watching it or listing it among their referencers. */
+        TMap<FName, TSet<FName>> Dependents;
+        TSet<FName> Dirty;
+        TArray<FCoveredRoot> Covered;
+
+        FGuid Epoch;
+        uint64 Revision = 0;
+        bool bStarted = false;
+        /** Set until the startup scan ends; the delegates ignore its flood of additions. */
+        std::atomic<bool> bRegistryLoading{ false };
+
+        /** Names queued by the delegates; expanded into Dirty on the game thread. */
+        FCriticalSection ChangedLock;
+        TSet<FName> Changed;
+
+        FDelegateHandle AssetAddedHandle;
+        FDelegateHandle AssetRemovedHandle;
+        FDelegateHandle AssetRenamedHandle;
+        FDelegateHandle AssetUpdatedHandle;
+        FDelegateHandle FilesLoadedHandle;
+        FDelegateHandle PackageSavedHandle;
+};
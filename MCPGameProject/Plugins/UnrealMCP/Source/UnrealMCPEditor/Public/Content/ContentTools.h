@@ -3,8 +3,19 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
+#include "IO/IoHash.h"
+#include "UObject/SoftObjectPath.h"
 
-/** High-level content hygiene helpers (scan/validate/fix/thumbnails). */
+class FMCPCommandRegistry;
+class IAssetRegistry;
+struct FAssetData;
+struct FCompiledValidationRules;
+
+/**
+ * High-level content hygiene helpers (scan/validate/fix/thumbnails). Validation rule sets can be
+ * registered once with content.register_rules and then referred to by id, so they are parsed and
+ * compiled once rather than on every content.validate.
+ */
 class UNREALMCPEDITOR_API FContentTools
 {
 public:
@@ -13,9 +24,13 @@ public:
         /** Routes a content.* command to the appropriate handler. */
         TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+        /** Adds this handler's commands to Registry; the registered handlers call back into this instance. */
+        void RegisterCommands(FMCPCommandRegistry& Registry);
+
 private:
         TSharedPtr<FJsonObject> HandleScan(const TSharedPtr<FJsonObject>& Params);
         TSharedPtr<FJsonObject> HandleValidate(const TSharedPtr<FJsonObject>& Params);
+        TSharedPtr<FJsonObject> HandleRegisterRules(const TSharedPtr<FJsonObject>& Params);
         TSharedPtr<FJsonObject> HandleFixMissing(const TSharedPtr<FJsonObject>& Params);
         TSharedPtr<FJsonObject> HandleGenerateThumbnails(const TSharedPtr<FJsonObject>& Params);
 
@@ -24,5 +39,20 @@ private:
         static bool CollectAssetPaths(const TSharedPtr<FJsonObject>& Params, TArray<FString>& OutAssets, FString& OutError);
         static FString NormalizeContentPath(const FString& InPath);
         static bool IsContentPathValid(const FString& Path);
+
+        /**
+         * A material instance's parameter names: from the object if it is already loaded, else from
+         * MaterialParameterCache while the package's saved hash is unchanged, else by loading it.
+         */
+        bool ReadMaterialParameterNames(IAssetRegistry& AssetRegistry, const FAssetData& AssetData, TArray<FName>& OutNames, bool& bOutLoaded, bool& bOutCacheHit);
+
+        struct FCachedMaterialParameters
+        {
+                FIoHash PackageSavedHash;
+                TArray<FName> Names;
+        };
+
+        TMap<FString, TSharedPtr<const FCompiledValidationRules>> RegisteredRules;
+        TMap<FSoftObjectPath, FCachedMaterialParameters> MaterialParameterCache;
 };
 
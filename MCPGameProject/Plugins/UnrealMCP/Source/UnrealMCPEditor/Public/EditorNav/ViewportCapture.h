@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+#include "Templates/SharedPointer.h"
+
+#include <atomic>
+
+class FRHIGPUTextureReadback;
+class FViewport;
+
+/**
+ * One viewport screenshot for take_screenshot, captured without stalling the editor. The viewport's
+ * last rendered frame (or a crop of it) is copied on the render thread into a GPU readback buffer.
+ * Poll() waits for the copy's fence on later frames, maps the buffer on the render thread, then
+ * converts, downscales and encodes on a worker; nothing on the game thread waits for the GPU.
+ * Viewports that render straight into the Slate back buffer have no texture to copy. Those, and
+ * callers that cannot wait across frames, use CaptureNow, which reads pixels synchronously.
+ */
+class FViewportCapture : public TSharedFromThis<FViewportCapture, ESPMode::ThreadSafe>
+{
+public:
+        enum class EFormat : uint8
+        {
+                Png,
+                Jpeg,
+                Bmp
+        };
+
+        struct FOptions
+        {
+                /** Region of the viewport to keep; empty keeps all of it. */
+                FIntRect Crop;
+                /** Downscales (keeping the aspect ratio) to fit; 0 leaves that axis unbounded. */
+                int32 MaxWidth = 0;
+                int32 MaxHeight = 0;
+                EFormat Format = EFormat::Png;
+                /** JPEG quality, 1-100; ignored by the lossless formats. */
+                int32 Quality = 85;
+                /** Written on the worker when set. */
+                FString FilePath;
+        };
+
+        struct FResult
+        {
+                bool bOk = false;
+                FString Error;
+                int32 Width = 0;
+                int32 Height = 0;
+                /** Size of the captured region before downscaling. */
+                int32 SourceWidth = 0;
+                int32 SourceHeight = 0;
+                TArray<uint8> Encoded;
+                bool bAsync = false;
+        };
+
+        /** "png", "jpeg"/"jpg" or "bmp". */
+        static bool ParseFormat(const FString& Name, EFormat& OutFormat);
+        static const TCHAR* GetMimeType(EFormat Format);
+        static const TCHAR* GetExtension(EFormat Format);
+
+        /** Starts a capture (game thread); null when the viewport has no render target to copy from. */
+        static TSharedPtr<FViewportCapture, ESPMode::ThreadSafe> Begin(FViewport& Viewport, const FOptions& Options);
+
+        /** Reads, encodes and writes in this call (game thread), flushing rendering as ReadPixels does. */
+        static void CaptureNow(FViewport& Viewport, const FOptions& Options, FResult& OutResult);
+
+        /**
+         * Downscales, encodes and writes BGRA8 Pixels per Options (any thread; the ImageWrapper module
+         * must already be loaded). Also used for stored asset thumbnails.
+         */
+        static void EncodeFrame(TArray<FColor>& Pixels, int32 Width, int32 Height, const FOptions& Options, FResult& OutResult);
+
+        /** Advances the capture (game thread); call each frame until IsDone. */
+        void Poll();
+
+        bool IsDone() const { return Stage.load() == EStage::Done; }
+
+        /** Valid once IsDone. */
+        const FResult& GetResult() const { return Result; }
+
+private:
+        enum class EStage : uint8
+        {
+                Copying,
+                InFlight,
+                Mapping,
+                Encoding,
+                Done
+        };
+
+        /** Raw texels to BGRA8; Bytes holds Width * Height texels of SourceFormat, tightly packed. */
+        static bool ConvertToColors(const TArray<uint8>& Bytes, EPixelFormat SourceFormat, int32 Width, int32 Height, TArray<FColor>& OutPixels);
+
+        void Fail(const FString& Error);
+
+        FOptions Options;
+        FResult Result;
+        TSharedPtr<FRHIGPUTextureReadback, ESPMode::ThreadSafe> Readback;
+        EPixelFormat SourceFormat = PF_Unknown;
+        FIntRect Region;
+        std::atomic<EStage> Stage { EStage::Copying };
+};
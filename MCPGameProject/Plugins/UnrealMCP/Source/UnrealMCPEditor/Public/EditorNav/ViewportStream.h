@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * viewport.stream_start / viewport.stream_stop: the active viewport pushed to the requesting session
+ * as a run of encoded frames, for agents that would otherwise poll take_screenshot. Each due frame
+ * starts an FViewportCapture (GPU copy and readback, convert, downscale and encode on a worker), so
+ * the game thread only issues the copy and checks fences; at most two frames are in flight and a
+ * frame that comes due while both are busy is skipped rather than queued. Finished frames go out as
+ *   viewport_frame { streamId, seq, tsMs, latencyMs, width, height, codec, mimeType, bytes, data }
+ * with data as a binary attachment when the connection negotiated them (through the shared-memory
+ * ring when that is on too) and as base64 otherwise. They are shed like events when the client
+ * reads too slowly. A session runs one stream; starting another replaces it.
+ */
+class UNREALMCPEDITOR_API FViewportStream
+{
+public:
+        /** Starts (or restarts) the session's stream: fps, resolution [w, h], codec, quality. */
+        static TSharedPtr<FJsonObject> StreamStart(const TSharedPtr<FJsonObject>& Params);
+
+        /** Stops streamId, or the session's stream, and reports what it sent. */
+        static TSharedPtr<FJsonObject> StreamStop(const TSharedPtr<FJsonObject>& Params);
+
+        /** Ends every stream (game thread); the bridge calls it when the server stops. */
+        static void StopAll();
+};
@@ -14,4 +14,7 @@ public:
     static TSharedPtr<FJsonObject> Load(const TSharedPtr<FJsonObject>& Params);
     static TSharedPtr<FJsonObject> Unload(const TSharedPtr<FJsonObject>& Params);
     static TSharedPtr<FJsonObject> StreamSublevel(const TSharedPtr<FJsonObject>& Params);
+    /** Loads the World Partition actors in a box until UnloadRegion, as the editor's loaded regions do. */
+    static TSharedPtr<FJsonObject> LoadRegion(const TSharedPtr<FJsonObject>& Params);
+    static TSharedPtr<FJsonObject> UnloadRegion(const TSharedPtr<FJsonObject>& Params);
 };
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class UWorld;
+class UWorldPartition;
+
+/**
+ * Actors of World Partition maps that are not loaded, answered from the partition's actor
+ * descriptors (class, label, bounds, tags, folder, data layers) so a query never loads a cell.
+ * Also keeps the regions that level.load_region loaded, so level.unload_region can release them.
+ * Game thread only.
+ */
+class UNREALMCPEDITOR_API FWorldPartitionActors
+{
+public:
+    struct FDesc
+    {
+        FGuid Guid;
+        /** Object path the actor will have once loaded. */
+        FString Path;
+        FString Name;
+        FString Label;
+        /** The Blueprint class for Blueprint actors, otherwise the native one. */
+        FString ClassPath;
+        FString ClassName;
+        const UClass* NativeClass = nullptr;
+        FString Folder;
+        FBox Bounds = FBox(ForceInit);
+        TArray<FName> Tags;
+        TArray<FName> DataLayers;
+    };
+
+    /** World's partition, or null when World is not a World Partition map. */
+    static UWorldPartition* GetWorldPartition(UWorld* World);
+
+    /** Descriptors of World's actors that are not loaded. False (and nothing) if World is not partitioned. */
+    static bool GetUnloaded(UWorld* World, TArray<FDesc>& OutDescs);
+
+    /**
+     * Desc as an actor entry, "loaded": false included. With Fields, only those of name, label,
+     * class, path, folder, tags and location (the bounds' center) are set, as for loaded actors.
+     */
+    static TSharedRef<FJsonObject> ToJson(const FDesc& Desc, const TSet<FString>* Fields = nullptr);
+
+    /**
+     * Loads the actors of World whose bounds meet Bounds, as the editor's "load region" does.
+     * OutActorCount counts the actors the region covers, including any loaded before.
+     */
+    static bool LoadRegion(UWorld* World, const FBox& Bounds, FString& OutRegionId, int32& OutActorCount, FString& OutError);
+
+    /** Unloads a region from LoadRegion. Regions of a map that has since been closed are gone already. */
+    static bool UnloadRegion(const FString& RegionId, FString& OutError);
+};
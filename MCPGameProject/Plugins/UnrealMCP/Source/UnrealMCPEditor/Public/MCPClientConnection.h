@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/SharedPointer.h"
+#include "MCPServerRunnable.h"
+#include "Protocol/Transport.h"
+
+class UUnrealMCPBridge;
+class FJsonObject;
+class FRunnableThread;
+class FEvent;
+class FMCPConnectionWriter;
+class FMCPSession;
+class FMCPSessionRegistry;
+class FTrafficRecorder;
+enum class EMCPOutboundKind : uint8;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+        class FCommandContext;
+        class FProtocolClient;
+        class FResponseStream;
+}
+}
+
+/**
+ * A single accepted MCP client. Each connection owns its byte stream (TCP socket or
+ * local IPC channel), protocol state and session id, and is served on a dedicated
+ * thread so several agents can talk to the editor at once. All connections feed the same bridge dispatcher.
+ *
+ * Requests are pipelined: up to MaxInFlightRequests commands may be queued on the
+ * bridge at once, and responses are written as they complete, matched by meta.requestId.
+ * Outgoing frames are encoded by whichever thread produced them and written by a
+ * per-connection FMCPConnectionWriter, so a slow reader on the client side never blocks
+ * request intake or heartbeats.
+ */
+class FMCPClientConnection : public FRunnable, public TSharedFromThis<FMCPClientConnection, ESPMode::ThreadSafe>
+{
+public:
+        FMCPClientConnection(UUnrealMCPBridge* InBridge, UnrealMCP::Protocol::FByteStreamPtr InStream, const FMCPServerConfig& InConfig, int32 InConnectionId,
+                TSharedPtr<FMCPSessionRegistry, ESPMode::ThreadSafe> InSessions, TSharedPtr<FTrafficRecorder, ESPMode::ThreadSafe> InRecorder = nullptr);
+        virtual ~FMCPClientConnection();
+
+        /** Spawns the connection thread. Returns false if the thread could not be created. */
+        bool Start();
+
+        /** Requests shutdown, closes the stream and waits for the connection thread to exit. */
+        void Shutdown();
+
+        /** Number of requests dispatched to the bridge that have not been answered yet. */
+        int32 GetInFlightCount() const { return InFlightCount.GetValue(); }
+
+        /** True once the connection thread has left its serve loop. */
+        bool IsFinished() const { return bFinished; }
+
+        int32 GetConnectionId() const { return ConnectionId; }
+        /** Fresh per connection until the handshake; a resumed connection takes over its earlier session's id. */
+        const FString& GetSessionId() const { return SessionId; }
+
+        // FRunnable interface
+        virtual uint32 Run() override;
+        virtual void Stop() override;
+
+private:
+        struct FPendingRequest
+        {
+                FString MessageType;
+                FString RequestId;
+                double StartSeconds = 0.0;
+                double StartTsMs = 0.0;
+                TSharedPtr<UnrealMCP::Protocol::FResponseStream, ESPMode::ThreadSafe> Stream;
+                /** Holds the timings the bridge recorded while the command ran. */
+                TSharedPtr<UnrealMCP::Protocol::FCommandContext, ESPMode::ThreadSafe> Context;
+        };
+
+        UUnrealMCPBridge* Bridge;
+        UnrealMCP::Protocol::FByteStreamPtr Stream;
+        FMCPServerConfig Config;
+        int32 ConnectionId;
+        FString SessionId;
+        FRunnableThread* Thread;
+        FThreadSafeBool bRunning;
+        FThreadSafeBool bFinished;
+
+        TSharedPtr<FMCPSessionRegistry, ESPMode::ThreadSafe> Sessions;
+        TSharedPtr<FMCPSession, ESPMode::ThreadSafe> Session;
+        /** Shared with every connection of the server; null unless traffic capture is on. */
+        TSharedPtr<FTrafficRecorder, ESPMode::ThreadSafe> Recorder;
+
+        TUniquePtr<UnrealMCP::Protocol::FProtocolClient> ProtocolClient;
+        TUniquePtr<FMCPConnectionWriter> Writer;
+        FCriticalSection SendMutex;
+        FThreadSafeCounter InFlightCount;
+        FEvent* SlotAvailableEvent;
+
+        void Serve();
+        bool HandleProtocolMessage(const TSharedPtr<FJsonObject>& Message);
+        /** Answers subscribe/unsubscribe directly on the connection thread; no game-thread hop. */
+        void HandleSubscription(const TSharedPtr<FJsonObject>& Message, bool bSubscribe, const FString& RequestId);
+        void CompleteRequest(const FPendingRequest& Pending, const TSharedRef<FJsonObject>& ResponseObject);
+
+        /**
+         * Records a finished response on the session and sends it on whichever connection is attached now.
+         * A non-empty Tool records its serialize and send phases.
+         */
+        static void DeliverResponse(const TSharedRef<FMCPSession, ESPMode::ThreadSafe>& InSession, const FString& RequestId, const TSharedRef<FJsonObject>& ResponseObject, bool bRemember, const FString& Tool = FString());
+
+        /**
+         * Encodes Message on the calling thread and hands it to the writer. A non-empty TimedTool
+         * records the encode as its serialize phase and the wait until written as its send phase.
+         */
+        bool QueueMessage(const TSharedRef<FJsonObject>& Message, EMCPOutboundKind Kind, FString& OutError, const FString& TimedTool = FString());
+};
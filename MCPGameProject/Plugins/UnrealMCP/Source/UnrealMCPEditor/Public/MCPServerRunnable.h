@@ -2,33 +2,40 @@
 
 #include "CoreMinimal.h"
 #include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Protocol/Transport.h"
 
 class UUnrealMCPBridge;
-class FJsonObject;
-class FSocket;
-
-namespace UnrealMCP
-{
-namespace Protocol
-{
-        class FProtocolClient;
-}
-}
+class FMCPClientConnection;
+class FMCPSessionRegistry;
+class FTrafficRecorder;
 
 struct FMCPServerConfig
 {
         double HandshakeTimeoutSeconds = 5.0;
         double ReadTimeoutSeconds = 60.0;
         double HeartbeatIntervalSeconds = 15.0;
+        bool bKeepaliveOnlyHeartbeats = false;
+        int32 MaxConnections = 8;
+        int32 MaxInFlightRequests = 16;
+        bool bAllowBinaryEncoding = true;
+        int32 CompressionThresholdBytes = 16 * 1024;
+        int32 SharedMemoryRingBytes = 32 * 1024 * 1024;
+        int64 MaxOutboundQueueBytes = 32 * 1024 * 1024;
+        bool bDisconnectSlowClients = false;
+        double SessionResumeWindowSeconds = 300.0;
+        /** When set, inbound frames and response timings are captured to this .mcptrace file. */
+        FString TrafficCapturePath;
 };
 
 /**
- * Runnable class for the MCP server thread
+ * Runnable class for the MCP server thread. Accepts incoming streams (TCP or local IPC)
+ * and hands each one to its own FMCPClientConnection so multiple clients are served concurrently.
  */
 class FMCPServerRunnable : public FRunnable
 {
 public:
-        FMCPServerRunnable(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InListenerSocket, const FMCPServerConfig& InConfig);
+        FMCPServerRunnable(UUnrealMCPBridge* InBridge, UnrealMCP::Protocol::FStreamListenerPtr InListener, const FMCPServerConfig& InConfig);
         virtual ~FMCPServerRunnable();
 
 	// FRunnable interface
@@ -37,13 +44,28 @@ public:
 	virtual void Stop() override;
 	virtual void Exit() override;
 
+        /** Number of clients currently connected. */
+        int32 GetConnectionCount() const;
+
+        /** Requests accepted from every connected client and not yet answered. */
+        int32 GetInFlightCount() const;
+
 private:
         UUnrealMCPBridge* Bridge;
-        TSharedPtr<FSocket> ListenerSocket;
-        TSharedPtr<FSocket> ClientSocket;
-        bool bRunning;
+        UnrealMCP::Protocol::FStreamListenerPtr Listener;
+        FThreadSafeBool bRunning;
         FMCPServerConfig Config;
 
-        void RunConnection(const TSharedPtr<FSocket>& InClientSocket);
-        bool HandleProtocolMessage(class UnrealMCP::Protocol::FProtocolClient& ProtocolClient, const TSharedPtr<class FJsonObject>& Message);
-};
\ No newline at end of file
+        mutable FCriticalSection ConnectionsMutex;
+        TArray<TSharedPtr<FMCPClientConnection>> Connections;
+        int32 NextConnectionId;
+        TSharedPtr<FMCPSessionRegistry, ESPMode::ThreadSafe> Sessions;
+        TSharedPtr<FTrafficRecorder, ESPMode::ThreadSafe> Recorder;
+
+        void AcceptConnection(const UnrealMCP::Protocol::FByteStreamPtr& InClientStream);
+        void ReapFinishedConnections();
+        void CloseAllConnections();
+
+        /** Unsubscribes expired (or, on shutdown, all) sessions from the bridge's event hub. */
+        void ReleaseSessions(const TArray<FString>& SessionIds);
+};
@@ -11,6 +11,10 @@ public:
     /** Implements the `mi.batch_apply` tool. */
     static TSharedPtr<FJsonObject> BatchApply(const TSharedPtr<FJsonObject>& Params);
 
-    /** Implements the `mesh.remap_material_slots` tool. */
+    /**
+     * Implements the `mesh.remap_material_slots` tool. Takes one mesh, or a `meshes` array of
+     * them that are all validated first; rebinding builds the mesh-to-component map in one pass
+     * over the editor world.
+     */
     static TSharedPtr<FJsonObject> RemapMaterialSlots(const TSharedPtr<FJsonObject>& Params);
 };
@@ -8,9 +8,15 @@ class FJsonObject;
 class FMaterialInstanceTools
 {
 public:
-    /** Implements the `mi.create` tool. */
+    /**
+     * Implements the `mi.create` tool, for one instance or an `instances` array created with their
+     * parameter overrides, announced to the asset registry and saved as one batch.
+     */
     static TSharedPtr<FJsonObject> Create(const TSharedPtr<FJsonObject>& Params);
 
-    /** Implements the `mi.set_params` tool. */
+    /**
+     * Implements the `mi.set_params` tool, for one instance or an `instances` array edited under a
+     * single material update and saved together.
+     */
     static TSharedPtr<FJsonObject> SetParameters(const TSharedPtr<FJsonObject>& Params);
 };
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class UMaterialInterface;
+
+/**
+ * `waitFor: "shaders"` for the material tools: holds a successful response back until the shader
+ * compiling manager has finished the shader maps of the materials that command touched, so an
+ * agent's next screenshot or edit does not see default materials or block in FinishCompilation.
+ *
+ * The handler suspends between frames while it waits (nothing blocks the editor) and reports
+ *   progress { done, total, phase: "shaders" }
+ * with the compiling manager's remaining job count, so a job.start'ed command shows it in
+ * job.status too. "shaderTimeoutMs" bounds the wait (default 120000). Inside a batch, where the
+ * handler cannot suspend, the listed materials are finished synchronously instead.
+ *
+ * The response gains "shaders": { complete, elapsedMs, remainingJobs, pending[], timedOut?,
+ * cancelled? }; the command's own result stands whichever way the wait ends.
+ */
+class FShaderCompileWait
+{
+public:
+    /** Whether Params carry waitFor: "shaders". */
+    static bool IsRequested(const TSharedPtr<FJsonObject>& Params);
+
+    /**
+     * Starts waiting for Materials on behalf of Response (the command's success payload). Returns
+     * the response to send now, or null after suspending the handler; it is then called again
+     * with the same params and must hand over to Resume before doing anything else.
+     */
+    static TSharedPtr<FJsonObject> Begin(const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonObject>& Response, const TArray<UMaterialInterface*>& Materials);
+
+    /**
+     * True when the running handler is a suspended wait coming back; OutResponse is then the
+     * finished response, or null if it suspended again.
+     */
+    static bool Resume(TSharedPtr<FJsonObject>& OutResponse);
+};
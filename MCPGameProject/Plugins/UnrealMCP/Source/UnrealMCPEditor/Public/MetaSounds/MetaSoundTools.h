@@ -4,7 +4,7 @@
 
 class FJsonObject;
 
-/** Placeholder MetaSound helpers exposed through the MCP bridge. */
+/** MetaSound helpers exposed through the MCP bridge. Render and Sweep are implemented; the rest are placeholders. */
 class UNREALMCPEDITOR_API FMetaSoundTools
 {
 public:
@@ -25,5 +25,23 @@ public:
 
         /** Create or update a MetaSound preset asset (currently not implemented). */
         static TSharedPtr<FJsonObject> PatchPreset(const TSharedPtr<FJsonObject>& Params);
+
+        /**
+         * Render a MetaSound source offline, faster than realtime, on a worker thread.
+         * Params: sourcePath, params ("Type:Name" or "Name" keys), durationSec, sampleRate,
+         * format ("wav" | "pcm"), stopWhenFinished, timeoutSec, and optionally variants
+         * [{params, durationSec}] to render several parameter sets in parallel. The audio is
+         * returned as an attachment when the connection allows them, streamed when the request
+         * asked for a stream, and inlined as base64 otherwise.
+         */
+        static TSharedPtr<FJsonObject> Render(const TSharedPtr<FJsonObject>& Params);
+
+        /**
+         * Render every combination of a parameter grid offline, in parallel across workers, and
+         * summarize each one: peak, RMS, integrated loudness and spectral centroid, rolloff and
+         * flatness. Params: sourcePath, grid ({key: [values]}), params (fixed), durationSec,
+         * sampleRate, includeAudio (default false), format, stopWhenFinished, timeoutSec.
+         */
+        static TSharedPtr<FJsonObject> Sweep(const TSharedPtr<FJsonObject>& Params);
 };
 
@@ -11,7 +11,11 @@ public:
         /** Spawns a Niagara component in the current editor world. */
         static TSharedPtr<FJsonObject> SpawnComponent(const TSharedPtr<FJsonObject>& Params);
 
-        /** Sets user parameters on an existing Niagara component. */
+        /**
+         * Sets user parameters on an existing Niagara component, or on each entry of a
+         * `components` array. Parameters are parsed once per call and written to each component's
+         * override store by offset; `reinitialize` restarts a changed component once at the end.
+         */
         static TSharedPtr<FJsonObject> SetUserParameters(const TSharedPtr<FJsonObject>& Params);
 
         /** Activates a Niagara component. */
@@ -19,4 +23,11 @@ public:
 
         /** Deactivates a Niagara component. */
         static TSharedPtr<FJsonObject> Deactivate(const TSharedPtr<FJsonObject>& Params);
+
+        /**
+         * Implements `niagara.prepare`: requests compilation of a batch of systems, waits for them
+         * across frames with "compiling" progress, and with `warmup` runs a transient component
+         * of each for a moment so later spawns do not hitch.
+         */
+        static TSharedPtr<FJsonObject> Prepare(const TSharedPtr<FJsonObject>& Params);
 };
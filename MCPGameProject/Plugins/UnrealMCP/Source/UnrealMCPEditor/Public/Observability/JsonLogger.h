@@ -16,28 +16,39 @@ struct FLogEvent
     double TsUnixMs = 0.0;
 };
 
-/** Simple JSON lines logger for events and metrics. */
+/**
+ * JSON lines logger for events and metrics. Callers only serialize and queue a line; a background
+ * writer keeps the files open, appends in batches (every 64 KiB or 200 ms) and rotates each file
+ * by the bytes it has written.
+ */
 class UNREALMCPEDITOR_API FJsonLogger
 {
 public:
-    /** Initialise the logger with the directory for log files. */
+    /** Initialise the logger with the directory for log files and start the writer. */
     static void Init(const FString& Directory, bool bEnable);
 
+    /** Writes out every queued line and stops the writer. */
+    static void Shutdown();
+
     /** Emit a structured log event. */
     static void Log(const FLogEvent& Event);
 
     /** Emit a structured metric entry. */
     static void Metric(const FString& Name, const TSharedPtr<FJsonObject>& Fields);
 
+    /** Emit an event to the slow-command log (UnrealMCP_slow.jsonl) instead of the events file. */
+    static void Slow(const FLogEvent& Event);
+
 private:
+    /** Serializes Init and Shutdown; logging itself does not take it. */
     static FCriticalSection CriticalSection;
     static FString EventsPath;
     static FString MetricsPath;
+    static FString SlowPath;
     static bool bIsEnabled;
 
+    static TSharedRef<FJsonObject> BuildEventPayload(const FLogEvent& Event);
     static void EnsureDirectory(const FString& Directory);
     static void WriteLine(const FString& Path, const TSharedRef<FJsonObject>& Payload);
-    static void RotateIfNeeded(const FString& Path);
-    static TSharedPtr<FJsonObject> CloneJson(const TSharedPtr<FJsonObject>& Source);
     static double NowUnixMs();
 };
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Trace/Trace.h"
+
+/**
+ * Insights channel for MCP activity, so it lines up with render, GC and shader compiles in a
+ * capture. Enable it with -trace=cpu,unrealmcp (or Trace.Enable UnrealMCP at runtime).
+ *
+ * Scopes are named after the step, or the tool for handler bodies; request ids would give every
+ * command its own timer, so they go in the per-command bookmarks instead.
+ */
+UE_TRACE_CHANNEL_EXTERN(UnrealMCPChannel, UNREALMCPEDITOR_API)
+
+/** LLM tag for allocations made by command handlers and response encoding; see -llm / stat LLM. */
+LLM_DECLARE_TAG_API(UnrealMCP, UNREALMCPEDITOR_API);
+
+#define UNREALMCP_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, UnrealMCPChannel)
+#define UNREALMCP_TRACE_SCOPE_TEXT(Text) TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(Text, UnrealMCPChannel)
+
+/** A bookmark that is only emitted while the UnrealMCP channel is on. */
+#define UNREALMCP_TRACE_BOOKMARK(Format, ...) \
+    do \
+    { \
+        if (UE_TRACE_CHANNELEXPR_IS_ENABLED(UnrealMCPChannel)) \
+        { \
+            TRACE_BOOKMARK(Format, ##__VA_ARGS__); \
+        } \
+    } while (0)
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+class UPackage;
+
+/**
+ * Keeps long agent sessions from growing the editor without bound. In the editor a loaded asset is
+ * standalone and stays resident after the command that loaded it finishes, so thousands of
+ * asset.* and content.* calls add up. The policy tracks the packages loaded while MCP commands
+ * run (and by FPackagePrefetch between their slices). Once no command has been queued or parked
+ * for IdleGcSec, those nobody has modified or opened in an editor lose their standalone flag, an
+ * incremental collection runs (its purge spread over the following frames), and whatever is still
+ * referenced gets the flag back.
+ *
+ * MemoryCeilingMb bounds used physical memory. From 90% of it the policy collects between frames,
+ * releasing tracked packages only while no command is in flight, since parked handlers may hold
+ * raw pointers. At the ceiling it purges in full, and until memory drops back below it bulk
+ * commands and batches are refused with OVERLOADED. Chunked commands that collect between their
+ * chunks go through Collect, so every collection's time is reported in the metrics.
+ */
+class UNREALMCPEDITOR_API FMemoryPolicy
+{
+public:
+    struct FStats
+    {
+        /** Per reason: idle, ceiling, chunk. */
+        TMap<FString, int32> Collections;
+        double CollectSeconds = 0.0;
+        double LastCollectMs = 0.0;
+        int32 TrackedPackages = 0;
+        int32 ReleasedPackages = 0;
+        int64 UsedBytes = 0;
+        int64 CeilingBytes = 0;
+        bool bOverCeiling = false;
+    };
+
+    /**
+     * Starts tracking loads and the once-a-second policy tick (game thread). HasCommandsInFlight
+     * reports whether any command is queued or parked.
+     */
+    static void Start(TFunction<bool()> InHasCommandsInFlight);
+
+    /** Stops tracking and forgets the tracked packages; their assets stay loaded. */
+    static void Stop();
+
+    /** Brackets one command slice, so the assets it loads are tracked (game thread). */
+    static void BeginSlice();
+    static void EndSlice();
+
+    /** Tracks a package loaded on a command's behalf outside its slices (game thread). */
+    static void NoteLoaded(UPackage* Package);
+
+    /**
+     * Collects garbage now (game thread), first releasing the tracked packages when bRelease and
+     * the setting allow it, and records the run under Reason. False when the collector was busy.
+     */
+    static bool Collect(const TCHAR* Reason, bool bRelease, bool bFullPurge);
+
+    /** Whether used memory was past MemoryCeilingMb at the last tick. Safe from any thread. */
+    static bool IsOverCeiling();
+
+    /** Safe from any thread. */
+    static FStats GetStats();
+
+private:
+    static bool Tick(float DeltaTime);
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+class IHttpRouter;
+struct FHttpRouteHandleInternal;
+
+/** Point-in-time values the bridge reports on each scrape. */
+struct FMetricsGauges
+{
+    int32 QueueDepth = 0;
+    int32 InFlight = 0;
+    int32 Connections = 0;
+    int32 FramesOverBudget = 0;
+
+    /** FResponsePrefetcher totals since the server started. */
+    int64 PrefetchQueued = 0;
+    int64 PrefetchRun = 0;
+    int64 PrefetchHits = 0;
+    int64 PrefetchDropped = 0;
+    double PrefetchSeconds = 0.0;
+};
+
+/**
+ * Serves the aggregated metrics in OpenMetrics text format at GET /metrics on the given port,
+ * through the engine's HTTPServer module so it shares listeners with other editor HTTP routes.
+ * The module ticks its listeners on the game thread, so scrapes are answered between frames.
+ */
+class UNREALMCPEDITOR_API FMetricsEndpoint
+{
+public:
+    typedef TFunction<FMetricsGauges()> FGaugeSource;
+
+    ~FMetricsEndpoint();
+
+    /** Binds the route and starts the listener. False (with OutError) if the port cannot be used. */
+    bool Start(uint32 Port, FGaugeSource InGauges, FString& OutError);
+
+    /** Unbinds the route; the listener itself is shared and stays up. */
+    void Stop();
+
+    /** The exposition text for the current registry contents and Gauges. */
+    static FString Render(const FMetricsGauges& Gauges);
+
+private:
+    TSharedPtr<IHttpRouter> Router;
+    TSharedPtr<FHttpRouteHandleInternal> RouteHandle;
+    FGaugeSource Gauges;
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+/**
+ * Log-linear latency histogram (HDR-style): values in microseconds fall into 16 linear
+ * sub-buckets per power of two, so any percentile is within about 6% of the true value
+ * while the whole range (1 us to about 12 days) fits in a fixed array.
+ */
+class UNREALMCPEDITOR_API FLatencyHistogram
+{
+public:
+    static constexpr int32 SubBucketBits = 4;
+    static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+    static constexpr int32 MaxExponent = 36;
+    static constexpr int32 NumBuckets = (MaxExponent + 2) * SubBucketCount;
+
+    FLatencyHistogram();
+
+    void Record(double Milliseconds);
+    void Reset();
+
+    /** Adds every value recorded in Other. */
+    void Merge(const FLatencyHistogram& Other);
+
+    uint64 GetCount() const { return Count; }
+    double GetSumMs() const { return SumMs; }
+    double GetMaxMs() const { return MaxMs; }
+
+    /** Value at Quantile (0..1) in milliseconds, the midpoint of the bucket it falls in; 0 when empty. */
+    double GetPercentileMs(double Quantile) const;
+
+    /** Values recorded at or below Milliseconds; a bucket straddling the bound counts as below it. */
+    uint64 GetCountAtOrBelow(double Milliseconds) const;
+
+    static int32 BucketIndex(uint64 Microseconds);
+    static uint64 BucketLowerBound(int32 Index);
+    static uint64 BucketWidth(int32 Index);
+
+private:
+    TArray<uint32> Buckets;
+    uint64 Count;
+    double SumMs;
+    double MaxMs;
+};
+
+/** Copy of one series, taken under the registry lock. */
+struct FToolMetricsSnapshot
+{
+    FString Tool;
+    /** "ok" or the error code of the failed calls for call series; the phase name for phase series. */
+    FString Outcome;
+    FLatencyHistogram Total;
+    FLatencyHistogram Interval;
+};
+
+/** Peak memory above a command's starting point, aggregated per tool (see meta.memory). */
+struct FToolMemoryStats
+{
+    uint64 Count = 0;
+    double SumPeakBytes = 0.0;
+    int64 MaxPeakBytes = 0;
+
+    void Record(int64 PeakBytes)
+    {
+        ++Count;
+        SumPeakBytes += static_cast<double>(PeakBytes);
+        MaxPeakBytes = FMath::Max(MaxPeakBytes, PeakBytes);
+    }
+};
+
+struct FToolMemorySnapshot
+{
+    FString Tool;
+    FToolMemoryStats Total;
+    FToolMemoryStats Interval;
+};
+
+/** One step of the plugin's startup: module load, settings read, socket bind, first command served... */
+struct FStartupMilestone
+{
+    FString Name;
+    /** When the step finished, in seconds since the process started. */
+    double AtSeconds = 0.0;
+    /** How long the step itself took. */
+    double DurationMs = 0.0;
+};
+
+/**
+ * Per-tool call counters and latency histograms, aggregated in memory. Every
+ * MetricsFlushIntervalSec a snapshot line per active series (counts, p50/p95/p99, max) goes to the
+ * metrics file instead of a line per call; MetricsRawSampleRate keeps a sample of per-call lines.
+ */
+class UNREALMCPEDITOR_API FMetricsRegistry
+{
+public:
+    /** Starts the periodic snapshot ticker (game thread). */
+    static void Start(float FlushIntervalSeconds, float RawSampleRate);
+
+    /** Stops the ticker and writes a last snapshot. */
+    static void Stop();
+
+    /** Records one finished command. Safe from any thread. */
+    static void RecordToolCall(const FString& Tool, bool bOk, const FString& ErrorCode, double DurationMs);
+
+    /**
+     * Records where one command's time went: queue, gate, checkout, handler, parked, complete,
+     * serialize or send (see meta.timings). Safe from any thread.
+     */
+    static void RecordPhase(const FString& Tool, const TCHAR* Phase, double DurationMs);
+
+    /** Records one command's measured memory high-water mark. Safe from any thread. */
+    static void RecordMemory(const FString& Tool, int64 PeakDeltaBytes);
+
+    /** Copies every series; intervals are those since the last snapshot. Safe from any thread. */
+    static TArray<FToolMetricsSnapshot> GetSnapshot();
+
+    /** Same for the phase series, with the phase in Outcome. */
+    static TArray<FToolMetricsSnapshot> GetPhaseSnapshot();
+
+    /** Per-tool memory high-water marks. */
+    static TArray<FToolMemorySnapshot> GetMemorySnapshot();
+
+    /** Writes the interval snapshot to the metrics file and starts a new interval. */
+    static void Flush();
+
+    /** Frame payload bytes read from and queued to clients, before compression. Safe from any thread. */
+    static void AddBytesReceived(int64 Bytes);
+    static void AddBytesSent(int64 Bytes);
+
+    /** Game-thread time spent inside MCP command slices. */
+    static void AddGameThreadSeconds(double Seconds);
+
+    /**
+     * Records that the startup step Milestone, begun at StartedAt (FPlatformTime::Seconds), has just
+     * finished, and writes a "startup_milestone" metrics line. Only the first call per name counts.
+     * Safe from any thread.
+     */
+    static void MarkStartup(const TCHAR* Milestone, double StartedAt);
+
+    /** Every milestone recorded so far, in the order they were reached. */
+    static TArray<FStartupMilestone> GetStartupTimeline();
+
+    static int64 GetBytesReceived();
+    static int64 GetBytesSent();
+    static double GetGameThreadSeconds();
+
+private:
+    static bool Tick(float DeltaTime);
+};
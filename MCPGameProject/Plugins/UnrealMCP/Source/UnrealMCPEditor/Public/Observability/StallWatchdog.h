@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Templates/SharedPointer.h"
+
+class FEvent;
+class FJsonObject;
+class FRunnableThread;
+
+/**
+ * Times every MCP command slice on the game thread and reports the ones that block the editor.
+ *
+ * A slice longer than SlowCommandThresholdMs goes to UnrealMCP_slow.jsonl beside the JSON events
+ * file: command, requestId, a digest of its params, the duration and, when the sampler thread
+ * caught it still running past the threshold, the game thread's callstack at that moment. Each
+ * one also drops an Insights bookmark. Frames whose MCP work went over GameThreadBudgetMs are
+ * counted over a rolling minute.
+ *
+ * The sampler also reads the process's used physical memory every CommandMemorySampleMs while a
+ * slice runs, so each slice reports its high-water mark and not only the difference at its end.
+ */
+class UNREALMCPEDITOR_API FStallWatchdog : public FRunnable, public TSharedFromThis<FStallWatchdog, ESPMode::ThreadSafe>
+{
+public:
+    FStallWatchdog();
+    virtual ~FStallWatchdog() override;
+
+    /** What one slice cost. Memory is process-wide used physical memory, so other threads add noise. */
+    struct FSliceStats
+    {
+        double DurationSeconds = 0.0;
+        int64 StartUsedBytes = 0;
+        int64 PeakUsedBytes = 0;
+        int64 EndUsedBytes = 0;
+    };
+
+    /**
+     * Applies the thresholds; a slow threshold or memory sample interval above 0 starts the sampler
+     * thread. A slow threshold of 0 disables reports; a sample interval of 0 measures memory only at
+     * slice boundaries.
+     */
+    void Configure(double InSlowThresholdMs, double InFrameBudgetMs, double InMemorySampleMs);
+
+    /** Stops and joins the sampler thread. */
+    void Shutdown();
+
+    /** Brackets one game-thread slice of a command. Slices do not nest. */
+    void BeginSlice(const FString& CommandType, const FString& RequestId, const TSharedPtr<FJsonObject>& Params);
+    FSliceStats EndSlice();
+
+    /** Frames in the last minute whose MCP work exceeded the frame budget. Safe from any thread. */
+    int32 GetFramesOverBudget() const;
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    /** Closes the frame being accumulated if the game thread has moved on (game thread). */
+    void RollFrame(uint64 FrameNumber, double NowSeconds);
+
+    void WriteSlowEntry(double DurationMs, const FString& Callstack);
+
+    /** Guards the slice the sampler thread watches and the over-budget frame times. */
+    mutable FCriticalSection Mutex;
+    FString ActiveCommand;
+    FString ActiveRequestId;
+    double ActiveStartSeconds;
+    /** Bumped per slice, so a stack sampled for one slice is never attached to the next. */
+    uint64 ActiveSliceId;
+    bool bActiveSampled;
+    FString ActiveCallstack;
+    int64 ActiveStartUsedBytes;
+    int64 ActivePeakUsedBytes;
+    /** When each over-budget frame ended, oldest first. */
+    TArray<double> OverBudgetFrameTimes;
+
+    /** Game thread only. */
+    TSharedPtr<FJsonObject> ActiveParams;
+    uint64 AccumulatingFrame;
+    double AccumulatedFrameSeconds;
+
+    double SlowThresholdSeconds;
+    double FrameBudgetSeconds;
+    double MemorySampleSeconds;
+
+    FRunnableThread* Thread;
+    FEvent* WakeEvent;
+    FThreadSafeBool bStopping;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+class FJsonObject;
+
+/**
+ * Captures protocol traffic to a compact binary trace (.mcptrace) for Python/replay_trace.py.
+ * All integers are little-endian:
+ *
+ *   header:  "MCPTRACE" | uint16 version (1) | uint16 reserved | int64 capture start, Unix ms
+ *   record:  uint8 kind | uint32 connection id | uint64 offset from start, us | uint32 length | UTF-8 JSON
+ *
+ * Kind 0 is an inbound frame after the handshake, as the editor decoded it. Kind 1 summarises a
+ * response ({requestId, tool, durMs, ok}), so a replay can be compared with the original session.
+ * Heartbeats are left out. Safe from any thread; records are buffered and written about once a second.
+ */
+class UNREALMCPEDITOR_API FTrafficRecorder
+{
+public:
+    enum class ERecordKind : uint8
+    {
+        Inbound = 0,
+        Response = 1,
+    };
+
+    static const uint16 FormatVersion = 1;
+
+    /** Creates the file and writes its header. Null (with OutError) if it cannot be created. */
+    static TSharedPtr<FTrafficRecorder, ESPMode::ThreadSafe> Open(const FString& Path, FString& OutError);
+
+    ~FTrafficRecorder();
+
+    void RecordInbound(int32 ConnectionId, const TSharedRef<FJsonObject>& Message);
+    void RecordResponse(int32 ConnectionId, const FString& RequestId, const FString& Tool, double DurationMs, bool bOk);
+
+    /** Writes buffered records to disk. */
+    void Flush();
+
+    const FString& GetPath() const { return Path; }
+
+private:
+    FTrafficRecorder(const FString& InPath, TUniquePtr<FArchive> InWriter);
+
+    void Append(ERecordKind Kind, int32 ConnectionId, const FString& Json);
+
+    /** Caller holds Mutex. */
+    void FlushLocked();
+
+    FString Path;
+    double StartSeconds;
+    double LastFlushSeconds;
+
+    FCriticalSection Mutex;
+    TUniquePtr<FArchive> Writer;
+    TArray<uint8> Pending;
+};
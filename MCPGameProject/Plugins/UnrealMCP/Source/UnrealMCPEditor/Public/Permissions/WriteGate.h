@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
+#include "Templates/Function.h"
 
 class UUnrealMCPSettings;
 
@@ -17,6 +18,88 @@ struct FMutationPlan
         TArray<FMutationAction> Actions;
 };
 
+/** How a plan argument is read from a command's params. */
+enum class EMutationArg : uint8
+{
+        /** String param, trimmed. */
+        String,
+        /** String param as a /Game-rooted content path. */
+        Path,
+        /** Content path reduced to its package (Map.Map -> Map, actor paths -> their level). */
+        Package,
+        /** String array as comma-joined content paths. */
+        PathList,
+        /** Boolean param as "true"/"false". */
+        Bool,
+        /** Number or string param as an integer. */
+        Int,
+        /** Array param as JSON. */
+        Array,
+        /** Object param as JSON. */
+        Object,
+        /** Any param as JSON; null is recorded as "null". */
+        Value
+};
+
+struct FMutationArgSpec
+{
+        /** Name in the audit action's args. */
+        FString Name;
+        /** Param it is read from; unused for a ForEach element. */
+        FString Key;
+        EMutationArg Kind = EMutationArg::String;
+        /** Recorded when the param is missing; empty leaves the arg out. */
+        FString Default;
+};
+
+/** One audit action, or one per usable element of the ForEach array param. */
+struct FMutationActionSpec
+{
+        /** Defaults to the command name. */
+        FString Op;
+        FString ForEach;
+        /** How each ForEach element is recorded. */
+        FMutationArgSpec Element;
+        /** Added to every action produced. */
+        TArray<FMutationArgSpec> Args;
+};
+
+/** A param that may carry the content path a mutation touches. */
+struct FMutationPathKey
+{
+        /** A string param, or an array whose first usable element is taken. */
+        FString Key;
+        /** For arrays of objects: the string field read from each element. */
+        FString Field;
+        /** Reduce the path to its package. */
+        bool bPackage = false;
+};
+
+/** Editor level whose package a mutation touches when none of its path keys is present. */
+enum class EMutationLevelPath : uint8
+{
+        None,
+        Persistent,
+        Current
+};
+
+/**
+ * Write-gate rules for one mutating command: where its content path lives and how its audit
+ * plan is built. The command registry attaches each command's schema when it is registered, so
+ * gating a mutation is a table walk rather than a match on command names.
+ */
+struct FMutationSchema
+{
+        typedef TFunction<void(const TSharedPtr<FJsonObject>&, TArray<FMutationAction>&)> FBuildActions;
+
+        /** Checked in order; the first one present wins. */
+        TArray<FMutationPathKey> PathKeys;
+        EMutationLevelPath LevelFallback = EMutationLevelPath::None;
+        TArray<FMutationActionSpec> Actions;
+        /** Replaces Actions for plans that depend on nested or conditional params. */
+        FBuildActions BuildActions;
+};
+
 /** Centralized enforcement for write operations issued via the MCP bridge. */
 class UNREALMCPEDITOR_API FWriteGate
 {
@@ -35,12 +118,21 @@ public:
         /** Validates the write gate for a command and path, returning false if blocked. */
         static bool CanMutate(const FString& CommandType, const FString& ContentPath, FString& OutReason);
 
+        /**
+         * Whether a mutation may run without undo: bAllowUndoFreeMutations is on, and RequireCheckout
+         * makes sure source control can revert whatever it changes.
+         */
+        static bool CanSkipUndo(FString& OutReason);
+
         /** Validates the tool allow/deny lists for a command. */
         static bool IsToolAllowed(const FString& CommandType, FString& OutReason);
 
         /** Builds a simple mutation plan for auditing. */
         static FMutationPlan BuildPlan(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+        /** Same, from an already looked-up schema. Without one the plan records every param. */
+        static FMutationPlan BuildPlan(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FMutationSchema* Schema);
+
         /** Builds an audit JSON object from a plan. */
         static TSharedPtr<FJsonObject> BuildAuditJson(const FMutationPlan& Plan, bool bExecuted);
 
@@ -50,6 +142,12 @@ public:
         /** Ensures the target content path is checked out when required by settings. */
         static bool EnsureCheckoutForContentPath(const FString& ContentPath, TSharedPtr<FJsonObject>& OutError);
 
+        /**
+         * Same for several paths in one provider operation; files already checked out are skipped.
+         * OutError names the first path that could not be checked out.
+         */
+        static bool EnsureCheckoutForContentPaths(const TArray<FString>& ContentPaths, TSharedPtr<FJsonObject>& OutError);
+
         /** Creates a structured error payload for missing source control checkout. */
         static TSharedPtr<FJsonObject> MakeSourceControlRequiredError(const FString& AssetPath, const FString& FailureMessage = FString());
 
@@ -59,19 +157,39 @@ public:
         /** Creates an error payload when a path is outside of the allowlist. */
         static TSharedPtr<FJsonObject> MakePathNotAllowedError(const FString& Path, const FString& Reason);
 
+        /** Creates an error payload when a request asked for no undo and may not have it. */
+        static TSharedPtr<FJsonObject> MakeUndoRequiredError(const FString& CommandType, const FString& Reason);
+
         /** Creates an error payload when a tool is blocked by policy. */
         static TSharedPtr<FJsonObject> MakeToolNotAllowedError(const FString& CommandType, const FString& Reason);
 
         /** Updates remote enforcement flags received from the Python server. */
         static void UpdateRemoteEnforcement(bool bAllowWrite, bool bDryRun, const TArray<FString>& AllowedPaths, const TArray<FString>& AllowedTools, const TArray<FString>& DeniedTools);
 
+        /**
+         * Recompiles the settings and remote enforcement into the policy the gate checks read
+         * without locking. Call after changing UUnrealMCPSettings; UpdateRemoteEnforcement does it.
+         */
+        static void RefreshPolicy();
+
         /** Resolves a potential content path from known command parameters. */
         static FString ResolvePathForCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+        /** Same, from an already looked-up schema. Empty when there is no schema or no path. */
+        static FString ResolvePath(const FMutationSchema* Schema, const TSharedPtr<FJsonObject>& Params);
+
+        /**
+         * Schema for CommandType, or null if none is declared. Every mutating command declares
+         * one, if only an empty one for editor-only mutations.
+         */
+        static const FMutationSchema* FindMutationSchema(const FString& CommandType);
+
         /** Produces a merged list of allowed content roots. */
         static TArray<FString> GetEffectiveAllowedRoots();
 
 private:
         static const UUnrealMCPSettings* GetSettings();
         static FString NormalizeContentPath(const FString& InPath);
+        static bool ReadMutationArg(const FMutationArgSpec& Spec, const TSharedPtr<FJsonValue>& Value, FString& OutValue);
+        static void RegisterMutationSchemas(TMap<FString, FMutationSchema>& Schemas);
 };
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+
+class FJsonObject;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+    /** Raw binary segments that travel after a frame's message. */
+    typedef TArray<TArray<uint8>> FAttachmentList;
+    typedef TSharedPtr<const FAttachmentList, ESPMode::ThreadSafe> FAttachmentListPtr;
+
+    /**
+     * Binary attachments of protocol messages. Once a connection negotiates "attachments" in the
+     * handshake, a frame may carry raw segments after its message (images, blobs) instead of
+     * base64 strings inside it; the message refers to them by position as {"$attachment": index}.
+     *
+     * A message's segments are bound to the message object itself rather than stored in a field,
+     * so they follow the envelope wherever it goes (the session's remembered responses, replays
+     * after a resume) and are released with it. Safe from any thread.
+     */
+    class UNREALMCPEDITOR_API FAttachments
+    {
+    public:
+        /** {"$attachment": Index, "bytes": Bytes}, the value a handler puts where the data would go. */
+        static TSharedRef<FJsonObject> MakeReference(int32 Index, int64 Bytes);
+
+        /** Index of a reference object, or INDEX_NONE if Object is not one. */
+        static int32 GetReferenceIndex(const FJsonObject& Object);
+
+        /** Binds List to Message; a null or empty list unbinds it. */
+        static void Bind(const TSharedRef<FJsonObject>& Message, FAttachmentListPtr List);
+
+        /** Segments bound to Message, or null. */
+        static FAttachmentListPtr Find(const FJsonObject& Message);
+    };
+}
+}
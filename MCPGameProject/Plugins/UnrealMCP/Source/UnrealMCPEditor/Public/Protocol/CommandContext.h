@@ -0,0 +1,269 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Protocol/Attachments.h"
+#include "Protocol/CommandScheduler.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+
+class FJsonObject;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+    /**
+     * Per-request state shared between the connection that received a command and the handler
+     * running it on the game thread. A client's cancel { requestId } sets the flag from the
+     * connection thread; a command still queued for the game thread is answered CANCELLED
+     * without running, and long-running handlers poll IsActiveCancelled() between items.
+     *
+     * Clients that send "progress": true also get
+     *   progress { requestId, done, total, phase }
+     * frames from handlers that call ReportActiveProgress, so a slow command can be told
+     * apart from a hung one.
+     *
+     * A request's meta.deadlineMs (Unix time in milliseconds) is kept here too: a command whose
+     * caller has already given up is answered DEADLINE_EXCEEDED instead of running, and its
+     * meta.priority picks the scheduler lane in place of the command's default.
+     *
+     * Read-only handlers that loop over many items may yield when the frame budget runs out:
+     *   if (Context->ShouldYield()) { Context->Yield(State); return nullptr; }
+     * The scheduler calls them again next frame with the same params, and TakeResumeState
+     * hands back where they stopped. Handlers waiting on work running elsewhere (an asynchronous
+     * source control operation) Suspend the same way, mutations included, when CanSuspend().
+     */
+    class UNREALMCPEDITOR_API FCommandContext : public TSharedFromThis<FCommandContext, ESPMode::ThreadSafe>
+    {
+    public:
+        /** What a yielding handler keeps between the frames it runs in. */
+        struct FResumeState
+        {
+            virtual ~FResumeState() = default;
+
+            /**
+             * Names the shared wait stage (shader compiles, package prefetch) that parked the
+             * handler, so each stage can tell its own state from the handler's; None otherwise.
+             */
+            FName Stage;
+        };
+
+        /**
+         * FPlatformTime::Seconds() at the steps a request passes on its way through the bridge; 0
+         * until it gets there. The connection turns them into meta.timings.
+         */
+        struct FTimings
+        {
+            /** First slice on the game thread (or the worker, for off-thread reads). */
+            double StartedSeconds = 0.0;
+            double HandlerStartSeconds = 0.0;
+            double HandlerEndSeconds = 0.0;
+            /** Time inside the handler, summed over the slices of a yielding or suspending one. */
+            double HandlerSeconds = 0.0;
+            /** Write-gate checkouts before the handler ran. */
+            double CheckoutSeconds = 0.0;
+        };
+
+        /** Process memory the command's game-thread slices used, from the stall watchdog's samples. */
+        struct FMemoryUse
+        {
+            bool bMeasured = false;
+            /** Highest used physical memory above where the first slice started, in bytes. */
+            int64 PeakDeltaBytes = 0;
+            /** Still in use when the last slice ended, in bytes; negative when it freed more. */
+            int64 RetainedBytes = 0;
+            /** Set once a mutation recorded undo, however little. */
+            bool bUndoRecorded = false;
+            /** Object snapshots the command's mutations added to the editor's undo buffer, in bytes. */
+            int64 UndoBytes = 0;
+        };
+
+        /** Writes one frame to the client; returns false if the connection is gone. */
+        typedef TFunction<bool(const TSharedRef<FJsonObject>&)> FFrameSink;
+
+        explicit FCommandContext(const FString& InRequestId);
+
+        const FString& GetRequestId() const { return RequestId; }
+
+        /** Requests cancellation. Safe from any thread; the handler stops at its next check. */
+        void Cancel() { bCancelled = true; }
+        bool IsCancelled() const { return bCancelled; }
+
+        /** Unix time in milliseconds after which the caller no longer waits; 0 means none. */
+        void SetDeadline(double InDeadlineUnixMs) { DeadlineUnixMs = InDeadlineUnixMs; }
+        double GetDeadline() const { return DeadlineUnixMs; }
+        bool IsPastDeadline() const;
+
+        /** Scheduler lane the client asked for; unset means the command's registered priority. */
+        void SetPriority(ECommandPriority InPriority) { Priority = InPriority; bHasPriority = true; }
+        ECommandPriority GetPriorityOr(ECommandPriority Default) const { return bHasPriority ? Priority : Default; }
+
+        /**
+         * Session the request came from and that session's share of the game thread; within a lane
+         * the scheduler serves sessions in proportion to their shares. Set before dispatch.
+         */
+        void SetScheduling(const FString& InSessionId, float InShare) { SessionId = InSessionId; Share = InShare; }
+        const FString& GetSessionId() const { return SessionId; }
+        float GetShare() const { return Share; }
+
+        /** Whether the client wants the mutation audit in the response (AlwaysEmitAudit adds it regardless). */
+        void SetAuditRequested(bool bInAuditRequested) { bAuditRequested = bInAuditRequested; }
+        bool IsAuditRequested() const { return bAuditRequested; }
+
+        /** Whether the client asked (meta.noUndo) to run its mutations without undo; the write gate decides. */
+        void SetUndoFreeRequested(bool bInUndoFreeRequested) { bUndoFreeRequested = bInUndoFreeRequested; }
+        bool IsUndoFreeRequested() const { return bUndoFreeRequested; }
+
+        /**
+         * Whether the response may carry binary attachments: the connection negotiated them and
+         * the response is not streamed. Set before the command is dispatched.
+         */
+        void SetAttachmentsAllowed(bool bInAllowed) { bAttachmentsAllowed = bInAllowed; }
+        bool CanAttach() const { return bAttachmentsAllowed; }
+
+        /**
+         * Adds Bytes to the response and returns the reference to put in its place (game thread).
+         * Only valid when CanAttach(); otherwise handlers inline the data as base64.
+         */
+        TSharedRef<FJsonObject> Attach(TArray<uint8>&& Bytes);
+
+        /** The response's attachments, or null; taken by the connection when it sends the response. */
+        FAttachmentListPtr TakeAttachments();
+
+        /** Segments the request frame carried, referenced from its params by {"$attachment": index}. */
+        void SetRequestAttachments(FAttachmentListPtr InAttachments) { RequestAttachments = MoveTemp(InAttachments); }
+        const TArray<uint8>* GetRequestAttachment(int32 Index) const;
+
+        /** Enables progress frames for this request. Set before the command is dispatched. */
+        void SetProgressSink(FFrameSink InSink) { ProgressSink = MoveTemp(InSink); }
+
+        /**
+         * Sends a progress frame (game thread only). Frames are throttled; the first and the
+         * last (Done == Total) of a phase always go out.
+         */
+        void ReportProgress(int32 Done, int32 Total, const FString& Phase);
+
+        /**
+         * Where a handler sends frames that outlive its response (viewport.stream_start), routed
+         * through the session so they follow it across a resume; the sink returns false once the
+         * session is gone. bInAttachments says whether the connection negotiated binary attachments.
+         * Set before the command is dispatched.
+         */
+        void SetPushSink(FFrameSink InSink, bool bInAttachments) { PushSink = MoveTemp(InSink); bPushAttachments = bInAttachments; }
+        const FFrameSink& GetPushSink() const { return PushSink; }
+        bool CanAttachToPush() const { return bPushAttachments; }
+
+        /**
+         * FPlatformTime::Seconds() at which the current slice should yield; 0 (the default, and
+         * always for mutations) means the handler must run to completion. Set by the bridge.
+         */
+        void SetYieldDeadline(double InYieldDeadlineSeconds) { YieldDeadlineSeconds = InYieldDeadlineSeconds; }
+        double GetYieldDeadline() const { return YieldDeadlineSeconds; }
+
+        /** True when the handler may yield and this frame's budget is used up. */
+        bool ShouldYield() const;
+
+        /** Parks the handler until the next frame; it must return right after. */
+        void Yield(TSharedRef<FResumeState> State);
+
+        /**
+         * Whether the handler may Suspend: true for a command the scheduler runs on its own, false
+         * for batch entries. Set by the bridge.
+         */
+        void SetSuspendable(bool bInSuspendable) { bSuspendable = bInSuspendable; }
+        bool CanSuspend() const { return bSuspendable; }
+
+        /**
+         * Parks the handler until the next frame while it waits for something it started; it must
+         * return right after and poll again when called back. Unlike Yield it does not depend on
+         * the frame budget, since the handler holds nothing open between frames.
+         */
+        void Suspend(TSharedRef<FResumeState> State);
+
+        /** True (once) if the handler that just returned yielded instead of finishing. */
+        bool ConsumeYield();
+
+        /** Stage of the state waiting for TakeResumeState, or None when there is none. */
+        FName GetResumeStage() const { return ResumeState.IsValid() ? ResumeState->Stage : NAME_None; }
+
+        /** The state passed to Yield on the previous slice, or null on the first one. */
+        template <typename StateType>
+        TSharedPtr<StateType> TakeResumeState()
+        {
+            TSharedPtr<FResumeState> State = MoveTemp(ResumeState);
+            ResumeState.Reset();
+            return StaticCastSharedPtr<StateType>(State);
+        }
+
+        /** Marks the first slice; later calls keep the original time. */
+        void MarkStarted();
+
+        /** Adds one handler slice (batch entries add one each). */
+        void AddHandlerSlice(double StartSeconds, double EndSeconds);
+
+        void AddCheckoutTime(double Seconds) { Timings.CheckoutSeconds += Seconds; }
+
+        /**
+         * Adds one slice's used physical memory at its start, its sampled peak and its end. Slices
+         * chain on what the earlier ones retained, so drift between frames is not counted.
+         */
+        void AddMemorySlice(int64 StartUsedBytes, int64 PeakUsedBytes, int64 EndUsedBytes);
+
+        /** Adds what one mutation's undo transaction grew by (FTransactionManager reports it). */
+        void AddUndoBytes(int64 Bytes) { MemoryUse.UndoBytes += Bytes; MemoryUse.bUndoRecorded = true; }
+
+        const FMemoryUse& GetMemoryUse() const { return MemoryUse; }
+
+        /** Read once the command has completed. */
+        const FTimings& GetTimings() const { return Timings; }
+
+        /** Context of the command currently executing on the game thread, or null. */
+        static FCommandContext* GetActive();
+
+        /** True when the command currently executing on the game thread has been cancelled. */
+        static bool IsActiveCancelled();
+
+        /** ReportProgress on the active context, if there is one. */
+        static void ReportActiveProgress(int32 Done, int32 Total, const FString& Phase);
+
+        /** Binds a context as active for the duration of a command dispatch (game thread only). */
+        class UNREALMCPEDITOR_API FScopedActive
+        {
+        public:
+            explicit FScopedActive(FCommandContext* InContext);
+            ~FScopedActive();
+
+        private:
+            FCommandContext* Previous;
+        };
+
+    private:
+        FString RequestId;
+        FThreadSafeBool bCancelled;
+        double DeadlineUnixMs;
+        ECommandPriority Priority;
+        bool bHasPriority;
+        FString SessionId;
+        float Share;
+        bool bAuditRequested;
+        bool bUndoFreeRequested;
+        FFrameSink ProgressSink;
+        FFrameSink PushSink;
+        bool bPushAttachments;
+        bool bAttachmentsAllowed;
+        TSharedPtr<FAttachmentList, ESPMode::ThreadSafe> Attachments;
+        FAttachmentListPtr RequestAttachments;
+        FString LastProgressPhase;
+        double LastProgressSeconds;
+        double YieldDeadlineSeconds;
+        TSharedPtr<FResumeState> ResumeState;
+        bool bYielded;
+        bool bSuspendable;
+        FTimings Timings;
+        FMemoryUse MemoryUse;
+
+        static FCommandContext* ActiveContext;
+    };
+}
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+    /** Scheduler lane; each frame drains the lanes in this order. */
+    enum class ECommandPriority : uint8
+    {
+        /** Liveness and other near-free commands (ping). */
+        Control,
+        /** Ordinary agent steps. */
+        Interactive,
+        /** Long jobs (imports, scans, batches) that may wait behind everything else. */
+        Bulk
+    };
+
+    /** Parses meta.priority ("control", "interactive", "bulk"; case-insensitive). */
+    bool LexTryParseString(ECommandPriority& OutPriority, const TCHAR* Text);
+    const TCHAR* LexToString(ECommandPriority Priority);
+
+    /**
+     * Game-thread command queue drained once per frame within a time budget, so a burst of
+     * requests (or one long batch) is spread over several frames instead of hitching one.
+     *
+     * A step that does not finish (a resumable handler that yielded) returns false and is
+     * queued again behind its session's commands that arrived meanwhile. At least one step runs
+     * every frame, so a budget smaller than a single command only delays, never starves, the queue.
+     *
+     * Commands wait in priority lanes: control before interactive before bulk. A lane passed
+     * over for MaxSkippedFrames frames runs one step first, so a steady stream of interactive
+     * work cannot starve a queued bulk job.
+     *
+     * Within a lane each session has its own FIFO, and the sessions are served by deficit
+     * round-robin: every round a session is credited Quantum times its share in cost, and runs
+     * queued commands while their cost fits its credit. A session flooding the lane with bulk
+     * work then delays another session's commands by about one round, not by its whole backlog.
+     * With a single session this is plain FIFO.
+     *
+     * Each command is queued with an estimated cost (see GetDefaultCost), and the queue keeps
+     * the total outstanding plus the rate recent frames have worked it off, so the bridge can
+     * refuse new work with an honest retry delay instead of letting the backlog grow.
+     *
+     * Frames that end with every lane empty and budget left over hand the rest of the slice to
+     * the idle step, for speculative work nobody waits for (see FResponsePrefetcher).
+     */
+    class UNREALMCPEDITOR_API FCommandScheduler
+    {
+    public:
+        /**
+         * Runs one slice of a queued command on the game thread. SliceDeadline is the
+         * FPlatformTime::Seconds() value at which yielding handlers should stop. Returns true
+         * once the command has completed.
+         */
+        typedef TFunction<bool(double SliceDeadline)> FStep;
+
+        /** Runs speculative work until SliceDeadline, on a frame with nothing queued. */
+        typedef TFunction<void(double SliceDeadline)> FIdleStep;
+
+        FCommandScheduler();
+        ~FCommandScheduler();
+
+        /** Binds the per-frame ticker (game thread). */
+        void Start();
+
+        /** Unbinds the ticker and drops queued commands without running them (game thread). */
+        void Stop();
+
+        /** Milliseconds of game-thread time the queue may use per frame. */
+        void SetBudgetMs(double InBudgetMs);
+
+        /** Sets (or with null clears) the step that gets the unused budget of idle frames (game thread). */
+        void SetIdleStep(FIdleStep InIdleStep);
+
+        /** Bounds for a session's share; the default is 1. */
+        static constexpr float MinShare = 0.1f;
+        static constexpr float MaxShare = 16.0f;
+
+        /**
+         * Queues Step in Priority's lane for the next frame, counting Cost until it completes. Steps
+         * with the same SessionId share one FIFO, served against the others in proportion to Share
+         * (the latest value queued for the session wins). Safe from any thread.
+         */
+        void Enqueue(ECommandPriority Priority, FStep Step, int32 Cost = 1, const FString& SessionId = FString(), float Share = 1.0f);
+
+        /** Commands waiting for (or resuming on) a later frame, across all lanes. */
+        int32 GetQueuedCount() const;
+
+        /** Estimated cost of those commands. */
+        int32 GetQueuedCost() const;
+
+        /** Seconds the queue needs to work off Cost at the rate recent frames completed it. Safe from any thread. */
+        double EstimateDrainSeconds(int32 Cost) const;
+
+        /** Cost of a command in Priority's lane: 0 for control, 1 for interactive, 8 for bulk. */
+        static int32 GetDefaultCost(ECommandPriority Priority);
+
+    private:
+        static constexpr int32 NumLanes = 3;
+        static constexpr int32 MaxSkippedFrames = 8;
+        /** Cost credited per round at share 1: one bulk command, or eight interactive ones. */
+        static constexpr double Quantum = 8.0;
+
+        struct FQueuedStep
+        {
+            FStep Step;
+            int32 Cost = 0;
+            FString SessionId;
+            float Share = 1.0f;
+        };
+
+        /** One session's commands in a lane (game thread only). */
+        struct FFlow
+        {
+            FString SessionId;
+            TQueue<FQueuedStep, EQueueMode::Spsc> Steps;
+            float Share = 1.0f;
+            double Deficit = 0.0;
+            /** Whether this round's quantum has been added; cleared when the round moves on. */
+            bool bCredited = false;
+        };
+
+        struct FLane
+        {
+            /** Filled from any thread; moved into Flows on the game thread. */
+            TQueue<FQueuedStep, EQueueMode::Mpsc> Inbox;
+            FThreadSafeCounter QueuedCount;
+            /** Game thread only: sessions with queued steps, in round-robin order. */
+            TArray<TUniquePtr<FFlow>> Flows;
+            /** Game thread only: index in Flows of the session being served. */
+            int32 NextFlow = 0;
+            /** Game thread only: frames in a row this lane had work but ran none of it. */
+            int32 SkippedFrames = 0;
+        };
+
+        bool Tick(float DeltaTime);
+
+        /** Moves steps queued since the last call into their sessions' flows (game thread). */
+        static void AdmitInbox(FLane& Lane);
+
+        /** Runs up to the lane's queued count of steps until SliceDeadline; returns the number run. */
+        int32 DrainLane(FLane& Lane, double SliceDeadline, int32 MaxSteps);
+
+        FLane Lanes[NumLanes];
+        FThreadSafeCounter QueuedCost;
+        /** Game thread only: cost completed during the current Tick. */
+        int32 CompletedCostThisTick = 0;
+        /** Smoothed cost completed per second over the frames that had work queued. */
+        std::atomic<double> CompletedCostPerSecond;
+        double BudgetSeconds;
+        FIdleStep IdleStep;
+        FTSTicker::FDelegateHandle TickerHandle;
+    };
+}
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commands/BlueprintCompileQueue.h"
+#include "Containers/Ticker.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/ObjectSaveContext.h"
+
+class AActor;
+class FJsonObject;
+class UPackage;
+struct FAssetData;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+    /**
+     * Server-push notifications for editor changes, so agents subscribe instead of polling
+     * get_actors_in_level / asset.find. One hub per bridge binds the editor delegates once;
+     * each topic's handler returns immediately unless some session subscribed to it.
+     *
+     * Events raised during a frame are coalesced per topic and key (an actor dragged across
+     * many ticks reports its latest transform once) and pushed at the end of the frame as
+     *   event { topic, seq, events: [...], dropped? }
+     * Encoding and sending happen off the game thread.
+     */
+    class UNREALMCPEDITOR_API FEventHub : public TSharedFromThis<FEventHub, ESPMode::ThreadSafe>
+    {
+    public:
+        /** Delivers one event frame; returns false if the subscriber's connection is gone. */
+        typedef TFunction<bool(const TSharedRef<FJsonObject>&)> FEventSink;
+
+        /** Topic names accepted by subscribe, e.g. "asset.added" or "actor.moved". */
+        static const TArray<FString>& GetTopicNames();
+
+        FEventHub();
+        ~FEventHub();
+
+        /** Binds the editor delegates and the flush ticker (game thread). */
+        void Start();
+
+        /** Unbinds everything and drops pending events (game thread). */
+        void Stop();
+
+        /**
+         * Adds Topics to SubscriberKey's subscription and (re)binds its sink. Unknown names are
+         * returned in OutUnknownTopics and ignored. Safe from any thread.
+         */
+        void Subscribe(const FString& SubscriberKey, const TArray<FString>& Topics, FEventSink Sink, TArray<FString>& OutUnknownTopics);
+
+        /** Removes Topics (all of them when empty) from SubscriberKey. Safe from any thread. */
+        void Unsubscribe(const FString& SubscriberKey, const TArray<FString>& Topics);
+
+        /** Topics SubscriberKey currently receives. */
+        TArray<FString> GetSubscribedTopics(const FString& SubscriberKey) const;
+
+        /**
+         * Where cache.invalidated reads the response cache generation; a negative value means
+         * nothing may be cached. Polled once per frame while someone subscribes (game thread).
+         */
+        void SetCacheGenerationSource(TFunction<int64()> Source) { CacheGenerationSource = MoveTemp(Source); }
+
+    private:
+        struct FSubscriber
+        {
+            uint32 TopicMask = 0;
+            FEventSink Sink;
+        };
+
+        struct FPendingTopic
+        {
+            TArray<TSharedPtr<FJsonObject>> Events;
+            TMap<FString, int32> IndexByKey;
+            int32 Dropped = 0;
+        };
+
+        bool IsTopicActive(int32 Topic) const;
+        void AddEvent(int32 Topic, const FString& Key, const TSharedRef<FJsonObject>& Event);
+        void RecomputeActiveMask();
+        bool Flush(float DeltaTime);
+
+        void HandleAssetAdded(const FAssetData& AssetData);
+        void HandleAssetRemoved(const FAssetData& AssetData);
+        void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+        void HandleActorAdded(AActor* Actor);
+        void HandleActorDeleted(AActor* Actor);
+        void HandleActorMoved(AActor* Actor);
+        void HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext);
+        void HandleBlueprintCompiled(const FBlueprintCompileQueue::FReport& Report);
+        void PollCacheGeneration();
+
+        mutable FCriticalSection SubscribersMutex;
+        TMap<FString, FSubscriber> Subscribers;
+        FThreadSafeCounter ActiveTopicMask;
+
+        /** Game thread only. */
+        TArray<FPendingTopic> PendingTopics;
+        bool bHasPending;
+        int64 NextSequence;
+        TFunction<int64()> CacheGenerationSource;
+        /** Last generation pushed on cache.invalidated; a new subscriber gets the current one first. */
+        int64 LastCacheGeneration;
+
+        bool bStarted;
+        FTSTicker::FDelegateHandle TickerHandle;
+        FDelegateHandle AssetAddedHandle;
+        FDelegateHandle AssetRemovedHandle;
+        FDelegateHandle AssetRenamedHandle;
+        FDelegateHandle ActorAddedHandle;
+        FDelegateHandle ActorDeletedHandle;
+        FDelegateHandle ActorMovedHandle;
+        FDelegateHandle PackageSavedHandle;
+        FDelegateHandle BlueprintCompiledHandle;
+    };
+}
+}
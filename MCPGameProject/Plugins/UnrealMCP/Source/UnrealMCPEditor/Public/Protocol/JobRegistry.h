@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/SharedPointer.h"
+
+class FJsonObject;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+    class FCommandContext;
+
+    /**
+     * Commands started with job.start: they run on the command scheduler like any other request,
+     * but belong to the editor rather than to the connection that started them, so a client can
+     * disconnect, reconnect and still poll job.status and fetch job.result.
+     *
+     * The response envelope is kept once the command completes, until RetentionSeconds have passed
+     * or MaxFinished newer jobs have finished. Safe from any thread.
+     */
+    class UNREALMCPEDITOR_API FJobRegistry : public TSharedFromThis<FJobRegistry, ESPMode::ThreadSafe>
+    {
+    public:
+        FJobRegistry();
+
+        /** Seconds a finished job is kept for job.result. */
+        void SetRetentionSeconds(double InRetentionSeconds);
+
+        /** A fresh job id, used as the requestId of the command it runs. */
+        static FString MakeJobId();
+
+        /** Records a new job running CommandType under Context, which carries its cancel flag and timings. */
+        void Add(const FString& JobId, const FString& CommandType, const TSharedRef<FCommandContext, ESPMode::ThreadSafe>& Context);
+
+        /** Progress reported by the job's handler (game thread, through the context's progress sink). */
+        void SetProgress(const FString& JobId, int32 Done, int32 Total, const FString& Phase);
+
+        /** Stores the job's response envelope; the job counts as finished from here on. */
+        void Complete(const FString& JobId, const TSharedRef<FJsonObject>& Response);
+
+        /**
+         * Asks a queued or running job to stop; it finishes as its command does when cancelled.
+         * Returns the job's status (cancelRequested is false if it had already finished), or null
+         * if the id is unknown.
+         */
+        TSharedPtr<FJsonObject> Cancel(const FString& JobId);
+
+        /** job.status payload, or null if the id is unknown (or expired). */
+        TSharedPtr<FJsonObject> GetStatus(const FString& JobId);
+
+        /**
+         * job.result payload: the finished envelope with every array of its result cut to
+         * [Offset, Offset + Limit). Null with OutErrorCode JOB_NOT_FOUND or JOB_NOT_FINISHED otherwise.
+         */
+        TSharedPtr<FJsonObject> GetResultPage(const FString& JobId, int32 Offset, int32 Limit, FString& OutErrorCode);
+
+    private:
+        static constexpr int32 MaxFinished = 256;
+
+        struct FJob
+        {
+            FString CommandType;
+            TSharedPtr<FCommandContext, ESPMode::ThreadSafe> Context;
+            double CreatedSeconds = 0.0;
+            double FinishedSeconds = 0.0;
+            int32 Done = 0;
+            int32 Total = 0;
+            FString Phase;
+            /** Null until the command completes. */
+            TSharedPtr<FJsonObject> Response;
+        };
+
+        /** "queued", "running", "succeeded", "failed" or "cancelled". */
+        static const TCHAR* GetState(const FJob& Job);
+
+        static TSharedRef<FJsonObject> MakeStatusLocked(const FString& JobId, const FJob& Job, double NowSeconds);
+
+        /** Drops finished jobs past the retention window or beyond MaxFinished (lock held). */
+        void PruneLocked(double NowSeconds);
+
+        FCriticalSection Mutex;
+        TMap<FString, FJob> Jobs;
+        /** Finished job ids with their completion time, oldest first. */
+        TArray<TPair<FString, double>> FinishedOrder;
+        double RetentionSeconds;
+    };
+}
+}
@@ -2,8 +2,10 @@
 
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
+#include "Protocol/Transport.h"
+
+#include <atomic>
 
-class FSocket;
 class FJsonObject;
 
 namespace UnrealMCP
@@ -17,11 +19,47 @@ namespace Protocol
         ReadTimeout,
         WriteError,
         UnsupportedMessage,
-        InternalError
+        InternalError,
+        Cancelled,
+        DeadlineExceeded,
+        /** The game-thread queue is full; details carry retryAfterMs. */
+        Overloaded,
+        /** Params do not match the command's schema; details carry the offending path. */
+        InvalidParams
     };
 
     FString LexToString(EProtocolErrorCode Code);
 
+    /** Payload encoding negotiated in the handshake. The handshake itself is always JSON. */
+    enum class EFrameEncoding : uint8
+    {
+        Json,
+        Cbor
+    };
+
+    FString LexToString(EFrameEncoding Encoding);
+    bool LexTryParseString(EFrameEncoding& OutEncoding, const TCHAR* Buffer);
+
+    /** Per-connection framing state negotiated in the handshake. */
+    struct FFrameOptions
+    {
+        EFrameEncoding Encoding = EFrameEncoding::Json;
+
+        /** zlib compression was negotiated; compressed frames set the high bit of the length prefix. */
+        bool bCompression = false;
+
+        /** Payloads smaller than this are always sent uncompressed so heartbeats stay cheap. */
+        int32 CompressionThreshold = 16 * 1024;
+
+        /**
+         * Binary attachments were negotiated: a frame with the second-highest bit of its length
+         * prefix set carries raw segments after its message (see FAttachments).
+         */
+        bool bAttachments = false;
+    };
+
+    class FSharedMemoryRing;
+
     TSharedRef<FJsonObject> MakeErrorResponse(EProtocolErrorCode Code, const FString& Message, const TSharedPtr<FJsonObject>& Details = nullptr);
 
     struct FProtocolReadResult
@@ -32,22 +70,50 @@ namespace Protocol
         bool bConnectionClosed = false;
         bool bLegacyFallback = false;
         FString Error;
+        /** Decoded payload size of the frame, after decompression; 0 for legacy messages. */
+        int64 PayloadBytes = 0;
     };
 
-    bool WriteFramedJson(FSocket& Socket, const TSharedRef<FJsonObject>& Message, FString& OutError, double TimeoutSeconds = 10.0);
-    bool WriteLegacyJson(FSocket& Socket, const TSharedRef<FJsonObject>& Message, FString& OutError);
+    /** Encodes Message as a complete frame (length prefix + payload in the given encoding) into OutFrame. */
+    bool EncodeFrame(const TSharedRef<FJsonObject>& Message, TArray<uint8>& OutFrame, FString& OutError, const FFrameOptions& Options = FFrameOptions());
+
+    bool WriteFramedJson(IByteStream& Stream, const TSharedRef<FJsonObject>& Message, FString& OutError, double TimeoutSeconds = 10.0);
+    /** Same as above, but encodes into a caller-owned buffer that is reused across frames. */
+    bool WriteFramedJson(IByteStream& Stream, const TSharedRef<FJsonObject>& Message, TArray<uint8>& ScratchBuffer, FString& OutError, double TimeoutSeconds = 10.0, const FFrameOptions& Options = FFrameOptions());
+    bool WriteLegacyJson(IByteStream& Stream, const TSharedRef<FJsonObject>& Message, FString& OutError);
+
+    /** Reads one frame; segments of an attachment frame are bound to the returned message (FAttachments::Find). */
+    FProtocolReadResult ReadFramedJson(IByteStream& Stream, double TimeoutSeconds, bool bAllowLegacyFallback, const FFrameOptions& Options = FFrameOptions());
+
+    /** Heartbeat messages ({type: ping|pong, ts}); pings carry the current Unix time in ms. */
+    TSharedRef<FJsonObject> MakePingMessage();
+    TSharedRef<FJsonObject> MakePongMessage(int64 Timestamp);
 
-    FProtocolReadResult ReadFramedJson(FSocket& Socket, double TimeoutSeconds, bool bAllowLegacyFallback);
+    /** Session reported in the handshake ack; a resolver may resume an earlier one from its token. */
+    struct FHandshakeSession
+    {
+        FString SessionId;
+
+        /** Token the client presents on its next connect to resume; empty when resumption is off. */
+        FString ResumeToken;
+
+        bool bResumed = false;
+    };
 
     class UNREALMCPEDITOR_API FProtocolClient
     {
     public:
-        explicit FProtocolClient(const TSharedPtr<FSocket>& InSocket);
+        explicit FProtocolClient(const FByteStreamPtr& InStream);
+        ~FProtocolClient();
 
-        bool IsValid() const { return Socket.IsValid(); }
+        bool IsValid() const { return Stream.IsValid(); }
 
         bool PerformHandshake(const FString& EngineVersion, const FString& PluginVersion, const FString& SessionId, FString& OutError, double TimeoutSeconds = 10.0);
 
+        /** Maps the handshake's resumeToken (possibly empty) to the session the ack reports. Without one, SessionId is always fresh. */
+        typedef TFunction<FHandshakeSession(const FString& RequestedResumeToken)> FSessionResolver;
+        void SetSessionResolver(FSessionResolver InResolver) { SessionResolver = MoveTemp(InResolver); }
+
         bool SendMessage(const TSharedPtr<FJsonObject>& Message, FString& OutError, double TimeoutSeconds = 10.0);
         bool SendMessage(const TSharedRef<FJsonObject>& Message, FString& OutError, double TimeoutSeconds = 10.0)
         {
@@ -55,20 +121,71 @@ namespace Protocol
         }
         FProtocolReadResult ReceiveMessage(double TimeoutSeconds, bool bAllowLegacyFallback = false);
 
-        bool SendPing(FString& OutError);
-        bool SendPong(int64 Timestamp, FString& OutError);
+        /**
+         * Encodes Message with the negotiated encoding into OutFrame, leaving the length prefix for
+         * SendEncoded; attachments bound to Message go after it when negotiated. Only reads
+         * handshake state, so any thread may call it once the handshake is done.
+         */
+        bool EncodeOutbound(const TSharedRef<FJsonObject>& Message, TArray<uint8>& OutFrame, FString& OutError) const;
+
+        /**
+         * Sends a frame produced by EncodeOutbound: via the shared-memory ring when active and the
+         * payload is large, otherwise size-checked, compressed if negotiated and written inline.
+         * Callers serialize sends.
+         */
+        bool SendEncoded(TArray<uint8>& Frame, FString& OutError, double TimeoutSeconds = 10.0);
+
+        /** Waits until at least one byte is readable. Returns false on timeout or stream error. */
+        bool WaitForReadable(double TimeoutSeconds) const;
+
+        /** Maximum requests a client may keep in flight; advertised as windowMax in the handshake ack. */
+        void SetWindowMax(int32 InWindowMax) { WindowMax = FMath::Max(1, InWindowMax); }
+        int32 GetWindowMax() const { return WindowMax; }
+
+        /** Whether binary (CBOR) payloads may be negotiated; JSON is always accepted. */
+        void SetAllowBinaryEncoding(bool bInAllow) { bAllowBinaryEncoding = bInAllow; }
+        EFrameEncoding GetEncoding() const { return FrameOptions.Encoding; }
+
+        /** Minimum payload size for zlib frame compression; 0 disables compression negotiation. */
+        void SetCompressionThreshold(int32 InThresholdBytes) { CompressionThresholdBytes = FMath::Max(0, InThresholdBytes); }
+        bool IsCompressionEnabled() const { return FrameOptions.bCompression; }
+
+        /** Whether the client asked for binary attachments; handlers inline base64 otherwise. */
+        bool IsAttachmentsEnabled() const { return FrameOptions.bAttachments; }
+
+        /** Size of the shared-memory ring offered to same-host clients; 0 disables it. */
+        void SetSharedMemoryRingBytes(int32 InRingBytes) { SharedMemoryRingBytes = FMath::Max(0, InRingBytes); }
+
+        /**
+         * Called once the client reports it has mapped the ring (shm/ready). From then on large
+         * payloads go through the ring and the socket carries only a shm/frame descriptor.
+         * Callers serialize this with sends.
+         */
+        void ActivateSharedMemory();
+        bool IsSharedMemoryActive() const { return bSharedMemoryActive; }
 
         double GetLastReceivedTime() const { return LastReceivedTime; }
-        double GetLastSentTime() const { return LastSentTime; }
+        double GetLastSentTime() const { return LastSentTime.load(std::memory_order_relaxed); }
 
     private:
-        bool SendHeartbeatMessage(const FString& Type, int64 Timestamp, FString& OutError);
 
-        TSharedPtr<FSocket> Socket;
+        FByteStreamPtr Stream;
         double LastReceivedTime;
-        double LastSentTime;
+        /** Written by whichever thread sends (the connection's writer), read by the reader for heartbeats. */
+        std::atomic<double> LastSentTime;
         bool bHandshakeCompleted;
         bool bLegacyDetected;
+        int32 WindowMax;
+        bool bAllowBinaryEncoding;
+        int32 CompressionThresholdBytes;
+        FFrameOptions FrameOptions;
+        int32 SharedMemoryRingBytes;
+        TUniquePtr<FSharedMemoryRing> SharedMemory;
+        bool bSharedMemoryActive;
+        FSessionResolver SessionResolver;
+
+        /** Reused encode buffer; callers serialize sends (see FMCPClientConnection::SendMutex). */
+        TArray<uint8> SendBuffer;
     };
 }
 }
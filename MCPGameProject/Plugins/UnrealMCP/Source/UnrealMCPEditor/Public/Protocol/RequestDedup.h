@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+
+class FJsonObject;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+    /**
+     * Editor-wide memory of mutations by requestId, so a retry that reaches the editor through a
+     * new MCP server process, a second server instance or a fresh session does not run twice.
+     * Session records only cover retries within one resumed session.
+     *
+     * A duplicate that arrives while the original is still running waits for it and receives the
+     * same response; one that arrives later is answered from the stored response (flagged
+     * meta.deduplicated) until the window expires. Only successful responses are kept, so a
+     * failed mutation can be retried. A requestId reused with a different command or params is
+     * not treated as a duplicate.
+     */
+    class UNREALMCPEDITOR_API FRequestDedup : public TSharedFromThis<FRequestDedup, ESPMode::ThreadSafe>
+    {
+    public:
+        typedef TFunction<void(TSharedRef<FJsonObject>)> FCompletion;
+
+        enum class EClaim : uint8
+        {
+            /** First sighting: run the command, then call Complete. */
+            Owner,
+            /** The requestId is taken by a different request: run it, but do not call Complete. */
+            Untracked,
+            /** A duplicate: OnComplete was answered from the stored response or queued behind the original. */
+            Joined
+        };
+
+        FRequestDedup();
+
+        /** Seconds a completed response is kept; 0 disables deduplication. */
+        void SetWindowSeconds(double InWindowSeconds);
+        bool IsEnabled() const { return WindowSeconds > 0.0; }
+
+        /** Claims RequestId for CommandType + Params; OnComplete is taken only for Joined. */
+        EClaim Claim(const FString& RequestId, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FCompletion& OnComplete);
+
+        /** Records the claimed request's Response and hands copies to any waiting duplicates. */
+        void Complete(const FString& RequestId, const TSharedRef<FJsonObject>& Response);
+
+    private:
+        static constexpr int32 MaxCompleted = 2048;
+
+        struct FEntry
+        {
+            FSHAHash Fingerprint;
+            /** Null while the original runs. */
+            TSharedPtr<FJsonObject> Response;
+            TArray<FCompletion> Waiters;
+        };
+
+        /** Copy of Stored with a fresh meta, since the connection decorates each response it sends. */
+        static TSharedRef<FJsonObject> MakeReplay(const TSharedRef<FJsonObject>& Stored);
+
+        /** Drops completed entries past the window or beyond MaxCompleted (lock held). */
+        void PruneLocked(double NowSeconds);
+
+        FCriticalSection Mutex;
+        TMap<FString, FEntry> Entries;
+        /** Completed requestIds with their completion time, oldest first. */
+        TArray<TPair<FString, double>> CompletedOrder;
+        double WindowSeconds;
+    };
+}
+}
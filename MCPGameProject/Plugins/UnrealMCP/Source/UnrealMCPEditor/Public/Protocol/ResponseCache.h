@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Templates/SharedPointer.h"
+
+class FJsonObject;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+    /**
+     * Successful responses of repeatable read-only commands (asset.metadata, get_actors_in_level,
+     * sequence.list_bindings, ...), keyed by command and canonicalized params, so a repeated query
+     * is answered on the connection thread without waiting for the editor frame.
+     *
+     * Any editor change that could alter an answer bumps a generation counter: asset registry
+     * updates, object modification and undo/redo, level actors added or removed, package saves,
+     * map changes and PIE, plus every mutation the bridge runs. Entries from an older generation
+     * are never served, a response computed across a bump is not stored, and nothing is cached
+     * while a play session runs.
+     */
+    class UNREALMCPEDITOR_API FResponseCache : public TSharedFromThis<FResponseCache, ESPMode::ThreadSafe>
+    {
+    public:
+        FResponseCache();
+        ~FResponseCache();
+
+        /** Binds the invalidation delegates (game thread). */
+        void Start();
+
+        /** Unbinds them and drops every entry (game thread). */
+        void Stop();
+
+        /** Bounds the cache; 0 disables it. Oldest entries are evicted first. */
+        void SetMaxEntries(int32 InMaxEntries);
+        bool IsEnabled() const { return MaxEntries > 0; }
+
+        /** Key for CommandType with Params; object keys are sorted so field order does not matter. */
+        static FString MakeKey(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+        /** Current generation; capture it before running a command and pass it to Store. */
+        int64 GetGeneration() const { return Generation.GetValue(); }
+
+        /** Copy of the cached response for Key (flagged meta.cached), or null. Safe from any thread. */
+        TSharedPtr<FJsonObject> Find(const FString& Key);
+
+        /** Whether Find would answer Key, without copying the entry. Safe from any thread. */
+        bool Contains(const FString& Key);
+
+        /** Remembers Response (if ok) unless the cache was invalidated since InGeneration. Safe from any thread. */
+        void Store(const FString& Key, int64 InGeneration, const TSharedRef<FJsonObject>& Response);
+
+        /** Forgets every entry. Cheap; safe from any thread. */
+        void Invalidate() { Generation.Increment(); }
+
+        /** Nothing is cached during PIE, and the generation does not follow the play world. */
+        bool IsPlaySessionActive() const { return bPlaySessionActive; }
+
+    private:
+        FCriticalSection Mutex;
+        TMap<FString, TSharedPtr<FJsonObject>> Entries;
+        /** Keys oldest first, for eviction. */
+        TArray<FString> InsertionOrder;
+        /** Generation the entries were computed in. */
+        int64 EntriesGeneration;
+        FThreadSafeCounter64 Generation;
+        int32 MaxEntries;
+        FThreadSafeBool bPlaySessionActive;
+
+        bool bStarted;
+        FDelegateHandle AssetAddedHandle;
+        FDelegateHandle AssetRemovedHandle;
+        FDelegateHandle AssetRenamedHandle;
+        FDelegateHandle AssetUpdatedHandle;
+        FDelegateHandle ObjectModifiedHandle;
+        FDelegateHandle ObjectPropertyChangedHandle;
+        FDelegateHandle ObjectTransactedHandle;
+        FDelegateHandle ActorAddedHandle;
+        FDelegateHandle ActorDeletedHandle;
+        FDelegateHandle PackageSavedHandle;
+        FDelegateHandle MapOpenedHandle;
+        FDelegateHandle BeginPIEHandle;
+        FDelegateHandle EndPIEHandle;
+    };
+}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+#include <atomic>
+
+class FJsonObject;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+    class FResponseCache;
+
+    /**
+     * Speculative follow-up reads. Agents follow some answers with the same reads almost every
+     * time: asset.find with asset.metadata of its top results, sequence.create with
+     * sequence.list_bindings of the new sequence. Those follow-ups are queued here when the first
+     * answer goes out, and run in the command scheduler's idle step (no command queued, frame
+     * budget left) with their answers stored in the response cache, so the follow-up request is
+     * a cache hit instead of a wait for the next frame.
+     *
+     * A follow-up only starts when its command's recent run time fits in what is left of the
+     * slice; one that is already cached, has waited longer than MaxAgeSeconds or would run
+     * during PIE is dropped. Queued, run, hit and dropped counts and the game-thread time spent
+     * are kept for the metrics endpoint, and each run is recorded as the "prefetch" phase.
+     */
+    class UNREALMCPEDITOR_API FResponsePrefetcher : public TSharedFromThis<FResponsePrefetcher, ESPMode::ThreadSafe>
+    {
+    public:
+        /** Runs one read-only command on the game thread and returns its response. */
+        typedef TFunction<TSharedRef<FJsonObject>(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)> FExecutor;
+
+        struct FStats
+        {
+            int64 Queued = 0;
+            int64 Run = 0;
+            int64 Hits = 0;
+            int64 Dropped = 0;
+            double Seconds = 0.0;
+        };
+
+        FResponsePrefetcher(const TSharedRef<FResponseCache, ESPMode::ThreadSafe>& InCache, FExecutor InExecutor);
+
+        /** Follow-ups queued per triggering answer; 0 disables prefetching and drops the queue. */
+        void SetMaxFollowUps(int32 InMaxFollowUps);
+        bool IsEnabled() const { return MaxFollowUps.load(std::memory_order_relaxed) > 0; }
+
+        /** Whether answers to CommandType queue follow-ups. */
+        static bool IsTrigger(const FString& CommandType);
+
+        /** Queues the likely follow-ups of CommandType's Response. Cheap; safe from any thread. */
+        void OnResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FJsonObject& Response);
+
+        /** Counts a response-cache hit on Key if a prefetch stored it. Safe from any thread. */
+        void NoteCacheHit(const FString& Key);
+
+        /** Runs queued follow-ups until SliceDeadline; the scheduler's idle step (game thread). */
+        void RunIdle(double SliceDeadline);
+
+        FStats GetStats() const;
+
+    private:
+        static constexpr int32 MaxPending = 64;
+        static constexpr int32 MaxTrackedKeys = 512;
+        static constexpr double MaxAgeSeconds = 30.0;
+
+        struct FPending
+        {
+            FString CommandType;
+            TSharedPtr<FJsonObject> Params;
+            FString Key;
+            double QueuedAt = 0.0;
+        };
+
+        void Enqueue(const FString& CommandType, const TSharedRef<FJsonObject>& Params, double Now);
+
+        TSharedRef<FResponseCache, ESPMode::ThreadSafe> Cache;
+        FExecutor Executor;
+        std::atomic<int32> MaxFollowUps;
+
+        mutable FCriticalSection Mutex;
+        /** Oldest first. */
+        TArray<FPending> Pending;
+        /** Keys stored by a prefetch and not yet hit, oldest first. */
+        TArray<FString> TrackedKeys;
+        /** Smoothed handler seconds per command, for deciding whether the next one fits. */
+        TMap<FString, double> EstimatedSeconds;
+        FStats Stats;
+    };
+}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Templates/SharedPointer.h"
+
+class FJsonObject;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+    /**
+     * Incremental response channel for a single request. Clients opt in with "stream": true;
+     * handlers running on the game thread then push chunks with WriteChunk instead of holding
+     * the whole payload, and the final envelope is delivered as stream_end.
+     *
+     * Wire frames (all carry requestId and meta.requestId):
+     *   stream_begin { field, contentType }
+     *   stream_chunk { seq, data }
+     *   stream_end   { ok, status, result, error, chunks }
+     *
+     * Frames are queued and written in order by a background drain task, so the game thread
+     * never blocks on the socket.
+     */
+    class UNREALMCPEDITOR_API FResponseStream : public TSharedFromThis<FResponseStream, ESPMode::ThreadSafe>
+    {
+    public:
+        /** Writes one frame to the client; returns false if the connection is gone. */
+        typedef TFunction<bool(const TSharedRef<FJsonObject>&)> FFrameSink;
+
+        FResponseStream(const FString& InRequestId, FFrameSink InSink);
+
+        /** Stream requested by the command currently executing on the game thread, or null. */
+        static FResponseStream* GetActive();
+
+        /** Binds a stream as active for the duration of a command dispatch (game thread only). */
+        class UNREALMCPEDITOR_API FScopedActive
+        {
+        public:
+            explicit FScopedActive(FResponseStream* InStream);
+            ~FScopedActive();
+
+        private:
+            FResponseStream* Previous;
+        };
+
+        /** Opens the stream. Field names the result field the client reassembles the chunks into. */
+        void Begin(const FString& Field, const FString& ContentType);
+
+        /** Queues a chunk of text for the client. Begin must have been called. */
+        void WriteChunk(const FString& Data);
+
+        /** Queues the final envelope (sent as stream_end) behind every chunk already written. */
+        void Finish(const TSharedRef<FJsonObject>& FinalResponse);
+
+        bool HasBegun() const { return bBegun; }
+        int32 GetChunkCount() const { return ChunkCount; }
+
+    private:
+        void Enqueue(const TSharedRef<FJsonObject>& Frame);
+        void ScheduleDrain();
+        void Drain();
+        TSharedRef<FJsonObject> MakeFrame(const TCHAR* Type) const;
+
+        FString RequestId;
+        FFrameSink Sink;
+        FThreadSafeBool bBegun;
+        FThreadSafeBool bDraining;
+        FThreadSafeBool bFailed;
+        int32 ChunkCount;
+        TQueue<TSharedPtr<FJsonObject>, EQueueMode::Mpsc> PendingFrames;
+
+        static FResponseStream* ActiveStream;
+    };
+}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+
+class FSocket;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+    enum class EStreamWait : uint8
+    {
+        Read,
+        Write
+    };
+
+    /**
+     * Byte stream underneath the protocol framing. TCP sockets and same-host IPC channels
+     * (Unix domain sockets, Windows named pipes) implement it, so framing, negotiation and
+     * heartbeats are identical whichever transport a client connects over.
+     *
+     * Streams are non-blocking: Recv/Send report bOutWouldBlock and callers park in Wait.
+     */
+    class UNREALMCPEDITOR_API IByteStream
+    {
+    public:
+        virtual ~IByteStream() = default;
+
+        /** Reads up to MaxBytes. Returns true with OutBytesRead == 0 once the peer has closed. */
+        virtual bool Recv(uint8* Data, int32 MaxBytes, int32& OutBytesRead, bool& bOutWouldBlock) = 0;
+
+        /** Writes up to Length bytes; OutBytesSent may be short. */
+        virtual bool Send(const uint8* Data, int32 Length, int32& OutBytesSent, bool& bOutWouldBlock) = 0;
+
+        /** Blocks until the stream is readable/writable. Returns false on timeout, error or shutdown. */
+        virtual bool Wait(EStreamWait Condition, double TimeoutSeconds) = 0;
+
+        virtual bool IsConnected() const = 0;
+
+        /** Wakes any thread blocked on the stream and refuses further I/O. Safe from any thread. */
+        virtual void Shutdown() = 0;
+
+        virtual void Close() = 0;
+
+        /** Formats the last OS error for Operation, for protocol error messages. */
+        virtual FString DescribeLastError(const TCHAR* Operation) const = 0;
+
+        /** Short transport name for logs: "tcp", "unix" or "pipe". */
+        virtual const TCHAR* GetTransportName() const = 0;
+    };
+
+    typedef TSharedPtr<IByteStream, ESPMode::ThreadSafe> FByteStreamPtr;
+
+    /** Accepts client streams for the server thread. */
+    class UNREALMCPEDITOR_API IStreamListener
+    {
+    public:
+        virtual ~IStreamListener() = default;
+
+        /** Waits up to TimeoutSeconds for a client. Returns null on timeout, error or after Shutdown. */
+        virtual FByteStreamPtr Accept(double TimeoutSeconds) = 0;
+
+        /** Wakes a pending Accept and stops listening. Safe from any thread. */
+        virtual void Shutdown() = 0;
+
+        /** Endpoint description for logs, e.g. "127.0.0.1:12029" or "\\.\pipe\unreal-mcp". */
+        virtual FString Describe() const = 0;
+    };
+
+    typedef TSharedPtr<IStreamListener, ESPMode::ThreadSafe> FStreamListenerPtr;
+
+    /** Wraps a connected socket; the stream shares ownership of it. */
+    UNREALMCPEDITOR_API FByteStreamPtr MakeSocketStream(const TSharedPtr<FSocket>& Socket);
+
+    /** Wraps a bound, listening socket. Accepted sockets get TCP_NODELAY and blocking mode. */
+    UNREALMCPEDITOR_API FStreamListenerPtr MakeSocketListener(const TSharedPtr<FSocket>& ListenerSocket);
+
+    /** Full local IPC endpoint for Name: \\.\pipe\<Name> on Windows, <user temp dir>/<Name>.sock elsewhere. */
+    UNREALMCPEDITOR_API FString GetLocalEndpointPath(const FString& Name);
+
+    /** Creates a same-host listener on the local endpoint. Returns null and sets OutError on failure. */
+    UNREALMCPEDITOR_API FStreamListenerPtr CreateLocalListener(const FString& Name, FString& OutError);
+
+    /** Connects to a local endpoint as a client (used by the settings diagnostics). */
+    UNREALMCPEDITOR_API FByteStreamPtr ConnectLocalStream(const FString& Name, double TimeoutSeconds, FString& OutError);
+}
+}
@@ -8,6 +8,18 @@ class FJsonObject;
 class UNREALMCPEDITOR_API FSequenceExport
 {
 public:
-    /** Exports the structure of a sequence in either JSON or CSV form. */
+    /**
+     * Exports the structure of a sequence in either JSON or CSV form. With outputPath (relative to
+     * Saved/) or a streamed response the text is written as the sequence is walked, not built first.
+     * keyMode picks evaluated keys (the default), raw channel keys with tangents, or baked frames.
+     * format "columnar" writes the keys as binary int32/float32 arrays behind a JSON header.
+     * Results for an unchanged, saved sequence are served from FSequenceExportCache unless cache is false.
+     */
     static TSharedPtr<FJsonObject> Export(const TSharedPtr<FJsonObject>& Params);
+
+    /**
+     * Plays the sequence headless against the editor world over a frame range and returns each
+     * binding's evaluated world transform at every frame, in the columnar container of Export.
+     */
+    static TSharedPtr<FJsonObject> EvaluateRange(const TSharedPtr<FJsonObject>& Params);
 };
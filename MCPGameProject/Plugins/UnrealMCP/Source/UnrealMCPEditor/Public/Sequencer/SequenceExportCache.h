@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+class FJsonObject;
+class ULevelSequence;
+
+/**
+ * sequence.export results kept in Saved/UnrealMCP/SequenceExportCache, so exporting an unchanged
+ * sequence again reads the last result back instead of walking it. An entry is keyed by the export
+ * options and the saved state of the sequence's package and of every sub-sequence package it
+ * reaches. A package with unsaved changes, or one never saved, makes the export uncacheable, so an
+ * edit can never be answered with an older result. Each entry is a body file (the JSON document, the
+ * CSV text or the columnar bytes) and a JSON file with the result fields that go with it. The
+ * oldest entries are deleted past MaxEntries. Game thread only.
+ */
+class FSequenceExportCache
+{
+public:
+    /** Entries kept on disk; storing one more deletes the least recently written. */
+    static constexpr int32 MaxEntries = 200;
+
+    /** The key for Sequence exported with Options; false when a package involved is unsaved or dirty. */
+    static bool MakeKey(ULevelSequence& Sequence, const FString& Options, FString& OutKey);
+
+    /** The stored body file and result fields for Key; false on a miss. */
+    static bool Find(const FString& Key, FString& OutBodyFile, TSharedPtr<FJsonObject>& OutFields);
+
+    /** A writer for a new entry's body, or null if the cache folder cannot be written. */
+    static TUniquePtr<FArchive> BeginStore(const FString& Key);
+
+    /** Publishes the body written through Writer together with Fields; false if the body could not be written. */
+    static bool CommitStore(const FString& Key, TUniquePtr<FArchive> Writer, const TSharedRef<FJsonObject>& Fields);
+
+    /** Drops a body that will not be published (the export failed or was cancelled). */
+    static void AbandonStore(const FString& Key, TUniquePtr<FArchive> Writer);
+};
@@ -8,26 +8,85 @@ class FJsonObject;
 
 /**
  * Helper utilities to execute source control operations in a provider agnostic way.
+ *
+ * The blocking calls (UpdateStatus, Checkout, ...) run the provider synchronously. Callers that
+ * can wait across frames use BeginOperation instead, which returns at once and fills the result
+ * from the provider's completion callback. A background refresh keeps the provider's cached state
+ * of recently checked-out files current, so status reads can come from the cache.
  */
 class UNREALMCPEDITOR_API FSourceControlService
 {
 public:
+        enum class EOperation : uint8
+        {
+                UpdateStatus,
+                Checkout,
+                MarkForAdd,
+                Revert,
+                Submit
+        };
+
+        /** Outcome of an operation; bDone flips on the game thread once the provider has finished. */
+        struct FOperationResult
+        {
+                bool bDone = false;
+                bool bSucceeded = false;
+                bool bCancelled = false;
+                FString Error;
+                TMap<FString, bool> PerFileOk;
+                /** UpdateStatus only. */
+                TMap<FString, FString> PerFileState;
+                TSharedPtr<class ISourceControlOperation, ESPMode::ThreadSafe> ProviderOperation;
+        };
+        typedef TSharedRef<FOperationResult, ESPMode::ThreadSafe> FOperationResultRef;
+
         static bool IsEnabled();
         static bool EnsureProviderReady(FString& OutError);
 
         static bool UpdateStatus(const TArray<FString>& Files, TMap<FString, FString>& OutPerFileState, FString& OutError);
         static bool Checkout(const TArray<FString>& Files, TMap<FString, bool>& OutPerFileOk, FString& OutError);
+
+        /**
+         * Checks out whichever of Files are not already checked out (or added), in one provider
+         * operation. Files known to be writable, from earlier checkouts, UpdateStatus or the
+         * provider's cached state, are reported ok without a server round trip.
+         */
+        static bool EnsureCheckedOut(const TArray<FString>& Files, TMap<FString, bool>& OutPerFileOk, FString& OutError);
         static bool MarkForAdd(const TArray<FString>& Files, TMap<FString, bool>& OutPerFileOk, FString& OutError);
         static bool Revert(const TArray<FString>& Files, TMap<FString, bool>& OutPerFileOk, FString& OutError);
         static bool Submit(const TArray<FString>& Files, const FString& Description, TMap<FString, bool>& OutPerFileOk, FString& OutError);
 
+        /**
+         * Starts Operation on Files (game thread). With bAsync the provider runs it in the background
+         * and the result completes during a later editor tick; otherwise it is complete on return.
+         * Description is for Submit.
+         */
+        static FOperationResultRef BeginOperation(EOperation Operation, const TArray<FString>& Files, const FString& Description, bool bAsync);
+
+        /** Asks the provider to stop a running operation; it still completes, as failed. */
+        static void CancelOperation(const FOperationResultRef& Result);
+
+        /** Status of Files from the provider's cache, without asking the server. */
+        static bool GetCachedStatus(const TArray<FString>& Files, TMap<FString, FString>& OutPerFileState, FString& OutError);
+
+        /** Refreshes the status of recently checked-out files every SourceControlRefreshIntervalSec (game thread). */
+        static void StartStatusRefresh();
+        static void StopStatusRefresh();
+
         static bool AssetPathsToFiles(const TArray<FString>& AssetPaths, TArray<FString>& OutFiles, FString& OutError);
 
         static void AppendResultArray(const TMap<FString, bool>& PerFileResult, TArray<TSharedPtr<FJsonValue>>& OutArray);
         static void AppendStatusArray(const TMap<FString, FString>& PerFileStatus, TArray<TSharedPtr<FJsonValue>>& OutArray);
 
 private:
-        static bool ExecuteSimpleOperation(const TArray<FString>& Files, const TFunctionRef<TSharedRef<class ISourceControlOperation>(void)>& OperationFactory, TMap<FString, bool>& OutPerFileOk, FString& OutError);
+        /** Records the provider's answer in Result and the checked-out cache (game thread). */
+        static void FinishOperation(EOperation Operation, const FOperationResultRef& Result, const TArray<FString>& Files, bool bSucceeded, bool bCancelled);
+        static bool TickStatusRefresh(float DeltaTime);
         static FString DescribeState(const class ISourceControlState& State);
         static bool CollectExistingFiles(const TArray<FString>& Files, TArray<FString>& OutExistingFiles);
+
+        /** Checked-out cache upkeep; entries are normalized file paths. */
+        static bool IsKnownCheckedOut(const FString& File);
+        static void RememberCheckedOut(const TMap<FString, bool>& PerFileOk);
+        static void ForgetCheckedOut(const TArray<FString>& Files);
 };
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bulk-edit scope: while open, the editor UI stops reacting to each MCP mutation and catches up once
+ * at the end. Realtime level viewports are paused through a realtime override, selection changes
+ * are batched into one notification, and the redraws and actor-list refreshes that tools request
+ * are coalesced into one of each when the last scope closes.
+ *
+ * Scopes nest by count. Shared transactions and batches enter one automatically; a client can hold
+ * one across requests with editor.bulk_begin / editor.bulk_end. Game thread only.
+ */
+class UNREALMCPEDITOR_API FBulkEdit
+{
+public:
+        /** Enters a scope for the lifetime of the object. */
+        struct FScope
+        {
+                FScope() { FBulkEdit::Enter(); }
+                ~FScope() { FBulkEdit::Leave(); }
+
+                FScope(const FScope&) = delete;
+                FScope& operator=(const FScope&) = delete;
+        };
+
+        static void Enter();
+
+        /** Leaves a scope; leaving the last one restores the viewports and flushes deferred refreshes. */
+        static void Leave();
+
+        static bool IsActive();
+
+        /** Redraws the level viewports now, or once when the scope closes. */
+        static void RedrawViewports(bool bInvalidateHitProxies);
+
+        /** Broadcasts the level actor list change now, or once when the scope closes. */
+        static void NoteActorListChanged();
+
+        /** Notes a selection change now, or once when the scope closes. */
+        static void NoteSelectionChange();
+
+        /**
+         * Opens the client-held scope. IdleTimeoutSeconds > 0 closes it automatically when no request
+         * touched it for that long, so a client that disappears cannot leave the viewports paused.
+         * Fails if one is already open.
+         */
+        static bool OpenExplicit(double IdleTimeoutSeconds, FString& OutBulkId, FString& OutError);
+
+        /** Closes the client-held scope BulkId. OutDurationSeconds is how long it was open. */
+        static bool CloseExplicit(const FString& BulkId, double& OutDurationSeconds, FString& OutError);
+
+        /** Resets the idle timer of the client-held scope, if any (called per request, on the game thread). */
+        static void TouchExplicit();
+
+private:
+        static void Suspend();
+        static void Resume();
+        static bool TickExplicit(float DeltaTime);
+};
@@ -2,13 +2,77 @@
 
 #include "CoreMinimal.h"
 
-/** Lightweight helper around editor transactions for MCP-driven mutations. */
+class FTransaction;
+
+/**
+ * Lightweight helper around editor transactions for MCP-driven mutations.
+ *
+ * Each mutation normally gets its own undo transaction. While a shared transaction is open
+ * (transaction.begin, or a batch with "transaction": true) mutations join it instead: they skip
+ * their own Begin/End, every object is snapshotted once for the whole group, and the group
+ * undoes as a single step. The editor UI is held in a bulk-edit scope (FBulkEdit) while a shared
+ * transaction is open. Game thread only.
+ *
+ * The bytes each mutation adds to the undo buffer are reported to the active command context.
+ * Once the transactions MCP left in the buffer hold more than MaxUndoMemoryMb, the oldest entries
+ * are dropped. Undo is linear, so dropping an MCP step also drops any older editor step before it.
+ * A trusted request may instead run without undo (BeginUndoFree); the editor's own transactions
+ * (FScopedTransaction in handlers) check IsUndoSuppressed for that.
+ */
 class UNREALMCPEDITOR_API FTransactionManager
 {
 public:
-        /** Begins a new transaction if the editor is available. */
+        /** Begins a new transaction if the editor is available, or joins the open shared one. */
         static void Begin(const FString& TransactionName);
 
-        /** Ends the active transaction if the editor is available. */
+        /** Ends the transaction started by the matching Begin. */
         static void End();
+
+        /** True while a shared transaction is open. */
+        static bool IsSharedOpen();
+
+        /**
+         * Runs the mutations up to the matching EndUndoFree without recording undo. EndUndoFree
+         * clears the editor's undo history, since its older steps would restore objects without
+         * the changes made in between. Fails while a shared transaction is open.
+         */
+        static bool BeginUndoFree(FString& OutError);
+        static void EndUndoFree();
+
+        /** True between BeginUndoFree and EndUndoFree; handlers pass !IsUndoSuppressed() to FScopedTransaction. */
+        static bool IsUndoSuppressed();
+
+        /**
+         * What MCP transactions held in the undo buffer when the last one finished, and what
+         * trimming has dropped. Safe from any thread.
+         */
+        struct FUndoStats
+        {
+                int64 HeldBytes = 0;
+                int32 HeldTransactions = 0;
+                int64 TrimmedBytes = 0;
+                int32 TrimmedTransactions = 0;
+        };
+        static FUndoStats GetUndoStats();
+
+        /**
+         * Opens a shared transaction. IdleTimeoutSeconds > 0 commits it automatically when no
+         * mutation joined it for that long, so a client that disappears cannot hold it forever.
+         * Fails if one is already open.
+         */
+        static bool OpenShared(const FString& TransactionName, double IdleTimeoutSeconds, FString& OutTransactionId, FString& OutError);
+
+        /** Closes the shared transaction TransactionId, keeping its changes. OutMutations counts the mutations that joined it. */
+        static bool CommitShared(const FString& TransactionId, int32& OutMutations, FString& OutError);
+
+        /** Closes the shared transaction TransactionId and undoes everything done inside it. */
+        static bool AbortShared(const FString& TransactionId, int32& OutMutations, FString& OutError);
+
+private:
+        static bool CloseShared(const FString& TransactionId, bool bUndo, int32& OutMutations, FString& OutError);
+        static bool TickShared(float DeltaTime);
+
+        /** Adds the undo transaction MCP just finished to its accounting and trims the buffer if needed. */
+        static void NoteFinished(const FTransaction* Transaction);
+        static void TrimUndoBuffer();
 };
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * transaction.begin / commit / abort: groups the mutations sent between them into one undo
+ * transaction (see FTransactionManager). editor.bulk_begin / bulk_end: holds the editor UI in a
+ * bulk-edit scope between them (see FBulkEdit).
+ */
+class UNREALMCPEDITOR_API FTransactionTools
+{
+public:
+    static TSharedPtr<FJsonObject> Begin(const TSharedPtr<FJsonObject>& Params);
+    static TSharedPtr<FJsonObject> Commit(const TSharedPtr<FJsonObject>& Params);
+    static TSharedPtr<FJsonObject> Abort(const TSharedPtr<FJsonObject>& Params);
+    static TSharedPtr<FJsonObject> BulkBegin(const TSharedPtr<FJsonObject>& Params);
+    static TSharedPtr<FJsonObject> BulkEnd(const TSharedPtr<FJsonObject>& Params);
+};
@@ -6,7 +6,10 @@
 #include "SocketSubsystem.h"
 #include "Interfaces/IPv4/IPv4Address.h"
 #include "IPAddress.h"
+#include "Containers/Ticker.h"
 #include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
 #include "UnrealMCPBridge.generated.h"
 
 class FMCPServerRunnable;
@@ -19,6 +22,26 @@ class FUnrealMCPProjectCommands;
 class FUnrealMCPUMGCommands;
 class FUnrealMCPSourceControlCommands;
 class FContentTools;
+class FMCPCommandRegistry;
+struct FMCPCommandDescriptor;
+class FMetricsEndpoint;
+class FStallWatchdog;
+
+namespace UnrealMCP
+{
+namespace Protocol
+{
+        class FCommandContext;
+        class FCommandScheduler;
+        class FEventHub;
+        class FJobRegistry;
+        class FRequestDedup;
+        class FResponseCache;
+        class FResponsePrefetcher;
+        class FResponseStream;
+        class IStreamListener;
+}
+}
 
 /**
  * Editor subsystem for MCP Bridge
@@ -44,15 +67,154 @@ public:
 	void StopServer();
 	bool IsRunning() const { return bIsRunning; }
 
+        /** True when no client is connected and no command is queued or parked; UnrealMCPServe exits after IdleTimeout of it. */
+        bool IsIdle();
+
 	// Command execution
+        /** Runs a command on the game thread and blocks the calling (non game) thread until it completes. */
         FString ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& RequestId);
 
+        /**
+         * Queues a command for the game thread and invokes OnComplete (on the game thread) with the response envelope.
+         * The queue is drained within GameThreadBudgetMs per frame; read-only handlers may yield and resume next frame.
+         * Commands registered with AnyThread affinity (registry reads) instead run and complete on a worker thread once
+         * the asset registry has finished its initial scan, unless bRunRegistryQueriesOffGameThread is off.
+         * Cacheable commands whose answer is still in the response cache complete immediately, on the calling thread.
+         * A mutation whose RequestId already ran (or is running) is answered with that run's response instead.
+         * Ownership of the object passes to the callback, which may decorate it (meta) before encoding it once for the wire.
+         * When Stream is set it is bound as the active stream while the handler runs, so handlers can write chunks incrementally.
+         * When Context is set it is bound as the active command context; a command cancelled before the game thread picks it
+         * up is answered CANCELLED, and one whose deadline has passed DEADLINE_EXCEEDED, without running.
+         */
+        void ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& RequestId, TFunction<void(TSharedRef<FJsonObject>)> OnComplete,
+                TSharedPtr<UnrealMCP::Protocol::FResponseStream, ESPMode::ThreadSafe> Stream = nullptr,
+                TSharedPtr<UnrealMCP::Protocol::FCommandContext, ESPMode::ThreadSafe> Context = nullptr);
+
+        /** Server-push subscriptions shared by every connection. Null before Initialize and after Deinitialize. */
+        TSharedPtr<UnrealMCP::Protocol::FEventHub, ESPMode::ThreadSafe> GetEventHub() const { return EventHub; }
+
 private:
+        TSharedRef<FJsonObject> ExecuteCommandOnGameThread(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+        /** CANCELLED / DEADLINE_EXCEEDED envelope for a command that should no longer start, or null to run it. */
+        static TSharedPtr<FJsonObject> MakeNotStartedResponse(const FString& CommandType, const FString& RequestId, const UnrealMCP::Protocol::FCommandContext* Context);
+
+        /**
+         * OVERLOADED envelope, with retryAfterMs, when queueing one more command of Cost would take the
+         * game-thread queue past MaxQueuedCommands or MaxQueuedCost; null to admit it. Control-lane
+         * commands are always admitted, so ping, cancel and job.status keep working under load.
+         */
+        TSharedPtr<FJsonObject> MakeOverloadedResponse(const FString& CommandType, const FString& RequestId, UnrealMCP::Protocol::ECommandPriority Priority, int32 Cost) const;
+
+        /** INVALID_PARAMS envelope, with the offending path, when Params fail Command's schema; null when they pass or it has none. */
+        static TSharedPtr<FJsonObject> MakeInvalidParamsResponse(const FMCPCommandDescriptor& Command, const TSharedPtr<FJsonObject>& Params, const FString& RequestId);
+
+        /** Refreshes the write gate policy and, while running, the scheduler budget and cache, dedup and job limits (game thread). */
+        void HandleRuntimeConfigChanged();
+
+        /** Marks the asset registry's initial scan as finished and releases requests parked by waitForScan (game thread). */
+        void HandleAssetRegistryFilesLoaded();
+
+        /**
+         * Parks a request carrying "waitForScan": true until the initial registry scan finishes or
+         * "scanTimeoutMs" passes; nothing blocks meanwhile. False if the scan is already done.
+         */
+        bool ParkUntilScanFinished(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& RequestId, TFunction<void(TSharedRef<FJsonObject>)>& OnComplete,
+                TSharedPtr<UnrealMCP::Protocol::FResponseStream, ESPMode::ThreadSafe>& Stream,
+                TSharedPtr<UnrealMCP::Protocol::FCommandContext, ESPMode::ThreadSafe>& Context);
+
+        /** Dispatches parked requests: all of them, or only those whose timeout has passed. */
+        void ReleaseScanWaiters(bool bOnlyExpired);
+
+        /** Runs every entry of a batch envelope sequentially inside the current game-thread task. */
+        TSharedRef<FJsonObject> ExecuteBatch(const TSharedPtr<FJsonObject>& Params);
+
+        /**
+         * Checks out, in one source control operation, the target packages of every batch entry
+         * that the gate would let mutate, so the entries find them already checked out.
+         */
+        void PrefetchBatchCheckouts(const TArray<TSharedPtr<FJsonValue>>& Commands);
+
+        /** job.start: queues the wrapped command under a fresh job id and answers with the id straight away. */
+        TSharedPtr<FJsonObject> HandleJobStart(const TSharedPtr<FJsonObject>& Params);
+
+        /**
+         * editor.warmup: loads the modules of the families named in "families" ("*" for all) and builds
+         * the registry-backed indexes, so a new client's first real command does not wait for them.
+         */
+        TSharedPtr<FJsonObject> HandleWarmup(const TSharedPtr<FJsonObject>& Params);
+
+        /**
+         * Creates the command handler instances and CommandRegistry on the first StartServer, so the
+         * class default object and editors that never serve skip them. Game thread only.
+         */
+        void EnsureCommandsRegistered();
+
+        /** Fills CommandRegistry from the command handler instances and the static tool classes. */
+        void RegisterCommands();
+
+        /** Gates, dispatches and wraps a single command into the response envelope (ok/status/result/error/audit). */
+        TSharedRef<FJsonObject> BuildCommandResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+        /** Binds the TCP listener from ServerHost/ServerPort; the local IPC transport skips this. */
+        bool StartTcpListener(const UUnrealMCPSettings& Settings, TSharedPtr<UnrealMCP::Protocol::IStreamListener, ESPMode::ThreadSafe>& OutListener);
+
 	// Server state
 	bool bIsRunning;
 	TSharedPtr<FSocket> ListenerSocket;
 	TSharedPtr<FSocket> ConnectionSocket;
 	FRunnableThread* ServerThread;
+	FMCPServerRunnable* ServerRunnable;
+        TSharedPtr<UnrealMCP::Protocol::FEventHub, ESPMode::ThreadSafe> EventHub;
+
+        /** Game-thread commands wait here and are drained each frame within GameThreadBudgetMs. */
+        TSharedPtr<UnrealMCP::Protocol::FCommandScheduler, ESPMode::ThreadSafe> CommandScheduler;
+
+        /** Set once the asset registry finished its initial scan; read by connection threads. */
+        FThreadSafeBool bAssetRegistryReady;
+        FDelegateHandle AssetRegistryFilesLoadedHandle;
+        bool bRegistryQueriesOffGameThread = true;
+
+        /** Admission limits for the game-thread queue (MaxQueuedCommands / MaxQueuedCost settings); 0 is unlimited. */
+        int32 MaxQueuedCommands = 0;
+        int32 MaxQueuedCost = 0;
+
+        struct FScanWaiter
+        {
+                FString CommandType;
+                TSharedPtr<FJsonObject> Params;
+                FString RequestId;
+                TFunction<void(TSharedRef<FJsonObject>)> OnComplete;
+                TSharedPtr<UnrealMCP::Protocol::FResponseStream, ESPMode::ThreadSafe> Stream;
+                TSharedPtr<UnrealMCP::Protocol::FCommandContext, ESPMode::ThreadSafe> Context;
+                double DeadlineSeconds = 0.0;
+        };
+
+        /** Requests waiting for the initial scan; guarded by ScanWaitersLock, which also orders them against bAssetRegistryReady. */
+        FCriticalSection ScanWaitersLock;
+        TArray<FScanWaiter> ScanWaiters;
+        FTSTicker::FDelegateHandle ScanWaitTickerHandle;
+
+        /** Repeatable read-only responses, dropped on every editor change; see FResponseCache. */
+        TSharedPtr<UnrealMCP::Protocol::FResponseCache, ESPMode::ThreadSafe> ResponseCache;
+
+        /** Likely follow-up reads run in idle game-thread time into ResponseCache; see FResponsePrefetcher. */
+        TSharedPtr<UnrealMCP::Protocol::FResponsePrefetcher, ESPMode::ThreadSafe> ResponsePrefetcher;
+
+        /** Mutations by requestId across every session; see FRequestDedup. */
+        TSharedPtr<UnrealMCP::Protocol::FRequestDedup, ESPMode::ThreadSafe> RequestDedup;
+
+        /** Commands started with job.start, kept past the connection that started them; see FJobRegistry. */
+        TSharedPtr<UnrealMCP::Protocol::FJobRegistry, ESPMode::ThreadSafe> JobRegistry;
+
+        /** Times each game-thread command slice and logs the slow ones; see FStallWatchdog. */
+        TSharedPtr<FStallWatchdog, ESPMode::ThreadSafe> StallWatchdog;
+
+        /** OpenMetrics scrape route, present while the server runs with MetricsHttpPort set. */
+        TSharedPtr<FMetricsEndpoint> MetricsEndpoint;
+
+        /** HandleRuntimeConfigChanged, bound to FUnrealMCPRuntimeConfig::OnChanged. */
+        FDelegateHandle SettingsChangedHandle;
 
 	// Server configuration
 	FIPv4Address ServerAddress;
@@ -66,4 +228,7 @@ private:
         TSharedPtr<FUnrealMCPUMGCommands> UMGCommands;
         TSharedPtr<FUnrealMCPSourceControlCommands> SourceControlCommands;
         TSharedPtr<FContentTools> ContentTools;
+
+        /** Command name -> handler and gate metadata, built once by EnsureCommandsRegistered. */
+        TSharedPtr<FMCPCommandRegistry> CommandRegistry;
 };
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleInterface.h"
 
+class IConsoleObject;
+
 class FUnrealMCPEditorModule : public IModuleInterface
 {
 public:
@@ -12,4 +14,8 @@ public:
 private:
     bool bSettingsRegistered = false;
     bool bCustomizationRegistered = false;
+    IConsoleObject* BenchmarkCommand = nullptr;
+    IConsoleObject* ProtocolBenchmarkCommand = nullptr;
+    /** Re-initializes the JSON logger when its settings change. */
+    FDelegateHandle ConfigChangedHandle;
 };
@@ -39,13 +39,27 @@ public class UnrealMCPEditor : ModuleRules
             "PropertyEditor",
             "ContentBrowser",
             "BlueprintGraph",
+            "Kismet",              // FindInBlueprintManager
             "KismetCompiler",
             "Sockets",
             "Networking",
+            "HTTPServer",
+            "Cbor",
             "AssetTools",
+            "Foliage",
             "Niagara",
             "NiagaraCore",
-            "CinematicCamera"
+            "AudioExtensions",     // FAudioParameter, ISoundGenerator
+            "MetasoundEngine",
+            "MetasoundFrontend",
+            "MetasoundGraphCore",
+            "CinematicCamera",
+            "InterchangeCore",
+            "InterchangeEngine",
+            "InterchangePipelines",
+            "RHI",
+            "RenderCore",
+            "ImageWrapper"
         });
 
         // Inclut les headers publics/privés du module runtime "UnrealMCP" via des chemins robustes.
@@ -0,0 +1,173 @@
+"""Minimal CBOR (RFC 8949) codec for Unreal MCP frame payloads.
+
+Only the JSON data model is supported: maps with text keys, arrays, text strings,
+integers, floats, booleans and null. This mirrors FrameCodec.cpp on the editor side.
+"""
+
+from __future__ import annotations
+
+import struct
+from typing import Any, Tuple
+
+_MAX_DEPTH = 64
+
+
+class CborError(ValueError):
+    """Raised when a payload cannot be encoded or decoded."""
+
+
+def _encode_head(major: int, value: int, out: bytearray) -> None:
+    if value < 24:
+        out.append((major << 5) | value)
+    elif value < 0x100:
+        out.append((major << 5) | 24)
+        out.append(value)
+    elif value < 0x10000:
+        out.append((major << 5) | 25)
+        out += struct.pack(">H", value)
+    elif value < 0x100000000:
+        out.append((major << 5) | 26)
+        out += struct.pack(">I", value)
+    else:
+        out.append((major << 5) | 27)
+        out += struct.pack(">Q", value)
+
+
+def _encode_float(value: float, out: bytearray) -> None:
+    packed = struct.pack(">f", value)
+    if struct.unpack(">f", packed)[0] == value:
+        out.append(0xFA)
+        out += packed
+    else:
+        out.append(0xFB)
+        out += struct.pack(">d", value)
+
+
+def _encode(value: Any, out: bytearray, depth: int) -> None:
+    if depth > _MAX_DEPTH:
+        raise CborError("Payload nested too deeply")
+
+    if value is None:
+        out.append(0xF6)
+    elif value is True:
+        out.append(0xF5)
+    elif value is False:
+        out.append(0xF4)
+    elif isinstance(value, int):
+        if value >= 0:
+            _encode_head(0, value, out)
+        else:
+            _encode_head(1, -1 - value, out)
+    elif isinstance(value, float):
+        if value.is_integer() and abs(value) < 2**53:
+            _encode(int(value), out, depth)
+        else:
+            _encode_float(value, out)
+    elif isinstance(value, str):
+        data = value.encode("utf-8")
+        _encode_head(3, len(data), out)
+        out += data
+    elif isinstance(value, (list, tuple)):
+        _encode_head(4, len(value), out)
+        for item in value:
+            _encode(item, out, depth + 1)
+    elif isinstance(value, dict):
+        _encode_head(5, len(value), out)
+        for key, item in value.items():
+            if not isinstance(key, str):
+                key = str(key)
+            _encode(key, out, depth + 1)
+            _encode(item, out, depth + 1)
+    else:
+        raise CborError(f"Unsupported type: {type(value).__name__}")
+
+
+def dumps(value: Any) -> bytes:
+    """Encode ``value`` as CBOR."""
+
+    out = bytearray()
+    _encode(value, out, 0)
+    return bytes(out)
+
+
+def _read_length(data: bytes, pos: int, info: int) -> Tuple[int, int]:
+    if info < 24:
+        return info, pos
+    sizes = {24: 1, 25: 2, 26: 4, 27: 8}
+    size = sizes.get(info)
+    if size is None:
+        raise CborError("Invalid length encoding")
+    if pos + size > len(data):
+        raise CborError("Truncated payload")
+    return int.from_bytes(data[pos:pos + size], "big"), pos + size
+
+
+def _decode(data: bytes, pos: int, depth: int) -> Tuple[Any, int]:
+    if depth > _MAX_DEPTH:
+        raise CborError("Payload nested too deeply")
+    if pos >= len(data):
+        raise CborError("Truncated payload")
+
+    initial = data[pos]
+    pos += 1
+    major, info = initial >> 5, initial & 0x1F
+
+    if major == 7:
+        if info == 20:
+            return False, pos
+        if info == 21:
+            return True, pos
+        if info in (22, 23):
+            return None, pos
+        formats = {25: (">e", 2), 26: (">f", 4), 27: (">d", 8)}
+        if info in formats:
+            fmt, size = formats[info]
+            if pos + size > len(data):
+                raise CborError("Truncated payload")
+            return struct.unpack(fmt, data[pos:pos + size])[0], pos + size
+        raise CborError("Unsupported simple value")
+
+    indefinite = info == 31 and major in (4, 5)
+    length = 0
+    if not indefinite:
+        length, pos = _read_length(data, pos, info)
+
+    if major == 0:
+        return length, pos
+    if major == 1:
+        return -1 - length, pos
+    if major == 3:
+        if pos + length > len(data):
+            raise CborError("Truncated payload")
+        return data[pos:pos + length].decode("utf-8"), pos + length
+    if major == 4:
+        items = []
+        while indefinite or len(items) < length:
+            if indefinite and pos < len(data) and data[pos] == 0xFF:
+                return items, pos + 1
+            item, pos = _decode(data, pos, depth + 1)
+            items.append(item)
+        return items, pos
+    if major == 5:
+        result = {}
+        count = 0
+        while indefinite or count < length:
+            if indefinite and pos < len(data) and data[pos] == 0xFF:
+                return result, pos + 1
+            key, pos = _decode(data, pos, depth + 1)
+            if not isinstance(key, str):
+                raise CborError("Map keys must be text strings")
+            result[key], pos = _decode(data, pos, depth + 1)
+            count += 1
+        return result, pos
+
+    raise CborError(f"Unsupported major type {major}")
+
+
+def loads(data: bytes) -> Any:
+    """Decode a single CBOR item spanning all of ``data``."""
+
+    value, pos = _decode(bytes(data), 0, 0)
+    if pos != len(data):
+        raise CborError("Trailing bytes after CBOR item")
+    return value
@@ -0,0 +1,454 @@
+"""Client-side load benchmark driving the editor through ``UnrealConnection``.
+
+The editor's Run Benchmark (``FUnrealMCPDiagnostics::StartBenchmark``) times the server from
+inside the process. This one goes through the same client stack as the MCP server (framing,
+handshake negotiation, CBOR, zlib, shared memory and the request window), so transports and
+encodings can be compared end to end: every combination of transport, encoding and compression
+is run at each concurrency and payload size, and each run reports throughput and latency
+percentiles, overall and per tool.
+"""
+
+from __future__ import annotations
+
+import base64
+import logging
+import math
+import random
+import sys
+import threading
+import time
+from dataclasses import dataclass, field
+from datetime import datetime, timezone
+from itertools import product
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional, Sequence, Tuple
+
+__all__ = [
+    "BenchError",
+    "DEFAULT_TOOL_PARAMS",
+    "Variant",
+    "build_params",
+    "format_size",
+    "load_connection_module",
+    "parse_mix",
+    "parse_sizes",
+    "parse_variants",
+    "percentile",
+    "print_report",
+    "run_benchmark",
+    "summarize",
+]
+
+# The same requests as the editor's load generator, so both sides time the same work.
+DEFAULT_TOOL_PARAMS: Dict[str, Dict[str, Any]] = {
+    "ping": {},
+    "asset.find": {"paths": ["/Game"], "limit": 50},
+    "asset.exists": {"objectPath": "/Engine/BasicShapes/Cube.Cube"},
+    "get_actors_in_level": {},
+}
+
+TRANSPORTS = ("tcp", "local")
+ENCODINGS = ("json", "cbor")
+_TRANSPORT_ALIASES = {"ipc": "local", "uds": "local", "pipe": "local"}
+_SIZE_SUFFIXES = {"k": 1024, "m": 1024 * 1024}
+# High enough that the server's policy limits never throttle a benchmark run.
+_UNLIMITED_PER_MINUTE = 1_000_000_000
+
+
+class BenchError(RuntimeError):
+    """Invalid benchmark options, or the server module could not be loaded."""
+
+
+@dataclass(frozen=True)
+class Variant:
+    transport: str
+    encoding: str
+    compression: bool
+
+    @property
+    def label(self) -> str:
+        return f"{self.transport}/{self.encoding}/{'zlib' if self.compression else 'raw'}"
+
+
+@dataclass
+class _Sample:
+    tool: str
+    latency_ms: float
+    error_code: Optional[str]
+
+
+@dataclass
+class _RunState:
+    deadline: float
+    max_requests: Optional[int]
+    issued: int = 0
+    lock: threading.Lock = field(default_factory=threading.Lock)
+
+    def take(self) -> bool:
+        if time.perf_counter() >= self.deadline:
+            return False
+        with self.lock:
+            if self.max_requests is not None and self.issued >= self.max_requests:
+                return False
+            self.issued += 1
+            return True
+
+
+def _split(text: str) -> List[str]:
+    return [item.strip() for item in text.split(",") if item.strip()]
+
+
+def parse_sizes(text: str) -> List[int]:
+    """``"0,4k,1m"`` -> ``[0, 4096, 1048576]``."""
+
+    sizes: List[int] = []
+    for item in _split(text):
+        lowered = item.lower().rstrip("b")
+        multiplier = _SIZE_SUFFIXES.get(lowered[-1:], 1)
+        digits = lowered[:-1] if multiplier != 1 else lowered
+        try:
+            value = int(float(digits) * multiplier)
+        except ValueError as exc:
+            raise BenchError(f"Invalid payload size '{item}'.") from exc
+        if value < 0:
+            raise BenchError(f"Invalid payload size '{item}'.")
+        sizes.append(value)
+    return sizes or [0]
+
+
+def parse_mix(text: str) -> List[Tuple[str, float]]:
+    """``"ping=4,asset.find"`` -> ``[("ping", 4.0), ("asset.find", 1.0)]``."""
+
+    mix: List[Tuple[str, float]] = []
+    for item in _split(text):
+        tool, _, weight_text = item.partition("=")
+        tool = tool.strip()
+        try:
+            weight = float(weight_text) if weight_text.strip() else 1.0
+        except ValueError as exc:
+            raise BenchError(f"Invalid weight in mix entry '{item}'.") from exc
+        if not tool or weight <= 0:
+            raise BenchError(f"Invalid mix entry '{item}'.")
+        mix.append((tool, weight))
+    if not mix:
+        raise BenchError("The tool mix is empty.")
+    return mix
+
+
+def parse_variants(transports: str, encodings: str, compression: str) -> List[Variant]:
+    """The cross product of the comma-separated lists; compression takes ``on``/``off``."""
+
+    transport_list = []
+    for value in _split(transports.lower()):
+        value = _TRANSPORT_ALIASES.get(value, value)
+        if value not in TRANSPORTS:
+            raise BenchError(f"Unknown transport '{value}' (expected tcp or local).")
+        transport_list.append(value)
+    encoding_list = []
+    for value in _split(encodings.lower()):
+        if value not in ENCODINGS:
+            raise BenchError(f"Unknown encoding '{value}' (expected json or cbor).")
+        encoding_list.append(value)
+    compression_list = []
+    for value in _split(compression.lower()):
+        if value in ("on", "zlib", "1", "true", "yes"):
+            compression_list.append(True)
+        elif value in ("off", "raw", "0", "false", "no"):
+            compression_list.append(False)
+        else:
+            raise BenchError(f"Unknown compression setting '{value}' (expected on or off).")
+    variants = [Variant(t, e, c) for t, e, c in product(transport_list, encoding_list, compression_list)]
+    if not variants:
+        raise BenchError("No transport/encoding/compression combination selected.")
+    return list(dict.fromkeys(variants))
+
+
+def _padding(size: int, seed: int) -> str:
+    """``size`` characters of base64 noise: compresses about as well as an inline attachment."""
+
+    raw = random.Random(seed).getrandbits(8 * (size * 3 // 4 + 3)).to_bytes(size * 3 // 4 + 3, "little")
+    return base64.b64encode(raw).decode("ascii")[:size]
+
+
+def build_params(tool: str, payload_bytes: int, overrides: Dict[str, Dict[str, Any]], padding: str = "") -> Dict[str, Any]:
+    """Request params for ``tool``; the payload is carried by ``ping``, which ignores its params."""
+
+    params = dict(overrides.get(tool, DEFAULT_TOOL_PARAMS.get(tool, {})))
+    if tool == "ping" and payload_bytes > 0:
+        params["padding"] = padding or _padding(payload_bytes, payload_bytes)
+    return params
+
+
+def percentile(values: Sequence[float], quantile: float) -> float:
+    """Nearest-rank percentile; 0 for an empty list."""
+
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    rank = max(1, math.ceil(quantile * len(ordered)))
+    return ordered[min(rank, len(ordered)) - 1]
+
+
+def summarize(latencies_ms: Sequence[float]) -> Dict[str, float]:
+    ordered = sorted(latencies_ms)
+    return {
+        "count": len(ordered),
+        "avgMs": round(sum(ordered) / len(ordered), 3) if ordered else 0.0,
+        "p50Ms": round(percentile(ordered, 0.50), 3),
+        "p90Ms": round(percentile(ordered, 0.90), 3),
+        "p99Ms": round(percentile(ordered, 0.99), 3),
+        "maxMs": round(ordered[-1], 3) if ordered else 0.0,
+    }
+
+
+def format_size(size: int) -> str:
+    if size >= 1024 * 1024 and size % (1024 * 1024) == 0:
+        return f"{size // (1024 * 1024)} MiB"
+    if size >= 1024 and size % 1024 == 0:
+        return f"{size // 1024} KiB"
+    return f"{size} B"
+
+
+def load_connection_module() -> Any:
+    """Import ``unreal_mcp_server`` from the Python folder next to this CLI, set up for benchmarking."""
+
+    python_dir = Path(__file__).resolve().parents[2]
+    if str(python_dir) not in sys.path:
+        sys.path.insert(0, str(python_dir))
+    try:
+        import unreal_mcp_server as module
+        from security.rate_limit import RateLimitConfig, RateLimiter
+    except ImportError as exc:
+        raise BenchError(f"Cannot import unreal_mcp_server from {python_dir} ({exc}); install the server requirements first.") from exc
+
+    # Every response is logged at DEBUG; at benchmark rates that would be what gets measured.
+    logging.getLogger("UnrealMCP").setLevel(logging.WARNING)
+    module.RATE_LIMITER = RateLimiter(RateLimitConfig(per_minute_global=_UNLIMITED_PER_MINUTE, per_minute_tool=_UNLIMITED_PER_MINUTE))
+    return module
+
+
+def _connection_factory(module: Any, host: str, port: int, local_endpoint: Optional[str], shared_memory: bool) -> Callable[[Variant], Any]:
+    def connect(variant: Variant) -> Any:
+        # UnrealConnection reads these when it connects, so they apply to this connection only.
+        module.UNREAL_TRANSPORT = variant.transport
+        if local_endpoint:
+            module.UNREAL_LOCAL_ENDPOINT = local_endpoint
+        module.PREFERRED_ENCODINGS = [variant.encoding]
+        module.OFFER_COMPRESSION = variant.compression
+        module.OFFER_SHARED_MEMORY = shared_memory
+        connection = module.UnrealConnection(host, port)
+        # Answers must come from the editor, not from the client's read cache.
+        connection.read_cache = None
+        if not connection.connect():
+            return None
+        return connection
+
+    return connect
+
+
+def _negotiation_mismatch(variant: Variant, connection: Any) -> Optional[str]:
+    if getattr(connection, "encoding", variant.encoding) != variant.encoding:
+        return f"the editor did not accept {variant.encoding} (negotiated {connection.encoding})"
+    if variant.compression and getattr(connection, "compress_threshold", 1) <= 0:
+        return "the editor did not accept zlib compression"
+    return None
+
+
+def _error_code(response: Any) -> Optional[str]:
+    if not isinstance(response, dict):
+        return "NO_RESPONSE"
+    if response.get("ok", False):
+        return None
+    error = response.get("error")
+    if isinstance(error, dict) and error.get("code"):
+        return str(error["code"])
+    return "ERROR"
+
+
+def _worker(connection: Any, mix: List[Tuple[str, float]], params_by_tool: Dict[str, Dict[str, Any]], state: _RunState, seed: int, samples: List[_Sample]) -> None:
+    rng = random.Random(seed)
+    tools = [tool for tool, _ in mix]
+    weights = [weight for _, weight in mix]
+    while state.take():
+        tool = rng.choices(tools, weights)[0]
+        started = time.perf_counter()
+        try:
+            response = connection.send_command(tool, params_by_tool[tool])
+        except Exception as exc:  # pragma: no cover - the connection reports its own errors
+            response = {"ok": False, "error": {"code": type(exc).__name__}}
+        samples.append(_Sample(tool, (time.perf_counter() - started) * 1000.0, _error_code(response)))
+
+
+def _run_load(
+    connection: Any,
+    mix: List[Tuple[str, float]],
+    params_by_tool: Dict[str, Dict[str, Any]],
+    concurrency: int,
+    duration: float,
+    max_requests: Optional[int],
+    seed: int,
+) -> Tuple[List[_Sample], float]:
+    state = _RunState(deadline=time.perf_counter() + duration, max_requests=max_requests)
+    per_worker: List[List[_Sample]] = [[] for _ in range(concurrency)]
+    threads = [
+        threading.Thread(target=_worker, args=(connection, mix, params_by_tool, state, seed + index, per_worker[index]), name=f"mcp-bench-{index}", daemon=True)
+        for index in range(concurrency)
+    ]
+    started = time.perf_counter()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.perf_counter() - started
+    return [sample for samples in per_worker for sample in samples], elapsed
+
+
+def _run_result(variant: Variant, concurrency: int, payload_bytes: int, samples: List[_Sample], elapsed: float, negotiated: Dict[str, Any]) -> Dict[str, Any]:
+    latencies = [sample.latency_ms for sample in samples]
+    errors: Dict[str, int] = {}
+    per_tool: Dict[str, List[float]] = {}
+    payload_sent = 0
+    for sample in samples:
+        per_tool.setdefault(sample.tool, []).append(sample.latency_ms)
+        if sample.error_code:
+            errors[sample.error_code] = errors.get(sample.error_code, 0) + 1
+        if sample.tool == "ping":
+            payload_sent += payload_bytes
+    seconds = max(elapsed, 1e-9)
+    return {
+        "variant": variant.label,
+        "transport": variant.transport,
+        "encoding": variant.encoding,
+        "compression": variant.compression,
+        "negotiated": negotiated,
+        "concurrency": concurrency,
+        "payloadBytes": payload_bytes,
+        "requests": len(samples),
+        "errors": sum(errors.values()),
+        "errorCodes": errors,
+        "elapsedSec": round(elapsed, 3),
+        "throughputRps": round(len(samples) / seconds, 2),
+        "payloadMiBps": round(payload_sent / seconds / (1024 * 1024), 3),
+        "latency": summarize(latencies),
+        "perTool": {tool: summarize(values) for tool, values in sorted(per_tool.items())},
+    }
+
+
+def run_benchmark(
+    variants: Sequence[Variant],
+    *,
+    mix: List[Tuple[str, float]],
+    concurrency: Sequence[int],
+    payload_sizes: Sequence[int],
+    duration: float,
+    max_requests: Optional[int] = None,
+    warmup: int = 20,
+    seed: int = 1,
+    tool_params: Optional[Dict[str, Dict[str, Any]]] = None,
+    connect: Optional[Callable[[Variant], Any]] = None,
+    host: str = "127.0.0.1",
+    port: int = 55557,
+    local_endpoint: Optional[str] = None,
+    shared_memory: bool = True,
+    on_run: Optional[Callable[[Dict[str, Any]], None]] = None,
+) -> Dict[str, Any]:
+    """Run every variant at every concurrency and payload size; returns the results document.
+
+    ``connect`` opens a connection for a variant (None when it cannot); by default it is an
+    ``UnrealConnection`` to ``host:port`` or ``local_endpoint``. Each variant gets one connection,
+    shared by all workers as the MCP server shares its own, and ``warmup`` untimed requests.
+    """
+
+    if connect is None:
+        connect = _connection_factory(load_connection_module(), host, port, local_endpoint, shared_memory)
+    overrides = tool_params or {}
+    paddings = {size: _padding(size, seed + size) for size in payload_sizes if size > 0}
+
+    runs: List[Dict[str, Any]] = []
+    skipped: List[Dict[str, str]] = []
+    for variant in variants:
+        connection = connect(variant)
+        if connection is None:
+            skipped.append({"variant": variant.label, "reason": "could not connect"})
+            continue
+        try:
+            mismatch = _negotiation_mismatch(variant, connection)
+            if mismatch:
+                skipped.append({"variant": variant.label, "reason": mismatch})
+                continue
+            negotiated = {
+                "encoding": getattr(connection, "encoding", variant.encoding),
+                "compressThreshold": getattr(connection, "compress_threshold", 0),
+                "windowMax": getattr(connection, "window_max", None),
+                "sharedMemory": getattr(connection, "_shared_memory", None) is not None,
+            }
+            for payload_bytes in payload_sizes:
+                params_by_tool = {tool: build_params(tool, payload_bytes, overrides, paddings.get(payload_bytes, "")) for tool, _ in mix}
+                if warmup > 0:
+                    _run_load(connection, mix, params_by_tool, 1, float("inf"), warmup, seed)
+                for workers in concurrency:
+                    samples, elapsed = _run_load(connection, mix, params_by_tool, workers, duration, max_requests, seed)
+                    result = _run_result(variant, workers, payload_bytes, samples, elapsed, negotiated)
+                    runs.append(result)
+                    if on_run is not None:
+                        on_run(result)
+        finally:
+            disconnect = getattr(connection, "disconnect", None)
+            if callable(disconnect):
+                disconnect()
+
+    return {
+        "startedAt": datetime.now(timezone.utc).isoformat(),
+        "config": {
+            "host": host,
+            "port": port,
+            "localEndpoint": local_endpoint,
+            "variants": [variant.label for variant in variants],
+            "mix": {tool: weight for tool, weight in mix},
+            "concurrency": list(concurrency),
+            "payloadBytes": list(payload_sizes),
+            "durationSec": duration,
+            "maxRequests": max_requests,
+            "warmup": warmup,
+            "seed": seed,
+        },
+        "runs": runs,
+        "skipped": skipped,
+    }
+
+
+def print_report(results: Dict[str, Any]) -> None:
+    """Latency/throughput table per concurrency and payload size, against the first variant."""
+
+    from rich.console import Console
+    from rich.table import Table
+
+    console = Console()
+    groups: Dict[Tuple[int, int], List[Dict[str, Any]]] = {}
+    for run in results.get("runs", []):
+        groups.setdefault((run["concurrency"], run["payloadBytes"]), []).append(run)
+
+    for (concurrency, payload_bytes), runs in sorted(groups.items()):
+        table = Table(title=f"concurrency {concurrency}, payload {format_size(payload_bytes)}")
+        for column in ("variant", "requests", "errors", "req/s", "MiB/s", "p50 ms", "p90 ms", "p99 ms", "max ms", "p50 vs first"):
+            table.add_column(column, justify="left" if column == "variant" else "right")
+        baseline = runs[0]["latency"]["p50Ms"]
+        for run in runs:
+            latency = run["latency"]
+            delta = f"{(latency['p50Ms'] / baseline - 1.0) * 100.0:+.1f}%" if baseline > 0 else "-"
+            table.add_row(
+                run["variant"],
+                str(run["requests"]),
+                str(run["errors"]),
+                f"{run['throughputRps']:.1f}",
+                f"{run['payloadMiBps']:.2f}",
+                f"{latency['p50Ms']:.2f}",
+                f"{latency['p90Ms']:.2f}",
+                f"{latency['p99Ms']:.2f}",
+                f"{latency['maxMs']:.2f}",
+                delta,
+            )
+        console.print(table)
+
+    for entry in results.get("skipped", []):
+        console.print(f"[yellow]skipped {entry['variant']}: {entry['reason']}[/yellow]")
@@ -11,6 +11,7 @@ import jmespath
 import typer
 import yaml
 
+from . import bench
 from .logs import configure_logging, get_logger
 from .mcp_client import MCPClient, ProtocolError
 from .recipes import (
@@ -288,3 +289,68 @@ def test_recipe(
     print(_format_output(selected, output=output.lower()))
 
     raise typer.Exit(0 if report.get("ok") else 1)
+
+
+@app.command("bench")
+def run_bench(
+    host: str = typer.Option("127.0.0.1", "--host", help="Editor host for the tcp transport."),
+    port: int = typer.Option(55557, "--port", help="Editor port for the tcp transport."),
+    local_endpoint: Optional[str] = typer.Option(None, "--local-endpoint", envvar="UNREAL_MCP_LOCAL_ENDPOINT", help="Socket path / pipe name for the local transport."),
+    transports: str = typer.Option("tcp,local", "--transports", help="Comma-separated transports: tcp, local (ipc)."),
+    encodings: str = typer.Option("json,cbor", "--encodings", help="Comma-separated frame encodings: json, cbor."),
+    compression: str = typer.Option("off,on", "--compression", help="Comma-separated zlib settings: on, off."),
+    concurrency: str = typer.Option("1,8", "--concurrency", help="Comma-separated numbers of concurrent callers."),
+    payload_sizes: str = typer.Option("0,64k", "--payload-sizes", help="Comma-separated ping payload sizes (k/m suffixes)."),
+    mix: str = typer.Option("ping=4,asset.find=1,asset.exists=1,get_actors_in_level=1", "--mix", help="Tool mix as TOOL=WEIGHT pairs."),
+    tool_params: List[str] = typer.Option([], "--tool-params", help="Params for a tool in the mix (TOOL=JSON)."),
+    duration: float = typer.Option(5.0, "--duration", min=0.1, help="Seconds per run."),
+    requests: Optional[int] = typer.Option(None, "--requests", min=1, help="Stop each run after this many requests."),
+    warmup: int = typer.Option(20, "--warmup", min=0, help="Untimed requests before each payload size."),
+    shared_memory: bool = typer.Option(True, "--shared-memory/--no-shared-memory", help="Offer the shared-memory ring on local connections."),
+    seed: int = typer.Option(1, "--seed", help="Seed for the tool choice and the payload bytes."),
+    out: Optional[Path] = typer.Option(None, "--out", help="Write the results as JSON to this file."),
+    log_level: str = typer.Option("warning", "--log-level", help="Logging level."),
+) -> None:
+    logger = _configure_and_get_logger(log_level, "command.bench")
+    params_by_tool: Dict[str, Dict[str, Any]] = {}
+    for tool, text in _parse_key_values(tool_params, option="--tool-params").items():
+        try:
+            value = json.loads(text)
+        except json.JSONDecodeError as exc:
+            raise typer.BadParameter(f"Invalid JSON for --tool-params {tool}: {exc}") from exc
+        if not isinstance(value, dict):
+            raise typer.BadParameter(f"--tool-params {tool} must be a JSON object")
+        params_by_tool[tool] = value
+
+    try:
+        variants = bench.parse_variants(transports, encodings, compression)
+        workers = [int(value) for value in concurrency.split(",") if value.strip()]
+        if not workers or min(workers) < 1:
+            raise bench.BenchError("--concurrency needs positive integers")
+        results = bench.run_benchmark(
+            variants,
+            mix=bench.parse_mix(mix),
+            concurrency=workers,
+            payload_sizes=bench.parse_sizes(payload_sizes),
+            duration=duration,
+            max_requests=requests,
+            warmup=warmup,
+            seed=seed,
+            tool_params=params_by_tool,
+            host=host,
+            port=port,
+            local_endpoint=local_endpoint,
+            shared_memory=shared_memory,
+            on_run=lambda run: logger.info("%s x%d %s: %.1f req/s", run["variant"], run["concurrency"], bench.format_size(run["payloadBytes"]), run["throughputRps"]),
+        )
+    except (bench.BenchError, ValueError) as exc:
+        raise typer.BadParameter(str(exc)) from exc
+
+    bench.print_report(results)
+    if out:
+        resolved = out.expanduser().resolve()
+        resolved.parent.mkdir(parents=True, exist_ok=True)
+        resolved.write_text(json.dumps(results, indent=2), encoding="utf-8")
+        logger.info("Results written to %s", resolved)
+
+    raise typer.Exit(0 if results["runs"] else 1)
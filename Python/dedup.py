@@ -1,11 +1,16 @@
 from __future__ import annotations
 
+import atexit
+import hashlib
 import json
+import os
+import queue
 import threading
 import time
+from collections import OrderedDict
 from dataclasses import dataclass
 from pathlib import Path
-from typing import Dict, Optional, Any
+from typing import Dict, List, Optional, Any, Tuple
 
 
 @dataclass
@@ -15,32 +20,58 @@ class _DedupEntry:
 
 
 class DedupStore:
-    """Simple in-memory deduplication store with a JSONL journal."""
+    """Bounded LRU deduplication store, persisted as a snapshot plus a JSONL journal.
+
+    Responses larger than ``max_body_bytes`` are kept as a stub: ``ok``, ``error`` and ``meta``,
+    plus ``dedup: {sha256, bytes, bodyOmitted: true}``. A replayed request then still learns
+    whether it ran, without the store holding the body. Journal lines are written in batches by a
+    background thread. Once the journal holds ``compact_after`` records, the live entries are
+    rewritten to the snapshot and the journal starts again, so startup reads at most one snapshot
+    and one short journal.
+    """
+
+    FLUSH_INTERVAL_SEC = 0.5
 
     def __init__(
         self,
         ttl_sec: float = 600.0,
         journal_path: Optional[Path] = None,
         max_entries: int = 2048,
+        max_body_bytes: int = 64 * 1024,
+        compact_after: Optional[int] = None,
     ) -> None:
         self.ttl_sec = ttl_sec
         self.max_entries = max_entries
+        self.max_body_bytes = max_body_bytes
+        self.compact_after = compact_after or max(256, max_entries * 2)
         self._lock = threading.Lock()
-        self._entries: Dict[str, _DedupEntry] = {}
+        self._entries: "OrderedDict[str, _DedupEntry]" = OrderedDict()
         self.journal_path = journal_path or Path("logs/dedup.jsonl")
-        self._load_journal()
+        self.snapshot_path = self.journal_path.with_name(self.journal_path.stem + ".snapshot.jsonl")
+        self._journal_records = 0
+        self._pending: "queue.Queue[Optional[str]]" = queue.Queue()
+        self._load()
+        self._writer = threading.Thread(target=self._write_loop, name="dedup-journal", daemon=True)
+        self._writer.start()
+        atexit.register(self.close)
+
+    # -- persistence -----------------------------------------------------------------------
+
+    def _read_records(self, path: Path) -> int:
+        """Load ``path`` into the store; returns the number of lines read."""
 
-    def _load_journal(self) -> None:
-        if not self.journal_path.exists():
-            return
+        if not path.exists():
+            return 0
 
         now = time.time()
+        lines = 0
         try:
-            with self.journal_path.open("r", encoding="utf-8") as handle:
+            with path.open("r", encoding="utf-8") as handle:
                 for line in handle:
                     line = line.strip()
                     if not line:
                         continue
+                    lines += 1
                     try:
                         payload = json.loads(line)
                     except json.JSONDecodeError:
@@ -57,56 +88,146 @@ class DedupStore:
                         continue
 
                     self._entries[request_id] = _DedupEntry(ts, response)
+                    self._entries.move_to_end(request_id)
+                    self._evict_locked()
         except OSError:
-            # If we fail to read the journal we simply start with an empty store.
-            self._entries.clear()
+            # If we fail to read a file we simply start without its entries.
+            pass
+        return lines
 
-    def _append_journal(self, request_id: str, response: Dict[str, Any]) -> None:
+    def _load(self) -> None:
+        with self._lock:
+            self._read_records(self.snapshot_path)
+            self._journal_records = self._read_records(self.journal_path)
+
+    @staticmethod
+    def _encode(response: Dict[str, Any]) -> str:
+        return json.dumps(response, ensure_ascii=False, default=str)
+
+    @staticmethod
+    def _record(request_id: str, timestamp: float, encoded_response: str) -> str:
+        return '{"requestId": %s, "ts": %r, "response": %s}' % (json.dumps(request_id), timestamp, encoded_response)
+
+    def _write_loop(self) -> None:
+        while True:
+            item = self._pending.get()
+            taken = 1
+            stop = item is None
+            batch: List[str] = [] if item is None else [item]
+            # Lines that arrive within the flush interval go out in the same write.
+            deadline = time.monotonic() + self.FLUSH_INTERVAL_SEC
+            while not stop:
+                try:
+                    item = self._pending.get(timeout=max(0.0, deadline - time.monotonic()))
+                except queue.Empty:
+                    break
+                taken += 1
+                if item is None:
+                    stop = True
+                else:
+                    batch.append(item)
+
+            if batch:
+                self._append_journal(batch)
+                if self._journal_records >= self.compact_after:
+                    self._compact()
+            for _ in range(taken):
+                self._pending.task_done()
+            if stop:
+                return
+
+    def _append_journal(self, lines: List[str]) -> None:
         try:
             self.journal_path.parent.mkdir(parents=True, exist_ok=True)
             with self.journal_path.open("a", encoding="utf-8") as handle:
-                handle.write(
-                    json.dumps(
-                        {
-                            "requestId": request_id,
-                            "ts": time.time(),
-                            "response": response,
-                        },
-                        ensure_ascii=False,
-                    )
-                    + "\n"
-                )
+                handle.write("\n".join(lines) + "\n")
+            self._journal_records += len(lines)
         except OSError:
             # Ignore journaling errors; the in-memory map still guarantees correctness for
             # the current process lifetime.
             pass
 
-    def get(self, request_id: str) -> Optional[Dict[str, Any]]:
+    def _compact(self) -> None:
+        """Rewrite the live entries as the snapshot and empty the journal."""
+
         with self._lock:
             self._gc_locked()
+            live: List[Tuple[str, _DedupEntry]] = list(self._entries.items())
+
+        temp_path = self.snapshot_path.with_name(self.snapshot_path.name + ".tmp")
+        try:
+            with temp_path.open("w", encoding="utf-8") as handle:
+                for request_id, entry in live:
+                    handle.write(self._record(request_id, entry.timestamp, self._encode(entry.response)) + "\n")
+            os.replace(temp_path, self.snapshot_path)
+            # Only the writer thread appends, so nothing is lost between the rename and the truncate.
+            with self.journal_path.open("w", encoding="utf-8"):
+                pass
+            self._journal_records = 0
+        except OSError:
+            try:
+                temp_path.unlink()
+            except OSError:
+                pass
+
+    def flush(self) -> None:
+        """Wait until the journal lines queued so far are written."""
+
+        if self._writer.is_alive():
+            self._pending.join()
+
+    def close(self) -> None:
+        """Write out queued journal lines and stop the writer thread."""
+
+        if self._writer.is_alive():
+            self._pending.put(None)
+            self._writer.join(timeout=5.0)
+
+    # -- store -----------------------------------------------------------------------------
+
+    def _stub(self, response: Dict[str, Any], encoded: bytes) -> Dict[str, Any]:
+        stub: Dict[str, Any] = {key: response[key] for key in ("ok", "error", "meta") if key in response}
+        stub["dedup"] = {"sha256": hashlib.sha256(encoded).hexdigest(), "bytes": len(encoded), "bodyOmitted": True}
+        return stub
+
+    def get(self, request_id: str) -> Optional[Dict[str, Any]]:
+        with self._lock:
             entry = self._entries.get(request_id)
-            if entry:
-                return entry.response
-            return None
+            if entry is None:
+                return None
+            if time.time() - entry.timestamp > self.ttl_sec:
+                del self._entries[request_id]
+                return None
+            self._entries.move_to_end(request_id)
+            return entry.response
 
     def put(self, request_id: str, response: Dict[str, Any]) -> None:
         now = time.time()
+        encoded = self._encode(response)
+        encoded_bytes = encoded.encode("utf-8")
+        if len(encoded_bytes) > self.max_body_bytes:
+            response = self._stub(response, encoded_bytes)
+            encoded = self._encode(response)
+
         with self._lock:
-            self._gc_locked(now)
             self._entries[request_id] = _DedupEntry(now, response)
-            if len(self._entries) > self.max_entries:
-                # Remove oldest entries to bound memory usage.
-                sorted_items = sorted(self._entries.items(), key=lambda item: item[1].timestamp)
-                for key, _ in sorted_items[: len(self._entries) - self.max_entries]:
-                    self._entries.pop(key, None)
-            self._append_journal(request_id, response)
+            self._entries.move_to_end(request_id)
+            self._gc_locked(now)
+            self._evict_locked()
+        self._pending.put(self._record(request_id, now, encoded))
+
+    def _evict_locked(self) -> None:
+        while len(self._entries) > self.max_entries:
+            self._entries.popitem(last=False)
 
     def _gc_locked(self, now: Optional[float] = None) -> None:
+        # Least recently used first; expired entries past the first live one go when they are read.
         deadline = (now or time.time()) - self.ttl_sec
-        stale = [key for key, entry in self._entries.items() if entry.timestamp < deadline]
-        for key in stale:
-            self._entries.pop(key, None)
+        while self._entries:
+            key, entry = next(iter(self._entries.items()))
+            if entry.timestamp >= deadline:
+                break
+            del self._entries[key]
 
 
 __all__ = ["DedupStore"]
-
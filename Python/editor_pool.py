@@ -0,0 +1,410 @@
+"""Several editor instances behind one MCP server.
+
+``UNREAL_MCP_EDITORS`` lists the editors, either inline (``host:port,name=host:port``) or as a JSON
+file::
+
+    {"editors": [
+        {"name": "city", "host": "10.0.0.5", "port": 55557, "maps": ["/Game/Maps/City"], "paths": ["/Game/City"]},
+        {"name": "spare", "host": "10.0.0.6"}
+    ]}
+
+Each command goes to one editor. An explicit ``editor=`` wins; then the editor that started a job or
+an open transaction; then the editor whose ``maps``/``paths`` share the longest prefix with a content
+path in the params; then the first healthy editor in the list (the primary). ``content.validate`` is
+split across every healthy editor with its ``shard`` param and the answers merged, so all editors
+must have the same project checked out. ``content.register_rules`` goes to every editor and is
+replayed on an editor that reconnects.
+
+A health thread marks an editor down once its connection drops or an idle ping fails, and retries
+the connection on the next check. Reads whose editor is down go to the primary; mutations do not
+move, since another editor's working copy is not the one the caller meant to change.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import json
+import logging
+import threading
+import time
+import uuid
+from concurrent.futures import ThreadPoolExecutor
+from copy import deepcopy
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any, Callable, Dict, Iterable, List, Optional, Set, Tuple
+
+logger = logging.getLogger("UnrealMCP")
+
+DEFAULT_PORT = 55557
+
+# Summary counters of content.validate that add up across shards.
+_VALIDATE_COUNTERS = ("violations", "assets", "assetsLoaded", "parameterCacheHits")
+_JOB_COMMANDS = ("job.status", "job.result", "job.cancel")
+# Owners remembered for this many of the latest jobs; older ids fall back to the normal rules.
+_MAX_TRACKED_JOBS = 1024
+
+
+@dataclass
+class EditorEndpoint:
+    name: str
+    host: str
+    port: int = DEFAULT_PORT
+    # Content prefixes this editor should receive commands for: open maps and owned folders.
+    maps: List[str] = field(default_factory=list)
+    paths: List[str] = field(default_factory=list)
+
+    def affinity(self, candidates: Iterable[str]) -> int:
+        """Length of the longest of ``maps``/``paths`` that prefixes a candidate, 0 for none."""
+
+        best = 0
+        for prefix in self.maps + self.paths:
+            stem = prefix.rstrip("/")
+            for candidate in candidates:
+                if len(stem) > best and (candidate == stem or candidate.startswith(stem + "/") or candidate.startswith(stem + ".")):
+                    best = len(stem)
+        return best
+
+
+def load_endpoints(spec: str) -> List[EditorEndpoint]:
+    """Parse ``UNREAL_MCP_EDITORS``: a JSON file, or a comma-separated ``[name=]host[:port]`` list."""
+
+    spec = spec.strip()
+    if not spec:
+        return []
+    if spec.endswith(".json") or Path(spec).is_file():
+        with open(spec, "r", encoding="utf-8") as handle:
+            document = json.load(handle)
+        entries = document.get("editors", []) if isinstance(document, dict) else document
+        endpoints = []
+        for index, entry in enumerate(entries):
+            if not isinstance(entry, dict) or not entry.get("host"):
+                raise ValueError(f"{spec}: editors[{index}] needs a host")
+            endpoints.append(EditorEndpoint(
+                name=str(entry.get("name") or f"editor{index}"),
+                host=str(entry["host"]),
+                port=int(entry.get("port") or DEFAULT_PORT),
+                maps=[str(value) for value in entry.get("maps") or []],
+                paths=[str(value) for value in entry.get("paths") or []],
+            ))
+        return endpoints
+
+    endpoints = []
+    for index, part in enumerate(item.strip() for item in spec.split(",")):
+        if not part:
+            continue
+        name, _, address = part.rpartition("=")
+        host, _, port = address.rpartition(":") if address.count(":") == 1 else (address, "", "")
+        endpoints.append(EditorEndpoint(name=name or f"editor{index}", host=host, port=int(port or DEFAULT_PORT)))
+    return endpoints
+
+
+def _content_paths(value: Any, depth: int = 0) -> List[str]:
+    """Strings in the params that look like content paths (``/Game/...``), a few levels deep."""
+
+    if isinstance(value, str):
+        return [value] if value.startswith("/") else []
+    if depth >= 3:
+        return []
+    items = value.values() if isinstance(value, dict) else value if isinstance(value, list) else ()
+    found: List[str] = []
+    for item in items:
+        found.extend(_content_paths(item, depth + 1))
+    return found
+
+
+def merge_validate_results(results: List[Dict[str, Any]]) -> Dict[str, Any]:
+    """One content.validate result from the shards' results, in shard order."""
+
+    merged = deepcopy(results[0]) if results else {}
+    violations: List[Any] = []
+    summary: Dict[str, Any] = dict(merged.get("summary") or {})
+    by_rule: Dict[str, int] = {}
+    for name in _VALIDATE_COUNTERS:
+        summary[name] = 0
+    for result in results:
+        violations.extend(result.get("violations") or [])
+        shard_summary = result.get("summary") or {}
+        for name in _VALIDATE_COUNTERS:
+            summary[name] += shard_summary.get(name) or 0
+        for rule, count in (shard_summary.get("byRule") or {}).items():
+            by_rule[rule] = by_rule.get(rule, 0) + (count or 0)
+    summary["byRule"] = by_rule
+    if not merged.get("violationsStreamed"):
+        merged["violations"] = violations
+    merged["summary"] = summary
+    return merged
+
+
+class _Member:
+    __slots__ = ("endpoint", "connection", "healthy", "last_error", "checked_at")
+
+    def __init__(self, endpoint: EditorEndpoint, connection: Any) -> None:
+        self.endpoint = endpoint
+        self.connection = connection
+        self.healthy = False
+        self.last_error: Optional[str] = None
+        self.checked_at = 0.0
+
+
+class EditorPool:
+    """Routes commands across editors; quacks like one ``UnrealConnection`` for the tools."""
+
+    def __init__(
+        self,
+        endpoints: List[EditorEndpoint],
+        connect: Callable[[EditorEndpoint], Any],
+        *,
+        mutating: Set[str],
+        health_interval: float = 10.0,
+    ) -> None:
+        if not endpoints:
+            raise ValueError("EditorPool needs at least one editor")
+        self._members = [_Member(endpoint, connect(endpoint)) for endpoint in endpoints]
+        self._mutating = mutating
+        self.health_interval = health_interval
+        self._lock = threading.Lock()
+        # jobId -> editor that runs it; job.* calls must reach the same editor.
+        self._job_owners: Dict[str, _Member] = {}
+        # Between transaction.begin and commit/abort every routed command stays on one editor.
+        self._transaction_owner: Optional[_Member] = None
+        # content.register_rules params by id, replayed on editors that (re)connect.
+        self._registered_rules: Dict[str, Dict[str, Any]] = {}
+        self._stop = threading.Event()
+        self._health_thread: Optional[threading.Thread] = None
+
+    def connect(self) -> bool:
+        """Connect every editor and start the health checks; True when at least one answered."""
+
+        self.check_health()
+        connected = any(member.healthy for member in self._members)
+        if connected and self._health_thread is None and self.health_interval > 0:
+            self._stop.clear()
+            self._health_thread = threading.Thread(target=self._health_loop, name="unreal-mcp-pool-health", daemon=True)
+            self._health_thread.start()
+        return connected
+
+    def disconnect(self) -> None:
+        self._stop.set()
+        thread, self._health_thread = self._health_thread, None
+        if thread is not None and thread is not threading.current_thread():
+            thread.join(timeout=5.0)
+        for member in self._members:
+            member.healthy = False
+            member.connection.disconnect()
+
+    def _health_loop(self) -> None:
+        while not self._stop.wait(self.health_interval):
+            try:
+                self.check_health()
+            except Exception as exc:  # pragma: no cover - defensive logging
+                logger.error("Editor health check failed: %s", exc)
+
+    def check_health(self) -> None:
+        """Reconnect editors that are down and ping those idle for longer than the interval."""
+
+        for member in self._members:
+            connection = member.connection
+            was_healthy = member.healthy
+            error = None
+            if not connection.connected:
+                if not connection.connect():
+                    error = "connect failed"
+                else:
+                    self._replay_rules(member)
+            elif connection.idle_seconds() >= self.health_interval:
+                response = connection.send_command("ping")
+                if not isinstance(response, dict) or not response.get("ok"):
+                    error = "ping failed"
+                    connection.disconnect()
+            member.healthy = error is None
+            member.last_error = error
+            member.checked_at = time.time()
+            if was_healthy != member.healthy:
+                logger.log(
+                    logging.INFO if member.healthy else logging.WARNING,
+                    "Editor %s (%s:%s) is %s", member.endpoint.name, member.endpoint.host, member.endpoint.port,
+                    "up" if member.healthy else f"down: {error}",
+                )
+
+    def status(self) -> List[Dict[str, Any]]:
+        return [
+            {
+                "name": member.endpoint.name,
+                "host": member.endpoint.host,
+                "port": member.endpoint.port,
+                "healthy": member.healthy,
+                "error": member.last_error,
+                "checkedAt": member.checked_at,
+                "maps": list(member.endpoint.maps),
+                "paths": list(member.endpoint.paths),
+            }
+            for member in self._members
+        ]
+
+    @property
+    def primary(self) -> Any:
+        return self._primary().connection
+
+    def _primary(self) -> _Member:
+        return next((member for member in self._members if member.healthy), self._members[0])
+
+    def _named(self, name: str) -> _Member:
+        for member in self._members:
+            if member.endpoint.name == name:
+                return member
+        raise KeyError(f"No editor named '{name}'")
+
+    def route(self, command: str, params: Optional[Dict[str, Any]], editor: Optional[str] = None) -> _Member:
+        """The editor ``command`` goes to (see the module docstring for the order of the rules)."""
+
+        if editor:
+            return self._named(editor)
+        params = params or {}
+        with self._lock:
+            if command in _JOB_COMMANDS and params.get("jobId") in self._job_owners:
+                return self._job_owners[params["jobId"]]
+            if self._transaction_owner is not None:
+                return self._transaction_owner
+
+        candidates = _content_paths(params)
+        best, best_score = None, 0
+        if candidates:
+            for member in self._members:
+                score = member.endpoint.affinity(candidates)
+                if score > best_score:
+                    best, best_score = member, score
+        if best is not None and (best.healthy or command in self._mutating):
+            return best
+        return self._primary()
+
+    def _note_routed(self, member: _Member, command: str, params: Dict[str, Any], response: Any) -> None:
+        if not isinstance(response, dict) or not response.get("ok"):
+            return
+        result = response.get("result") if isinstance(response.get("result"), dict) else {}
+        with self._lock:
+            if command == "job.start" and isinstance(result.get("jobId"), str):
+                self._job_owners[result["jobId"]] = member
+                while len(self._job_owners) > _MAX_TRACKED_JOBS:
+                    del self._job_owners[next(iter(self._job_owners))]
+            elif command == "transaction.begin":
+                self._transaction_owner = member
+            elif command in ("transaction.commit", "transaction.abort"):
+                self._transaction_owner = None
+
+    def send_command(self, command: str, params: Optional[Dict[str, Any]] = None, *, editor: Optional[str] = None, **kwargs: Any) -> Optional[Dict[str, Any]]:
+        params = params or {}
+        if editor is None and not kwargs.get("stream"):
+            if command == "content.validate" and "shard" not in params:
+                return self._validate_sharded(params, kwargs)
+            if command == "content.register_rules":
+                return self._broadcast_rules(params, kwargs)
+        member = self.route(command, params, editor)
+        response = member.connection.send_command(command, params, **kwargs)
+        self._note_routed(member, command, params, response)
+        return response
+
+    async def send_command_async(self, command: str, params: Optional[Dict[str, Any]] = None, *, editor: Optional[str] = None, **kwargs: Any) -> Optional[Dict[str, Any]]:
+        params = params or {}
+        if editor is None and not kwargs.get("stream") and command in ("content.validate", "content.register_rules"):
+            # Blocking fan-out, kept off the event loop; on_progress callbacks are thread-safe.
+            return await asyncio.to_thread(self.send_command, command, params, **kwargs)
+        member = self.route(command, params, editor)
+        response = await member.connection.send_command_async(command, params, **kwargs)
+        self._note_routed(member, command, params, response)
+        return response
+
+    def __getattr__(self, name: str) -> Any:
+        if name.startswith("_"):
+            raise AttributeError(name)
+        # Events, subscriptions and the rest of the connection API belong to the primary editor.
+        return getattr(self.primary, name)
+
+    def _healthy(self) -> List[_Member]:
+        return [member for member in self._members if member.healthy]
+
+    def _validate_sharded(self, params: Dict[str, Any], kwargs: Dict[str, Any]) -> Optional[Dict[str, Any]]:
+        members = self._healthy()
+        if len(members) <= 1:
+            member = members[0] if members else self._primary()
+            return member.connection.send_command("content.validate", params, **kwargs)
+
+        count = len(members)
+        base_id = kwargs.pop("request_id", None) or str(uuid.uuid4())
+        started = time.monotonic()
+
+        def run(index: int) -> Tuple[Optional[Dict[str, Any]], _Member]:
+            shard_params = dict(params, shard={"index": index, "count": count})
+            # A shard whose editor fails is retried once on the next editor in the list.
+            for attempt, member in enumerate((members[index], members[(index + 1) % count])):
+                response = member.connection.send_command(
+                    "content.validate", shard_params, request_id=f"{base_id}-{index}of{count}-{attempt}", **kwargs
+                )
+                if isinstance(response, dict) and response.get("ok"):
+                    break
+            return response, member
+
+        with ThreadPoolExecutor(max_workers=count, thread_name_prefix="unreal-mcp-shard") as executor:
+            outcomes = list(executor.map(run, range(count)))
+
+        shards = []
+        for index, (response, member) in enumerate(outcomes):
+            ok = isinstance(response, dict) and bool(response.get("ok"))
+            result = response.get("result") if ok and isinstance(response.get("result"), dict) else {}
+            shards.append({
+                "index": index,
+                "editor": member.endpoint.name,
+                "ok": ok,
+                "assets": (result.get("summary") or {}).get("assets"),
+            })
+        # Half a validation would read as a clean bill of health for the other half.
+        for index, (response, member) in enumerate(outcomes):
+            if not isinstance(response, dict) or not response.get("ok"):
+                failure = deepcopy(response) if isinstance(response, dict) else {
+                    "ok": False,
+                    "error": {"code": "CONNECTION_FAILED", "message": f"No response from editor {member.endpoint.name}", "details": {}},
+                }
+                error = failure.setdefault("error", {})
+                if isinstance(error, dict):
+                    details = error.setdefault("details", {})
+                    if isinstance(details, dict):
+                        details["shard"] = {"index": index, "count": count, "editor": member.endpoint.name}
+                        details["shards"] = shards
+                return failure
+
+        merged = merge_validate_results([response["result"] for response, _ in outcomes])
+        merged["shards"] = shards
+        return {
+            "ok": True,
+            "result": merged,
+            "meta": {"requestId": base_id, "durMs": round((time.monotonic() - started) * 1000.0, 3), "editors": count},
+        }
+
+    def _broadcast_rules(self, params: Dict[str, Any], kwargs: Dict[str, Any]) -> Optional[Dict[str, Any]]:
+        rules_id = params.get("id")
+        if isinstance(rules_id, str):
+            with self._lock:
+                if params.get("rules") is None:
+                    self._registered_rules.pop(rules_id, None)
+                else:
+                    self._registered_rules[rules_id] = deepcopy(params)
+
+        base_id = kwargs.pop("request_id", None) or str(uuid.uuid4())
+        first: Optional[Dict[str, Any]] = None
+        for member in self._healthy() or [self._primary()]:
+            response = member.connection.send_command(
+                "content.register_rules", params, request_id=f"{base_id}-{member.endpoint.name}", **kwargs
+            )
+            if not isinstance(response, dict) or not response.get("ok"):
+                return response
+            first = first or response
+        return first
+
+    def _replay_rules(self, member: _Member) -> None:
+        with self._lock:
+            rule_sets = list(self._registered_rules.values())
+        for params in rule_sets:
+            member.connection.send_command("content.register_rules", params)
+
+
+__all__ = ["EditorEndpoint", "EditorPool", "load_endpoints", "merge_validate_results"]
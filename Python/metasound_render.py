@@ -1,25 +1,117 @@
-"""Placeholder implementation for MetaSound offline rendering."""
+"""Client helpers for metasound.render and metasound.sweep (offline MetaSound rendering)."""
 
 from __future__ import annotations
 
-from typing import Any, Dict
+import base64
+import struct
+from typing import Any, Dict, List, Mapping, Optional, Sequence
+
+from protocol import ATTACHMENT_REFERENCE_KEY
+
+FORMAT_WAV = "wav"
+FORMAT_PCM = "pcm"
 
 
 class MetaSoundRenderError(RuntimeError):
-    """Raised when offline rendering is not available."""
+    """Raised when a metasound.render result carries no usable audio."""
 
 
-def run(payload: Dict[str, Any]) -> Dict[str, Any]:
-    """Entry point for metasound.render_offline (not implemented)."""
+def build_request(
+    source_path: str,
+    params: Optional[Mapping[str, Any]] = None,
+    duration_sec: float = 5.0,
+    sample_rate: int = 48000,
+    fmt: str = FORMAT_WAV,
+    stop_when_finished: bool = True,
+    variants: Optional[Sequence[Mapping[str, Any]]] = None,
+    timeout_sec: Optional[float] = None,
+) -> Dict[str, Any]:
+    """Params for metasound.render. Keys of ``params`` may be typed as "Type:Name"."""
 
-    return {
-        "ok": False,
-        "error": {
-            "code": "NOT_IMPLEMENTED",
-            "message": "metasound.render_offline is not available in this build.",
-        },
+    if fmt not in (FORMAT_WAV, FORMAT_PCM):
+        raise ValueError(f"format must be {FORMAT_WAV!r} or {FORMAT_PCM!r}")
+    request: Dict[str, Any] = {
+        "sourcePath": source_path,
+        "durationSec": duration_sec,
+        "sampleRate": sample_rate,
+        "format": fmt,
+        "stopWhenFinished": stop_when_finished,
     }
+    if params:
+        request["params"] = dict(params)
+    if variants is not None:
+        request["variants"] = [dict(variant) for variant in variants]
+    if timeout_sec is not None:
+        request["timeoutSec"] = timeout_sec
+    return request
+
+
+def build_sweep_request(
+    source_path: str,
+    grid: Mapping[str, Sequence[Any]],
+    params: Optional[Mapping[str, Any]] = None,
+    duration_sec: float = 2.0,
+    sample_rate: int = 48000,
+    include_audio: bool = False,
+    fmt: str = FORMAT_WAV,
+    stop_when_finished: bool = True,
+    timeout_sec: Optional[float] = None,
+) -> Dict[str, Any]:
+    """Params for metasound.sweep: one variant per combination of the ``grid`` values."""
+
+    if not grid or any(not values for values in grid.values()):
+        raise ValueError("grid must map each parameter key to a non-empty list of values")
+    request = build_request(source_path, params, duration_sec, sample_rate, fmt, stop_when_finished, None, timeout_sec)
+    request["grid"] = {key: list(values) for key, values in grid.items()}
+    request["includeAudio"] = include_audio
+    return request
+
+
+def decode_audio(entry: Mapping[str, Any], attachments: Sequence[bytes] = ()) -> bytes:
+    """The audio bytes of a render result (or one of its variants).
+
+    Handles every way the editor delivers them: an attachment (already resolved to bytes, or
+    still a {"$attachment": index} reference into ``attachments``), a base64 string inlined in
+    the result, and a streamed response whose chunks the client joined into the same field.
+    """
+
+    audio = entry.get("audio")
+    if isinstance(audio, (bytes, bytearray)):
+        return bytes(audio)
+    if isinstance(audio, dict) and ATTACHMENT_REFERENCE_KEY in audio:
+        index = audio[ATTACHMENT_REFERENCE_KEY]
+        if not isinstance(index, int) or not 0 <= index < len(attachments):
+            raise MetaSoundRenderError(f"audio refers to missing attachment {index!r}")
+        return attachments[index]
+    if isinstance(audio, str):
+        try:
+            return base64.b64decode(audio, validate=True)
+        except ValueError as exc:
+            raise MetaSoundRenderError(f"audio is not valid base64: {exc}") from exc
+    raise MetaSoundRenderError("render result has no audio")
+
+
+def decode_variants(result: Mapping[str, Any], attachments: Sequence[bytes] = ()) -> List[bytes]:
+    """The audio of every variant of a batch render, in request order."""
+
+    return [decode_audio(variant, attachments) for variant in result.get("variants", [])]
+
+
+def pcm_to_floats(data: bytes) -> List[float]:
+    """Interleaved samples of a "pcm" render (little-endian float32)."""
 
+    if len(data) % 4:
+        raise MetaSoundRenderError("pcm data is not a whole number of float32 samples")
+    return list(struct.unpack(f"<{len(data) // 4}f", data))
 
-__all__ = ["run", "MetaSoundRenderError"]
 
+__all__ = [
+    "FORMAT_PCM",
+    "FORMAT_WAV",
+    "MetaSoundRenderError",
+    "build_request",
+    "build_sweep_request",
+    "decode_audio",
+    "decode_variants",
+    "pcm_to_floats",
+]
@@ -0,0 +1,162 @@
+"""Matches pipelined responses to the requests waiting for them, from threads or asyncio tasks.
+
+The editor answers up to ``windowMax`` requests at once and in any order (see ``Docs/Protocol.md``).
+One reader thread hands every response to :meth:`RequestDispatcher.resolve`, and each caller waits
+for its own ``requestId``, so requests no longer queue behind each other in the client.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import threading
+import time
+from typing import Any, Dict, List, Optional, Tuple
+
+from protocol import ProtocolError
+
+
+class PendingRequest:
+    """One request sent and not yet answered."""
+
+    __slots__ = ("request_id", "response", "error", "last_activity", "_done", "_futures")
+
+    def __init__(self, request_id: str) -> None:
+        self.request_id = request_id
+        self.response: Optional[Dict[str, Any]] = None
+        self.error: Optional[ProtocolError] = None
+        # Progress and stream frames count as activity, so a slow command that reports is not timed out.
+        self.last_activity = time.monotonic()
+        self._done = threading.Event()
+        self._futures: List[Tuple[asyncio.AbstractEventLoop, asyncio.Future]] = []
+
+    def done(self) -> bool:
+        return self._done.is_set()
+
+    def result(self) -> Dict[str, Any]:
+        if self.error is not None:
+            raise self.error
+        assert self.response is not None
+        return self.response
+
+
+def _settle(future: asyncio.Future) -> None:
+    if not future.done():
+        future.set_result(None)
+
+
+class RequestDispatcher:
+    """The requests in flight on one connection, at most ``window`` of them at a time."""
+
+    def __init__(self, window: int = 16) -> None:
+        self.window = max(1, window)
+        self._lock = threading.Condition()
+        self._pending: Dict[str, PendingRequest] = {}
+
+    def in_flight(self) -> int:
+        with self._lock:
+            return len(self._pending)
+
+    def acquire(self, request_id: str, timeout: Optional[float] = None) -> PendingRequest:
+        """Register ``request_id`` once the window has room; call before the request is written."""
+
+        deadline = None if timeout is None else time.monotonic() + timeout
+        with self._lock:
+            if request_id in self._pending:
+                raise ProtocolError("DUPLICATE_REQUEST", f"Request {request_id} is already in flight.")
+            while len(self._pending) >= self.window:
+                remaining = None if deadline is None else deadline - time.monotonic()
+                if remaining is not None and remaining <= 0:
+                    raise ProtocolError("WINDOW_FULL", "Timed out waiting for a free request slot.", {"window": self.window})
+                self._lock.wait(remaining)
+            pending = PendingRequest(request_id)
+            self._pending[request_id] = pending
+            return pending
+
+    def release(self, request_id: str) -> None:
+        """Forget a request that will not be answered (it could not be written, or its waiter gave up)."""
+
+        with self._lock:
+            if self._pending.pop(request_id, None) is not None:
+                self._lock.notify_all()
+
+    def touch(self, request_id: Optional[str]) -> None:
+        """Note a sign of life for ``request_id`` (a progress or stream frame)."""
+
+        if request_id is None:
+            return
+        with self._lock:
+            pending = self._pending.get(request_id)
+            if pending is not None:
+                pending.last_activity = time.monotonic()
+
+    def resolve(self, request_id: Optional[str], message: Dict[str, Any]) -> bool:
+        """Hand ``message`` to its request. False when nobody is waiting for it.
+
+        A response without a ``requestId`` goes to the only request in flight, if there is just one.
+        """
+
+        with self._lock:
+            if request_id is None and len(self._pending) == 1:
+                request_id = next(iter(self._pending))
+            pending = self._pending.pop(request_id, None) if request_id is not None else None
+            if pending is None:
+                return False
+            pending.response = message
+            self._complete(pending)
+            return True
+
+    def fail_all(self, error: ProtocolError) -> None:
+        """Fail every request in flight, e.g. when the connection drops."""
+
+        with self._lock:
+            pending_requests = list(self._pending.values())
+            self._pending.clear()
+            for pending in pending_requests:
+                pending.error = error
+                self._complete(pending)
+
+    def _complete(self, pending: PendingRequest) -> None:
+        # Called with the lock held.
+        pending._done.set()
+        for loop, future in pending._futures:
+            loop.call_soon_threadsafe(_settle, future)
+        pending._futures.clear()
+        self._lock.notify_all()
+
+    def _idle_remaining(self, pending: PendingRequest, idle_timeout: float) -> float:
+        return idle_timeout - (time.monotonic() - pending.last_activity)
+
+    def _timed_out(self, pending: PendingRequest) -> ProtocolError:
+        self.release(pending.request_id)
+        return ProtocolError("READ_TIMEOUT", "Timed out waiting for the response.", {"requestId": pending.request_id})
+
+    def wait(self, pending: PendingRequest, idle_timeout: float) -> Dict[str, Any]:
+        """Block until ``pending`` is answered, or raise READ_TIMEOUT after ``idle_timeout`` without activity."""
+
+        while not pending._done.wait(max(0.0, self._idle_remaining(pending, idle_timeout))):
+            if self._idle_remaining(pending, idle_timeout) <= 0 and not pending.done():
+                raise self._timed_out(pending)
+        return pending.result()
+
+    async def wait_async(self, pending: PendingRequest, idle_timeout: float) -> Dict[str, Any]:
+        """Like :meth:`wait`, without blocking the event loop."""
+
+        loop = asyncio.get_running_loop()
+        future = loop.create_future()
+        with self._lock:
+            if pending.done():
+                return pending.result()
+            pending._futures.append((loop, future))
+
+        while True:
+            try:
+                await asyncio.wait_for(asyncio.shield(future), max(0.0, self._idle_remaining(pending, idle_timeout)))
+                return pending.result()
+            except asyncio.TimeoutError:
+                if pending.done():
+                    return pending.result()
+                if self._idle_remaining(pending, idle_timeout) <= 0:
+                    raise self._timed_out(pending) from None
+
+
+__all__ = ["PendingRequest", "RequestDispatcher"]
@@ -1,40 +1,72 @@
-"""Lightweight structured logging helpers for the MCP server."""
+"""Lightweight structured logging helpers for the MCP server.
+
+Entries are queued and written by a background thread, so :func:`log_event` and :func:`log_metric`
+never wait on the disk. The writer keeps each file open, writes whatever arrived within
+``_FLUSH_INTERVAL_SEC`` in one go, and rotates on the byte count it has written. When the queue is
+full, entries are dropped and counted, and the count is logged once the writer catches up.
+"""
 from __future__ import annotations
 
+import atexit
 import json
 import os
+import queue
 import threading
+import time
 from pathlib import Path
-from typing import Any, Dict, Optional
+from typing import Any, Dict, List, Optional, Tuple
 
 _MAX_FILE_BYTES = 20 * 1024 * 1024
 _MAX_GENERATIONS = 3
+_MAX_QUEUED = 10000
+_FLUSH_INTERVAL_SEC = 0.2
 _LOCK = threading.RLock()
 _EVENTS_PATH: Optional[Path] = None
 _METRICS_PATH: Optional[Path] = None
+_WRITER: Optional["_Writer"] = None
 
 
 def init(directory: Path | str, enable: bool = True) -> None:
     """Initialise the structured log writers."""
-    global _EVENTS_PATH, _METRICS_PATH
+    global _EVENTS_PATH, _METRICS_PATH, _WRITER
 
-    if not enable:
-        _EVENTS_PATH = None
-        _METRICS_PATH = None
-        return
+    with _LOCK:
+        # Entries already queued still go to the files they were logged for.
+        if _WRITER is not None:
+            _WRITER.flush()
 
-    base = Path(directory)
-    base.mkdir(parents=True, exist_ok=True)
-    _EVENTS_PATH = base / "events.jsonl"
-    _METRICS_PATH = base / "metrics.jsonl"
+        if not enable:
+            _EVENTS_PATH = None
+            _METRICS_PATH = None
+            return
 
+        base = Path(directory)
+        base.mkdir(parents=True, exist_ok=True)
+        _EVENTS_PATH = base / "events.jsonl"
+        _METRICS_PATH = base / "metrics.jsonl"
+        if _WRITER is None:
+            _WRITER = _Writer()
+            atexit.register(close)
 
-def _rotate(path: Path) -> None:
-    if not path.exists():
-        return
-    if path.stat().st_size < _MAX_FILE_BYTES:
-        return
 
+def flush() -> None:
+    """Wait until everything logged so far is on disk."""
+
+    if _WRITER is not None:
+        _WRITER.flush()
+
+
+def close() -> None:
+    """Write out queued entries, close the files and stop the writer thread."""
+    global _WRITER
+
+    with _LOCK:
+        writer, _WRITER = _WRITER, None
+    if writer is not None:
+        writer.close()
+
+
+def _rotate(path: Path) -> None:
     for index in range(_MAX_GENERATIONS - 1, -1, -1):
         source = path if index == 0 else path.with_suffix(path.suffix + f".{index}")
         if not source.exists():
@@ -43,17 +75,133 @@ def _rotate(path: Path) -> None:
             source.unlink(missing_ok=True)
             continue
         dest = path.with_suffix(path.suffix + f".{index + 1}")
-        source.rename(dest)
+        source.replace(dest)
+
+
+class _LogFile:
+    """One append-only JSONL file, kept open between batches."""
+
+    __slots__ = ("path", "handle", "size")
+
+    def __init__(self, path: Path) -> None:
+        self.path = path
+        self.handle = None
+        self.size = 0
+
+    def _open(self) -> None:
+        self.path.parent.mkdir(parents=True, exist_ok=True)
+        self.handle = self.path.open("ab")
+        self.size = os.fstat(self.handle.fileno()).st_size
+
+    def write(self, data: bytes) -> None:
+        if self.handle is None:
+            self._open()
+        # Rotated before the batch that would cross the limit; a single oversized batch still goes out whole.
+        if self.size > 0 and self.size + len(data) > _MAX_FILE_BYTES:
+            self.close()
+            _rotate(self.path)
+            self._open()
+        self.handle.write(data)
+        self.handle.flush()
+        self.size += len(data)
+
+    def close(self) -> None:
+        if self.handle is not None:
+            self.handle.close()
+            self.handle = None
+
+
+class _Writer:
+    def __init__(self) -> None:
+        self._queue: "queue.Queue[Optional[Tuple[Path, Dict[str, Any]]]]" = queue.Queue(_MAX_QUEUED)
+        self._files: Dict[Path, _LogFile] = {}
+        self._dropped = 0
+        self._dropped_lock = threading.Lock()
+        self._thread = threading.Thread(target=self._run, name="observability-writer", daemon=True)
+        self._thread.start()
+
+    def submit(self, path: Path, payload: Dict[str, Any]) -> None:
+        try:
+            self._queue.put_nowait((path, payload))
+        except queue.Full:
+            with self._dropped_lock:
+                self._dropped += 1
+
+    def flush(self) -> None:
+        if self._thread.is_alive():
+            self._queue.join()
+
+    def close(self) -> None:
+        if self._thread.is_alive():
+            self._queue.put(None)
+            self._thread.join(timeout=5.0)
+
+    def _run(self) -> None:
+        while True:
+            item = self._queue.get()
+            items: List[Tuple[Path, Dict[str, Any]]] = []
+            taken = 1
+            stop = item is None
+            if item is not None:
+                items.append(item)
+            # Entries that arrive within the flush interval go out in the same write.
+            deadline = time.monotonic() + _FLUSH_INTERVAL_SEC
+            while not stop and len(items) < _MAX_QUEUED:
+                try:
+                    item = self._queue.get(timeout=max(0.0, deadline - time.monotonic()))
+                except queue.Empty:
+                    break
+                taken += 1
+                if item is None:
+                    stop = True
+                else:
+                    items.append(item)
+
+            self._write(items)
+            for _ in range(taken):
+                self._queue.task_done()
+            if stop:
+                for log_file in self._files.values():
+                    log_file.close()
+                self._files.clear()
+                return
+
+    def _write(self, items: List[Tuple[Path, Dict[str, Any]]]) -> None:
+        with self._dropped_lock:
+            dropped, self._dropped = self._dropped, 0
+        if dropped and _EVENTS_PATH is not None:
+            items.append((_EVENTS_PATH, {
+                "level": "warning",
+                "category": "observability.dropped",
+                "message": f"Dropped {dropped} log entries while the writer was behind",
+                "ts": _now_ms(),
+                "fields": {"dropped": dropped},
+            }))
+
+        batches: Dict[Path, List[str]] = {}
+        for path, payload in items:
+            try:
+                line = json.dumps(payload, separators=(",", ":"), default=str)
+            except (TypeError, ValueError):
+                continue
+            batches.setdefault(path, []).append(line)
+
+        for path, lines in batches.items():
+            log_file = self._files.get(path)
+            if log_file is None:
+                log_file = self._files[path] = _LogFile(path)
+            try:
+                log_file.write(("\n".join(lines) + "\n").encode("utf-8"))
+            except OSError:
+                # Logging must never take the server down; the next batch reopens the file.
+                log_file.close()
 
 
 def _write_line(path: Optional[Path], payload: Dict[str, Any]) -> None:
-    if path is None:
+    writer = _WRITER
+    if path is None or writer is None:
         return
-    with _LOCK:
-        _rotate(path)
-        with path.open("a", encoding="utf-8") as handle:
-            json.dump(payload, handle, separators=(",", ":"))
-            handle.write("\n")
+    writer.submit(path, payload)
 
 
 def log_event(
@@ -65,7 +213,7 @@ def log_event(
     fields: Optional[Dict[str, Any]] = None,
     ts_ms: Optional[float] = None,
 ) -> None:
-    """Append an event entry to the structured log."""
+    """Queue an event entry for the structured log. ``fields`` is encoded later; do not change it afterwards."""
     payload: Dict[str, Any] = {
         "level": (level or "info").lower(),
         "category": category,
@@ -84,7 +232,7 @@ def log_event(
 
 
 def log_metric(name: str, fields: Optional[Dict[str, Any]] = None) -> None:
-    """Append a metric entry to the structured log."""
+    """Queue a metric entry for the structured log. ``fields`` is encoded later; do not change it afterwards."""
     payload: Dict[str, Any] = {
         "metric": name,
         "ts": _now_ms(),
@@ -98,5 +246,4 @@ def _now_ms() -> float:
     return time.time() * 1000.0
 
 
-import time  # placed at end to avoid circular import during module load
-
+__all__ = ["close", "flush", "init", "log_event", "log_metric"]
@@ -0,0 +1,119 @@
+"""Answers to read-only tools kept in the MCP server until the editor reports a change.
+
+The editor tags every answer it could cache itself (``asset.find``, ``asset.metadata``,
+``sequence.list_bindings``, ...) with ``meta.cacheable`` and ``meta.cacheGen``, the generation of
+its response cache, and pushes ``cache.invalidated {generation}`` events when that generation moves. Mutations carry the
+generation they ended in. An answer is served from here only while it is from the newest
+generation the server has seen, so a repeated lookup during planning never round-trips, and
+nothing is served once the editor has changed anything.
+"""
+
+from __future__ import annotations
+
+import json
+import threading
+import time
+from collections import OrderedDict
+from copy import deepcopy
+from typing import Any, Dict, Optional, Set, Tuple
+
+
+class ReadCache:
+    """Bounded LRU of ``(command, params) -> response``, valid for one editor cache generation."""
+
+    def __init__(self, max_entries: int = 512, ttl_sec: float = 300.0) -> None:
+        self.max_entries = max_entries
+        # A backstop for events lost with a dropped connection; invalidation normally comes first.
+        self.ttl_sec = ttl_sec
+        self._lock = threading.Lock()
+        self._entries: "OrderedDict[str, Tuple[float, Dict[str, Any]]]" = OrderedDict()
+        # Commands the editor has tagged; only their params are ever keyed.
+        self._cacheable: Set[str] = set()
+        self._generation = -1
+        self._live = False
+        self.hits = 0
+
+    @property
+    def live(self) -> bool:
+        """True while the editor pushes invalidations to this connection."""
+
+        return self._live
+
+    def set_live(self, live: bool) -> None:
+        with self._lock:
+            self._live = live
+            self._entries.clear()
+            if not live:
+                self._generation = -1
+
+    def key(self, command: str, params: Dict[str, Any]) -> Optional[str]:
+        if not self._live or self.max_entries <= 0 or command not in self._cacheable:
+            return None
+        try:
+            return command + "\n" + json.dumps(params, sort_keys=True, separators=(",", ":"), ensure_ascii=False)
+        except (TypeError, ValueError):
+            return None
+
+    def get(self, key: Optional[str]) -> Optional[Dict[str, Any]]:
+        if key is None:
+            return None
+        with self._lock:
+            entry = self._entries.get(key)
+            if entry is None:
+                return None
+            if time.monotonic() - entry[0] > self.ttl_sec:
+                del self._entries[key]
+                return None
+            self._entries.move_to_end(key)
+            self.hits += 1
+            response = deepcopy(entry[1])
+        meta = response.setdefault("meta", {})
+        meta["clientCached"] = True
+        return response
+
+    def observe(self, generation: Any) -> None:
+        """Note a generation from an event or a response; a newer or negative one drops every entry."""
+
+        if not isinstance(generation, (int, float)) or isinstance(generation, bool):
+            return
+        generation = int(generation)
+        with self._lock:
+            if generation < 0 or generation > self._generation:
+                self._entries.clear()
+                self._generation = generation
+
+    def observe_response(self, command: str, params: Dict[str, Any], response: Any) -> None:
+        """Take in ``response``'s generation, and keep it if it is a cacheable, current answer."""
+
+        if not isinstance(response, dict):
+            return
+        meta = response.get("meta")
+        generation = meta.get("cacheGen") if isinstance(meta, dict) else None
+        if generation is None:
+            return
+        self.observe(generation)
+        if not response.get("ok") or meta.get("cacheable") is not True or meta.get("clientCached"):
+            return
+
+        self._cacheable.add(command)
+        key = self.key(command, params)
+        if key is None:
+            return
+        with self._lock:
+            # Computed before a change the server already knows of: not worth keeping.
+            if int(generation) != self._generation or self._generation < 0:
+                return
+            self._entries[key] = (time.monotonic(), deepcopy(response))
+            self._entries.move_to_end(key)
+            while len(self._entries) > self.max_entries:
+                self._entries.popitem(last=False)
+
+    def clear(self) -> None:
+        with self._lock:
+            self._entries.clear()
+
+    def __len__(self) -> int:
+        return len(self._entries)
+
+
+__all__ = ["ReadCache"]
@@ -0,0 +1,318 @@
+"""Replay a captured ``.mcptrace`` session against an editor and compare per-tool latency.
+
+The editor writes captures when ``bCaptureTraffic`` is on (see ``FTrafficRecorder``). Each
+captured connection is replayed on its own connection, keeping the original gaps between
+frames (divided by ``--speed``), and every response is timed. The report compares those
+times per tool with the response times recorded in the capture, or with an earlier report
+passed as ``--baseline``::
+
+    python replay_trace.py UnrealMCP_traffic_20261014-101500.mcptrace --speed 4 --out upgrade.json
+    python replay_trace.py UnrealMCP_traffic_20261014-101500.mcptrace --baseline upgrade.json
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import math
+import socket
+import struct
+import sys
+import threading
+import time
+import uuid
+from dataclasses import dataclass
+from typing import Any, BinaryIO, Dict, List, Optional, Tuple
+
+from protocol import FrameReader, ProtocolError, current_timestamp_ms, read_frame, write_frame
+from transport import DEFAULT_LOCAL_ENDPOINT, connect_local
+
+TRACE_MAGIC = b"MCPTRACE"
+TRACE_VERSION = 1
+_HEADER = struct.Struct("<8sHHq")
+_RECORD = struct.Struct("<BIQI")
+
+KIND_INBOUND = 0
+KIND_RESPONSE = 1
+
+# Negotiated per connection by the replayer itself; replaying the recorded ones would break it.
+_SKIPPED_TYPES = {"handshake", "ping", "pong", "shm/ready"}
+# Frames that precede or accompany a response rather than end it.
+_INTERIM_TYPES = {"event", "progress", "stream_begin", "stream_chunk", "ping", "pong"}
+
+
+@dataclass
+class TraceRecord:
+    kind: int
+    connection_id: int
+    offset_us: int
+    message: Dict[str, Any]
+
+
+def read_trace(stream: BinaryIO) -> Tuple[int, List[TraceRecord]]:
+    """Return the capture start (Unix ms) and its records, in file order."""
+
+    header = stream.read(_HEADER.size)
+    if len(header) != _HEADER.size:
+        raise ValueError("Not an MCP trace: file too short.")
+    magic, version, _reserved, start_unix_ms = _HEADER.unpack(header)
+    if magic != TRACE_MAGIC:
+        raise ValueError("Not an MCP trace: bad magic.")
+    if version != TRACE_VERSION:
+        raise ValueError(f"Unsupported MCP trace version {version}.")
+
+    records: List[TraceRecord] = []
+    while True:
+        prefix = stream.read(_RECORD.size)
+        if not prefix:
+            break
+        if len(prefix) != _RECORD.size:
+            # The editor was stopped mid-write; everything before is intact.
+            break
+        kind, connection_id, offset_us, length = _RECORD.unpack(prefix)
+        body = stream.read(length)
+        if len(body) != length:
+            break
+        records.append(TraceRecord(kind, connection_id, offset_us, json.loads(body.decode("utf-8"))))
+    return start_unix_ms, records
+
+
+def rewrite_request_ids(message: Dict[str, Any], suffix: str) -> Dict[str, Any]:
+    """Give a replayed request fresh ids so the editor's dedup window does not answer it from memory."""
+
+    message = json.loads(json.dumps(message))
+    if isinstance(message.get("requestId"), str):
+        message["requestId"] += suffix
+    meta = message.get("meta")
+    if isinstance(meta, dict) and isinstance(meta.get("requestId"), str):
+        meta["requestId"] += suffix
+    params = message.get("params")
+    if message.get("type") == "cancel" and isinstance(params, dict) and isinstance(params.get("requestId"), str):
+        params["requestId"] += suffix
+    return message
+
+
+def _request_id(message: Dict[str, Any]) -> Optional[str]:
+    meta = message.get("meta")
+    if isinstance(meta, dict) and isinstance(meta.get("requestId"), str):
+        return meta["requestId"]
+    value = message.get("requestId")
+    return value if isinstance(value, str) else None
+
+
+def percentile(values: List[float], quantile: float) -> float:
+    """Nearest-rank percentile; 0 for an empty list."""
+
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    rank = max(1, math.ceil(quantile * len(ordered)))
+    return ordered[min(rank, len(ordered)) - 1]
+
+
+def summarize(samples: Dict[str, List[float]]) -> Dict[str, Dict[str, float]]:
+    return {
+        tool: {
+            "count": len(values),
+            "p50Ms": percentile(values, 0.50),
+            "p95Ms": percentile(values, 0.95),
+            "maxMs": max(values),
+        }
+        for tool, values in samples.items()
+        if values
+    }
+
+
+class ReplayConnection:
+    """One replayed client connection: a scheduled sender and a reader that times responses."""
+
+    def __init__(self, args: argparse.Namespace, records: List[TraceRecord], suffix: str) -> None:
+        self._args = args
+        self._records = records
+        self._suffix = suffix
+        self._sock = None
+        self._send_lock = threading.Lock()
+        self._pending: Dict[str, Tuple[str, float]] = {}
+        self._pending_lock = threading.Condition()
+        self._window = 16
+        self._sending_done = False
+        self.samples: Dict[str, List[float]] = {}
+        self.errors: Dict[str, int] = {}
+        self.failure: Optional[str] = None
+
+    def run(self, start: float) -> None:
+        try:
+            self._connect()
+            reader = threading.Thread(target=self._read_loop, daemon=True)
+            reader.start()
+            self._send_all(start)
+            with self._pending_lock:
+                deadline = time.monotonic() + self._args.timeout
+                while self._pending and time.monotonic() < deadline:
+                    self._pending_lock.wait(0.1)
+                for _request_id, (tool, _sent) in self._pending.items():
+                    self.errors[f"{tool}:NO_RESPONSE"] = self.errors.get(f"{tool}:NO_RESPONSE", 0) + 1
+        except (OSError, ProtocolError) as exc:
+            self.failure = str(exc)
+        finally:
+            self._sending_done = True
+            if self._sock is not None:
+                try:
+                    self._sock.close()
+                except OSError:
+                    pass
+
+    def _connect(self) -> None:
+        if self._args.local:
+            self._sock = connect_local(self._args.local_endpoint, timeout=self._args.timeout)
+        else:
+            self._sock = socket.create_connection((self._args.host, self._args.port), timeout=self._args.timeout)
+        handshake = {
+            "type": "handshake",
+            "protocolVersion": 1.1,
+            "engineVersion": "5.6.x",
+            "pluginVersion": "replay-trace/1.0",
+            "sessionId": str(uuid.uuid4()),
+        }
+        write_frame(self._sock, handshake, timeout=self._args.timeout)
+        ack = read_frame(self._sock, timeout=self._args.timeout)
+        if ack.get("type") != "handshake/ack" or not ack.get("ok", False):
+            raise ProtocolError("PROTOCOL_VERSION_MISMATCH", "Protocol handshake rejected.", {"response": ack})
+        window = ack.get("windowMax")
+        if isinstance(window, int) and window > 0:
+            self._window = window
+
+    def _send_all(self, start: float) -> None:
+        for record in self._records:
+            if self._args.speed > 0:
+                delay = start + record.offset_us / 1_000_000.0 / self._args.speed - time.monotonic()
+                if delay > 0:
+                    time.sleep(delay)
+
+            message = rewrite_request_ids(record.message, self._suffix)
+            request_id = _request_id(message)
+            tool = str(message.get("type", ""))
+            with self._pending_lock:
+                # Stay inside the editor's window, as the original client had to.
+                while request_id and len(self._pending) >= self._window:
+                    self._pending_lock.wait(0.1)
+                if request_id:
+                    self._pending[request_id] = (tool, time.monotonic())
+            with self._send_lock:
+                write_frame(self._sock, message, timeout=self._args.timeout)
+
+    def _read_loop(self) -> None:
+        reader = FrameReader(self._sock)
+        while not self._sending_done:
+            try:
+                message = reader.read_frame(timeout=self._args.timeout)
+            except (OSError, ProtocolError):
+                return
+            message_type = message.get("type")
+            if message_type == "ping":
+                with self._send_lock:
+                    write_frame(self._sock, {"type": "pong", "ts": int(message.get("ts", current_timestamp_ms()))}, timeout=self._args.timeout)
+                continue
+            if message_type in _INTERIM_TYPES:
+                continue
+
+            request_id = _request_id(message)
+            with self._pending_lock:
+                entry = self._pending.pop(request_id, None) if request_id else None
+                self._pending_lock.notify_all()
+            if entry is None:
+                continue
+            tool, sent = entry
+            self.samples.setdefault(tool, []).append((time.monotonic() - sent) * 1000.0)
+            if not message.get("ok", False):
+                error = message.get("error")
+                code = error.get("code") if isinstance(error, dict) else None
+                key = f"{tool}:{code or 'ERROR'}"
+                self.errors[key] = self.errors.get(key, 0) + 1
+
+
+def recorded_samples(records: List[TraceRecord]) -> Dict[str, List[float]]:
+    samples: Dict[str, List[float]] = {}
+    for record in records:
+        if record.kind == KIND_RESPONSE and isinstance(record.message.get("durMs"), (int, float)):
+            samples.setdefault(str(record.message.get("tool", "")), []).append(float(record.message["durMs"]))
+    return samples
+
+
+def format_report(replay: Dict[str, Dict[str, float]], baseline: Dict[str, Dict[str, float]], baseline_label: str) -> str:
+    lines = [f"{'tool':<32} {'count':>6} {'p50 ms':>9} {'p95 ms':>9} {'max ms':>9}   vs {baseline_label}: p50 / p95"]
+    for tool in sorted(replay):
+        stats = replay[tool]
+        line = f"{tool:<32} {stats['count']:>6} {stats['p50Ms']:>9.2f} {stats['p95Ms']:>9.2f} {stats['maxMs']:>9.2f}"
+        reference = baseline.get(tool)
+        if reference:
+            line += f"   {stats['p50Ms'] - reference['p50Ms']:+8.2f} / {stats['p95Ms'] - reference['p95Ms']:+8.2f}"
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def replay(args: argparse.Namespace) -> int:
+    with open(args.trace, "rb") as stream:
+        _start_unix_ms, records = read_trace(stream)
+
+    by_connection: Dict[int, List[TraceRecord]] = {}
+    for record in records:
+        if record.kind == KIND_INBOUND and record.message.get("type") not in _SKIPPED_TYPES:
+            by_connection.setdefault(record.connection_id, []).append(record)
+    if not by_connection:
+        print("The trace has no requests to replay.", file=sys.stderr)
+        return 1
+
+    suffix = f"-replay{int(time.time())}"
+    connections = [ReplayConnection(args, by_connection[key], suffix) for key in sorted(by_connection)]
+    start = time.monotonic()
+    threads = [threading.Thread(target=connection.run, args=(start,)) for connection in connections]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    samples: Dict[str, List[float]] = {}
+    errors: Dict[str, int] = {}
+    for connection in connections:
+        if connection.failure:
+            print(f"Connection failed: {connection.failure}", file=sys.stderr)
+        for tool, values in connection.samples.items():
+            samples.setdefault(tool, []).extend(values)
+        for key, count in connection.errors.items():
+            errors[key] = errors.get(key, 0) + count
+
+    summary = summarize(samples)
+    if args.baseline:
+        with open(args.baseline, "r", encoding="utf-8") as handle:
+            baseline = json.load(handle).get("tools", {})
+        label = "baseline"
+    else:
+        baseline = summarize(recorded_samples(records))
+        label = "capture"
+
+    print(format_report(summary, baseline, label))
+    for key in sorted(errors):
+        print(f"error {key}: {errors[key]}")
+    if args.out:
+        with open(args.out, "w", encoding="utf-8") as handle:
+            json.dump({"trace": args.trace, "speed": args.speed, "tools": summary, "errors": errors}, handle, indent=2)
+    return 0 if all(connection.failure is None for connection in connections) else 2
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("trace", help="Path to a .mcptrace capture")
+    parser.add_argument("--speed", type=float, default=1.0, help="Time compression; 1 keeps the original pacing, 0 sends as fast as the window allows")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=12029)
+    parser.add_argument("--local", action="store_true", help="Use the local IPC endpoint instead of TCP")
+    parser.add_argument("--local-endpoint", default=DEFAULT_LOCAL_ENDPOINT)
+    parser.add_argument("--timeout", type=float, default=60.0, help="Seconds to wait for connects and outstanding responses")
+    parser.add_argument("--baseline", help="Report from an earlier --out to compare with instead of the capture")
+    parser.add_argument("--out", help="Write the per-tool summary as JSON")
+    return replay(parser.parse_args(argv))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,4 +1,11 @@
-"""Audit log signing helpers."""
+"""Audit log signing helpers.
+
+:meth:`AuditSigner.sign` signs one record. :meth:`AuditSigner.sign_batch` signs a whole batch with one
+HMAC over the root of a Merkle tree whose leaves are the records' hashes; each record keeps an
+inclusion proof (its sibling hashes up to the root), so any record can be checked against the signed
+root without the rest of the batch. Leaves and inner nodes are hashed with distinct prefixes, and an
+odd node is carried up unpaired rather than duplicated, so no two batches share a root.
+"""
 
 from __future__ import annotations
 
@@ -10,8 +17,9 @@ import uuid
 from dataclasses import dataclass
 from datetime import datetime, timezone
 from hashlib import sha256
+from collections import OrderedDict
 from threading import RLock
-from typing import Dict, Optional
+from typing import Dict, List, Optional, Sequence, Tuple
 
 
 def _canonicalize_payload(payload: Dict[str, object]) -> bytes:
@@ -20,18 +28,94 @@ def _canonicalize_payload(payload: Dict[str, object]) -> bytes:
     return json.dumps(payload, sort_keys=True, separators=(",", ":"), ensure_ascii=False).encode("utf-8")
 
 
+_LEAF_PREFIX = b"\x00"
+_NODE_PREFIX = b"\x01"
+
+
+def _leaf_hash(canonical: bytes) -> bytes:
+    return sha256(_LEAF_PREFIX + canonical).digest()
+
+
+def _node_hash(left: bytes, right: bytes) -> bytes:
+    return sha256(_NODE_PREFIX + left + right).digest()
+
+
 @dataclass
 class AuditRecord:
     request_id: str
     tool: str
     payload: Dict[str, object]
 
+    def canonical(self) -> bytes:
+        return _canonicalize_payload({"requestId": self.request_id, "tool": self.tool, **self.payload})
+
+
+# (sibling hash in hex, "L" or "R" for the side it is on), from the leaf up.
+InclusionProof = List[Tuple[str, str]]
+
+
+@dataclass
+class BatchSignature:
+    """One signature for a batch, plus what each record needs to show it belongs to it."""
+
+    root: str
+    count: int
+    signature: str
+    nonce: str
+    server_ts: str
+    proofs: List[InclusionProof]
+
+    def header(self) -> Dict[str, object]:
+        return {"root": self.root, "count": self.count, "nonce": self.nonce, "serverTs": self.server_ts}
+
+    def record_proof(self, index: int) -> Dict[str, object]:
+        """What to store beside record ``index``: the signed header, the signature and its proof."""
+
+        return {**self.header(), "auditSig": self.signature, "index": index, "proof": self.proofs[index]}
+
+
+def merkle_tree(leaves: Sequence[bytes]) -> Tuple[bytes, List[InclusionProof]]:
+    """Root of ``leaves`` and every leaf's inclusion proof, in one pass over the tree."""
+
+    if not leaves:
+        return sha256(_NODE_PREFIX).digest(), []
+
+    proofs: List[InclusionProof] = [[] for _ in leaves]
+    # members[i]: the leaves under level node i, whose proofs gain that node's sibling.
+    members: List[List[int]] = [[index] for index in range(len(leaves))]
+    level = list(leaves)
+    while len(level) > 1:
+        next_level: List[bytes] = []
+        next_members: List[List[int]] = []
+        for index in range(0, len(level) - 1, 2):
+            left, right = level[index], level[index + 1]
+            for leaf in members[index]:
+                proofs[leaf].append((right.hex(), "R"))
+            for leaf in members[index + 1]:
+                proofs[leaf].append((left.hex(), "L"))
+            next_level.append(_node_hash(left, right))
+            next_members.append(members[index] + members[index + 1])
+        if len(level) % 2:
+            next_level.append(level[-1])
+            next_members.append(members[-1])
+        level, members = next_level, next_members
+    return level[0], proofs
+
+
+def merkle_root_from_proof(leaf: bytes, proof: InclusionProof) -> bytes:
+    node = leaf
+    for sibling_hex, side in proof:
+        sibling = bytes.fromhex(sibling_hex)
+        node = _node_hash(sibling, node) if side == "L" else _node_hash(node, sibling)
+    return node
+
 
 class AuditSigner:
     def __init__(self, secret: Optional[str]) -> None:
         self.secret = secret.encode("utf-8") if secret else None
         self._lock = RLock()
-        self._recent: Dict[str, float] = {}
+        # Oldest first, so pruning stops at the first nonce still inside the TTL.
+        self._recent: "OrderedDict[str, float]" = OrderedDict()
         self.ttl = 3600.0
 
     def is_available(self) -> bool:
@@ -52,6 +136,40 @@ class AuditSigner:
             self._recent[nonce] = timestamp
         return {"auditSig": signature, "nonce": nonce, "serverTs": server_ts}
 
+    def sign_batch(self, records: Sequence[AuditRecord]) -> Optional[BatchSignature]:
+        """Sign ``records`` with one HMAC, over their Merkle root. Each record is canonicalized once."""
+
+        if not self.secret:
+            return None
+        root, proofs = merkle_tree([_leaf_hash(record.canonical()) for record in records])
+        server_ts = datetime.now(tz=timezone.utc).isoformat().replace("+00:00", "Z")
+        nonce = str(uuid.uuid4())
+        batch = BatchSignature(root.hex(), len(records), "", nonce, server_ts, proofs)
+        batch.signature = self._mac(batch.header())
+        with self._lock:
+            timestamp = time.time()
+            self._prune_locked(timestamp)
+            self._recent[nonce] = timestamp
+        return batch
+
+    def verify_record(self, record: AuditRecord, record_proof: Dict[str, object]) -> bool:
+        """True when ``record`` is the one ``record_proof`` (from :meth:`BatchSignature.record_proof`) signed."""
+
+        if not self.secret:
+            return False
+        try:
+            header = {key: record_proof[key] for key in ("root", "count", "nonce", "serverTs")}
+            proof = [(str(sibling), str(side)) for sibling, side in record_proof["proof"]]  # type: ignore[union-attr]
+            if not hmac.compare_digest(self._mac(header), str(record_proof["auditSig"])):
+                return False
+            return merkle_root_from_proof(_leaf_hash(record.canonical()), proof).hex() == header["root"]
+        except (KeyError, TypeError, ValueError):
+            return False
+
+    def _mac(self, header: Dict[str, object]) -> str:
+        assert self.secret is not None
+        return base64.b64encode(hmac.new(self.secret, _canonicalize_payload(header), sha256).digest()).decode("ascii")
+
     def verify_nonce(self, nonce: str) -> bool:
         with self._lock:
             timestamp = time.time()
@@ -62,9 +180,11 @@ class AuditSigner:
         return True
 
     def _prune_locked(self, now: float) -> None:
-        expired = [key for key, ts in self._recent.items() if now - ts > self.ttl]
-        for key in expired:
-            self._recent.pop(key, None)
+        while self._recent:
+            key, ts = next(iter(self._recent.items()))
+            if now - ts <= self.ttl:
+                break
+            del self._recent[key]
 
 
 def load_secret_from_env(env_var: str) -> Optional[str]:
@@ -74,4 +194,4 @@ def load_secret_from_env(env_var: str) -> Optional[str]:
     return None
 
 
-__all__ = ["AuditRecord", "AuditSigner", "load_secret_from_env"]
+__all__ = ["AuditRecord", "AuditSigner", "BatchSignature", "load_secret_from_env", "merkle_root_from_proof", "merkle_tree"]
@@ -4,45 +4,111 @@ from __future__ import annotations
 
 import fnmatch
 import os
+import re
 from dataclasses import dataclass, field
+from functools import lru_cache
 from pathlib import Path
 from threading import RLock
-from typing import Dict, Iterable, List, Optional
+from typing import Dict, Iterable, List, Optional, Pattern, Tuple
 
 import yaml
 
+_WILDCARDS = frozenset("*?[")
+
+
+class _PatternSet:
+    """fnmatch patterns compiled for repeated matching.
+
+    Plain names go in a set, ``prefix*`` patterns become one ``str.startswith`` tuple, and the
+    rest are joined into a single regex, so a lookup is at most three C-level checks however many
+    patterns there are.
+    """
+
+    __slots__ = ("exact", "prefixes", "regex")
+
+    def __init__(self, patterns: Iterable[str]) -> None:
+        exact = set()
+        prefixes = []
+        translated = []
+        for pattern in patterns:
+            head = pattern[:-1]
+            if not _WILDCARDS.intersection(pattern):
+                exact.add(pattern)
+            elif pattern.endswith("*") and not _WILDCARDS.intersection(head):
+                prefixes.append(head)
+            else:
+                translated.append(fnmatch.translate(pattern))
+        self.exact = frozenset(exact)
+        self.prefixes: Tuple[str, ...] = tuple(sorted(set(prefixes)))
+        self.regex: Optional[Pattern[str]] = re.compile("|".join(translated)) if translated else None
+
+    def __bool__(self) -> bool:
+        return bool(self.exact or self.prefixes or self.regex)
+
+    def matches(self, target: str) -> bool:
+        if target in self.exact:
+            return True
+        if self.prefixes and target.startswith(self.prefixes):
+            return True
+        return self.regex is not None and self.regex.match(target) is not None
+
+
+class PatternMatcher:
+    """Allow/deny patterns compiled once; a matching deny beats any allow.
+
+    Answers are memoised per target, since a server asks about the same few tools over and over.
+    """
+
+    MAX_CACHED = 4096
+
+    def __init__(self, allow: Iterable[str], deny: Iterable[str]) -> None:
+        self._allow = _PatternSet(allow)
+        self._deny = _PatternSet(deny)
+        self._results: Dict[str, bool] = {}
+
+    @classmethod
+    def from_patterns(cls, patterns: Iterable[str]) -> "PatternMatcher":
+        """Build from one list where ``!pattern`` entries are denies."""
+
+        allow: List[str] = []
+        deny: List[str] = []
+        for pattern in normalize_patterns(patterns):
+            if pattern.startswith("!"):
+                candidate = pattern[1:].strip()
+                if candidate:
+                    deny.append(candidate)
+            else:
+                allow.append(pattern)
+        return cls(allow, deny)
+
+    def evaluate(self, target: str) -> bool:
+        result = self._results.get(target)
+        if result is None:
+            result = not self._deny.matches(target) and self._allow.matches(target)
+            if len(self._results) >= self.MAX_CACHED:
+                self._results.clear()
+            self._results[target] = result
+        return result
+
 
 @dataclass
 class RoleRules:
-    """Allow and deny patterns for a specific role."""
+    """Allow and deny patterns for a specific role.
+
+    The patterns are compiled on construction; replace the rules rather than editing the lists.
+    """
 
     allow: List[str] = field(default_factory=list)
     deny: List[str] = field(default_factory=list)
+    _matcher: PatternMatcher = field(init=False, repr=False, compare=False)
+
+    def __post_init__(self) -> None:
+        self._matcher = PatternMatcher.from_patterns(self.allow + [f"!{pattern}" for pattern in self.deny])
 
     def evaluate(self, tool: str) -> bool:
         """Return ``True`` when ``tool`` is permitted for the role."""
 
-        normalized_tool = tool or ""
-        explicit_allow = False
-
-        patterns = self.allow + [f"!{pattern}" for pattern in self.deny]
-        if not patterns:
-            return False
-
-        for pattern in patterns:
-            pattern = pattern.strip()
-            if not pattern:
-                continue
-            is_deny = pattern.startswith("!")
-            if is_deny:
-                pattern = pattern[1:].strip()
-            if not pattern:
-                continue
-            if fnmatch.fnmatchcase(normalized_tool, pattern):
-                if is_deny:
-                    return False
-                explicit_allow = True
-        return explicit_allow
+        return self._matcher.evaluate(tool or "")
 
 
 @dataclass
@@ -51,6 +117,8 @@ class PolicyLimits:
     rate_per_minute_per_tool: int = 30
     request_size_kb: int = 512
     array_items_max: int = 10_000
+    # Per-tool cost overrides (exact names or fnmatch patterns) on top of rate_limit.DEFAULT_TOOL_COSTS.
+    tool_costs: Dict[str, float] = field(default_factory=dict)
 
 
 @dataclass
@@ -73,7 +141,7 @@ class Policy:
     audit: AuditRules = field(default_factory=AuditRules)
 
     def role_rules(self, role: str) -> RoleRules:
-        return self.roles.get(role, RoleRules())
+        return self.roles.get(role, _NO_RULES)
 
     def is_tool_allowed(self, role: str, tool: str) -> bool:
         rules = self.role_rules(role)
@@ -118,11 +186,20 @@ class PolicyLoader:
                 roles[name] = RoleRules(allow=allow, deny=deny)
 
         limits_data = data.get("limits", {}) if isinstance(data, dict) else {}
+        costs_data = limits_data.get("tool_costs", {})
+        tool_costs: Dict[str, float] = {}
+        if isinstance(costs_data, dict):
+            for name, cost in costs_data.items():
+                try:
+                    tool_costs[str(name)] = float(cost)
+                except (TypeError, ValueError):
+                    continue
         limits = PolicyLimits(
             rate_per_minute_global=int(limits_data.get("rate_per_minute_global", 120)),
             rate_per_minute_per_tool=int(limits_data.get("rate_per_minute_per_tool", 30)),
             request_size_kb=int(limits_data.get("request_size_kb", 512)),
             array_items_max=int(limits_data.get("array_items_max", 10_000)),
+            tool_costs=tool_costs,
         )
 
         paths_data = data.get("paths", {}) if isinstance(data, dict) else {}
@@ -149,6 +226,13 @@ def normalize_patterns(patterns: Iterable[str]) -> List[str]:
     return normalized
 
 
+@lru_cache(maxsize=256)
+def compile_patterns(patterns: Tuple[str, ...]) -> PatternMatcher:
+    """The compiled matcher for ``patterns``, built once per distinct tuple."""
+
+    return PatternMatcher.from_patterns(patterns)
+
+
 def evaluate_patterns(patterns: Iterable[str], target: str) -> bool:
     """Evaluate allow/deny patterns in order for *target*.
 
@@ -157,26 +241,20 @@ def evaluate_patterns(patterns: Iterable[str], target: str) -> bool:
     and no matching deny.
     """
 
-    normalized_patterns = normalize_patterns(patterns)
-    allowed = False
-    for pattern in normalized_patterns:
-        negate = pattern.startswith("!")
-        candidate = pattern[1:].strip() if negate else pattern
-        if not candidate:
-            continue
-        if fnmatch.fnmatchcase(target, candidate):
-            if negate:
-                return False
-            allowed = True
-    return allowed
+    return compile_patterns(tuple(patterns)).evaluate(target)
+
+
+_NO_RULES = RoleRules()
 
 
 __all__ = [
     "AuditRules",
     "PathRules",
+    "PatternMatcher",
     "Policy",
     "PolicyLimits",
     "PolicyLoader",
     "RoleRules",
+    "compile_patterns",
     "evaluate_patterns",
 ]
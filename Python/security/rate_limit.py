@@ -1,46 +1,115 @@
-"""Token bucket rate limiting helpers."""
+"""Token bucket rate limiting helpers, weighted by what each tool costs the editor."""
 
 from __future__ import annotations
 
+import fnmatch
+import threading
 import time
-from collections import defaultdict, deque
-from dataclasses import dataclass
-from typing import Deque, Dict, Tuple
+from dataclasses import dataclass, field
+from typing import Dict, Optional, Tuple
+
+# Relative cost of one call, in units of an ordinary command. Exact names win over patterns;
+# patterns are tried in order. Lookups and pings are nearly free; imports, saves and scans
+# hold the game thread for seconds.
+DEFAULT_TOOL_COSTS: Dict[str, float] = {
+    "ping": 0.1,
+    "cancel": 0.0,
+    "job.status": 0.1,
+    "asset.exists": 0.25,
+    "asset.find": 0.5,
+    "asset.batch_import": 10.0,
+    "asset.save_all": 8.0,
+    "asset.fix_redirectors": 8.0,
+    "blueprint.compile_many": 8.0,
+    "sequence.export": 5.0,
+    "sequence.evaluate_range": 5.0,
+    "content.*": 5.0,
+}
 
 
 @dataclass
 class RateLimitConfig:
+    # Cost units refilled per minute; a full minute's worth may be spent in one burst.
     per_minute_global: int
     per_minute_tool: int
+    tool_costs: Dict[str, float] = field(default_factory=lambda: dict(DEFAULT_TOOL_COSTS))
+    default_cost: float = 1.0
+
+
+class TokenBucket:
+    """``capacity`` tokens, refilled continuously at ``capacity`` per ``period`` seconds."""
+
+    __slots__ = ("capacity", "refill_per_sec", "tokens", "updated")
+
+    def __init__(self, capacity: float, period: float, now: float) -> None:
+        self.capacity = max(0.0, float(capacity))
+        self.refill_per_sec = self.capacity / period if period > 0 else 0.0
+        self.tokens = self.capacity
+        self.updated = now
+
+    def _refill(self, now: float) -> None:
+        if now > self.updated:
+            self.tokens = min(self.capacity, self.tokens + (now - self.updated) * self.refill_per_sec)
+        self.updated = now
+
+    def wait_for(self, cost: float, now: float) -> float:
+        """Seconds until ``cost`` tokens are available; 0 when they are now."""
+
+        self._refill(now)
+        # A call dearer than the whole bucket only has to wait for a full one.
+        cost = min(cost, self.capacity)
+        if self.tokens >= cost:
+            return 0.0
+        if self.refill_per_sec <= 0:
+            return float("inf")
+        return (cost - self.tokens) / self.refill_per_sec
+
+    def take(self, cost: float) -> None:
+        self.tokens -= min(cost, self.capacity)
 
 
 class RateLimiter:
     def __init__(self, config: RateLimitConfig) -> None:
         self.config = config
         self.window = 60.0
-        self.global_hits: Deque[float] = deque()
-        self.tool_hits: Dict[str, Deque[float]] = defaultdict(deque)
+        self._lock = threading.Lock()
+        self._global = TokenBucket(config.per_minute_global, self.window, time.monotonic())
+        self._tools: Dict[str, TokenBucket] = {}
+        self._costs: Dict[str, float] = {}
+
+    def cost_of(self, tool: str) -> float:
+        cost = self._costs.get(tool)
+        if cost is None:
+            cost = self.config.tool_costs.get(tool)
+            if cost is None:
+                cost = next(
+                    (value for pattern, value in self.config.tool_costs.items() if fnmatch.fnmatchcase(tool, pattern)),
+                    self.config.default_cost,
+                )
+            cost = max(0.0, float(cost))
+            self._costs[tool] = cost
+        return cost
 
-    def _prune(self, hits: Deque[float], now: float) -> None:
-        while hits and now - hits[0] > self.window:
-            hits.popleft()
+    def check(self, tool: str, cost: Optional[float] = None) -> Tuple[bool, float]:
+        """Spend ``cost`` (default: the tool's weight) from the global and the tool's bucket.
 
-    def check(self, tool: str) -> Tuple[bool, float]:
-        now = time.time()
-        self._prune(self.global_hits, now)
-        self._prune(self.tool_hits[tool], now)
+        Returns ``(allowed, retry_after_sec)``. Nothing is spent unless both buckets can pay.
+        """
 
-        if len(self.global_hits) >= self.config.per_minute_global:
-            retry = max(0.0, self.window - (now - self.global_hits[0]))
-            return False, retry
+        cost = self.cost_of(tool) if cost is None else max(0.0, float(cost))
+        now = time.monotonic()
+        with self._lock:
+            bucket = self._tools.get(tool)
+            if bucket is None:
+                bucket = self._tools[tool] = TokenBucket(self.config.per_minute_tool, self.window, now)
 
-        if len(self.tool_hits[tool]) >= self.config.per_minute_tool:
-            retry = max(0.0, self.window - (now - self.tool_hits[tool][0]))
-            return False, retry
+            retry = max(self._global.wait_for(cost, now), bucket.wait_for(cost, now))
+            if retry > 0:
+                return False, retry
 
-        self.global_hits.append(now)
-        self.tool_hits[tool].append(now)
-        return True, 0.0
+            self._global.take(cost)
+            bucket.take(cost)
+            return True, 0.0
 
 
-__all__ = ["RateLimitConfig", "RateLimiter"]
+__all__ = ["DEFAULT_TOOL_COSTS", "RateLimitConfig", "RateLimiter", "TokenBucket"]
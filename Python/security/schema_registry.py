@@ -1,8 +1,12 @@
-"""JSON Schema registry for sensitive MCP tools."""
+"""JSON Schema registry for MCP tool parameters, read from the plugin's Resources/ParamSchemas.json."""
 
 from __future__ import annotations
 
-from typing import Any, Dict, Optional
+import json
+import os
+from pathlib import Path
+from threading import Lock
+from typing import Any, Dict, Optional, Tuple
 
 try:
     import jsonschema
@@ -10,45 +14,65 @@ except ImportError:  # pragma: no cover - jsonschema is an optional dependency
     jsonschema = None  # type: ignore
 
 
-SCHEMAS: Dict[str, Dict[str, Any]] = {
-    "asset.batch_import": {
-        "type": "object",
-        "properties": {
-            "files": {
-                "type": "array",
-                "items": {"type": "object"},
-                "maxItems": 10000,
-            },
-            "confirm": {"type": "boolean"},
-        },
-        "required": ["files"],
-        "additionalProperties": True,
-    },
-    "sequence.create": {
-        "type": "object",
-        "properties": {
-            "name": {"type": "string"},
-            "path": {"type": "string"},
-        },
-        "required": ["name", "path"],
-        "additionalProperties": False,
-    },
-}
+# The plugin validates the same file natively before queueing a command (see FParamSchema), so a
+# request the server lets through is never rejected for a different reason by the editor.
+DEFAULT_SCHEMA_PATH = (
+    Path(__file__).resolve().parents[2] / "MCPGameProject" / "Plugins" / "UnrealMCP" / "Resources" / "ParamSchemas.json"
+)
+
+
+def load_schemas(path: Optional[Path] = None) -> Dict[str, Dict[str, Any]]:
+    """The ``tools`` map of a parameter schema file; empty when it is missing or unreadable."""
+
+    path = path or Path(os.environ.get("UNREAL_MCP_PARAM_SCHEMAS") or DEFAULT_SCHEMA_PATH)
+    try:
+        with path.open("r", encoding="utf-8") as handle:
+            tools = json.load(handle).get("tools")
+    except (OSError, ValueError, AttributeError):
+        return {}
+    return tools if isinstance(tools, dict) else {}
+
+
+SCHEMAS: Dict[str, Dict[str, Any]] = load_schemas()
 
 
 def get_schema(tool: str) -> Optional[Dict[str, Any]]:
     return SCHEMAS.get(tool)
 
 
-def validate(tool: str, params: Dict[str, Any]) -> Optional[str]:
+# tool -> (schema it was built from, validator). jsonschema.validate checks the schema and builds a
+# validator on every call; reusing one makes validation of a small payload several times cheaper.
+_VALIDATORS: Dict[str, Tuple[Dict[str, Any], Any]] = {}
+_VALIDATORS_LOCK = Lock()
+
+
+def get_validator(tool: str) -> Any:
+    """The validator for ``tool``'s schema, or None. Rebuilt when ``SCHEMAS[tool]`` is replaced."""
+
     schema = get_schema(tool)
     if not schema or not jsonschema:
         return None
+    cached = _VALIDATORS.get(tool)
+    if cached is not None and cached[0] is schema:
+        return cached[1]
+    with _VALIDATORS_LOCK:
+        validator_class = jsonschema.validators.validator_for(schema)
+        validator_class.check_schema(schema)
+        validator = validator_class(schema)
+        _VALIDATORS[tool] = (schema, validator)
+    return validator
+
+
+def validate(tool: str, params: Dict[str, Any]) -> Optional[str]:
     try:
-        jsonschema.validate(instance=params, schema=schema)  # type: ignore[arg-type]
+        validator = get_validator(tool)
+        if validator is None or validator.is_valid(params):
+            return None
+        # The same error jsonschema.validate would raise.
+        error = jsonschema.exceptions.best_match(validator.iter_errors(params))
     except Exception as exc:  # pragma: no cover - error path
         return str(exc)
-    return None
+    return str(error) if error is not None else None
 
 
-__all__ = ["get_schema", "validate"]
+__all__ = ["DEFAULT_SCHEMA_PATH", "SCHEMAS", "get_schema", "get_validator", "load_schemas", "validate"]
@@ -0,0 +1,92 @@
+"""Client helpers for sequence.export with format "columnar" (binary key arrays)."""
+
+from __future__ import annotations
+
+import base64
+import json
+import struct
+import sys
+from array import array
+from typing import Any, Dict, List, Mapping, Sequence
+
+from protocol import ATTACHMENT_REFERENCE_KEY
+
+MAGIC = b"UMCPCOL1"
+VERSION = 1
+
+INTERP_MODES = ("linear", "constant", "cubic", "none")
+TANGENT_MODES = ("auto", "user", "break", "none", "smartAuto")
+
+_TYPECODES = {"f32": "f", "i32": "i"}
+
+
+class ColumnarExportError(RuntimeError):
+    """Raised when a columnar export is missing or malformed."""
+
+
+def columnar_bytes(result: Mapping[str, Any], attachments: Sequence[bytes] = ()) -> bytes:
+    """The container bytes of a sequence.export result: an attachment or a base64 string."""
+
+    payload = result.get("columnar")
+    if isinstance(payload, (bytes, bytearray)):
+        return bytes(payload)
+    if isinstance(payload, dict) and ATTACHMENT_REFERENCE_KEY in payload:
+        index = payload[ATTACHMENT_REFERENCE_KEY]
+        if not isinstance(index, int) or not 0 <= index < len(attachments):
+            raise ColumnarExportError(f"columnar refers to missing attachment {index!r}")
+        return attachments[index]
+    if isinstance(payload, str):
+        try:
+            return base64.b64decode(payload, validate=True)
+        except ValueError as exc:
+            raise ColumnarExportError(f"columnar is not valid base64: {exc}") from exc
+    raise ColumnarExportError("result has no columnar data")
+
+
+def _read_array(data: memoryview, typecode: str, offset: int, count: int) -> array:
+    values = array(typecode)
+    end = offset + count * values.itemsize
+    if offset < 0 or end > len(data):
+        raise ColumnarExportError("column runs past the end of the data")
+    values.frombytes(data[offset:end])
+    if sys.byteorder == "big":
+        values.byteswap()
+    return values
+
+
+def decode(data: bytes) -> Dict[str, Any]:
+    """The header of a columnar export, with each series' ``frames`` and columns' ``values`` filled in."""
+
+    if len(data) < len(MAGIC) + 4 or data[: len(MAGIC)] != MAGIC:
+        raise ColumnarExportError("not a columnar export")
+    (header_length,) = struct.unpack_from("<I", data, len(MAGIC))
+    header_start = len(MAGIC) + 4
+    header_end = header_start + header_length
+    if header_end > len(data):
+        raise ColumnarExportError("header runs past the end of the data")
+    header = json.loads(data[header_start:header_end].decode("utf-8"))
+    if header.get("version") != VERSION:
+        raise ColumnarExportError(f"unsupported columnar version {header.get('version')!r}")
+
+    body = memoryview(data)[(header_end + 7) // 8 * 8 :]
+    series_list: List[Dict[str, Any]] = header.get("series", [])
+    for series in series_list:
+        count = series["count"]
+        series["frames"] = _read_array(body, "i", series["frames"], count)
+        for column in series["columns"]:
+            typecode = _TYPECODES.get(column["type"])
+            if typecode is None:
+                raise ColumnarExportError(f"unknown column type {column['type']!r}")
+            column["values"] = _read_array(body, typecode, column["offset"], count)
+    return header
+
+
+__all__ = [
+    "INTERP_MODES",
+    "MAGIC",
+    "TANGENT_MODES",
+    "VERSION",
+    "ColumnarExportError",
+    "columnar_bytes",
+    "decode",
+]
@@ -0,0 +1,27 @@
+from security.audit_sign import AuditRecord, AuditSigner, merkle_root_from_proof, merkle_tree
+
+
+def test_audit_batch_signature_proves_each_record():
+    signer = AuditSigner("secret")
+    for count in (1, 2, 5, 8):
+        records = [AuditRecord(f"r{i}", "asset.rename", {"from": f"/Game/A{i}", "to": f"/Game/B{i}"}) for i in range(count)]
+        batch = signer.sign_batch(records)
+        assert batch is not None and batch.count == count
+        for index, record in enumerate(records):
+            assert signer.verify_record(record, batch.record_proof(index)), (count, index)
+
+        # A changed record, a proof for another slot, or another key all fail.
+        tampered = AuditRecord("r0", "asset.rename", {"from": "/Game/A0", "to": "/Game/Elsewhere"})
+        assert not signer.verify_record(tampered, batch.record_proof(0))
+        if count > 1:
+            assert not signer.verify_record(records[0], batch.record_proof(1))
+        assert not AuditSigner("other").verify_record(records[0], batch.record_proof(0))
+
+
+def test_merkle_tree_carries_odd_leaves_up():
+    # An odd leaf is carried up, not paired with itself, so [a, b, c] and [a, b, c, c] differ.
+    leaves = [bytes([value]) * 32 for value in range(3)]
+    root, proofs = merkle_tree(leaves)
+    assert root != merkle_tree(leaves + leaves[-1:])[0]
+    assert all(merkle_root_from_proof(leaf, proof) == root for leaf, proof in zip(leaves, proofs))
+    assert AuditSigner(None).sign_batch([]) is None
@@ -0,0 +1,76 @@
+import importlib.util
+import sys
+from pathlib import Path
+
+import pytest
+
+
+def _load_bench():
+    # The CLI is its own package under cli/; load its bench module from there rather than putting
+    # cli/ on sys.path for every test in the session.
+    path = Path(__file__).resolve().parent / "cli" / "mcp_cli" / "bench.py"
+    spec = importlib.util.spec_from_file_location("mcp_cli_bench_under_test", path)
+    module = importlib.util.module_from_spec(spec)
+    sys.modules[spec.name] = module
+    spec.loader.exec_module(module)
+    return module
+
+
+bench = _load_bench()
+
+
+class FakeConnection:
+    def __init__(self, encoding):
+        self.encoding = encoding
+        self.compress_threshold = 0
+        self.sent = []
+
+    def send_command(self, tool, params):
+        self.sent.append((tool, params))
+        return {"ok": tool != "asset.exists", "error": {"code": "NOT_FOUND"}}
+
+    def disconnect(self):
+        pass
+
+
+def test_cli_bench_parses_options():
+    assert bench.parse_sizes("0, 4k,1m") == [0, 4096, 1024 * 1024]
+    assert bench.parse_mix("ping=4,asset.find") == [("ping", 4.0), ("asset.find", 1.0)]
+    with pytest.raises(bench.BenchError):
+        bench.parse_mix("ping=0")
+    variants = bench.parse_variants("tcp,ipc", "json,cbor", "off,on")
+    assert len(variants) == 8 and variants[0].label == "tcp/json/raw" and variants[-1].label == "local/cbor/zlib"
+    assert bench.percentile([5.0, 1.0, 3.0, 2.0], 0.5) == 2.0 and bench.percentile([], 0.99) == 0.0
+    assert len(bench.build_params("ping", 1000, {})["padding"]) == 1000
+    assert bench.build_params("asset.find", 1000, {"asset.find": {"limit": 5}}) == {"limit": 5}
+
+
+def test_cli_bench_runs_and_skips_unavailable_variants():
+    connections = {}
+
+    def connect(variant):
+        if variant.transport == "local":
+            return None
+        # The editor only speaks JSON here, so the CBOR run must be skipped, not mislabelled.
+        connections[variant.label] = FakeConnection("json")
+        return connections[variant.label]
+
+    results = bench.run_benchmark(
+        bench.parse_variants("tcp,local", "json,cbor", "off"),
+        mix=[("ping", 1.0), ("asset.exists", 1.0)],
+        concurrency=[1, 3],
+        payload_sizes=[0, 64],
+        duration=60.0,
+        max_requests=30,
+        warmup=2,
+        connect=connect,
+    )
+    assert [(r["variant"], r["concurrency"], r["payloadBytes"]) for r in results["runs"]] == [
+        ("tcp/json/raw", 1, 0), ("tcp/json/raw", 3, 0), ("tcp/json/raw", 1, 64), ("tcp/json/raw", 3, 64)
+    ]
+    assert {s["variant"]: s["reason"] for s in results["skipped"]}["local/json/raw"] == "could not connect"
+    assert "cbor" in {s["variant"]: s["reason"] for s in results["skipped"]}["tcp/cbor/raw"]
+    run = results["runs"][3]
+    assert run["requests"] == 30 and run["errors"] == run["errorCodes"]["NOT_FOUND"] == run["perTool"]["asset.exists"]["count"]
+    assert len(connections["tcp/json/raw"].sent) == 4 * 30 + 2 * 2
+    assert all(len(p["padding"]) == 64 for t, p in connections["tcp/json/raw"].sent[-30:] if t == "ping")
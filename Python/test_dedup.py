@@ -0,0 +1,26 @@
+from dedup import DedupStore
+
+
+def test_dedup_store_evicts_stubs_and_compacts(tmp_path):
+    journal = tmp_path / "dedup.jsonl"
+    store = DedupStore(journal_path=journal, max_entries=3, max_body_bytes=100, compact_after=4)
+    for index in range(5):
+        store.put(f"r{index}", {"ok": True, "index": index})
+    store.get("r2")
+    store.put("big", {"ok": True, "data": "x" * 500})
+    store.flush()
+
+    assert store.get("r0") is None and store.get("r3") is None
+    stub = store.get("big")
+    assert stub["ok"] is True and "data" not in stub
+    assert stub["dedup"]["bodyOmitted"] is True and stub["dedup"]["bytes"] > 500
+    assert store.snapshot_path.exists()
+    store.close()
+
+    reloaded = DedupStore(journal_path=journal, max_entries=3)
+    try:
+        assert reloaded.get("r2") == {"ok": True, "index": 2}
+        assert reloaded.get("r4") == {"ok": True, "index": 4}
+        assert reloaded.get("big")["dedup"]["bodyOmitted"] is True
+    finally:
+        reloaded.close()
@@ -0,0 +1,56 @@
+from editor_pool import EditorEndpoint, EditorPool, load_endpoints
+
+
+class FakeConnection:
+    def __init__(self, endpoint):
+        self.name = endpoint.name
+        self.connected = False
+        self.sent = []
+
+    def connect(self):
+        self.connected = True
+        return True
+
+    def disconnect(self):
+        self.connected = False
+
+    def idle_seconds(self):
+        return 0.0
+
+    def send_command(self, command, params=None, **kwargs):
+        self.sent.append((command, params))
+        if command == "content.validate":
+            shard = params["shard"]
+            return {"ok": True, "result": {
+                "violations": [{"editor": self.name, "shard": shard["index"]}],
+                "summary": {"violations": 1, "assets": 10, "assetsLoaded": 0, "parameterCacheHits": 0, "byRule": {"naming": 1}},
+            }}
+        if command == "job.start":
+            return {"ok": True, "result": {"jobId": f"job-{self.name}"}}
+        return {"ok": True, "result": {}}
+
+
+def test_load_endpoints_parses_names_and_default_port():
+    assert [(e.name, e.host, e.port) for e in load_endpoints("a=10.0.0.1:6000, 10.0.0.2")] == [("a", "10.0.0.1", 6000), ("editor1", "10.0.0.2", 55557)]
+
+
+def test_editor_pool_routes_by_affinity_and_merges_shards():
+    endpoints = [EditorEndpoint("main", "h1"), EditorEndpoint("city", "h2", maps=["/Game/Maps/City"], paths=["/Game/City"])]
+    pool = EditorPool(endpoints, FakeConnection, mutating={"actor.spawn"}, health_interval=0)
+    assert pool.connect()
+
+    assert pool.route("asset.find", {"path": "/Game/City/Props"}).endpoint.name == "city"
+    assert pool.route("asset.find", {"path": "/Game/Cityscape"}).endpoint.name == "main"
+    pool.send_command("job.start", {"type": "content.scan", "params": {"paths": ["/Game/City"]}})
+    assert pool.route("job.status", {"jobId": "job-city"}).endpoint.name == "city"
+
+    response = pool.send_command("content.validate", {"paths": ["/Game"]})
+    result = response["result"]
+    assert response["ok"] and result["summary"]["assets"] == 20 and result["summary"]["byRule"] == {"naming": 2}
+    assert [v["shard"] for v in result["violations"]] == [0, 1] and [s["editor"] for s in result["shards"]] == ["main", "city"]
+
+    # Reads move off an editor that is down; mutations stay where they belong.
+    pool._members[1].healthy = False
+    assert pool.route("asset.find", {"path": "/Game/City/A"}).endpoint.name == "main"
+    assert pool.route("actor.spawn", {"path": "/Game/City/A"}).endpoint.name == "city"
+    pool.disconnect()
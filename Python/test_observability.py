@@ -0,0 +1,29 @@
+import json
+
+import observability
+
+
+def test_observability_writer_batches_and_rotates_by_size(tmp_path, monkeypatch):
+    observability.init(str(tmp_path))
+    try:
+        for index in range(50):
+            observability.log_event("INFO", "test", f"event {index}", request_id=f"r{index}", fields={"index": index})
+        observability.log_metric("test.metric", {"value": 1})
+        observability.flush()
+
+        events = [json.loads(line) for line in (tmp_path / "events.jsonl").read_text(encoding="utf-8").splitlines()]
+        assert [event["fields"]["index"] for event in events] == list(range(50))
+        assert events[0]["level"] == "info" and events[0]["requestId"] == "r0"
+        metrics = (tmp_path / "metrics.jsonl").read_text(encoding="utf-8").splitlines()
+        assert json.loads(metrics[0])["metric"] == "test.metric"
+
+        # Rotation follows the bytes written, without a stat per entry.
+        monkeypatch.setattr(observability, "_MAX_FILE_BYTES", 200)
+        for _ in range(20):
+            observability.log_event("info", "test", "x" * 50)
+            observability.flush()
+        assert (tmp_path / "events.jsonl.1").exists()
+        assert (tmp_path / "events.jsonl").stat().st_size <= 200
+        observability.close()
+    finally:
+        observability.init("", enable=False)
@@ -0,0 +1,28 @@
+import fnmatch
+
+from security.policy import RoleRules, evaluate_patterns
+
+
+def test_compiled_policy_patterns_match_like_fnmatch():
+    patterns = ["asset.*", "actor.get_?", "sc.[as]*", "ping", " ", "!asset.save_all", "!", "! sc.submit"]
+    tools = ["asset.find", "asset.save_all", "actor.get_x", "actor.get_xy", "sc.add", "sc.submit", "sc.status", "ping", "pong", ""]
+
+    def reference(target):
+        allowed = False
+        for pattern in (p.strip() for p in patterns):
+            negate = pattern.startswith("!")
+            candidate = pattern[1:].strip() if negate else pattern
+            if candidate and fnmatch.fnmatchcase(target, candidate):
+                if negate:
+                    return False
+                allowed = True
+        return allowed
+
+    for tool in tools:
+        assert evaluate_patterns(patterns, tool) == reference(tool), tool
+        assert evaluate_patterns(patterns, tool) == reference(tool), tool
+
+    rules = RoleRules(allow=["asset.*", "ping"], deny=["asset.delete*"])
+    assert rules.evaluate("asset.find") and rules.evaluate("ping")
+    assert not rules.evaluate("asset.delete_many") and not rules.evaluate("actor.spawn")
+    assert not RoleRules().evaluate("ping")
@@ -27,6 +27,11 @@ class FakeSocket:
         self._read_offset = end
         return chunk
 
+    def recv_into(self, view) -> int:
+        chunk = self.recv(len(view))
+        view[:len(chunk)] = chunk
+        return len(chunk)
+
     # Helpers for tests
     def buffer(self) -> bytes:
         return bytes(self._buffer)
@@ -42,6 +47,26 @@ def test_write_and_read_frame_roundtrip():
     assert result == payload
 
 
+
+def test_frame_reader_reads_many_frames_and_grows_for_large_ones():
+    from protocol import FrameReader
+
+    writer = FakeSocket()
+    write_frame(writer, {"type": "a", "n": 1})
+    write_frame(writer, {"type": "big", "data": "x" * 5000}, compress_threshold=64)
+    write_frame(writer, {"type": "blob", "data": {"$attachment": 0}}, attachments=[b"\x00\x01raw"])
+    write_frame(writer, {"type": "long", "data": "y" * 3000})
+
+    reader = FrameReader(FakeSocket(writer.buffer()), buffer_size=1024)
+    assert reader.read_frame() == {"type": "a", "n": 1}
+    assert reader.buffered() > 0
+    assert reader.read_frame(allow_compressed=True)["data"] == "x" * 5000
+    assert reader.read_frame(allow_attachments=True)["data"] == b"\x00\x01raw"
+    assert reader.read_frame()["data"] == "y" * 3000
+    assert reader.buffered() == 0
+    with pytest.raises(ProtocolError):
+        reader.read_frame()
+
 def test_read_frame_invalid_length_raises():
     writer = FakeSocket()
     # Write header with invalid huge length
@@ -76,3 +101,239 @@ def test_current_timestamp_ms():
     ts = current_timestamp_ms()
     assert isinstance(ts, int)
     assert ts > 0
+
+
+def test_cbor_frame_roundtrip():
+    payload: Dict[str, Any] = {
+        "type": "sequence.export",
+        "ok": True,
+        "count": 3,
+        "negative": -17,
+        "keys": [0.5, 1.25, 3.141592653589793, None],
+        "nested": {"label": "Rock_01", "flags": [True, False]},
+    }
+    writer = FakeSocket()
+    write_frame(writer, payload, encoding="cbor")
+
+    reader = FakeSocket(writer.buffer())
+    assert read_frame(reader, encoding="cbor") == payload
+
+
+def test_cbor_frame_is_smaller_for_numeric_payloads():
+    payload = {"keys": [i * 0.1 for i in range(1000)]}
+    json_writer = FakeSocket()
+    cbor_writer = FakeSocket()
+    write_frame(json_writer, payload)
+    write_frame(cbor_writer, payload, encoding="cbor")
+    assert len(cbor_writer.buffer()) < len(json_writer.buffer())
+
+
+def test_read_frame_invalid_cbor_raises():
+    body = b"\x9f\x01"  # indefinite array without break
+    reader = FakeSocket(len(body).to_bytes(4, "little") + body)
+
+    with pytest.raises(ProtocolError) as exc:
+        read_frame(reader, encoding="cbor")
+    assert exc.value.code == "MALFORMED_FRAME"
+
+
+def test_compressed_frame_roundtrip():
+    payload = {"paths": ["/Game/Environment/Props/SM_Rock_%03d.SM_Rock_%03d" % (i, i) for i in range(500)]}
+    writer = FakeSocket()
+    write_frame(writer, payload, compress_threshold=1024)
+
+    raw = writer.buffer()
+    length = int.from_bytes(raw[:4], "little")
+    assert length & 0x80000000
+    assert len(raw) < len(json.dumps(payload))
+
+    reader = FakeSocket(raw)
+    assert read_frame(reader, allow_compressed=True) == payload
+
+
+def test_small_frames_stay_uncompressed():
+    writer = FakeSocket()
+    write_frame(writer, {"type": "ping", "ts": 1}, compress_threshold=1024)
+    assert not int.from_bytes(writer.buffer()[:4], "little") & 0x80000000
+
+
+def test_attachment_frame_roundtrip():
+    image = bytes(range(256)) * 64
+    payload = {"type": "response", "result": {"mimeType": "image/png", "data": {"$attachment": 0, "bytes": len(image)}}}
+    for threshold in (0, 1024):
+        writer = FakeSocket()
+        write_frame(writer, payload, compress_threshold=threshold, attachments=[image])
+        assert int.from_bytes(writer.buffer()[:4], "little") & 0x40000000
+
+        message = read_frame(FakeSocket(writer.buffer()), allow_compressed=True, allow_attachments=True)
+        assert message["result"]["data"] == image
+        assert message["result"]["mimeType"] == "image/png"
+
+
+def test_attachment_frame_rejects_bad_segment_sizes():
+    writer = FakeSocket()
+    write_frame(writer, {"data": {"$attachment": 0}}, attachments=[b"abcd"])
+    raw = bytearray(writer.buffer())
+    raw[-8:-4] = (99).to_bytes(4, "little")  # segment size no longer matches the frame
+
+    with pytest.raises(ProtocolError) as exc:
+        read_frame(FakeSocket(bytes(raw)), allow_attachments=True)
+    assert exc.value.code == "MALFORMED_FRAME"
+
+
+def test_local_endpoint_path_sanitises_name():
+    import transport
+
+    path = transport.local_endpoint_path("my editor/1")
+    assert path.endswith("my_editor_1.sock") or path.endswith("\\my_editor_1")
+    assert transport.sanitize_endpoint_name("   ") == transport.DEFAULT_LOCAL_ENDPOINT
+
+
+def test_frames_over_local_unix_socket():
+    import os
+    import socket
+    import uuid
+
+    import transport
+
+    if not hasattr(socket, "AF_UNIX"):
+        return
+
+    name = f"unreal-mcp-test-{uuid.uuid4().hex[:8]}"
+    path = transport.local_endpoint_path(name)
+    listener = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    try:
+        listener.bind(path)
+        listener.listen(1)
+        client = transport.connect_local(name, timeout=1.0)
+        server, _ = listener.accept()
+        try:
+            write_frame(client, {"type": "ping", "ts": 1}, timeout=1.0)
+            assert read_frame(server, timeout=1.0) == {"type": "ping", "ts": 1}
+        finally:
+            client.close()
+            server.close()
+    finally:
+        listener.close()
+        os.unlink(path)
+
+
+def test_shared_memory_reader_detects_overrun():
+    import struct
+    import sys
+    import uuid
+    from multiprocessing import shared_memory
+
+    import transport
+
+    capacity = 1024
+    region = shared_memory.SharedMemory(name=f"umcp_test_{uuid.uuid4().hex[:8]}", create=True, size=transport.SHM_HEADER_BYTES + capacity)
+    try:
+        struct.pack_into("<IIQQQ", region.buf, 0, transport.SHM_MAGIC, transport.SHM_VERSION, capacity, 0, 0)
+        body = json.dumps({"ok": True}).encode("utf-8")
+        position = 3 * capacity + 100  # monotonic position; lives at offset 100
+        region.buf[transport.SHM_HEADER_BYTES + 100:transport.SHM_HEADER_BYTES + 100 + len(body)] = body
+
+        reader = transport.SharedMemoryReader(region.name)
+        try:
+            assert reader.read(position, len(body)) == body
+            struct.pack_into("<Q", region.buf, 24, position + 1)
+            with pytest.raises(ProtocolError) as exc:
+                reader.read(position, len(body))
+            assert exc.value.code == "SHM_OVERRUN"
+        finally:
+            reader.close()
+    finally:
+        region.close()
+        if sys.version_info < (3, 13):
+            # The reader dropped the shared tracker entry; restore it so unlink does not warn.
+            from multiprocessing import resource_tracker
+
+            resource_tracker.register(region._name, "shared_memory")
+        region.unlink()
+
+
+def test_read_trace_parses_records_and_tolerates_truncation():
+    import io
+    import struct
+
+    from replay_trace import KIND_INBOUND, KIND_RESPONSE, read_trace
+
+    def record(kind: int, connection: int, offset_us: int, message: Dict[str, Any]) -> bytes:
+        body = json.dumps(message).encode("utf-8")
+        return struct.pack("<BIQI", kind, connection, offset_us, len(body)) + body
+
+    data = struct.pack("<8sHHq", b"MCPTRACE", 1, 0, 1_700_000_000_000)
+    data += record(KIND_INBOUND, 1, 0, {"type": "asset.find", "requestId": "a"})
+    data += record(KIND_RESPONSE, 1, 1500, {"requestId": "a", "tool": "asset.find", "durMs": 1.5, "ok": True})
+    data += record(KIND_INBOUND, 2, 2000, {"type": "ping"})[:-3]
+
+    start, records = read_trace(io.BytesIO(data))
+    assert start == 1_700_000_000_000
+    assert [(r.kind, r.connection_id, r.offset_us) for r in records] == [(KIND_INBOUND, 1, 0), (KIND_RESPONSE, 1, 1500)]
+    assert records[1].message["durMs"] == 1.5
+
+
+def test_rewrite_request_ids_covers_cancel_targets():
+    from replay_trace import rewrite_request_ids
+
+    original = {"type": "cancel", "requestId": "c1", "params": {"requestId": "r1"}}
+    rewritten = rewrite_request_ids(original, "-x")
+    assert rewritten == {"type": "cancel", "requestId": "c1-x", "params": {"requestId": "r1-x"}}
+    assert original["requestId"] == "c1"
+
+
+def test_dispatcher_matches_out_of_order_responses():
+    import threading
+
+    from multiplex import RequestDispatcher
+
+    dispatcher = RequestDispatcher(window=4)
+    first = dispatcher.acquire("a")
+    second = dispatcher.acquire("b")
+    assert dispatcher.in_flight() == 2
+
+    def answer() -> None:
+        assert dispatcher.resolve("b", {"ok": True, "id": "b"})
+        assert dispatcher.resolve("a", {"ok": True, "id": "a"})
+
+    threading.Thread(target=answer).start()
+    assert dispatcher.wait(second, 1.0)["id"] == "b"
+    assert dispatcher.wait(first, 1.0)["id"] == "a"
+    assert dispatcher.in_flight() == 0
+    assert not dispatcher.resolve("a", {"ok": True})
+
+
+def test_dispatcher_async_wait_and_failure():
+    import asyncio
+
+    from multiplex import RequestDispatcher
+
+    dispatcher = RequestDispatcher(window=2)
+
+    async def run() -> None:
+        answered = dispatcher.acquire("a")
+        failed = dispatcher.acquire("b")
+        loop = asyncio.get_running_loop()
+        loop.call_later(0.01, dispatcher.resolve, "a", {"ok": True})
+        assert (await dispatcher.wait_async(answered, 1.0)) == {"ok": True}
+        loop.call_later(0.01, dispatcher.fail_all, ProtocolError("CONNECTION_CLOSED", "closed"))
+        with pytest.raises(ProtocolError):
+            await dispatcher.wait_async(failed, 1.0)
+
+    asyncio.run(run())
+
+
+def test_dispatcher_times_out_idle_requests_and_frees_the_slot():
+    from multiplex import RequestDispatcher
+
+    dispatcher = RequestDispatcher(window=1)
+    pending = dispatcher.acquire("a")
+    with pytest.raises(ProtocolError) as excinfo:
+        dispatcher.acquire("b", timeout=0.01)
+    assert excinfo.value.code == "WINDOW_FULL"
+    with pytest.raises(ProtocolError) as excinfo:
+        dispatcher.wait(pending, 0.01)
+    assert excinfo.value.code == "READ_TIMEOUT"
+    assert dispatcher.in_flight() == 0
+
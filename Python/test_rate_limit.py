@@ -0,0 +1,18 @@
+from security import rate_limit
+from security.rate_limit import RateLimitConfig, RateLimiter
+
+
+def test_rate_limiter_weights_tools_and_refills(monkeypatch):
+    clock = [1000.0]
+    monkeypatch.setattr(rate_limit.time, "monotonic", lambda: clock[0])
+
+    limiter = RateLimiter(RateLimitConfig(per_minute_global=100, per_minute_tool=20))
+    assert limiter.cost_of("ping") < limiter.cost_of("get_actors_in_level") < limiter.cost_of("content.scan")
+    assert limiter.check("asset.batch_import") == (True, 0.0)
+    assert limiter.check("asset.batch_import") == (True, 0.0)
+    allowed, retry = limiter.check("asset.batch_import")
+    assert not allowed and abs(retry - 30.0) < 1e-6
+    # Another tool still has its own bucket, and the refused call spent nothing.
+    assert limiter.check("ping")[0]
+    clock[0] += 30.0
+    assert limiter.check("asset.batch_import") == (True, 0.0)
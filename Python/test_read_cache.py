@@ -0,0 +1,25 @@
+from read_cache import ReadCache
+
+
+def test_read_cache_serves_one_generation():
+    cache = ReadCache()
+    params = {"path": "/Game", "class": "StaticMesh"}
+    answer = {"ok": True, "result": {"assets": []}, "meta": {"cacheable": True, "cacheGen": 3}}
+    cache.observe_response("asset.find", params, answer)
+    assert cache.key("asset.find", params) is None
+
+    cache.set_live(True)
+    cache.observe(3)
+    cache.observe_response("asset.find", params, answer)
+    hit = cache.get(cache.key("asset.find", {"class": "StaticMesh", "path": "/Game"}))
+    assert hit["meta"]["clientCached"] is True and "clientCached" not in answer["meta"]
+
+    # A mutation's generation, or an answer computed before it, never serves stale data.
+    cache.observe_response("actor.spawn", {}, {"ok": True, "meta": {"cacheGen": 4}})
+    assert cache.get(cache.key("asset.find", params)) is None
+    cache.observe_response("asset.find", params, answer)
+    assert len(cache) == 0
+    cache.observe_response("asset.find", params, {"ok": True, "meta": {"cacheable": True, "cacheGen": 4}})
+    assert len(cache) == 1
+    cache.observe(-1)
+    assert len(cache) == 0
@@ -0,0 +1,34 @@
+from security.schema_registry import SCHEMAS, load_schemas
+
+# The keywords FParamSchema compiles; anything else would be enforced by the server only.
+SUPPORTED_KEYWORDS = {
+    "type", "properties", "required", "additionalProperties", "items", "enum",
+    "minimum", "maximum", "minLength", "maxLength", "minItems", "maxItems",
+}
+JSON_TYPES = {"null", "boolean", "integer", "number", "string", "array", "object"}
+
+
+def _check_schema(schema, path):
+    assert isinstance(schema, dict), path
+    assert set(schema) <= SUPPORTED_KEYWORDS, (path, set(schema) - SUPPORTED_KEYWORDS)
+    declared = schema.get("type", [])
+    assert set([declared] if isinstance(declared, str) else declared) <= JSON_TYPES, path
+    assert isinstance(schema.get("additionalProperties", True), bool), path
+    assert set(schema.get("required", [])) <= set(schema.get("properties", {})), path
+    for name, child in schema.get("properties", {}).items():
+        _check_schema(child, f"{path}.{name}")
+    if "items" in schema:
+        _check_schema(schema["items"], f"{path}[]")
+
+
+def test_param_schemas_stay_within_the_native_subset():
+    assert {"asset.batch_import", "sequence.create", "take_screenshot"} <= set(SCHEMAS)
+    for tool, schema in SCHEMAS.items():
+        _check_schema(schema, tool)
+
+
+def test_load_schemas_ignores_missing_and_broken_files(tmp_path):
+    assert load_schemas(tmp_path / "missing.json") == {}
+    broken = tmp_path / "broken.json"
+    broken.write_text("{", encoding="utf-8")
+    assert load_schemas(broken) == {}
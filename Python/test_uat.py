@@ -0,0 +1,73 @@
+import os
+import stat
+
+import pytest
+
+import uat
+
+# A stand-in for RunUAT.sh: writes one pak into the archive directory and records its command line.
+FAKE_RUNUAT = (
+    "#!/bin/sh\n"
+    "for arg in \"$@\"; do case \"$arg\" in -archivedirectory=*) dir=\"${arg#-archivedirectory=}\";; esac; done\n"
+    "mkdir -p \"$dir\" && echo built > \"$dir/Game.pak\"\n"
+    "echo \"$@\" >> \"$dir/../calls.txt\"\n"
+    "echo 'AutomationTool exiting with ExitCode=0 (Success)'\n"
+)
+
+
+@pytest.mark.skipif(os.name == "nt", reason="the fake RunUAT is a shell script")
+def test_uat_parallel_platforms_and_artifact_reuse(tmp_path, monkeypatch):
+    root = tmp_path
+    batch_files = root / "Engine" / "Engine" / "Build" / "BatchFiles"
+    batch_files.mkdir(parents=True)
+    runuat = batch_files / "RunUAT.sh"
+    runuat.write_text(FAKE_RUNUAT)
+    runuat.chmod(runuat.stat().st_mode | stat.S_IXUSR)
+    project = root / "Game"
+    (project / "Content").mkdir(parents=True)
+    (project / "Content" / "Map.umap").write_bytes(b"map")
+    uproject = project / "Game.uproject"
+    uproject.write_text("{}")
+    monkeypatch.setattr(uat, "LOG_ROOT", root / "logs")
+    monkeypatch.setattr(uat, "REUSE_INDEX_PATH", root / "builds" / "artifact_index.json")
+
+    payload = {
+        "engineRoot": str(root / "Engine"),
+        "uproject": str(uproject),
+        "platforms": ["Win64", "Linux"],
+        "cook": True,
+        "archive": True,
+        "archiveDir": str(root / "builds" / "nightly"),
+        "parallel": True,
+        "maxParallel": 2,
+        "iterative": True,
+        "ddc": "Shared",
+        "reuseArtifacts": True,
+    }
+
+    config = uat.BuildCookRunConfig.from_payload(payload)
+    command = uat.build_base_command(config, "Linux")
+    assert "-iterativecooking" in command and "-ddc=Shared" in command
+    assert f"-archivedirectory={root / 'builds' / 'nightly' / 'Linux'}" in command
+    assert 1 <= uat.resolve_parallelism(config, []) <= 2
+    warnings = []
+    assert uat.resolve_parallelism(uat.BuildCookRunConfig.from_payload(dict(payload, build=True)), warnings) == 1
+    assert warnings[0]["code"] == "PARALLEL_BUILD_SERIALIZED"
+
+    first = uat.run_buildcookrun(payload)
+    assert first["ok"], first
+    assert [result["platform"] for result in first["results"]] == ["Win64", "Linux"]
+    assert all(not result.get("reused") for result in first["results"])
+    assert first["results"][0]["artifacts"] == [str((root / "builds" / "nightly" / "Win64" / "Game.pak").resolve())]
+
+    second = uat.run_buildcookrun(payload)
+    assert second["ok"] and all(result["reused"] for result in second["results"])
+    assert len((root / "builds" / "nightly" / "calls.txt").read_text().splitlines()) == 2
+
+    # Changed content reruns every platform; a changed command line reruns only the one it touches.
+    (project / "Content" / "Map.umap").write_bytes(b"map v2")
+    third = uat.run_buildcookrun(payload)
+    assert all(not result.get("reused") for result in third["results"])
+    config = uat.BuildCookRunConfig.from_payload(payload)
+    fingerprint = uat.fingerprint_inputs(config)
+    assert uat.platform_input_hash(config, "Linux", fingerprint) != uat.platform_input_hash(config, "Win64", fingerprint)
@@ -253,9 +253,10 @@ def register_blueprint_tools(mcp: FastMCP):
     @mcp.tool()
     def compile_blueprint(
         ctx: Context,
-        blueprint_name: str
+        blueprint_name: str,
+        mode: str = "full"
     ) -> Dict[str, Any]:
-        """Compile a Blueprint."""
+        """Compile a Blueprint; mode "skeleton" only refreshes its skeleton class, so new pins and types resolve."""
         from unreal_mcp_server import get_unreal_connection
         
         try:
@@ -265,7 +266,8 @@ def register_blueprint_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             params = {
-                "blueprint_name": blueprint_name
+                "blueprint_name": blueprint_name,
+                "mode": mode
             }
             
             logger.info(f"Compiling blueprint: {blueprint_name}")
@@ -283,6 +285,54 @@ def register_blueprint_tools(mcp: FastMCP):
             logger.error(error_msg)
             return {"success": False, "message": error_msg}
 
+    @mcp.tool()
+    def compile_blueprints(
+        ctx: Context,
+        blueprints: List[str] = [],
+        paths: List[str] = [],
+        save: bool = False,
+        skip_up_to_date: bool = False
+    ) -> Dict[str, Any]:
+        """
+        Compile many Blueprints in one pass, in dependency order.
+        
+        Args:
+            blueprints: Blueprint names or paths to compile
+            paths: Content folders whose Blueprints (recursively) are all compiled
+            save: Save each Blueprint after it compiles
+            skip_up_to_date: Leave out Blueprints that are already compiled and unmodified
+            
+        Returns:
+            Response with one compile report per Blueprint and the timings
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            params = {"save": save, "skipUpToDate": skip_up_to_date}
+            if blueprints:
+                params["blueprints"] = blueprints
+            if paths:
+                params["paths"] = paths
+            
+            logger.info(f"Compiling {len(blueprints)} blueprint(s) and folders {paths}")
+            response = unreal.send_command("blueprint.compile_many", params)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error compiling blueprints: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
     @mcp.tool()
     def set_blueprint_property(
         ctx: Context,
@@ -295,7 +345,7 @@ def register_blueprint_tools(mcp: FastMCP):
         
         Args:
             blueprint_name: Name of the target Blueprint
-            property_name: Name of the property to set
+            property_name: Name of the property to set, or a struct field path such as RelativeLocation.X
             property_value: Value to set the property to
             
         Returns:
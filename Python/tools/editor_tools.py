@@ -15,8 +15,31 @@ def register_editor_tools(mcp: FastMCP):
     """Register editor tools with the MCP server."""
     
     @mcp.tool()
-    def get_actors_in_level(ctx: Context) -> List[Dict[str, Any]]:
-        """Get a list of all actors in the current level."""
+    def get_actors_in_level(
+        ctx: Context,
+        class_names: Optional[List[str]] = None,
+        tags: Optional[List[str]] = None,
+        label_contains: Optional[str] = None,
+        folder: Optional[str] = None,
+        fields: Optional[List[str]] = None,
+        limit: Optional[int] = None,
+        cursor: Optional[str] = None,
+        include_unloaded: bool = False
+    ) -> Any:
+        """Get actors in the current level, optionally filtered by class, tags, label and outliner folder.
+
+        Args:
+            class_names: Actor classes to keep, such as ["StaticMeshActor"]; subclasses match too
+            tags: Tags every returned actor must have
+            label_contains: Substring of the actor label
+            folder: Outliner folder, including its subfolders
+            fields: Fields to return per actor (name, label, class, path, folder, tags, location, rotation, scale)
+            limit: Most actors to return; the response then carries nextCursor when there are more
+            cursor: nextCursor from a previous call with the same filters
+            include_unloaded: On World Partition maps, also list unloaded actors (marked loaded: false) without loading them
+
+        Returns the list of actors, or {"actors", "nextCursor"} when limit or cursor is given.
+        """
         from unreal_mcp_server import get_unreal_connection
         
         try:
@@ -24,8 +47,26 @@ def register_editor_tools(mcp: FastMCP):
             if not unreal:
                 logger.warning("Failed to connect to Unreal Engine")
                 return []
-                
-            response = unreal.send_command("get_actors_in_level", {})
+
+            params: Dict[str, Any] = {}
+            if class_names:
+                params["classNames"] = class_names
+            if tags:
+                params["tags"] = tags
+            if label_contains:
+                params["labelContains"] = label_contains
+            if folder:
+                params["folder"] = folder
+            if fields:
+                params["fields"] = fields
+            if limit:
+                params["limit"] = limit
+            if cursor:
+                params["cursor"] = cursor
+            if include_unloaded:
+                params["includeUnloaded"] = True
+
+            response = unreal.send_command("get_actors_in_level", params)
             
             if not response:
                 logger.warning("No response from Unreal Engine")
@@ -35,13 +76,13 @@ def register_editor_tools(mcp: FastMCP):
             logger.info(f"Complete response from Unreal: {response}")
             
             # Check response format
-            if "result" in response and "actors" in response["result"]:
-                actors = response["result"]["actors"]
-                logger.info(f"Found {len(actors)} actors in level")
-                return actors
-            elif "actors" in response:
-                actors = response["actors"]
+            result = response["result"] if "result" in response and "actors" in response["result"] else response
+            if "actors" in result:
+                actors = result["actors"]
                 logger.info(f"Found {len(actors)} actors in level")
+                # Paged calls also need the cursor for the next page
+                if limit or cursor:
+                    return {"actors": actors, "nextCursor": result.get("nextCursor")}
                 return actors
                 
             logger.warning(f"Unexpected response format: {response}")
@@ -51,6 +92,46 @@ def register_editor_tools(mcp: FastMCP):
             logger.error(f"Error getting actors: {e}")
             return []
 
+    @mcp.tool()
+    def get_world_changes(
+        ctx: Context,
+        token: Optional[str] = None,
+        limit: Optional[int] = None
+    ) -> Dict[str, Any]:
+        """Get the actors of the current level that changed since a token.
+
+        Args:
+            token: token from the previous call; omit it to get a starting token
+            limit: Most changes to return; "more" is then true when others remain
+
+        Returns {"token", "resync", "more", "changes"}. When "resync" is true, re-read the level with
+        get_actors_in_level and continue from the returned token.
+        """
+        from unreal_mcp_server import get_unreal_connection
+
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.warning("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+
+            params: Dict[str, Any] = {}
+            if token:
+                params["token"] = token
+            if limit:
+                params["limit"] = limit
+
+            response = unreal.send_command("world.changes_since", params)
+            if not response:
+                return {"success": False, "message": "No response from Unreal Engine"}
+
+            result = response.get("result", response)
+            return result.get("data", result)
+
+        except Exception as e:
+            logger.error(f"Error getting world changes: {e}")
+            return {"success": False, "message": str(e)}
+
     @mcp.tool()
     def find_actors_by_name(ctx: Context, pattern: str) -> List[str]:
         """Find actors by name pattern."""
@@ -196,8 +277,9 @@ def register_editor_tools(mcp: FastMCP):
             return {}
     
     @mcp.tool()
-    def get_actor_properties(ctx: Context, name: str) -> Dict[str, Any]:
-        """Get all properties of an actor."""
+    def get_actor_properties(ctx: Context, name: str, properties: List[str] = None) -> Dict[str, Any]:
+        """Get all properties of an actor, plus the values of specific property paths
+        (struct fields such as PivotOffset.Z included) when ``properties`` is given."""
         from unreal_mcp_server import get_unreal_connection
         
         try:
@@ -206,15 +288,59 @@ def register_editor_tools(mcp: FastMCP):
                 logger.error("Failed to connect to Unreal Engine")
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
-            response = unreal.send_command("get_actor_properties", {
-                "name": name
-            })
+            params = {"name": name}
+            if properties:
+                params["properties"] = properties
+            response = unreal.send_command("get_actor_properties", params)
             return response or {}
             
         except Exception as e:
             logger.error(f"Error getting properties: {e}")
             return {}
 
+    @mcp.tool()
+    def read_actor_properties(
+        ctx: Context,
+        properties: List[str],
+        actors: Optional[List[str]] = None,
+        class_names: Optional[List[str]] = None
+    ) -> Dict[str, Any]:
+        """Read the same property paths from many actors at once.
+
+        Args:
+            properties: Property paths, such as "bHidden", "PivotOffset.Z" or "LightComponent.CastShadow"
+            actors: Actor names, labels or paths; unknown ones are listed in "missing"
+            class_names: Used when actors is omitted: every level actor of these classes or their subclasses
+
+        Returns {"properties", "actors", "columns", "unresolved", "missing", "count", "truncated"}.
+        columns[i][j] is properties[i] on actors[j], null where the path does not resolve; unresolved[i]
+        lists the classes properties[i] was not found on.
+        """
+        from unreal_mcp_server import get_unreal_connection
+
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.warning("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+
+            params: Dict[str, Any] = {"properties": properties}
+            if actors:
+                params["actors"] = actors
+            elif class_names:
+                params["classNames"] = class_names
+
+            response = unreal.send_command("actor.read_properties", params)
+            if not response:
+                return {"success": False, "message": "No response from Unreal Engine"}
+
+            result = response.get("result", response)
+            return result.get("data", result)
+
+        except Exception as e:
+            logger.error(f"Error reading actor properties: {e}")
+            return {"success": False, "message": str(e)}
+
     @mcp.tool()
     def set_actor_property(
         ctx: Context,
@@ -227,7 +353,7 @@ def register_editor_tools(mcp: FastMCP):
         
         Args:
             name: Name of the actor
-            property_name: Name of the property to set
+            property_name: Name of the property to set, or a struct field path such as RelativeLocation.X
             property_value: Value to set the property to
             
         Returns:
@@ -366,4 +492,240 @@ def register_editor_tools(mcp: FastMCP):
             logger.error(error_msg)
             return {"success": False, "message": error_msg}
 
+    @mcp.tool()
+    def subscribe_editor_events(ctx: Context, topics: List[str]) -> Dict[str, Any]:
+        """Subscribe to editor change notifications instead of polling.
+
+        Args:
+            ctx: The MCP context
+            topics: Any of asset.added, asset.removed, asset.renamed, actor.added,
+                actor.deleted, actor.moved, package.saved, blueprint.compiled, or "*" for all of them
+
+        Returns:
+            Dict with the topics now subscribed; collect events with get_editor_events
+        """
+        from unreal_mcp_server import get_unreal_connection
+
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+
+            response = unreal.subscribe(topics)
+            if not response:
+                return {"success": False, "message": "No response from Unreal Engine"}
+            return response
+
+        except Exception as e:
+            error_msg = f"Error subscribing to editor events: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
+    @mcp.tool()
+    async def scan_content(ctx: Context, paths: List[str], include_unused_textures: bool = False,
+                           since_token: Optional[str] = None) -> Dict[str, Any]:
+        """Scan content folders for redirectors, missing dependencies, broken references and orphans.
+
+        Progress is reported while the editor works through the assets.
+
+        Args:
+            ctx: The MCP context
+            paths: Content folders to scan, e.g. ["/Game/Props"]
+            include_unused_textures: Also list textures nothing references
+            since_token: The token of an earlier scan; only packages changed since then are returned
+
+        Returns:
+            Dict with stats, the findings per category and a token for the next incremental scan
+        """
+        from unreal_mcp_server import send_command_with_progress
+
+        try:
+            params = {"paths": paths, "includeUnusedTextures": include_unused_textures}
+            if since_token:
+                params["sinceToken"] = since_token
+            response = await send_command_with_progress(ctx, "content.scan", params)
+            if not response:
+                return {"success": False, "message": "No response from Unreal Engine"}
+            return response
+
+        except Exception as e:
+            error_msg = f"Error scanning content: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
+    @mcp.tool()
+    async def validate_content(ctx: Context, paths: List[str], rules: Optional[Dict[str, Any]] = None,
+                               rules_id: Optional[str] = None) -> Dict[str, Any]:
+        """Check content folders against naming, texture, mesh and material instance rules.
+
+        With several editors configured (UNREAL_MCP_EDITORS) the assets are split between every
+        healthy editor and the violations merged.
+
+        Args:
+            ctx: The MCP context
+            paths: Content folders to validate, e.g. ["/Game"]
+            rules: The rule set, inline
+            rules_id: The id of a rule set registered with content.register_rules, instead of rules
+
+        Returns:
+            Dict with the violations, a summary per rule and, when sharded, what each editor checked
+        """
+        from unreal_mcp_server import send_command_with_progress
+
+        try:
+            params: Dict[str, Any] = {"paths": paths}
+            if rules_id:
+                params["rulesId"] = rules_id
+            elif rules:
+                params["rules"] = rules
+            response = await send_command_with_progress(ctx, "content.validate", params)
+            if not response:
+                return {"success": False, "message": "No response from Unreal Engine"}
+            return response
+
+        except Exception as e:
+            error_msg = f"Error validating content: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
+    @mcp.tool()
+    def list_editors(ctx: Context) -> List[Dict[str, Any]]:
+        """List the editors this server routes to, with their health and affinity rules.
+
+        Args:
+            ctx: The MCP context
+
+        Returns:
+            One entry per editor ({name, host, port, healthy, error, maps, paths})
+        """
+        from editor_pool import EditorPool
+        from unreal_mcp_server import get_unreal_connection
+
+        unreal = get_unreal_connection()
+        if unreal is None:
+            return []
+        if isinstance(unreal, EditorPool):
+            return unreal.status()
+        return [{"name": "editor0", "host": unreal.host, "port": unreal.port, "healthy": unreal.connected, "maps": [], "paths": []}]
+
+    @mcp.tool()
+    def get_editor_events(ctx: Context, wait_seconds: float = 0.0) -> List[Dict[str, Any]]:
+        """Return editor change events pushed since the last call.
+
+        Args:
+            ctx: The MCP context
+            wait_seconds: How long to wait for an event when none are buffered
+
+        Returns:
+            List of event frames ({topic, seq, events: [...]}), oldest first
+        """
+        from unreal_mcp_server import get_unreal_connection
+
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.warning("Failed to connect to Unreal Engine")
+                return []
+            return unreal.drain_events(wait=wait_seconds)
+
+        except Exception as e:
+            logger.error(f"Error reading editor events: {e}")
+            return []
+
+    @mcp.tool()
+    def start_job(ctx: Context, command: str, params: Optional[Dict[str, Any]] = None,
+                  priority: Optional[str] = None) -> Dict[str, Any]:
+        """Start a long editor command as a background job and return its id at once.
+
+        Args:
+            ctx: The MCP context
+            command: The command to run, e.g. "content.scan" or "asset.batch_import"
+            params: The command's own params
+            priority: Optional scheduler lane: "control", "interactive" or "bulk"
+
+        Returns:
+            Dict with the jobId and its initial state; poll with get_job_status
+        """
+        from unreal_mcp_server import get_unreal_connection
+
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+
+            job_params: Dict[str, Any] = {"type": command, "params": params or {}}
+            if priority:
+                job_params["priority"] = priority
+            response = unreal.send_command("job.start", job_params)
+            if not response:
+                return {"success": False, "message": "No response from Unreal Engine"}
+            return response
+
+        except Exception as e:
+            error_msg = f"Error starting job: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
+    @mcp.tool()
+    def get_job_status(ctx: Context, job_id: str) -> Dict[str, Any]:
+        """Report a job's state, progress and, once finished, its error.
+
+        Args:
+            ctx: The MCP context
+            job_id: The id returned by start_job
+
+        Returns:
+            Dict with state (queued, running, succeeded, failed, cancelled), elapsedMs and progress
+        """
+        return _send_job_command("job.status", {"jobId": job_id})
+
+    @mcp.tool()
+    def get_job_result(ctx: Context, job_id: str, offset: int = 0, limit: int = 500) -> Dict[str, Any]:
+        """Fetch one page of a finished job's result.
+
+        Args:
+            ctx: The MCP context
+            job_id: The id returned by start_job
+            offset: Index of the first item of each result array
+            limit: Items per array in this page
+
+        Returns:
+            Dict with the command's response (arrays cut to the page) and page.nextOffset while more remains
+        """
+        return _send_job_command("job.result", {"jobId": job_id, "offset": offset, "limit": limit})
+
+    @mcp.tool()
+    def cancel_job(ctx: Context, job_id: str) -> Dict[str, Any]:
+        """Ask a queued or running job to stop.
+
+        Args:
+            ctx: The MCP context
+            job_id: The id returned by start_job
+
+        Returns:
+            Dict with the job's status and whether the cancel reached it before it finished
+        """
+        return _send_job_command("job.cancel", {"jobId": job_id})
+
+    def _send_job_command(command: str, params: Dict[str, Any]) -> Dict[str, Any]:
+        from unreal_mcp_server import get_unreal_connection
+
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+
+            response = unreal.send_command(command, params)
+            if not response:
+                return {"success": False, "message": "No response from Unreal Engine"}
+            return response
+
+        except Exception as e:
+            error_msg = f"Error sending {command}: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
     logger.info("Editor tools registered successfully")
@@ -427,4 +427,116 @@ def register_blueprint_node_tools(mcp: FastMCP):
             logger.error(error_msg)
             return {"success": False, "message": error_msg}
     
+    @mcp.tool()
+    def apply_blueprint_graph_patch(
+        ctx: Context,
+        blueprint_name: str,
+        nodes: List[Dict[str, Any]] = [],
+        edges: List[Dict[str, Any]] = [],
+        compile: bool = True
+    ) -> Dict[str, Any]:
+        """
+        Create many nodes and connections in a Blueprint's event graph in one request.
+        
+        Args:
+            blueprint_name: Name of the target Blueprint
+            nodes: Node specs, each {"id", "type", ...}. The id is local to the patch; type is one of
+                   event (event_name), function (function_name, target, params), input_action
+                   (action_name), component (component_name), variable_get / variable_set
+                   (variable_name) or self. Every type takes an optional node_position.
+            edges: Connections, each {"source", "source_pin", "target", "target_pin"}; source and
+                   target are patch ids or GUIDs of nodes already in the graph
+            compile: Compile the Blueprint once the patch is applied (default True); False leaves
+                     the compile to the deferred compile queue
+            
+        Returns:
+            Response with the GUID of each created node by id, counts, per-node and per-edge
+            failures, and the compile report
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            params = {
+                "blueprint_name": blueprint_name,
+                "nodes": nodes,
+                "edges": edges,
+                "compile": compile
+            }
+            
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            logger.info(f"Patching graph of blueprint '{blueprint_name}': {len(nodes)} nodes, {len(edges)} edges")
+            response = unreal.send_command("blueprint.graph_patch", params)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            logger.info(f"Graph patch response: {response}")
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error applying graph patch: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
+    @mcp.tool()
+    def search_blueprint_nodes(
+        ctx: Context,
+        function: str = "",
+        variable: str = "",
+        event: str = "",
+        node_class: str = "",
+        query: str = "",
+        paths: List[str] = [],
+        limit: int = 500
+    ) -> Dict[str, Any]:
+        """
+        Find nodes across every Blueprint in the project without loading them.
+        
+        Args:
+            function: Find calls to this function
+            variable: Find get/set nodes of this variable
+            event: Find handlers of this event
+            node_class: Node class to keep (e.g. K2Node_CallFunction); may be used on its own
+            query: A raw Find-in-Blueprints query, used instead of the fields above
+            paths: Only keep Blueprints under these package paths
+            limit: Maximum number of matches returned
+            
+        Returns:
+            Response with the matching nodes grouped by Blueprint
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            params = {"limit": limit}
+            for key, value in (("function", function), ("variable", variable), ("event", event),
+                               ("nodeClass", node_class), ("query", query)):
+                if value:
+                    params[key] = value
+            if paths:
+                params["paths"] = paths
+            
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            logger.info(f"Searching blueprint nodes: {params}")
+            response = unreal.send_command("blueprint.find_nodes", params)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error searching blueprint nodes: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
     logger.info("Blueprint node tools registered successfully")
\ No newline at end of file
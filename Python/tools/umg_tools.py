@@ -330,4 +330,66 @@ def register_umg_tools(mcp: FastMCP):
             logger.error(error_msg)
             return {"success": False, "message": error_msg}
 
+    @mcp.tool()
+    def build_widget_tree(
+        ctx: Context,
+        widget_name: str,
+        root: Dict[str, Any] = None,
+        widgets: List[Dict[str, Any]] = None,
+        parent: str = "",
+        replace: bool = False,
+        compile: bool = True
+    ) -> Dict[str, Any]:
+        """
+        Build a widget hierarchy in a Widget Blueprint in one request.
+        
+        A widget spec is {"type": "TextBlock", "name": "Score", "text": "0",
+        "properties": {...}, "slot": {"position": [x, y], "size": [w, h], ...},
+        "events": ["OnClicked"], "text_binding": "ScoreText", "children": [...]}.
+        
+        Args:
+            widget_name: Name or path of the target Widget Blueprint
+            root: Spec of the whole tree; needs replace=True if the Blueprint has a root already
+            widgets: Specs added under parent instead of a whole tree
+            parent: Panel the widgets go into (defaults to the root widget)
+            replace: Discard the existing tree when building from root
+            compile: Compile and save at once (otherwise the compile is deferred)
+            
+        Returns:
+            Dict with the created widget names, per-widget failures and the compile report
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            params = {
+                "blueprint_name": widget_name,
+                "replace": replace,
+                "compile": compile
+            }
+            if root is not None:
+                params["root"] = root
+            if widgets is not None:
+                params["widgets"] = widgets
+            if parent:
+                params["parent"] = parent
+            
+            logger.info(f"Building widget tree in {widget_name}")
+            response = unreal.send_command("umg.build_tree", params)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error building widget tree: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
     logger.info("UMG tools registered successfully") 
\ No newline at end of file
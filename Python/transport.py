@@ -0,0 +1,141 @@
+"""Same-host transports for the Unreal MCP protocol.
+
+The editor can listen on a Unix domain socket (Linux/macOS) or a named pipe (Windows) instead
+of TCP. Framing is identical on every transport; these helpers only open the byte stream and
+return an object with the ``send``/``recv``/``settimeout``/``close`` subset that
+:mod:`protocol` uses.
+"""
+
+from __future__ import annotations
+
+import os
+import re
+import socket
+import struct
+import sys
+import tempfile
+import time
+from typing import Optional
+
+from protocol import ProtocolError
+
+DEFAULT_LOCAL_ENDPOINT = "unreal-mcp"
+
+_INVALID_ENDPOINT_CHARS = re.compile(r"[^A-Za-z0-9._-]")
+
+
+def sanitize_endpoint_name(name: str) -> str:
+    """Mirror the editor's endpoint-name sanitisation so both sides derive the same path."""
+
+    cleaned = _INVALID_ENDPOINT_CHARS.sub("_", (name or "").strip())
+    return cleaned or DEFAULT_LOCAL_ENDPOINT
+
+
+def local_endpoint_path(name: str = DEFAULT_LOCAL_ENDPOINT) -> str:
+    """Return ``\\\\.\\pipe\\<name>`` on Windows or ``<temp dir>/<name>.sock`` elsewhere."""
+
+    name = sanitize_endpoint_name(name)
+    if sys.platform == "win32":
+        return "\\\\.\\pipe\\" + name
+    return os.path.join(tempfile.gettempdir(), name + ".sock")
+
+
+class NamedPipeStream:
+    """Blocking named-pipe client with the socket methods :mod:`protocol` relies on.
+
+    Pipe reads do not honour per-call timeouts; the editor's heartbeat and idle timeout still
+    close a dead session from the server side.
+    """
+
+    def __init__(self, path: str) -> None:
+        self._file = open(path, "r+b", buffering=0)
+
+    def settimeout(self, _timeout: Optional[float]) -> None:
+        return None
+
+    def recv(self, size: int) -> bytes:
+        return self._file.read(size) or b""
+
+    def send(self, data) -> int:
+        return self._file.write(data) or 0
+
+    def close(self) -> None:
+        self._file.close()
+
+
+def connect_local(name: str = DEFAULT_LOCAL_ENDPOINT, timeout: float = 5.0):
+    """Open a stream to the editor's local IPC endpoint."""
+
+    path = local_endpoint_path(name)
+    if sys.platform == "win32":
+        deadline = time.monotonic() + timeout
+        while True:
+            try:
+                return NamedPipeStream(path)
+            except OSError as exc:
+                # All pipe instances busy (ERROR_PIPE_BUSY) or the editor is still creating the next one.
+                if getattr(exc, "winerror", None) != 231 or time.monotonic() >= deadline:
+                    raise
+                time.sleep(0.02)
+
+    sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    try:
+        sock.settimeout(timeout)
+        sock.connect(path)
+        sock.settimeout(None)
+    except OSError:
+        sock.close()
+        raise
+    return sock
+
+
+# Shared-memory ring (see FSharedMemoryRing in the plugin): 64-byte header
+# {uint32 magic, uint32 version, uint64 capacity, uint64 head, uint64 tail} then the data bytes.
+SHM_MAGIC = 0x52534D55
+SHM_VERSION = 1
+SHM_HEADER_BYTES = 64
+_SHM_TAIL_OFFSET = 24
+
+
+class SharedMemoryReader:
+    """Read-only view of the editor's bulk-payload ring, opened from the handshake ack."""
+
+    def __init__(self, name: str) -> None:
+        from multiprocessing import shared_memory
+
+        try:
+            self._shm = shared_memory.SharedMemory(name=name, create=False, track=False)
+        except TypeError:
+            # Python < 3.13 always tracks attached segments and would unlink the editor's region
+            # at exit; opt out by hand.
+            from multiprocessing import resource_tracker
+
+            self._shm = shared_memory.SharedMemory(name=name, create=False)
+            try:
+                resource_tracker.unregister(self._shm._name, "shared_memory")  # type: ignore[attr-defined]
+            except Exception:  # pragma: no cover - tracker internals vary by version
+                pass
+
+        magic, version, capacity = struct.unpack_from("<IIQ", self._shm.buf, 0)
+        if magic != SHM_MAGIC or version != SHM_VERSION or capacity <= 0:
+            self.close()
+            raise ProtocolError("MALFORMED_FRAME", "Shared memory region has an unexpected layout.")
+        self.capacity = capacity
+
+    def read(self, position: int, length: int) -> bytes:
+        """Copy one entry out of the ring, failing if the editor overwrote it meanwhile."""
+
+        if length <= 0 or length > self.capacity:
+            raise ProtocolError("MALFORMED_FRAME", "Invalid shared memory descriptor.", {"length": length})
+        start = SHM_HEADER_BYTES + position % self.capacity
+        data = bytes(self._shm.buf[start:start + length])
+        (tail,) = struct.unpack_from("<Q", self._shm.buf, _SHM_TAIL_OFFSET)
+        if tail > position:
+            raise ProtocolError("SHM_OVERRUN", "Shared memory entry was overwritten before it was read.", {"position": position})
+        return data
+
+    def close(self) -> None:
+        try:
+            self._shm.close()
+        except (BufferError, OSError):  # pragma: no cover - exported views still alive
+            pass
@@ -2,6 +2,8 @@
 
 from __future__ import annotations
 
+import hashlib
+import json
 import os
 import queue
 import signal
@@ -9,6 +11,7 @@ import subprocess
 import threading
 import time
 from collections import deque
+from concurrent.futures import ThreadPoolExecutor
 from dataclasses import dataclass, field
 from datetime import datetime
 from pathlib import Path
@@ -16,6 +19,14 @@ from typing import Any, Dict, List, Optional, Sequence
 
 LOG_ROOT = Path("logs") / "uat"
 DEFAULT_ARCHIVE_ROOT = Path("builds")
+# Input hash and artifacts of the last successful archived run per project, platform and target.
+REUSE_INDEX_PATH = DEFAULT_ARCHIVE_ROOT / "artifact_index.json"
+# What one cook needs to itself before another is started next to it.
+CORES_PER_COOK = 4
+DEFAULT_MEMORY_PER_COOK_GB = 16.0
+# Project folders whose files feed a cook; Binaries, Intermediate and Saved are its outputs.
+INPUT_DIRECTORIES = ("Content", "Config", "Source", "Plugins")
+INPUT_SKIPPED_DIRECTORIES = {"Binaries", "Intermediate", "Saved", "DerivedDataCache", ".git", ".vs"}
 SUPPORTED_PLATFORMS = {
     "win64": "Win64",
     "windows": "Win64",
@@ -91,6 +102,13 @@ class BuildCookRunConfig:
     timeout_seconds: Optional[int]
     dry_run: bool
     platforms: List[str]
+    parallel: bool = False
+    max_parallel: Optional[int] = None
+    memory_per_cook_gb: float = DEFAULT_MEMORY_PER_COOK_GB
+    iterative: bool = False
+    ddc: Optional[str] = None
+    shared_ddc_path: Optional[str] = None
+    reuse_artifacts: bool = False
     timestamp: str = field(default_factory=lambda: datetime.now().strftime("%Y%m%d_%H%M%S"))
 
     @property
@@ -185,6 +203,28 @@ class BuildCookRunConfig:
             if timeout_value > 0:
                 timeout_seconds = int(timeout_value * 60)
 
+        max_parallel_raw = payload.get("maxParallel")
+        max_parallel = None
+        if max_parallel_raw is not None:
+            try:
+                max_parallel = int(max_parallel_raw)
+            except (TypeError, ValueError):
+                raise ToolError("INVALID_PARALLELISM", "maxParallel must be an integer.")
+            if max_parallel < 1:
+                raise ToolError("INVALID_PARALLELISM", "maxParallel must be at least 1.")
+
+        memory_per_cook_gb = DEFAULT_MEMORY_PER_COOK_GB
+        if payload.get("memoryPerCookGB") is not None:
+            try:
+                memory_per_cook_gb = float(payload["memoryPerCookGB"])
+            except (TypeError, ValueError):
+                raise ToolError("INVALID_PARALLELISM", "memoryPerCookGB must be numeric.")
+            if memory_per_cook_gb <= 0:
+                raise ToolError("INVALID_PARALLELISM", "memoryPerCookGB must be positive.")
+
+        ddc = payload.get("ddc")
+        shared_ddc_path = payload.get("sharedDDCPath")
+
         return cls(
             engine_root=engine_root,
             runuat_path=runuat_path,
@@ -210,6 +250,13 @@ class BuildCookRunConfig:
             timeout_seconds=timeout_seconds,
             dry_run=bool(payload.get("dryRun", False)),
             platforms=platforms,
+            parallel=bool(payload.get("parallel", False)) or max_parallel is not None,
+            max_parallel=max_parallel,
+            memory_per_cook_gb=memory_per_cook_gb,
+            iterative=bool(payload.get("iterative", False)),
+            ddc=str(ddc) if ddc else None,
+            shared_ddc_path=str(shared_ddc_path) if shared_ddc_path else None,
+            reuse_artifacts=bool(payload.get("reuseArtifacts", False)),
             timestamp=timestamp,
         )
 
@@ -232,22 +279,239 @@ def run_buildcookrun(payload: Optional[Dict[str, Any]]) -> Dict[str, Any]:
     if config.archive and config.archive_dir and not config.dry_run:
         config.archive_dir.mkdir(parents=True, exist_ok=True)
 
-    results: List[Dict[str, Any]] = []
-    for platform_name in config.platforms:
-        if config.dry_run:
-            result = build_dry_run_result(config, platform_name)
-        else:
-            result = execute_buildcookrun(config, platform_name)
-        results.append(result)
+    warnings: List[Dict[str, Any]] = []
+    parallelism = resolve_parallelism(config, warnings)
+
+    if config.dry_run:
+        results = [build_dry_run_result(config, platform_name) for platform_name in config.platforms]
+    else:
+        results = run_platforms(config, parallelism, warnings)
 
     if len(results) == 1:
+        if warnings:
+            results[0].setdefault("warnings", []).extend(warnings)
         return results[0]
 
     ok = all(result.get("ok", False) for result in results)
-    return {
+    response: Dict[str, Any] = {
         "ok": ok,
+        "parallelism": parallelism,
         "results": results,
     }
+    if warnings:
+        response["warnings"] = warnings
+    return response
+
+
+def run_platforms(config: BuildCookRunConfig, parallelism: int, warnings: List[Dict[str, Any]]) -> List[Dict[str, Any]]:
+    """Runs each platform, reusing archived artifacts whose inputs have not changed."""
+
+    input_fingerprint: Optional[str] = None
+    reuse_index: Dict[str, Any] = {}
+    if config.reuse_artifacts:
+        if config.archive and config.archive_dir:
+            input_fingerprint = fingerprint_inputs(config)
+            reuse_index = load_reuse_index()
+        else:
+            warnings.append(
+                {
+                    "code": "REUSE_NEEDS_ARCHIVE",
+                    "message": "reuseArtifacts only applies to archived runs; every platform was run.",
+                }
+            )
+
+    results: List[Optional[Dict[str, Any]]] = [None] * len(config.platforms)
+    input_hashes: Dict[str, str] = {}
+    to_run: List[int] = []
+    for index, platform_name in enumerate(config.platforms):
+        if input_fingerprint is not None:
+            input_hash = platform_input_hash(config, platform_name, input_fingerprint)
+            input_hashes[platform_name] = input_hash
+            reused = build_reused_result(config, platform_name, input_hash, reuse_index)
+            if reused is not None:
+                results[index] = reused
+                continue
+        to_run.append(index)
+
+    def run(index: int) -> None:
+        results[index] = execute_buildcookrun(config, config.platforms[index])
+
+    if parallelism > 1 and len(to_run) > 1:
+        with ThreadPoolExecutor(max_workers=min(parallelism, len(to_run)), thread_name_prefix="uat") as executor:
+            for future in [executor.submit(run, index) for index in to_run]:
+                future.result()
+    else:
+        for index in to_run:
+            run(index)
+
+    if input_fingerprint is not None:
+        recorded = False
+        for index in to_run:
+            platform_name = config.platforms[index]
+            result = results[index]
+            if result and result.get("ok") and result.get("artifacts"):
+                result["inputHash"] = input_hashes[platform_name]
+                reuse_index[reuse_key(config, platform_name)] = {
+                    "inputHash": input_hashes[platform_name],
+                    "artifacts": result["artifacts"],
+                    "commandLine": result["commandLine"],
+                    "recordedAt": datetime.now().isoformat(timespec="seconds"),
+                }
+                recorded = True
+        if recorded:
+            save_reuse_index(reuse_index)
+
+    return [result for result in results if result is not None]
+
+
+def resolve_parallelism(config: BuildCookRunConfig, warnings: List[Dict[str, Any]]) -> int:
+    """How many platforms run at once: maxParallel (or all of them), bounded by cores and memory."""
+
+    count = len(config.platforms)
+    if not config.parallel or count <= 1:
+        return 1
+    if config.build:
+        # Every BuildCookRun with -build waits on the same UnrealBuildTool mutex.
+        warnings.append(
+            {
+                "code": "PARALLEL_BUILD_SERIALIZED",
+                "message": "build=true runs UnrealBuildTool, which allows one instance at a time; platforms ran one after another.",
+            }
+        )
+        return 1
+
+    limit = min(config.max_parallel or count, count)
+    core_limit = max(1, (os.cpu_count() or 1) // CORES_PER_COOK)
+    limit = min(limit, core_limit)
+    available = available_memory_bytes()
+    if available is not None:
+        memory_limit = max(1, int(available // (config.memory_per_cook_gb * 1024 ** 3)))
+        limit = min(limit, memory_limit)
+    return max(1, limit)
+
+
+def available_memory_bytes() -> Optional[int]:
+    """Physical memory free for new processes, or None when it cannot be read."""
+
+    try:
+        if os.name == "nt":
+            import ctypes
+
+            class MemoryStatus(ctypes.Structure):
+                _fields_ = [
+                    ("dwLength", ctypes.c_ulong),
+                    ("dwMemoryLoad", ctypes.c_ulong),
+                    ("ullTotalPhys", ctypes.c_ulonglong),
+                    ("ullAvailPhys", ctypes.c_ulonglong),
+                    ("ullTotalPageFile", ctypes.c_ulonglong),
+                    ("ullAvailPageFile", ctypes.c_ulonglong),
+                    ("ullTotalVirtual", ctypes.c_ulonglong),
+                    ("ullAvailVirtual", ctypes.c_ulonglong),
+                    ("ullAvailExtendedVirtual", ctypes.c_ulonglong),
+                ]
+
+            status = MemoryStatus()
+            status.dwLength = ctypes.sizeof(MemoryStatus)
+            if ctypes.windll.kernel32.GlobalMemoryStatusEx(ctypes.byref(status)):
+                return int(status.ullAvailPhys)
+            return None
+        meminfo = Path("/proc/meminfo")
+        if meminfo.exists():
+            for line in meminfo.read_text(encoding="ascii", errors="ignore").splitlines():
+                if line.startswith("MemAvailable:"):
+                    return int(line.split()[1]) * 1024
+        # macOS has no cheap "available" figure; the total keeps the bound meaningful.
+        return int(os.sysconf("SC_PAGE_SIZE") * os.sysconf("SC_PHYS_PAGES"))
+    except (AttributeError, OSError, ValueError):
+        return None
+
+
+def fingerprint_inputs(config: BuildCookRunConfig) -> str:
+    """Hash of the project's cook inputs, from each file's path, size and modification time."""
+
+    digest = hashlib.sha256()
+    digest.update(config.uproject.read_bytes())
+    build_version = config.engine_root / "Engine" / "Build" / "Build.version"
+    if build_version.exists():
+        digest.update(build_version.read_bytes())
+    else:
+        digest.update(str(config.engine_root).encode("utf-8"))
+
+    project_dir = config.project_dir
+    for directory_name in INPUT_DIRECTORIES:
+        root = project_dir / directory_name
+        if not root.is_dir():
+            continue
+        for current, directories, files in os.walk(root):
+            directories[:] = sorted(d for d in directories if d not in INPUT_SKIPPED_DIRECTORIES)
+            for file_name in sorted(files):
+                path = Path(current) / file_name
+                try:
+                    stat = path.stat()
+                except OSError:
+                    continue
+                relative = path.relative_to(project_dir).as_posix()
+                digest.update(f"{relative}\0{stat.st_size}\0{stat.st_mtime_ns}\n".encode("utf-8"))
+    return digest.hexdigest()
+
+
+def platform_input_hash(config: BuildCookRunConfig, platform_name: str, input_fingerprint: str) -> str:
+    """The inputs plus the platform's command line, without the run-specific archive directory."""
+
+    command = [part for part in build_base_command(config, platform_name) if not part.startswith("-archivedirectory=")]
+    digest = hashlib.sha256(input_fingerprint.encode("ascii"))
+    digest.update("\0".join(command).encode("utf-8"))
+    return digest.hexdigest()
+
+
+def reuse_key(config: BuildCookRunConfig, platform_name: str) -> str:
+    return f"{config.uproject}|{platform_name}|{config.target}|{config.configuration}"
+
+
+def load_reuse_index() -> Dict[str, Any]:
+    try:
+        with REUSE_INDEX_PATH.open("r", encoding="utf-8") as handle:
+            index = json.load(handle)
+    except (OSError, ValueError):
+        return {}
+    return index if isinstance(index, dict) else {}
+
+
+def save_reuse_index(index: Dict[str, Any]) -> None:
+    REUSE_INDEX_PATH.parent.mkdir(parents=True, exist_ok=True)
+    temporary = REUSE_INDEX_PATH.with_suffix(".tmp")
+    with temporary.open("w", encoding="utf-8") as handle:
+        json.dump(index, handle, indent=2, sort_keys=True)
+    os.replace(temporary, REUSE_INDEX_PATH)
+
+
+def build_reused_result(
+    config: BuildCookRunConfig,
+    platform_name: str,
+    input_hash: str,
+    reuse_index: Dict[str, Any],
+) -> Optional[Dict[str, Any]]:
+    """The previous run's result when its inputs match and every artifact is still on disk."""
+
+    entry = reuse_index.get(reuse_key(config, platform_name))
+    if not isinstance(entry, dict) or entry.get("inputHash") != input_hash:
+        return None
+    artifacts = entry.get("artifacts") or []
+    if not artifacts or not all(Path(path).exists() for path in artifacts):
+        return None
+    return {
+        "ok": True,
+        "exitCode": 0,
+        "durationSec": 0,
+        "commandLine": format_command_line(config, build_base_command(config, platform_name)),
+        "platform": platform_name,
+        "logs": {},
+        "dryRun": False,
+        "reused": True,
+        "reusedFrom": entry.get("recordedAt"),
+        "inputHash": input_hash,
+        "artifacts": artifacts,
+    }
 
 
 def build_dry_run_result(config: BuildCookRunConfig, platform_name: str) -> Dict[str, Any]:
@@ -256,8 +520,9 @@ def build_dry_run_result(config: BuildCookRunConfig, platform_name: str) -> Dict
 
     project_saved = config.project_dir / "Saved"
     would_write: List[str] = []
-    if config.archive and config.archive_dir:
-        would_write.append(str(config.archive_dir.resolve()))
+    archive_dir = platform_archive_dir(config, platform_name)
+    if archive_dir:
+        would_write.append(str(archive_dir.resolve()))
     if config.cook:
         would_write.append(str((project_saved / "Cooked").resolve()))
     if config.stage:
@@ -289,6 +554,8 @@ def execute_buildcookrun(config: BuildCookRunConfig, platform_name: str) -> Dict
     env.update(config.env)
     if "UE_ENGINE_ROOT" not in env:
         env["UE_ENGINE_ROOT"] = str(config.engine_root)
+    if config.shared_ddc_path:
+        env["UE-SharedDataCachePath"] = config.shared_ddc_path
 
     process_args = build_process_args(config, command_parts)
 
@@ -327,13 +594,15 @@ def execute_buildcookrun(config: BuildCookRunConfig, platform_name: str) -> Dict
         exit_code = parsed_exit
 
     logs: Dict[str, Any] = {"uatLog": str(log_path.resolve())}
-    cook_log = find_latest_cook_log(config.project_dir)
+    # Cooks running side by side share Saved/Logs, so the newest cook log may be another platform's.
+    cook_log = find_latest_cook_log(config.project_dir) if not config.parallel else None
     if cook_log:
         logs["cookLog"] = cook_log
 
     artifacts: List[str] = []
-    if config.archive and config.archive_dir:
-        artifacts = collect_artifacts(config.archive_dir)
+    archive_dir = platform_archive_dir(config, platform_name)
+    if archive_dir:
+        artifacts = collect_artifacts(archive_dir)
 
     result: Dict[str, Any] = {
         "ok": not timed_out and exit_code == 0,
@@ -381,12 +650,12 @@ def execute_buildcookrun(config: BuildCookRunConfig, platform_name: str) -> Dict
         }
         return result
 
-    if config.archive and config.archive_dir and not artifacts:
+    if archive_dir and not artifacts:
         result.setdefault("warnings", []).append(
             {
                 "code": "ARTIFACTS_NOT_FOUND",
                 "message": "No build artifacts were discovered.",
-                "details": {"archiveDir": str(config.archive_dir.resolve())},
+                "details": {"archiveDir": str(archive_dir.resolve())},
             }
         )
 
@@ -405,6 +674,10 @@ def build_base_command(config: BuildCookRunConfig, platform_name: str) -> List[s
         command.append(f"-target={config.target}")
     if config.cook:
         command.append("-cook")
+        if config.iterative:
+            command.append("-iterativecooking")
+    if config.ddc:
+        command.append(f"-ddc={config.ddc}")
     if config.stage:
         command.append("-stage")
     if config.pak:
@@ -415,8 +688,9 @@ def build_base_command(config: BuildCookRunConfig, platform_name: str) -> List[s
         command.append("-package")
     if config.archive:
         command.append("-archive")
-        if config.archive_dir:
-            command.append(f"-archivedirectory={str(config.archive_dir)}")
+        archive_dir = platform_archive_dir(config, platform_name)
+        if archive_dir:
+            command.append(f"-archivedirectory={str(archive_dir)}")
     if config.build:
         command.append("-build")
     if config.prereqs:
@@ -440,6 +714,16 @@ def build_base_command(config: BuildCookRunConfig, platform_name: str) -> List[s
     return command
 
 
+def platform_archive_dir(config: BuildCookRunConfig, platform_name: str) -> Optional[Path]:
+    """Where a platform archives. Parallel runs get a folder each, so their artifacts stay apart."""
+
+    if not config.archive or not config.archive_dir:
+        return None
+    if config.parallel and len(config.platforms) > 1:
+        return config.archive_dir / platform_name
+    return config.archive_dir
+
+
 def build_process_args(config: BuildCookRunConfig, command_parts: List[str]) -> List[str]:
     base = [str(config.runuat_path)] + command_parts
     if config.is_windows:
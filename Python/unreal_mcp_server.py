@@ -5,6 +5,8 @@ A simple MCP server for interacting with Unreal Engine.
 """
 
 import argparse
+import asyncio
+import base64
 import hashlib
 import json
 import logging
@@ -12,26 +14,39 @@ import os
 import platform
 import socket
 import sys
+import threading
 import time
 import uuid
+from collections import deque
 from contextlib import asynccontextmanager
 from dataclasses import dataclass
 from datetime import datetime, timezone
 from pathlib import Path
-from typing import AsyncIterator, Dict, Any, Optional, List
+from typing import AsyncIterator, Callable, Dict, Any, Optional, List
 
 from copy import deepcopy
 
-from mcp.server.fastmcp import FastMCP
+from mcp.server.fastmcp import Context, FastMCP
 
 from protocol import (
+    ENCODING_JSON,
+    SUPPORTED_ENCODINGS,
+    FrameReader,
     ProtocolError,
     current_timestamp_ms,
+    decode_frame_payload,
     read_frame,
     write_frame,
 )
 from observability import init as init_observability, log_event, log_metric
 from dedup import DedupStore
+from multiplex import PendingRequest, RequestDispatcher
+from read_cache import ReadCache
+from editor_pool import EditorPool, load_endpoints
+from security.policy import PolicyLoader, PolicyLimits
+from security.rate_limit import DEFAULT_TOOL_COSTS, RateLimitConfig, RateLimiter
+from security import schema_registry
+from transport import DEFAULT_LOCAL_ENDPOINT, SharedMemoryReader, connect_local, local_endpoint_path
 
 # Configure logging with more detailed format
 logging.basicConfig(
@@ -48,6 +63,48 @@ logger = logging.getLogger("UnrealMCP")
 UNREAL_HOST = "127.0.0.1"
 UNREAL_PORT = 55557
 SERVER_IDENTITY = "mcp-python/0.2.0"
+# Frame encodings offered in the handshake, most preferred first ("json" disables CBOR).
+PREFERRED_ENCODINGS = [
+    value.strip()
+    for value in os.environ.get("UNREAL_MCP_ENCODINGS", ",".join(SUPPORTED_ENCODINGS)).split(",")
+    if value.strip() in SUPPORTED_ENCODINGS
+] or [ENCODING_JSON]
+# Set UNREAL_MCP_COMPRESSION=0 to stop offering zlib frame compression.
+OFFER_COMPRESSION = os.environ.get("UNREAL_MCP_COMPRESSION", "1").strip().lower() not in ("0", "false", "no", "off")
+# Set UNREAL_MCP_ATTACHMENTS=0 to have images and blobs sent as base64 inside the payload.
+OFFER_ATTACHMENTS = os.environ.get("UNREAL_MCP_ATTACHMENTS", "1").strip().lower() not in ("0", "false", "no", "off")
+# UNREAL_MCP_TRANSPORT=local connects over the editor's Unix domain socket / named pipe
+# (Transport=LocalIpc in the plugin settings) instead of TCP.
+UNREAL_TRANSPORT = os.environ.get("UNREAL_MCP_TRANSPORT", "tcp").strip().lower()
+UNREAL_LOCAL_ENDPOINT = os.environ.get("UNREAL_MCP_LOCAL_ENDPOINT", DEFAULT_LOCAL_ENDPOINT)
+# UNREAL_MCP_SHARE weights this client's game-thread time against other clients of the same editor (0.1-16, default 1).
+try:
+    SCHEDULING_SHARE: Optional[float] = float(os.environ["UNREAL_MCP_SHARE"])
+except (KeyError, ValueError):
+    SCHEDULING_SHARE = None
+# Answers to read-only tools kept until the editor pushes cache.invalidated (see read_cache.py).
+READ_CACHE_ENABLED = os.environ.get("UNREAL_MCP_READ_CACHE", "0").strip().lower() in ("1", "true", "yes", "on")
+# Several editors behind this server (see editor_pool.py); empty for the one at UNREAL_HOST:UNREAL_PORT.
+EDITOR_ENDPOINTS = os.environ.get("UNREAL_MCP_EDITORS", "")
+EDITOR_HEALTH_INTERVAL_SEC = float(os.environ.get("UNREAL_MCP_HEALTH_INTERVAL_SEC", "10") or 10)
+# Bulk payloads through the editor's shared-memory ring; only offered when the editor is on this host.
+OFFER_SHARED_MEMORY = os.environ.get("UNREAL_MCP_SHARED_MEMORY", "1").strip().lower() not in ("0", "false", "no", "off")
+# A second connection, handshaken ahead of need, that takes over when the first one drops.
+KEEP_WARM_SPARE = os.environ.get("UNREAL_MCP_WARM_SPARE", "1").strip().lower() not in ("0", "false", "no", "off")
+SPARE_RETRY_SEC = 30.0
+# Handler families ("niagara.", "sequence.", ...) whose editor modules editor.warmup loads on startup; "*" for all.
+WARMUP_ENABLED = os.environ.get("UNREAL_MCP_WARMUP", "1").strip().lower() not in ("0", "false", "no", "off")
+WARMUP_FAMILIES = [
+    value.strip() for value in os.environ.get("UNREAL_MCP_WARMUP_FAMILIES", "*").split(",") if value.strip()
+]
+LOCAL_HOSTS = ("127.0.0.1", "localhost", "::1")
+
+
+def _attachment_to_base64(data: bytes) -> str:
+    """Tools hand results on as JSON, so attachments reach them in the inline (base64) shape."""
+
+    return base64.b64encode(data).decode("ascii")
+
 
 LOG_DIRECTORY = Path(__file__).resolve().parent / "logs"
 init_observability(LOG_DIRECTORY, enable=True)
@@ -55,11 +112,43 @@ SERVER_START_TIME = time.time()
 DEDUP_STORE = DedupStore()
 
 
+def _build_rate_limiter() -> RateLimiter:
+    try:
+        limits = PolicyLoader().load().limits
+    except Exception as exc:  # pragma: no cover - a broken policy file must not stop the server
+        logger.warning("Failed to load policy limits, using defaults: %s", exc)
+        limits = PolicyLimits()
+    # Policy overrides first, so their patterns are tried before the defaults.
+    tool_costs = dict(limits.tool_costs)
+    for name, cost in DEFAULT_TOOL_COSTS.items():
+        tool_costs.setdefault(name, cost)
+    return RateLimiter(
+        RateLimitConfig(
+            per_minute_global=limits.rate_per_minute_global,
+            per_minute_tool=limits.rate_per_minute_per_tool,
+            tool_costs=tool_costs,
+        )
+    )
+
+
+RATE_LIMITER = _build_rate_limiter()
+
+
+def _is_retryable(response: Any) -> bool:
+    """Refusals such as the editor's OVERLOADED are answers to "not now", not to the request."""
+
+    error = response.get("error") if isinstance(response, dict) else None
+    details = error.get("details") if isinstance(error, dict) else None
+    return isinstance(details, dict) and bool(details.get("retryable"))
+
+
 @dataclass
 class EnforcementConfig:
     allow_write: bool = False
     dry_run: bool = True
     allowed_paths: List[str] = None
+    # Ask the editor to attach audits to mutation responses; they feed logs/audit.jsonl.
+    request_audit: bool = True
 
     def normalized_paths(self) -> List[str]:
         paths: List[str] = []
@@ -85,6 +174,7 @@ MUTATING_COMMANDS = {
     "set_component_property",
     "set_physics_properties",
     "compile_blueprint",
+    "blueprint.compile_many",
     "set_blueprint_property",
     "set_static_mesh_properties",
     "set_pawn_properties",
@@ -102,6 +192,7 @@ MUTATING_COMMANDS = {
     "add_button_to_widget",
     "bind_widget_event",
     "set_text_block_binding",
+    "umg.build_tree",
     "add_widget_to_viewport",
     "sc.status",
     "sc.checkout",
@@ -137,7 +228,9 @@ def configure_server_from_args(argv: List[str]) -> None:
     parser.add_argument("--dry-run", dest="dry_run", action="store_true")
     parser.add_argument("--no-dry-run", dest="dry_run", action="store_false")
     parser.add_argument("--allowed-path", dest="allowed_paths", action="append")
-    parser.set_defaults(allow_write=None, dry_run=None, allowed_paths=None)
+    parser.add_argument("--audit", dest="request_audit", action="store_true")
+    parser.add_argument("--no-audit", dest="request_audit", action="store_false")
+    parser.set_defaults(allow_write=None, dry_run=None, allowed_paths=None, request_audit=None)
 
     args, remaining = parser.parse_known_args(argv[1:])
     sys.argv = [argv[0]] + remaining
@@ -172,31 +265,60 @@ def configure_server_from_args(argv: List[str]) -> None:
             if trimmed:
                 allowed_paths.append(trimmed)
 
+    request_audit = args.request_audit
+    if request_audit is None:
+        env_value = _env_bool("MCP_REQUEST_AUDIT")
+        request_audit = True if env_value is None else env_value
+
     global SERVER_CONFIG
     SERVER_CONFIG = EnforcementConfig(
         allow_write=allow_write,
         dry_run=dry_run,
         allowed_paths=allowed_paths,
+        request_audit=request_audit,
     )
 
     logger.info(
-        "Server enforcement configured: allow_write=%s dry_run=%s allowed_paths=%s",
+        "Server enforcement configured: allow_write=%s dry_run=%s allowed_paths=%s request_audit=%s",
         SERVER_CONFIG.allow_write,
         SERVER_CONFIG.dry_run,
         SERVER_CONFIG.normalized_paths(),
+        SERVER_CONFIG.request_audit,
     )
 
+@dataclass
+class _PreparedCommand:
+    """A command that passed the client-side checks and is ready to send."""
+
+    command: str
+    params: Dict[str, Any]
+    request_id: str
+    is_mutation: bool
+    start_time: float
+    stream: bool
+    progress: bool
+
+
 class UnrealConnection:
-    """Connection to an Unreal Engine instance using Protocol v1.1."""
+    """Connection to an Unreal Engine instance using Protocol v1.1.
+
+    Requests are pipelined on the one connection: every caller writes its frame and waits for its
+    own requestId, while a reader thread hands each response to whoever is waiting for it. Up to
+    ``windowMax`` requests (from the handshake) are in flight at once. ``send_command`` blocks
+    its thread; ``send_command_async`` is the awaitable form for async tools.
+    """
 
     PROTOCOL_VERSION = 1.1
     HANDSHAKE_TIMEOUT = 10.0
     WRITE_TIMEOUT = 5.0
     IDLE_TIMEOUT = 60.0
+    EVENT_BUFFER_SIZE = 1000
     ENGINE_VERSION = "5.6.x"
     CLIENT_VERSION = "python-mcp/1.0.0"
 
-    def __init__(self) -> None:
+    def __init__(self, host: Optional[str] = None, port: Optional[int] = None) -> None:
+        self.host = host or UNREAL_HOST
+        self.port = port or UNREAL_PORT
         self.socket: Optional[socket.socket] = None
         self.connected = False
         self.session_id = str(uuid.uuid4())
@@ -209,26 +331,75 @@ class UnrealConnection:
         self.remote_plugin_version: Optional[str] = None
         self.window_max: int = 16
         self.resume_token: Optional[str] = None
+        # Payload encoding negotiated in the handshake; the handshake itself is always JSON.
+        self.encoding: str = ENCODING_JSON
+        # Minimum frame size to compress; 0 when compression was not negotiated.
+        self.compress_threshold: int = 0
+        self.attachments: bool = False
+        # Requests in flight, answered by the reader thread as their responses arrive.
+        self._dispatcher = RequestDispatcher(self.window_max)
+        self._reader: Optional[threading.Thread] = None
+        # Partially received stream_begin/stream_chunk responses, keyed by requestId.
+        self._open_streams: Dict[str, Dict[str, Any]] = {}
+        # Mapped shared-memory ring for large payloads (shm/frame descriptors), if negotiated.
+        self._shared_memory: Optional[SharedMemoryReader] = None
+        # Server-pushed event frames (see subscribe()), oldest dropped first once full.
+        self._events: deque = deque(maxlen=self.EVENT_BUFFER_SIZE)
+        self._events_ready = threading.Condition()
+        # Newest viewport_frame per stream (see start_viewport_stream); older frames are not kept.
+        self._viewport_frames: Dict[str, Dict[str, Any]] = {}
+        # Served only while this connection receives the editor's cache.invalidated events.
+        self.read_cache: Optional[ReadCache] = ReadCache() if READ_CACHE_ENABLED else None
+        # Callbacks for progress frames of requests sent with on_progress, keyed by requestId.
+        self._progress_handlers: Dict[str, Callable[[Dict[str, Any]], None]] = {}
+        # Frames are written whole by one thread at a time; reads all happen on the reader thread.
+        self._write_lock = threading.Lock()
+        self._connect_lock = threading.RLock()
 
     def connect(self) -> bool:
         """Connect to the Unreal Engine instance and perform handshake."""
 
+        with self._connect_lock:
+            return self._connect()
+
+    def idle_seconds(self) -> float:
+        """Seconds since the last frame arrived from the editor."""
+
+        return time.monotonic() - self._last_receive
+
+    def _ensure_connected(self) -> bool:
+        with self._connect_lock:
+            if self.connected and self.socket:
+                return True
+            return self._connect()
+
+    def _connect(self) -> bool:
         self.disconnect()
 
         try:
-            logger.info("Connecting to Unreal at %s:%s...", UNREAL_HOST, UNREAL_PORT)
-            sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-            sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
-            sock.setsockopt(socket.SOL_SOCKET, socket.SO_KEEPALIVE, 1)
-            sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 65536)
-            sock.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 65536)
-            sock.settimeout(None)
-            sock.connect((UNREAL_HOST, UNREAL_PORT))
+            if UNREAL_TRANSPORT == "local":
+                logger.info("Connecting to Unreal at %s...", local_endpoint_path(UNREAL_LOCAL_ENDPOINT))
+                sock = connect_local(UNREAL_LOCAL_ENDPOINT, timeout=self.HANDSHAKE_TIMEOUT)
+            else:
+                logger.info("Connecting to Unreal at %s:%s...", self.host, self.port)
+                sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+                sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+                sock.setsockopt(socket.SOL_SOCKET, socket.SO_KEEPALIVE, 1)
+                sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 65536)
+                sock.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 65536)
+                sock.settimeout(None)
+                sock.connect((self.host, self.port))
 
             self.socket = sock
             self.connected = True
             self._perform_handshake()
-            logger.info("Connected to Unreal Engine (capabilities=%s)", self.capabilities)
+            # From here the reader thread owns every read, so nothing may leave a timeout on the socket.
+            sock.settimeout(None)
+            self._dispatcher.window = self.window_max
+            self._reader = threading.Thread(target=self._read_loop, args=(sock,), name="unreal-mcp-reader", daemon=True)
+            self._reader.start()
+            logger.info("Connected to Unreal Engine (capabilities=%s, window=%s)", self.capabilities, self.window_max)
+            self._subscribe_cache_invalidation()
             return True
 
         except ProtocolError as exc:
@@ -243,13 +414,38 @@ class UnrealConnection:
     def disconnect(self) -> None:
         """Disconnect from the Unreal Engine instance."""
 
-        if self.socket:
+        sock = self.socket
+        self.socket = None
+        self.connected = False
+        if sock:
             try:
-                self.socket.close()
+                # Wakes the reader thread out of its blocking read.
+                if isinstance(sock, socket.socket):
+                    sock.shutdown(socket.SHUT_RDWR)
             except OSError:
                 pass
-        self.socket = None
-        self.connected = False
+            try:
+                sock.close()
+            except OSError:
+                pass
+        reader = self._reader
+        self._reader = None
+        if reader is not None and reader is not threading.current_thread():
+            reader.join(timeout=1.0)
+        self._dispatcher.fail_all(ProtocolError("CONNECTION_CLOSED", "Connection to Unreal closed."))
+        self.encoding = ENCODING_JSON
+        self.compress_threshold = 0
+        self.attachments = False
+        self._open_streams.clear()
+        if self.read_cache is not None:
+            # Changes made while disconnected were never reported.
+            self.read_cache.set_live(False)
+        with self._events_ready:
+            self._events.clear()
+            self._viewport_frames.clear()
+        if self._shared_memory:
+            self._shared_memory.close()
+        self._shared_memory = None
 
     def _perform_handshake(self) -> None:
         if not self.socket:
@@ -262,7 +458,14 @@ class UnrealConnection:
             "pluginVersion": self.CLIENT_VERSION,
             "sessionId": self.session_id,
             "resumeToken": self.resume_token,
+            "encodings": PREFERRED_ENCODINGS,
         }
+        if OFFER_COMPRESSION:
+            handshake["compression"] = ["zlib"]
+        if OFFER_SHARED_MEMORY and (UNREAL_TRANSPORT == "local" or self.host in LOCAL_HOSTS):
+            handshake["sharedMemory"] = True
+        if OFFER_ATTACHMENTS:
+            handshake["attachments"] = True
 
         write_frame(self.socket, handshake, timeout=self.WRITE_TIMEOUT)
         ack = read_frame(self.socket, timeout=self.HANDSHAKE_TIMEOUT)
@@ -285,6 +488,19 @@ class UnrealConnection:
                 {"sessionId": self.session_id},
             )
 
+        encoding = ack.get("encoding")
+        self.encoding = encoding if encoding in SUPPORTED_ENCODINGS else ENCODING_JSON
+
+        threshold = ack.get("compressionThreshold")
+        if ack.get("compression") == "zlib" and isinstance(threshold, (int, float)) and threshold > 0:
+            self.compress_threshold = int(threshold)
+        else:
+            self.compress_threshold = 0
+
+        self.attachments = ack.get("attachments") is True
+
+        self._attach_shared_memory(ack.get("sharedMemory"))
+
         window_val = ack.get("windowMax")
         if isinstance(window_val, int) and window_val > 0:
             self.window_max = window_val
@@ -295,7 +511,66 @@ class UnrealConnection:
         else:
             self.resume_token = None
 
-        self._send_enforcement_capabilities()
+        # The editor's session id ties our logs to its own; it is stable across resumes.
+        session_id = ack.get("sessionId")
+        if isinstance(session_id, str) and session_id:
+            self.session_id = session_id
+
+        # A resumed session still has the enforcement we sent on first connect.
+        if not ack.get("resume"):
+            self._send_enforcement_capabilities()
+
+    def _attach_shared_memory(self, offer: Any) -> None:
+        """Map the ring from the handshake ack and tell the editor to start using it."""
+
+        if not isinstance(offer, dict) or not isinstance(offer.get("name"), str):
+            return
+        try:
+            reader = SharedMemoryReader(offer["name"])
+        except (OSError, ProtocolError, ValueError) as exc:
+            # The editor keeps sending inline frames until it sees shm/ready.
+            logger.warning("Shared memory ring %s unavailable: %s", offer["name"], exc)
+            return
+        self._write({"type": "shm/ready"})
+        self._shared_memory = reader
+
+    def _resolve_shared_memory(self, message: Dict[str, Any]) -> Dict[str, Any]:
+        if message.get("type") != "shm/frame":
+            return message
+        if not self._shared_memory:
+            raise ProtocolError("MALFORMED_FRAME", "Received shm/frame without a shared memory ring.")
+        position = message.get("position")
+        length = message.get("length")
+        if not isinstance(position, (int, float)) or not isinstance(length, (int, float)):
+            raise ProtocolError("MALFORMED_FRAME", "Invalid shared memory descriptor.", {"descriptor": message})
+        return decode_frame_payload(
+            self._shared_memory.read(int(position), int(length)),
+            self.encoding,
+            self.attachments and message.get("attachments") is True,
+            _attachment_to_base64,
+        )
+
+    def _write(self, payload: Dict[str, Any]) -> None:
+        """Write one frame. Once the reader thread runs, the socket stays blocking (no timeout)."""
+
+        sock = self.socket
+        if not sock:
+            raise ProtocolError("WRITE_ERROR", "Socket not connected.")
+        timeout = None if self._reader is not None else self.WRITE_TIMEOUT
+        with self._write_lock:
+            write_frame(sock, payload, timeout=timeout, **self._frame_write_options())
+        self._last_send = time.monotonic()
+
+    def _frame_write_options(self) -> Dict[str, Any]:
+        return {"encoding": self.encoding, "compress_threshold": self.compress_threshold}
+
+    def _frame_read_options(self) -> Dict[str, Any]:
+        return {
+            "encoding": self.encoding,
+            "allow_compressed": self.compress_threshold > 0,
+            "allow_attachments": self.attachments,
+            "convert_attachment": _attachment_to_base64,
+        }
 
     def _send_enforcement_capabilities(self) -> None:
         if not self.socket:
@@ -308,16 +583,18 @@ class UnrealConnection:
             "allowedPaths": config.normalized_paths(),
             "server": SERVER_IDENTITY,
         }
+        if SCHEDULING_SHARE is not None:
+            enforcement["share"] = SCHEDULING_SHARE
 
         payload = {
             "type": "capabilities",
             "ok": True,
             "enforcement": enforcement,
+            "audit": bool(config.request_audit),
         }
 
         try:
-            write_frame(self.socket, payload, timeout=self.WRITE_TIMEOUT)
-            self._last_send = time.monotonic()
+            self._write(payload)
             logger.debug("Sent enforcement capabilities: %s", enforcement)
         except ProtocolError as exc:
             logger.error("Failed to send enforcement capabilities: %s", exc)
@@ -330,8 +607,7 @@ class UnrealConnection:
         if message_type == "ping":
             timestamp = int(message.get("ts", current_timestamp_ms()))
             try:
-                write_frame(self.socket, {"type": "pong", "ts": timestamp}, timeout=self.WRITE_TIMEOUT)
-                self._last_send = time.monotonic()
+                self._write({"type": "pong", "ts": timestamp})
                 logger.debug("Responded to ping (%s)", timestamp)
             except ProtocolError as exc:
                 logger.error("Failed to respond to ping: %s", exc)
@@ -342,20 +618,115 @@ class UnrealConnection:
             logger.debug("Received pong (%s)", message.get("ts"))
             return True
 
+        if message_type == "event" and message.get("topic") == "cache.invalidated":
+            # Internal to the read cache; tools that subscribed to "*" do not need them.
+            if self.read_cache is not None:
+                for event in message.get("events") or []:
+                    if isinstance(event, dict):
+                        self.read_cache.observe(event.get("generation"))
+            return True
+
+        if message_type == "event":
+            with self._events_ready:
+                self._events.append(message)
+                self._events_ready.notify_all()
+            return True
+
+        if message_type == "viewport_frame":
+            stream_id = str(message.get("streamId", ""))
+            with self._events_ready:
+                # Workers may finish frames out of order; an agent only wants the newest.
+                previous = self._viewport_frames.get(stream_id)
+                if previous is None or message.get("seq", 0) > previous.get("seq", 0):
+                    self._viewport_frames[stream_id] = message
+                    self._events_ready.notify_all()
+            return True
+
+        if message_type == "progress":
+            # The command is alive, just slow; keep its idle deadline rolling.
+            self._dispatcher.touch(str(message.get("requestId", "")))
+            handler = self._progress_handlers.get(str(message.get("requestId", "")))
+            if handler is not None:
+                try:
+                    handler(message)
+                except Exception as exc:  # pragma: no cover - defensive logging
+                    logger.warning("Progress handler failed: %s", exc)
+            return True
+
         return False
 
-    def _wait_for_message(self) -> Dict[str, Any]:
-        if not self.socket:
-            raise ProtocolError("READ_TIMEOUT", "Socket not connected.")
+    @staticmethod
+    def _response_request_id(message: Dict[str, Any]) -> Optional[str]:
+        meta = message.get("meta")
+        if isinstance(meta, dict):
+            value = meta.get("requestId")
+            if isinstance(value, str):
+                return value
+        return None
 
-        deadline = time.monotonic() + self.IDLE_TIMEOUT
+    def _absorb_stream_frame(self, message: Dict[str, Any]) -> Optional[Dict[str, Any]]:
+        """Accumulate streamed frames; return the reassembled response once stream_end arrives."""
+
+        message_type = message.get("type")
+        stream_id = message.get("requestId") or self._response_request_id(message)
+        if not isinstance(stream_id, str):
+            return message
+
+        if message_type == "stream_begin":
+            self._open_streams[stream_id] = {"field": message.get("field") or "data", "chunks": []}
+            return None
+
+        if message_type == "stream_chunk":
+            stream = self._open_streams.get(stream_id)
+            if stream is not None:
+                stream["chunks"].append(str(message.get("data", "")))
+            return None
+
+        stream = self._open_streams.pop(stream_id, None)
+        if stream is not None:
+            result = message.get("result")
+            if not isinstance(result, dict):
+                result = {}
+                message["result"] = result
+            result[stream["field"]] = "".join(stream["chunks"])
+        message.pop("type", None)
+        return message
+
+    def _read_loop(self, sock: Any) -> None:
+        """Reader thread: hand each frame from ``sock`` to the request or handler it belongs to."""
+
+        reader = FrameReader(sock)
         while True:
-            remaining = max(0.0, deadline - time.monotonic())
-            message = read_frame(self.socket, timeout=remaining)
+            try:
+                message = self._resolve_shared_memory(reader.read_frame(timeout=None, **self._frame_read_options()))
+            except (ProtocolError, OSError, ValueError) as exc:
+                if self.socket is sock:
+                    logger.error("Lost connection to Unreal: %s", exc)
+                    self.disconnect()
+                return
             self._last_receive = time.monotonic()
-            if self._handle_control_message(message):
-                continue
-            return message
+            try:
+                self._dispatch(message)
+            except ProtocolError as exc:
+                if self.socket is sock:
+                    logger.error("Protocol error while reading from Unreal: %s (%s)", exc.code, exc)
+                    self.disconnect()
+                return
+
+    def _dispatch(self, message: Dict[str, Any]) -> None:
+        if self._handle_control_message(message):
+            return
+        if message.get("type") in ("stream_begin", "stream_chunk", "stream_end"):
+            # Chunks arrive incrementally; keep the idle deadline rolling while they flow.
+            self._dispatcher.touch(message.get("requestId") or self._response_request_id(message))
+            completed = self._absorb_stream_frame(message)
+            if completed is None:
+                return
+            message = completed
+        response_id = self._response_request_id(message)
+        if not self._dispatcher.resolve(response_id, message):
+            # Its caller already timed out or was disconnected.
+            logger.debug("Dropping response nobody is waiting for (requestId=%s)", response_id)
 
     def send_command(
         self,
@@ -363,12 +734,77 @@ class UnrealConnection:
         params: Optional[Dict[str, Any]] = None,
         *,
         request_id: Optional[str] = None,
+        stream: bool = False,
+        on_progress: Optional[Callable[[Dict[str, Any]], None]] = None,
     ) -> Optional[Dict[str, Any]]:
-        """Send a command to Unreal Engine and wait for a framed response."""
+        """Send a command to Unreal Engine and wait for a framed response.
+
+        With ``stream=True`` large results (e.g. ``sequence.export`` CSV) are sent as
+        stream_begin/stream_chunk/stream_end frames and reassembled here.
+        With ``on_progress`` the editor reports ``{done, total, phase}`` while long commands
+        (content.scan, asset.batch_import, ...) run; each frame also resets the idle timeout.
+        """
+
+        request_id = request_id or str(uuid.uuid4())
+        prepared = self._prepare_command(command, params, request_id=request_id, stream=stream, progress=on_progress is not None)
+        if not isinstance(prepared, _PreparedCommand):
+            return prepared
+        if on_progress is not None:
+            self._progress_handlers[request_id] = on_progress
+        try:
+            pending = self._submit(prepared)
+            return self._finish_command(prepared, self._dispatcher.wait(pending, self.IDLE_TIMEOUT))
+        except ProtocolError as exc:
+            return self._fail_command(prepared, exc)
+        except Exception as exc:  # pragma: no cover - defensive logging
+            return self._fail_unexpected(prepared, exc)
+        finally:
+            self._progress_handlers.pop(request_id, None)
+
+    async def send_command_async(
+        self,
+        command: str,
+        params: Optional[Dict[str, Any]] = None,
+        *,
+        request_id: Optional[str] = None,
+        stream: bool = False,
+        on_progress: Optional[Callable[[Dict[str, Any]], None]] = None,
+    ) -> Optional[Dict[str, Any]]:
+        """Awaitable ``send_command``: concurrent calls are in flight together on the one connection.
+
+        Connecting and writing run on a worker thread; waiting for the response does not hold one.
+        ``on_progress`` is called on the reader thread.
+        """
+
+        request_id = request_id or str(uuid.uuid4())
+        prepared = self._prepare_command(command, params, request_id=request_id, stream=stream, progress=on_progress is not None)
+        if not isinstance(prepared, _PreparedCommand):
+            return prepared
+        if on_progress is not None:
+            self._progress_handlers[request_id] = on_progress
+        try:
+            pending = await asyncio.to_thread(self._submit, prepared)
+            return self._finish_command(prepared, await self._dispatcher.wait_async(pending, self.IDLE_TIMEOUT))
+        except ProtocolError as exc:
+            return self._fail_command(prepared, exc)
+        except Exception as exc:  # pragma: no cover - defensive logging
+            return self._fail_unexpected(prepared, exc)
+        finally:
+            self._progress_handlers.pop(request_id, None)
+
+    def _prepare_command(
+        self,
+        command: str,
+        params: Optional[Dict[str, Any]],
+        *,
+        request_id: str,
+        stream: bool,
+        progress: bool,
+    ) -> Any:
+        """The checks made before anything is sent. Returns a ``_PreparedCommand``, or the final answer."""
 
         params = params or {}
         is_mutation = command in MUTATING_COMMANDS
-        request_id = request_id or str(uuid.uuid4())
         idempotency_key = request_id
         cached_response = DEDUP_STORE.get(idempotency_key)
         if cached_response is not None:
@@ -383,7 +819,57 @@ class UnrealConnection:
             )
             return deepcopy(cached_response)
         start_time = time.time()
-        start_ts_ms = start_time * 1000.0
+
+        read_cache = self.read_cache
+        if read_cache is not None:
+            if is_mutation or command == "batch":
+                read_cache.clear()
+            elif not stream:
+                cached = read_cache.get(read_cache.key(command, params))
+                if cached is not None:
+                    log_metric("read_cache_hits_total", {"tool": command})
+                    return cached
+
+        # Checked before any rate-limit tokens are spent; the editor repeats the check without jsonschema.
+        schema_error = schema_registry.validate(command, params)
+        if schema_error is not None:
+            return {
+                "ok": False,
+                "error": {
+                    "code": "INVALID_PARAMS",
+                    "message": f"{command}: {schema_error}",
+                    "details": {"tool": command, "retryable": False},
+                },
+            }
+
+        cost = None
+        if command == "batch" and isinstance(params.get("commands"), list):
+            cost = sum(RATE_LIMITER.cost_of(str(entry.get("type", ""))) for entry in params["commands"] if isinstance(entry, dict))
+        allowed, retry_after = RATE_LIMITER.check(command, cost)
+        if not allowed:
+            # Not remembered in the dedup store, so a retry with the same requestId runs.
+            log_event(
+                "warning",
+                "rate.limited",
+                f"Rate limit reached for {command}",
+                request_id=request_id,
+                session_id=self.session_id,
+                fields={"tool": command, "retryAfterSec": retry_after},
+                ts_ms=current_timestamp_ms(),
+            )
+            return {
+                "ok": False,
+                "error": {
+                    "code": "RATE_LIMITED",
+                    "message": f"Rate limit reached for {command}; retry in {retry_after:.1f} s",
+                    "details": {
+                        "tool": command,
+                        "retryable": True,
+                        "retryAfterSec": round(retry_after, 3),
+                        "retryAfterMs": int(retry_after * 1000.0 + 0.5),
+                    },
+                },
+            }
 
         if is_mutation:
             config = get_server_config()
@@ -406,96 +892,251 @@ class UnrealConnection:
                 self._emit_audit(command, params, error_payload)
                 return error_payload
 
-        if not self.connected or not self.socket:
-            if not self.connect():
-                logger.error("Failed to connect to Unreal Engine for command")
-                return None
+        return _PreparedCommand(command, params, request_id, is_mutation, start_time, stream, progress)
+
+    def _submit(self, prepared: "_PreparedCommand") -> PendingRequest:
+        """Connect if needed, take a slot in the request window and write the request."""
 
+        if not self._ensure_connected():
+            raise ProtocolError("CONNECTION_FAILED", "Failed to connect to Unreal Engine.")
+
+        request_id = prepared.request_id
+        start_ts_ms = prepared.start_time * 1000.0
         payload = {
-            "type": command,
-            "params": params,
+            "type": prepared.command,
+            "params": prepared.params,
             "requestId": request_id,
-            "idempotencyKey": idempotency_key,
-            "meta": {"requestId": request_id, "ts": start_ts_ms},
+            "idempotencyKey": request_id,
+            # The editor drops the command unstarted once we would have stopped waiting for it.
+            "meta": {"requestId": request_id, "ts": start_ts_ms, "deadlineMs": start_ts_ms + self.IDLE_TIMEOUT * 1000.0},
         }
+        if prepared.stream and "response-stream" in self.capabilities:
+            payload["stream"] = True
+        if prepared.progress and "progress" in self.capabilities:
+            payload["progress"] = True
 
+        pending = self._dispatcher.acquire(request_id, timeout=self.IDLE_TIMEOUT)
         try:
-            write_frame(self.socket, payload, timeout=self.WRITE_TIMEOUT)
-            self._last_send = time.monotonic()
-            response = self._wait_for_message()
-            logger.debug("Received response payload: %s", response)
-            duration_ms = (time.time() - start_time) * 1000.0
-            if isinstance(response, dict):
-                meta = response.setdefault("meta", {})
-                meta.setdefault("requestId", request_id)
-                meta["serverTs"] = start_ts_ms
-                meta["durMs"] = duration_ms
-                fields = {
-                    "tool": command,
-                    "ok": bool(response.get("ok", False)),
-                    "durMs": duration_ms,
-                }
-                if isinstance(response.get("error"), dict):
-                    code = response["error"].get("code")
-                    if code:
-                        fields["errorCode"] = code
-                log_metric("tool_duration_ms", fields)
-                log_metric("tool_calls_total", {k: fields[k] for k in ("tool", "ok") if k in fields} | ({"errorCode": fields["errorCode"]} if "errorCode" in fields else {}))
-                log_event(
-                    "info" if response.get("ok") else "error",
-                    f"tool.{command}",
-                    f"Tool {command} completed",
-                    request_id=request_id,
-                    session_id=self.session_id,
-                    fields=fields,
-                    ts_ms=start_ts_ms,
-                )
-                DEDUP_STORE.put(idempotency_key, deepcopy(response))
-            if is_mutation and response is not None:
-                self._emit_audit(command, params, response)
-            return response
-
-        except ProtocolError as exc:
-            logger.error("Protocol error while communicating with Unreal: %s (%s)", exc.code, exc)
-            error_payload = exc.to_dict()
-            if is_mutation:
-                self._emit_audit(command, params, error_payload)
-            self.disconnect()
-            log_event(
-                "error",
-                f"tool.{command}",
-                f"Protocol error for {command}: {exc.code}",
-                request_id=request_id,
-                session_id=self.session_id,
-                fields={"errorCode": exc.code, "durMs": (time.time() - start_time) * 1000.0},
-                ts_ms=start_ts_ms,
-            )
-            DEDUP_STORE.put(idempotency_key, deepcopy(error_payload))
-            return error_payload
-        except Exception as exc:  # pragma: no cover - defensive logging
-            logger.error("Unexpected error while sending command: %s", exc)
-            self.disconnect()
-            error_payload = {
-                "ok": False,
-                "error": {
-                    "code": "INTERNAL_ERROR",
-                    "message": str(exc),
-                    "details": {},
-                },
+            self._write(payload)
+        except BaseException:
+            self._dispatcher.release(request_id)
+            raise
+        return pending
+
+    def _finish_command(self, prepared: "_PreparedCommand", response: Dict[str, Any]) -> Optional[Dict[str, Any]]:
+        command = prepared.command
+        request_id = prepared.request_id
+        start_time = prepared.start_time
+        start_ts_ms = start_time * 1000.0
+        logger.debug("Received response payload: %s", response)
+        duration_ms = (time.time() - start_time) * 1000.0
+        if isinstance(response, dict):
+            meta = response.setdefault("meta", {})
+            meta.setdefault("requestId", request_id)
+            meta["serverTs"] = start_ts_ms
+            meta["durMs"] = duration_ms
+            fields = {
+                "tool": command,
+                "ok": bool(response.get("ok", False)),
+                "durMs": duration_ms,
             }
-            if is_mutation:
-                self._emit_audit(command, params, error_payload)
+            if isinstance(response.get("error"), dict):
+                code = response["error"].get("code")
+                if code:
+                    fields["errorCode"] = code
+            log_metric("tool_duration_ms", fields)
+            log_metric("tool_calls_total", {k: fields[k] for k in ("tool", "ok") if k in fields} | ({"errorCode": fields["errorCode"]} if "errorCode" in fields else {}))
             log_event(
-                "error",
+                "info" if response.get("ok") else "error",
                 f"tool.{command}",
-                f"Unexpected error for {command}",
+                f"Tool {command} completed",
                 request_id=request_id,
                 session_id=self.session_id,
-                fields={"error": str(exc), "durMs": (time.time() - start_time) * 1000.0},
+                fields=fields,
                 ts_ms=start_ts_ms,
             )
-            DEDUP_STORE.put(idempotency_key, deepcopy(error_payload))
-            return error_payload
+            if not _is_retryable(response):
+                DEDUP_STORE.put(request_id, deepcopy(response))
+            if self.read_cache is not None:
+                self.read_cache.observe_response(command, prepared.params, response)
+        if prepared.is_mutation and response is not None:
+            self._emit_audit(command, prepared.params, response)
+        return response
+
+    def _fail_command(self, prepared: "_PreparedCommand", exc: ProtocolError) -> Optional[Dict[str, Any]]:
+        command = prepared.command
+        request_id = prepared.request_id
+        if exc.code == "CONNECTION_FAILED":
+            logger.error("Failed to connect to Unreal Engine for command")
+            return None
+        logger.error("Protocol error while communicating with Unreal: %s (%s)", exc.code, exc)
+        if exc.code == "READ_TIMEOUT":
+            # Nobody will read the answer; don't leave the editor working on it. Other requests
+            # on the connection are unaffected, so it stays open.
+            self.cancel(request_id)
+        elif exc.code not in ("CONNECTION_CLOSED", "WINDOW_FULL", "DUPLICATE_REQUEST"):
+            self.disconnect()
+        error_payload = exc.to_dict()
+        if prepared.is_mutation:
+            self._emit_audit(command, prepared.params, error_payload)
+        log_event(
+            "error",
+            f"tool.{command}",
+            f"Protocol error for {command}: {exc.code}",
+            request_id=request_id,
+            session_id=self.session_id,
+            fields={"errorCode": exc.code, "durMs": (time.time() - prepared.start_time) * 1000.0},
+            ts_ms=prepared.start_time * 1000.0,
+        )
+        DEDUP_STORE.put(request_id, deepcopy(error_payload))
+        return error_payload
+
+    def _fail_unexpected(self, prepared: "_PreparedCommand", exc: Exception) -> Optional[Dict[str, Any]]:
+        command = prepared.command
+        logger.error("Unexpected error while sending command: %s", exc)
+        self.disconnect()
+        error_payload = {
+            "ok": False,
+            "error": {
+                "code": "INTERNAL_ERROR",
+                "message": str(exc),
+                "details": {},
+            },
+        }
+        if prepared.is_mutation:
+            self._emit_audit(command, prepared.params, error_payload)
+        log_event(
+            "error",
+            f"tool.{command}",
+            f"Unexpected error for {command}",
+            request_id=prepared.request_id,
+            session_id=self.session_id,
+            fields={"error": str(exc), "durMs": (time.time() - prepared.start_time) * 1000.0},
+            ts_ms=prepared.start_time * 1000.0,
+        )
+        DEDUP_STORE.put(prepared.request_id, deepcopy(error_payload))
+        return error_payload
+
+    def send_batch(
+        self,
+        commands: List[Dict[str, Any]],
+        *,
+        stop_on_error: bool = False,
+        request_id: Optional[str] = None,
+    ) -> Optional[Dict[str, Any]]:
+        """Execute ``[{"type": ..., "params": {...}}]`` in one round trip and one game-thread hop."""
+
+        return self.send_command(
+            "batch",
+            {"commands": commands, "stopOnError": stop_on_error},
+            request_id=request_id,
+        )
+
+    def cancel(self, request_id: str) -> bool:
+        """Ask the editor to stop ``request_id``. Fire-and-forget: the request itself answers CANCELLED.
+
+        A command still queued for the game thread never runs; a running scan/import/export stops
+        between items. Returns False when the cancel could not be sent.
+        """
+
+        if not self.connected or not self.socket or "cancel" not in self.capabilities:
+            return False
+        try:
+            self._write({"type": "cancel", "params": {"requestId": request_id}})
+        except ProtocolError as exc:
+            logger.warning("Failed to send cancel for %s: %s", request_id, exc)
+            return False
+        return True
+
+    def subscribe(self, topics: List[str]) -> Optional[Dict[str, Any]]:
+        """Ask the editor to push ``event`` frames for ``topics`` (e.g. ``actor.moved``, ``*`` for all)."""
+
+        response = self.send_command("subscribe", {"topics": list(topics)})
+        self._note_subscribed_topics(response)
+        return response
+
+    def unsubscribe(self, topics: Optional[List[str]] = None) -> Optional[Dict[str, Any]]:
+        """Stop events for ``topics``, or for every topic when omitted."""
+
+        response = self.send_command("unsubscribe", {"topics": list(topics or [])})
+        self._note_subscribed_topics(response)
+        return response
+
+    def _subscribe_cache_invalidation(self) -> None:
+        if self.read_cache is None or "events" not in self.capabilities:
+            return
+        self._note_subscribed_topics(self.send_command("subscribe", {"topics": ["cache.invalidated"]}))
+
+    def _note_subscribed_topics(self, response: Optional[Dict[str, Any]]) -> None:
+        """The read cache stays live only while cache.invalidated is among the session's topics."""
+
+        if self.read_cache is None or not isinstance(response, dict) or not response.get("ok"):
+            return
+        result = response.get("result")
+        topics = result.get("topics") if isinstance(result, dict) else None
+        if isinstance(topics, list):
+            live = "cache.invalidated" in topics
+            if live != self.read_cache.live:
+                self.read_cache.set_live(live)
+
+    def drain_events(self, wait: float = 0.0) -> List[Dict[str, Any]]:
+        """Return the event frames received so far.
+
+        With ``wait`` > 0 and nothing buffered, block up to that many seconds for the next one.
+        """
+
+        with self._events_ready:
+            if not self._events and wait > 0:
+                self._events_ready.wait_for(lambda: bool(self._events), timeout=wait)
+            events = list(self._events)
+            self._events.clear()
+        return events
+
+    def start_viewport_stream(
+        self,
+        fps: int = 15,
+        resolution: Optional[List[int]] = None,
+        codec: str = "mjpeg",
+        quality: Optional[int] = None,
+    ) -> Optional[Dict[str, Any]]:
+        """Have the editor push the active viewport as ``viewport_frame`` frames until stopped.
+
+        ``resolution`` is ``[width, height]`` to fit frames into (default 1280x720). Read them
+        with ``latest_viewport_frame``; the session's previous stream, if any, is replaced.
+        """
+
+        params: Dict[str, Any] = {"fps": fps, "codec": codec}
+        if resolution is not None:
+            params["resolution"] = list(resolution)
+        if quality is not None:
+            params["quality"] = quality
+        return self.send_command("viewport.stream_start", params)
+
+    def stop_viewport_stream(self, stream_id: Optional[str] = None) -> Optional[Dict[str, Any]]:
+        """Stop ``stream_id`` (or this session's stream); the result carries frame counts and latency."""
+
+        response = self.send_command("viewport.stream_stop", {"streamId": stream_id} if stream_id else {})
+        with self._events_ready:
+            if stream_id:
+                self._viewport_frames.pop(stream_id, None)
+            else:
+                self._viewport_frames.clear()
+        return response
+
+    def latest_viewport_frame(self, stream_id: str, after_seq: int = -1, wait: float = 0.0) -> Optional[Dict[str, Any]]:
+        """The newest frame of ``stream_id`` with ``seq`` above ``after_seq``, or None.
+
+        With ``wait`` > 0, block up to that many seconds for one. ``data`` is base64 either way.
+        """
+
+        def newer() -> bool:
+            frame = self._viewport_frames.get(stream_id)
+            return frame is not None and frame.get("seq", 0) > after_seq
+
+        with self._events_ready:
+            if not newer() and wait > 0:
+                self._events_ready.wait_for(newer, timeout=wait)
+            return self._viewport_frames.get(stream_id) if newer() else None
 
     def _emit_audit(self, command: str, params: Dict[str, Any], response: Dict[str, Any]) -> None:
         if command not in MUTATING_COMMANDS:
@@ -536,22 +1177,149 @@ class UnrealConnection:
 
 # Global connection state
 _unreal_connection: UnrealConnection = None
+_spare_connection: Optional[UnrealConnection] = None
+_spare_lock = threading.Lock()
+_spare_refilling = False
+_spare_retry_at = 0.0
+_spare_closed = False
+
+def _new_connection() -> Any:
+    endpoints = load_endpoints(EDITOR_ENDPOINTS)
+    if not endpoints:
+        return UnrealConnection()
+    return EditorPool(
+        endpoints,
+        lambda endpoint: UnrealConnection(endpoint.host, endpoint.port),
+        mutating=MUTATING_COMMANDS,
+        health_interval=EDITOR_HEALTH_INTERVAL_SEC,
+    )
 
 def get_unreal_connection() -> Optional[UnrealConnection]:
-    """Get the connection to Unreal Engine."""
+    """Get the connection to Unreal Engine, or the pool of editors when UNREAL_MCP_EDITORS is set."""
     global _unreal_connection
     try:
         if _unreal_connection is None:
-            _unreal_connection = UnrealConnection()
-            if not _unreal_connection.connect():
+            _unreal_connection = _take_spare() or _new_connection()
+            if not _unreal_connection.connected and not _unreal_connection.connect():
                 logger.warning("Could not connect to Unreal Engine")
                 _unreal_connection = None
-
+        elif isinstance(_unreal_connection, UnrealConnection) and not _unreal_connection.connected:
+            # A session the editor can resume keeps its editor-side state, so it reconnects itself instead.
+            if not _unreal_connection.resume_token:
+                spare = _take_spare()
+                if spare is not None:
+                    logger.info("Connection to Unreal lost; switching to the warm spare")
+                    _unreal_connection.disconnect()
+                    _unreal_connection = spare
+
+        if isinstance(_unreal_connection, UnrealConnection):
+            _refill_spare()
         return _unreal_connection
     except Exception as e:
         logger.error(f"Error getting Unreal connection: {e}")
         return None
 
+def _take_spare() -> Optional[UnrealConnection]:
+    """The warm spare if it is still connected; it is no longer the spare afterwards."""
+    global _spare_connection
+    with _spare_lock:
+        spare, _spare_connection = _spare_connection, None
+    if spare is not None and not spare.connected:
+        spare.disconnect()
+        return None
+    return spare
+
+def _refill_spare() -> None:
+    """Connect and handshake a new spare on a background thread, unless one is ready or on its way."""
+    global _spare_refilling, _spare_connection
+    if not KEEP_WARM_SPARE or EDITOR_ENDPOINTS or _spare_closed:
+        return
+    stale: Optional[UnrealConnection] = None
+    with _spare_lock:
+        if _spare_connection is not None and not _spare_connection.connected:
+            # The editor closed it while it waited.
+            stale, _spare_connection = _spare_connection, None
+        if _spare_refilling or _spare_connection is not None or time.monotonic() < _spare_retry_at:
+            start = False
+        else:
+            _spare_refilling = start = True
+    if stale is not None:
+        stale.disconnect()
+    if not start:
+        return
+
+    def run() -> None:
+        global _spare_connection, _spare_refilling, _spare_retry_at
+        spare: Optional[UnrealConnection] = UnrealConnection()
+        connected = spare.connect()
+        with _spare_lock:
+            _spare_refilling = False
+            # One that connects after _discard_spare is closed instead of kept.
+            if connected and _spare_connection is None and not _spare_closed:
+                _spare_connection, spare = spare, None
+            elif not connected:
+                _spare_retry_at = time.monotonic() + SPARE_RETRY_SEC
+        if spare is not None:
+            spare.disconnect()
+
+    threading.Thread(target=run, name="unreal-mcp-spare", daemon=True).start()
+
+def _discard_spare() -> None:
+    global _spare_closed
+    with _spare_lock:
+        _spare_closed = True
+    spare = _take_spare()
+    if spare is not None:
+        spare.disconnect()
+
+def prime_connection(connection: Any) -> None:
+    """Ask each editor to load now what the first commands would otherwise wait for (editor.warmup)."""
+    if not WARMUP_ENABLED:
+        return
+    params = {"families": WARMUP_FAMILIES}
+    if isinstance(connection, EditorPool):
+        targets = [(entry["name"], {"editor": entry["name"]}) for entry in connection.status() if entry["healthy"]]
+    else:
+        targets = [(f"{connection.host}:{connection.port}", {})]
+    for name, routing in targets:
+        started = time.monotonic()
+        response = connection.send_command("editor.warmup", params, **routing)
+        if not isinstance(response, dict) or not response.get("ok"):
+            # Editors from before editor.warmup answer UNKNOWN_COMMAND; they warm up on first use as before.
+            error = response.get("error") if isinstance(response, dict) else None
+            logger.info("Editor %s warm-up skipped: %s", name, (error or {}).get("code", "no response"))
+            continue
+        result = response.get("result") if isinstance(response.get("result"), dict) else response
+        data = result.get("data") if isinstance(result.get("data"), dict) else result
+        logger.info(
+            "Editor %s warmed up in %.0f ms (families=%s, indexes=%s)",
+            name,
+            (time.monotonic() - started) * 1000.0,
+            data.get("loadedFamilies"),
+            data.get("indexes"),
+        )
+
+async def send_command_with_progress(ctx: Context, command: str, params: Optional[Dict[str, Any]] = None) -> Optional[Dict[str, Any]]:
+    """Await ``command`` and forward its progress frames as MCP progress notifications.
+
+    For long-running tools (content.scan, asset.batch_import, content.generate_thumbnails,
+    sequence.export): the MCP client sees the work advancing instead of guessing at a timeout.
+    """
+
+    unreal = get_unreal_connection()
+    if not unreal:
+        return None
+
+    loop = asyncio.get_running_loop()
+
+    def forward(frame: Dict[str, Any]) -> None:
+        asyncio.run_coroutine_threadsafe(
+            ctx.report_progress(float(frame.get("done", 0)), float(frame.get("total", 0)) or None, frame.get("phase")),
+            loop,
+        )
+
+    return await unreal.send_command_async(command, params, on_progress=forward)
+
 @asynccontextmanager
 async def server_lifespan(server: FastMCP) -> AsyncIterator[Dict[str, Any]]:
     """Handle server startup and shutdown."""
@@ -561,6 +1329,9 @@ async def server_lifespan(server: FastMCP) -> AsyncIterator[Dict[str, Any]]:
         _unreal_connection = get_unreal_connection()
         if _unreal_connection:
             logger.info("Connected to Unreal Engine on startup")
+            # Off the startup path: the agent's first command queues behind the warm-up on the
+            # editor's game thread rather than behind the whole of it here.
+            threading.Thread(target=prime_connection, args=(_unreal_connection,), name="unreal-mcp-warmup", daemon=True).start()
         else:
             logger.warning("Could not connect to Unreal Engine on startup")
     except Exception as e:
@@ -570,6 +1341,7 @@ async def server_lifespan(server: FastMCP) -> AsyncIterator[Dict[str, Any]]:
     try:
         yield {}
     finally:
+        _discard_spare()
         if _unreal_connection:
             _unreal_connection.disconnect()
             _unreal_connection = None
@@ -617,6 +1389,8 @@ def info():
       Add widget instance to game viewport
     - `set_text_block_binding(widget_name, text_block_name, binding_property, binding_type="Text")`
       Set up dynamic property binding for text blocks
+    - `build_widget_tree(widget_name, root=None, widgets=None, parent="", replace=False, compile=True)`
+      Build a whole widget hierarchy in one request, with one compile and save
 
     ## Editor Tools
     ### Viewport and Screenshots
@@ -630,13 +1404,21 @@ def info():
     - `delete_actor(name)` - Remove actors
     - `set_actor_transform(name, location, rotation, scale)` - Modify actor transform
     - `get_actor_properties(name)` - Get actor properties
+    - `scan_content(paths, include_unused_textures=False)` - Find redirectors, missing and broken references (reports progress)
+    - `validate_content(paths, rules, rules_id)` - Check naming, texture, mesh and material rules, split across every configured editor
+    - `list_editors()` - Show the editors this server routes to and whether they are up
+
+    ### Change Notifications
+    - `subscribe_editor_events(topics)` - Push asset/actor/package changes instead of polling
+    - `get_editor_events(wait_seconds=0)` - Collect events received since the last call
     
     ## Blueprint Management
     - `create_blueprint(name, parent_class)` - Create new Blueprint classes
     - `add_component_to_blueprint(blueprint_name, component_type, component_name)` - Add components
     - `set_static_mesh_properties(blueprint_name, component_name, static_mesh)` - Configure meshes
     - `set_physics_properties(blueprint_name, component_name)` - Configure physics
-    - `compile_blueprint(blueprint_name)` - Compile Blueprint changes
+    - `compile_blueprint(blueprint_name, mode="full")` - Compile Blueprint changes; `skeleton` only refreshes the skeleton class
+    - `compile_blueprints(blueprints, paths, save, skip_up_to_date)` - Compile many Blueprints in one dependency-ordered pass
     - `set_blueprint_property(blueprint_name, property_name, property_value)` - Set properties
     - `set_pawn_properties(blueprint_name)` - Configure Pawn settings
     - `spawn_blueprint_actor(blueprint_name, actor_name)` - Spawn Blueprint actors
@@ -650,6 +1432,8 @@ def info():
     - `add_blueprint_get_self_component_reference(blueprint_name, component_name)` - Add component refs
     - `add_blueprint_self_reference(blueprint_name)` - Add self references
     - `find_blueprint_nodes(blueprint_name, node_type, event_type)` - Find nodes
+    - `apply_blueprint_graph_patch(blueprint_name, nodes, edges, compile)` - Add many nodes and connections in one request
+    - `search_blueprint_nodes(function, variable, event, node_class, query, paths, limit)` - Find nodes across every Blueprint without loading them
     
     ## Project Tools
     - `create_input_mapping(action_name, key, input_type)` - Create input mappings
@@ -1,21 +0,0 @@
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Modules/ModuleManager.h"
-
-class FUnrealMCPModule : public IModuleInterface
-{
-public:
-    virtual void StartupModule() override;
-    virtual void ShutdownModule() override;
-
-    static inline FUnrealMCPModule& Get()
-    {
-        return FModuleManager::LoadModuleChecked<FUnrealMCPModule>("UnrealMCP");
-    }
-
-    static inline bool IsAvailable()
-    {
-        return FModuleManager::Get().IsModuleLoaded("UnrealMCP");
-    }
-};
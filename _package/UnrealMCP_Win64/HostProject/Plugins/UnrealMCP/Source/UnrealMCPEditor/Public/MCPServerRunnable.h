@@ -1,49 +0,0 @@
-#pragma once
-
-#include "CoreMinimal.h"
-#include "HAL/Runnable.h"
-
-class UUnrealMCPBridge;
-class FJsonObject;
-class FSocket;
-
-namespace UnrealMCP
-{
-namespace Protocol
-{
-        class FProtocolClient;
-}
-}
-
-struct FMCPServerConfig
-{
-        double HandshakeTimeoutSeconds = 5.0;
-        double ReadTimeoutSeconds = 60.0;
-        double HeartbeatIntervalSeconds = 15.0;
-};
-
-/**
- * Runnable class for the MCP server thread
- */
-class FMCPServerRunnable : public FRunnable
-{
-public:
-        FMCPServerRunnable(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InListenerSocket, const FMCPServerConfig& InConfig);
-        virtual ~FMCPServerRunnable();
-
-	// FRunnable interface
-	virtual bool Init() override;
-	virtual uint32 Run() override;
-	virtual void Stop() override;
-	virtual void Exit() override;
-
-private:
-        UUnrealMCPBridge* Bridge;
-        TSharedPtr<FSocket> ListenerSocket;
-        TSharedPtr<FSocket> ClientSocket;
-        bool bRunning;
-        FMCPServerConfig Config;
-
-        void RunConnection(const TSharedPtr<FSocket>& InClientSocket);
-        bool HandleProtocolMessage(class UnrealMCP::Protocol::FProtocolClient& ProtocolClient, const TSharedPtr<class FJsonObject>& Message);
-};
\ No newline at end of file
@@ -11,6 +11,18 @@ param(
 $ErrorActionPreference = 'Stop'
 Set-StrictMode -Version Latest
 
+# Relative path -> SHA256 of every file under $root, for comparing two source trees.
+function Get-SourceHashes([string]$root) {
+  $hashes = @{}
+  if (-not (Test-Path $root)) { return $hashes }
+  $rootFull = (Resolve-Path -LiteralPath $root).Path
+  Get-ChildItem -LiteralPath $rootFull -Recurse -File | ForEach-Object {
+    $relative = $_.FullName.Substring($rootFull.Length).TrimStart('\', '/')
+    $hashes[$relative] = (Get-FileHash -LiteralPath $_.FullName -Algorithm SHA256).Hash
+  }
+  return $hashes
+}
+
 function Resolve-Full([string]$p) {
   if (-not $p) { return $null }
   try { return (Resolve-Path -LiteralPath $p).Path } catch { return $p }
@@ -47,6 +59,13 @@ if ($Clean) {
   }
 }
 
+# UAT stages the plugin into <OutDir>/HostProject to compile it. A copy left by an earlier run would
+# be built instead of the current sources, so it is always staged afresh.
+$hostProject = Join-Path $OutDir "HostProject"
+if (Test-Path $hostProject) {
+  Remove-Item -Recurse -Force $hostProject
+}
+
 New-Item -ItemType Directory -Force -Path $OutDir | Out-Null
 New-Item -ItemType Directory -Force -Path "logs" | Out-Null
 $logRootPath = (Resolve-Path -LiteralPath "logs").Path
@@ -117,5 +136,18 @@ if ($exitCode -ne 0) {
   exit $exitCode
 }
 
+# The package must ship exactly the sources it was built from.
+$sourceHashes = Get-SourceHashes (Join-Path $pluginRoot "Source")
+$packagedHashes = Get-SourceHashes (Join-Path $OutDir "Source")
+if ($packagedHashes.Count -gt 0) {
+  $drifted = @($sourceHashes.Keys | Where-Object { $packagedHashes[$_] -ne $sourceHashes[$_] })
+  $drifted += @($packagedHashes.Keys | Where-Object { -not $sourceHashes.ContainsKey($_) })
+  if ($drifted.Count -gt 0) {
+    Write-Host "`nPACKAGED SOURCE DIFFERS from $pluginRoot\Source ($($drifted.Count) files):" -ForegroundColor Red
+    $drifted | Select-Object -First 20 | ForEach-Object { Write-Host "  $_" }
+    exit 1
+  }
+}
+
 Write-Host "`nBUILD SUCCESS. Output: $OutDir" -ForegroundColor Green
 Write-Host "Log: $log"